@@ -0,0 +1,465 @@
+#include <levikno/levikno.h>
+
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// INFO: microbenchmarks of the core containers and allocators compared against their std equivalents
+//       build with LVN_BUILD_BENCHMARKS and a release configuration, debug builds keep the container asserts
+//       run with a file path to also write the results as csv: benchmarkContainers [results.csv]
+//
+//       every benchmark runs several times and keeps the fastest run, times are nanoseconds per operation
+
+
+static constexpr uint32_t s_Repetitions = 7;
+static constexpr size_t s_Count = 1 << 18;
+
+static volatile uint64_t s_Sink = 0; // results are folded into this so the compiler cannot drop the measured work
+
+struct BenchmarkResult
+{
+    const char* group;
+    const char* name;
+    double nsPerOp;
+};
+
+static std::vector<BenchmarkResult> s_Results;
+
+// keys spread over the whole range so hash maps do not get sequential keys
+static uint64_t benchmarkKey(uint64_t i)
+{
+    uint64_t x = i + 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+template <typename Func>
+static void benchmark(const char* group, const char* name, size_t ops, Func func)
+{
+    double best = 0.0;
+    for (uint32_t i = 0; i < s_Repetitions; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        s_Sink = s_Sink + func();
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / ops;
+        if (i == 0 || ns < best)
+            best = ns;
+    }
+
+    s_Results.push_back({ group, name, best });
+    printf("%-14s %-40s %10.2f ns/op\n", group, name, best);
+}
+
+
+// [Vector]
+static void benchmarkVector()
+{
+    benchmark("vector", "LvnVector<int>::push_back", s_Count, []()
+    {
+        LvnVector<int> vec;
+        for (size_t i = 0; i < s_Count; i++)
+            vec.push_back(static_cast<int>(i));
+        return static_cast<uint64_t>(vec.size());
+    });
+
+    benchmark("vector", "std::vector<int>::push_back", s_Count, []()
+    {
+        std::vector<int> vec;
+        for (size_t i = 0; i < s_Count; i++)
+            vec.push_back(static_cast<int>(i));
+        return static_cast<uint64_t>(vec.size());
+    });
+
+    LvnVector<int> lvnVec;
+    std::vector<int> stdVec;
+    for (size_t i = 0; i < s_Count; i++)
+    {
+        lvnVec.push_back(static_cast<int>(i));
+        stdVec.push_back(static_cast<int>(i));
+    }
+
+    benchmark("vector", "LvnVector<int> iterate", s_Count, [&]()
+    {
+        uint64_t sum = 0;
+        for (int value : lvnVec)
+            sum += value;
+        return sum;
+    });
+
+    benchmark("vector", "std::vector<int> iterate", s_Count, [&]()
+    {
+        uint64_t sum = 0;
+        for (int value : stdVec)
+            sum += value;
+        return sum;
+    });
+}
+
+
+// [Hash Map]
+static void benchmarkHashMap()
+{
+    benchmark("hash map", "LvnHashMap insert", s_Count, []()
+    {
+        LvnHashMap<uint64_t, uint64_t> map;
+        for (size_t i = 0; i < s_Count; i++)
+            map.insert(benchmarkKey(i), i);
+        return static_cast<uint64_t>(map.size());
+    });
+
+    benchmark("hash map", "LvnFlatHashMap insert", s_Count, []()
+    {
+        LvnFlatHashMap<uint64_t, uint64_t> map;
+        for (size_t i = 0; i < s_Count; i++)
+            map.insert(benchmarkKey(i), i);
+        return static_cast<uint64_t>(map.size());
+    });
+
+    benchmark("hash map", "std::unordered_map insert", s_Count, []()
+    {
+        std::unordered_map<uint64_t, uint64_t> map;
+        for (size_t i = 0; i < s_Count; i++)
+            map.insert({ benchmarkKey(i), i });
+        return static_cast<uint64_t>(map.size());
+    });
+
+    LvnHashMap<uint64_t, uint64_t> lvnMap;
+    LvnFlatHashMap<uint64_t, uint64_t> flatMap;
+    std::unordered_map<uint64_t, uint64_t> stdMap;
+    for (size_t i = 0; i < s_Count; i++)
+    {
+        lvnMap.insert(benchmarkKey(i), i);
+        flatMap.insert(benchmarkKey(i), i);
+        stdMap.insert({ benchmarkKey(i), i });
+    }
+
+    // half of the lookups miss
+    benchmark("hash map", "LvnHashMap lookup", s_Count, [&]()
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            uint64_t key = benchmarkKey(i * 2);
+            if (lvnMap.contains(key))
+                sum += lvnMap.at(key);
+        }
+        return sum;
+    });
+
+    benchmark("hash map", "LvnFlatHashMap lookup", s_Count, [&]()
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            if (const uint64_t* value = flatMap.find(benchmarkKey(i * 2)))
+                sum += *value;
+        }
+        return sum;
+    });
+
+    benchmark("hash map", "std::unordered_map lookup", s_Count, [&]()
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            auto it = stdMap.find(benchmarkKey(i * 2));
+            if (it != stdMap.end())
+                sum += it->second;
+        }
+        return sum;
+    });
+}
+
+
+// [Arena List]
+static void benchmarkArenaList()
+{
+    benchmark("list", "LvnArenaList push_back/pop_front", s_Count * 2, []()
+    {
+        LvnArenaList<uint64_t> list;
+        for (size_t i = 0; i < s_Count; i++)
+            list.push_back(i);
+
+        uint64_t sum = 0;
+        while (!list.empty())
+        {
+            sum += list[0];
+            list.pop_front();
+        }
+        return sum;
+    });
+
+    benchmark("list", "std::list push_back/pop_front", s_Count * 2, []()
+    {
+        std::list<uint64_t> list;
+        for (size_t i = 0; i < s_Count; i++)
+            list.push_back(i);
+
+        uint64_t sum = 0;
+        while (!list.empty())
+        {
+            sum += list.front();
+            list.pop_front();
+        }
+        return sum;
+    });
+
+    LvnArenaList<uint64_t> lvnList;
+    std::list<uint64_t> stdList;
+    for (size_t i = 0; i < s_Count; i++)
+    {
+        lvnList.push_back(i);
+        stdList.push_back(i);
+    }
+
+    // dense iteration walks the node array in memory order, list order is not kept
+    benchmark("list", "LvnArenaList iterate dense", s_Count, [&]()
+    {
+        uint64_t sum = 0;
+        for (uint64_t value : lvnList.dense())
+            sum += value;
+        return sum;
+    });
+
+    benchmark("list", "std::list iterate", s_Count, [&]()
+    {
+        uint64_t sum = 0;
+        for (uint64_t value : stdList)
+            sum += value;
+        return sum;
+    });
+}
+
+
+// [String]
+static void benchmarkString()
+{
+    static const char* s_Words[] = { "vertex", "fragment", "pipeline", "descriptor", "a", "texture_sampler_linear" };
+    static constexpr size_t s_WordCount = sizeof(s_Words) / sizeof(s_Words[0]);
+
+    benchmark("string", "LvnString construct", s_Count, []()
+    {
+        uint64_t size = 0;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            LvnString str(s_Words[i % s_WordCount]);
+            size += str.size();
+        }
+        return size;
+    });
+
+    benchmark("string", "std::string construct", s_Count, []()
+    {
+        uint64_t size = 0;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            std::string str(s_Words[i % s_WordCount]);
+            size += str.size();
+        }
+        return size;
+    });
+
+    benchmark("string", "LvnString append", s_Count, []()
+    {
+        LvnString str;
+        for (size_t i = 0; i < s_Count; i++)
+            str += s_Words[i % s_WordCount];
+        return static_cast<uint64_t>(str.size());
+    });
+
+    benchmark("string", "std::string append", s_Count, []()
+    {
+        std::string str;
+        for (size_t i = 0; i < s_Count; i++)
+            str += s_Words[i % s_WordCount];
+        return static_cast<uint64_t>(str.size());
+    });
+}
+
+
+// [Queue]
+static void benchmarkQueue()
+{
+    // the queue stays short like a work queue that is drained as it is filled
+    benchmark("queue", "LvnQueue push/pop", s_Count * 2, []()
+    {
+        LvnQueue<uint64_t> queue;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            queue.push(i);
+            if (queue.size() > 64)
+            {
+                sum += queue.front();
+                queue.pop();
+            }
+        }
+        while (!queue.empty())
+        {
+            sum += queue.front();
+            queue.pop();
+        }
+        return sum;
+    });
+
+    benchmark("queue", "std::queue push/pop", s_Count * 2, []()
+    {
+        std::queue<uint64_t> queue;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            queue.push(i);
+            if (queue.size() > 64)
+            {
+                sum += queue.front();
+                queue.pop();
+            }
+        }
+        while (!queue.empty())
+        {
+            sum += queue.front();
+            queue.pop();
+        }
+        return sum;
+    });
+}
+
+
+// [Draw List]
+static void benchmarkDrawList()
+{
+    struct Vertex { float pos[3]; float uv[2]; };
+
+    static const Vertex s_Vertices[] =
+    {
+        { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f } },
+        { { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f } },
+        { { 1.0f, 1.0f, 0.0f }, { 1.0f, 1.0f } },
+        { { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f } },
+    };
+    static uint32_t s_Indices[] = { 0, 1, 2, 2, 3, 0 };
+
+    benchmark("draw list", "LvnDrawList::push_back quad", s_Count, []()
+    {
+        LvnDrawList list;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            LvnDrawCommand cmd{};
+            cmd.pVertices = const_cast<Vertex*>(s_Vertices);
+            cmd.pIndices = s_Indices;
+            cmd.vertexCount = 4;
+            cmd.indexCount = 6;
+            cmd.vertexStride = sizeof(Vertex);
+            cmd.sortKey = i;
+            list.push_back(cmd);
+        }
+        list.merge();
+        return static_cast<uint64_t>(list.index_count());
+    });
+
+    // what a hand written batch does, vertices and offset indices appended to two vectors
+    benchmark("draw list", "std::vector append quad", s_Count, []()
+    {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        for (size_t i = 0; i < s_Count; i++)
+        {
+            uint32_t first = static_cast<uint32_t>(vertices.size());
+            vertices.insert(vertices.end(), s_Vertices, s_Vertices + 4);
+            for (uint32_t index : s_Indices)
+                indices.push_back(first + index);
+        }
+        return static_cast<uint64_t>(indices.size());
+    });
+}
+
+
+// [Memory Pool]
+static void benchmarkObjectAllocation(const char* name, LvnMemAllocMode mode)
+{
+    static constexpr uint32_t s_ObjectCount = 1024;
+    static constexpr uint32_t s_Rounds = 64;
+
+    LvnContextCreateInfo lvnCreateInfo{};
+    lvnCreateInfo.memoryInfo.memAllocMode = mode;
+
+    LvnMemoryBindingInfo memoryBindings[] = { { Lvn_Stype_CommandList, s_ObjectCount } };
+    if (mode == Lvn_MemAllocMode_MemPool)
+    {
+        lvnCreateInfo.memoryInfo.pMemoryBindings = memoryBindings;
+        lvnCreateInfo.memoryInfo.memoryBindingCount = 1;
+    }
+
+    lvn::createContext(&lvnCreateInfo);
+
+    std::vector<LvnCommandList*> commandLists(s_ObjectCount);
+    benchmark("memory pool", name, s_ObjectCount * s_Rounds * 2, [&]()
+    {
+        uint64_t sum = 0;
+        for (uint32_t round = 0; round < s_Rounds; round++)
+        {
+            for (uint32_t i = 0; i < s_ObjectCount; i++)
+            {
+                lvn::createCommandList(&commandLists[i]);
+                sum += reinterpret_cast<uintptr_t>(commandLists[i]) & 0xff;
+            }
+
+            for (uint32_t i = 0; i < s_ObjectCount; i++)
+                lvn::destroyCommandList(commandLists[i]);
+        }
+        return sum;
+    });
+
+    lvn::terminateContext();
+}
+
+
+static void writeResults(const char* filepath)
+{
+    FILE* fileptr = fopen(filepath, "w");
+    if (!fileptr)
+    {
+        printf("failed to open %s\n", filepath);
+        return;
+    }
+
+    fprintf(fileptr, "group,name,ns_per_op\n");
+    for (const BenchmarkResult& result : s_Results)
+        fprintf(fileptr, "%s,%s,%.3f\n", result.group, result.name, result.nsPerOp);
+
+    fclose(fileptr);
+}
+
+int main(int argc, char** argv)
+{
+    // the containers allocate through the memory functions of the context
+    LvnContextCreateInfo lvnCreateInfo{};
+    lvn::createContext(&lvnCreateInfo);
+
+    benchmarkVector();
+    benchmarkHashMap();
+    benchmarkArenaList();
+    benchmarkString();
+    benchmarkQueue();
+    benchmarkDrawList();
+
+    lvn::terminateContext();
+
+    // each allocation mode gets its own context
+    benchmarkObjectAllocation("createCommandList individual", Lvn_MemAllocMode_Individual);
+    benchmarkObjectAllocation("createCommandList memory pool", Lvn_MemAllocMode_MemPool);
+
+    if (argc > 1)
+        writeResults(argv[1]);
+
+    printf("checksum: %llu\n", static_cast<unsigned long long>(s_Sink));
+
+    return 0;
+}
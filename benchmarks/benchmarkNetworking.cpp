@@ -0,0 +1,321 @@
+#include <levikno/levikno.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// INFO: runs a loopback server and several clients in one process and reports message rate, round trip latency and bandwidth as json
+//       benchmarkNetworking [--clients N] [--messages N] [--size BYTES] [--rate N] [--tick MS] [--unreliable 0|1]
+//                           [--latency MS] [--jitter MS] [--loss 0.0-1.0] [--port P] [--out results.json]
+//
+//       every client sends --messages packets of --size bytes, --rate per client each millisecond, the server echoes each one back
+//       - the server uses a network thread ticking every --tick ms and answers with socketService and socketSendTo
+//       - the clients send and receive on the main thread with socketSend and socketReceive
+//       - latency, jitter and loss are injected on the clients with LvnSocketSimulation, the latency is added to the
+//         client to server direction and the loss to the server to client direction
+//       - latency is the round trip time of each echoed message, unreliable messages that never come back count as lost
+
+
+static constexpr uint32_t s_ChannelCount = 2;
+static constexpr uint32_t s_MinMessageSize = sizeof(uint64_t) + sizeof(uint32_t) * 2; // send time, client index and sequence
+static constexpr double s_IdleTimeoutSeconds = 2.0; // the run ends when no echo arrives for this long
+
+struct BenchmarkOptions
+{
+    uint32_t clients = 8;
+    uint32_t messages = 2000;
+    uint32_t size = 64;
+    uint32_t rate = 1;
+    uint32_t tick = 1;
+    bool unreliable = false;
+    LvnSocketSimulation simulation = {};
+    uint16_t port = 47410;
+    const char* outPath = nullptr;
+};
+
+struct TimeStats
+{
+    double mean, p50, p90, p95, p99, max;
+};
+
+struct ServerContext
+{
+    LvnSocket* server;
+    LvnPacketFlagBits flags;
+    uint32_t connected;
+};
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions* options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value)
+        {
+            printf("missing value for %s\n", arg);
+            return false;
+        }
+        i++;
+
+        if (!strcmp(arg, "--clients")) options->clients = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--messages")) options->messages = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--size")) options->size = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--rate")) options->rate = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--tick")) options->tick = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--unreliable")) options->unreliable = strtoul(value, nullptr, 10) != 0;
+        else if (!strcmp(arg, "--latency")) options->simulation.latencyMilliseconds = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--jitter")) options->simulation.jitterMilliseconds = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--loss")) options->simulation.packetLoss = strtof(value, nullptr);
+        else if (!strcmp(arg, "--port")) options->port = static_cast<uint16_t>(strtoul(value, nullptr, 10));
+        else if (!strcmp(arg, "--out")) options->outPath = value;
+        else
+        {
+            printf("unknown option: %s\n", arg);
+            return false;
+        }
+    }
+
+    if (options->clients == 0 || options->messages == 0 || options->rate == 0)
+    {
+        printf("--clients, --messages and --rate must be at least 1\n");
+        return false;
+    }
+
+    options->size = std::max(options->size, s_MinMessageSize);
+    return true;
+}
+
+static TimeStats calculateTimeStats(std::vector<double> times)
+{
+    TimeStats stats{};
+    if (times.empty())
+        return stats;
+
+    std::sort(times.begin(), times.end());
+
+    double sum = 0.0;
+    for (double time : times)
+        sum += time;
+
+    auto percentile = [&](double p) { return times[std::min(times.size() - 1, (size_t)(p * (times.size() - 1) + 0.5))]; };
+
+    stats.mean = sum / times.size();
+    stats.p50 = percentile(0.50);
+    stats.p90 = percentile(0.90);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = times.back();
+    return stats;
+}
+
+static void writeTimeStats(FILE* fileptr, const char* name, const TimeStats& stats, bool last)
+{
+    fprintf(fileptr, "    \"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+        name, stats.mean, stats.p50, stats.p90, stats.p95, stats.p99, stats.max, last ? "" : ",");
+}
+
+static uint64_t benchmarkNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// echoes every received message back to the peer that sent it, the packet is only valid during the callback
+static void serverEvent(const LvnSocketEvent* event, void* userData)
+{
+    ServerContext* context = static_cast<ServerContext*>(userData);
+
+    if (event->type == Lvn_SocketEvent_Connect)
+    {
+        context->connected++;
+        return;
+    }
+    if (event->type != Lvn_SocketEvent_Receive)
+        return;
+
+    LvnPacket packet = event->packet;
+    lvn::socketSendTo(context->server, event->peerId, event->channel, &packet, context->flags);
+}
+
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, &options))
+        return 1;
+
+    // the server network thread needs multithreading
+    LvnContextCreateInfo lvnCreateInfo{};
+    lvnCreateInfo.logging.enableLogging = true;
+    lvnCreateInfo.enableMultithreading = true;
+
+    if (lvn::createContext(&lvnCreateInfo) != Lvn_Result_Success)
+        return 1;
+
+    // [Sockets]
+    LvnAddress serverAddress{};
+    serverAddress.host = 0; // any interface
+    serverAddress.port = options.port;
+
+    LvnSocketCreateInfo serverInfo = lvn::configSocketServerInit(serverAddress, options.clients, s_ChannelCount, 0, 0);
+    serverInfo.networkThread = true;
+    serverInfo.networkTickMilliseconds = options.tick;
+    serverInfo.networkQueueCapacity = std::max(1024u, options.clients * options.rate * 64);
+
+    LvnSocket* server = nullptr;
+    if (lvn::createSocket(&server, &serverInfo) != Lvn_Result_Success)
+    {
+        lvn::terminateContext();
+        return 1;
+    }
+
+    ServerContext serverContext{};
+    serverContext.server = server;
+    serverContext.flags = options.unreliable ? Lvn_PacketFlag_Unreliable : Lvn_PacketFlag_Reliable;
+
+    LvnAddress connectAddress{};
+    connectAddress.host = lvn::socketGetHostFromStr("127.0.0.1");
+    connectAddress.port = options.port;
+
+    std::vector<LvnSocket*> clients(options.clients, nullptr);
+    bool connected = true;
+    for (uint32_t i = 0; i < options.clients && connected; i++)
+    {
+        LvnSocketCreateInfo clientInfo = lvn::configSocketClientInit(1, s_ChannelCount, 0, 0);
+        clientInfo.simulation = options.simulation;
+
+        // the network thread answers the handshake while socketConnect waits
+        connected = lvn::createSocket(&clients[i], &clientInfo) == Lvn_Result_Success
+            && lvn::socketConnect(clients[i], &connectAddress, s_ChannelCount, 2000) == Lvn_Result_Success;
+    }
+
+    // the connect events only count the clients the server has seen
+    for (uint64_t waitStart = benchmarkNowNs(); connected && serverContext.connected < options.clients && benchmarkNowNs() - waitStart < 2000000000ull; )
+        lvn::socketService(server, serverEvent, &serverContext, 0);
+
+    if (!connected || serverContext.connected < options.clients)
+    {
+        printf("failed to connect all %u clients to the loopback server on port %u\n", options.clients, options.port);
+
+        for (LvnSocket* client : clients)
+            lvn::destroySocket(client);
+        lvn::destroySocket(server);
+        lvn::terminateContext();
+        return 1;
+    }
+
+    // [Run]
+    std::vector<uint8_t> message(options.size, 0);
+    std::vector<uint32_t> sent(options.clients, 0);
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<size_t>(options.clients) * options.messages);
+
+    const uint64_t total = static_cast<uint64_t>(options.clients) * options.messages;
+    const uint64_t start = benchmarkNowNs();
+    uint64_t lastSendTick = 0;
+    uint64_t lastEcho = start;
+    uint64_t totalSent = 0;
+
+    while (latencies.size() < total && (benchmarkNowNs() - lastEcho) * 1e-9 < s_IdleTimeoutSeconds)
+    {
+        // each client sends --rate messages every millisecond until it has sent them all
+        const uint64_t sendTick = (benchmarkNowNs() - start) / 1000000;
+        if (totalSent < total && (sendTick != lastSendTick || totalSent == 0))
+        {
+            lastSendTick = sendTick;
+
+            for (uint32_t i = 0; i < options.clients; i++)
+            {
+                for (uint32_t j = 0; j < options.rate && sent[i] < options.messages; j++)
+                {
+                    uint64_t sendTime = benchmarkNowNs();
+                    memcpy(message.data(), &sendTime, sizeof(uint64_t));
+                    memcpy(message.data() + sizeof(uint64_t), &i, sizeof(uint32_t));
+                    memcpy(message.data() + sizeof(uint64_t) + sizeof(uint32_t), &sent[i], sizeof(uint32_t));
+
+                    LvnPacket packet{};
+                    packet.data = message.data();
+                    packet.size = message.size();
+                    lvn::socketSend(clients[i], 0, &packet, serverContext.flags);
+
+                    sent[i]++;
+                    totalSent++;
+                }
+            }
+        }
+
+        lvn::socketService(server, serverEvent, &serverContext, 0);
+
+        for (LvnSocket* client : clients)
+        {
+            LvnPacket packet{};
+            while (lvn::socketReceive(client, &packet, 0) == Lvn_Result_Success)
+            {
+                uint64_t sendTime;
+                memcpy(&sendTime, packet.data, sizeof(uint64_t));
+                lastEcho = benchmarkNowNs();
+                latencies.push_back((lastEcho - sendTime) * 1e-6);
+                lvn::socketPacketRelease(&packet);
+            }
+        }
+    }
+
+    const double seconds = (lastEcho - start) * 1e-9;
+
+    // bandwidth is the payload the server sent and received, enet headers and acknowledgements are not counted
+    uint64_t serverBytes = 0;
+    for (uint32_t i = 0; i < lvn::socketGetPeerCount(server); i++)
+    {
+        LvnSocketPeerInfo peerInfo{};
+        if (lvn::socketGetPeerInfo(server, i, &peerInfo) == Lvn_Result_Success)
+            serverBytes += peerInfo.bytesSent + peerInfo.bytesReceived;
+    }
+
+    uint32_t roundTripTime = 0;
+    LvnSocketPeerInfo clientInfo{};
+    if (lvn::socketGetPeerInfo(clients[0], 0, &clientInfo) == Lvn_Result_Success)
+        roundTripTime = clientInfo.roundTripTime;
+
+    TimeStats latencyStats = calculateTimeStats(latencies);
+
+    // [Results]
+    FILE* fileptr = options.outPath ? fopen(options.outPath, "w") : stdout;
+    if (fileptr)
+    {
+        fprintf(fileptr, "{\n");
+        fprintf(fileptr, "    \"clients\": %u,\n", options.clients);
+        fprintf(fileptr, "    \"messagesPerClient\": %u,\n", options.messages);
+        fprintf(fileptr, "    \"messageSize\": %u,\n", options.size);
+        fprintf(fileptr, "    \"reliable\": %s,\n", options.unreliable ? "false" : "true");
+        fprintf(fileptr, "    \"serverTickMs\": %u,\n", options.tick);
+        fprintf(fileptr, "    \"simulatedLatencyMs\": %u,\n", options.simulation.latencyMilliseconds);
+        fprintf(fileptr, "    \"simulatedJitterMs\": %u,\n", options.simulation.jitterMilliseconds);
+        fprintf(fileptr, "    \"simulatedLoss\": %.4f,\n", options.simulation.packetLoss);
+        fprintf(fileptr, "    \"echoed\": %zu,\n", latencies.size());
+        fprintf(fileptr, "    \"lost\": %llu,\n", static_cast<unsigned long long>(total - latencies.size()));
+        fprintf(fileptr, "    \"seconds\": %.4f,\n", seconds);
+        fprintf(fileptr, "    \"messagesPerSecond\": %.1f,\n", seconds > 0.0 ? latencies.size() / seconds : 0.0);
+        fprintf(fileptr, "    \"serverBytesPerSecond\": %.1f,\n", seconds > 0.0 ? serverBytes / seconds : 0.0);
+        fprintf(fileptr, "    \"enetRoundTripMs\": %u,\n", roundTripTime);
+        writeTimeStats(fileptr, "latencyMs", latencyStats, true);
+        fprintf(fileptr, "}\n");
+
+        if (fileptr != stdout)
+            fclose(fileptr);
+    }
+
+    // [Cleanup]
+    for (LvnSocket* client : clients)
+    {
+        lvn::socketDisconnect(client, 100);
+        lvn::destroySocket(client);
+    }
+    lvn::destroySocket(server);
+
+    lvn::terminateContext();
+
+    return 0;
+}
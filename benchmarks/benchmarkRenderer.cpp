@@ -0,0 +1,578 @@
+#include <levikno/levikno.h>
+#include <levikno/lvn_renderer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// INFO: renders a fixed scene into an offscreen framebuffer of a hidden window with vsync off and reports frame times as json
+//       benchmarkRenderer [--api vulkan|opengl] [--scene sprites|rects|text|gltf] [--count N] [--frames N] [--warmup N]
+//                         [--width W] [--height H] [--model file.gltf] [--out results.json]
+//
+//       scenes only depend on the frame index, every run draws the same frames so results can be compared between builds
+//       - frame: time of one whole iteration of the render loop, including waiting for the frame in flight and present
+//       - record: cpu time spent recording the scene into the offscreen framebuffer (draw calls, sorting, uploads, commands)
+//       - gpu: gpu time of the scene measured with renderCmdBeginTimestamp, read back a few frames later
+
+
+#define ARRAY_LEN(x) (sizeof(x) / sizeof(x[0]))
+
+static const char* s_VertexShaderSrc = R"(
+#version 460
+
+layout(location = 0) in vec3 inPos;
+layout(location = 1) in vec3 inNormal;
+
+layout(location = 0) out vec3 fragNormal;
+
+#ifdef VULKAN
+layout(push_constant) uniform PushConstants
+#else
+layout(std140, binding = 15) uniform PushConstants
+#endif
+{
+    mat4 matrix;
+    mat4 model;
+} pc;
+
+void main()
+{
+    gl_Position = pc.matrix * vec4(inPos, 1.0);
+    fragNormal = mat3(pc.model) * inNormal;
+}
+)";
+
+static const char* s_FragmentShaderSrc = R"(
+#version 460
+
+layout(location = 0) out vec4 outColor;
+
+layout(location = 0) in vec3 fragNormal;
+
+void main()
+{
+    float diffuse = max(dot(normalize(fragNormal), normalize(vec3(0.4, 1.0, 0.3))), 0.0);
+    outColor = vec4(vec3(0.15 + diffuse * 0.85), 1.0);
+}
+)";
+
+
+enum BenchmarkScene
+{
+    Benchmark_Scene_Sprites,
+    Benchmark_Scene_Rects,
+    Benchmark_Scene_Text,
+    Benchmark_Scene_Gltf,
+};
+
+struct BenchmarkOptions
+{
+    LvnGraphicsApi graphicsapi = Lvn_GraphicsApi_vulkan;
+    BenchmarkScene scene = Benchmark_Scene_Sprites;
+    const char* sceneName = "sprites";
+    uint32_t count = 10000;
+    uint32_t frames = 1000;
+    uint32_t warmup = 100;
+    uint32_t width = 1280, height = 720;
+    const char* modelPath = "res/models/teapot/teapot.gltf";
+    const char* outPath = nullptr;
+};
+
+struct GltfScene
+{
+    LvnPipeline* pipeline;
+    LvnModel model;
+    LvnVector<LvnMat4> primitiveMatrices; // world matrix of every primitive drawn, in the order of drawablePrimitives
+    LvnVector<LvnPrimitive*> drawablePrimitives;
+};
+
+struct TimeStats
+{
+    double mean, p50, p90, p95, p99, max;
+};
+
+// deterministic random numbers so every run draws the same scene
+static uint32_t benchmarkRandom(uint32_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static float benchmarkRandomFloat(uint32_t* state, float min, float max)
+{
+    return min + (benchmarkRandom(state) & 0xffffff) / (float)0xffffff * (max - min);
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions* options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value)
+        {
+            printf("missing value for %s\n", arg);
+            return false;
+        }
+        i++;
+
+        if (!strcmp(arg, "--api"))
+        {
+            if (!strcmp(value, "vulkan")) options->graphicsapi = Lvn_GraphicsApi_vulkan;
+            else if (!strcmp(value, "opengl")) options->graphicsapi = Lvn_GraphicsApi_opengl;
+            else { printf("unknown graphics api: %s\n", value); return false; }
+        }
+        else if (!strcmp(arg, "--scene"))
+        {
+            if (!strcmp(value, "sprites")) options->scene = Benchmark_Scene_Sprites;
+            else if (!strcmp(value, "rects")) options->scene = Benchmark_Scene_Rects;
+            else if (!strcmp(value, "text")) options->scene = Benchmark_Scene_Text;
+            else if (!strcmp(value, "gltf")) options->scene = Benchmark_Scene_Gltf;
+            else { printf("unknown scene: %s\n", value); return false; }
+            options->sceneName = value;
+        }
+        else if (!strcmp(arg, "--count")) options->count = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--frames")) options->frames = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--warmup")) options->warmup = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--width")) options->width = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--height")) options->height = strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--model")) options->modelPath = value;
+        else if (!strcmp(arg, "--out")) options->outPath = value;
+        else
+        {
+            printf("unknown option: %s\n", arg);
+            return false;
+        }
+    }
+
+    if (options->frames == 0)
+    {
+        printf("--frames must be at least 1\n");
+        return false;
+    }
+
+    return true;
+}
+
+static TimeStats calculateTimeStats(std::vector<double> times)
+{
+    TimeStats stats{};
+    if (times.empty())
+        return stats;
+
+    std::sort(times.begin(), times.end());
+
+    double sum = 0.0;
+    for (double time : times)
+        sum += time;
+
+    auto percentile = [&](double p) { return times[std::min(times.size() - 1, (size_t)(p * (times.size() - 1) + 0.5))]; };
+
+    stats.mean = sum / times.size();
+    stats.p50 = percentile(0.50);
+    stats.p90 = percentile(0.90);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = times.back();
+    return stats;
+}
+
+static void writeTimeStats(FILE* fileptr, const char* name, const TimeStats& stats, bool last)
+{
+    fprintf(fileptr, "    \"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+        name, stats.mean, stats.p50, stats.p90, stats.p95, stats.p99, stats.max, last ? "" : ",");
+}
+
+
+// [2d scenes]
+// drawn with the renderer of the offscreen framebuffer, positions move with the frame index
+
+static void drawSpriteScene(const BenchmarkOptions& options, const LvnSprite& sprite, uint32_t frame, bool sprites)
+{
+    uint32_t seed = 0x2545f491;
+    float halfWidth = options.width * 0.5f, halfHeight = options.height * 0.5f;
+
+    for (uint32_t i = 0; i < options.count; i++)
+    {
+        float x = benchmarkRandomFloat(&seed, -halfWidth, halfWidth);
+        float y = benchmarkRandomFloat(&seed, -halfHeight, halfHeight);
+        float size = benchmarkRandomFloat(&seed, 4.0f, 32.0f);
+        LvnColor color = { (uint8_t)benchmarkRandom(&seed), (uint8_t)benchmarkRandom(&seed), (uint8_t)benchmarkRandom(&seed), 255 };
+
+        float offset = (float)((frame + i) % 64) - 32.0f;
+
+        if (sprites)
+            lvn::drawSprite(sprite, { x + offset, y }, { size, size }, color);
+        else
+            lvn::drawRect({ x + offset, y }, { size, size }, color);
+    }
+}
+
+static void drawTextScene(const BenchmarkOptions& options, const std::vector<std::string>& lines, uint32_t frame)
+{
+    float y = options.height * 0.5f - 16.0f;
+    for (uint32_t i = 0; i < lines.size(); i++)
+    {
+        // lines scroll so the text is laid out and uploaded every frame like a changing log view
+        const std::string& line = lines[(i + frame) % lines.size()];
+        lvn::drawText(line.c_str(), { -options.width * 0.5f, y - i * 12.0f }, { 255, 255, 255, 255 }, 0.5f);
+    }
+}
+
+static std::vector<std::string> createTextLines(uint32_t glyphCount)
+{
+    static const char* s_Text = "The quick brown fox jumps over the lazy dog 0123456789 ";
+    static constexpr uint32_t s_LineLength = 100;
+
+    std::vector<std::string> lines;
+    uint32_t textLength = strlen(s_Text);
+    for (uint32_t glyph = 0; glyph < glyphCount;)
+    {
+        uint32_t length = std::min(s_LineLength, glyphCount - glyph);
+        std::string line;
+        for (uint32_t i = 0; i < length; i++)
+            line += s_Text[(glyph + i) % textLength];
+        lines.push_back(line);
+        glyph += length;
+    }
+
+    return lines;
+}
+
+
+// [gltf scene]
+// count instances of a model in a grid drawn with the low level render commands, one push constant update per primitive
+
+static LvnMat4 nodeWorldMatrix(const LvnModel& model, int32_t index)
+{
+    const LvnNode& node = model.nodes[index];
+    LvnMat4 local = lvn::translate(LvnMat4(1.0f), node.transform.translation) * lvn::quatToMat4(node.transform.rotation) * lvn::scale(LvnMat4(1.0f), node.transform.scale) * node.matrix;
+    return node.parent >= 0 ? nodeWorldMatrix(model, node.parent) * local : local;
+}
+
+static bool createGltfScene(const BenchmarkOptions& options, LvnFrameBuffer* frameBuffer, GltfScene* scene)
+{
+    scene->model = lvn::loadModel(options.modelPath);
+    if (scene->model.meshes.empty())
+    {
+        printf("failed to load model: %s\n", options.modelPath);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < scene->model.nodes.size(); i++)
+    {
+        int32_t mesh = scene->model.nodes[i].mesh;
+        if (mesh < 0)
+            continue;
+
+        LvnMat4 world = nodeWorldMatrix(scene->model, i);
+        for (LvnPrimitive& primitive : scene->model.meshes[mesh].primitives)
+        {
+            scene->drawablePrimitives.push_back(&primitive);
+            scene->primitiveMatrices.push_back(world);
+        }
+    }
+
+    LvnVertexAttribute attributes[] =
+    {
+        { 0, 0, Lvn_AttributeFormat_Vec3_f32, offsetof(LvnVertex, pos) },
+        { 0, 1, Lvn_AttributeFormat_Vec3_f32, offsetof(LvnVertex, normal) },
+    };
+
+    LvnVertexBindingDescription vertexBindingDescription{};
+    vertexBindingDescription.stride = sizeof(LvnVertex);
+    vertexBindingDescription.binding = 0;
+
+    LvnShaderCreateInfo shaderCreateInfo{};
+    shaderCreateInfo.vertexSrc = s_VertexShaderSrc;
+    shaderCreateInfo.fragmentSrc = s_FragmentShaderSrc;
+
+    LvnShader* shader;
+    if (lvn::createShaderFromSrc(&shader, &shaderCreateInfo) != Lvn_Result_Success)
+        return false;
+
+    LvnPushConstantRange pushConstantRange{};
+    pushConstantRange.shaderStage = Lvn_ShaderStage_Vertex;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(LvnMat4) * 2;
+
+    LvnPipelineSpecification pipelineSpec = lvn::configPipelineSpecificationInit();
+    pipelineSpec.depthstencil.enableDepth = true;
+    pipelineSpec.depthstencil.depthOpCompare = Lvn_CompareOp_LessOrEqual;
+
+    LvnPipelineCreateInfo pipelineCreateInfo{};
+    pipelineCreateInfo.pipelineSpecification = &pipelineSpec;
+    pipelineCreateInfo.pVertexAttributes = attributes;
+    pipelineCreateInfo.vertexAttributeCount = ARRAY_LEN(attributes);
+    pipelineCreateInfo.pVertexBindingDescriptions = &vertexBindingDescription;
+    pipelineCreateInfo.vertexBindingDescriptionCount = 1;
+    pipelineCreateInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineCreateInfo.pushConstantRangeCount = 1;
+    pipelineCreateInfo.shader = shader;
+    pipelineCreateInfo.renderPass = lvn::frameBufferGetRenderPass(frameBuffer);
+
+    LvnResult result = lvn::createPipeline(&scene->pipeline, &pipelineCreateInfo);
+    lvn::destroyShader(shader);
+
+    return result == Lvn_Result_Success;
+}
+
+static void destroyGltfScene(GltfScene* scene)
+{
+    if (scene->pipeline)
+        lvn::destroyPipeline(scene->pipeline);
+    lvn::unloadModel(&scene->model);
+}
+
+static void drawGltfScene(const BenchmarkOptions& options, LvnWindow* window, LvnFrameBuffer* frameBuffer, GltfScene* scene, uint32_t frame)
+{
+    uint32_t gridSize = 1;
+    while (gridSize * gridSize < options.count)
+        gridSize++;
+
+    float spacing = 2.5f;
+    float extent = gridSize * spacing;
+
+    LvnMat4 proj = lvn::perspective(lvn::radians(60.0f), (float)options.width / (float)options.height, 0.1f, extent * 4.0f);
+    LvnMat4 view = lvn::lookAt(LvnVec3(0.0f, extent * 0.6f, -extent * 0.9f), LvnVec3(0.0f, 0.0f, 0.0f), LvnVec3(0.0f, 1.0f, 0.0f));
+    LvnMat4 camera = proj * view;
+    float angle = lvn::radians((float)(frame % 360));
+
+    lvn::frameBufferSetClearColor(frameBuffer, 0, 0.1f, 0.1f, 0.1f, 1.0f);
+    lvn::renderCmdBeginFrameBuffer(window, frameBuffer);
+    lvn::renderCmdBindPipeline(window, scene->pipeline);
+
+    for (uint32_t i = 0; i < options.count; i++)
+    {
+        float x = (i % gridSize - gridSize * 0.5f) * spacing;
+        float z = (i / gridSize - gridSize * 0.5f) * spacing;
+        LvnMat4 instance = lvn::translate(LvnMat4(1.0f), LvnVec3(x, 0.0f, z)) * lvn::rotate(LvnMat4(1.0f), angle, LvnVec3(0.0f, 1.0f, 0.0f));
+
+        for (uint32_t j = 0; j < scene->drawablePrimitives.size(); j++)
+        {
+            LvnPrimitive* primitive = scene->drawablePrimitives[j];
+
+            LvnMat4 matrices[2];
+            matrices[1] = instance * scene->primitiveMatrices[j];
+            matrices[0] = camera * matrices[1];
+
+            lvn::renderCmdPushConstants(window, scene->pipeline, Lvn_ShaderStage_Vertex, 0, sizeof(matrices), matrices);
+            lvn::renderCmdBindVertexBuffer(window, 0, 1, &primitive->buffer, nullptr);
+            lvn::renderCmdBindIndexBuffer(window, primitive->buffer, primitive->indexOffset);
+            lvn::renderCmdDrawIndexed(window, primitive->indexCount);
+        }
+    }
+
+    lvn::renderCmdEndFrameBuffer(window, frameBuffer);
+}
+
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, &options))
+        return 1;
+
+    LvnContextCreateInfo lvnCreateInfo{};
+    lvnCreateInfo.logging.enableLogging = true;
+    lvnCreateInfo.windowapi = Lvn_WindowApi_glfw;
+    lvnCreateInfo.graphicsapi = options.graphicsapi;
+
+    if (lvn::createContext(&lvnCreateInfo) != Lvn_Result_Success)
+        return 1;
+
+    // [Window and offscreen target]
+    // the window only presents, the scene is rendered into the framebuffer so its size does not depend on the display
+    LvnWindowCreateInfo windowInfo{};
+    windowInfo.title = "benchmarkRenderer";
+    windowInfo.width = 320;
+    windowInfo.height = 180;
+    windowInfo.resizable = false;
+    windowInfo.hidden = true;
+    windowInfo.vSync = false;
+    windowInfo.presentMode = Lvn_PresentMode_Immediate;
+
+    if (lvn::renderInit(&windowInfo) != Lvn_Result_Success)
+    {
+        lvn::terminateContext();
+        return 1;
+    }
+
+    LvnWindow* window = lvn::getRendererWindow();
+    LvnRenderer* windowRenderer = lvn::renderGetCurrent();
+
+    LvnDepthImageFormat depthFormats[] =
+    {
+        Lvn_DepthImageFormat_Depth32Stencil8, Lvn_DepthImageFormat_Depth24Stencil8, Lvn_DepthImageFormat_Depth32, Lvn_DepthImageFormat_Depth16,
+    };
+
+    LvnFrameBufferColorAttachment colorAttachment = { 0, Lvn_ColorImageFormat_RGBA8 };
+    LvnFrameBufferDepthAttachment depthAttachment = { 1, lvn::findSupportedDepthImageFormat(depthFormats, ARRAY_LEN(depthFormats)) };
+
+    LvnFrameBufferCreateInfo frameBufferCreateInfo{};
+    frameBufferCreateInfo.width = options.width;
+    frameBufferCreateInfo.height = options.height;
+    frameBufferCreateInfo.sampleCount = Lvn_SampleCount_1_Bit;
+    frameBufferCreateInfo.pColorAttachments = &colorAttachment;
+    frameBufferCreateInfo.colorAttachmentCount = 1;
+    frameBufferCreateInfo.depthAttachment = &depthAttachment;
+    frameBufferCreateInfo.textureMode = Lvn_TextureMode_ClampToEdge;
+    frameBufferCreateInfo.textureFilter = Lvn_TextureFilter_Linear;
+
+    LvnFrameBuffer* frameBuffer;
+    lvn::createFrameBuffer(&frameBuffer, &frameBufferCreateInfo);
+
+    LvnRendererCreateInfo rendererCreateInfo{};
+    rendererCreateInfo.window = window;
+    rendererCreateInfo.frameBuffer = frameBuffer;
+
+    LvnRenderer* offscreenRenderer;
+    lvn::createRenderer(&offscreenRenderer, &rendererCreateInfo);
+
+    // [Scene resources]
+    LvnSprite sprite{};
+    std::vector<std::string> textLines;
+    GltfScene gltfScene{};
+    bool sceneCreated = true;
+
+    if (options.scene == Benchmark_Scene_Sprites)
+    {
+        LvnTextureCreateInfo textureCreateInfo{};
+        textureCreateInfo.imageData = lvn::loadImageData("res/images/debug.png", 4);
+        textureCreateInfo.format = Lvn_TextureFormat_Unorm;
+        textureCreateInfo.minFilter = Lvn_TextureFilter_Linear;
+        textureCreateInfo.magFilter = Lvn_TextureFilter_Linear;
+        textureCreateInfo.wrapS = Lvn_TextureMode_Repeat;
+        textureCreateInfo.wrapT = Lvn_TextureMode_Repeat;
+        sprite = lvn::createSprite(textureCreateInfo, { 0.0f, 0.0f, 1.0f, 1.0f });
+    }
+    else if (options.scene == Benchmark_Scene_Text)
+    {
+        textLines = createTextLines(options.count);
+    }
+    else if (options.scene == Benchmark_Scene_Gltf)
+    {
+        sceneCreated = createGltfScene(options, frameBuffer, &gltfScene);
+    }
+
+    // [Render loop]
+    std::vector<double> frameTimes, recordTimes, gpuTimes;
+    frameTimes.reserve(options.frames);
+    recordTimes.reserve(options.frames);
+    gpuTimes.reserve(options.frames);
+
+    uint64_t drawCalls = 0, vertices = 0;
+    uint32_t totalFrames = options.warmup + options.frames;
+    auto previous = std::chrono::steady_clock::now();
+
+    for (uint32_t frame = 0; sceneCreated && frame < totalFrames && lvn::renderWindowOpen(); frame++)
+    {
+        lvn::windowPollEvents();
+
+        lvn::renderSetCurrent(windowRenderer);
+        lvn::drawBegin();
+        lvn::drawClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+        auto recordStart = std::chrono::steady_clock::now();
+        lvn::renderCmdBeginTimestamp(window, "scene");
+
+        if (options.scene == Benchmark_Scene_Gltf)
+        {
+            drawGltfScene(options, window, frameBuffer, &gltfScene, frame);
+        }
+        else
+        {
+            lvn::renderSetCurrent(offscreenRenderer);
+            lvn::drawBegin();
+            lvn::drawClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+
+            if (options.scene == Benchmark_Scene_Text)
+                drawTextScene(options, textLines, frame);
+            else
+                drawSpriteScene(options, sprite, frame, options.scene == Benchmark_Scene_Sprites);
+
+            lvn::drawEnd();
+            lvn::renderSetCurrent(windowRenderer);
+        }
+
+        lvn::renderCmdEndTimestamp(window);
+        auto recordEnd = std::chrono::steady_clock::now();
+
+        lvn::drawEnd();
+
+        auto now = std::chrono::steady_clock::now();
+        double frameMs = std::chrono::duration<double, std::milli>(now - previous).count();
+        previous = now;
+
+        if (frame < options.warmup)
+            continue;
+
+        frameTimes.push_back(frameMs);
+        recordTimes.push_back(std::chrono::duration<double, std::milli>(recordEnd - recordStart).count());
+
+        // the timestamps are from the latest frame the gpu finished, a few frames behind
+        LvnGpuTimestamp timestamps[8];
+        uint32_t timestampCount = lvn::renderGetTimestamps(window, timestamps, ARRAY_LEN(timestamps));
+        for (uint32_t i = 0; i < timestampCount; i++)
+        {
+            if (!strcmp(timestamps[i].name, "scene"))
+                gpuTimes.push_back(timestamps[i].milliseconds);
+        }
+
+        LvnFrameStats frameStats = lvn::getFrameStats();
+        drawCalls += frameStats.drawCalls;
+        vertices += frameStats.vertices;
+    }
+
+    // [Results]
+    if (!frameTimes.empty())
+    {
+        TimeStats frameStats = calculateTimeStats(frameTimes);
+        TimeStats recordStats = calculateTimeStats(recordTimes);
+        TimeStats gpuStats = calculateTimeStats(gpuTimes);
+
+        printf("%s %s x%u, %zu frames | frame p50 %.3f ms p99 %.3f ms | record p50 %.3f ms | gpu p50 %.3f ms\n",
+            options.graphicsapi == Lvn_GraphicsApi_vulkan ? "vulkan" : "opengl", options.sceneName, options.count, frameTimes.size(),
+            frameStats.p50, frameStats.p99, recordStats.p50, gpuStats.p50);
+
+        FILE* fileptr = options.outPath ? fopen(options.outPath, "w") : stdout;
+        if (fileptr)
+        {
+            fprintf(fileptr, "{\n");
+            fprintf(fileptr, "    \"api\": \"%s\",\n", options.graphicsapi == Lvn_GraphicsApi_vulkan ? "vulkan" : "opengl");
+            fprintf(fileptr, "    \"scene\": \"%s\",\n", options.sceneName);
+            fprintf(fileptr, "    \"count\": %u,\n", options.count);
+            fprintf(fileptr, "    \"frames\": %zu,\n", frameTimes.size());
+            fprintf(fileptr, "    \"width\": %u,\n", options.width);
+            fprintf(fileptr, "    \"height\": %u,\n", options.height);
+            fprintf(fileptr, "    \"drawCallsPerFrame\": %.1f,\n", (double)drawCalls / frameTimes.size());
+            fprintf(fileptr, "    \"verticesPerFrame\": %.1f,\n", (double)vertices / frameTimes.size());
+            writeTimeStats(fileptr, "frameMs", frameStats, false);
+            writeTimeStats(fileptr, "recordMs", recordStats, false);
+            writeTimeStats(fileptr, "gpuMs", gpuStats, true);
+            fprintf(fileptr, "}\n");
+
+            if (fileptr != stdout)
+                fclose(fileptr);
+        }
+    }
+
+    // [Cleanup]
+    if (options.scene == Benchmark_Scene_Sprites)
+        lvn::destroySprite(sprite);
+    else if (options.scene == Benchmark_Scene_Gltf)
+        destroyGltfScene(&gltfScene);
+
+    lvn::destroyRenderer(offscreenRenderer);
+    lvn::destroyFrameBuffer(frameBuffer);
+
+    lvn::terminateContext();
+
+    return sceneCreated ? 0 : 1;
+}
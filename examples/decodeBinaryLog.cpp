@@ -0,0 +1,54 @@
+#include <cstdio>
+#include <levikno/levikno.h>
+
+// INFO: this example shows how to write log messages to a binary log file and decode it back to text
+//       run with a file path to decode an existing binary log: decodeBinaryLog <file.lvnlog> [output.txt] [log pattern]
+
+static void writeSampleLog(const char* filename)
+{
+    LvnContextCreateInfo lvnCreateInfo{};
+    lvnCreateInfo.logging.enableLogging = true;
+    lvnCreateInfo.logging.disableCoreLogging = true;
+
+    lvn::createContext(&lvnCreateInfo);
+
+    // NOTE: messages of the client logger now go to the binary file only, they are not formatted or printed
+    lvn::logSetBinaryFileConfig(lvn::logGetClientLogger(), true, filename);
+
+    for (int i = 0; i < 1000; i++)
+        LVN_INFO("frame %d took %.3f ms, %zu draw calls", i, 16.6 + i * 0.001, (size_t)(i % 40));
+
+    LVN_WARN("texture not found: %s", "res/images/missing.png");
+    LVN_ERROR("error message, code: %d", 2);
+
+    // the file is complete once the context is terminated
+    lvn::terminateContext();
+}
+
+int main(int argc, char** argv)
+{
+    const char* inpath = argc > 1 ? argv[1] : "binaryLogExample.lvnlog";
+    const char* outpath = argc > 2 ? argv[2] : nullptr;
+    const char* pattern = argc > 3 ? argv[3] : nullptr;
+
+    if (argc <= 1)
+        writeSampleLog(inpath);
+
+    // [Decode]
+    // decoding happens offline, only a context with logging enabled is needed
+    LvnContextCreateInfo lvnCreateInfo{};
+    lvnCreateInfo.logging.enableLogging = true;
+
+    lvn::createContext(&lvnCreateInfo);
+
+    // the log patterns of the logger passed in are used for every message, the logger name is taken from the file
+    LvnLogger* logger = lvn::logGetClientLogger();
+    if (pattern)
+        lvn::logSetPatternFormat(logger, pattern);
+
+    LvnResult result = lvn::logDecodeBinaryFile(logger, inpath, outpath);
+
+    lvn::terminateContext();
+
+    return result == Lvn_Result_Success ? 0 : 1;
+}
@@ -137,5 +137,11 @@ int main(int argc, char** argv)
     lvn::destroyLogger(l5);
     lvn::destroyLogger(l6);
 
+
+    // memory blocks created after the base memory block stay allocated until the context is terminated,
+    // memPoolTrim frees the blocks that have no objects left in them (eg. after unloading a level)
+    // the base memory block is always kept
+    lvn::memPoolTrim();
+
     lvn::terminateContext();
 }
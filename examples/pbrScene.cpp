@@ -1,7 +1,6 @@
 #include <levikno/levikno.h>
 
 #include <vector>
-#include <unordered_map>
 
 #define ARRAY_LEN(x) (sizeof(x) / sizeof(x[0]))
 
@@ -407,12 +406,9 @@ bool windowFrameBufferResize(LvnWindowFramebufferResizeEvent* e, void* userData)
 bool mouseScroll(LvnMouseScrolledEvent* e, void* pUserData);
 void eventsCallbackFn(LvnEvent* e);
 void scaleInput(LvnWindow* window, float* scale, float dt);
-LvnMat4 getNodeMatrix(const LvnModel& model, const LvnNode& node);
-void updateJoints(const LvnModel& model, const LvnNode& node);
-void updateAnimation(LvnModel& model, float dt);
 void updateNodeDescriptorSets(LvnModel& model, const std::vector<int32_t>& nodes);
 void updateNodeMatrix(LvnModel& model, const std::vector<int32_t>& nodes, std::vector<UniformData>& objectData, CameraView camera);
-void drawNode(LvnModel& model, const std::vector<int32_t>& nodes);
+void drawNode(LvnModel& model, const std::vector<int32_t>& nodes, const CameraView& camera);
 
 static float s_CameraSpeed = 5.0f;
 static bool s_CameraFirstClick = true;
@@ -672,127 +668,7 @@ void scaleInput(LvnWindow* window, float* scale, float dt)
     if (*scale <= 0.0) *scale = 0.01f;
 }
 
-LvnMat4 getNodeMatrix(const LvnModel& model, const LvnNode& node)
-{
-    LvnMat4 nodeMatrix = lvn::translate(LvnMat4(1.0f), node.transform.translation) * lvn::quatToMat4(node.transform.rotation) * lvn::scale(LvnMat4(1.0f), node.transform.scale) * node.matrix;
-    if (node.parent >= 0)
-    {
-        const LvnNode& parrent = model.nodes[node.parent];
-        nodeMatrix = getNodeMatrix(model, parrent) * nodeMatrix;
-    }
-
-    return nodeMatrix;
-}
-
-static std::vector<LvnMat4> s_JointMatrices;
-static std::unordered_map<int, LvnBuffer*> s_CacheSkinSSBO; // keep track of skins that are already updated so that they arent updated again
-
-void updateJoints(const LvnModel& model, const LvnNode& node)
-{
-    if (node.skin >= 0)
-    {
-        const LvnSkin& skin = lvnmodel.skins[node.skin];
-
-        if (s_CacheSkinSSBO.find(node.skin) != s_CacheSkinSSBO.end())
-            return;
-        else
-            s_CacheSkinSSBO[node.skin] = skin.ssbo;
-
-        s_JointMatrices.resize(skin.joints.size());
-        for (size_t i = 0; i < skin.joints.size(); i++)
-        {
-            s_JointMatrices[i] = getNodeMatrix(model, model.nodes[skin.joints[i]]) * skin.inverseBindMatrices[i];
-        }
-
-        lvn::bufferUpdateData(skin.ssbo, s_JointMatrices.data(), s_JointMatrices.size() * sizeof(LvnMat4), 0);
-    }
-}
-
-void updateAnimation(LvnModel& model, float dt)
-{
-    if (model.animations.empty())
-        return;
-
-    LvnAnimation& animation = model.animations[0];
-    animation.currentTime += dt;
-
-    if (animation.currentTime > animation.end)
-        animation.currentTime -= animation.end;
-
-    for (const LvnAnimationChannel& channel : animation.channels)
-    {
-        for (uint32_t i = 0; i < channel.keyFrames.size(); i++)
-        {
-            if (channel.interpolation == Lvn_InterpolationMode_Linear)
-            {
-                if ((animation.currentTime >= channel.keyFrames[i]) && (animation.currentTime <= channel.keyFrames[i + 1]))
-                {
-                    float a = (animation.currentTime - channel.keyFrames[i]) / (channel.keyFrames[i + 1] - channel.keyFrames[i]);
-                    if (channel.path == Lvn_AnimationPath_Translation)
-                    {
-                        model.nodes[channel.node].transform.translation = lvn::lerp(channel.outputs[i], channel.outputs[i + 1], a);
-                        break;
-                    }
-                    else if (channel.path == Lvn_AnimationPath_Rotation)
-                    {
-                        LvnQuat q1;
-                        q1.x = channel.outputs[i].x;
-                        q1.y = channel.outputs[i].y;
-                        q1.z = channel.outputs[i].z;
-                        q1.w = channel.outputs[i].w;
-
-                        LvnQuat q2;
-                        q2.x = channel.outputs[i + 1].x;
-                        q2.y = channel.outputs[i + 1].y;
-                        q2.z = channel.outputs[i + 1].z;
-                        q2.w = channel.outputs[i + 1].w;
-
-                        model.nodes[channel.node].transform.rotation = lvn::normalize(lvn::slerp(q1, q2, a));
-                        break;
-                    }
-                    else if (channel.path == Lvn_AnimationPath_Scale)
-                    {
-                        model.nodes[channel.node].transform.scale = lvn::lerp(channel.outputs[i], channel.outputs[i + 1], a);
-                        break;
-                    }
-                }
-            }
-            else if (channel.interpolation == Lvn_InterpolationMode_Step)
-            {
-                if ((animation.currentTime >= channel.keyFrames[i]) && (animation.currentTime <= channel.keyFrames[i + 1]))
-                {
-                    if (channel.path == Lvn_AnimationPath_Translation)
-                    {
-                        model.nodes[channel.node].transform.translation = channel.outputs[i];
-                        break;
-                    }
-                    else if (channel.path == Lvn_AnimationPath_Rotation)
-                    {
-                        LvnQuat q1;
-                        q1.x = channel.outputs[i].x;
-                        q1.y = channel.outputs[i].y;
-                        q1.z = channel.outputs[i].z;
-                        q1.w = channel.outputs[i].w;
-
-                        model.nodes[channel.node].transform.rotation = q1;
-                        break;
-                    }
-                    else if (channel.path == Lvn_AnimationPath_Scale)
-                    {
-                        model.nodes[channel.node].transform.scale = channel.outputs[i];
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    s_CacheSkinSSBO.clear();
-
-    for (auto& skin : model.skins)
-        for (auto& node : skin.joints)
-            updateJoints(model, model.nodes[node]);
-}
+static std::vector<LvnMat4> s_NodeMatrices; // world matrices of the nodes for the current frame
 
 uint32_t buffOffset = 0;
 void updateNodeDescriptorSets(LvnModel& model, const std::vector<int32_t>& nodes)
@@ -875,7 +751,7 @@ void updateNodeMatrix(LvnModel& model, const std::vector<int32_t>& nodes, std::v
                 UniformData data{};
                 LvnMat4 scaleMat = lvn::scale(LvnMat4(1.0f), LvnVec3(s_Scale));
                 data.matrix = camera.matrix;
-                data.model = scaleMat * getNodeMatrix(model, node);
+                data.model = scaleMat * s_NodeMatrices[nodeIndex];
                 objectData.push_back(data);
             }
         }
@@ -884,24 +760,31 @@ void updateNodeMatrix(LvnModel& model, const std::vector<int32_t>& nodes, std::v
     }
 }
 
-void drawNode(LvnModel& model, const std::vector<int32_t>& nodes)
+void drawNode(LvnModel& model, const std::vector<int32_t>& nodes, const CameraView& camera)
 {
+    float screenScale = lvn::lodGetScreenScale(lvn::radians(camera.data.fov), (float)lvn::windowGetSize(window).height);
+
     for (const int32_t& nodeIndex : nodes)
     {
         const LvnNode& node = model.nodes[nodeIndex];
         if (node.mesh >= 0)
         {
+            LvnMat4 scaleMat = lvn::scale(LvnMat4(1.0f), LvnVec3(s_Scale));
+            LvnMat4 nodeMatrix = scaleMat * s_NodeMatrices[nodeIndex];
+
             for (auto& primitive : model.meshes[node.mesh].primitives)
             {
+                LvnPrimitiveLod lod = lvn::primitiveSelectLod(primitive, nodeMatrix, camera.position, screenScale);
+
                 lvn::renderCmdBindDescriptorSets(window, pipeline, 0, 1, &primitive.descriptorSet);
                 lvn::renderCmdBindVertexBuffer(window, 0, 1, &primitive.buffer, 0);
-                lvn::renderCmdBindIndexBuffer(window, primitive.buffer, primitive.indexOffset);
+                lvn::renderCmdBindIndexBuffer(window, primitive.buffer, lod.indexOffset);
 
-                lvn::renderCmdDrawIndexed(window, primitive.indexCount);
+                lvn::renderCmdDrawIndexed(window, lod.indexCount);
             }
         }
 
-        drawNode(model, std::vector<int32_t>(node.children.data(), node.children.data() + node.children.size()));
+        drawNode(model, std::vector<int32_t>(node.children.data(), node.children.data() + node.children.size()), camera);
     }
 }
 
@@ -932,7 +815,7 @@ int main()
     lvn::windowSetVSync(window, true);
 
     // load model
-    lvnmodel = lvn::loadModel("res/models/teapot/teapot.gltf");
+    lvnmodel = lvn::loadModel("res/models/teapot/teapot.gltf", LvnVertexLayout{ Lvn_VertexAttributeFlag_All, false }, Lvn_MeshOptimizeFlag_All);
 
 
     // create framebuffer
@@ -1333,7 +1216,9 @@ int main()
         lvn::frameBufferSetClearColor(frameBuffer, 0, 0.0f, 0.0f, 0.0f, 1.0f);
 
         objectData.clear();
-        updateAnimation(lvnmodel, dt);
+        lvn::modelUpdateAnimation(&lvnmodel, 0, dt);
+        s_NodeMatrices.resize(lvnmodel.nodes.size());
+        lvn::modelGetNodeMatrices(lvnmodel, s_NodeMatrices.data());
         updateNodeMatrix(lvnmodel, roots, objectData, camera);
         lvn::bufferUpdateData(matrixUniformBuffer, objectData.data(), objectData.size() * sizeof(UniformData), 0);
 
@@ -1348,7 +1233,7 @@ int main()
 
         lvn::renderCmdBindPipeline(window, pipeline);
 
-        drawNode(lvnmodel, roots);
+        drawNode(lvnmodel, roots, camera);
 
         // draw cubemap
         lvn::mat4 projection = camera.projectionMatrix;
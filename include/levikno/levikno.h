@@ -27,6 +27,7 @@
 // [SECTION]: Functions
 // -- [SUBSECT]: Core Functions
 // -- [SUBSECT]: Logging Functions
+// -- [SUBSECT]: Profiling Functions
 // -- [SUBSECT]: Event Functions
 // -- [SUBSECT]: Input Functions
 // -- [SUBSECT]: Graphics Functions
@@ -177,6 +178,30 @@
 #define LVN_PI ((float)M_PI)
 #define LVN_PI_EXACT (22.0/7.0) /* 3.1415... */
 
+// uniform block binding the opengl backend uses to emulate push constants, shaders not compiled for vulkan declare their push constant block as a std140 uniform block at this binding
+#define LVN_OPENGL_PUSH_CONSTANT_BINDING 15
+
+// bindings of the material storage buffer and texture array in the descriptor layout of a material table
+#define LVN_MATERIAL_TABLE_MATERIAL_BINDING 11
+#define LVN_MATERIAL_TABLE_TEXTURE_BINDING 12
+
+// most memory heaps reported in LvnGraphicsMemoryStats, matches VK_MAX_MEMORY_HEAPS
+#define LVN_MAX_MEMORY_HEAPS 16
+
+// completed frames kept for lvn::getFrameStatsHistory
+#define LVN_FRAME_STATS_HISTORY 256
+
+// factor LvnVector multiplies its capacity by when an insert runs out of space, can be defined before including levikno.h
+#ifndef LVN_VECTOR_GROWTH_FACTOR
+    #define LVN_VECTOR_GROWTH_FACTOR 2.0
+#endif
+
+// alignment of memory pool blocks and lvn::getAlignedAllocator allocations
+#define LVN_CACHE_LINE_SIZE 64
+
+// lvn::memAllocAligned allocations of at least this size are mapped directly from the os and backed by huge pages when available
+#define LVN_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
 
 // -- [SUBSECT]: Log Defines
 // ------------------------------------------------------------
@@ -230,21 +255,109 @@
 #define LVN_LOG_COLOR_RESET                     "\x1b[0m"
 
 
-// Core Log macros
-#define LVN_CORE_TRACE(...)                     ::lvn::logMessageTrace(lvn::logGetCoreLogger(), ##__VA_ARGS__)
-#define LVN_CORE_DEBUG(...)                     ::lvn::logMessageDebug(lvn::logGetCoreLogger(), ##__VA_ARGS__)
-#define LVN_CORE_INFO(...)                      ::lvn::logMessageInfo(lvn::logGetCoreLogger(), ##__VA_ARGS__)
-#define LVN_CORE_WARN(...)                      ::lvn::logMessageWarn(lvn::logGetCoreLogger(), ##__VA_ARGS__)
-#define LVN_CORE_ERROR(...)                     ::lvn::logMessageError(lvn::logGetCoreLogger(), ##__VA_ARGS__)
-#define LVN_CORE_FATAL(...)                     ::lvn::logMessageFatal(lvn::logGetCoreLogger(), ##__VA_ARGS__)
+// log levels as numbers for the preprocessor, same values as LvnLogLevel
+#define LVN_LOG_LEVEL_TRACE                     1
+#define LVN_LOG_LEVEL_DEBUG                     2
+#define LVN_LOG_LEVEL_INFO                      3
+#define LVN_LOG_LEVEL_WARN                      4
+#define LVN_LOG_LEVEL_ERROR                     5
+#define LVN_LOG_LEVEL_FATAL                     6
+#define LVN_LOG_LEVEL_OFF                       7
+
+// log macros below this level expand to nothing and their arguments are never evaluated,
+// define it before including levikno.h (eg. -DLVN_LOG_ACTIVE_LEVEL=3 to keep info and above), release builds strip trace messages by default
+#ifndef LVN_LOG_ACTIVE_LEVEL
+    #ifdef LVN_CONFIG_DEBUG
+        #define LVN_LOG_ACTIVE_LEVEL            LVN_LOG_LEVEL_TRACE
+    #else
+        #define LVN_LOG_ACTIVE_LEVEL            LVN_LOG_LEVEL_DEBUG
+    #endif
+#endif
+
+// the level of the logger is checked before the message arguments are evaluated, messages the logger drops cost one call
+#define LVN_LOG_IF(logger, level, func, ...)    (::lvn::logShouldOutput(logger, level) ? func(logger, ##__VA_ARGS__) : (void)0)
+
+#if LVN_LOG_ACTIVE_LEVEL <= LVN_LOG_LEVEL_TRACE
+    #define LVN_CORE_TRACE(...)                 LVN_LOG_IF(::lvn::logGetCoreLogger(), Lvn_LogLevel_Trace, ::lvn::logMessageTrace, ##__VA_ARGS__)
+    #define LVN_TRACE(...)                      LVN_LOG_IF(::lvn::logGetClientLogger(), Lvn_LogLevel_Trace, ::lvn::logMessageTrace, ##__VA_ARGS__)
+#else
+    #define LVN_CORE_TRACE(...)                 ((void)0)
+    #define LVN_TRACE(...)                      ((void)0)
+#endif
+
+#if LVN_LOG_ACTIVE_LEVEL <= LVN_LOG_LEVEL_DEBUG
+    #define LVN_CORE_DEBUG(...)                 LVN_LOG_IF(::lvn::logGetCoreLogger(), Lvn_LogLevel_Debug, ::lvn::logMessageDebug, ##__VA_ARGS__)
+    #define LVN_DEBUG(...)                      LVN_LOG_IF(::lvn::logGetClientLogger(), Lvn_LogLevel_Debug, ::lvn::logMessageDebug, ##__VA_ARGS__)
+#else
+    #define LVN_CORE_DEBUG(...)                 ((void)0)
+    #define LVN_DEBUG(...)                      ((void)0)
+#endif
+
+#if LVN_LOG_ACTIVE_LEVEL <= LVN_LOG_LEVEL_INFO
+    #define LVN_CORE_INFO(...)                  LVN_LOG_IF(::lvn::logGetCoreLogger(), Lvn_LogLevel_Info, ::lvn::logMessageInfo, ##__VA_ARGS__)
+    #define LVN_INFO(...)                       LVN_LOG_IF(::lvn::logGetClientLogger(), Lvn_LogLevel_Info, ::lvn::logMessageInfo, ##__VA_ARGS__)
+#else
+    #define LVN_CORE_INFO(...)                  ((void)0)
+    #define LVN_INFO(...)                       ((void)0)
+#endif
+
+#if LVN_LOG_ACTIVE_LEVEL <= LVN_LOG_LEVEL_WARN
+    #define LVN_CORE_WARN(...)                  LVN_LOG_IF(::lvn::logGetCoreLogger(), Lvn_LogLevel_Warn, ::lvn::logMessageWarn, ##__VA_ARGS__)
+    #define LVN_WARN(...)                       LVN_LOG_IF(::lvn::logGetClientLogger(), Lvn_LogLevel_Warn, ::lvn::logMessageWarn, ##__VA_ARGS__)
+#else
+    #define LVN_CORE_WARN(...)                  ((void)0)
+    #define LVN_WARN(...)                       ((void)0)
+#endif
+
+#if LVN_LOG_ACTIVE_LEVEL <= LVN_LOG_LEVEL_ERROR
+    #define LVN_CORE_ERROR(...)                 LVN_LOG_IF(::lvn::logGetCoreLogger(), Lvn_LogLevel_Error, ::lvn::logMessageError, ##__VA_ARGS__)
+    #define LVN_ERROR(...)                      LVN_LOG_IF(::lvn::logGetClientLogger(), Lvn_LogLevel_Error, ::lvn::logMessageError, ##__VA_ARGS__)
+#else
+    #define LVN_CORE_ERROR(...)                 ((void)0)
+    #define LVN_ERROR(...)                      ((void)0)
+#endif
+
+#if LVN_LOG_ACTIVE_LEVEL <= LVN_LOG_LEVEL_FATAL
+    #define LVN_CORE_FATAL(...)                 LVN_LOG_IF(::lvn::logGetCoreLogger(), Lvn_LogLevel_Fatal, ::lvn::logMessageFatal, ##__VA_ARGS__)
+    #define LVN_FATAL(...)                      LVN_LOG_IF(::lvn::logGetClientLogger(), Lvn_LogLevel_Fatal, ::lvn::logMessageFatal, ##__VA_ARGS__)
+#else
+    #define LVN_CORE_FATAL(...)                 ((void)0)
+    #define LVN_FATAL(...)                      ((void)0)
+#endif
 
-// Client Log macros
-#define LVN_TRACE(...)                          ::lvn::logMessageTrace(lvn::logGetClientLogger(), ##__VA_ARGS__)
-#define LVN_DEBUG(...)                          ::lvn::logMessageDebug(lvn::logGetClientLogger(), ##__VA_ARGS__)
-#define LVN_INFO(...)                           ::lvn::logMessageInfo(lvn::logGetClientLogger(), ##__VA_ARGS__)
-#define LVN_WARN(...)                           ::lvn::logMessageWarn(lvn::logGetClientLogger(), ##__VA_ARGS__)
-#define LVN_ERROR(...)                          ::lvn::logMessageError(lvn::logGetClientLogger(), ##__VA_ARGS__)
-#define LVN_FATAL(...)                          ::lvn::logMessageFatal(lvn::logGetClientLogger(), ##__VA_ARGS__)
+// call site limits for messages in hot paths, logmacro is any log macro above (eg. LVN_LOG_ONCE(LVN_CORE_WARN, "msg %d", x))
+// LVN_LOG_ONCE logs the first call only, LVN_LOG_EVERY_N logs the first of every n calls
+// LVN_LOG_RATE_LIMIT logs up to burst messages back to back and then perSecond messages each second,
+// the next message that passes is followed by the number of messages that were dropped since the last one
+#define LVN_LOG_ONCE(logmacro, ...) \
+    do { static std::atomic<bool> lvnLogOnce{false}; if (!lvnLogOnce.exchange(true, std::memory_order_relaxed)) { logmacro(__VA_ARGS__); } } while (0)
+
+#define LVN_LOG_EVERY_N(n, logmacro, ...) \
+    do { static std::atomic<uint64_t> lvnLogCount{0}; if (lvnLogCount.fetch_add(1, std::memory_order_relaxed) % (n) == 0) { logmacro(__VA_ARGS__); } } while (0)
+
+#define LVN_LOG_RATE_LIMIT(perSecond, burst, logmacro, ...) \
+    do { \
+        static LvnLogRateLimit lvnLogLimit{ static_cast<float>(perSecond), static_cast<float>(burst) }; \
+        uint32_t lvnLogSuppressed; \
+        if (::lvn::logRateLimit(&lvnLogLimit, &lvnLogSuppressed)) \
+        { \
+            logmacro(__VA_ARGS__); \
+            if (lvnLogSuppressed > 0) { logmacro("(%u more messages from this call site were suppressed before the one above)", lvnLogSuppressed); } \
+        } \
+    } while (0)
+
+#define LVN_CONCAT_IMPL(a, b) a##b
+#define LVN_CONCAT(a, b) LVN_CONCAT_IMPL(a, b)
+
+// profiling zones are recorded from the macro to the end of the scope while lvn::profileEnable(true) is set,
+// define LVN_DISABLE_PROFILING to compile them out
+#ifndef LVN_DISABLE_PROFILING
+    #define LVN_PROFILE_SCOPE(name)             LvnProfileScope LVN_CONCAT(lvnProfileScope, __LINE__)(name)
+    #define LVN_PROFILE_FUNCTION()              LVN_PROFILE_SCOPE(LVN_FUNC_NAME)
+#else
+    #define LVN_PROFILE_SCOPE(name)             ((void)0)
+    #define LVN_PROFILE_FUNCTION()              ((void)0)
+#endif
 
 
 // -- [SUBSECT]: Includes
@@ -257,6 +370,22 @@
 #include <cstring> // strlen
 #include <cmath>
 #include <new>
+#include <atomic>
+#include <type_traits>
+
+// simd paths of the float LvnVec4, LvnMat4 and LvnQuat math, only instruction sets the compiler targets by default are used,
+// define LVN_DISABLE_SIMD_MATH to keep the scalar math
+#ifndef LVN_DISABLE_SIMD_MATH
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <emmintrin.h>
+        #define LVN_SIMD_MATH_SSE2
+        #define LVN_SIMD_MATH
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>
+        #define LVN_SIMD_MATH_NEON
+        #define LVN_SIMD_MATH
+    #endif
+#endif
 
 
 using std::abs;
@@ -288,6 +417,23 @@ using std::fmod;
 typedef void* (*LvnMemAllocFunc)(size_t sz, void* userData);
 typedef void  (*LvnMemFreeFunc)(void* ptr, void* userData);
 typedef void* (*LvnMemReallocFunc)(void* ptr, size_t sz, void* userData);
+typedef void* (*LvnAllocatorAllocFunc)(size_t size, size_t align, void* userData);
+typedef void  (*LvnAllocatorFreeFunc)(void* ptr, void* userData);
+typedef void* (*LvnAllocatorReallocFunc)(void* ptr, size_t oldSize, size_t newSize, size_t align, void* userData);
+typedef void  (*LvnJobFunc)(void* userData);
+typedef void  (*LvnParallelForFunc)(uint32_t start, uint32_t end, void* userData);
+typedef void  (*LvnFileChunkFunc)(const uint8_t* data, uint64_t offset, uint64_t size, void* userData);
+typedef void  (*LvnFileChangedFunc)(const char* filepath, void* userData);
+
+// allocator handle that containers allocate from instead of the global memory functions, containers keep a pointer to it so it must outlive them
+// freeFunc can be nullptr for allocators that release all their memory at once (eg. LvnArena), reallocFunc can be nullptr to fall back to alloc, copy and free
+struct LvnAllocator
+{
+    LvnAllocatorAllocFunc allocFunc;
+    LvnAllocatorFreeFunc freeFunc;
+    LvnAllocatorReallocFunc reallocFunc;
+    void* userData;
+};
 
 
 // ------------------------------------------------------------
@@ -320,7 +466,15 @@ enum LvnStructureType
     Lvn_Stype_Sampler,
     Lvn_Stype_Texture,
     Lvn_Stype_Cubemap,
+    Lvn_Stype_EnvironmentMap,
+    Lvn_Stype_LightClusters,
+    Lvn_Stype_ShadowCache,
+    Lvn_Stype_MaterialTable,
+    Lvn_Stype_RenderGraph,
+    Lvn_Stype_CommandList,
     Lvn_Stype_Sound,
+    Lvn_Stype_SoundBank,
+    Lvn_Stype_SoundGroup,
     Lvn_Stype_Socket,
 
     Lvn_Stype_Max_Value,
@@ -332,6 +486,25 @@ enum LvnMemAllocMode
     Lvn_MemAllocMode_MemPool,
 };
 
+// subsystem an allocation is tagged with when memory tracking is enabled, see LvnMemoryScope
+enum LvnMemoryCategory
+{
+    Lvn_MemoryCategory_General,
+    Lvn_MemoryCategory_MemoryPool,
+    Lvn_MemoryCategory_Graphics,
+    Lvn_MemoryCategory_Renderer,
+    Lvn_MemoryCategory_Loaders,
+    Lvn_MemoryCategory_Fonts,
+    Lvn_MemoryCategory_Audio,
+    Lvn_MemoryCategory_Networking,
+    Lvn_MemoryCategory_Ecs,
+
+    Lvn_MemoryCategory_Max_Value,
+};
+
+// called on every tracked allocation and free, eg. forward to TracyAllocN(ptr, size, lvn::getMemoryCategoryName(category)) and TracyFreeN
+typedef void (*LvnMemTrackFunc)(void* ptr, size_t size, LvnMemoryCategory category, bool freed, void* userData);
+
 enum LvnClipRegion
 {
     Lvn_ClipRegion_ApiSpecific,
@@ -352,6 +525,12 @@ enum LvnFileMode
     Lvn_FileMode_Append,
 };
 
+enum LvnPackCompression
+{
+    Lvn_PackCompression_None,
+    Lvn_PackCompression_Deflate,    // zlib stream, files that do not get smaller are stored uncompressed
+};
+
 enum LvnLoadFont
 {
     Lvn_LoadFont_Default              = (0),
@@ -359,6 +538,7 @@ enum LvnLoadFont
     Lvn_LoadFont_AutoHinting          = (1U << 1),
     Lvn_LoadFont_TargetLight          = (1U << 2),
     Lvn_LoadFont_TargetMono           = (1U << 3),
+    Lvn_LoadFont_SDF                  = (1U << 4), // render glyphs as signed distance fields, the atlas stays sharp when text is scaled
 };
 typedef uint32_t LvnLoadFontFlagBits;
 
@@ -595,6 +775,14 @@ enum LvnWindowApi
     // Lvn_WindowApi_WIN32 = Lvn_WindowApi_Win32,
 };
 
+// when an optional subsystem of the context (eg. audio, networking) is brought up
+enum LvnSubsystemInit
+{
+    Lvn_SubsystemInit_Startup = 0,  // initialized by lvn::createContext
+    Lvn_SubsystemInit_FirstUse,     // initialized by the first function that needs it, from any thread
+    Lvn_SubsystemInit_Disabled,     // never initialized, functions of the subsystem fail or do nothing
+};
+
 
 // -- [SUBSECT]: Graphics Enums
 // ------------------------------------------------------------
@@ -620,6 +808,14 @@ enum LvnPhysicalDeviceType
     Lvn_PhysicalDeviceType_Unknown = Lvn_PhysicalDeviceType_Other,
 };
 
+// how the graphics context picks a physical device when it is created, a device chosen later with lvn::setPhysicalDevice replaces it
+enum LvnPhysicalDevicePreference
+{
+    Lvn_PhysicalDevicePreference_HighPerformance = 0,  // discrete gpus first, then scored by video memory, queue families and features
+    Lvn_PhysicalDevicePreference_LowPower,             // integrated gpus first, eg. to save battery on hybrid laptops
+    Lvn_PhysicalDevicePreference_FirstSupported,       // the first device with the queue families and extensions needed
+};
+
 enum LvnBufferType
 {
     Lvn_BufferType_Unknown  = 0,
@@ -627,6 +823,7 @@ enum LvnBufferType
     Lvn_BufferType_Index    = (1U << 1),
     Lvn_BufferType_Uniform  = (1U << 2),
     Lvn_BufferType_Storage  = (1U << 3),
+    Lvn_BufferType_Indirect = (1U << 4),
 };
 typedef uint32_t LvnBufferTypeFlagBits;
 
@@ -635,7 +832,42 @@ enum LvnBufferUsage
     Lvn_BufferUsage_Static,
     Lvn_BufferUsage_Dynamic,
     Lvn_BufferUsage_Resize,
+    Lvn_BufferUsage_DynamicRing, // dynamic buffer with a separate region for each frame in flight, data should be updated every frame, the region written follows the window presented last so windows sharing ring buffers should begin and present their frames together
+    Lvn_BufferUsage_DynamicDeviceLocal, // dynamic buffer stored in gpu memory, updates are staged and copied to the gpu before the frame is drawn
+};
+
+// uses of buffer data written by compute shaders that a memory barrier makes visible
+enum LvnMemoryBarrierFlags
+{
+    Lvn_MemoryBarrier_None           = 0,
+    Lvn_MemoryBarrier_StorageBuffer  = (1U << 0), // storage buffer reads and writes in later shaders
+    Lvn_MemoryBarrier_UniformBuffer  = (1U << 1),
+    Lvn_MemoryBarrier_VertexBuffer   = (1U << 2),
+    Lvn_MemoryBarrier_IndexBuffer    = (1U << 3),
+    Lvn_MemoryBarrier_IndirectBuffer = (1U << 4),
+    Lvn_MemoryBarrier_All            = 0x1f,
 };
+typedef uint32_t LvnMemoryBarrierFlagBits;
+
+// pipeline states that can be changed with render commands after the pipeline is bound instead of creating a pipeline for each variant
+enum LvnPipelineDynamicStateFlags
+{
+    Lvn_PipelineDynamicState_None              = 0,
+    Lvn_PipelineDynamicState_CullMode          = (1U << 0), // renderCmdSetCullMode
+    Lvn_PipelineDynamicState_FrontFace         = (1U << 1), // renderCmdSetFrontFace
+    Lvn_PipelineDynamicState_PrimitiveTopology = (1U << 2), // renderCmdSetPrimitiveTopology, vulkan only allows topologies of the same class (points, lines or triangles)
+    Lvn_PipelineDynamicState_DepthTest         = (1U << 3), // renderCmdSetDepthTest
+    Lvn_PipelineDynamicState_BlendEnable       = (1U << 4), // renderCmdSetBlendEnable
+    Lvn_PipelineDynamicState_All               = 0x1f,
+};
+typedef uint32_t LvnPipelineDynamicStateFlagBits;
+
+// interned string of lvn::atomIntern, equal strings share one atom so names compare and hash as integers, 0 is the empty string
+typedef uint32_t LvnAtom;
+
+// handle of a framebuffer, buffer or window declared in a render graph
+typedef uint32_t LvnRenderGraphResource;
+#define LVN_RENDER_GRAPH_NO_RESOURCE (UINT32_MAX)
 
 enum LvnCullFaceMode
 {
@@ -729,6 +961,16 @@ enum LvnDescriptorType
     Lvn_DescriptorType_ImageSamplerBindless,
     Lvn_DescriptorType_UniformBuffer,
     Lvn_DescriptorType_StorageBuffer,
+    Lvn_DescriptorType_UniformBufferDynamic,     // uniform buffer bound with a per draw offset passed to renderCmdBindDescriptorSetsDynamic
+};
+
+enum LvnPresentMode
+{
+    Lvn_PresentMode_Default = 0,   // chosen from the window vSync setting, fifo when enabled and mailbox otherwise
+    Lvn_PresentMode_Fifo,          // waits for the vertical blank, no tearing
+    Lvn_PresentMode_FifoRelaxed,   // waits for the vertical blank unless the frame is late, late frames may tear
+    Lvn_PresentMode_Mailbox,       // replaces the queued image with the newest frame, no tearing
+    Lvn_PresentMode_Immediate,     // presents without waiting for the vertical blank, frames may tear
 };
 
 enum LvnSampleCount
@@ -747,6 +989,7 @@ enum LvnShaderStage
     Lvn_ShaderStage_All,
     Lvn_ShaderStage_Vertex,
     Lvn_ShaderStage_Fragment,
+    Lvn_ShaderStage_Compute,
 };
 
 enum LvnStencilOperation
@@ -761,6 +1004,33 @@ enum LvnStencilOperation
     Lvn_StencilOp_DecrementAndWrap  = 7,
 };
 
+enum LvnTextureCompression
+{
+    Lvn_TextureCompression_None = 0,   // uncompressed 8 bit per channel pixel data
+    Lvn_TextureCompression_Bc1,        // rgba, 8 bytes per 4x4 block
+    Lvn_TextureCompression_Bc3,        // rgba, 16 bytes per 4x4 block
+    Lvn_TextureCompression_Bc4,        // r, 8 bytes per 4x4 block
+    Lvn_TextureCompression_Bc5,        // rg, 16 bytes per 4x4 block
+    Lvn_TextureCompression_Bc7,        // rgba, 16 bytes per 4x4 block
+    Lvn_TextureCompression_Etc2Rgb,    // rgb, 8 bytes per 4x4 block
+    Lvn_TextureCompression_Etc2Rgba,   // rgba, 16 bytes per 4x4 block
+    Lvn_TextureCompression_Astc4x4,    // rgba, 16 bytes per 4x4 block
+};
+
+enum LvnHdrImageFormat
+{
+    Lvn_HdrImageFormat_Float = 0,      // 32 bit float per channel, 4 to 16 bytes per texel
+    Lvn_HdrImageFormat_Half,           // rgba 16 bit half float, 8 bytes per texel
+    Lvn_HdrImageFormat_Rgb9e5,         // rgb with a shared 5 bit exponent, 4 bytes per texel, negative values are clamped to zero
+};
+
+enum LvnImageFilter
+{
+    Lvn_ImageFilter_Box = 0,           // average of the covered pixels, nearest when upscaling, the usual mip filter
+    Lvn_ImageFilter_Bilinear,          // tent filter, widened when downscaling so every source pixel contributes
+    Lvn_ImageFilter_Lanczos,           // lanczos3, sharpest of the three, can ring slightly at hard edges
+};
+
 enum LvnTextureFilter
 {
     Lvn_TextureFilter_Nearest,
@@ -781,6 +1051,13 @@ enum LvnTextureMode
     Lvn_TextureMode_ClampToBorder,
 };
 
+enum LvnTextureStreamLevel
+{
+    Lvn_TextureStreamLevel_Placeholder = 0, // 1x1 texture of the placeholder color
+    Lvn_TextureStreamLevel_Preview,         // downscaled image or a smaller mip level of a compressed file
+    Lvn_TextureStreamLevel_Full,            // full resolution image
+};
+
 enum LvnTopologyType
 {
     Lvn_TopologyType_None = 0,
@@ -791,6 +1068,12 @@ enum LvnTopologyType
     Lvn_TopologyType_TriangleStrip,
 };
 
+enum LvnVertexInputRate
+{
+    Lvn_VertexInputRate_Vertex = 0,
+    Lvn_VertexInputRate_Instance,
+};
+
 enum LvnAttributeFormat
 {
     Lvn_AttributeFormat_Undefined = 0,
@@ -828,7 +1111,42 @@ enum LvnAttributeFormat
     Lvn_AttributeFormat_2_10_10_10_uile,
     Lvn_AttributeFormat_2_10_10_10_nle,
     Lvn_AttributeFormat_2_10_10_10_unle,
+    Lvn_AttributeFormat_Vec2_f16,
+    Lvn_AttributeFormat_Vec4_f16,
+    Lvn_AttributeFormat_Vec2_n16,
+    Lvn_AttributeFormat_Vec4_n16,
+    Lvn_AttributeFormat_Vec2_un16,
+    Lvn_AttributeFormat_Vec4_un16,
+};
+
+// attributes of LvnVertex kept by a LvnVertexLayout, the position is always kept
+enum LvnVertexAttributeFlags
+{
+    Lvn_VertexAttributeFlag_None    = 0,
+    Lvn_VertexAttributeFlag_Color   = (1U << 0),
+    Lvn_VertexAttributeFlag_TexUV   = (1U << 1),
+    Lvn_VertexAttributeFlag_Normal  = (1U << 2),
+    Lvn_VertexAttributeFlag_Tangent = (1U << 3), // tangent and bitangent, quantized layouts keep the bitangent sign with the tangent instead
+    Lvn_VertexAttributeFlag_Joints  = (1U << 4),
+    Lvn_VertexAttributeFlag_Weights = (1U << 5),
+
+    Lvn_VertexAttributeFlag_Static  = Lvn_VertexAttributeFlag_Color | Lvn_VertexAttributeFlag_TexUV | Lvn_VertexAttributeFlag_Normal | Lvn_VertexAttributeFlag_Tangent,
+    Lvn_VertexAttributeFlag_All     = Lvn_VertexAttributeFlag_Static | Lvn_VertexAttributeFlag_Joints | Lvn_VertexAttributeFlag_Weights,
+};
+typedef uint32_t LvnVertexAttributeFlagBits;
+
+// post processing passes run on the triangle lists of loaded meshes
+enum LvnMeshOptimizeFlags
+{
+    Lvn_MeshOptimizeFlag_None         = 0,
+    Lvn_MeshOptimizeFlag_VertexCache  = (1U << 0), // reorder triangles to reuse vertices in the post transform cache
+    Lvn_MeshOptimizeFlag_Overdraw     = (1U << 1), // reorder clusters of triangles so outward facing ones draw first, runs after the vertex cache pass
+    Lvn_MeshOptimizeFlag_VertexFetch  = (1U << 2), // reorder vertices in the order the indices use them and drop unused ones
+    Lvn_MeshOptimizeFlag_GenerateLods = (1U << 3), // simplify triangle lists into coarser index ranges stored after the full indices, see LvnPrimitive::lods
+
+    Lvn_MeshOptimizeFlag_All          = Lvn_MeshOptimizeFlag_VertexCache | Lvn_MeshOptimizeFlag_Overdraw | Lvn_MeshOptimizeFlag_VertexFetch | Lvn_MeshOptimizeFlag_GenerateLods,
 };
+typedef uint32_t LvnMeshOptimizeFlagBits;
 
 enum LvnInterpolationMode
 {
@@ -847,6 +1165,27 @@ enum LvnAnimationPath
 // -- [SUBSECT]: Audio Enums
 // ------------------------------------------------------------
 
+// NOTE: in the same order as the backends of miniaudio, offset by one for the default
+enum LvnAudioBackend
+{
+    Lvn_AudioBackend_Default,
+    Lvn_AudioBackend_Wasapi,
+    Lvn_AudioBackend_DirectSound,
+    Lvn_AudioBackend_WinMM,
+    Lvn_AudioBackend_CoreAudio,
+    Lvn_AudioBackend_Sndio,
+    Lvn_AudioBackend_Audio4,
+    Lvn_AudioBackend_Oss,
+    Lvn_AudioBackend_PulseAudio,
+    Lvn_AudioBackend_Alsa,
+    Lvn_AudioBackend_Jack,
+    Lvn_AudioBackend_AAudio,
+    Lvn_AudioBackend_OpenSL,
+    Lvn_AudioBackend_WebAudio,
+    Lvn_AudioBackend_Custom,
+    Lvn_AudioBackend_Null,
+};
+
 enum LvnSoundFlags
 {
     Lvn_SoundFlag_Stream                = (1U << 0),
@@ -883,19 +1222,49 @@ enum LvnSocketType
     Lvn_SocketType_Server,
 };
 
+enum LvnPacketFlags
+{
+    Lvn_PacketFlag_Unreliable           = 0,         // may be lost, arrives in order with older packets dropped
+    Lvn_PacketFlag_Reliable             = (1U << 0), // resent until acknowledged, arrives in order
+    Lvn_PacketFlag_Unsequenced          = (1U << 1), // unreliable and not ordered, nothing is dropped for arriving late
+    Lvn_PacketFlag_UnreliableFragment   = (1U << 3), // unreliable packets larger than the mtu are sent as unreliable fragments instead of reliably
+};
+typedef uint32_t LvnPacketFlagBits;
+
+// compresses each datagram the socket sends, both ends of a connection must use the same mode
+enum LvnSocketCompression
+{
+    Lvn_SocketCompression_None,
+    Lvn_SocketCompression_RangeCoder, // enet adaptive range coder, cheap enough for every datagram of small state updates
+    Lvn_SocketCompression_Deflate,    // zlib stream, compresses more but costs much more cpu, meant for large reliable transfers
+};
+
+enum LvnSocketEventType
+{
+    Lvn_SocketEvent_None,
+    Lvn_SocketEvent_Connect,
+    Lvn_SocketEvent_Disconnect,
+    Lvn_SocketEvent_Receive,
+};
+
 
 // ------------------------------------------------------------
 // [SECTION]: Struct Definitions
 // ------------------------------------------------------------
 
+struct LvnAabb;
 struct LvnAddress;
 struct LvnAnimation;
 struct LvnAnimationChannel;
 struct LvnAppRenderEvent;
+struct LvnAudioDeviceInfo;
 struct LvnAppTickEvent;
 struct LvnBuffer;
+struct LvnBvhNode;
 struct LvnBufferCreateInfo;
 struct LvnCamera;
+struct LvnCommandList;
+struct LvnComputePipelineCreateInfo;
 struct LvnContext;
 struct LvnContextCreateInfo;
 struct LvnCubemap;
@@ -904,39 +1273,66 @@ struct LvnCubemapHdrCreateInfo;
 struct LvnDescriptorBinding;
 struct LvnDescriptorLayout;
 struct LvnDescriptorLayoutCreateInfo;
+struct LvnDescriptorLayoutStats;
 struct LvnDescriptorSet;
+struct LvnDescriptorSetUpdate;
 struct LvnDescriptorUpdateInfo;
 struct LvnDrawCommand;
+struct LvnDrawIndexedIndirectCommand;
+struct LvnDrawIndirectCommand;
+struct LvnDynamicFont;
+struct LvnDynamicFontCreateInfo;
+struct LvnEnvironmentMap;
+struct LvnEnvironmentMapCreateInfo;
 struct LvnEvent;
 struct LvnFont;
 struct LvnFontConfig;
 struct LvnFontGlyph;
 struct LvnFrameBuffer;
+struct LvnFrustum;
 struct LvnFrameBufferColorAttachment;
 struct LvnFrameBufferCreateInfo;
 struct LvnFrameBufferDepthAttachment;
+struct LvnGpuTimestamp;
+struct LvnFrameStats;
+struct LvnGraphicsMemoryHeapStats;
+struct LvnGraphicsMemoryStats;
 struct LvnGraphicsContext;
 struct LvnImageData;
 struct LvnImageHdrData;
+struct LvnJobCounter;
 struct LvnKeyHoldEvent;
 struct LvnKeyPressedEvent;
 struct LvnKeyReleasedEvent;
 struct LvnKeyTypedEvent;
+struct LvnLightClusters;
+struct LvnLightClustersCreateInfo;
 struct LvnLogFile;
+struct LvnLogFileOptions;
+struct LvnLogRateLimit;
 struct LvnLogger;
 struct LvnLoggerCreateInfo;
 struct LvnLogMessage;
 struct LvnLogPattern;
+struct LvnLooseGridCell;
+struct LvnLooseGridObject;
 struct LvnMaterial;
+struct LvnMaterialTable;
+struct LvnMaterialTableCreateInfo;
 struct LvnMemoryBindingInfo;
+struct LvnMemoryCategoryStats;
+struct LvnMemoryStats;
 struct LvnMesh;
 struct LvnMeshTextureBindings;
 struct LvnModel;
+struct LvnModelInstance;
 struct LvnMouseButtonPressedEvent;
 struct LvnMouseButtonReleasedEvent;
+struct LvnMouseMotionSample;
 struct LvnMouseMovedEvent;
 struct LvnMouseScrolledEvent;
 struct LvnNode;
+struct LvnNodeHierarchy;
 struct LvnOrthoCamera;
 struct LvnPacket;
 struct LvnPhysicalDevice;
@@ -956,24 +1352,49 @@ struct LvnPipelineSpecification;
 struct LvnPipelineStencilAttachment;
 struct LvnPipelineViewport;
 struct LvnPrimitive;
+struct LvnPrimitiveLod;
+struct LvnPushConstantRange;
+struct LvnRay;
+struct LvnReadbackData;
+struct LvnRenderGraph;
+struct LvnRenderGraphAccess;
+struct LvnRenderGraphPassCreateInfo;
 struct LvnRenderPass;
+struct LvnRenderScaleController;
 struct LvnSampler;
 struct LvnSamplerCreateInfo;
 struct LvnServer;
 struct LvnShader;
 struct LvnShaderCreateInfo;
+struct LvnShadowCache;
+struct LvnShadowCacheCreateInfo;
 struct LvnSkin;
 struct LvnSocket;
 struct LvnSocketCreateInfo;
+struct LvnSocketEvent;
+struct LvnSocketPeerInfo;
+struct LvnSocketSimulation;
 struct LvnSound;
+struct LvnSoundBank;
+struct LvnSoundBankCreateInfo;
 struct LvnSoundCreateInfo;
+struct LvnSoundGroup;
+struct LvnSoundGroupCreateInfo;
+struct LvnSoundPlayParams;
 struct LvnTexture;
+struct LvnTextureAtlas;
+struct LvnTextureAtlasCreateInfo;
+struct LvnTextureAtlasRegion;
 struct LvnTextureCreateInfo;
 struct LvnTextureSamplerCreateInfo;
+struct LvnTextureStream;
+struct LvnTextureStreamCreateInfo;
 struct LvnTransform;
 struct LvnUniformBufferInfo;
 struct LvnVertex;
 struct LvnVertexAttribute;
+struct LvnVertexLayout;
+struct LvnVisiblePrimitive;
 struct LvnVertexBindingDescription;
 struct LvnWindow;
 struct LvnWindowCloseEvent;
@@ -1001,9 +1422,15 @@ struct LvnPair;
 template <typename T1, typename T2>
 struct LvnDoublePair;
 
+struct LvnArenaMarker;
+class LvnArena;
+
 template <typename T>
 class LvnVector;
 
+template <typename T, size_t N>
+class LvnSmallVector;
+
 template <typename T>
 struct LvnLinkedIndexNode;
 
@@ -1013,29 +1440,61 @@ using LvnINode = LvnLinkedIndexNode<T>;
 template <typename T>
 class LvnArenaList;
 
-template <typename T, typename Container>
+template <typename T>
 class LvnQueue;
+template <typename T>
+class LvnSpscQueue;
+template <typename T>
+class LvnMpmcQueue;
 
 struct LvnHash;
 template <typename K, typename T>
 struct LvnHashEntry;
 template <typename K, typename T, typename Hash>
 class LvnHashMap;
+template <typename K, typename T>
+struct LvnFlatHashEntry;
+struct LvnKeyEqual;
+template <typename K, typename T, typename Hash, typename KeyEqual>
+class LvnFlatHashMap;
 
 template <typename T>
 class LvnUniquePtr;
 
 class LvnString;
+struct LvnStringView;
+struct LvnStringHash;
+struct LvnStringEqual;
 
 template <typename T>
 class LvnData;
 typedef LvnData<uint8_t> LvnBin;
+typedef void (*LvnFileReadFunc)(LvnBin* data, LvnResult result, void* userData);
+typedef void (*LvnFileWriteFunc)(LvnResult result, void* userData);
+typedef void (*LvnSocketEventFunc)(const LvnSocketEvent* event, void* userData);
+typedef void (*LvnReadbackFunc)(const LvnReadbackData* readback, void* userData);
 
 class LvnTimer;
+class LvnProfileScope;
 class LvnThread;
 class LvnMutex;
 class LvnLockGaurd;
+class LvnSpinLock;
+class LvnSpinLockGaurd;
+class LvnSharedMutex;
+class LvnSharedLockGaurd;
+class LvnWriteLockGaurd;
+class LvnCondVar;
+template <typename T>
+class LvnAtomic;
+class LvnMemoryScope;
 class LvnDrawList;
+template <typename V>
+class LvnTypedDrawList;
+class LvnBvh;
+class LvnLooseGrid2D;
+class LvnBitWriter;
+class LvnBitReader;
 
 
 // -- [SUBSECT]: Vertices & Matrices
@@ -1266,30 +1725,90 @@ namespace lvn
     LVN_API LvnString               dateGetSecondNumStr();                              // get the current second as a string
 
     LVN_API float                   getContextTime();                                   // get time in seconds since context creation
+    LVN_API uint64_t                getContextTimeNs();                                 // get time in nanoseconds since context creation from a monotonic clock
+    LVN_API uint64_t                getMonotonicTimeNs();                               // get a monotonic high resolution timestamp in nanoseconds, only differences between two calls are meaningful
+
+    // string atoms, each distinct string is stored once per context and stays valid until the context is terminated
+    LVN_API LvnAtom                 atomIntern(const char* str);                        // returns the atom of str, adding it on first use
+    LVN_API LvnAtom                 atomInternLength(const char* str, size_t length);   // same as atomIntern for strings that are not null terminated
+    LVN_API LvnAtom                 atomFind(const char* str);                          // returns the atom of str without adding it, 0 if it was never interned
+    LVN_API const char*             atomGetString(LvnAtom atom);                        // null terminated string of the atom
+    LVN_API uint32_t                atomGetLength(LvnAtom atom);
+    LVN_API uint64_t                atomGetHash(LvnAtom atom);                          // LvnStringHash of the string, computed once when it was interned
+
+    // job system, one worker per core is started by createContext when enableMultithreading is set, jobs run inline on the calling thread otherwise
+    LVN_API void                    jobSubmit(LvnJobFunc func, void* userData, LvnJobCounter* counter = nullptr);   // queue a job on the workers, counter is incremented now and decremented once the job has run
+    LVN_API void                    jobSubmitAfter(LvnJobFunc func, void* userData, LvnJobCounter* dependency, LvnJobCounter* counter = nullptr); // queue a job that starts once every job counted by dependency has run
+    LVN_API void                    jobWait(LvnJobCounter* counter);                    // runs queued jobs on the calling thread until counter reaches zero
+    LVN_API void                    parallelFor(uint32_t count, uint32_t grainSize, LvnParallelForFunc func, void* userData); // splits [0, count) into ranges of grainSize (0 picks one) run by the workers and the calling thread, returns once every range has run
+    LVN_API uint32_t                jobGetWorkerCount();                                // number of worker threads, 0 when multithreading is disabled
+    LVN_API uint32_t                jobGetThreadIndex();                                // 0 outside the job system and 1...jobGetWorkerCount() on the workers, use to index per thread scratch data in jobs
 
     LVN_API LvnString               loadFileSrc(const char* filepath);                                     // get the src contents from a text file format, filepath must be a valid path to a text file
     LVN_API LvnBin                  loadFileSrcBin(const char* filepath);                                  // get the binary data contents (in unsigned char*) from a binary file (eg .spv), filepath must be a valid path to a binary file
+    LVN_API LvnBin                  loadFileMapped(const char* filepath);                                  // map a binary file into memory instead of reading it, pages are read from disk on first access and unmapped when the data is freed, writes to the data are private and never reach the file
+                                                                                                           // uncompressed files from a mounted pack are views into the pack and stay valid while it is mounted
+    LVN_API LvnResult               loadFileChunksAsync(const char* filepath, uint64_t chunkSize, LvnFileChunkFunc func, void* userData, LvnJobCounter* counter = nullptr); // read a file on the io thread, func is called in order for each chunk of at most chunkSize bytes, wait for counter with jobWait
+    LVN_API void                    loadFileAsync(const char* filepath, LvnFileReadFunc func, void* userData, LvnJobCounter* counter = nullptr); // read a whole file on the io thread, func may move the data out and gets Lvn_Result_Failure with empty data if the file could not be read
+    LVN_API void                    writeFileAsync(const char* filepath, const void* data, uint64_t size, LvnFileMode mode, LvnFileWriteFunc func = nullptr, void* userData = nullptr, LvnJobCounter* counter = nullptr); // data is copied, requests run in the order they were submitted
+    LVN_API void                    fileWaitIdle();                                                        // blocks until every queued file request, including log file writes, has completed
+
+    // virtual file system, files in mounted packs are found by the path they were packed with before the disk is searched
+    // every file loader (loadFileSrc, loadFileSrcBin, loadFileMapped, loadImageData, loadModel, loadFontFromFileTTF, createSound, shaders from file) searches the mounted packs
+    LVN_API LvnResult               packBuild(const char* packPath, const char* const* filepaths, uint32_t fileCount, LvnPackCompression compression = Lvn_PackCompression_None); // write the files into one pack, each file is stored under the path it was given with
+    LVN_API LvnResult               vfsMountPack(const char* packPath);                                    // map a pack file, packs mounted later shadow files of earlier packs
+    LVN_API void                    vfsUnmountPack(const char* packPath);                                  // data returned by vfsLoadFile from this pack becomes invalid
+    LVN_API bool                    vfsFileExists(const char* filepath);                                   // checks the mounted packs then the disk
     LVN_API void                    writeFileSrc(const char* filename, const char* src, LvnFileMode mode); // write to a file given the file name, the source content of the file and the mode to write to the file
 
-    LVN_API LvnFont                 loadFontFromFileTTF(const char* filepath, uint32_t fontSize, const uint32_t* pCodepoints = nullptr, uint32_t codepointCount = 0, LvnLoadFontFlagBits flags = Lvn_LoadFont_Default);    // get the font data from a ttf font file, font data will be stored in a LvnImageData struct which is an atlas texture containing all the font glyphs and their UV positions
-    LVN_API LvnFont                 loadFontFromFileTTFMemory(const uint8_t* fontData, uint64_t fontDataSize, uint32_t fontSize, const uint32_t* pCodepoints = nullptr, uint32_t codepointCount = 0, LvnLoadFontFlagBits flags = Lvn_LoadFont_Default);
-    LVN_API LvnFontGlyph            fontGetGlyph(const LvnFont& font, uint32_t codepoint);
+    LVN_API LvnFont                 loadFontFromFileTTF(const char* filepath, uint32_t fontSize, const uint32_t* pCodepoints = nullptr, uint32_t codepointCount = 0, LvnLoadFontFlagBits flags = Lvn_LoadFont_Default, const char* cachePath = nullptr);    // get the font data from a ttf font file, font data will be stored in a LvnImageData struct which is an atlas texture containing all the font glyphs and their UV positions
+    LVN_API LvnFont                 loadFontFromFileTTFMemory(const uint8_t* fontData, uint64_t fontDataSize, uint32_t fontSize, const uint32_t* pCodepoints = nullptr, uint32_t codepointCount = 0, LvnLoadFontFlagBits flags = Lvn_LoadFont_Default, const char* cachePath = nullptr);
+                                                                                                           // glyphs are rasterized in parallel on the job system, the atlas and glyphs are loaded from and written to cachePath if given, keyed by the font data, size, flags and codepoints
+    LVN_API LvnFontGlyph            fontGetGlyph(const LvnFont& font, uint32_t codepoint);                 // returns the first glyph if the font does not contain the codepoint
+    LVN_API void                    fontBuildGlyphLookup(LvnFont& font);                                   // build the lookup tables used by fontGetGlyph, fonts from the font loaders already have them
+    LVN_API LvnResult               createDynamicFont(LvnDynamicFont** font, const LvnDynamicFontCreateInfo* createInfo);    // create a font that rasterizes glyphs into atlas pages the first time they are requested
+    LVN_API void                    destroyDynamicFont(LvnDynamicFont* font);
+    LVN_API LvnDynamicFontCreateInfo configDynamicFontInit(const char* filepath, uint32_t fontSize);
+    LVN_API LvnFontGlyph            dynamicFontGetGlyph(LvnDynamicFont* font, uint32_t codepoint, uint32_t* pageIndex);       // rasterizes the glyph on first use, the glyph uv is within the atlas page at pageIndex
+    LVN_API void                    dynamicFontUpdate(LvnDynamicFont* font);                               // upload the atlas regions rasterized since the last update, call once per frame before drawing with the page textures
+    LVN_API LvnTexture*             dynamicFontGetPageTexture(LvnDynamicFont* font, uint32_t pageIndex);   // returns nullptr until the page is first uploaded by dynamicFontUpdate
+    LVN_API uint32_t                dynamicFontGetPageCount(LvnDynamicFont* font);
     LVN_API uint32_t                decodeCodepointUTF8(const char* str, uint32_t* next);
+    LVN_API size_t                  decodeUTF8(const char* str, size_t len, uint32_t* out);      // decode len bytes into out (room for len codepoints), returns the number of codepoints, invalid or truncated sequences decode to '?' one byte at a time
     LVN_API LvnData<uint32_t>       getDefaultSupportedCodepoints();
 
     LVN_API void*                   memAlloc(size_t size);                              // custom memory allocation function that allocates memory given the size of memory, note that function is connected with the context and will keep track of allocation counts, will increment number of allocations per use
     LVN_API void                    memFree(void* ptr);                                 // custom memory free function, note that it keeps track of memory allocations remaining, decrements number of allocations per use with lvn::memAlloc
     LVN_API void*                   memRealloc(void* ptr, size_t size);                 // custom memory realloc function
+    LVN_API void*                   memAllocAligned(size_t size, size_t alignment);     // allocates zeroed memory aligned to alignment (power of two), allocations of at least LVN_HUGE_PAGE_SIZE are mapped from the os and use huge pages when available, counts as one allocation like lvn::memAlloc
+    LVN_API void                    memFreeAligned(void* ptr);                          // frees memory allocated with lvn::memAllocAligned
+    LVN_API const LvnAllocator*     getAlignedAllocator();                              // allocator for containers that allocates through lvn::memAllocAligned with at least LVN_CACHE_LINE_SIZE alignment, pass to set_allocator for large arrays iterated with simd loads
 
     LVN_API void                    setMemFuncs(LvnMemAllocFunc allocFunc, LvnMemFreeFunc freeFunc, LvnMemReallocFunc reallocFunc, void* userData);
     LVN_API LvnMemAllocFunc         getMemAllocFunc();
     LVN_API LvnMemFreeFunc          getMemFreeFunc();
     LVN_API LvnMemReallocFunc       getMemReallocFunc();
     LVN_API void*                   getMemUserData();
+    LVN_API void                    memPoolTrim();                                      // free the memory pool blocks that have no objects left in them, following the trim watermarks set in the context create info, no other thread may create or destroy objects during the call
+    LVN_API size_t                  memPoolGetPeakCount(LvnStructureType sType);        // most objects of sType that were alive at once since the context was created, tracked in every memory allocation mode
+    LVN_API LvnResult               memPoolWriteConfig(const char* filepath);           // write the peak object count of each sType to a pool config file, see poolConfigPath in the context create info
+
+    // memory tracking, allocations are only tracked when the library and application are built with LVN_MEMORY_TRACKING defined
+    LVN_API LvnMemoryCategory       memSetCategory(LvnMemoryCategory category);         // sets the category allocations made on the calling thread are tagged with and returns the previous one, prefer LvnMemoryScope
+    LVN_API LvnMemoryStats          getMemoryStats();                                   // bytes, peak bytes and allocation counts per category and for the last frame, all zero when memory tracking is disabled
+    LVN_API void                    memNextFrame();                                     // ends the current frame for the per frame allocation counts, called by the renderer every frame
+    LVN_API void                    setMemTrackFunc(LvnMemTrackFunc func, void* userData); // set a function that is called on every tracked allocation and free, pass nullptr to remove it
+    LVN_API const char*             getMemoryCategoryName(LvnMemoryCategory category);
+
+#ifdef LVN_MEMORY_TRACKING
+    LVN_API void*                   memTrackAlloc(size_t size);                         // allocates through the memory functions with a tracking header in front, used by lvn::memNew, lvn::memAlloc and the containers
+    LVN_API void                    memTrackFree(void* ptr);
+    LVN_API void*                   memTrackRealloc(void* ptr, size_t size);
+#endif
 
 #ifdef LVN_CONFIG_DEBUG
-    LVN_API inline size_t i_ObjectAllocationCount = 0;
-    LVN_API inline size_t getObjectAllocationCount() { return i_ObjectAllocationCount; }
+    LVN_API inline std::atomic<size_t> i_ObjectAllocationCount{0}; // containers allocate from several threads (eg. separate ecs worlds)
+    LVN_API inline size_t getObjectAllocationCount() { return i_ObjectAllocationCount.load(std::memory_order_relaxed); }
 #endif
 
     template <typename T>
@@ -1297,9 +1816,13 @@ namespace lvn
     {
         if (size == 0) { return nullptr; }
     #ifdef LVN_CONFIG_DEBUG
-        i_ObjectAllocationCount++;
+        i_ObjectAllocationCount.fetch_add(1, std::memory_order_relaxed);
     #endif
+    #ifdef LVN_MEMORY_TRACKING
+        T* memalloc = (T*)lvn::memTrackAlloc(size * sizeof(T));
+    #else
         T* memalloc = (T*)(*lvn::getMemAllocFunc())(size * sizeof(T), lvn::getMemUserData());
+    #endif
         if (construct)
         {
             for (size_t i = 0; i < size; i++)
@@ -1313,14 +1836,55 @@ namespace lvn
     {
         if (ptr == nullptr) { return; }
     #ifdef LVN_CONFIG_DEBUG
-        i_ObjectAllocationCount--;
+        i_ObjectAllocationCount.fetch_sub(1, std::memory_order_relaxed);
     #endif
         if (!std::is_trivially_destructible_v<T>)
         {
             for (size_t i = 0; i < size; i++)
                 ptr[i].~T();
         }
+    #ifdef LVN_MEMORY_TRACKING
+        lvn::memTrackFree(ptr);
+    #else
         (*lvn::getMemFreeFunc())(ptr, lvn::getMemUserData());
+    #endif
+    }
+
+    // allocates uninitialized memory for size elements from the allocator, or from the global memory functions when allocator is nullptr
+    template <typename T>
+    LVN_API constexpr T* allocatorNew(const LvnAllocator* allocator, size_t size)
+    {
+        if (size == 0) { return nullptr; }
+        if (allocator == nullptr) { return lvn::memNew<T>(size, false); }
+        return static_cast<T*>(allocator->allocFunc(size * sizeof(T), alignof(T), allocator->userData));
+    }
+
+    // frees memory from lvn::allocatorNew, destructors are not run
+    template <typename T>
+    LVN_API constexpr void allocatorDelete(const LvnAllocator* allocator, T* ptr)
+    {
+        if (ptr == nullptr) { return; }
+        if (allocator == nullptr) { lvn::memDelete<T>(ptr, 0); return; }
+        if (allocator->freeFunc) { allocator->freeFunc(ptr, allocator->userData); }
+    }
+
+    // grows or shrinks memory from lvn::allocatorNew keeping the first min(oldSize, newSize) elements, only for trivially copyable types
+    template <typename T>
+    LVN_API constexpr T* allocatorRealloc(const LvnAllocator* allocator, T* ptr, size_t oldSize, size_t newSize)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "allocatorRealloc requires a trivially copyable type");
+        if (ptr == nullptr) { return lvn::allocatorNew<T>(allocator, newSize); }
+    #ifdef LVN_MEMORY_TRACKING
+        if (allocator == nullptr) { return static_cast<T*>(lvn::memTrackRealloc(ptr, newSize * sizeof(T))); }
+    #else
+        if (allocator == nullptr) { return static_cast<T*>((*lvn::getMemReallocFunc())(ptr, newSize * sizeof(T), lvn::getMemUserData())); } /* NOTE: the allocation count from memNew still holds for the reallocated block */
+    #endif
+        if (allocator->reallocFunc) { return static_cast<T*>(allocator->reallocFunc(ptr, oldSize * sizeof(T), newSize * sizeof(T), alignof(T), allocator->userData)); }
+
+        T* data = lvn::allocatorNew<T>(allocator, newSize);
+        if (data) { memcpy(data, ptr, (oldSize < newSize ? oldSize : newSize) * sizeof(T)); }
+        lvn::allocatorDelete<T>(allocator, ptr);
+        return data;
     }
 
     template <typename T, typename... Args>
@@ -1340,6 +1904,22 @@ namespace lvn
     // The core logger is used to output information relevant to the library (eg. error messages, object creation)
     // The client logger is used for the implementation of the library for the application or engine (if the user wishes to use it)
 
+    // With async logging enabled (LvnContextCreateInfo::logging.enableAsyncLogging) a log call only formats the message into a queued record,
+    // a background thread applies the log patterns and writes the records to the console and log files in batches
+    // - errors and fatal messages wake the thread right away, other messages are written within a few milliseconds
+    // - call lvn::logFlush before writing to stdout directly so the output stays in order
+
+    // Log files can be buffered and rotated (lvn::logSetFileOptions or LvnLoggerCreateInfo::fileConfig.options)
+    // - lines are collected until the buffer is full, a message at the flush level or an error arrives, the flush interval passes or lvn::logFlush is called
+    // - a file past maxFileSize or rotateInterval is renamed to "<filename>.1", older files move up to "<filename>.<maxFiles>" and a new file is started
+    // - buffered lines are lost if the program crashes before they are written, fatal messages are always written before the log call returns
+
+    // A binary log file (lvn::logSetBinaryFileConfig) stores each message as the id of its format string and the raw arguments instead of formatted text
+    // - while it is enabled the messages of the logger are never formatted and skip the console and the text log file
+    // - each format string is written once and string arguments are copied, the file is usually a fraction of the size of the text log
+    // - lvn::logDecodeBinaryFile renders the file back to text offline with the log patterns of a logger (see examples/decodeBinaryLog.cpp)
+    // - user defined log patterns have to be added by the decoding program as well, the file does not store them
+
     // Each Logger has a name, log level, and log patterns
     // - the log level tells the logger what type of messages to output, the logger will only output messages with the current log level set and higher
     // - log levels under the current level set in the logger will be ignored
@@ -1378,11 +1958,18 @@ namespace lvn
     LVN_API void                        logEnableCoreLogging(bool enable);                                                // enable or disable logging from the core logger
     LVN_API void                        logSetLevel(LvnLogger* logger, LvnLogLevel level);                                // sets the log level of logger, will only print messages with set log level and higher
     LVN_API void                        logSetFileConfig(LvnLogger* logger, bool enable, const char* filename = "", LvnFileMode filemode = Lvn_FileMode_Write);  // sets the log file config, whether to enable logging and the log file name and mode
+    LVN_API void                        logSetFileOptions(LvnLogger* logger, const LvnLogFileOptions* options);          // sets the buffering, flushing and rotation of the log file of logger, writes out what was buffered under the old options
+    LVN_API void                        logFlushFile(LvnLogger* logger);                                                  // writes the buffered lines of the log file of logger, lvn::logFlush does this for every logger with a buffered file
+    LVN_API LvnResult                   logSetBinaryFileConfig(LvnLogger* logger, bool enable, const char* filename = ""); // writes the messages of logger to a binary log file instead of the console and text log file, the file is overwritten
+    LVN_API LvnResult                   logDecodeBinaryFile(LvnLogger* logger, const char* filepath, const char* outpath = nullptr); // renders a binary log file with the log patterns of logger into the text file outpath, or to the console when outpath is nullptr
     LVN_API bool                        logCheckLevel(LvnLogger* logger, LvnLogLevel level);                              // checks level with loger, returns true if level is the same or higher level than the level of the logger
+    LVN_API bool                        logShouldOutput(LvnLogger* logger, LvnLogLevel level);                            // checks the level and whether logging (and core logging for the core logger) is enabled, the log macros check this before formatting
     LVN_API void                        logRenameLogger(LvnLogger* logger, const char* name);                             // renames the name of the logger
     LVN_API void                        logOutputMessage(LvnLogger* logger, LvnLogMessage* msg);                          // prints the log message
     LVN_API LvnString                   logFormatMessage(LvnLogger* logger, LvnLogLevel level, const char* msg, bool removeANSI = false); // formats the log message into the log pattern set by the logger
     LVN_API void                        logMessage(LvnLogger* logger, LvnLogLevel level, const char* msg);                // log message with given log level
+    LVN_API bool                        logRateLimit(LvnLogRateLimit* limit, uint32_t* suppressed);                       // takes a token from limit, returns false if the message should be dropped, suppressed gets the messages dropped before this one
+    LVN_API void                        logFlush();                                                                       // waits until every message logged so far is written, only needed with async logging (eg. before printing to stdout directly)
     LVN_API void                        logMessageTrace(LvnLogger* logger, const char* fmt, ...);                         // log message with level trace; ANSI code "\x1b[0;37m"
     LVN_API void                        logMessageDebug(LvnLogger* logger, const char* fmt, ...);                         // log message with level debug; ANSI code "\x1b[0;34m"
     LVN_API void                        logMessageInfo(LvnLogger* logger, const char* fmt, ...);                          // log message with level info;  ANSI code "\x1b[0;32m"
@@ -1399,6 +1986,27 @@ namespace lvn
     LVN_API void                        destroyLogger(LvnLogger* logger);
 
 
+    // -- [SUBSECT]: Profiling Functions
+    // ------------------------------------------------------------
+
+    // LVN_PROFILE_SCOPE(name) records the time from the macro to the end of the scope as a zone of the calling thread
+    // - each thread writes its zones into its own ring buffer, once it is full the oldest zones are overwritten
+    // - zone names are stored as pointers and read when exporting, use string literals or lvn::profileInternString
+    // - lvn::profileExportChromeTrace writes the zones as chrome trace json, open the file in chrome://tracing or ui.perfetto.dev
+    // - recording costs two clock reads per zone and a check of one flag when it is disabled
+
+    LVN_API inline std::atomic<bool>    i_ProfileEnabled{false};
+
+    LVN_API void                        profileEnable(bool enable);                                                       // starts or stops recording zones
+    LVN_API bool                        profileIsEnabled();
+    LVN_API uint64_t                    profileGetTicks();                                                                // monotonic clock in nanoseconds the zones are timed with
+    LVN_API void                        profileRecordZone(const char* name, uint64_t start, uint64_t end);                // writes a zone into the ring buffer of the calling thread, used by LvnProfileScope
+    LVN_API void                        profileSetThreadName(const char* name);                                           // name of the calling thread in exported traces
+    LVN_API const char*                 profileInternString(const char* str);                                             // returns a copy of str that stays valid until the context is terminated, for zone names built at runtime
+    LVN_API LvnResult                   profileExportChromeTrace(const char* filepath);                                   // writes the recorded zones of every thread as chrome trace json, call while no thread is recording (eg. after profileEnable(false)) for a consistent trace
+    LVN_API void                        profileClear();                                                                   // drops the recorded zones of every thread, no thread may be recording during the call
+
+
     // -- [SUBSECT]: Event Functions
     // ------------------------------------------------------------
     // - Use these function within the call back function of LvnWindow (if set)
@@ -1429,15 +2037,21 @@ namespace lvn
     LVN_API void                        windowUpdate(LvnWindow* window);
     LVN_API bool                        windowOpen(LvnWindow* window);
     LVN_API void                        windowPollEvents();
+    LVN_API void                        windowWaitEvents(double timeout);                  // sleeps until an event arrives for any window or timeout seconds pass and processes the events like windowPollEvents, a negative timeout waits without limit
+    LVN_API void                        windowPostEmptyEvent();                            // wakes the thread blocked in windowWaitEvents, can be called from any thread
+    LVN_API void                        windowInvalidate(LvnWindow* window);               // request a redraw of the window and wake windowWaitEvents, can be called from any thread
+    LVN_API bool                        windowConsumeRedraw(LvnWindow* window);            // returns whether the window received an event or was invalidated since the last call and clears the request, windows start with a request pending
     LVN_API LvnPair<int>                windowGetDimensions(LvnWindow* window);
     LVN_API int                         windowGetWidth(LvnWindow* window);
     LVN_API int                         windowGetHeight(LvnWindow* window);
     LVN_API void                        windowSetEventCallback(LvnWindow* window, void (*callback)(LvnEvent*), void* userData);
+    LVN_API uint32_t                    windowConsumeEvents(LvnWindow* window, void (*callback)(LvnEvent*), uint32_t maxCount); // pops up to maxCount buffered events of a window created with eventQueueCapacity and passes each to callback on the calling thread, returns the number consumed
     LVN_API void                        windowSetVSync(LvnWindow* window, bool enable);
     LVN_API bool                        windowGetVSync(LvnWindow* window);
     LVN_API void*                       windowGetNativeWindow(LvnWindow* window);
     LVN_API LvnRenderPass*              windowGetRenderPass(LvnWindow* window);
     LVN_API void                        windowSetContextCurrent(LvnWindow* window);
+    LVN_API LvnResult                   windowReadPixels(LvnWindow* window, void* data, uint64_t size);  // copy the last frame submitted by a headless window into data (width * height * 4 bytes, bgra8), waits for the gpu to finish the frame
 
 
     // -- [SUBSECT]: Input Functions
@@ -1455,6 +2069,9 @@ namespace lvn
     LVN_API float                       mouseGetY(LvnWindow* window);
     LVN_API void                        mouseSetCursor(LvnWindow* window, LvnMouseCursor);
     LVN_API void                        mouseSetInputMode(LvnWindow* window, LvnMouseInputMode mode);
+    LVN_API bool                        mouseRawMotionSupported();
+    LVN_API void                        mouseSetRawMotion(LvnWindow* window, bool enable);                                        // use unscaled and unaccelerated motion from the device while the mouse input mode is Lvn_MouseInputMode_Disable
+    LVN_API uint32_t                    mouseGetMotionSamples(LvnWindow* window, LvnMouseMotionSample* samples, uint32_t maxCount); // pops up to maxCount cursor motion samples recorded since the last call, oldest first, returns the number written; needs mouseSampleCapacity in LvnWindowCreateInfo
 
     LVN_API LvnPair<int>                windowGetPos(LvnWindow* window);
     LVN_API void                        windowGetPos(LvnWindow* window, int* xpos, int* ypos);
@@ -1477,74 +2094,195 @@ namespace lvn
     LVN_API LvnResult                   checkPhysicalDeviceSupport(LvnPhysicalDevice* physicalDevice);
     LVN_API LvnResult                   setPhysicalDevice(LvnPhysicalDevice* physicalDevice);
     LVN_API LvnClipRegion               getRenderClipRegionEnum();
+    LVN_API LvnGraphicsMemoryStats      getGraphicsMemoryStats();                                                                                         // get the memory budget and usage of each heap and the memory allocated for each resource type (vulkan only, opengl returns empty stats)
 
     LVN_API void                        renderBeginNextFrame(LvnWindow* window);                                                                          // begins the next frame of the window
+    LVN_API LvnArena*                   renderGetFrameArena(LvnWindow* window);                                                                           // get the frame arena of the window, it is reset at the start of every renderBeginNextFrame so only use it for data that lives within the frame
     LVN_API void                        renderDrawSubmit(LvnWindow* window);                                                                              // submits all draw commands recorded and presents to window
+    LVN_API void                        renderBeginSubmitBatch();                                                                                         // renderDrawSubmit calls on the calling thread are collected until renderEndSubmitBatch instead of submitted one by one
+    LVN_API void                        renderEndSubmitBatch();                                                                                           // submits the collected frames of every window with one queue submit and presents them with one present (vulkan), the windows should begin their next frames after this call
     LVN_API void                        renderBeginCommandRecording(LvnWindow* window);                                                                   // begins command buffer when recording draw commands start
     LVN_API void                        renderEndCommandRecording(LvnWindow* window);                                                                     // ends command buffer when finished recording draw commands
+    LVN_API LvnResult                   renderBeginSecondaryCommandRecording(LvnWindow* window, LvnFrameBuffer* frameBuffer);                             // records the render commands of the calling thread into a secondary command buffer that continues the pass of the framebuffer, or of the window when frameBuffer is null, call after renderBeginNextFrame (vulkan only)
+    LVN_API void                        renderEndSecondaryCommandRecording(LvnWindow* window);                                                            // ends the secondary command buffer of the calling thread, buffers ended before their pass begins are executed by that pass, which then runs no inline commands
+    LVN_API LvnResult                   renderBeginCommandList(LvnWindow* window, LvnCommandList* commandList);                                           // record the render commands called on the window into the command list instead of the frame, replaces the commands previously recorded in the list
+    LVN_API void                        renderEndCommandList(LvnWindow* window);                                                                          // ends recording the command list, render commands are recorded to the frame again
+    LVN_API void                        renderCmdExecuteCommandList(LvnWindow* window, LvnCommandList* commandList);                                      // replay the commands of a command list recorded for the window, the list can be executed any number of times and in any frame
     LVN_API void                        renderCmdDraw(LvnWindow* window, uint32_t vertexCount);
     LVN_API void                        renderCmdDrawIndexed(LvnWindow* window, uint32_t indexCount);
     LVN_API void                        renderCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance);
     LVN_API void                        renderCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance);
+    LVN_API void                        renderCmdDrawIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);   // draws with the LvnDrawIndirectCommand structs stored in an indirect buffer, stride of zero means tightly packed
+    LVN_API void                        renderCmdDrawIndexedIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride); // draws with the LvnDrawIndexedIndirectCommand structs stored in an indirect buffer, stride of zero means tightly packed
+    LVN_API void                        renderCmdDrawIndexedIndirectCount(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, LvnBuffer* countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride); // same as renderCmdDrawIndexedIndirect but the draw count is read from a uint32_t in countBuffer on the gpu
     LVN_API void                        renderCmdSetStencilReference(uint32_t reference);
     LVN_API void                        renderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask);
+    LVN_API void                        renderCmdSetCullMode(LvnWindow* window, LvnCullFaceMode cullMode);                                                // set the cull mode of the bound pipeline, the pipeline must be created with Lvn_PipelineDynamicState_CullMode
+    LVN_API void                        renderCmdSetFrontFace(LvnWindow* window, LvnCullFrontFace frontFace);                                             // set the front face of the bound pipeline, the pipeline must be created with Lvn_PipelineDynamicState_FrontFace
+    LVN_API void                        renderCmdSetPrimitiveTopology(LvnWindow* window, LvnTopologyType topology);                                       // set the topology of the bound pipeline, the pipeline must be created with Lvn_PipelineDynamicState_PrimitiveTopology
+    LVN_API void                        renderCmdSetDepthTest(LvnWindow* window, bool enableDepth, bool depthWrite, LvnCompareOperation depthOpCompare); // set the depth test of the bound pipeline, the pipeline must be created with Lvn_PipelineDynamicState_DepthTest
+    LVN_API void                        renderCmdSetBlendEnable(LvnWindow* window, uint32_t attachment, bool enable);                                     // enable or disable blending of one color attachment of the bound pipeline, the pipeline must be created with Lvn_PipelineDynamicState_BlendEnable
+    LVN_API void                        renderCmdSetScissor(LvnWindow* window, int32_t x, int32_t y, uint32_t width, uint32_t height);                 // clip the following draws to a pixel rectangle of the render area with the origin at its bottom left corner, beginning a render pass or framebuffer resets it to the whole render area
     LVN_API void                        renderCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a);                                  // begins renderpass when rendering starts
     LVN_API void                        renderCmdEndRenderPass(LvnWindow* window);                                                                        // ends renderpass when rendering has finished
     LVN_API void                        renderCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline);                                                  // bind a pipeline to begin shading during rendering
     LVN_API void                        renderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets); // binds the vertex buffer within an LvnBuffer object
     LVN_API void                        renderCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset);                                  // binds the index buffer within an LvnBuffer object
     LVN_API void                        renderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets); // bind multiple descriptor sets to the shader (if multiple sets are used), Note that descriptor sets must be in order to how the sets are ordered in the pipeline
+    LVN_API void                        renderCmdBindDescriptorSetsDynamic(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets); // bind descriptor sets with one offset per dynamic uniform buffer binding, ordered by set then binding number, offsets are multiples of minUniformBufferOffsetAlignment
+    LVN_API void                        renderCmdPushConstants(LvnWindow* window, LvnPipeline* pipeline, LvnShaderStage shaderStage, uint32_t offset, uint32_t size, const void* data); // write push constants declared by the pipeline, the data is copied when the command is recorded
+    LVN_API void                        renderCmdDispatch(LvnWindow* window, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);     // dispatch the bound compute pipeline, must be recorded outside of render passes and framebuffers
+    LVN_API void                        renderCmdMemoryBarrier(LvnWindow* window, LvnMemoryBarrierFlagBits barriers);                                     // wait for earlier compute shader writes before the given uses of the data, must be recorded outside of render passes and framebuffers
+    LVN_API void                        renderCmdBeginTimestamp(LvnWindow* window, const char* name);                                                     // begin a named scope timed on the gpu, scopes can be nested and must be ended within the same frame
+    LVN_API void                        renderCmdEndTimestamp(LvnWindow* window);                                                                         // end the innermost timestamp scope
+    LVN_API uint32_t                    renderGetTimestamps(LvnWindow* window, LvnGpuTimestamp* pTimestamps, uint32_t timestampCount);                    // copy the scope times of the latest frame the gpu finished, returns the number of scopes available, pass nullptr to only get the count
+    LVN_API LvnFrameStats               getFrameStats();                                                                                                  // get the render command counts of the last completed frame, a frame ends when renderBeginNextFrame is called for the first window that began a frame
+    LVN_API uint32_t                    getFrameStatsHistory(LvnFrameStats* pStats, uint32_t statsCount);                                                 // copy the stats of up to the last LVN_FRAME_STATS_HISTORY frames oldest first, returns the number of frames available, pass nullptr to only get the count
+    LVN_API void                        setFrameStatsBudget(const LvnFrameStats* budget);                                                                 // warn when a completed frame exceeds a non zero count of the budget, pass nullptr to remove the budget
+    LVN_API uint64_t                    getFrameStatsOverBudgetCount();                                                                                   // number of frames that exceeded the budget since it was set
     LVN_API void                        renderCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer);                                        // begins the framebuffer for recording offscreen render calls, similar to beginning the render pass
     LVN_API void                        renderCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer);                                          // ends recording to the framebuffer
+    LVN_API void                        renderCmdReadbackFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData); // copy a color attachment as rendered so far this frame without waiting, func is called on a worker once the gpu finished the frame, record outside of render passes
+    LVN_API void                        renderCmdCaptureFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, const char* filename, int jpgQuality = 0); // save a color attachment of 8 bit channels as a png file (jpg when jpgQuality is between 1 and 100), read back and encoded off the render thread
 
     LVN_API LvnResult                   createShaderFromSrc(LvnShader** shader, const LvnShaderCreateInfo* createInfo);                                   // create shader with the source code as input
     LVN_API LvnResult                   createShaderFromFileBin(LvnShader** shader, const LvnShaderCreateInfo* createInfo);                               // create shader with the file paths to the binary files (.spv) as input
     LVN_API LvnResult                   createShaderFromFileSrc(LvnShader** shader, const LvnShaderCreateInfo* createInfo);                               // create shader with the file paths to the source files as input
     LVN_API LvnResult                   createDescriptorLayout(LvnDescriptorLayout** descriptorLayout, const LvnDescriptorLayoutCreateInfo* createInfo);  // create descriptor layout for the pipeline
-    LVN_API LvnResult                   createPipeline(LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo);                                  // create pipeline to describe shading specifications
+    LVN_API LvnResult                   createPipeline(LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo);                                  // create pipeline to describe shading specifications, equal create infos return the same shared pipeline
+    LVN_API LvnResult                   createPipelineAsync(LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo, LvnPipeline* fallback);     // create pipeline compiled on a background thread (vulkan), binds use the layout compatible fallback until it is ready, or wait for it without a fallback
+    LVN_API LvnResult                   createComputePipeline(LvnPipeline** pipeline, const LvnComputePipelineCreateInfo* createInfo);                    // create pipeline from a compute shader, destroyed with destroyPipeline
     LVN_API LvnResult                   createFrameBuffer(LvnFrameBuffer** frameBuffer, const LvnFrameBufferCreateInfo* createInfo);                      // create framebuffer to render images to
     LVN_API LvnResult                   createBuffer(LvnBuffer** buffer, const LvnBufferCreateInfo* createInfo);                                          // create a single buffer object that can hold both the vertex and index buffers
-    LVN_API LvnResult                   createSampler(LvnSampler** sampler, const LvnSamplerCreateInfo* createInfo);                                      // create a sampler object to store texture sampler data
-    LVN_API LvnResult                   createTexture(LvnTexture** texture, const LvnTextureCreateInfo* createInfo);                                      // create a texture object to store image data
+    LVN_API LvnResult                   createSampler(LvnSampler** sampler, const LvnSamplerCreateInfo* createInfo);                                      // create a sampler object to store texture sampler data, equal create infos share one reference counted sampler
+    LVN_API LvnResult                   createTexture(LvnTexture** texture, const LvnTextureCreateInfo* createInfo);                                      // create a texture object to store image data, textures and buffers can be created from loader threads and are fully uploaded once the call returns
     LVN_API LvnResult                   createTexture(LvnTexture** texture, const LvnTextureSamplerCreateInfo* createInfo);                               // create a texture object to store image data given a sampler object
     LVN_API LvnResult                   createCubemap(LvnCubemap** cubemap, const LvnCubemapCreateInfo* createInfo);                                      // create a cubemap texture object that holds the textures of the cubemap
-    LVN_API LvnResult                   createCubemap(LvnCubemap** cubemap, const LvnCubemapHdrCreateInfo* createInfo);                                   // create a cubemap texture object that holds the hdr texture of the cubemap
+    LVN_API LvnResult                   createCubemap(LvnCubemap** cubemap, const LvnCubemapHdrCreateInfo* createInfo);                                   // create a cubemap texture object from an equirectangular hdr image, the conversion runs on the gpu
+    LVN_API LvnResult                   createEnvironmentMap(LvnEnvironmentMap** environmentMap, const LvnEnvironmentMapCreateInfo* createInfo);          // create the image based lighting textures of an hdr environment in one gpu submission, optionally cached to disk
+    LVN_API LvnResult                   createTextureStream(LvnTextureStream** textureStream, const LvnTextureStreamCreateInfo* createInfo);              // create a texture that starts as a placeholder and is refined by textureStreamUpdate once the image is decoded on a worker
+    LVN_API LvnResult                   createTextureAtlas(LvnTextureAtlas** textureAtlas, const LvnTextureAtlasCreateInfo* createInfo);                 // create an atlas that packs many images into a few shared page textures
+    LVN_API LvnResult                   createLightClusters(LvnLightClusters** lightClusters, const LvnLightClustersCreateInfo* createInfo);              // create a froxel grid that bins lights into per cluster index lists stored in a storage buffer for clustered forward shading
+    LVN_API LvnResult                   createShadowCache(LvnShadowCache** shadowCache, const LvnShadowCacheCreateInfo* createInfo);                      // create a shadow map split into a static layer rendered only when invalidated and a dynamic layer rendered every frame
+    LVN_API LvnResult                   createMaterialTable(LvnMaterialTable** materialTable, const LvnMaterialTableCreateInfo* createInfo);              // create a storage buffer of materials and one texture array shared by every material, bound together with a single descriptor set
 
 
     LVN_API void                        destroyShader(LvnShader* shader);                                                                                 // destroy shader module object
     LVN_API void                        destroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout);                                                   // destroy descriptor layout
-    LVN_API void                        destroyPipeline(LvnPipeline* pipeline);                                                                           // destroy pipeline object
+    LVN_API bool                        pipelineIsReady(LvnPipeline* pipeline);                                                                           // true once a pipeline created with createPipelineAsync has finished compiling
+
+    LVN_API uint32_t                    hotReloadUpdate();                                                                                                 // reload the watched files that changed on disk, called by renderBeginNextFrame when rendering.enableHotReload is set, returns the number of files reloaded
+    LVN_API LvnResult                   hotReloadWatchFile(const char* filepath, LvnFileChangedFunc func, void* userData);                                 // call func from hotReloadUpdate each time the file changes, for assets the library does not reload by itself
+    LVN_API void                        hotReloadUnwatchFile(const char* filepath, LvnFileChangedFunc func, void* userData);
+    LVN_API LvnResult                   hotReloadWatchTexture(LvnTexture* texture, const char* filepath);                                                 // reload the base level of an uncompressed texture from an image file, the image must keep the size of the texture
+    LVN_API LvnResult                   hotReloadWatchModel(LvnModel* model, const char* filepath, const LvnVertexLayout* layout = nullptr, LvnMeshOptimizeFlagBits optimize = Lvn_MeshOptimizeFlag_None); // replace model with a reload of the file and unload the old one, the model must stay at the same address while watched
+    LVN_API void                        hotReloadUnwatch(const void* object);                                                                             // stop reloading a texture or model, destroyTexture and unloadModel do this by themselves
+    LVN_API void                        destroyPipeline(LvnPipeline* pipeline);                                                                           // destroy pipeline object, shared pipelines are destroyed once every create call has been matched by a destroy
     LVN_API void                        destroyFrameBuffer(LvnFrameBuffer* frameBuffer);                                                                  // destroy framebuffer object
     LVN_API void                        destroyBuffer(LvnBuffer* buffer);                                                                                 // destory buffers object
-    LVN_API void                        destroySampler(LvnSampler* sampler);                                                                              // destroy sampler object
+    LVN_API void                        destroySampler(LvnSampler* sampler);                                                                              // destroy sampler object, a shared sampler is destroyed with its last reference
     LVN_API void                        destroyTexture(LvnTexture* texture);                                                                              // destroy texture object
     LVN_API void                        destroyCubemap(LvnCubemap* cubemap);                                                                              // destroy cubemap object
+    LVN_API void                        destroyEnvironmentMap(LvnEnvironmentMap* environmentMap);                                                         // destroy environment map object and its textures
+    LVN_API void                        destroyTextureStream(LvnTextureStream* textureStream);                                                            // destroy texture stream and its current texture, waits for the decode if it is still running
+    LVN_API void                        destroyTextureAtlas(LvnTextureAtlas* textureAtlas);                                                               // destroy texture atlas and its page textures
+    LVN_API void                        destroyLightClusters(LvnLightClusters* lightClusters);                                                            // destroy light clusters and their storage buffer
+    LVN_API void                        destroyShadowCache(LvnShadowCache* shadowCache);                                                                  // destroy shadow cache and its framebuffers
+    LVN_API void                        destroyMaterialTable(LvnMaterialTable* materialTable);                                                            // destroy material table, its buffer and descriptor set, the textures of the materials are not destroyed
+
+    LVN_API LvnResult                   createCommandList(LvnCommandList** commandList);                                                                  // create an empty command list to record render commands once and execute them every frame (eg. static ui or scene passes)
+    LVN_API void                        destroyCommandList(LvnCommandList* commandList);                                                                  // destroy command list, objects used by the recorded commands are not destroyed and must outlive the list, transient descriptor sets cannot be recorded
+
+    LVN_API LvnResult                   createRenderGraph(LvnRenderGraph** renderGraph);                                                                  // create an empty render graph, passes and resources are declared before compiling it
+    LVN_API void                        destroyRenderGraph(LvnRenderGraph* renderGraph);                                                                  // destroy render graph and the transient framebuffers it created, imported resources are not destroyed
+    LVN_API LvnRenderGraphResource      renderGraphImportFrameBuffer(LvnRenderGraph* renderGraph, LvnFrameBuffer* frameBuffer);                           // declare a framebuffer owned by the caller, its contents are kept between frames
+    LVN_API LvnRenderGraphResource      renderGraphImportBuffer(LvnRenderGraph* renderGraph, LvnBuffer* buffer);                                          // declare a buffer owned by the caller so passes can read or write it
+    LVN_API LvnRenderGraphResource      renderGraphImportWindow(LvnRenderGraph* renderGraph);                                                             // declare the window render pass the graph is executed in, usually the output of the graph
+    LVN_API LvnRenderGraphResource      renderGraphCreateFrameBuffer(LvnRenderGraph* renderGraph, const LvnFrameBufferCreateInfo* createInfo);            // declare a framebuffer owned by the graph, transient framebuffers with matching create infos and no overlapping passes share one framebuffer
+    LVN_API LvnResult                   renderGraphAddPass(LvnRenderGraph* renderGraph, const LvnRenderGraphPassCreateInfo* createInfo);                  // add a pass, passes run in the order they are added and may only read resources written by earlier passes
+    LVN_API LvnResult                   renderGraphCompile(LvnRenderGraph* renderGraph, LvnRenderGraphResource output);                                   // cull passes that do not contribute to the output, allocate transient framebuffers and plan the barriers between passes
+    LVN_API void                        renderGraphExecute(LvnRenderGraph* renderGraph, LvnWindow* window);                                               // record the compiled passes, call between renderBeginCommandRecording and renderEndCommandRecording outside of any render pass
+    LVN_API LvnFrameBuffer*             renderGraphGetFrameBuffer(LvnRenderGraph* renderGraph, LvnRenderGraphResource resource);                          // get the framebuffer of a framebuffer resource, transient framebuffers are only valid after compiling
 
     LVN_API uint32_t                    getAttributeFormatSize(LvnAttributeFormat format);
     LVN_API uint32_t                    getAttributeFormatComponentSize(LvnAttributeFormat format);
     LVN_API bool                        isAttributeFormatNormalizedType(LvnAttributeFormat format);
+    LVN_API uint32_t                    vertexLayoutGetStride(const LvnVertexLayout& layout);                                                            // size in bytes of one vertex in the layout
+    LVN_API uint32_t                    vertexLayoutGetAttributes(const LvnVertexLayout& layout, LvnVertexAttribute* pAttributes, uint32_t binding = 0); // writes the attributes of the layout to pAttributes (up to 8, may be nullptr) and returns their count, attribute locations match the members of LvnVertex
+    LVN_API void                        vertexLayoutPack(const LvnVertexLayout& layout, const LvnVertex* pVertices, uint64_t count, void* dst);          // converts vertices into the layout, dst must hold count * vertexLayoutGetStride(layout) bytes
     LVN_API void                        pipelineSpecificationSetConfig(LvnPipelineSpecification* pipelineSpecification);
     LVN_API LvnPipelineSpecification    configPipelineSpecificationInit();
-    LVN_API LvnResult                   allocateDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout);                   // create descriptor set to uplaod uniform data to pipeline
+    LVN_API LvnResult                   allocateDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout);                   // create descriptor set to uplaod uniform data to pipeline, new pools are chained to the layout once its pools are full
+    LVN_API LvnResult                   allocateTransientDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout);          // allocate a descriptor set only valid for the frame being recorded, transient sets are reset in bulk once that frame retires
+    LVN_API LvnDescriptorLayoutStats    descriptorLayoutGetStats(LvnDescriptorLayout* descriptorLayout);                                                  // get the pool and set usage of a descriptor layout
 
-    LVN_API void                        bufferUpdateData(LvnBuffer* buffer, void* data, uint64_t size, uint64_t offset);
+    LVN_API void                        bufferUpdateData(LvnBuffer* buffer, void* data, uint64_t size, uint64_t offset);                                          // write data to the buffer, ring and device local buffers write the region of the frame recorded next, updates made after a present go to the frame the next renderBeginNextFrame begins
     LVN_API void                        bufferResize(LvnBuffer* buffer, uint64_t size);
+    LVN_API void*                       bufferGetMappedData(LvnBuffer* buffer);                                                                                   // get the persistently mapped memory region of a ring buffer for the frame recorded next, returns nullptr if the buffer cannot be written to directly
+    LVN_API void*                       bufferMap(LvnBuffer* buffer);                                                                                             // map the region of the frame recorded next for writing (the frame the next renderBeginNextFrame begins when called after a present), written ranges are committed with bufferMarkRange and bufferUnmapRange, returns nullptr for static buffers
+    LVN_API void                        bufferMarkRange(LvnBuffer* buffer, uint64_t offset, uint64_t size);                                                       // mark a range written through bufferMap as dirty, adjacent and overlapping ranges are coalesced into one flush
+    LVN_API void                        bufferUnmapRange(LvnBuffer* buffer, uint64_t offset, uint64_t size);                                                      // mark the last written range, flush the coalesced dirty range in one upload and unmap the buffer, size may be zero if every range was already marked
+    LVN_API LvnResult                   textureUpdateData(LvnTexture* texture, const void* pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height);      // update a region of the base mip level of an uncompressed texture, pixels are tightly packed with the channel count the texture was created with
+
+    LVN_API LvnTextureStreamCreateInfo  configTextureStreamInit(const char* filepath);
+    LVN_API uint64_t                    textureStreamUpdate(LvnTextureStream** pTextureStreams, uint32_t textureStreamCount, uint64_t budget);                   // upload the next levels of decoded streams within budget bytes, call once per frame, previews go first and a level larger than the budget is only uploaded alone, returns the bytes uploaded
+    LVN_API LvnTexture*                 textureStreamGetTexture(LvnTextureStream* textureStream);                                                                 // current texture of the stream, it is replaced when a level is uploaded so descriptor sets using it must be updated
+    LVN_API LvnTextureStreamLevel       textureStreamGetLevel(LvnTextureStream* textureStream);                                                                   // level of the current texture, streams that failed to decode stay at the placeholder
+    LVN_API bool                        textureStreamIsDone(LvnTextureStream* textureStream);                                                                     // true once the full image is uploaded or the image failed to decode
+
+    LVN_API LvnTextureAtlasCreateInfo   configTextureAtlasInit();
+    LVN_API LvnResult                   textureAtlasAdd(LvnTextureAtlas* textureAtlas, const LvnImageData& imageData, uint32_t* pRegion);                         // pack an uncompressed image into the first page with room, opening a new page if none has, the region index is written to pRegion
+    LVN_API void                        textureAtlasUpdate(LvnTextureAtlas* textureAtlas);                                                                        // upload the pages changed since the last update, images added before the call are only visible in the page textures after it
+    LVN_API LvnTextureAtlasRegion       textureAtlasGetRegion(LvnTextureAtlas* textureAtlas, uint32_t region);                                                    // page and uvs of an image added with textureAtlasAdd
+    LVN_API LvnTexture*                 textureAtlasGetPageTexture(LvnTextureAtlas* textureAtlas, uint32_t pageIndex);                                            // returns nullptr until the page is first uploaded by textureAtlasUpdate, the texture stays the same for the life of the atlas
+    LVN_API uint32_t                    textureAtlasGetPageCount(LvnTextureAtlas* textureAtlas);
 
     LVN_API LvnTexture*                 cubemapGetTextureData(LvnCubemap* cubemap);                                                                               // get the cubemap texture from the cubemap
+    LVN_API LvnTexture*                 environmentMapGetCubemap(LvnEnvironmentMap* environmentMap);                                                              // get the mipmapped environment cubemap, used for the skybox
+    LVN_API LvnTexture*                 environmentMapGetIrradiance(LvnEnvironmentMap* environmentMap);                                                           // get the diffuse irradiance cubemap
+    LVN_API LvnTexture*                 environmentMapGetPrefilter(LvnEnvironmentMap* environmentMap);                                                            // get the prefiltered specular cubemap, roughness maps linearly from 0 at mip 0 to 1 at the last mip
+    LVN_API LvnTexture*                 environmentMapGetBrdfLut(LvnEnvironmentMap* environmentMap);                                                              // get the split sum brdf lookup texture, sampled with (NdotV, roughness) and storing (scale, bias) in rg
+    LVN_API uint32_t                    lightClustersUpdate(LvnLightClusters* lightClusters, const LvnMat4& view, const LvnCamera& camera, const LvnVec4* pLights, uint32_t lightCount); // bins lights stored as (world position, radius) into the clusters of the camera and writes the buffer of the current frame, camera.fov is the vertical fov in radians, returns the number of light indices written
+    LVN_API LvnBuffer*                  lightClustersGetBuffer(LvnLightClusters* lightClusters);                                                                  // storage buffer read by the shader source of lightClustersGetShaderSource, bind it as a storage buffer descriptor
+    LVN_API const char*                 lightClustersGetShaderSource();                                                                                           // glsl declarations and lookup functions of the cluster buffer to paste into fragment shaders, define LVN_LIGHT_CLUSTERS_BINDING before it to change the binding from 8
+    LVN_API void                        shadowCacheInvalidate(LvnShadowCache* shadowCache);                                                                       // mark the static layer stale, call when a static caster is added, moved or removed
+    LVN_API bool                        shadowCacheBeginStatic(LvnWindow* window, LvnShadowCache* shadowCache, const LvnMat4& lightMatrix);                       // begins the static layer and returns true only if it was invalidated or the light matrix changed, draw the static casters and call shadowCacheEndStatic when it returns true
+    LVN_API void                        shadowCacheEndStatic(LvnWindow* window, LvnShadowCache* shadowCache);
+    LVN_API void                        shadowCacheBeginDynamic(LvnWindow* window, LvnShadowCache* shadowCache);                                                  // begins the dynamic layer, draw the moving casters with the light matrix of the static layer every frame
+    LVN_API void                        shadowCacheEndDynamic(LvnWindow* window, LvnShadowCache* shadowCache);
+    LVN_API LvnTexture*                 shadowCacheGetStaticImage(LvnShadowCache* shadowCache);                                                                   // depth of the static casters stored in the red channel, cleared to 1
+    LVN_API LvnTexture*                 shadowCacheGetDynamicImage(LvnShadowCache* shadowCache);                                                                  // depth of the dynamic casters stored in the red channel, cleared to 1
+    LVN_API const LvnMat4&              shadowCacheGetLightMatrix(LvnShadowCache* shadowCache);                                                                   // light matrix the static layer was last rendered with
+    LVN_API const char*                 shadowCacheGetShaderSource();                                                                                             // glsl samplers and lookup functions that composite both layers, define LVN_SHADOW_STATIC_BINDING and LVN_SHADOW_DYNAMIC_BINDING before it to change the bindings from 9 and 10
 
     LVN_API void                        updateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count);           // update the descriptor content within a descroptor set
+    LVN_API void                        updateDescriptorSetsData(const LvnDescriptorSetUpdate* pUpdates, uint32_t count);                                         // update many descriptor sets in one call, vulkan writes every set that is not in flight together
 
     LVN_API LvnTexture*                 frameBufferGetImage(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex);                                               // get the texture image data (render pass attachment) from the framebuffer via the attachment index
     LVN_API LvnRenderPass*              frameBufferGetRenderPass(LvnFrameBuffer* frameBuffer);                                                                    // get the render pass from the framebuffer
     LVN_API void                        frameBufferResize(LvnFrameBuffer* frameBuffer, uint32_t width, uint32_t height);                                          // update the width and height of the new framebuffer (updates the image data dimensions), Note: call only when the image dimensions need to be changed
     LVN_API void                        frameBufferSetClearColor(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, float r, float g, float b, float a);      // set the background color for the framebuffer for offscreen rendering
+    LVN_API void                        frameBufferSetRenderScale(LvnFrameBuffer* frameBuffer, float scale);                                                      // render later passes into the scaled sub rectangle at the origin of the attachments without reallocating them, scale is clamped to (0, 1] and kept across resizes
+    LVN_API float                       frameBufferGetRenderScale(LvnFrameBuffer* frameBuffer);
+    LVN_API void                        frameBufferGetRenderSize(LvnFrameBuffer* frameBuffer, uint32_t* width, uint32_t* height);                                 // size of the rendered sub rectangle, the full size of the framebuffer unless a render scale is set
+    LVN_API LvnVec2                     frameBufferGetRenderUvScale(LvnFrameBuffer* frameBuffer);                                                                 // multiply uvs by this when sampling the images of a scaled framebuffer to upscale the rendered sub rectangle over the full target
+    LVN_API LvnRenderScaleController    configRenderScaleControllerInit(float targetGpuTime);                                                                     // controller aiming for targetGpuTime milliseconds of gpu time per frame between render scales of 0.5 and 1
+    LVN_API float                       renderScaleControllerUpdate(LvnRenderScaleController* controller, float gpuTime);                                        // feed the gpu time of the latest finished frame (eg. from renderGetTimestamps) and get the render scale for the next frame
+    LVN_API LvnResult                   frameBufferReadPixels(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, void* data, uint64_t size);                  // copy a color attachment as last rendered into data (width * height * pixel size of the attachment format), waits for the gpu, meant for captures and tests
     LVN_API LvnDepthImageFormat         findSupportedDepthImageFormat(LvnDepthImageFormat* pDepthImageFormats, uint32_t count);
 
     LVN_API LvnImageData                loadImageData(const char* filepath, int forceChannels = 0, bool flipVertically = false);
     LVN_API LvnImageData                loadImageDataMemory(const uint8_t* data, int length, int forceChannels = 0, bool flipVertically = false);
     LVN_API LvnImageData                loadImageDataThread(const LvnString filepath, int forceChannels = 0, bool flipVertically = false);
     LVN_API LvnImageData                loadImageDataMemoryThread(const uint8_t* data, int length, int forceChannels = 0, bool flipVertically = false);
+    LVN_API LvnResult                   loadImageDataMemoryInto(const uint8_t* data, uint64_t length, uint8_t* dst, uint64_t dstSize, int forceChannels = 0, bool flipVertically = false); // decode into caller memory, eg. a mapped staging buffer, dst must hold width * height * channels bytes from imageGetInfo, can be called from any thread
+    LVN_API LvnResult                   imageGetInfo(const uint8_t* data, uint64_t length, uint32_t* width, uint32_t* height, uint32_t* channels);                 // read the size and channel count of an encoded image from its header without decoding it
     LVN_API LvnImageHdrData             loadHdrImageData(const char* filepath, int forceChannels = 0, bool flipVertically = false);
+    LVN_API LvnImageHdrData             loadHdrImageData(const char* filepath, LvnHdrImageFormat format, bool flipVertically = false, const char* cachePath = nullptr); // decode and convert to format (half is rgba, rgb9e5 is rgb), the converted texels are loaded from and written to cachePath if given, can be called from any thread
+    LVN_API void                        loadHdrImageDataAsync(const char* filepath, LvnHdrImageFormat format, LvnImageHdrData* pImageData, LvnJobCounter* counter, bool flipVertically = false, const char* cachePath = nullptr); // decode and convert on the job system, pImageData is written once counter reaches zero, wait for counter with jobWait
+    LVN_API LvnImageData                loadImageDataCompressed(const char* filepath, LvnVector<LvnImageData>* pMipLevels = nullptr);                 // load block compressed image data from a ktx2 or dds file, mip levels after the first are stored in pMipLevels if not null
+    LVN_API LvnImageData                loadImageDataCompressedMemory(const uint8_t* data, uint64_t length, LvnVector<LvnImageData>* pMipLevels = nullptr); // load block compressed image data from ktx2 or dds file data in memory
+    LVN_API uint64_t                    imageGetCompressedSize(LvnTextureCompression compression, uint32_t width, uint32_t height);                 // size in bytes of a block compressed image with the given dimensions
 
     LVN_API LvnResult                   writeImagePng(const LvnImageData& imageData, const char* filename);               // writes the image data into a png file with the filename/filepath
     LVN_API LvnResult                   writeImageJpg(const LvnImageData& imageData, const char* filename, int quality);  // writes the image data into a jpg file with the filename/filepath and the jpg quality (from 0...100)
@@ -1554,14 +2292,54 @@ namespace lvn
     LVN_API void                        imageFlipHorizontally(LvnImageData& imageData);                                   // flips the image horizontally
     LVN_API void                        imageRotateCW(LvnImageData& imageData);                                           // rotates the image clockwise (right)
     LVN_API void                        imageRotateCCW(LvnImageData& imageData);                                          // rotates the image counter clockwise (left)
+    LVN_API void                        imageConvertChannels(uint8_t* dst, uint32_t dstChannels, const uint8_t* src, uint32_t srcChannels, uint64_t pixelCount); // converts 8 bit pixels between 1 to 4 channels, gray fills every color channel and a missing alpha is opaque
+    LVN_API LvnImageData                imageSetChannels(const LvnImageData& imageData, uint32_t channels);               // returns a copy of the image data converted to the number of channels
+    LVN_API LvnImageData                imageGetView(const LvnImageData& imageData);                                      // copy of imageData that borrows its pixels instead of copying them, eg. for texture create infos, imageData must outlive the view
+    LVN_API uint32_t                    imageGetMipLevelCount(uint32_t width, uint32_t height);                           // number of mip levels in a full mip chain down to 1x1 for an image of the given size
+    LVN_API LvnImageData                imageResize(const LvnImageData& imageData, uint32_t width, uint32_t height, LvnImageFilter filter = Lvn_ImageFilter_Bilinear, bool srgb = false); // resampled copy of the image, srgb filters the color channels in linear space, alpha is premultiplied while filtering
+    LVN_API LvnVector<LvnImageData>     imageGenerateMips(const LvnImageData& imageData, LvnImageFilter filter = Lvn_ImageFilter_Box, bool srgb = false); // mip levels 1 and up of a full mip chain, each filtered from the level above without requantizing, eg. for pMipImageData
 
     LVN_API LvnImageData                imageGenWhiteNoise(uint32_t width, uint32_t height, uint32_t channels);
     LVN_API LvnImageData                imageGenWhiteNoise(uint32_t width, uint32_t height, uint32_t channels, uint32_t seed);
     LVN_API LvnImageData                imageGenGrayScaleNoise(uint32_t width, uint32_t height, uint32_t channels);
     LVN_API LvnImageData                imageGenGrayScaleNoise(uint32_t width, uint32_t height, uint32_t channels, uint32_t seed);
 
-    LVN_API LvnModel                    loadModel(const char* filepath);
+    LVN_API LvnModel                    loadModel(const char* filepath);                                                  // loads a gltf, glb, obj or cooked lvnmodel file, meshes use the LvnVertex layout
+    LVN_API LvnModel                    loadModel(const char* filepath, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize = Lvn_MeshOptimizeFlag_None); // loads a model with its vertices converted to layout and its triangle lists optimized, cooked files keep the layout and order they were cooked with
     LVN_API void                        unloadModel(LvnModel* model);
+    LVN_API LvnResult                   cookModel(const char* filepath, const char* outpath, const LvnVertexLayout* layout = nullptr, LvnMeshOptimizeFlagBits optimize = Lvn_MeshOptimizeFlag_All); // loads a gltf, glb or obj model and writes it to outpath as a cooked .lvnmodel file, cooked files are mapped and uploaded by loadModel without parsing or recomputing vertex data, layout is LvnVertex if nullptr
+
+    LVN_API void                        meshOptimizeVertexCache(uint32_t* indices, uint64_t indexCount, uint64_t vertexCount);                                                              // reorders the triangles of a triangle list in place to reuse transformed vertices
+    LVN_API void                        meshOptimizeOverdraw(uint32_t* indices, uint64_t indexCount, const float* positions, uint64_t vertexCount, uint64_t positionStride, float threshold = 1.05f); // reorders triangle clusters of a vertex cache optimized list so outward facing ones draw first, threshold is how much worse the vertex cache may get, positionStride is in bytes
+    LVN_API uint64_t                    meshOptimizeVertexFetchRemap(uint32_t* remap, uint32_t* indices, uint64_t indexCount, uint64_t vertexCount);                                         // renumbers vertices in the order the indices first use them, remap[old] is the new index or UINT32_MAX if unused, returns the number of used vertices
+    LVN_API void                        meshRemapVertices(void* dst, const void* src, uint64_t vertexCount, uint64_t vertexSize, const uint32_t* remap);                                      // moves vertices to their remapped index, dst and src must not overlap
+    LVN_API uint64_t                    meshSimplify(uint32_t* dst, const uint32_t* indices, uint64_t indexCount, const float* positions, uint64_t vertexCount, uint64_t positionStride, uint64_t targetIndexCount, float targetError, float* resultError = nullptr); // collapses edges of a triangle list into dst until targetIndexCount or targetError (in position units) is reached, vertices are kept and only indices change, returns the index count written to dst
+    LVN_API float                       lodGetScreenScale(float fovy, float screenHeight);                                                                                                    // pixels per unit of error at a distance of one for a perspective projection, fovy in radians
+    LVN_API LvnPrimitiveLod             primitiveSelectLod(const LvnPrimitive& primitive, const LvnMat4& matrix, const LvnVec3& cameraPosition, float screenScale, float maxPixelError = 1.0f); // picks the coarsest lod of the primitive whose error projects under maxPixelError pixels, matrix is the world matrix of the node, returns the full index range if the primitive has no lods
+    LVN_API void                        modelCullPrimitives(const LvnModel& model, const LvnMat4* pNodeMatrices, const LvnFrustum& frustum, LvnVector<LvnVisiblePrimitive>* pVisible); // replaces pVisible with the primitives of every node whose world bounds intersect the frustum, pNodeMatrices are the world matrices of modelGetNodeMatrices
+    LVN_API uint32_t                    modelGetInstanceCount(const LvnModel& model, uint32_t instanceCount);                                                // number of LvnModelInstance entries modelWriteInstances writes for instanceCount instances of the model, nodes with gpu instances add one entry per instance of the node
+    LVN_API void                        modelWriteInstances(const LvnModel& model, const LvnMat4* pNodeMatrices, const LvnModelInstance* pInstances, uint32_t instanceCount, LvnModelInstance* pDst); // expands instances of the model into per node instances in node order, pDst must hold modelGetInstanceCount entries and is usually the mapped instance buffer
+    LVN_API void                        renderCmdDrawModelInstanced(LvnWindow* window, const LvnModel& model, LvnPipeline* pipeline, LvnBuffer* instanceBuffer, uint64_t instanceOffset, uint32_t instanceCount); // draws every primitive once for all instances written by modelWriteInstances, mesh vertices are bound to binding 0 and the instance buffer to binding 1 with per instance input rate
+    LVN_API void                        renderCmdDrawModelMaterials(LvnWindow* window, const LvnModel& model, LvnPipeline* pipeline, LvnMaterialTable* materialTable, uint32_t setIndex, LvnBuffer* instanceBuffer, uint64_t instanceOffset, uint32_t instanceCount); // renderCmdDrawModelInstanced that binds the material table once at setIndex and pushes the material index of each primitive as a uint at push constant offset 0 instead of binding per primitive descriptor sets
+
+    LVN_API uint32_t                    materialTableAdd(LvnMaterialTable* materialTable, const LvnMaterial& material);                                      // adds the material and its textures to the table and returns its material index, identical materials share one index, returns UINT32_MAX if the table is full
+    LVN_API LvnResult                   materialTableAddModel(LvnMaterialTable* materialTable, LvnModel* model);                                             // adds the material of every primitive of the model and writes its index to primitive.materialIndex
+    LVN_API void                        materialTableUpdate(LvnMaterialTable* materialTable);                                                                // uploads the materials and texture array added since the last update, call before drawing with the table
+    LVN_API LvnDescriptorLayout*        materialTableGetDescriptorLayout(LvnMaterialTable* materialTable);                                                   // layout of the table descriptor set, add it to the descriptor layouts of pipelines reading materials
+    LVN_API LvnDescriptorSet*           materialTableGetDescriptorSet(LvnMaterialTable* materialTable);
+    LVN_API const char*                 materialTableGetShaderSource(LvnMaterialTable* materialTable);                                                       // glsl declarations of the material buffer, texture array and material index push constant to paste after #version, define LVN_MATERIAL_TABLE_SET before it to change the vulkan set from 1 and LVN_MATERIAL_TABLE_NO_PUSH_CONSTANTS to declare uint lvnMaterialIndex in your own push constant block
+
+    LVN_API void                        animationSample(LvnAnimation* animation, float time, LvnNode* pNodes);                                               // writes the transforms of the channels at time into pNodes, the nodes of the model the animation belongs to, channels cache the last keyframe so playing forward does not search
+    LVN_API void                        modelGetNodeMatrices(const LvnModel& model, LvnMat4* pMatrices);                                                      // computes the world matrix of every node from the node transforms, parents first, pMatrices must hold model.nodes.size() matrices
+    LVN_API void                        skinGetJointMatrices(const LvnSkin& skin, const LvnMat4* pNodeMatrices, LvnMat4* pJointMatrices);                    // joint matrices of the skin from the world matrices of modelGetNodeMatrices, pJointMatrices must hold skin.joints.size() matrices
+    LVN_API void                        modelUpdateAnimation(LvnModel* model, uint32_t animation, float dt);                                                  // advances and loops the animation by dt seconds, samples it into the nodes and uploads the joint matrices of every skin to its ssbo
+    LVN_API void                        modelUpdateAnimations(LvnModel** pModels, uint32_t modelCount, uint32_t animation, float dt);                        // modelUpdateAnimation for many models, the models are evaluated in parallel and the skin buffers are updated once all are done, models without the animation are skipped
+    LVN_API void                        modelBuildHierarchy(const LvnModel& model, LvnNodeHierarchy* pHierarchy);                                            // flattens the nodes of the model into pHierarchy with every entry dirty, rebuild it when nodes are added, removed or reparented
+    LVN_API void                        hierarchySetTransform(LvnNodeHierarchy* pHierarchy, uint32_t node, const LvnTransform& transform);                  // sets the local transform of a model node and marks its subtree dirty
+    LVN_API void                        hierarchySyncNodes(LvnNodeHierarchy* pHierarchy, const LvnNode* pNodes);                                            // copies the transforms of pNodes, the nodes of the model, and marks the ones that changed dirty, use after animationSample
+    LVN_API uint32_t                    hierarchyUpdate(LvnNodeHierarchy* pHierarchy);                                                                       // recomputes the world matrices of dirty subtrees in one linear pass, returns the number of world matrices updated
+    LVN_API void                        hierarchyGetNodeMatrices(const LvnNodeHierarchy& hierarchy, LvnMat4* pMatrices);                                     // copies the world matrices in model node order, same layout as modelGetNodeMatrices
+    LVN_API const LvnMat4&              hierarchyGetWorldMatrix(const LvnNodeHierarchy& hierarchy, uint32_t node);                                           // world matrix of a model node as of the last hierarchyUpdate
 
 
     // -- [SUBSECT]: Audio Functions
@@ -1573,10 +2351,15 @@ namespace lvn
     LVN_API void                        audioSetGlobalTimeMilliSeconds(uint64_t ms);
     LVN_API void                        audioSetGlobalTimePcmFrames(uint64_t pcm);
     LVN_API void                        audioSetMasterVolume(float volume);
+    LVN_API void                        audioSetMaxVoices(uint32_t maxVoices);  // sounds mixed at once by audioUpdateVoices, 0 mixes every audible sound (default: 64)
 
     LVN_API uint32_t                    audioGetSampleRate();
+    LVN_API LvnAudioDeviceInfo          audioGetDeviceInfo();                     // settings the audio device was opened with, which can differ from the requested ones
     LVN_API uint64_t                    audioGetGlobalTimeMilliseconds();
     LVN_API uint64_t                    audioGetGlobalTimePcmFrames();
+    LVN_API uint32_t                    audioGetMaxVoices();
+    LVN_API void                        audioGetVoiceCounts(uint32_t* pMixed, uint32_t* pVirtual); // counts of the last audioUpdateVoices
+    LVN_API void                        audioUpdateVoices();                      // ranks playing sounds by priority and audible gain, sounds past the voice budget or too quiet to hear are virtualized and keep time without being mixed, call once per frame
 
     LVN_API void                        listenerSetPosition(float x, float y, float z);
     LVN_API void                        listenerSetPosition(const LvnVec3& pos);
@@ -1594,6 +2377,7 @@ namespace lvn
     LVN_API void                        listenerGetCone(float* innerAngleRad, float* outerAngleRad, float* outerGain);
 
     LVN_API LvnResult                   createSound(LvnSound** sound, const LvnSoundCreateInfo* createInfo);
+    LVN_API LvnResult                   createSoundAsync(LvnSound** sound, const LvnSoundCreateInfo* createInfo); // returns right away and loads the file on the job thread of the audio engine, the sound can be configured and started meanwhile and plays once its data is loaded; sounds in packs and sounds streamed with multithreading are created as with createSound
     LVN_API void                        destroySound(LvnSound* sound);
     LVN_API LvnSoundCreateInfo          configSoundInit(const char* filepath);
 
@@ -1615,6 +2399,8 @@ namespace lvn
     LVN_API void                        soundSetMinDistance(LvnSound* sound, float minDist);
     LVN_API void                        soundSetMaxDistance(LvnSound* sound, float maxDist);
     LVN_API void                        soundSetDopplerFactor(LvnSound* sound, float dopplerFactor);
+    LVN_API void                        soundSetAudibleRadius(LvnSound* sound, float radius);
+    LVN_API void                        soundSetPriority(LvnSound* sound, uint32_t priority);
     LVN_API void                        soundSetLooping(LvnSound* sound, bool looping);
     LVN_API void                        soundPlayStart(LvnSound* sound);
     LVN_API void                        soundPlayStop(LvnSound* sound);
@@ -1648,6 +2434,35 @@ namespace lvn
     LVN_API uint64_t                    soundGetTimeMilliseconds(const LvnSound* sound);
     LVN_API uint64_t                    soundGetTimePcmFrames(const LvnSound* sound);
     LVN_API float                       soundGetLengthSeconds(LvnSound* sound);
+    LVN_API float                       soundGetAudibleRadius(const LvnSound* sound);
+    LVN_API uint32_t                    soundGetPriority(const LvnSound* sound);
+    LVN_API bool                        soundIsReady(const LvnSound* sound);    // the data of a sound from createSoundAsync has loaded, always true for other sounds
+    LVN_API LvnResult                   soundWaitReady(LvnSound* sound);        // blocks until a sound from createSoundAsync has finished loading, fails if the file could not be loaded
+    LVN_API bool                        soundIsVirtual(const LvnSound* sound);  // the sound is playing but was stopped by soundsUpdateSpatial for being out of range, it resumes where it would be when it comes back in range
+    LVN_API void                        soundsUpdateSpatial(LvnSound** pSounds, const LvnVec3* pPositions, const LvnVec3* pVelocities, uint32_t count); // sets the positions and velocities (pVelocities may be nullptr) of many sounds at once, sounds are virtualized and resumed by their audible radius
+
+    // sound banks decode each file once and play one shots on pooled voices that share the decoded data
+    LVN_API LvnResult                   createSoundBank(LvnSoundBank** bank, const LvnSoundBankCreateInfo* createInfo);
+    LVN_API void                        destroySoundBank(LvnSoundBank* bank);                                      // stops and frees the voices and releases the decoded data of every sound in the bank
+    LVN_API LvnSoundBankCreateInfo      configSoundBankInit();
+    LVN_API LvnResult                   soundBankLoad(LvnSoundBank* bank, const char* filepath, uint32_t* pId);    // decodes the file into the bank and writes its id to pId, loading a path that is already in the bank returns the same id
+    LVN_API LvnSoundPlayParams          configSoundPlayParams();
+    LVN_API LvnResult                   soundPlayOneShot(LvnSoundBank* bank, uint32_t id, const LvnSoundPlayParams& params); // plays the sound on a free voice, voices are created up to maxVoicesPerSound and then the one closest to its end is restarted
+    LVN_API void                        soundBankStopAll(LvnSoundBank* bank);
+
+    LVN_API LvnResult                   createSoundGroup(LvnSoundGroup** group, const LvnSoundGroupCreateInfo* createInfo);
+    LVN_API void                        destroySoundGroup(LvnSoundGroup* group);                                   // sounds, banks and child groups mixed into the group must be destroyed first
+    LVN_API LvnSoundGroupCreateInfo     configSoundGroupInit();
+    LVN_API void                        soundGroupSetVolume(LvnSoundGroup* group, float volume);
+    LVN_API void                        soundGroupSetFadeMilliseconds(LvnSoundGroup* group, float volBegin, float volEnd, uint64_t ms); // fades every sound of the group at once, use for ducking
+    LVN_API void                        soundGroupSetLowPass(LvnSoundGroup* group, float cutoff);                  // cutoff frequency in hz, 0.0 bypasses the filter
+    LVN_API void                        soundGroupSetReverbSend(LvnSoundGroup* group, float send);                 // 0.0 bypasses the reverb
+    LVN_API void                        soundGroupSetReverbDecay(LvnSoundGroup* group, float decay);
+    LVN_API void                        soundGroupStart(LvnSoundGroup* group);
+    LVN_API void                        soundGroupStop(LvnSoundGroup* group);                                      // pauses every sound of the group
+    LVN_API float                       soundGroupGetVolume(const LvnSoundGroup* group);
+    LVN_API float                       soundGroupGetLowPass(const LvnSoundGroup* group);
+    LVN_API float                       soundGroupGetReverbSend(const LvnSoundGroup* group);
 
 
     // -- [SUBSECT]: Networking Functions
@@ -1659,10 +2474,20 @@ namespace lvn
     LVN_API LvnSocketCreateInfo         configSocketServerInit(LvnAddress address, uint32_t connectionCount, uint32_t channelCount, uint32_t inBandwidth, uint32_t outBandWidth);
 
     LVN_API uint32_t                    socketGetHostFromStr(const char* host);
-    LVN_API LvnResult                   socketConnect(LvnSocket* socket, LvnAddress* address, uint32_t channelCount, uint32_t milliseconds);
+    LVN_API LvnResult                   socketConnect(LvnSocket* socket, LvnAddress* address, uint32_t channelCount, uint32_t milliseconds); // with a network thread the connect does not wait, the result arrives as a socketService event
     LVN_API LvnResult                   socketDisconnect(LvnSocket* socket, uint32_t milliseconds);
-    LVN_API void                        socketSend(LvnSocket* socket, uint8_t channel, LvnPacket* packet);
-    LVN_API LvnResult                   socketReceive(LvnSocket* socket, LvnPacket* packet, uint32_t milliseconds);
+    LVN_API void                        socketSend(LvnSocket* socket, uint8_t channel, LvnPacket* packet);                             // sends reliably
+    LVN_API void                        socketSend(LvnSocket* socket, uint8_t channel, LvnPacket* packet, LvnPacketFlagBits flags);
+    LVN_API void                        socketFlush(LvnSocket* socket);                                                              // sends the packets queued by a socket created with batchSends, queued packets share datagrams where they fit
+    LVN_API LvnResult                   socketReceive(LvnSocket* socket, LvnPacket* packet, uint32_t milliseconds);               // the received packet owns its data until it is released with socketPacketRelease
+    LVN_API LvnResult                   socketPacketCreate(LvnPacket* packet, size_t size);                                         // allocates an owned packet buffer to write into, socketSend hands it to the socket without copying
+    LVN_API void                        socketPacketRelease(LvnPacket* packet);                                                     // frees an owned packet that was received or created and not sent
+    LVN_API void                        socketSendTo(LvnSocket* socket, uint32_t peerId, uint8_t channel, LvnPacket* packet, LvnPacketFlagBits flags); // sends to the peer with the id given by a socket event, used by servers to reply
+    LVN_API void                        socketBroadcast(LvnSocket* socket, uint8_t channel, LvnPacket* packet, LvnPacketFlagBits flags); // sends one shared packet to every connected peer
+    LVN_API void                        socketDisconnectPeer(LvnSocket* socket, uint32_t peerId);
+    LVN_API uint32_t                    socketGetPeerCount(LvnSocket* socket);                                                       // number of peer slots on the socket, peer ids are less than this count
+    LVN_API LvnResult                   socketGetPeerInfo(LvnSocket* socket, uint32_t peerId, LvnSocketPeerInfo* info);           // values are a snapshot that may be one tick old when the socket has a network thread
+    LVN_API uint32_t                    socketService(LvnSocket* socket, LvnSocketEventFunc func, void* userData, uint32_t milliseconds); // waits up to milliseconds for the first event then handles every pending event without blocking, returns the number of events handled, sockets with a network thread never wait
 
 
     // -- [SUBSECT]: Math Functions
@@ -1694,8 +2519,248 @@ namespace lvn
     LVN_API float clampAngle(float rad);       // clamps the given angle in radians to the translated angle between 0 and 2 PI
     LVN_API float clampAngleDeg(float deg);    // clamps the given angle in degrees to the translated angle between 0 and 2 PI
     LVN_API float invSqrt(float num);
+
+    // fast approximations for hot loops that can tolerate a small error, the bounds are the max errors measured against double precision libm
+    LVN_API float fastSin(float x);            // abs error 2e-7 for |x| <= 2 PI, grows with |x| to 3e-5 at |x| = 1000
+    LVN_API float fastCos(float x);            // abs error 2e-7 for |x| <= 2 PI, grows with |x| to 3e-5 at |x| = 1000
+    LVN_API float fastAtan2(float y, float x); // abs error 2e-6 radians, returns 0 for (0, 0)
+    LVN_API float fastExp(float x);            // rel error 3e-7 for |x| <= 1 and 4e-6 over the input range, x is clamped to [-87.3, 88.3]
+    LVN_API float fastRsqrt(float x);          // rel error 3e-7 for positive normal x
     LVN_API double derivative(double (*func)(double), double x, double delta = 0.001); // finds the instantaneous slope of the function given with a delta offset
 
+    // batched transform kernels, every array holds count elements and the outputs can be the same arrays as the inputs
+    // multiplyMatrices and the soa transformPoints use avx2 when the running cpu supports it
+    LVN_API void multiplyMatrices(const LvnMat4* a, const LvnMat4* b, LvnMat4* out, uint32_t count);                 // out[i] = a[i] * b[i]
+    LVN_API void transformPoints(const LvnMat4& matrix, const LvnVec3* points, LvnVec3* out, uint32_t count);          // out[i] = matrix * vec4(points[i], 1), the w row is not applied and nothing is divided
+    LVN_API void transformPoints(const LvnMat4& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, uint32_t count); // transformPoints with the points split into one array per component
+    LVN_API void composeTRS(const LvnVec3* translations, const LvnQuat* rotations, const LvnVec3* scales, LvnMat4* out, uint32_t count); // out[i] = translate * rotate * scale, rotations must be normalized
+    LVN_API void slerpBatch(const LvnQuat* q1, const LvnQuat* q2, const float* t, LvnQuat* out, uint32_t count);     // shortest path spherical interpolation of each pair by t[i], the results are normalized
+
+    // frustum culling, the tests are conservative and only reject bounds that are completely outside one of the planes
+    LVN_API LvnFrustum frustumFromMatrix(const LvnMat4& viewProj);                                                     // normalized planes of a projection * view matrix for the clip region of the render api, the planes are in world space
+    LVN_API bool frustumTestSphere(const LvnFrustum& frustum, const LvnVec3& center, float radius);                    // true if the sphere intersects or is inside the frustum
+    LVN_API bool frustumTestAabb(const LvnFrustum& frustum, const LvnVec3& boundsMin, const LvnVec3& boundsMax);       // true if the axis aligned box intersects or is inside the frustum
+    LVN_API uint32_t frustumCullSpheres(const LvnFrustum& frustum, const LvnVec4* spheres, uint8_t* pVisible, uint32_t count); // tests spheres stored as (center, radius) four at a time, pVisible[i] is set to 1 if sphere i is visible and 0 otherwise, returns the number of visible spheres
+
+#if defined(LVN_SIMD_MATH)
+    // simd kernels of the float vector, matrix and quaternion math, vectors and quaternions are 4 packed floats and matrices 4 packed columns
+    // loads and stores are unaligned so the math types keep their scalar size and alignment inside vertices and uniform buffers
+#if defined(LVN_SIMD_MATH_SSE2)
+    typedef __m128 LvnSimdFloat4;
+
+    inline LvnSimdFloat4 simdLoad(const float* p) { return _mm_loadu_ps(p); }
+    inline void simdStore(float* p, LvnSimdFloat4 a) { _mm_storeu_ps(p, a); }
+    inline LvnSimdFloat4 simdSplat(float s) { return _mm_set1_ps(s); }
+    inline LvnSimdFloat4 simdSet(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+    inline LvnSimdFloat4 simdAdd(LvnSimdFloat4 a, LvnSimdFloat4 b) { return _mm_add_ps(a, b); }
+    inline LvnSimdFloat4 simdSub(LvnSimdFloat4 a, LvnSimdFloat4 b) { return _mm_sub_ps(a, b); }
+    inline LvnSimdFloat4 simdMul(LvnSimdFloat4 a, LvnSimdFloat4 b) { return _mm_mul_ps(a, b); }
+    inline LvnSimdFloat4 simdDiv(LvnSimdFloat4 a, LvnSimdFloat4 b) { return _mm_div_ps(a, b); }
+    inline LvnSimdFloat4 simdMulAdd(LvnSimdFloat4 a, LvnSimdFloat4 b, LvnSimdFloat4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    inline LvnSimdFloat4 simdMin(LvnSimdFloat4 a, LvnSimdFloat4 b) { return _mm_min_ps(a, b); }
+    inline int simdLessMask(LvnSimdFloat4 a, LvnSimdFloat4 b) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); } // bit i is set if lane i of a is less than lane i of b
+
+    // takes lanes i0 and i1 of a and lanes i2 and i3 of b
+    template <int i0, int i1, int i2, int i3>
+    inline LvnSimdFloat4 simdShuffle(LvnSimdFloat4 a, LvnSimdFloat4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(i3, i2, i1, i0)); }
+
+    inline float simdDot(LvnSimdFloat4 a, LvnSimdFloat4 b)
+    {
+        __m128 d = _mm_mul_ps(a, b);
+        d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+        d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtss_f32(d);
+    }
+#elif defined(LVN_SIMD_MATH_NEON)
+    typedef float32x4_t LvnSimdFloat4;
+
+    inline LvnSimdFloat4 simdLoad(const float* p) { return vld1q_f32(p); }
+    inline void simdStore(float* p, LvnSimdFloat4 a) { vst1q_f32(p, a); }
+    inline LvnSimdFloat4 simdSplat(float s) { return vdupq_n_f32(s); }
+    inline LvnSimdFloat4 simdSet(float x, float y, float z, float w) { const float v[4] = { x, y, z, w }; return vld1q_f32(v); }
+    inline LvnSimdFloat4 simdAdd(LvnSimdFloat4 a, LvnSimdFloat4 b) { return vaddq_f32(a, b); }
+    inline LvnSimdFloat4 simdSub(LvnSimdFloat4 a, LvnSimdFloat4 b) { return vsubq_f32(a, b); }
+    inline LvnSimdFloat4 simdMul(LvnSimdFloat4 a, LvnSimdFloat4 b) { return vmulq_f32(a, b); }
+    inline LvnSimdFloat4 simdMulAdd(LvnSimdFloat4 a, LvnSimdFloat4 b, LvnSimdFloat4 c) { return vmlaq_f32(c, a, b); }
+    inline LvnSimdFloat4 simdMin(LvnSimdFloat4 a, LvnSimdFloat4 b) { return vminq_f32(a, b); }
+
+    // bit i is set if lane i of a is less than lane i of b
+    inline int simdLessMask(LvnSimdFloat4 a, LvnSimdFloat4 b)
+    {
+        const uint32_t bits[4] = { 1, 2, 4, 8 };
+        uint32x4_t m = vandq_u32(vcltq_f32(a, b), vld1q_u32(bits));
+        uint32x2_t s = vadd_u32(vget_low_u32(m), vget_high_u32(m));
+        return static_cast<int>(vget_lane_u32(vpadd_u32(s, s), 0));
+    }
+#if defined(__aarch64__) || defined(_M_ARM64)
+    inline LvnSimdFloat4 simdDiv(LvnSimdFloat4 a, LvnSimdFloat4 b) { return vdivq_f32(a, b); }
+#else
+    // armv7 neon has no vector divide, dividing per lane keeps the results exact
+    inline LvnSimdFloat4 simdDiv(LvnSimdFloat4 a, LvnSimdFloat4 b)
+    {
+        float x[4], y[4];
+        vst1q_f32(x, a);
+        vst1q_f32(y, b);
+        return lvn::simdSet(x[0] / y[0], x[1] / y[1], x[2] / y[2], x[3] / y[3]);
+    }
+#endif
+
+    // takes lanes i0 and i1 of a and lanes i2 and i3 of b, constant lane moves are folded into permutes by the compiler
+    template <int i0, int i1, int i2, int i3>
+    inline LvnSimdFloat4 simdShuffle(LvnSimdFloat4 a, LvnSimdFloat4 b)
+    {
+        LvnSimdFloat4 r = vdupq_n_f32(vgetq_lane_f32(a, i0));
+        r = vsetq_lane_f32(vgetq_lane_f32(a, i1), r, 1);
+        r = vsetq_lane_f32(vgetq_lane_f32(b, i2), r, 2);
+        return vsetq_lane_f32(vgetq_lane_f32(b, i3), r, 3);
+    }
+
+    inline float simdDot(LvnSimdFloat4 a, LvnSimdFloat4 b)
+    {
+        float32x4_t d = vmulq_f32(a, b);
+        float32x2_t s = vadd_f32(vget_low_f32(d), vget_high_f32(d));
+        return vget_lane_f32(vpadd_f32(s, s), 0);
+    }
+#endif
+
+    // column major matrix multiply, each column of the result is a sum of the columns of m1 scaled by one column of m2, dst can alias m1 or m2
+    inline void simdMat4Mul(float* dst, const float* m1, const float* m2)
+    {
+        LvnSimdFloat4 c0 = lvn::simdLoad(m1);
+        LvnSimdFloat4 c1 = lvn::simdLoad(m1 + 4);
+        LvnSimdFloat4 c2 = lvn::simdLoad(m1 + 8);
+        LvnSimdFloat4 c3 = lvn::simdLoad(m1 + 12);
+
+        LvnSimdFloat4 columns[4];
+        for (int i = 0; i < 4; i++)
+            columns[i] = lvn::simdLoad(m2 + i * 4);
+
+        for (int i = 0; i < 4; i++)
+        {
+            LvnSimdFloat4 b = columns[i];
+            LvnSimdFloat4 r = lvn::simdMul(c0, lvn::simdShuffle<0, 0, 0, 0>(b, b));
+            r = lvn::simdMulAdd(c1, lvn::simdShuffle<1, 1, 1, 1>(b, b), r);
+            r = lvn::simdMulAdd(c2, lvn::simdShuffle<2, 2, 2, 2>(b, b), r);
+            r = lvn::simdMulAdd(c3, lvn::simdShuffle<3, 3, 3, 3>(b, b), r);
+            lvn::simdStore(dst + i * 4, r);
+        }
+    }
+
+    inline void simdMat4MulVec4(float* dst, const float* m, const float* v)
+    {
+        LvnSimdFloat4 r = lvn::simdMul(lvn::simdLoad(m), lvn::simdSplat(v[0]));
+        r = lvn::simdMulAdd(lvn::simdLoad(m + 4), lvn::simdSplat(v[1]), r);
+        r = lvn::simdMulAdd(lvn::simdLoad(m + 8), lvn::simdSplat(v[2]), r);
+        r = lvn::simdMulAdd(lvn::simdLoad(m + 12), lvn::simdSplat(v[3]), r);
+        lvn::simdStore(dst, r);
+    }
+
+    inline void simdMat4Transpose(LvnSimdFloat4* rows, const float* m)
+    {
+        LvnSimdFloat4 c0 = lvn::simdLoad(m);
+        LvnSimdFloat4 c1 = lvn::simdLoad(m + 4);
+        LvnSimdFloat4 c2 = lvn::simdLoad(m + 8);
+        LvnSimdFloat4 c3 = lvn::simdLoad(m + 12);
+
+        LvnSimdFloat4 t0 = lvn::simdShuffle<0, 1, 0, 1>(c0, c1);
+        LvnSimdFloat4 t1 = lvn::simdShuffle<2, 3, 2, 3>(c0, c1);
+        LvnSimdFloat4 t2 = lvn::simdShuffle<0, 1, 0, 1>(c2, c3);
+        LvnSimdFloat4 t3 = lvn::simdShuffle<2, 3, 2, 3>(c2, c3);
+
+        rows[0] = lvn::simdShuffle<0, 2, 0, 2>(t0, t2);
+        rows[1] = lvn::simdShuffle<1, 3, 1, 3>(t0, t2);
+        rows[2] = lvn::simdShuffle<0, 2, 0, 2>(t1, t3);
+        rows[3] = lvn::simdShuffle<1, 3, 1, 3>(t1, t3);
+    }
+
+    inline void simdMat4Transpose(float* dst, const float* m)
+    {
+        LvnSimdFloat4 rows[4];
+        lvn::simdMat4Transpose(rows, m);
+        for (int i = 0; i < 4; i++)
+            lvn::simdStore(dst + i * 4, rows[i]);
+    }
+
+    // row vector times matrix, each lane is the dot product of v with one column of m
+    inline void simdVec4MulMat4(float* dst, const float* v, const float* m)
+    {
+        LvnSimdFloat4 rows[4];
+        lvn::simdMat4Transpose(rows, m);
+
+        LvnSimdFloat4 r = lvn::simdMul(rows[0], lvn::simdSplat(v[0]));
+        r = lvn::simdMulAdd(rows[1], lvn::simdSplat(v[1]), r);
+        r = lvn::simdMulAdd(rows[2], lvn::simdSplat(v[2]), r);
+        r = lvn::simdMulAdd(rows[3], lvn::simdSplat(v[3]), r);
+        lvn::simdStore(dst, r);
+    }
+
+    // 2x2 sub determinants of rows p and q, lanes follow the coefficients of the scalar inverse
+    template <int p, int q>
+    inline LvnSimdFloat4 simdMat4InverseFactor(LvnSimdFloat4 c1, LvnSimdFloat4 c2, LvnSimdFloat4 c3)
+    {
+        LvnSimdFloat4 a = lvn::simdShuffle<p, p, p, p>(c2, c1);
+        LvnSimdFloat4 b = lvn::simdShuffle<q, q, q, q>(c3, c2);
+        LvnSimdFloat4 c = lvn::simdShuffle<p, p, p, p>(c3, c2);
+        LvnSimdFloat4 d = lvn::simdShuffle<q, q, q, q>(c2, c1);
+        b = lvn::simdShuffle<0, 0, 0, 2>(b, b);
+        c = lvn::simdShuffle<0, 0, 0, 2>(c, c);
+        return lvn::simdSub(lvn::simdMul(a, b), lvn::simdMul(c, d));
+    }
+
+    // same cofactor expansion as the scalar inverse with the coefficients computed four at a time
+    inline void simdMat4Inverse(float* dst, const float* m)
+    {
+        LvnSimdFloat4 c0 = lvn::simdLoad(m);
+        LvnSimdFloat4 c1 = lvn::simdLoad(m + 4);
+        LvnSimdFloat4 c2 = lvn::simdLoad(m + 8);
+        LvnSimdFloat4 c3 = lvn::simdLoad(m + 12);
+
+        LvnSimdFloat4 fac0 = lvn::simdMat4InverseFactor<2, 3>(c1, c2, c3);
+        LvnSimdFloat4 fac1 = lvn::simdMat4InverseFactor<1, 3>(c1, c2, c3);
+        LvnSimdFloat4 fac2 = lvn::simdMat4InverseFactor<1, 2>(c1, c2, c3);
+        LvnSimdFloat4 fac3 = lvn::simdMat4InverseFactor<0, 3>(c1, c2, c3);
+        LvnSimdFloat4 fac4 = lvn::simdMat4InverseFactor<0, 2>(c1, c2, c3);
+        LvnSimdFloat4 fac5 = lvn::simdMat4InverseFactor<0, 1>(c1, c2, c3);
+
+        LvnSimdFloat4 vec0 = lvn::simdShuffle<0, 0, 0, 0>(c1, c0);
+        LvnSimdFloat4 vec1 = lvn::simdShuffle<1, 1, 1, 1>(c1, c0);
+        LvnSimdFloat4 vec2 = lvn::simdShuffle<2, 2, 2, 2>(c1, c0);
+        LvnSimdFloat4 vec3 = lvn::simdShuffle<3, 3, 3, 3>(c1, c0);
+        vec0 = lvn::simdShuffle<0, 2, 2, 2>(vec0, vec0);
+        vec1 = lvn::simdShuffle<0, 2, 2, 2>(vec1, vec1);
+        vec2 = lvn::simdShuffle<0, 2, 2, 2>(vec2, vec2);
+        vec3 = lvn::simdShuffle<0, 2, 2, 2>(vec3, vec3);
+
+        LvnSimdFloat4 signA = lvn::simdSet(1.0f, -1.0f, 1.0f, -1.0f);
+        LvnSimdFloat4 signB = lvn::simdSet(-1.0f, 1.0f, -1.0f, 1.0f);
+
+        LvnSimdFloat4 inv0 = lvn::simdMul(lvn::simdAdd(lvn::simdSub(lvn::simdMul(vec1, fac0), lvn::simdMul(vec2, fac1)), lvn::simdMul(vec3, fac2)), signA);
+        LvnSimdFloat4 inv1 = lvn::simdMul(lvn::simdAdd(lvn::simdSub(lvn::simdMul(vec0, fac0), lvn::simdMul(vec2, fac3)), lvn::simdMul(vec3, fac4)), signB);
+        LvnSimdFloat4 inv2 = lvn::simdMul(lvn::simdAdd(lvn::simdSub(lvn::simdMul(vec0, fac1), lvn::simdMul(vec1, fac3)), lvn::simdMul(vec3, fac5)), signA);
+        LvnSimdFloat4 inv3 = lvn::simdMul(lvn::simdAdd(lvn::simdSub(lvn::simdMul(vec0, fac2), lvn::simdMul(vec1, fac4)), lvn::simdMul(vec2, fac5)), signB);
+
+        LvnSimdFloat4 row0 = lvn::simdShuffle<0, 2, 0, 2>(lvn::simdShuffle<0, 0, 0, 0>(inv0, inv1), lvn::simdShuffle<0, 0, 0, 0>(inv2, inv3));
+        LvnSimdFloat4 oneOverDeterminant = lvn::simdSplat(1.0f / lvn::simdDot(c0, row0));
+
+        lvn::simdStore(dst, lvn::simdMul(inv0, oneOverDeterminant));
+        lvn::simdStore(dst + 4, lvn::simdMul(inv1, oneOverDeterminant));
+        lvn::simdStore(dst + 8, lvn::simdMul(inv2, oneOverDeterminant));
+        lvn::simdStore(dst + 12, lvn::simdMul(inv3, oneOverDeterminant));
+    }
+
+    // hamilton product of quaternions stored as w, x, y, z
+    inline void simdQuatMul(float* dst, const float* q1, const float* q2)
+    {
+        LvnSimdFloat4 b = lvn::simdLoad(q2);
+
+        LvnSimdFloat4 r = lvn::simdMul(lvn::simdSplat(q1[0]), b);
+        r = lvn::simdMulAdd(lvn::simdMul(lvn::simdSplat(q1[1]), lvn::simdSet(-1.0f, 1.0f, -1.0f, 1.0f)), lvn::simdShuffle<1, 0, 3, 2>(b, b), r);
+        r = lvn::simdMulAdd(lvn::simdMul(lvn::simdSplat(q1[2]), lvn::simdSet(-1.0f, 1.0f, 1.0f, -1.0f)), lvn::simdShuffle<2, 3, 0, 1>(b, b), r);
+        r = lvn::simdMulAdd(lvn::simdMul(lvn::simdSplat(q1[3]), lvn::simdSet(-1.0f, -1.0f, 1.0f, 1.0f)), lvn::simdShuffle<3, 2, 1, 0>(b, b), r);
+        lvn::simdStore(dst, r);
+    }
+#endif
+
     template <typename T>
     LVN_API LvnVec<2, T> normalize(const LvnVec<2, T>& v)
     {
@@ -1713,6 +2778,15 @@ namespace lvn
     template <typename T>
     LVN_API LvnVec<4, T> normalize(const LvnVec<4, T>& v)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            LvnSimdFloat4 a = lvn::simdLoad(&v.x);
+            LvnVec<4, T> result;
+            lvn::simdStore(&result.x, lvn::simdMul(a, lvn::simdSplat(1.0f / sqrt(lvn::simdDot(a, a)))));
+            return result;
+        }
+#endif
         T u = static_cast<T>(1) / sqrt(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
         return LvnVec<4, T>(v.x * u, v.y * u, v.z * u, v.w * u);
     }
@@ -1796,12 +2870,20 @@ namespace lvn
     template <typename T>
     LVN_API T dot(const LvnVec<4, T>& v1, const LvnVec<4, T>& v2)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+            return lvn::simdDot(lvn::simdLoad(&v1.x), lvn::simdLoad(&v2.x));
+#endif
         return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z + v1.w * v2.w;
     }
 
     template <typename T>
     LVN_API T dot(const LvnQuat_t<T>& q1, const LvnQuat_t<T>& q2)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+            return lvn::simdDot(lvn::simdLoad(&q1.w), lvn::simdLoad(&q2.w));
+#endif
         return q1.w * q2.w + q1.x * q2.x + q1.y * q2.y + q1.z * q2.z;
     }
 
@@ -1848,6 +2930,13 @@ namespace lvn
     LVN_API LvnMat<4, 4, T> transpose(const LvnMat<4, 4, T>& m)
     {
         LvnMat<4, 4, T> result;
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            lvn::simdMat4Transpose(&result[0].x, &m[0].x);
+            return result;
+        }
+#endif
         result[0][0] = m[0][0];
         result[0][1] = m[1][0];
         result[0][2] = m[2][0];
@@ -2036,6 +3125,14 @@ namespace lvn
     template <typename T>
     LVN_API LvnMat<4, 4, T> inverse(const LvnMat<4, 4, T>& m)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            LvnMat<4, 4, T> result;
+            lvn::simdMat4Inverse(&result[0].x, &m[0].x);
+            return result;
+        }
+#endif
         T coef00 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
         T coef02 = m[1][2] * m[3][3] - m[3][2] * m[1][3];
         T coef03 = m[1][2] * m[2][3] - m[2][2] * m[1][3];
@@ -2466,10 +3563,93 @@ struct LvnDoublePair
     union { T2 p2, y, height, second; };
 };
 
+// -- LvnArenaMarker, LvnArena
+// ------------------------------------------------------------
+// - linear allocator, allocations bump an offset through blocks of memory that stay allocated until the arena is destroyed or clear_free() is called
+// - individual allocations are never freed, memory is given back all at once with reset() or back to a marker with rewind()
+// - reset() and rewind() do not run destructors, objects allocated from the arena must be destroyed before the memory is reused
+// - not thread safe, use one arena per thread
+// - containers allocate from an arena through allocator(), arenas cannot be moved since containers keep a pointer to it
+
+struct LvnArenaMarker
+{
+    void* block;   /* block that was current when the marker was taken, nullptr if the arena had no blocks */
+    size_t used;   /* bytes taken in that block */
+};
+
+class LvnArena
+{
+private:
+    struct Block
+    {
+        Block* next;
+        size_t size;  /* bytes of data following the block header */
+        size_t used;  /* bytes of data taken, blocks after the current block always have used == 0 */
+    };
+
+    Block* m_First;
+    Block* m_Current;
+    void* m_Last;       /* most recent allocation, realloc grows it in place when it is still at the end of the current block */
+    size_t m_BlockSize;
+    LvnAllocator m_Allocator;
+
+    static size_t align_offset(const Block* block, size_t align)
+    {
+        uintptr_t base = reinterpret_cast<uintptr_t>(block + 1);
+        return ((base + block->used + align - 1) & ~static_cast<uintptr_t>(align - 1)) - base;
+    }
+
+    void* alloc_slow(size_t size, size_t align);
+    static void* allocator_alloc(size_t size, size_t align, void* userData);
+    static void* allocator_realloc(void* ptr, size_t oldSize, size_t newSize, size_t align, void* userData);
+
+public:
+    static const size_t DefaultBlockSize = 64 * 1024;
+
+    LvnArena();
+    explicit LvnArena(size_t blockSize);
+    ~LvnArena();
+    LvnArena(const LvnArena&) = delete;
+    LvnArena& operator=(const LvnArena&) = delete;
+
+    /* align must be a power of two, returns nullptr when size is 0 */
+    void* alloc(size_t size, size_t align = alignof(max_align_t))
+    {
+        if (size == 0) return nullptr;
+        if (m_Current)
+        {
+            size_t offset = align_offset(m_Current, align);
+            if (offset + size <= m_Current->size)
+            {
+                m_Current->used = offset + size;
+                m_Last = reinterpret_cast<uint8_t*>(m_Current + 1) + offset;
+                return m_Last;
+            }
+        }
+        return alloc_slow(size, align);
+    }
+
+    template <typename T>
+    T* alloc_array(size_t count) { return static_cast<T*>(alloc(count * sizeof(T), alignof(T))); }
+
+    void*           realloc(void* ptr, size_t oldSize, size_t newSize, size_t align = alignof(max_align_t));
+    LvnArenaMarker  marker() const;
+    void            rewind(const LvnArenaMarker& marker);
+    void            reset();
+    void            clear_free();
+    size_t          used() const;
+    size_t          capacity() const;
+    size_t          block_size() const { return m_BlockSize; }
+    const LvnAllocator* allocator() const { return &m_Allocator; }
+};
+
+
 // -- LvnVector
 // ------------------------------------------------------------
 // - simple and light weight replacement to std::vector
 // - this vector implmentation is not intended to be used outside of the library, use std::vector instead
+// - capacity grows by LVN_VECTOR_GROWTH_FACTOR when inserting, trivially copyable elements are relocated with realloc and memcpy instead of per element copies
+// - set_allocator() makes the vector allocate from an LvnAllocator instead of the global memory functions, copies allocate from the global memory functions again
 
 template <typename T>
 class LvnVector
@@ -2478,45 +3658,97 @@ private:
     T* m_Data;            /* pointer array to data */
     size_t m_Size;      /* number of elements that are in this vector; size of vector */
     size_t m_Capacity;  /* max number of elements allocated/reserved for this vector; note that m_Size can be less than or equal to the capacity */
+    const LvnAllocator* m_Allocator; /* allocator the data is allocated from, the global memory functions are used when nullptr */
+
+    static constexpr bool s_Trivial = std::is_trivially_copyable_v<T>;
+    static_assert(LVN_VECTOR_GROWTH_FACTOR > 1.0, "LVN_VECTOR_GROWTH_FACTOR must be greater than 1");
 
     void destruct() { if constexpr (!std::is_trivially_destructible_v<T>) { for (size_t i = 0; i < m_Size; i++) m_Data[i].~T(); } }
     void destruct_at(T* value) { if constexpr (!std::is_trivially_destructible_v<T>) value->~T(); }
 
+    static void copy_construct(T* dst, const T* src, size_t size)
+    {
+        if constexpr (s_Trivial)
+        {
+            if (size != 0) memcpy(dst, src, size * sizeof(T));
+        }
+        else
+        {
+            for (size_t i = 0; i < size; i++)
+                new (dst + i) T(src[i]);
+        }
+    }
+
+    T* allocate(size_t size) { return lvn::allocatorNew<T>(m_Allocator, size); }
+    void deallocate(T* data) { lvn::allocatorDelete<T>(m_Allocator, data); }
+
+    /* moves the alive elements into an allocation of capacity elements, capacity must be at least m_Size */
+    void reallocate(size_t capacity)
+    {
+        if constexpr (s_Trivial)
+        {
+            m_Data = lvn::allocatorRealloc<T>(m_Allocator, m_Data, m_Size, capacity);
+        }
+        else
+        {
+            T* temp = allocate(capacity);
+            for (size_t i = 0; i < m_Size; i++)
+                new (temp + i) T(static_cast<std::remove_reference_t<T>&&>(m_Data[i])); /* NOTE: cast to rvalue for move constructor */
+            destruct();
+            deallocate(m_Data);
+            m_Data = temp;
+        }
+        m_Capacity = capacity;
+    }
+
+    /* reserves geometrically so repeated inserts are amortized constant, reserve() still allocates the exact size asked for */
+    void grow(size_t size)
+    {
+        if (size <= m_Capacity) return;
+        size_t grown = static_cast<size_t>(static_cast<double>(m_Capacity) * LVN_VECTOR_GROWTH_FACTOR);
+        reallocate(grown > size ? grown : size);
+    }
+
+    bool aliases(const T* data) const { return data >= m_Data && data < m_Data + m_Size; }
+
 public:
     LvnVector()
-        : m_Data(nullptr), m_Size(0), m_Capacity(0) {}
+        : m_Data(nullptr), m_Size(0), m_Capacity(0), m_Allocator(nullptr) {}
     ~LvnVector()
     {
-        lvn::memDelete<T>(m_Data, m_Size);
+        destruct();
+        deallocate(m_Data);
         m_Size = 0;
         m_Capacity = 0;
         m_Data = nullptr;
     }
 
     LvnVector(size_t size)
+        : m_Allocator(nullptr)
     {
         m_Size = size;
         m_Capacity = size;
         m_Data = lvn::memNew<T>(size);
     }
     LvnVector(const T* data, size_t size)
+        : m_Allocator(nullptr)
     {
         m_Size = size;
         m_Capacity = size;
         m_Data = lvn::memNew<T>(size, false);
-        for (size_t i = 0; i < size; i++)
-            new (&m_Data[i]) T(data[i]);
+        copy_construct(m_Data, data, size);
     }
     LvnVector(const T* begin, const T* end)
+        : m_Allocator(nullptr)
     {
         LVN_CORE_ASSERT(end > begin, "end element pointer must be after before element pointer");
         m_Size = end - begin;
         m_Capacity = m_Size;
         m_Data = lvn::memNew<T>(m_Size, false);
-        for (size_t i = 0; i < m_Size; i++)
-            new (&m_Data[i]) T(begin[i]);
+        copy_construct(m_Data, begin, m_Size);
     }
     LvnVector(size_t size, const T& value)
+        : m_Allocator(nullptr)
     {
         m_Size = size;
         m_Capacity = size;
@@ -2525,18 +3757,19 @@ public:
             new (&m_Data[i]) T(value);
     }
     LvnVector(const LvnVector& other)
+        : m_Allocator(nullptr)
     {
         m_Size = other.m_Size;
         m_Capacity = other.m_Size; /* NOTE: we are only allocating up to the size of the other vector, not the capacity */
         m_Data = lvn::memNew<T>(other.m_Size, false);
-        for (size_t i = 0; i < other.m_Size; i++)
-            new (&m_Data[i]) T(other.m_Data[i]);
+        copy_construct(m_Data, other.m_Data, other.m_Size);
     }
     LvnVector(LvnVector&& other)
     {
         m_Size = other.m_Size;
         m_Capacity = other.m_Capacity;
         m_Data = other.m_Data;
+        m_Allocator = other.m_Allocator;
         other.m_Size = 0;
         other.m_Capacity = 0;
         other.m_Data = nullptr;
@@ -2544,17 +3777,21 @@ public:
     LvnVector& operator=(const LvnVector& other)
     {
         if (this == &other) return *this;
-        resize(other.m_Size);
-        for (size_t i = 0; i < m_Size; i++)
-            new (&m_Data[i]) T(other.m_Data[i]);
+        clear();
+        reserve(other.m_Size);
+        copy_construct(m_Data, other.m_Data, other.m_Size);
+        m_Size = other.m_Size;
         return *this;
     }
     LvnVector& operator=(LvnVector&& other)
     {
-        lvn::memDelete<T>(m_Data, m_Size);
+        if (this == &other) return *this;
+        destruct();
+        deallocate(m_Data);
         m_Size = other.m_Size;
         m_Capacity = other.m_Capacity;
         m_Data = other.m_Data;
+        m_Allocator = other.m_Allocator;
         other.m_Size = 0;
         other.m_Capacity = 0;
         other.m_Data = nullptr;
@@ -2609,20 +3846,56 @@ public:
     {
         if (size == 0) return;
         LVN_CORE_ASSERT(index <= m_Size, "insert index not within vector bounds");
-        reserve(m_Size + size);
 
-        /* shift elements to the right */
-        for (int64_t i = m_Size - 1; i >= (int64_t)index; --i)
+        /* the source range would be moved or freed while shifting, copy it out first */
+        if (aliases(data))
         {
-            new (m_Data + i + size) T(static_cast<std::remove_reference_t<T>&&>(m_Data[i])); /* NOTE: cast to rvalue for move constructor */
-            destruct_at(m_Data + i);
+            LvnVector<T> temp(data, size);
+            insert_index(index, temp.m_Data, size);
+            return;
+        }
+
+        grow(m_Size + size);
+
+        if constexpr (s_Trivial)
+        {
+            memmove(m_Data + index + size, m_Data + index, (m_Size - index) * sizeof(T));
+            memcpy(m_Data + index, data, size * sizeof(T));
+        }
+        else
+        {
+            /* shift elements to the right */
+            for (int64_t i = m_Size - 1; i >= (int64_t)index; --i)
+            {
+                new (m_Data + i + size) T(static_cast<std::remove_reference_t<T>&&>(m_Data[i])); /* NOTE: cast to rvalue for move constructor */
+                destruct_at(m_Data + i);
+            }
+
+            /* construct new elements in place at index */
+            for (size_t i = 0; i < size; ++i)
+                new (m_Data + index + i) T(data[i]);
         }
 
-        /* construct new elements in place at index */
-        for (size_t i = 0; i < size; ++i)
-            new (m_Data + index + i) T(data[i]);
+        m_Size += size;
+    }
 
+    /* opens a gap of size elements at index without constructing them and returns a pointer to the gap, the caller writes every element */
+    T* insert_uninitialized(size_t index, size_t size)
+    {
+        static_assert(s_Trivial, "insert_uninitialized requires a trivially copyable element type");
+        LVN_CORE_ASSERT(index <= m_Size, "insert index not within vector bounds");
+        grow(m_Size + size);
+        if (index != m_Size)
+            memmove(m_Data + index + size, m_Data + index, (m_Size - index) * sizeof(T));
         m_Size += size;
+        return m_Data + index;
+    }
+    T* push_back_uninitialized(size_t size) { return insert_uninitialized(m_Size, size); }
+    void resize_uninitialized(size_t size)
+    {
+        static_assert(s_Trivial, "resize_uninitialized requires a trivially copyable element type");
+        grow(size);
+        m_Size = size;
     }
 
     T*          begin() { return m_Data; }
@@ -2636,23 +3909,48 @@ public:
 
     bool        empty() const { return m_Size == 0; }
     void        clear() { destruct(); m_Size = 0; }
-    void        clear_free() { if (m_Data) { lvn::memDelete<T>(m_Data, m_Size); m_Size = m_Capacity = 0; m_Data = nullptr; } }
+    void        clear_free() { if (m_Data) { destruct(); deallocate(m_Data); m_Size = m_Capacity = 0; m_Data = nullptr; } }
+    void        set_allocator(const LvnAllocator* allocator) { LVN_CORE_ASSERT(m_Capacity == 0, "the allocator of a vector can only be set before it allocates"); m_Allocator = allocator; }
+    const LvnAllocator* allocator() const { return m_Allocator; }
     void        erase(const T* it) { LVN_CORE_ASSERT(it >= m_Data && it < m_Data + m_Size, "erase element not within vector bounds"); size_t index = it - m_Data; erase_index(index); }
-    void        erase_index(size_t index) { LVN_CORE_ASSERT(index < m_Size, "index out of vector size range"); size_t aftIndex = m_Size - index - 1; if (aftIndex != 0) { for (size_t i = index + 1; i < m_Size; i++) { m_Data[i - 1] = m_Data[i]; } destruct_at(&m_Data[m_Size - 1]); } --m_Size; }
+    void        erase_index(size_t index)
+    {
+        LVN_CORE_ASSERT(index < m_Size, "index out of vector size range");
+        if constexpr (s_Trivial)
+        {
+            memmove(m_Data + index, m_Data + index + 1, (m_Size - index - 1) * sizeof(T));
+        }
+        else
+        {
+            for (size_t i = index + 1; i < m_Size; i++) { m_Data[i - 1] = static_cast<std::remove_reference_t<T>&&>(m_Data[i]); }
+            destruct_at(&m_Data[m_Size - 1]);
+        }
+        --m_Size;
+    }
     T*          data() { return m_Data; }
     const T*    data() const { return m_Data; }
+
+    /* gives up ownership of the elements without destroying them, they are freed with lvn::allocatorDelete on allocator() after running their destructors */
+    T* release()
+    {
+        T* data = m_Data;
+        m_Data = nullptr;
+        m_Size = m_Capacity = 0;
+        return data;
+    }
     size_t      size() const { return m_Size; }
     size_t      capacity() const { return m_Capacity; }
     size_t      memsize() const { return m_Size * sizeof(T); }
     size_t      memcap() const { return m_Capacity * sizeof(T); }
-    void        resize(size_t size) { if (size > m_Size) { reserve(size); for (size_t i = m_Size; i < size; i++) { new (m_Data + i) T(); } } else { for (size_t i = size; i < m_Size; i++) destruct_at(&m_Data[i]); }  m_Size = size; }
-    void        resize(size_t size, const T& value) { if (size > m_Size) { reserve(size); for (size_t i = m_Size; i < size; i++) { new (m_Data + i) T(value); } } else { for (size_t i = size; i < m_Size; i++) destruct_at(&m_Data[i]); }  m_Size = size; }
-    void        reserve(size_t size) { if (size <= m_Capacity) return; T* temp = lvn::memNew<T>(size, false); for (size_t i = 0; i < m_Size; i++) { new (temp + i) T(m_Data[i]); } lvn::memDelete<T>(m_Data, m_Size); m_Data = temp; m_Capacity = size; }
-    void        shrink_to_fit() { if (m_Size >= m_Capacity) { return; } T* temp = lvn::memNew<T>(m_Size, false); for (size_t i = 0; i < m_Size; i++) { new (temp + i) T(m_Data[i]); } lvn::memDelete<T>(m_Data, m_Size); m_Data = temp; m_Capacity = m_Size; }
+    void        resize(size_t size) { if (size > m_Size) { grow(size); for (size_t i = m_Size; i < size; i++) { new (m_Data + i) T(); } } else { for (size_t i = size; i < m_Size; i++) destruct_at(&m_Data[i]); }  m_Size = size; }
+    void        resize(size_t size, const T& value) { if (size > m_Size) { grow(size); for (size_t i = m_Size; i < size; i++) { new (m_Data + i) T(value); } } else { for (size_t i = size; i < m_Size; i++) destruct_at(&m_Data[i]); }  m_Size = size; }
+    void        reserve(size_t size) { if (size <= m_Capacity) return; reallocate(size); }
+    void        shrink_to_fit() { if (m_Size >= m_Capacity) { return; } if (m_Size == 0) { clear_free(); return; } reallocate(m_Size); }
 
-    void        push_back(const T& value) { resize(m_Size + 1); m_Data[m_Size - 1] = value; }
-    void        push_range(const T* data, size_t size) { resize(m_Size + size); for (size_t i = 0; i < size; i++) { m_Data[i + m_Size - size] = data[i]; } }
-    void        pop_back() { if (m_Size == 0) return; destruct_at(&m_Data[m_Size - 1]); resize(m_Size - 1); }
+    void        push_back(const T& value) { if (m_Size == m_Capacity) { T temp(value); grow(m_Size + 1); new (m_Data + m_Size) T(static_cast<T&&>(temp)); } else { new (m_Data + m_Size) T(value); } m_Size++; }
+    void        push_back(T&& value) { if (m_Size == m_Capacity) { T temp(static_cast<T&&>(value)); grow(m_Size + 1); new (m_Data + m_Size) T(static_cast<T&&>(temp)); } else { new (m_Data + m_Size) T(static_cast<T&&>(value)); } m_Size++; }
+    void        push_range(const T* data, size_t size) { insert_index(m_Size, data, size); }
+    void        pop_back() { if (m_Size == 0) return; destruct_at(&m_Data[m_Size - 1]); --m_Size; }
 
     T*          find(const T& e) { T* begin = m_Data; const T* end = m_Data + m_Size; while (begin < end) { if (*begin == e) break; begin++; } return begin; }
     const T*    find(const T& e) const { T* begin = m_Data; const T* end = m_Data + m_Size; while (begin < end) { if (*begin == e) break; begin++; } return begin; }
@@ -2661,11 +3959,180 @@ public:
 };
 
 
+// -- LvnSmallVector
+// ------------------------------------------------------------
+// - vector that keeps up to N elements inline before falling back to the heap
+// - meant for short lived scratch vectors on hot paths where the element count is usually small, eg. formatting log messages
+// - moving a small vector that is still inline moves each element, pointers into an inline small vector are not stable across moves
+
+template <typename T, size_t N>
+class LvnSmallVector
+{
+private:
+    T* m_Data;            /* points to m_Local while the elements fit inline, otherwise to a heap allocation */
+    size_t m_Size;      /* number of elements that are in this vector */
+    size_t m_Capacity;  /* N while inline, otherwise the number of elements allocated on the heap */
+    alignas(T) unsigned char m_Local[N * sizeof(T)]; /* inline storage, elements are constructed in place */
+
+    static_assert(N > 0, "LvnSmallVector inline capacity must be greater than 0");
+
+    T* local() { return reinterpret_cast<T*>(m_Local); }
+    bool is_local() const { return m_Data == reinterpret_cast<const T*>(m_Local); }
+
+    void destruct() { if constexpr (!std::is_trivially_destructible_v<T>) { for (size_t i = 0; i < m_Size; i++) m_Data[i].~T(); } }
+    void free_data() { if (!is_local()) lvn::memDelete<T>(m_Data, 0); }
+
+    void reallocate(size_t capacity)
+    {
+        T* temp = lvn::memNew<T>(capacity, false);
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            if (m_Size != 0) memcpy(temp, m_Data, m_Size * sizeof(T));
+        }
+        else
+        {
+            for (size_t i = 0; i < m_Size; i++)
+            {
+                new (temp + i) T(static_cast<std::remove_reference_t<T>&&>(m_Data[i]));
+                m_Data[i].~T();
+            }
+        }
+        free_data();
+        m_Data = temp;
+        m_Capacity = capacity;
+    }
+
+    void grow(size_t size)
+    {
+        if (size <= m_Capacity) return;
+        size_t grown = static_cast<size_t>(static_cast<double>(m_Capacity) * LVN_VECTOR_GROWTH_FACTOR);
+        reallocate(grown > size ? grown : size);
+    }
+
+    void move_from(LvnSmallVector& other)
+    {
+        if (other.is_local())
+        {
+            m_Data = local();
+            m_Capacity = N;
+            for (size_t i = 0; i < other.m_Size; i++)
+                new (m_Data + i) T(static_cast<std::remove_reference_t<T>&&>(other.m_Data[i]));
+            m_Size = other.m_Size;
+            other.clear();
+        }
+        else
+        {
+            m_Data = other.m_Data;
+            m_Size = other.m_Size;
+            m_Capacity = other.m_Capacity;
+            other.m_Data = other.local();
+            other.m_Size = 0;
+            other.m_Capacity = N;
+        }
+    }
+
+public:
+    LvnSmallVector()
+        : m_Data(local()), m_Size(0), m_Capacity(N) {}
+    ~LvnSmallVector()
+    {
+        destruct();
+        free_data();
+    }
+
+    LvnSmallVector(size_t size)
+        : m_Data(local()), m_Size(0), m_Capacity(N)
+    {
+        resize(size);
+    }
+    LvnSmallVector(const T* data, size_t size)
+        : m_Data(local()), m_Size(0), m_Capacity(N)
+    {
+        push_range(data, size);
+    }
+    LvnSmallVector(const LvnSmallVector& other)
+        : m_Data(local()), m_Size(0), m_Capacity(N)
+    {
+        push_range(other.m_Data, other.m_Size);
+    }
+    LvnSmallVector(LvnSmallVector&& other)
+    {
+        move_from(other);
+    }
+    LvnSmallVector& operator=(const LvnSmallVector& other)
+    {
+        if (this == &other) return *this;
+        clear();
+        push_range(other.m_Data, other.m_Size);
+        return *this;
+    }
+    LvnSmallVector& operator=(LvnSmallVector&& other)
+    {
+        if (this == &other) return *this;
+        destruct();
+        free_data();
+        move_from(other);
+        return *this;
+    }
+
+    T& operator[](size_t i)
+    {
+        LVN_CORE_ASSERT(i < m_Size, "index out of vector size range");
+        return m_Data[i];
+    }
+    const T& operator[](size_t i) const
+    {
+        LVN_CORE_ASSERT(i < m_Size, "index out of vector size range");
+        return m_Data[i];
+    }
+
+    T*          begin() { return m_Data; }
+    const T*    begin() const { return m_Data; }
+    T*          end() { return m_Data + m_Size; }
+    const T*    end() const { return m_Data + m_Size; }
+    T&          front() { LVN_CORE_ASSERT(m_Size > 0, "cannot access index of empty vector"); return m_Data[0]; }
+    const T&    front() const { LVN_CORE_ASSERT(m_Size > 0, "cannot access index of empty vector"); return m_Data[0]; }
+    T&          back() { LVN_CORE_ASSERT(m_Size > 0, "cannot access index of empty vector"); return m_Data[m_Size - 1]; }
+    const T&    back() const { LVN_CORE_ASSERT(m_Size > 0, "cannot access index of empty vector"); return m_Data[m_Size - 1]; }
+
+    bool        empty() const { return m_Size == 0; }
+    bool        inlined() const { return is_local(); }
+    void        clear() { destruct(); m_Size = 0; }
+    T*          data() { return m_Data; }
+    const T*    data() const { return m_Data; }
+    size_t      size() const { return m_Size; }
+    size_t      capacity() const { return m_Capacity; }
+    size_t      memsize() const { return m_Size * sizeof(T); }
+
+    void        reserve(size_t size) { if (size > m_Capacity) reallocate(size); }
+    void        resize(size_t size) { if (size > m_Size) { grow(size); for (size_t i = m_Size; i < size; i++) { new (m_Data + i) T(); } } else if constexpr (!std::is_trivially_destructible_v<T>) { for (size_t i = size; i < m_Size; i++) m_Data[i].~T(); } m_Size = size; }
+    void        resize(size_t size, const T& value) { if (size > m_Size) { grow(size); for (size_t i = m_Size; i < size; i++) { new (m_Data + i) T(value); } } else if constexpr (!std::is_trivially_destructible_v<T>) { for (size_t i = size; i < m_Size; i++) m_Data[i].~T(); } m_Size = size; }
+
+    void        push_back(const T& value) { if (m_Size == m_Capacity) { T temp(value); grow(m_Size + 1); new (m_Data + m_Size) T(static_cast<T&&>(temp)); } else { new (m_Data + m_Size) T(value); } m_Size++; }
+    void        push_back(T&& value) { if (m_Size == m_Capacity) { T temp(static_cast<T&&>(value)); grow(m_Size + 1); new (m_Data + m_Size) T(static_cast<T&&>(temp)); } else { new (m_Data + m_Size) T(static_cast<T&&>(value)); } m_Size++; }
+    void        push_range(const T* data, size_t size)
+    {
+        if (size == 0) return;
+        LVN_CORE_ASSERT(data + size <= m_Data || data >= m_Data + m_Capacity, "cannot push a range from the same small vector");
+        grow(m_Size + size);
+        if constexpr (std::is_trivially_copyable_v<T>)
+            memcpy(m_Data + m_Size, data, size * sizeof(T));
+        else
+            for (size_t i = 0; i < size; i++) { new (m_Data + m_Size + i) T(data[i]); }
+        m_Size += size;
+    }
+    void        pop_back() { if (m_Size == 0) return; if constexpr (!std::is_trivially_destructible_v<T>) { m_Data[m_Size - 1].~T(); } --m_Size; }
+};
+
+
 // -- LvnLinkedIndexNode, LvnArenaList
 // ------------------------------------------------------------
 // - simple and light weight replacement to std::list
 // - arena list is designed to be more cache effecient by using indexed nodes to an allocated array instead of allocated memory per node
-// - inserting into LvnArenaList has at worst O(n) linear time complexity
+// - the node array grows geometrically and free nodes are kept in an index free list, so pushing is amortized O(1), index based access and insertion walks the list in O(n)
+// - every node in the array holds a constructed value, values of free nodes are reset to T()
+// - after erasing, the taken nodes are scattered through the array, compact() relinks them so memory order is list order again
+// - dense() iterates the taken nodes in memory order without following the links, which is list order after compact()
 
 // LvnLinkedIndexNode
 template <typename T>
@@ -2685,50 +4152,27 @@ class LvnArenaList
 {
 private:
     LvnINode<T>* m_Nodes;              /* pointer to an array of nodes */
-    size_t* m_FreeNodes;             /* pointer to an array of indices for nodes that are not taken in the array */
+    size_t* m_FreeNodes;             /* pointer to an array of indices for nodes that are not taken in the array, the last index is taken first */
     size_t m_Size;                   /* the number of the currently alive nodes in the list */
     size_t m_Capacity;               /* the number of nodes allocated for the m_Nodes array */
-    size_t m_FreeSize;               /* the number of indices for nodes not taken */
+    size_t m_FreeSize;               /* the number of indices for nodes not taken; NOTE: m_FreeSize is always m_Capacity - m_Size */
     size_t m_FreeCapacity;           /* the number of indices allocated in the m_FreeNodes array; NOTE: m_FreeCapacity should always be the same value as m_Capacity */
     size_t m_Head;                   /* the index to the head of the list in the array */
     size_t m_Tail;                   /* the index to the tail of the list in the array */
+    const LvnAllocator* m_Allocator; /* allocator the node arrays are allocated from, the global memory functions are used when nullptr */
+
+    static constexpr size_t s_MinCapacity = 8;
 
     void destruct()
     {
         if constexpr (!std::is_trivially_destructible_v<T>)
         {
             for (size_t i = 0; i < m_Capacity; i++)
-            {
-                if (m_Nodes[i].taken)
-                    m_Nodes[i].value.~T();
-            }
+                m_Nodes[i].value.~T();
         }
     }
 
-    void destruct_at(LvnINode<T>& node)
-    {
-        if constexpr (!std::is_trivially_destructible_v<T>)
-            node.value.~T();
-        node.next = 0;
-        node.prev = 0;
-        node.hasPrev = false;
-        node.hasNext = false;
-        node.taken = false;
-    }
-
-public:
-    LvnArenaList() : m_Nodes(nullptr), m_FreeNodes(nullptr), m_Size(0), m_Capacity(0), m_FreeSize(0), m_FreeCapacity(0), m_Head(0), m_Tail(0) {}
-    ~LvnArenaList()
-    {
-        destruct();
-        lvn::memDelete<LvnINode<T>>(m_Nodes, 0);
-        lvn::memDelete<size_t>(m_FreeNodes, 0);
-        m_Size = m_Capacity = m_FreeSize = m_FreeCapacity = m_Head = m_Tail = 0;
-        m_Nodes = nullptr;
-        m_FreeNodes = nullptr;
-    }
-
-    LvnArenaList(const LvnArenaList<T>& other)
+    void copy_from(const LvnArenaList<T>& other)
     {
         m_Head = other.m_Head;
         m_Tail = other.m_Tail;
@@ -2736,15 +4180,16 @@ public:
         m_Capacity = other.m_Capacity;
         m_FreeSize = other.m_FreeSize;
         m_FreeCapacity = other.m_FreeCapacity;
-        m_Nodes = lvn::memNew<LvnINode<T>>(other.m_Capacity, false);
+        m_Nodes = lvn::allocatorNew<LvnINode<T>>(m_Allocator, other.m_Capacity);
         for (size_t i = 0; i < other.m_Capacity; i++)
             new (&m_Nodes[i]) LvnINode<T>(other.m_Nodes[i]);
-        m_FreeNodes = lvn::memNew<size_t>(other.m_FreeSize, false);
-        for (size_t i = 0; i < other.m_FreeSize; i++)
-            new (&m_FreeNodes[i]) size_t(other.m_FreeNodes[i]);
+        m_FreeNodes = lvn::allocatorNew<size_t>(m_Allocator, other.m_FreeCapacity);
+        if (other.m_FreeSize) { memcpy(m_FreeNodes, other.m_FreeNodes, other.m_FreeSize * sizeof(size_t)); }
     }
-    LvnArenaList(LvnArenaList<T>&& other)
+
+    void move_from(LvnArenaList<T>& other)
     {
+        m_Allocator = other.m_Allocator;
         m_Nodes = other.m_Nodes;
         m_FreeNodes = other.m_FreeNodes;
         m_Size = other.m_Size;
@@ -2755,54 +4200,139 @@ public:
         m_Tail = other.m_Tail;
         other.m_Nodes = nullptr;
         other.m_FreeNodes = nullptr;
-        other.m_Size = 0;
-        other.m_Capacity = 0;
-        other.m_FreeSize = 0;
-        other.m_FreeCapacity = 0;
-        other.m_Head = 0;
-        other.m_Tail = 0;
+        other.m_Size = other.m_Capacity = other.m_FreeSize = other.m_FreeCapacity = other.m_Head = other.m_Tail = 0;
+    }
+
+    /* takes a free node for value, the node is not linked yet */
+    size_t take_node(const T& value)
+    {
+        if (m_FreeSize == 0)
+            reserve(m_Capacity ? m_Capacity * 2 : s_MinCapacity);
+
+        size_t nodeIndex = m_FreeNodes[--m_FreeSize];
+        LvnINode<T>& node = m_Nodes[nodeIndex];
+        node.value = value;
+        node.taken = true;
+        node.hasPrev = node.hasNext = false;
+        node.next = node.prev = 0;
+        return nodeIndex;
+    }
+
+    /* unlinks the node and returns it to the free list */
+    void release_node(size_t nodeIndex)
+    {
+        LvnINode<T>& node = m_Nodes[nodeIndex];
+        LVN_CORE_ASSERT(node.taken, "cannot release a node that is not taken");
+
+        if (node.hasPrev) { m_Nodes[node.prev].next = node.next; m_Nodes[node.prev].hasNext = node.hasNext; }
+        else { m_Head = node.next; }
+        if (node.hasNext) { m_Nodes[node.next].prev = node.prev; m_Nodes[node.next].hasPrev = node.hasPrev; }
+        else { m_Tail = node.prev; }
+
+        node.value = T();
+        node.next = node.prev = 0;
+        node.hasPrev = node.hasNext = node.taken = false;
+
+        m_FreeNodes[m_FreeSize++] = nodeIndex;
+        m_Size--;
+        if (m_Size == 0) { m_Head = m_Tail = 0; }
+    }
+
+    /* links a taken node directly before the node at nextIndex */
+    void link_before(size_t nodeIndex, size_t nextIndex)
+    {
+        LvnINode<T>& node = m_Nodes[nodeIndex];
+        LvnINode<T>& next = m_Nodes[nextIndex];
+        node.next = nextIndex;
+        node.hasNext = true;
+        node.prev = next.prev;
+        node.hasPrev = next.hasPrev;
+        if (next.hasPrev) { m_Nodes[next.prev].next = nodeIndex; m_Nodes[next.prev].hasNext = true; }
+        else { m_Head = nodeIndex; }
+        next.prev = nodeIndex;
+        next.hasPrev = true;
+        m_Size++;
+    }
+
+    /* links a taken node at the end of the list */
+    void link_back(size_t nodeIndex)
+    {
+        LvnINode<T>& node = m_Nodes[nodeIndex];
+        if (m_Size == 0) { m_Head = m_Tail = nodeIndex; m_Size++; return; }
+        node.prev = m_Tail;
+        node.hasPrev = true;
+        m_Nodes[m_Tail].next = nodeIndex;
+        m_Nodes[m_Tail].hasNext = true;
+        m_Tail = nodeIndex;
+        m_Size++;
+    }
+
+    size_t node_array_index(size_t index) const
+    {
+        LVN_CORE_ASSERT(index < m_Size, "list index out of range");
+        size_t nodeIndex = m_Head;
+        for (size_t i = 0; i < index; i++)
+            nodeIndex = m_Nodes[nodeIndex].next;
+        return nodeIndex;
+    }
+
+public:
+    /* walks the taken nodes in memory order */
+    template <typename NodeType, typename ValueType>
+    class DenseIterator
+    {
+    private:
+        NodeType* m_Node;
+        NodeType* m_End;
+
+        void skip_free() { while (m_Node != m_End && !m_Node->taken) ++m_Node; }
+
+    public:
+        DenseIterator(NodeType* node, NodeType* end) : m_Node(node), m_End(end) { skip_free(); }
+
+        ValueType& operator*() const { return m_Node->value; }
+        ValueType* operator->() const { return &m_Node->value; }
+        DenseIterator& operator++() { ++m_Node; skip_free(); return *this; }
+        bool operator==(const DenseIterator& other) const { return m_Node == other.m_Node; }
+        bool operator!=(const DenseIterator& other) const { return m_Node != other.m_Node; }
+    };
+
+    typedef DenseIterator<LvnINode<T>, T> dense_iterator;
+    typedef DenseIterator<const LvnINode<T>, const T> const_dense_iterator;
+
+    template <typename Iterator>
+    struct DenseRange
+    {
+        Iterator first, last;
+
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+    };
+
+    LvnArenaList() : m_Nodes(nullptr), m_FreeNodes(nullptr), m_Size(0), m_Capacity(0), m_FreeSize(0), m_FreeCapacity(0), m_Head(0), m_Tail(0), m_Allocator(nullptr) {}
+    ~LvnArenaList() { clear_free(); }
+
+    LvnArenaList(const LvnArenaList<T>& other)
+        : m_Allocator(nullptr)
+    {
+        copy_from(other);
+    }
+    LvnArenaList(LvnArenaList<T>&& other)
+    {
+        move_from(other);
     }
     LvnArenaList& operator=(const LvnArenaList<T>& other)
     {
         if (this == &other) return *this;
-        destruct();
-        lvn::memDelete<LvnINode<T>>(m_Nodes, 0);
-        lvn::memDelete<size_t>(m_FreeNodes, 0);
-        m_Head = other.m_Head;
-        m_Tail = other.m_Tail;
-        m_Size = other.m_Size;
-        m_Capacity = other.m_Capacity;
-        m_FreeSize = other.m_FreeSize;
-        m_FreeCapacity = other.m_FreeCapacity;
-        m_Nodes = lvn::memNew<LvnINode<T>>(other.m_Capacity, false);
-        for (size_t i = 0; i < other.m_Capacity; i++)
-            new (&m_Nodes[i]) LvnINode<T>(other.m_Nodes[i]);
-        m_FreeNodes = lvn::memNew<size_t>(other.m_FreeSize, false);
-        for (size_t i = 0; i < other.m_FreeSize; i++)
-            new (&m_FreeNodes[i]) size_t(other.m_FreeNodes[i]);
+        clear_free();
+        copy_from(other);
         return *this;
     }
     LvnArenaList& operator=(LvnArenaList<T>&& other)
     {
-        destruct();
-        lvn::memDelete<LvnINode<T>>(m_Nodes, 0);
-        lvn::memDelete<size_t>(m_FreeNodes, 0);
-        m_Nodes = other.m_Nodes;
-        m_FreeNodes = other.m_FreeNodes;
-        m_Size = other.m_Size;
-        m_Capacity = other.m_Capacity;
-        m_FreeSize = other.m_FreeSize;
-        m_FreeCapacity = other.m_FreeCapacity;
-        m_Head = other.m_Head;
-        m_Tail = other.m_Tail;
-        other.m_Nodes = nullptr;
-        other.m_FreeNodes = nullptr;
-        other.m_Size = 0;
-        other.m_Capacity = 0;
-        other.m_FreeSize = 0;
-        other.m_FreeCapacity = 0;
-        other.m_Head = 0;
-        other.m_Tail = 0;
+        if (this == &other) return *this;
+        clear_free();
+        move_from(other);
         return *this;
     }
 
@@ -2815,358 +4345,516 @@ public:
         return at_index(index);
     }
 
-    T& at_index(size_t index)
-    {
-        LVN_CORE_ASSERT(index < m_Size, "list index out of range");
-        size_t nodeIndex = m_Head;
-        for (size_t i = 0; i < index; i++)
-        {
-            if (m_Nodes[nodeIndex].hasNext)
-                nodeIndex = m_Nodes[nodeIndex].next;
-        }
-        return m_Nodes[nodeIndex].value;
-    }
-    const T& at_index(size_t index) const
-    {
-        LVN_CORE_ASSERT(index < m_Size, "list index out of range");
-        size_t nodeIndex = m_Head;
-        for (size_t i = 0; i < index; i++)
-        {
-            if (m_Nodes[nodeIndex].hasNext)
-                nodeIndex = m_Nodes[nodeIndex].next;
-        }
-        return m_Nodes[nodeIndex].value;
-    }
+    T& at_index(size_t index) { return m_Nodes[node_array_index(index)].value; }
+    const T& at_index(size_t index) const { return m_Nodes[node_array_index(index)].value; }
 
     LvnINode<T>& node_index(size_t index, size_t* pIndex = nullptr)
     {
-        LVN_CORE_ASSERT(index < m_Size, "list index out of range");
-        size_t nodeIndex = m_Head;
-        for (size_t i = 0; i < index; i++)
-        {
-            if (m_Nodes[nodeIndex].hasNext)
-                nodeIndex = m_Nodes[nodeIndex].next;
-        }
-
+        size_t nodeIndex = node_array_index(index);
         if (pIndex) *pIndex = nodeIndex;
         return m_Nodes[nodeIndex];
     }
     const LvnINode<T>& node_index(size_t index, size_t* pIndex = nullptr) const
     {
-        LVN_CORE_ASSERT(index < m_Size, "list index out of range");
-        size_t nodeIndex = m_Head;
-        for (size_t i = 0; i < index; i++)
-        {
-            if (m_Nodes[nodeIndex].hasNext)
-                nodeIndex = m_Nodes[nodeIndex].next;
-        }
-
+        size_t nodeIndex = node_array_index(index);
         if (pIndex) *pIndex = nodeIndex;
         return m_Nodes[nodeIndex];
     }
 
     void erase_index(const size_t index)
     {
-        LVN_CORE_ASSERT(index < m_Size, "list index out of range");
-
-        if (index == 0) { pop_front(); return; }
-        else if (index == m_Size - 1) { pop_back(); return; }
-
-        size_t nodeIndex;
-        LvnINode<T>& node = node_index(index, &nodeIndex);
-        if (node.hasNext)
-        {
-            LvnINode<T>& next = m_Nodes[node.next];
-            next.prev = node.prev;
-        }
-        if (node.hasPrev)
-        {
-            LvnINode<T>& prev = m_Nodes[node.prev];
-            prev.next = node.next;
-        }
-
-        /* push back free node */
-        LVN_CORE_ASSERT(m_FreeSize < m_FreeCapacity, "free nodes array is full");
-        m_FreeNodes[m_FreeSize] = nodeIndex;
-        m_FreeSize++;
-
-        destruct_at(node);
-        m_Size--;
+        release_node(node_array_index(index));
     }
     void insert_index(const size_t index, const T& value)
     {
         LVN_CORE_ASSERT(index <= m_Size, "list index out of range");
 
-        if (index == 0) { push_front(value); return; }
         if (index == m_Size) { push_back(value); return; }
 
-        if (m_Size >= m_Capacity)
-            reserve(m_Size + 1);
-
-        size_t currentNodeIndex;
-        LvnINode<T>& node = node_index(index, &currentNodeIndex);
-
-        /* check if there are indices to free nodes */
-        if (m_FreeSize != 0)
+        size_t nodeIndex = take_node(value); /* NOTE: take the node first, it can reallocate the node array */
+        link_before(nodeIndex, node_array_index(index));
+    }
+    void push_back(const T& data)
+    {
+        link_back(take_node(data));
+    }
+    void push_front(const T& data)
+    {
+        size_t nodeIndex = take_node(data);
+        if (m_Size == 0) { link_back(nodeIndex); return; }
+        link_before(nodeIndex, m_Head);
+    }
+    void push_back_range(const T* data, size_t size)
+    {
+        if (m_Size + size > m_Capacity)
         {
-            size_t nodeIndex = m_FreeNodes[m_FreeSize - 1];
-            LvnINode<T>& newNode = m_Nodes[nodeIndex];
-            newNode = node;
-            newNode.prev = currentNodeIndex;
-            newNode.hasPrev = true;
-            newNode.taken = true;
-
-            if (index == m_Size - 1) /* if insert is on last index, move tail to next */
-                m_Tail = nodeIndex;
-
-            node.value = value;
-            node.next = nodeIndex;
-            node.hasNext = true;
-            m_Size++;
-            m_FreeSize--;
-            return;
+            size_t capacity = m_Capacity ? m_Capacity * 2 : s_MinCapacity;
+            reserve(capacity > m_Size + size ? capacity : m_Size + size);
         }
 
-        /* find an index linearly */
-        for (size_t i = 0; i < m_Capacity; i++)
+        for (size_t i = 0; i < size; i++)
+            link_back(take_node(data[i]));
+    }
+    void pop_back()
+    {
+        if (!m_Size) { return; }
+        release_node(m_Tail);
+    }
+    void pop_front()
+    {
+        if (!m_Size) { return; }
+        release_node(m_Head);
+    }
+
+    /* erases every element pred returns true for in one pass over the list, returns the number of erased elements */
+    template <typename Pred>
+    size_t erase_if(Pred pred)
+    {
+        size_t erased = 0;
+        size_t nodeIndex = m_Head;
+        size_t count = m_Size;
+        for (size_t i = 0; i < count; i++)
         {
-            if (!m_Nodes[i].taken)
+            LvnINode<T>& node = m_Nodes[nodeIndex];
+            size_t next = node.next;
+            if (pred(node.value))
             {
-                if (node.hasNext)
-                    m_Nodes[node.next].prev = i;
-
-                LvnINode<T>& newNode = m_Nodes[i];
-                newNode = node;
-                newNode.prev = currentNodeIndex;
-                newNode.hasPrev = true;
-                newNode.taken = true;
-
-                if (index == m_Size - 1) /* if insert is on last index, move tail to next */
-                    m_Tail = i;
-
-                node.value = value;
-                node.next = i;
-                node.hasNext = true;
-                m_Size++;
-                return;
+                release_node(nodeIndex);
+                erased++;
             }
+            nodeIndex = next;
         }
-
-        LVN_CORE_ASSERT(false, "could not find empty node to insert index");
+        return erased;
     }
-    void push_back(const T& data)
+
+    /* moves the taken nodes to the front of the array in list order, links them in memory order and puts the free nodes behind them */
+    void compact()
     {
-        if (!m_Size)
+        if (m_Capacity == 0) { return; }
+
+        LvnINode<T>* temp = lvn::allocatorNew<LvnINode<T>>(m_Allocator, m_Capacity);
+        size_t nodeIndex = m_Head;
+        for (size_t i = 0; i < m_Size; i++)
         {
-            reserve(m_Size + 1);
-            m_Head = m_Tail = 0;
-            m_Nodes[m_Head].value = data;
-            m_Nodes[m_Head].taken = true;
-            m_Size++;
-            return;
+            LvnINode<T>& node = m_Nodes[nodeIndex];
+            new (&temp[i]) LvnINode<T>(static_cast<LvnINode<T>&&>(node));
+            temp[i].prev = i - 1;
+            temp[i].next = i + 1;
+            temp[i].hasPrev = i != 0;
+            temp[i].hasNext = i + 1 != m_Size;
+            nodeIndex = node.next;
         }
+        if (m_Size) { temp[0].prev = 0; temp[m_Size - 1].next = 0; }
+        for (size_t i = m_Size; i < m_Capacity; i++)
+            new (&temp[i]) LvnINode<T>();
 
-        if (m_Size >= m_Capacity)
-            reserve(m_Size + 1);
-
-        LvnINode<T>& node = m_Nodes[m_Tail];
+        destruct();
+        lvn::allocatorDelete<LvnINode<T>>(m_Allocator, m_Nodes);
+        m_Nodes = temp;
+        m_Head = 0;
+        m_Tail = m_Size ? m_Size - 1 : 0;
 
-        /* check if there are indices to free nodes */
-        if (m_FreeSize != 0)
-        {
-            size_t nodeIndex = m_FreeNodes[m_FreeSize - 1];
-            LvnINode<T>& newNode = m_Nodes[nodeIndex];
-            newNode.value = data;
-            newNode.prev = m_Tail;
-            newNode.hasPrev = true;
-            newNode.taken = true;
-
-            node.next = nodeIndex;
-            node.hasNext = true;
-            m_Tail = nodeIndex;
-            m_Size++;
-            m_FreeSize--;
-            return;
-        }
+        /* lowest free index is taken first so new nodes continue in memory order */
+        m_FreeSize = m_Capacity - m_Size;
+        for (size_t i = 0; i < m_FreeSize; i++)
+            m_FreeNodes[i] = m_Capacity - 1 - i;
+    }
 
-        /* find an index linearly */
+    void reserve(size_t size)
+    {
+        if (size <= m_Capacity) { return; }
+        LvnINode<T>* temp = lvn::allocatorNew<LvnINode<T>>(m_Allocator, size);
         for (size_t i = 0; i < m_Capacity; i++)
+            new (&temp[i]) LvnINode<T>(static_cast<LvnINode<T>&&>(m_Nodes[i]));
+        for (size_t i = m_Capacity; i < size; i++)
+            new (&temp[i]) LvnINode<T>(); /* NOTE: allocators do not zero memory, new nodes must start out not taken */
+        destruct();
+        lvn::allocatorDelete<LvnINode<T>>(m_Allocator, m_Nodes);
+        m_Nodes = temp;
+
+        /* new nodes go below the existing free indices so they are taken last, lowest index first */
+        size_t* freeTemp = lvn::allocatorNew<size_t>(m_Allocator, size);
+        size_t added = size - m_Capacity;
+        for (size_t i = 0; i < added; i++)
+            freeTemp[i] = size - 1 - i;
+        if (m_FreeSize) { memcpy(freeTemp + added, m_FreeNodes, m_FreeSize * sizeof(size_t)); }
+        lvn::allocatorDelete<size_t>(m_Allocator, m_FreeNodes);
+        m_FreeNodes = freeTemp;
+        m_FreeSize += added;
+        m_FreeCapacity = size;
+        m_Capacity = size;
+    }
+
+    size_t      size() const { return m_Size; }
+    size_t      capacity() const { return m_Capacity; }
+    bool        empty() const { return m_Size == 0; }
+    void        set_allocator(const LvnAllocator* allocator) { LVN_CORE_ASSERT(m_Capacity == 0, "the allocator of a list can only be set before it allocates"); m_Allocator = allocator; }
+    const LvnAllocator* allocator() const { return m_Allocator; }
+    void        clear() { for (size_t i = 0; i < m_Capacity; i++) { m_Nodes[i].value = T(); m_Nodes[i].taken = m_Nodes[i].hasPrev = m_Nodes[i].hasNext = false; m_FreeNodes[i] = m_Capacity - 1 - i; } m_Size = 0; m_FreeSize = m_FreeCapacity; m_Head = m_Tail = 0; }
+    void        clear_free() { destruct(); lvn::allocatorDelete<LvnINode<T>>(m_Allocator, m_Nodes); lvn::allocatorDelete<size_t>(m_Allocator, m_FreeNodes); m_Nodes = nullptr; m_FreeNodes = nullptr; m_Head = m_Tail = m_Size = m_Capacity = m_FreeSize = m_FreeCapacity = 0; }
+
+    dense_iterator              dense_begin() { return dense_iterator(m_Nodes, m_Nodes + m_Capacity); }
+    dense_iterator              dense_end() { return dense_iterator(m_Nodes + m_Capacity, m_Nodes + m_Capacity); }
+    const_dense_iterator        dense_begin() const { return const_dense_iterator(m_Nodes, m_Nodes + m_Capacity); }
+    const_dense_iterator        dense_end() const { return const_dense_iterator(m_Nodes + m_Capacity, m_Nodes + m_Capacity); }
+    DenseRange<dense_iterator>         dense() { return { dense_begin(), dense_end() }; }
+    DenseRange<const_dense_iterator>   dense() const { return { dense_begin(), dense_end() }; }
+
+    T&          front() { LVN_CORE_ASSERT(m_Size, "cannot call front on empty list"); return m_Nodes[m_Head].value; }
+    const T&    front() const { LVN_CORE_ASSERT(m_Size, "cannot call front on empty list"); return m_Nodes[m_Head].value; }
+
+    T&          back() { LVN_CORE_ASSERT(m_Size, "cannot call back on empty list"); return m_Nodes[m_Tail].value; }
+    const T&    back() const { LVN_CORE_ASSERT(m_Size, "cannot call back on empty list"); return m_Nodes[m_Tail].value; }
+};
+
+
+// -- LvnQueue
+// ------------------------------------------------------------
+// - simple and light weight replacement to std::queue
+// - contiguous ring buffer, the capacity is always a power of two so wrapping the indices is a mask
+// - capacity doubles when a push runs out of space, popping never frees so steady push and pop churn does not allocate
+// - pop_back removes from the back so it can also be used as a double ended queue
+
+template <typename T>
+class LvnQueue
+{
+private:
+    T* m_Data;            /* ring buffer of m_Capacity slots, only the m_Size slots starting at m_Head are constructed */
+    size_t m_Head;        /* slot index of the front element */
+    size_t m_Size;
+    size_t m_Capacity;    /* zero or a power of two */
+    const LvnAllocator* m_Allocator; /* allocator the ring buffer is allocated from, the global memory functions are used when nullptr */
+
+    static constexpr size_t s_MinCapacity = 8;
+
+    size_t slot(size_t index) const { return (m_Head + index) & (m_Capacity - 1); }
+
+    void destruct() { if constexpr (!std::is_trivially_destructible_v<T>) { for (size_t i = 0; i < m_Size; i++) m_Data[slot(i)].~T(); } }
+
+    /* moves the elements in order into a new ring buffer of capacity slots starting at slot 0 */
+    void reallocate(size_t capacity)
+    {
+        T* temp = lvn::allocatorNew<T>(m_Allocator, capacity);
+        for (size_t i = 0; i < m_Size; i++)
+            new (temp + i) T(static_cast<T&&>(m_Data[slot(i)]));
+        destruct();
+        lvn::allocatorDelete<T>(m_Allocator, m_Data);
+        m_Data = temp;
+        m_Head = 0;
+        m_Capacity = capacity;
+    }
+
+    void grow()
+    {
+        if (m_Size < m_Capacity) { return; }
+        reallocate(m_Capacity ? m_Capacity * 2 : s_MinCapacity);
+    }
+
+    void copy_from(const LvnQueue& other)
+    {
+        reserve(other.m_Size);
+        for (size_t i = 0; i < other.m_Size; i++)
+            new (m_Data + i) T(other.m_Data[other.slot(i)]);
+        m_Head = 0;
+        m_Size = other.m_Size;
+    }
+
+public:
+    LvnQueue() : m_Data(nullptr), m_Head(0), m_Size(0), m_Capacity(0), m_Allocator(nullptr) {}
+    ~LvnQueue() { clear_free(); }
+
+    LvnQueue(const T* data, size_t size)
+        : m_Data(nullptr), m_Head(0), m_Size(0), m_Capacity(0), m_Allocator(nullptr)
+    {
+        reserve(size);
+        for (size_t i = 0; i < size; i++)
+            new (m_Data + i) T(data[i]);
+        m_Size = size;
+    }
+
+    LvnQueue(const LvnQueue& other)
+        : m_Data(nullptr), m_Head(0), m_Size(0), m_Capacity(0), m_Allocator(nullptr)
+    {
+        copy_from(other);
+    }
+    LvnQueue(LvnQueue&& other)
+        : m_Data(other.m_Data), m_Head(other.m_Head), m_Size(other.m_Size), m_Capacity(other.m_Capacity), m_Allocator(other.m_Allocator)
+    {
+        other.m_Data = nullptr;
+        other.m_Head = other.m_Size = other.m_Capacity = 0;
+    }
+    LvnQueue& operator=(const LvnQueue& other)
+    {
+        if (this == &other) return *this;
+        clear();
+        copy_from(other);
+        return *this;
+    }
+    LvnQueue& operator=(LvnQueue&& other)
+    {
+        if (this == &other) return *this;
+        clear_free();
+        m_Data = other.m_Data;
+        m_Head = other.m_Head;
+        m_Size = other.m_Size;
+        m_Capacity = other.m_Capacity;
+        m_Allocator = other.m_Allocator;
+        other.m_Data = nullptr;
+        other.m_Head = other.m_Size = other.m_Capacity = 0;
+        return *this;
+    }
+
+    size_t      size() const { return m_Size; }
+    size_t      capacity() const { return m_Capacity; }
+    bool        empty() const { return m_Size == 0; }
+    const LvnAllocator* allocator() const { return m_Allocator; }
+
+    /* moves the elements into memory from the new allocator */
+    void set_allocator(const LvnAllocator* allocator)
+    {
+        if (allocator == m_Allocator) { return; }
+        LvnQueue temp(static_cast<LvnQueue&&>(*this));
+        m_Allocator = allocator;
+        if (temp.m_Size == 0) { return; }
+        reserve(temp.m_Size);
+        for (size_t i = 0; i < temp.m_Size; i++)
+            new (m_Data + i) T(static_cast<T&&>(temp.m_Data[temp.slot(i)]));
+        m_Size = temp.m_Size;
+    }
+
+    /* capacity is rounded up to a power of two */
+    void reserve(size_t size)
+    {
+        if (size <= m_Capacity) { return; }
+        size_t capacity = m_Capacity ? m_Capacity : s_MinCapacity;
+        while (capacity < size)
+            capacity *= 2;
+        reallocate(capacity);
+    }
+
+    void push(const T& value)
+    {
+        if (m_Size == m_Capacity)
         {
-            if (!m_Nodes[i].taken)
-            {
-                LvnINode<T>& newNode = m_Nodes[i];
-                newNode.value = data;
-                newNode.prev = m_Tail;
-                newNode.hasPrev = true;
-                newNode.taken = true;
-
-                node.next = i;
-                node.hasNext = true;
-                m_Tail = i;
-                m_Size++;
-                return;
-            }
+            T temp(value); /* NOTE: value may be an element of this queue, copy it before the ring buffer moves */
+            push(static_cast<T&&>(temp));
+            return;
         }
-
-        LVN_CORE_ASSERT(false, "could not find empty node to push back element");
+        new (m_Data + slot(m_Size)) T(value);
+        m_Size++;
     }
-    void push_front(const T& data)
+    void push(T&& value)
     {
-        if (!m_Size)
+        if (m_Size == m_Capacity)
         {
-            reserve(m_Size + 1);
-            m_Head = m_Tail = 0;
-            m_Nodes[m_Head].value = data;
-            m_Nodes[m_Head].taken = true;
+            T temp(static_cast<T&&>(value));
+            grow();
+            new (m_Data + slot(m_Size)) T(static_cast<T&&>(temp));
             m_Size++;
             return;
         }
+        new (m_Data + slot(m_Size)) T(static_cast<T&&>(value));
+        m_Size++;
+    }
+    void pop()
+    {
+        LVN_CORE_ASSERT(m_Size, "cannot call pop on empty queue");
+        if constexpr (!std::is_trivially_destructible_v<T>) { m_Data[m_Head].~T(); }
+        m_Head = (m_Head + 1) & (m_Capacity - 1);
+        m_Size--;
+    }
+    void pop_back()
+    {
+        LVN_CORE_ASSERT(m_Size, "cannot call pop_back on empty queue");
+        if constexpr (!std::is_trivially_destructible_v<T>) { m_Data[slot(m_Size - 1)].~T(); }
+        m_Size--;
+    }
+
+    void        clear() { destruct(); m_Head = m_Size = 0; }
+    void        clear_free() { destruct(); lvn::allocatorDelete<T>(m_Allocator, m_Data); m_Data = nullptr; m_Head = m_Size = m_Capacity = 0; }
+
+    T&          front() { LVN_CORE_ASSERT(m_Size, "cannot call front on empty queue"); return m_Data[m_Head]; }
+    const T&    front() const { LVN_CORE_ASSERT(m_Size, "cannot call front on empty queue"); return m_Data[m_Head]; }
+    T&          back() { LVN_CORE_ASSERT(m_Size, "cannot call back on empty queue"); return m_Data[slot(m_Size - 1)]; }
+    const T&    back() const { LVN_CORE_ASSERT(m_Size, "cannot call back on empty queue"); return m_Data[slot(m_Size - 1)]; }
+};
 
-        if (m_Size >= m_Capacity)
-            reserve(m_Size + 1);
 
-        LvnINode<T>& node = m_Nodes[m_Head];
+// -- LvnSpscQueue, LvnMpmcQueue
+// ------------------------------------------------------------
+// - bounded lock-free ring buffer queues for handing work and events between threads, the capacity is fixed at construction
+// - LvnSpscQueue is for exactly one producer thread and one consumer thread
+// - LvnMpmcQueue allows any number of producer and consumer threads, each slot has a sequence number that tells
+//   producers and consumers whose turn it is (based on the bounded mpmc queue by dmitry vyukov)
+// - try_push returns false when the queue is full and try_pop returns false when it is empty, neither ever blocks or allocates
 
-        /* check if there are indices to free nodes */
-        if (m_FreeSize != 0)
+template <typename T>
+class LvnSpscQueue
+{
+private:
+    T* m_Data;
+    size_t m_Mask;
+
+    alignas(LVN_CACHE_LINE_SIZE) std::atomic<size_t> m_Head; /* written by the consumer */
+    size_t m_CachedTail;                                     /* consumer copy of m_Tail, only reloaded when the queue looks empty */
+    alignas(LVN_CACHE_LINE_SIZE) std::atomic<size_t> m_Tail; /* written by the producer */
+    size_t m_CachedHead;                                     /* producer copy of m_Head, only reloaded when the queue looks full */
+
+public:
+    /* capacity is rounded up to a power of two */
+    LvnSpscQueue(size_t capacity)
+        : m_Head(0), m_CachedTail(0), m_Tail(0), m_CachedHead(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        m_Data = lvn::memNew<T>(size, false);
+        m_Mask = size - 1;
+    }
+    ~LvnSpscQueue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
         {
-            size_t nodeIndex = m_FreeNodes[m_FreeSize - 1];
-            LvnINode<T>& newNode = m_Nodes[nodeIndex];
-            newNode.value = data;
-            newNode.next = m_Head;
-            newNode.hasNext = true;
-            newNode.taken = true;
-
-            node.prev = nodeIndex;
-            node.hasPrev = true;
-            m_Head = nodeIndex;
-            m_Size++;
-            m_FreeSize--;
-            return;
+            const size_t tail = m_Tail.load(std::memory_order_acquire);
+            for (size_t i = m_Head.load(std::memory_order_relaxed); i != tail; i++)
+                m_Data[i & m_Mask].~T();
         }
+        lvn::memDelete<T>(m_Data, 0);
+    }
 
-        /* find an index linearly */
-        for (size_t i = 0; i < m_Capacity; i++)
+    LvnSpscQueue(const LvnSpscQueue&) = delete;
+    LvnSpscQueue& operator=(const LvnSpscQueue&) = delete;
+
+    bool try_push(const T& value)
+    {
+        const size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if (tail - m_CachedHead > m_Mask)
         {
-            if (!m_Nodes[i].taken)
-            {
-                LvnINode<T>& newNode = m_Nodes[i];
-                newNode.value = data;
-                newNode.next = m_Head;
-                newNode.hasNext = true;
-                newNode.taken = true;
-
-                node.prev = i;
-                node.hasPrev = true;
-                m_Head = i;
-                m_Size++;
-                return;
-            }
+            m_CachedHead = m_Head.load(std::memory_order_acquire);
+            if (tail - m_CachedHead > m_Mask) { return false; }
         }
 
-        LVN_CORE_ASSERT(false, "could not find empty node to push front element");
+        new (m_Data + (tail & m_Mask)) T(value);
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return true;
     }
-    void pop_back()
+
+    bool try_pop(T& value)
     {
-        if (!m_Size) { return; }
-        if (m_Size == 1) { destruct_at(m_Nodes[m_Head]); m_Tail = m_Head = 0; m_Size--; return; }
+        const size_t head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_CachedTail)
+        {
+            m_CachedTail = m_Tail.load(std::memory_order_acquire);
+            if (head == m_CachedTail) { return false; }
+        }
 
-        /* push back free node */
-        LVN_CORE_ASSERT(m_FreeSize < m_FreeCapacity, "free nodes array is full");
-        m_FreeNodes[m_FreeSize] = m_Tail;
-        m_FreeSize++;
+        T* slot = m_Data + (head & m_Mask);
+        value = static_cast<T&&>(*slot);
+        slot->~T();
+        m_Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
 
-        /* set prev node to tail */
-        LvnINode<T>& node = m_Nodes[m_Tail];
-        LvnINode<T>& prev = m_Nodes[node.prev];
-        m_Tail = node.prev;
-        prev.next = 0;
-        prev.hasNext = false;
+    size_t capacity() const { return m_Mask + 1; }
+    bool empty() const { return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire); } /* NOTE: only a snapshot when other threads are pushing or popping */
+};
 
-        destruct_at(node);
-        m_Size--;
-    }
-    void pop_front()
+template <typename T>
+class LvnMpmcQueue
+{
+private:
+    struct Cell
     {
-        if (!m_Size) { return; }
-        if (m_Size == 1) { destruct_at(m_Nodes[m_Head]); m_Tail = m_Head = 0; m_Size--; return; }
+        std::atomic<size_t> sequence; /* position the cell is ready for, pos when empty and pos + 1 when it holds the element pushed at pos */
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
 
-        /* push back free node */
-        LVN_CORE_ASSERT(m_FreeSize < m_FreeCapacity, "free nodes array is full");
-        m_FreeNodes[m_FreeSize] = m_Head;
-        m_FreeSize++;
+    Cell* m_Cells;
+    size_t m_Mask;
 
-        /* set next node to head */
-        LvnINode<T>& node = m_Nodes[m_Head];
-        LvnINode<T>& next = m_Nodes[node.next];
-        m_Head = node.next;
-        next.prev = 0;
-        next.hasPrev = false;
+    alignas(LVN_CACHE_LINE_SIZE) std::atomic<size_t> m_EnqueuePos;
+    alignas(LVN_CACHE_LINE_SIZE) std::atomic<size_t> m_DequeuePos;
 
-        destruct_at(node);
-        m_Size--;
+public:
+    /* capacity is rounded up to a power of two */
+    LvnMpmcQueue(size_t capacity)
+        : m_EnqueuePos(0), m_DequeuePos(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        m_Cells = lvn::memNew<Cell>(size, false);
+        for (size_t i = 0; i < size; i++)
+            new (&m_Cells[i].sequence) std::atomic<size_t>(i);
+        m_Mask = size - 1;
     }
-
-    void reserve(size_t size)
+    ~LvnMpmcQueue()
     {
-        if (size <= m_Capacity) { return; }
-        LvnINode<T>* temp = lvn::memNew<LvnINode<T>>(size, false);
-        for (size_t i = 0; i < m_Capacity; i++)
-            new (&temp[i]) LvnINode<T>(m_Nodes[i]);
-        destruct();
-        lvn::memDelete<LvnINode<T>>(m_Nodes, 0);
-        m_Nodes = temp;
-        m_Capacity = size;
-        size_t* freeTemp = lvn::memNew<size_t>(size, false);
-        for (size_t i = 0; i < m_FreeSize; i++)
-            new (&freeTemp[i]) size_t(m_FreeNodes[i]);
-        lvn::memDelete<size_t>(m_FreeNodes, 0);
-        m_FreeNodes = freeTemp;
-        m_FreeCapacity = size;
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            const size_t enqueuePos = m_EnqueuePos.load(std::memory_order_acquire);
+            for (size_t i = m_DequeuePos.load(std::memory_order_relaxed); i != enqueuePos; i++)
+                reinterpret_cast<T*>(m_Cells[i & m_Mask].storage)->~T();
+        }
+        lvn::memDelete<Cell>(m_Cells, 0);
     }
 
-    size_t      size() const { return m_Size; }
-    bool        empty() const { return m_Size == 0; }
-    void        clear() { destruct(); lvn::memDelete<LvnINode<T>>(m_Nodes, 0); m_Size = 0; for (size_t i = 0; i < m_FreeCapacity; i++) m_FreeNodes[i] = i; m_FreeSize = m_FreeCapacity; m_Head = m_Tail = 0; }
-    void        clear_free() { destruct(); lvn::memDelete<LvnINode<T>>(m_Nodes, 0); lvn::memDelete<size_t>(m_FreeNodes, 0); m_Nodes = nullptr; m_FreeNodes = nullptr; m_Head = m_Tail = m_Size = m_Capacity = m_FreeSize = m_FreeCapacity = 0; }
-
-    T&          front() { LVN_CORE_ASSERT(m_Size, "cannot call front on empty list"); return m_Nodes[m_Head].value; }
-    const T&    front() const { LVN_CORE_ASSERT(m_Size, "cannot call front on empty list"); return m_Nodes[m_Head].value; }
-
-    T&          back() { LVN_CORE_ASSERT(m_Size, "cannot call back on empty list"); return m_Nodes[m_Tail].value; }
-    const T&    back() const { LVN_CORE_ASSERT(m_Size, "cannot call back on empty list"); return m_Nodes[m_Tail].value; }
-};
-
+    LvnMpmcQueue(const LvnMpmcQueue&) = delete;
+    LvnMpmcQueue& operator=(const LvnMpmcQueue&) = delete;
 
-// -- LvnQueue
-// ------------------------------------------------------------
-// - simple and light weight replacement to std::queue
-// - LvnQueue is a wrapper around LvnArenaList by default
-// - designed to be more cache effecient based on indexed nodes from a singular allocated array
+    bool try_push(const T& value)
+    {
+        Cell* cell;
+        size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_Cells[pos & m_Mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false; /* full, the cell still holds the element from one lap ago */
+            else
+                pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        }
 
-template <typename T, typename Container = LvnArenaList<T>>
-class LvnQueue
-{
-private:
-    Container m_Container;
+        new (cell->storage) T(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
 
-public:
-    LvnQueue() = default;
-    LvnQueue(const T* data, size_t size)
+    bool try_pop(T& value)
     {
-        m_Container.reserve(size);
-        for (size_t i = 0; i < size; i++)
-            m_Container.push_back(data[i]);
+        Cell* cell;
+        size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_Cells[pos & m_Mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false; /* empty, nothing was pushed at pos yet */
+            else
+                pos = m_DequeuePos.load(std::memory_order_relaxed);
+        }
+
+        T* element = reinterpret_cast<T*>(cell->storage);
+        value = static_cast<T&&>(*element);
+        element->~T();
+        cell->sequence.store(pos + m_Mask + 1, std::memory_order_release);
+        return true;
     }
 
-    size_t      size() const { return m_Container.size(); }
-    bool        empty() const { return m_Container.empty(); }
-    void        push(const T& value) { m_Container.push_back(value); }
-    void        pop() { m_Container.pop_front(); }
-    T&          front() { return m_Container.front(); }
-    const T&    front() const { return m_Container.front(); }
-    T&          back() { return m_Container.back(); }
-    const T&    back() const { return m_Container.back(); }
+    size_t capacity() const { return m_Mask + 1; }
 };
 
 
@@ -3203,22 +4891,38 @@ class LvnHashMap
 {
     static_assert(std::is_integral_v<K>, "cannot have non integral type as key");
     using MoveRef = std::remove_reference_t<T>&&;
+    using Entry = LvnHashEntry<K, T>;
 private:
-    LvnHashEntry<K, T>* m_HashEntries;
+    Entry* m_HashEntries;
     size_t m_Size;
     size_t m_Capacity;
     Hash m_Hasher;
+    const LvnAllocator* m_Allocator; /* allocator the entries are allocated from, the global memory functions are used when nullptr */
 
-    void destruct()
+    /* every entry of the table is constructed, free entries hold a default constructed value */
+    Entry* allocate(size_t capacity)
     {
-        if constexpr (!std::is_trivially_destructible_v<T>)
+        Entry* entries = lvn::allocatorNew<Entry>(m_Allocator, capacity);
+        for (size_t i = 0; i < capacity; i++)
+            new (&entries[i]) Entry();
+        return entries;
+    }
+    void release(Entry* entries, size_t capacity)
+    {
+        if constexpr (!std::is_trivially_destructible_v<Entry>)
         {
-            for (size_t i = 0; i < m_Capacity; i++)
-            {
-                if (m_HashEntries[i].taken)
-                    m_HashEntries[i].data.~T();
-            }
+            for (size_t i = 0; i < capacity; i++)
+                entries[i].~Entry();
         }
+        lvn::allocatorDelete<Entry>(m_Allocator, entries);
+    }
+    void copy_from(const LvnHashMap& other)
+    {
+        m_Size = other.m_Size;
+        m_Capacity = other.m_Capacity;
+        m_HashEntries = lvn::allocatorNew<Entry>(m_Allocator, m_Capacity);
+        for (size_t i = 0; i < m_Capacity; i++)
+            new (&m_HashEntries[i]) Entry(other.m_HashEntries[i]);
     }
     bool erase_recursive(size_t index)
     {
@@ -3238,8 +4942,8 @@ private:
         }
         else /* last entry in chain */
         {
-            if (m_HashEntries[index].taken && !std::is_trivially_destructible_v<T>)
-                m_HashEntries[index].data.~T();
+            if (m_HashEntries[index].taken)
+                m_HashEntries[index].data = T();
             m_HashEntries[index].key = 0;
             m_HashEntries[index].nextIndex = 0;
             m_HashEntries[index].taken = false;
@@ -3252,34 +4956,28 @@ private:
 
 public:
     LvnHashMap()
-        : m_HashEntries(nullptr), m_Size(0), m_Capacity(0) {}
+        : m_HashEntries(nullptr), m_Size(0), m_Capacity(0), m_Allocator(nullptr) {}
     ~LvnHashMap()
     {
-        destruct();
-        lvn::memDelete(m_HashEntries, 0);
+        release(m_HashEntries, m_Capacity);
         m_Size = m_Capacity = 0;
         m_HashEntries = nullptr;
     }
 
     LvnHashMap(size_t size)
-        : m_Size(0)
+        : m_HashEntries(nullptr), m_Size(0), m_Capacity(0), m_Allocator(nullptr)
     {
         reserve(size);
     }
 
     LvnHashMap(const LvnHashMap& other)
+        : m_Allocator(nullptr)
     {
-        m_Size = other.m_Size;
-        m_Capacity = other.m_Capacity;
-        m_HashEntries = lvn::memNew<LvnHashEntry<K, T>>(m_Capacity, false);
-        for (size_t i = 0; i < other.m_Capacity; i++)
-        {
-            if (other.m_HashEntries[i].taken)
-                new (&m_HashEntries[i]) LvnHashEntry<K, T>(other.m_HashEntries[i]);
-        }
+        copy_from(other);
     }
     LvnHashMap(LvnHashMap&& other)
     {
+        m_Allocator = other.m_Allocator;
         m_Size = other.m_Size;
         m_Capacity = other.m_Capacity;
         m_HashEntries = other.m_HashEntries;
@@ -3290,22 +4988,15 @@ public:
     LvnHashMap& operator=(const LvnHashMap& other)
     {
         if (this == &other) return *this;
-        destruct();
-        lvn::memDelete<LvnHashEntry<K, T>>(m_HashEntries, 0);
-        m_Size = other.m_Size;
-        m_Capacity = other.m_Capacity;
-        m_HashEntries = lvn::memNew<LvnHashEntry<K, T>>(other.m_Capacity, false);
-        for (size_t i = 0; i < other.m_Capacity; i++)
-        {
-            if (other.m_HashEntries[i].taken)
-                new (&m_HashEntries[i]) LvnHashEntry<K, T>(other.m_HashEntries[i]);
-        }
+        release(m_HashEntries, m_Capacity);
+        copy_from(other);
         return *this;
     }
     LvnHashMap& operator=(LvnHashMap&& other)
     {
-        destruct();
-        lvn::memDelete<LvnHashEntry<K, T>>(m_HashEntries, 0);
+        if (this == &other) return *this;
+        release(m_HashEntries, m_Capacity);
+        m_Allocator = other.m_Allocator;
         m_Size = other.m_Size;
         m_Capacity = other.m_Capacity;
         m_HashEntries = other.m_HashEntries;
@@ -3329,9 +5020,9 @@ public:
     {
         /* step 1: reserve/allocate memory */
         if (size <= m_Size) return;
-        LvnHashEntry<K, T>* temp = m_HashEntries;
+        Entry* temp = m_HashEntries;
         size_t tempSize = m_Capacity;
-        m_HashEntries = lvn::memNew<LvnHashEntry<K, T>>(size);
+        m_HashEntries = allocate(size);
         m_Capacity = size;
 
         /* step 2: rehash and insert entries into new table */
@@ -3341,8 +5032,7 @@ public:
             if (temp[i].taken)
                 insert(temp[i].key, static_cast<MoveRef>(temp[i].data));
         }
-        destruct();
-        lvn::memDelete<LvnHashEntry<K, T>>(temp, 0);
+        release(temp, tempSize); /* NOTE: the old entries were moved from, only the old table is destroyed */
     }
     void insert(const K& key, const T& value)
     {
@@ -3521,20 +5211,353 @@ public:
             index = entry->nextIndex;
             entry = &m_HashEntries[entry->nextIndex];
 
-            if (entry->key == key)
-                return true;
-        }
+            if (entry->key == key)
+                return true;
+        }
+
+        return false;
+    }
+
+    bool                   empty() { return m_Size == 0; }
+    void                   clear() { if (m_Size) { for (size_t i = 0; i < m_Capacity; i++) { if (m_HashEntries[i].taken) m_HashEntries[i].data = T(); m_HashEntries[i].key = 0; m_HashEntries[i].nextIndex = 0; m_HashEntries[i].taken = false; m_HashEntries[i].hasNext = false; } } m_Size = 0; }
+    void                   clear_free() { release(m_HashEntries, m_Capacity); m_Size = m_Capacity = 0; m_HashEntries = nullptr; }
+    void                   set_allocator(const LvnAllocator* allocator) { LVN_CORE_ASSERT(m_Capacity == 0, "the allocator of a hash map can only be set before it allocates"); m_Allocator = allocator; }
+    const LvnAllocator*    allocator() const { return m_Allocator; }
+    size_t                 size() { return m_Size; }
+    size_t                 capacity() { return m_Capacity; }
+    size_t                 memcap() { return m_Capacity * sizeof(LvnHashEntry<K, T>); }
+    LvnHashEntry<K, T>*    data() { return m_HashEntries; }
+};
+
+
+// -- LvnFlatHashEntry, LvnFlatHashMap
+// ------------------------------------------------------------
+// open addressing variant of LvnHashMap using robin hood hashing with backward shift deletion
+// entries are probed linearly from their home slot and kept sorted by probe distance, so lookups stop early and never follow chains
+// keys can be of any type given a hasher and key equal for them (eg. LvnStringHash and LvnStringEqual for LvnString keys)
+// find, contains and erase also take other key types the hasher and key equal accept, so strings can be looked up without creating a key
+
+struct LvnKeyEqual
+{
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const { return a == b; }
+};
+
+template <typename K, typename T>
+struct LvnFlatHashEntry
+{
+    T data;
+    K key;
+    uint32_t distance; /* probe distance from the home slot plus one, zero for empty slots */
+};
+
+template <typename K, typename T, typename Hash = LvnHash, typename KeyEqual = LvnKeyEqual>
+class LvnFlatHashMap
+{
+    using MoveRef = std::remove_reference_t<T>&&;
+    using KeyMoveRef = std::remove_reference_t<K>&&;
+    using Entry = LvnFlatHashEntry<K, T>;
+private:
+    Entry* m_HashEntries;
+    size_t m_Size;
+    size_t m_Capacity; /* always a power of two so the home slot is found with a mask */
+    Hash m_Hasher;
+    KeyEqual m_KeyEqual;
+    const LvnAllocator* m_Allocator; /* allocator the entries are allocated from, the global memory functions are used when nullptr */
+
+    Entry* allocate(size_t capacity)
+    {
+        /* data and keys are only constructed for taken slots */
+        Entry* entries = lvn::allocatorNew<Entry>(m_Allocator, capacity);
+        for (size_t i = 0; i < capacity; i++)
+            entries[i].distance = 0;
+        return entries;
+    }
+    static void destroy_entry(Entry& entry)
+    {
+        entry.data.~T();
+        entry.key.~K();
+        entry.distance = 0;
+    }
+    void destruct()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T> || !std::is_trivially_destructible_v<K>)
+        {
+            for (size_t i = 0; i < m_Capacity; i++)
+            {
+                if (m_HashEntries[i].distance)
+                    destroy_entry(m_HashEntries[i]);
+            }
+        }
+    }
+    void copy_from(const LvnFlatHashMap& other)
+    {
+        /* same capacity and hash so every entry keeps its slot */
+        m_Size = other.m_Size;
+        m_Capacity = other.m_Capacity;
+        m_HashEntries = m_Capacity ? allocate(m_Capacity) : nullptr;
+        for (size_t i = 0; i < m_Capacity; i++)
+        {
+            if (other.m_HashEntries[i].distance)
+            {
+                new (&m_HashEntries[i].data) T(other.m_HashEntries[i].data);
+                new (&m_HashEntries[i].key) K(other.m_HashEntries[i].key);
+                m_HashEntries[i].distance = other.m_HashEntries[i].distance;
+            }
+        }
+    }
+    template <typename U>
+    size_t find_index(const U& key) const
+    {
+        if (m_Size == 0) return m_Capacity;
+
+        size_t mask = m_Capacity - 1;
+        size_t index = m_Hasher.operator()(key) & mask;
+        for (uint32_t distance = 1; ; distance++)
+        {
+            /* a key is never stored past an entry that is closer to its own home slot */
+            const Entry& entry = m_HashEntries[index];
+            if (entry.distance < distance)
+                return m_Capacity;
+            if (m_KeyEqual(entry.key, key))
+                return index;
+
+            index = (index + 1) & mask;
+        }
+    }
+    void grow()
+    {
+        /* resize/rehash when size exceeds 85% capacity, robin hood keeps probes short at high load */
+        if ((m_Size + 1) * 20 > m_Capacity * 17)
+            reserve(m_Capacity ? m_Capacity * 2 : 8);
+    }
+    /* inserts a key that is not in the table, entries closer to their home slot are displaced further along */
+    T& emplace_new(K&& key, T&& value)
+    {
+        size_t mask = m_Capacity - 1;
+        size_t index = m_Hasher.operator()(key) & mask;
+        size_t result = m_Capacity;
+        uint32_t distance = 1;
+        K carryKey(static_cast<KeyMoveRef>(key));
+        T carry(static_cast<MoveRef>(value));
+
+        while (true)
+        {
+            Entry& entry = m_HashEntries[index];
+            if (entry.distance == 0)
+            {
+                new (&entry.data) T(static_cast<MoveRef>(carry));
+                new (&entry.key) K(static_cast<KeyMoveRef>(carryKey));
+                entry.distance = distance;
+                if (result == m_Capacity) result = index;
+                break;
+            }
+
+            if (entry.distance < distance)
+            {
+                T temp(static_cast<MoveRef>(entry.data));
+                entry.data = static_cast<MoveRef>(carry);
+                carry = static_cast<MoveRef>(temp);
+
+                K tempKey(static_cast<KeyMoveRef>(entry.key));
+                entry.key = static_cast<KeyMoveRef>(carryKey);
+                carryKey = static_cast<KeyMoveRef>(tempKey);
+
+                uint32_t tempDistance = entry.distance;
+                entry.distance = distance;
+                distance = tempDistance;
+
+                if (result == m_Capacity) result = index;
+            }
+
+            index = (index + 1) & mask;
+            distance++;
+        }
+
+        m_Size++;
+        return m_HashEntries[result].data;
+    }
+
+public:
+    LvnFlatHashMap()
+        : m_HashEntries(nullptr), m_Size(0), m_Capacity(0), m_Allocator(nullptr) {}
+    ~LvnFlatHashMap()
+    {
+        destruct();
+        lvn::allocatorDelete<Entry>(m_Allocator, m_HashEntries);
+        m_Size = m_Capacity = 0;
+        m_HashEntries = nullptr;
+    }
+
+    LvnFlatHashMap(size_t size)
+        : m_HashEntries(nullptr), m_Size(0), m_Capacity(0), m_Allocator(nullptr)
+    {
+        reserve(size);
+    }
+
+    LvnFlatHashMap(const LvnFlatHashMap& other)
+        : m_Allocator(nullptr)
+    {
+        copy_from(other);
+    }
+    LvnFlatHashMap(LvnFlatHashMap&& other)
+    {
+        m_Allocator = other.m_Allocator;
+        m_Size = other.m_Size;
+        m_Capacity = other.m_Capacity;
+        m_HashEntries = other.m_HashEntries;
+        other.m_Size = 0;
+        other.m_Capacity = 0;
+        other.m_HashEntries = nullptr;
+    }
+    LvnFlatHashMap& operator=(const LvnFlatHashMap& other)
+    {
+        if (this == &other) return *this;
+        destruct();
+        lvn::allocatorDelete<Entry>(m_Allocator, m_HashEntries);
+        copy_from(other);
+        return *this;
+    }
+    LvnFlatHashMap& operator=(LvnFlatHashMap&& other)
+    {
+        if (this == &other) return *this;
+        destruct();
+        lvn::allocatorDelete<Entry>(m_Allocator, m_HashEntries);
+        m_Allocator = other.m_Allocator;
+        m_Size = other.m_Size;
+        m_Capacity = other.m_Capacity;
+        m_HashEntries = other.m_HashEntries;
+        other.m_Size = 0;
+        other.m_Capacity = 0;
+        other.m_HashEntries = nullptr;
+        return *this;
+    }
+
+    T& operator[](const K& key)
+    {
+        return at(key);
+    }
+    const T& operator[](const K& key) const
+    {
+        return at(key);
+    }
+
+    /* reserves new memory space and rehashes entries, capacity is rounded up to a power of two */
+    void reserve(size_t size)
+    {
+        size_t capacity = 8;
+        while (capacity < size) capacity <<= 1;
+        if (capacity <= m_Capacity) return;
+
+        Entry* temp = m_HashEntries;
+        size_t tempCapacity = m_Capacity;
+        m_HashEntries = allocate(capacity);
+        m_Capacity = capacity;
+
+        m_Size = 0;
+        for (size_t i = 0; i < tempCapacity; i++)
+        {
+            if (temp[i].distance)
+            {
+                emplace_new(static_cast<KeyMoveRef>(temp[i].key), static_cast<MoveRef>(temp[i].data));
+                destroy_entry(temp[i]);
+            }
+        }
+        lvn::allocatorDelete<Entry>(m_Allocator, temp);
+    }
+    void insert(const K& key, const T& value)
+    {
+        size_t index = find_index(key);
+        if (index != m_Capacity)
+        {
+            m_HashEntries[index].data = value;
+            return;
+        }
+
+        grow();
+        emplace_new(K(key), T(value));
+    }
+    void insert(const K& key, T&& value)
+    {
+        size_t index = find_index(key);
+        if (index != m_Capacity)
+        {
+            m_HashEntries[index].data = static_cast<MoveRef>(value);
+            return;
+        }
+
+        grow();
+        emplace_new(K(key), static_cast<MoveRef>(value));
+    }
+    template <typename U>
+    void erase(const U& key)
+    {
+        size_t index = find_index(key);
+        if (index == m_Capacity) return;
+
+        destroy_entry(m_HashEntries[index]);
+
+        /* shift the following entries back a slot until reaching an empty slot or an entry already in its home slot */
+        size_t mask = m_Capacity - 1;
+        size_t next = (index + 1) & mask;
+        while (m_HashEntries[next].distance > 1)
+        {
+            new (&m_HashEntries[index].data) T(static_cast<MoveRef>(m_HashEntries[next].data));
+            new (&m_HashEntries[index].key) K(static_cast<KeyMoveRef>(m_HashEntries[next].key));
+            m_HashEntries[index].distance = m_HashEntries[next].distance - 1;
+            destroy_entry(m_HashEntries[next]);
+
+            index = next;
+            next = (next + 1) & mask;
+        }
+
+        m_Size--;
+    }
+    T& at(const K& key)
+    {
+        size_t index = find_index(key);
+        if (index != m_Capacity)
+            return m_HashEntries[index].data;
+
+        /* if key not found, create new entry */
+        grow();
+        return emplace_new(K(key), T{});
+    }
+    const T& at(const K& key) const
+    {
+        size_t index = find_index(key);
+        LVN_CORE_ASSERT(index != m_Capacity, "key not found within hash map, const hash maps cannot insert new entries");
+        return m_HashEntries[index].data;
+    }
 
-        return false;
+    /* returns a pointer to the data of the key, nullptr if the key is not in the map */
+    template <typename U>
+    T* find(const U& key)
+    {
+        size_t index = find_index(key);
+        return index != m_Capacity ? &m_HashEntries[index].data : nullptr;
+    }
+    template <typename U>
+    const T* find(const U& key) const
+    {
+        size_t index = find_index(key);
+        return index != m_Capacity ? &m_HashEntries[index].data : nullptr;
+    }
+    template <typename U>
+    bool contains(const U& key) const
+    {
+        return find_index(key) != m_Capacity;
     }
 
-    bool                   empty() { return m_Size == 0; }
-    void                   clear() { if (m_Size) { destruct(); } m_Size = 0; }
-    void                   clear_free() { lvn::memDelete<LvnHashEntry<K, T>>(m_HashEntries, m_Capacity); m_Size = m_Capacity = 0; m_HashEntries = nullptr; }
-    size_t                 size() { return m_Size; }
-    size_t                 capacity() { return m_Capacity; }
-    size_t                 memcap() { return m_Capacity * sizeof(LvnHashEntry<K, T>); }
-    LvnHashEntry<K, T>*    data() { return m_HashEntries; }
+    bool                   empty() const { return m_Size == 0; }
+    void                   clear() { if (m_Size) { destruct(); for (size_t i = 0; i < m_Capacity; i++) { m_HashEntries[i].distance = 0; } } m_Size = 0; }
+    void                   clear_free() { destruct(); lvn::allocatorDelete<Entry>(m_Allocator, m_HashEntries); m_Size = m_Capacity = 0; m_HashEntries = nullptr; }
+    void                   set_allocator(const LvnAllocator* allocator) { LVN_CORE_ASSERT(m_Capacity == 0, "the allocator of a hash map can only be set before it allocates"); m_Allocator = allocator; }
+    const LvnAllocator*    allocator() const { return m_Allocator; }
+    size_t                 size() const { return m_Size; }
+    size_t                 capacity() const { return m_Capacity; }
+    size_t                 memcap() const { return m_Capacity * sizeof(Entry); }
+    Entry*                 data() { return m_HashEntries; }
 };
 
 
@@ -3597,23 +5620,37 @@ public:
 // - simple and light weight replacement to std::string
 // - used for functions or struct data types that need to use or return stored string types
 // - this is meant to be a temporary object on client side, convert LvnString to std::string when possible
+// - strings shorter than LocalCapacity characters are stored inline and do not allocate
+// - set_allocator() makes longer strings allocate from an LvnAllocator instead of the global memory functions, copies allocate from the global memory functions again
 
 class LvnString
 {
+public:
+    static const size_t npos = -1;
+    static const size_t LocalCapacity = 24; /* bytes of inline storage including the null terminator */
+
 private:
-    char* m_Data;
+    char* m_Data;       /* points to m_Local while the string fits inline */
     size_t m_Size;
-    size_t m_Capacity;
+    size_t m_Capacity;  /* bytes available at m_Data including the null terminator */
+    const LvnAllocator* m_Allocator; /* allocator long strings are allocated from, the global memory functions are used when nullptr */
+    char m_Local[LocalCapacity];
 
-public:
-    static const size_t npos = -1;
+    bool is_local() const { return m_Data == m_Local; }
+    char* allocate(size_t size);
+    void deallocate();
+    void assign(const char* data, size_t size);
+    void move_from(LvnString& other);
 
+public:
     LvnString();
     ~LvnString();
     LvnString(const char* str);
     LvnString(const char* data, size_t size);
     LvnString(const LvnString& other);
+    LvnString(LvnString&& other);
     LvnString& operator=(const LvnString& other);
+    LvnString& operator=(LvnString&& other);
 
     char& operator [](size_t index);
     const char& operator [](size_t index) const;
@@ -3665,6 +5702,8 @@ public:
     void           resize(size_t size);
     void           clear();
     void           clear_free();
+    void           set_allocator(const LvnAllocator* allocator);
+    const LvnAllocator* allocator() const { return m_Allocator; }
     void           erase(const char* it);
     void           erase_index(size_t index);
     void           push_back(const char& ch);
@@ -3702,68 +5741,186 @@ public:
 };
 LvnString operator+(const char* str, const LvnString& other);
 
+// -- LvnStringView, LvnStringHash, LvnStringEqual
+// ------------------------------------------------------------
+// - non owning view of a range of characters, converts implicitly from LvnString and null terminated strings
+// - LvnStringHash and LvnStringEqual take string views so LvnFlatHashMap<LvnString, T, LvnStringHash, LvnStringEqual> can be looked up by const char* or LvnStringView without creating an LvnString
+
+struct LvnStringView
+{
+    const char* data;
+    size_t size;
+
+    LvnStringView() : data(nullptr), size(0) {}
+    LvnStringView(const char* str) : data(str), size(str ? strlen(str) : 0) {}
+    LvnStringView(const char* str, size_t length) : data(str), size(length) {}
+    LvnStringView(const LvnString& str) : data(str.c_str()), size(str.size()) {}
+
+    bool operator==(const LvnStringView& other) const { return size == other.size && (size == 0 || memcmp(data, other.data, size) == 0); }
+    bool operator!=(const LvnStringView& other) const { return !(*this == other); }
+};
+
+struct LvnStringHash
+{
+    /* mixes 8 bytes per step then finalizes with splitmix64 */
+    size_t operator()(LvnStringView str) const
+    {
+        uint64_t h = 0x243F6A8885A308D3 ^ (static_cast<uint64_t>(str.size) * 0x9E3779B97F4A7C15);
+        const char* p = str.data;
+        size_t n = str.size;
+
+        while (n >= 8)
+        {
+            uint64_t word;
+            memcpy(&word, p, 8);
+            h ^= word * 0xBF58476D1CE4E5B9;
+            h = ((h << 31) | (h >> 33)) * 0x94D049BB133111EB;
+            p += 8;
+            n -= 8;
+        }
+
+        if (n)
+        {
+            uint64_t word = 0;
+            memcpy(&word, p, n);
+            h ^= word * 0xBF58476D1CE4E5B9;
+        }
+
+        return LvnHash{}(static_cast<size_t>(h));
+    }
+};
+
+struct LvnStringEqual
+{
+    bool operator()(LvnStringView a, LvnStringView b) const { return a == b; }
+};
+
 template<typename T>
 class LvnData
 {
 private:
     T* m_Data;
     size_t m_Size;
+    LvnMemFreeFunc m_FreeFunc;  /* frees adopted data, nullptr for data allocated with lvn::memNew */
+    void* m_FreeUserData;
+    bool m_Adopted;             /* data was not allocated by this LvnData, it is freed with m_FreeFunc or not at all for views */
 
-public:
-    LvnData()
-        : m_Data(nullptr), m_Size(0) {}
-
-    ~LvnData()
+    void free_data()
     {
-        delete [] m_Data;
+        if (!m_Adopted)
+            lvn::memDelete<T>(m_Data, m_Size);
+        else if (m_FreeFunc != nullptr && m_Data != nullptr)
+            m_FreeFunc(m_Data, m_FreeUserData);
     }
 
-    LvnData(const T* data, size_t size)
+    void copy_from(const T* data, size_t size)
     {
         m_Size = size;
         m_Data = lvn::memNew<T>(size, false);
+        m_FreeFunc = nullptr;
+        m_FreeUserData = nullptr;
+        m_Adopted = false;
 
         for (size_t i = 0; i < size; i++)
             new (&m_Data[i]) T(data[i]);
     }
-    LvnData(const LvnData<T>& other)
+
+    void take(LvnData<T>& other)
     {
+        m_Data = other.m_Data;
         m_Size = other.m_Size;
-        m_Data = lvn::memNew<T>(other.m_Size, false);
+        m_FreeFunc = other.m_FreeFunc;
+        m_FreeUserData = other.m_FreeUserData;
+        m_Adopted = other.m_Adopted;
+        other.m_Data = nullptr;
+        other.m_Size = 0;
+        other.m_FreeFunc = nullptr;
+        other.m_Adopted = false;
+    }
 
-        for (size_t i = 0; i < other.m_Size; i++)
-            new (&m_Data[i]) T(other.m_Data[i]);
+public:
+    LvnData()
+        : m_Data(nullptr), m_Size(0), m_FreeFunc(nullptr), m_FreeUserData(nullptr), m_Adopted(false) {}
+
+    ~LvnData()
+    {
+        free_data();
+    }
+
+    /* allocates size value initialized elements to be written through data() */
+    explicit LvnData(size_t size)
+        : m_Size(size), m_FreeFunc(nullptr), m_FreeUserData(nullptr), m_Adopted(false)
+    {
+        m_Data = lvn::memNew<T>(size);
+    }
+    LvnData(const T* data, size_t size)
+    {
+        copy_from(data, size);
+    }
+    /* takes ownership of constructed elements allocated outside of lvn::memNew (eg. by stb_image), freeFunc is called with data and userData when they are freed */
+    LvnData(T* data, size_t size, LvnMemFreeFunc freeFunc, void* userData = nullptr)
+        : m_Data(data), m_Size(size), m_FreeFunc(freeFunc), m_FreeUserData(userData), m_Adopted(true)
+    {
+        LVN_CORE_ASSERT(freeFunc != nullptr, "free function for adopted data cannot be nullptr, use LvnData::view for data that is not owned");
+    }
+    /* takes the elements of vector without copying them when it allocates from the global memory functions */
+    LvnData(LvnVector<T>&& vector)
+        : m_FreeFunc(nullptr), m_FreeUserData(nullptr), m_Adopted(false)
+    {
+        if (vector.allocator() != nullptr)
+        {
+            copy_from(vector.data(), vector.size());
+            return;
+        }
+        m_Size = vector.size();
+        m_Data = vector.release();
+    }
+    LvnData(const LvnData<T>& other)
+    {
+        copy_from(other.m_Data, other.m_Size);
     }
     LvnData(LvnData<T>&& other)
     {
-        m_Size = other.m_Size;
-        m_Data = other.m_Data;
-        other.m_Size = 0;
-        other.m_Data = nullptr;
+        take(other);
     }
     LvnData<T>& operator=(const LvnData<T>& other)
     {
         if (this == &other) return *this;
-        lvn::memDelete<T>(m_Data, m_Size);
-        m_Size = other.m_Size;
-        m_Data = lvn::memNew<T>(other.m_Size, false);
-
-        for (size_t i = 0; i < other.m_Size; i++)
-            new (&m_Data[i]) T(other.m_Data[i]);
-
+        free_data();
+        copy_from(other.m_Data, other.m_Size);
         return *this;
     }
     LvnData<T>& operator=(LvnData<T>&& other)
     {
         if (this == &other) return *this;
-        lvn::memDelete<T>(m_Data, m_Size);
-        m_Size = other.m_Size;
-        m_Data = other.m_Data;
-        other.m_Size = 0;
-        other.m_Data = nullptr;
+        free_data();
+        take(other);
         return *this;
     }
 
+    /* borrows data without copying or freeing it, data must outlive the view, copies of a view own their elements */
+    static LvnData<T> view(const T* data, size_t size)
+    {
+        LvnData<T> result;
+        result.m_Data = const_cast<T*>(data);
+        result.m_Size = size;
+        result.m_Adopted = true;
+        return result;
+    }
+
+    /* gives up ownership of the elements, the caller frees them with lvn::memDelete or with the free function they were adopted with, views return their borrowed data */
+    T* release()
+    {
+        T* data = m_Data;
+        m_Data = nullptr;
+        m_Size = 0;
+        m_FreeFunc = nullptr;
+        m_Adopted = false;
+        return data;
+    }
+
+    bool              owns_data() const { return !m_Adopted || m_FreeFunc != nullptr; }
+
     T& operator[](size_t i)
     {
         LVN_CORE_ASSERT(i < m_Size, "element index out of range");
@@ -3802,6 +5959,21 @@ private:
     int64_t m_Start, m_Current;
 };
 
+// records a profiling zone from construction to destruction, use through LVN_PROFILE_SCOPE
+class LvnProfileScope
+{
+public:
+    LvnProfileScope(const char* name) : m_Name(name), m_Start(lvn::i_ProfileEnabled.load(std::memory_order_relaxed) ? lvn::profileGetTicks() : 0) {}
+    ~LvnProfileScope() { if (m_Start != 0) { lvn::profileRecordZone(m_Name, m_Start, lvn::profileGetTicks()); } }
+
+    LvnProfileScope(const LvnProfileScope&) = delete;
+    LvnProfileScope& operator=(const LvnProfileScope&) = delete;
+
+private:
+    const char* m_Name;
+    uint64_t m_Start;                                            /* 0 when recording was disabled as the zone began */
+};
+
 class LvnThread
 {
 private:
@@ -3860,6 +6032,168 @@ public:
     void unlock() { m_Mutex.unlock(); }
 };
 
+// lock for very short critical sections, waiting threads spin and then yield instead of sleeping in the os
+class LvnSpinLock
+{
+private:
+    std::atomic<bool> m_Locked;
+
+    void wait_unlocked();
+
+public:
+    LvnSpinLock() : m_Locked(false) {}
+
+    LvnSpinLock(const LvnSpinLock&) = delete;
+    LvnSpinLock& operator=(const LvnSpinLock&) = delete;
+
+    void lock() { while (m_Locked.exchange(true, std::memory_order_acquire)) wait_unlocked(); }
+    bool try_lock() { return !m_Locked.load(std::memory_order_relaxed) && !m_Locked.exchange(true, std::memory_order_acquire); }
+    void unlock() { m_Locked.store(false, std::memory_order_release); }
+};
+
+class LvnSpinLockGaurd
+{
+private:
+    LvnSpinLock& m_Lock;
+
+public:
+    LvnSpinLockGaurd(LvnSpinLock& lock) : m_Lock(lock) { m_Lock.lock(); }
+    ~LvnSpinLockGaurd() { m_Lock.unlock(); }
+
+    LvnSpinLockGaurd(const LvnSpinLockGaurd&) = delete;
+    LvnSpinLockGaurd& operator=(const LvnSpinLockGaurd&) = delete;
+};
+
+// reader/writer lock, any number of threads can hold the shared lock while no thread holds the exclusive lock
+class LvnSharedMutex
+{
+private:
+    static constexpr uint16_t m_SharedMutexBuffSize = 64;
+    LVN_TYPE_BUFF(m_SharedMutexBuff, m_SharedMutexBuffSize);
+
+public:
+    LvnSharedMutex();
+    ~LvnSharedMutex();
+
+    LvnSharedMutex(const LvnSharedMutex&) = delete;
+    LvnSharedMutex& operator=(const LvnSharedMutex&) = delete;
+
+    void lock();
+    bool try_lock();
+    void unlock();
+    void lock_shared();
+    bool try_lock_shared();
+    void unlock_shared();
+};
+
+class LvnSharedLockGaurd
+{
+private:
+    LvnSharedMutex& m_Mutex;
+
+public:
+    LvnSharedLockGaurd(LvnSharedMutex& mutex) : m_Mutex(mutex) { m_Mutex.lock_shared(); }
+    ~LvnSharedLockGaurd() { m_Mutex.unlock_shared(); }
+
+    LvnSharedLockGaurd(const LvnSharedLockGaurd&) = delete;
+    LvnSharedLockGaurd& operator=(const LvnSharedLockGaurd&) = delete;
+};
+
+class LvnWriteLockGaurd
+{
+private:
+    LvnSharedMutex& m_Mutex;
+
+public:
+    LvnWriteLockGaurd(LvnSharedMutex& mutex) : m_Mutex(mutex) { m_Mutex.lock(); }
+    ~LvnWriteLockGaurd() { m_Mutex.unlock(); }
+
+    LvnWriteLockGaurd(const LvnWriteLockGaurd&) = delete;
+    LvnWriteLockGaurd& operator=(const LvnWriteLockGaurd&) = delete;
+};
+
+// condition variable waited on with a locked LvnMutex, the mutex is unlocked while waiting and locked again before a wait returns
+class LvnCondVar
+{
+private:
+    static constexpr uint16_t m_CondVarBuffSize = 128;
+    LVN_TYPE_BUFF(m_CondVarBuff, m_CondVarBuffSize);
+
+public:
+    LvnCondVar();
+    ~LvnCondVar();
+
+    LvnCondVar(const LvnCondVar&) = delete;
+    LvnCondVar& operator=(const LvnCondVar&) = delete;
+
+    void wait(LvnMutex& mutex);
+    bool wait_for(LvnMutex& mutex, uint64_t milliseconds); /* returns false when the wait timed out */
+    void notify_one();
+    void notify_all();
+
+    /* waits are allowed to wake spuriously, this overload waits until pred returns true */
+    template <typename Pred>
+    void wait(LvnMutex& mutex, Pred pred)
+    {
+        while (!pred())
+            wait(mutex);
+    }
+};
+
+// atomic value for counters and flags shared between threads, the memory order defaults to sequentially consistent like std::atomic
+template <typename T>
+class LvnAtomic
+{
+private:
+    std::atomic<T> m_Value;
+
+public:
+    LvnAtomic() : m_Value(T()) {}
+    LvnAtomic(T value) : m_Value(value) {}
+
+    LvnAtomic(const LvnAtomic&) = delete;
+    LvnAtomic& operator=(const LvnAtomic&) = delete;
+
+    LvnAtomic& operator=(T value) { m_Value.store(value); return *this; }
+    operator T() const { return m_Value.load(); }
+
+    T load(std::memory_order order = std::memory_order_seq_cst) const { return m_Value.load(order); }
+    void store(T value, std::memory_order order = std::memory_order_seq_cst) { m_Value.store(value, order); }
+    T exchange(T value, std::memory_order order = std::memory_order_seq_cst) { return m_Value.exchange(value, order); }
+    bool compare_exchange(T& expected, T desired, std::memory_order order = std::memory_order_seq_cst) { return m_Value.compare_exchange_strong(expected, desired, order); } /* expected is set to the current value when the exchange fails */
+
+    /* integral types only */
+    T fetch_add(T value, std::memory_order order = std::memory_order_seq_cst) { return m_Value.fetch_add(value, order); }
+    T fetch_sub(T value, std::memory_order order = std::memory_order_seq_cst) { return m_Value.fetch_sub(value, order); }
+    T increment(std::memory_order order = std::memory_order_seq_cst) { return m_Value.fetch_add(1, order) + 1; } /* returns the new value */
+    T decrement(std::memory_order order = std::memory_order_seq_cst) { return m_Value.fetch_sub(1, order) - 1; }
+};
+
+// tags the allocations made on the calling thread with a category until the scope ends, does nothing when memory tracking is disabled
+class LvnMemoryScope
+{
+#ifdef LVN_MEMORY_TRACKING
+private:
+    LvnMemoryCategory m_Previous;
+
+public:
+    LvnMemoryScope(LvnMemoryCategory category) : m_Previous(lvn::memSetCategory(category)) {}
+    ~LvnMemoryScope() { lvn::memSetCategory(m_Previous); }
+#else
+public:
+    LvnMemoryScope(LvnMemoryCategory) {}
+#endif
+
+    LvnMemoryScope(const LvnMemoryScope&) = delete;
+    LvnMemoryScope& operator=(const LvnMemoryScope&) = delete;
+};
+
+// number of unfinished jobs submitted with it, must outlive the jobs it counts
+struct LvnJobCounter
+{
+    std::atomic<uint32_t> count{0};
+};
+
 struct LvnDrawCommand
 {
     void* pVertices;
@@ -3867,19 +6201,49 @@ struct LvnDrawCommand
     uint64_t vertexCount;
     uint64_t indexCount;
     uint64_t vertexStride;
+    uint64_t sortKey;                         // user defined key kept with the command, the draw list does not sort by it
 };
 
+// range of a pushed command within the merged vertex and index data
+struct LvnDrawListCommand
+{
+    uint64_t sortKey;
+    uint64_t firstVertex;
+    uint64_t vertexCount;
+    uint64_t firstIndex;
+    uint64_t indexCount;
+};
+
+struct LvnDrawListShard;
+
+// draw commands can be pushed from multiple threads at once, each thread writes into its own shard
+// call merge() after all threads have finished pushing to combine the shards before reading the vertex and index data
 class LvnDrawList
 {
 private:
     LvnVector<uint8_t> m_VerticesRaw;
     LvnVector<uint32_t> m_Indices;
+    LvnVector<LvnDrawListCommand> m_Commands;
     size_t m_VertexCount;
 
+    LvnVector<LvnDrawListShard*> m_Shards;
+    LvnMutex m_ShardMutex;
+    uint64_t m_Id;
+
+    LvnDrawListShard* get_shard();
+
 public:
+    LvnDrawList();
+    ~LvnDrawList();
+
+    LvnDrawList(const LvnDrawList& other);
+    LvnDrawList& operator=(const LvnDrawList& other);
+
     void push_back(const LvnDrawCommand& drawCmd);
+    void merge();
+    void swap(LvnDrawList& other); /* exchanges the commands and shards of both lists, no thread may push to either list meanwhile */
 
-    void clear()                              { m_VerticesRaw.clear(); m_Indices.clear(); m_VertexCount = 0; }
+    void clear();
     bool empty()                              { return m_VerticesRaw.empty() && m_Indices.empty(); }
 
     void* vertices()                          { return m_VerticesRaw.data(); }
@@ -3891,6 +6255,60 @@ public:
     const uint32_t* indices() const           { return m_Indices.data(); }
     size_t index_count()                      { return m_Indices.size(); }
     size_t index_size()                       { return m_Indices.size() * sizeof(uint32_t); }
+
+    const LvnDrawListCommand* commands() const { return m_Commands.data(); }
+    size_t command_count()                    { return m_Commands.size(); }
+};
+
+// draw list of a single vertex type, the stride is sizeof(V) so commands cannot be pushed with a mismatched vertex size
+template <typename V>
+class LvnTypedDrawList
+{
+    static_assert(std::is_trivially_copyable_v<V>, "draw list vertices are copied as bytes and must be trivially copyable");
+
+private:
+    LvnDrawList m_List;
+
+public:
+    static constexpr uint64_t vertex_stride() { return sizeof(V); }
+
+    void push_back(const V* pVertices, uint64_t vertexCount, const uint32_t* pIndices, uint64_t indexCount, uint64_t sortKey = 0)
+    {
+        LvnDrawCommand drawCmd{};
+        drawCmd.pVertices = const_cast<V*>(pVertices);
+        drawCmd.vertexCount = vertexCount;
+        drawCmd.pIndices = const_cast<uint32_t*>(pIndices);
+        drawCmd.indexCount = indexCount;
+        drawCmd.vertexStride = sizeof(V);
+        drawCmd.sortKey = sortKey;
+        m_List.push_back(drawCmd);
+    }
+    template <size_t VertexCount, size_t IndexCount>
+    void push_back(const V (&vertices)[VertexCount], const uint32_t (&indices)[IndexCount], uint64_t sortKey = 0)
+    {
+        push_back(vertices, VertexCount, indices, IndexCount, sortKey);
+    }
+
+    void merge()                              { m_List.merge(); }
+    void swap(LvnTypedDrawList& other)        { m_List.swap(other.m_List); }
+    void clear()                              { m_List.clear(); }
+    bool empty()                              { return m_List.empty(); }
+
+    V* vertices()                             { return static_cast<V*>(m_List.vertices()); }
+    const V* vertices() const                 { return static_cast<const V*>(m_List.vertices()); }
+    size_t vertex_count()                     { return m_List.vertex_count(); }
+    size_t vertex_size()                      { return m_List.vertex_size(); }
+
+    uint32_t* indices()                       { return m_List.indices(); }
+    const uint32_t* indices() const           { return m_List.indices(); }
+    size_t index_count()                      { return m_List.index_count(); }
+    size_t index_size()                       { return m_List.index_size(); }
+
+    const LvnDrawListCommand* commands() const { return m_List.commands(); }
+    size_t command_count()                    { return m_List.command_count(); }
+
+    LvnDrawList& list()                       { return m_List; }
+    const LvnDrawList& list() const           { return m_List; }
 };
 
 
@@ -4250,7 +6668,7 @@ struct LvnVec<4, T>
     LvnVec() = default;
     LvnVec(const LvnVec<4, T>&) = default;
     LvnVec(const T& n)
-        : x(n), y(n), z(n) {}
+        : x(n), y(n), z(n), w(n) {}
     LvnVec(const T& nx, const T& ny, const T& nz, const T& nw)
         : x(nx), y(ny), z(nz), w(nw) {}
     LvnVec(const LvnVec<2, T>& v1, LvnVec<2, T>& v2)
@@ -4295,6 +6713,13 @@ struct LvnVec<4, T>
 
     LvnVec<4, T>& operator+=(const LvnVec<4, T>& v)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            lvn::simdStore(&this->x, lvn::simdAdd(lvn::simdLoad(&this->x), lvn::simdLoad(&v.x)));
+            return *this;
+        }
+#endif
         this->x += v.x;
         this->y += v.y;
         this->z += v.z;
@@ -4303,6 +6728,13 @@ struct LvnVec<4, T>
     }
     LvnVec<4, T>& operator-=(const LvnVec<4, T>& v)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            lvn::simdStore(&this->x, lvn::simdSub(lvn::simdLoad(&this->x), lvn::simdLoad(&v.x)));
+            return *this;
+        }
+#endif
         this->x -= v.x;
         this->y -= v.y;
         this->z -= v.z;
@@ -4311,6 +6743,13 @@ struct LvnVec<4, T>
     }
     LvnVec<4, T>& operator*=(const LvnVec<4, T>& v)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            lvn::simdStore(&this->x, lvn::simdMul(lvn::simdLoad(&this->x), lvn::simdLoad(&v.x)));
+            return *this;
+        }
+#endif
         this->x *= v.x;
         this->y *= v.y;
         this->z *= v.z;
@@ -4319,10 +6758,17 @@ struct LvnVec<4, T>
     }
     LvnVec<4, T>& operator/=(const LvnVec<4, T>& v)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            lvn::simdStore(&this->x, lvn::simdDiv(lvn::simdLoad(&this->x), lvn::simdLoad(&v.x)));
+            return *this;
+        }
+#endif
         this->x /= v.x;
         this->y /= v.y;
         this->z /= v.z;
-        this->w *= v.w;
+        this->w /= v.w;
         return *this;
     }
     LvnVec<4, T>& operator++()
@@ -4366,21 +6812,53 @@ struct LvnVec<4, T>
 template <typename T>
 LvnVec<4, T> operator+(const LvnVec<4, T>& v1, const LvnVec<4, T>& v2)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdStore(&result.x, lvn::simdAdd(lvn::simdLoad(&v1.x), lvn::simdLoad(&v2.x)));
+        return result;
+    }
+#endif
     return LvnVec<4, T>(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w);
 }
 template <typename T>
 LvnVec<4, T> operator-(const LvnVec<4, T>& v1, const LvnVec<4, T>& v2)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdStore(&result.x, lvn::simdSub(lvn::simdLoad(&v1.x), lvn::simdLoad(&v2.x)));
+        return result;
+    }
+#endif
     return LvnVec<4, T>(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.w - v2.w);
 }
 template <typename T>
 LvnVec<4, T> operator*(const LvnVec<4, T>& v1, const LvnVec<4, T>& v2)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdStore(&result.x, lvn::simdMul(lvn::simdLoad(&v1.x), lvn::simdLoad(&v2.x)));
+        return result;
+    }
+#endif
     return LvnVec<4, T>(v1.x * v2.x, v1.y * v2.y, v1.z * v2.z, v1.w * v2.w);
 }
 template <typename T>
 LvnVec<4, T> operator/(const LvnVec<4, T>& v1, const LvnVec<4, T>& v2)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdStore(&result.x, lvn::simdDiv(lvn::simdLoad(&v1.x), lvn::simdLoad(&v2.x)));
+        return result;
+    }
+#endif
     return LvnVec<4, T>(v1.x / v2.x, v1.y / v2.y, v1.z / v2.z, v1.w / v2.w);
 }
 template <typename T>
@@ -4396,6 +6874,14 @@ LvnVec<4, T> operator-(const T& s, const LvnVec<4, T>& v)
 template <typename T>
 LvnVec<4, T> operator*(const T& s, const LvnVec<4, T>& v)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdStore(&result.x, lvn::simdMul(lvn::simdSplat(s), lvn::simdLoad(&v.x)));
+        return result;
+    }
+#endif
     return LvnVec<4, T>(s * v.x, s * v.y, s * v.z, s * v.w);
 }
 template <typename T>
@@ -4416,11 +6902,27 @@ LvnVec<4, T> operator-(const LvnVec<4, T>& v, const T& s)
 template <typename T>
 LvnVec<4, T> operator*(const LvnVec<4, T>& v, const T& s)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdStore(&result.x, lvn::simdMul(lvn::simdLoad(&v.x), lvn::simdSplat(s)));
+        return result;
+    }
+#endif
     return LvnVec<4, T>(v.x * s, v.y * s, v.z * s, v.w * s);
 }
 template <typename T>
 LvnVec<4, T> operator/(const LvnVec<4, T>& v, const T& s)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdStore(&result.x, lvn::simdDiv(lvn::simdLoad(&v.x), lvn::simdSplat(s)));
+        return result;
+    }
+#endif
     return LvnVec<4, T>(v.x / s, v.y / s, v.z / s, v.w / s);
 }
 
@@ -4854,7 +7356,7 @@ struct LvnMat<4, 4, T>
         return LvnMat<4, 4, T>(
             this->value[0] + m[0],
             this->value[1] + m[1],
-            this->value[4] + m[2],
+            this->value[2] + m[2],
             this->value[3] + m[3]);
     }
     LvnMat<4, 4, T> operator-(const LvnMat<4, 4, T>& m)
@@ -4922,6 +7424,14 @@ LvnMat<4, 4, T> operator/(const T& s, const LvnMat<4, 4, T>& m)
 template<typename T>
 LvnMat<4, 4, T> operator*(const LvnMat<4, 4, T>& m1, const LvnMat<4, 4, T>& m2)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnMat<4, 4, T> result;
+        lvn::simdMat4Mul(&result[0].x, &m1[0].x, &m2[0].x);
+        return result;
+    }
+#endif
     return LvnMat<4, 4, T>(
         m1[0][0] * m2[0][0] + m1[1][0] * m2[0][1] + m1[2][0] * m2[0][2] + m1[3][0] * m2[0][3],
         m1[0][1] * m2[0][0] + m1[1][1] * m2[0][1] + m1[2][1] * m2[0][2] + m1[3][1] * m2[0][3],
@@ -4973,6 +7483,14 @@ LvnMat<3, 4, T> operator*(const LvnMat<4, 4, T>& m1, const LvnMat<3, 4, T>& m2)
 template<typename T>
 LvnVec<4, T> operator*(const LvnMat<4, 4, T>& m, const LvnVec<4, T>& v)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdMat4MulVec4(&result.x, &m[0].x, &v.x);
+        return result;
+    }
+#endif
     return LvnVec<4, T>(
         m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z + m[3][0] * v.w,
         m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z + m[3][1] * v.w,
@@ -4982,6 +7500,14 @@ LvnVec<4, T> operator*(const LvnMat<4, 4, T>& m, const LvnVec<4, T>& v)
 template<typename T>
 LvnVec<4, T> operator*(const LvnVec<4, T>& v, const LvnMat<4, 4, T>& m)
 {
+#if defined(LVN_SIMD_MATH)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        LvnVec<4, T> result;
+        lvn::simdVec4MulMat4(&result.x, &v.x, &m[0].x);
+        return result;
+    }
+#endif
     return LvnVec<4, T>(
         v.x * m[0][0] + v.y * m[0][1] + v.z * m[0][2] + v.w * m[0][3],
         v.x * m[1][0] + v.y * m[1][1] + v.z * m[1][2] + v.w * m[1][3],
@@ -6146,6 +8672,14 @@ struct LvnQuat_t
     }
     LvnQuat_t<T> operator*(const LvnQuat_t<T>& q)
     {
+#if defined(LVN_SIMD_MATH)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            LvnQuat_t<T> result;
+            lvn::simdQuatMul(&result.w, &this->w, &q.w);
+            return result;
+        }
+#endif
         return LvnQuat_t<T>(
             this->w * q.w - this->x * q.x - this->y * q.y - this->z * q.z,
             this->w * q.x + this->x * q.w + this->y * q.z - this->z * q.y,
@@ -6235,6 +8769,8 @@ struct LvnContextCreateInfo
     {
         bool                      enableLogging;                 // enable or diable logging
         bool                      disableCoreLogging;            // whether to disable core logging in the library
+        bool                      enableAsyncLogging;            // messages are queued and written in batches by a background thread instead of on the calling thread
+        uint32_t                  asyncQueueCapacity;            // number of messages the async queue holds before callers wait for room, rounded up to a power of two, set to 0 for the default (8192)
         bool                      enableGraphicsApiDebugLogs;    // enable debug output for graphics api calls (eg. vulkan validation layer, opengl debug callbacks)
     } logging;
 
@@ -6243,8 +8779,31 @@ struct LvnContextCreateInfo
         LvnTextureFormat              frameBufferColorFormat;        // set the color image format of the window framebuffer when rendering
         LvnClipRegion                 matrixClipRegion;              // set the clip region to the correct coordinate system depending on the api
         uint32_t                      maxFramesInFlight;             // set the max frames in flight (vulkan only)
+        uint32_t                      frameLatency;                  // frames the cpu may get ahead of the gpu (1-3), capped at maxFramesInFlight, set to 0 to use maxFramesInFlight (vulkan only)
+        bool                          waitForPresent;                // waits for the previous frame to be presented before beginning the next one, lowers input latency at the cost of framerate (vulkan only)
+        LvnPhysicalDevicePreference   physicalDevicePreference;      // policy used to pick the physical device (GPU) when the context is created, high performance by default (vulkan only)
+        LvnString                     pipelineCachePath;             // file path the pipeline cache is loaded from on startup and saved to on shutdown, leave empty to not use a cache file (vulkan only)
+        LvnString                     shaderCacheDirectory;          // directory compiled spirv binaries are cached to when creating shaders from source, leave empty to only cache in memory (vulkan only)
+        bool                          enableHotReload;               // watch the files of shaders created from files, edited shaders are rebuilt with the pipelines that use them when the next frame begins, meant for development builds
     } rendering;
 
+    struct
+    {
+        LvnSubsystemInit          init;                          // when the audio device and engine are created, opening the device can take a long time on some backends
+        LvnAudioBackend           backend;                       // audio backend tried first, the others are tried in their default order if it fails (PipeWire is reached through PulseAudio or Jack)
+        uint32_t                  sampleRate;                    // output sample rate in hz, set to 0 to use the rate of the device
+        uint32_t                  channels;                      // output channel count, set to 0 to use the channels of the device
+        uint32_t                  periodSizeInFrames;            // frames mixed per audio callback, lower is less latency but more callbacks (eg. 128 at 48000hz is 2.7ms), set to 0 for the backend default
+        uint32_t                  periods;                       // periods queued in the device buffer, set to 0 for the backend default
+        bool                      exclusiveMode;                 // open the device in exclusive mode and skip the system mixer where supported (wasapi, alsa), falls back to shared mode when refused
+        bool                      noFixedSizedCallback;          // mix as many frames as the backend asks for instead of buffering whole periods, removes a period of latency but callback sizes may vary
+    } audio;
+
+    struct
+    {
+        LvnSubsystemInit          init;                          // when the socket library is initialized
+    } networking;
+
     struct
     {
         LvnMemAllocMode           memAllocMode;                  // memory allocation mode, how memory should be allocated when creating new object
@@ -6252,10 +8811,29 @@ struct LvnContextCreateInfo
         uint32_t                  memoryBindingCount;            // number of object alloc inso structs;
         LvnMemoryBindingInfo*     pBlockMemoryBindings;          // array of objects alloc info structs of each type to allocate for further memory blocks in case if the first block is full
         uint32_t                  blockMemoryBindingCount;       // number of block object alloc info structs
+        size_t                    trimHighWatermark;             // memPoolTrim only frees the memory blocks of an sType once its unused pool memory in bytes is above this value, set to 0 to always trim
+        size_t                    trimLowWatermark;              // memPoolTrim stops freeing the memory blocks of an sType once its unused pool memory in bytes would drop below this value
+        LvnString                 poolConfigPath;                // file the peak object counts of each sType are written to at terminateContext, the next createContext sizes the base memory block from it when using a memory pool; pMemoryBindings still override it, leave empty to not use a config file
     } memoryInfo;
+
+    struct
+    {
+        bool                      enableProfiling;               // record LVN_PROFILE_SCOPE zones from the start, can be changed later with lvn::profileEnable
+        uint32_t                  zonesPerThread;                // size of the zone ring buffer of each thread, rounded up to a power of two, set to 0 for the default (16384)
+    } profiling;
 };
 
 /* [Logging] */
+struct LvnLogFileOptions
+{
+    uint32_t bufferSize;                                         // bytes of log lines collected before they are written, 0 writes every message (or every batch with async logging) right away
+    LvnLogLevel flushLevel;                                      // messages of this level or higher write the buffer right away, errors and fatal messages always do, Lvn_LogLevel_None for only those
+    uint32_t flushInterval;                                      // milliseconds buffered lines wait at most before they are written, checked on each message and by the async log thread, 0 waits for a full buffer
+    uint64_t maxFileSize;                                        // bytes a log file grows to before it is rotated, 0 for no size limit
+    uint32_t rotateInterval;                                     // seconds a log file is written to before it is rotated, 0 for no time limit
+    uint32_t maxFiles;                                           // rotated files kept next to the log file ("<filename>.1" is the newest), older ones are deleted, 0 only keeps the current file
+};
+
 struct LvnLoggerCreateInfo
 {
     LvnString loggerName;
@@ -6267,6 +8845,7 @@ struct LvnLoggerCreateInfo
         bool enableLogToFile;
         LvnString filename;
         LvnFileMode filemode;
+        LvnLogFileOptions options;                               // buffering, flushing and rotation of the log file, zero initialized writes every message to one file
     } fileConfig;
 };
 
@@ -6289,6 +8868,25 @@ struct LvnLogFile
     LvnFileMode filemode;
     FILE* fileptr;
     bool logToFile;
+
+    LvnLogFileOptions options;
+    LvnMutex mutex;                                              // guards the buffer and the rotation state, messages are logged from several threads
+    LvnVector<char> buffer;                                      // lines not yet handed to the io thread
+    uint64_t fileSize;                                           // bytes of the current file including the buffer
+    long long openTime;                                          // seconds since epoch the current file was opened, for rotateInterval
+    float flushTime;                                             // context time the buffer was last written, for flushInterval
+};
+
+// token bucket of one LVN_LOG_RATE_LIMIT call site, the members after burst start zero initialized
+struct LvnLogRateLimit
+{
+    float ratePerSecond;                                         // tokens added each second, one message takes one token
+    float burst;                                                 // most tokens the bucket holds, the bucket starts full
+    float tokens = 0.0f;
+    float lastTime = 0.0f;                                       // context time tokens were last added
+    uint32_t suppressed = 0;                                     // messages dropped since the last one that passed
+    bool started = false;
+    LvnSpinLock lock = {};
 };
 
 /* [Events] */
@@ -6363,6 +8961,14 @@ struct LvnMouseMovedEvent
     int x, y;
 };
 
+// every cursor position reported by the window api between polls, the deltas of all samples add up to the motion since sampling began
+struct LvnMouseMotionSample
+{
+    double x, y;     // cursor position, unbounded while the mouse input mode is Lvn_MouseInputMode_Disable
+    double dx, dy;   // motion since the previous sample
+    double time;     // context time in seconds when the motion was delivered
+};
+
 struct LvnMouseScrolledEvent
 {
     LvnEventType type;
@@ -6441,11 +9047,16 @@ struct LvnWindowCreateInfo
     int minWidth, minHeight;            // minimum width and height of window (set to 0 if not specified)
     int maxWidth, maxHeight;            // maximum width and height of window (set to -1 if not specified)
     bool fullscreen, resizable, vSync;  // sets window to fullscreen if true; enables window resizing if true; vSync controls window framerate, sets framerate to 60fps if true
+    bool hidden;                        // creates the window without showing it, frames are still rendered and presented (eg. benchmarks that render offscreen)
+    bool headless;                      // creates no native window or swap chain, frames are rendered to offscreen images read back with lvn::windowReadPixels and input queries return defaults (vulkan only)
+    LvnPresentMode presentMode;         // present mode of the window swapchain, Lvn_PresentMode_Default uses vSync to choose; unsupported modes fall back to fifo
     LvnWindowIconData* pIcons;          // icon images used for window/app icon; pIcons can be stored in an array; pIcons will be ignored if set to null
     uint32_t iconCount;                 // iconCount is the number of icons in pIcons; if using only one icon, set iconCount to 1; if using an array of icons, set to length of array
 
     void (*eventCallBack)(LvnEvent*);   // set function ptr used as a callback to get events from this window
     void* userData;                     // pass a ptr of a variable or struct to use and get data during window callbacks
+    uint32_t mouseSampleCapacity;       // cursor motion samples kept between lvn::mouseGetMotionSamples calls, motion that does not fit is merged into the next sample; 0 disables sampling
+    uint32_t eventQueueCapacity;        // when not 0, events are pushed into a lock-free ring buffer of this many records instead of sent to eventCallBack; drain it with lvn::windowConsumeEvents() from any thread, events are dropped while it is full
 
     LvnWindowCreateInfo()
     {
@@ -6454,13 +9065,118 @@ struct LvnWindowCreateInfo
         minWidth = 0, minHeight = 0;
         maxWidth = -1, maxHeight = -1;
         fullscreen = false, resizable = true, vSync = false;
+        hidden = false;
+        headless = false;
+        presentMode = Lvn_PresentMode_Default;
         pIcons = nullptr;
         iconCount = 0;
         eventCallBack = nullptr;
         userData = nullptr;
+        mouseSampleCapacity = 0;
+        eventQueueCapacity = 0;
     }
 };
 
+// axis aligned box and ray used by the spatial structures, ray directions do not need to be normalized and hit distances are in multiples of the direction
+struct LvnAabb
+{
+    LvnVec3 min;
+    LvnVec3 max;
+};
+
+struct LvnRay
+{
+    LvnVec3 origin;
+    LvnVec3 direction;
+};
+
+// inner nodes have count 0 and their two children at first and first + 1, leaves hold count objects starting at first in the leaf object order
+// 32 bytes so two nodes share a cache line and the bounds load as two float4s
+struct LvnBvhNode
+{
+    LvnVec3 min;
+    uint32_t first;
+    LvnVec3 max;
+    uint32_t count;
+};
+
+// returns the distance along the ray to the hit within maxDistance or a negative number if the object is missed
+typedef float (*LvnBvhIntersectFunc)(uint32_t object, const LvnRay& ray, float maxDistance, void* userData);
+
+// bounding volume hierarchy over object bounds, objects are the indices of the bounds array given to build()
+// - build() splits nodes with the surface area heuristic over binned centroids
+// - refit() moves the bounds of the same objects without changing the tree, queries get slower the further objects move from where they were built so rebuild after large changes
+class LvnBvh
+{
+private:
+    LvnVector<LvnBvhNode> m_Nodes;
+    LvnVector<uint32_t> m_Objects;            // object indices in leaf order
+    LvnVector<LvnAabb> m_Bounds;              // bounds of m_Objects in the same order, kept next to each other for the leaf tests
+
+public:
+    void build(const LvnAabb* pBounds, uint32_t count, uint32_t maxLeafSize = 4);
+    void refit(const LvnAabb* pBounds);
+    void clear();
+
+    void query_aabb(const LvnAabb& bounds, LvnVector<uint32_t>* pResults) const;             // appends the objects whose bounds overlap bounds
+    void query_frustum(const LvnFrustum& frustum, LvnVector<uint32_t>* pResults) const;      // appends the objects whose bounds intersect the frustum
+    void query_ray(const LvnRay& ray, float maxDistance, LvnVector<uint32_t>* pResults) const; // appends the objects whose bounds the ray enters within maxDistance
+    bool raycast(const LvnRay& ray, float maxDistance, uint32_t* pObject, float* pDistance, LvnBvhIntersectFunc intersect = nullptr, void* userData = nullptr) const; // nearest hit front to back, the bounds are the hit if intersect is null
+
+    bool empty() const                        { return m_Nodes.empty(); }
+    const LvnBvhNode* nodes() const           { return m_Nodes.data(); }
+    size_t node_count() const                 { return m_Nodes.size(); }
+    const uint32_t* objects() const           { return m_Objects.data(); }
+    size_t object_count() const               { return m_Objects.size(); }
+};
+
+struct LvnLooseGridCell
+{
+    LvnVec2 looseMin, looseMax;               // bounds of the objects in the cell, they grow with inserts and reset when the cell empties
+    uint32_t head;                            // first object of the cell list, UINT32_MAX if empty
+    uint32_t count;
+};
+
+struct LvnLooseGridObject
+{
+    LvnVec2 min, max;
+    uint32_t cell;                            // UINT32_MAX if the id is not in the grid
+    uint32_t prev, next;
+};
+
+// 2d loose grid, each object is stored once in the cell that holds the center of its bounds and cells keep the loose bounds of their objects
+// objects are referred to by user ids which index a dense array, centers outside the grid go to the nearest border cell
+class LvnLooseGrid2D
+{
+private:
+    LvnVector<LvnLooseGridCell> m_Cells;
+    LvnVector<LvnLooseGridObject> m_Objects;
+    LvnVec2 m_Origin;
+    LvnVec2 m_MaxHalfExtent;
+    float m_CellSize, m_InvCellSize;
+    uint32_t m_Width, m_Height;
+
+    uint32_t cell_of(const LvnVec2& point) const;
+    void cell_range(const LvnVec2& boundsMin, const LvnVec2& boundsMax, uint32_t* x0, uint32_t* y0, uint32_t* x1, uint32_t* y1) const;
+    void link(uint32_t id, uint32_t cell);
+    void unlink(uint32_t id);
+
+public:
+    LvnLooseGrid2D();
+    LvnLooseGrid2D(const LvnVec2& origin, float cellSize, uint32_t width, uint32_t height);
+
+    void init(const LvnVec2& origin, float cellSize, uint32_t width, uint32_t height); // origin is the min corner of the grid, removes every object
+    void insert(uint32_t id, const LvnVec2& boundsMin, const LvnVec2& boundsMax);      // inserting an id that is already in the grid updates it
+    void update(uint32_t id, const LvnVec2& boundsMin, const LvnVec2& boundsMax);
+    void remove(uint32_t id);
+    void clear();
+    bool contains(uint32_t id) const          { return id < m_Objects.size() && m_Objects[id].cell != UINT32_MAX; }
+
+    void query_aabb(const LvnVec2& boundsMin, const LvnVec2& boundsMax, LvnVector<uint32_t>* pResults) const; // appends the ids whose bounds overlap the box, also used for culling against the bounds of an ortho camera
+    void query_point(const LvnVec2& point, LvnVector<uint32_t>* pResults) const;
+    void query_ray(const LvnVec2& origin, const LvnVec2& direction, float maxDistance, LvnVector<uint32_t>* pResults) const; // appends the ids whose bounds the ray enters within maxDistance
+};
+
 
 // -- [SUBSECT]: Graphics Struct Implementation
 // ------------------------------------------------------------
@@ -6472,6 +9188,9 @@ struct LvnPhysicalDeviceProperties
     uint32_t apiVersion;
     uint32_t driverVersion;
     uint32_t vendorID;
+    uint64_t minUniformBufferOffsetAlignment;    // alignment of uniform buffer and dynamic uniform buffer offsets
+    uint32_t maxPushConstantsSize;               // bytes of push constants a pipeline can declare
+    uint64_t deviceLocalMemorySize;              // bytes of all device local memory heaps, shared system memory on most integrated gpus
 };
 
 struct LvnPhysicalDeviceFeatures
@@ -6635,11 +9354,13 @@ struct LvnPipelineSpecification
     LvnPipelineMultiSampling multisampling;
     LvnPipelineColorBlend colorBlend;
     LvnPipelineDepthStencil depthstencil;
+    LvnPipelineDynamicStateFlagBits dynamicStates; // states set with render commands instead of baked into the pipeline, each bind resets them to the values above
 };
 
 struct LvnVertexBindingDescription
 {
     uint32_t binding, stride;
+    LvnVertexInputRate inputRate; // advance the binding per vertex or per instance, defaults to per vertex
 };
 
 struct LvnVertexAttribute
@@ -6650,6 +9371,87 @@ struct LvnVertexAttribute
     uint64_t offset;
 };
 
+// attribute format of a vertex member type, members of types without a specialization fail to compile in lvn::vertexLayout
+template <typename T>
+struct LvnAttributeFormatOf;
+
+template <> struct LvnAttributeFormatOf<float>     { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Scalar_f32; };
+template <> struct LvnAttributeFormatOf<double>    { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Scalar_f64; };
+template <> struct LvnAttributeFormatOf<int32_t>   { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Scalar_i32; };
+template <> struct LvnAttributeFormatOf<uint32_t>  { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Scalar_ui32; };
+template <> struct LvnAttributeFormatOf<int8_t>    { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Scalar_i8; };
+template <> struct LvnAttributeFormatOf<uint8_t>   { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Scalar_ui8; };
+template <> struct LvnAttributeFormatOf<LvnVec2>   { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec2_f32; };
+template <> struct LvnAttributeFormatOf<LvnVec3>   { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec3_f32; };
+template <> struct LvnAttributeFormatOf<LvnVec4>   { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec4_f32; };
+template <> struct LvnAttributeFormatOf<LvnVec2d>  { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec2_f64; };
+template <> struct LvnAttributeFormatOf<LvnVec3d>  { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec3_f64; };
+template <> struct LvnAttributeFormatOf<LvnVec4d>  { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec4_f64; };
+template <> struct LvnAttributeFormatOf<LvnVec2i>  { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec2_i32; };
+template <> struct LvnAttributeFormatOf<LvnVec3i>  { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec3_i32; };
+template <> struct LvnAttributeFormatOf<LvnVec4i>  { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec4_i32; };
+template <> struct LvnAttributeFormatOf<LvnVec2ui> { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec2_ui32; };
+template <> struct LvnAttributeFormatOf<LvnVec3ui> { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec3_ui32; };
+template <> struct LvnAttributeFormatOf<LvnVec4ui> { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec4_ui32; };
+
+template <typename T>
+struct LvnVertexMemberTraits;
+
+template <typename T, typename...>
+struct LvnFirstOf { using type = T; };
+
+template <typename V, typename T>
+struct LvnVertexMemberTraits<T V::*>
+{
+    using vertex_type = V;
+    using member_type = T;
+};
+
+// fixed size attribute array made by lvn::vertexLayout, pass data() and size() to LvnPipelineCreateInfo
+template <uint32_t N>
+struct LvnVertexAttributeArray
+{
+    LvnVertexAttribute attributes[N];
+
+    const LvnVertexAttribute* data() const { return attributes; }
+    static constexpr uint32_t size() { return N; }
+    const LvnVertexAttribute& operator[](uint32_t index) const { return attributes[index]; }
+};
+
+namespace lvn
+{
+    // byte offset of a member within its vertex, taken from storage that is never read so no vertex has to be constructed
+    template <typename V, typename T>
+    inline uint64_t vertexMemberOffset(T V::* member)
+    {
+        alignas(V) unsigned char storage[sizeof(V)];
+        const V* vertex = reinterpret_cast<const V*>(storage);
+        return static_cast<uint64_t>(reinterpret_cast<const unsigned char*>(&(vertex->*member)) - storage);
+    }
+
+    // attributes of the given members of one vertex type in order, locations count up from firstLocation
+    // eg. lvn::vertexLayout<&Vertex::pos, &Vertex::color>() for locations 0 and 1 of binding 0
+    template <auto... Members>
+    inline LvnVertexAttributeArray<sizeof...(Members)> vertexLayout(uint32_t binding = 0, uint32_t firstLocation = 0)
+    {
+        static_assert(sizeof...(Members) > 0, "a vertex layout needs at least one member");
+
+        using V = typename LvnVertexMemberTraits<typename LvnFirstOf<decltype(Members)...>::type>::vertex_type;
+        static_assert((std::is_same_v<V, typename LvnVertexMemberTraits<decltype(Members)>::vertex_type> && ...), "all members of a vertex layout must belong to the same vertex type");
+
+        LvnVertexAttributeArray<sizeof...(Members)> layout{};
+        uint32_t index = 0;
+        ((layout.attributes[index] = LvnVertexAttribute{ binding, firstLocation + index, LvnAttributeFormatOf<typename LvnVertexMemberTraits<decltype(Members)>::member_type>::value, lvn::vertexMemberOffset(Members) }, index++), ...);
+        return layout;
+    }
+
+    template <typename V>
+    constexpr LvnVertexBindingDescription vertexBinding(uint32_t binding = 0, LvnVertexInputRate inputRate = Lvn_VertexInputRate_Vertex)
+    {
+        return LvnVertexBindingDescription{ binding, static_cast<uint32_t>(sizeof(V)), inputRate };
+    }
+}
+
 struct LvnDescriptorBinding
 {
     uint32_t binding;
@@ -6663,7 +9465,16 @@ struct LvnDescriptorLayoutCreateInfo
 {
     LvnDescriptorBinding* pDescriptorBindings;
     uint32_t descriptorBindingCount;
-    uint32_t maxSets;
+    uint32_t maxSets;                        // sets the first pool is sized for, more pools are chained once it is full
+};
+
+struct LvnDescriptorLayoutStats
+{
+    uint32_t poolCount;                      // pools chained for persistent descriptor sets
+    uint32_t transientPoolCount;             // pools transient descriptor sets are allocated from
+    uint64_t poolSetCapacity;                // persistent sets the chained pools can hold
+    uint64_t allocatedSets;                  // persistent descriptor sets allocated from the layout
+    uint64_t transientSets;                  // transient descriptor sets allocated for the frames still in flight
 };
 
 struct LvnDescriptorUpdateInfo
@@ -6675,6 +9486,13 @@ struct LvnDescriptorUpdateInfo
     const LvnTexture* const* pTextureInfos;
 };
 
+struct LvnDescriptorSetUpdate
+{
+    LvnDescriptorSet* descriptorSet;
+    LvnDescriptorUpdateInfo* pUpdateInfos;
+    uint32_t updateInfoCount;
+};
+
 struct LvnPipelineCreateInfo
 {
     LvnPipelineSpecification* pipelineSpecification;
@@ -6686,12 +9504,31 @@ struct LvnPipelineCreateInfo
     uint32_t descriptorLayoutCount;
     const LvnShader* shader;
     const LvnRenderPass* renderPass;
+    const LvnPushConstantRange* pPushConstantRanges;
+    uint32_t pushConstantRangeCount;
+};
+
+struct LvnComputePipelineCreateInfo
+{
+    LvnDescriptorLayout** pDescriptorLayouts;
+    uint32_t descriptorLayoutCount;
+    const LvnShader* shader;                            // shader created with computeSrc
+    const LvnPushConstantRange* pPushConstantRanges;
+    uint32_t pushConstantRangeCount;
+};
+
+struct LvnPushConstantRange
+{
+    LvnShaderStage shaderStage;
+    uint32_t offset;
+    uint32_t size;
 };
 
 struct LvnShaderCreateInfo
 {
     LvnString vertexSrc;
     LvnString fragmentSrc;
+    LvnString computeSrc; // when set, a compute shader is created and the vertex and fragment sources are ignored
 };
 
 struct LvnFrameBufferColorAttachment
@@ -6704,6 +9541,7 @@ struct LvnFrameBufferDepthAttachment
 {
     uint32_t index;
     LvnDepthImageFormat format;
+    bool sampled = false; // keep the depth contents after the render pass so the depth image can be sampled, otherwise the depth image is transient and may never be allocated in memory
 };
 
 struct LvnFrameBufferCreateInfo
@@ -6717,6 +9555,146 @@ struct LvnFrameBufferCreateInfo
     LvnTextureMode textureMode;
 };
 
+// picks a render scale per frame from measured gpu times, the cost of a frame is assumed to follow the pixel count (scale squared)
+struct LvnRenderScaleController
+{
+    float targetGpuTime;        // gpu milliseconds per frame the controller aims for
+    float minScale, maxScale;   // range of the chosen render scale
+    float headroom;             // fraction of the target that must be free before the scale is raised, keeps the scale from oscillating
+    float maxIncrease;          // largest raise of the scale per update, drops are applied at once
+    float smoothing;            // weight of the newest gpu time in the running average, between 0 and 1
+    float scale;                // current render scale
+    float averageGpuTime;       // running average of the gpu times, 0 until the first update
+};
+
+// pixels of a framebuffer attachment copied with renderCmdReadbackFrameBuffer, only valid during the readback callback
+struct LvnReadbackData
+{
+    const void* pixels;             // tightly packed rows in the same order lvn::frameBufferReadPixels returns them
+    uint64_t size;
+    uint32_t width, height;
+    uint32_t pixelSize;             // bytes per pixel of the attachment format
+    LvnColorImageFormat format;
+    uint64_t frameIndex;            // frame the readback was recorded in, callbacks run on the workers and may finish out of order
+};
+
+// gpu time of a scope recorded with renderCmdBeginTimestamp/renderCmdEndTimestamp, read back a few frames after it was recorded
+struct LvnGpuTimestamp
+{
+    const char* name;       // name of the scope, valid until the next frame begins
+    double milliseconds;    // gpu time between the beginning and end of the scope
+    uint32_t depth;         // nesting depth of the scope, 0 for outermost scopes
+};
+
+// render work of one frame, commands replayed from command lists are counted every time the list is executed
+struct LvnFrameStats
+{
+    uint64_t frameIndex;                     // frames completed before this one
+    double cpuMilliseconds;                  // time between the renderBeginNextFrame calls that began and ended the frame
+
+    uint64_t drawCalls;                      // every renderCmdDraw* call, an indirect draw counts once
+    uint64_t vertices;                       // vertices or indices submitted by direct draws, multiplied by the instance count
+    uint64_t instances;                      // instances of direct draws, 1 for non instanced draws
+    uint64_t indirectDraws;                  // draws read from indirect buffers, the max draw count for renderCmdDrawIndexedIndirectCount
+    uint64_t dispatches;
+    uint64_t renderPasses;                   // window render passes and framebuffers begun
+    uint64_t pipelineBinds;
+    uint64_t descriptorSetBinds;             // descriptor sets bound, not bind calls
+    uint64_t vertexBufferBinds;              // vertex buffers bound, not bind calls
+    uint64_t indexBufferBinds;
+    uint64_t pushConstantBytes;
+    uint64_t commandListsExecuted;
+    uint64_t bufferUploads;                  // bufferUpdateData calls
+    uint64_t bufferUploadBytes;
+};
+
+// memory budget and usage of a memory heap of the physical device
+struct LvnGraphicsMemoryHeapStats
+{
+    uint64_t budget;                         // estimated bytes the application can use from the heap, the heap size is used when the budget is not supported
+    uint64_t usage;                          // estimated bytes of the heap used by the process, includes memory not allocated by the library
+    uint64_t blockBytes;                     // bytes of device memory blocks allocated from the heap
+    uint64_t allocationBytes;                // bytes of the blocks occupied by resources
+    uint32_t blockCount;                     // device memory blocks allocated from the heap
+    uint32_t allocationCount;                // resource allocations placed in the blocks
+    bool deviceLocal;                        // the heap is gpu memory
+};
+
+struct LvnGraphicsMemoryStats
+{
+    LvnGraphicsMemoryHeapStats heaps[LVN_MAX_MEMORY_HEAPS];
+    uint32_t heapCount;
+    bool budgetSupported;                    // heap budget and usage are reported by the driver (VK_EXT_memory_budget)
+
+    uint64_t bufferBytes;                    // memory allocated for buffers, including their staging memory
+    uint32_t bufferAllocations;
+    uint64_t textureBytes;                   // memory allocated for textures, cubemaps and environment maps
+    uint32_t textureAllocations;
+    uint64_t frameBufferBytes;               // memory allocated for framebuffer attachments
+    uint32_t frameBufferAllocations;
+
+    uint64_t unusedBytes;                    // bytes of allocated blocks not occupied by any resource
+    uint32_t unusedRangeCount;               // free ranges between allocations in the blocks
+    uint64_t largestUnusedRange;             // largest free range in any block
+    float fragmentation;                     // 0 when the unused memory is a single range, approaches 1 as it is split into many small ranges
+};
+
+struct LvnMemoryCategoryStats
+{
+    uint64_t bytes;                          // bytes currently allocated
+    uint64_t peakBytes;                      // highest value bytes has reached
+    uint64_t allocationCount;                // allocations currently alive
+    uint64_t totalAllocations;               // allocations made since startup
+};
+
+struct LvnMemoryStats
+{
+    LvnMemoryCategoryStats categories[Lvn_MemoryCategory_Max_Value];
+    uint64_t bytes;                          // bytes currently allocated over all categories
+    uint64_t peakBytes;
+    uint64_t allocationCount;
+    uint64_t frameAllocations;               // allocations made in the last completed frame, see lvn::memNextFrame
+    uint64_t frameBytes;                     // bytes allocated in the last completed frame
+};
+
+// layouts match VkDrawIndirectCommand/VkDrawIndexedIndirectCommand and the opengl indirect command structs
+struct LvnDrawIndirectCommand
+{
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t firstInstance;
+};
+
+struct LvnDrawIndexedIndirectCommand
+{
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;
+};
+
+struct LvnRenderGraphAccess
+{
+    LvnRenderGraphResource resource;
+    LvnMemoryBarrierFlagBits usage;    // how a buffer is read by the pass (eg. Lvn_MemoryBarrier_VertexBuffer), ignored for framebuffers
+};
+
+struct LvnRenderGraphPassCreateInfo
+{
+    const char* name;                                   // name of the pass used in log messages
+    LvnRenderGraphResource target;                      // framebuffer or window rendered to by the pass, set to LVN_RENDER_GRAPH_NO_RESOURCE for passes recorded outside of render passes (eg. compute dispatches)
+    const LvnRenderGraphAccess* pReads;                 // framebuffers sampled and buffers read by the pass
+    uint32_t readCount;
+    const LvnRenderGraphResource* pWrites;              // buffers written by shaders in the pass (eg. storage buffers written by compute)
+    uint32_t writeCount;
+    LvnVec4 clearColor;                                 // clear color when the target is the window, framebuffers use their own clear colors
+    bool keepAlive;                                     // never cull the pass, for passes whose results are used outside of the graph
+    void (*execute)(LvnRenderGraph* renderGraph, LvnWindow* window, void* userData); // records the draw or dispatch commands of the pass, the target render pass is already begun
+    void* userData;
+};
+
 struct LvnBufferCreateInfo
 {
     LvnBufferTypeFlagBits type;
@@ -6737,13 +9715,16 @@ struct LvnImageData
     LvnData<uint8_t> pixels;
     uint32_t width, height, channels;
     uint64_t size;
+    LvnTextureCompression compression = Lvn_TextureCompression_None; // block compression of the pixel data, pixels holds the compressed blocks if not none
 };
 
 struct LvnImageHdrData
 {
-    LvnData<float> pixels;
+    LvnData<float> pixels;              // float texels, empty if the image was converted to a packed format
+    LvnData<uint8_t> packedPixels;      // texels of half and rgb9e5 images
     uint32_t width, height, channels;
-    uint64_t size;
+    uint64_t size;                      // number of floats in pixels, or bytes in packedPixels for packed formats
+    LvnHdrImageFormat format;
 };
 
 struct LvnSamplerCreateInfo
@@ -6758,6 +9739,8 @@ struct LvnTextureCreateInfo
     LvnTextureFormat format;
     LvnTextureFilter minFilter, magFilter;
     LvnTextureMode wrapS, wrapT;
+    uint32_t mipLevels;                 // number of mip levels, 0 or 1 for no mipmaps, use lvn::imageGetMipLevelCount() for the full mip chain
+    const LvnImageData* pMipImageData;  // optional precomputed images for mip levels 1 to mipLevels - 1, if null the mip levels are generated from imageData
 };
 
 struct LvnTextureSamplerCreateInfo
@@ -6765,6 +9748,40 @@ struct LvnTextureSamplerCreateInfo
     LvnImageData imageData;
     LvnTextureFormat format;
     LvnSampler* sampler;
+    uint32_t mipLevels;                 // number of mip levels, 0 or 1 for no mipmaps, use lvn::imageGetMipLevelCount() for the full mip chain
+    const LvnImageData* pMipImageData;  // optional precomputed images for mip levels 1 to mipLevels - 1, if null the mip levels are generated from imageData
+};
+
+struct LvnTextureStreamCreateInfo
+{
+    LvnString filepath;                 // image file decoded on a worker, png, jpg, etc. or a block compressed ktx2 or dds file, unused if data is set
+    const uint8_t* data;                // encoded image file in memory, copied when the stream is created
+    uint64_t size;
+
+    LvnTextureFormat format;
+    LvnTextureFilter minFilter, magFilter;
+    LvnTextureMode wrapS, wrapT;
+    bool mipmaps;                       // full mip chain for every level, compressed files use the mip levels stored in the file
+    uint32_t previewSize;               // largest side of the preview uploaded before the full image, 0 skips the preview
+    uint8_t placeholder[4];             // rgba color of the texture used until the first level is uploaded
+};
+
+struct LvnTextureAtlasCreateInfo
+{
+    uint32_t pageWidth, pageHeight;     // dimensions of each rgba atlas page, (default: 2048x2048)
+    uint32_t maxPages;                  // textureAtlasAdd fails once this many pages are full, 0 for no limit, (default: 0)
+    uint32_t padding;                   // border around every image filled with its edge pixels so filtering never reads a neighbouring image, (default: 2)
+    uint32_t mipLevels;                 // mip levels of the page textures, 0 or 1 for no mipmaps, images are placed on multiples of 2^(mipLevels - 1) texels so neighbours do not mix in the mip chain,
+                                        // mipmapped pages take no new images once uploaded since only the base level of a texture can be updated, (default: 1)
+    LvnTextureFormat format;
+    LvnTextureFilter minFilter, magFilter;
+};
+
+struct LvnTextureAtlasRegion
+{
+    uint32_t page;                      // index of the page texture the image was packed into
+    uint32_t x, y, width, height;       // texels of the image within the page, without the padding
+    float u0, v0, u1, v1;               // uvs of the image corners, v0 is the first row of the image
 };
 
 struct LvnVertex
@@ -6779,6 +9796,20 @@ struct LvnVertex
     LvnVec4 weights;
 };
 
+// vertex layout of loaded meshes, the full unquantized layout with every attribute is LvnVertex
+// - unquantized layouts store the kept attributes as floats in the order of LvnVertex
+// - quantized layouts store pos as Vec3_f32, color as Vec4_un8, texUV as Vec2_f16, the normal octahedral encoded as Vec2_n16,
+//   the tangent octahedral encoded in xy of 2_10_10_10_nle with the bitangent sign in w, joints as Vec4_ui8 and weights as Vec4_un16
+//   decode in the shader with:
+//     vec3 octDecode(vec2 e) { vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y)); float t = max(-v.z, 0.0); v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0))); return normalize(v); }
+//     normal = octDecode(inNormal); tangent = octDecode(inTangent.xy); bitangent = cross(normal, tangent) * inTangent.w;
+//   joints are read as uvec4 and joint indices must be below 256
+struct LvnVertexLayout
+{
+    LvnVertexAttributeFlagBits attributes;
+    bool quantized;
+};
+
 struct LvnTransform
 {
     LvnVec3 translation;
@@ -6801,6 +9832,13 @@ struct LvnMaterial
     bool doubleSided;
 };
 
+struct LvnPrimitiveLod
+{
+    uint64_t indexOffset;        // byte offset of the lod indices in the primitive buffer
+    uint32_t indexCount;
+    float error;                 // largest distance the simplified surface moved from the full mesh, in mesh units
+};
+
 struct LvnPrimitive
 {
     LvnTopologyType topology;
@@ -6811,6 +9849,26 @@ struct LvnPrimitive
 
     LvnBuffer* buffer;
     LvnDescriptorSet* descriptorSet;
+    uint32_t materialIndex;      // index of the material in a material table, written by lvn::materialTableAddModel
+
+    LvnVec3 boundsCenter;        // bounding sphere of the vertices in mesh space
+    float boundsRadius;
+    LvnVec3 boundsMin;           // axis aligned bounding box of the vertices in mesh space
+    LvnVec3 boundsMax;
+    LvnVector<LvnPrimitiveLod> lods; // lods[0] is the full index range followed by coarser ranges in the same buffer, empty if no lods were generated
+};
+
+struct LvnVisiblePrimitive
+{
+    uint32_t node;               // index of the node in the model, its mesh holds the primitive
+    uint32_t primitive;          // index of the primitive in the mesh
+};
+
+struct LvnModelInstance
+{
+    LvnMat4 matrix;              // world matrix of the instance
+    uint32_t materialIndex;      // free for shaders to pick a material or tint per instance, levikno does not read it
+    uint32_t reserved[3];        // pads the instance to 80 bytes so it can also be read from a std430 storage buffer
 };
 
 struct LvnMesh
@@ -6827,11 +9885,13 @@ struct LvnNode
     int32_t skin;
     LvnTransform transform;
     LvnMat4 matrix;
+    LvnVector<LvnTransform> instances; // EXT_mesh_gpu_instancing transforms applied before the node matrix, empty if the node is not instanced
 };
 
 struct LvnSkin
 {
     LvnString name;
+    LvnAtom nameAtom; // atom of name, compare skins by name with it
     LvnVector<LvnMat4> inverseBindMatrices;
     LvnVector<int32_t> joints;
     LvnBuffer* ssbo;
@@ -6844,6 +9904,7 @@ struct LvnAnimationChannel
     LvnVector<float> keyFrames;
     LvnVector<LvnVec4> outputs;
     int32_t node;
+    uint32_t cursor; // keyframe of the last sample
 };
 
 struct LvnAnimation
@@ -6854,6 +9915,24 @@ struct LvnAnimation
     float currentTime;
 };
 
+// nodes of a model flattened in depth first order, parents come before their children and every subtree is a contiguous range of entries
+// local transforms are stored per component so dirty runs are composed in batches, world matrices are only recomputed for dirty subtrees
+struct LvnNodeHierarchy
+{
+    LvnVector<uint32_t> nodes;          // model node of each entry
+    LvnVector<uint32_t> entries;        // entry of each model node
+    LvnVector<int32_t> parents;         // entry of the parent, -1 for roots
+    LvnVector<uint32_t> subtreeEnds;    // one past the last entry in the subtree of each entry
+    LvnVector<LvnVec3> translations;
+    LvnVector<LvnQuat> rotations;
+    LvnVector<LvnVec3> scales;
+    LvnVector<LvnMat4> matrices;        // node matrix applied after the translation, rotation and scale
+    LvnVector<LvnMat4> localMatrices;
+    LvnVector<LvnMat4> worldMatrices;
+    LvnVector<uint8_t> dirty;           // entries whose local transform changed since the last update
+    bool anyDirty;
+};
+
 struct LvnModel
 {
     LvnVector<int32_t> rootNodes;
@@ -6865,6 +9944,8 @@ struct LvnModel
     LvnVector<LvnSampler*> samplers;
     LvnVector<LvnTexture*> textures;
     LvnMat4 matrix;
+    LvnVertexLayout vertexLayout; // layout of the vertices in the mesh buffers
+    LvnNodeHierarchy hierarchy;   // flattened nodes used by the animation updates, built on the first update of the model
 };
 
 struct LvnCamera
@@ -6885,6 +9966,11 @@ struct LvnOrthoCamera
     float zFar;                  // near plane
 };
 
+struct LvnFrustum
+{
+    LvnVec4 planes[6];           // left, right, bottom, top, near and far planes as (normal, distance), points with dot(normal, p) + distance >= 0 are inside
+};
+
 struct LvnCubemapCreateInfo
 {
     LvnImageData posx, negx, posy, negy, posz, negz;
@@ -6892,7 +9978,39 @@ struct LvnCubemapCreateInfo
 
 struct LvnCubemapHdrCreateInfo
 {
-    LvnImageHdrData hdr;
+    LvnImageHdrData hdr;         // equirectangular hdr image
+    uint32_t size;               // width and height of each cubemap face, set to 0 to use a quarter of the hdr image width
+};
+
+struct LvnEnvironmentMapCreateInfo
+{
+    LvnImageHdrData hdr;         // equirectangular hdr image, may be left empty when cachePath points to a valid cache file
+    uint32_t cubemapSize;        // face size of the environment cubemap, 0 uses 512
+    uint32_t irradianceSize;     // face size of the irradiance cubemap, 0 uses 32
+    uint32_t prefilterSize;      // face size of the base level of the prefiltered cubemap, 0 uses 128
+    uint32_t prefilterMipLevels; // roughness levels of the prefiltered cubemap, 0 uses 5
+    uint32_t brdfLutSize;        // width and height of the brdf lookup texture, 0 uses 512
+    LvnString cachePath;         // optional file the baked textures are loaded from and written to, rebaked when the sizes or the hdr image do not match
+};
+
+struct LvnLightClustersCreateInfo
+{
+    uint32_t tilesX, tilesY;     // clusters across and up the screen, 0 uses 16 x 9
+    uint32_t slices;             // exponentially spaced depth slices between zNear and zFar of the camera, 0 uses 24
+    uint32_t maxLightIndices;    // capacity of the light index list shared by all clusters, lights past it are dropped from the clusters that overflow, 0 uses 32 per cluster
+};
+
+struct LvnMaterialTableCreateInfo
+{
+    uint32_t maxMaterials;                   // capacity of the material storage buffer, 0 uses 1024
+    uint32_t maxTextures;                    // length of the texture array shared by all materials including the default white texture at index 0, 0 uses 256
+};
+
+struct LvnShadowCacheCreateInfo
+{
+    uint32_t width, height;                  // size of both layers, 0 uses 2048 x 2048
+    LvnColorImageFormat depthFormat;         // color format the caster depth is written to, None uses RGBA32F
+    LvnTextureFilter textureFilter;          // filter of the sampled layers, nearest keeps depth comparisons exact
 };
 
 struct LvnFontGlyph
@@ -6915,15 +10033,40 @@ struct LvnFont
 {
     LvnImageData atlas;
     float fontSize;
+    float sdfSpread; // distance in pixels encoded on each side of a glyph edge with 0.5 on the edge, zero if the atlas holds coverage bitmaps
 
     LvnData<uint32_t> codepoints;
     LvnData<LvnFontGlyph> glyphs;
+
+    // built by fontBuildGlyphLookup, fontGetGlyph falls back to searching the glyphs if these are empty
+    LvnData<uint32_t> glyphTable;     // glyph index plus one for each codepoint in the latin ranges (0...0x24f), zero if the font has no glyph
+    LvnData<uint64_t> glyphHashTable; // (codepoint << 32 | glyph index) for codepoints above the latin ranges, open addressed, empty slots are UINT64_MAX
+};
+
+struct LvnDynamicFontCreateInfo
+{
+    LvnString filepath;              // the filepath to the ttf font file
+    uint32_t fontSize;               // pixel size the glyphs are rasterized at
+    uint32_t pageWidth, pageHeight;  // dimensions of each single channel atlas page, (default: 1024x1024)
+    uint32_t maxPages;               // max number of atlas pages, once every page is full the least recently used page is cleared for new glyphs, (default: 4)
+    LvnLoadFontFlagBits flags;
 };
 
 
 // -- [SUBSECT]: Audio Struct Implementation
 // ------------------------------------------------------------
 
+struct LvnAudioDeviceInfo
+{
+    const char* backendName;
+    uint32_t sampleRate;
+    uint32_t channels;
+    uint32_t periodSizeInFrames;
+    uint32_t periods;
+    bool exclusive;              // the device was opened in exclusive mode
+    float latencyMilliseconds;   // length of the device buffer, the output latency added by the mixer
+};
+
 struct LvnSoundCreateInfo
 {
     LvnString filepath;      // the filepath to the sound file (.wav .mp3)
@@ -6935,6 +10078,38 @@ struct LvnSoundCreateInfo
     bool looping;              // sound source loops when reaches end of track
 
     LvnVec3 pos;
+
+    float audibleRadius;                // distance from the listener past which soundsUpdateSpatial virtualizes the sound, 0.0 never virtualizes (default: 0.0)
+    uint32_t priority;                  // higher priority sounds keep their voices first when audioUpdateVoices is over the voice budget (default: 0)
+    LvnSoundGroup* group;               // group the sound is mixed into, nullptr mixes into the master output (default: nullptr)
+    bool stream;                        // decode the sound ahead of playback on a background thread instead of all at once, memory stays constant for long tracks (default: false)
+    uint32_t streamBufferMilliseconds;  // length of decoded audio kept ahead of playback when streaming (default: 500)
+};
+
+struct LvnSoundBankCreateInfo
+{
+    uint32_t maxVoicesPerSound;  // voices kept for each sound of the bank, the number of one shots of the same sound that can overlap (default: 8)
+    float audibleRadius;         // spatialized one shots further than this from the listener are not played, 0.0 plays every one shot (default: 0.0)
+    LvnSoundGroup* group;        // group the voices are mixed into, nullptr mixes into the master output (default: nullptr)
+};
+
+struct LvnSoundGroupCreateInfo
+{
+    LvnSoundGroup* parent;           // group the output is mixed into, nullptr mixes into the master output (default: nullptr)
+    float volume;                    // (default: 1.0)
+    float lowPassCutoff;             // cutoff frequency in hz of the low pass filter run once on the mix of the group, 0.0 bypasses the filter (default: 0.0)
+    float reverbSend;                // level of the group sent to its reverb, 0.0 bypasses the reverb (default: 0.0)
+    float reverbDelayMilliseconds;   // delay of the reverb feedback line, fixed after creation (default: 80.0)
+    float reverbDecay;               // feedback of the reverb, each repeat is this much quieter (default: 0.5, min: 0.0, max: 0.95)
+};
+
+struct LvnSoundPlayParams
+{
+    float volume;                // (default: 1.0)
+    float pan;                   // (default: 0.0)
+    float pitch;                 // (default: 1.0)
+    bool spatialize;             // attenuate and pan the voice by its position relative to the listener (default: true)
+    LvnVec3 pos;
 };
 
 
@@ -6947,6 +10122,14 @@ struct LvnAddress
     uint16_t port;
 };
 
+// network conditions injected into a socket for testing, all zero sends and receives normally
+struct LvnSocketSimulation
+{
+    uint32_t latencyMilliseconds; // added to every packet the socket sends
+    uint32_t jitterMilliseconds;  // random extra delay up to this on top of the latency, packets still leave in the order they were sent
+    float packetLoss;             // chance each received datagram is dropped, 0.0 to 1.0, enet resends the reliable packets it held
+};
+
 struct LvnSocketCreateInfo
 {
     LvnSocketType type;
@@ -6955,12 +10138,113 @@ struct LvnSocketCreateInfo
     uint32_t connectionCount;
     uint32_t inBandWidth;
     uint32_t outBandWidth;
+    bool batchSends;          // socketSend only queues packets, they are sent together by socketFlush or socketReceive once per network tick (default: false)
+    bool networkThread;       // a worker thread owns the host and services it every tick, socket calls only exchange packets and events with it through lock-free queues, requires multithreading (default: false)
+    uint32_t networkTickMilliseconds; // longest time the network thread waits for traffic before sending the packets queued since (default: 5)
+    uint32_t networkQueueCapacity;    // packets and events each queue can hold between the network thread and the socket calls (default: 1024)
+    LvnSocketCompression compression; // (default: Lvn_SocketCompression_None)
+    uint32_t compressionThreshold;    // datagrams smaller than this many bytes are sent uncompressed, datagrams that do not get smaller are always sent uncompressed (default: 64)
+    LvnSocketSimulation simulation;   // delayed packets leave on the next service, receive or flush after their delay (default: all zero)
 };
 
 struct LvnPacket
 {
     void* data;
     size_t size;
+    void* handle;             // owned packet from socketReceive or socketPacketCreate, the ownership moves to the socket when sent (default: nullptr)
+};
+
+struct LvnSocketEvent
+{
+    LvnSocketEventType type;
+    uint32_t peerId;          // index of the peer on the socket, stays the same while the peer is connected
+    uint8_t channel;
+    LvnPacket packet;         // received packet for Lvn_SocketEvent_Receive, the data is only valid during the callback
+    uint32_t data;            // data sent with the connect or disconnect
+};
+
+struct LvnSocketPeerInfo
+{
+    LvnAddress address;
+    bool connected;
+    uint32_t roundTripTime;         // mean round trip time in milliseconds
+    uint32_t roundTripTimeVariance;
+    float packetLoss;               // fraction of reliable packets lost in the last interval, 0.0 to 1.0
+    uint64_t bytesSent;             // payload totals since the peer connected
+    uint64_t bytesReceived;
+    uint64_t packetsSent;
+    uint64_t packetsReceived;
+};
+
+// -- LvnBitWriter, LvnBitReader
+// ------------------------------------------------------------
+// - bit-packed streams for replicated state, each value only takes the bits its range needs
+// - bounded ints take the bits of max - min, quantized floats take the bits of (max - min) / resolution steps
+// - the delta writes take a single bit when the value equals the one in the base snapshot the receiver already has,
+//   whole snapshots can also be diffed with ecsSnapshotDelta before they are sent
+// - reads past the end return zero and set overflowed() instead of failing each read, check it once after reading a packet
+
+class LvnBitWriter
+{
+private:
+    LvnVector<uint8_t> m_Data;
+    uint64_t m_Scratch;     /* bits not yet moved to m_Data, the oldest bit is the lowest */
+    uint32_t m_ScratchBits;
+
+public:
+    LvnBitWriter();
+
+    void write_bits(uint32_t value, uint32_t bits); /* bits is 0 to 32 */
+    void write_bool(bool value);
+    void write_uint(uint32_t value, uint32_t min, uint32_t max);
+    void write_int(int32_t value, int32_t min, int32_t max);
+    void write_varint(uint64_t value);              /* 8 bits for each 7 bits of the value, small values stay small */
+    void write_svarint(int64_t value);              /* zigzag encoded so small negative values stay small */
+    void write_float(float value);
+    void write_float(float value, float min, float max, float resolution);
+    void write_bytes(const void* data, size_t size); /* aligns to a byte first */
+
+    void write_delta_uint(uint32_t value, uint32_t base, uint32_t min, uint32_t max);
+    void write_delta_int(int32_t value, int32_t base, int32_t min, int32_t max);
+    void write_delta_float(float value, float base, float min, float max, float resolution);
+
+    void align(); /* pads to a byte boundary, call before data() and size() so the last bits are included */
+    void clear();
+
+    const uint8_t* data() const { return m_Data.data(); }
+    size_t size() const { return m_Data.size(); }
+    size_t bit_count() const { return m_Data.size() * 8 + m_ScratchBits; }
+};
+
+class LvnBitReader
+{
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_BitOffset;
+    bool m_Overflowed;
+
+public:
+    LvnBitReader(const uint8_t* data, size_t size);
+
+    uint32_t read_bits(uint32_t bits);
+    bool read_bool();
+    uint32_t read_uint(uint32_t min, uint32_t max);
+    int32_t read_int(int32_t min, int32_t max);
+    uint64_t read_varint();
+    int64_t read_svarint();
+    float read_float();
+    float read_float(float min, float max, float resolution);
+    void read_bytes(void* data, size_t size);
+
+    uint32_t read_delta_uint(uint32_t base, uint32_t min, uint32_t max);
+    int32_t read_delta_int(int32_t base, int32_t min, int32_t max);
+    float read_delta_float(float base, float min, float max, float resolution);
+
+    void align();
+
+    bool overflowed() const { return m_Overflowed; }
+    size_t bits_remaining() const { return m_Size * 8 - m_BitOffset; }
 };
 
 
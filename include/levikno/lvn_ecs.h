@@ -7,26 +7,63 @@
 // ------------------------------------------------------------
 //
 // [SECTION]: ECS (Entity Component System) Definitions & Implementation
+// -- [SUBSECT]: Component Types
+// -- [SUBSECT]: Archetype Storage
+// -- [SUBSECT]: Views
+// -- [SUBSECT]: Groups
 // [SECTION]: ECS Functions
+// -- [SUBSECT]: System Scheduling
+// -- [SUBSECT]: Command Buffers
+// -- [SUBSECT]: Snapshots
 
 #include "levikno.h"
 
+#include <atomic>
 #include <type_traits>
+#include <utility>
 
 
 // ------------------------------------------------------------
 // [SECTION]: ECS (Entity Component System) Definitions & Implementation
 // ------------------------------------------------------------
 
-template <typename T>
-class LvnComponentArray;
-class LvnIComponentArray;
-class LvnComponentManager;
+struct LvnComponentInfo;
+struct LvnArchetypeChunk;
+struct LvnArchetype;
+struct LvnEntityRecord;
+struct LvnEcsWorld;
+template <typename... Ts> class LvnEcsView;
+template <typename... Ts> class LvnEcsGroup;
+struct LvnEcsSchedule;
+struct LvnEcsCommandBuffer;
 typedef size_t LvnTypeId;
-typedef size_t LvnEntity;
+typedef uint64_t LvnEntity;                         /* index in the low LVN_ENTITY_INDEX_BITS, generation of the index in the high bits, 0 is never a valid entity */
 
+#define LVN_ENTITY_INDEX_BITS 32
+#define LVN_ENTITY_INDEX_MASK ((1ull << LVN_ENTITY_INDEX_BITS) - 1)
+#define LVN_ENTITY_PENDING_GENERATION 0xffffffffu    /* generation of the handles lvn::ecsCommandCreateEntity returns until they are played back, never given to live entities */
 
-inline LvnTypeId i_NextTypeId = 0;
+typedef void (*LvnComponentCopyFunc)(void* dst, const void* src, size_t count);
+typedef void (*LvnEcsSystemChunkFunc)(void (*func)(), uint8_t* memory, uint32_t count, const size_t* offsets);
+
+
+// -- [SUBSECT]: Component Types
+// ------------------------------------------------------------
+
+inline std::atomic<LvnTypeId> i_NextTypeId{0};      /* atomic so worlds on different threads can register new component types */
+
+// type erased operations of a component type, archetypes move and destroy components through these
+struct LvnComponentInfo
+{
+    LvnTypeId id;                                   /* dense, assigned in the order types are first used so it differs between runs */
+    uint64_t hash;                                  /* lvn::getTypeHash, stable across runs and builds of the same compiler, use it to serialize components */
+    size_t size;
+    size_t alignment;
+    void (*moveConstruct)(void* dst, void* src);
+    void (*destruct)(void* ptr);                    // nullptr for trivially destructible types
+    LvnComponentCopyFunc copyConstruct;             /* nullptr for types that cannot be copied, worlds with them cannot be cloned */
+    bool triviallyCopyable;                         /* columns are copied and serialized as raw bytes */
+};
 
 namespace lvn
 {
@@ -36,9 +73,61 @@ namespace internal
     template<typename T>
     inline LvnTypeId getTypeIdImpl()
     {
-        static const LvnTypeId id = i_NextTypeId++;
+        static const LvnTypeId id = i_NextTypeId.fetch_add(1, std::memory_order_relaxed);
         return id;
     }
+
+    /* fnv-1a of the function signature, which names the type */
+    constexpr uint64_t hashTypeSignature(const char* str)
+    {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (; *str; str++)
+        {
+            hash ^= static_cast<uint8_t>(*str);
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    constexpr uint64_t getTypeHashImpl()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return hashTypeSignature(__FUNCSIG__);
+#else
+        return hashTypeSignature(__PRETTY_FUNCTION__);
+#endif
+    }
+
+    template<typename T>
+    struct ComponentOps
+    {
+        static void moveConstruct(void* dst, void* src) { new (dst) T(static_cast<T&&>(*static_cast<T*>(src))); }
+        static void destruct(void* ptr) { static_cast<T*>(ptr)->~T(); }
+
+        /* only instantiated for copy constructible types so non copyable components can still be added one at a time */
+        static void copyConstruct(void* dst, const void* src, size_t count)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                memcpy(dst, src, count * sizeof(T));
+            }
+            else
+            {
+                for (size_t i = 0; i < count; i++)
+                    new (static_cast<T*>(dst) + i) T(static_cast<const T*>(src)[i]);
+            }
+        }
+    };
+
+    template <typename T>
+    constexpr LvnComponentCopyFunc getCopyConstruct()
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+            return &ComponentOps<T>::copyConstruct;
+        else
+            return nullptr;
+    }
 } /* namespace internal */
 
     template<typename T>
@@ -47,194 +136,853 @@ namespace internal
         return lvn::internal::getTypeIdImpl<std::remove_cv_t<std::remove_reference_t<T>>>();
     }
 
+    // compile time hash of the type name, unlike lvn::getTypeId it does not depend on the order types are used in
+    template<typename T>
+    constexpr uint64_t getTypeHash()
+    {
+        return lvn::internal::getTypeHashImpl<std::remove_cv_t<std::remove_reference_t<T>>>();
+    }
+
+    template<typename T>
+    const LvnComponentInfo* getComponentInfo()
+    {
+        using U = std::remove_cv_t<std::remove_reference_t<T>>;
+        static const LvnComponentInfo info =
+        {
+            lvn::getTypeId<U>(),
+            lvn::getTypeHash<U>(),
+            sizeof(U),
+            alignof(U),
+            &lvn::internal::ComponentOps<U>::moveConstruct,
+            std::is_trivially_destructible_v<U> ? nullptr : &lvn::internal::ComponentOps<U>::destruct,
+            lvn::internal::getCopyConstruct<U>(),
+            std::is_trivially_copyable_v<U>,
+        };
+        return &info;
+    }
+
 } /* namespace lvn */
 
 
-class LvnIComponentArray
+// -- [SUBSECT]: Archetype Storage
+// ------------------------------------------------------------
+//
+// entities with the same set of component types share an archetype, the archetype stores them in fixed size chunks
+// each chunk holds one array per component type (and one of the entities) so systems iterate contiguous columns
+// adding or removing a component moves the entity to another archetype, references to its components do not survive that
+// every component also keeps the world tick it was added and last changed at, chunks keep the newest of each per column
+// so change filters skip whole chunks, mutable access (non const views, systems, entityGetComponent) marks components changed
+
+struct LvnArchetypeChunk
 {
-public:
-    virtual ~LvnIComponentArray() = default;
-    virtual void entityDestroyed(LvnEntity entity) = 0;
+    uint8_t* memory;                                /* entity column at offset 0 followed by the component columns, their tick columns and the chunk ticks */
+    uint32_t count;
+
+    LvnEntity* entities() const { return reinterpret_cast<LvnEntity*>(memory); }
 };
 
-template <typename T>
-class LvnComponentArray : public LvnIComponentArray
+struct LvnArchetype
 {
-    static_assert(!std::is_pointer_v<T>, "cannot have pointer type as template parameter in component array");
+    LvnVector<LvnTypeId> typeIds;                   /* sorted */
+    LvnVector<const LvnComponentInfo*> components;  /* in the order of typeIds */
+    LvnVector<size_t> columnOffsets;                /* byte offset of each component column in a chunk, every column starts on a cache line */
+    LvnVector<int32_t> columnTable;                 /* column of each type id up to the largest one in the archetype, -1 where the type is missing */
+    LvnVector<size_t> tickOffsets;                  /* byte offset of the added ticks of each column in a chunk, the changed ticks follow them */
+    size_t chunkTickOffset;                         /* byte offset of the newest added and changed tick of each column in a chunk */
+    LvnVector<LvnArchetypeChunk> chunks;            /* every chunk but the last is full */
+    LvnFlatHashMap<LvnTypeId, LvnArchetype*> addEdges;     /* archetype reached by adding a component type */
+    LvnFlatHashMap<LvnTypeId, LvnArchetype*> removeEdges;  /* archetype reached by removing a component type, nullptr for no components */
+    size_t chunkSize;
+    uint32_t chunkCapacity;
+    size_t entityCount;
+    uint32_t index;                                 /* position in the archetypes of the world */
+
+    /* index into typeIds, -1 if the archetype does not have the component type */
+    int32_t column_index(LvnTypeId id) const
+    {
+        return id < columnTable.size() ? columnTable[id] : -1;
+    }
+    void* component(const LvnArchetypeChunk& chunk, uint32_t column, uint32_t row) const
+    {
+        return chunk.memory + columnOffsets[column] + row * components[column]->size;
+    }
+    uint32_t* added_ticks(const LvnArchetypeChunk& chunk, uint32_t column) const
+    {
+        return reinterpret_cast<uint32_t*>(chunk.memory + tickOffsets[column]);
+    }
+    uint32_t* changed_ticks(const LvnArchetypeChunk& chunk, uint32_t column) const
+    {
+        return reinterpret_cast<uint32_t*>(chunk.memory + tickOffsets[column]) + chunkCapacity;
+    }
+    /* [column * 2] is the newest added tick of the column, [column * 2 + 1] the newest changed tick */
+    uint32_t* chunk_ticks(const LvnArchetypeChunk& chunk) const
+    {
+        return reinterpret_cast<uint32_t*>(chunk.memory + chunkTickOffset);
+    }
+};
 
-private:
-    LvnVector<T> m_Data;
-    LvnHashMap<LvnEntity, size_t> m_EntityToIndex;
-    LvnQueue<size_t> m_AvailableIndices;
+#define LVN_ECS_RECORD_PAGE_SIZE 1024
 
-public:
-    void add_entity(LvnEntity entity, const T& comp)
+struct LvnEntityRecord
+{
+    LvnArchetype* archetype;                        /* nullptr while the entity has no components */
+    uint32_t chunk;
+    uint32_t row;
+    uint32_t generation;                            /* incremented when the entity of the index is destroyed, handles with another generation are stale */
+};
+
+struct LvnEcsRemovedComponent
+{
+    LvnEntity entity;
+    uint32_t tick;
+};
+
+// owns a set of entities and their components, worlds share nothing so separate worlds can be used on separate threads at once
+// a single world is not thread safe, the functions without a world parameter use the default world returned by lvn::getEcsWorld
+struct LvnEcsWorld
+{
+    LvnVector<LvnArchetype*> archetypes;
+    LvnFlatHashMap<LvnTypeId, LvnArchetype*> rootEdges;    /* archetype reached by adding a component type to an entity without components */
+    LvnVector<LvnEntityRecord*> recordPages;        /* sparse pages of LVN_ECS_RECORD_PAGE_SIZE records indexed by entity id, allocated on first use */
+    LvnQueue<uint32_t> availableEntityIds;          /* indices of destroyed entities */
+    size_t entityIndexId = 0;                       /* last index handed out */
+    size_t maxEntityIds = LVN_ENTITY_INDEX_MASK;
+    uint64_t generation = 0;                        /* unique across worlds, replaced when the world is cleared so views and schedules rebuild their matches */
+    uint32_t changeTick = 1;                        /* stamped on added and changed components, 0 is older than every tick */
+    LvnVector<LvnVector<LvnEcsRemovedComponent>> removedComponents; /* indexed by type id, kept until lvn::ecsWorldClearRemoved */
+    LvnVector<const LvnComponentInfo*> componentInfos; /* indexed by type id, every type stored in or registered with the world, nullptr for the others */
+    LvnVector<LvnEcsCommandBuffer*> commandBuffers; /* one per thread that recorded commands for the world, emptied by lvn::ecsWorldPlaybackCommands */
+    LvnSpinLock commandBufferLock;                  /* only taken the first time a thread records commands for the world */
+};
+
+namespace lvn
+{
+
+    LvnEcsWorld*            getEcsWorld();
+
+    inline uint32_t         entityIndex(LvnEntity entity) { return static_cast<uint32_t>(entity & LVN_ENTITY_INDEX_MASK); }
+    inline uint32_t         entityGeneration(LvnEntity entity) { return static_cast<uint32_t>(entity >> LVN_ENTITY_INDEX_BITS); }
+    inline bool             entityIsPending(LvnEntity entity) { return lvn::entityGeneration(entity) == LVN_ENTITY_PENDING_GENERATION; }
+
+namespace internal
+{
+    template <typename... Ts, size_t... I>
+    inline void ecsRunRow(void (*func)(Ts&...), uint8_t* memory, const size_t* offsets, uint32_t row, std::index_sequence<I...>)
     {
-        LVN_CORE_ASSERT(!m_EntityToIndex.contains(entity), "entity already has component in component array");
+        func(reinterpret_cast<Ts*>(memory + offsets[I])[row]...);
+    }
 
-        if (!m_AvailableIndices.empty())
+    template <typename F, typename... Ts>
+    inline void ecsRunColumns(F& func, uint32_t count, Ts*... columns)
+    {
+        for (uint32_t row = 0; row < count; row++)
+            func(columns[row]...);
+    }
+
+    template <typename F, typename... Ts>
+    inline void ecsRunEntityColumns(F& func, uint32_t count, const LvnEntity* entities, Ts*... columns)
+    {
+        for (uint32_t row = 0; row < count; row++)
+            func(entities[row], columns[row]...);
+    }
+
+    inline void ecsPrefetch(const void* ptr)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(ptr);
+#else
+        (void)ptr;
+#endif
+    }
+
+    /* wrap safe tick comparison, true if tick is newer than since */
+    inline bool ecsTickNewer(uint32_t tick, uint32_t since)
+    {
+        return static_cast<int32_t>(tick - since) > 0;
+    }
+
+    /* stamps rows [first, first + count) of a column as changed at tick */
+    inline void ecsMarkChanged(const LvnArchetype* archetype, const LvnArchetypeChunk& chunk, uint32_t column, uint32_t first, uint32_t count, uint32_t tick)
+    {
+        uint32_t* ticks = archetype->changed_ticks(chunk, column);
+        for (uint32_t row = first; row < first + count; row++)
+            ticks[row] = tick;
+        archetype->chunk_ticks(chunk)[column * 2 + 1] = tick;
+    }
+
+    /* runs a system function of type void(*)(Ts&...) over one chunk, func is stored type erased by the schedule */
+    template <typename... Ts>
+    struct EcsSystemOps
+    {
+        static void runChunk(void (*func)(), uint8_t* memory, uint32_t count, const size_t* offsets)
         {
-            const size_t index = m_AvailableIndices.front();
-            m_AvailableIndices.pop();
-            m_Data[index] = comp;
-            m_EntityToIndex[entity] = index;
-            return;
+            run(func, memory, count, offsets, std::index_sequence_for<Ts...>{});
         }
 
-        m_Data.push_back(comp);
-        m_EntityToIndex[entity] = m_Data.size() - 1;
+        template <size_t... I>
+        static void run(void (*func)(), uint8_t* memory, uint32_t count, const size_t* offsets, std::index_sequence<I...>)
+        {
+            void (*system)(Ts&...) = reinterpret_cast<void (*)(Ts&...)>(func);
+            lvn::internal::ecsRunColumns(system, count, reinterpret_cast<Ts*>(memory + offsets[I])...);
+        }
+    };
+
+    /* fills the columns and chunk offsets of the component types, returns false if the archetype is missing one of them */
+    inline bool ecsGetColumns(const LvnArchetype* archetype, const LvnTypeId* ids, size_t count, uint32_t* columns, size_t* offsets)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            int32_t column = archetype->column_index(ids[i]);
+            if (column < 0) { return false; }
+            columns[i] = static_cast<uint32_t>(column);
+            offsets[i] = archetype->columnOffsets[column];
+        }
+        return true;
     }
+} /* namespace internal */
+
+} /* namespace lvn */
+
+
+// -- [SUBSECT]: Views
+// ------------------------------------------------------------
+//
+// a view walks every archetype that has all of its component types, the matching archetypes and their column offsets are
+// cached in the view and extended when archetypes are created so iterating only reads the component columns sequentially
+// keep a view around between frames to avoid matching again, do not add or remove components while iterating it
+
+template <typename... Ts>
+class LvnEcsView
+{
+    static_assert(sizeof...(Ts) > 0, "view must have at least one component type");
+
+private:
+    struct Match
+    {
+        const LvnArchetype* archetype;
+        uint32_t columns[sizeof...(Ts)];
+        size_t offsets[sizeof...(Ts)];
+    };
+
+    static constexpr bool s_Writes[] = { !std::is_const_v<Ts>... };
 
-    void remove_entity(LvnEntity entity)
+    LvnEcsWorld* m_World;
+    LvnVector<Match> m_Matches;
+    size_t m_ArchetypeCount;
+    uint64_t m_Generation;
+
+    void update()
     {
-        LVN_CORE_ASSERT(m_EntityToIndex.contains(entity), "entity not found within component array");
+        LvnEcsWorld* world = m_World;
+        if (m_Generation != world->generation)
+        {
+            m_Matches.clear();
+            m_ArchetypeCount = 0;
+            m_Generation = world->generation;
+        }
 
-        const size_t index = m_EntityToIndex[entity];
-        LVN_CORE_ASSERT(index < m_Data.size(), "index out of vector size range");
+        // archetypes are only appended until the next generation so only the new ones need matching
+        const LvnTypeId ids[] = { lvn::getTypeId<Ts>()... };
+        for (; m_ArchetypeCount < world->archetypes.size(); m_ArchetypeCount++)
+        {
+            Match match;
+            match.archetype = world->archetypes[m_ArchetypeCount];
+            if (lvn::internal::ecsGetColumns(match.archetype, ids, sizeof...(Ts), match.columns, match.offsets))
+                m_Matches.push_back(match);
+        }
+    }
 
-        m_AvailableIndices.push(index);
-        m_EntityToIndex.erase(entity);
+    /* components the view can write are marked changed once they were handed out */
+    void mark_writes(const Match& match, const LvnArchetypeChunk& chunk, uint32_t first, uint32_t count)
+    {
+        for (size_t i = 0; i < sizeof...(Ts); i++)
+        {
+            if (s_Writes[i])
+                lvn::internal::ecsMarkChanged(match.archetype, chunk, match.columns[i], first, count, m_World->changeTick);
+        }
     }
 
-    T& get_entity_component(LvnEntity entity)
+    template <typename F, size_t... I>
+    void each_impl(F& func, std::index_sequence<I...>)
     {
-        LVN_CORE_ASSERT(m_EntityToIndex.contains(entity), "entity not found within component array");
+        for (size_t i = 0; i < m_Matches.size(); i++)
+        {
+            const Match& match = m_Matches[i];
+            for (size_t j = 0; j < match.archetype->chunks.size(); j++)
+            {
+                const LvnArchetypeChunk& chunk = match.archetype->chunks[j];
+                lvn::internal::ecsRunColumns(func, chunk.count, reinterpret_cast<Ts*>(chunk.memory + match.offsets[I])...);
+                mark_writes(match, chunk, 0, chunk.count);
+            }
+        }
+    }
 
-        const size_t index = m_EntityToIndex[entity];
-        LVN_CORE_ASSERT(index < m_Data.size(), "index out of vector size range");
+    template <typename F, size_t... I>
+    void each_entity_impl(F& func, std::index_sequence<I...>)
+    {
+        for (size_t i = 0; i < m_Matches.size(); i++)
+        {
+            const Match& match = m_Matches[i];
+            for (size_t j = 0; j < match.archetype->chunks.size(); j++)
+            {
+                const LvnArchetypeChunk& chunk = match.archetype->chunks[j];
+                lvn::internal::ecsRunEntityColumns(func, chunk.count, chunk.entities(), reinterpret_cast<Ts*>(chunk.memory + match.offsets[I])...);
+                mark_writes(match, chunk, 0, chunk.count);
+            }
+        }
+    }
 
-        return m_Data[index];
+    template <typename F, size_t... I>
+    void each_chunk_impl(F& func, std::index_sequence<I...>)
+    {
+        for (size_t i = 0; i < m_Matches.size(); i++)
+        {
+            const Match& match = m_Matches[i];
+            for (size_t j = 0; j < match.archetype->chunks.size(); j++)
+            {
+                const LvnArchetypeChunk& chunk = match.archetype->chunks[j];
+                func(chunk.count, static_cast<const LvnEntity*>(chunk.entities()), reinterpret_cast<Ts*>(chunk.memory + match.offsets[I])...);
+                mark_writes(match, chunk, 0, chunk.count);
+            }
+        }
     }
 
-    bool has_entity_with_component(LvnEntity entity)
+    /* rows whose filter component was added (tickIndex 0) or changed (tickIndex 1) after since */
+    template <typename F, size_t... I>
+    void each_since_impl(F& func, LvnTypeId filterId, uint32_t tickIndex, uint32_t since, std::index_sequence<I...>)
     {
-        return m_EntityToIndex.contains(entity);
+        for (size_t i = 0; i < m_Matches.size(); i++)
+        {
+            const Match& match = m_Matches[i];
+            int32_t filter = match.archetype->column_index(filterId);
+            if (filter < 0) { continue; }
+
+            for (size_t j = 0; j < match.archetype->chunks.size(); j++)
+            {
+                const LvnArchetypeChunk& chunk = match.archetype->chunks[j];
+                if (!lvn::internal::ecsTickNewer(match.archetype->chunk_ticks(chunk)[filter * 2 + tickIndex], since))
+                    continue;
+
+                const uint32_t* ticks = tickIndex == 0 ? match.archetype->added_ticks(chunk, filter) : match.archetype->changed_ticks(chunk, filter);
+                for (uint32_t row = 0; row < chunk.count; row++)
+                {
+                    if (!lvn::internal::ecsTickNewer(ticks[row], since))
+                        continue;
+
+                    func(reinterpret_cast<Ts*>(chunk.memory + match.offsets[I])[row]...);
+                    mark_writes(match, chunk, row, 1);
+                }
+            }
+        }
     }
 
-    virtual void entityDestroyed(LvnEntity entity) override
+public:
+    explicit LvnEcsView(LvnEcsWorld* world = lvn::getEcsWorld()) : m_World(world), m_ArchetypeCount(0), m_Generation(world->generation) { update(); }
+
+    /* func(Ts&...) for every matching entity */
+    template <typename F>
+    void each(F&& func) { update(); each_impl(func, std::index_sequence_for<Ts...>{}); }
+
+    /* func(LvnEntity, Ts&...) for every matching entity */
+    template <typename F>
+    void each_entity(F&& func) { update(); each_entity_impl(func, std::index_sequence_for<Ts...>{}); }
+
+    /* func(uint32_t count, const LvnEntity* entities, Ts*... columns) for every chunk of the matching archetypes */
+    template <typename F>
+    void each_chunk(F&& func) { update(); each_chunk_impl(func, std::index_sequence_for<Ts...>{}); }
+
+    /* func(Ts&...) for matching entities whose T was added after the tick since, T does not have to be one of Ts */
+    template <typename T, typename F>
+    void each_added(uint32_t since, F&& func) { update(); each_since_impl(func, lvn::getTypeId<T>(), 0, since, std::index_sequence_for<Ts...>{}); }
+
+    /* func(Ts&...) for matching entities whose T was added or changed after the tick since */
+    template <typename T, typename F>
+    void each_changed(uint32_t since, F&& func) { update(); each_since_impl(func, lvn::getTypeId<T>(), 1, since, std::index_sequence_for<Ts...>{}); }
+
+    /* number of entities the view iterates */
+    size_t size()
     {
-        if (has_entity_with_component(entity))
-            remove_entity(entity);
+        update();
+        size_t count = 0;
+        for (size_t i = 0; i < m_Matches.size(); i++)
+            count += m_Matches[i].archetype->entityCount;
+        return count;
     }
 };
 
-class LvnComponentManager
+
+// -- [SUBSECT]: Groups
+// ------------------------------------------------------------
+//
+// a group keeps the column pointers of every chunk it matches in one flat table, iterating walks the table without looking at
+// archetypes or column offsets and prefetches the columns of the next chunk while the current one runs
+// columns start on a cache line in every chunk so the loops of each_chunk can use aligned simd loads
+// the table is only rebuilt when a matched archetype gains or loses a chunk, keep groups for the hot multi component systems
+// the same rules as views apply, do not add or remove components while iterating a group
+
+template <typename... Ts>
+class LvnEcsGroup
 {
-private:
-    LvnHashMap<LvnTypeId, LvnUniquePtr<LvnIComponentArray>> m_Components;
-    LvnVector<LvnDoublePair<LvnTypeId, LvnIComponentArray*>> m_ComponentArray;
+    static_assert(sizeof...(Ts) > 0, "group must have at least one component type");
 
-public:
-    template <typename T>
-    void add_component()
+private:
+    struct Match
     {
-        LvnTypeId id = lvn::getTypeId<T>();
-        m_Components[id] = lvn::makeUniquePtr<LvnComponentArray<T>>();
-        m_ComponentArray.push_back(LvnDoublePair<LvnTypeId, LvnIComponentArray*>{id, m_Components[id].get()});
-    }
+        const LvnArchetype* archetype;
+        uint32_t columns[sizeof...(Ts)];
+        size_t offsets[sizeof...(Ts)];
+        const LvnArchetypeChunk* chunks;            /* chunks of the archetype when the table was built, a new array, count or last chunk means a rebuild */
+        size_t chunkCount;
+        const uint8_t* lastMemory;                  /* only the last chunk is ever freed or allocated */
+    };
+
+    struct Entry
+    {
+        const LvnArchetypeChunk* chunk;
+        uint32_t match;
+        void* columns[sizeof...(Ts)];
+    };
 
-    template <typename T>
-    void remove_component()
+    static constexpr bool s_Writes[] = { !std::is_const_v<Ts>... };
+
+    LvnEcsWorld* m_World;
+    LvnVector<Match> m_Matches;
+    LvnVector<Entry> m_Entries;
+    size_t m_ArchetypeCount;
+    uint64_t m_Generation;
+
+    void update()
     {
-        LVN_CORE_ASSERT(m_Components.contains(lvn::getTypeId<T>()), "component not found within registry");
-        LvnTypeId id = lvn::getTypeId<T>();
-        m_Components.erase(id);
-        for (size_t i = 0; i < m_ComponentArray.size(); i++)
+        LvnEcsWorld* world = m_World;
+        bool rebuild = false;
+        if (m_Generation != world->generation)
+        {
+            m_Matches.clear();
+            m_Entries.clear();
+            m_ArchetypeCount = 0;
+            m_Generation = world->generation;
+        }
+
+        const LvnTypeId ids[] = { lvn::getTypeId<Ts>()... };
+        for (; m_ArchetypeCount < world->archetypes.size(); m_ArchetypeCount++)
+        {
+            Match match;
+            match.archetype = world->archetypes[m_ArchetypeCount];
+            match.chunks = nullptr;
+            match.chunkCount = 0;
+            match.lastMemory = nullptr;
+            if (lvn::internal::ecsGetColumns(match.archetype, ids, sizeof...(Ts), match.columns, match.offsets))
+                m_Matches.push_back(match);
+        }
+
+        // column pointers stay valid until the chunks of their archetype change
+        for (size_t i = 0; i < m_Matches.size(); i++)
+        {
+            Match& match = m_Matches[i];
+            const LvnVector<LvnArchetypeChunk>& chunks = match.archetype->chunks;
+            const uint8_t* lastMemory = chunks.empty() ? nullptr : chunks.back().memory;
+            if (match.chunks != chunks.data() || match.chunkCount != chunks.size() || match.lastMemory != lastMemory)
+            {
+                match.chunks = chunks.data();
+                match.chunkCount = chunks.size();
+                match.lastMemory = lastMemory;
+                rebuild = true;
+            }
+        }
+
+        if (!rebuild) { return; }
+
+        m_Entries.clear();
+        for (size_t i = 0; i < m_Matches.size(); i++)
         {
-            if (m_ComponentArray[i].first == id)
+            const Match& match = m_Matches[i];
+            for (size_t j = 0; j < match.chunkCount; j++)
             {
-                m_ComponentArray.erase_index(i);
-                break;
+                Entry entry;
+                entry.chunk = &match.chunks[j];
+                entry.match = static_cast<uint32_t>(i);
+                for (size_t k = 0; k < sizeof...(Ts); k++)
+                    entry.columns[k] = match.chunks[j].memory + match.offsets[k];
+                m_Entries.push_back(entry);
             }
         }
     }
 
-    template <typename T>
-    LvnComponentArray<T>& get_component()
+    void mark_writes(const Entry& entry)
     {
-        LVN_CORE_ASSERT(m_Components.contains(lvn::getTypeId<T>()), "component not found within registry");
-        return *static_cast<LvnComponentArray<T>*>(m_Components[lvn::getTypeId<T>()].get());
+        const Match& match = m_Matches[entry.match];
+        for (size_t i = 0; i < sizeof...(Ts); i++)
+        {
+            if (s_Writes[i])
+                lvn::internal::ecsMarkChanged(match.archetype, *entry.chunk, match.columns[i], 0, entry.chunk->count, m_World->changeTick);
+        }
     }
 
-    template <typename T>
-    bool has_component()
+    void prefetch(size_t index) const
     {
-        return m_Components.contains(lvn::getTypeId<T>());
+        if (index >= m_Entries.size()) { return; }
+
+        for (size_t i = 0; i < sizeof...(Ts); i++)
+            lvn::internal::ecsPrefetch(m_Entries[index].columns[i]);
     }
 
-    auto begin() { return m_ComponentArray.begin(); }
-    auto end()   { return m_ComponentArray.end(); }
+    template <typename F, size_t... I>
+    void each_impl(F& func, std::index_sequence<I...>)
+    {
+        for (size_t i = 0; i < m_Entries.size(); i++)
+        {
+            const Entry& entry = m_Entries[i];
+            prefetch(i + 1);
+            lvn::internal::ecsRunColumns(func, entry.chunk->count, static_cast<Ts*>(entry.columns[I])...);
+            mark_writes(entry);
+        }
+    }
+
+    template <typename F, size_t... I>
+    void each_chunk_impl(F& func, std::index_sequence<I...>)
+    {
+        for (size_t i = 0; i < m_Entries.size(); i++)
+        {
+            const Entry& entry = m_Entries[i];
+            prefetch(i + 1);
+            func(entry.chunk->count, static_cast<const LvnEntity*>(entry.chunk->entities()), static_cast<Ts*>(entry.columns[I])...);
+            mark_writes(entry);
+        }
+    }
+
+public:
+    explicit LvnEcsGroup(LvnEcsWorld* world = lvn::getEcsWorld()) : m_World(world), m_ArchetypeCount(0), m_Generation(world->generation) { update(); }
+
+    /* func(Ts&...) for every matching entity */
+    template <typename F>
+    void each(F&& func) { update(); each_impl(func, std::index_sequence_for<Ts...>{}); }
+
+    /* func(uint32_t count, const LvnEntity* entities, Ts*... columns) for every matching chunk, each column is cache line aligned */
+    template <typename F>
+    void each_chunk(F&& func) { update(); each_chunk_impl(func, std::index_sequence_for<Ts...>{}); }
+
+    /* number of chunks the group iterates */
+    size_t chunk_count() { update(); return m_Entries.size(); }
+
+    /* number of entities the group iterates */
+    size_t size()
+    {
+        update();
+        size_t count = 0;
+        for (size_t i = 0; i < m_Matches.size(); i++)
+            count += m_Matches[i].archetype->entityCount;
+        return count;
+    }
 };
 
+
 namespace lvn
 {
     // ------------------------------------------------------------
     // [SECTION]: ECS Functions
     // ------------------------------------------------------------
 
+    LvnEcsWorld*            ecsCreateWorld();
+    void                    ecsDestroyWorld(LvnEcsWorld* world);
+    void                    ecsWorldClear(LvnEcsWorld* world);                                       // destroys every entity and component of the world
+    LvnEcsWorld*            getEcsWorld();                                                           // the default world
+    void                    ecsRestart();                                                            // clears the default world
+
+    LvnEntity               createEntity(LvnEcsWorld* world);
+    void                    createEntities(LvnEcsWorld* world, LvnEntity* pEntities, uint32_t count);
+    void                    destroyEntity(LvnEcsWorld* world, LvnEntity entity);
+    bool                    entityIsAlive(LvnEcsWorld* world, LvnEntity entity);                     // false for destroyed (stale) handles even after their index is reused
+    void                    setMaxEntityIdCount(LvnEcsWorld* world, size_t max);
+    size_t                  getMaxEntityIdCount(LvnEcsWorld* world);
+
     LvnEntity               createEntity();
+    void                    createEntities(LvnEntity* pEntities, uint32_t count);
     void                    destroyEntity(LvnEntity entity);
+    bool                    entityIsAlive(LvnEntity entity);
     void                    setMaxEntityIdCount(size_t max);
     size_t                  getMaxEntityIdCount();
-    LvnComponentManager*    getComponentManager();
-    void                    ecsRestart();
+
+    // type erased component functions used by the templates below
+    void*                   entityAddComponentStorage(LvnEcsWorld* world, LvnEntity entity, const LvnComponentInfo* info); // moves the entity to the archetype with the component, returns uninitialized storage for it
+    void                    entityRemoveComponentId(LvnEcsWorld* world, LvnEntity entity, LvnTypeId id);
+    void*                   entityGetComponentId(LvnEcsWorld* world, LvnEntity entity, LvnTypeId id, bool markChanged = false); // nullptr if the entity does not have the component
+    const LvnEntityRecord&  entityGetRecord(LvnEcsWorld* world, LvnEntity entity);
+    void                    entityAddComponentsId(LvnEcsWorld* world, const LvnEntity* pEntities, uint32_t count, const LvnComponentInfo* info, const void* pValues, LvnComponentCopyFunc copy); // copy is called once per run of rows that land next to each other
 
 
     template <typename T>
-    void entityAddComponent(LvnEntity entity, const T& comp)
+    void entityAddComponent(LvnEcsWorld* world, LvnEntity entity, const T& comp)
     {
-        LvnComponentManager* compManager = lvn::getComponentManager();
-        if (!compManager->has_component<T>())
-            compManager->add_component<T>();
+        void* storage = lvn::entityAddComponentStorage(world, entity, lvn::getComponentInfo<T>());
+        new (storage) T(comp);
+    }
 
-        LvnComponentArray<T>& compArray = compManager->get_component<T>();
-        compArray.add_entity(entity, comp);
+    template <typename T, typename... Args>
+    void entityAddComponent(LvnEcsWorld* world, LvnEntity entity, const T& comp, const Args&... args)
+    {
+        lvn::entityAddComponent(world, entity, comp);
+        entityAddComponent(world, entity, args...);
     }
 
     template <typename T, typename... Args>
     void entityAddComponent(LvnEntity entity, const T& comp, const Args&... args)
     {
-        LvnComponentManager* compManager = lvn::getComponentManager();
-        if (!compManager->has_component<T>())
-            compManager->add_component<T>();
+        lvn::entityAddComponent(lvn::getEcsWorld(), entity, comp, args...);
+    }
 
-        LvnComponentArray<T>& compArray = compManager->get_component<T>();
-        compArray.add_entity(entity, comp);
+    // adds pValues[i] to pEntities[i], entities that share an archetype get their components with one copy per chunk
+    template <typename T>
+    void entityAddComponents(LvnEcsWorld* world, const LvnEntity* pEntities, const T* pValues, uint32_t count)
+    {
+        lvn::entityAddComponentsId(world, pEntities, count, lvn::getComponentInfo<T>(), pValues, &lvn::internal::ComponentOps<std::remove_cv_t<T>>::copyConstruct);
+    }
 
-        entityAddComponent(entity, args...);
+    template <typename T>
+    void entityAddComponents(const LvnEntity* pEntities, const T* pValues, uint32_t count)
+    {
+        lvn::entityAddComponents(lvn::getEcsWorld(), pEntities, pValues, count);
     }
 
     template <typename T>
-    void entityRemoveComponent(LvnEntity entity)
+    void entityRemoveComponent(LvnEcsWorld* world, LvnEntity entity)
     {
-        LvnComponentArray<T>& compArray = lvn::getComponentManager()->get_component<T>();
-        compArray.remove_entity(entity);
+        lvn::entityRemoveComponentId(world, entity, lvn::getTypeId<T>());
     }
 
     template <typename T, typename T2, typename... Args>
+    void entityRemoveComponent(LvnEcsWorld* world, LvnEntity entity)
+    {
+        lvn::entityRemoveComponentId(world, entity, lvn::getTypeId<T>());
+        entityRemoveComponent<T2, Args...>(world, entity);
+    }
+
+    template <typename T, typename... Args>
     void entityRemoveComponent(LvnEntity entity)
     {
-        LvnComponentArray<T>& compArray = lvn::getComponentManager()->get_component<T>();
-        compArray.remove_entity(entity);
+        lvn::entityRemoveComponent<T, Args...>(lvn::getEcsWorld(), entity);
+    }
 
-        entityRemoveComponent<T2, Args...>(entity);
+    template <typename T>
+    T& entityGetComponent(LvnEcsWorld* world, LvnEntity entity)
+    {
+        // mutable access counts as a change, request const T to read without marking
+        void* comp = lvn::entityGetComponentId(world, entity, lvn::getTypeId<T>(), !std::is_const_v<T>);
+        LVN_CORE_ASSERT(comp != nullptr, "entity does not have component");
+        return *static_cast<T*>(comp);
     }
 
     template <typename T>
     T& entityGetComponent(LvnEntity entity)
     {
-        LvnComponentArray<T>& compArray = lvn::getComponentManager()->get_component<T>();
-        return compArray.get_entity_component(entity);
+        return lvn::entityGetComponent<T>(lvn::getEcsWorld(), entity);
+    }
+
+    template <typename T>
+    bool entityHasComponent(LvnEcsWorld* world, LvnEntity entity)
+    {
+        return lvn::entityGetComponentId(world, entity, lvn::getTypeId<T>()) != nullptr;
+    }
+
+    template <typename T>
+    bool entityHasComponent(LvnEntity entity)
+    {
+        return lvn::entityHasComponent<T>(lvn::getEcsWorld(), entity);
+    }
+
+    // every entity passed in must have all the components of the function parameters
+    template <typename T>
+    void entityMarkChanged(LvnEcsWorld* world, LvnEntity entity)
+    {
+        void* comp = lvn::entityGetComponentId(world, entity, lvn::getTypeId<T>(), true);
+        LVN_CORE_ASSERT(comp != nullptr, "entity does not have component");
+    }
+
+    template <typename T>
+    void entityMarkChanged(LvnEntity entity)
+    {
+        lvn::entityMarkChanged<T>(lvn::getEcsWorld(), entity);
     }
 
     template <typename... Ts>
-    void entityUpdateSystem(LvnEntity* pEntities, size_t entityCount, void (*func)(Ts&...))
+    void entityUpdateSystem(LvnEcsWorld* world, LvnEntity* pEntities, size_t entityCount, void (*func)(Ts&...))
     {
+        static_assert(sizeof...(Ts) > 0, "system function must take at least one component");
+
+        const LvnTypeId ids[] = { lvn::getTypeId<Ts>()... };
+        const bool writes[] = { !std::is_const_v<Ts>... };
+        uint32_t columns[sizeof...(Ts)];
+        size_t offsets[sizeof...(Ts)];
+        const LvnArchetype* archetype = nullptr;
+
+        // column offsets are looked up again only when the archetype changes between entities
         for (size_t i = 0; i < entityCount; i++)
         {
-            func(lvn::entityGetComponent<Ts>(pEntities[i])...);
+            const LvnEntityRecord& record = lvn::entityGetRecord(world, pEntities[i]);
+            if (record.archetype != archetype)
+            {
+                archetype = record.archetype;
+                bool found = archetype && lvn::internal::ecsGetColumns(archetype, ids, sizeof...(Ts), columns, offsets);
+                LVN_CORE_ASSERT(found, "entity does not have every component of the system");
+            }
+
+            const LvnArchetypeChunk& chunk = archetype->chunks[record.chunk];
+            lvn::internal::ecsRunRow(func, chunk.memory, offsets, record.row, std::index_sequence_for<Ts...>{});
+
+            for (size_t j = 0; j < sizeof...(Ts); j++)
+            {
+                if (writes[j])
+                    lvn::internal::ecsMarkChanged(archetype, chunk, columns[j], record.row, 1, world->changeTick);
+            }
+        }
+    }
+
+    template <typename... Ts>
+    void entityUpdateSystem(LvnEntity* pEntities, size_t entityCount, void (*func)(Ts&...))
+    {
+        lvn::entityUpdateSystem(lvn::getEcsWorld(), pEntities, entityCount, func);
+    }
+
+    template <typename... Ts>
+    LvnEcsView<Ts...> view(LvnEcsWorld* world = lvn::getEcsWorld())
+    {
+        return LvnEcsView<Ts...>(world);
+    }
+
+    template <typename... Ts>
+    LvnEcsGroup<Ts...> group(LvnEcsWorld* world = lvn::getEcsWorld())
+    {
+        return LvnEcsGroup<Ts...>(world);
+    }
+
+    // runs func for every entity that has all the components of the function parameters, no entity list needed
+    template <typename... Ts>
+    void ecsForEach(void (*func)(Ts&...), LvnEcsWorld* world = lvn::getEcsWorld())
+    {
+        LvnEcsView<Ts...>(world).each(func);
+    }
+
+    // passes whole component columns of each chunk, suited for loops the compiler can vectorize
+    template <typename... Ts>
+    void ecsForEachChunk(void (*func)(uint32_t count, const LvnEntity* entities, Ts*... columns), LvnEcsWorld* world = lvn::getEcsWorld())
+    {
+        LvnEcsView<Ts...>(world).each_chunk(func);
+    }
+
+
+    // change ticks, an incremental system reads changes after the tick it last ran at then advances the tick so its own writes
+    // and the writes of systems before it are not seen again, eg. view.each_changed<Transform>(lastTick, func); lastTick = lvn::ecsWorldAdvanceTick(world);
+    uint32_t                ecsWorldGetTick(LvnEcsWorld* world);
+    uint32_t                ecsWorldAdvanceTick(LvnEcsWorld* world);                                  // returns the tick that was current and starts the next one
+    const LvnEcsRemovedComponent* ecsGetRemovedId(LvnEcsWorld* world, LvnTypeId id, uint32_t* count);  // components removed from entities (or destroyed with them) since the last clear, oldest first
+    void                    ecsWorldClearRemoved(LvnEcsWorld* world, uint32_t tick);                  // forgets removals up to and including tick once every consumer has seen them
+
+    // func(LvnEntity) for every entity that lost its T after the tick since
+    template <typename T, typename F>
+    void ecsForEachRemoved(LvnEcsWorld* world, uint32_t since, F&& func)
+    {
+        uint32_t count = 0;
+        const LvnEcsRemovedComponent* removed = lvn::ecsGetRemovedId(world, lvn::getTypeId<T>(), &count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (lvn::internal::ecsTickNewer(removed[i].tick, since))
+                func(removed[i].entity);
         }
     }
+
+
+    // -- [SUBSECT]: System Scheduling
+    // ------------------------------------------------------------
+    //
+    // a schedule runs its systems on the job system, a system reads the components it takes by const reference and writes the others
+    // systems that write a component another system reads or writes run in the order they were added, the rest run in parallel
+    // the chunks each system matches are run as separate jobs, entities must not be created or change components while the schedule runs,
+    // systems record those changes in a command buffer instead which the schedule plays back once every system has finished
+    // a schedule can run different worlds but only one at a time, use a schedule per thread to step worlds in parallel
+
+    LvnEcsSchedule*         ecsCreateSchedule();
+    void                    ecsDestroySchedule(LvnEcsSchedule* schedule);
+    void                    ecsScheduleRun(LvnEcsSchedule* schedule, LvnEcsWorld* world);              // runs every system once over the world and returns when all have finished, requires a context
+    void                    ecsScheduleRun(LvnEcsSchedule* schedule);                                  // runs over the default world
+    uint32_t                ecsScheduleAddSystemId(LvnEcsSchedule* schedule, const char* name, const LvnTypeId* ids, const bool* writes, uint32_t count, void (*func)(), LvnEcsSystemChunkFunc runChunk); // type erased, returns the index of the system
+
+    template <typename... Ts>
+    uint32_t ecsScheduleAddSystem(LvnEcsSchedule* schedule, const char* name, void (*func)(Ts&...))
+    {
+        static_assert(sizeof...(Ts) > 0, "system function must take at least one component");
+
+        const LvnTypeId ids[] = { lvn::getTypeId<Ts>()... };
+        const bool writes[] = { !std::is_const_v<Ts>... };
+        return lvn::ecsScheduleAddSystemId(schedule, name, ids, writes, sizeof...(Ts), reinterpret_cast<void (*)()>(func), &lvn::internal::EcsSystemOps<Ts...>::runChunk);
+    }
+
+
+    // -- [SUBSECT]: Command Buffers
+    // ------------------------------------------------------------
+    //
+    // a command buffer records structural changes (creating and destroying entities, adding and removing components) to apply later
+    // every thread gets its own buffer per world so systems running in parallel record without locking
+    // playback applies the commands of every buffer in bulk, grouped by kind and component type and ordered by the archetype of the entity
+    // so entities moving between the same two archetypes reuse the lookup and fill the destination chunks in sequence:
+    // entities are created first, then components are added, then removed, then entities are destroyed
+    // so a remove wins over an add of the same component and a destroy wins over both, adding a component the entity already has replaces it
+    // commands for entities that are no longer alive at playback are dropped
+
+    LvnEcsCommandBuffer*    ecsGetCommandBuffer(LvnEcsWorld* world);                                   // the command buffer of the calling thread for the world, created on first use
+    LvnEcsCommandBuffer*    ecsGetCommandBuffer();                                                     // for the world of the schedule running the calling system, the default world outside of systems
+    void                    ecsWorldPlaybackCommands(LvnEcsWorld* world);                              // applies and empties every command buffer of the world, no thread may record while it runs
+    LvnEntity               ecsCommandCreateEntity(LvnEcsCommandBuffer* commands);                     // returns a pending handle that other commands of the same buffer can use, it becomes an entity on playback
+    void                    ecsCommandDestroyEntity(LvnEcsCommandBuffer* commands, LvnEntity entity);
+    void*                   ecsCommandAddComponentStorage(LvnEcsCommandBuffer* commands, LvnEntity entity, const LvnComponentInfo* info); // uninitialized storage for the component, it is moved into the world on playback
+    void                    ecsCommandRemoveComponentId(LvnEcsCommandBuffer* commands, LvnEntity entity, LvnTypeId id);
+    LvnEntity               ecsCommandGetEntity(LvnEcsCommandBuffer* commands, LvnEntity pending);    // the entity a pending handle of the buffer became in its last playback, 0 if it has not been played back
+
+    template <typename T>
+    void ecsCommandAddComponent(LvnEcsCommandBuffer* commands, LvnEntity entity, const T& comp)
+    {
+        void* storage = lvn::ecsCommandAddComponentStorage(commands, entity, lvn::getComponentInfo<T>());
+        new (storage) T(comp);
+    }
+
+    template <typename T, typename T2, typename... Args>
+    void ecsCommandAddComponent(LvnEcsCommandBuffer* commands, LvnEntity entity, const T& comp, const T2& comp2, const Args&... args)
+    {
+        lvn::ecsCommandAddComponent(commands, entity, comp);
+        lvn::ecsCommandAddComponent(commands, entity, comp2, args...);
+    }
+
+    template <typename T, typename... Args>
+    void ecsCommandRemoveComponent(LvnEcsCommandBuffer* commands, LvnEntity entity)
+    {
+        lvn::ecsCommandRemoveComponentId(commands, entity, lvn::getTypeId<T>());
+        if constexpr (sizeof...(Args) > 0)
+            lvn::ecsCommandRemoveComponent<Args...>(commands, entity);
+    }
+
+
+    // -- [SUBSECT]: Snapshots
+    // ------------------------------------------------------------
+    //
+    // cloning copies every chunk of a world into another, whole chunks are copied at once when every component is trivially copyable
+    // entity handles and change ticks survive so a clone can be stepped and thrown away or copied back, eg. for rollback
+    // snapshots are the same world written to bytes, they only hold trivially copyable components and find their types by lvn::getTypeHash
+    // so every component type in a snapshot must be used in or registered with the world that reads it
+    // a delta encodes the bytes that differ between two snapshots, small enough to send every frame when few components change
+
+    LvnResult               ecsWorldCopy(LvnEcsWorld* dst, const LvnEcsWorld* src);                    // replaces the contents of dst with a copy of src, fails without changing dst if a component is not copy constructible
+    LvnEcsWorld*            ecsCloneWorld(const LvnEcsWorld* src);                                     // new world with a copy of src or nullptr if it cannot be copied, destroy it with lvn::ecsDestroyWorld
+    void                    ecsRegisterComponentInfo(LvnEcsWorld* world, const LvnComponentInfo* info);
+
+    LvnBin                  ecsWorldSerialize(const LvnEcsWorld* world);                               // every component must be trivially copyable, the bytes are in the byte order of the machine
+    LvnResult               ecsWorldDeserialize(LvnEcsWorld* world, const uint8_t* data, size_t size); // replaces the contents of world, fails without changing it if the data is not a snapshot or has an unknown type
+    LvnBin                  ecsSnapshotDelta(const LvnBin& base, const LvnBin& snapshot);              // the changes that turn base into snapshot
+    LvnResult               ecsSnapshotApplyDelta(const LvnBin& base, const uint8_t* delta, size_t size, LvnBin* snapshot); // rebuilds the snapshot a delta was made from, fails if base is not the one it was made against
+
+    // lets a world deserialize snapshots with components it has not stored yet
+    template <typename T>
+    void ecsRegisterComponent(LvnEcsWorld* world = lvn::getEcsWorld())
+    {
+        lvn::ecsRegisterComponentInfo(world, lvn::getComponentInfo<T>());
+    }
 } /* namespace lvn */
 
 #endif
@@ -25,6 +25,7 @@ enum LvnAttributeLocation
     Lvn_AttributeLocation_Color,
     Lvn_AttributeLocation_TexCoords,
     Lvn_AttributeLocation_TexId,
+    Lvn_AttributeLocation_InstanceRect,
     // Lvn_AttributeLocation_Normal,
     // Lvn_AttributeLocation_Tangent,
     // Lvn_AttributeLocation_BoneIds,
@@ -36,6 +37,9 @@ enum LvnAttributeLocation
 enum LvnRenderModeEnum
 {
     Lvn_RenderMode_2d,
+    Lvn_RenderMode_2dQuad,
+    Lvn_RenderMode_2dCircle,
+    Lvn_RenderMode_2dSprite,
     Lvn_RenderMode_2dText,
 
     Lvn_RenderMode_Max_Value,
@@ -48,10 +52,17 @@ enum LvnRenderModeEnum
 
 struct LvnColor;
 struct LvnCircle;
+struct LvnParticleEmitter;
+struct LvnParticleSystem;
+struct LvnParticleSystemCreateInfo;
 struct LvnPoint;
 struct LvnRect;
 struct LvnRenderer;
+struct LvnRendererCreateInfo;
 struct LvnSprite;
+struct LvnStaticBatch;
+struct LvnTextLayout;
+struct LvnTextLayoutGlyph;
 struct LvnTriangle;
 struct LvnUVBox;
 
@@ -68,24 +79,54 @@ namespace lvn
     LVN_API void                        renderTerminate();
     LVN_API bool                        rendererIsInitialized();
     LVN_API LvnWindow*                  getRendererWindow();
+    LVN_API LvnResult                   createRenderer(LvnRenderer** renderer, const LvnRendererCreateInfo* createInfo);   // create a renderer for another window or an offscreen framebuffer, renderers share the white texture and the default font
+    LVN_API void                        destroyRenderer(LvnRenderer* renderer);
+    LVN_API void                        renderSetCurrent(LvnRenderer* renderer);           // set the renderer the draw functions go to, renderInit makes its own renderer current
+    LVN_API LvnRenderer*                renderGetCurrent();
     LVN_API bool                        renderWindowOpen();
+    LVN_API void                        renderSetFont(const LvnFont& font);                // replace the font used by the text draw functions, fonts loaded with Lvn_LoadFont_SDF are drawn with the distance field shader and stay sharp at any scale, call outside of drawBegin and drawEnd
+    LVN_API void                        renderSetDirectWrite(bool enable);                 // write draw calls straight into the mapped vertex buffer of the frame instead of the intermediate draw list, takes effect on the next drawBegin and falls back to the draw list if the graphics api cannot map the buffer
+    LVN_API void                        renderSetOnDemand(bool enable);                    // render on demand, the current renderer only needs a frame after input to its window or lvn::windowInvalidate so idle windows stop using the cpu and gpu
+    LVN_API bool                        renderWaitEvents(double timeout);                  // process window events and return whether the current renderer should draw a frame, always true without render on demand; with it the call sleeps for up to timeout seconds (negative waits without limit) until an event arrives, skip drawBegin and drawEnd when it returns false
+    LVN_API void                        renderSetRenderThread(bool enable);                // record and submit the frames of the current renderer on a dedicated render thread, drawEnd hands the frame over and returns so the next frame is recorded while the last one is submitted, takes effect on the next drawBegin; needs multithreading and vulkan, disables direct writes, and offscreen renderers of the same window cannot be used meanwhile
+    LVN_API void                        renderWaitIdle();                                  // wait until the render thread has submitted the frame handed over by the last drawEnd, call before destroying resources the frame draws with
 
     LVN_API LvnSprite                   createSprite(const LvnTextureCreateInfo& texCreateInfo, const LvnUVBox& uv);
+    LVN_API LvnSprite                   createSprite(LvnTextureAtlas* atlas, uint32_t region);                       // sprite sampling an atlas region, shares the page texture and must not be passed to destroySprite, call after lvn::textureAtlasUpdate()
     LVN_API void                        destroySprite(LvnSprite& sprite);
 
     LVN_API void                        drawBegin();
     LVN_API void                        drawEnd();
     LVN_API void                        drawClearColor(float r, float g, float b, float a);
     LVN_API void                        drawClearColor(const LvnColor& color);
+    LVN_API void                        drawSetLayer(int32_t layer);                       // set the layer of the following draws on the calling thread, higher layers are drawn on top, draws on the same layer are batched and drawn in submission order per render mode
+    LVN_API int32_t                     drawGetLayer();
+    LVN_API void                        drawPushClipRect(const LvnVec2& pos, const LvnVec2& size); // clip the following draws on the calling thread to a rect within the current clip rect, draws entirely outside of the clip rect or the render area are culled before any vertices are written
+    LVN_API void                        drawPopClipRect();                                 // restore the clip rect that was current before the last drawPushClipRect, clip rects left pushed at drawEnd are dropped
     LVN_API void                        drawTriangle(const LvnVec2& v1, const LvnVec2& v2, const LvnVec2& v3, const LvnColor& color);
     LVN_API void                        drawRect(const LvnVec2& pos, const LvnVec2& size, const LvnColor& color);
     LVN_API void                        drawRectEx(const LvnRect& rect);
+    LVN_API void                        drawSprite(const LvnSprite& sprite, const LvnVec2& pos, const LvnVec2& size, const LvnColor& color);
     LVN_API void                        drawCircle(const LvnVec2& pos, float radius, const LvnColor& color);
     LVN_API void                        drawCircleSector(const LvnVec2& pos, float radius, float startAngle, float endAngle, const LvnColor& color);
     LVN_API void                        drawPolyNgon(const LvnVec2& pos, float radius, uint32_t nSides, const LvnColor& color);
     LVN_API void                        drawPolyNgonSector(const LvnVec2& pos, float radius, float startAngle, float endAngle, uint32_t nSides, const LvnColor& color);
     LVN_API void                        drawText(const char* text, const LvnVec2& pos, const LvnColor& color, float scale);
-    LVN_API void                        drawTextEx(const char* text, const LvnVec2& pos, const LvnColor& color, float scale, float lineHeight, float textBoxWidth);
+    LVN_API void                        drawTextEx(const char* text, const LvnVec2& pos, const LvnColor& color, float scale, float lineHeight, float textBoxWidth);   // text layouts are cached across frames, repeated strings with the same parameters skip the layout
+    LVN_API LvnTextLayout               createTextLayout(const char* text, float scale, float lineHeight, float textBoxWidth);                                       // lay out text once with the default font for static text drawn every frame
+    LVN_API void                        drawTextLayout(const LvnTextLayout& layout, const LvnVec2& pos, const LvnColor& color);
+
+    LVN_API LvnResult                   createStaticBatch(LvnStaticBatch** batch);         // create a retained batch of 2d geometry for the current renderer, it is drawn with the pipelines of that renderer
+    LVN_API void                        destroyStaticBatch(LvnStaticBatch* batch);         // the batch must not be drawn by a frame that is still being submitted, call renderWaitIdle first with a render thread
+    LVN_API void                        staticBatchBegin(LvnStaticBatch* batch);           // record the following draw calls into batch instead of the frame, no other thread may draw until staticBatchEnd; can be called inside or outside of drawBegin and drawEnd, textured sprites are not recorded
+    LVN_API void                        staticBatchEnd();                                  // upload the recorded draws into a static buffer of the batch, replacing what it held before
+    LVN_API void                        drawStaticBatch(const LvnStaticBatch* batch, const LvnMat4& transform); // draw the batch on the current layer with transform applied, each render mode of the batch is one draw call and no vertices are generated
+
+    LVN_API LvnResult                   createParticleSystem(LvnParticleSystem** particleSystem, const LvnParticleSystemCreateInfo* createInfo); // create a particle system for the current renderer, particles live in a storage buffer and are simulated by a compute shader
+    LVN_API void                        destroyParticleSystem(LvnParticleSystem* particleSystem); // the system must not be drawn by a frame that is still being submitted, call renderWaitIdle first with a render thread
+    LVN_API void                        particleSystemSetEmitter(LvnParticleSystem* particleSystem, uint32_t index, const LvnParticleEmitter& emitter); // configure one of the LVN_PARTICLE_MAX_EMITTERS emitters, particles already alive take on the new acceleration, size and colors of their emitter
+    LVN_API void                        particleSystemEmit(LvnParticleSystem* particleSystem, uint32_t index, uint32_t count); // spawn a burst of count particles from an emitter with the next draw
+    LVN_API void                        drawParticleSystem(LvnParticleSystem* particleSystem, float dt); // advance the particles by dt seconds on the gpu and draw them on the current layer as instanced quads, only the first draw of a system in a frame is kept
 } /* namespace lvn */
 
 
@@ -93,11 +134,37 @@ namespace lvn
 // [SECTION]: Renderer Struct Implementation
 // ------------------------------------------------------------
 
+struct LvnRendererCreateInfo
+{
+    LvnWindow* window;               // window the renderer records its commands into
+    LvnFrameBuffer* frameBuffer;     // optional offscreen target, drawBegin and drawEnd of the renderer are then called between drawBegin and drawEnd of the renderer of the window
+};
+
 struct LvnColor
 {
     uint8_t r, g, b, a;
 };
 
+#define LVN_PARTICLE_MAX_EMITTERS 16
+
+struct LvnParticleSystemCreateInfo
+{
+    uint32_t maxParticles;           // capacity of the particle buffer, spawning into a full buffer replaces the oldest particles
+};
+
+struct LvnParticleEmitter
+{
+    LvnVec2 pos, posVariance;           // particles spawn within posVariance of pos on each axis
+    LvnVec2 velocity, velocityVariance;
+    LvnVec2 acceleration;               // constant acceleration of the particles (eg. gravity)
+    float rate;                         // particles spawned per second, 0 only spawns bursts of particleSystemEmit
+    float lifetime, lifetimeVariance;   // in seconds
+    float startSize, endSize;           // diameter of the particles, interpolated over their lifetime
+    LvnColor startColor, endColor;
+};
+
+template <> struct LvnAttributeFormatOf<LvnColor> { static constexpr LvnAttributeFormat value = Lvn_AttributeFormat_Vec4_un8; };
+
 struct LvnUVBox
 {
     float x0, y0, x1, y1;
@@ -135,4 +202,16 @@ struct LvnSprite
     LvnUVBox uv;
 };
 
+struct LvnTextLayoutGlyph
+{
+    LvnVec2 pos; // bottom left corner relative to the text position
+    LvnVec2 size;
+    LvnUVBox uv;
+};
+
+struct LvnTextLayout
+{
+    LvnVector<LvnTextLayoutGlyph> glyphs;
+};
+
 #endif
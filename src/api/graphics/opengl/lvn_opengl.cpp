@@ -7,6 +7,41 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+// s3tc and astc formats are extensions not included in the core glad header
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#endif
+
+// environment maps are baked into rgba16f textures, the bake shaders use 8x8 work groups
+#define LVN_OPENGL_ENVIRONMENT_MAP_TEXEL_SIZE (4 * sizeof(uint16_t))
+#define LVN_OPENGL_ENVIRONMENT_MAP_GROUP_SIZE (8)
+
+// timestamp queries are read back after cycling through this many frames, each frame can use up to the max queries
+#define LVN_OPENGL_TIMESTAMP_FRAMES (3)
+#define LVN_OPENGL_MAX_TIMESTAMP_QUERIES (256)
+
+// ring buffers are persistently mapped with one region per frame, a region is rewritten once the fence of the frame that last used it signals
+#define LVN_OPENGL_BUFFER_REGIONS (3)
+#define LVN_OPENGL_FENCE_WAIT_TIMEOUT (100ull * 1000 * 1000)
+
+// resources can be created from this many loader threads at once, other threads wait for a worker context to be returned
+#define LVN_OPENGL_WORKER_CONTEXTS (4)
+
 
 enum LvnVertexAttribType
 {
@@ -19,20 +54,29 @@ namespace lvn
 {
 
 static OglBackends* s_OglBackends = nullptr;
+static thread_local GLFWwindow* s_OglWorkerContext = nullptr; // worker context made current on the calling thread while it creates a resource
 
 namespace ogls
 {
     static LvnResult           checkErrorCode();
     static void GLAPIENTRY     debugCallback( GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam );
     static LvnResult           checkShaderError(uint32_t shader, GLenum type, const char* shaderSrc);;
+    static LvnResult           createComputeShader(LvnShader* shader, const char* computeSrc);
+    static uint32_t            createComputeProgram(const char* computeSrc);
+    static void                createEnvironmentMapTexture(LvnTexture* texture, GLenum target, uint32_t size, uint32_t mipLevels);
+    static void                dispatchEnvironmentMapPass(uint32_t program, uint32_t dstTexture, uint32_t mipLevel, bool layered, uint32_t size);
     static GLenum              getVertexAttributeFormatEnum(LvnAttributeFormat format);
     static LvnVertexAttribType getVertexAttribType(LvnAttributeFormat format);
     static GLenum              getTextureFilterEnum(LvnTextureFilter filter);
+    static GLenum              getTextureMipmapFilterEnum(LvnTextureFilter filter);
+    static GLenum              getCompressedTextureFormatEnum(LvnTextureCompression compression, LvnTextureFormat format);
+    static LvnResult           uploadTextureImage(uint32_t id, GLenum internalFormat, GLenum format, const LvnImageData& imageData, const LvnImageData* pMipImageData, uint32_t* mipLevels);
     static GLenum              getTextureWrapModeEnum(LvnTextureMode mode);
     static uint32_t            getSampleCountEnum(LvnSampleCount samples);
     static GLenum              getColorFormat(LvnColorImageFormat texFormat);
     static GLenum              getDataFormat(LvnColorImageFormat texFormat);
     static void                getDepthFormat(LvnDepthImageFormat texFormat, GLenum* format, GLenum* attachmentType);
+    static uint32_t            getReadPixelsFormat(LvnColorImageFormat texFormat, GLenum* format, GLenum* type);
     static GLenum              getCompareOpEnum(LvnCompareOperation compareOp);
     static GLenum              getTopologyTypeEnum(LvnTopologyType type);
     static GLenum              getBlendFactorType(LvnColorBlendFactor factor);
@@ -40,6 +84,661 @@ namespace ogls
     static GLenum              getCullFrontFaceEnum(LvnCullFrontFace frontFace);
     static GLenum              getUniformBufferTypeEnum(LvnDescriptorType type);
     static LvnResult           updateFrameBuffer(OglFramebufferData* frameBufferData);
+    static void                initDescriptorSet(OglDescriptorSet* descriptorSet, const LvnVector<LvnDescriptorBinding>& descriptorBindings);
+    static void                destroyDescriptorSet(OglDescriptorSet* descriptorSet);
+    static void                releaseBindlessTextures(OglDescriptorSet* descriptorSet);
+    static void                bindDescriptorSets(uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets);
+    static void                createPushConstantBuffer(OglPipelineEnums* pipelineEnums, const LvnPushConstantRange* pPushConstantRanges, uint32_t pushConstantRangeCount);
+    static void                pushConstants(LvnPipeline* pipeline, uint32_t offset, uint32_t size, const void* data);
+    static GLbitfield          getMemoryBarrierEnum(LvnMemoryBarrierFlagBits barriers);
+    static uint64_t            getCmdPayloadSize(uint64_t cmdSize, uint64_t payloadSize);
+    static uint8_t*            allocateCmd(LvnWindow* window, uint64_t size);
+
+    // makes a worker context current while a resource is created from a thread without a current context
+    // the uploads are fenced and waited on before the scope ends, so the resource is complete once it is handed back to the render thread
+    class OglWorkerContextScope
+    {
+    private:
+        GLFWwindow* m_Context;
+
+    public:
+        OglWorkerContextScope();
+        ~OglWorkerContextScope();
+
+        OglWorkerContextScope(const OglWorkerContextScope&) = delete;
+        OglWorkerContextScope& operator=(const OglWorkerContextScope&) = delete;
+    };
+    static uint32_t            beginTimestampScope(LvnWindow* window, const char* name);
+    static uint32_t            endTimestampScope(LvnWindow* window);
+    static void                writeTimestamp(LvnWindow* window, uint32_t query);
+    static void                readTimestampQueries(LvnWindow* window);
+    static void                readbackFrameBuffer(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData);
+    static void                readbackJob(void* userData);
+    static void                completeReadbacks(OglBackends* oglBackends, bool wait);
+    static void                destroyReadbackBuffers(OglBackends* oglBackends);
+    static uint64_t            getBufferRegionOffset(const LvnBuffer* buffer);
+    static void                waitRegionFence(OglBackends* oglBackends, uint32_t region);
+    static void                resetStateCache();
+    static void                setCapability(GLenum capability, uint32_t* cachedState, bool enable);
+    static void                setDepthMask(bool enable);
+    static void                useProgram(uint32_t program);
+    static void                bindVertexArray(uint32_t vao);
+    static void                bindTextureUnit(uint32_t unit, uint32_t texture);
+    static void                bindBufferRange(GLenum target, uint32_t binding, uint32_t buffer, uint64_t offset, uint64_t size);
+    static void                bindPipeline(LvnWindow* window, LvnPipeline* pipeline);
+
+    static void initDescriptorSet(OglDescriptorSet* descriptorSet, const LvnVector<LvnDescriptorBinding>& descriptorBindings)
+    {
+        for (const LvnDescriptorBinding& descriptorBinding : descriptorBindings)
+        {
+            LvnDescriptorType descriptorType = descriptorBinding.descriptorType;
+
+            if (descriptorType == Lvn_DescriptorType_UniformBuffer || descriptorType == Lvn_DescriptorType_UniformBufferDynamic || descriptorType == Lvn_DescriptorType_StorageBuffer)
+            {
+                OglDescriptorBinding oglBinding{};
+                oglBinding.type = descriptorType;
+                oglBinding.binding = descriptorBinding.binding;
+                descriptorSet->uniformBuffers.push_back(oglBinding);
+
+                // keep buffers sorted by binding so dynamic offsets are consumed in binding order
+                for (uint32_t k = descriptorSet->uniformBuffers.size() - 1; k > 0 && descriptorSet->uniformBuffers[k - 1].binding > oglBinding.binding; k--)
+                {
+                    descriptorSet->uniformBuffers[k] = descriptorSet->uniformBuffers[k - 1];
+                    descriptorSet->uniformBuffers[k - 1] = oglBinding;
+                }
+            }
+            else if (descriptorType == Lvn_DescriptorType_ImageSampler)
+            {
+                // sampler arrays take consecutive texture units starting from the binding, one entry per element
+                for (uint32_t k = 0; k < lvn::max(descriptorBinding.descriptorCount, 1u); k++)
+                {
+                    OglDescriptorBinding oglBinding{};
+                    oglBinding.type = descriptorType;
+                    oglBinding.binding = descriptorBinding.binding + k;
+                    oglBinding.count = 1;
+                    descriptorSet->textures.push_back(oglBinding);
+                }
+            }
+        }
+    }
+
+    static void destroyDescriptorSet(OglDescriptorSet* descriptorSet)
+    {
+        ogls::releaseBindlessTextures(descriptorSet);
+        delete descriptorSet;
+    }
+
+    static void releaseBindlessTextures(OglDescriptorSet* descriptorSet)
+    {
+        for (const OglBindlessTextureBinding& bindlessTexBinding : descriptorSet->bindlessTextures)
+        {
+            // only the current context's residency can be released, other contexts release theirs when the texture is deleted
+            for (const uint64_t& handle : bindlessTexBinding.textureHandles)
+            {
+                if (glIsTextureHandleResidentARB(handle))
+                    glMakeTextureHandleNonResidentARB(handle);
+            }
+
+            glDeleteBuffers(1, &bindlessTexBinding.ssbo);
+        }
+
+        descriptorSet->bindlessTextures.clear();
+    }
+
+    static void bindDescriptorSets(uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets)
+    {
+        OglBackends* oglBackends = s_OglBackends;
+        int texCount = 0;
+
+        uint32_t dynamicOffsetIndex = 0;
+
+        for (uint32_t i = 0; i < descriptorSetCount; i++)
+        {
+            OglDescriptorSet* descriptorSetPtr = static_cast<OglDescriptorSet*>(pDescriptorSets[i]->singleSet);
+
+            // uniform/storage buffers
+            for (uint32_t j = 0; j < descriptorSetPtr->uniformBuffers.size(); j++)
+            {
+                // dynamic uniform buffers consume the next dynamic offset, in binding order
+                uint64_t offset = descriptorSetPtr->uniformBuffers[j].offset + descriptorSetPtr->uniformBuffers[j].regionSize * oglBackends->bufferRegion;
+                if (descriptorSetPtr->uniformBuffers[j].type == Lvn_DescriptorType_UniformBufferDynamic && dynamicOffsetIndex < dynamicOffsetCount)
+                    offset += pDynamicOffsets[dynamicOffsetIndex++];
+
+                ogls::bindBufferRange(ogls::getUniformBufferTypeEnum(descriptorSetPtr->uniformBuffers[j].type),
+                    descriptorSetPtr->uniformBuffers[j].binding,
+                    descriptorSetPtr->uniformBuffers[j].id,
+                    offset,
+                    descriptorSetPtr->uniformBuffers[j].range);
+            }
+
+            // textures
+            for (uint32_t j = 0; j < descriptorSetPtr->textures.size(); j++)
+            {
+                if (texCount >= oglBackends->maxTextureUnitSlots)
+                {
+                    LVN_CORE_WARN("maximum texture unit slots exceeded, cannot bind more texture unit slots to one shader pipeline. Max slots: %u", oglBackends->maxTextureUnitSlots);
+                    return;
+                }
+
+                ogls::bindTextureUnit(descriptorSetPtr->textures[j].binding, descriptorSetPtr->textures[j].id);
+                texCount++;
+            }
+
+            // bindless textures, the whole set of handles is bound with one storage buffer instead of a texture unit per texture
+            for (uint32_t j = 0; j < descriptorSetPtr->bindlessTextures.size(); j++)
+            {
+                OglBindlessTextureBinding& bindlessTextureBinding = descriptorSetPtr->bindlessTextures[j];
+
+                GLFWwindow* context = glfwGetCurrentContext();
+                if (bindlessTextureBinding.residentContexts.find(context) == bindlessTextureBinding.residentContexts.end())
+                {
+                    for (const uint64_t& handle : bindlessTextureBinding.textureHandles)
+                    {
+                        if (!glIsTextureHandleResidentARB(handle))
+                            glMakeTextureHandleResidentARB(handle);
+                    }
+
+                    bindlessTextureBinding.residentContexts.push_back(context);
+                }
+
+                ogls::bindBufferRange(GL_SHADER_STORAGE_BUFFER, bindlessTextureBinding.binding, bindlessTextureBinding.ssbo, 0, 0);
+            }
+        }
+    }
+
+    static void createPushConstantBuffer(OglPipelineEnums* pipelineEnums, const LvnPushConstantRange* pPushConstantRanges, uint32_t pushConstantRangeCount)
+    {
+        // push constants, backed by one uniform buffer covering every range
+        for (uint32_t i = 0; i < pushConstantRangeCount; i++)
+            pipelineEnums->pushConstantSize = lvn::max(pipelineEnums->pushConstantSize, pPushConstantRanges[i].offset + pPushConstantRanges[i].size);
+
+        if (pipelineEnums->pushConstantSize > 0)
+        {
+            glCreateBuffers(1, &pipelineEnums->pushConstantBuffer);
+            glNamedBufferStorage(pipelineEnums->pushConstantBuffer, pipelineEnums->pushConstantSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        }
+    }
+
+    static GLbitfield getMemoryBarrierEnum(LvnMemoryBarrierFlagBits barriers)
+    {
+        GLbitfield barrierBits = 0;
+        if (barriers & Lvn_MemoryBarrier_StorageBuffer)
+            barrierBits |= GL_SHADER_STORAGE_BARRIER_BIT;
+        if (barriers & Lvn_MemoryBarrier_UniformBuffer)
+            barrierBits |= GL_UNIFORM_BARRIER_BIT;
+        if (barriers & Lvn_MemoryBarrier_VertexBuffer)
+            barrierBits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+        if (barriers & Lvn_MemoryBarrier_IndexBuffer)
+            barrierBits |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+        if (barriers & Lvn_MemoryBarrier_IndirectBuffer)
+            barrierBits |= GL_COMMAND_BARRIER_BIT;
+
+        return barrierBits;
+    }
+
+    // scopes are tracked when recorded so multithreaded recording can defer only the query writes, returns the query to write or UINT32_MAX
+    static uint32_t beginTimestampScope(LvnWindow* window, const char* name)
+    {
+        if (window->timestampFrames.empty())
+            window->timestampFrames.resize(LVN_OPENGL_TIMESTAMP_FRAMES);
+
+        LvnGpuTimestampFrame& frame = window->timestampFrames[window->timestampFrame];
+
+        LvnGpuTimestampScope scope{};
+        scope.name = name ? name : "";
+        scope.beginQuery = UINT32_MAX;
+        scope.depth = frame.openScopes.size();
+        scope.ended = false;
+
+        if (frame.queryCount + 2 <= LVN_OPENGL_MAX_TIMESTAMP_QUERIES)
+        {
+            scope.beginQuery = frame.queryCount;
+            frame.queryCount += 2;
+        }
+
+        frame.openScopes.push_back(frame.scopes.size());
+        frame.scopes.push_back(scope);
+
+        return scope.beginQuery;
+    }
+
+    static uint32_t endTimestampScope(LvnWindow* window)
+    {
+        if (window->timestampFrames.empty() || window->timestampFrames[window->timestampFrame].openScopes.empty())
+        {
+            LVN_CORE_ERROR("renderCmdEndTimestamp(LvnWindow*) | no timestamp scope was begun in the current frame of window (%p)", window);
+            return UINT32_MAX;
+        }
+
+        LvnGpuTimestampFrame& frame = window->timestampFrames[window->timestampFrame];
+        LvnGpuTimestampScope& scope = frame.scopes[frame.openScopes.back()];
+        frame.openScopes.erase_index(frame.openScopes.size() - 1);
+        scope.ended = true;
+
+        return scope.beginQuery != UINT32_MAX ? scope.beginQuery + 1 : UINT32_MAX;
+    }
+
+    static void writeTimestamp(LvnWindow* window, uint32_t query)
+    {
+        if (query == UINT32_MAX) { return; }
+
+        // query objects are created when a frame first needs them and reused by later frames
+        LvnVector<uint32_t>& queries = window->timestampFrames[window->timestampFrame].queries;
+        if (query >= queries.size())
+        {
+            uint32_t firstQuery = queries.size();
+            queries.resize(query + 1);
+            glGenQueries(queries.size() - firstQuery, &queries[firstQuery]);
+        }
+
+        glQueryCounter(queries[query], GL_TIMESTAMP);
+    }
+
+    // the frame being reused was recorded LVN_OPENGL_TIMESTAMP_FRAMES frames ago, its results are dropped rather than waited for if the gpu is still behind
+    static void readTimestampQueries(LvnWindow* window)
+    {
+        if (window->timestampFrames.empty()) { return; }
+
+        window->timestampFrame = (window->timestampFrame + 1) % LVN_OPENGL_TIMESTAMP_FRAMES;
+        LvnGpuTimestampFrame& frame = window->timestampFrames[window->timestampFrame];
+
+        bool available = frame.queryCount > 0 && frame.queries.size() >= frame.queryCount;
+        for (uint32_t i = 0; i < frame.queryCount && available; i++)
+        {
+            GLint queryAvailable = GL_FALSE;
+            glGetQueryObjectiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &queryAvailable);
+            available = queryAvailable == GL_TRUE;
+        }
+
+        if (available)
+        {
+            window->timestamps.clear();
+            for (uint32_t i = 0; i < frame.scopes.size(); i++)
+            {
+                const LvnGpuTimestampScope& scope = frame.scopes[i];
+                if (scope.beginQuery == UINT32_MAX || !scope.ended) { continue; }
+
+                GLuint64 beginTime = 0, endTime = 0;
+                glGetQueryObjectui64v(frame.queries[scope.beginQuery], GL_QUERY_RESULT, &beginTime);
+                glGetQueryObjectui64v(frame.queries[scope.beginQuery + 1], GL_QUERY_RESULT, &endTime);
+
+                LvnGpuTimestampResult timestamp{};
+                timestamp.name = scope.name;
+                timestamp.milliseconds = static_cast<double>(endTime - beginTime) / 1000000.0;
+                timestamp.depth = scope.depth;
+                window->timestamps.push_back(timestamp);
+            }
+        }
+
+        frame.scopes.clear();
+        frame.openScopes.clear();
+        frame.queryCount = 0;
+    }
+
+    // the texture is read into a pixel pack buffer so glGetTexImage returns without waiting, the pixels are picked up once the fence signals
+    static void readbackFrameBuffer(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData)
+    {
+        OglBackends* oglBackends = s_OglBackends;
+        OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(frameBuffer->frameBufferData);
+
+        if (attachmentIndex >= frameBufferData->colorAttachmentTextures.size())
+        {
+            LVN_CORE_ERROR("[opengl] cannot read back framebuffer (%p), attachment index (%u) is not a color attachment", frameBuffer, attachmentIndex);
+            return;
+        }
+
+        GLenum format, type;
+        uint32_t pixelSize = ogls::getReadPixelsFormat(frameBufferData->colorAttachmentSpecifications[attachmentIndex].format, &format, &type);
+        uint64_t size = static_cast<uint64_t>(frameBufferData->width) * frameBufferData->height * pixelSize;
+
+        OglReadback* readback = lvn::memNew<OglReadback>();
+        readback->buffer.id = 0;
+
+        // buffers are reused by later readbacks of the same or a smaller size
+        {
+            LvnLockGaurd lock(oglBackends->readbackMutex);
+            for (uint32_t i = 0; i < oglBackends->readbackBuffers.size(); i++)
+            {
+                if (oglBackends->readbackBuffers[i].size < size) { continue; }
+
+                readback->buffer = oglBackends->readbackBuffers[i];
+                oglBackends->readbackBuffers.erase_index(i);
+                break;
+            }
+        }
+
+        if (readback->buffer.id == 0)
+        {
+            GLbitfield mapFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glCreateBuffers(1, &readback->buffer.id);
+            glNamedBufferStorage(readback->buffer.id, size, nullptr, mapFlags);
+            readback->buffer.mappedData = glMapNamedBufferRange(readback->buffer.id, 0, size, mapFlags);
+            readback->buffer.size = size;
+
+            if (!readback->buffer.mappedData)
+            {
+                LVN_CORE_ERROR("[opengl] failed to map readback buffer of %llu bytes when reading back framebuffer (%p)", size, frameBuffer);
+                glDeleteBuffers(1, &readback->buffer.id);
+                lvn::memDelete(readback);
+                return;
+            }
+        }
+
+        readback->func = func;
+        readback->userData = userData;
+        readback->data.size = size;
+        readback->data.width = frameBufferData->width;
+        readback->data.height = frameBufferData->height;
+        readback->data.pixelSize = pixelSize;
+        readback->data.format = frameBufferData->colorAttachmentSpecifications[attachmentIndex].format;
+        readback->data.frameIndex = oglBackends->frameIndex;
+
+        // rows of rgb attachments are not padded to 4 bytes
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer.id);
+        glBindTexture(GL_TEXTURE_2D, frameBufferData->colorAttachmentTextures[attachmentIndex].id);
+        glGetTexImage(GL_TEXTURE_2D, 0, format, type, nullptr);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+        readback->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        oglBackends->pendingReadbacks.push_back(readback);
+    }
+
+    static void readbackJob(void* userData)
+    {
+        OglBackends* oglBackends = s_OglBackends;
+        OglReadback* readback = static_cast<OglReadback*>(userData);
+
+        // the buffer is mapped coherent, the pixels are visible once the fence signaled
+        readback->data.pixels = readback->buffer.mappedData;
+        readback->func(&readback->data, readback->userData);
+
+        {
+            LvnLockGaurd lock(oglBackends->readbackMutex);
+            oglBackends->readbackBuffers.push_back(readback->buffer);
+        }
+
+        lvn::memDelete(readback);
+    }
+
+    // reads the gpu finished are handed to the workers, unfinished ones are checked again next frame unless wait is set
+    static void completeReadbacks(OglBackends* oglBackends, bool wait)
+    {
+        LvnVector<OglReadback*>& pending = oglBackends->pendingReadbacks;
+
+        uint32_t remaining = 0;
+        for (uint32_t i = 0; i < pending.size(); i++)
+        {
+            GLsync fence = static_cast<GLsync>(pending[i]->fence);
+
+            GLenum result = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, 0);
+            while (wait && result == GL_TIMEOUT_EXPIRED)
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, LVN_OPENGL_FENCE_WAIT_TIMEOUT);
+
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                pending[remaining++] = pending[i];
+                continue;
+            }
+
+            glDeleteSync(fence);
+            lvn::jobSubmit(ogls::readbackJob, pending[i], &oglBackends->readbackJobs);
+        }
+        pending.resize(remaining);
+    }
+
+    static void destroyReadbackBuffers(OglBackends* oglBackends)
+    {
+        ogls::completeReadbacks(oglBackends, true);
+        lvn::jobWait(&oglBackends->readbackJobs);
+
+        // deleting a buffer also unmaps it
+        for (uint32_t i = 0; i < oglBackends->readbackBuffers.size(); i++)
+            glDeleteBuffers(1, &oglBackends->readbackBuffers[i].id);
+
+        oglBackends->readbackBuffers.clear();
+    }
+
+    // regionSize is zero for buffers that are not ring buffered
+    static uint64_t getBufferRegionOffset(const LvnBuffer* buffer)
+    {
+        return buffer->regionSize * s_OglBackends->bufferRegion;
+    }
+
+    static void waitRegionFence(OglBackends* oglBackends, uint32_t region)
+    {
+        if (oglBackends->regionFences[region] == nullptr) { return; }
+
+        GLsync fence = static_cast<GLsync>(oglBackends->regionFences[region]);
+
+        GLenum result;
+        do
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, LVN_OPENGL_FENCE_WAIT_TIMEOUT);
+        } while (result == GL_TIMEOUT_EXPIRED);
+
+        glDeleteSync(fence);
+        oglBackends->regionFences[region] = nullptr;
+    }
+
+    OglWorkerContextScope::OglWorkerContextScope()
+        : m_Context(nullptr)
+    {
+        // the render thread and threads that made their own context current keep using it
+        if (glfwGetCurrentContext() != nullptr)
+            return;
+
+        OglBackends* oglBackends = s_OglBackends;
+        while (m_Context == nullptr)
+        {
+            {
+                LvnLockGaurd lock(oglBackends->workerContextMutex);
+                if (!oglBackends->workerContexts.empty())
+                {
+                    m_Context = oglBackends->workerContexts.back();
+                    oglBackends->workerContexts.pop_back();
+                }
+            }
+
+            if (m_Context == nullptr)
+                std::this_thread::yield();
+        }
+
+        glfwMakeContextCurrent(m_Context);
+        s_OglWorkerContext = m_Context;
+    }
+
+    OglWorkerContextScope::~OglWorkerContextScope()
+    {
+        if (m_Context == nullptr)
+            return;
+
+        // block the loader thread, not the render thread, until the uploads of the worker context complete
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, LVN_OPENGL_FENCE_WAIT_TIMEOUT) == GL_TIMEOUT_EXPIRED) {}
+        glDeleteSync(fence);
+
+        glfwMakeContextCurrent(nullptr);
+        s_OglWorkerContext = nullptr;
+
+        OglBackends* oglBackends = s_OglBackends;
+        LvnLockGaurd lock(oglBackends->workerContextMutex);
+        oglBackends->workerContexts.push_back(m_Context);
+    }
+
+    static void resetStateCache()
+    {
+        // worker contexts have their own state, the cache only tracks the render thread's contexts
+        if (s_OglWorkerContext != nullptr)
+            return;
+
+        OglStateCache& cache = s_OglBackends->stateCache;
+
+        cache.program = UINT32_MAX;
+        cache.vao = UINT32_MAX;
+        cache.depthTest = cache.depthFunc = cache.depthMask = UINT32_MAX;
+        cache.blend = cache.srcBlendFactor = cache.dstBlendFactor = UINT32_MAX;
+        cache.cullFace = cache.cullMode = cache.frontFace = UINT32_MAX;
+        cache.scissorTest = UINT32_MAX;
+        cache.textureUnits.clear();
+        cache.uniformBuffers.clear();
+        cache.storageBuffers.clear();
+    }
+
+    static void setCapability(GLenum capability, uint32_t* cachedState, bool enable)
+    {
+        if (*cachedState == static_cast<uint32_t>(enable)) { return; }
+
+        if (enable)
+            glEnable(capability);
+        else
+            glDisable(capability);
+
+        *cachedState = enable;
+    }
+
+    static void setDepthMask(bool enable)
+    {
+        OglStateCache& cache = s_OglBackends->stateCache;
+        if (cache.depthMask == static_cast<uint32_t>(enable)) { return; }
+
+        glDepthMask(enable ? GL_TRUE : GL_FALSE);
+        cache.depthMask = enable;
+    }
+
+    static void useProgram(uint32_t program)
+    {
+        OglStateCache& cache = s_OglBackends->stateCache;
+        if (cache.program == program) { return; }
+
+        glUseProgram(program);
+        cache.program = program;
+    }
+
+    static void bindVertexArray(uint32_t vao)
+    {
+        OglStateCache& cache = s_OglBackends->stateCache;
+        if (cache.vao == vao) { return; }
+
+        glBindVertexArray(vao);
+        cache.vao = vao;
+    }
+
+    static void bindTextureUnit(uint32_t unit, uint32_t texture)
+    {
+        LvnVector<uint32_t>& textureUnits = s_OglBackends->stateCache.textureUnits;
+        if (unit < textureUnits.size() && textureUnits[unit] == texture) { return; }
+
+        glBindTextureUnit(unit, texture);
+
+        if (unit >= textureUnits.size())
+            textureUnits.resize(unit + 1, UINT32_MAX);
+        textureUnits[unit] = texture;
+    }
+
+    static void bindBufferRange(GLenum target, uint32_t binding, uint32_t buffer, uint64_t offset, uint64_t size)
+    {
+        OglStateCache& cache = s_OglBackends->stateCache;
+        LvnVector<OglBufferRangeBinding>& bindings = target == GL_SHADER_STORAGE_BUFFER ? cache.storageBuffers : cache.uniformBuffers;
+
+        if (binding < bindings.size() && bindings[binding].id == buffer && bindings[binding].offset == offset && bindings[binding].size == size) { return; }
+
+        if (size == 0)
+            glBindBufferBase(target, binding, buffer);
+        else
+            glBindBufferRange(target, binding, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+
+        if (binding >= bindings.size())
+            bindings.resize(binding + 1, { UINT32_MAX, 0, 0 });
+        bindings[binding] = { buffer, offset, size };
+    }
+
+    static void bindPipeline(LvnWindow* window, LvnPipeline* pipeline)
+    {
+        // compute pipelines only have a program, the draw state is left as is
+        if (pipeline->compute)
+        {
+            ogls::useProgram(pipeline->id);
+            return;
+        }
+
+        OglStateCache& cache = s_OglBackends->stateCache;
+        OglPipelineEnums* pipelineEnums = static_cast<OglPipelineEnums*>(pipeline->nativePipeline);
+
+        // depth
+        ogls::setCapability(GL_DEPTH_TEST, &cache.depthTest, pipelineEnums->enableDepth);
+        ogls::setDepthMask(true); // depth writes are only turned off by renderCmdSetDepthTest
+        if (pipelineEnums->enableDepth && cache.depthFunc != pipelineEnums->depthCompareOp)
+        {
+            glDepthFunc(pipelineEnums->depthCompareOp);
+            cache.depthFunc = pipelineEnums->depthCompareOp;
+        }
+
+        // color blend
+        ogls::setCapability(GL_BLEND, &cache.blend, pipelineEnums->enableBlending);
+        if (pipelineEnums->enableBlending && (cache.srcBlendFactor != pipelineEnums->srcBlendFactor || cache.dstBlendFactor != pipelineEnums->dstBlendFactor))
+        {
+            glBlendFunc(pipelineEnums->srcBlendFactor, pipelineEnums->dstBlendFactor);
+            cache.srcBlendFactor = pipelineEnums->srcBlendFactor;
+            cache.dstBlendFactor = pipelineEnums->dstBlendFactor;
+        }
+
+        // culling
+        ogls::setCapability(GL_CULL_FACE, &cache.cullFace, pipelineEnums->enableCulling);
+        if (pipelineEnums->enableCulling)
+        {
+            if (cache.cullMode != pipelineEnums->cullMode)
+            {
+                glCullFace(pipelineEnums->cullMode);
+                cache.cullMode = pipelineEnums->cullMode;
+            }
+            if (cache.frontFace != pipelineEnums->frontFace)
+            {
+                glFrontFace(pipelineEnums->frontFace);
+                cache.frontFace = pipelineEnums->frontFace;
+            }
+        }
+
+        ogls::useProgram(pipeline->id);
+        ogls::bindVertexArray(pipeline->vaoId);
+
+        window->topologyTypeEnum = pipelineEnums->topologyType;
+        window->vao = pipeline->vaoId;
+        window->bindingDescriptions = &pipeline->bindingDescriptions;
+    }
+
+    static void pushConstants(LvnPipeline* pipeline, uint32_t offset, uint32_t size, const void* data)
+    {
+        OglPipelineEnums* pipelineEnums = static_cast<OglPipelineEnums*>(pipeline->nativePipeline);
+
+        if (pipelineEnums->pushConstantBuffer == 0 || offset + size > pipelineEnums->pushConstantSize)
+        {
+            LVN_CORE_ERROR("[opengl] push constant range (offset:%u, size:%u) is outside the push constant ranges of pipeline (%p)", offset, size, pipeline);
+            return;
+        }
+
+        // push constants are emulated with a small uniform buffer owned by the pipeline
+        glNamedBufferSubData(pipelineEnums->pushConstantBuffer, offset, size, data);
+        ogls::bindBufferRange(GL_UNIFORM_BUFFER, LVN_OPENGL_PUSH_CONSTANT_BINDING, pipelineEnums->pushConstantBuffer, 0, 0);
+    }
+
+    static uint64_t getCmdPayloadSize(uint64_t cmdSize, uint64_t payloadSize)
+    {
+        return (cmdSize + payloadSize + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    static uint8_t* allocateCmd(LvnWindow* window, uint64_t size)
+    {
+        // bump allocate from the window's command buffer, it keeps its capacity between frames so steady state recording does not allocate
+        uint64_t offset = window->cmdBufferSize;
+        if (offset + size > window->cmdBuffer.size())
+            window->cmdBuffer.resize_uninitialized(offset + size);
+
+        window->cmdBufferSize += size;
+        return &window->cmdBuffer[offset];
+    }
 
     static LvnResult checkErrorCode()
     {
@@ -120,6 +819,7 @@ namespace ogls
                 const char* shaderType;
                 if (type == GL_VERTEX_SHADER) { shaderType = "vertex"; }
                 else if (type == GL_FRAGMENT_SHADER) { shaderType = "fragment"; }
+                else if (type == GL_COMPUTE_SHADER) { shaderType = "compute"; }
 
                 glGetShaderInfoLog(shader, 1024, 0, infoLog);
                 LVN_CORE_ERROR("[opengl] [%s] shader compilation error: %s, source: %s", shaderType, infoLog, shaderSrc);
@@ -143,6 +843,69 @@ namespace ogls
         return Lvn_Result_Success;
     }
 
+    static LvnResult createComputeShader(LvnShader* shader, const char* computeSrc)
+    {
+        uint32_t computeShader = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(computeShader, 1, &computeSrc, NULL);
+        glCompileShader(computeShader);
+        if (ogls::checkShaderError(computeShader, GL_COMPUTE_SHADER, computeSrc) != Lvn_Result_Success)
+        {
+            LVN_CORE_ERROR("[opengl] failed to create compute shader module (id:%u) when creating shader (%p)", computeShader, shader);
+            return Lvn_Result_Failure;
+        }
+
+        shader->computeShaderId = computeShader;
+        return Lvn_Result_Success;
+    }
+
+    static uint32_t createComputeProgram(const char* computeSrc)
+    {
+        uint32_t computeShader = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(computeShader, 1, &computeSrc, NULL);
+        glCompileShader(computeShader);
+        if (ogls::checkShaderError(computeShader, GL_COMPUTE_SHADER, computeSrc) != Lvn_Result_Success)
+            return 0;
+
+        uint32_t shaderProgram = glCreateProgram();
+        glAttachShader(shaderProgram, computeShader);
+        glLinkProgram(shaderProgram);
+        glDeleteShader(computeShader);
+
+        if (ogls::checkShaderError(shaderProgram, GL_PROGRAM, "") != Lvn_Result_Success)
+            return 0;
+
+        return shaderProgram;
+    }
+
+    static void createEnvironmentMapTexture(LvnTexture* texture, GLenum target, uint32_t size, uint32_t mipLevels)
+    {
+        uint32_t id;
+        glCreateTextures(target, 1, &id);
+        glTextureStorage2D(id, mipLevels, GL_RGBA16F, size, size);
+
+        glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, mipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+        *texture = LvnTexture{};
+        texture->id = id;
+        texture->width = size;
+        texture->height = size;
+        texture->channels = 4;
+        texture->mipLevels = mipLevels;
+    }
+
+    static void dispatchEnvironmentMapPass(uint32_t program, uint32_t dstTexture, uint32_t mipLevel, bool layered, uint32_t size)
+    {
+        uint32_t groupCount = (size + LVN_OPENGL_ENVIRONMENT_MAP_GROUP_SIZE - 1) / LVN_OPENGL_ENVIRONMENT_MAP_GROUP_SIZE;
+
+        glUseProgram(program);
+        glBindImageTexture(1, dstTexture, mipLevel, layered ? GL_TRUE : GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        glDispatchCompute(groupCount, groupCount, layered ? 6 : 1);
+    }
+
     static GLenum getVertexAttributeFormatEnum(LvnAttributeFormat format)
     {
         switch (format)
@@ -182,6 +945,12 @@ namespace ogls
             case Lvn_AttributeFormat_2_10_10_10_uile:  { return GL_UNSIGNED_INT_2_10_10_10_REV; }
             case Lvn_AttributeFormat_2_10_10_10_nle:   { return GL_INT_2_10_10_10_REV; }
             case Lvn_AttributeFormat_2_10_10_10_unle:  { return GL_UNSIGNED_INT_2_10_10_10_REV; }
+            case Lvn_AttributeFormat_Vec2_f16:         { return GL_HALF_FLOAT; }
+            case Lvn_AttributeFormat_Vec4_f16:         { return GL_HALF_FLOAT; }
+            case Lvn_AttributeFormat_Vec2_n16:         { return GL_SHORT; }
+            case Lvn_AttributeFormat_Vec4_n16:         { return GL_SHORT; }
+            case Lvn_AttributeFormat_Vec2_un16:        { return GL_UNSIGNED_SHORT; }
+            case Lvn_AttributeFormat_Vec4_un16:        { return GL_UNSIGNED_SHORT; }
 
             default:
             {
@@ -230,6 +999,12 @@ namespace ogls
             case Lvn_AttributeFormat_2_10_10_10_uile:  { return Lvn_VertexAttrib_I; }
             case Lvn_AttributeFormat_2_10_10_10_nle:   { return Lvn_VertexAttrib_N; }
             case Lvn_AttributeFormat_2_10_10_10_unle:  { return Lvn_VertexAttrib_N; }
+            case Lvn_AttributeFormat_Vec2_f16:         { return Lvn_VertexAttrib_N; }
+            case Lvn_AttributeFormat_Vec4_f16:         { return Lvn_VertexAttrib_N; }
+            case Lvn_AttributeFormat_Vec2_n16:         { return Lvn_VertexAttrib_N; }
+            case Lvn_AttributeFormat_Vec4_n16:         { return Lvn_VertexAttrib_N; }
+            case Lvn_AttributeFormat_Vec2_un16:        { return Lvn_VertexAttrib_N; }
+            case Lvn_AttributeFormat_Vec4_un16:        { return Lvn_VertexAttrib_N; }
 
             default:
             {
@@ -254,6 +1029,102 @@ namespace ogls
         }
     }
 
+    static GLenum getTextureMipmapFilterEnum(LvnTextureFilter filter)
+    {
+        // mip levels are always blended linearly to match the vulkan sampler mipmap mode
+        switch (filter)
+        {
+            case Lvn_TextureFilter_Nearest: { return GL_NEAREST_MIPMAP_LINEAR; }
+            case Lvn_TextureFilter_Linear: { return GL_LINEAR_MIPMAP_LINEAR; }
+
+            default:
+            {
+                LVN_CORE_WARN("unknown sampler filter enum type (%u), setting filter to \'GL_NEAREST_MIPMAP_LINEAR\' as default", filter);
+                return GL_NEAREST_MIPMAP_LINEAR;
+            }
+        }
+    }
+
+    static GLenum getCompressedTextureFormatEnum(LvnTextureCompression compression, LvnTextureFormat format)
+    {
+        bool unorm = format == Lvn_TextureFormat_Unorm;
+
+        switch (compression)
+        {
+            case Lvn_TextureCompression_Bc1: { return unorm ? GL_COMPRESSED_RGBA_S3TC_DXT1_EXT : GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT; }
+            case Lvn_TextureCompression_Bc3: { return unorm ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT; }
+            case Lvn_TextureCompression_Bc4: { return GL_COMPRESSED_RED_RGTC1; }
+            case Lvn_TextureCompression_Bc5: { return GL_COMPRESSED_RG_RGTC2; }
+            case Lvn_TextureCompression_Bc7: { return unorm ? GL_COMPRESSED_RGBA_BPTC_UNORM : GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM; }
+            case Lvn_TextureCompression_Etc2Rgb: { return unorm ? GL_COMPRESSED_RGB8_ETC2 : GL_COMPRESSED_SRGB8_ETC2; }
+            case Lvn_TextureCompression_Etc2Rgba: { return unorm ? GL_COMPRESSED_RGBA8_ETC2_EAC : GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC; }
+            case Lvn_TextureCompression_Astc4x4: { return unorm ? GL_COMPRESSED_RGBA_ASTC_4x4_KHR : GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR; }
+
+            default:
+            {
+                LVN_CORE_WARN("unknown texture compression enum (%u), setting format to \'GL_COMPRESSED_RGBA_S3TC_DXT1_EXT\' as default", compression);
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            }
+        }
+    }
+
+    static LvnResult uploadTextureImage(uint32_t id, GLenum internalFormat, GLenum format, const LvnImageData& imageData, const LvnImageData* pMipImageData, uint32_t* mipLevels)
+    {
+        uint32_t levels = lvn::clamp(*mipLevels, 1u, lvn::imageGetMipLevelCount(imageData.width, imageData.height));
+
+        if (pMipImageData)
+        {
+            for (uint32_t i = 1; i < levels; i++)
+            {
+                const LvnImageData& mip = pMipImageData[i - 1];
+                if (mip.width != lvn::max(imageData.width >> i, 1u) || mip.height != lvn::max(imageData.height >> i, 1u) || mip.channels != imageData.channels)
+                {
+                    LVN_CORE_ERROR("[opengl] precomputed mip level (%u) has dimensions (w:%u,h:%u,ch:%u), expected (w:%u,h:%u,ch:%u)", i, mip.width, mip.height, mip.channels, lvn::max(imageData.width >> i, 1u), lvn::max(imageData.height >> i, 1u), imageData.channels);
+                    return Lvn_Result_Failure;
+                }
+                if (mip.compression != imageData.compression || (mip.compression != Lvn_TextureCompression_None && mip.pixels.memsize() < lvn::imageGetCompressedSize(mip.compression, mip.width, mip.height)))
+                {
+                    LVN_CORE_ERROR("[opengl] precomputed mip level (%u) does not match the compression format or block size of the base image", i);
+                    return Lvn_Result_Failure;
+                }
+            }
+        }
+
+        if (imageData.compression != Lvn_TextureCompression_None)
+        {
+            // compressed images cannot be filtered into new levels, only the supplied mip chain is uploaded
+            if (!pMipImageData && levels > 1)
+            {
+                LVN_CORE_WARN("[opengl] mipmaps cannot be generated for compressed texture images, using a single mip level");
+                levels = 1;
+            }
+
+            glTextureStorage2D(id, levels, internalFormat, imageData.width, imageData.height);
+            for (uint32_t i = 0; i < levels; i++)
+            {
+                const LvnImageData& level = i == 0 ? imageData : pMipImageData[i - 1];
+                glCompressedTextureSubImage2D(id, i, 0, 0, level.width, level.height, internalFormat, lvn::imageGetCompressedSize(level.compression, level.width, level.height), level.pixels.data());
+            }
+
+            *mipLevels = levels;
+            return Lvn_Result_Success;
+        }
+
+        glTextureStorage2D(id, levels, internalFormat, imageData.width, imageData.height);
+        glTextureSubImage2D(id, 0, 0, 0, imageData.width, imageData.height, format, GL_UNSIGNED_BYTE, imageData.pixels.data());
+
+        if (pMipImageData)
+        {
+            for (uint32_t i = 1; i < levels; i++)
+                glTextureSubImage2D(id, i, 0, 0, pMipImageData[i - 1].width, pMipImageData[i - 1].height, format, GL_UNSIGNED_BYTE, pMipImageData[i - 1].pixels.data());
+        }
+        else if (levels > 1)
+            glGenerateTextureMipmap(id);
+
+        *mipLevels = levels;
+        return Lvn_Result_Success;
+    }
+
     static GLenum getTextureWrapModeEnum(LvnTextureMode mode)
     {
         switch (mode)
@@ -342,6 +1213,20 @@ namespace ogls
         }
     }
 
+    // pixel layout color attachments are read back in, returns the size of one pixel
+    static uint32_t getReadPixelsFormat(LvnColorImageFormat texFormat, GLenum* format, GLenum* type)
+    {
+        switch (texFormat)
+        {
+            case Lvn_ColorImageFormat_RedInt: { *format = GL_RED_INTEGER; *type = GL_INT; return 4; }
+            case Lvn_ColorImageFormat_RGB: { *format = GL_RGB; *type = GL_UNSIGNED_BYTE; return 3; }
+            case Lvn_ColorImageFormat_RGBA16F: { *format = GL_RGBA; *type = GL_HALF_FLOAT; return 8; }
+            case Lvn_ColorImageFormat_RGBA32F: { *format = GL_RGBA; *type = GL_FLOAT; return 16; }
+
+            default: { *format = GL_RGBA; *type = GL_UNSIGNED_BYTE; return 4; }
+        }
+    }
+
     static GLenum getCompareOpEnum(LvnCompareOperation compareOp)
     {
         switch (compareOp)
@@ -449,6 +1334,7 @@ namespace ogls
         switch (type)
         {
             case Lvn_DescriptorType_UniformBuffer: { return GL_UNIFORM_BUFFER; }
+            case Lvn_DescriptorType_UniformBufferDynamic: { return GL_UNIFORM_BUFFER; }
             case Lvn_DescriptorType_StorageBuffer: { return GL_SHADER_STORAGE_BUFFER; }
             default:
             {
@@ -460,6 +1346,8 @@ namespace ogls
 
     static LvnResult updateFrameBuffer(OglFramebufferData* frameBufferData)
     {
+        ogls::resetStateCache();
+
         GLenum texType = frameBufferData->multisampling ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
         GLenum texFilter = ogls::getTextureFilterEnum(frameBufferData->textureFilter);
         GLenum texWrapMode = ogls::getTextureWrapModeEnum(frameBufferData->textureMode);
@@ -667,6 +1555,8 @@ namespace ogls
         {
             LvnTexture colorTexture{};
             colorTexture.id = frameBufferData->multisampling ? frameBufferData->msaaColorAttachments[i] : frameBufferData->colorAttachments[i];
+            colorTexture.width = frameBufferData->width;
+            colorTexture.height = frameBufferData->height;
             frameBufferData->colorAttachmentTextures[i] = colorTexture;
         }
 
@@ -691,6 +1581,9 @@ LvnResult oglsImplCreateContext(LvnGraphicsContext* graphicsContext)
     s_OglBackends->defaultOglPipelineSpecification = lvn::configPipelineSpecificationInit();
     s_OglBackends->maxTextureUnitSlots = 32;
     s_OglBackends->framebufferColorFormatSrgb = graphicsContext->frameBufferColorFormat == Lvn_TextureFormat_Srgb ? true : false;
+    s_OglBackends->bufferRegion = 0;
+    s_OglBackends->regionFences.resize(LVN_OPENGL_BUFFER_REGIONS, nullptr);
+    ogls::resetStateCache();
 
 
     // NOTE: opengl does not support any enumerated physical devices so we just create a dummy device
@@ -700,6 +1593,8 @@ LvnResult oglsImplCreateContext(LvnGraphicsContext* graphicsContext)
     props.apiVersion = (((uint32_t)(s_OglBackends->versionMajor)) << 22) | (((uint32_t)(s_OglBackends->versionMinor)) << 12);
     props.driverVersion = 0;
     props.vendorID = 0;
+    props.minUniformBufferOffsetAlignment = 0; // queried once the context is created
+    props.maxPushConstantsSize = 256;
 
     LvnPhysicalDevice physicalDevice{};
     physicalDevice.physicalDevice = nullptr;
@@ -724,8 +1619,32 @@ LvnResult oglsImplCreateContext(LvnGraphicsContext* graphicsContext)
         return Lvn_Result_Failure;
     }
 
+    // worker contexts share objects with the main context, glfw windows can only be created on the main thread so they are created up front
+    for (uint32_t i = 0; i < LVN_OPENGL_WORKER_CONTEXTS; i++)
+    {
+        GLFWwindow* workerContext = glfwCreateWindow(1, 1, "", nullptr, s_OglBackends->windowContext);
+        if (workerContext == nullptr)
+        {
+            LVN_CORE_WARN("[opengl] failed to create worker context %u, resources created from loader threads wait for the remaining worker contexts", i);
+            break;
+        }
+
+        s_OglBackends->workerContexts.push_back(workerContext);
+    }
+    glfwMakeContextCurrent(s_OglBackends->windowContext);
+
     glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
 
+    s_OglBackends->bindlessTextureSupported = GLAD_GL_ARB_bindless_texture != 0;
+
+    GLint uniformBufferOffsetAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferOffsetAlignment);
+    s_OglBackends->physicalDevice.properties.minUniformBufferOffsetAlignment = static_cast<uint64_t>(uniformBufferOffsetAlignment);
+
+    GLint storageBufferOffsetAlignment = 0;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageBufferOffsetAlignment);
+    s_OglBackends->bufferRegionAlignment = static_cast<uint64_t>(lvn::max(lvn::max(uniformBufferOffsetAlignment, storageBufferOffsetAlignment), 1));
+
     // set error callback
     if (graphicsContext->enableGraphicsApiDebugLogs)
     {
@@ -738,18 +1657,20 @@ LvnResult oglsImplCreateContext(LvnGraphicsContext* graphicsContext)
     graphicsContext->getPhysicalDevices = oglsImplGetPhysicalDevices;
     graphicsContext->checkPhysicalDeviceSupport = oglsImplCheckPhysicalDeviceSupport;
     graphicsContext->setPhysicalDevice = oglsImplSetPhysicalDevice;
+    graphicsContext->getMemoryStats = oglsImplGetMemoryStats;
     graphicsContext->createShaderFromSrc = oglsImplCreateShaderFromSrc;
     graphicsContext->createShaderFromFileSrc = oglsImplCreateShaderFromFileSrc;
     graphicsContext->createShaderFromFileBin = oglsImplCreateShaderFromFileBin;
     graphicsContext->createDescriptorLayout = oglsImplCreateDescriptorLayout;
     graphicsContext->createPipeline = oglsImplCreatePipeline;
+    graphicsContext->createComputePipeline = oglsImplCreateComputePipeline;
     graphicsContext->createFrameBuffer = oglsImplCreateFrameBuffer;
     graphicsContext->createBuffer = oglsImplCreateBuffer;
     graphicsContext->createSampler = oglsImplCreateSampler;
     graphicsContext->createTexture = oglsImplCreateTexture;
     graphicsContext->createTextureSampler = oglsImplCreateTextureSampler;
     graphicsContext->createCubemap = oglsImplCreateCubemap;
-    graphicsContext->createCubemapHdr = oglsImplCreateCubemapHdr;
+    graphicsContext->createEnvironmentMap = oglsImplCreateEnvironmentMap;
     
     graphicsContext->destroyShader = oglsImplDestroyShader;
     graphicsContext->destroyDescriptorLayout = oglsImplDestroyDescriptorLayout;
@@ -759,11 +1680,16 @@ LvnResult oglsImplCreateContext(LvnGraphicsContext* graphicsContext)
     graphicsContext->destroySampler = oglsImplDestroySampler;
     graphicsContext->destroyTexture = oglsImplDestroyTexture;
     graphicsContext->destroyCubemap = oglsImplDestroyCubemap;
+    graphicsContext->destroyEnvironmentMap = oglsImplDestroyEnvironmentMap;
 
     graphicsContext->renderBeginNextFrame = oglsImplRenderBeginNextFrame;
     graphicsContext->renderDrawSubmit = oglsImplRenderDrawSubmit;
+    graphicsContext->renderBeginSubmitBatch = oglsImplRenderBeginSubmitBatch;
+    graphicsContext->renderEndSubmitBatch = oglsImplRenderEndSubmitBatch;
     graphicsContext->renderBeginCommandRecording = oglsImplRenderBeginCommandRecording;
     graphicsContext->renderEndCommandRecording = oglsImplRenderEndCommandRecording;
+    graphicsContext->renderBeginSecondaryCommandRecording = oglsImplRenderBeginSecondaryCommandRecording;
+    graphicsContext->renderEndSecondaryCommandRecording = oglsImplRenderEndSecondaryCommandRecording;
 
     if (lvnctx->multithreading)
     {
@@ -771,16 +1697,31 @@ LvnResult oglsImplCreateContext(LvnGraphicsContext* graphicsContext)
         graphicsContext->renderCmdDrawIndexed = oglsImplRecordCmdDrawIndexed;
         graphicsContext->renderCmdDrawInstanced = oglsImplRecordCmdDrawInstanced;
         graphicsContext->renderCmdDrawIndexedInstanced = oglsImplRecordCmdDrawIndexedInstanced;
+        graphicsContext->renderCmdDrawIndirect = oglsImplRecordCmdDrawIndirect;
+        graphicsContext->renderCmdDrawIndexedIndirect = oglsImplRecordCmdDrawIndexedIndirect;
+        graphicsContext->renderCmdDrawIndexedIndirectCount = oglsImplRecordCmdDrawIndexedIndirectCount;
         graphicsContext->renderCmdSetStencilReference = oglsImplRecordCmdSetStencilReference;
         graphicsContext->renderCmdSetStencilMask = oglsImplRecordCmdSetStencilMask;
+        graphicsContext->renderCmdSetCullMode = oglsImplRecordCmdSetCullMode;
+        graphicsContext->renderCmdSetFrontFace = oglsImplRecordCmdSetFrontFace;
+        graphicsContext->renderCmdSetPrimitiveTopology = oglsImplRecordCmdSetPrimitiveTopology;
+        graphicsContext->renderCmdSetDepthTest = oglsImplRecordCmdSetDepthTest;
+        graphicsContext->renderCmdSetBlendEnable = oglsImplRecordCmdSetBlendEnable;
+        graphicsContext->renderCmdSetScissor = oglsImplRecordCmdSetScissor;
         graphicsContext->renderCmdBeginRenderPass = oglsImplRecordCmdBeginRenderPass;
         graphicsContext->renderCmdEndRenderPass = oglsImplRecordCmdEndRenderPass;
         graphicsContext->renderCmdBindPipeline = oglsImplRecordCmdBindPipeline;
         graphicsContext->renderCmdBindVertexBuffer = oglsImplRecordCmdBindVertexBuffer;
         graphicsContext->renderCmdBindIndexBuffer = oglsImplRecordCmdBindIndexBuffer;
         graphicsContext->renderCmdBindDescriptorSets = oglsImplRecordCmdBindDescriptorSets;
+        graphicsContext->renderCmdPushConstants = oglsImplRecordCmdPushConstants;
+        graphicsContext->renderCmdDispatch = oglsImplRecordCmdDispatch;
+        graphicsContext->renderCmdMemoryBarrier = oglsImplRecordCmdMemoryBarrier;
+        graphicsContext->renderCmdBeginTimestamp = oglsImplRecordCmdBeginTimestamp;
+        graphicsContext->renderCmdEndTimestamp = oglsImplRecordCmdEndTimestamp;
         graphicsContext->renderCmdBeginFrameBuffer = oglsImplRecordCmdBeginFrameBuffer;
         graphicsContext->renderCmdEndFrameBuffer = oglsImplRecordCmdEndFrameBuffer;
+        graphicsContext->renderCmdReadbackFrameBuffer = oglsImplRecordCmdReadbackFrameBuffer;
     }
     else
     {
@@ -788,26 +1729,50 @@ LvnResult oglsImplCreateContext(LvnGraphicsContext* graphicsContext)
         graphicsContext->renderCmdDrawIndexed = oglsImplRenderCmdDrawIndexed;
         graphicsContext->renderCmdDrawInstanced = oglsImplRenderCmdDrawInstanced;
         graphicsContext->renderCmdDrawIndexedInstanced = oglsImplRenderCmdDrawIndexedInstanced;
+        graphicsContext->renderCmdDrawIndirect = oglsImplRenderCmdDrawIndirect;
+        graphicsContext->renderCmdDrawIndexedIndirect = oglsImplRenderCmdDrawIndexedIndirect;
+        graphicsContext->renderCmdDrawIndexedIndirectCount = oglsImplRenderCmdDrawIndexedIndirectCount;
         graphicsContext->renderCmdSetStencilReference = oglsImplRenderCmdSetStencilReference;
         graphicsContext->renderCmdSetStencilMask = oglsImplRenderCmdSetStencilMask;
+        graphicsContext->renderCmdSetCullMode = oglsImplRenderCmdSetCullMode;
+        graphicsContext->renderCmdSetFrontFace = oglsImplRenderCmdSetFrontFace;
+        graphicsContext->renderCmdSetPrimitiveTopology = oglsImplRenderCmdSetPrimitiveTopology;
+        graphicsContext->renderCmdSetDepthTest = oglsImplRenderCmdSetDepthTest;
+        graphicsContext->renderCmdSetBlendEnable = oglsImplRenderCmdSetBlendEnable;
+        graphicsContext->renderCmdSetScissor = oglsImplRenderCmdSetScissor;
         graphicsContext->renderCmdBeginRenderPass = oglsImplRenderCmdBeginRenderPass;
         graphicsContext->renderCmdEndRenderPass = oglsImplRenderCmdEndRenderPass;
         graphicsContext->renderCmdBindPipeline = oglsImplRenderCmdBindPipeline;
         graphicsContext->renderCmdBindVertexBuffer = oglsImplRenderCmdBindVertexBuffer;
         graphicsContext->renderCmdBindIndexBuffer = oglsImplRenderCmdBindIndexBuffer;
         graphicsContext->renderCmdBindDescriptorSets = oglsImplRenderCmdBindDescriptorSets;
+        graphicsContext->renderCmdPushConstants = oglsImplRenderCmdPushConstants;
+        graphicsContext->renderCmdDispatch = oglsImplRenderCmdDispatch;
+        graphicsContext->renderCmdMemoryBarrier = oglsImplRenderCmdMemoryBarrier;
+        graphicsContext->renderCmdBeginTimestamp = oglsImplRenderCmdBeginTimestamp;
+        graphicsContext->renderCmdEndTimestamp = oglsImplRenderCmdEndTimestamp;
         graphicsContext->renderCmdBeginFrameBuffer = oglsImplRenderCmdBeginFrameBuffer;
         graphicsContext->renderCmdEndFrameBuffer = oglsImplRenderCmdEndFrameBuffer;
+        graphicsContext->renderCmdReadbackFrameBuffer = oglsImplRenderCmdReadbackFrameBuffer;
     }
 
     graphicsContext->bufferUpdateData = oglsImplBufferUpdateData;
     graphicsContext->bufferResize = oglsImplBufferResize;
+    graphicsContext->bufferGetMappedData = oglsImplBufferGetMappedData;
+    graphicsContext->bufferMap = oglsImplBufferMap;
+    graphicsContext->bufferFlushRange = oglsImplBufferFlushRange;
+    graphicsContext->bufferUnmap = oglsImplBufferUnmap;
+    graphicsContext->textureUpdateData = oglsImplTextureUpdateData;
     graphicsContext->allocateDescriptorSet = oglsImplAllocateDescriptorSet;
+    graphicsContext->allocateTransientDescriptorSet = oglsImplAllocateTransientDescriptorSet;
     graphicsContext->updateDescriptorSetData = oglsImplUpdateDescriptorSetData;
+    graphicsContext->updateDescriptorSetsData = oglsImplUpdateDescriptorSetsData;
     graphicsContext->frameBufferGetImage = oglsImplFrameBufferGetImage;
     graphicsContext->frameBufferGetRenderPass = oglsImplFrameBufferGetRenderPass;
     graphicsContext->framebufferResize = oglsImplFrameBufferResize;
     graphicsContext->frameBufferSetClearColor = oglsImplFrameBufferSetClearColor;
+    graphicsContext->frameBufferReadPixels = oglsImplFrameBufferReadPixels;
+    graphicsContext->windowReadPixels = oglsImplWindowReadPixels;
     graphicsContext->findSupportedDepthImageFormat = oglsImplFindSupportedDepthImageFormat;
 
 
@@ -816,6 +1781,17 @@ LvnResult oglsImplCreateContext(LvnGraphicsContext* graphicsContext)
 
 void oglsImplTerminateContext()
 {
+    ogls::destroyReadbackBuffers(s_OglBackends);
+
+    for (uint32_t i = 0; i < s_OglBackends->regionFences.size(); i++)
+    {
+        if (s_OglBackends->regionFences[i] != nullptr)
+            glDeleteSync(static_cast<GLsync>(s_OglBackends->regionFences[i]));
+    }
+
+    for (uint32_t i = 0; i < s_OglBackends->workerContexts.size(); i++)
+        glfwDestroyWindow(s_OglBackends->workerContexts[i]);
+
     glfwDestroyWindow(s_OglBackends->windowContext);
 
     if (s_OglBackends != nullptr)
@@ -849,8 +1825,17 @@ LvnResult oglsImplSetPhysicalDevice(LvnPhysicalDevice* physicalDevice)
     return Lvn_Result_Success;
 }
 
+void oglsImplGetMemoryStats(LvnGraphicsMemoryStats* stats)
+{
+    // opengl has no core query for memory heaps or budgets, the driver places and pages resources itself
+    *stats = LvnGraphicsMemoryStats{};
+}
+
 LvnResult oglsImplCreateShaderFromSrc(LvnShader* shader, const LvnShaderCreateInfo* createInfo)
 {
+    if (!createInfo->computeSrc.empty())
+        return ogls::createComputeShader(shader, createInfo->computeSrc.c_str());
+
     uint32_t vertexShader, fragmentShader;
 
     const char* vertexSrc = createInfo->vertexSrc.c_str();
@@ -883,6 +1868,12 @@ LvnResult oglsImplCreateShaderFromSrc(LvnShader* shader, const LvnShaderCreateIn
 
 LvnResult oglsImplCreateShaderFromFileSrc(LvnShader* shader, const LvnShaderCreateInfo* createInfo)
 {
+    if (!createInfo->computeSrc.empty())
+    {
+        LvnString fileCompSrc = lvn::loadFileSrc(createInfo->computeSrc.c_str());
+        return ogls::createComputeShader(shader, fileCompSrc.c_str());
+    }
+
     LvnString fileVertSrc = lvn::loadFileSrc(createInfo->vertexSrc.c_str());
     LvnString fileFragSrc = lvn::loadFileSrc(createInfo->fragmentSrc.c_str());
 
@@ -918,6 +1909,24 @@ LvnResult oglsImplCreateShaderFromFileSrc(LvnShader* shader, const LvnShaderCrea
 
 LvnResult oglsImplCreateShaderFromFileBin(LvnShader* shader, const LvnShaderCreateInfo* createInfo)
 {
+    if (!createInfo->computeSrc.empty())
+    {
+        LvnData<uint8_t> compbin = lvn::loadFileSrcBin(createInfo->computeSrc.c_str());
+
+        uint32_t computeShader = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderBinary(1, &computeShader, GL_SHADER_BINARY_FORMAT_SPIR_V, compbin.data(), compbin.size());
+        glSpecializeShader(computeShader, "main", 0, nullptr, nullptr);
+
+        if (ogls::checkShaderError(computeShader, GL_COMPUTE_SHADER, createInfo->computeSrc.c_str()) != Lvn_Result_Success)
+        {
+            LVN_CORE_ERROR("[opengl] failed to load compute shader module from binary file, id: (%u)", computeShader);
+            return Lvn_Result_Failure;
+        }
+
+        shader->computeShaderId = computeShader;
+        return Lvn_Result_Success;
+    }
+
     LvnData<uint8_t> vertbin = lvn::loadFileSrcBin(createInfo->vertexSrc.c_str());
     LvnData<uint8_t> fragbin = lvn::loadFileSrcBin(createInfo->fragmentSrc.c_str());
 
@@ -967,40 +1976,52 @@ LvnResult oglsImplCreateShaderFromFileBin(LvnShader* shader, const LvnShaderCrea
 LvnResult oglsImplCreateDescriptorLayout(LvnDescriptorLayout* descriptorLayout, const LvnDescriptorLayoutCreateInfo* createInfo)
 {
     descriptorLayout->descriptorLayout = nullptr;
-    descriptorLayout->descriptorPool = new OglDescriptorSet[descriptorLayout->descriptorSets.size()];
+    descriptorLayout->descriptorPool = new OglDescriptorAllocator();
 
-    for (uint64_t i = 0; i < descriptorLayout->descriptorSets.size(); i++)
-    {
-        OglDescriptorSet* descriptorSet = &static_cast<OglDescriptorSet*>(descriptorLayout->descriptorPool)[i];
+    // opengl has no descriptor pools, sets are created as they are allocated
+    descriptorLayout->stats.poolCount = 1;
+    descriptorLayout->stats.transientPoolCount = 1;
 
-        for (uint32_t j = 0; j < createInfo->descriptorBindingCount; j++)
-        {
-            LvnDescriptorType descriptorType = createInfo->pDescriptorBindings[j].descriptorType;
+    return Lvn_Result_Success;
+}
 
-            if (descriptorType == Lvn_DescriptorType_UniformBuffer || descriptorType == Lvn_DescriptorType_StorageBuffer)
-            {
-                OglDescriptorBinding descriptorBinding{};
-                descriptorBinding.type = descriptorType;
-                descriptorBinding.binding = createInfo->pDescriptorBindings[j].binding;
-                descriptorSet->uniformBuffers.push_back(descriptorBinding);
-            }
-            else if (descriptorType == Lvn_DescriptorType_ImageSampler)
-            {
-                OglDescriptorBinding descriptorBinding{};
-                descriptorBinding.type = descriptorType;
-                descriptorBinding.binding = createInfo->pDescriptorBindings[j].binding;
-                descriptorBinding.count = createInfo->pDescriptorBindings[j].descriptorCount;
-                descriptorSet->textures.push_back(descriptorBinding);
-            }
-        }
-    }
+LvnResult oglsImplAllocateDescriptorSet(LvnDescriptorSet* descriptorSet, LvnDescriptorLayout* descriptorLayout)
+{
+    OglDescriptorSet* descriptorSetPtr = new OglDescriptorSet();
+    ogls::initDescriptorSet(descriptorSetPtr, descriptorLayout->descriptorBindings);
 
+    descriptorSet->singleSet = descriptorSetPtr;
+    descriptorLayout->stats.poolSetCapacity++;
     return Lvn_Result_Success;
 }
 
-LvnResult oglsImplAllocateDescriptorSet(LvnDescriptorSet* descriptorSet, LvnDescriptorLayout* descriptorLayout)
+LvnResult oglsImplAllocateTransientDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout)
 {
-    descriptorSet->singleSet = &static_cast<OglDescriptorSet*>(descriptorLayout->descriptorPool)[descriptorLayout->descriptorSetIndex - 1]; // NOTE: set index minus one due to index shifted before
+    OglBackends* oglBackends = s_OglBackends;
+    OglDescriptorAllocator* allocator = static_cast<OglDescriptorAllocator*>(descriptorLayout->descriptorPool);
+
+    // draw commands are executed within the frame they are recorded in, sets of earlier frames are free again
+    if (allocator->transientFrame != oglBackends->frameIndex)
+    {
+        allocator->transientFrame = oglBackends->frameIndex;
+        allocator->transientCount = 0;
+        descriptorLayout->stats.transientSets = 0;
+    }
+
+    if (allocator->transientCount == allocator->transientSets.size())
+    {
+        LvnDescriptorSet* transientSet = lvn::memNew<LvnDescriptorSet>();
+        transientSet->transient = true;
+
+        OglDescriptorSet* descriptorSetPtr = new OglDescriptorSet();
+        ogls::initDescriptorSet(descriptorSetPtr, descriptorLayout->descriptorBindings);
+        transientSet->singleSet = descriptorSetPtr;
+
+        allocator->transientSets.push_back(transientSet);
+    }
+
+    *descriptorSet = allocator->transientSets[allocator->transientCount++];
+    descriptorLayout->stats.transientSets++;
     return Lvn_Result_Success;
 }
 
@@ -1029,6 +2050,8 @@ LvnResult oglsImplCreatePipeline(LvnPipeline* pipeline, const LvnPipelineCreateI
     pipelineEnums->depthCompareOp = ogls::getCompareOpEnum(createInfo->pipelineSpecification->depthstencil.depthOpCompare);
     pipelineEnums->topologyType = ogls::getTopologyTypeEnum(createInfo->pipelineSpecification->inputAssembly.topology);
 
+    ogls::createPushConstantBuffer(pipelineEnums, createInfo->pPushConstantRanges, createInfo->pushConstantRangeCount);
+
     if (pipelineEnums->enableBlending)
     {
         pipelineEnums->srcBlendFactor = ogls::getBlendFactorType(createInfo->pipelineSpecification->colorBlend.pColorBlendAttachments[0].srcColorBlendFactor);
@@ -1055,7 +2078,6 @@ LvnResult oglsImplCreatePipeline(LvnPipeline* pipeline, const LvnPipelineCreateI
 
         glEnableVertexArrayAttrib(pipeline->vaoId, attribute.layout);
         glVertexArrayAttribBinding(pipeline->vaoId, attribute.layout, attribute.binding);
-        // glVertexAttribDivisor(attribute.layout, 0);
 
         switch (type)
         {
@@ -1071,9 +2093,40 @@ LvnResult oglsImplCreatePipeline(LvnPipeline* pipeline, const LvnPipelineCreateI
         }
     }
 
-    for (uint32_t i = 0; i < createInfo->vertexBindingDescriptionCount; i++)
-        pipeline->bindingDescriptions[createInfo->pVertexBindingDescriptions[i].binding] = createInfo->pVertexBindingDescriptions[i].stride;
+    for (uint32_t i = 0; i < createInfo->vertexBindingDescriptionCount; i++)
+    {
+        const LvnVertexBindingDescription& bindingDescription = createInfo->pVertexBindingDescriptions[i];
+        pipeline->bindingDescriptions[bindingDescription.binding] = bindingDescription.stride;
+        glVertexArrayBindingDivisor(pipeline->vaoId, bindingDescription.binding, bindingDescription.inputRate == Lvn_VertexInputRate_Instance ? 1 : 0);
+    }
+
+
+    return Lvn_Result_Success;
+}
+
+LvnResult oglsImplCreateComputePipeline(LvnPipeline* pipeline, const LvnComputePipelineCreateInfo* createInfo)
+{
+    if (createInfo->shader->computeShaderId == 0)
+    {
+        LVN_CORE_ERROR("[opengl] cannot create compute pipeline (%p), shader (%p) was not created with a compute shader source", pipeline, createInfo->shader);
+        return Lvn_Result_Failure;
+    }
+
+    uint32_t shaderProgram = glCreateProgram();
+    glAttachShader(shaderProgram, createInfo->shader->computeShaderId);
+    glLinkProgram(shaderProgram);
+    if (ogls::checkShaderError(shaderProgram, GL_PROGRAM, "") != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("[opengl] failed to create shader program (id:%u) when creating compute pipeline (%p)", shaderProgram, pipeline);
+        return Lvn_Result_Failure;
+    }
+
+    pipeline->id = shaderProgram;
+    pipeline->vaoId = 0;
+    pipeline->nativePipeline = new OglPipelineEnums();
 
+    OglPipelineEnums* pipelineEnums = static_cast<OglPipelineEnums*>(pipeline->nativePipeline);
+    ogls::createPushConstantBuffer(pipelineEnums, createInfo->pPushConstantRanges, createInfo->pushConstantRangeCount);
 
     return Lvn_Result_Success;
 }
@@ -1104,16 +2157,45 @@ LvnResult oglsImplCreateFrameBuffer(LvnFrameBuffer* frameBuffer, const LvnFrameB
 
 LvnResult oglsImplCreateBuffer(LvnBuffer* buffer, const LvnBufferCreateInfo* createInfo)
 {
+    ogls::OglWorkerContextScope workerContext;
+
     glCreateBuffers(1, &buffer->id);
 
     if (createInfo->usage == Lvn_BufferUsage_Resize)
     {
         glNamedBufferData(buffer->id, createInfo->size, createInfo->data, GL_DYNAMIC_DRAW);
     }
+    else if (createInfo->usage == Lvn_BufferUsage_DynamicRing)
+    {
+        // ring buffers are mapped once and written directly, each frame writes to its own region so no driver copies or implicit syncs are needed
+        OglBackends* oglBackends = s_OglBackends;
+        uint64_t alignment = oglBackends->bufferRegionAlignment;
+        uint64_t regionSize = (createInfo->size + alignment - 1) & ~(alignment - 1);
+
+        GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glNamedBufferStorage(buffer->id, regionSize * LVN_OPENGL_BUFFER_REGIONS, nullptr, mapFlags);
+        buffer->bufferMap = glMapNamedBufferRange(buffer->id, 0, regionSize * LVN_OPENGL_BUFFER_REGIONS, mapFlags);
+
+        if (!buffer->bufferMap)
+        {
+            LVN_CORE_ERROR("[opengl] failed to map ring buffer, id: %u, size: %llu", buffer->id, createInfo->size);
+            glDeleteBuffers(1, &buffer->id);
+            return Lvn_Result_Failure;
+        }
+
+        if (createInfo->data)
+        {
+            for (uint32_t i = 0; i < LVN_OPENGL_BUFFER_REGIONS; i++)
+                memcpy(static_cast<uint8_t*>(buffer->bufferMap) + regionSize * i, createInfo->data, createInfo->size);
+        }
+
+        buffer->regionSize = regionSize;
+    }
     else
     {
-        GLbitfield usage = createInfo->usage == Lvn_BufferUsage_Dynamic ? GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT | GL_MAP_COHERENT_BIT | GL_MAP_PERSISTENT_BIT : 0;
-        glNamedBufferStorage(buffer->id, createInfo->size, createInfo->data, usage);
+        // dynamic and device local buffers keep a single region that is updated with sub data or mapped with explicit flushes, the driver synchronizes updates with draws in flight
+        bool dynamic = createInfo->usage == Lvn_BufferUsage_Dynamic || createInfo->usage == Lvn_BufferUsage_DynamicDeviceLocal;
+        glNamedBufferStorage(buffer->id, createInfo->size, createInfo->data, dynamic ? (GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT) : 0);
     }
 
     buffer->type = createInfo->type;
@@ -1138,6 +2220,9 @@ LvnResult oglsImplCreateSampler(LvnSampler* sampler, const LvnSamplerCreateInfo*
 
 LvnResult oglsImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo* createInfo)
 {
+    ogls::OglWorkerContextScope workerContext;
+    ogls::resetStateCache();
+
     GLenum format = createInfo->format == Lvn_TextureFormat_Unorm ? GL_RGB8 : GL_SRGB8;
     GLenum internalFormat = GL_RGB;
     switch (createInfo->imageData.channels)
@@ -1148,6 +2233,9 @@ LvnResult oglsImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo*
         case 4: { internalFormat = createInfo->format == Lvn_TextureFormat_Unorm ? GL_RGBA8 : GL_SRGB8_ALPHA8; format = GL_RGBA; break; }
     }
 
+    if (createInfo->imageData.compression != Lvn_TextureCompression_None)
+        internalFormat = ogls::getCompressedTextureFormatEnum(createInfo->imageData.compression, createInfo->format);
+
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
     glCreateTextures(GL_TEXTURE_2D, 1, &texture->id);
@@ -1155,13 +2243,16 @@ LvnResult oglsImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo*
     glTextureParameteri(texture->id, GL_TEXTURE_WRAP_S, ogls::getTextureWrapModeEnum(createInfo->wrapS));
     glTextureParameteri(texture->id, GL_TEXTURE_WRAP_T, ogls::getTextureWrapModeEnum(createInfo->wrapT));
     glTextureParameteri(texture->id, GL_TEXTURE_WRAP_R, ogls::getTextureWrapModeEnum(createInfo->wrapT));
-    glTextureParameteri(texture->id, GL_TEXTURE_MIN_FILTER, ogls::getTextureFilterEnum(createInfo->minFilter));
     glTextureParameteri(texture->id, GL_TEXTURE_MAG_FILTER, ogls::getTextureFilterEnum(createInfo->magFilter));
 
-    glTextureStorage2D(texture->id, 1, internalFormat, createInfo->imageData.width, createInfo->imageData.height);
-    glTextureSubImage2D(texture->id, 0, 0, 0, createInfo->imageData.width, createInfo->imageData.height, format, GL_UNSIGNED_BYTE, createInfo->imageData.pixels.data());
+    uint32_t mipLevels = createInfo->mipLevels;
+    if (ogls::uploadTextureImage(texture->id, internalFormat, format, createInfo->imageData, createInfo->pMipImageData, &mipLevels) != Lvn_Result_Success)
+    {
+        glDeleteTextures(1, &texture->id);
+        return Lvn_Result_Failure;
+    }
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+    glTextureParameteri(texture->id, GL_TEXTURE_MIN_FILTER, mipLevels > 1 ? ogls::getTextureMipmapFilterEnum(createInfo->minFilter) : ogls::getTextureFilterEnum(createInfo->minFilter));
 
     if (ogls::checkErrorCode() == Lvn_Result_Failure)
     {
@@ -1169,10 +2260,11 @@ LvnResult oglsImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo*
         return Lvn_Result_Failure;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     texture->width = createInfo->imageData.width;
     texture->height = createInfo->imageData.height;
+    texture->channels = createInfo->imageData.channels;
+    texture->mipLevels = mipLevels;
+    texture->compression = createInfo->imageData.compression;
     texture->seperateSampler = false;
 
     return Lvn_Result_Success;
@@ -1180,6 +2272,9 @@ LvnResult oglsImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo*
 
 LvnResult oglsImplCreateTextureSampler(LvnTexture* texture, const LvnTextureSamplerCreateInfo* createInfo)
 {
+    ogls::OglWorkerContextScope workerContext;
+    ogls::resetStateCache();
+
     OglSampler* sampler = static_cast<OglSampler*>(createInfo->sampler->sampler);
 
     GLenum format = createInfo->format == Lvn_TextureFormat_Unorm ? GL_RGB8 : GL_SRGB8;
@@ -1192,21 +2287,26 @@ LvnResult oglsImplCreateTextureSampler(LvnTexture* texture, const LvnTextureSamp
         case 4: { internalFormat = createInfo->format == Lvn_TextureFormat_Unorm ? GL_RGBA8 : GL_SRGB8_ALPHA8; format = GL_RGBA; break; }
     }
 
+    if (createInfo->imageData.compression != Lvn_TextureCompression_None)
+        internalFormat = ogls::getCompressedTextureFormatEnum(createInfo->imageData.compression, createInfo->format);
+
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
     uint32_t id;
     glCreateTextures(GL_TEXTURE_2D, 1, &id);
-    glTextureStorage2D(id, 1, internalFormat, createInfo->imageData.width, createInfo->imageData.height);
 
-    glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ogls::getTextureWrapModeEnum(sampler->wrapS));
-    glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ogls::getTextureWrapModeEnum(sampler->wrapT));
-    glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, ogls::getTextureWrapModeEnum(sampler->wrapT));
-    glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, ogls::getTextureFilterEnum(sampler->minFilter));
-    glTextureParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, ogls::getTextureFilterEnum(sampler->magFilter));
-
-    glTextureSubImage2D(id, 0, 0, 0, createInfo->imageData.width, createInfo->imageData.height, format, GL_UNSIGNED_BYTE, createInfo->imageData.pixels.data());
+    uint32_t mipLevels = createInfo->mipLevels;
+    if (ogls::uploadTextureImage(id, internalFormat, format, createInfo->imageData, createInfo->pMipImageData, &mipLevels) != Lvn_Result_Success)
+    {
+        glDeleteTextures(1, &id);
+        return Lvn_Result_Failure;
+    }
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+    glTextureParameteri(id, GL_TEXTURE_WRAP_S, ogls::getTextureWrapModeEnum(sampler->wrapS));
+    glTextureParameteri(id, GL_TEXTURE_WRAP_T, ogls::getTextureWrapModeEnum(sampler->wrapT));
+    glTextureParameteri(id, GL_TEXTURE_WRAP_R, ogls::getTextureWrapModeEnum(sampler->wrapT));
+    glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, mipLevels > 1 ? ogls::getTextureMipmapFilterEnum(sampler->minFilter) : ogls::getTextureFilterEnum(sampler->minFilter));
+    glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, ogls::getTextureFilterEnum(sampler->magFilter));
 
     if (ogls::checkErrorCode() == Lvn_Result_Failure)
     {
@@ -1214,11 +2314,12 @@ LvnResult oglsImplCreateTextureSampler(LvnTexture* texture, const LvnTextureSamp
         return Lvn_Result_Failure;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     texture->id = id;
     texture->width = createInfo->imageData.width;
     texture->height = createInfo->imageData.height;
+    texture->channels = createInfo->imageData.channels;
+    texture->mipLevels = mipLevels;
+    texture->compression = createInfo->imageData.compression;
     texture->seperateSampler = true;
 
     return Lvn_Result_Success;
@@ -1226,13 +2327,37 @@ LvnResult oglsImplCreateTextureSampler(LvnTexture* texture, const LvnTextureSamp
 
 LvnResult oglsImplCreateCubemap(LvnCubemap* cubemap, const LvnCubemapCreateInfo* createInfo)
 {
-    uint32_t id;
-    glGenTextures(1, &id);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, id);
+    ogls::OglWorkerContextScope workerContext;
+    ogls::resetStateCache();
 
     const LvnImageData* texImages[6] = { &createInfo->posx, &createInfo->negx, &createInfo->posy, &createInfo->negy, &createInfo->posz, &createInfo->negz };
 
-    for(uint32_t i = 0; i < 6; i++)
+    // immutable storage needs one size and format for every face
+    GLenum internalFormat = GL_RGBA8;
+    switch (texImages[0]->channels)
+    {
+        case 1: { internalFormat = GL_R8; break; }
+        case 2: { internalFormat = GL_RG8; break; }
+        case 3: { internalFormat = GL_RGB8; break; }
+        case 4: { internalFormat = GL_RGBA8; break; }
+    }
+
+    for (uint32_t i = 1; i < 6; i++)
+    {
+        if (texImages[i]->width != texImages[0]->width || texImages[i]->height != texImages[0]->height)
+        {
+            LVN_CORE_ERROR("[opengl] cubemap (%p) face (%u) has dimensions (w:%u,h:%u), every face must match the first face (w:%u,h:%u)", cubemap, i, texImages[i]->width, texImages[i]->height, texImages[0]->width, texImages[0]->height);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    uint32_t id;
+    glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &id);
+    glTextureStorage2D(id, 1, internalFormat, texImages[0]->width, texImages[0]->height);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    for (uint32_t i = 0; i < 6; i++)
     {
         GLenum texFormat = GL_RGBA;
         switch (texImages[i]->channels)
@@ -1245,18 +2370,20 @@ LvnResult oglsImplCreateCubemap(LvnCubemap* cubemap, const LvnCubemapCreateInfo*
             default:
             {
                 LVN_CORE_ERROR("[opengl] invalid texture channel format (%u) when creating texture for cubemap (%p)", texImages[i]->channels, cubemap);
+                glDeleteTextures(1, &id);
                 return Lvn_Result_Failure;
             }
         }
 
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, texFormat, texImages[i]->width, texImages[i]->height, 0, texFormat, GL_UNSIGNED_BYTE, texImages[i]->pixels.data());
+        // cubemap faces are the layers of the texture with dsa
+        glTextureSubImage3D(id, 0, 0, 0, i, texImages[i]->width, texImages[i]->height, 1, texFormat, GL_UNSIGNED_BYTE, texImages[i]->pixels.data());
     }
 
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(id, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
     LvnTexture texData{};
     texData.id = id;
@@ -1266,9 +2393,150 @@ LvnResult oglsImplCreateCubemap(LvnCubemap* cubemap, const LvnCubemapCreateInfo*
     return Lvn_Result_Success;
 }
 
-LvnResult oglsImplCreateCubemapHdr(LvnCubemap* cubemap, const LvnCubemapHdrCreateInfo* createInfo)
+LvnResult oglsImplCreateEnvironmentMap(LvnEnvironmentMap* environmentMap, const LvnEnvironmentMapBakeInfo* bakeInfo)
 {
-    // TODO: implement cubemap hdr
+    ogls::resetStateCache();
+
+    // vulkan always filters across cubemap faces, match it so the baked maps look the same on both backends
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    ogls::createEnvironmentMapTexture(&environmentMap->cubemap, GL_TEXTURE_CUBE_MAP, bakeInfo->cubemapSize, lvn::imageGetMipLevelCount(bakeInfo->cubemapSize, bakeInfo->cubemapSize));
+
+    if (!bakeInfo->cubemapOnly)
+    {
+        ogls::createEnvironmentMapTexture(&environmentMap->irradiance, GL_TEXTURE_CUBE_MAP, bakeInfo->irradianceSize, 1);
+        ogls::createEnvironmentMapTexture(&environmentMap->prefilter, GL_TEXTURE_CUBE_MAP, bakeInfo->prefilterSize, bakeInfo->prefilterMipLevels);
+        ogls::createEnvironmentMapTexture(&environmentMap->brdfLut, GL_TEXTURE_2D, bakeInfo->brdfLutSize, 1);
+    }
+
+    // levels that are uploaded or read back, in the order of the baked data; the cubemap mips are generated instead of stored
+    const LvnTexture* levels[3] = { &environmentMap->cubemap, &environmentMap->irradiance, &environmentMap->prefilter };
+    uint32_t levelTextureCount = bakeInfo->cubemapOnly ? 0 : 3;
+
+    if (bakeInfo->pBakedData)
+    {
+        const uint8_t* data = bakeInfo->pBakedData;
+
+        for (uint32_t i = 0; i < levelTextureCount; i++)
+        {
+            uint32_t copyLevels = i == 0 ? 1 : levels[i]->mipLevels;
+            for (uint32_t j = 0; j < copyLevels; j++)
+            {
+                uint32_t mipSize = lvn::max(levels[i]->width >> j, 1u);
+                glTextureSubImage3D(levels[i]->id, j, 0, 0, 0, mipSize, mipSize, 6, GL_RGBA, GL_HALF_FLOAT, data);
+                data += 6 * (uint64_t)mipSize * mipSize * LVN_OPENGL_ENVIRONMENT_MAP_TEXEL_SIZE;
+            }
+        }
+
+        glTextureSubImage2D(environmentMap->brdfLut.id, 0, 0, 0, environmentMap->brdfLut.width, environmentMap->brdfLut.height, GL_RGBA, GL_HALF_FLOAT, data);
+        glGenerateTextureMipmap(environmentMap->cubemap.id);
+    }
+    else
+    {
+        // equirectangular source image, sampled with repeat around the horizon and clamped at the poles
+        GLenum equirectFormat = GL_RGBA32F, equirectDataFormat = GL_RGBA, equirectType = GL_FLOAT;
+        if (bakeInfo->format == Lvn_HdrImageFormat_Half)
+        {
+            equirectFormat = GL_RGBA16F;
+            equirectType = GL_HALF_FLOAT;
+        }
+        else if (bakeInfo->format == Lvn_HdrImageFormat_Rgb9e5)
+        {
+            equirectFormat = GL_RGB9_E5;
+            equirectDataFormat = GL_RGB;
+            equirectType = GL_UNSIGNED_INT_5_9_9_9_REV;
+        }
+
+        uint32_t equirectTexture;
+        glCreateTextures(GL_TEXTURE_2D, 1, &equirectTexture);
+        glTextureStorage2D(equirectTexture, 1, equirectFormat, bakeInfo->width, bakeInfo->height);
+        glTextureSubImage2D(equirectTexture, 0, 0, 0, bakeInfo->width, bakeInfo->height, equirectDataFormat, equirectType, bakeInfo->pixels);
+        glTextureParameteri(equirectTexture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(equirectTexture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTextureParameteri(equirectTexture, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTextureParameteri(equirectTexture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        const char* shaderSrcs[4] = { bakeInfo->equirectToCubemapSrc, bakeInfo->irradianceSrc, bakeInfo->prefilterSrc, bakeInfo->brdfLutSrc };
+        uint32_t programCount = bakeInfo->cubemapOnly ? 1 : 4;
+        uint32_t programs[4] = { 0, 0, 0, 0 };
+        bool compiled = true;
+
+        for (uint32_t i = 0; i < programCount && compiled; i++)
+        {
+            programs[i] = ogls::createComputeProgram(shaderSrcs[i]);
+            compiled = programs[i] != 0;
+        }
+
+        if (compiled)
+        {
+            glBindTextureUnit(0, equirectTexture);
+            ogls::dispatchEnvironmentMapPass(programs[0], environmentMap->cubemap.id, 0, true, environmentMap->cubemap.width);
+
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+            glGenerateTextureMipmap(environmentMap->cubemap.id);
+
+            if (!bakeInfo->cubemapOnly)
+            {
+                glBindTextureUnit(0, environmentMap->cubemap.id);
+                ogls::dispatchEnvironmentMapPass(programs[1], environmentMap->irradiance.id, 0, true, environmentMap->irradiance.width);
+
+                uint32_t prefilterMipLevels = environmentMap->prefilter.mipLevels;
+                for (uint32_t i = 0; i < prefilterMipLevels; i++)
+                {
+                    glProgramUniform1f(programs[2], 0, prefilterMipLevels > 1 ? (float)i / (float)(prefilterMipLevels - 1) : 0.0f);
+                    ogls::dispatchEnvironmentMapPass(programs[2], environmentMap->prefilter.id, i, true, lvn::max(environmentMap->prefilter.width >> i, 1u));
+                }
+
+                ogls::dispatchEnvironmentMapPass(programs[3], environmentMap->brdfLut.id, 0, false, environmentMap->brdfLut.width);
+            }
+
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+            if (bakeInfo->pBakedDataOut && !bakeInfo->cubemapOnly)
+            {
+                LvnVector<uint8_t>& bakedData = *bakeInfo->pBakedDataOut;
+                bakedData.resize(lvn::environmentMapGetBakedSize(bakeInfo));
+                uint8_t* data = bakedData.data();
+
+                for (uint32_t i = 0; i < levelTextureCount; i++)
+                {
+                    uint32_t copyLevels = i == 0 ? 1 : levels[i]->mipLevels;
+                    for (uint32_t j = 0; j < copyLevels; j++)
+                    {
+                        uint32_t mipSize = lvn::max(levels[i]->width >> j, 1u);
+                        uint64_t levelSize = 6 * (uint64_t)mipSize * mipSize * LVN_OPENGL_ENVIRONMENT_MAP_TEXEL_SIZE;
+                        glGetTextureImage(levels[i]->id, j, GL_RGBA, GL_HALF_FLOAT, levelSize, data);
+                        data += levelSize;
+                    }
+                }
+
+                uint64_t brdfLutSize = (uint64_t)environmentMap->brdfLut.width * environmentMap->brdfLut.height * LVN_OPENGL_ENVIRONMENT_MAP_TEXEL_SIZE;
+                glGetTextureImage(environmentMap->brdfLut.id, 0, GL_RGBA, GL_HALF_FLOAT, brdfLutSize, data);
+            }
+
+            glBindImageTexture(1, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+            glBindTextureUnit(0, 0);
+            glUseProgram(0);
+        }
+
+        for (uint32_t i = 0; i < 4; i++)
+            glDeleteProgram(programs[i]);
+        glDeleteTextures(1, &equirectTexture);
+
+        if (!compiled)
+        {
+            LVN_CORE_ERROR("[opengl] failed to compile environment map compute shaders for environment map (%p)", environmentMap);
+            oglsImplDestroyEnvironmentMap(environmentMap);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    if (ogls::checkErrorCode() == Lvn_Result_Failure)
+    {
+        LVN_CORE_ERROR("[opengl] last error check occurance when creating environment map (%p)", environmentMap);
+        oglsImplDestroyEnvironmentMap(environmentMap);
+        return Lvn_Result_Failure;
+    }
 
     return Lvn_Result_Success;
 }
@@ -1278,32 +2546,32 @@ void oglsImplDestroyShader(LvnShader* shader)
 {
     glDeleteShader(shader->vertexShaderId);
     glDeleteShader(shader->fragmentShaderId);
+    glDeleteShader(shader->computeShaderId);
 }
 
 void oglsImplDestroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout)
 {
-    for (uint64_t i = 0; i < descriptorLayout->descriptorSets.size(); i++)
-    {
-        OglDescriptorSet* descriptorSet = &static_cast<OglDescriptorSet*>(descriptorLayout->descriptorPool)[i];
+    OglDescriptorAllocator* allocator = static_cast<OglDescriptorAllocator*>(descriptorLayout->descriptorPool);
 
-        for (const OglBindlessTextureBinding& bindlessTexBinding : descriptorSet->bindlessTextures)
-        {
-            for (const uint64_t& handle : bindlessTexBinding.textureHandles)
-            {
-                glMakeTextureHandleNonResidentARB(handle);
-            }
+    for (LvnDescriptorSet* descriptorSet : descriptorLayout->descriptorSets)
+        ogls::destroyDescriptorSet(static_cast<OglDescriptorSet*>(descriptorSet->singleSet));
 
-            glDeleteBuffers(1, &bindlessTexBinding.ssbo);
-        }
-        descriptorSet->bindlessTextures.clear();
+    for (LvnDescriptorSet* transientSet : allocator->transientSets)
+    {
+        ogls::destroyDescriptorSet(static_cast<OglDescriptorSet*>(transientSet->singleSet));
+        lvn::memDelete(transientSet);
     }
 
-    delete [] static_cast<OglDescriptorSet*>(descriptorLayout->descriptorPool);
+    delete allocator;
 }
 
 void oglsImplDestroyPipeline(LvnPipeline* pipeline)
 {
+    ogls::resetStateCache();
+
     OglPipelineEnums* pipelineEnums = static_cast<OglPipelineEnums*>(pipeline->nativePipeline);
+    if (pipelineEnums->pushConstantBuffer != 0)
+        glDeleteBuffers(1, &pipelineEnums->pushConstantBuffer);
     delete pipelineEnums;
 
     glDeleteProgram(pipeline->id);
@@ -1312,6 +2580,8 @@ void oglsImplDestroyPipeline(LvnPipeline* pipeline)
 
 void oglsImplDestroyFrameBuffer(LvnFrameBuffer* frameBuffer)
 {
+    ogls::resetStateCache();
+
     OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(frameBuffer->frameBufferData);
 
     glDeleteFramebuffers(1, &frameBufferData->id);
@@ -1330,6 +2600,8 @@ void oglsImplDestroyFrameBuffer(LvnFrameBuffer* frameBuffer)
 
 void oglsImplDestroyBuffer(LvnBuffer* buffer)
 {
+    ogls::resetStateCache();
+
     glDeleteBuffers(1, &buffer->id);
 }
 
@@ -1341,14 +2613,28 @@ void oglsImplDestroySampler(LvnSampler* sampler)
 
 void oglsImplDestroyTexture(LvnTexture* texture)
 {
+    ogls::resetStateCache();
+
     glDeleteTextures(1, &texture->id);
 }
 
 void oglsImplDestroyCubemap(LvnCubemap* cubemap)
 {
+    ogls::resetStateCache();
+
     glDeleteTextures(1, &cubemap->textureData.id);
 }
 
+void oglsImplDestroyEnvironmentMap(LvnEnvironmentMap* environmentMap)
+{
+    ogls::resetStateCache();
+
+    glDeleteTextures(1, &environmentMap->cubemap.id);
+    glDeleteTextures(1, &environmentMap->irradiance.id);
+    glDeleteTextures(1, &environmentMap->prefilter.id);
+    glDeleteTextures(1, &environmentMap->brdfLut.id);
+}
+
 void oglsImplRenderCmdDraw(LvnWindow* window, uint32_t vertexCount)
 {
     glDrawArrays(window->topologyTypeEnum, 0, vertexCount);
@@ -1369,11 +2655,113 @@ void oglsImplRenderCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCoun
     glDrawElementsInstancedBaseInstance(window->topologyTypeEnum, indexCount, GL_UNSIGNED_INT, (void*)(uintptr_t)window->indexOffset, instanceCount, firstInstance);
 }
 
+void oglsImplRenderCmdDrawIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer->id);
+    glMultiDrawArraysIndirect(window->topologyTypeEnum, (void*)(uintptr_t)(offset + ogls::getBufferRegionOffset(buffer)), drawCount, stride);
+}
+
+void oglsImplRenderCmdDrawIndexedIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    // NOTE: firstIndex in the indirect commands is relative to the start of the index buffer, the bound index offset is not applied
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer->id);
+    glMultiDrawElementsIndirect(window->topologyTypeEnum, GL_UNSIGNED_INT, (void*)(uintptr_t)(offset + ogls::getBufferRegionOffset(buffer)), drawCount, stride);
+}
+
+void oglsImplRenderCmdDrawIndexedIndirectCount(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, LvnBuffer* countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer->id);
+    glBindBuffer(GL_PARAMETER_BUFFER, countBuffer->id);
+    glMultiDrawElementsIndirectCount(window->topologyTypeEnum, GL_UNSIGNED_INT, (void*)(uintptr_t)(offset + ogls::getBufferRegionOffset(buffer)), static_cast<GLintptr>(countBufferOffset + ogls::getBufferRegionOffset(countBuffer)), maxDrawCount, stride);
+}
+
 void oglsImplRenderCmdSetStencilReference(uint32_t reference)
 {
     
 }
 
+void oglsImplRenderCmdSetCullMode(LvnWindow* window, LvnCullFaceMode cullMode)
+{
+    // bound pipelines always reapply their own state, dynamic state lasts until the next bind
+    OglStateCache& cache = s_OglBackends->stateCache;
+
+    ogls::setCapability(GL_CULL_FACE, &cache.cullFace, cullMode != Lvn_CullFaceMode_Disable);
+    if (cullMode == Lvn_CullFaceMode_Disable) { return; }
+
+    GLenum mode = ogls::getCullFaceModeEnum(cullMode);
+    if (cache.cullMode != mode)
+    {
+        glCullFace(mode);
+        cache.cullMode = mode;
+    }
+}
+
+void oglsImplRenderCmdSetFrontFace(LvnWindow* window, LvnCullFrontFace frontFace)
+{
+    OglStateCache& cache = s_OglBackends->stateCache;
+
+    GLenum face = ogls::getCullFrontFaceEnum(frontFace);
+    if (cache.frontFace != face)
+    {
+        glFrontFace(face);
+        cache.frontFace = face;
+    }
+}
+
+void oglsImplRenderCmdSetPrimitiveTopology(LvnWindow* window, LvnTopologyType topology)
+{
+    window->topologyTypeEnum = ogls::getTopologyTypeEnum(topology);
+}
+
+void oglsImplRenderCmdSetDepthTest(LvnWindow* window, bool enableDepth, bool depthWrite, LvnCompareOperation depthOpCompare)
+{
+    OglStateCache& cache = s_OglBackends->stateCache;
+
+    ogls::setCapability(GL_DEPTH_TEST, &cache.depthTest, enableDepth);
+    if (!enableDepth) { return; }
+
+    ogls::setDepthMask(depthWrite);
+    GLenum depthFunc = ogls::getCompareOpEnum(depthOpCompare);
+    if (cache.depthFunc != depthFunc)
+    {
+        glDepthFunc(depthFunc);
+        cache.depthFunc = depthFunc;
+    }
+}
+
+void oglsImplRenderCmdSetBlendEnable(LvnWindow* window, uint32_t attachment, bool enable)
+{
+    OglStateCache& cache = s_OglBackends->stateCache;
+
+    if (attachment == 0)
+    {
+        ogls::setCapability(GL_BLEND, &cache.blend, enable);
+        return;
+    }
+
+    // other draw buffers are set individually, the cached state no longer describes every attachment
+    if (enable)
+        glEnablei(GL_BLEND, attachment);
+    else
+        glDisablei(GL_BLEND, attachment);
+    cache.blend = UINT32_MAX;
+}
+
+void oglsImplRenderCmdSetScissor(LvnWindow* window, int32_t x, int32_t y, uint32_t width, uint32_t height)
+{
+    // gl scissors count from the bottom left like the viewport, framebuffers add the offset of their viewport
+    LvnFrameBuffer* frameBuffer = s_OglBackends->passFrameBuffer;
+    if (frameBuffer)
+    {
+        OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(frameBuffer->frameBufferData);
+        x += frameBufferData->x;
+        y += frameBufferData->y;
+    }
+
+    ogls::setCapability(GL_SCISSOR_TEST, &s_OglBackends->stateCache.scissorTest, true);
+    glScissor(x, y, width, height);
+}
+
 void oglsImplRenderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask)
 {
     
@@ -1381,17 +2769,34 @@ void oglsImplRenderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask)
 
 void oglsImplRenderBeginNextFrame(LvnWindow* window)
 {
-    
+    OglBackends* oglBackends = s_OglBackends;
+
+    // ring buffer writes of this frame go to the region used LVN_OPENGL_BUFFER_REGIONS frames ago, the gpu must be done reading it
+    oglBackends->bufferRegion = oglBackends->frameIndex % LVN_OPENGL_BUFFER_REGIONS;
+    ogls::waitRegionFence(oglBackends, oglBackends->bufferRegion);
+
+    oglBackends->frameIndex++;
+
+    ogls::readTimestampQueries(window);
+    ogls::completeReadbacks(oglBackends, false);
 }
 
 void oglsImplRenderDrawSubmit(LvnWindow* window)
 {
-    
+    OglBackends* oglBackends = s_OglBackends;
+
+    // fence the region after the frame's commands, it may be written again once they complete
+    if (oglBackends->regionFences[oglBackends->bufferRegion] != nullptr)
+        glDeleteSync(static_cast<GLsync>(oglBackends->regionFences[oglBackends->bufferRegion]));
+
+    oglBackends->regionFences[oglBackends->bufferRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 }
 
 void oglsImplRenderBeginCommandRecording(LvnWindow* window)
 {
-    window->cmdBuffer.clear();
+    // each window records with its own context, the cached state of the previous context does not apply
+    ogls::resetStateCache();
+    window->cmdBufferSize = 0;
 }
 
 void oglsImplRenderEndCommandRecording(LvnWindow* window)
@@ -1399,7 +2804,10 @@ void oglsImplRenderEndCommandRecording(LvnWindow* window)
     uint64_t offset = 0;
     uint8_t* data = window->cmdBuffer.data();
 
-    while (offset < window->cmdBuffer.size())
+    // objects may have been created or destroyed while the commands were recorded
+    ogls::resetStateCache();
+
+    while (offset < window->cmdBufferSize)
     {
         LvnDrawCmdHeader* header = reinterpret_cast<LvnDrawCmdHeader*>(&data[offset]);
         header->callFunc(&data[offset]);
@@ -1407,12 +2815,40 @@ void oglsImplRenderEndCommandRecording(LvnWindow* window)
     }
 }
 
+// every opengl context swaps its own buffers, there is no queue to batch the windows on
+void oglsImplRenderBeginSubmitBatch()
+{
+
+}
+
+void oglsImplRenderEndSubmitBatch()
+{
+
+}
+
+LvnResult oglsImplRenderBeginSecondaryCommandRecording(LvnWindow* window, LvnFrameBuffer* frameBuffer)
+{
+    // gl commands can only be issued from the thread owning the context
+    LVN_CORE_ERROR("[opengl] secondary command recording is not supported by the opengl backend, record render commands on the thread owning the context");
+    return Lvn_Result_Failure;
+}
+
+void oglsImplRenderEndSecondaryCommandRecording(LvnWindow* window)
+{
+
+}
+
 void oglsImplRenderCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a)
 {
     GLFWwindow* glfwWindow = static_cast<GLFWwindow*>(window->nativeWindow);
     int width, height;
     glfwGetFramebufferSize(glfwWindow, &width, &height);
 
+    // a scissor left from the last pass would clip the clear
+    ogls::setCapability(GL_SCISSOR_TEST, &s_OglBackends->stateCache.scissorTest, false);
+    s_OglBackends->passFrameBuffer = nullptr;
+
+    ogls::setDepthMask(true);
     glClearColor(r, g, b, a);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glViewport(0, 0, width, height);
@@ -1425,47 +2861,7 @@ void oglsImplRenderCmdEndRenderPass(LvnWindow* window)
 
 void oglsImplRenderCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline)
 {
-    OglPipelineEnums* pipelineEnums = static_cast<OglPipelineEnums*>(pipeline->nativePipeline);
-
-    // depth
-    if (pipelineEnums->enableDepth)
-    {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(pipelineEnums->depthCompareOp);
-    }
-    else
-    {
-        glDisable(GL_DEPTH_TEST);
-    }
-
-    // color blend
-    if (pipelineEnums->enableBlending)
-    {
-        glEnable(GL_BLEND);
-        glBlendFunc(pipelineEnums->srcBlendFactor, pipelineEnums->dstBlendFactor);
-    }
-    else
-    {
-        glDisable(GL_BLEND);
-    }
-
-    if (pipelineEnums->enableCulling)
-    {
-        glEnable(GL_CULL_FACE);
-        glCullFace(pipelineEnums->cullMode);
-        glFrontFace(pipelineEnums->frontFace);
-    }
-    else
-    {
-        glDisable(GL_CULL_FACE);
-    }
-
-    glUseProgram(pipeline->id);
-    glBindVertexArray(pipeline->vaoId);
-
-    window->topologyTypeEnum = pipelineEnums->topologyType;
-    window->vao = pipeline->vaoId;
-    window->bindingDescriptions = &pipeline->bindingDescriptions;
+    ogls::bindPipeline(window, pipeline);
 }
 
 void oglsImplRenderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets)
@@ -1474,66 +2870,56 @@ void oglsImplRenderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding,
 
     for (uint32_t i = firstBinding; i < bindingCount; i++)
     {
-        glVertexArrayVertexBuffer(window->vao, i, pBuffers[i]->id, pOffsets[i], (*bindingDescriptions)[i]);
+        glVertexArrayVertexBuffer(window->vao, i, pBuffers[i]->id, pOffsets[i] + ogls::getBufferRegionOffset(pBuffers[i]), (*bindingDescriptions)[i]);
     }
 }
 
 void oglsImplRenderCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset)
 {
     glVertexArrayElementBuffer(window->vao, buffer->id);
-    window->indexOffset = offset;
+    window->indexOffset = offset + ogls::getBufferRegionOffset(buffer);
 }
 
-void oglsImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets)
+void oglsImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline*, uint32_t, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets)
 {
-    OglBackends* oglBackends = s_OglBackends;
-    int texCount = 0;
-
-    for (uint32_t i = 0; i < descriptorSetCount; i++)
-    {
-        OglDescriptorSet* descriptorSetPtr = static_cast<OglDescriptorSet*>(pDescriptorSets[i]->singleSet);
+    ogls::bindDescriptorSets(descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+}
 
-        // uniform/storage buffers
-        for (uint32_t j = 0; j < descriptorSetPtr->uniformBuffers.size(); j++)
-        {
-            glBindBufferRange(ogls::getUniformBufferTypeEnum(descriptorSetPtr->uniformBuffers[j].type),
-                descriptorSetPtr->uniformBuffers[j].binding,
-                descriptorSetPtr->uniformBuffers[j].id,
-                static_cast<GLintptr>(descriptorSetPtr->uniformBuffers[j].offset),
-                static_cast<GLsizeiptr>(descriptorSetPtr->uniformBuffers[j].range));
-        }
+void oglsImplRenderCmdPushConstants(LvnWindow* window, LvnPipeline* pipeline, LvnShaderStage, uint32_t offset, uint32_t size, const void* data)
+{
+    ogls::pushConstants(pipeline, offset, size, data);
+}
 
-        // textures
-        for (uint32_t j = 0; j < descriptorSetPtr->textures.size(); j++)
-        {
-            if (texCount >= oglBackends->maxTextureUnitSlots)
-            {
-                LVN_CORE_WARN("maximum texture unit slots exceeded, cannot bind more texture unit slots to one shader pipeline. Max slots: %u", oglBackends->maxTextureUnitSlots);
-                return;
-            }
+void oglsImplRenderCmdDispatch(LvnWindow* window, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    glDispatchCompute(groupCountX, groupCountY, groupCountZ);
+}
 
-            glBindTextureUnit(descriptorSetPtr->textures[j].binding, descriptorSetPtr->textures[j].id);
-            texCount++;
-        }
+void oglsImplRenderCmdMemoryBarrier(LvnWindow* window, LvnMemoryBarrierFlagBits barriers)
+{
+    GLbitfield barrierBits = ogls::getMemoryBarrierEnum(barriers);
+    if (barrierBits != 0)
+        glMemoryBarrier(barrierBits);
+}
 
-        // bindless textures
-        for (const OglBindlessTextureBinding& bindlessTextureBinding : descriptorSetPtr->bindlessTextures)
-        {
-            for (const uint64_t& handle : bindlessTextureBinding.textureHandles)
-            {
-                glMakeTextureHandleResidentARB(handle);
-            }
+void oglsImplRenderCmdBeginTimestamp(LvnWindow* window, const char* name)
+{
+    ogls::writeTimestamp(window, ogls::beginTimestampScope(window, name));
+}
 
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindlessTextureBinding.binding, bindlessTextureBinding.ssbo);
-        }
-    }
+void oglsImplRenderCmdEndTimestamp(LvnWindow* window)
+{
+    ogls::writeTimestamp(window, ogls::endTimestampScope(window));
 }
 
 void oglsImplRenderCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
 {
     OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(frameBuffer->frameBufferData);
 
-    glViewport(frameBufferData->x, frameBufferData->y, frameBufferData->width, frameBufferData->height);
+    ogls::setCapability(GL_SCISSOR_TEST, &s_OglBackends->stateCache.scissorTest, false);
+    s_OglBackends->passFrameBuffer = frameBuffer;
+
+    glViewport(frameBufferData->x, frameBufferData->y, frameBuffer->renderWidth, frameBuffer->renderHeight);
     glBindFramebuffer(GL_FRAMEBUFFER, frameBufferData->id);
 }
 
@@ -1541,27 +2927,104 @@ void oglsImplRenderCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuf
 {
     OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(frameBuffer->frameBufferData);
 
+    // the resolve blit is clipped by the scissor test
+    ogls::setCapability(GL_SCISSOR_TEST, &s_OglBackends->stateCache.scissorTest, false);
+    s_OglBackends->passFrameBuffer = nullptr;
+
     if (frameBufferData->multisampling)
     {
         glBindFramebuffer(GL_READ_FRAMEBUFFER, frameBufferData->id);
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, frameBufferData->msaaId);
-        glBlitFramebuffer(0, 0, frameBufferData->width, frameBufferData->height, 0, 0, frameBufferData->width, frameBufferData->height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBlitFramebuffer(0, 0, frameBuffer->renderWidth, frameBuffer->renderHeight, 0, 0, frameBuffer->renderWidth, frameBuffer->renderHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
     }
     
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void oglsImplRenderCmdReadbackFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData)
+{
+    ogls::readbackFrameBuffer(frameBuffer, attachmentIndex, func, userData);
+}
+
 void oglsImplBufferUpdateData(LvnBuffer* buffer, void* vertices, uint64_t size, uint64_t offset)
 {
     if (buffer->usage & Lvn_BufferUsage_Static)
     {
-        LVN_CORE_ERROR("[opengl] cannot change data of buffer that has static buffer usage set Lvn_BufferUsage_Static, buffer: (%p)", buffer);
+        // usually called every frame, the error is limited so it does not flood the log
+        LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_ERROR, "[opengl] cannot change data of buffer that has static buffer usage set Lvn_BufferUsage_Static, buffer: (%p)", buffer);
+        return;
+    }
+
+    if (buffer->bufferMap)
+    {
+        memcpy(static_cast<uint8_t*>(buffer->bufferMap) + ogls::getBufferRegionOffset(buffer) + offset, vertices, size);
         return;
     }
 
     glNamedBufferSubData(buffer->id, offset, size, vertices);
 }
 
+void* oglsImplBufferGetMappedData(LvnBuffer* buffer)
+{
+    if (buffer->usage != Lvn_BufferUsage_DynamicRing || !buffer->bufferMap)
+        return nullptr;
+
+    return static_cast<uint8_t*>(buffer->bufferMap) + ogls::getBufferRegionOffset(buffer);
+}
+
+void* oglsImplBufferMap(LvnBuffer* buffer)
+{
+    if (buffer->bufferMap)
+        return static_cast<uint8_t*>(buffer->bufferMap) + ogls::getBufferRegionOffset(buffer);
+
+    // buffers without a persistent map are mapped whole and keep their contents, only the dirty range is flushed on unmap
+    void* data = glMapNamedBufferRange(buffer->id, 0, buffer->size, GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+    if (!data)
+        LVN_CORE_ERROR("[opengl] failed to map buffer, id: %u, size: %llu", buffer->id, buffer->size);
+
+    return data;
+}
+
+void oglsImplBufferFlushRange(LvnBuffer* buffer, uint64_t offset, uint64_t size)
+{
+    // persistent maps are coherent so writes are already visible
+    if (buffer->bufferMap)
+        return;
+
+    glFlushMappedNamedBufferRange(buffer->id, offset, size);
+}
+
+void oglsImplBufferUnmap(LvnBuffer* buffer)
+{
+    if (buffer->bufferMap)
+        return;
+
+    glUnmapNamedBuffer(buffer->id);
+}
+
+LvnResult oglsImplTextureUpdateData(LvnTexture* texture, const void* pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    GLenum format = GL_RGBA;
+    switch (texture->channels)
+    {
+        case 1: { format = GL_RED; break; }
+        case 2: { format = GL_RG; break; }
+        case 3: { format = GL_RGB; break; }
+        case 4: { format = GL_RGBA; break; }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTextureSubImage2D(texture->id, 0, x, y, width, height, format, GL_UNSIGNED_BYTE, pixels);
+
+    if (ogls::checkErrorCode() == Lvn_Result_Failure)
+    {
+        LVN_CORE_ERROR("[opengl] last error check occurance when updating texture, id: %u, region: (x:%u,y:%u,w:%u,h:%u)", texture->id, x, y, width, height);
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
 void oglsImplBufferResize(LvnBuffer* buffer, uint64_t size)
 {
     if (!(buffer->usage & Lvn_BufferUsage_Resize))
@@ -1581,21 +3044,12 @@ void oglsImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescrip
     OglDescriptorSet* descriptorSetPtr = static_cast<OglDescriptorSet*>(descriptorSet->singleSet);
 
     // clean up bindless texture on previous updates
-    for (const OglBindlessTextureBinding& bindlessTexBinding : descriptorSetPtr->bindlessTextures)
-    {
-        for (const uint64_t& handle : bindlessTexBinding.textureHandles)
-        {
-            glMakeTextureHandleNonResidentARB(handle);
-        }
-
-        glDeleteBuffers(1, &bindlessTexBinding.ssbo);
-    }
-    descriptorSetPtr->bindlessTextures.clear();
+    ogls::releaseBindlessTextures(descriptorSetPtr);
 
     for (uint32_t i = 0; i < count; i++)
     {
         // uniform buffer
-        if (pUpdateInfo[i].descriptorType == Lvn_DescriptorType_UniformBuffer || pUpdateInfo[i].descriptorType == Lvn_DescriptorType_StorageBuffer)
+        if (pUpdateInfo[i].descriptorType == Lvn_DescriptorType_UniformBuffer || pUpdateInfo[i].descriptorType == Lvn_DescriptorType_UniformBufferDynamic || pUpdateInfo[i].descriptorType == Lvn_DescriptorType_StorageBuffer)
         {
             for (uint32_t j = 0; j < descriptorSetPtr->uniformBuffers.size(); j++)
             {
@@ -1604,6 +3058,7 @@ void oglsImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescrip
                     descriptorSetPtr->uniformBuffers[j].id = pUpdateInfo[i].bufferInfo->buffer->id;
                     descriptorSetPtr->uniformBuffers[j].range = pUpdateInfo[i].bufferInfo->range;
                     descriptorSetPtr->uniformBuffers[j].offset = pUpdateInfo[i].bufferInfo->offset;
+                    descriptorSetPtr->uniformBuffers[j].regionSize = pUpdateInfo[i].bufferInfo->buffer->regionSize;
                     break;
                 }
             }
@@ -1617,8 +3072,11 @@ void oglsImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescrip
             {
                 if (descriptorSetPtr->textures[j].binding == pUpdateInfo[i].binding)
                 {
-                    descriptorSetPtr->textures[j].id = pUpdateInfo[i].pTextureInfos[0]->id;
-                    texCount++;
+                    // array elements are stored in consecutive entries after the first
+                    uint32_t count = lvn::min(lvn::max(pUpdateInfo[i].descriptorCount, 1u), (uint32_t)(descriptorSetPtr->textures.size() - j));
+                    for (uint32_t k = 0; k < count; k++)
+                        descriptorSetPtr->textures[j + k].id = pUpdateInfo[i].pTextureInfos[k]->id;
+                    texCount += count;
                     break;
                 }
             }
@@ -1627,6 +3085,12 @@ void oglsImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescrip
         // bindless textures; note they are created/added during descriptor update
         else if (pUpdateInfo[i].descriptorType == Lvn_DescriptorType_ImageSamplerBindless)
         {
+            if (!oglBackends->bindlessTextureSupported)
+            {
+                LVN_CORE_ERROR("[opengl] bindless texture descriptor at binding (%u) cannot be updated, ARB_bindless_texture is not supported by the device", pUpdateInfo[i].binding);
+                return;
+            }
+
             OglBindlessTextureBinding bindlessTexture{};
             for (uint32_t j = 0; j < pUpdateInfo[i].descriptorCount; j++)
             {
@@ -1641,8 +3105,9 @@ void oglsImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescrip
                 bindlessTexture.textureHandles.push_back(handle);
             }
 
+            // the handles do not change until the next update, the storage is immutable
             glCreateBuffers(1, &bindlessTexture.ssbo);
-            glNamedBufferData(bindlessTexture.ssbo, bindlessTexture.textureHandles.size() * sizeof(uint64_t), bindlessTexture.textureHandles.data(), GL_DYNAMIC_DRAW);
+            glNamedBufferStorage(bindlessTexture.ssbo, bindlessTexture.textureHandles.size() * sizeof(uint64_t), bindlessTexture.textureHandles.data(), 0);
             bindlessTexture.binding = pUpdateInfo[i].binding;
             descriptorSetPtr->bindlessTextures.push_back(bindlessTexture);
         }
@@ -1654,6 +3119,13 @@ void oglsImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescrip
     }
 }
 
+void oglsImplUpdateDescriptorSetsData(const LvnDescriptorSetUpdate* pUpdates, uint32_t count)
+{
+    // opengl descriptor sets are host side binding lists, there is nothing to batch
+    for (uint32_t i = 0; i < count; i++)
+        oglsImplUpdateDescriptorSetData(pUpdates[i].descriptorSet, pUpdates[i].pUpdateInfos, pUpdates[i].updateInfoCount);
+}
+
 LvnTexture* oglsImplFrameBufferGetImage(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex)
 {
     OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(frameBuffer->frameBufferData);
@@ -1698,10 +3170,47 @@ void oglsImplFrameBufferResize(LvnFrameBuffer* frameBuffer, uint32_t width, uint
 
 void oglsImplFrameBufferSetClearColor(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, float r, float g, float b, float a)
 {
+    ogls::setCapability(GL_SCISSOR_TEST, &s_OglBackends->stateCache.scissorTest, false);
     glClearColor(r, g, b, a);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+LvnResult oglsImplFrameBufferReadPixels(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, void* data, uint64_t size)
+{
+    OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(frameBuffer->frameBufferData);
+
+    if (attachmentIndex >= frameBufferData->colorAttachmentTextures.size())
+    {
+        LVN_CORE_ERROR("[opengl] cannot read pixels of framebuffer (%p), attachment index (%u) is not a color attachment", frameBuffer, attachmentIndex);
+        return Lvn_Result_Failure;
+    }
+
+    GLenum format, type;
+    uint32_t pixelSize = ogls::getReadPixelsFormat(frameBufferData->colorAttachmentSpecifications[attachmentIndex].format, &format, &type);
+    uint64_t requiredSize = static_cast<uint64_t>(frameBufferData->width) * frameBufferData->height * pixelSize;
+
+    if (size < requiredSize)
+    {
+        LVN_CORE_ERROR("[opengl] cannot read pixels of framebuffer (%p), data size (%zu) is smaller than the attachment size (%zu)", frameBuffer, size, requiredSize);
+        return Lvn_Result_Failure;
+    }
+
+    // rows of rgb attachments are not padded to 4 bytes
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, frameBufferData->colorAttachmentTextures[attachmentIndex].id);
+    glGetTexImage(GL_TEXTURE_2D, 0, format, type, data);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    return ogls::checkErrorCode();
+}
+
+LvnResult oglsImplWindowReadPixels(LvnWindow* window, void*, uint64_t)
+{
+    LVN_CORE_ERROR("[opengl] cannot read pixels of window (%p), headless windows are only supported with vulkan, render to a framebuffer and use lvn::frameBufferReadPixels instead", window);
+    return Lvn_Result_Failure;
+}
+
 LvnDepthImageFormat oglsImplFindSupportedDepthImageFormat(LvnDepthImageFormat* pDepthImageFormats, uint32_t count)
 {
     return pDepthImageFormats[0];
@@ -1715,6 +3224,18 @@ void setOglWindowContextValues()
         glEnable(GL_FRAMEBUFFER_SRGB);
 }
 
+void destroyOglWindowTimestampQueries(LvnWindow* window)
+{
+    for (uint32_t i = 0; i < window->timestampFrames.size(); i++)
+    {
+        LvnVector<uint32_t>& queries = window->timestampFrames[i].queries;
+        if (!queries.empty())
+            glDeleteQueries(queries.size(), queries.data());
+    }
+
+    window->timestampFrames.clear_free();
+}
+
 void* getMainOglWindowContext()
 {
     OglBackends* oglBackends = s_OglBackends;
@@ -1731,7 +3252,7 @@ void oglsImplRecordCmdDraw(LvnWindow* window, uint32_t vertexCount)
     cmd.window = window;
     cmd.vertexCount = vertexCount;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdDrawIndexed(LvnWindow* window, uint32_t indexCount)
@@ -1742,7 +3263,7 @@ void oglsImplRecordCmdDrawIndexed(LvnWindow* window, uint32_t indexCount)
     cmd.window = window;
     cmd.indexCount = indexCount;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance)
@@ -1755,7 +3276,7 @@ void oglsImplRecordCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uin
     cmd.instanceCount = instanceCount;
     cmd.firstInstance = firstInstance;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance)
@@ -1768,7 +3289,51 @@ void oglsImplRecordCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCoun
     cmd.instanceCount = instanceCount;
     cmd.firstInstance = firstInstance;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdDrawIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    LvnCmdDrawIndirect cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdDrawIndirect;
+    cmd.header.size = sizeof(LvnCmdDrawIndirect);
+    cmd.window = window;
+    cmd.buffer = buffer;
+    cmd.offset = offset;
+    cmd.drawCount = drawCount;
+    cmd.stride = stride;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdDrawIndexedIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    LvnCmdDrawIndirect cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdDrawIndexedIndirect;
+    cmd.header.size = sizeof(LvnCmdDrawIndirect);
+    cmd.window = window;
+    cmd.buffer = buffer;
+    cmd.offset = offset;
+    cmd.drawCount = drawCount;
+    cmd.stride = stride;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdDrawIndexedIndirectCount(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, LvnBuffer* countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    LvnCmdDrawIndirect cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdDrawIndexedIndirectCount;
+    cmd.header.size = sizeof(LvnCmdDrawIndirect);
+    cmd.window = window;
+    cmd.buffer = buffer;
+    cmd.offset = offset;
+    cmd.countBuffer = countBuffer;
+    cmd.countBufferOffset = countBufferOffset;
+    cmd.drawCount = maxDrawCount;
+    cmd.stride = stride;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdSetStencilReference(uint32_t reference)
@@ -1786,6 +3351,78 @@ void oglsImplRecordCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask)
 
 }
 
+void oglsImplRecordCmdSetCullMode(LvnWindow* window, LvnCullFaceMode cullMode)
+{
+    LvnCmdSetCullMode cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdSetCullMode;
+    cmd.header.size = sizeof(LvnCmdSetCullMode);
+    cmd.window = window;
+    cmd.cullMode = cullMode;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdSetFrontFace(LvnWindow* window, LvnCullFrontFace frontFace)
+{
+    LvnCmdSetFrontFace cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdSetFrontFace;
+    cmd.header.size = sizeof(LvnCmdSetFrontFace);
+    cmd.window = window;
+    cmd.frontFace = frontFace;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdSetPrimitiveTopology(LvnWindow* window, LvnTopologyType topology)
+{
+    LvnCmdSetPrimitiveTopology cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdSetPrimitiveTopology;
+    cmd.header.size = sizeof(LvnCmdSetPrimitiveTopology);
+    cmd.window = window;
+    cmd.topology = topology;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdSetDepthTest(LvnWindow* window, bool enableDepth, bool depthWrite, LvnCompareOperation depthOpCompare)
+{
+    LvnCmdSetDepthTest cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdSetDepthTest;
+    cmd.header.size = sizeof(LvnCmdSetDepthTest);
+    cmd.window = window;
+    cmd.enableDepth = enableDepth;
+    cmd.depthWrite = depthWrite;
+    cmd.depthOpCompare = depthOpCompare;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdSetBlendEnable(LvnWindow* window, uint32_t attachment, bool enable)
+{
+    LvnCmdSetBlendEnable cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdSetBlendEnable;
+    cmd.header.size = sizeof(LvnCmdSetBlendEnable);
+    cmd.window = window;
+    cmd.attachment = attachment;
+    cmd.enable = enable;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdSetScissor(LvnWindow* window, int32_t x, int32_t y, uint32_t width, uint32_t height)
+{
+    LvnCmdSetScissor cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdSetScissor;
+    cmd.header.size = sizeof(LvnCmdSetScissor);
+    cmd.window = window;
+    cmd.x = x;
+    cmd.y = y;
+    cmd.width = width;
+    cmd.height = height;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
 void oglsImplRecordCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a)
 {
     LvnCmdBeginRenderPass cmd{};
@@ -1797,7 +3434,7 @@ void oglsImplRecordCmdBeginRenderPass(LvnWindow* window, float r, float g, float
     cmd.b = b;
     cmd.a = a;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdEndRenderPass(LvnWindow* window)
@@ -1807,7 +3444,7 @@ void oglsImplRecordCmdEndRenderPass(LvnWindow* window)
     cmd.header.size = sizeof(LvnCmdEndRenderPass);
     cmd.window = window;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline)
@@ -1818,7 +3455,7 @@ void oglsImplRecordCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline)
     cmd.window = window;
     cmd.pipeline = pipeline;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets)
@@ -1832,7 +3469,7 @@ void oglsImplRecordCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding,
     cmd.pBuffers = pBuffers;
     cmd.pOffsets = pOffsets;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset)
@@ -1844,21 +3481,88 @@ void oglsImplRecordCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint
     cmd.buffer = buffer;
     cmd.offset = offset;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
-void oglsImplRecordCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets)
+void oglsImplRecordCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets)
 {
     LvnCmdBindDescriptorSets cmd{};
     cmd.header.callFunc = lvn::oglsImplDrawBuffCmdBindDescriptorSets;
-    cmd.header.size = sizeof(LvnCmdBindDescriptorSets);
+    cmd.header.size = ogls::getCmdPayloadSize(sizeof(LvnCmdBindDescriptorSets), dynamicOffsetCount * sizeof(uint32_t));
     cmd.window = window;
     cmd.pipeline = pipeline;
     cmd.firstSetIndex = firstSetIndex;
     cmd.descriptorSetCount = descriptorSetCount;
     cmd.pDescriptorSets = pDescriptorSets;
+    cmd.dynamicOffsetCount = dynamicOffsetCount;
+
+    // dynamic offsets are stored inline after the command, padded so the next command stays aligned
+    uint8_t* cmdData = ogls::allocateCmd(window, cmd.header.size);
+    memcpy(cmdData, &cmd, sizeof(LvnCmdBindDescriptorSets));
+    if (dynamicOffsetCount > 0)
+        memcpy(cmdData + sizeof(LvnCmdBindDescriptorSets), pDynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+}
+
+void oglsImplRecordCmdPushConstants(LvnWindow* window, LvnPipeline* pipeline, LvnShaderStage shaderStage, uint32_t offset, uint32_t size, const void* data)
+{
+    LvnCmdPushConstants cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdPushConstants;
+    cmd.header.size = ogls::getCmdPayloadSize(sizeof(LvnCmdPushConstants), size);
+    cmd.window = window;
+    cmd.pipeline = pipeline;
+    cmd.shaderStage = shaderStage;
+    cmd.offset = offset;
+    cmd.size = size;
+
+    uint8_t* cmdData = ogls::allocateCmd(window, cmd.header.size);
+    memcpy(cmdData, &cmd, sizeof(LvnCmdPushConstants));
+    memcpy(cmdData + sizeof(LvnCmdPushConstants), data, size);
+}
+
+void oglsImplRecordCmdDispatch(LvnWindow* window, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    LvnCmdDispatch cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdDispatch;
+    cmd.header.size = sizeof(LvnCmdDispatch);
+    cmd.window = window;
+    cmd.groupCountX = groupCountX;
+    cmd.groupCountY = groupCountY;
+    cmd.groupCountZ = groupCountZ;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdMemoryBarrier(LvnWindow* window, LvnMemoryBarrierFlagBits barriers)
+{
+    LvnCmdMemoryBarrier cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdMemoryBarrier;
+    cmd.header.size = sizeof(LvnCmdMemoryBarrier);
+    cmd.window = window;
+    cmd.barriers = barriers;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdBeginTimestamp(LvnWindow* window, const char* name)
+{
+    LvnCmdWriteTimestamp cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdWriteTimestamp;
+    cmd.header.size = sizeof(LvnCmdWriteTimestamp);
+    cmd.window = window;
+    cmd.query = ogls::beginTimestampScope(window, name);
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdEndTimestamp(LvnWindow* window)
+{
+    LvnCmdWriteTimestamp cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdWriteTimestamp;
+    cmd.header.size = sizeof(LvnCmdWriteTimestamp);
+    cmd.window = window;
+    cmd.query = ogls::endTimestampScope(window);
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
@@ -1869,7 +3573,7 @@ void oglsImplRecordCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameB
     cmd.window = window;
     cmd.frameBuffer = frameBuffer;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 void oglsImplRecordCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
@@ -1880,7 +3584,21 @@ void oglsImplRecordCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuf
     cmd.window = window;
     cmd.frameBuffer = frameBuffer;
 
-    window->cmdBuffer.insert(window->cmdBuffer.end(), reinterpret_cast<uint8_t*>(&cmd), reinterpret_cast<uint8_t*>(&cmd) + cmd.header.size);
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
+}
+
+void oglsImplRecordCmdReadbackFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData)
+{
+    LvnCmdReadbackFrameBuffer cmd{};
+    cmd.header.callFunc = lvn::oglsImplDrawBuffCmdReadbackFrameBuffer;
+    cmd.header.size = sizeof(LvnCmdReadbackFrameBuffer);
+    cmd.window = window;
+    cmd.frameBuffer = frameBuffer;
+    cmd.attachmentIndex = attachmentIndex;
+    cmd.func = func;
+    cmd.userData = userData;
+
+    memcpy(ogls::allocateCmd(window, cmd.header.size), &cmd, cmd.header.size);
 }
 
 
@@ -1908,6 +3626,24 @@ void oglsImplDrawBuffCmdDrawIndexedInstanced(void* data)
     glDrawElementsInstancedBaseInstance(cmd->window->topologyTypeEnum, cmd->indexCount, GL_UNSIGNED_INT, (void*)(uintptr_t)cmd->window->indexOffset, cmd->instanceCount, cmd->firstInstance);
 }
 
+void oglsImplDrawBuffCmdDrawIndirect(void* data)
+{
+    LvnCmdDrawIndirect* cmd = static_cast<LvnCmdDrawIndirect*>(data);
+    oglsImplRenderCmdDrawIndirect(cmd->window, cmd->buffer, cmd->offset, cmd->drawCount, cmd->stride);
+}
+
+void oglsImplDrawBuffCmdDrawIndexedIndirect(void* data)
+{
+    LvnCmdDrawIndirect* cmd = static_cast<LvnCmdDrawIndirect*>(data);
+    oglsImplRenderCmdDrawIndexedIndirect(cmd->window, cmd->buffer, cmd->offset, cmd->drawCount, cmd->stride);
+}
+
+void oglsImplDrawBuffCmdDrawIndexedIndirectCount(void* data)
+{
+    LvnCmdDrawIndirect* cmd = static_cast<LvnCmdDrawIndirect*>(data);
+    oglsImplRenderCmdDrawIndexedIndirectCount(cmd->window, cmd->buffer, cmd->offset, cmd->countBuffer, cmd->countBufferOffset, cmd->drawCount, cmd->stride);
+}
+
 void oglsImplDrawBuffCmdSetStencilReference(void* data)
 {
     LvnCmdSetStencilReference* cmd = static_cast<LvnCmdSetStencilReference*>(data);
@@ -1918,18 +3654,46 @@ void oglsImplDrawBuffCmdSetStencilMask(void* data)
     LvnCmdSetStencilMask* cmd = static_cast<LvnCmdSetStencilMask*>(data);
 }
 
-void oglsImplDrawBuffCmdBeginRenderPass(void* data)
+void oglsImplDrawBuffCmdSetCullMode(void* data)
 {
-    LvnCmdBeginRenderPass* cmd = static_cast<LvnCmdBeginRenderPass*>(data);
+    LvnCmdSetCullMode* cmd = static_cast<LvnCmdSetCullMode*>(data);
+    oglsImplRenderCmdSetCullMode(cmd->window, cmd->cullMode);
+}
 
-    GLFWwindow* glfwWindow = static_cast<GLFWwindow*>(cmd->window->nativeWindow);
+void oglsImplDrawBuffCmdSetFrontFace(void* data)
+{
+    LvnCmdSetFrontFace* cmd = static_cast<LvnCmdSetFrontFace*>(data);
+    oglsImplRenderCmdSetFrontFace(cmd->window, cmd->frontFace);
+}
 
-    int width, height;
-    glfwGetFramebufferSize(glfwWindow, &width, &height);
+void oglsImplDrawBuffCmdSetPrimitiveTopology(void* data)
+{
+    LvnCmdSetPrimitiveTopology* cmd = static_cast<LvnCmdSetPrimitiveTopology*>(data);
+    oglsImplRenderCmdSetPrimitiveTopology(cmd->window, cmd->topology);
+}
 
-    glClearColor(cmd->r, cmd->g, cmd->b, cmd->a);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glViewport(0, 0, width, height);
+void oglsImplDrawBuffCmdSetDepthTest(void* data)
+{
+    LvnCmdSetDepthTest* cmd = static_cast<LvnCmdSetDepthTest*>(data);
+    oglsImplRenderCmdSetDepthTest(cmd->window, cmd->enableDepth, cmd->depthWrite, cmd->depthOpCompare);
+}
+
+void oglsImplDrawBuffCmdSetBlendEnable(void* data)
+{
+    LvnCmdSetBlendEnable* cmd = static_cast<LvnCmdSetBlendEnable*>(data);
+    oglsImplRenderCmdSetBlendEnable(cmd->window, cmd->attachment, cmd->enable);
+}
+
+void oglsImplDrawBuffCmdSetScissor(void* data)
+{
+    LvnCmdSetScissor* cmd = static_cast<LvnCmdSetScissor*>(data);
+    oglsImplRenderCmdSetScissor(cmd->window, cmd->x, cmd->y, cmd->width, cmd->height);
+}
+
+void oglsImplDrawBuffCmdBeginRenderPass(void* data)
+{
+    LvnCmdBeginRenderPass* cmd = static_cast<LvnCmdBeginRenderPass*>(data);
+    oglsImplRenderCmdBeginRenderPass(cmd->window, cmd->r, cmd->g, cmd->b, cmd->a);
 }
 
 void oglsImplDrawBuffCmdEndRenderPass(void* data)
@@ -1940,47 +3704,7 @@ void oglsImplDrawBuffCmdEndRenderPass(void* data)
 void oglsImplDrawBuffCmdBindPipeline(void* data)
 {
     LvnCmdBindPipeline* cmd = static_cast<LvnCmdBindPipeline*>(data);
-
-    OglPipelineEnums* pipelineEnums = static_cast<OglPipelineEnums*>(cmd->pipeline->nativePipeline);
-
-    // depth
-    if (pipelineEnums->enableDepth)
-    {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(pipelineEnums->depthCompareOp);
-    }
-    else
-    {
-        glDisable(GL_DEPTH_TEST);
-    }
-
-    // color blend
-    if (pipelineEnums->enableBlending)
-    {
-        glEnable(GL_BLEND);
-        glBlendFunc(pipelineEnums->srcBlendFactor, pipelineEnums->dstBlendFactor);
-    }
-    else
-    {
-        glDisable(GL_BLEND);
-    }
-
-    if (pipelineEnums->enableCulling)
-    {
-        glEnable(GL_CULL_FACE);
-        glCullFace(pipelineEnums->cullMode);
-        glFrontFace(pipelineEnums->frontFace);
-    }
-    else
-    {
-        glDisable(GL_CULL_FACE);
-    }
-
-    glUseProgram(cmd->pipeline->id);
-
-    cmd->window->topologyTypeEnum = pipelineEnums->topologyType;
-    cmd->window->vao = cmd->pipeline->vaoId;
-    cmd->window->bindingDescriptions = &cmd->pipeline->bindingDescriptions;
+    ogls::bindPipeline(cmd->window, cmd->pipeline);
 }
 
 void oglsImplDrawBuffCmdBindVertexBuffer(void* data)
@@ -1990,7 +3714,7 @@ void oglsImplDrawBuffCmdBindVertexBuffer(void* data)
 
     for (uint32_t i = cmd->firstBinding; i < cmd->bindingCount; i++)
     {
-        glVertexArrayVertexBuffer(cmd->window->vao, i, cmd->pBuffers[i]->id, 0, (*bindingDescriptions)[i]);
+        glVertexArrayVertexBuffer(cmd->window->vao, i, cmd->pBuffers[i]->id, ogls::getBufferRegionOffset(cmd->pBuffers[i]), (*bindingDescriptions)[i]);
     }
 }
 
@@ -1999,80 +3723,58 @@ void oglsImplDrawBuffCmdBindIndexBuffer(void* data)
     LvnCmdBindIndexBuffer* cmd = static_cast<LvnCmdBindIndexBuffer*>(data);
 
     glVertexArrayElementBuffer(cmd->window->vao, cmd->buffer->id);
-    cmd->window->indexOffset = cmd->offset;
+    cmd->window->indexOffset = cmd->offset + ogls::getBufferRegionOffset(cmd->buffer);
 }
 
 void oglsImplDrawBuffCmdBindDescriptorSets(void* data)
 {
     LvnCmdBindDescriptorSets* cmd = static_cast<LvnCmdBindDescriptorSets*>(data);
+    const uint32_t* pDynamicOffsets = reinterpret_cast<const uint32_t*>(cmd + 1);
 
-    OglBackends* oglBackends = s_OglBackends;
-    int texCount = 0;
-
-    for (uint32_t i = 0; i < cmd->descriptorSetCount; i++)
-    {
-        OglDescriptorSet* descriptorSetPtr = static_cast<OglDescriptorSet*>(cmd->pDescriptorSets[i]->singleSet);
+    ogls::bindDescriptorSets(cmd->descriptorSetCount, cmd->pDescriptorSets, cmd->dynamicOffsetCount, pDynamicOffsets);
+}
 
-        // uniform/storage buffers
-        for (uint32_t j = 0; j < descriptorSetPtr->uniformBuffers.size(); j++)
-        {
-            glBindBufferRange(ogls::getUniformBufferTypeEnum(descriptorSetPtr->uniformBuffers[j].type),
-                descriptorSetPtr->uniformBuffers[j].binding,
-                descriptorSetPtr->uniformBuffers[j].id,
-                static_cast<GLintptr>(descriptorSetPtr->uniformBuffers[j].offset),
-                static_cast<GLsizeiptr>(descriptorSetPtr->uniformBuffers[j].range));
-        }
+void oglsImplDrawBuffCmdPushConstants(void* data)
+{
+    LvnCmdPushConstants* cmd = static_cast<LvnCmdPushConstants*>(data);
 
-        // textures
-        for (uint32_t j = 0; j < descriptorSetPtr->textures.size(); j++)
-        {
-            if (texCount >= oglBackends->maxTextureUnitSlots)
-            {
-                LVN_CORE_WARN("maximum texture unit slots exceeded, cannot bind more texture unit slots to one shader pipeline. Max slots: %u", oglBackends->maxTextureUnitSlots);
-                return;
-            }
+    ogls::pushConstants(cmd->pipeline, cmd->offset, cmd->size, cmd + 1);
+}
 
-            glBindTextureUnit(descriptorSetPtr->textures[j].binding, descriptorSetPtr->textures[j].id);
-            texCount++;
-        }
+void oglsImplDrawBuffCmdDispatch(void* data)
+{
+    LvnCmdDispatch* cmd = static_cast<LvnCmdDispatch*>(data);
+    glDispatchCompute(cmd->groupCountX, cmd->groupCountY, cmd->groupCountZ);
+}
 
-        // bindless textures
-        for (const OglBindlessTextureBinding& bindlessTextureBinding : descriptorSetPtr->bindlessTextures)
-        {
-            for (const uint64_t& handle : bindlessTextureBinding.textureHandles)
-            {
-                glMakeTextureHandleResidentARB(handle);
-            }
+void oglsImplDrawBuffCmdMemoryBarrier(void* data)
+{
+    LvnCmdMemoryBarrier* cmd = static_cast<LvnCmdMemoryBarrier*>(data);
+    oglsImplRenderCmdMemoryBarrier(cmd->window, cmd->barriers);
+}
 
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindlessTextureBinding.binding, bindlessTextureBinding.ssbo);
-        }
-    }
+void oglsImplDrawBuffCmdWriteTimestamp(void* data)
+{
+    LvnCmdWriteTimestamp* cmd = static_cast<LvnCmdWriteTimestamp*>(data);
+    ogls::writeTimestamp(cmd->window, cmd->query);
 }
 
 void oglsImplDrawBuffCmdBeginFrameBuffer(void* data)
 {
     LvnCmdBeginFrameBuffer* cmd = static_cast<LvnCmdBeginFrameBuffer*>(data);
-
-    OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(cmd->frameBuffer->frameBufferData);
-
-    glViewport(frameBufferData->x, frameBufferData->y, frameBufferData->width, frameBufferData->height);
-    glBindFramebuffer(GL_FRAMEBUFFER, frameBufferData->id);
+    oglsImplRenderCmdBeginFrameBuffer(cmd->window, cmd->frameBuffer);
 }
 
 void oglsImplDrawBuffCmdEndFrameBuffer(void* data)
 {
     LvnCmdEndFrameBuffer* cmd = static_cast<LvnCmdEndFrameBuffer*>(data);
+    oglsImplRenderCmdEndFrameBuffer(cmd->window, cmd->frameBuffer);
+}
 
-    OglFramebufferData* frameBufferData = static_cast<OglFramebufferData*>(cmd->frameBuffer->frameBufferData);
-
-    if (frameBufferData->multisampling)
-    {
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, frameBufferData->id);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, frameBufferData->msaaId);
-        glBlitFramebuffer(0, 0, frameBufferData->width, frameBufferData->height, 0, 0, frameBufferData->width, frameBufferData->height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-    }
-
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+void oglsImplDrawBuffCmdReadbackFrameBuffer(void* data)
+{
+    LvnCmdReadbackFrameBuffer* cmd = static_cast<LvnCmdReadbackFrameBuffer*>(data);
+    ogls::readbackFrameBuffer(cmd->frameBuffer, cmd->attachmentIndex, cmd->func, cmd->userData);
 }
 
 
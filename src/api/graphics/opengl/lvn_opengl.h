@@ -10,20 +10,23 @@ namespace lvn
     void oglsImplGetPhysicalDevices(LvnPhysicalDevice** pPhysicalDevices, uint32_t* physicalDeviceCount);
     LvnResult oglsImplCheckPhysicalDeviceSupport(LvnPhysicalDevice* physicalDevice);
     LvnResult oglsImplSetPhysicalDevice(LvnPhysicalDevice* physicalDevice);
+    void oglsImplGetMemoryStats(LvnGraphicsMemoryStats* stats);
 
     LvnResult oglsImplCreateShaderFromSrc(LvnShader* shader, const LvnShaderCreateInfo* createInfo);
     LvnResult oglsImplCreateShaderFromFileSrc(LvnShader* shader, const LvnShaderCreateInfo* createInfo);
     LvnResult oglsImplCreateShaderFromFileBin(LvnShader* shader, const LvnShaderCreateInfo* createInfo);
     LvnResult oglsImplCreateDescriptorLayout(LvnDescriptorLayout* descriptorLayout, const LvnDescriptorLayoutCreateInfo* createInfo);
     LvnResult oglsImplAllocateDescriptorSet(LvnDescriptorSet* descriptorSet, LvnDescriptorLayout* descriptorLayout);
+    LvnResult oglsImplAllocateTransientDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout);
     LvnResult oglsImplCreatePipeline(LvnPipeline* pipeline, const LvnPipelineCreateInfo* createInfo);
+    LvnResult oglsImplCreateComputePipeline(LvnPipeline* pipeline, const LvnComputePipelineCreateInfo* createInfo);
     LvnResult oglsImplCreateFrameBuffer(LvnFrameBuffer* frameBuffer, const LvnFrameBufferCreateInfo* createInfo);
     LvnResult oglsImplCreateBuffer(LvnBuffer* buffer, const LvnBufferCreateInfo* createInfo);
     LvnResult oglsImplCreateSampler(LvnSampler* sampler, const LvnSamplerCreateInfo* createInfo);
     LvnResult oglsImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo* createInfo);
     LvnResult oglsImplCreateTextureSampler(LvnTexture* texture, const LvnTextureSamplerCreateInfo* createInfo);
     LvnResult oglsImplCreateCubemap(LvnCubemap* cubemap, const LvnCubemapCreateInfo* createInfo);
-    LvnResult oglsImplCreateCubemapHdr(LvnCubemap* cubemap, const LvnCubemapHdrCreateInfo* createInfo);
+    LvnResult oglsImplCreateEnvironmentMap(LvnEnvironmentMap* environmentMap, const LvnEnvironmentMapBakeInfo* bakeInfo);
 
     void oglsImplDestroyShader(LvnShader* shader);
     void oglsImplDestroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout);
@@ -33,36 +36,65 @@ namespace lvn
     void oglsImplDestroySampler(LvnSampler* sampler);
     void oglsImplDestroyTexture(LvnTexture* texture);
     void oglsImplDestroyCubemap(LvnCubemap* cubemap);
+    void oglsImplDestroyEnvironmentMap(LvnEnvironmentMap* environmentMap);
 
     void oglsImplRenderBeginNextFrame(LvnWindow* window);
     void oglsImplRenderDrawSubmit(LvnWindow* window);
+    void oglsImplRenderBeginSubmitBatch();
+    void oglsImplRenderEndSubmitBatch();
     void oglsImplRenderBeginCommandRecording(LvnWindow* window);
     void oglsImplRenderEndCommandRecording(LvnWindow* window);
+    LvnResult oglsImplRenderBeginSecondaryCommandRecording(LvnWindow* window, LvnFrameBuffer* frameBuffer);
+    void oglsImplRenderEndSecondaryCommandRecording(LvnWindow* window);
     void oglsImplRenderCmdDraw(LvnWindow* window, uint32_t vertexCount);
     void oglsImplRenderCmdDrawIndexed(LvnWindow* window, uint32_t indexCount);
     void oglsImplRenderCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance);
     void oglsImplRenderCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance);
+    void oglsImplRenderCmdDrawIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void oglsImplRenderCmdDrawIndexedIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void oglsImplRenderCmdDrawIndexedIndirectCount(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, LvnBuffer* countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride);
     void oglsImplRenderCmdSetStencilReference(uint32_t reference);
     void oglsImplRenderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask);
+    void oglsImplRenderCmdSetCullMode(LvnWindow* window, LvnCullFaceMode cullMode);
+    void oglsImplRenderCmdSetFrontFace(LvnWindow* window, LvnCullFrontFace frontFace);
+    void oglsImplRenderCmdSetPrimitiveTopology(LvnWindow* window, LvnTopologyType topology);
+    void oglsImplRenderCmdSetDepthTest(LvnWindow* window, bool enableDepth, bool depthWrite, LvnCompareOperation depthOpCompare);
+    void oglsImplRenderCmdSetBlendEnable(LvnWindow* window, uint32_t attachment, bool enable);
+    void oglsImplRenderCmdSetScissor(LvnWindow* window, int32_t x, int32_t y, uint32_t width, uint32_t height);
     void oglsImplRenderCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a);
     void oglsImplRenderCmdEndRenderPass(LvnWindow* window);
     void oglsImplRenderCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline);
     void oglsImplRenderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets);
     void oglsImplRenderCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset);
-    void oglsImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets);
+    void oglsImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets);
+    void oglsImplRenderCmdPushConstants(LvnWindow* window, LvnPipeline* pipeline, LvnShaderStage shaderStage, uint32_t offset, uint32_t size, const void* data);
+    void oglsImplRenderCmdDispatch(LvnWindow* window, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+    void oglsImplRenderCmdMemoryBarrier(LvnWindow* window, LvnMemoryBarrierFlagBits barriers);
+    void oglsImplRenderCmdBeginTimestamp(LvnWindow* window, const char* name);
+    void oglsImplRenderCmdEndTimestamp(LvnWindow* window);
     void oglsImplRenderCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer);
     void oglsImplRenderCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer);
+    void oglsImplRenderCmdReadbackFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData);
 
     void oglsImplBufferUpdateData(LvnBuffer* buffer, void* vertices, uint64_t size, uint64_t offset);
+    void* oglsImplBufferGetMappedData(LvnBuffer* buffer);
+    void* oglsImplBufferMap(LvnBuffer* buffer);
+    void oglsImplBufferFlushRange(LvnBuffer* buffer, uint64_t offset, uint64_t size);
+    void oglsImplBufferUnmap(LvnBuffer* buffer);
+    LvnResult oglsImplTextureUpdateData(LvnTexture* texture, const void* pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     void oglsImplBufferResize(LvnBuffer* buffer, uint64_t size);
     void oglsImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count);
+    void oglsImplUpdateDescriptorSetsData(const LvnDescriptorSetUpdate* pUpdates, uint32_t count);
     LvnTexture* oglsImplFrameBufferGetImage(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex);
     LvnRenderPass* oglsImplFrameBufferGetRenderPass(LvnFrameBuffer* frameBuffer);
     void oglsImplFrameBufferResize(LvnFrameBuffer* frameBuffer, uint32_t width, uint32_t height);
     void oglsImplFrameBufferSetClearColor(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, float r, float g, float b, float a);
+    LvnResult oglsImplFrameBufferReadPixels(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, void* data, uint64_t size);
+    LvnResult oglsImplWindowReadPixels(LvnWindow* window, void* data, uint64_t size);
 
     LvnDepthImageFormat oglsImplFindSupportedDepthImageFormat(LvnDepthImageFormat* pDepthImageFormats, uint32_t count);
     void setOglWindowContextValues();
+    void destroyOglWindowTimestampQueries(LvnWindow* window);
     void* getMainOglWindowContext();
 }
 
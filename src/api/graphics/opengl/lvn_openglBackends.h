@@ -6,6 +6,8 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <thread>
+
 struct OglDescriptorBinding
 {
     LvnDescriptorType type;
@@ -14,6 +16,7 @@ struct OglDescriptorBinding
     uint32_t id;
     uint64_t range;
     uint64_t offset;
+    uint64_t regionSize; // region size of ring buffers, the region of the current frame is bound
 };
 
 struct OglBindlessTextureBinding
@@ -21,6 +24,7 @@ struct OglBindlessTextureBinding
     uint32_t ssbo;
     uint32_t binding;
     LvnVector<uint64_t> textureHandles;
+    LvnVector<GLFWwindow*> residentContexts; // residency is per context, handles are made resident once in each context that binds them
 };
 
 struct OglDescriptorSet
@@ -30,6 +34,13 @@ struct OglDescriptorSet
     LvnVector<OglBindlessTextureBinding> bindlessTextures;
 };
 
+struct OglDescriptorAllocator
+{
+    uint64_t transientFrame; // frame the transient sets were handed out in, they are reused from the next frame on
+    uint32_t transientCount;
+    LvnVector<LvnDescriptorSet*> transientSets;
+};
+
 struct OglPipelineEnums
 {
     uint32_t depthCompareOp;
@@ -38,6 +49,8 @@ struct OglPipelineEnums
     uint32_t dstBlendFactor;
     uint32_t cullMode;
     uint32_t frontFace;
+    uint32_t pushConstantBuffer;
+    uint32_t pushConstantSize;
     bool enableDepth;
     bool enableBlending;
     bool enableCulling;
@@ -66,6 +79,44 @@ struct OglSampler
     LvnTextureMode wrapS, wrapT, wrapR;
 };
 
+struct OglBufferRangeBinding
+{
+    uint32_t id;
+    uint64_t offset;
+    uint64_t size; // zero when the whole buffer is bound
+};
+
+// shadow of the gl state set by pipeline and descriptor binds, values set to UINT32_MAX or missing bindings are unknown
+struct OglStateCache
+{
+    uint32_t program;
+    uint32_t vao;
+    uint32_t depthTest, depthFunc, depthMask;
+    uint32_t blend, srcBlendFactor, dstBlendFactor;
+    uint32_t cullFace, cullMode, frontFace;
+    uint32_t scissorTest;
+    LvnVector<uint32_t> textureUnits;
+    LvnVector<OglBufferRangeBinding> uniformBuffers;
+    LvnVector<OglBufferRangeBinding> storageBuffers;
+};
+
+// pixel pack buffer a framebuffer attachment is read into, persistently mapped and pooled between readbacks
+struct OglReadbackBuffer
+{
+    uint32_t id;
+    uint64_t size;
+    void* mappedData;
+};
+
+struct OglReadback
+{
+    OglReadbackBuffer buffer;
+    void* fence; // GLsync fenced after the read, the pixels are in the buffer once it signals
+    LvnReadbackFunc func;
+    void* userData;
+    LvnReadbackData data;
+};
+
 struct OglBackends
 {
     GLFWwindow* windowContext;
@@ -77,6 +128,19 @@ struct OglBackends
 
     int maxTextureUnitSlots;
     bool framebufferColorFormatSrgb;
+    bool bindlessTextureSupported; // ARB_bindless_texture, required by Lvn_DescriptorType_ImageSamplerBindless descriptors
+    uint64_t frameIndex; // frames begun, transient descriptor sets are reused once it advances
+    uint32_t bufferRegion; // region of ring buffers written and read by the current frame
+    uint64_t bufferRegionAlignment; // ring buffer regions are aligned for binding as uniform and storage buffers
+    LvnVector<void*> regionFences; // GLsync fence of the last frame that used each ring buffer region
+    OglStateCache stateCache; // reset whenever gl state may have changed outside of the cached binds (eg. another context, object creation or deletion)
+    LvnVector<GLFWwindow*> workerContexts; // free hidden contexts sharing objects with windowContext, lent to threads that create resources without a current context
+    LvnMutex workerContextMutex;
+    LvnVector<OglReadback*> pendingReadbacks; // framebuffer reads the gpu may not have finished, polled every frame
+    LvnVector<OglReadbackBuffer> readbackBuffers; // free readback buffers, returned by the workers once their callback has run
+    LvnMutex readbackMutex;
+    LvnJobCounter readbackJobs; // readback callbacks queued or running on the workers
+    LvnFrameBuffer* passFrameBuffer; // framebuffer between renderCmdBeginFrameBuffer and renderCmdEndFrameBuffer, null for the window
 };
 
 
@@ -86,31 +150,60 @@ namespace lvn
     void oglsImplRecordCmdDrawIndexed(LvnWindow* window, uint32_t indexCount);
     void oglsImplRecordCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance);
     void oglsImplRecordCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance);
+    void oglsImplRecordCmdDrawIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void oglsImplRecordCmdDrawIndexedIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void oglsImplRecordCmdDrawIndexedIndirectCount(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, LvnBuffer* countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride);
     void oglsImplRecordCmdSetStencilReference(uint32_t reference);
     void oglsImplRecordCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask);
+    void oglsImplRecordCmdSetCullMode(LvnWindow* window, LvnCullFaceMode cullMode);
+    void oglsImplRecordCmdSetFrontFace(LvnWindow* window, LvnCullFrontFace frontFace);
+    void oglsImplRecordCmdSetPrimitiveTopology(LvnWindow* window, LvnTopologyType topology);
+    void oglsImplRecordCmdSetDepthTest(LvnWindow* window, bool enableDepth, bool depthWrite, LvnCompareOperation depthOpCompare);
+    void oglsImplRecordCmdSetBlendEnable(LvnWindow* window, uint32_t attachment, bool enable);
+    void oglsImplRecordCmdSetScissor(LvnWindow* window, int32_t x, int32_t y, uint32_t width, uint32_t height);
     void oglsImplRecordCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a);
     void oglsImplRecordCmdEndRenderPass(LvnWindow* window);
     void oglsImplRecordCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline);
     void oglsImplRecordCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets);
     void oglsImplRecordCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset);
-    void oglsImplRecordCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets);
+    void oglsImplRecordCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets);
+    void oglsImplRecordCmdPushConstants(LvnWindow* window, LvnPipeline* pipeline, LvnShaderStage shaderStage, uint32_t offset, uint32_t size, const void* data);
+    void oglsImplRecordCmdDispatch(LvnWindow* window, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+    void oglsImplRecordCmdMemoryBarrier(LvnWindow* window, LvnMemoryBarrierFlagBits barriers);
+    void oglsImplRecordCmdBeginTimestamp(LvnWindow* window, const char* name);
+    void oglsImplRecordCmdEndTimestamp(LvnWindow* window);
     void oglsImplRecordCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer);
     void oglsImplRecordCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer);
+    void oglsImplRecordCmdReadbackFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData);
 
     void oglsImplDrawBuffCmdDraw(void* data);
     void oglsImplDrawBuffCmdDrawIndexed(void* data);
     void oglsImplDrawBuffCmdDrawInstanced(void* data);
     void oglsImplDrawBuffCmdDrawIndexedInstanced(void* data);
+    void oglsImplDrawBuffCmdDrawIndirect(void* data);
+    void oglsImplDrawBuffCmdDrawIndexedIndirect(void* data);
+    void oglsImplDrawBuffCmdDrawIndexedIndirectCount(void* data);
     void oglsImplDrawBuffCmdSetStencilReference(void* data);
     void oglsImplDrawBuffCmdSetStencilMask(void* data);
+    void oglsImplDrawBuffCmdSetCullMode(void* data);
+    void oglsImplDrawBuffCmdSetFrontFace(void* data);
+    void oglsImplDrawBuffCmdSetPrimitiveTopology(void* data);
+    void oglsImplDrawBuffCmdSetDepthTest(void* data);
+    void oglsImplDrawBuffCmdSetBlendEnable(void* data);
+    void oglsImplDrawBuffCmdSetScissor(void* data);
     void oglsImplDrawBuffCmdBeginRenderPass(void* data);
     void oglsImplDrawBuffCmdEndRenderPass(void* data);
     void oglsImplDrawBuffCmdBindPipeline(void* data);
     void oglsImplDrawBuffCmdBindVertexBuffer(void* data);
     void oglsImplDrawBuffCmdBindIndexBuffer(void* data);
     void oglsImplDrawBuffCmdBindDescriptorSets(void* data);
+    void oglsImplDrawBuffCmdPushConstants(void* data);
+    void oglsImplDrawBuffCmdDispatch(void* data);
+    void oglsImplDrawBuffCmdMemoryBarrier(void* data);
+    void oglsImplDrawBuffCmdWriteTimestamp(void* data);
     void oglsImplDrawBuffCmdBeginFrameBuffer(void* data);
     void oglsImplDrawBuffCmdEndFrameBuffer(void* data);
+    void oglsImplDrawBuffCmdReadbackFrameBuffer(void* data);
 }
 
 
@@ -35,8 +35,61 @@ static const char* s_DeviceExtensions[] =
     VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME,
 };
 
+// optional extensions enabled together when supported, used to wait for the previous frame to be presented
+static const char* s_PresentWaitDeviceExtensions[] =
+{
+    VK_KHR_PRESENT_ID_EXTENSION_NAME,
+    VK_KHR_PRESENT_WAIT_EXTENSION_NAME,
+};
+
+// optional extension enabled when supported, offscreen framebuffers begin rendering without render pass and framebuffer objects
+static const char* s_DynamicRenderingDeviceExtensions[] =
+{
+    VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
+};
+
+// optional extensions enabled when supported, pipelines that declare dynamic states set them with render commands instead of baking them
+static const char* s_ExtendedDynamicStateDeviceExtensions[] =
+{
+    VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME,
+};
+
+static const char* s_ExtendedDynamicState3DeviceExtensions[] =
+{
+    VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME,
+};
+
+// optional extension enabled when supported, lets vma read the memory budget of each heap from the driver
+static const char* s_MemoryBudgetDeviceExtensions[] =
+{
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+};
+
 #define ARRAY_LEN(x) (sizeof(x) / sizeof(x[0]))
 
+// upload batches are submitted early once they hold this much staging memory
+#define LVN_VULKAN_UPLOAD_BATCH_MAX_STAGING_SIZE (64ull * 1024 * 1024)
+
+// static and dynamic buffers up to the max size are packed into shared buffer blocks instead of getting their own allocation
+#define LVN_VULKAN_BUFFER_POOL_BLOCK_SIZE (16ull * 1024 * 1024)
+#define LVN_VULKAN_BUFFER_POOL_MAX_BUFFER_SIZE (1024ull * 1024)
+
+// descriptor sets held by the first chained or transient pool of a layout, later pools double in size up to the max
+#define LVN_VULKAN_DESCRIPTOR_POOL_INITIAL_SETS (64)
+#define LVN_VULKAN_DESCRIPTOR_POOL_MAX_SETS (4096)
+
+// frame latency is clamped to this many frames, and the longest wait for a previous frame to be presented in nanoseconds
+#define LVN_VULKAN_MAX_FRAME_LATENCY (3)
+#define LVN_VULKAN_PRESENT_WAIT_TIMEOUT (100ull * 1000 * 1000)
+
+// timestamp queries available to each frame in flight, every timestamp scope uses two
+#define LVN_VULKAN_MAX_TIMESTAMP_QUERIES (256)
+
+// environment maps are baked into rgba16f images, the bake shaders use 8x8 work groups
+#define LVN_VULKAN_ENVIRONMENT_MAP_FORMAT (VK_FORMAT_R16G16B16A16_SFLOAT)
+#define LVN_VULKAN_ENVIRONMENT_MAP_TEXEL_SIZE (4 * sizeof(uint16_t))
+#define LVN_VULKAN_ENVIRONMENT_MAP_GROUP_SIZE (8)
+
 
 
 namespace lvn
@@ -44,6 +97,51 @@ namespace lvn
 
 static VulkanBackends* s_VkBackends = nullptr;
 static std::mutex s_QueueSubmitMutex;
+static std::mutex s_UploadMutex;
+static std::mutex s_DeletionMutex;
+static LvnSharedMutex s_ShaderCacheMutex; // spirv cache lookups only take the shared lock
+static std::mutex s_SecondaryCommandMutex;
+static std::mutex s_DescriptorMutex;
+
+// secondary command buffer being recorded on the calling thread, render commands for its window are recorded into it
+struct VulkanSecondaryRecording
+{
+    LvnWindow* window;
+    LvnFrameBuffer* frameBuffer;
+    VkCommandBuffer commandBuffer;
+};
+
+static thread_local VulkanSecondaryRecording s_SecondaryRecording{};
+
+// frame of a window ready to be submitted, everything before vkQueueSubmit has already been done
+struct VulkanPendingSubmit
+{
+    LvnWindow* window;
+    VkCommandBuffer commandBuffers[2]; // staged buffer uploads, if any, then the frame command buffer
+    uint32_t commandBufferCount;
+    uint64_t submitIndex;
+    uint32_t frame;                    // frame in flight of the submission
+};
+
+// frames submitted between renderBeginSubmitBatch and renderEndSubmitBatch on the calling thread, sent with one queue submit and one present
+struct VulkanSubmitBatch
+{
+    bool active;
+    LvnVector<VulkanPendingSubmit> submits;
+
+    // scratch arrays of submitFrames, kept so submitting does not allocate every frame
+    LvnVector<VkSubmitInfo> submitInfos;
+    LvnVector<VkTimelineSemaphoreSubmitInfo> timelineInfos;
+    LvnVector<VkSemaphore> semaphores;
+    LvnVector<uint64_t> semaphoreValues;
+    LvnVector<VkSemaphore> presentSemaphores;
+    LvnVector<VkSwapchainKHR> swapChains;
+    LvnVector<uint32_t> imageIndices;
+    LvnVector<uint64_t> presentIds;
+    LvnVector<VkResult> presentResults;
+};
+
+static thread_local VulkanSubmitBatch s_SubmitBatch{};
 
 namespace vks
 {
@@ -57,8 +155,11 @@ namespace vks
     static void                                 setupDebugMessenger(VulkanBackends* vkBackends);
     static LvnPhysicalDeviceType                getPhysicalDeviceTypeEnum(VkPhysicalDeviceType type);
     static LvnVector<VkPhysicalDevice>          getPhysicalDevices(VkInstance instance);
-    static VkPhysicalDevice                     getBestPhysicalDevice(VkInstance instance, const LvnVector<VkPhysicalDevice>& physicalDevices);
+    static VkPhysicalDevice                     getBestPhysicalDevice(VkInstance instance, const LvnVector<VkPhysicalDevice>& physicalDevices, LvnPhysicalDevicePreference preference);
+    static uint64_t                             scorePhysicalDevice(VkPhysicalDevice physicalDevice, LvnPhysicalDevicePreference preference);
+    static uint64_t                             getDeviceLocalMemorySize(VkPhysicalDevice physicalDevice);
     static bool                                 checkDeviceExtensionSupport(VkPhysicalDevice device);
+    static bool                                 checkDeviceExtensionsAvailable(VkPhysicalDevice device, const char** ppExtensions, uint32_t count);
     static VulkanSwapChainSupportDetails        querySwapChainSupport(VkSurfaceKHR surface, VkPhysicalDevice device);
     static VulkanQueueFamilyIndices             findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface);
     static VkFormat                             findSupportedFormat(VkPhysicalDevice physicalDevice, const VkFormat* candidates, uint32_t count, VkImageTiling tiling, VkFormatFeatureFlags features);
@@ -67,17 +168,26 @@ namespace vks
     static LvnResult                            createLogicalDevice(VulkanBackends* vkBackends, VkSurfaceKHR surface);
     static void                                 createRenderPass(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, VkFormat format);
     static VkSurfaceFormatKHR                   chooseSwapSurfaceFormat(VulkanBackends* vkBackends, const VkSurfaceFormatKHR* pAvailableFormats, uint32_t count);
-    static VkPresentModeKHR                     chooseSwapPresentMode(const VkPresentModeKHR* pAvailablePresentModes, uint32_t count, bool vSync);
+    static VkPresentModeKHR                     chooseSwapPresentMode(const VkPresentModeKHR* pAvailablePresentModes, uint32_t count, LvnPresentMode mode, bool vSync);
     static VkExtent2D                           chooseSwapExtent(GLFWwindow* window, const VkSurfaceCapabilitiesKHR* capabilities);
-    static void                                 createSwapChain(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, VulkanSwapChainSupportDetails swapChainSupport, VkSurfaceFormatKHR surfaceFormat, VkPresentModeKHR presentMode, VkExtent2D extent);
+    static void                                 createSwapChain(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, VulkanSwapChainSupportDetails swapChainSupport, VkSurfaceFormatKHR surfaceFormat, VkPresentModeKHR presentMode, VkExtent2D extent, VkSwapchainKHR oldSwapChain);
     static VkImageView                          createImageView(VkDevice device, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags);
     static void                                 createImageViews(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
+    static void                                 createHeadlessImages(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, uint32_t width, uint32_t height);
     static void                                 createDepthResources(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
     static void                                 createFrameBuffers(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
     static void                                 createCommandBuffers(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
     static void                                 createSyncObjects(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
+    static void                                 createTimestampQueryPool(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
+    static void                                 readTimestampQueries(VulkanBackends* vkBackends, LvnWindow* window, VulkanWindowSurfaceData* surfaceData, uint32_t frameIndex);
+    static void                                 trackResourceMemory(VulkanBackends* vkBackends, VulkanMemoryResource resource, VmaAllocation allocation, bool allocated);
+    static void                                 trackFrameBufferMemory(VulkanBackends* vkBackends, VulkanFrameBufferData* frameBufferData, bool allocated);
     static LvnResult                            createOffscreenFrameBuffer(VulkanBackends* vkBackends, LvnFrameBuffer* frameBuffer);
-    static void                                 cleanSwapChain(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
+    static void                                 fillRenderingAttachments(VulkanFrameBufferData* frameBufferData);
+    static void                                 transitionRenderingAttachments(VkCommandBuffer commandBuffer, VulkanFrameBufferData* frameBufferData, bool begin);
+    static VkRenderingInfoKHR                   getRenderingInfo(VulkanFrameBufferData* frameBufferData, VkExtent2D renderExtent, VkRenderingFlagsKHR flags);
+    static void                                 retireSwapChain(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
+    static void                                 createRenderFinishedSemaphores(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
     static void                                 recreateSwapChain(VulkanBackends* vkBackends, LvnWindow* window);
     static LvnResult                            setupRenderInit(VulkanBackends* vkBackends, VkPhysicalDevice physicalDevice);
     static VkPrimitiveTopology                  getVulkanTopologyTypeEnum(LvnTopologyType topologyType);
@@ -85,6 +195,8 @@ namespace vks
     static VkFrontFace                          getVulkanCullFrontFaceEnum(LvnCullFrontFace cullFrontFace);
     static VkFormat                             getVulkanColorFormatEnum(LvnColorImageFormat format);
     static VkFormat                             getVulkanDepthFormatEnum(LvnDepthImageFormat format);
+    static VkFormat                             getVulkanCompressedFormatEnum(LvnTextureCompression compression, LvnTextureFormat format);
+    static VkFormat                             getTextureImageFormat(VulkanBackends* vkBackends, const LvnImageData& imageData, LvnTextureFormat format);
     static VkColorComponentFlags                getColorComponents(LvnPipelineColorWriteMask colorMask);
     static VkBlendFactor                        getBlendFactorEnum(LvnColorBlendFactor blendFactor);
     static VkBlendOp                            getBlendOperationEnum(LvnColorBlendOperation blendOp);
@@ -99,17 +211,78 @@ namespace vks
     static VkDescriptorType                     getDescriptorTypeEnum(LvnDescriptorType type);
     static VkBufferUsageFlags                   getUniformBufferTypeEnum(LvnBufferType type);
     static VkShaderStageFlags                   getShaderStageFlagEnum(LvnShaderStage stage);
+    static void                                 getMemoryBarrierDstEnums(LvnMemoryBarrierFlagBits barriers, VkPipelineStageFlags* dstStage, VkAccessFlags* dstAccess);
     static VkFilter                             getTextureFilterEnum(LvnTextureFilter filter);
     static VkSamplerAddressMode                 getTextureWrapModeEnum(LvnTextureMode mode);
     static VulkanPipeline                       createVulkanPipeline(VulkanBackends* vkBackends, VulkanPipelineCreateData* createData);
+    static void                                 setPipelineDynamicState(VulkanBackends* vkBackends, VkCommandBuffer commandBuffer, const VulkanPipelineDynamicState* dynamicState);
     static VkShaderModule                       createShaderModule(VulkanBackends* vkBackends, const uint8_t* code, uint32_t size);
     static LvnResult                            createBuffer(VulkanBackends* vkBackends, VkBuffer* buffer, VmaAllocation* bufferMemory, VkDeviceSize size, VkBufferUsageFlags usage, VmaMemoryUsage memUsage);
     static void                                 copyBuffer(VulkanBackends* vkBackends, VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset);
-    static LvnResult                            createImage(VulkanBackends* vkBackends, VkImage* image, VmaAllocation* imageMemory, uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkSampleCountFlagBits samples, VmaMemoryUsage memUsage);
-    static void                                 transitionImageLayout(VulkanBackends* vkBackends, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t layerCount);
-    static void                                 copyBufferToImage(VulkanBackends* vkBackends, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount);
+    static VulkanBufferPoolBlock*               createBufferPoolBlock(VulkanBackends* vkBackends, VmaMemoryUsage memUsage);
+    static void                                 destroyBufferPoolBlock(VulkanBackends* vkBackends, VulkanBufferPoolBlock* block);
+    static bool                                 allocateBufferRange(VulkanBackends* vkBackends, LvnBuffer* buffer, VkDeviceSize size, VmaMemoryUsage memUsage);
+    static void                                 freeBufferRange(VulkanBackends* vkBackends, VulkanBufferPoolBlock* block, VmaVirtualAllocation allocation);
+    static void                                 destroyBufferPool(VulkanBackends* vkBackends);
+    static void                                 pushBufferUpload(VulkanBackends* vkBackends, const VulkanBufferUpload& upload);
+    static void                                 recordBufferUploads(VulkanBackends* vkBackends, VkCommandBuffer commandBuffer);
+    static VkCommandBuffer                      beginUploadCommands(VulkanBackends* vkBackends);
+    static void                                 releaseStagingBuffer(VulkanBackends* vkBackends, VkBuffer stagingBuffer, VmaAllocation stagingMemory);
+    static void                                 releaseCompletedUploads(VulkanBackends* vkBackends);
+    static void                                 submitUploadCommands(VulkanBackends* vkBackends, bool wait);
+    static void                                 flushUploadCommands(VulkanBackends* vkBackends);
+    static void                                 prepareFrameSubmit(VulkanBackends* vkBackends, LvnWindow* window, VulkanPendingSubmit* submit);
+    static void                                 submitFrames(VulkanBackends* vkBackends, const VulkanPendingSubmit* submits, uint32_t count);
+    static void                                 flushSubmitBatch(VulkanBackends* vkBackends, LvnWindow* window);
+    static void                                 deferDestroy(VulkanBackends* vkBackends, VkObjectType type, uint64_t handle, VmaAllocation memory);
+    static void                                 advanceRingRegion(VulkanBackends* vkBackends, LvnWindow* window);
+    static void                                 waitRingRegion(VulkanBackends* vkBackends);
+    static void                                 deferFreeBufferRange(VulkanBackends* vkBackends, VulkanBufferPoolBlock* block, VmaVirtualAllocation allocation);
+    static void                                 releaseDeferredDeletions(VulkanBackends* vkBackends, bool all);
+    static void                                 writeDescriptorUpdates(VulkanBackends* vkBackends, const VulkanDescriptorUpdate* pUpdates, uint32_t count);
+    static VkDescriptorBufferInfo               getDescriptorBufferInfo(const LvnUniformBufferInfo* bufferInfo, uint32_t frame);
+    static void                                 getDescriptorUpdate(const LvnDescriptorSet* descriptorSet, const LvnDescriptorUpdateInfo* updateInfo, uint32_t frame, VulkanDescriptorUpdate* update);
+    static void                                 createDescriptorUpdateTemplate(VulkanBackends* vkBackends, VkDescriptorSetLayout descriptorLayout, const LvnVector<VkDescriptorSetLayoutBinding>& layoutBindings, VulkanDescriptorUpdateTemplate* updateTemplate);
+    static bool                                 descriptorUpdateCoversTemplate(const VulkanDescriptorUpdateTemplate* updateTemplate, const LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count);
+    static void                                 fillDescriptorTemplateData(const VulkanDescriptorUpdateTemplate* updateTemplate, const LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t frame, uint8_t* data);
+    static void                                 updateDescriptorSet(VulkanBackends* vkBackends, LvnDescriptorSet* descriptorSet, const LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count);
+    static void                                 applyPendingDescriptorUpdates(VulkanBackends* vkBackends, uint32_t frameIndex);
+    static LvnResult                            createDescriptorPool(VulkanBackends* vkBackends, const VulkanDescriptorAllocator* allocator, uint32_t maxSets, VulkanDescriptorPool* descriptorPool);
+    static VkResult                             allocateFromDescriptorPool(VulkanBackends* vkBackends, VulkanDescriptorPool* descriptorPool, VkDescriptorSetLayout descriptorLayout, uint32_t count, VkDescriptorSet* pDescriptorSets);
+    static uint32_t                             getNextDescriptorPoolSize(const LvnVector<VulkanDescriptorPool>& pools, uint32_t minSets);
+    static VulkanThreadCommandPool*             getThreadCommandPool(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
+    static void                                 resetThreadCommandPools(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, uint32_t frameIndex);
+    static void                                 destroyThreadCommandPools(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData);
+    static VkCommandBuffer                      getRecordingCommandBuffer(LvnWindow* window, VulkanWindowSurfaceData* surfaceData);
+    static bool                                 executeSecondaryCommandBuffers(VulkanWindowSurfaceData* surfaceData, LvnFrameBuffer* frameBuffer, const VkRenderPassBeginInfo* renderPassInfo);
+    static bool                                 readBinaryFile(const char* filepath, LvnVector<uint8_t>& data);
+    static bool                                 writeBinaryFile(const char* filepath, const uint8_t* data, size_t size);
+    static void                                 createPipelineCache(VulkanBackends* vkBackends);
+    static void                                 destroyPipelineCache(VulkanBackends* vkBackends);
+    static LvnResult                            createImage(VulkanBackends* vkBackends, VkImage* image, VmaAllocation* imageMemory, uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkSampleCountFlagBits samples, VmaMemoryUsage memUsage);
+    static void                                 transitionImageLayout(VulkanBackends* vkBackends, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t layerCount, uint32_t mipLevels);
+    static void                                 copyBufferToImage(VulkanBackends* vkBackends, VkBuffer buffer, VkDeviceSize bufferOffset, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevel, uint32_t layerCount);
+    static void                                 generateMipmaps(VulkanBackends* vkBackends, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount);
+    static void                                 cmdImageBarrier(VkCommandBuffer commandBuffer, VkImage image, uint32_t baseMipLevel, uint32_t mipLevels, uint32_t layerCount, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage);
+    static uint32_t                             getColorFormatPixelSize(VkFormat format);
+    static LvnResult                            readImagePixels(VulkanBackends* vkBackends, VkImage image, VkImageLayout layout, uint32_t width, uint32_t height, uint32_t pixelSize, void* data);
+    static bool                                 acquireReadbackBuffer(VulkanBackends* vkBackends, VkDeviceSize size, VulkanReadbackBuffer* readbackBuffer);
+    static void                                 releaseReadbackBuffer(VulkanBackends* vkBackends, const VulkanReadbackBuffer& readbackBuffer);
+    static void                                 destroyReadbackBuffers(VulkanBackends* vkBackends);
+    static void                                 readbackJob(void* userData);
+    static void                                 completeReadbacks(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, uint32_t frame, bool all);
+    static LvnResult                            createEnvironmentMapTexture(VulkanBackends* vkBackends, LvnTexture* texture, uint32_t size, uint32_t mipLevels, uint32_t layerCount);
+    static void                                 addEnvironmentMapPass(VulkanBackends* vkBackends, LvnVector<VulkanEnvironmentMapPass>* passes, VkPipeline pipeline, VkImageView srcView, VkSampler srcSampler, const LvnTexture* dst, uint32_t mipLevel, uint32_t layerCount, float roughness);
+    static void                                 recordEnvironmentMapPass(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const VulkanEnvironmentMapPass& pass);
+    static void                                 uploadEnvironmentMap(VulkanBackends* vkBackends, LvnEnvironmentMap* environmentMap, const LvnEnvironmentMapBakeInfo* bakeInfo);
+    static LvnResult                            bakeEnvironmentMap(VulkanBackends* vkBackends, LvnEnvironmentMap* environmentMap, const LvnEnvironmentMapBakeInfo* bakeInfo);
+    static VkDeviceSize                         getTextureStagingSize(const LvnImageData& imageData);
+    static void                                 copyTextureStagingData(uint8_t* dst, const LvnImageData& imageData);
+    static LvnResult                            createTextureImage(VulkanBackends* vkBackends, VkImage* image, VmaAllocation* imageMemory, uint32_t* mipLevels, VkFormat format, const LvnImageData& imageData, const LvnImageData* pMipImageData);
 #ifdef LVN_INCLUDE_GLSLANG_SRC_COMPILE_SUPPORT
     static LvnResult                            compileShaderToSPIRV(glslang_stage_t stage, const char* shaderSource, LvnVector<uint8_t>& bin);
+    static uint64_t                             hashShaderSource(glslang_stage_t stage, const char* shaderSource);
+    static LvnResult                            getShaderSPIRV(VulkanBackends* vkBackends, glslang_stage_t stage, const char* shaderSource, LvnVector<uint8_t>& bin);
 #endif
 
     static LvnResult createVulkanInstace(VulkanBackends* vkBackends, bool enableValidationLayers)
@@ -294,7 +467,7 @@ namespace vks
         return physicalDevices;
     }
 
-    static VkPhysicalDevice getBestPhysicalDevice(VkInstance instance, const LvnVector<VkPhysicalDevice>& physicalDevices)
+    static VkPhysicalDevice getBestPhysicalDevice(VkInstance instance, const LvnVector<VkPhysicalDevice>& physicalDevices, LvnPhysicalDevicePreference preference)
     {
         glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
         VkSurfaceKHR surface;
@@ -306,7 +479,7 @@ namespace vks
             return VK_NULL_HANDLE;
         }
 
-        size_t bestScore = 0;
+        uint64_t bestScore = 0;
         VkPhysicalDevice bestDevice = VK_NULL_HANDLE;
 
         for (const auto& physicalDevice : physicalDevices)
@@ -321,25 +494,13 @@ namespace vks
             if (!vks::checkDeviceExtensionSupport(physicalDevice))
                 continue;
 
-            VkPhysicalDeviceProperties deviceProperties{};
-            vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
-
-            VkPhysicalDeviceFeatures deviceFeatures{};
-            vkGetPhysicalDeviceFeatures(physicalDevice, &deviceFeatures);
-
-            size_t score = 0;
-
-            if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
-                score += 1000;
-            else if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU)
-                score += 500;
-            else if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU)
-                score += 100;
-            else if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU)
-                score += 10;
-            else
-                score += 1;
+            if (preference == Lvn_PhysicalDevicePreference_FirstSupported)
+            {
+                bestDevice = physicalDevice;
+                break;
+            }
 
+            uint64_t score = vks::scorePhysicalDevice(physicalDevice, preference);
             if (score > bestScore)
             {
                 bestScore = score;
@@ -347,6 +508,9 @@ namespace vks
             }
         }
 
+        if (bestDevice == VK_NULL_HANDLE)
+            LVN_CORE_ERROR("[vulkan] no physical device supports the queue families and extensions needed for rendering");
+
         vkDestroySurfaceKHR(instance, surface, nullptr);
         glfwDestroyWindow(glfwWindow);
         glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
@@ -354,6 +518,75 @@ namespace vks
         return bestDevice;
     }
 
+    // the device type decides the score first, then video memory, queue families and features break ties between devices of the same type
+    static uint64_t scorePhysicalDevice(VkPhysicalDevice physicalDevice, LvnPhysicalDevicePreference preference)
+    {
+        VkPhysicalDeviceProperties deviceProperties{};
+        vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+
+        VkPhysicalDeviceFeatures deviceFeatures{};
+        vkGetPhysicalDeviceFeatures(physicalDevice, &deviceFeatures);
+
+        uint64_t typeRank = 1;
+        switch (deviceProperties.deviceType)
+        {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: { typeRank = preference == Lvn_PhysicalDevicePreference_LowPower ? 4 : 5; break; }
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: { typeRank = preference == Lvn_PhysicalDevicePreference_LowPower ? 5 : 4; break; }
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: { typeRank = 3; break; }
+            case VK_PHYSICAL_DEVICE_TYPE_CPU: { typeRank = 2; break; }
+            default: { break; }
+        }
+
+        uint64_t score = typeRank * 1000000000000ull;
+
+        // megabytes of video memory, integrated gpus report the shared system memory they may use
+        if (preference != Lvn_PhysicalDevicePreference_LowPower)
+            score += lvn::min<uint64_t>(vks::getDeviceLocalMemorySize(physicalDevice) / (1024 * 1024), 100000000ull) * 1000;
+
+        // queue families the device can run uploads and compute work on next to graphics
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+        LvnVector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+        bool dedicatedTransfer = false, asyncCompute = false;
+        for (const VkQueueFamilyProperties& queueFamily : queueFamilies)
+        {
+            if ((queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) && !(queueFamily.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+                dedicatedTransfer = true;
+            if ((queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT))
+                asyncCompute = true;
+        }
+
+        if (dedicatedTransfer) score += 5000;
+        if (asyncCompute) score += 5000;
+
+        // features the renderer uses when they are available
+        if (deviceFeatures.samplerAnisotropy) score += 1000;
+        if (deviceFeatures.multiDrawIndirect) score += 1000;
+        if (deviceFeatures.drawIndirectFirstInstance) score += 1000;
+        if (deviceFeatures.textureCompressionBC || deviceFeatures.textureCompressionASTC_LDR) score += 1000;
+        if (deviceFeatures.fillModeNonSolid) score += 1000;
+        if (deviceFeatures.sampleRateShading) score += 1000;
+
+        return score;
+    }
+
+    static uint64_t getDeviceLocalMemorySize(VkPhysicalDevice physicalDevice)
+    {
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+        uint64_t size = 0;
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+        {
+            if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+                size += memoryProperties.memoryHeaps[i].size;
+        }
+
+        return size;
+    }
+
     static VulkanQueueFamilyIndices findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface)
     {
         VulkanQueueFamilyIndices indices{};
@@ -470,15 +703,102 @@ namespace vks
         if (vkBackends->deviceSupportedFeatures.samplerAnisotropy)
             deviceFeatures.samplerAnisotropy = VK_TRUE;
 
+        // enable block compressed texture formats when available
+        deviceFeatures.textureCompressionBC = vkBackends->deviceSupportedFeatures.textureCompressionBC;
+        deviceFeatures.textureCompressionETC2 = vkBackends->deviceSupportedFeatures.textureCompressionETC2;
+        deviceFeatures.textureCompressionASTC_LDR = vkBackends->deviceSupportedFeatures.textureCompressionASTC_LDR;
+
+        // indirect draws, multiple draws per call and a gpu side draw count when available
+        deviceFeatures.multiDrawIndirect = vkBackends->deviceSupportedFeatures.multiDrawIndirect;
+        deviceFeatures.drawIndirectFirstInstance = vkBackends->deviceSupportedFeatures.drawIndirectFirstInstance;
+
+        // texture arrays indexed with dynamically uniform values, eg. the material table indexed by a push constant
+        deviceFeatures.shaderSampledImageArrayDynamicIndexing = vkBackends->deviceSupportedFeatures.shaderSampledImageArrayDynamicIndexing;
+
+        // optional features are chained onto the device create info only when supported
+        void* pNextFeatures = nullptr;
+
+        VkPhysicalDeviceVulkan12Features vulkan12Features{};
+        vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        vulkan12Features.drawIndirectCount = vkBackends->drawIndirectCountSupported ? VK_TRUE : VK_FALSE;
+        vulkan12Features.timelineSemaphore = vkBackends->timelineSemaphoreSupported ? VK_TRUE : VK_FALSE;
+
+        if (vkBackends->drawIndirectCountSupported || vkBackends->timelineSemaphoreSupported)
+        {
+            vulkan12Features.pNext = pNextFeatures;
+            pNextFeatures = &vulkan12Features;
+        }
+
+        LvnVector<const char*> deviceExtensions(s_DeviceExtensions, s_DeviceExtensions + ARRAY_LEN(s_DeviceExtensions));
+
+        VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+        presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+        presentIdFeatures.presentId = VK_TRUE;
+
+        VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+        presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+        presentWaitFeatures.presentWait = VK_TRUE;
+
+        if (vkBackends->presentWaitSupported)
+        {
+            for (uint32_t i = 0; i < ARRAY_LEN(s_PresentWaitDeviceExtensions); i++)
+                deviceExtensions.push_back(s_PresentWaitDeviceExtensions[i]);
+
+            presentIdFeatures.pNext = pNextFeatures;
+            presentWaitFeatures.pNext = &presentIdFeatures;
+            pNextFeatures = &presentWaitFeatures;
+        }
+
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures{};
+        dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+
+        if (vkBackends->dynamicRenderingSupported)
+        {
+            deviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+
+            dynamicRenderingFeatures.pNext = pNextFeatures;
+            pNextFeatures = &dynamicRenderingFeatures;
+        }
+
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures{};
+        extendedDynamicStateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+        extendedDynamicStateFeatures.extendedDynamicState = VK_TRUE;
+
+        if (vkBackends->extendedDynamicStateSupported)
+        {
+            deviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+
+            extendedDynamicStateFeatures.pNext = pNextFeatures;
+            pNextFeatures = &extendedDynamicStateFeatures;
+        }
+
+        // only the blend enable state of the third extension is used
+        VkPhysicalDeviceExtendedDynamicState3FeaturesEXT extendedDynamicState3Features{};
+        extendedDynamicState3Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+        extendedDynamicState3Features.extendedDynamicState3ColorBlendEnable = VK_TRUE;
+
+        if (vkBackends->dynamicBlendEnableSupported)
+        {
+            deviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+
+            extendedDynamicState3Features.pNext = pNextFeatures;
+            pNextFeatures = &extendedDynamicState3Features;
+        }
+
+        if (vkBackends->memoryBudgetSupported)
+            deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = pNextFeatures;
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
         createInfo.queueCreateInfoCount = queueCreateInfos.size();
 
         createInfo.pEnabledFeatures = &deviceFeatures;
 
-        createInfo.ppEnabledExtensionNames = s_DeviceExtensions;
-        createInfo.enabledExtensionCount = ARRAY_LEN(s_DeviceExtensions);
+        createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+        createInfo.enabledExtensionCount = deviceExtensions.size();
 
         if (vkBackends->enableValidationLayers)
         {
@@ -498,6 +818,49 @@ namespace vks
         vkGetDeviceQueue(vkBackends->device, queueIndices.presentIndex, 0, &vkBackends->presentQueue);
         vkGetDeviceQueue(vkBackends->device, queueIndices.graphicsIndex, 0, &vkBackends->graphicsQueue);
 
+        // extension functions are not exported by the loader and are fetched from the device
+        vkBackends->waitForPresentFn = nullptr;
+        if (vkBackends->presentWaitSupported)
+        {
+            vkBackends->waitForPresentFn = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(vkBackends->device, "vkWaitForPresentKHR"));
+            vkBackends->presentWaitSupported = vkBackends->waitForPresentFn != nullptr;
+        }
+
+        vkBackends->beginRenderingFn = nullptr;
+        vkBackends->endRenderingFn = nullptr;
+        if (vkBackends->dynamicRenderingSupported)
+        {
+            vkBackends->beginRenderingFn = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdBeginRenderingKHR"));
+            vkBackends->endRenderingFn = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdEndRenderingKHR"));
+            vkBackends->dynamicRenderingSupported = vkBackends->beginRenderingFn != nullptr && vkBackends->endRenderingFn != nullptr;
+        }
+
+        vkBackends->setCullModeFn = nullptr;
+        vkBackends->setFrontFaceFn = nullptr;
+        vkBackends->setPrimitiveTopologyFn = nullptr;
+        vkBackends->setDepthTestEnableFn = nullptr;
+        vkBackends->setDepthWriteEnableFn = nullptr;
+        vkBackends->setDepthCompareOpFn = nullptr;
+        if (vkBackends->extendedDynamicStateSupported)
+        {
+            vkBackends->setCullModeFn = reinterpret_cast<PFN_vkCmdSetCullModeEXT>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdSetCullModeEXT"));
+            vkBackends->setFrontFaceFn = reinterpret_cast<PFN_vkCmdSetFrontFaceEXT>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdSetFrontFaceEXT"));
+            vkBackends->setPrimitiveTopologyFn = reinterpret_cast<PFN_vkCmdSetPrimitiveTopologyEXT>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdSetPrimitiveTopologyEXT"));
+            vkBackends->setDepthTestEnableFn = reinterpret_cast<PFN_vkCmdSetDepthTestEnableEXT>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdSetDepthTestEnableEXT"));
+            vkBackends->setDepthWriteEnableFn = reinterpret_cast<PFN_vkCmdSetDepthWriteEnableEXT>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdSetDepthWriteEnableEXT"));
+            vkBackends->setDepthCompareOpFn = reinterpret_cast<PFN_vkCmdSetDepthCompareOpEXT>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdSetDepthCompareOpEXT"));
+            vkBackends->extendedDynamicStateSupported = vkBackends->setCullModeFn != nullptr && vkBackends->setFrontFaceFn != nullptr
+                && vkBackends->setPrimitiveTopologyFn != nullptr && vkBackends->setDepthTestEnableFn != nullptr
+                && vkBackends->setDepthWriteEnableFn != nullptr && vkBackends->setDepthCompareOpFn != nullptr;
+        }
+
+        vkBackends->setColorBlendEnableFn = nullptr;
+        if (vkBackends->dynamicBlendEnableSupported)
+        {
+            vkBackends->setColorBlendEnableFn = reinterpret_cast<PFN_vkCmdSetColorBlendEnableEXT>(vkGetDeviceProcAddr(vkBackends->device, "vkCmdSetColorBlendEnableEXT"));
+            vkBackends->dynamicBlendEnableSupported = vkBackends->setColorBlendEnableFn != nullptr;
+        }
+
         return Lvn_Result_Success;
     }
 
@@ -512,7 +875,7 @@ namespace vks
         colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        colorAttachment.finalLayout = surfaceData->headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
         VkAttachmentReference colorAttachmentRef{};
         colorAttachmentRef.attachment = 0;
@@ -561,6 +924,33 @@ namespace vks
         LVN_CORE_CALL_ASSERT(vkCreateRenderPass(vkBackends->device, &renderPassInfo, nullptr, &surfaceData->renderPass) == VK_SUCCESS, "[vulkan] failed to create render pass!");
     }
 
+    static bool checkDeviceExtensionsAvailable(VkPhysicalDevice device, const char** ppExtensions, uint32_t count)
+    {
+        uint32_t extensionCount;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+        LvnVector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            bool extensionFound = false;
+            for (uint32_t j = 0; j < extensionCount; j++)
+            {
+                if (!strcmp(ppExtensions[i], availableExtensions[j].extensionName))
+                {
+                    extensionFound = true;
+                    break;
+                }
+            }
+
+            if (!extensionFound)
+                return false;
+        }
+
+        return true;
+    }
+
     static bool checkDeviceExtensionSupport(VkPhysicalDevice device)
     {
         uint32_t extensionCount;
@@ -633,15 +1023,39 @@ namespace vks
         return pAvailableFormats[0];
     }
 
-    static VkPresentModeKHR chooseSwapPresentMode(const VkPresentModeKHR* pAvailablePresentModes, uint32_t count, bool vSync)
+    static VkPresentModeKHR chooseSwapPresentMode(const VkPresentModeKHR* pAvailablePresentModes, uint32_t count, LvnPresentMode mode, bool vSync)
     {
-        VkPresentModeKHR presentMode = vSync ? VK_PRESENT_MODE_FIFO_KHR : VK_PRESENT_MODE_MAILBOX_KHR;
+        // preferred modes in order, fifo is always supported and used when none of them are
+        VkPresentModeKHR preferredModes[2];
+        uint32_t preferredModeCount = 0;
 
-        for (uint32_t i = 0; i < count; i++)
+        switch (mode)
+        {
+            case Lvn_PresentMode_Fifo: { preferredModes[preferredModeCount++] = VK_PRESENT_MODE_FIFO_KHR; break; }
+            case Lvn_PresentMode_FifoRelaxed: { preferredModes[preferredModeCount++] = VK_PRESENT_MODE_FIFO_RELAXED_KHR; break; }
+            case Lvn_PresentMode_Mailbox: { preferredModes[preferredModeCount++] = VK_PRESENT_MODE_MAILBOX_KHR; break; }
+            case Lvn_PresentMode_Immediate:
+            {
+                preferredModes[preferredModeCount++] = VK_PRESENT_MODE_IMMEDIATE_KHR;
+                preferredModes[preferredModeCount++] = VK_PRESENT_MODE_MAILBOX_KHR;
+                break;
+            }
+
+            default:
+            {
+                preferredModes[preferredModeCount++] = vSync ? VK_PRESENT_MODE_FIFO_KHR : VK_PRESENT_MODE_MAILBOX_KHR;
+                break;
+            }
+        }
+
+        for (uint32_t i = 0; i < preferredModeCount; i++)
         {
-            if (pAvailablePresentModes[i] == presentMode)
+            for (uint32_t j = 0; j < count; j++)
             {
-                return pAvailablePresentModes[i];
+                if (pAvailablePresentModes[j] == preferredModes[i])
+                {
+                    return pAvailablePresentModes[j];
+                }
             }
         }
 
@@ -665,7 +1079,7 @@ namespace vks
         return actualExtent;
     }
 
-    static void createSwapChain(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, VulkanSwapChainSupportDetails swapChainSupport, VkSurfaceFormatKHR surfaceFormat, VkPresentModeKHR presentMode, VkExtent2D extent)
+    static void createSwapChain(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, VulkanSwapChainSupportDetails swapChainSupport, VkSurfaceFormatKHR surfaceFormat, VkPresentModeKHR presentMode, VkExtent2D extent, VkSwapchainKHR oldSwapChain)
     {
         uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
 
@@ -704,7 +1118,7 @@ namespace vks
         createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
         createInfo.presentMode = presentMode;
         createInfo.clipped = VK_TRUE;
-        createInfo.oldSwapchain = VK_NULL_HANDLE;
+        createInfo.oldSwapchain = oldSwapChain;
 
         LVN_CORE_CALL_ASSERT(vkCreateSwapchainKHR(vkBackends->device, &createInfo, nullptr, &surfaceData->swapChain) == VK_SUCCESS, "[vulkan] failed to create swap chain!");
 
@@ -749,14 +1163,28 @@ namespace vks
         }
     }
 
+    // headless windows render each frame in flight to its own image, they are left in the transfer source layout for reading back
+    static void createHeadlessImages(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, uint32_t width, uint32_t height)
+    {
+        surfaceData->swapChainImageFormat = vkBackends->frameBufferColorFormat;
+        surfaceData->swapChainExtent = { width, height };
+        surfaceData->swapChainImages.resize(vkBackends->maxFramesInFlight);
+        surfaceData->headlessImageMemory.resize(vkBackends->maxFramesInFlight);
+
+        for (uint32_t i = 0; i < vkBackends->maxFramesInFlight; i++)
+        {
+            LVN_CORE_CALL_ASSERT(vks::createImage(vkBackends, &surfaceData->swapChainImages[i], &surfaceData->headlessImageMemory[i], width, height, 1, surfaceData->swapChainImageFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_SAMPLE_COUNT_1_BIT, VMA_MEMORY_USAGE_GPU_ONLY) == Lvn_Result_Success, "[vulkan] failed to create headless window image");
+        }
+    }
+
     static void createDepthResources(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
     {
         VkFormat depthFormat = vks::findDepthFormat(vkBackends->physicalDevice);
 
-        vks::createImage(vkBackends, &surfaceData->depthImage, &surfaceData->depthImageMemory, surfaceData->swapChainExtent.width, surfaceData->swapChainExtent.height, depthFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+        vks::createImage(vkBackends, &surfaceData->depthImage, &surfaceData->depthImageMemory, surfaceData->swapChainExtent.width, surfaceData->swapChainExtent.height, 1, depthFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
         surfaceData->depthImageView = vks::createImageView(vkBackends->device, surfaceData->depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
 
-        vks::transitionImageLayout(vkBackends, surfaceData->depthImage, depthFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, 1);
+        vks::transitionImageLayout(vkBackends, surfaceData->depthImage, depthFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, 1, 1);
     }
 
     static void createFrameBuffers(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
@@ -803,6 +1231,10 @@ namespace vks
 
         surfaceData->commandBuffers.resize(vkBackends->maxFramesInFlight);
         LVN_CORE_CALL_ASSERT(vkAllocateCommandBuffers(vkBackends->device, &allocInfo, surfaceData->commandBuffers.data()) == VK_SUCCESS, "[vulkan] failed to allocate command buffers!");
+
+        // upload command buffers for staged buffer copies, submitted before the frame command buffer
+        surfaceData->uploadCommandBuffers.resize(vkBackends->maxFramesInFlight);
+        LVN_CORE_CALL_ASSERT(vkAllocateCommandBuffers(vkBackends->device, &allocInfo, surfaceData->uploadCommandBuffers.data()) == VK_SUCCESS, "[vulkan] failed to allocate upload command buffers!");
     }
 
     static void createSyncObjects(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
@@ -815,18 +1247,125 @@ namespace vks
         fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
         surfaceData->imageAvailableSemaphores.resize(vkBackends->maxFramesInFlight);
-        surfaceData->inFlightFences.resize(vkBackends->maxFramesInFlight);
+        surfaceData->inFlightSubmitIndices.resize(vkBackends->maxFramesInFlight, 0);
 
         for (uint32_t i = 0; i < vkBackends->maxFramesInFlight; i++)
         {
             LVN_CORE_CALL_ASSERT(vkCreateSemaphore(vkBackends->device, &semaphoreInfo, nullptr, &surfaceData->imageAvailableSemaphores[i]) == VK_SUCCESS, "[vulkan] failed to create semaphore");
-            LVN_CORE_CALL_ASSERT(vkCreateFence(vkBackends->device, &fenceInfo, nullptr, &surfaceData->inFlightFences[i]) == VK_SUCCESS, "[vulkan] failed to create fence");
         }
 
-        surfaceData->renderFinishedSemaphores.resize(surfaceData->swapChainImages.size());
-        for (uint32_t i = 0; i < surfaceData->renderFinishedSemaphores.size(); i++)
+        // frames signal a single timeline semaphore with their submission index, per frame fences are only needed without timeline semaphores
+        surfaceData->frameTimeline = VK_NULL_HANDLE;
+        if (vkBackends->timelineSemaphoreSupported)
         {
-            LVN_CORE_CALL_ASSERT(vkCreateSemaphore(vkBackends->device, &semaphoreInfo, nullptr, &surfaceData->renderFinishedSemaphores[i]) == VK_SUCCESS, "[vulkan] failed to create semaphore");
+            VkSemaphoreTypeCreateInfo timelineInfo{};
+            timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+            timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+            timelineInfo.initialValue = 0;
+
+            VkSemaphoreCreateInfo timelineSemaphoreInfo{};
+            timelineSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            timelineSemaphoreInfo.pNext = &timelineInfo;
+
+            LVN_CORE_CALL_ASSERT(vkCreateSemaphore(vkBackends->device, &timelineSemaphoreInfo, nullptr, &surfaceData->frameTimeline) == VK_SUCCESS, "[vulkan] failed to create timeline semaphore");
+        }
+        else
+        {
+            surfaceData->inFlightFences.resize(vkBackends->maxFramesInFlight);
+            for (uint32_t i = 0; i < vkBackends->maxFramesInFlight; i++)
+            {
+                LVN_CORE_CALL_ASSERT(vkCreateFence(vkBackends->device, &fenceInfo, nullptr, &surfaceData->inFlightFences[i]) == VK_SUCCESS, "[vulkan] failed to create fence");
+            }
+        }
+
+        vks::createRenderFinishedSemaphores(vkBackends, surfaceData);
+    }
+
+    static void createTimestampQueryPool(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
+    {
+        surfaceData->timestampQueryPool = VK_NULL_HANDLE;
+        surfaceData->timestampFrames.resize(vkBackends->maxFramesInFlight);
+
+        if (!vkBackends->timestampsSupported)
+            return;
+
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = vkBackends->maxFramesInFlight * LVN_VULKAN_MAX_TIMESTAMP_QUERIES;
+
+        LVN_CORE_CALL_ASSERT(vkCreateQueryPool(vkBackends->device, &queryPoolInfo, nullptr, &surfaceData->timestampQueryPool) == VK_SUCCESS, "[vulkan] failed to create timestamp query pool");
+    }
+
+    // the frame was waited on before this is called so its queries are normally available, results are never waited for
+    static void readTimestampQueries(VulkanBackends* vkBackends, LvnWindow* window, VulkanWindowSurfaceData* surfaceData, uint32_t frameIndex)
+    {
+        LvnGpuTimestampFrame& frame = surfaceData->timestampFrames[frameIndex];
+
+        if (frame.queryCount > 0)
+        {
+            LvnVector<uint64_t> queryResults(frame.queryCount);
+            VkResult result = vkGetQueryPoolResults(vkBackends->device, surfaceData->timestampQueryPool, frameIndex * LVN_VULKAN_MAX_TIMESTAMP_QUERIES, frame.queryCount, queryResults.memsize(), queryResults.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+            if (result == VK_SUCCESS)
+            {
+                double nanosecondsPerTick = static_cast<double>(vkBackends->deviceProperties.limits.timestampPeriod);
+
+                window->timestamps.clear();
+                for (uint32_t i = 0; i < frame.scopes.size(); i++)
+                {
+                    const LvnGpuTimestampScope& scope = frame.scopes[i];
+                    if (scope.beginQuery == UINT32_MAX || !scope.ended) { continue; }
+
+                    uint64_t ticks = queryResults[scope.beginQuery + 1] - queryResults[scope.beginQuery];
+
+                    LvnGpuTimestampResult timestamp{};
+                    timestamp.name = scope.name;
+                    timestamp.milliseconds = static_cast<double>(ticks) * nanosecondsPerTick / 1000000.0;
+                    timestamp.depth = scope.depth;
+                    window->timestamps.push_back(timestamp);
+                }
+            }
+        }
+
+        frame.scopes.clear();
+        frame.openScopes.clear();
+        frame.queryCount = 0;
+    }
+
+    // counts the memory of an allocation towards its resource type, call with allocated false before the allocation is freed
+    static void trackResourceMemory(VulkanBackends* vkBackends, VulkanMemoryResource resource, VmaAllocation allocation, bool allocated)
+    {
+        if (allocation == VK_NULL_HANDLE)
+            return;
+
+        VmaAllocationInfo allocationInfo;
+        vmaGetAllocationInfo(vkBackends->vmaAllocator, allocation, &allocationInfo);
+
+        if (allocated)
+        {
+            vkBackends->resourceMemoryBytes[resource] += allocationInfo.size;
+            vkBackends->resourceAllocationCount[resource]++;
+        }
+        else
+        {
+            vkBackends->resourceMemoryBytes[resource] -= allocationInfo.size;
+            vkBackends->resourceAllocationCount[resource]--;
+        }
+    }
+
+    static void trackFrameBufferMemory(VulkanBackends* vkBackends, VulkanFrameBufferData* frameBufferData, bool allocated)
+    {
+        for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
+            vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_FrameBuffer, frameBufferData->colorImageMemory[i], allocated);
+
+        if (frameBufferData->hasDepth)
+            vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_FrameBuffer, frameBufferData->depthImageMemory, allocated);
+
+        if (frameBufferData->multisampling)
+        {
+            for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
+                vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_FrameBuffer, frameBufferData->msaaColorImageMemory[i], allocated);
         }
     }
 
@@ -837,11 +1376,15 @@ namespace vks
 
         LvnVector<VkImageView> attachments(frameBufferData->totalAttachmentCount);
 
+        // multisampled color images are only resolved within the render pass and never read afterwards, so they can stay in tile memory
+        VkImageUsageFlags colorUsage = frameBufferData->multisampling ? VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        VmaMemoryUsage colorMemUsage = frameBufferData->multisampling ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED : VMA_MEMORY_USAGE_GPU_ONLY;
+
         for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
         {
             VkFormat colorFormat = vks::getVulkanColorFormatEnum(frameBufferData->colorAttachments[i].format);
 
-            if (vks::createImage(vkBackends, &frameBufferData->colorImages[i], &frameBufferData->colorImageMemory[i], frameBufferData->width, frameBufferData->height, colorFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, frameBufferData->sampleCount, VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
+            if (vks::createImage(vkBackends, &frameBufferData->colorImages[i], &frameBufferData->colorImageMemory[i], frameBufferData->width, frameBufferData->height, 1, colorFormat, VK_IMAGE_TILING_OPTIMAL, colorUsage, frameBufferData->sampleCount, colorMemUsage) != Lvn_Result_Success)
             {
                 LVN_CORE_ERROR("[vulkan] failed to create image <VkImage> when creating framebuffer at (%p)", frameBuffer);
                 return Lvn_Result_Failure;
@@ -875,6 +1418,8 @@ namespace vks
                 textureImage.imageView = frameBufferData->colorImageViews[i];
                 textureImage.imageMemory = frameBufferData->colorImageMemory[i];
                 textureImage.sampler = frameBufferData->sampler;
+                textureImage.width = frameBufferData->width;
+                textureImage.height = frameBufferData->height;
                 frameBufferData->frameBufferImages[frameBufferData->colorAttachments[i].index] = textureImage;
             }
         }
@@ -883,8 +1428,13 @@ namespace vks
         if (frameBufferData->hasDepth)
         {
             VkFormat depthFormat = vks::getVulkanDepthFormatEnum(frameBufferData->depthAttachment.format);
+            bool depthSampled = frameBufferData->depthAttachment.sampled;
 
-            if (vks::createImage(vkBackends, &frameBufferData->depthImage, &frameBufferData->depthImageMemory, frameBufferData->width, frameBufferData->height, depthFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, frameBufferData->sampleCount, VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
+            // depth that is not sampled is discarded at the end of the render pass and only needs tile memory
+            VkImageUsageFlags depthUsage = depthSampled ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT : VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+            VmaMemoryUsage depthMemUsage = depthSampled ? VMA_MEMORY_USAGE_GPU_ONLY : VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+
+            if (vks::createImage(vkBackends, &frameBufferData->depthImage, &frameBufferData->depthImageMemory, frameBufferData->width, frameBufferData->height, 1, depthFormat, VK_IMAGE_TILING_OPTIMAL, depthUsage, frameBufferData->sampleCount, depthMemUsage) != Lvn_Result_Success)
             {
                 LVN_CORE_ERROR("[vulkan] failed to create image <VkImage> when creating framebuffer at (%p)", frameBuffer);
                 return Lvn_Result_Failure;
@@ -914,9 +1464,21 @@ namespace vks
 
             attachments[frameBufferData->depthAttachment.index] = frameBufferData->depthImageView;
 
+            // descriptors can only sample one aspect of a depth stencil image
+            frameBufferData->depthSampleView = frameBufferData->depthImageView;
+            if (depthSampled && vks::hasStencilComponent(depthFormat))
+            {
+                depthStencilView.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+                if (vkCreateImageView(vkBackends->device, &depthStencilView, nullptr, &frameBufferData->depthSampleView) != VK_SUCCESS)
+                {
+                    LVN_CORE_ERROR("[vulkan] failed to create depth sample image view <VkImageView> when creating frambuffer at (%p)", frameBuffer);
+                    return Lvn_Result_Failure;
+                }
+            }
+
             LvnTexture textureImage{};
             textureImage.image = frameBufferData->depthImage;
-            textureImage.imageView = frameBufferData->depthImageView;
+            textureImage.imageView = frameBufferData->depthSampleView;
             textureImage.imageMemory = frameBufferData->depthImageMemory;
             textureImage.sampler = frameBufferData->sampler;
             frameBufferData->frameBufferImages[frameBufferData->depthAttachment.index] = textureImage;
@@ -934,7 +1496,7 @@ namespace vks
             {
                 VkFormat colorFormat = vks::getVulkanColorFormatEnum(frameBufferData->colorAttachments[i].format);
 
-                if (vks::createImage(vkBackends, &frameBufferData->msaaColorImages[i], &frameBufferData->msaaColorImageMemory[i], frameBufferData->width, frameBufferData->height, colorFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_SAMPLE_COUNT_1_BIT, VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
+                if (vks::createImage(vkBackends, &frameBufferData->msaaColorImages[i], &frameBufferData->msaaColorImageMemory[i], frameBufferData->width, frameBufferData->height, 1, colorFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_SAMPLE_COUNT_1_BIT, VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
                 {
                     LVN_CORE_ERROR("[vulkan] failed to create image <VkImage> when creating framebuffer at (%p)", frameBuffer);
                     return Lvn_Result_Failure;
@@ -967,10 +1529,18 @@ namespace vks
                 textureImage.imageView = frameBufferData->msaaColorImageViews[i];
                 textureImage.imageMemory = frameBufferData->msaaColorImageMemory[i];
                 textureImage.sampler = frameBufferData->sampler;
+                textureImage.width = frameBufferData->width;
+                textureImage.height = frameBufferData->height;
                 frameBufferData->frameBufferImages[frameBufferData->colorAttachments[i].index] = textureImage;
             }
         }
 
+        if (frameBufferData->dynamicRendering)
+        {
+            vks::fillRenderingAttachments(frameBufferData);
+            return Lvn_Result_Success;
+        }
+
         VkFramebufferCreateInfo fbufCreateInfo{};
         fbufCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         fbufCreateInfo.renderPass = frameBufferData->renderPass;
@@ -989,56 +1559,242 @@ namespace vks
         return Lvn_Result_Success;
     }
 
-    static void cleanSwapChain(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
+    // the attachments match the load and store ops of the render pass a framebuffer would otherwise use
+    static void fillRenderingAttachments(VulkanFrameBufferData* frameBufferData)
     {
-        // swap chain images
-        for (uint32_t i = 0; i < surfaceData->swapChainImageViews.size(); i++)
+        frameBufferData->renderingColorAttachments.resize(frameBufferData->colorAttachments.size());
+        for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
         {
-            vkDestroyImageView(vkBackends->device, surfaceData->swapChainImageViews[i], nullptr);
+            VkRenderingAttachmentInfoKHR& attachment = frameBufferData->renderingColorAttachments[i];
+            attachment = {};
+            attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+            attachment.imageView = frameBufferData->colorImageViews[i];
+            attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachment.storeOp = frameBufferData->multisampling ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+
+            if (frameBufferData->multisampling)
+            {
+                attachment.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
+                attachment.resolveImageView = frameBufferData->msaaColorImageViews[i];
+                attachment.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            }
         }
 
-        vkDestroyImageView(vkBackends->device, surfaceData->depthImageView, nullptr);
-        vkDestroyImage(vkBackends->device, surfaceData->depthImage, nullptr);
-        vmaFreeMemory(vkBackends->vmaAllocator, surfaceData->depthImageMemory);
-
-        // frame buffers
-        for (uint32_t i = 0; i < surfaceData->frameBuffers.size(); i++)
+        frameBufferData->renderingDepthAttachment = {};
+        frameBufferData->renderingStencilAttachment = {};
+        if (frameBufferData->hasDepth)
         {
-            vkDestroyFramebuffer(vkBackends->device, surfaceData->frameBuffers[i], nullptr);
+            VkRenderingAttachmentInfoKHR& attachment = frameBufferData->renderingDepthAttachment;
+            attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+            attachment.imageView = frameBufferData->depthImageView;
+            attachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachment.storeOp = frameBufferData->depthAttachment.sampled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
+            // the stencil aspect shares the depth image view, its contents are not kept like in the render pass
+            frameBufferData->renderingStencilAttachment = attachment;
+            frameBufferData->renderingStencilAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            frameBufferData->renderingStencilAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         }
-
-        // swap chain
-        vkDestroySwapchainKHR(vkBackends->device, surfaceData->swapChain, nullptr);
     }
 
-    static void recreateSwapChain(VulkanBackends* vkBackends, LvnWindow* window)
+    // dynamic rendering has no subpass dependencies, the layout transitions of the render pass are recorded as barriers
+    static void transitionRenderingAttachments(VkCommandBuffer commandBuffer, VulkanFrameBufferData* frameBufferData, bool begin)
     {
-        vkDeviceWaitIdle(vkBackends->device);
+        LvnVector<VkImageMemoryBarrier> barriers;
 
-        VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
-        GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
-        bool vSync = window->data.vSync;
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
 
-        vks::cleanSwapChain(vkBackends, surfaceData);
+        // color, only the resolve images are sampled when multisampling
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
+        {
+            VkImage sampledImage = frameBufferData->multisampling ? frameBufferData->msaaColorImages[i] : frameBufferData->colorImages[i];
 
-        VulkanSwapChainSupportDetails swapChainSupport = vks::querySwapChainSupport(surfaceData->surface, vkBackends->physicalDevice);
-        LVN_CORE_ASSERT(!swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty(), "[vulkan] physical device does not have swap chain support formats or present modes!");
+            if (begin)
+            {
+                // the previous contents are cleared, the transition only has to wait for earlier passes sampling the image
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+                barrier.image = frameBufferData->colorImages[i];
+                barriers.push_back(barrier);
+                if (frameBufferData->multisampling)
+                {
+                    barrier.image = sampledImage;
+                    barriers.push_back(barrier);
+                }
+            }
+            else
+            {
+                barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                barrier.image = sampledImage;
+                barriers.push_back(barrier);
+            }
+        }
+
+        // depth, attachments that are not sampled stay in the attachment layout
+        bool depthSampled = frameBufferData->hasDepth && frameBufferData->depthAttachment.sampled;
+        if (frameBufferData->hasDepth && (begin || depthSampled))
+        {
+            VkFormat depthFormat = frameBufferData->renderingFormats.depthFormat;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            if (vks::hasStencilComponent(depthFormat))
+                barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+
+            barrier.image = frameBufferData->depthImage;
+            barrier.srcAccessMask = begin ? 0 : VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            barrier.dstAccessMask = begin ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : VK_ACCESS_SHADER_READ_BIT;
+            barrier.oldLayout = begin ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            barrier.newLayout = begin ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barriers.push_back(barrier);
+        }
+
+        VkPipelineStageFlags srcStage, dstStage;
+        if (begin)
+        {
+            srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        }
+        else
+        {
+            srcStage = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        }
+
+        if (!barriers.empty())
+            vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, barriers.size(), barriers.data());
+    }
+
+    static VkRenderingInfoKHR getRenderingInfo(VulkanFrameBufferData* frameBufferData, VkExtent2D renderExtent, VkRenderingFlagsKHR flags)
+    {
+        // clear colors can change between frames, they are copied in every time the framebuffer begins
+        for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
+            frameBufferData->renderingColorAttachments[i].clearValue = frameBufferData->clearValues[frameBufferData->colorAttachments[i].index];
+
+        if (frameBufferData->hasDepth)
+        {
+            frameBufferData->renderingDepthAttachment.clearValue = frameBufferData->clearValues[frameBufferData->depthAttachment.index];
+            frameBufferData->renderingStencilAttachment.clearValue = frameBufferData->renderingDepthAttachment.clearValue;
+        }
+
+        VkRenderingInfoKHR renderingInfo{};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        renderingInfo.flags = flags;
+        renderingInfo.renderArea.offset = { 0, 0 };
+        renderingInfo.renderArea.extent = renderExtent;
+        renderingInfo.layerCount = 1;
+        renderingInfo.colorAttachmentCount = frameBufferData->renderingColorAttachments.size();
+        renderingInfo.pColorAttachments = frameBufferData->renderingColorAttachments.data();
+        renderingInfo.pDepthAttachment = frameBufferData->hasDepth ? &frameBufferData->renderingDepthAttachment : nullptr;
+        renderingInfo.pStencilAttachment = frameBufferData->renderingFormats.stencilFormat != VK_FORMAT_UNDEFINED ? &frameBufferData->renderingStencilAttachment : nullptr;
+
+        return renderingInfo;
+    }
+
+    // hands the swap chain resources to the deferred deletion queue, they are destroyed once the frames using them retire
+    static void retireSwapChain(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
+    {
+        // swap chain images
+        for (uint32_t i = 0; i < surfaceData->swapChainImageViews.size(); i++)
+        {
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)surfaceData->swapChainImageViews[i], nullptr);
+        }
+
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)surfaceData->depthImageView, nullptr);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)surfaceData->depthImage, surfaceData->depthImageMemory);
+
+        // frame buffers
+        for (uint32_t i = 0; i < surfaceData->frameBuffers.size(); i++)
+        {
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_FRAMEBUFFER, (uint64_t)surfaceData->frameBuffers[i], nullptr);
+        }
+
+        // render finished semaphores may still be waited on by the last presents of the old swap chain
+        for (uint32_t i = 0; i < surfaceData->renderFinishedSemaphores.size(); i++)
+        {
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_SEMAPHORE, (uint64_t)surfaceData->renderFinishedSemaphores[i], nullptr);
+        }
+
+        // swap chain, the new swap chain is created from it before it is destroyed
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_SWAPCHAIN_KHR, (uint64_t)surfaceData->swapChain, nullptr);
+    }
+
+    static void createRenderFinishedSemaphores(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
+    {
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        surfaceData->renderFinishedSemaphores.resize(surfaceData->swapChainImages.size());
+        for (uint32_t i = 0; i < surfaceData->renderFinishedSemaphores.size(); i++)
+        {
+            LVN_CORE_CALL_ASSERT(vkCreateSemaphore(vkBackends->device, &semaphoreInfo, nullptr, &surfaceData->renderFinishedSemaphores[i]) == VK_SUCCESS, "[vulkan] failed to create semaphore");
+        }
+    }
+
+    // the new swap chain is created from the old one so the device is never waited on,
+    // resources of the old swap chain are retired through the deferred deletion queue
+    static void recreateSwapChain(VulkanBackends* vkBackends, LvnWindow* window)
+    {
+        VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+        GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        bool vSync = window->data.vSync;
+
+        // headless images keep the size the window was created with
+        if (surfaceData->headless) { return; }
+
+        // a minimized window has no framebuffer to present to, wait until it is restored
+        int width = 0, height = 0;
+        glfwGetFramebufferSize(glfwWin, &width, &height);
+        while (width == 0 || height == 0)
+        {
+            glfwWaitEvents();
+            glfwGetFramebufferSize(glfwWin, &width, &height);
+        }
+
+        VulkanSwapChainSupportDetails swapChainSupport = vks::querySwapChainSupport(surfaceData->surface, vkBackends->physicalDevice);
+        LVN_CORE_ASSERT(!swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty(), "[vulkan] physical device does not have swap chain support formats or present modes!");
 
         VkSurfaceFormatKHR surfaceFormat = vks::chooseSwapSurfaceFormat(vkBackends, swapChainSupport.formats.data(), swapChainSupport.formats.size());
-        VkPresentModeKHR presentMode = vks::chooseSwapPresentMode(swapChainSupport.presentModes.data(), swapChainSupport.presentModes.size(), vSync);
+        VkPresentModeKHR presentMode = vks::chooseSwapPresentMode(swapChainSupport.presentModes.data(), swapChainSupport.presentModes.size(), window->data.presentMode, vSync);
         VkExtent2D extent = vks::chooseSwapExtent(glfwWin, &swapChainSupport.capabilities);
 
-        vks::createSwapChain(vkBackends, surfaceData, swapChainSupport, surfaceFormat, presentMode, extent);
+        vks::retireSwapChain(vkBackends, surfaceData);
+        vks::createSwapChain(vkBackends, surfaceData, swapChainSupport, surfaceFormat, presentMode, extent, surfaceData->swapChain);
+        vks::createRenderFinishedSemaphores(vkBackends, surfaceData);
         vks::createImageViews(vkBackends, surfaceData);
         vks::createDepthResources(vkBackends, surfaceData);
         vks::createFrameBuffers(vkBackends, surfaceData);
+
+        // present ids belong to the swap chain they were presented with
+        surfaceData->presentId = 0;
     }
 
     static LvnResult setupRenderInit(VulkanBackends* vkBackends, VkPhysicalDevice physicalDevice)
     {
         if (vkBackends->device != VK_NULL_HANDLE)
+        {
+            vks::flushUploadCommands(vkBackends);
             vkDeviceWaitIdle(vkBackends->device);
+        }
 
+        if (vkBackends->pipelineCache != VK_NULL_HANDLE)
+        {
+            vks::destroyPipelineCache(vkBackends);
+        }
         if (vkBackends->commandPool != VK_NULL_HANDLE)
         {
             vkDestroyCommandPool(vkBackends->device, vkBackends->commandPool, nullptr);
@@ -1046,6 +1802,7 @@ namespace vks
         }
         if (vkBackends->vmaAllocator != VK_NULL_HANDLE)
         {
+            vks::destroyBufferPool(vkBackends);
             vmaDestroyAllocator(vkBackends->vmaAllocator);
             vkBackends->vmaAllocator = VK_NULL_HANDLE;
         }
@@ -1066,6 +1823,82 @@ namespace vks
         vkGetPhysicalDeviceFeatures(vkBackends->physicalDevice, &supportedFeatures);
         vkBackends->deviceSupportedFeatures = supportedFeatures;
 
+        vkBackends->drawIndirectCountSupported = false;
+        vkBackends->timelineSemaphoreSupported = false;
+        vkBackends->presentWaitSupported = false;
+        vkBackends->dynamicRenderingSupported = false;
+        vkBackends->extendedDynamicStateSupported = false;
+        vkBackends->dynamicBlendEnableSupported = false;
+        vkBackends->timestampsSupported = physicalDeviceProperties.limits.timestampComputeAndGraphics == VK_TRUE;
+
+        // the budget is queried with vkGetPhysicalDeviceMemoryProperties2 which is core since vulkan 1.1
+        vkBackends->descriptorUpdateTemplateSupported = physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_1;
+        vkBackends->memoryBudgetSupported = physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_1
+            && vks::checkDeviceExtensionsAvailable(vkBackends->physicalDevice, s_MemoryBudgetDeviceExtensions, ARRAY_LEN(s_MemoryBudgetDeviceExtensions));
+        if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2)
+        {
+            VkPhysicalDeviceVulkan12Features vulkan12Features{};
+            vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+            // present wait features are only queried when their extensions are available
+            VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+            presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+
+            VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+            presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+            bool presentWaitExtensions = vks::checkDeviceExtensionsAvailable(vkBackends->physicalDevice, s_PresentWaitDeviceExtensions, ARRAY_LEN(s_PresentWaitDeviceExtensions));
+            if (presentWaitExtensions)
+            {
+                presentIdFeatures.pNext = &presentWaitFeatures;
+                presentWaitFeatures.pNext = vulkan12Features.pNext;
+                vulkan12Features.pNext = &presentIdFeatures;
+            }
+
+            // dynamic rendering needs depth stencil resolve which is core since vulkan 1.2
+            VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures{};
+            dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+
+            bool dynamicRenderingExtensions = vks::checkDeviceExtensionsAvailable(vkBackends->physicalDevice, s_DynamicRenderingDeviceExtensions, ARRAY_LEN(s_DynamicRenderingDeviceExtensions));
+            if (dynamicRenderingExtensions)
+            {
+                dynamicRenderingFeatures.pNext = vulkan12Features.pNext;
+                vulkan12Features.pNext = &dynamicRenderingFeatures;
+            }
+
+            VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures{};
+            extendedDynamicStateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+
+            bool extendedDynamicStateExtensions = vks::checkDeviceExtensionsAvailable(vkBackends->physicalDevice, s_ExtendedDynamicStateDeviceExtensions, ARRAY_LEN(s_ExtendedDynamicStateDeviceExtensions));
+            if (extendedDynamicStateExtensions)
+            {
+                extendedDynamicStateFeatures.pNext = vulkan12Features.pNext;
+                vulkan12Features.pNext = &extendedDynamicStateFeatures;
+            }
+
+            VkPhysicalDeviceExtendedDynamicState3FeaturesEXT extendedDynamicState3Features{};
+            extendedDynamicState3Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+
+            bool extendedDynamicState3Extensions = vks::checkDeviceExtensionsAvailable(vkBackends->physicalDevice, s_ExtendedDynamicState3DeviceExtensions, ARRAY_LEN(s_ExtendedDynamicState3DeviceExtensions));
+            if (extendedDynamicState3Extensions)
+            {
+                extendedDynamicState3Features.pNext = vulkan12Features.pNext;
+                vulkan12Features.pNext = &extendedDynamicState3Features;
+            }
+
+            VkPhysicalDeviceFeatures2 supportedFeatures2{};
+            supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            supportedFeatures2.pNext = &vulkan12Features;
+            vkGetPhysicalDeviceFeatures2(vkBackends->physicalDevice, &supportedFeatures2);
+
+            vkBackends->drawIndirectCountSupported = vulkan12Features.drawIndirectCount;
+            vkBackends->timelineSemaphoreSupported = vulkan12Features.timelineSemaphore;
+            vkBackends->presentWaitSupported = presentWaitExtensions && presentIdFeatures.presentId && presentWaitFeatures.presentWait;
+            vkBackends->dynamicRenderingSupported = dynamicRenderingExtensions && dynamicRenderingFeatures.dynamicRendering;
+            vkBackends->extendedDynamicStateSupported = extendedDynamicStateExtensions && extendedDynamicStateFeatures.extendedDynamicState;
+            vkBackends->dynamicBlendEnableSupported = extendedDynamicState3Extensions && extendedDynamicState3Features.extendedDynamicState3ColorBlendEnable;
+        }
+
         // create dummy window and surface to get device queue indices support
         glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
         VkSurfaceKHR surface;
@@ -1103,9 +1936,15 @@ namespace vks
         allocatorInfo.device = vkBackends->device;
         allocatorInfo.physicalDevice = vkBackends->physicalDevice;
         allocatorInfo.instance = vkBackends->instance;
+        allocatorInfo.vulkanApiVersion = physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_1 ? VK_API_VERSION_1_1 : VK_API_VERSION_1_0;
+        if (vkBackends->memoryBudgetSupported)
+            allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
 
         vmaCreateAllocator(&allocatorInfo, &vkBackends->vmaAllocator);
 
+        // pipeline cache, loaded from the cache file if there is one
+        vks::createPipelineCache(vkBackends);
+
         return Lvn_Result_Success;
     }
 
@@ -1199,6 +2038,57 @@ namespace vks
         }
     }
 
+    static VkFormat getVulkanCompressedFormatEnum(LvnTextureCompression compression, LvnTextureFormat format)
+    {
+        bool unorm = format == Lvn_TextureFormat_Unorm;
+
+        switch (compression)
+        {
+            case Lvn_TextureCompression_Bc1: { return unorm ? VK_FORMAT_BC1_RGBA_UNORM_BLOCK : VK_FORMAT_BC1_RGBA_SRGB_BLOCK; }
+            case Lvn_TextureCompression_Bc3: { return unorm ? VK_FORMAT_BC3_UNORM_BLOCK : VK_FORMAT_BC3_SRGB_BLOCK; }
+            case Lvn_TextureCompression_Bc4: { return VK_FORMAT_BC4_UNORM_BLOCK; }
+            case Lvn_TextureCompression_Bc5: { return VK_FORMAT_BC5_UNORM_BLOCK; }
+            case Lvn_TextureCompression_Bc7: { return unorm ? VK_FORMAT_BC7_UNORM_BLOCK : VK_FORMAT_BC7_SRGB_BLOCK; }
+            case Lvn_TextureCompression_Etc2Rgb: { return unorm ? VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK : VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK; }
+            case Lvn_TextureCompression_Etc2Rgba: { return unorm ? VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK : VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK; }
+            case Lvn_TextureCompression_Astc4x4: { return unorm ? VK_FORMAT_ASTC_4x4_UNORM_BLOCK : VK_FORMAT_ASTC_4x4_SRGB_BLOCK; }
+
+            default:
+            {
+                LVN_CORE_WARN("unknown texture compression enum (%u), setting image format to undefined", compression);
+                return VK_FORMAT_UNDEFINED;
+            }
+        }
+    }
+
+    static VkFormat getTextureImageFormat(VulkanBackends* vkBackends, const LvnImageData& imageData, LvnTextureFormat format)
+    {
+        if (imageData.compression != Lvn_TextureCompression_None)
+        {
+            VkFormat compressedFormat = vks::getVulkanCompressedFormatEnum(imageData.compression, format);
+
+            VkFormatProperties formatProperties;
+            vkGetPhysicalDeviceFormatProperties(vkBackends->physicalDevice, compressedFormat, &formatProperties);
+
+            if (compressedFormat == VK_FORMAT_UNDEFINED || !(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+            {
+                LVN_CORE_ERROR("[vulkan] compressed texture format (%u) is not supported by the physical device", compressedFormat);
+                return VK_FORMAT_UNDEFINED;
+            }
+
+            return compressedFormat;
+        }
+
+        bool unorm = format == Lvn_TextureFormat_Unorm;
+
+        switch (imageData.channels)
+        {
+            case 1: { return unorm ? VK_FORMAT_R8_UNORM : VK_FORMAT_R8_SRGB; }
+            case 2: { return unorm ? VK_FORMAT_R8G8_UNORM : VK_FORMAT_R8G8_SRGB; }
+            default: { return unorm ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_SRGB; }
+        }
+    }
+
     static VkColorComponentFlags getColorComponents(LvnPipelineColorWriteMask colorMask)
     {
         VkColorComponentFlags colorComponentsFlag = 0;
@@ -1339,6 +2229,12 @@ namespace vks
             case Lvn_AttributeFormat_2_10_10_10_uile:  { return VK_FORMAT_A2B10G10R10_UINT_PACK32; }
             case Lvn_AttributeFormat_2_10_10_10_nle:   { return VK_FORMAT_A2B10G10R10_SNORM_PACK32; }
             case Lvn_AttributeFormat_2_10_10_10_unle:  { return VK_FORMAT_A2B10G10R10_UNORM_PACK32; }
+            case Lvn_AttributeFormat_Vec2_f16:         { return VK_FORMAT_R16G16_SFLOAT; }
+            case Lvn_AttributeFormat_Vec4_f16:         { return VK_FORMAT_R16G16B16A16_SFLOAT; }
+            case Lvn_AttributeFormat_Vec2_n16:         { return VK_FORMAT_R16G16_SNORM; }
+            case Lvn_AttributeFormat_Vec4_n16:         { return VK_FORMAT_R16G16B16A16_SNORM; }
+            case Lvn_AttributeFormat_Vec2_un16:        { return VK_FORMAT_R16G16_UNORM; }
+            case Lvn_AttributeFormat_Vec4_un16:        { return VK_FORMAT_R16G16B16A16_UNORM; }
 
             default:
             {
@@ -1442,6 +2338,7 @@ namespace vks
             case Lvn_DescriptorType_ImageSampler: { return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; }
             case Lvn_DescriptorType_ImageSamplerBindless: { return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; }
             case Lvn_DescriptorType_UniformBuffer: { return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; }
+            case Lvn_DescriptorType_UniformBufferDynamic: { return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; }
             case Lvn_DescriptorType_StorageBuffer: { return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; }
 
             default:
@@ -1474,6 +2371,7 @@ namespace vks
             case Lvn_ShaderStage_All: { return VK_SHADER_STAGE_ALL; }
             case Lvn_ShaderStage_Vertex: { return VK_SHADER_STAGE_VERTEX_BIT; }
             case Lvn_ShaderStage_Fragment: { return VK_SHADER_STAGE_FRAGMENT_BIT; }
+            case Lvn_ShaderStage_Compute: { return VK_SHADER_STAGE_COMPUTE_BIT; }
 
             default:
             {
@@ -1483,6 +2381,38 @@ namespace vks
         }
     }
 
+    static void getMemoryBarrierDstEnums(LvnMemoryBarrierFlagBits barriers, VkPipelineStageFlags* dstStage, VkAccessFlags* dstAccess)
+    {
+        *dstStage = 0;
+        *dstAccess = 0;
+
+        if (barriers & Lvn_MemoryBarrier_StorageBuffer)
+        {
+            *dstStage |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            *dstAccess |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        }
+        if (barriers & Lvn_MemoryBarrier_UniformBuffer)
+        {
+            *dstStage |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            *dstAccess |= VK_ACCESS_UNIFORM_READ_BIT;
+        }
+        if (barriers & Lvn_MemoryBarrier_VertexBuffer)
+        {
+            *dstStage |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+            *dstAccess |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        }
+        if (barriers & Lvn_MemoryBarrier_IndexBuffer)
+        {
+            *dstStage |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+            *dstAccess |= VK_ACCESS_INDEX_READ_BIT;
+        }
+        if (barriers & Lvn_MemoryBarrier_IndirectBuffer)
+        {
+            *dstStage |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+            *dstAccess |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        }
+    }
+
     static VkFilter getTextureFilterEnum(LvnTextureFilter filter)
     {
         switch (filter)
@@ -1538,6 +2468,32 @@ namespace vks
             dynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_WRITE_MASK);
         }
 
+        // states the device cannot set dynamically stay baked with the values of the specification
+        LvnPipelineDynamicStateFlagBits supportedStates = Lvn_PipelineDynamicState_None;
+        if (vkBackends->extendedDynamicStateSupported)
+            supportedStates |= Lvn_PipelineDynamicState_CullMode | Lvn_PipelineDynamicState_FrontFace | Lvn_PipelineDynamicState_PrimitiveTopology | Lvn_PipelineDynamicState_DepthTest;
+        if (vkBackends->dynamicBlendEnableSupported)
+            supportedStates |= Lvn_PipelineDynamicState_BlendEnable;
+
+        LvnPipelineDynamicStateFlagBits pipelineDynamicStates = pipelineSpecification->dynamicStates & supportedStates;
+        if (pipelineDynamicStates != pipelineSpecification->dynamicStates)
+            LVN_CORE_WARN("[vulkan] physical device does not support some of the dynamic states (0x%x) requested by the pipeline, they are baked into the pipeline instead", pipelineSpecification->dynamicStates & ~supportedStates);
+
+        if (pipelineDynamicStates & Lvn_PipelineDynamicState_CullMode)
+            dynamicStates.push_back(VK_DYNAMIC_STATE_CULL_MODE_EXT);
+        if (pipelineDynamicStates & Lvn_PipelineDynamicState_FrontFace)
+            dynamicStates.push_back(VK_DYNAMIC_STATE_FRONT_FACE_EXT);
+        if (pipelineDynamicStates & Lvn_PipelineDynamicState_PrimitiveTopology)
+            dynamicStates.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+        if (pipelineDynamicStates & Lvn_PipelineDynamicState_DepthTest)
+        {
+            dynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT);
+            dynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT);
+            dynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT);
+        }
+        if (pipelineDynamicStates & Lvn_PipelineDynamicState_BlendEnable)
+            dynamicStates.push_back(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT);
+
         VkPipelineDynamicStateCreateInfo dynamicState{};
         dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
         dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
@@ -1652,8 +2608,20 @@ namespace vks
 
         LVN_CORE_CALL_ASSERT(vkCreatePipelineLayout(vkBackends->device, &pipelineLayoutInfo, nullptr, &pipeline.pipelineLayout) == VK_SUCCESS, "[vulkan] failed to create pipeline layout!");
 
+        // without a render pass the pipeline only declares the formats it renders to
+        VkPipelineRenderingCreateInfoKHR renderingInfo{};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        if (createData->renderPass == VK_NULL_HANDLE && createData->renderingFormats != nullptr)
+        {
+            renderingInfo.colorAttachmentCount = createData->renderingFormats->colorFormats.size();
+            renderingInfo.pColorAttachmentFormats = createData->renderingFormats->colorFormats.data();
+            renderingInfo.depthAttachmentFormat = createData->renderingFormats->depthFormat;
+            renderingInfo.stencilAttachmentFormat = createData->renderingFormats->stencilFormat;
+        }
+
         VkGraphicsPipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.pNext = createData->renderPass == VK_NULL_HANDLE ? &renderingInfo : nullptr;
         pipelineInfo.renderPass = createData->renderPass;
         pipelineInfo.stageCount = 2;
         pipelineInfo.pStages = createData->shaderStages;
@@ -1670,11 +2638,45 @@ namespace vks
         pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
         pipelineInfo.basePipelineIndex = -1;
 
-        LVN_CORE_CALL_ASSERT(vkCreateGraphicsPipelines(vkBackends->device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline.pipeline) == VK_SUCCESS, "[vulkan] failed to create graphics pipeline!");
+        LVN_CORE_CALL_ASSERT(vkCreateGraphicsPipelines(vkBackends->device, vkBackends->pipelineCache, 1, &pipelineInfo, nullptr, &pipeline.pipeline) == VK_SUCCESS, "[vulkan] failed to create graphics pipeline!");
+
+        // the specification values of the dynamic states are set again each time the pipeline is bound
+        if (pipelineDynamicStates != Lvn_PipelineDynamicState_None)
+        {
+            pipeline.dynamicState = new VulkanPipelineDynamicState();
+            pipeline.dynamicState->states = pipelineDynamicStates;
+            pipeline.dynamicState->cullMode = rasterizer.cullMode;
+            pipeline.dynamicState->frontFace = rasterizer.frontFace;
+            pipeline.dynamicState->topology = inputAssembly.topology;
+            pipeline.dynamicState->depthTestEnable = depthStencil.depthTestEnable;
+            pipeline.dynamicState->depthWriteEnable = depthStencil.depthWriteEnable;
+            pipeline.dynamicState->depthCompareOp = depthStencil.depthCompareOp;
+
+            for (uint32_t i = 0; i < colorBlendAttachments.size(); i++)
+                pipeline.dynamicState->blendEnables.push_back(colorBlendAttachments[i].blendEnable);
+        }
 
         return pipeline;
     }
 
+    static void setPipelineDynamicState(VulkanBackends* vkBackends, VkCommandBuffer commandBuffer, const VulkanPipelineDynamicState* dynamicState)
+    {
+        if (dynamicState->states & Lvn_PipelineDynamicState_CullMode)
+            vkBackends->setCullModeFn(commandBuffer, dynamicState->cullMode);
+        if (dynamicState->states & Lvn_PipelineDynamicState_FrontFace)
+            vkBackends->setFrontFaceFn(commandBuffer, dynamicState->frontFace);
+        if (dynamicState->states & Lvn_PipelineDynamicState_PrimitiveTopology)
+            vkBackends->setPrimitiveTopologyFn(commandBuffer, dynamicState->topology);
+        if (dynamicState->states & Lvn_PipelineDynamicState_DepthTest)
+        {
+            vkBackends->setDepthTestEnableFn(commandBuffer, dynamicState->depthTestEnable);
+            vkBackends->setDepthWriteEnableFn(commandBuffer, dynamicState->depthWriteEnable);
+            vkBackends->setDepthCompareOpFn(commandBuffer, dynamicState->depthCompareOp);
+        }
+        if (dynamicState->states & Lvn_PipelineDynamicState_BlendEnable)
+            vkBackends->setColorBlendEnableFn(commandBuffer, 0, static_cast<uint32_t>(dynamicState->blendEnables.size()), dynamicState->blendEnables.data());
+    }
+
     static VkShaderModule createShaderModule(VulkanBackends* vkBackends, const uint8_t* code, uint32_t size)
     {
         VkShaderModuleCreateInfo createInfo{};
@@ -1707,25 +2709,10 @@ namespace vks
         return Lvn_Result_Success;
     }
 
-    static std::mutex s_CopyBufferMutex;
     void copyBuffer(VulkanBackends* vkBackends, VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset)
     {
-        std::lock_guard<std::mutex> lock(s_CopyBufferMutex);
-
-        VkCommandBufferAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = vkBackends->commandPool;
-        allocInfo.commandBufferCount = 1;
-
-        VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(vkBackends->device, &allocInfo, &commandBuffer);
-
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        std::lock_guard<std::mutex> lock(s_UploadMutex);
+        VkCommandBuffer commandBuffer = vks::beginUploadCommands(vkBackends);
 
         VkBufferCopy copyRegion{};
         copyRegion.size = size;
@@ -1733,185 +2720,2121 @@ namespace vks
         copyRegion.dstOffset = dstOffset;
         vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
 
-        vkEndCommandBuffer(commandBuffer);
-
-        VkSubmitInfo submitInfo{};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffer;
-
-        vkQueueSubmit(vkBackends->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(vkBackends->graphicsQueue);
-
-        vkFreeCommandBuffers(vkBackends->device, vkBackends->commandPool, 1, &commandBuffer);
+        // make the copy visible to any later reads on the queue
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
     }
 
-    static LvnResult createImage(VulkanBackends* vkBackends, VkImage* image, VmaAllocation* imageMemory, uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkSampleCountFlagBits samples, VmaMemoryUsage memUsage)
+    static VulkanBufferPoolBlock* createBufferPoolBlock(VulkanBackends* vkBackends, VmaMemoryUsage memUsage)
     {
-        VkImageCreateInfo imageInfo{};
-        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        imageInfo.imageType = VK_IMAGE_TYPE_2D;
-        imageInfo.extent.width = width;
-        imageInfo.extent.height = height;
-        imageInfo.extent.depth = 1;
-        imageInfo.mipLevels = 1;
-        imageInfo.arrayLayers = 1;
-        imageInfo.format = format;
-        imageInfo.tiling = tiling;
-        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        imageInfo.usage = usage;
-        imageInfo.samples = samples;
-        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        VulkanBufferPoolBlock* block = new VulkanBufferPoolBlock();
+        block->memUsage = memUsage;
 
-        VmaAllocationCreateInfo allocInfo{};
-        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        // blocks are shared by buffers of every type so they are created with all the buffer usages
+        VkBufferUsageFlags usageFlags = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT
+            | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
 
-        if (vmaCreateImage(vkBackends->vmaAllocator, &imageInfo, &allocInfo, image, imageMemory, nullptr) != VK_SUCCESS)
+        if (vks::createBuffer(vkBackends, &block->buffer, &block->memory, LVN_VULKAN_BUFFER_POOL_BLOCK_SIZE, usageFlags, memUsage) != Lvn_Result_Success)
         {
-            LVN_CORE_ERROR("[vulkan] failed to create image <VkImage>, image size: (w:%u, h:%u)", width, height);
-            return Lvn_Result_Failure;
+            delete block;
+            return nullptr;
         }
 
-        return Lvn_Result_Success;
+        VmaVirtualBlockCreateInfo blockInfo{};
+        blockInfo.size = LVN_VULKAN_BUFFER_POOL_BLOCK_SIZE;
+
+        if (vmaCreateVirtualBlock(&blockInfo, &block->virtualBlock) != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create virtual block for buffer pool block <VkBuffer> (%p)", block->buffer);
+            vmaDestroyBuffer(vkBackends->vmaAllocator, block->buffer, block->memory);
+            delete block;
+            return nullptr;
+        }
+
+        if (memUsage == VMA_MEMORY_USAGE_CPU_ONLY)
+            vmaMapMemory(vkBackends->vmaAllocator, block->memory, &block->map);
+
+        vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Buffer, block->memory, true);
+        vkBackends->bufferPoolBlocks.push_back(block);
+
+        return block;
     }
 
-    static std::mutex s_TransitionImageLayoutMutex;
-    static void transitionImageLayout(VulkanBackends* vkBackends, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t layerCount)
+    static void destroyBufferPoolBlock(VulkanBackends* vkBackends, VulkanBufferPoolBlock* block)
     {
-        std::lock_guard<std::mutex> lock(s_TransitionImageLayoutMutex);
-
-        VkCommandBufferAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = vkBackends->commandPool;
-        allocInfo.commandBufferCount = 1;
+        vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Buffer, block->memory, false);
 
-        VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(vkBackends->device, &allocInfo, &commandBuffer);
+        if (block->map)
+            vmaUnmapMemory(vkBackends->vmaAllocator, block->memory);
 
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        // ranges of buffers that were never destroyed are dropped with the block
+        vmaClearVirtualBlock(block->virtualBlock);
+        vmaDestroyVirtualBlock(block->virtualBlock);
+        vmaDestroyBuffer(vkBackends->vmaAllocator, block->buffer, block->memory);
 
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        delete block;
+    }
 
+    // sub-allocates the buffer from a pool block, returns false when the buffer is too large to be pooled and needs its own allocation
+    static bool allocateBufferRange(VulkanBackends* vkBackends, LvnBuffer* buffer, VkDeviceSize size, VmaMemoryUsage memUsage)
+    {
+        if (size > LVN_VULKAN_BUFFER_POOL_MAX_BUFFER_SIZE)
+            return false;
 
-        VkImageMemoryBarrier barrier{};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.oldLayout = oldLayout;
-        barrier.newLayout = newLayout;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = image;
-        barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = 1;
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount = layerCount;
+        // ranges are aligned so any pooled buffer can also be bound as a uniform or storage buffer
+        const VkPhysicalDeviceLimits& limits = vkBackends->deviceProperties.limits;
+        VkDeviceSize alignment = lvn::max<VkDeviceSize>(16, lvn::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment));
 
-        if (newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
-        {
-            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        VmaVirtualAllocationCreateInfo rangeInfo{};
+        rangeInfo.size = size;
+        rangeInfo.alignment = alignment;
 
-            if (vks::hasStencilComponent(format))
-                barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
-        }
-        else
-            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        std::lock_guard<std::mutex> lock(vkBackends->bufferPoolMutex);
 
-        VkPipelineStageFlags sourceStage;
-        VkPipelineStageFlags destinationStage;
+        VulkanBufferPoolBlock* block = nullptr;
+        VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
 
-        if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-        {
-            barrier.srcAccessMask = 0;
-            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        }
-        else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+        for (uint32_t i = 0; i < vkBackends->bufferPoolBlocks.size(); i++)
         {
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-            sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            VulkanBufferPoolBlock* poolBlock = vkBackends->bufferPoolBlocks[i];
+            if (poolBlock->memUsage == memUsage && vmaVirtualAllocate(poolBlock->virtualBlock, &rangeInfo, &allocation, &offset) == VK_SUCCESS)
+            {
+                block = poolBlock;
+                break;
+            }
         }
-        else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
-        {
-            barrier.srcAccessMask = 0;
-            barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
-            sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            destinationStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-        } 
-        else
+        if (block == nullptr)
         {
-            LVN_CORE_ASSERT(false, "[vulkan] unsupported layout transition during image layout transition");
+            block = vks::createBufferPoolBlock(vkBackends, memUsage);
+            if (block == nullptr || vmaVirtualAllocate(block->virtualBlock, &rangeInfo, &allocation, &offset) != VK_SUCCESS)
+                return false;
         }
 
-        vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-
-        vkEndCommandBuffer(commandBuffer);
+        block->allocationCount++;
 
-        VkSubmitInfo submitInfo{};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffer;
+        buffer->buffer = block->buffer;
+        buffer->bufferMap = block->map ? static_cast<uint8_t*>(block->map) + offset : nullptr;
+        buffer->baseOffset = offset;
+        buffer->poolBlock = block;
+        buffer->poolAllocation = allocation;
 
-        vkQueueSubmit(vkBackends->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(vkBackends->graphicsQueue);
-
-        vkFreeCommandBuffers(vkBackends->device, vkBackends->commandPool, 1, &commandBuffer);
+        return true;
     }
 
-    static std::mutex s_CopyBufferToImageMutex;
-    static void copyBufferToImage(VulkanBackends* vkBackends, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount)
+    static void freeBufferRange(VulkanBackends* vkBackends, VulkanBufferPoolBlock* block, VmaVirtualAllocation allocation)
     {
-        std::lock_guard<std::mutex> lock(s_CopyBufferToImageMutex);
+        std::lock_guard<std::mutex> lock(vkBackends->bufferPoolMutex);
 
-        VkCommandBufferAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        vmaVirtualFree(block->virtualBlock, allocation);
+        block->allocationCount--;
+
+        if (block->allocationCount > 0)
+            return;
+
+        // empty blocks are released unless it is the last block of its memory usage, so creating and destroying small buffers does not reallocate a block each time
+        LvnVector<VulkanBufferPoolBlock*>& blocks = vkBackends->bufferPoolBlocks;
+        uint32_t blockIndex = 0, usageBlockCount = 0;
+        for (uint32_t i = 0; i < blocks.size(); i++)
+        {
+            if (blocks[i] == block)
+                blockIndex = i;
+            if (blocks[i]->memUsage == block->memUsage)
+                usageBlockCount++;
+        }
+
+        if (usageBlockCount > 1)
+        {
+            blocks.erase_index(blockIndex);
+            vks::destroyBufferPoolBlock(vkBackends, block);
+        }
+    }
+
+    static void destroyBufferPool(VulkanBackends* vkBackends)
+    {
+        std::lock_guard<std::mutex> lock(vkBackends->bufferPoolMutex);
+
+        for (uint32_t i = 0; i < vkBackends->bufferPoolBlocks.size(); i++)
+            vks::destroyBufferPoolBlock(vkBackends, vkBackends->bufferPoolBlocks[i]);
+
+        vkBackends->bufferPoolBlocks.clear();
+    }
+
+    // queue a staging copy, a region that continues the previous upload in both buffers extends it instead of adding another copy region
+    static void pushBufferUpload(VulkanBackends* vkBackends, const VulkanBufferUpload& upload)
+    {
+        LvnVector<VulkanBufferUpload>& uploads = vkBackends->pendingBufferUploads;
+
+        if (!uploads.empty())
+        {
+            VulkanBufferUpload& last = uploads.back();
+            if (last.srcBuffer == upload.srcBuffer && last.dstBuffer == upload.dstBuffer &&
+                last.region.srcOffset + last.region.size == upload.region.srcOffset &&
+                last.region.dstOffset + last.region.size == upload.region.dstOffset)
+            {
+                last.region.size += upload.region.size;
+                return;
+            }
+        }
+
+        uploads.push_back(upload);
+    }
+
+    static void recordBufferUploads(VulkanBackends* vkBackends, VkCommandBuffer commandBuffer)
+    {
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkResetCommandBuffer(commandBuffer, 0);
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+        VkPipelineStageFlags readStages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+        // wait for previous frames to finish reading before the buffers are overwritten
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, readStages, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        // batch consecutive regions with the same source and destination into one copy
+        LvnVector<VulkanBufferUpload>& uploads = vkBackends->pendingBufferUploads;
+        LvnVector<VkBufferCopy> regions;
+
+        for (uint32_t i = 0; i < uploads.size(); i++)
+        {
+            regions.push_back(uploads[i].region);
+
+            if (i + 1 < uploads.size() && uploads[i + 1].srcBuffer == uploads[i].srcBuffer && uploads[i + 1].dstBuffer == uploads[i].dstBuffer)
+                continue;
+
+            vkCmdCopyBuffer(commandBuffer, uploads[i].srcBuffer, uploads[i].dstBuffer, regions.size(), regions.data());
+            regions.clear();
+        }
+
+        // make the copied data visible to the draw commands of this frame
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, readStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        vkEndCommandBuffer(commandBuffer);
+        uploads.clear();
+    }
+
+    // NOTE: s_UploadMutex must be locked by the caller
+    static VkCommandBuffer beginUploadCommands(VulkanBackends* vkBackends)
+    {
+        VulkanUploadBatch& batch = vkBackends->uploadBatch;
+
+        if (batch.commandBuffer != VK_NULL_HANDLE)
+            return batch.commandBuffer;
+
+        vks::releaseCompletedUploads(vkBackends);
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         allocInfo.commandPool = vkBackends->commandPool;
         allocInfo.commandBufferCount = 1;
 
-        VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(vkBackends->device, &allocInfo, &commandBuffer);
+        LVN_CORE_CALL_ASSERT(vkAllocateCommandBuffers(vkBackends->device, &allocInfo, &batch.commandBuffer) == VK_SUCCESS, "[vulkan] failed to allocate upload command buffer");
 
         VkCommandBufferBeginInfo beginInfo{};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        vkBeginCommandBuffer(batch.commandBuffer, &beginInfo);
+        batch.stagingSize = 0;
 
+        return batch.commandBuffer;
+    }
 
-        VkBufferImageCopy region{};
-        region.bufferOffset = 0;
-        region.bufferRowLength = 0;
-        region.bufferImageHeight = 0;
+    static void releaseStagingBuffer(VulkanBackends* vkBackends, VkBuffer stagingBuffer, VmaAllocation stagingMemory)
+    {
+        bool submit = false;
+        {
+            std::lock_guard<std::mutex> lock(s_UploadMutex);
+            VulkanUploadBatch& batch = vkBackends->uploadBatch;
+
+            VmaAllocationInfo allocationInfo{};
+            vmaGetAllocationInfo(vkBackends->vmaAllocator, stagingMemory, &allocationInfo);
+
+            // staging buffers are kept alive until the batch that reads from them has finished
+            batch.stagingBuffers.push_back(stagingBuffer);
+            batch.stagingMemory.push_back(stagingMemory);
+            batch.stagingSize += allocationInfo.size;
+
+            submit = batch.stagingSize >= LVN_VULKAN_UPLOAD_BATCH_MAX_STAGING_SIZE;
+        }
+
+        // submit early if the batch holds too much staging memory
+        if (submit)
+        {
+            std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+            vks::submitUploadCommands(vkBackends, false);
+        }
+    }
+
+    // NOTE: s_UploadMutex must be locked by the caller
+    static void releaseCompletedUploads(VulkanBackends* vkBackends)
+    {
+        LvnVector<VulkanUploadBatch>& submitted = vkBackends->submittedUploads;
+
+        for (uint32_t i = 0; i < submitted.size();)
+        {
+            if (vkGetFenceStatus(vkBackends->device, submitted[i].fence) != VK_SUCCESS)
+            {
+                i++;
+                continue;
+            }
+
+            for (uint32_t j = 0; j < submitted[i].stagingBuffers.size(); j++)
+            {
+                vkDestroyBuffer(vkBackends->device, submitted[i].stagingBuffers[j], nullptr);
+                vmaFreeMemory(vkBackends->vmaAllocator, submitted[i].stagingMemory[j]);
+            }
+
+            vkDestroyFence(vkBackends->device, submitted[i].fence, nullptr);
+            vkFreeCommandBuffers(vkBackends->device, vkBackends->commandPool, 1, &submitted[i].commandBuffer);
+            submitted.erase_index(i);
+        }
+    }
+
+    // NOTE: s_QueueSubmitMutex must be locked by the caller
+    static void submitUploadCommands(VulkanBackends* vkBackends, bool wait)
+    {
+        std::lock_guard<std::mutex> lock(s_UploadMutex);
+        VulkanUploadBatch& batch = vkBackends->uploadBatch;
+
+        if (batch.commandBuffer != VK_NULL_HANDLE)
+        {
+            vkEndCommandBuffer(batch.commandBuffer);
+
+            VkFenceCreateInfo fenceInfo{};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            LVN_CORE_CALL_ASSERT(vkCreateFence(vkBackends->device, &fenceInfo, nullptr, &batch.fence) == VK_SUCCESS, "[vulkan] failed to create upload fence");
+
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &batch.commandBuffer;
+
+            // later submits on the same queue are ordered after the upload, resources can be used in any frame recorded after this point
+            LVN_CORE_CALL_ASSERT(vkQueueSubmit(vkBackends->graphicsQueue, 1, &submitInfo, batch.fence) == VK_SUCCESS, "[vulkan] failed to submit upload command buffer");
+
+            vkBackends->submittedUploads.push_back(batch);
+            batch = VulkanUploadBatch{};
+        }
+
+        // staging buffers released without any recorded commands are still owned by the batch
+        else if (!batch.stagingBuffers.empty())
+        {
+            for (uint32_t i = 0; i < batch.stagingBuffers.size(); i++)
+            {
+                vkDestroyBuffer(vkBackends->device, batch.stagingBuffers[i], nullptr);
+                vmaFreeMemory(vkBackends->vmaAllocator, batch.stagingMemory[i]);
+            }
+            batch = VulkanUploadBatch{};
+        }
+
+        if (wait)
+        {
+            for (uint32_t i = 0; i < vkBackends->submittedUploads.size(); i++)
+                vkWaitForFences(vkBackends->device, 1, &vkBackends->submittedUploads[i].fence, VK_TRUE, UINT64_MAX);
+        }
+
+        vks::releaseCompletedUploads(vkBackends);
+    }
+
+    static void flushUploadCommands(VulkanBackends* vkBackends)
+    {
+        std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+        vks::submitUploadCommands(vkBackends, true);
+    }
+
+    // NOTE: s_QueueSubmitMutex must be locked by the caller
+    // the submission index is taken here and not when the frame reaches the queue, objects destroyed while later windows of a batch record are retired after their frames
+    static void prepareFrameSubmit(VulkanBackends* vkBackends, LvnWindow* window, VulkanPendingSubmit* submit)
+    {
+        VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+
+        // resource uploads recorded since the last frame are submitted first so the frame can use them
+        vks::submitUploadCommands(vkBackends, false);
+
+        submit->window = window;
+        submit->frame = surfaceData->currentFrame;
+        submit->commandBufferCount = 0;
+
+        // staged buffer uploads are submitted ahead of the frame command buffer
+        if (!vkBackends->pendingBufferUploads.empty())
+        {
+            vks::recordBufferUploads(vkBackends, surfaceData->uploadCommandBuffers[surfaceData->currentFrame]);
+            submit->commandBuffers[submit->commandBufferCount++] = surfaceData->uploadCommandBuffers[surfaceData->currentFrame];
+        }
+        submit->commandBuffers[submit->commandBufferCount++] = surfaceData->commandBuffers[surfaceData->currentFrame];
+
+        submit->submitIndex = vkBackends->submitIndex + 1;
+        surfaceData->inFlightSubmitIndices[surfaceData->currentFrame] = submit->submitIndex;
+        vkBackends->submitIndex = submit->submitIndex;
+        vkBackends->recordingFrame = false;
+    }
+
+    // NOTE: s_QueueSubmitMutex must be locked by the caller
+    // sends the batch of the calling thread early when it holds a frame of the window, the window cannot begin or destroy a frame that has not reached the queue
+    static void flushSubmitBatch(VulkanBackends* vkBackends, LvnWindow* window)
+    {
+        VulkanSubmitBatch& batch = s_SubmitBatch;
+        for (const VulkanPendingSubmit& submit : batch.submits)
+        {
+            if (submit.window == window)
+            {
+                vks::submitFrames(vkBackends, batch.submits.data(), batch.submits.size());
+                batch.submits.clear();
+                return;
+            }
+        }
+    }
+
+    // NOTE: s_QueueSubmitMutex must be locked by the caller
+    static void submitFrames(VulkanBackends* vkBackends, const VulkanPendingSubmit* submits, uint32_t count)
+    {
+        VulkanSubmitBatch& scratch = s_SubmitBatch;
+        scratch.submitInfos.resize(count);
+        scratch.timelineInfos.resize(count);
+        scratch.semaphores.resize(count * 3); // image available, render finished and frame timeline per frame
+        scratch.semaphoreValues.resize(count * 2);
+        scratch.presentSemaphores.resize(count);
+        scratch.swapChains.resize(count);
+        scratch.imageIndices.resize(count);
+        scratch.presentIds.resize(count);
+        scratch.presentResults.resize(count);
+
+        static const VkPipelineStageFlags waitStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        bool allTimeline = true;
+        uint32_t presentCount = 0;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(submits[i].window->apiData);
+            bool timeline = surfaceData->frameTimeline != VK_NULL_HANDLE;
+            allTimeline &= timeline;
+
+            // the frame signals its submission index on the timeline, the value paired with the binary render finished semaphore is ignored
+            VkSemaphore* semaphores = &scratch.semaphores[i * 3];
+            semaphores[0] = surfaceData->imageAvailableSemaphores[submits[i].frame];
+            semaphores[1] = surfaceData->renderFinishedSemaphores[surfaceData->imageIndex];
+            semaphores[2] = surfaceData->frameTimeline;
+
+            uint64_t* signalValues = &scratch.semaphoreValues[i * 2];
+            signalValues[0] = 0;
+            signalValues[1] = submits[i].submitIndex;
+
+            VkTimelineSemaphoreSubmitInfo& timelineSubmitInfo = scratch.timelineInfos[i];
+            timelineSubmitInfo = VkTimelineSemaphoreSubmitInfo{};
+            timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineSubmitInfo.signalSemaphoreValueCount = 2;
+            timelineSubmitInfo.pSignalSemaphoreValues = signalValues;
+
+            VkSubmitInfo& submitInfo = scratch.submitInfos[i];
+            submitInfo = VkSubmitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext = timeline ? &timelineSubmitInfo : nullptr;
+            submitInfo.waitSemaphoreCount = 1;
+            submitInfo.pWaitSemaphores = &semaphores[0];
+            submitInfo.pWaitDstStageMask = &waitStages;
+            submitInfo.commandBufferCount = submits[i].commandBufferCount;
+            submitInfo.pCommandBuffers = submits[i].commandBuffers;
+            submitInfo.signalSemaphoreCount = timeline ? 2 : 1;
+            submitInfo.pSignalSemaphores = &semaphores[1];
+
+            // headless frames acquire and present nothing, they only signal their timeline
+            if (surfaceData->headless)
+            {
+                timelineSubmitInfo.signalSemaphoreValueCount = 1;
+                timelineSubmitInfo.pSignalSemaphoreValues = &signalValues[1];
+                submitInfo.waitSemaphoreCount = 0;
+                submitInfo.signalSemaphoreCount = timeline ? 1 : 0;
+                submitInfo.pSignalSemaphores = &semaphores[2];
+                continue;
+            }
+
+            scratch.swapChains[presentCount] = surfaceData->swapChain;
+            scratch.imageIndices[presentCount] = surfaceData->imageIndex;
+            scratch.presentIds[presentCount] = surfaceData->presentId + 1;
+            scratch.presentSemaphores[presentCount] = semaphores[1];
+            presentCount++;
+        }
+
+        // frames are waited on through their timelines so one submit carries every frame,
+        // without timeline semaphores each frame signals its own fence and needs its own submit
+        if (allTimeline)
+        {
+            LVN_CORE_CALL_ASSERT(vkQueueSubmit(vkBackends->graphicsQueue, count, scratch.submitInfos.data(), VK_NULL_HANDLE) == VK_SUCCESS, "[vulkan] failed to submit draw command buffers!");
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(submits[i].window->apiData);
+                VkFence frameFence = surfaceData->frameTimeline != VK_NULL_HANDLE ? VK_NULL_HANDLE : surfaceData->inFlightFences[submits[i].frame];
+                LVN_CORE_CALL_ASSERT(vkQueueSubmit(vkBackends->graphicsQueue, 1, &scratch.submitInfos[i], frameFence) == VK_SUCCESS, "[vulkan] failed to submit draw command buffer!");
+            }
+        }
+
+        VkPresentInfoKHR presentInfo{};
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = presentCount;
+        presentInfo.pWaitSemaphores = scratch.presentSemaphores.data();
+        presentInfo.swapchainCount = presentCount;
+        presentInfo.pSwapchains = scratch.swapChains.data();
+        presentInfo.pImageIndices = scratch.imageIndices.data();
+        presentInfo.pResults = scratch.presentResults.data();
+
+        // present ids let the next frame wait until this one is on screen
+        VkPresentIdKHR presentIdInfo{};
+        presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        presentIdInfo.swapchainCount = presentCount;
+        presentIdInfo.pPresentIds = scratch.presentIds.data();
+
+        if (vkBackends->presentWaitSupported)
+            presentInfo.pNext = &presentIdInfo;
+
+        if (presentCount > 0)
+            vkQueuePresentKHR(vkBackends->presentQueue, &presentInfo);
+
+        for (uint32_t i = 0, presentIndex = 0; i < count; i++)
+        {
+            LvnWindow* window = submits[i].window;
+            VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+
+            if (surfaceData->headless)
+            {
+                surfaceData->currentFrame = (surfaceData->currentFrame + 1) % vkBackends->maxFramesInFlight;
+                vks::advanceRingRegion(vkBackends, window);
+                continue;
+            }
+
+            VkResult result = scratch.presentResults[presentIndex];
+
+            if (vkBackends->presentWaitSupported)
+                surfaceData->presentId = scratch.presentIds[presentIndex];
+            presentIndex++;
+
+            if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || surfaceData->frameBufferResized)
+            {
+                surfaceData->frameBufferResized = false;
+                vks::recreateSwapChain(vkBackends, window);
+            }
+            else
+            {
+                LVN_CORE_ASSERT(result == VK_SUCCESS, "[vulkan] failed to present swap chain image");
+            }
+
+            // advance to next frame in flight
+            surfaceData->currentFrame = (surfaceData->currentFrame + 1) % vkBackends->maxFramesInFlight;
+            vks::advanceRingRegion(vkBackends, window);
+        }
+    }
+
+    // buffer updates made between present and the next begin frame go to the regions of the frame recorded next, the same regions its
+    // begin frame binds, a frame still being recorded by another window keeps the regions it began with
+    static void advanceRingRegion(VulkanBackends* vkBackends, LvnWindow* window)
+    {
+        if (vkBackends->recordingFrame)
+            return;
+
+        vkBackends->currentFrame = static_cast<VulkanWindowSurfaceData*>(window->apiData)->currentFrame;
+        vkBackends->ringRegionWindow = window;
+    }
+
+    // the regions of the frame recorded next may still be read by the submission that last used them, it is waited on by the
+    // first buffer update made before the frame begins instead of at present so work done in between still overlaps the gpu
+    static void waitRingRegion(VulkanBackends* vkBackends)
+    {
+        LvnWindow* window = vkBackends->ringRegionWindow;
+        if (window == nullptr)
+            return;
+
+        vkBackends->ringRegionWindow = nullptr;
+
+        VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+        uint64_t waitSubmitIndex = surfaceData->inFlightSubmitIndices[surfaceData->currentFrame];
+        if (waitSubmitIndex <= vkBackends->completedSubmitIndex)
+            return;
+
+        if (surfaceData->frameTimeline != VK_NULL_HANDLE)
+        {
+            VkSemaphoreWaitInfo waitInfo{};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &surfaceData->frameTimeline;
+            waitInfo.pValues = &waitSubmitIndex;
+
+            vkWaitSemaphores(vkBackends->device, &waitInfo, UINT64_MAX);
+        }
+        else
+        {
+            vkWaitForFences(vkBackends->device, 1, &surfaceData->inFlightFences[surfaceData->currentFrame], VK_TRUE, UINT64_MAX);
+        }
+    }
+
+    static void deferDestroy(VulkanBackends* vkBackends, VkObjectType type, uint64_t handle, VmaAllocation memory)
+    {
+        std::lock_guard<std::mutex> lock(s_DeletionMutex);
+
+        // the frame currently being recorded may still reference the object, so wait for the next submission to retire
+        VulkanDeferredDeletion deletion{};
+        deletion.type = type;
+        deletion.handle = handle;
+        deletion.memory = memory;
+        deletion.submitIndex = vkBackends->submitIndex + 1;
+        vkBackends->deletionQueue.push_back(deletion);
+    }
+
+    // pooled buffer ranges are returned to their block once the frames that used them retire
+    static void deferFreeBufferRange(VulkanBackends* vkBackends, VulkanBufferPoolBlock* block, VmaVirtualAllocation allocation)
+    {
+        std::lock_guard<std::mutex> lock(s_DeletionMutex);
+
+        VulkanDeferredDeletion deletion{};
+        deletion.type = VK_OBJECT_TYPE_UNKNOWN;
+        deletion.handle = (uint64_t)allocation;
+        deletion.poolBlock = block;
+        deletion.submitIndex = vkBackends->submitIndex + 1;
+        vkBackends->deletionQueue.push_back(deletion);
+    }
+
+    static void releaseDeferredDeletions(VulkanBackends* vkBackends, bool all)
+    {
+        std::lock_guard<std::mutex> lock(s_DeletionMutex);
+
+        LvnVector<VulkanDeferredDeletion>& deletionQueue = vkBackends->deletionQueue;
+        for (uint32_t i = 0; i < deletionQueue.size();)
+        {
+            const VulkanDeferredDeletion& deletion = deletionQueue[i];
+
+            if (!all && deletion.submitIndex > vkBackends->completedSubmitIndex)
+            {
+                i++;
+                continue;
+            }
+
+            switch (deletion.type)
+            {
+                case VK_OBJECT_TYPE_BUFFER: { vkDestroyBuffer(vkBackends->device, (VkBuffer)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_IMAGE: { vkDestroyImage(vkBackends->device, (VkImage)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_IMAGE_VIEW: { vkDestroyImageView(vkBackends->device, (VkImageView)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_SAMPLER: { vkDestroySampler(vkBackends->device, (VkSampler)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_PIPELINE: { vkDestroyPipeline(vkBackends->device, (VkPipeline)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_PIPELINE_LAYOUT: { vkDestroyPipelineLayout(vkBackends->device, (VkPipelineLayout)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_RENDER_PASS: { vkDestroyRenderPass(vkBackends->device, (VkRenderPass)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_FRAMEBUFFER: { vkDestroyFramebuffer(vkBackends->device, (VkFramebuffer)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_DESCRIPTOR_POOL: { vkDestroyDescriptorPool(vkBackends->device, (VkDescriptorPool)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT: { vkDestroyDescriptorSetLayout(vkBackends->device, (VkDescriptorSetLayout)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_SEMAPHORE: { vkDestroySemaphore(vkBackends->device, (VkSemaphore)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_SWAPCHAIN_KHR: { vkDestroySwapchainKHR(vkBackends->device, (VkSwapchainKHR)deletion.handle, nullptr); break; }
+                case VK_OBJECT_TYPE_UNKNOWN: { vks::freeBufferRange(vkBackends, deletion.poolBlock, (VmaVirtualAllocation)deletion.handle); break; }
+                default: { LVN_CORE_ERROR("[vulkan] unknown object type (%u) in deferred deletion queue", deletion.type); break; }
+            }
+
+            if (deletion.memory)
+                vmaFreeMemory(vkBackends->vmaAllocator, deletion.memory);
+
+            deletionQueue.erase_index(i);
+        }
+    }
+
+    static void writeDescriptorUpdates(VulkanBackends* vkBackends, const VulkanDescriptorUpdate* pUpdates, uint32_t count)
+    {
+        if (count == 0) { return; }
+
+        // every write goes to the driver in a single call
+        LvnVector<VkWriteDescriptorSet> descriptorWrites(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const VulkanDescriptorUpdate& update = pUpdates[i];
+
+            VkWriteDescriptorSet& descriptorWrite = descriptorWrites[i];
+            descriptorWrite = {};
+            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrite.dstSet = update.descriptorSet;
+            descriptorWrite.dstBinding = update.binding;
+            descriptorWrite.dstArrayElement = 0;
+            descriptorWrite.descriptorType = update.descriptorType;
+            descriptorWrite.descriptorCount = update.descriptorCount;
+
+            if (update.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || update.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || update.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                descriptorWrite.pBufferInfo = &update.bufferInfo;
+            else if (update.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+                descriptorWrite.pImageInfo = update.imageInfos.data();
+        }
+
+        vkUpdateDescriptorSets(vkBackends->device, count, descriptorWrites.data(), 0, nullptr);
+    }
+
+    static void applyPendingDescriptorUpdates(VulkanBackends* vkBackends, uint32_t frameIndex)
+    {
+        std::lock_guard<std::mutex> lock(s_DeletionMutex);
+
+        LvnVector<VulkanDescriptorUpdate>& updates = vkBackends->pendingDescriptorUpdates[frameIndex];
+        vks::writeDescriptorUpdates(vkBackends, updates.data(), updates.size());
+
+        updates.clear();
+    }
+
+    static VkDescriptorBufferInfo getDescriptorBufferInfo(const LvnUniformBufferInfo* bufferInfo, uint32_t frame)
+    {
+        const LvnBuffer* infoBuffer = bufferInfo->buffer;
+
+        VkDescriptorBufferInfo descriptorBufferInfo{};
+        descriptorBufferInfo.buffer = static_cast<VkBuffer>(infoBuffer->buffer);
+        descriptorBufferInfo.offset = infoBuffer->baseOffset + bufferInfo->offset + infoBuffer->regionSize * frame; // offset to the ring buffer region of each frame in flight
+        descriptorBufferInfo.range = bufferInfo->range;
+
+        // the whole size of a pooled buffer would reach past its range to the end of the pool block
+        if (infoBuffer->poolBlock != nullptr && descriptorBufferInfo.range == VK_WHOLE_SIZE)
+            descriptorBufferInfo.range = infoBuffer->size - bufferInfo->offset;
+
+        return descriptorBufferInfo;
+    }
+
+    static void getDescriptorUpdate(const LvnDescriptorSet* descriptorSet, const LvnDescriptorUpdateInfo* updateInfo, uint32_t frame, VulkanDescriptorUpdate* update)
+    {
+        update->descriptorSet = static_cast<VkDescriptorSet>(descriptorSet->descriptorSets[frame]);
+        update->descriptorPool = static_cast<VkDescriptorPool>(descriptorSet->descriptorPool);
+        update->binding = updateInfo->binding;
+        update->descriptorType = vks::getDescriptorTypeEnum(updateInfo->descriptorType);
+        update->descriptorCount = updateInfo->descriptorCount;
+
+        if (updateInfo->descriptorType == Lvn_DescriptorType_UniformBuffer || updateInfo->descriptorType == Lvn_DescriptorType_UniformBufferDynamic || updateInfo->descriptorType == Lvn_DescriptorType_StorageBuffer)
+            update->bufferInfo = vks::getDescriptorBufferInfo(updateInfo->bufferInfo, frame);
+
+        if (updateInfo->descriptorType == Lvn_DescriptorType_ImageSampler || updateInfo->descriptorType == Lvn_DescriptorType_ImageSamplerBindless)
+        {
+            update->imageInfos.resize(updateInfo->descriptorCount);
+            for (uint32_t i = 0; i < updateInfo->descriptorCount; i++)
+            {
+                update->imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                update->imageInfos[i].imageView = static_cast<VkImageView>(updateInfo->pTextureInfos[i]->imageView);
+                update->imageInfos[i].sampler = static_cast<VkSampler>(updateInfo->pTextureInfos[i]->sampler);
+            }
+        }
+    }
+
+    static void createDescriptorUpdateTemplate(VulkanBackends* vkBackends, VkDescriptorSetLayout descriptorLayout, const LvnVector<VkDescriptorSetLayoutBinding>& layoutBindings, VulkanDescriptorUpdateTemplate* updateTemplate)
+    {
+        updateTemplate->updateTemplate = VK_NULL_HANDLE;
+        updateTemplate->dataSize = 0;
+
+        for (uint32_t i = 0; i < layoutBindings.size(); i++)
+        {
+            const VkDescriptorSetLayoutBinding& binding = layoutBindings[i];
+            bool imageBinding = binding.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+            // update infos hold one buffer, bindings without descriptors or with buffer arrays are only written without the template
+            if (binding.descriptorCount == 0 || (!imageBinding && binding.descriptorCount != 1))
+            {
+                updateTemplate->entries.clear();
+                return;
+            }
+
+            VkDescriptorUpdateTemplateEntry entry{};
+            entry.dstBinding = binding.binding;
+            entry.dstArrayElement = 0;
+            entry.descriptorCount = binding.descriptorCount;
+            entry.descriptorType = binding.descriptorType;
+            entry.offset = updateTemplate->dataSize;
+            entry.stride = imageBinding ? sizeof(VkDescriptorImageInfo) : sizeof(VkDescriptorBufferInfo);
+
+            updateTemplate->entries.push_back(entry);
+            updateTemplate->dataSize += entry.stride * entry.descriptorCount;
+        }
+
+        if (updateTemplate->entries.empty()) { return; }
+
+        VkDescriptorUpdateTemplateCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        createInfo.descriptorUpdateEntryCount = updateTemplate->entries.size();
+        createInfo.pDescriptorUpdateEntries = updateTemplate->entries.data();
+        createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        createInfo.descriptorSetLayout = descriptorLayout;
+
+        if (vkCreateDescriptorUpdateTemplate(vkBackends->device, &createInfo, nullptr, &updateTemplate->updateTemplate) != VK_SUCCESS)
+        {
+            LVN_CORE_WARN("[vulkan] failed to create descriptor update template for descriptor set layout (%p), descriptor sets are written without it", descriptorLayout);
+            updateTemplate->updateTemplate = VK_NULL_HANDLE;
+            updateTemplate->entries.clear();
+            updateTemplate->dataSize = 0;
+        }
+    }
+
+    static bool descriptorUpdateCoversTemplate(const VulkanDescriptorUpdateTemplate* updateTemplate, const LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count)
+    {
+        // the template is only used when every binding is written in layout order with all of its descriptors
+        if (count != updateTemplate->entries.size()) { return false; }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const VkDescriptorUpdateTemplateEntry& entry = updateTemplate->entries[i];
+            if (entry.dstBinding != pUpdateInfo[i].binding || entry.descriptorCount != pUpdateInfo[i].descriptorCount || entry.descriptorType != vks::getDescriptorTypeEnum(pUpdateInfo[i].descriptorType))
+                return false;
+        }
+
+        return true;
+    }
+
+    static void fillDescriptorTemplateData(const VulkanDescriptorUpdateTemplate* updateTemplate, const LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t frame, uint8_t* data)
+    {
+        for (uint32_t i = 0; i < updateTemplate->entries.size(); i++)
+        {
+            const VkDescriptorUpdateTemplateEntry& entry = updateTemplate->entries[i];
+
+            if (entry.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+            {
+                VkDescriptorImageInfo* imageInfos = reinterpret_cast<VkDescriptorImageInfo*>(data + entry.offset);
+                for (uint32_t j = 0; j < entry.descriptorCount; j++)
+                {
+                    imageInfos[j].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                    imageInfos[j].imageView = static_cast<VkImageView>(pUpdateInfo[i].pTextureInfos[j]->imageView);
+                    imageInfos[j].sampler = static_cast<VkSampler>(pUpdateInfo[i].pTextureInfos[j]->sampler);
+                }
+            }
+            else
+            {
+                VkDescriptorBufferInfo* bufferInfo = reinterpret_cast<VkDescriptorBufferInfo*>(data + entry.offset);
+                *bufferInfo = vks::getDescriptorBufferInfo(pUpdateInfo[i].bufferInfo, frame);
+            }
+        }
+    }
+
+    static void updateDescriptorSet(VulkanBackends* vkBackends, LvnDescriptorSet* descriptorSet, const LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count)
+    {
+        const VulkanDescriptorUpdateTemplate* updateTemplate = static_cast<const VulkanDescriptorUpdateTemplate*>(descriptorSet->updateTemplate);
+        bool useTemplate = updateTemplate != nullptr && vks::descriptorUpdateCoversTemplate(updateTemplate, pUpdateInfo, count);
+
+        for (uint32_t i = 0; i < vkBackends->maxFramesInFlight; i++)
+        {
+            // transient sets share one set across the frames in flight and are only used by the frame being recorded
+            if (descriptorSet->transient && i != vkBackends->currentFrame)
+                continue;
+
+            // sets of frames still executing on the gpu are written once their frame comes around again,
+            // the set of the frame being recorded (or every set before the first submit) can be written now
+            bool frameIdle = descriptorSet->transient || vkBackends->submitIndex == 0 || (vkBackends->recordingFrame && i == vkBackends->currentFrame);
+
+            if (frameIdle && useTemplate)
+            {
+                vkBackends->descriptorTemplateData.resize(updateTemplate->dataSize);
+                vks::fillDescriptorTemplateData(updateTemplate, pUpdateInfo, i, vkBackends->descriptorTemplateData.data());
+                vkUpdateDescriptorSetWithTemplate(vkBackends->device, static_cast<VkDescriptorSet>(descriptorSet->descriptorSets[i]), updateTemplate->updateTemplate, vkBackends->descriptorTemplateData.data());
+                continue;
+            }
+
+            // idle writes are collected and written together by the caller
+            LvnVector<VulkanDescriptorUpdate>& updates = frameIdle ? vkBackends->descriptorWrites : vkBackends->pendingDescriptorUpdates[i];
+            for (uint32_t j = 0; j < count; j++)
+            {
+                VulkanDescriptorUpdate update{};
+                vks::getDescriptorUpdate(descriptorSet, &pUpdateInfo[j], i, &update);
+                updates.push_back(update);
+            }
+        }
+    }
+
+    static LvnResult createDescriptorPool(VulkanBackends* vkBackends, const VulkanDescriptorAllocator* allocator, uint32_t maxSets, VulkanDescriptorPool* descriptorPool)
+    {
+        LvnVector<VkDescriptorPoolSize> poolSizes(allocator->setSizes.size());
+        for (uint32_t i = 0; i < poolSizes.size(); i++)
+        {
+            poolSizes[i].type = allocator->setSizes[i].type;
+            poolSizes[i].descriptorCount = allocator->setSizes[i].descriptorCount * maxSets;
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = poolSizes.size();
+        poolInfo.pPoolSizes = poolSizes.data();
+        poolInfo.maxSets = maxSets;
+
+        *descriptorPool = VulkanDescriptorPool{};
+        if (vkCreateDescriptorPool(vkBackends->device, &poolInfo, nullptr, &descriptorPool->pool) != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create descriptor pool <VkDescriptorPool> for %u sets", maxSets);
+            return Lvn_Result_Failure;
+        }
+
+        descriptorPool->maxSets = maxSets;
+        return Lvn_Result_Success;
+    }
+
+    static VkResult allocateFromDescriptorPool(VulkanBackends* vkBackends, VulkanDescriptorPool* descriptorPool, VkDescriptorSetLayout descriptorLayout, uint32_t count, VkDescriptorSet* pDescriptorSets)
+    {
+        if (descriptorPool->allocatedSets + count > descriptorPool->maxSets)
+            return VK_ERROR_OUT_OF_POOL_MEMORY;
+
+        LvnVector<VkDescriptorSetLayout> layouts(count, descriptorLayout);
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool->pool;
+        allocInfo.descriptorSetCount = count;
+        allocInfo.pSetLayouts = layouts.data();
+
+        VkResult result = vkAllocateDescriptorSets(vkBackends->device, &allocInfo, pDescriptorSets);
+        if (result == VK_SUCCESS)
+            descriptorPool->allocatedSets += count;
+        else if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+            descriptorPool->allocatedSets = descriptorPool->maxSets; // the pool ran out of descriptors before sets, treat it as full
+
+        return result;
+    }
+
+    static uint32_t getNextDescriptorPoolSize(const LvnVector<VulkanDescriptorPool>& pools, uint32_t minSets)
+    {
+        uint32_t maxSets = pools.empty() ? LVN_VULKAN_DESCRIPTOR_POOL_INITIAL_SETS : lvn::min(pools.back().maxSets * 2, (uint32_t)LVN_VULKAN_DESCRIPTOR_POOL_MAX_SETS);
+        return lvn::max(maxSets, minSets);
+    }
+
+    static VulkanThreadCommandPool* getThreadCommandPool(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
+    {
+        // called with s_SecondaryCommandMutex locked
+        std::thread::id threadId = std::this_thread::get_id();
+        for (VulkanThreadCommandPool& threadPool : surfaceData->threadCommandPools)
+        {
+            if (threadPool.threadId == threadId)
+                return &threadPool;
+        }
+
+        // command pools are externally synchronized, each recording thread gets its own pool per frame in flight
+        VulkanThreadCommandPool threadPool{};
+        threadPool.threadId = threadId;
+        threadPool.commandPools.resize(vkBackends->maxFramesInFlight);
+        threadPool.commandBuffers.resize(vkBackends->maxFramesInFlight);
+        threadPool.usedCounts.resize(vkBackends->maxFramesInFlight, 0);
+
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = vkBackends->deviceIndices.graphicsIndex;
+
+        for (uint32_t i = 0; i < vkBackends->maxFramesInFlight; i++)
+        {
+            if (vkCreateCommandPool(vkBackends->device, &poolInfo, nullptr, &threadPool.commandPools[i]) != VK_SUCCESS)
+            {
+                LVN_CORE_ERROR("[vulkan] failed to create thread command pool <VkCommandPool> for secondary command buffers");
+                for (uint32_t j = 0; j < i; j++)
+                    vkDestroyCommandPool(vkBackends->device, threadPool.commandPools[j], nullptr);
+                return nullptr;
+            }
+        }
+
+        surfaceData->threadCommandPools.push_back(threadPool);
+        return &surfaceData->threadCommandPools.back();
+    }
+
+    static void resetThreadCommandPools(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, uint32_t frameIndex)
+    {
+        std::lock_guard<std::mutex> lock(s_SecondaryCommandMutex);
+
+        // the frame has retired, every secondary command buffer recorded for it can be reused
+        for (VulkanThreadCommandPool& threadPool : surfaceData->threadCommandPools)
+        {
+            if (threadPool.usedCounts[frameIndex] == 0)
+                continue;
+
+            vkResetCommandPool(vkBackends->device, threadPool.commandPools[frameIndex], 0);
+            threadPool.usedCounts[frameIndex] = 0;
+        }
+
+        if (!surfaceData->secondaryCommandBuffers.empty())
+        {
+            LVN_CORE_WARN("[vulkan] %zu secondary command buffer(s) were never executed, the pass they continue was not begun in the frame they were recorded for", (size_t)surfaceData->secondaryCommandBuffers.size());
+            surfaceData->secondaryCommandBuffers.clear();
+        }
+    }
+
+    static void destroyThreadCommandPools(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData)
+    {
+        std::lock_guard<std::mutex> lock(s_SecondaryCommandMutex);
+
+        for (VulkanThreadCommandPool& threadPool : surfaceData->threadCommandPools)
+        {
+            for (VkCommandPool commandPool : threadPool.commandPools)
+                vkDestroyCommandPool(vkBackends->device, commandPool, nullptr);
+        }
+
+        surfaceData->threadCommandPools.clear_free();
+        surfaceData->secondaryCommandBuffers.clear_free();
+    }
+
+    static VkCommandBuffer getRecordingCommandBuffer(LvnWindow* window, VulkanWindowSurfaceData* surfaceData)
+    {
+        if (s_SecondaryRecording.window == window)
+            return s_SecondaryRecording.commandBuffer;
+
+        return surfaceData->commandBuffers[surfaceData->currentFrame];
+    }
+
+    static bool executeSecondaryCommandBuffers(VulkanWindowSurfaceData* surfaceData, LvnFrameBuffer* frameBuffer, const VkRenderPassBeginInfo* renderPassInfo)
+    {
+        VulkanBackends* vkBackends = s_VkBackends;
+        VkCommandBuffer primary = surfaceData->commandBuffers[surfaceData->currentFrame];
+        LvnVector<VkCommandBuffer> commandBuffers;
+
+        {
+            std::lock_guard<std::mutex> lock(s_SecondaryCommandMutex);
+
+            LvnVector<VulkanSecondaryCommandBuffer>& pending = surfaceData->secondaryCommandBuffers;
+            uint32_t remaining = 0;
+            for (uint32_t i = 0; i < pending.size(); i++)
+            {
+                if (pending[i].frameBuffer == frameBuffer)
+                    commandBuffers.push_back(pending[i].commandBuffer);
+                else
+                    pending[remaining++] = pending[i];
+            }
+            pending.resize(remaining);
+        }
+
+        if (commandBuffers.empty())
+            return false;
+
+        // a pass with secondary contents can only execute command buffers, the pass runs what the workers recorded in the order they finished
+        VulkanFrameBufferData* frameBufferData = frameBuffer ? static_cast<VulkanFrameBufferData*>(frameBuffer->frameBufferData) : nullptr;
+        if (frameBufferData && frameBufferData->dynamicRendering)
+        {
+            VkRenderingInfoKHR renderingInfo = vks::getRenderingInfo(frameBufferData, { frameBuffer->renderWidth, frameBuffer->renderHeight }, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR);
+            vks::transitionRenderingAttachments(primary, frameBufferData, true);
+            vkBackends->beginRenderingFn(primary, &renderingInfo);
+        }
+        else
+            vkCmdBeginRenderPass(primary, renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+        vkCmdExecuteCommands(primary, commandBuffers.size(), commandBuffers.data());
+        return true;
+    }
+
+    static bool readBinaryFile(const char* filepath, LvnVector<uint8_t>& data)
+    {
+        // unlike lvn::loadFileSrcBin, a missing file is not reported since cache files are expected to be missing on first launch
+        FILE* fileptr = fopen(filepath, "rb");
+        if (!fileptr)
+            return false;
+
+        fseek(fileptr, 0, SEEK_END);
+        long int size = ftell(fileptr);
+        fseek(fileptr, 0, SEEK_SET);
+
+        data.resize(size > 0 ? size : 0);
+        bool success = size > 0 && fread(data.data(), sizeof(uint8_t), size, fileptr) == (size_t)size;
+        fclose(fileptr);
+
+        if (!success)
+            data.clear();
+
+        return success;
+    }
+
+    static bool writeBinaryFile(const char* filepath, const uint8_t* data, size_t size)
+    {
+        FILE* fileptr = fopen(filepath, "wb");
+        if (!fileptr)
+            return false;
+
+        bool success = fwrite(data, sizeof(uint8_t), size, fileptr) == size;
+        fclose(fileptr);
+
+        return success;
+    }
+
+    static void createPipelineCache(VulkanBackends* vkBackends)
+    {
+        LvnVector<uint8_t> cacheData;
+
+        if (!vkBackends->pipelineCachePath.empty())
+        {
+            vks::readBinaryFile(vkBackends->pipelineCachePath.c_str(), cacheData);
+
+            // discard cache data written by a different device or driver
+            if (!cacheData.empty())
+            {
+                VkPipelineCacheHeaderVersionOne header{};
+                bool valid = cacheData.size() >= sizeof(header);
+
+                if (valid)
+                {
+                    memcpy(&header, cacheData.data(), sizeof(header));
+                    valid = header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+                        header.vendorID == vkBackends->deviceProperties.vendorID &&
+                        header.deviceID == vkBackends->deviceProperties.deviceID &&
+                        memcmp(header.pipelineCacheUUID, vkBackends->deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+                }
+
+                if (!valid)
+                {
+                    LVN_CORE_WARN("[vulkan] pipeline cache file \"%s\" does not match the current device, creating an empty pipeline cache", vkBackends->pipelineCachePath.c_str());
+                    cacheData.clear();
+                }
+            }
+        }
+
+        VkPipelineCacheCreateInfo cacheInfo{};
+        cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        cacheInfo.initialDataSize = cacheData.size();
+        cacheInfo.pInitialData = cacheData.data();
+
+        if (vkCreatePipelineCache(vkBackends->device, &cacheInfo, nullptr, &vkBackends->pipelineCache) != VK_SUCCESS)
+        {
+            // pipelines still work without a cache
+            LVN_CORE_WARN("[vulkan] failed to create pipeline cache <VkPipelineCache>, pipelines will be built without a cache");
+            vkBackends->pipelineCache = VK_NULL_HANDLE;
+        }
+    }
+
+    static void destroyPipelineCache(VulkanBackends* vkBackends)
+    {
+        if (vkBackends->pipelineCache == VK_NULL_HANDLE)
+            return;
+
+        if (!vkBackends->pipelineCachePath.empty())
+        {
+            size_t size = 0;
+            vkGetPipelineCacheData(vkBackends->device, vkBackends->pipelineCache, &size, nullptr);
+
+            LvnVector<uint8_t> cacheData(size);
+            if (size > 0 && vkGetPipelineCacheData(vkBackends->device, vkBackends->pipelineCache, &size, cacheData.data()) == VK_SUCCESS)
+            {
+                if (!vks::writeBinaryFile(vkBackends->pipelineCachePath.c_str(), cacheData.data(), size))
+                    LVN_CORE_ERROR("[vulkan] cannot write pipeline cache file: %s", vkBackends->pipelineCachePath.c_str());
+            }
+        }
+
+        vkDestroyPipelineCache(vkBackends->device, vkBackends->pipelineCache, nullptr);
+        vkBackends->pipelineCache = VK_NULL_HANDLE;
+    }
+
+    static LvnResult createImage(VulkanBackends* vkBackends, VkImage* image, VmaAllocation* imageMemory, uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkSampleCountFlagBits samples, VmaMemoryUsage memUsage)
+    {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = width;
+        imageInfo.extent.height = height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = mipLevels;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = tiling;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = usage;
+        imageInfo.samples = samples;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = memUsage;
+
+        VkResult result = vmaCreateImage(vkBackends->vmaAllocator, &imageInfo, &allocInfo, image, imageMemory, nullptr);
+
+        // most desktop gpus have no lazily allocated memory, transient attachments then use regular device memory
+        if (result != VK_SUCCESS && memUsage == VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED)
+        {
+            allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+            result = vmaCreateImage(vkBackends->vmaAllocator, &imageInfo, &allocInfo, image, imageMemory, nullptr);
+        }
+
+        if (result != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create image <VkImage>, image size: (w:%u, h:%u)", width, height);
+            return Lvn_Result_Failure;
+        }
+
+        return Lvn_Result_Success;
+    }
+
+    static void transitionImageLayout(VulkanBackends* vkBackends, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t layerCount, uint32_t mipLevels)
+    {
+        std::lock_guard<std::mutex> lock(s_UploadMutex);
+        VkCommandBuffer commandBuffer = vks::beginUploadCommands(vkBackends);
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = mipLevels;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = layerCount;
+
+        if (newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
+        {
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+            if (vks::hasStencilComponent(format))
+                barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+        }
+        else
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+        VkPipelineStageFlags sourceStage;
+        VkPipelineStageFlags destinationStage;
+
+        if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+        {
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+            destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        }
+        else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+        {
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        }
+        else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
+        {
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+            sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+            destinationStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        } 
+        else
+        {
+            LVN_CORE_ASSERT(false, "[vulkan] unsupported layout transition during image layout transition");
+        }
+
+        vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    static void copyBufferToImage(VulkanBackends* vkBackends, VkBuffer buffer, VkDeviceSize bufferOffset, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevel, uint32_t layerCount)
+    {
+        std::lock_guard<std::mutex> lock(s_UploadMutex);
+        VkCommandBuffer commandBuffer = vks::beginUploadCommands(vkBackends);
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = bufferOffset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = mipLevel;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = layerCount;
+
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = { width, height, 1 };
+
+        vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+
+    static void generateMipmaps(VulkanBackends* vkBackends, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount)
+    {
+        // expects every mip level in transfer dst layout with level 0 filled, leaves every level in shader read layout
+        std::lock_guard<std::mutex> lock(s_UploadMutex);
+        VkCommandBuffer commandBuffer = vks::beginUploadCommands(vkBackends);
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = layerCount;
+
+        int32_t mipWidth = width;
+        int32_t mipHeight = height;
+
+        for (uint32_t i = 1; i < mipLevels; i++)
+        {
+            // previous level becomes the blit source
+            barrier.subresourceRange.baseMipLevel = i - 1;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            int32_t nextWidth = mipWidth > 1 ? mipWidth / 2 : 1;
+            int32_t nextHeight = mipHeight > 1 ? mipHeight / 2 : 1;
+
+            VkImageBlit blit{};
+            blit.srcOffsets[0] = { 0, 0, 0 };
+            blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
+            blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.srcSubresource.mipLevel = i - 1;
+            blit.srcSubresource.baseArrayLayer = 0;
+            blit.srcSubresource.layerCount = layerCount;
+            blit.dstOffsets[0] = { 0, 0, 0 };
+            blit.dstOffsets[1] = { nextWidth, nextHeight, 1 };
+            blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.dstSubresource.mipLevel = i;
+            blit.dstSubresource.baseArrayLayer = 0;
+            blit.dstSubresource.layerCount = layerCount;
+
+            vkCmdBlitImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+            // previous level is done, move it to shader read
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            mipWidth = nextWidth;
+            mipHeight = nextHeight;
+        }
+
+        // last level was only written to
+        barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    static void cmdImageBarrier(VkCommandBuffer commandBuffer, VkImage image, uint32_t baseMipLevel, uint32_t mipLevels, uint32_t layerCount, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage)
+    {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstAccessMask = dstAccess;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = baseMipLevel;
+        barrier.subresourceRange.levelCount = mipLevels;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = layerCount;
+
+        vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    static uint32_t getColorFormatPixelSize(VkFormat format)
+    {
+        switch (format)
+        {
+            case VK_FORMAT_R8_SINT: { return 1; }
+            case VK_FORMAT_R8G8B8_UNORM: { return 3; }
+            case VK_FORMAT_R8G8B8_SRGB: { return 3; }
+            case VK_FORMAT_R8G8B8A8_UNORM: { return 4; }
+            case VK_FORMAT_R8G8B8A8_SRGB: { return 4; }
+            case VK_FORMAT_B8G8R8A8_UNORM: { return 4; }
+            case VK_FORMAT_B8G8R8A8_SRGB: { return 4; }
+            case VK_FORMAT_R16G16B16A16_SFLOAT: { return 8; }
+            case VK_FORMAT_R32G32B32A32_SFLOAT: { return 16; }
+
+            default: { return 0; }
+        }
+    }
+
+    // copies a color image into host memory and waits for the copy, the image is returned to its layout afterwards
+    // the copy is recorded into the upload batch, which reaches the queue after every frame already submitted so it sees their writes
+    static LvnResult readImagePixels(VulkanBackends* vkBackends, VkImage image, VkImageLayout layout, uint32_t width, uint32_t height, uint32_t pixelSize, void* data)
+    {
+        VkDeviceSize size = static_cast<VkDeviceSize>(width) * height * pixelSize;
+
+        VkBuffer readbackBuffer;
+        VmaAllocation readbackMemory;
+        if (vks::createBuffer(vkBackends, &readbackBuffer, &readbackMemory, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU) != Lvn_Result_Success)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create readback buffer <VkBuffer> of %zu bytes when reading image pixels", size);
+            return Lvn_Result_Failure;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s_UploadMutex);
+            VkCommandBuffer commandBuffer = vks::beginUploadCommands(vkBackends);
+
+            vks::cmdImageBarrier(commandBuffer, image, 0, 1, 1, layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+            VkBufferImageCopy region{};
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = { width, height, 1 };
+            vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer, 1, &region);
+
+            // later frames may render to the image again, they wait for the copy to finish reading it
+            vks::cmdImageBarrier(commandBuffer, image, 0, 1, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, layout,
+                VK_ACCESS_TRANSFER_READ_BIT, 0,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+
+            // frames held by an open submit batch of this thread are sent first, the copy reads what they rendered
+            VulkanSubmitBatch& batch = s_SubmitBatch;
+            if (!batch.submits.empty())
+            {
+                vks::submitFrames(vkBackends, batch.submits.data(), batch.submits.size());
+                batch.submits.clear();
+            }
+
+            vks::submitUploadCommands(vkBackends, true);
+        }
+
+        void* mappedData;
+        vmaMapMemory(vkBackends->vmaAllocator, readbackMemory, &mappedData);
+        vmaInvalidateAllocation(vkBackends->vmaAllocator, readbackMemory, 0, VK_WHOLE_SIZE);
+        memcpy(data, mappedData, size);
+        vmaUnmapMemory(vkBackends->vmaAllocator, readbackMemory);
+
+        vkDestroyBuffer(vkBackends->device, readbackBuffer, nullptr);
+        vmaFreeMemory(vkBackends->vmaAllocator, readbackMemory);
+
+        return Lvn_Result_Success;
+    }
+
+    // buffers are reused by later readbacks of the same or a smaller size, captures of one framebuffer every frame allocate only once
+    static bool acquireReadbackBuffer(VulkanBackends* vkBackends, VkDeviceSize size, VulkanReadbackBuffer* readbackBuffer)
+    {
+        {
+            std::lock_guard<std::mutex> lock(vkBackends->readbackMutex);
+            for (uint32_t i = 0; i < vkBackends->readbackBuffers.size(); i++)
+            {
+                if (vkBackends->readbackBuffers[i].size < size) { continue; }
+
+                *readbackBuffer = vkBackends->readbackBuffers[i];
+                vkBackends->readbackBuffers.erase_index(i);
+                return true;
+            }
+        }
+
+        if (vks::createBuffer(vkBackends, &readbackBuffer->buffer, &readbackBuffer->memory, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU) != Lvn_Result_Success)
+            return false;
+
+        readbackBuffer->size = size;
+        vmaMapMemory(vkBackends->vmaAllocator, readbackBuffer->memory, &readbackBuffer->mappedData);
+        return true;
+    }
+
+    static void releaseReadbackBuffer(VulkanBackends* vkBackends, const VulkanReadbackBuffer& readbackBuffer)
+    {
+        std::lock_guard<std::mutex> lock(vkBackends->readbackMutex);
+        vkBackends->readbackBuffers.push_back(readbackBuffer);
+    }
+
+    static void destroyReadbackBuffers(VulkanBackends* vkBackends)
+    {
+        // callbacks still running return their buffers to the pool first
+        lvn::jobWait(&vkBackends->readbackJobs);
+
+        for (uint32_t i = 0; i < vkBackends->readbackBuffers.size(); i++)
+        {
+            vmaUnmapMemory(vkBackends->vmaAllocator, vkBackends->readbackBuffers[i].memory);
+            vkDestroyBuffer(vkBackends->device, vkBackends->readbackBuffers[i].buffer, nullptr);
+            vmaFreeMemory(vkBackends->vmaAllocator, vkBackends->readbackBuffers[i].memory);
+        }
+        vkBackends->readbackBuffers.clear();
+    }
+
+    static void readbackJob(void* userData)
+    {
+        VulkanBackends* vkBackends = s_VkBackends;
+        VulkanReadback* readback = static_cast<VulkanReadback*>(userData);
+
+        vmaInvalidateAllocation(vkBackends->vmaAllocator, readback->buffer.memory, 0, readback->data.size);
+        readback->data.pixels = readback->buffer.mappedData;
+        readback->func(&readback->data, readback->userData);
+
+        vks::releaseReadbackBuffer(vkBackends, readback->buffer);
+        lvn::memDelete(readback);
+    }
+
+    // copies of the frame just waited on are finished, their callbacks are handed to the workers so encoding never runs on the render thread
+    static void completeReadbacks(VulkanBackends* vkBackends, VulkanWindowSurfaceData* surfaceData, uint32_t frame, bool all)
+    {
+        LvnVector<VulkanReadback*>& pending = surfaceData->pendingReadbacks;
+
+        uint32_t remaining = 0;
+        for (uint32_t i = 0; i < pending.size(); i++)
+        {
+            if (!all && pending[i]->frame != frame)
+            {
+                pending[remaining++] = pending[i];
+                continue;
+            }
+
+            lvn::jobSubmit(vks::readbackJob, pending[i], &vkBackends->readbackJobs);
+        }
+        pending.resize(remaining);
+    }
+
+    static LvnResult createEnvironmentMapTexture(VulkanBackends* vkBackends, LvnTexture* texture, uint32_t size, uint32_t mipLevels, uint32_t layerCount)
+    {
+        VkFormat format = LVN_VULKAN_ENVIRONMENT_MAP_FORMAT;
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = size;
+        imageInfo.extent.height = size;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = mipLevels;
+        imageInfo.arrayLayers = layerCount;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.flags = layerCount == 6 ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        VkImage image;
+        VmaAllocation imageMemory;
+        if (vmaCreateImage(vkBackends->vmaAllocator, &imageInfo, &allocInfo, &image, &imageMemory, nullptr) != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create environment map image <VkImage>, image size: (w:%u, h:%u)", size, size);
+            return Lvn_Result_Failure;
+        }
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = layerCount == 6 ? VK_IMAGE_VIEW_TYPE_CUBE : VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = mipLevels;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = layerCount;
+
+        VkImageView imageView;
+        if (vkCreateImageView(vkBackends->device, &viewInfo, nullptr, &imageView) != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create environment map image view <VkImageView>");
+            vmaDestroyImage(vkBackends->vmaAllocator, image, imageMemory);
+            return Lvn_Result_Failure;
+        }
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+        samplerInfo.minLod = 0.0f;
+        samplerInfo.maxLod = static_cast<float>(mipLevels);
+        samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+        samplerInfo.maxAnisotropy = 1.0f;
+
+        VkSampler sampler;
+        if (vkCreateSampler(vkBackends->device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create environment map sampler <VkSampler>");
+            vkDestroyImageView(vkBackends->device, imageView, nullptr);
+            vmaDestroyImage(vkBackends->vmaAllocator, image, imageMemory);
+            return Lvn_Result_Failure;
+        }
+
+        vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Texture, imageMemory, true);
+
+        *texture = LvnTexture{};
+        texture->image = image;
+        texture->imageMemory = imageMemory;
+        texture->imageView = imageView;
+        texture->sampler = sampler;
+        texture->width = size;
+        texture->height = size;
+        texture->channels = 4;
+        texture->mipLevels = mipLevels;
+
+        return Lvn_Result_Success;
+    }
+
+    static void addEnvironmentMapPass(VulkanBackends* vkBackends, LvnVector<VulkanEnvironmentMapPass>* passes, VkPipeline pipeline, VkImageView srcView, VkSampler srcSampler, const LvnTexture* dst, uint32_t mipLevel, uint32_t layerCount, float roughness)
+    {
+        // storage images cannot be cube views, cubemap levels are written through a 2d array view of their six faces
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = static_cast<VkImage>(dst->image);
+        viewInfo.viewType = layerCount == 6 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = LVN_VULKAN_ENVIRONMENT_MAP_FORMAT;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel = mipLevel;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = layerCount;
+
+        VulkanEnvironmentMapPass pass{};
+        LVN_CORE_CALL_ASSERT(vkCreateImageView(vkBackends->device, &viewInfo, nullptr, &pass.dstView) == VK_SUCCESS, "[vulkan] failed to create environment map storage image view");
+
+        pass.pipeline = pipeline;
+        pass.srcView = srcView;
+        pass.srcSampler = srcSampler;
+        pass.size = lvn::max(dst->width >> mipLevel, 1u);
+        pass.layerCount = layerCount;
+        pass.roughness = roughness;
+
+        passes->push_back(pass);
+    }
+
+    static void recordEnvironmentMapPass(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const VulkanEnvironmentMapPass& pass)
+    {
+        uint32_t groupCount = (pass.size + LVN_VULKAN_ENVIRONMENT_MAP_GROUP_SIZE - 1) / LVN_VULKAN_ENVIRONMENT_MAP_GROUP_SIZE;
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &pass.descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(float), &pass.roughness);
+        vkCmdDispatch(commandBuffer, groupCount, groupCount, pass.layerCount);
+    }
+
+    static void uploadEnvironmentMap(VulkanBackends* vkBackends, LvnEnvironmentMap* environmentMap, const LvnEnvironmentMapBakeInfo* bakeInfo)
+    {
+        VkDeviceSize bakedSize = lvn::environmentMapGetBakedSize(bakeInfo);
+        VkFormat format = LVN_VULKAN_ENVIRONMENT_MAP_FORMAT;
+
+        VkBuffer stagingBuffer;
+        VmaAllocation stagingBufferMemory;
+        vks::createBuffer(vkBackends, &stagingBuffer, &stagingBufferMemory, bakedSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+
+        void* bufferData;
+        vmaMapMemory(vkBackends->vmaAllocator, stagingBufferMemory, &bufferData);
+        memcpy(bufferData, bakeInfo->pBakedData, bakedSize);
+        vmaUnmapMemory(vkBackends->vmaAllocator, stagingBufferMemory);
+
+        // copy the texels in the order they were baked, the cubemap mips are cheap to blit again so only its base level is stored
+        VkDeviceSize offset = 0;
+        LvnTexture* textures[3] = { &environmentMap->cubemap, &environmentMap->irradiance, &environmentMap->prefilter };
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            VkImage image = static_cast<VkImage>(textures[i]->image);
+            uint32_t copyLevels = i == 0 ? 1 : textures[i]->mipLevels;
+
+            vks::transitionImageLayout(vkBackends, image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 6, textures[i]->mipLevels);
+
+            for (uint32_t j = 0; j < copyLevels; j++)
+            {
+                uint32_t mipSize = lvn::max(textures[i]->width >> j, 1u);
+                vks::copyBufferToImage(vkBackends, stagingBuffer, offset, image, mipSize, mipSize, j, 6);
+                offset += 6 * (VkDeviceSize)mipSize * mipSize * LVN_VULKAN_ENVIRONMENT_MAP_TEXEL_SIZE;
+            }
+
+            if (i == 0)
+                vks::generateMipmaps(vkBackends, image, textures[i]->width, textures[i]->height, textures[i]->mipLevels, 6);
+            else
+                vks::transitionImageLayout(vkBackends, image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 6, textures[i]->mipLevels);
+        }
+
+        VkImage brdfImage = static_cast<VkImage>(environmentMap->brdfLut.image);
+        vks::transitionImageLayout(vkBackends, brdfImage, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, 1);
+        vks::copyBufferToImage(vkBackends, stagingBuffer, offset, brdfImage, environmentMap->brdfLut.width, environmentMap->brdfLut.height, 0, 1);
+        vks::transitionImageLayout(vkBackends, brdfImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 1);
+
+        vks::releaseStagingBuffer(vkBackends, stagingBuffer, stagingBufferMemory);
+    }
+
+    static LvnResult bakeEnvironmentMap(VulkanBackends* vkBackends, LvnEnvironmentMap* environmentMap, const LvnEnvironmentMapBakeInfo* bakeInfo)
+    {
+#ifdef LVN_INCLUDE_GLSLANG_SRC_COMPILE_SUPPORT
+        VkDevice device = vkBackends->device;
+        VmaAllocator vmaAllocator = vkBackends->vmaAllocator;
+        LvnResult result = Lvn_Result_Success;
+
+        // equirectangular source image, sampled with repeat around the horizon and clamped at the poles
+        VkFormat equirectFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+        if (bakeInfo->format == Lvn_HdrImageFormat_Half)
+            equirectFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+        else if (bakeInfo->format == Lvn_HdrImageFormat_Rgb9e5)
+            equirectFormat = VK_FORMAT_E5B9G9R9_UFLOAT_PACK32;
+
+        VkDeviceSize equirectSize = (VkDeviceSize)bakeInfo->width * bakeInfo->height * lvn::hdrImageGetTexelSize(bakeInfo->format, 4);
+
+        VkBuffer stagingBuffer;
+        VmaAllocation stagingBufferMemory;
+        vks::createBuffer(vkBackends, &stagingBuffer, &stagingBufferMemory, equirectSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+
+        void* bufferData;
+        vmaMapMemory(vmaAllocator, stagingBufferMemory, &bufferData);
+        memcpy(bufferData, bakeInfo->pixels, equirectSize);
+        vmaUnmapMemory(vmaAllocator, stagingBufferMemory);
+
+        VkImage equirectImage;
+        VmaAllocation equirectImageMemory;
+        if (vks::createImage(vkBackends, &equirectImage, &equirectImageMemory, bakeInfo->width, bakeInfo->height, 1, equirectFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_SAMPLE_COUNT_1_BIT, VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
+        {
+            vks::releaseStagingBuffer(vkBackends, stagingBuffer, stagingBufferMemory);
+            return Lvn_Result_Failure;
+        }
+
+        vks::transitionImageLayout(vkBackends, equirectImage, equirectFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, 1);
+        vks::copyBufferToImage(vkBackends, stagingBuffer, 0, equirectImage, bakeInfo->width, bakeInfo->height, 0, 1);
+        vks::transitionImageLayout(vkBackends, equirectImage, equirectFormat, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 1);
+        vks::releaseStagingBuffer(vkBackends, stagingBuffer, stagingBufferMemory);
+
+        VkImageView equirectImageView = vks::createImageView(device, equirectImage, equirectFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = 0.0f;
+        samplerInfo.maxAnisotropy = 1.0f;
+
+        VkSampler equirectSampler;
+        LVN_CORE_CALL_ASSERT(vkCreateSampler(device, &samplerInfo, nullptr, &equirectSampler) == VK_SUCCESS, "[vulkan] failed to create environment map source sampler");
+
+        // every pass samples binding 0 and writes to the storage image at binding 1, the prefilter pass takes its roughness as a push constant
+        VkDescriptorSetLayoutBinding bindings[2]{};
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+        setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutInfo.bindingCount = 2;
+        setLayoutInfo.pBindings = bindings;
+
+        VkDescriptorSetLayout setLayout;
+        LVN_CORE_CALL_ASSERT(vkCreateDescriptorSetLayout(device, &setLayoutInfo, nullptr, &setLayout) == VK_SUCCESS, "[vulkan] failed to create environment map descriptor set layout");
+
+        VkPushConstantRange pushConstant{};
+        pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstant.offset = 0;
+        pushConstant.size = sizeof(float);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &setLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstant;
+
+        VkPipelineLayout pipelineLayout;
+        LVN_CORE_CALL_ASSERT(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) == VK_SUCCESS, "[vulkan] failed to create environment map pipeline layout");
+
+        const char* shaderSrcs[4] = { bakeInfo->equirectToCubemapSrc, bakeInfo->irradianceSrc, bakeInfo->prefilterSrc, bakeInfo->brdfLutSrc };
+        uint32_t pipelineCount = bakeInfo->cubemapOnly ? 1 : 4;
+        VkPipeline pipelines[4] = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE };
+
+        for (uint32_t i = 0; i < pipelineCount; i++)
+        {
+            LvnVector<uint8_t> compData;
+            if (vks::getShaderSPIRV(vkBackends, GLSLANG_STAGE_COMPUTE, shaderSrcs[i], compData) != Lvn_Result_Success)
+            {
+                LVN_CORE_ERROR("[vulkan] failed to compile environment map compute shader");
+                result = Lvn_Result_Failure;
+                break;
+            }
+
+            VkShaderModule compShaderModule = vks::createShaderModule(vkBackends, compData.data(), compData.size());
+
+            VkComputePipelineCreateInfo pipelineInfo{};
+            pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            pipelineInfo.stage.module = compShaderModule;
+            pipelineInfo.stage.pName = "main";
+            pipelineInfo.layout = pipelineLayout;
+
+            VkResult pipelineResult = vkCreateComputePipelines(device, vkBackends->pipelineCache, 1, &pipelineInfo, nullptr, &pipelines[i]);
+            vkDestroyShaderModule(device, compShaderModule, nullptr);
+
+            if (pipelineResult != VK_SUCCESS)
+            {
+                LVN_CORE_ERROR("[vulkan] failed to create environment map compute pipeline");
+                result = Lvn_Result_Failure;
+                break;
+            }
+        }
+
+        // one pass per written image level, in the order they are dispatched
+        LvnVector<VulkanEnvironmentMapPass> passes;
+
+        VkImageView cubemapView = static_cast<VkImageView>(environmentMap->cubemap.imageView);
+        VkSampler cubemapSampler = static_cast<VkSampler>(environmentMap->cubemap.sampler);
+
+        if (result == Lvn_Result_Success)
+        {
+            vks::addEnvironmentMapPass(vkBackends, &passes, pipelines[0], equirectImageView, equirectSampler, &environmentMap->cubemap, 0, 6, 0.0f);
+
+            if (!bakeInfo->cubemapOnly)
+            {
+                vks::addEnvironmentMapPass(vkBackends, &passes, pipelines[1], cubemapView, cubemapSampler, &environmentMap->irradiance, 0, 6, 0.0f);
+
+                uint32_t prefilterMipLevels = environmentMap->prefilter.mipLevels;
+                for (uint32_t i = 0; i < prefilterMipLevels; i++)
+                    vks::addEnvironmentMapPass(vkBackends, &passes, pipelines[2], cubemapView, cubemapSampler, &environmentMap->prefilter, i, 6, prefilterMipLevels > 1 ? (float)i / (float)(prefilterMipLevels - 1) : 0.0f);
+
+                vks::addEnvironmentMapPass(vkBackends, &passes, pipelines[3], cubemapView, cubemapSampler, &environmentMap->brdfLut, 0, 1, 0.0f);
+            }
+        }
+
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        LvnVector<VkDescriptorSet> descriptorSets(passes.size());
+
+        if (!passes.empty())
+        {
+            VkDescriptorPoolSize poolSizes[2]{};
+            poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            poolSizes[0].descriptorCount = passes.size();
+            poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            poolSizes[1].descriptorCount = passes.size();
+
+            VkDescriptorPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            poolInfo.poolSizeCount = 2;
+            poolInfo.pPoolSizes = poolSizes;
+            poolInfo.maxSets = passes.size();
+
+            LVN_CORE_CALL_ASSERT(vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) == VK_SUCCESS, "[vulkan] failed to create environment map descriptor pool");
+
+            LvnVector<VkDescriptorSetLayout> setLayouts(passes.size(), setLayout);
+
+            VkDescriptorSetAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocInfo.descriptorPool = descriptorPool;
+            allocInfo.descriptorSetCount = passes.size();
+            allocInfo.pSetLayouts = setLayouts.data();
+
+            LVN_CORE_CALL_ASSERT(vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) == VK_SUCCESS, "[vulkan] failed to allocate environment map descriptor sets");
+
+            for (uint32_t i = 0; i < passes.size(); i++)
+                passes[i].descriptorSet = descriptorSets[i];
+
+            LvnVector<VkDescriptorImageInfo> imageInfos(passes.size() * 2);
+            LvnVector<VkWriteDescriptorSet> descriptorWrites(passes.size() * 2);
+
+            for (uint32_t i = 0; i < passes.size(); i++)
+            {
+                imageInfos[i * 2] = { passes[i].srcSampler, passes[i].srcView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+                imageInfos[i * 2 + 1] = { VK_NULL_HANDLE, passes[i].dstView, VK_IMAGE_LAYOUT_GENERAL };
+
+                for (uint32_t j = 0; j < 2; j++)
+                {
+                    VkWriteDescriptorSet& write = descriptorWrites[i * 2 + j];
+                    write = VkWriteDescriptorSet{};
+                    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                    write.dstSet = descriptorSets[i];
+                    write.dstBinding = j;
+                    write.descriptorCount = 1;
+                    write.descriptorType = j == 0 ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                    write.pImageInfo = &imageInfos[i * 2 + j];
+                }
+            }
+
+            vkUpdateDescriptorSets(device, descriptorWrites.size(), descriptorWrites.data(), 0, nullptr);
+        }
+
+        bool readback = bakeInfo->pBakedDataOut != nullptr && !bakeInfo->cubemapOnly;
+        VkDeviceSize bakedSize = lvn::environmentMapGetBakedSize(bakeInfo);
+        VkBuffer readbackBuffer = VK_NULL_HANDLE;
+        VmaAllocation readbackBufferMemory = VK_NULL_HANDLE;
+
+        if (readback && vks::createBuffer(vkBackends, &readbackBuffer, &readbackBufferMemory, bakedSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU) != Lvn_Result_Success)
+            readback = false;
+
+        if (result == Lvn_Result_Success)
+        {
+            VkImage cubemapImage = static_cast<VkImage>(environmentMap->cubemap.image);
+            uint32_t cubemapMipLevels = environmentMap->cubemap.mipLevels;
+            const LvnTexture* targets[3] = { &environmentMap->irradiance, &environmentMap->prefilter, &environmentMap->brdfLut };
+            const uint32_t targetLayers[3] = { 6, 6, 1 };
+            uint32_t targetCount = bakeInfo->cubemapOnly ? 0 : 3;
+
+            // the equirectangular conversion comes first, the cubemap it writes is then mipmapped for the following passes to sample
+            {
+                std::lock_guard<std::mutex> lock(s_UploadMutex);
+                VkCommandBuffer commandBuffer = vks::beginUploadCommands(vkBackends);
+
+                VkMemoryBarrier memoryBarrier{};
+                memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+                vks::cmdImageBarrier(commandBuffer, cubemapImage, 0, 1, 6, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+                if (cubemapMipLevels > 1)
+                    vks::cmdImageBarrier(commandBuffer, cubemapImage, 1, cubemapMipLevels - 1, 6, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+                for (uint32_t i = 0; i < targetCount; i++)
+                    vks::cmdImageBarrier(commandBuffer, static_cast<VkImage>(targets[i]->image), 0, targets[i]->mipLevels, targetLayers[i], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+                vks::recordEnvironmentMapPass(commandBuffer, pipelineLayout, passes[0]);
+
+                vks::cmdImageBarrier(commandBuffer, cubemapImage, 0, 1, 6, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            }
+
+            vks::generateMipmaps(vkBackends, cubemapImage, environmentMap->cubemap.width, environmentMap->cubemap.height, cubemapMipLevels, 6);
+
+            {
+                std::lock_guard<std::mutex> lock(s_UploadMutex);
+                VkCommandBuffer commandBuffer = vks::beginUploadCommands(vkBackends);
+
+                VkMemoryBarrier memoryBarrier{};
+                memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+                for (uint32_t i = 1; i < passes.size(); i++)
+                    vks::recordEnvironmentMapPass(commandBuffer, pipelineLayout, passes[i]);
+
+                if (readback)
+                {
+                    for (uint32_t i = 0; i < targetCount; i++)
+                        vks::cmdImageBarrier(commandBuffer, static_cast<VkImage>(targets[i]->image), 0, targets[i]->mipLevels, targetLayers[i], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+                    vks::cmdImageBarrier(commandBuffer, cubemapImage, 0, 1, 6, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 0, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+                    // same layout as the baked data uploaded by uploadEnvironmentMap
+                    LvnVector<VkBufferImageCopy> regions;
+                    const LvnTexture* sources[4] = { &environmentMap->cubemap, targets[0], targets[1], targets[2] };
+                    const uint32_t sourceLayers[4] = { 6, 6, 6, 1 };
+                    VkDeviceSize offset = 0;
+
+                    for (uint32_t i = 0; i < 4; i++)
+                    {
+                        uint32_t copyLevels = i == 0 ? 1 : sources[i]->mipLevels;
+                        for (uint32_t j = 0; j < copyLevels; j++)
+                        {
+                            uint32_t mipSize = lvn::max(sources[i]->width >> j, 1u);
+
+                            VkBufferImageCopy region{};
+                            region.bufferOffset = offset;
+                            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                            region.imageSubresource.mipLevel = j;
+                            region.imageSubresource.baseArrayLayer = 0;
+                            region.imageSubresource.layerCount = sourceLayers[i];
+                            region.imageExtent = { mipSize, mipSize, 1 };
+                            regions.push_back(region);
+
+                            offset += sourceLayers[i] * (VkDeviceSize)mipSize * mipSize * LVN_VULKAN_ENVIRONMENT_MAP_TEXEL_SIZE;
+                        }
+
+                        vkCmdCopyImageToBuffer(commandBuffer, static_cast<VkImage>(sources[i]->image), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer, regions.size(), regions.data());
+                        regions.clear();
+                    }
+
+                    for (uint32_t i = 0; i < targetCount; i++)
+                        vks::cmdImageBarrier(commandBuffer, static_cast<VkImage>(targets[i]->image), 0, targets[i]->mipLevels, targetLayers[i], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+                    vks::cmdImageBarrier(commandBuffer, cubemapImage, 0, 1, 6, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+                    VkMemoryBarrier hostBarrier{};
+                    hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+                    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+                }
+                else
+                {
+                    for (uint32_t i = 0; i < targetCount; i++)
+                        vks::cmdImageBarrier(commandBuffer, static_cast<VkImage>(targets[i]->image), 0, targets[i]->mipLevels, targetLayers[i], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+                }
+            }
+
+            // the whole bake goes out in one submission, waiting on it lets the temporary resources be destroyed right away
+            {
+                std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+                vks::submitUploadCommands(vkBackends, true);
+            }
+
+            if (readback)
+            {
+                void* readbackData;
+                vmaMapMemory(vmaAllocator, readbackBufferMemory, &readbackData);
+                vmaInvalidateAllocation(vmaAllocator, readbackBufferMemory, 0, VK_WHOLE_SIZE);
+
+                bakeInfo->pBakedDataOut->resize(bakedSize);
+                memcpy(bakeInfo->pBakedDataOut->data(), readbackData, bakedSize);
+                vmaUnmapMemory(vmaAllocator, readbackBufferMemory);
+            }
+        }
+        else
+        {
+            // the source image upload is still queued, it must finish before the image is destroyed below
+            std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+            vks::submitUploadCommands(vkBackends, true);
+        }
+
+        if (readbackBuffer != VK_NULL_HANDLE)
+            vmaDestroyBuffer(vmaAllocator, readbackBuffer, readbackBufferMemory);
+
+        for (uint32_t i = 0; i < passes.size(); i++)
+            vkDestroyImageView(device, passes[i].dstView, nullptr);
+
+        if (descriptorPool != VK_NULL_HANDLE)
+            vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+
+        for (uint32_t i = 0; i < 4; i++)
+            vkDestroyPipeline(device, pipelines[i], nullptr);
+
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+        vkDestroySampler(device, equirectSampler, nullptr);
+        vkDestroyImageView(device, equirectImageView, nullptr);
+        vmaDestroyImage(vmaAllocator, equirectImage, equirectImageMemory);
+
+        return result;
+#else
+        LVN_CORE_ERROR("[vulkan]: cannot bake environment map, glslang is not included, unable to compile the environment map compute shaders");
+        return Lvn_Result_Failure;
+#endif
+    }
+
+    // three channel images have no widely supported format and are uploaded as rgba
+    static VkDeviceSize getTextureStagingSize(const LvnImageData& imageData)
+    {
+        if (imageData.compression == Lvn_TextureCompression_None && imageData.channels == 3)
+            return (VkDeviceSize)imageData.width * imageData.height * 4;
+
+        return imageData.pixels.memsize();
+    }
+
+    static void copyTextureStagingData(uint8_t* dst, const LvnImageData& imageData)
+    {
+        if (imageData.compression == Lvn_TextureCompression_None && imageData.channels == 3)
+        {
+            lvn::imageConvertChannels(dst, 4, imageData.pixels.data(), 3, (uint64_t)imageData.width * imageData.height);
+            return;
+        }
+
+        memcpy(dst, imageData.pixels.data(), imageData.pixels.memsize());
+    }
+
+    static LvnResult createTextureImage(VulkanBackends* vkBackends, VkImage* image, VmaAllocation* imageMemory, uint32_t* mipLevels, VkFormat format, const LvnImageData& imageData, const LvnImageData* pMipImageData)
+    {
+        uint32_t levels = lvn::clamp(*mipLevels, 1u, lvn::imageGetMipLevelCount(imageData.width, imageData.height));
+
+        if (pMipImageData)
+        {
+            for (uint32_t i = 1; i < levels; i++)
+            {
+                const LvnImageData& mip = pMipImageData[i - 1];
+                if (mip.width != lvn::max(imageData.width >> i, 1u) || mip.height != lvn::max(imageData.height >> i, 1u) || mip.channels != imageData.channels)
+                {
+                    LVN_CORE_ERROR("[vulkan] precomputed mip level (%u) has dimensions (w:%u,h:%u,ch:%u), expected (w:%u,h:%u,ch:%u)", i, mip.width, mip.height, mip.channels, lvn::max(imageData.width >> i, 1u), lvn::max(imageData.height >> i, 1u), imageData.channels);
+                    return Lvn_Result_Failure;
+                }
+                if (mip.compression != imageData.compression || (mip.compression != Lvn_TextureCompression_None && mip.pixels.memsize() < lvn::imageGetCompressedSize(mip.compression, mip.width, mip.height)))
+                {
+                    LVN_CORE_ERROR("[vulkan] precomputed mip level (%u) does not match the compression format or block size of the base image", i);
+                    return Lvn_Result_Failure;
+                }
+            }
+        }
+
+        // block compressed images cannot be blitted into, they must ship their own mip chain
+        if (levels > 1 && !pMipImageData && imageData.compression != Lvn_TextureCompression_None)
+        {
+            LVN_CORE_WARN("[vulkan] mipmaps cannot be generated for compressed texture images, using a single mip level");
+            levels = 1;
+        }
+
+        // generated mips are blitted with linear filtering, fall back to a single level if the format cannot do that
+        if (levels > 1 && !pMipImageData)
+        {
+            VkFormatProperties formatProperties;
+            vkGetPhysicalDeviceFormatProperties(vkBackends->physicalDevice, format, &formatProperties);
+
+            VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT | VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+            if ((formatProperties.optimalTilingFeatures & blitFeatures) != blitFeatures)
+            {
+                LVN_CORE_WARN("[vulkan] texture image format (%u) does not support linear blitting, mipmaps will not be generated", format);
+                levels = 1;
+            }
+        }
+
+        // staging buffer holds level 0 followed by any precomputed mip levels
+        VkDeviceSize imageSize = vks::getTextureStagingSize(imageData);
+        if (pMipImageData)
+        {
+            for (uint32_t i = 1; i < levels; i++)
+                imageSize += vks::getTextureStagingSize(pMipImageData[i - 1]);
+        }
 
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = layerCount;
+        VkBuffer stagingBuffer;
+        VmaAllocation stagingBufferMemory;
+        vks::createBuffer(vkBackends, &stagingBuffer, &stagingBufferMemory, imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
 
-        region.imageOffset = { 0, 0, 0 };
-        region.imageExtent = { width, height, 1 };
+        uint8_t* data;
+        vmaMapMemory(vkBackends->vmaAllocator, stagingBufferMemory, (void**)&data);
+        vks::copyTextureStagingData(data, imageData);
+        if (pMipImageData)
+        {
+            VkDeviceSize offset = vks::getTextureStagingSize(imageData);
+            for (uint32_t i = 1; i < levels; i++)
+            {
+                vks::copyTextureStagingData(data + offset, pMipImageData[i - 1]);
+                offset += vks::getTextureStagingSize(pMipImageData[i - 1]);
+            }
+        }
+        vmaUnmapMemory(vkBackends->vmaAllocator, stagingBufferMemory);
 
-        vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        // create texture image
+        VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        if (levels > 1 && !pMipImageData)
+            usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
 
-        vkEndCommandBuffer(commandBuffer);
+        if (vks::createImage(vkBackends, image, imageMemory, imageData.width, imageData.height, levels, format, VK_IMAGE_TILING_OPTIMAL, usage, VK_SAMPLE_COUNT_1_BIT, VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
+        {
+            vkDestroyBuffer(vkBackends->device, stagingBuffer, nullptr);
+            vmaFreeMemory(vkBackends->vmaAllocator, stagingBufferMemory);
+            return Lvn_Result_Failure;
+        }
+
+        // transition buffer to image
+        vks::transitionImageLayout(vkBackends, *image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, levels);
+        vks::copyBufferToImage(vkBackends, stagingBuffer, 0, *image, imageData.width, imageData.height, 0, 1);
 
-        VkSubmitInfo submitInfo{};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffer;
+        if (pMipImageData)
+        {
+            VkDeviceSize offset = vks::getTextureStagingSize(imageData);
+            for (uint32_t i = 1; i < levels; i++)
+            {
+                vks::copyBufferToImage(vkBackends, stagingBuffer, offset, *image, lvn::max(imageData.width >> i, 1u), lvn::max(imageData.height >> i, 1u), i, 1);
+                offset += vks::getTextureStagingSize(pMipImageData[i - 1]);
+            }
+            vks::transitionImageLayout(vkBackends, *image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, levels);
+        }
+        else if (levels > 1)
+            vks::generateMipmaps(vkBackends, *image, imageData.width, imageData.height, levels, 1);
+        else
+            vks::transitionImageLayout(vkBackends, *image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, 1);
 
-        vkQueueSubmit(vkBackends->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(vkBackends->graphicsQueue);
+        vks::releaseStagingBuffer(vkBackends, stagingBuffer, stagingBufferMemory);
 
-        vkFreeCommandBuffers(vkBackends->device, vkBackends->commandPool, 1, &commandBuffer);
+        *mipLevels = levels;
+        return Lvn_Result_Success;
     }
 #ifdef LVN_INCLUDE_GLSLANG_SRC_COMPILE_SUPPORT
     static LvnResult compileShaderToSPIRV(glslang_stage_t stage, const char* shaderSource, LvnVector<uint8_t>& bin)
@@ -2101,6 +5024,71 @@ namespace vks
 
         return Lvn_Result_Success;
     }
+
+    static uint64_t hashShaderSource(glslang_stage_t stage, const char* shaderSource)
+    {
+        // FNV-1a over the compile target, stage and source; the target string must change whenever the compile settings above change
+        const char* target = "vulkan1.2-spv1.5";
+        uint64_t hash = 0xcbf29ce484222325;
+
+        for (const char* c = target; *c; c++)
+            hash = (hash ^ (uint8_t)*c) * 0x100000001b3;
+
+        hash = (hash ^ (uint64_t)stage) * 0x100000001b3;
+
+        for (const char* c = shaderSource; *c; c++)
+            hash = (hash ^ (uint8_t)*c) * 0x100000001b3;
+
+        return hash;
+    }
+
+    static LvnResult getShaderSPIRV(VulkanBackends* vkBackends, glslang_stage_t stage, const char* shaderSource, LvnVector<uint8_t>& bin)
+    {
+        uint64_t hash = vks::hashShaderSource(stage, shaderSource);
+
+        LvnString cachePath;
+        if (!vkBackends->shaderCacheDirectory.empty())
+        {
+            char filename[32];
+            snprintf(filename, sizeof(filename), "%016llx.spv", (unsigned long long)hash);
+            cachePath = vkBackends->shaderCacheDirectory;
+            if (cachePath.back() != '/' && cachePath.back() != '\\')
+                cachePath.push_back('/');
+            cachePath += filename;
+        }
+
+        // in memory cache, then on disk cache
+        {
+            LvnSharedLockGaurd lock(s_ShaderCacheMutex);
+            if (vkBackends->spirvCache.contains(hash))
+            {
+                bin = vkBackends->spirvCache[hash];
+                return Lvn_Result_Success;
+            }
+        }
+
+        {
+            LvnWriteLockGaurd lock(s_ShaderCacheMutex);
+
+            // spirv binaries are a whole number of 32 bit words starting with the spirv magic number
+            if (!cachePath.empty() && vks::readBinaryFile(cachePath.c_str(), bin) && bin.size() % 4 == 0 && *(uint32_t*)bin.data() == 0x07230203)
+            {
+                vkBackends->spirvCache.insert(hash, bin);
+                return Lvn_Result_Success;
+            }
+        }
+
+        if (vks::compileShaderToSPIRV(stage, shaderSource, bin) != Lvn_Result_Success)
+            return Lvn_Result_Failure;
+
+        LvnWriteLockGaurd lock(s_ShaderCacheMutex);
+        vkBackends->spirvCache.insert(hash, bin);
+
+        if (!cachePath.empty() && !vks::writeBinaryFile(cachePath.c_str(), bin.data(), bin.size()))
+            LVN_CORE_WARN("[vulkan] cannot write shader cache file: %s", cachePath.c_str());
+
+        return Lvn_Result_Success;
+    }
 #endif
 
 } /* namespace vks */
@@ -2119,6 +5107,25 @@ void createVulkanWindowSurfaceData(LvnWindow* window)
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
     bool vSync = window->data.vSync;
 
+    // headless windows have no surface, their frames go through the same command buffers and sync objects but are never presented
+    if (glfwWindow == nullptr)
+    {
+        surfaceData->headless = true;
+
+        vks::createHeadlessImages(vkBackends, surfaceData, static_cast<uint32_t>(lvn::max(window->data.width, 1)), static_cast<uint32_t>(lvn::max(window->data.height, 1)));
+        vks::createImageViews(vkBackends, surfaceData);
+        vks::createDepthResources(vkBackends, surfaceData);
+        vks::createRenderPass(vkBackends, surfaceData, surfaceData->swapChainImageFormat);
+        vks::createFrameBuffers(vkBackends, surfaceData);
+        vks::createCommandBuffers(vkBackends, surfaceData);
+        vks::createSyncObjects(vkBackends, surfaceData);
+        vks::createTimestampQueryPool(vkBackends, surfaceData);
+
+        window->renderPass.nativeRenderPass = surfaceData->renderPass;
+        window->renderPass.nativeRenderingFormats = nullptr;
+        return;
+    }
+
     LVN_CORE_CALL_ASSERT(glfwCreateWindowSurface(vkBackends->instance, glfwWindow, nullptr, &surfaceData->surface) == VK_SUCCESS, "[vulkan] failed to create temporary window surface at (%p)", surfaceData->surface);
 
     // get and check swap chain specs
@@ -2126,18 +5133,20 @@ void createVulkanWindowSurfaceData(LvnWindow* window)
     LVN_CORE_ASSERT(!swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty(), "[vulkan] device does not have supported swap chain formats or present modes");
 
     VkSurfaceFormatKHR surfaceFormat = vks::chooseSwapSurfaceFormat(vkBackends, swapChainSupport.formats.data(), swapChainSupport.formats.size());
-    VkPresentModeKHR presentMode = vks::chooseSwapPresentMode(swapChainSupport.presentModes.data(), swapChainSupport.presentModes.size(), vSync);
+    VkPresentModeKHR presentMode = vks::chooseSwapPresentMode(swapChainSupport.presentModes.data(), swapChainSupport.presentModes.size(), window->data.presentMode, vSync);
     VkExtent2D extent = vks::chooseSwapExtent(glfwWindow, &swapChainSupport.capabilities);
 
-    vks::createSwapChain(vkBackends, surfaceData, swapChainSupport, surfaceFormat, presentMode, extent);
+    vks::createSwapChain(vkBackends, surfaceData, swapChainSupport, surfaceFormat, presentMode, extent, VK_NULL_HANDLE);
     vks::createImageViews(vkBackends, surfaceData);
     vks::createDepthResources(vkBackends, surfaceData);
     vks::createRenderPass(vkBackends, surfaceData, surfaceFormat.format);
     vks::createFrameBuffers(vkBackends, surfaceData);
     vks::createCommandBuffers(vkBackends, surfaceData);
     vks::createSyncObjects(vkBackends, surfaceData);
+    vks::createTimestampQueryPool(vkBackends, surfaceData);
 
     window->renderPass.nativeRenderPass = static_cast<VulkanWindowSurfaceData*>(window->apiData)->renderPass;
+    window->renderPass.nativeRenderingFormats = nullptr;
 }
 
 void destroyVulkanWindowSurfaceData(LvnWindow* window)
@@ -2149,19 +5158,42 @@ void destroyVulkanWindowSurfaceData(LvnWindow* window)
     VulkanBackends* vkBackends = s_VkBackends;
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
 
+    vks::flushSubmitBatch(vkBackends, window);
+    vks::submitUploadCommands(vkBackends, true);
     vkDeviceWaitIdle(vkBackends->device);
+    vkBackends->completedSubmitIndex = vkBackends->submitIndex;
+    if (vkBackends->ringRegionWindow == window)
+        vkBackends->ringRegionWindow = nullptr;
+
+    // swap chains retired by resizes must be destroyed before their surface
+    vks::releaseDeferredDeletions(vkBackends, false);
+
+    // the device is idle, readbacks of frames that will not be waited on again are complete
+    vks::completeReadbacks(vkBackends, surfaceData, 0, true);
 
     // sync objects
     for (uint32_t i = 0; i < vkBackends->maxFramesInFlight; i++)
     {
         vkDestroySemaphore(vkBackends->device, surfaceData->imageAvailableSemaphores[i], nullptr);
+    }
+    for (uint32_t i = 0; i < surfaceData->inFlightFences.size(); i++)
+    {
         vkDestroyFence(vkBackends->device, surfaceData->inFlightFences[i], nullptr);
     }
+    if (surfaceData->frameTimeline != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore(vkBackends->device, surfaceData->frameTimeline, nullptr);
+    }
     for (uint32_t i = 0; i < surfaceData->renderFinishedSemaphores.size(); i++)
     {
         vkDestroySemaphore(vkBackends->device, surfaceData->renderFinishedSemaphores[i], nullptr);
     }
 
+    if (surfaceData->timestampQueryPool != VK_NULL_HANDLE)
+    {
+        vkDestroyQueryPool(vkBackends->device, surfaceData->timestampQueryPool, nullptr);
+    }
+
     // swap chain images
     for (uint32_t i = 0; i < surfaceData->swapChainImageViews.size(); i++)
     {
@@ -2174,6 +5206,7 @@ void destroyVulkanWindowSurfaceData(LvnWindow* window)
 
     // command pool
     vkDestroyCommandPool(vkBackends->device, surfaceData->commandPool, nullptr);
+    vks::destroyThreadCommandPools(vkBackends, surfaceData);
 
     // frame buffers
     for (uint32_t i = 0; i < surfaceData->frameBuffers.size(); i++)
@@ -2181,14 +5214,26 @@ void destroyVulkanWindowSurfaceData(LvnWindow* window)
         vkDestroyFramebuffer(vkBackends->device, surfaceData->frameBuffers[i], nullptr);
     }
 
-    // swap chain
-    vkDestroySwapchainKHR(vkBackends->device, surfaceData->swapChain, nullptr);
+    // swap chain, headless windows own their images instead
+    if (surfaceData->headless)
+    {
+        for (uint32_t i = 0; i < surfaceData->swapChainImages.size(); i++)
+        {
+            vkDestroyImage(vkBackends->device, surfaceData->swapChainImages[i], nullptr);
+            vmaFreeMemory(vkBackends->vmaAllocator, surfaceData->headlessImageMemory[i]);
+        }
+    }
+    else
+    {
+        vkDestroySwapchainKHR(vkBackends->device, surfaceData->swapChain, nullptr);
+    }
 
     // render pass
     vkDestroyRenderPass(vkBackends->device, surfaceData->renderPass, nullptr);
 
     // window surface
-    vkDestroySurfaceKHR(vkBackends->instance, surfaceData->surface, nullptr);
+    if (!surfaceData->headless)
+        vkDestroySurfaceKHR(vkBackends->instance, surfaceData->surface, nullptr);
 
     delete static_cast<VulkanWindowSurfaceData*>(window->apiData);
 }
@@ -2206,6 +5251,12 @@ LvnResult vksImplCreateContext(LvnGraphicsContext* graphicsContext)
     vkBackends->enableValidationLayers = graphicsContext->enableGraphicsApiDebugLogs;
     vkBackends->defaultPipelineSpecification = lvn::configPipelineSpecificationInit();
     vkBackends->maxFramesInFlight = graphicsContext->maxFramesInFlight > 0 ? graphicsContext->maxFramesInFlight : 1;
+    vkBackends->frameLatency = graphicsContext->frameLatency > 0 ? graphicsContext->frameLatency : vkBackends->maxFramesInFlight;
+    vkBackends->frameLatency = lvn::min(lvn::min(vkBackends->frameLatency, (uint32_t)LVN_VULKAN_MAX_FRAME_LATENCY), vkBackends->maxFramesInFlight);
+    vkBackends->waitForPresent = graphicsContext->waitForPresent;
+    vkBackends->pendingDescriptorUpdates.resize(vkBackends->maxFramesInFlight);
+    vkBackends->pipelineCachePath = graphicsContext->pipelineCachePath;
+    vkBackends->shaderCacheDirectory = graphicsContext->shaderCacheDirectory;
 
     switch (graphicsContext->frameBufferColorFormat)
     {
@@ -2233,7 +5284,13 @@ LvnResult vksImplCreateContext(LvnGraphicsContext* graphicsContext)
 
     // get physical devices and setup render init
     LvnVector<VkPhysicalDevice> physicalDevices = vks::getPhysicalDevices(vkBackends->instance);
-    VkPhysicalDevice physicalDevice = vks::getBestPhysicalDevice(vkBackends->instance, physicalDevices);
+    VkPhysicalDevice physicalDevice = vks::getBestPhysicalDevice(vkBackends->instance, physicalDevices, graphicsContext->physicalDevicePreference);
+    if (physicalDevice == VK_NULL_HANDLE)
+    {
+        LVN_CORE_ERROR("[vulkan] failed to find a physical device when creating graphics context");
+        return Lvn_Result_Failure;
+    }
+
     vks::setupRenderInit(vkBackends, physicalDevice);
 
 
@@ -2241,18 +5298,20 @@ LvnResult vksImplCreateContext(LvnGraphicsContext* graphicsContext)
     graphicsContext->getPhysicalDevices = vksImplGetPhysicalDevices;
     graphicsContext->checkPhysicalDeviceSupport = vksImplCheckPhysicalDeviceSupport;
     graphicsContext->setPhysicalDevice = vksImplSetPhysicalDevice;
+    graphicsContext->getMemoryStats = vksImplGetMemoryStats;
     graphicsContext->createShaderFromSrc = vksImplCreateShaderFromSrc;
     graphicsContext->createShaderFromFileSrc = vksImplCreateShaderFromFileSrc;
     graphicsContext->createShaderFromFileBin = vksImplCreateShaderFromFileBin;
     graphicsContext->createDescriptorLayout = vksImplCreateDescriptorLayout;
     graphicsContext->createPipeline = vksImplCreatePipeline;
+    graphicsContext->createComputePipeline = vksImplCreateComputePipeline;
     graphicsContext->createFrameBuffer = vksImplCreateFrameBuffer;
     graphicsContext->createBuffer = vksImplCreateBuffer;
     graphicsContext->createSampler = vksImplCreateSampler;
     graphicsContext->createTexture = vksImplCreateTexture;
     graphicsContext->createTextureSampler = vksImplCreateTextureSampler;
     graphicsContext->createCubemap = vksImplCreateCubemap;
-    graphicsContext->createCubemapHdr = vksImplCreateCubemapHdr;
+    graphicsContext->createEnvironmentMap = vksImplCreateEnvironmentMap;
 
     graphicsContext->destroyShader = vksImplDestroyShader;
     graphicsContext->destroyDescriptorLayout = vksImplDestroyDescriptorLayout;
@@ -2262,34 +5321,63 @@ LvnResult vksImplCreateContext(LvnGraphicsContext* graphicsContext)
     graphicsContext->destroySampler = vksImplDestroySampler;
     graphicsContext->destroyTexture = vksImplDestroyTexture;
     graphicsContext->destroyCubemap = vksImplDestroyCubemap;
+    graphicsContext->destroyEnvironmentMap = vksImplDestroyEnvironmentMap;
 
     graphicsContext->renderBeginNextFrame = vksImplRenderBeginNextFrame;
     graphicsContext->renderDrawSubmit = vksImplRenderDrawSubmit;
+    graphicsContext->renderBeginSubmitBatch = vksImplRenderBeginSubmitBatch;
+    graphicsContext->renderEndSubmitBatch = vksImplRenderEndSubmitBatch;
     graphicsContext->renderBeginCommandRecording = vksImplRenderBeginCommandRecording;
+    graphicsContext->renderBeginSecondaryCommandRecording = vksImplRenderBeginSecondaryCommandRecording;
+    graphicsContext->renderEndSecondaryCommandRecording = vksImplRenderEndSecondaryCommandRecording;
     graphicsContext->renderEndCommandRecording = vksImplRenderEndCommandRecording;
     graphicsContext->renderCmdDraw = vksImplRenderCmdDraw;
     graphicsContext->renderCmdDrawIndexed = vksImplRenderCmdDrawIndexed;
     graphicsContext->renderCmdDrawInstanced = vksImplRenderCmdDrawInstanced;
     graphicsContext->renderCmdDrawIndexedInstanced = vksImplRenderCmdDrawIndexedInstanced;
+    graphicsContext->renderCmdDrawIndirect = vksImplRenderCmdDrawIndirect;
+    graphicsContext->renderCmdDrawIndexedIndirect = vksImplRenderCmdDrawIndexedIndirect;
+    graphicsContext->renderCmdDrawIndexedIndirectCount = vksImplRenderCmdDrawIndexedIndirectCount;
     graphicsContext->renderCmdSetStencilReference = vksImplRenderCmdSetStencilReference;
     graphicsContext->renderCmdSetStencilMask = vksImplRenderCmdSetStencilMask;
+    graphicsContext->renderCmdSetCullMode = vksImplRenderCmdSetCullMode;
+    graphicsContext->renderCmdSetFrontFace = vksImplRenderCmdSetFrontFace;
+    graphicsContext->renderCmdSetPrimitiveTopology = vksImplRenderCmdSetPrimitiveTopology;
+    graphicsContext->renderCmdSetDepthTest = vksImplRenderCmdSetDepthTest;
+    graphicsContext->renderCmdSetBlendEnable = vksImplRenderCmdSetBlendEnable;
+    graphicsContext->renderCmdSetScissor = vksImplRenderCmdSetScissor;
     graphicsContext->renderCmdBeginRenderPass = vksImplRenderCmdBeginRenderPass;
     graphicsContext->renderCmdEndRenderPass = vksImplRenderCmdEndRenderPass;
     graphicsContext->renderCmdBindPipeline = vksImplRenderCmdBindPipeline;
     graphicsContext->renderCmdBindVertexBuffer = vksImplRenderCmdBindVertexBuffer;
     graphicsContext->renderCmdBindIndexBuffer = vksImplRenderCmdBindIndexBuffer;
     graphicsContext->renderCmdBindDescriptorSets = vksImplRenderCmdBindDescriptorSets;
+    graphicsContext->renderCmdPushConstants = vksImplRenderCmdPushConstants;
+    graphicsContext->renderCmdDispatch = vksImplRenderCmdDispatch;
+    graphicsContext->renderCmdMemoryBarrier = vksImplRenderCmdMemoryBarrier;
+    graphicsContext->renderCmdBeginTimestamp = vksImplRenderCmdBeginTimestamp;
+    graphicsContext->renderCmdEndTimestamp = vksImplRenderCmdEndTimestamp;
     graphicsContext->renderCmdBeginFrameBuffer = vksImplRenderCmdBeginFrameBuffer;
     graphicsContext->renderCmdEndFrameBuffer = vksImplRenderCmdEndFrameBuffer;
+    graphicsContext->renderCmdReadbackFrameBuffer = vksImplRenderCmdReadbackFrameBuffer;
 
     graphicsContext->bufferUpdateData = vksImplBufferUpdateData;
     graphicsContext->bufferResize = vksImplBufferResize;
+    graphicsContext->bufferGetMappedData = vksImplBufferGetMappedData;
+    graphicsContext->bufferMap = vksImplBufferMap;
+    graphicsContext->bufferFlushRange = vksImplBufferFlushRange;
+    graphicsContext->bufferUnmap = vksImplBufferUnmap;
+    graphicsContext->textureUpdateData = vksImplTextureUpdateData;
     graphicsContext->allocateDescriptorSet = vksImplAllocateDescriptorSet;
+    graphicsContext->allocateTransientDescriptorSet = vksImplAllocateTransientDescriptorSet;
     graphicsContext->updateDescriptorSetData = vksImplUpdateDescriptorSetData;
+    graphicsContext->updateDescriptorSetsData = vksImplUpdateDescriptorSetsData;
     graphicsContext->frameBufferGetImage = vksImplFrameBufferGetImage;
     graphicsContext->frameBufferGetRenderPass = vksImplFrameBufferGetRenderPass;
     graphicsContext->framebufferResize = vksImplFrameBufferResize;
     graphicsContext->frameBufferSetClearColor = vksImplFrameBufferSetClearColor;
+    graphicsContext->frameBufferReadPixels = vksImplFrameBufferReadPixels;
+    graphicsContext->windowReadPixels = vksImplWindowReadPixels;
     graphicsContext->findSupportedDepthImageFormat = vksImplFindSupportedDepthImageFormat;
 
     return Lvn_Result_Success;
@@ -2298,7 +5386,14 @@ LvnResult vksImplCreateContext(LvnGraphicsContext* graphicsContext)
 void vksImplTerminateContext()
 {
     VulkanBackends* vkBackends = s_VkBackends;
+    vks::flushUploadCommands(vkBackends);
     vkDeviceWaitIdle(vkBackends->device);
+    vks::releaseDeferredDeletions(vkBackends, true);
+    vks::destroyBufferPool(vkBackends);
+    vks::destroyReadbackBuffers(vkBackends);
+
+    // pipeline cache, saved to the cache file before the device is destroyed
+    vks::destroyPipelineCache(vkBackends);
 
     // command pool
     vkDestroyCommandPool(vkBackends->device, vkBackends->commandPool, nullptr);
@@ -2352,6 +5447,9 @@ void vksImplGetPhysicalDevices(LvnPhysicalDevice** pPhysicalDevices, uint32_t* p
         props.apiVersion = deviceProperties.apiVersion;
         props.driverVersion = deviceProperties.driverVersion;
         props.vendorID = deviceProperties.vendorID;
+        props.minUniformBufferOffsetAlignment = deviceProperties.limits.minUniformBufferOffsetAlignment;
+        props.maxPushConstantsSize = deviceProperties.limits.maxPushConstantsSize;
+        props.deviceLocalMemorySize = vks::getDeviceLocalMemorySize(physicalDevices[i]);
 
         vkBackends->lvnPhysicalDevices[i].properties = props;
         vkBackends->lvnPhysicalDevices[i].features = *reinterpret_cast<LvnPhysicalDeviceFeatures*>(&deviceFeatures);
@@ -2412,124 +5510,505 @@ LvnResult vksImplSetPhysicalDevice(LvnPhysicalDevice* physicalDevice)
     return vks::setupRenderInit(vkBackends, vkPhysicalDevice);;
 }
 
+void vksImplGetMemoryStats(LvnGraphicsMemoryStats* stats)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    const VkPhysicalDeviceMemoryProperties* memoryProperties;
+    vmaGetMemoryProperties(vkBackends->vmaAllocator, &memoryProperties);
+
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(vkBackends->vmaAllocator, budgets);
+
+    stats->heapCount = lvn::min<uint32_t>(memoryProperties->memoryHeapCount, LVN_MAX_MEMORY_HEAPS);
+    stats->budgetSupported = vkBackends->memoryBudgetSupported;
+
+    for (uint32_t i = 0; i < stats->heapCount; i++)
+    {
+        LvnGraphicsMemoryHeapStats& heap = stats->heaps[i];
+        heap.budget = budgets[i].budget;
+        heap.usage = budgets[i].usage;
+        heap.blockBytes = budgets[i].statistics.blockBytes;
+        heap.allocationBytes = budgets[i].statistics.allocationBytes;
+        heap.blockCount = budgets[i].statistics.blockCount;
+        heap.allocationCount = budgets[i].statistics.allocationCount;
+        heap.deviceLocal = (memoryProperties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+
+    stats->bufferBytes = vkBackends->resourceMemoryBytes[Vulkan_MemoryResource_Buffer];
+    stats->bufferAllocations = vkBackends->resourceAllocationCount[Vulkan_MemoryResource_Buffer];
+    stats->textureBytes = vkBackends->resourceMemoryBytes[Vulkan_MemoryResource_Texture];
+    stats->textureAllocations = vkBackends->resourceAllocationCount[Vulkan_MemoryResource_Texture];
+    stats->frameBufferBytes = vkBackends->resourceMemoryBytes[Vulkan_MemoryResource_FrameBuffer];
+    stats->frameBufferAllocations = vkBackends->resourceAllocationCount[Vulkan_MemoryResource_FrameBuffer];
+
+    // detailed statistics walk every block, they are only calculated when asked for
+    VmaTotalStatistics totalStats;
+    vmaCalculateStatistics(vkBackends->vmaAllocator, &totalStats);
+
+    const VmaDetailedStatistics& total = totalStats.total;
+    stats->unusedBytes = total.statistics.blockBytes - total.statistics.allocationBytes;
+    stats->unusedRangeCount = total.unusedRangeCount;
+    stats->largestUnusedRange = total.unusedRangeCount > 0 ? total.unusedRangeSizeMax : 0;
+    stats->fragmentation = stats->unusedBytes > 0 ? 1.0f - static_cast<float>(static_cast<double>(stats->largestUnusedRange) / static_cast<double>(stats->unusedBytes)) : 0.0f;
+}
+
 void vksImplRenderCmdDraw(LvnWindow* window, uint32_t vertexCount)
 {
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
-    vkCmdDraw(surfaceData->commandBuffers[surfaceData->currentFrame], vertexCount, 1, 0, 0);
+    vkCmdDraw(vks::getRecordingCommandBuffer(window, surfaceData), vertexCount, 1, 0, 0);
 }
 
 void vksImplRenderCmdDrawIndexed(LvnWindow* window, uint32_t indexCount)
 {
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
-    vkCmdDrawIndexed(surfaceData->commandBuffers[surfaceData->currentFrame], indexCount, 1, 0, 0, 0);
+    vkCmdDrawIndexed(vks::getRecordingCommandBuffer(window, surfaceData), indexCount, 1, 0, 0, 0);
+}
+
+void vksImplRenderCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance)
+{
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    vkCmdDraw(vks::getRecordingCommandBuffer(window, surfaceData), vertexCount, instanceCount, 0, firstInstance);
+}
+
+void vksImplRenderCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance)
+{
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    vkCmdDrawIndexed(vks::getRecordingCommandBuffer(window, surfaceData), indexCount, instanceCount, 0, 0, firstInstance);
+}
+
+void vksImplRenderCmdDrawIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    VkCommandBuffer commandBuffer = vks::getRecordingCommandBuffer(window, surfaceData);
+    VkBuffer indirectBuffer = static_cast<VkBuffer>(buffer->buffer);
+    offset += buffer->baseOffset + buffer->regionSize * surfaceData->currentFrame;
+
+    if (vkBackends->deviceSupportedFeatures.multiDrawIndirect)
+    {
+        vkCmdDrawIndirect(commandBuffer, indirectBuffer, offset, drawCount, stride);
+        return;
+    }
+
+    // without multiDrawIndirect the draw count must be at most one
+    for (uint32_t i = 0; i < drawCount; i++)
+        vkCmdDrawIndirect(commandBuffer, indirectBuffer, offset + static_cast<uint64_t>(i) * stride, 1, stride);
+}
+
+void vksImplRenderCmdDrawIndexedIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    VkCommandBuffer commandBuffer = vks::getRecordingCommandBuffer(window, surfaceData);
+    VkBuffer indirectBuffer = static_cast<VkBuffer>(buffer->buffer);
+    offset += buffer->baseOffset + buffer->regionSize * surfaceData->currentFrame;
+
+    if (vkBackends->deviceSupportedFeatures.multiDrawIndirect)
+    {
+        vkCmdDrawIndexedIndirect(commandBuffer, indirectBuffer, offset, drawCount, stride);
+        return;
+    }
+
+    for (uint32_t i = 0; i < drawCount; i++)
+        vkCmdDrawIndexedIndirect(commandBuffer, indirectBuffer, offset + static_cast<uint64_t>(i) * stride, 1, stride);
+}
+
+void vksImplRenderCmdDrawIndexedIndirectCount(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, LvnBuffer* countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    if (!vkBackends->drawIndirectCountSupported)
+    {
+        LVN_CORE_ERROR("[vulkan] cannot draw indexed indirect count, physical device does not support the drawIndirectCount feature");
+        return;
+    }
+
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+
+    vkCmdDrawIndexedIndirectCount(vks::getRecordingCommandBuffer(window, surfaceData),
+        static_cast<VkBuffer>(buffer->buffer), buffer->baseOffset + offset + buffer->regionSize * surfaceData->currentFrame,
+        static_cast<VkBuffer>(countBuffer->buffer), countBuffer->baseOffset + countBufferOffset + countBuffer->regionSize * surfaceData->currentFrame,
+        maxDrawCount, stride);
+}
+
+void vksImplRenderCmdSetStencilReference(uint32_t reference)
+{
+
+}
+
+void vksImplRenderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask)
+{
+
+}
+
+void vksImplRenderCmdSetCullMode(LvnWindow* window, LvnCullFaceMode cullMode)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    if (!vkBackends->extendedDynamicStateSupported)
+    {
+        LVN_LOG_RATE_LIMIT(1, 1, LVN_CORE_WARN, "[vulkan] cannot set cull mode, physical device does not support VK_EXT_extended_dynamic_state, the pipeline value is used");
+        return;
+    }
+
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    vkBackends->setCullModeFn(vks::getRecordingCommandBuffer(window, surfaceData), vks::getVulkanCullModeFlagEnum(cullMode));
+}
+
+void vksImplRenderCmdSetFrontFace(LvnWindow* window, LvnCullFrontFace frontFace)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    if (!vkBackends->extendedDynamicStateSupported)
+    {
+        LVN_LOG_RATE_LIMIT(1, 1, LVN_CORE_WARN, "[vulkan] cannot set front face, physical device does not support VK_EXT_extended_dynamic_state, the pipeline value is used");
+        return;
+    }
+
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    vkBackends->setFrontFaceFn(vks::getRecordingCommandBuffer(window, surfaceData), vks::getVulkanCullFrontFaceEnum(frontFace));
+}
+
+void vksImplRenderCmdSetPrimitiveTopology(LvnWindow* window, LvnTopologyType topology)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    if (!vkBackends->extendedDynamicStateSupported)
+    {
+        LVN_LOG_RATE_LIMIT(1, 1, LVN_CORE_WARN, "[vulkan] cannot set primitive topology, physical device does not support VK_EXT_extended_dynamic_state, the pipeline value is used");
+        return;
+    }
+
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    vkBackends->setPrimitiveTopologyFn(vks::getRecordingCommandBuffer(window, surfaceData), vks::getVulkanTopologyTypeEnum(topology));
+}
+
+void vksImplRenderCmdSetDepthTest(LvnWindow* window, bool enableDepth, bool depthWrite, LvnCompareOperation depthOpCompare)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    if (!vkBackends->extendedDynamicStateSupported)
+    {
+        LVN_LOG_RATE_LIMIT(1, 1, LVN_CORE_WARN, "[vulkan] cannot set depth test, physical device does not support VK_EXT_extended_dynamic_state, the pipeline value is used");
+        return;
+    }
+
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    VkCommandBuffer commandBuffer = vks::getRecordingCommandBuffer(window, surfaceData);
+    vkBackends->setDepthTestEnableFn(commandBuffer, enableDepth ? VK_TRUE : VK_FALSE);
+    vkBackends->setDepthWriteEnableFn(commandBuffer, enableDepth && depthWrite ? VK_TRUE : VK_FALSE);
+    vkBackends->setDepthCompareOpFn(commandBuffer, vks::getCompareOpEnum(depthOpCompare));
+}
+
+void vksImplRenderCmdSetBlendEnable(LvnWindow* window, uint32_t attachment, bool enable)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    if (!vkBackends->dynamicBlendEnableSupported)
+    {
+        LVN_LOG_RATE_LIMIT(1, 1, LVN_CORE_WARN, "[vulkan] cannot set blend enable, physical device does not support the extendedDynamicState3ColorBlendEnable feature, the pipeline value is used");
+        return;
+    }
+
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    VkBool32 blendEnable = enable ? VK_TRUE : VK_FALSE;
+    vkBackends->setColorBlendEnableFn(vks::getRecordingCommandBuffer(window, surfaceData), attachment, 1, &blendEnable);
+}
+
+void vksImplRenderCmdSetScissor(LvnWindow* window, int32_t x, int32_t y, uint32_t width, uint32_t height)
+{
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+
+    // the window pass flips its viewport, a bottom left origin counts from the last row of the swap chain image
+    LvnFrameBuffer* frameBuffer = s_SecondaryRecording.window == window ? s_SecondaryRecording.frameBuffer : surfaceData->passFrameBuffer;
+    int64_t areaWidth = frameBuffer ? frameBuffer->renderWidth : surfaceData->swapChainExtent.width;
+    int64_t areaHeight = frameBuffer ? frameBuffer->renderHeight : surfaceData->swapChainExtent.height;
+    int64_t top = frameBuffer ? y : areaHeight - (static_cast<int64_t>(y) + height);
+
+    // vulkan needs a non negative offset, the rectangle is clamped to the render area
+    int64_t x0 = lvn::clamp<int64_t>(x, 0, areaWidth), y0 = lvn::clamp<int64_t>(top, 0, areaHeight);
+    int64_t x1 = lvn::clamp<int64_t>(static_cast<int64_t>(x) + width, 0, areaWidth), y1 = lvn::clamp<int64_t>(top + height, 0, areaHeight);
+
+    VkRect2D scissor{};
+    scissor.offset = { static_cast<int32_t>(x0), static_cast<int32_t>(y0) };
+    scissor.extent = { static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0) };
+    vkCmdSetScissor(vks::getRecordingCommandBuffer(window, surfaceData), 0, 1, &scissor);
+}
+
+void vksImplRenderBeginNextFrame(LvnWindow* window)
+{
+    GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+
+    VulkanBackends* vkBackends = s_VkBackends;
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+
+    if (!s_SubmitBatch.submits.empty())
+    {
+        std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+        vks::flushSubmitBatch(vkBackends, window);
+    }
+
+    // the frame submitted frameLatency frames ago must finish before recording a new one, with a latency of at most
+    // maxFramesInFlight this also retires the previous use of the current frame's resources
+    uint32_t latencyFrame = (surfaceData->currentFrame + vkBackends->maxFramesInFlight - vkBackends->frameLatency) % vkBackends->maxFramesInFlight;
+
+    // wait for present keeps a single frame queued, the previous frame has to be on screen before the next one begins
+    if (vkBackends->waitForPresent)
+    {
+        latencyFrame = (surfaceData->currentFrame + vkBackends->maxFramesInFlight - 1) % vkBackends->maxFramesInFlight;
+
+        if (vkBackends->presentWaitSupported && !surfaceData->headless && surfaceData->presentId > 0)
+            vkBackends->waitForPresentFn(vkBackends->device, surfaceData->swapChain, surfaceData->presentId, LVN_VULKAN_PRESENT_WAIT_TIMEOUT);
+    }
+
+    uint64_t waitSubmitIndex = lvn::max(surfaceData->inFlightSubmitIndices[surfaceData->currentFrame], surfaceData->inFlightSubmitIndices[latencyFrame]);
+
+    if (surfaceData->frameTimeline != VK_NULL_HANDLE)
+    {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &surfaceData->frameTimeline;
+        waitInfo.pValues = &waitSubmitIndex;
+
+        vkWaitSemaphores(vkBackends->device, &waitInfo, UINT64_MAX);
+    }
+    else
+    {
+        VkFence waitFences[2] = { surfaceData->inFlightFences[surfaceData->currentFrame], surfaceData->inFlightFences[latencyFrame] };
+        vkWaitForFences(vkBackends->device, latencyFrame != surfaceData->currentFrame ? 2 : 1, waitFences, VK_TRUE, UINT64_MAX);
+        vkResetFences(vkBackends->device, 1, &surfaceData->inFlightFences[surfaceData->currentFrame]);
+    }
+
+    // ring buffer updates write to the region of the frame that was just waited on
+    vkBackends->currentFrame = surfaceData->currentFrame;
+    vkBackends->recordingFrame = true;
+    if (vkBackends->ringRegionWindow == window)
+        vkBackends->ringRegionWindow = nullptr;
+
+    // vma refreshes the heap budgets fetched from the driver when the frame index changes
+    vmaSetCurrentFrameIndex(vkBackends->vmaAllocator, static_cast<uint32_t>(vkBackends->submitIndex));
+
+    // the waited submission retires every submission made before it, objects and descriptor sets used by those frames can now be released
+    vkBackends->completedSubmitIndex = lvn::max(vkBackends->completedSubmitIndex, waitSubmitIndex);
+    vks::releaseDeferredDeletions(vkBackends, false);
+    vks::applyPendingDescriptorUpdates(vkBackends, surfaceData->currentFrame);
+    vks::resetThreadCommandPools(vkBackends, surfaceData, surfaceData->currentFrame);
+    vks::readTimestampQueries(vkBackends, window, surfaceData, surfaceData->currentFrame);
+    vks::completeReadbacks(vkBackends, surfaceData, surfaceData->currentFrame, false);
+
+    // the image of a headless frame was retired with the frame waited on above
+    if (surfaceData->headless)
+    {
+        surfaceData->imageIndex = surfaceData->currentFrame;
+        return;
+    }
+
+    VkResult result = vkAcquireNextImageKHR(vkBackends->device, surfaceData->swapChain, UINT64_MAX, surfaceData->imageAvailableSemaphores[surfaceData->currentFrame], VK_NULL_HANDLE, &surfaceData->imageIndex);
+
+    // the frame still needs an image, acquire again from the recreated swap chain
+    if (result == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        vks::recreateSwapChain(vkBackends, window);
+        result = vkAcquireNextImageKHR(vkBackends->device, surfaceData->swapChain, UINT64_MAX, surfaceData->imageAvailableSemaphores[surfaceData->currentFrame], VK_NULL_HANDLE, &surfaceData->imageIndex);
+    }
+    LVN_CORE_ASSERT(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR, "[vulkan] failed to acquire swap chain image!");
 }
 
-void vksImplRenderCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance)
-{
-    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
-    vkCmdDraw(surfaceData->commandBuffers[surfaceData->currentFrame], vertexCount, instanceCount, 0, firstInstance);
+void vksImplRenderDrawSubmit(LvnWindow* window)
+{
+    std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+    VulkanBackends* vkBackends = s_VkBackends;
+    VulkanSubmitBatch& batch = s_SubmitBatch;
+
+    if (!batch.active)
+    {
+        VulkanPendingSubmit submit{};
+        vks::prepareFrameSubmit(vkBackends, window, &submit);
+        vks::submitFrames(vkBackends, &submit, 1);
+        return;
+    }
+
+    // a window submitted twice in one batch presents its first frame before the second is queued
+    vks::flushSubmitBatch(vkBackends, window);
+
+    VulkanPendingSubmit submit{};
+    vks::prepareFrameSubmit(vkBackends, window, &submit);
+    batch.submits.push_back(submit);
 }
 
-void vksImplRenderCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance)
+void vksImplRenderBeginSubmitBatch()
 {
-    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
-    vkCmdDrawIndexed(surfaceData->commandBuffers[surfaceData->currentFrame], indexCount, instanceCount, 0, 0, firstInstance);
+    VulkanSubmitBatch& batch = s_SubmitBatch;
+    if (batch.active)
+    {
+        LVN_CORE_WARN("[vulkan] renderBeginSubmitBatch() called while a submit batch is already open on this thread, the open batch is kept");
+        return;
+    }
+
+    batch.active = true;
+    batch.submits.clear();
 }
 
-void vksImplRenderCmdSetStencilReference(uint32_t reference)
+void vksImplRenderEndSubmitBatch()
 {
+    std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+    VulkanSubmitBatch& batch = s_SubmitBatch;
+
+    if (!batch.submits.empty())
+        vks::submitFrames(s_VkBackends, batch.submits.data(), batch.submits.size());
 
+    batch.submits.clear();
+    batch.active = false;
 }
 
-void vksImplRenderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask)
+void vksImplRenderBeginCommandRecording(LvnWindow* window)
 {
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = 0;
+    beginInfo.pInheritanceInfo = nullptr;
+
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    vkResetCommandBuffer(surfaceData->commandBuffers[surfaceData->currentFrame], 0);
+    LVN_CORE_CALL_ASSERT(vkBeginCommandBuffer(surfaceData->commandBuffers[surfaceData->currentFrame], &beginInfo) == VK_SUCCESS, "[vulkan] failed to begin recording command buffer!");
 
+    // queries of the frame are reset before any timestamp of the frame is written, the previous results were read when the frame began
+    if (surfaceData->timestampQueryPool != VK_NULL_HANDLE)
+        vkCmdResetQueryPool(surfaceData->commandBuffers[surfaceData->currentFrame], surfaceData->timestampQueryPool, surfaceData->currentFrame * LVN_VULKAN_MAX_TIMESTAMP_QUERIES, LVN_VULKAN_MAX_TIMESTAMP_QUERIES);
 }
 
-void vksImplRenderBeginNextFrame(LvnWindow* window)
+void vksImplRenderEndCommandRecording(LvnWindow* window)
 {
-    GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    LVN_CORE_CALL_ASSERT(vkEndCommandBuffer(surfaceData->commandBuffers[surfaceData->currentFrame]) == VK_SUCCESS, "[vulkan] failed to record command buffer!");
+}
 
+LvnResult vksImplRenderBeginSecondaryCommandRecording(LvnWindow* window, LvnFrameBuffer* frameBuffer)
+{
     VulkanBackends* vkBackends = s_VkBackends;
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
 
-    vkWaitForFences(vkBackends->device, 1, &surfaceData->inFlightFences[surfaceData->currentFrame], VK_TRUE, UINT64_MAX);
-    vkResetFences(vkBackends->device, 1, &surfaceData->inFlightFences[surfaceData->currentFrame]);
-
-    VkResult result = vkAcquireNextImageKHR(vkBackends->device, surfaceData->swapChain, UINT64_MAX, surfaceData->imageAvailableSemaphores[surfaceData->currentFrame], VK_NULL_HANDLE, &surfaceData->imageIndex);
-
-    if (result == VK_ERROR_OUT_OF_DATE_KHR)
+    if (s_SecondaryRecording.window != nullptr)
     {
-        vks::recreateSwapChain(vkBackends, window);
-        return;
+        LVN_CORE_ERROR("[vulkan] the calling thread is already recording a secondary command buffer, end it before beginning another one");
+        return Lvn_Result_Failure;
     }
-    LVN_CORE_ASSERT(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR, "[vulkan] failed to acquire swap chain image!");
-}
 
-void vksImplRenderDrawSubmit(LvnWindow* window)
-{
-    std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+    uint32_t frameIndex = surfaceData->currentFrame;
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
 
-    GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+    {
+        std::lock_guard<std::mutex> lock(s_SecondaryCommandMutex);
 
-    VulkanBackends* vkBackends = s_VkBackends;
-    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+        VulkanThreadCommandPool* threadPool = vks::getThreadCommandPool(vkBackends, surfaceData);
+        if (!threadPool)
+            return Lvn_Result_Failure;
+
+        LvnVector<VkCommandBuffer>& commandBuffers = threadPool->commandBuffers[frameIndex];
+        if (threadPool->usedCounts[frameIndex] == commandBuffers.size())
+        {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = threadPool->commandPools[frameIndex];
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = 1;
 
-    VkPipelineStageFlags waitStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = &surfaceData->imageAvailableSemaphores[surfaceData->currentFrame];
-    submitInfo.pWaitDstStageMask = &waitStages;
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = &surfaceData->renderFinishedSemaphores[surfaceData->imageIndex];
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &surfaceData->commandBuffers[surfaceData->currentFrame];
+            if (vkAllocateCommandBuffers(vkBackends->device, &allocInfo, &commandBuffer) != VK_SUCCESS)
+            {
+                LVN_CORE_ERROR("[vulkan] failed to allocate secondary command buffer <VkCommandBuffer>");
+                return Lvn_Result_Failure;
+            }
 
-    LVN_CORE_CALL_ASSERT(vkQueueSubmit(vkBackends->graphicsQueue, 1, &submitInfo, surfaceData->inFlightFences[surfaceData->currentFrame]) == VK_SUCCESS, "[vulkan] failed to submit draw command buffer!");
+            commandBuffers.push_back(commandBuffer);
+        }
 
+        commandBuffer = commandBuffers[threadPool->usedCounts[frameIndex]++];
+    }
 
-    VkPresentInfoKHR presentInfo{};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = &surfaceData->renderFinishedSemaphores[surfaceData->imageIndex];
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = &surfaceData->swapChain;
-    presentInfo.pImageIndices = &surfaceData->imageIndex;
-    presentInfo.pResults = nullptr;
+    VkExtent2D extent;
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.subpass = 0;
 
-    VkResult result = vkQueuePresentKHR(vkBackends->presentQueue, &presentInfo);
+    // dynamic rendering passes are inherited by their attachment formats
+    VkCommandBufferInheritanceRenderingInfoKHR inheritanceRenderingInfo{};
+    inheritanceRenderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
 
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || surfaceData->frameBufferResized)
+    if (frameBuffer)
     {
-        surfaceData->frameBufferResized = false;
-        vks::recreateSwapChain(vkBackends, window);
+        VulkanFrameBufferData* frameBufferData = static_cast<VulkanFrameBufferData*>(frameBuffer->frameBufferData);
+        inheritanceInfo.renderPass = frameBufferData->renderPass;
+        inheritanceInfo.framebuffer = frameBufferData->framebuffer;
+        extent = { frameBuffer->renderWidth, frameBuffer->renderHeight };
+
+        if (frameBufferData->dynamicRendering)
+        {
+            const VulkanRenderingFormats& formats = frameBufferData->renderingFormats;
+            inheritanceRenderingInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR;
+            inheritanceRenderingInfo.colorAttachmentCount = formats.colorFormats.size();
+            inheritanceRenderingInfo.pColorAttachmentFormats = formats.colorFormats.data();
+            inheritanceRenderingInfo.depthAttachmentFormat = formats.depthFormat;
+            inheritanceRenderingInfo.stencilAttachmentFormat = formats.stencilFormat;
+            inheritanceRenderingInfo.rasterizationSamples = formats.sampleCount;
+            inheritanceInfo.pNext = &inheritanceRenderingInfo;
+        }
     }
     else
     {
-        LVN_CORE_ASSERT(result == VK_SUCCESS, "[vulkan] failed to present swap chain image");
+        inheritanceInfo.renderPass = surfaceData->renderPass;
+        inheritanceInfo.framebuffer = surfaceData->frameBuffers[surfaceData->imageIndex];
+        extent = surfaceData->swapChainExtent;
     }
 
-    // advance to next frame in flight
-    surfaceData->currentFrame = (surfaceData->currentFrame + 1) % vkBackends->maxFramesInFlight;
-}
-
-void vksImplRenderBeginCommandRecording(LvnWindow* window)
-{
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = 0;
-    beginInfo.pInheritanceInfo = nullptr;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
 
-    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
-    vkResetCommandBuffer(surfaceData->commandBuffers[surfaceData->currentFrame], 0);
-    LVN_CORE_CALL_ASSERT(vkBeginCommandBuffer(surfaceData->commandBuffers[surfaceData->currentFrame], &beginInfo) == VK_SUCCESS, "[vulkan] failed to begin recording command buffer!");
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+    {
+        LVN_CORE_ERROR("[vulkan] failed to begin recording secondary command buffer <VkCommandBuffer>");
+        return Lvn_Result_Failure;
+    }
+
+    // dynamic state is not inherited from the primary command buffer, the window pass uses a flipped viewport like the primary does
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = frameBuffer ? 0.0f : static_cast<float>(extent.height);
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = frameBuffer ? static_cast<float>(extent.height) : -static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = { 0, 0 };
+    scissor.extent = extent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    s_SecondaryRecording = { window, frameBuffer, commandBuffer };
+    return Lvn_Result_Success;
 }
 
-void vksImplRenderEndCommandRecording(LvnWindow* window)
+void vksImplRenderEndSecondaryCommandRecording(LvnWindow* window)
 {
+    if (s_SecondaryRecording.window != window)
+    {
+        LVN_CORE_ERROR("[vulkan] the calling thread is not recording a secondary command buffer for window (%p)", window);
+        return;
+    }
+
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
-    LVN_CORE_CALL_ASSERT(vkEndCommandBuffer(surfaceData->commandBuffers[surfaceData->currentFrame]) == VK_SUCCESS, "[vulkan] failed to record command buffer!");
+    LVN_CORE_CALL_ASSERT(vkEndCommandBuffer(s_SecondaryRecording.commandBuffer) == VK_SUCCESS, "[vulkan] failed to record secondary command buffer!");
+
+    {
+        std::lock_guard<std::mutex> lock(s_SecondaryCommandMutex);
+        surfaceData->secondaryCommandBuffers.push_back({ s_SecondaryRecording.commandBuffer, s_SecondaryRecording.frameBuffer });
+    }
+
+    s_SecondaryRecording = VulkanSecondaryRecording{};
 }
 
 void vksImplRenderCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a)
@@ -2550,6 +6029,12 @@ void vksImplRenderCmdBeginRenderPass(LvnWindow* window, float r, float g, float
     renderPassInfo.clearValueCount = ARRAY_LEN(clearColor);
     renderPassInfo.pClearValues = clearColor;
 
+    surfaceData->passFrameBuffer = nullptr;
+
+    // secondary command buffers set their own viewport and scissor
+    if (vks::executeSecondaryCommandBuffers(surfaceData, nullptr, &renderPassInfo))
+        return;
+
     vkCmdBeginRenderPass(surfaceData->commandBuffers[surfaceData->currentFrame], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
     VkViewport viewport{};
@@ -2577,8 +6062,14 @@ void vksImplRenderCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline)
 {
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
 
+    VkCommandBuffer commandBuffer = vks::getRecordingCommandBuffer(window, surfaceData);
     VkPipeline graphicsPipeline = static_cast<VkPipeline>(pipeline->nativePipeline);
-    vkCmdBindPipeline(surfaceData->commandBuffers[surfaceData->currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+    VkPipelineBindPoint bindPoint = pipeline->compute ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
+    vkCmdBindPipeline(commandBuffer, bindPoint, graphicsPipeline);
+
+    VulkanPipelineDynamicState* dynamicState = static_cast<VulkanPipelineDynamicState*>(pipeline->nativeDynamicState);
+    if (dynamicState != nullptr)
+        vks::setPipelineDynamicState(s_VkBackends, commandBuffer, dynamicState);
 }
 
 void vksImplRenderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets)
@@ -2586,10 +6077,14 @@ void vksImplRenderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding,
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
 
     LvnVector<VkBuffer> buffers(bindingCount);
+    LvnVector<VkDeviceSize> offsets(bindingCount);
     for (uint32_t i = 0; i < bindingCount; i++)
+    {
         buffers[i] = static_cast<VkBuffer>(pBuffers[i]->buffer);
+        offsets[i] = pBuffers[i]->baseOffset + (pOffsets ? pOffsets[i] : 0) + pBuffers[i]->regionSize * surfaceData->currentFrame;
+    }
 
-    vkCmdBindVertexBuffers(surfaceData->commandBuffers[surfaceData->currentFrame], firstBinding, bindingCount, buffers.data(), pOffsets);
+    vkCmdBindVertexBuffers(vks::getRecordingCommandBuffer(window, surfaceData), firstBinding, bindingCount, buffers.data(), offsets.data());
 }
 
 void vksImplRenderCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset)
@@ -2597,10 +6092,10 @@ void vksImplRenderCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint6
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
     VkBuffer indexBuffer = static_cast<VkBuffer>(buffer->buffer);
 
-    vkCmdBindIndexBuffer(surfaceData->commandBuffers[surfaceData->currentFrame], indexBuffer, offset, VK_INDEX_TYPE_UINT32);
+    vkCmdBindIndexBuffer(vks::getRecordingCommandBuffer(window, surfaceData), indexBuffer, buffer->baseOffset + offset + buffer->regionSize * surfaceData->currentFrame, VK_INDEX_TYPE_UINT32);
 }
 
-void vksImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets)
+void vksImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets)
 {
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
     VkPipelineLayout pipelineLayout = static_cast<VkPipelineLayout>(pipeline->nativePipelineLayout);
@@ -2611,11 +6106,111 @@ void vksImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline
         descriptorSets[i] = static_cast<VkDescriptorSet>(pDescriptorSets[i]->descriptorSets[surfaceData->currentFrame]);
     }
 
-    vkCmdBindDescriptorSets(surfaceData->commandBuffers[surfaceData->currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, firstSetIndex, descriptorSetCount, descriptorSets.data(), 0, nullptr);
+    VkPipelineBindPoint bindPoint = pipeline->compute ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
+    vkCmdBindDescriptorSets(vks::getRecordingCommandBuffer(window, surfaceData), bindPoint, pipelineLayout, firstSetIndex, descriptorSetCount, descriptorSets.data(), dynamicOffsetCount, pDynamicOffsets);
+}
+
+void vksImplRenderCmdPushConstants(LvnWindow* window, LvnPipeline* pipeline, LvnShaderStage shaderStage, uint32_t offset, uint32_t size, const void* data)
+{
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    VkPipelineLayout pipelineLayout = static_cast<VkPipelineLayout>(pipeline->nativePipelineLayout);
+
+    VkShaderStageFlags stageFlags = vks::getShaderStageFlagEnum(shaderStage);
+    if (pipeline->compute)
+        stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    vkCmdPushConstants(vks::getRecordingCommandBuffer(window, surfaceData), pipelineLayout, stageFlags, offset, size, data);
+}
+
+void vksImplRenderCmdDispatch(LvnWindow* window, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    vkCmdDispatch(vks::getRecordingCommandBuffer(window, surfaceData), groupCountX, groupCountY, groupCountZ);
+}
+
+void vksImplRenderCmdMemoryBarrier(LvnWindow* window, LvnMemoryBarrierFlagBits barriers)
+{
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+
+    VkPipelineStageFlags dstStage;
+    VkAccessFlags dstAccess;
+    vks::getMemoryBarrierDstEnums(barriers, &dstStage, &dstAccess);
+    if (dstStage == 0) { return; }
+
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = dstAccess;
+
+    vkCmdPipelineBarrier(vks::getRecordingCommandBuffer(window, surfaceData), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void vksImplRenderCmdBeginTimestamp(LvnWindow* window, const char* name)
+{
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    if (surfaceData->timestampQueryPool == VK_NULL_HANDLE) { return; }
+
+    uint32_t query = UINT32_MAX;
+
+    {
+        // scopes may be recorded by threads recording secondary command buffers
+        std::lock_guard<std::mutex> lock(s_SecondaryCommandMutex);
+
+        LvnGpuTimestampFrame& frame = surfaceData->timestampFrames[surfaceData->currentFrame];
+
+        LvnGpuTimestampScope scope{};
+        scope.name = name ? name : "";
+        scope.beginQuery = UINT32_MAX;
+        scope.depth = frame.openScopes.size();
+        scope.ended = false;
+
+        // both queries of the scope are reserved at once so an end query is always available
+        if (frame.queryCount + 2 <= LVN_VULKAN_MAX_TIMESTAMP_QUERIES)
+        {
+            scope.beginQuery = frame.queryCount;
+            frame.queryCount += 2;
+            query = surfaceData->currentFrame * LVN_VULKAN_MAX_TIMESTAMP_QUERIES + scope.beginQuery;
+        }
+
+        frame.openScopes.push_back(frame.scopes.size());
+        frame.scopes.push_back(scope);
+    }
+
+    if (query != UINT32_MAX)
+        vkCmdWriteTimestamp(vks::getRecordingCommandBuffer(window, surfaceData), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, surfaceData->timestampQueryPool, query);
+}
+
+void vksImplRenderCmdEndTimestamp(LvnWindow* window)
+{
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    if (surfaceData->timestampQueryPool == VK_NULL_HANDLE) { return; }
+
+    uint32_t query = UINT32_MAX;
+
+    {
+        std::lock_guard<std::mutex> lock(s_SecondaryCommandMutex);
+
+        LvnGpuTimestampFrame& frame = surfaceData->timestampFrames[surfaceData->currentFrame];
+        if (frame.openScopes.empty())
+        {
+            LVN_CORE_ERROR("renderCmdEndTimestamp(LvnWindow*) | no timestamp scope was begun in the current frame of window (%p)", window);
+            return;
+        }
+
+        LvnGpuTimestampScope& scope = frame.scopes[frame.openScopes.back()];
+        frame.openScopes.erase_index(frame.openScopes.size() - 1);
+        scope.ended = true;
+
+        if (scope.beginQuery != UINT32_MAX)
+            query = surfaceData->currentFrame * LVN_VULKAN_MAX_TIMESTAMP_QUERIES + scope.beginQuery + 1;
+    }
+
+    if (query != UINT32_MAX)
+        vkCmdWriteTimestamp(vks::getRecordingCommandBuffer(window, surfaceData), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, surfaceData->timestampQueryPool, query);
 }
 
 void vksImplRenderCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
 {
+    VulkanBackends* vkBackends = s_VkBackends;
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
     VulkanFrameBufferData* frameBufferData = static_cast<VulkanFrameBufferData*>(frameBuffer->frameBufferData);
 
@@ -2624,33 +6219,135 @@ void vksImplRenderCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBu
     renderPassInfo.renderPass = frameBufferData->renderPass;
     renderPassInfo.framebuffer = frameBufferData->framebuffer;
     renderPassInfo.renderArea.offset = { 0, 0 };
-    renderPassInfo.renderArea.extent.width = frameBufferData->width;
-    renderPassInfo.renderArea.extent.height = frameBufferData->height;
+    // a scaled framebuffer only renders into the sub rectangle at the origin, the attachments keep their full size
+    renderPassInfo.renderArea.extent.width = frameBuffer->renderWidth;
+    renderPassInfo.renderArea.extent.height = frameBuffer->renderHeight;
     renderPassInfo.clearValueCount = frameBufferData->clearValues.size();
     renderPassInfo.pClearValues = frameBufferData->clearValues.data();
 
+    surfaceData->passFrameBuffer = frameBuffer;
+
+    if (vks::executeSecondaryCommandBuffers(surfaceData, frameBuffer, &renderPassInfo))
+        return;
+
+    VkCommandBuffer commandBuffer = surfaceData->commandBuffers[surfaceData->currentFrame];
+
     VkViewport viewport{};
     viewport.x = 0.0f;
     viewport.y = 0.0f;
-    viewport.width = static_cast<float>(frameBufferData->width);
-    viewport.height = static_cast<float>(frameBufferData->height);
+    viewport.width = static_cast<float>(frameBuffer->renderWidth);
+    viewport.height = static_cast<float>(frameBuffer->renderHeight);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
     vkCmdSetViewport(surfaceData->commandBuffers[surfaceData->currentFrame], 0, 1, &viewport);
 
     VkRect2D scissor{};
     scissor.offset = { 0, 0 };
-    scissor.extent.width = frameBufferData->width;
-    scissor.extent.height = frameBufferData->height;
+    scissor.extent.width = frameBuffer->renderWidth;
+    scissor.extent.height = frameBuffer->renderHeight;
     vkCmdSetScissor(surfaceData->commandBuffers[surfaceData->currentFrame], 0, 1, &scissor);
 
-    vkCmdBeginRenderPass(surfaceData->commandBuffers[surfaceData->currentFrame], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    if (frameBufferData->dynamicRendering)
+    {
+        VkRenderingInfoKHR renderingInfo = vks::getRenderingInfo(frameBufferData, renderPassInfo.renderArea.extent, 0);
+        vks::transitionRenderingAttachments(commandBuffer, frameBufferData, true);
+        vkBackends->beginRenderingFn(commandBuffer, &renderingInfo);
+        return;
+    }
+
+    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 }
 
 void vksImplRenderCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
 {
+    VulkanBackends* vkBackends = s_VkBackends;
     VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
-    vkCmdEndRenderPass(surfaceData->commandBuffers[surfaceData->currentFrame]);
+    VulkanFrameBufferData* frameBufferData = static_cast<VulkanFrameBufferData*>(frameBuffer->frameBufferData);
+    VkCommandBuffer commandBuffer = surfaceData->commandBuffers[surfaceData->currentFrame];
+
+    if (frameBufferData->dynamicRendering)
+    {
+        vkBackends->endRenderingFn(commandBuffer);
+        vks::transitionRenderingAttachments(commandBuffer, frameBufferData, false);
+        return;
+    }
+
+    vkCmdEndRenderPass(commandBuffer);
+}
+
+void vksImplRenderCmdReadbackFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+    VulkanFrameBufferData* frameBufferData = static_cast<VulkanFrameBufferData*>(frameBuffer->frameBufferData);
+
+    // copies cannot be recorded inside the render passes secondary command buffers continue
+    if (s_SecondaryRecording.window == window)
+    {
+        LVN_CORE_ERROR("[vulkan] cannot read back framebuffer (%p), readbacks must be recorded on the render thread outside of secondary command buffers", frameBuffer);
+        return;
+    }
+
+    for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
+    {
+        if (frameBufferData->colorAttachments[i].index != attachmentIndex)
+            continue;
+
+        VkFormat format = vks::getVulkanColorFormatEnum(frameBufferData->colorAttachments[i].format);
+        uint32_t pixelSize = vks::getColorFormatPixelSize(format);
+        VkDeviceSize size = static_cast<VkDeviceSize>(frameBufferData->width) * frameBufferData->height * pixelSize;
+
+        VulkanReadback* readback = lvn::memNew<VulkanReadback>();
+        if (!vks::acquireReadbackBuffer(vkBackends, size, &readback->buffer))
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create readback buffer <VkBuffer> of %zu bytes when reading back framebuffer (%p)", size, frameBuffer);
+            lvn::memDelete(readback);
+            return;
+        }
+
+        readback->frame = surfaceData->currentFrame;
+        readback->func = func;
+        readback->userData = userData;
+        readback->data.size = size;
+        readback->data.width = frameBufferData->width;
+        readback->data.height = frameBufferData->height;
+        readback->data.pixelSize = pixelSize;
+        readback->data.format = frameBufferData->colorAttachments[i].format;
+        readback->data.frameIndex = vkBackends->submitIndex;
+
+        VkCommandBuffer commandBuffer = surfaceData->commandBuffers[surfaceData->currentFrame];
+
+        // multisampled attachments are read from the image they resolve to
+        VkImage image = frameBufferData->multisampling ? frameBufferData->msaaColorImages[i] : frameBufferData->colorImages[i];
+
+        vks::cmdImageBarrier(commandBuffer, image, 0, 1, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { frameBufferData->width, frameBufferData->height, 1 };
+        vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback->buffer.buffer, 1, &region);
+
+        vks::cmdImageBarrier(commandBuffer, image, 0, 1, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_ACCESS_TRANSFER_READ_BIT, 0,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+        // the copy has to be visible to the host once the frame's fence signals
+        VkMemoryBarrier hostBarrier{};
+        hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+
+        surfaceData->pendingReadbacks.push_back(readback);
+        return;
+    }
+
+    LVN_CORE_ERROR("[vulkan] cannot read back framebuffer (%p), attachment index (%u) is not a color attachment", frameBuffer, attachmentIndex);
 }
 
 LvnResult vksImplCreateShaderFromSrc(LvnShader* shader, const LvnShaderCreateInfo* createInfo)
@@ -2658,16 +6355,29 @@ LvnResult vksImplCreateShaderFromSrc(LvnShader* shader, const LvnShaderCreateInf
 #ifdef LVN_INCLUDE_GLSLANG_SRC_COMPILE_SUPPORT
     VulkanBackends* vkBackends = s_VkBackends;
 
+    if (!createInfo->computeSrc.empty())
+    {
+        LvnVector<uint8_t> compData;
+        if (vks::getShaderSPIRV(vkBackends, GLSLANG_STAGE_COMPUTE, createInfo->computeSrc.c_str(), compData) == Lvn_Result_Failure)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create compute shader module for shader at (%p)", shader);
+            return Lvn_Result_Failure;
+        }
+
+        shader->nativeComputeShaderModule = vks::createShaderModule(vkBackends, compData.data(), compData.size());
+        return Lvn_Result_Success;
+    }
+
     LvnVector<uint8_t> vertData;
     LvnVector<uint8_t> fragData;
 
-    if (vks::compileShaderToSPIRV(GLSLANG_STAGE_VERTEX, createInfo->vertexSrc.c_str(), vertData) == Lvn_Result_Failure)
+    if (vks::getShaderSPIRV(vkBackends, GLSLANG_STAGE_VERTEX, createInfo->vertexSrc.c_str(), vertData) == Lvn_Result_Failure)
     {
         LVN_CORE_ERROR("[vulkan] failed to create vertex shader module for shader at (%p)", shader);
         return Lvn_Result_Failure;
     }
 
-    if (vks::compileShaderToSPIRV(GLSLANG_STAGE_FRAGMENT, createInfo->fragmentSrc.c_str(), fragData) == Lvn_Result_Failure)
+    if (vks::getShaderSPIRV(vkBackends, GLSLANG_STAGE_FRAGMENT, createInfo->fragmentSrc.c_str(), fragData) == Lvn_Result_Failure)
     {
         LVN_CORE_ERROR("[vulkan] failed to create fragment shader module for shader at (%p)", shader);
         return Lvn_Result_Failure;
@@ -2692,19 +6402,34 @@ LvnResult vksImplCreateShaderFromFileSrc(LvnShader* shader, const LvnShaderCreat
 #ifdef LVN_INCLUDE_GLSLANG_SRC_COMPILE_SUPPORT
     VulkanBackends* vkBackends = s_VkBackends;
 
+    if (!createInfo->computeSrc.empty())
+    {
+        LvnString fileCompSrc = lvn::loadFileSrc(createInfo->computeSrc.c_str());
+
+        LvnVector<uint8_t> compData;
+        if (vks::getShaderSPIRV(vkBackends, GLSLANG_STAGE_COMPUTE, fileCompSrc.c_str(), compData) == Lvn_Result_Failure)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create compute shader module for shader at (%p), filepath: %s", shader, createInfo->computeSrc.c_str());
+            return Lvn_Result_Failure;
+        }
+
+        shader->nativeComputeShaderModule = vks::createShaderModule(vkBackends, compData.data(), compData.size());
+        return Lvn_Result_Success;
+    }
+
     LvnString fileVertSrc = lvn::loadFileSrc(createInfo->vertexSrc.c_str());
     LvnString fileFragSrc = lvn::loadFileSrc(createInfo->fragmentSrc.c_str());
 
     LvnVector<uint8_t> vertData;
     LvnVector<uint8_t> fragData;
 
-    if (vks::compileShaderToSPIRV(GLSLANG_STAGE_VERTEX, fileVertSrc.c_str(), vertData) == Lvn_Result_Failure)
+    if (vks::getShaderSPIRV(vkBackends, GLSLANG_STAGE_VERTEX, fileVertSrc.c_str(), vertData) == Lvn_Result_Failure)
     {
         LVN_CORE_ERROR("[vulkan] failed to create vertex shader module for shader at (%p), filepath: %s", shader, createInfo->vertexSrc.c_str());
         return Lvn_Result_Failure;
     }
 
-    if (vks::compileShaderToSPIRV(GLSLANG_STAGE_FRAGMENT, fileFragSrc.c_str(), fragData) == Lvn_Result_Failure)
+    if (vks::getShaderSPIRV(vkBackends, GLSLANG_STAGE_FRAGMENT, fileFragSrc.c_str(), fragData) == Lvn_Result_Failure)
     {
         LVN_CORE_ERROR("[vulkan] failed to create fragment shader module for shader at (%p), filepath: %s", shader, createInfo->fragmentSrc.c_str());
         return Lvn_Result_Failure;
@@ -2728,6 +6453,13 @@ LvnResult vksImplCreateShaderFromFileBin(LvnShader* shader, const LvnShaderCreat
 {
     VulkanBackends* vkBackends = s_VkBackends;
 
+    if (!createInfo->computeSrc.empty())
+    {
+        LvnData<uint8_t> compbin = lvn::loadFileSrcBin(createInfo->computeSrc.c_str());
+        shader->nativeComputeShaderModule = vks::createShaderModule(vkBackends, compbin.data(), compbin.size());
+        return Lvn_Result_Success;
+    }
+
     LvnData<uint8_t> vertbin = lvn::loadFileSrcBin(createInfo->vertexSrc.c_str());
     LvnData<uint8_t> fragbin = lvn::loadFileSrcBin(createInfo->fragmentSrc.c_str());
 
@@ -2746,6 +6478,7 @@ LvnResult vksImplCreateDescriptorLayout(LvnDescriptorLayout* descriptorLayout, c
 
     LvnVector<VkDescriptorSetLayoutBinding> layoutBindings(createInfo->descriptorBindingCount);
     LvnVector<VkDescriptorPoolSize> poolSizes(createInfo->descriptorBindingCount);
+    LvnVector<VkDescriptorPoolSize> setSizes(createInfo->descriptorBindingCount);
 
     for (uint32_t i = 0; i < createInfo->descriptorBindingCount; i++)
     {
@@ -2759,6 +6492,9 @@ LvnResult vksImplCreateDescriptorLayout(LvnDescriptorLayout* descriptorLayout, c
 
         poolSizes[i].type = descriptorType;
         poolSizes[i].descriptorCount = createInfo->pDescriptorBindings[i].descriptorCount * createInfo->pDescriptorBindings[i].maxAllocations * vkBackends->maxFramesInFlight;
+
+        setSizes[i].type = descriptorType;
+        setSizes[i].descriptorCount = lvn::max(createInfo->pDescriptorBindings[i].descriptorCount, 1u);
     }
 
     VkDescriptorSetLayoutCreateInfo layoutInfo{};
@@ -2773,22 +6509,41 @@ LvnResult vksImplCreateDescriptorLayout(LvnDescriptorLayout* descriptorLayout, c
         return Lvn_Result_Failure;
     }
 
-    VkDescriptorPoolCreateInfo poolInfo{};
-    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = poolSizes.size();
-    poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = createInfo->maxSets * vkBackends->maxFramesInFlight;
-
-    VkDescriptorPool descriptorPool;
+    VulkanDescriptorAllocator* allocator = new VulkanDescriptorAllocator();
+    allocator->setSizes = setSizes;
+    allocator->transientPoolIndex = 0;
+    allocator->updateTemplate.updateTemplate = VK_NULL_HANDLE;
+    allocator->updateTemplate.dataSize = 0;
+    if (vkBackends->descriptorUpdateTemplateSupported)
+        vks::createDescriptorUpdateTemplate(vkBackends, vkDescriptorLayout, layoutBindings, &allocator->updateTemplate);
 
-    if (vkCreateDescriptorPool(vkBackends->device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+    // the first pool keeps the sizes requested by the layout, pools chained after it are sized from the descriptors of one set
+    if (createInfo->maxSets > 0)
     {
-        LVN_CORE_ERROR("[vulkan] failed to create descriptor pool at (%p)", descriptorPool);
-        return Lvn_Result_Failure;
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = poolSizes.size();
+        poolInfo.pPoolSizes = poolSizes.data();
+        poolInfo.maxSets = createInfo->maxSets * vkBackends->maxFramesInFlight;
+
+        VulkanDescriptorPool descriptorPool{};
+        descriptorPool.maxSets = poolInfo.maxSets;
+
+        if (vkCreateDescriptorPool(vkBackends->device, &poolInfo, nullptr, &descriptorPool.pool) != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create descriptor pool at (%p)", descriptorPool.pool);
+            vkDestroyDescriptorSetLayout(vkBackends->device, vkDescriptorLayout, nullptr);
+            delete allocator;
+            return Lvn_Result_Failure;
+        }
+
+        allocator->pools.push_back(descriptorPool);
+        descriptorLayout->stats.poolCount = 1;
+        descriptorLayout->stats.poolSetCapacity = createInfo->maxSets;
     }
 
     descriptorLayout->descriptorLayout = vkDescriptorLayout;
-    descriptorLayout->descriptorPool = descriptorPool;
+    descriptorLayout->descriptorPool = allocator;
 
     return Lvn_Result_Success;
 }
@@ -2798,24 +6553,119 @@ LvnResult vksImplAllocateDescriptorSet(LvnDescriptorSet* descriptorSet, LvnDescr
     VulkanBackends* vkBackends = s_VkBackends;
 
     VkDescriptorSetLayout vkDescriptorLayout = static_cast<VkDescriptorSetLayout>(descriptorLayout->descriptorLayout);
-    VkDescriptorPool descriptorPool = static_cast<VkDescriptorPool>(descriptorLayout->descriptorPool);
+    VulkanDescriptorAllocator* allocator = static_cast<VulkanDescriptorAllocator*>(descriptorLayout->descriptorPool);
+    uint32_t setCount = vkBackends->maxFramesInFlight;
+
+    descriptorSet->descriptorSets.resize(setCount);
+    VkDescriptorSet* pDescriptorSets = (VkDescriptorSet*)descriptorSet->descriptorSets.data();
+
+    std::lock_guard<std::mutex> lock(s_DescriptorMutex);
+
+    VkResult result = VK_ERROR_OUT_OF_POOL_MEMORY;
+    if (!allocator->pools.empty())
+        result = vks::allocateFromDescriptorPool(vkBackends, &allocator->pools.back(), vkDescriptorLayout, setCount, pDescriptorSets);
+
+    // chain a larger pool once the last one is exhausted
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+    {
+        VulkanDescriptorPool descriptorPool;
+        uint32_t maxSets = vks::getNextDescriptorPoolSize(allocator->pools, setCount);
+        if (vks::createDescriptorPool(vkBackends, allocator, maxSets, &descriptorPool) != Lvn_Result_Success)
+            return Lvn_Result_Failure;
+
+        allocator->pools.push_back(descriptorPool);
+        descriptorLayout->stats.poolCount++;
+        descriptorLayout->stats.poolSetCapacity += maxSets / setCount;
+
+        result = vks::allocateFromDescriptorPool(vkBackends, &allocator->pools.back(), vkDescriptorLayout, setCount, pDescriptorSets);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        LVN_CORE_ERROR("[vulkan] failed to allocate descriptor sets <VkDescriptorSet> at (%p)", descriptorSet->descriptorSets.data());
+        return Lvn_Result_Failure;
+    }
+
+    // NOTE: vulkan keeps the pool the sets were allocated from so pending descriptor updates can be dropped with the layout
+    descriptorSet->descriptorPool = allocator->pools.back().pool;
+    descriptorSet->updateTemplate = allocator->updateTemplate.updateTemplate != VK_NULL_HANDLE ? &allocator->updateTemplate : nullptr;
+
+    return Lvn_Result_Success;
+}
+
+LvnResult vksImplAllocateTransientDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    VkDescriptorSetLayout vkDescriptorLayout = static_cast<VkDescriptorSetLayout>(descriptorLayout->descriptorLayout);
+    VulkanDescriptorAllocator* allocator = static_cast<VulkanDescriptorAllocator*>(descriptorLayout->descriptorPool);
+    LvnVector<VulkanDescriptorPool>& pools = allocator->transientPools;
+
+    std::lock_guard<std::mutex> lock(s_DescriptorMutex);
+
+    VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
+    VulkanDescriptorPool* descriptorPool = nullptr;
+
+    // walk the pools from the one used last, pools whose frames have all retired are reset in bulk and reused
+    for (uint32_t i = 0; i < pools.size(); i++)
+    {
+        uint32_t index = (allocator->transientPoolIndex + i) % pools.size();
+        VulkanDescriptorPool& pool = pools[index];
+
+        if (pool.allocatedSets > 0 && pool.lastSubmitIndex <= vkBackends->completedSubmitIndex)
+        {
+            vkResetDescriptorPool(vkBackends->device, pool.pool, 0);
+            descriptorLayout->stats.transientSets -= lvn::min<uint64_t>(pool.allocatedSets, descriptorLayout->stats.transientSets);
+            pool.allocatedSets = 0;
+        }
+
+        if (vks::allocateFromDescriptorPool(vkBackends, &pool, vkDescriptorLayout, 1, &vkDescriptorSet) == VK_SUCCESS)
+        {
+            allocator->transientPoolIndex = index;
+            descriptorPool = &pool;
+            break;
+        }
+    }
+
+    if (!descriptorPool)
+    {
+        VulkanDescriptorPool pool;
+        if (vks::createDescriptorPool(vkBackends, allocator, vks::getNextDescriptorPoolSize(pools, 1), &pool) != Lvn_Result_Success)
+            return Lvn_Result_Failure;
 
-    LvnVector<VkDescriptorSetLayout> layouts(vkBackends->maxFramesInFlight, vkDescriptorLayout);
+        pools.push_back(pool);
+        descriptorLayout->stats.transientPoolCount++;
+        allocator->transientPoolIndex = pools.size() - 1;
+        descriptorPool = &pools.back();
 
-    VkDescriptorSetAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool = descriptorPool;
-    allocInfo.descriptorSetCount = vkBackends->maxFramesInFlight;
-    allocInfo.pSetLayouts = layouts.data();
+        if (vks::allocateFromDescriptorPool(vkBackends, descriptorPool, vkDescriptorLayout, 1, &vkDescriptorSet) != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to allocate transient descriptor set <VkDescriptorSet> from descriptor layout (%p)", descriptorLayout);
+            return Lvn_Result_Failure;
+        }
+    }
 
-    descriptorSet->descriptorSets.resize(vkBackends->maxFramesInFlight);
+    // the set belongs to the submission being recorded
+    descriptorPool->lastSubmitIndex = vkBackends->submitIndex + 1;
 
-    if (vkAllocateDescriptorSets(vkBackends->device, &allocInfo, (VkDescriptorSet*)descriptorSet->descriptorSets.data()) != VK_SUCCESS)
+    // set objects of a pool are reused in order after the pool is reset
+    if (descriptorPool->transientSets.size() < descriptorPool->allocatedSets)
     {
-        LVN_CORE_ERROR("[vulkan] failed to allocate descriptor sets <VkDescriptorSet> at (%p)", descriptorSet->descriptorSets.data());
-        return Lvn_Result_Failure;
+        LvnDescriptorSet* transientSet = lvn::memNew<LvnDescriptorSet>();
+        transientSet->transient = true;
+        descriptorPool->transientSets.push_back(transientSet);
     }
 
+    LvnDescriptorSet* descriptorSetPtr = descriptorPool->transientSets[descriptorPool->allocatedSets - 1];
+    descriptorSetPtr->descriptorSets.resize(vkBackends->maxFramesInFlight);
+    for (uint32_t i = 0; i < vkBackends->maxFramesInFlight; i++)
+        descriptorSetPtr->descriptorSets[i] = vkDescriptorSet; // only the frame being recorded uses the set
+    descriptorSetPtr->descriptorPool = descriptorPool->pool;
+    descriptorSetPtr->updateTemplate = allocator->updateTemplate.updateTemplate != VK_NULL_HANDLE ? &allocator->updateTemplate : nullptr;
+
+    descriptorLayout->stats.transientSets++;
+    *descriptorSet = descriptorSetPtr;
+
     return Lvn_Result_Success;
 }
 
@@ -2847,7 +6697,7 @@ LvnResult vksImplCreatePipeline(LvnPipeline* pipeline, const LvnPipelineCreateIn
         VkVertexInputBindingDescription bindingDescription{};
         bindingDescription.binding = createInfo->pVertexBindingDescriptions[i].binding;
         bindingDescription.stride = createInfo->pVertexBindingDescriptions[i].stride;
-        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        bindingDescription.inputRate = createInfo->pVertexBindingDescriptions[i].inputRate == Lvn_VertexInputRate_Instance ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX;
 
         bindingDescriptions[i] = bindingDescription;
     }
@@ -2889,6 +6739,15 @@ LvnResult vksImplCreatePipeline(LvnPipeline* pipeline, const LvnPipelineCreateIn
         descriptorLayouts[i] = descriptorLayout;
     }
 
+    // push constants
+    LvnVector<VkPushConstantRange> pushConstants(createInfo->pushConstantRangeCount);
+    for (uint32_t i = 0; i < createInfo->pushConstantRangeCount; i++)
+    {
+        pushConstants[i].stageFlags = vks::getShaderStageFlagEnum(createInfo->pPushConstantRanges[i].shaderStage);
+        pushConstants[i].offset = createInfo->pPushConstantRanges[i].offset;
+        pushConstants[i].size = createInfo->pPushConstantRanges[i].size;
+    }
+
     // render pass
     VkRenderPass renderPass = static_cast<VkRenderPass>(createInfo->renderPass->nativeRenderPass);
 
@@ -2898,15 +6757,83 @@ LvnResult vksImplCreatePipeline(LvnPipeline* pipeline, const LvnPipelineCreateIn
     pipelineCreateData.shaderStageCount = ARRAY_LEN(shaderStages);
     pipelineCreateData.vertexInputInfo = vertexInputInfo;
     pipelineCreateData.renderPass = renderPass;
+    pipelineCreateData.renderingFormats = static_cast<const VulkanRenderingFormats*>(createInfo->renderPass->nativeRenderingFormats);
     pipelineCreateData.pipelineSpecification = createInfo->pipelineSpecification != nullptr ? createInfo->pipelineSpecification : &vkBackends->defaultPipelineSpecification;
     pipelineCreateData.pDescrptorSetLayouts = descriptorLayouts.data();
     pipelineCreateData.descriptorSetLayoutCount = createInfo->descriptorLayoutCount;
+    pipelineCreateData.pPushConstants = pushConstants.data();
+    pipelineCreateData.pushConstantCount = pushConstants.size();
 
     // create pipeline
     VulkanPipeline vkPipeline = vks::createVulkanPipeline(vkBackends, &pipelineCreateData);
 
     pipeline->nativePipeline = vkPipeline.pipeline;
     pipeline->nativePipelineLayout = vkPipeline.pipelineLayout;
+    pipeline->nativeDynamicState = vkPipeline.dynamicState;
+
+    return Lvn_Result_Success;
+}
+
+LvnResult vksImplCreateComputePipeline(LvnPipeline* pipeline, const LvnComputePipelineCreateInfo* createInfo)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    VkShaderModule compShaderModule = static_cast<VkShaderModule>(createInfo->shader->nativeComputeShaderModule);
+    if (compShaderModule == VK_NULL_HANDLE)
+    {
+        LVN_CORE_ERROR("[vulkan] cannot create compute pipeline (%p), shader (%p) was not created with a compute shader source", pipeline, createInfo->shader);
+        return Lvn_Result_Failure;
+    }
+
+    // descriptor layouts
+    LvnVector<VkDescriptorSetLayout> descriptorLayouts(createInfo->descriptorLayoutCount);
+    for (uint32_t i = 0; i < createInfo->descriptorLayoutCount; i++)
+        descriptorLayouts[i] = static_cast<VkDescriptorSetLayout>(createInfo->pDescriptorLayouts[i]->descriptorLayout);
+
+    // push constants
+    LvnVector<VkPushConstantRange> pushConstants(createInfo->pushConstantRangeCount);
+    for (uint32_t i = 0; i < createInfo->pushConstantRangeCount; i++)
+    {
+        pushConstants[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstants[i].offset = createInfo->pPushConstantRanges[i].offset;
+        pushConstants[i].size = createInfo->pPushConstantRanges[i].size;
+    }
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = descriptorLayouts.size();
+    pipelineLayoutInfo.pSetLayouts = descriptorLayouts.empty() ? nullptr : descriptorLayouts.data();
+    pipelineLayoutInfo.pushConstantRangeCount = pushConstants.size();
+    pipelineLayoutInfo.pPushConstantRanges = pushConstants.empty() ? nullptr : pushConstants.data();
+
+    VkPipelineLayout pipelineLayout;
+    if (vkCreatePipelineLayout(vkBackends->device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+    {
+        LVN_CORE_ERROR("[vulkan] failed to create pipeline layout for compute pipeline (%p)", pipeline);
+        return Lvn_Result_Failure;
+    }
+
+    VkPipelineShaderStageCreateInfo compShaderStageInfo{};
+    compShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    compShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    compShaderStageInfo.module = compShaderModule;
+    compShaderStageInfo.pName = "main";
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = compShaderStageInfo;
+    pipelineInfo.layout = pipelineLayout;
+
+    VkPipeline vkPipeline;
+    if (vkCreateComputePipelines(vkBackends->device, vkBackends->pipelineCache, 1, &pipelineInfo, nullptr, &vkPipeline) != VK_SUCCESS)
+    {
+        LVN_CORE_ERROR("[vulkan] failed to create compute pipeline (%p)", pipeline);
+        vkDestroyPipelineLayout(vkBackends->device, pipelineLayout, nullptr);
+        return Lvn_Result_Failure;
+    }
+
+    pipeline->nativePipeline = vkPipeline;
+    pipeline->nativePipelineLayout = pipelineLayout;
 
     return Lvn_Result_Success;
 }
@@ -2934,6 +6861,7 @@ LvnResult vksImplCreateFrameBuffer(LvnFrameBuffer* frameBuffer, const LvnFrameBu
     frameBufferData->hasDepth = createInfo->depthAttachment != nullptr;
     frameBufferData->totalAttachmentCount = createInfo->colorAttachmentCount + (frameBufferData->hasDepth ? 1 : 0);
     frameBufferData->clearValues.resize(frameBufferData->totalAttachmentCount);
+    frameBufferData->dynamicRendering = vkBackends->dynamicRenderingSupported;
 
     LvnVector<VkAttachmentDescription> attachmentDescriptions(frameBufferData->totalAttachmentCount);
 
@@ -2950,7 +6878,7 @@ LvnResult vksImplCreateFrameBuffer(LvnFrameBuffer* frameBuffer, const LvnFrameBu
         attchmentDescription.format = colorFormat;
         attchmentDescription.samples = frameBufferData->sampleCount;
         attchmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attchmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attchmentDescription.storeOp = frameBufferData->multisampling ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE; // multisampled color is only read through its resolve attachment
         attchmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         attchmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         attchmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -2970,11 +6898,11 @@ LvnResult vksImplCreateFrameBuffer(LvnFrameBuffer* frameBuffer, const LvnFrameBu
         attchmentDescription.format = vks::getVulkanDepthFormatEnum(createInfo->depthAttachment->format);
         attchmentDescription.samples = frameBufferData->sampleCount;
         attchmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attchmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attchmentDescription.storeOp = createInfo->depthAttachment->sampled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
         attchmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         attchmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         attchmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attchmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        attchmentDescription.finalLayout = createInfo->depthAttachment->sampled ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
         attachmentDescriptions[createInfo->depthAttachment->index] = attchmentDescription;
         depthReference = { createInfo->depthAttachment->index, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
@@ -3040,24 +6968,48 @@ LvnResult vksImplCreateFrameBuffer(LvnFrameBuffer* frameBuffer, const LvnFrameBu
     dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
     dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
-    // create the renderpass framebuffer
-    VkRenderPassCreateInfo renderPassInfo{};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = attachmentDescriptions.size();
-    renderPassInfo.pAttachments = attachmentDescriptions.data();
-    renderPassInfo.subpassCount = 1;
-    renderPassInfo.pSubpasses = &subpassDescription;
-    renderPassInfo.dependencyCount = ARRAY_LEN(dependencies);
-    renderPassInfo.pDependencies = dependencies;
+    // a sampled depth image is read by later passes and written again by the next use of this pass
+    if (frameBufferData->hasDepth && createInfo->depthAttachment->sampled)
+    {
+        dependencies[0].dstStageMask |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependencies[0].dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].srcStageMask |= VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependencies[1].srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    }
 
-    VkRenderPass renderPass;
-    if (vkCreateRenderPass(vkBackends->device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
+    // create the renderpass framebuffer, with dynamic rendering the pass is described by the attachment formats instead
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    if (frameBufferData->dynamicRendering)
     {
-        LVN_CORE_ERROR("[vulkan] failed to create render pass <VkRenderPass> (%p) when creating framebuffer at (%p)", renderPass, frameBuffer);
-        return Lvn_Result_Failure;
+        VulkanRenderingFormats& formats = frameBufferData->renderingFormats;
+        formats.colorFormats.resize(createInfo->colorAttachmentCount);
+        for (uint32_t i = 0; i < createInfo->colorAttachmentCount; i++)
+            formats.colorFormats[i] = vks::getVulkanColorFormatEnum(createInfo->pColorAttachments[i].format);
+
+        formats.depthFormat = frameBufferData->hasDepth ? vks::getVulkanDepthFormatEnum(createInfo->depthAttachment->format) : VK_FORMAT_UNDEFINED;
+        formats.stencilFormat = frameBufferData->hasDepth && vks::hasStencilComponent(formats.depthFormat) ? formats.depthFormat : VK_FORMAT_UNDEFINED;
+        formats.sampleCount = frameBufferData->sampleCount;
+    }
+    else
+    {
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = attachmentDescriptions.size();
+        renderPassInfo.pAttachments = attachmentDescriptions.data();
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpassDescription;
+        renderPassInfo.dependencyCount = ARRAY_LEN(dependencies);
+        renderPassInfo.pDependencies = dependencies;
+
+        if (vkCreateRenderPass(vkBackends->device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create render pass <VkRenderPass> (%p) when creating framebuffer at (%p)", renderPass, frameBuffer);
+            return Lvn_Result_Failure;
+        }
     }
     frameBufferData->renderPass = renderPass;
     frameBufferData->frameBufferRenderPass.nativeRenderPass = renderPass;
+    frameBufferData->frameBufferRenderPass.nativeRenderingFormats = frameBufferData->dynamicRendering ? &frameBufferData->renderingFormats : nullptr;
 
     // create texture info
     VkSamplerCreateInfo samplerCreateInfo{};
@@ -3084,6 +7036,7 @@ LvnResult vksImplCreateFrameBuffer(LvnFrameBuffer* frameBuffer, const LvnFrameBu
 
     // create actual framebuffer
     vks::createOffscreenFrameBuffer(vkBackends, frameBuffer);
+    vks::trackFrameBufferMemory(vkBackends, frameBufferData, true);
 
     return Lvn_Result_Success;
 }
@@ -3102,6 +7055,8 @@ LvnResult vksImplCreateBuffer(LvnBuffer* buffer, const LvnBufferCreateInfo* crea
         usageFlags |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
     if (createInfo->type & Lvn_BufferType_Storage)
         usageFlags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (createInfo->type & Lvn_BufferType_Indirect)
+        usageFlags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
 
     // if buffer is static, transfer memory to gpu
     if (createInfo->usage == Lvn_BufferUsage_Static)
@@ -3123,35 +7078,101 @@ LvnResult vksImplCreateBuffer(LvnBuffer* buffer, const LvnBufferCreateInfo* crea
             vmaUnmapMemory(vkBackends->vmaAllocator, stagingMemory);
         }
 
-        // create the main buffer to be used
-        vks::createBuffer(vkBackends, &vkBuffer, &bufferMemory, bufferSize, usageFlags, VMA_MEMORY_USAGE_GPU_ONLY);
-        vks::copyBuffer(vkBackends, stagingBuffer, vkBuffer, bufferSize, 0, 0);
+        // create the main buffer to be used, small buffers are packed into a shared pool block
+        if (!vks::allocateBufferRange(vkBackends, buffer, bufferSize, VMA_MEMORY_USAGE_GPU_ONLY))
+        {
+            vks::createBuffer(vkBackends, &vkBuffer, &bufferMemory, bufferSize, usageFlags, VMA_MEMORY_USAGE_GPU_ONLY);
 
-        vkDestroyBuffer(vkBackends->device, stagingBuffer, nullptr);
-        vmaFreeMemory(vkBackends->vmaAllocator, stagingMemory);
+            buffer->buffer = vkBuffer;
+            buffer->bufferMemory = bufferMemory;
+        }
 
-        buffer->buffer = vkBuffer;
-        buffer->bufferMemory = bufferMemory;
+        vks::copyBuffer(vkBackends, stagingBuffer, static_cast<VkBuffer>(buffer->buffer), bufferSize, 0, buffer->baseOffset);
+        vks::releaseStagingBuffer(vkBackends, stagingBuffer, stagingMemory);
     }
-    else // dynamic buffers will have their memory stored on the cpu
+    else if (createInfo->usage == Lvn_BufferUsage_DynamicRing) // ring buffers have one region per frame in flight so the cpu never writes to memory the gpu is reading
     {
         VkBuffer vkBuffer;
         VmaAllocation bufferMemory;
 
-        vks::createBuffer(vkBackends, &vkBuffer, &bufferMemory, bufferSize, usageFlags, VMA_MEMORY_USAGE_CPU_ONLY);
+        VkDeviceSize alignment = vkBackends->deviceProperties.limits.minUniformBufferOffsetAlignment;
+        if (vkBackends->deviceProperties.limits.minStorageBufferOffsetAlignment > alignment)
+            alignment = vkBackends->deviceProperties.limits.minStorageBufferOffsetAlignment;
+        if (alignment < 16)
+            alignment = 16;
+
+        VkDeviceSize regionSize = (bufferSize + alignment - 1) & ~(alignment - 1);
+
+        vks::createBuffer(vkBackends, &vkBuffer, &bufferMemory, regionSize * vkBackends->maxFramesInFlight, usageFlags, VMA_MEMORY_USAGE_CPU_ONLY);
 
         vmaMapMemory(vkBackends->vmaAllocator, bufferMemory, &buffer->bufferMap);
         if (createInfo->data)
+        {
+            for (uint32_t i = 0; i < vkBackends->maxFramesInFlight; i++)
+                memcpy((uint8_t*)buffer->bufferMap + regionSize * i, createInfo->data, bufferSize);
+        }
+
+        buffer->buffer = vkBuffer;
+        buffer->bufferMemory = bufferMemory;
+        buffer->regionSize = regionSize;
+    }
+    else if (createInfo->usage == Lvn_BufferUsage_DynamicDeviceLocal) // device local buffers are updated through a staging buffer with one region per frame in flight
+    {
+        VkBuffer vkBuffer, stagingBuffer;
+        VmaAllocation bufferMemory, stagingMemory;
+
+        if (vks::createBuffer(vkBackends, &stagingBuffer, &stagingMemory, bufferSize * vkBackends->maxFramesInFlight, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY) != Lvn_Result_Success)
+        {
+            LVN_CORE_ERROR("[vulkan] failed to create staging buffer for device local buffer (%p)", buffer);
+            return Lvn_Result_Failure;
+        }
+
+        if (vks::createBuffer(vkBackends, &vkBuffer, &bufferMemory, bufferSize, usageFlags, VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
+        {
+            vkDestroyBuffer(vkBackends->device, stagingBuffer, nullptr);
+            vmaFreeMemory(vkBackends->vmaAllocator, stagingMemory);
+            LVN_CORE_ERROR("[vulkan] failed to create device local buffer (%p)", buffer);
+            return Lvn_Result_Failure;
+        }
+
+        vmaMapMemory(vkBackends->vmaAllocator, stagingMemory, &buffer->bufferMap);
+        if (createInfo->data)
+        {
             memcpy(buffer->bufferMap, createInfo->data, bufferSize);
+            vks::copyBuffer(vkBackends, stagingBuffer, vkBuffer, bufferSize, 0, 0);
+        }
 
         buffer->buffer = vkBuffer;
         buffer->bufferMemory = bufferMemory;
+        buffer->stagingBuffer = stagingBuffer;
+        buffer->stagingMemory = stagingMemory;
+    }
+    else // dynamic buffers will have their memory stored on the cpu
+    {
+        // resizable buffers are reallocated on resize so they always get their own allocation
+        if (createInfo->usage == Lvn_BufferUsage_Resize || !vks::allocateBufferRange(vkBackends, buffer, bufferSize, VMA_MEMORY_USAGE_CPU_ONLY))
+        {
+            VkBuffer vkBuffer;
+            VmaAllocation bufferMemory;
+
+            vks::createBuffer(vkBackends, &vkBuffer, &bufferMemory, bufferSize, usageFlags, VMA_MEMORY_USAGE_CPU_ONLY);
+            vmaMapMemory(vkBackends->vmaAllocator, bufferMemory, &buffer->bufferMap);
+
+            buffer->buffer = vkBuffer;
+            buffer->bufferMemory = bufferMemory;
+        }
+
+        if (createInfo->data)
+            memcpy(buffer->bufferMap, createInfo->data, bufferSize);
     }
 
     buffer->type = createInfo->type;
     buffer->usage = createInfo->usage;
     buffer->size = createInfo->size;
 
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Buffer, static_cast<VmaAllocation>(buffer->bufferMemory), true);
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Buffer, static_cast<VmaAllocation>(buffer->stagingMemory), true);
+
     return Lvn_Result_Success;
 }
 
@@ -3185,7 +7206,7 @@ LvnResult vksImplCreateSampler(LvnSampler* sampler, const LvnSamplerCreateInfo*
     samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     samplerInfo.mipLodBias = 0.0f;
     samplerInfo.minLod = 0.0f;
-    samplerInfo.maxLod = 0.0f;
+    samplerInfo.maxLod = VK_LOD_CLAMP_NONE; // clamped to the mip levels of whichever texture the sampler is used with
 
     VkSampler textureSampler;
 
@@ -3204,49 +7225,24 @@ LvnResult vksImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo*
 {
     VulkanBackends* vkBackends = s_VkBackends;
 
-    VkBuffer stagingBuffer;
-    VmaAllocation stagingBufferMemory;
-    VkDeviceSize imageSize = createInfo->imageData.pixels.memsize();
-
-    vks::createBuffer(vkBackends, &stagingBuffer, &stagingBufferMemory, imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
-
-    void* data;
-    vmaMapMemory(vkBackends->vmaAllocator, stagingBufferMemory, &data);
-    memcpy(data, createInfo->imageData.pixels.data(), imageSize);
-    vmaUnmapMemory(vkBackends->vmaAllocator, stagingBufferMemory);
-
-    VkFormat format = createInfo->format == Lvn_TextureFormat_Unorm ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_SRGB;
-    switch (createInfo->imageData.channels)
+    VkFormat format = vks::getTextureImageFormat(vkBackends, createInfo->imageData, createInfo->format);
+    if (format == VK_FORMAT_UNDEFINED)
     {
-        case 1: { format = createInfo->format == Lvn_TextureFormat_Unorm ? VK_FORMAT_R8_UNORM : VK_FORMAT_R8_SRGB; break; }
-        case 2: { format = createInfo->format == Lvn_TextureFormat_Unorm ? VK_FORMAT_R8G8_UNORM : VK_FORMAT_R8G8_SRGB; break; }
-        case 4: { format = createInfo->format == Lvn_TextureFormat_Unorm ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_SRGB; break; }
+        LVN_CORE_ERROR("[vulkan] failed to create texture (%p), no usable image format for the texture image data", texture);
+        return Lvn_Result_Failure;
     }
 
-    // create texture image
+    // create texture image, uploads the image data and fills the mip chain
     VkImage textureImage;
     VmaAllocation textureImageMemory;
+    uint32_t mipLevels = createInfo->mipLevels;
 
-    if (vks::createImage(vkBackends,
-        &textureImage,
-        &textureImageMemory,
-        createInfo->imageData.width,
-        createInfo->imageData.height,
-        format,
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-        VK_SAMPLE_COUNT_1_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
+    if (vks::createTextureImage(vkBackends, &textureImage, &textureImageMemory, &mipLevels, format, createInfo->imageData, createInfo->pMipImageData) != Lvn_Result_Success)
     {
         LVN_CORE_ERROR("[vulkan] failed to create texture image <VkImage> for texture (%p)", texture);
         return Lvn_Result_Failure;
     }
 
-    // transition buffer to image
-    vks::transitionImageLayout(vkBackends, textureImage, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1);
-    vks::copyBufferToImage(vkBackends, stagingBuffer, textureImage, createInfo->imageData.width, createInfo->imageData.height, 1);
-    vks::transitionImageLayout(vkBackends, textureImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1);
-
 
     // texture image view
     VkImageViewCreateInfo viewInfo{};
@@ -3256,7 +7252,7 @@ LvnResult vksImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo*
     viewInfo.format = format;
     viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.levelCount = mipLevels;
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount = 1;
 
@@ -3294,7 +7290,7 @@ LvnResult vksImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo*
     samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     samplerInfo.mipLodBias = 0.0f;
     samplerInfo.minLod = 0.0f;
-    samplerInfo.maxLod = 0.0f;
+    samplerInfo.maxLod = static_cast<float>(mipLevels);
 
     VkSampler textureSampler;
     if (vkCreateSampler(vkBackends->device, &samplerInfo, nullptr, &textureSampler) != VK_SUCCESS)
@@ -3303,17 +7299,19 @@ LvnResult vksImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo*
         return Lvn_Result_Failure;
     }
 
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Texture, textureImageMemory, true);
+
     texture->image = textureImage;
     texture->imageMemory = textureImageMemory;
     texture->imageView = imageView;
     texture->sampler = textureSampler;
     texture->width = createInfo->imageData.width;
     texture->height = createInfo->imageData.height;
+    texture->channels = createInfo->imageData.channels;
+    texture->mipLevels = mipLevels;
+    texture->compression = createInfo->imageData.compression;
     texture->seperateSampler = false;
 
-    vkDestroyBuffer(vkBackends->device, stagingBuffer, nullptr);
-    vmaFreeMemory(vkBackends->vmaAllocator, stagingBufferMemory);
-
     return Lvn_Result_Success;
 }
 
@@ -3321,217 +7319,78 @@ LvnResult vksImplCreateTextureSampler(LvnTexture* texture, const LvnTextureSampl
 {
     VulkanBackends* vkBackends = s_VkBackends;
 
-    VkBuffer stagingBuffer;
-    VmaAllocation stagingBufferMemory;
-    VkDeviceSize imageSize = createInfo->imageData.pixels.memsize();
-
-    vks::createBuffer(vkBackends, &stagingBuffer, &stagingBufferMemory, imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
-
-    void* data;
-    vmaMapMemory(vkBackends->vmaAllocator, stagingBufferMemory, &data);
-    memcpy(data, createInfo->imageData.pixels.data(), imageSize);
-    vmaUnmapMemory(vkBackends->vmaAllocator, stagingBufferMemory);
-
-    VkFormat format = createInfo->format == Lvn_TextureFormat_Unorm ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_SRGB;
-    switch (createInfo->imageData.channels)
+    VkFormat format = vks::getTextureImageFormat(vkBackends, createInfo->imageData, createInfo->format);
+    if (format == VK_FORMAT_UNDEFINED)
     {
-        case 1: { format = createInfo->format == Lvn_TextureFormat_Unorm ? VK_FORMAT_R8_UNORM : VK_FORMAT_R8_SRGB; break; }
-        case 2: { format = createInfo->format == Lvn_TextureFormat_Unorm ? VK_FORMAT_R8G8_UNORM : VK_FORMAT_R8G8_SRGB; break; }
-        case 4: { format = createInfo->format == Lvn_TextureFormat_Unorm ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_SRGB; break; }
+        LVN_CORE_ERROR("[vulkan] failed to create texture (%p), no usable image format for the texture image data", texture);
+        return Lvn_Result_Failure;
     }
 
-    // create texture image
+    // create texture image, uploads the image data and fills the mip chain
     VkImage textureImage;
     VmaAllocation textureImageMemory;
+    uint32_t mipLevels = createInfo->mipLevels;
 
-    if (vks::createImage(vkBackends,
-        &textureImage,
-        &textureImageMemory,
-        createInfo->imageData.width,
-        createInfo->imageData.height,
-        format,
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-        VK_SAMPLE_COUNT_1_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY) != Lvn_Result_Success)
-    {
-        LVN_CORE_ERROR("[vulkan] failed to create texture image <VkImage> for texture (%p)", texture);
-        return Lvn_Result_Failure;
-    }
-
-    // transition buffer to image
-    vks::transitionImageLayout(vkBackends, textureImage, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1);
-    vks::copyBufferToImage(vkBackends, stagingBuffer, textureImage, createInfo->imageData.width, createInfo->imageData.height, 1);
-    vks::transitionImageLayout(vkBackends, textureImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1);
-
-
-    // texture image view
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = textureImage;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = format;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-
-    VkImageView imageView;
-    if (vkCreateImageView(vkBackends->device, &viewInfo, nullptr, &imageView) != VK_SUCCESS)
-    {
-        LVN_CORE_ERROR("[vulkan] failed to create texture image view <VkImageView> for texture (%p)", texture);
-        return Lvn_Result_Failure;
-    }
-
-    texture->image = textureImage;
-    texture->imageMemory = textureImageMemory;
-    texture->imageView = imageView;
-    texture->sampler = createInfo->sampler->sampler;
-    texture->width = createInfo->imageData.width;
-    texture->height = createInfo->imageData.height;
-    texture->seperateSampler = true;
-
-    vkDestroyBuffer(vkBackends->device, stagingBuffer, nullptr);
-    vmaFreeMemory(vkBackends->vmaAllocator, stagingBufferMemory);
-
-    return Lvn_Result_Success;
-}
-
-LvnResult vksImplCreateCubemap(LvnCubemap* cubemap, const LvnCubemapCreateInfo* createInfo)
-{
-    VulkanBackends* vkBackends = getVulkanBackends();
-    VmaAllocator vmaAllocator = vkBackends->vmaAllocator;
-
-    uint32_t imageWidth = createInfo->posx.width; // Note that all images should have the same width
-    uint32_t imageHeight = createInfo->posx.height; // Note that all images should have the same height
-
-    VkDeviceSize layerSize = createInfo->posx.size; // size of image of one side of cubemap, Note that all images should have the same size
-    VkDeviceSize imageSize = layerSize * 6; // size of total combinded 6 images of cubemap
-
-    const uint8_t* texImages[6] = { createInfo->posx.pixels.data(), createInfo->negx.pixels.data(), createInfo->posy.pixels.data(), createInfo->negy.pixels.data(), createInfo->posz.pixels.data(), createInfo->negz.pixels.data() };
-    LvnVector<uint8_t> texData(imageSize);
-
-    for (uint32_t i = 0; i < 6; i++)
-    {
-        memcpy(texData.data() + layerSize * i, texImages[i], layerSize);
-    }
-
-    VkBuffer stagingBuffer;
-    VmaAllocation stagingBufferMemory;
-
-    vks::createBuffer(vkBackends, &stagingBuffer, &stagingBufferMemory, imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
-
-    void* bufferData;
-    vmaMapMemory(vmaAllocator, stagingBufferMemory, &bufferData);
-    memcpy(bufferData, texData.data(), imageSize);
-    vmaUnmapMemory(vmaAllocator, stagingBufferMemory);
-
-    VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
-
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = imageWidth;
-    imageInfo.extent.height = imageHeight;
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 6; // cubemap has 6 sides
-    imageInfo.format = format;
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
-
-    VkImage cubemapImage;
-    VmaAllocation cubemapImageMemory;
-
-    VmaAllocationCreateInfo allocInfo{};
-    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-
-    if (vmaCreateImage(vmaAllocator, &imageInfo, &allocInfo, &cubemapImage, &cubemapImageMemory, nullptr) != VK_SUCCESS)
-    {
-        LVN_CORE_ERROR("failed to create image <VkImage> when creating cubemap at (%p)", cubemap);
-        return Lvn_Result_Failure;
-    }
-
-    vks::transitionImageLayout(vkBackends, cubemapImage, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 6);
-    vks::copyBufferToImage(vkBackends, stagingBuffer, cubemapImage, imageWidth, imageHeight, 6);
-
-    vks::transitionImageLayout(vkBackends, cubemapImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 6);
-
-    vkDestroyBuffer(vkBackends->device, stagingBuffer, nullptr);
-    vmaFreeMemory(vmaAllocator, stagingBufferMemory);
-
-    // image view
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = cubemapImage;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_CUBE;
-    viewInfo.format = format;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 6;
-
-    VkImageView cubemapImageView;
-    if (vkCreateImageView(vkBackends->device, &viewInfo, nullptr, &cubemapImageView) != VK_SUCCESS)
-    {
-        LVN_CORE_ERROR("failed to create texture image view <VkImageView> when creating cubemap at (%p)", cubemap);
-        return Lvn_Result_Failure;
-    }
-
-    // sampler
-    VkSamplerCreateInfo sampler{};
-    sampler.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-    sampler.magFilter = VK_FILTER_LINEAR;
-    sampler.minFilter = VK_FILTER_LINEAR;
-    sampler.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-    sampler.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-    sampler.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-    sampler.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-    sampler.compareOp = VK_COMPARE_OP_ALWAYS;
-    sampler.mipLodBias = 0.0f;
-    sampler.minLod = 0.0f;
-    sampler.maxLod = 0.0f;
-    sampler.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
-    sampler.maxAnisotropy = 1.0f;
-    if (vkBackends->deviceSupportedFeatures.samplerAnisotropy)
-    {
-        sampler.maxAnisotropy = vkBackends->deviceProperties.limits.maxSamplerAnisotropy;
-        sampler.anisotropyEnable = VK_TRUE;
+    if (vks::createTextureImage(vkBackends, &textureImage, &textureImageMemory, &mipLevels, format, createInfo->imageData, createInfo->pMipImageData) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("[vulkan] failed to create texture image <VkImage> for texture (%p)", texture);
+        return Lvn_Result_Failure;
     }
 
-    VkSampler cubemapSampler;
-    if (vkCreateSampler(vkBackends->device, &sampler, nullptr, &cubemapSampler) != VK_SUCCESS)
+
+    // texture image view
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = textureImage;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = mipLevels;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    VkImageView imageView;
+    if (vkCreateImageView(vkBackends->device, &viewInfo, nullptr, &imageView) != VK_SUCCESS)
     {
-        LVN_CORE_ERROR("failed to create image sampler when creating cubemap at (%p)", cubemap);
+        LVN_CORE_ERROR("[vulkan] failed to create texture image view <VkImageView> for texture (%p)", texture);
         return Lvn_Result_Failure;
     }
 
-    LvnTexture cubemapTexture{};
-    cubemapTexture.image = cubemapImage;
-    cubemapTexture.imageView = cubemapImageView;
-    cubemapTexture.imageMemory = cubemapImageMemory;
-    cubemapTexture.sampler = cubemapSampler;
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Texture, textureImageMemory, true);
 
-    cubemap->textureData = cubemapTexture;
+    texture->image = textureImage;
+    texture->imageMemory = textureImageMemory;
+    texture->imageView = imageView;
+    texture->sampler = createInfo->sampler->sampler;
+    texture->width = createInfo->imageData.width;
+    texture->height = createInfo->imageData.height;
+    texture->channels = createInfo->imageData.channels;
+    texture->mipLevels = mipLevels;
+    texture->compression = createInfo->imageData.compression;
+    texture->seperateSampler = true;
 
     return Lvn_Result_Success;
 }
 
-LvnResult vksImplCreateCubemapHdr(LvnCubemap* cubemap, const LvnCubemapHdrCreateInfo* createInfo)
+LvnResult vksImplCreateCubemap(LvnCubemap* cubemap, const LvnCubemapCreateInfo* createInfo)
 {
     VulkanBackends* vkBackends = getVulkanBackends();
     VmaAllocator vmaAllocator = vkBackends->vmaAllocator;
 
-    uint32_t imageWidth = createInfo->hdr.width;
-    uint32_t imageHeight = createInfo->hdr.height;
-    VkDeviceSize imageSize = createInfo->hdr.size;
+    uint32_t imageWidth = createInfo->posx.width; // Note that all images should have the same width
+    uint32_t imageHeight = createInfo->posx.height; // Note that all images should have the same height
+
+    VkDeviceSize layerSize = createInfo->posx.size; // size of image of one side of cubemap, Note that all images should have the same size
+    VkDeviceSize imageSize = layerSize * 6; // size of total combinded 6 images of cubemap
+
+    const uint8_t* texImages[6] = { createInfo->posx.pixels.data(), createInfo->negx.pixels.data(), createInfo->posy.pixels.data(), createInfo->negy.pixels.data(), createInfo->posz.pixels.data(), createInfo->negz.pixels.data() };
+    LvnVector<uint8_t> texData(imageSize);
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        memcpy(texData.data() + layerSize * i, texImages[i], layerSize);
+    }
 
     VkBuffer stagingBuffer;
     VmaAllocation stagingBufferMemory;
@@ -3540,7 +7399,7 @@ LvnResult vksImplCreateCubemapHdr(LvnCubemap* cubemap, const LvnCubemapHdrCreate
 
     void* bufferData;
     vmaMapMemory(vmaAllocator, stagingBufferMemory, &bufferData);
-    memcpy(bufferData, createInfo->hdr.pixels.data(), imageSize);
+    memcpy(bufferData, texData.data(), imageSize);
     vmaUnmapMemory(vmaAllocator, stagingBufferMemory);
 
     VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
@@ -3574,13 +7433,12 @@ LvnResult vksImplCreateCubemapHdr(LvnCubemap* cubemap, const LvnCubemapHdrCreate
         return Lvn_Result_Failure;
     }
 
-    vks::transitionImageLayout(vkBackends, cubemapImage, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 6);
-    vks::copyBufferToImage(vkBackends, stagingBuffer, cubemapImage, imageWidth, imageHeight, 6);
+    vks::transitionImageLayout(vkBackends, cubemapImage, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 6, 1);
+    vks::copyBufferToImage(vkBackends, stagingBuffer, 0, cubemapImage, imageWidth, imageHeight, 0, 6);
 
-    vks::transitionImageLayout(vkBackends, cubemapImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 6);
+    vks::transitionImageLayout(vkBackends, cubemapImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 6, 1);
 
-    vkDestroyBuffer(vkBackends->device, stagingBuffer, nullptr);
-    vmaFreeMemory(vmaAllocator, stagingBufferMemory);
+    vks::releaseStagingBuffer(vkBackends, stagingBuffer, stagingBufferMemory);
 
     // image view
     VkImageViewCreateInfo viewInfo{};
@@ -3635,17 +7493,56 @@ LvnResult vksImplCreateCubemapHdr(LvnCubemap* cubemap, const LvnCubemapHdrCreate
     cubemapTexture.imageMemory = cubemapImageMemory;
     cubemapTexture.sampler = cubemapSampler;
 
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Texture, cubemapImageMemory, true);
+
     cubemap->textureData = cubemapTexture;
 
     return Lvn_Result_Success;
 }
 
+LvnResult vksImplCreateEnvironmentMap(LvnEnvironmentMap* environmentMap, const LvnEnvironmentMapBakeInfo* bakeInfo)
+{
+    VulkanBackends* vkBackends = getVulkanBackends();
+
+    uint32_t cubemapMipLevels = lvn::imageGetMipLevelCount(bakeInfo->cubemapSize, bakeInfo->cubemapSize);
+    if (vks::createEnvironmentMapTexture(vkBackends, &environmentMap->cubemap, bakeInfo->cubemapSize, cubemapMipLevels, 6) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    if (!bakeInfo->cubemapOnly)
+    {
+        if (vks::createEnvironmentMapTexture(vkBackends, &environmentMap->irradiance, bakeInfo->irradianceSize, 1, 6) != Lvn_Result_Success
+            || vks::createEnvironmentMapTexture(vkBackends, &environmentMap->prefilter, bakeInfo->prefilterSize, bakeInfo->prefilterMipLevels, 6) != Lvn_Result_Success
+            || vks::createEnvironmentMapTexture(vkBackends, &environmentMap->brdfLut, bakeInfo->brdfLutSize, 1, 1) != Lvn_Result_Success)
+        {
+            vksImplDestroyEnvironmentMap(environmentMap);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    if (bakeInfo->pBakedData)
+    {
+        vks::uploadEnvironmentMap(vkBackends, environmentMap, bakeInfo);
+        return Lvn_Result_Success;
+    }
+
+    if (vks::bakeEnvironmentMap(vkBackends, environmentMap, bakeInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("[vulkan] failed to bake environment map at (%p)", environmentMap);
+        vksImplDestroyEnvironmentMap(environmentMap);
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
 void vksImplDestroyShader(LvnShader* shader)
 {
     VulkanBackends* vkBackends = s_VkBackends;
 
     VkShaderModule vertShaderModule = static_cast<VkShaderModule>(shader->nativeVertexShaderModule);
     VkShaderModule fragShaderModule = static_cast<VkShaderModule>(shader->nativeFragmentShaderModule);
+    VkShaderModule compShaderModule = static_cast<VkShaderModule>(shader->nativeComputeShaderModule);
+    vkDestroyShaderModule(vkBackends->device, compShaderModule, nullptr);
     vkDestroyShaderModule(vkBackends->device, fragShaderModule, nullptr);
     vkDestroyShaderModule(vkBackends->device, vertShaderModule, nullptr);
 }
@@ -3655,58 +7552,95 @@ void vksImplDestroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout)
     VulkanBackends* vkBackends = s_VkBackends;
 
     VkDescriptorSetLayout vkDescriptorLayout = static_cast<VkDescriptorSetLayout>(descriptorLayout->descriptorLayout);
-    VkDescriptorPool descriptorPool = static_cast<VkDescriptorPool>(descriptorLayout->descriptorPool);
+    VulkanDescriptorAllocator* allocator = static_cast<VulkanDescriptorAllocator*>(descriptorLayout->descriptorPool);
+
+    LvnVector<VkDescriptorPool> descriptorPools;
+    for (const VulkanDescriptorPool& pool : allocator->pools)
+        descriptorPools.push_back(pool.pool);
+    for (const VulkanDescriptorPool& pool : allocator->transientPools)
+        descriptorPools.push_back(pool.pool);
+
+    // drop descriptor writes still waiting on sets allocated from the pools of this layout
+    {
+        std::lock_guard<std::mutex> lock(s_DeletionMutex);
+        for (uint32_t i = 0; i < vkBackends->pendingDescriptorUpdates.size(); i++)
+        {
+            LvnVector<VulkanDescriptorUpdate>& updates = vkBackends->pendingDescriptorUpdates[i];
+            for (uint32_t j = 0; j < updates.size();)
+            {
+                if (descriptorPools.contains(updates[j].descriptorPool))
+                    updates.erase_index(j);
+                else
+                    j++;
+            }
+        }
+    }
 
-    vkDestroyDescriptorPool(vkBackends->device, descriptorPool, nullptr);
-    vkDestroyDescriptorSetLayout(vkBackends->device, vkDescriptorLayout, nullptr);
+    for (VkDescriptorPool descriptorPool : descriptorPools)
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_DESCRIPTOR_POOL, (uint64_t)descriptorPool, VK_NULL_HANDLE);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, (uint64_t)vkDescriptorLayout, VK_NULL_HANDLE);
+
+    for (VulkanDescriptorPool& pool : allocator->transientPools)
+    {
+        for (LvnDescriptorSet* transientSet : pool.transientSets)
+            lvn::memDelete(transientSet);
+    }
+
+    // templates are only read on the host while writing sets, the gpu never references them
+    if (allocator->updateTemplate.updateTemplate != VK_NULL_HANDLE)
+        vkDestroyDescriptorUpdateTemplate(vkBackends->device, allocator->updateTemplate.updateTemplate, nullptr);
+
+    delete allocator;
 }
 
 void vksImplDestroyPipeline(LvnPipeline* pipeline)
 {
     VulkanBackends* vkBackends = s_VkBackends;
-    vkDeviceWaitIdle(vkBackends->device);
 
     VkPipeline vkPipeline = static_cast<VkPipeline>(pipeline->nativePipeline);
     VkPipelineLayout vkPipelineLayout = static_cast<VkPipelineLayout>(pipeline->nativePipelineLayout);
 
-    vkDestroyPipeline(vkBackends->device, vkPipeline, nullptr);
-    vkDestroyPipelineLayout(vkBackends->device, vkPipelineLayout, nullptr);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_PIPELINE, (uint64_t)vkPipeline, VK_NULL_HANDLE);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_PIPELINE_LAYOUT, (uint64_t)vkPipelineLayout, VK_NULL_HANDLE);
+
+    // only read while recording, command buffers in flight do not reference it
+    delete static_cast<VulkanPipelineDynamicState*>(pipeline->nativeDynamicState);
+    pipeline->nativeDynamicState = nullptr;
 }
 
 void vksImplDestroyFrameBuffer(LvnFrameBuffer* frameBuffer)
 {
     VulkanBackends* vkBackends = s_VkBackends;
-    vkDeviceWaitIdle(vkBackends->device);
 
     VulkanFrameBufferData* frameBufferData = static_cast<VulkanFrameBufferData*>(frameBuffer->frameBufferData);
+    vks::trackFrameBufferMemory(vkBackends, frameBufferData, false);
 
     for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
     {
-        vkDestroyImage(vkBackends->device, frameBufferData->colorImages[i], nullptr);
-        vkDestroyImageView(vkBackends->device, frameBufferData->colorImageViews[i], nullptr);
-        vmaFreeMemory(vkBackends->vmaAllocator, frameBufferData->colorImageMemory[i]);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)frameBufferData->colorImageViews[i], VK_NULL_HANDLE);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)frameBufferData->colorImages[i], frameBufferData->colorImageMemory[i]);
     }
 
     if (frameBufferData->hasDepth)
     {
-        vkDestroyImage(vkBackends->device, frameBufferData->depthImage, nullptr);
-        vkDestroyImageView(vkBackends->device, frameBufferData->depthImageView, nullptr);
-        vmaFreeMemory(vkBackends->vmaAllocator, frameBufferData->depthImageMemory);
+        if (frameBufferData->depthSampleView != frameBufferData->depthImageView)
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)frameBufferData->depthSampleView, VK_NULL_HANDLE);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)frameBufferData->depthImageView, VK_NULL_HANDLE);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)frameBufferData->depthImage, frameBufferData->depthImageMemory);
     }
 
     if (frameBufferData->multisampling)
     {
         for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
         {
-            vkDestroyImage(vkBackends->device, frameBufferData->msaaColorImages[i], nullptr);
-            vkDestroyImageView(vkBackends->device, frameBufferData->msaaColorImageViews[i], nullptr);
-            vmaFreeMemory(vkBackends->vmaAllocator, frameBufferData->msaaColorImageMemory[i]);
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)frameBufferData->msaaColorImageViews[i], VK_NULL_HANDLE);
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)frameBufferData->msaaColorImages[i], frameBufferData->msaaColorImageMemory[i]);
         }
     }
 
-    vkDestroyRenderPass(vkBackends->device, frameBufferData->renderPass, nullptr);
-    vkDestroySampler(vkBackends->device, frameBufferData->sampler, nullptr);
-    vkDestroyFramebuffer(vkBackends->device, frameBufferData->framebuffer, nullptr);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_FRAMEBUFFER, (uint64_t)frameBufferData->framebuffer, VK_NULL_HANDLE);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_RENDER_PASS, (uint64_t)frameBufferData->renderPass, VK_NULL_HANDLE);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_SAMPLER, (uint64_t)frameBufferData->sampler, VK_NULL_HANDLE);
 
     delete frameBufferData;
 }
@@ -3714,68 +7648,265 @@ void vksImplDestroyFrameBuffer(LvnFrameBuffer* frameBuffer)
 void vksImplDestroyBuffer(LvnBuffer* buffer)
 {
     VulkanBackends* vkBackends = s_VkBackends;
-    vkDeviceWaitIdle(vkBackends->device);
+
+    if (buffer->poolBlock != nullptr)
+    {
+        vks::deferFreeBufferRange(vkBackends, static_cast<VulkanBufferPoolBlock*>(buffer->poolBlock), static_cast<VmaVirtualAllocation>(buffer->poolAllocation));
+        return;
+    }
 
     VkBuffer vkBuffer = static_cast<VkBuffer>(buffer->buffer);
     VmaAllocation bufferMemory = static_cast<VmaAllocation>(buffer->bufferMemory);
 
-    if (buffer->usage != Lvn_BufferUsage_Static)
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Buffer, bufferMemory, false);
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Buffer, static_cast<VmaAllocation>(buffer->stagingMemory), false);
+
+    if (buffer->usage == Lvn_BufferUsage_DynamicDeviceLocal)
+    {
+        VkBuffer stagingBuffer = static_cast<VkBuffer>(buffer->stagingBuffer);
+        VmaAllocation stagingMemory = static_cast<VmaAllocation>(buffer->stagingMemory);
+
+        // drop uploads that have not been submitted yet
+        LvnVector<VulkanBufferUpload>& uploads = vkBackends->pendingBufferUploads;
+        for (uint32_t i = 0; i < uploads.size();)
+        {
+            if (uploads[i].dstBuffer == vkBuffer)
+                uploads.erase_index(i);
+            else
+                i++;
+        }
+
+        vmaUnmapMemory(vkBackends->vmaAllocator, stagingMemory);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_BUFFER, (uint64_t)stagingBuffer, stagingMemory);
+    }
+    else if (buffer->usage != Lvn_BufferUsage_Static)
         vmaUnmapMemory(vkBackends->vmaAllocator, bufferMemory);
 
-    vkDestroyBuffer(vkBackends->device, vkBuffer, nullptr);
-    vmaFreeMemory(vkBackends->vmaAllocator, bufferMemory);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_BUFFER, (uint64_t)vkBuffer, bufferMemory);
 }
 
 void vksImplDestroySampler(LvnSampler* sampler)
 {
     VulkanBackends* vkBackends = s_VkBackends;
-    vkDeviceWaitIdle(vkBackends->device);
 
     VkSampler textureSampler = static_cast<VkSampler>(sampler->sampler);
-    vkDestroySampler(vkBackends->device, textureSampler, nullptr);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_SAMPLER, (uint64_t)textureSampler, VK_NULL_HANDLE);
 }
 
 void vksImplDestroyTexture(LvnTexture* texture)
 {
     VulkanBackends* vkBackends = s_VkBackends;
-    vkDeviceWaitIdle(vkBackends->device);
 
     VkImage image = static_cast<VkImage>(texture->image);
     VmaAllocation imageMemory = static_cast<VmaAllocation>(texture->imageMemory);
     VkImageView imageView = static_cast<VkImageView>(texture->imageView);
 
-    vkDestroyImage(vkBackends->device, image, nullptr);
-    vmaFreeMemory(vkBackends->vmaAllocator, imageMemory);;
-    vkDestroyImageView(vkBackends->device, imageView, nullptr);
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Texture, imageMemory, false);
+
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)imageView, VK_NULL_HANDLE);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)image, imageMemory);
 
     if (!texture->seperateSampler)
     {
         VkSampler textureSampler = static_cast<VkSampler>(texture->sampler);
-        vkDestroySampler(vkBackends->device, textureSampler, nullptr);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_SAMPLER, (uint64_t)textureSampler, VK_NULL_HANDLE);
     }
 }
 
 void vksImplDestroyCubemap(LvnCubemap* cubemap)
 {
     VulkanBackends* vkBackends = s_VkBackends;
-    vkDeviceWaitIdle(vkBackends->device);
 
     LvnTexture* texture = &cubemap->textureData;
 
     VkImage image = static_cast<VkImage>(texture->image);
     VmaAllocation imageMemory = static_cast<VmaAllocation>(texture->imageMemory);
     VkImageView imageView = static_cast<VkImageView>(texture->imageView);
+
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Texture, imageMemory, false);
     VkSampler textureSampler = static_cast<VkSampler>(texture->sampler);
 
-    vkDestroyImage(vkBackends->device, image, nullptr);
-    vmaFreeMemory(vkBackends->vmaAllocator, imageMemory);;
-    vkDestroyImageView(vkBackends->device, imageView, nullptr);
-    vkDestroySampler(vkBackends->device, textureSampler, nullptr);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)imageView, VK_NULL_HANDLE);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)image, imageMemory);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_SAMPLER, (uint64_t)textureSampler, VK_NULL_HANDLE);
+}
+
+void vksImplDestroyEnvironmentMap(LvnEnvironmentMap* environmentMap)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    LvnTexture* textures[4] = { &environmentMap->cubemap, &environmentMap->irradiance, &environmentMap->prefilter, &environmentMap->brdfLut };
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        VkImage image = static_cast<VkImage>(textures[i]->image);
+        VmaAllocation imageMemory = static_cast<VmaAllocation>(textures[i]->imageMemory);
+        VkImageView imageView = static_cast<VkImageView>(textures[i]->imageView);
+        VkSampler textureSampler = static_cast<VkSampler>(textures[i]->sampler);
+
+        vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Texture, imageMemory, false);
+
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)imageView, VK_NULL_HANDLE);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)image, imageMemory);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_SAMPLER, (uint64_t)textureSampler, VK_NULL_HANDLE);
+    }
 }
 
 void vksImplBufferUpdateData(LvnBuffer* buffer, void* data, uint64_t size, uint64_t offset)
 {
-    memcpy((uint8_t*)buffer->bufferMap + offset, data, size);
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    // device local buffers stage through per frame regions, regionSize is zero for other buffers that are not ring buffered
+    if (buffer->usage == Lvn_BufferUsage_DynamicDeviceLocal || buffer->regionSize != 0)
+        vks::waitRingRegion(vkBackends);
+
+    if (buffer->usage == Lvn_BufferUsage_DynamicDeviceLocal)
+    {
+        // write to the staging region of the frame recorded next, the copy is recorded on its draw submit
+        uint64_t stagingOffset = buffer->size * vkBackends->currentFrame + offset;
+        memcpy((uint8_t*)buffer->bufferMap + stagingOffset, data, size);
+
+        VulkanBufferUpload upload{};
+        upload.srcBuffer = static_cast<VkBuffer>(buffer->stagingBuffer);
+        upload.dstBuffer = static_cast<VkBuffer>(buffer->buffer);
+        upload.region.srcOffset = stagingOffset;
+        upload.region.dstOffset = offset;
+        upload.region.size = size;
+        vks::pushBufferUpload(vkBackends, upload);
+        return;
+    }
+
+    memcpy((uint8_t*)buffer->bufferMap + buffer->regionSize * vkBackends->currentFrame + offset, data, size);
+}
+
+void* vksImplBufferGetMappedData(LvnBuffer* buffer)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    // only ring buffers are safe to write to directly, the region of the current frame is not read by the gpu until it is submitted
+    if (buffer->usage != Lvn_BufferUsage_DynamicRing || !buffer->bufferMap)
+        return nullptr;
+
+    vks::waitRingRegion(vkBackends);
+    return (uint8_t*)buffer->bufferMap + buffer->regionSize * vkBackends->currentFrame;
+}
+
+void* vksImplBufferMap(LvnBuffer* buffer)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    if (!buffer->bufferMap)
+        return nullptr;
+
+    if (buffer->usage == Lvn_BufferUsage_DynamicDeviceLocal || buffer->regionSize != 0)
+        vks::waitRingRegion(vkBackends);
+
+    // device local buffers are written through the staging region of the frame recorded next
+    if (buffer->usage == Lvn_BufferUsage_DynamicDeviceLocal)
+        return (uint8_t*)buffer->bufferMap + buffer->size * vkBackends->currentFrame;
+
+    return (uint8_t*)buffer->bufferMap + buffer->regionSize * vkBackends->currentFrame;
+}
+
+void vksImplBufferFlushRange(LvnBuffer* buffer, uint64_t offset, uint64_t size)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    if (buffer->usage == Lvn_BufferUsage_DynamicDeviceLocal)
+    {
+        uint64_t stagingOffset = buffer->size * vkBackends->currentFrame + offset;
+        vmaFlushAllocation(vkBackends->vmaAllocator, static_cast<VmaAllocation>(buffer->stagingMemory), stagingOffset, size);
+
+        VulkanBufferUpload upload{};
+        upload.srcBuffer = static_cast<VkBuffer>(buffer->stagingBuffer);
+        upload.dstBuffer = static_cast<VkBuffer>(buffer->buffer);
+        upload.region.srcOffset = stagingOffset;
+        upload.region.dstOffset = offset;
+        upload.region.size = size;
+        vks::pushBufferUpload(vkBackends, upload);
+        return;
+    }
+
+    // flushing is a no-op on coherent memory, pooled buffers flush their range of the shared block allocation
+    VmaAllocation memory = buffer->poolBlock ? static_cast<VulkanBufferPoolBlock*>(buffer->poolBlock)->memory : static_cast<VmaAllocation>(buffer->bufferMemory);
+    vmaFlushAllocation(vkBackends->vmaAllocator, memory, buffer->baseOffset + buffer->regionSize * vkBackends->currentFrame + offset, size);
+}
+
+void vksImplBufferUnmap(LvnBuffer*)
+{
+    // buffer memory stays persistently mapped, written ranges were already flushed
+}
+
+LvnResult vksImplTextureUpdateData(LvnTexture* texture, const void* pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+
+    // texture images are created with one, two or four 8 bit channels, three channel pixels are expanded to rgba
+    uint32_t imageChannels = texture->channels == 3 ? 4 : texture->channels;
+    VkDeviceSize regionSize = (VkDeviceSize)width * height * imageChannels;
+
+    VkBuffer stagingBuffer;
+    VmaAllocation stagingBufferMemory;
+    if (vks::createBuffer(vkBackends, &stagingBuffer, &stagingBufferMemory, regionSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("[vulkan] failed to create staging buffer when updating texture (%p)", texture);
+        return Lvn_Result_Failure;
+    }
+
+    void* data;
+    vmaMapMemory(vkBackends->vmaAllocator, stagingBufferMemory, &data);
+    if (texture->channels == 3)
+        lvn::imageConvertChannels(static_cast<uint8_t*>(data), 4, static_cast<const uint8_t*>(pixels), 3, (uint64_t)width * height);
+    else
+        memcpy(data, pixels, regionSize);
+    vmaUnmapMemory(vkBackends->vmaAllocator, stagingBufferMemory);
+
+    {
+        std::lock_guard<std::mutex> lock(s_UploadMutex);
+        VkCommandBuffer commandBuffer = vks::beginUploadCommands(vkBackends);
+
+        // the upload batch is submitted before the next frame, wait for any earlier frame still sampling the image
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = static_cast<VkImage>(texture->image);
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = { (int32_t)x, (int32_t)y, 0 };
+        region.imageExtent = { width, height, 1 };
+
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, static_cast<VkImage>(texture->image), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    vks::releaseStagingBuffer(vkBackends, stagingBuffer, stagingBufferMemory);
+
+    return Lvn_Result_Success;
 }
 
 void vksImplBufferResize(LvnBuffer* buffer, uint64_t size)
@@ -3786,6 +7917,7 @@ void vksImplBufferResize(LvnBuffer* buffer, uint64_t size)
     VkBuffer vkBuffer = static_cast<VkBuffer>(buffer->buffer);
     VmaAllocation bufferMemory = static_cast<VmaAllocation>(buffer->bufferMemory);
 
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Buffer, bufferMemory, false);
     vkDestroyBuffer(vkBackends->device, vkBuffer, nullptr);
     vmaFreeMemory(vmaAllocator, bufferMemory);
 
@@ -3794,8 +7926,11 @@ void vksImplBufferResize(LvnBuffer* buffer, uint64_t size)
         usageFlags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
     if (buffer->type & Lvn_BufferType_Index)
         usageFlags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    if (buffer->type & Lvn_BufferType_Indirect)
+        usageFlags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
 
     vks::createBuffer(vkBackends, &vkBuffer, &bufferMemory, size, usageFlags, VMA_MEMORY_USAGE_CPU_ONLY);
+    vks::trackResourceMemory(vkBackends, Vulkan_MemoryResource_Buffer, bufferMemory, true);
 
     buffer->buffer = vkBuffer;
     buffer->bufferMemory = bufferMemory;
@@ -3804,54 +7939,25 @@ void vksImplBufferResize(LvnBuffer* buffer, uint64_t size)
 void vksImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count)
 {
     VulkanBackends* vkBackends = s_VkBackends;
-    VkDescriptorSet* descriptorSets = (VkDescriptorSet*)descriptorSet->descriptorSets.data();
-
-    vkDeviceWaitIdle(vkBackends->device);
 
-    for (uint32_t i = 0; i < count; i++)
-    {
-        VkDescriptorBufferInfo bufferInfo{};
-        LvnVector<VkDescriptorImageInfo> imageInfos(pUpdateInfo[i].descriptorCount);
+    std::lock_guard<std::mutex> lock(s_DeletionMutex);
 
-        if (pUpdateInfo[i].descriptorType == Lvn_DescriptorType_ImageSampler ||
-            pUpdateInfo[i].descriptorType == Lvn_DescriptorType_ImageSamplerBindless)
-        {
-            for (uint32_t j = 0; j < pUpdateInfo[i].descriptorCount; j++)
-            {
-                imageInfos[j].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                imageInfos[j].imageView = static_cast<VkImageView>(pUpdateInfo[i].pTextureInfos[j]->imageView);
-                imageInfos[j].sampler = static_cast<VkSampler>(pUpdateInfo[i].pTextureInfos[j]->sampler);
-            }
-        }
+    vks::updateDescriptorSet(vkBackends, descriptorSet, pUpdateInfo, count);
+    vks::writeDescriptorUpdates(vkBackends, vkBackends->descriptorWrites.data(), vkBackends->descriptorWrites.size());
+    vkBackends->descriptorWrites.clear();
+}
 
-        for (uint32_t j = 0; j < vkBackends->maxFramesInFlight; j++)
-        {
-            VkWriteDescriptorSet descriptorWrite{};
-            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrite.dstSet = descriptorSets[j]; // update descriptor set for each frame in flight
-            descriptorWrite.dstBinding = pUpdateInfo[i].binding;
-            descriptorWrite.dstArrayElement = 0;
-            descriptorWrite.descriptorType = vks::getDescriptorTypeEnum(pUpdateInfo[i].descriptorType);
-            descriptorWrite.descriptorCount = pUpdateInfo[i].descriptorCount;
+void vksImplUpdateDescriptorSetsData(const LvnDescriptorSetUpdate* pUpdates, uint32_t count)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
 
-            // if descriptor using uniform buffers
-            if (pUpdateInfo[i].descriptorType == Lvn_DescriptorType_UniformBuffer || pUpdateInfo[i].descriptorType == Lvn_DescriptorType_StorageBuffer)
-            {
-                bufferInfo.buffer = static_cast<VkBuffer>(pUpdateInfo[i].bufferInfo->buffer->buffer);
-                bufferInfo.offset = pUpdateInfo[i].bufferInfo->offset; // offset buffer size for each frame in flight
-                bufferInfo.range = pUpdateInfo[i].bufferInfo->range;
-                descriptorWrite.pBufferInfo = &bufferInfo;
-            }
+    std::lock_guard<std::mutex> lock(s_DeletionMutex);
 
-            // if descriptor using textures
-            else if (pUpdateInfo[i].descriptorType == Lvn_DescriptorType_ImageSampler || pUpdateInfo[i].descriptorType == Lvn_DescriptorType_ImageSamplerBindless)
-            {
-                descriptorWrite.pImageInfo = imageInfos.data();
-            }
+    for (uint32_t i = 0; i < count; i++)
+        vks::updateDescriptorSet(vkBackends, pUpdates[i].descriptorSet, pUpdates[i].pUpdateInfos, pUpdates[i].updateInfoCount);
 
-            vkUpdateDescriptorSets(vkBackends->device, 1, &descriptorWrite, 0, nullptr);
-        }
-    }
+    vks::writeDescriptorUpdates(vkBackends, vkBackends->descriptorWrites.data(), vkBackends->descriptorWrites.size());
+    vkBackends->descriptorWrites.clear();
 }
 
 LvnTexture* vksImplFrameBufferGetImage(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex)
@@ -3871,39 +7977,41 @@ LvnRenderPass* vksImplFrameBufferGetRenderPass(LvnFrameBuffer* frameBuffer)
 void vksImplFrameBufferResize(LvnFrameBuffer* frameBuffer, uint32_t width, uint32_t height)
 {
     VulkanBackends* vkBackends = s_VkBackends;
-    vkDeviceWaitIdle(vkBackends->device);
 
+    // the old images are retired with the frames still using them instead of waiting for the device to go idle
     VulkanFrameBufferData* frameBufferData = static_cast<VulkanFrameBufferData*>(frameBuffer->frameBufferData);
+    vks::trackFrameBufferMemory(vkBackends, frameBufferData, false);
 
     for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
     {
-        vkDestroyImage(vkBackends->device, frameBufferData->colorImages[i], nullptr);
-        vkDestroyImageView(vkBackends->device, frameBufferData->colorImageViews[i], nullptr);
-        vmaFreeMemory(vkBackends->vmaAllocator, frameBufferData->colorImageMemory[i]);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)frameBufferData->colorImageViews[i], VK_NULL_HANDLE);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)frameBufferData->colorImages[i], frameBufferData->colorImageMemory[i]);
     }
 
     if (frameBufferData->hasDepth)
     {
-        vkDestroyImage(vkBackends->device, frameBufferData->depthImage, nullptr);
-        vkDestroyImageView(vkBackends->device, frameBufferData->depthImageView, nullptr);
-        vmaFreeMemory(vkBackends->vmaAllocator, frameBufferData->depthImageMemory);
+        if (frameBufferData->depthSampleView != frameBufferData->depthImageView)
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)frameBufferData->depthSampleView, VK_NULL_HANDLE);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)frameBufferData->depthImageView, VK_NULL_HANDLE);
+        vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)frameBufferData->depthImage, frameBufferData->depthImageMemory);
     }
 
     if (frameBufferData->multisampling)
     {
         for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
         {
-            vkDestroyImage(vkBackends->device, frameBufferData->msaaColorImages[i], nullptr);
-            vkDestroyImageView(vkBackends->device, frameBufferData->msaaColorImageViews[i], nullptr);
-            vmaFreeMemory(vkBackends->vmaAllocator, frameBufferData->msaaColorImageMemory[i]);
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)frameBufferData->msaaColorImageViews[i], VK_NULL_HANDLE);
+            vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_IMAGE, (uint64_t)frameBufferData->msaaColorImages[i], frameBufferData->msaaColorImageMemory[i]);
         }
     }
 
-    vkDestroyFramebuffer(vkBackends->device, frameBufferData->framebuffer, nullptr);
+    vks::deferDestroy(vkBackends, VK_OBJECT_TYPE_FRAMEBUFFER, (uint64_t)frameBufferData->framebuffer, VK_NULL_HANDLE);
+    frameBufferData->framebuffer = VK_NULL_HANDLE;
 
     frameBufferData->width = width;
     frameBufferData->height = height;
     vks::createOffscreenFrameBuffer(vkBackends, frameBuffer);
+    vks::trackFrameBufferMemory(vkBackends, frameBufferData, true);
 }
 
 void vksImplFrameBufferSetClearColor(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, float r, float g, float b, float a)
@@ -3914,6 +8022,72 @@ void vksImplFrameBufferSetClearColor(LvnFrameBuffer* frameBuffer, uint32_t attac
     frameBufferData->clearValues[attachmentIndex].color = {{ r, g, b, a }};
 }
 
+LvnResult vksImplFrameBufferReadPixels(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, void* data, uint64_t size)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+    VulkanFrameBufferData* frameBufferData = static_cast<VulkanFrameBufferData*>(frameBuffer->frameBufferData);
+
+    for (uint32_t i = 0; i < frameBufferData->colorAttachments.size(); i++)
+    {
+        if (frameBufferData->colorAttachments[i].index != attachmentIndex)
+            continue;
+
+        VkFormat format = vks::getVulkanColorFormatEnum(frameBufferData->colorAttachments[i].format);
+        uint32_t pixelSize = vks::getColorFormatPixelSize(format);
+        uint64_t requiredSize = static_cast<uint64_t>(frameBufferData->width) * frameBufferData->height * pixelSize;
+
+        if (size < requiredSize)
+        {
+            LVN_CORE_ERROR("[vulkan] cannot read pixels of framebuffer (%p), data size (%zu) is smaller than the attachment size (%zu)", frameBuffer, size, requiredSize);
+            return Lvn_Result_Failure;
+        }
+
+        // multisampled attachments are read from the image they resolve to
+        VkImage image = frameBufferData->multisampling ? frameBufferData->msaaColorImages[i] : frameBufferData->colorImages[i];
+        return vks::readImagePixels(vkBackends, image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, frameBufferData->width, frameBufferData->height, pixelSize, data);
+    }
+
+    LVN_CORE_ERROR("[vulkan] cannot read pixels of framebuffer (%p), attachment index (%u) is not a color attachment", frameBuffer, attachmentIndex);
+    return Lvn_Result_Failure;
+}
+
+LvnResult vksImplWindowReadPixels(LvnWindow* window, void* data, uint64_t size)
+{
+    VulkanBackends* vkBackends = s_VkBackends;
+    VulkanWindowSurfaceData* surfaceData = static_cast<VulkanWindowSurfaceData*>(window->apiData);
+
+    if (!surfaceData->headless)
+    {
+        LVN_CORE_ERROR("[vulkan] cannot read pixels of window (%p), only headless windows keep their frames readable, render to a framebuffer and use lvn::frameBufferReadPixels instead", window);
+        return Lvn_Result_Failure;
+    }
+
+    uint32_t pixelSize = vks::getColorFormatPixelSize(surfaceData->swapChainImageFormat);
+    uint64_t requiredSize = static_cast<uint64_t>(surfaceData->swapChainExtent.width) * surfaceData->swapChainExtent.height * pixelSize;
+
+    if (size < requiredSize)
+    {
+        LVN_CORE_ERROR("[vulkan] cannot read pixels of window (%p), data size (%zu) is smaller than the window image size (%zu)", window, size, requiredSize);
+        return Lvn_Result_Failure;
+    }
+
+    // a frame still held by a submit batch has not advanced the frame index yet
+    uint32_t lastFrame;
+    {
+        std::lock_guard<std::mutex> lock(s_QueueSubmitMutex);
+        vks::flushSubmitBatch(vkBackends, window);
+        lastFrame = (surfaceData->currentFrame + vkBackends->maxFramesInFlight - 1) % vkBackends->maxFramesInFlight;
+    }
+
+    if (surfaceData->inFlightSubmitIndices[lastFrame] == 0)
+    {
+        LVN_CORE_ERROR("[vulkan] cannot read pixels of window (%p), no frame has been submitted to the window yet", window);
+        return Lvn_Result_Failure;
+    }
+
+    return vks::readImagePixels(vkBackends, surfaceData->swapChainImages[lastFrame], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, surfaceData->swapChainExtent.width, surfaceData->swapChainExtent.height, pixelSize, data);
+}
+
 LvnDepthImageFormat vksImplFindSupportedDepthImageFormat(LvnDepthImageFormat* pDepthImageFormats, uint32_t count)
 {
     VulkanBackends* vkBackends = s_VkBackends;
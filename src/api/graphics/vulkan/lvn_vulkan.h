@@ -10,20 +10,23 @@ namespace lvn
     void vksImplGetPhysicalDevices(LvnPhysicalDevice** pPhysicalDevices, uint32_t* physicalDeviceCount);
     LvnResult vksImplCheckPhysicalDeviceSupport(LvnPhysicalDevice* physicalDevice);
     LvnResult vksImplSetPhysicalDevice(LvnPhysicalDevice* physicalDevice);
+    void vksImplGetMemoryStats(LvnGraphicsMemoryStats* stats);
 
     LvnResult vksImplCreateShaderFromSrc(LvnShader* shader, const LvnShaderCreateInfo* createInfo);
     LvnResult vksImplCreateShaderFromFileSrc(LvnShader* shader, const LvnShaderCreateInfo* createInfo);
     LvnResult vksImplCreateShaderFromFileBin(LvnShader* shader, const LvnShaderCreateInfo* createInfo);
     LvnResult vksImplCreateDescriptorLayout(LvnDescriptorLayout* descriptorLayout, const LvnDescriptorLayoutCreateInfo* createInfo);
     LvnResult vksImplAllocateDescriptorSet(LvnDescriptorSet* descriptorSet, LvnDescriptorLayout* descriptorLayout);
+    LvnResult vksImplAllocateTransientDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout);
     LvnResult vksImplCreatePipeline(LvnPipeline* pipeline, const LvnPipelineCreateInfo* createInfo);
+    LvnResult vksImplCreateComputePipeline(LvnPipeline* pipeline, const LvnComputePipelineCreateInfo* createInfo);
     LvnResult vksImplCreateFrameBuffer(LvnFrameBuffer* frameBuffer, const LvnFrameBufferCreateInfo* createInfo);
     LvnResult vksImplCreateBuffer(LvnBuffer* buffer, const LvnBufferCreateInfo* createInfo);
     LvnResult vksImplCreateSampler(LvnSampler* sampler, const LvnSamplerCreateInfo* createInfo);
     LvnResult vksImplCreateTexture(LvnTexture* texture, const LvnTextureCreateInfo* createInfo);
     LvnResult vksImplCreateTextureSampler(LvnTexture* texture, const LvnTextureSamplerCreateInfo* createInfo);
     LvnResult vksImplCreateCubemap(LvnCubemap* cubemap, const LvnCubemapCreateInfo* createInfo);
-    LvnResult vksImplCreateCubemapHdr(LvnCubemap* cubemap, const LvnCubemapHdrCreateInfo* createInfo);
+    LvnResult vksImplCreateEnvironmentMap(LvnEnvironmentMap* environmentMap, const LvnEnvironmentMapBakeInfo* bakeInfo);
 
     void vksImplDestroyShader(LvnShader* shader);
     void vksImplDestroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout);
@@ -33,33 +36,61 @@ namespace lvn
     void vksImplDestroySampler(LvnSampler* sampler);
     void vksImplDestroyTexture(LvnTexture* texture);
     void vksImplDestroyCubemap(LvnCubemap* cubemap);
+    void vksImplDestroyEnvironmentMap(LvnEnvironmentMap* environmentMap);
 
     void vksImplRenderBeginNextFrame(LvnWindow* window);
     void vksImplRenderDrawSubmit(LvnWindow* window);
+    void vksImplRenderBeginSubmitBatch();
+    void vksImplRenderEndSubmitBatch();
     void vksImplRenderBeginCommandRecording(LvnWindow* window);
     void vksImplRenderEndCommandRecording(LvnWindow* window);
+    LvnResult vksImplRenderBeginSecondaryCommandRecording(LvnWindow* window, LvnFrameBuffer* frameBuffer);
+    void vksImplRenderEndSecondaryCommandRecording(LvnWindow* window);
     void vksImplRenderCmdDraw(LvnWindow* window, uint32_t vertexCount);
     void vksImplRenderCmdDrawIndexed(LvnWindow* window, uint32_t indexCount);
     void vksImplRenderCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance);
     void vksImplRenderCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance);
+    void vksImplRenderCmdDrawIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void vksImplRenderCmdDrawIndexedIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void vksImplRenderCmdDrawIndexedIndirectCount(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, LvnBuffer* countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride);
     void vksImplRenderCmdSetStencilReference(uint32_t reference);
     void vksImplRenderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask);
+    void vksImplRenderCmdSetCullMode(LvnWindow* window, LvnCullFaceMode cullMode);
+    void vksImplRenderCmdSetFrontFace(LvnWindow* window, LvnCullFrontFace frontFace);
+    void vksImplRenderCmdSetPrimitiveTopology(LvnWindow* window, LvnTopologyType topology);
+    void vksImplRenderCmdSetDepthTest(LvnWindow* window, bool enableDepth, bool depthWrite, LvnCompareOperation depthOpCompare);
+    void vksImplRenderCmdSetBlendEnable(LvnWindow* window, uint32_t attachment, bool enable);
+    void vksImplRenderCmdSetScissor(LvnWindow* window, int32_t x, int32_t y, uint32_t width, uint32_t height);
     void vksImplRenderCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a);
     void vksImplRenderCmdEndRenderPass(LvnWindow* window);
     void vksImplRenderCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline);
     void vksImplRenderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets);
     void vksImplRenderCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset);
-    void vksImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets);
+    void vksImplRenderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets);
+    void vksImplRenderCmdPushConstants(LvnWindow* window, LvnPipeline* pipeline, LvnShaderStage shaderStage, uint32_t offset, uint32_t size, const void* data);
+    void vksImplRenderCmdDispatch(LvnWindow* window, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+    void vksImplRenderCmdMemoryBarrier(LvnWindow* window, LvnMemoryBarrierFlagBits barriers);
+    void vksImplRenderCmdBeginTimestamp(LvnWindow* window, const char* name);
+    void vksImplRenderCmdEndTimestamp(LvnWindow* window);
     void vksImplRenderCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer);
     void vksImplRenderCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer);
+    void vksImplRenderCmdReadbackFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData);
 
     void vksImplBufferUpdateData(LvnBuffer* buffer, void* data, uint64_t size, uint64_t offset);
+    void* vksImplBufferGetMappedData(LvnBuffer* buffer);
+    void* vksImplBufferMap(LvnBuffer* buffer);
+    void vksImplBufferFlushRange(LvnBuffer* buffer, uint64_t offset, uint64_t size);
+    void vksImplBufferUnmap(LvnBuffer* buffer);
+    LvnResult vksImplTextureUpdateData(LvnTexture* texture, const void* pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     void vksImplBufferResize(LvnBuffer* buffer, uint64_t size);
     void vksImplUpdateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count);
+    void vksImplUpdateDescriptorSetsData(const LvnDescriptorSetUpdate* pUpdates, uint32_t count);
     LvnTexture* vksImplFrameBufferGetImage(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex);
     LvnRenderPass* vksImplFrameBufferGetRenderPass(LvnFrameBuffer* frameBuffer);
     void vksImplFrameBufferResize(LvnFrameBuffer* frameBuffer, uint32_t width, uint32_t height);
     void vksImplFrameBufferSetClearColor(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, float r, float g, float b, float a);
+    LvnResult vksImplFrameBufferReadPixels(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, void* data, uint64_t size);
+    LvnResult vksImplWindowReadPixels(LvnWindow* window, void* data, uint64_t size);
 
     LvnDepthImageFormat vksImplFindSupportedDepthImageFormat(LvnDepthImageFormat* pDepthImageFormats, uint32_t count);
 }
@@ -6,6 +6,9 @@
 
 #include "levikno_internal.h"
 
+#include <atomic>
+#include <thread>
+
 
 struct VulkanQueueFamilyIndices
 {
@@ -20,6 +23,98 @@ struct VulkanSwapChainSupportDetails
     LvnVector<VkPresentModeKHR> presentModes;
 };
 
+struct VulkanBufferUpload
+{
+    VkBuffer srcBuffer;
+    VkBuffer dstBuffer;
+    VkBufferCopy region;
+};
+
+struct VulkanUploadBatch
+{
+    VkCommandBuffer commandBuffer;
+    VkFence fence;
+    LvnVector<VkBuffer> stagingBuffers;
+    LvnVector<VmaAllocation> stagingMemory;
+    VkDeviceSize stagingSize;
+};
+
+// large buffer that small static and dynamic buffers are sub-allocated from
+struct VulkanBufferPoolBlock
+{
+    VkBuffer buffer;
+    VmaAllocation memory;
+    VmaVirtualBlock virtualBlock; // ranges of the buffer handed out to pooled buffers
+    VmaMemoryUsage memUsage;
+    void* map; // persistently mapped memory of cpu blocks, null for gpu blocks
+    uint32_t allocationCount;
+};
+
+struct VulkanDeferredDeletion
+{
+    VkObjectType type;
+    uint64_t handle;
+    VmaAllocation memory;
+    VulkanBufferPoolBlock* poolBlock; // block a pooled buffer range is returned to, handle is then the range allocation
+    uint64_t submitIndex; // frame submission that must finish before the object can be destroyed
+};
+
+struct VulkanDescriptorUpdate
+{
+    VkDescriptorSet descriptorSet;
+    VkDescriptorPool descriptorPool;
+    uint32_t binding;
+    VkDescriptorType descriptorType;
+    uint32_t descriptorCount;
+    VkDescriptorBufferInfo bufferInfo;
+    LvnVector<VkDescriptorImageInfo> imageInfos;
+};
+
+struct VulkanDescriptorPool
+{
+    VkDescriptorPool pool;
+    uint32_t maxSets;
+    uint32_t allocatedSets;
+    uint64_t lastSubmitIndex; // transient pools: frame submission that last used sets of the pool
+    LvnVector<LvnDescriptorSet*> transientSets; // transient pools: set objects handed out from the pool, reused after it is reset
+};
+
+// update template of a descriptor layout, writes the descriptors of every binding from one packed array of image and buffer infos
+struct VulkanDescriptorUpdateTemplate
+{
+    VkDescriptorUpdateTemplate updateTemplate;
+    LvnVector<VkDescriptorUpdateTemplateEntry> entries; // one entry per binding, offset is the byte offset of its infos in the packed data
+    size_t dataSize;
+};
+
+struct VulkanDescriptorAllocator
+{
+    LvnVector<VkDescriptorPoolSize> setSizes; // descriptors of each type one set needs
+    VulkanDescriptorUpdateTemplate updateTemplate; // null template when the device is below vulkan 1.1 or a binding has no descriptors
+    LvnVector<VulkanDescriptorPool> pools; // pools for persistent sets, a larger pool is chained once the last one is full
+    LvnVector<VulkanDescriptorPool> transientPools; // pools for transient sets, reset in bulk once the frames using them retire
+    uint32_t transientPoolIndex;
+};
+
+// resource types the memory allocated through vma is counted for
+enum VulkanMemoryResource
+{
+    Vulkan_MemoryResource_Buffer,
+    Vulkan_MemoryResource_Texture,
+    Vulkan_MemoryResource_FrameBuffer,
+
+    Vulkan_MemoryResource_Count,
+};
+
+// attachment formats of a framebuffer rendered with dynamic rendering, pipelines made for it work with any framebuffer of the same formats
+struct VulkanRenderingFormats
+{
+    LvnVector<VkFormat> colorFormats;
+    VkFormat depthFormat;
+    VkFormat stencilFormat;
+    VkSampleCountFlagBits sampleCount;
+};
+
 struct VulkanFrameBufferData
 {
     uint32_t width, height;
@@ -30,6 +125,13 @@ struct VulkanFrameBufferData
     VkRenderPass renderPass;
     VkFramebuffer framebuffer;
 
+    // rendered with vkCmdBeginRenderingKHR instead, renderPass and framebuffer stay null and resizes only recreate the images
+    bool dynamicRendering;
+    VulkanRenderingFormats renderingFormats;
+    LvnVector<VkRenderingAttachmentInfoKHR> renderingColorAttachments;
+    VkRenderingAttachmentInfoKHR renderingDepthAttachment;
+    VkRenderingAttachmentInfoKHR renderingStencilAttachment;
+
     LvnVector<LvnFrameBufferColorAttachment> colorAttachments;
     LvnFrameBufferDepthAttachment depthAttachment;
 
@@ -47,11 +149,44 @@ struct VulkanFrameBufferData
 
     VkImage depthImage;
     VkImageView depthImageView;
+    VkImageView depthSampleView; // depth aspect only view used when sampling a depth stencil image, same as depthImageView for depth only formats
     VmaAllocation depthImageMemory;
 
     VkSampler sampler;
 };
 
+struct VulkanThreadCommandPool
+{
+    std::thread::id threadId;
+    LvnVector<VkCommandPool> commandPools; // one pool per frame in flight, reset once that frame has retired
+    LvnVector<LvnVector<VkCommandBuffer>> commandBuffers; // secondary command buffers allocated from each pool, reused every frame
+    LvnVector<uint32_t> usedCounts; // command buffers of each pool handed out since its last reset
+};
+
+struct VulkanSecondaryCommandBuffer
+{
+    VkCommandBuffer commandBuffer;
+    LvnFrameBuffer* frameBuffer; // framebuffer pass continued by the command buffer, null for the pass of the window
+};
+
+// host visible buffer a framebuffer attachment is copied into, stays mapped and is pooled between readbacks
+struct VulkanReadbackBuffer
+{
+    VkBuffer buffer;
+    VmaAllocation memory;
+    VkDeviceSize size;
+    void* mappedData;
+};
+
+struct VulkanReadback
+{
+    VulkanReadbackBuffer buffer;
+    uint32_t frame; // frame in flight the copy was recorded in, complete once that frame is waited on again
+    LvnReadbackFunc func;
+    void* userData;
+    LvnReadbackData data;
+};
+
 struct VulkanWindowSurfaceData
 {
     // core surface/swapchain data
@@ -61,6 +196,8 @@ struct VulkanWindowSurfaceData
     VkExtent2D swapChainExtent;
     LvnVector<VkImage> swapChainImages;
     LvnVector<VkImageView> swapChainImageViews;
+    bool headless; // no surface or swap chain, swapChainImages are offscreen images owned by the window, one per frame in flight
+    LvnVector<VmaAllocation> headlessImageMemory;
 
     // depth resources
     VkImage depthImage;
@@ -74,15 +211,29 @@ struct VulkanWindowSurfaceData
     // command pool recording
     VkCommandPool commandPool;
     LvnVector<VkCommandBuffer> commandBuffers;
+    LvnVector<VkCommandBuffer> uploadCommandBuffers;
+    LvnVector<VulkanThreadCommandPool> threadCommandPools; // pools of the threads recording secondary command buffers
+    LvnVector<VulkanSecondaryCommandBuffer> secondaryCommandBuffers; // ended secondary command buffers waiting for their pass to begin
 
     // synchronization
     LvnVector<VkSemaphore> imageAvailableSemaphores;
     LvnVector<VkSemaphore> renderFinishedSemaphores;
-    LvnVector<VkFence> inFlightFences;
+    VkSemaphore frameTimeline; // timeline semaphore signaled with the submission index of each frame, null when timeline semaphores are not supported
+    LvnVector<VkFence> inFlightFences; // per frame fences used in place of the timeline semaphore
+    LvnVector<uint64_t> inFlightSubmitIndices; // submission index last signaled by each frame in flight
+    uint64_t presentId; // id of the last image presented on the current swap chain, 0 when nothing has been presented yet
+
+    // gpu timestamps, each frame in flight owns LVN_VULKAN_MAX_TIMESTAMP_QUERIES queries of the pool
+    VkQueryPool timestampQueryPool; // null when the device does not support timestamps
+    LvnVector<LvnGpuTimestampFrame> timestampFrames;
+
+    // framebuffer readbacks recorded into frames still in flight
+    LvnVector<VulkanReadback*> pendingReadbacks;
 
     // per frame data
     uint32_t imageIndex;
     uint32_t currentFrame;
+    LvnFrameBuffer* passFrameBuffer; // target of the pass recorded into the primary command buffer, null for the swap chain
     bool frameBufferResized;
 };
 
@@ -90,6 +241,7 @@ struct VulkanPipelineCreateData
 {
     LvnPipelineSpecification* pipelineSpecification;
     VkRenderPass renderPass;
+    const VulkanRenderingFormats* renderingFormats; // used instead of renderPass when it is null
     VkPipelineVertexInputStateCreateInfo vertexInputInfo;
     VkExtent2D* swapChainExtent;
     VkPipelineShaderStageCreateInfo* shaderStages;
@@ -100,10 +252,37 @@ struct VulkanPipelineCreateData
     uint32_t pushConstantCount;
 };
 
+// values of the states a pipeline made dynamic, vulkan leaves them undefined after a bind so they are set again each time the pipeline is bound
+struct VulkanPipelineDynamicState
+{
+    LvnPipelineDynamicStateFlagBits states; // only the states the device could make dynamic
+    VkCullModeFlags cullMode;
+    VkFrontFace frontFace;
+    VkPrimitiveTopology topology;
+    VkBool32 depthTestEnable;
+    VkBool32 depthWriteEnable;
+    VkCompareOp depthCompareOp;
+    LvnVector<VkBool32> blendEnables;
+};
+
 struct VulkanPipeline
 {
     VkPipeline pipeline;
     VkPipelineLayout pipelineLayout;
+    VulkanPipelineDynamicState* dynamicState;
+};
+
+// one compute dispatch of an environment map bake, writing a single level of the destination image
+struct VulkanEnvironmentMapPass
+{
+    VkPipeline pipeline;
+    VkImageView srcView;
+    VkSampler srcSampler;
+    VkImageView dstView;
+    VkDescriptorSet descriptorSet;
+    uint32_t size;
+    uint32_t layerCount;
+    float roughness;
 };
 
 struct VulkanBackends
@@ -120,13 +299,57 @@ struct VulkanBackends
     VulkanQueueFamilyIndices            deviceIndices;
     VkPhysicalDeviceProperties          deviceProperties;
     VkPhysicalDeviceFeatures            deviceSupportedFeatures;
+    bool                                drawIndirectCountSupported; // vulkan 1.2 drawIndirectCount feature
+    bool                                timelineSemaphoreSupported; // vulkan 1.2 timelineSemaphore feature
+    bool                                presentWaitSupported; // VK_KHR_present_id and VK_KHR_present_wait extensions and features
+    bool                                timestampsSupported; // timestampComputeAndGraphics limit, timestamps can be written on the graphics queue
+    bool                                memoryBudgetSupported; // VK_EXT_memory_budget extension, vma reads the heap budgets from the driver
+    bool                                descriptorUpdateTemplateSupported; // vulkan 1.1 descriptor update templates, sets written with every binding of their layout use them
+    bool                                dynamicRenderingSupported; // VK_KHR_dynamic_rendering extension and feature, offscreen framebuffers render without render pass and framebuffer objects
+    PFN_vkWaitForPresentKHR             waitForPresentFn;
+    PFN_vkCmdBeginRenderingKHR          beginRenderingFn;
+    PFN_vkCmdEndRenderingKHR            endRenderingFn;
+    bool                                extendedDynamicStateSupported; // VK_EXT_extended_dynamic_state extension and feature, cull mode, front face, topology and depth test can be dynamic
+    bool                                dynamicBlendEnableSupported; // VK_EXT_extended_dynamic_state3 extension and extendedDynamicState3ColorBlendEnable feature
+    PFN_vkCmdSetCullModeEXT             setCullModeFn;
+    PFN_vkCmdSetFrontFaceEXT            setFrontFaceFn;
+    PFN_vkCmdSetPrimitiveTopologyEXT    setPrimitiveTopologyFn;
+    PFN_vkCmdSetDepthTestEnableEXT      setDepthTestEnableFn;
+    PFN_vkCmdSetDepthWriteEnableEXT     setDepthWriteEnableFn;
+    PFN_vkCmdSetDepthCompareOpEXT       setDepthCompareOpFn;
+    PFN_vkCmdSetColorBlendEnableEXT     setColorBlendEnableFn;
     VkCommandPool                       commandPool;
     VmaAllocator                        vmaAllocator;
+    std::atomic<uint64_t>               resourceMemoryBytes[Vulkan_MemoryResource_Count]; // bytes of the vma allocations owned by each resource type, resources can be created from loader threads
+    std::atomic<uint32_t>               resourceAllocationCount[Vulkan_MemoryResource_Count];
+    LvnVector<VulkanBufferPoolBlock*>   bufferPoolBlocks; // blocks small buffers are packed into, empty blocks are released once their last range retires
+    std::mutex                          bufferPoolMutex;
+    VkPipelineCache                     pipelineCache;
+    LvnString                           pipelineCachePath; // cache file loaded when the device is created and saved when it is destroyed
+    LvnHashMap<uint64_t, LvnVector<uint8_t>> spirvCache; // compiled spirv binaries keyed by the hash of their stage and source
+    LvnString                           shaderCacheDirectory; // directory spirv binaries are also cached to on disk
 
     LvnPipelineSpecification            defaultPipelineSpecification;
     bool                                gammaCorrect;
     uint32_t                            maxFramesInFlight;
+    uint32_t                            frameLatency; // frames the cpu may record ahead of the gpu, at most maxFramesInFlight
+    bool                                waitForPresent; // wait for the previous frame to be presented before beginning a new one
+    uint32_t                            currentFrame; // frame in flight recorded next, advanced at present, indexes the ring buffer and staging regions buffer updates write to
+    LvnWindow*                          ringRegionWindow; // window presented last, its frame that last used the current regions is waited on before the first buffer update ahead of its next frame
+    LvnVector<VulkanBufferUpload>       pendingBufferUploads; // staged device local buffer updates, recorded on the next draw submit
+    VulkanUploadBatch                   uploadBatch; // resource creation copies and layout transitions being recorded
+    LvnVector<VulkanUploadBatch>        submittedUploads; // upload batches waiting on their fence before staging memory is freed
+    uint64_t                            submitIndex; // number of frames submitted to the graphics queue
+    uint64_t                            completedSubmitIndex; // latest frame submission known to have finished on the gpu
+    bool                                recordingFrame; // true between begin next frame and draw submit
+    LvnVector<VulkanDeferredDeletion>   deletionQueue; // destroyed objects waiting for the frames that used them to retire
+    LvnVector<LvnVector<VulkanDescriptorUpdate>> pendingDescriptorUpdates; // descriptor writes per frame in flight, applied once that frame is no longer in use
+    LvnVector<VulkanDescriptorUpdate> descriptorWrites; // scratch of the writes one update call makes now, guarded by the deletion mutex like the pending updates
+    LvnVector<uint8_t> descriptorTemplateData;
     VkFormat                            frameBufferColorFormat;
+    LvnVector<VulkanReadbackBuffer>     readbackBuffers; // free readback buffers, returned by the workers once their callback has run
+    std::mutex                          readbackMutex;
+    LvnJobCounter                       readbackJobs; // readback callbacks queued or running on the workers
 };
 
 
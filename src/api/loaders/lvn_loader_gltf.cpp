@@ -1,13 +1,23 @@
 #include "levikno.h"
 #include "lvn_loaders.h"
 
-#include <future>
 #include <string>
 #include <vector>
+#include <type_traits>
 
 #include "json.h"
 #include "mikktspace.h"
 
+// simd paths of the accessor conversions, only instruction sets the compiler targets by default are used
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LVN_SIMD_SSE2
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define LVN_SIMD_NEON
+#endif
+
 namespace nlm = nlohmann;
 
 enum LvnFileType
@@ -33,11 +43,37 @@ namespace gltfs
         LvnVec3      max;
     };
 
+    // EXT_meshopt_compression of a buffer view, the compressed data is read from its own buffer range
+    struct GLTFMeshoptCompression
+    {
+        int buffer;
+        uint32_t byteOffset;
+        uint32_t byteLength;
+        uint32_t byteStride;
+        uint32_t count;
+        LvnMeshoptMode mode;
+        LvnMeshoptFilter filter;
+    };
+
     struct GLTFBufferView
     {
         int buffer;
         uint32_t byteLength;
         uint32_t byteOffset;
+        uint32_t byteStride; // 0 when the elements are tightly packed
+        bool meshopt;        // compressed with EXT_meshopt_compression, decoded into a buffer of its own before the accessors are read
+        GLTFMeshoptCompression compression;
+    };
+
+    // typed view of an accessor that reads straight from the mapped buffer, elements are byteStride bytes apart
+    struct GLTFAccessorView
+    {
+        const uint8_t* data;
+        uint32_t count;
+        uint32_t components;
+        uint32_t byteStride;
+        int componentType;
+        bool normalized;
     };
 
     struct GLTFTextureInfo
@@ -100,14 +136,21 @@ namespace gltfs
     struct GLTFTangentCalcInfo
     {
         LvnVector<LvnVec4> outTangents;
-        LvnVector<LvnVec3> positions;
-        LvnVector<LvnVec3> normals;
-        LvnVector<LvnVec2> texUVs;
-        LvnVector<uint32_t> indices;
+        const LvnVertex* vertices; // positions, normals and uvs are read from the combined vertices
+        uint64_t vertexCount;
+        const uint32_t* indices;
         int32_t  numFaces;
         int32_t  vertexPerFace;
     };
 
+    // image decoded on the job system, either from a file or from memory within a glb buffer
+    struct GLTFImageJob
+    {
+        LvnString filepath;
+        const uint8_t* data;
+        int length;
+        LvnImageData* image;
+    };
 
     struct GLTFLoadData
     {
@@ -117,6 +160,7 @@ namespace gltfs
 
         LvnVector<int32_t> rootNodes;
         LvnVector<LvnNode> nodes;
+        LvnBin fileData; // mapped glb file, buffers are views into it
         LvnVector<LvnBin> buffers;
         LvnVector<GLTFAccessor> accessors;
         LvnVector<GLTFBufferView> bufferViews;
@@ -124,10 +168,16 @@ namespace gltfs
         LvnVector<GLTFAnimation> animations;
         LvnVector<GLTFSkin> skins;
         LvnVector<LvnImageData> images;
+        LvnVector<LvnVector<LvnImageData>> imageMipLevels;
+        LvnVector<GLTFImageJob> imageJobs;
+        LvnJobCounter imageCounter; // image decode jobs still running, wait on it before the images are read
         LvnVector<LvnSampler*> samplers;
         LvnVector<LvnTexture*> textures;
         LvnVector<LvnBuffer*> meshBuffers;
         LvnVector<LvnMesh> meshes;
+        LvnModelCookData* cook; // records the uploaded resources when the model is loaded to be cooked, nullptr otherwise
+        LvnVertexLayout vertexLayout;
+        LvnMeshOptimizeFlagBits optimize;
 
         LvnSampler* defaultSampler;
         LvnTexture* defaultBaseColorTexture;
@@ -137,164 +187,474 @@ namespace gltfs
         LvnTexture* defaultEmissiveTexture;
     };
 
+    struct GLTFAnimationJob
+    {
+        const GLTFLoadData* gltfData; // only reads the accessors and buffers, which are not written while the meshes load
+        LvnVector<LvnAnimation> animations;
+    };
+
+    // one primitive decoded, optimized and packed on the job system, the worker creates its buffer as soon as the data is built
+    struct GLTFPrimitiveJob
+    {
+        const nlm::json* primitiveNode;
+        LvnPrimitive* primitive;
+        LvnVector<uint8_t> bufferData;
+    };
+
+    struct GLTFMeshJobData
+    {
+        const GLTFLoadData* gltfData;
+        GLTFPrimitiveJob* primitiveJobs;
+    };
+
+    struct GLTFMeshoptJobData
+    {
+        GLTFLoadData* gltfData;
+        const uint32_t* views;   // compressed buffer views
+        const uint32_t* buffers; // decoded buffer of each view
+        uint8_t* results;        // set for the views that decoded
+    };
+
+    enum GLTFJsonTable
+    {
+        GLTF_JsonTable_None,
+        GLTF_JsonTable_Accessors,
+        GLTF_JsonTable_BufferViews,
+        GLTF_JsonTable_Materials,
+        GLTF_JsonTable_Skip, // a table key at the root without an array, its value is dropped
+    };
+
+    // an open object or array within a table, key is the last key read in an object and index is the next element of an array
+    struct GLTFJsonFrame
+    {
+        std::string key;
+        uint32_t index;
+        bool array;
+    };
+
+    // sax handler for nlohmann json, builds the dom like json::parse except for the accessor, buffer view and material arrays
+    // those can hold tens of thousands of elements and are read straight into their tables in the same pass instead
+    struct GLTFJsonParser
+    {
+        nlm::json* root;
+        std::vector<nlm::json*> domStack;
+        nlm::json* domMember;                     // object member the next dom value is written to
+        GLTFLoadData* gltfData;
+        GLTFJsonTable table;                      // table being read, frames[0] is its array
+        GLTFJsonTable pendingTable;               // set by a table key at the root, the table starts if the next value is an array
+        std::vector<GLTFJsonFrame> frames;
+        size_t errorPosition;
+        std::string errorMessage;
+
+        template <typename T>
+        nlm::json* domAdd(T&& value)
+        {
+            if (domStack.empty())
+            {
+                *root = nlm::json(std::forward<T>(value));
+                return root;
+            }
+
+            nlm::json* parent = domStack.back();
+            if (parent->is_array())
+            {
+                parent->emplace_back(std::forward<T>(value));
+                return &parent->back();
+            }
+
+            *domMember = nlm::json(std::forward<T>(value));
+            return domMember;
+        }
+
+        // the open table element and the key path that leads to the value within it
+        void tableValue(double number, const std::string* str)
+        {
+            GLTFJsonFrame& top = frames.back();
+            uint32_t index = top.array ? top.index++ : 0;
+            if (table == GLTF_JsonTable_Skip) { return; }
+
+            // every element of the table array gets an entry so the indices match the file, elements that are not objects keep the defaults
+            if (frames.size() < 2)
+            {
+                tableStartElement();
+                return;
+            }
+
+            uint32_t element = frames[0].index - 1;
+            const std::string& key = frames[1].key;
+
+            if (table == GLTF_JsonTable_Accessors)
+            {
+                GLTFAccessor& accessor = gltfData->accessors[element];
+                if (frames.size() == 2)
+                {
+                    if (key == "bufferView") accessor.bufferView = static_cast<int>(number);
+                    else if (key == "byteOffset") accessor.byteOffset = static_cast<uint32_t>(number);
+                    else if (key == "componentType") accessor.componentType = static_cast<int>(number);
+                    else if (key == "normalized") accessor.normalized = number != 0.0;
+                    else if (key == "count") accessor.count = static_cast<int>(number);
+                    else if (key == "type" && str) accessor.type = *str;
+                }
+                else if (frames.size() == 3 && top.array && index < 3)
+                {
+                    if (key == "min") accessor.min[index] = static_cast<float>(number);
+                    else if (key == "max") accessor.max[index] = static_cast<float>(number);
+                }
+            }
+            else if (table == GLTF_JsonTable_BufferViews)
+            {
+                GLTFBufferView& bufferView = gltfData->bufferViews[element];
+                if (frames.size() == 2)
+                {
+                    if (key == "buffer") bufferView.buffer = static_cast<int>(number);
+                    else if (key == "byteLength") bufferView.byteLength = static_cast<uint32_t>(number);
+                    else if (key == "byteOffset") bufferView.byteOffset = static_cast<uint32_t>(number);
+                    else if (key == "byteStride") bufferView.byteStride = static_cast<uint32_t>(number);
+                }
+                else if (frames.size() == 4 && key == "extensions" && frames[2].key == "EXT_meshopt_compression")
+                {
+                    GLTFMeshoptCompression& compression = bufferView.compression;
+                    const std::string& member = frames[3].key;
+                    bufferView.meshopt = true;
+                    if (member == "buffer") compression.buffer = static_cast<int>(number);
+                    else if (member == "byteOffset") compression.byteOffset = static_cast<uint32_t>(number);
+                    else if (member == "byteLength") compression.byteLength = static_cast<uint32_t>(number);
+                    else if (member == "byteStride") compression.byteStride = static_cast<uint32_t>(number);
+                    else if (member == "count") compression.count = static_cast<uint32_t>(number);
+                    else if (member == "mode" && str)
+                    {
+                        if (*str == "TRIANGLES") compression.mode = Lvn_MeshoptMode_Triangles;
+                        else if (*str == "INDICES") compression.mode = Lvn_MeshoptMode_Indices;
+                        else compression.mode = Lvn_MeshoptMode_Attributes;
+                    }
+                    else if (member == "filter" && str)
+                    {
+                        if (*str == "OCTAHEDRAL") compression.filter = Lvn_MeshoptFilter_Octahedral;
+                        else if (*str == "QUATERNION") compression.filter = Lvn_MeshoptFilter_Quaternion;
+                        else if (*str == "EXPONENTIAL") compression.filter = Lvn_MeshoptFilter_Exponential;
+                        else compression.filter = Lvn_MeshoptFilter_None;
+                    }
+                }
+            }
+            else if (table == GLTF_JsonTable_Materials)
+            {
+                GLTFMatrial& material = gltfData->materials[element];
+                GLTFPbrMetalicRoughness& pbr = material.pbrMetallicRoughness;
+                if (frames.size() == 2)
+                {
+                    if (key == "alphaMode" && str) material.alphaMode = *str;
+                    else if (key == "alphaCutoff") material.alphaCutoff = static_cast<float>(number);
+                    else if (key == "doubleSided") material.doubleSided = number != 0.0;
+                }
+                else if (frames.size() == 3)
+                {
+                    const std::string& member = frames[2].key;
+                    if (key == "emissiveFactor" && top.array && index < 3) material.emissiveFactor[index] = static_cast<float>(number);
+                    else if (key == "normalTexture" && member == "index") material.normalTexture.index = static_cast<int>(number);
+                    else if (key == "occlusionTexture" && member == "index") material.occlusionTexture.index = static_cast<int>(number);
+                    else if (key == "emissiveTexture" && member == "index") material.emissiveTexture.index = static_cast<int>(number);
+                    else if (key == "pbrMetallicRoughness" && member == "metallicFactor") pbr.metallicFactor = static_cast<float>(number);
+                    else if (key == "pbrMetallicRoughness" && member == "roughnessFactor") pbr.roughnessFactor = static_cast<float>(number);
+                }
+                else if (frames.size() == 4 && key == "pbrMetallicRoughness")
+                {
+                    const std::string& member = frames[2].key;
+                    if (member == "baseColorFactor" && top.array && index < 4) pbr.baseColorFactor[index] = static_cast<float>(number);
+                    else if (member == "baseColorTexture" && frames[3].key == "index") pbr.baseColorTexture.index = static_cast<int>(number);
+                    else if (member == "metallicRoughnessTexture" && frames[3].key == "index") pbr.metallicRoughnessTexture.index = static_cast<int>(number);
+                }
+            }
+        }
+        void tableStartElement()
+        {
+            if (table == GLTF_JsonTable_Accessors)
+            {
+                GLTFAccessor accessor{};
+                gltfData->accessors.push_back(accessor);
+            }
+            else if (table == GLTF_JsonTable_BufferViews)
+            {
+                GLTFBufferView bufferView{};
+                gltfData->bufferViews.push_back(bufferView);
+            }
+            else if (table == GLTF_JsonTable_Materials)
+            {
+                // defaults of the gltf specification for any member the material leaves out
+                GLTFMatrial material{};
+                material.pbrMetallicRoughness.baseColorFactor = LvnVec4(1, 1, 1, 1);
+                material.pbrMetallicRoughness.metallicFactor = 1.0f;
+                material.pbrMetallicRoughness.roughnessFactor = 1.0f;
+                material.pbrMetallicRoughness.baseColorTexture.index = -1;
+                material.pbrMetallicRoughness.metallicRoughnessTexture.index = -1;
+                material.normalTexture.index = -1;
+                material.occlusionTexture.index = -1;
+                material.emissiveTexture.index = -1;
+                material.emissiveFactor = LvnVec3(0, 0, 0);
+                material.alphaMode = "OPAQUE";
+                material.alphaCutoff = 0.5f;
+                material.doubleSided = false;
+                gltfData->materials.push_back(material);
+            }
+        }
+        bool startContainer(bool array)
+        {
+            if (pendingTable != GLTF_JsonTable_None)
+            {
+                table = array ? pendingTable : GLTF_JsonTable_Skip;
+                pendingTable = GLTF_JsonTable_None;
+                frames.push_back({ std::string(), 0, array });
+                return true;
+            }
+
+            if (table != GLTF_JsonTable_None)
+            {
+                if (frames.size() == 1 && table != GLTF_JsonTable_Skip)
+                    tableStartElement();
+                if (frames.back().array)
+                    frames.back().index++;
+                frames.push_back({ std::string(), 0, array });
+                return true;
+            }
+
+            domStack.push_back(domAdd(array ? nlm::json::value_t::array : nlm::json::value_t::object));
+            return true;
+        }
+        bool endContainer()
+        {
+            if (table != GLTF_JsonTable_None)
+            {
+                frames.pop_back();
+                if (frames.empty())
+                    table = GLTF_JsonTable_None;
+                return true;
+            }
+
+            domStack.pop_back();
+            return true;
+        }
+        bool value(double number, const std::string* str)
+        {
+            if (pendingTable != GLTF_JsonTable_None) // table key without an array, ignore it
+            {
+                pendingTable = GLTF_JsonTable_None;
+                return true;
+            }
+            if (table != GLTF_JsonTable_None)
+                tableValue(number, str);
+            return true;
+        }
+
+        bool null() { if (table != GLTF_JsonTable_None || pendingTable != GLTF_JsonTable_None) { return value(0.0, nullptr); } domAdd(nullptr); return true; }
+        bool boolean(bool val) { if (table != GLTF_JsonTable_None || pendingTable != GLTF_JsonTable_None) { return value(val ? 1.0 : 0.0, nullptr); } domAdd(val); return true; }
+        bool number_integer(nlm::json::number_integer_t val) { if (table != GLTF_JsonTable_None || pendingTable != GLTF_JsonTable_None) { return value(static_cast<double>(val), nullptr); } domAdd(val); return true; }
+        bool number_unsigned(nlm::json::number_unsigned_t val) { if (table != GLTF_JsonTable_None || pendingTable != GLTF_JsonTable_None) { return value(static_cast<double>(val), nullptr); } domAdd(val); return true; }
+        bool number_float(nlm::json::number_float_t val, const nlm::json::string_t&) { if (table != GLTF_JsonTable_None || pendingTable != GLTF_JsonTable_None) { return value(val, nullptr); } domAdd(val); return true; }
+        bool string(nlm::json::string_t& val) { if (table != GLTF_JsonTable_None || pendingTable != GLTF_JsonTable_None) { return value(0.0, &val); } domAdd(std::move(val)); return true; }
+        bool binary(nlm::json::binary_t& val) { if (table != GLTF_JsonTable_None || pendingTable != GLTF_JsonTable_None) { return value(0.0, nullptr); } domAdd(nlm::json::binary(std::move(val))); return true; }
+        bool start_object(std::size_t) { return startContainer(false); }
+        bool start_array(std::size_t) { return startContainer(true); }
+        bool end_object() { return endContainer(); }
+        bool end_array() { return endContainer(); }
+
+        bool key(nlm::json::string_t& val)
+        {
+            if (table != GLTF_JsonTable_None)
+            {
+                frames.back().key = std::move(val);
+                return true;
+            }
+
+            // tables are only read from the root object
+            if (domStack.size() == 1 && domStack[0] == root && root->is_object())
+            {
+                if (val == "accessors") { pendingTable = GLTF_JsonTable_Accessors; return true; }
+                if (val == "bufferViews") { pendingTable = GLTF_JsonTable_BufferViews; return true; }
+                if (val == "materials") { pendingTable = GLTF_JsonTable_Materials; return true; }
+            }
+
+            domMember = &(*domStack.back())[val];
+            return true;
+        }
+        bool parse_error(std::size_t position, const std::string&, const nlm::detail::exception& ex)
+        {
+            errorPosition = position;
+            errorMessage = ex.what();
+            return false;
+        }
+    };
+
+    static bool                        parseJson(GLTFLoadData* gltfData, const char* begin, const char* end);
     static LvnVector<LvnBin>           loadBuffers(const nlm::json& JSON, std::string_view filepath);
-    static LvnVector<GLTFAccessor>     loadAccessors(const nlm::json& JSON);
-    static LvnVector<GLTFBufferView>   loadBufferViews(const nlm::json& JSON);
-    static LvnVector<GLTFMatrial>      loadMaterials(const nlm::json& JSON);
+    static bool                        isMeshoptFallbackBuffer(const nlm::json& buffer);
+    static bool                        checkRequiredExtensions(const GLTFLoadData* gltfData);
+    static bool                        decodeMeshoptBufferViews(GLTFLoadData* gltfData);
+    static void                        decodeMeshoptJob(uint32_t start, uint32_t end, void* arg);
     static LvnVector<GLTFAnimation>    loadAnimations(const nlm::json& JSON);
     static LvnVector<GLTFSkin>         loadSkins(const nlm::json& JSON);
-    static LvnVector<LvnImageData>     loadImages(const GLTFLoadData& gltfData);
-    static LvnVector<LvnSampler*>      loadSamplers(const nlm::json& JSON, LvnSampler** defaultSampler);
+    static void                        loadImages(GLTFLoadData* gltfData);
+    static void                        loadImageJob(void* arg);
+    static bool                        isCompressedImage(const nlm::json& image);
+    static uint32_t                    getTextureSource(const GLTFLoadData* gltfData, uint32_t texIndex);
+    static void                        setTextureImage(const GLTFLoadData* gltfData, uint32_t texIndex, LvnTextureSamplerCreateInfo* createInfo);
+    static LvnVector<LvnSampler*>      loadSamplers(const nlm::json& JSON, LvnSampler** defaultSampler, LvnModelCookData* cook);
+    static void                        createModelSampler(LvnModelCookData* cook, LvnSampler** sampler, const LvnSamplerCreateInfo* createInfo);
+    static void                        createModelTexture(GLTFLoadData* gltfData, LvnTexture** texture, const LvnTextureSamplerCreateInfo* createInfo);
     static LvnVector<LvnAnimation>     bindAnimationsToNodes(const GLTFLoadData& gltfData);
+    static void                        bindAnimationsJob(void* arg);
     static LvnVector<LvnSkin>          bindSkinsToNodes(GLTFLoadData& gltfData);
     static size_t                      getCompType(int compType);
     static bool                        isNormalizedType(int compType);
-    static LvnVector<float>            getAttributeData(const GLTFLoadData* gltfData, const GLTFAccessor& accessor);
+    static uint32_t                    getAccessorComponents(const std::string& type);
+    static GLTFAccessorView            getAccessorView(const GLTFLoadData* gltfData, const GLTFAccessor& accessor);
+    static void                        readAccessorFloats(const GLTFAccessorView& view, float* dst, uint32_t dstStride, uint32_t dstComponents);
+    static void                        readAccessorIndices(const GLTFAccessorView& view, uint32_t* dst);
     static LvnTextureFilter            getSamplerFilterEnum(int filter);
     static LvnTextureMode              getSamplerWrapModeEnum(int mode);
     static LvnTopologyType             getTopologyEnum(int mode);
     static LvnInterpolationMode        getInterpolationMode(std::string interpolation);
-    static LvnVector<LvnVec3>          calculateBitangents(const LvnVector<LvnVec3>& normals, const LvnVector<LvnVec4>& tangents);
     static LvnVector<LvnVec4>          calculateTangents(GLTFTangentCalcInfo* calcInfo);
+    static void                        loadNodeInstances(const GLTFLoadData* gltfData, const nlm::json& jinstancing, LvnNode* node);
     static void                        traverseNode(GLTFLoadData* const gltfData, int32_t nodeIndex);
     static LvnMaterial                 getMaterial(GLTFLoadData* gltfData, int meshMaterialIndex);
     static void                        loadDefaultTextures(GLTFLoadData* gltfData);
-    static LvnVector<LvnMesh>          loadMeshes(GLTFLoadData* gltfData);
+    static void                        loadPrimitiveData(const GLTFLoadData* gltfData, GLTFPrimitiveJob* job);
+    static void                        loadPrimitivesJob(uint32_t start, uint32_t end, void* arg);
+    static void                        createPrimitiveBuffer(GLTFPrimitiveJob* job);
+    static LvnVector<LvnMesh>          loadMeshes(GLTFLoadData* gltfData, LvnVector<GLTFPrimitiveJob>* pPrimitiveJobs);
+    static void                        createMeshResources(GLTFLoadData* gltfData, LvnVector<GLTFPrimitiveJob>& primitiveJobs);
     static void                        bindMeshToNodes(GLTFLoadData* gltfData);
-    static LvnModel                    loadGltfModelFileType(const char* filepath, LvnFileType filetype);
+    static LvnModel                    loadGltfModelFileType(const char* filepath, LvnFileType filetype, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize, LvnModelCookData* cook);
+
 
+    // parses the json in one pass, filling the dom and the accessor, buffer view and material tables
+    static bool parseJson(GLTFLoadData* gltfData, const char* begin, const char* end)
+    {
+        GLTFJsonParser parser{};
+        parser.root = &gltfData->JSON;
+        parser.gltfData = gltfData;
+
+        if (!nlm::json::sax_parse(begin, end, &parser))
+        {
+            LVN_CORE_ERROR("loadModel(const char*) | failed to parse gltf json at byte %zu, %s; Filepath: %s", parser.errorPosition, parser.errorMessage.c_str(), gltfData->filepath.c_str());
+            return false;
+        }
 
+        return true;
+    }
     static LvnVector<LvnBin> loadBuffers(const nlm::json& JSON, std::string_view filepath)
     {
         LvnVector<LvnBin> buffers(JSON["buffers"].size());
 
         for (int i = 0; i < JSON["buffers"].size(); i++)
         {
+            // the uncompressed data of meshopt compressed views may be left out of the file, no view reads it once they are decoded
+            if (gltfs::isMeshoptFallbackBuffer(JSON["buffers"][i]) || !JSON["buffers"][i].contains("uri"))
+                continue;
+
             std::string uri = JSON["buffers"][i]["uri"];
             std::string_view fileDirectory = filepath.substr(0, filepath.find_last_of("/\\") + 1);
             std::string pathbin = std::string(fileDirectory) + uri;
 
-            buffers[i] = lvn::loadFileSrcBin(pathbin.c_str());
+            buffers[i] = lvn::loadFileMapped(pathbin.c_str()); // accessors read straight from the mapping
         }
 
         return buffers;
     }
-    static LvnVector<GLTFAccessor> loadAccessors(const nlm::json& JSON)
+    static bool isMeshoptFallbackBuffer(const nlm::json& buffer)
     {
-        LvnVector<GLTFAccessor> accessors(JSON["accessors"].size());
+        if (!buffer.contains("extensions") || !buffer["extensions"].contains("EXT_meshopt_compression"))
+            return false;
 
-        for (uint32_t i = 0; i < JSON["accessors"].size(); i++)
-        {
-            accessors[i].bufferView = JSON["accessors"][i].value("bufferView", 0);
-            accessors[i].byteOffset = JSON["accessors"][i].value("byteOffset", 0);
-            accessors[i].componentType = JSON["accessors"][i]["componentType"];
-            accessors[i].normalized = JSON["accessors"][i].value("normalized", false);
-            accessors[i].count = JSON["accessors"][i]["count"];
-            accessors[i].type = JSON["accessors"][i]["type"];
-
-            std::vector<float> min = JSON["accessors"][i].value("min", std::vector<float>(3));
-            min.resize(3);
-            accessors[i].min.x = min[0];
-            accessors[i].min.y = min[1];
-            accessors[i].min.z = min[2];
-            std::vector<float> max = JSON["accessors"][i].value("max", std::vector<float>(3));
-            max.resize(3);
-            accessors[i].max.x = max[0];
-            accessors[i].max.y = max[1];
-            accessors[i].max.z = max[2];
-        }
-
-        return accessors;
+        return buffer["extensions"]["EXT_meshopt_compression"].value("fallback", false);
     }
-    static LvnVector<GLTFBufferView> loadBufferViews(const nlm::json& JSON)
+    static bool checkRequiredExtensions(const GLTFLoadData* gltfData)
     {
-        LvnVector<GLTFBufferView> bufferViews(JSON["bufferViews"].size());
+        const nlm::json& JSON = gltfData->JSON;
+        if (!JSON.contains("extensionsRequired"))
+            return true;
 
-        for (int i = 0; i < JSON["bufferViews"].size(); i++)
+        // draco primitives only carry compressed data when the extension is required, there is no accessor data to fall back to
+        for (const nlm::json& extension : JSON["extensionsRequired"])
         {
-            bufferViews[i].buffer = JSON["bufferViews"][i]["buffer"];
-            bufferViews[i].byteLength = JSON["bufferViews"][i]["byteLength"];
-            bufferViews[i].byteOffset = JSON["bufferViews"][i].value("byteOffset", 0);
+            std::string name = extension;
+            if (name == "EXT_meshopt_compression" || name == "KHR_texture_basisu" || name == "EXT_mesh_gpu_instancing" || name == "KHR_mesh_quantization")
+                continue;
+
+            if (name == "KHR_draco_mesh_compression")
+            {
+                LVN_CORE_ERROR("loadModel(const char*) | gltf model requires KHR_draco_mesh_compression which is not supported, re-export the model with EXT_meshopt_compression or without compression; Filepath: %s", gltfData->filepath.c_str());
+                return false;
+            }
+
+            LVN_CORE_WARN("gltf model requires the unsupported extension %s, the model may not load correctly; Filepath: %s", name.c_str(), gltfData->filepath.c_str());
         }
 
-        return bufferViews;
+        return true;
     }
-    static LvnVector<GLTFMatrial> loadMaterials(const nlm::json& JSON)
+    // decodes every meshopt compressed buffer view into a buffer of its own and points the view at it, the accessors are then read as if the file was uncompressed
+    static bool decodeMeshoptBufferViews(GLTFLoadData* gltfData)
     {
-        if (!JSON.contains("materials"))
-            return {};
-
-        LvnVector<GLTFMatrial> materials(JSON["materials"].size());
-
-        for (uint32_t i = 0; i < JSON["materials"].size(); i++)
+        LvnVector<uint32_t> views;
+        LvnVector<uint32_t> buffers;
+        for (uint32_t i = 0; i < gltfData->bufferViews.size(); i++)
         {
-            nlm::json materialNode = JSON["materials"][i];
+            const GLTFBufferView& bufferView = gltfData->bufferViews[i];
+            if (!bufferView.meshopt)
+                continue;
+
+            // the buffers are allocated up front so the jobs can decode into them in place
+            views.push_back(i);
+            buffers.push_back(gltfData->buffers.size());
+            gltfData->buffers.push_back(LvnBin((size_t)bufferView.compression.count * bufferView.compression.byteStride));
+        }
 
-            if (materialNode.find("pbrMetallicRoughness") != materialNode.end())
-            {
-                // color factors
-                if (materialNode["pbrMetallicRoughness"].find("baseColorFactor") != materialNode["pbrMetallicRoughness"].end())
-                {
-                    nlm::json colorNode = materialNode["pbrMetallicRoughness"]["baseColorFactor"];
-                    materials[i].pbrMetallicRoughness.baseColorFactor = LvnVec4(colorNode[0], colorNode[1], colorNode[2], colorNode[3]);
-                }
-                else
-                {
-                    materials[i].pbrMetallicRoughness.baseColorFactor = LvnVec4(1, 1, 1, 1);
-                }
+        if (views.empty())
+            return true;
 
-                // color texture
-                if (materialNode["pbrMetallicRoughness"].find("baseColorTexture") != materialNode["pbrMetallicRoughness"].end())
-                    materials[i].pbrMetallicRoughness.baseColorTexture.index = materialNode["pbrMetallicRoughness"]["baseColorTexture"]["index"];
-                else
-                    materials[i].pbrMetallicRoughness.baseColorTexture.index = -1;
+        LvnVector<uint8_t> results(views.size(), 0);
 
-                // metallic & roughness factors
-                materials[i].pbrMetallicRoughness.metallicFactor = materialNode["pbrMetallicRoughness"].value("metallicFactor", 1);
-                materials[i].pbrMetallicRoughness.roughnessFactor = materialNode["pbrMetallicRoughness"].value("roughnessFactor", 1);
+        // views differ a lot in size, each is decoded as its own range
+        GLTFMeshoptJobData jobData{};
+        jobData.gltfData = gltfData;
+        jobData.views = views.data();
+        jobData.buffers = buffers.data();
+        jobData.results = results.data();
+        lvn::parallelFor(views.size(), 1, gltfs::decodeMeshoptJob, &jobData);
 
-                // metallic roughness texture
-                if (materialNode["pbrMetallicRoughness"].find("metallicRoughnessTexture") != materialNode["pbrMetallicRoughness"].end())
-                    materials[i].pbrMetallicRoughness.metallicRoughnessTexture.index = materialNode["pbrMetallicRoughness"]["metallicRoughnessTexture"]["index"];
-                else
-                    materials[i].pbrMetallicRoughness.metallicRoughnessTexture.index = -1;
+        for (uint32_t i = 0; i < views.size(); i++)
+        {
+            GLTFBufferView& bufferView = gltfData->bufferViews[views[i]];
+            if (!results[i])
+            {
+                LVN_CORE_ERROR("loadModel(const char*) | failed to decode meshopt compressed buffer view %u, the compressed data is malformed or out of range of its buffer; Filepath: %s", views[i], gltfData->filepath.c_str());
+                return false;
             }
 
-            // normal texture
-            if (materialNode.find("normalTexture") != materialNode.end())
-                materials[i].normalTexture.index = materialNode["normalTexture"]["index"];
-            else
-                materials[i].normalTexture.index = -1;
+            bufferView.buffer = buffers[i];
+            bufferView.byteOffset = 0;
+            bufferView.byteLength = bufferView.compression.count * bufferView.compression.byteStride;
+        }
 
-            // occlusion texture
-            if (materialNode.find("occlusionTexture") != materialNode.end())
-                materials[i].occlusionTexture.index = materialNode["occlusionTexture"]["index"];
-            else
-                materials[i].occlusionTexture.index = -1;
+        return true;
+    }
+    static void decodeMeshoptJob(uint32_t start, uint32_t end, void* arg)
+    {
+        GLTFMeshoptJobData* jobData = static_cast<GLTFMeshoptJobData*>(arg);
+        GLTFLoadData* gltfData = jobData->gltfData;
 
-            // emissive texture
-            if (materialNode.find("emissiveTexture") != materialNode.end())
-                materials[i].emissiveTexture.index = materialNode["emissiveTexture"]["index"];
-            else
-                materials[i].emissiveTexture.index = -1;
+        for (uint32_t i = start; i < end; i++)
+        {
+            const GLTFMeshoptCompression& compression = gltfData->bufferViews[jobData->views[i]].compression;
+            if (compression.buffer < 0 || (uint32_t)compression.buffer >= gltfData->buffers.size())
+                continue;
 
-            // emissive factor
-            if (materialNode.find("emissiveFactor") != materialNode.end())
-            {
-                nlm::json emissiveNode = materialNode["emissiveFactor"];
-                materials[i].emissiveFactor = LvnVec3(emissiveNode[0], emissiveNode[1], emissiveNode[2]);
-            }
-            else
-            {
-                materials[i].emissiveFactor = LvnVec3(0, 0, 0);
-            }
+            const LvnBin& src = gltfData->buffers[compression.buffer];
+            if ((uint64_t)compression.byteOffset + compression.byteLength > src.size())
+                continue;
 
-            materials[i].alphaMode = materialNode.value("alphaMode", "OPAQUE");
-            materials[i].alphaCutoff = materialNode.value("alphaCutoff", 0.5);
-            materials[i].doubleSided = materialNode.value("doubleSided", false);
+            LvnBin& dst = gltfData->buffers[jobData->buffers[i]];
+            jobData->results[i] = lvn::decodeMeshoptBuffer(dst.data(), compression.count, compression.byteStride, src.data() + compression.byteOffset, compression.byteLength, compression.mode, compression.filter);
         }
-
-        return materials;
     }
     static LvnVector<GLTFAnimation>  loadAnimations(const nlm::json& JSON)
     {
@@ -353,76 +713,141 @@ namespace gltfs
 
         return skins;
     }
-    static LvnVector<LvnImageData> loadImages(const GLTFLoadData& gltfData)
+    // starts decoding the images on the job system and returns without waiting, the meshes are processed meanwhile
+    static void loadImages(GLTFLoadData* gltfData)
     {
         LvnContext* lvnctx = lvn::getContext();
 
-        const nlm::json& JSON = gltfData.JSON;
+        const nlm::json& JSON = gltfData->JSON;
 
         if (!JSON.contains("images"))
-            return {};
+            return;
 
-        LvnVector<LvnImageData> images(JSON["images"].size());
+        LvnVector<LvnImageData>& images = gltfData->images;
+        LvnVector<LvnVector<LvnImageData>>& mipLevels = gltfData->imageMipLevels;
+        images.resize(JSON["images"].size());
+        mipLevels.resize(JSON["images"].size());
 
         if (lvnctx->multithreading) // multithreading enabled
         {
-            LvnVector<std::future<LvnImageData>> futureImages(images.size());
+            LvnVector<GLTFImageJob>& imageJobs = gltfData->imageJobs;
+            imageJobs.resize(images.size());
 
-            if (gltfData.filetype == Lvn_FileType_Gltf)
+            if (gltfData->filetype == Lvn_FileType_Gltf)
             {
                 for (uint32_t i = 0; i < JSON["images"].size(); i++)
                 {
                     std::string uri = JSON["images"][i]["uri"];
-                    std::string fileDirectory = gltfData.filepath.substr(0, gltfData.filepath.find_last_of("/\\") + 1);
+                    std::string fileDirectory = gltfData->filepath.substr(0, gltfData->filepath.find_last_of("/\\") + 1);
 
-                    futureImages[i] = std::async(std::launch::async, lvn::loadImageDataThread, LvnString((fileDirectory + uri).c_str()), 4, false);
+                    // compressed images are read directly into memory, there is no decoding work to offload
+                    if (gltfs::isCompressedImage(JSON["images"][i]))
+                        images[i] = lvn::loadImageDataCompressed((fileDirectory + uri).c_str(), &mipLevels[i]);
+                    else
+                    {
+                        imageJobs[i].filepath = LvnString((fileDirectory + uri).c_str());
+                        imageJobs[i].image = &images[i];
+                        lvn::jobSubmit(gltfs::loadImageJob, &imageJobs[i], &gltfData->imageCounter);
+                    }
                 }
             }
-            else if (gltfData.filetype == Lvn_FileType_Glb)
+            else if (gltfData->filetype == Lvn_FileType_Glb)
             {
                 for (uint32_t i = 0; i < JSON["images"].size(); i++)
                 {
                     uint32_t bufferViewIndex = JSON["images"][i]["bufferView"];
-                    GLTFBufferView bufferView = gltfData.bufferViews[bufferViewIndex];
-                    LvnBin buffer = gltfData.buffers[bufferView.buffer];
+                    GLTFBufferView bufferView = gltfData->bufferViews[bufferViewIndex];
+                    const LvnBin& buffer = gltfData->buffers[bufferView.buffer]; // jobs read the image from the buffer, it cannot be a copy that goes out of scope
 
-                    futureImages[i] = std::async(std::launch::async, lvn::loadImageDataMemoryThread, &buffer[bufferView.byteOffset], bufferView.byteLength, 4, false);
+                    if (gltfs::isCompressedImage(JSON["images"][i]))
+                        images[i] = lvn::loadImageDataCompressedMemory(&buffer[bufferView.byteOffset], bufferView.byteLength, &mipLevels[i]);
+                    else
+                    {
+                        imageJobs[i].data = &buffer[bufferView.byteOffset];
+                        imageJobs[i].length = bufferView.byteLength;
+                        imageJobs[i].image = &images[i];
+                        lvn::jobSubmit(gltfs::loadImageJob, &imageJobs[i], &gltfData->imageCounter);
+                    }
                 }
             }
-
-            for (uint32_t i = 0; i < JSON["images"].size(); i++)
-            {
-                images[i] = std::move(futureImages[i].get());
-            }
         }
         else // no multithreading
         {
-            if (gltfData.filetype == Lvn_FileType_Gltf)
+            if (gltfData->filetype == Lvn_FileType_Gltf)
             {
                 for (uint32_t i = 0; i < JSON["images"].size(); i++)
                 {
                     std::string uri = JSON["images"][i]["uri"];
-                    std::string fileDirectory = gltfData.filepath.substr(0, gltfData.filepath.find_last_of("/\\") + 1);
+                    std::string fileDirectory = gltfData->filepath.substr(0, gltfData->filepath.find_last_of("/\\") + 1);
 
-                    images[i] = lvn::loadImageData((fileDirectory + uri).c_str(), 4);
+                    if (gltfs::isCompressedImage(JSON["images"][i]))
+                        images[i] = lvn::loadImageDataCompressed((fileDirectory + uri).c_str(), &mipLevels[i]);
+                    else
+                        images[i] = lvn::loadImageData((fileDirectory + uri).c_str(), 4);
                 }
             }
-            else if (gltfData.filetype == Lvn_FileType_Glb)
+            else if (gltfData->filetype == Lvn_FileType_Glb)
             {
                 for (uint32_t i = 0; i < JSON["images"].size(); i++)
                 {
                     uint32_t bufferViewIndex = JSON["images"][i]["bufferView"];
-                    GLTFBufferView bufferView = gltfData.bufferViews[bufferViewIndex];
-                    LvnBin buffer = gltfData.buffers[bufferView.buffer];
+                    GLTFBufferView bufferView = gltfData->bufferViews[bufferViewIndex];
+                    const LvnBin& buffer = gltfData->buffers[bufferView.buffer];
 
-                    images[i] = lvn::loadImageDataMemory(&buffer[bufferView.byteOffset], bufferView.byteLength, 4);
+                    if (gltfs::isCompressedImage(JSON["images"][i]))
+                        images[i] = lvn::loadImageDataCompressedMemory(&buffer[bufferView.byteOffset], bufferView.byteLength, &mipLevels[i]);
+                    else
+                        images[i] = lvn::loadImageDataMemory(&buffer[bufferView.byteOffset], bufferView.byteLength, 4);
                 }
             }
         }
+    }
+    static void loadImageJob(void* arg)
+    {
+        GLTFImageJob* job = static_cast<GLTFImageJob*>(arg);
+
+        if (job->data != nullptr)
+            *job->image = lvn::loadImageDataMemoryThread(job->data, job->length, 4, false);
+        else
+            *job->image = lvn::loadImageDataThread(job->filepath, 4, false);
+    }
+
+    static bool isCompressedImage(const nlm::json& image)
+    {
+        if (image.value("mimeType", "") == "image/ktx2")
+            return true;
 
-        return images;
+        std::string uri = image.value("uri", "");
+        return uri.size() >= 5 && uri.compare(uri.size() - 5, 5, ".ktx2") == 0;
     }
-    static LvnVector<LvnSampler*> loadSamplers(const nlm::json& JSON, LvnSampler** defaultSampler)
+    static uint32_t getTextureSource(const GLTFLoadData* gltfData, uint32_t texIndex)
+    {
+        const nlm::json& texture = gltfData->JSON["textures"][texIndex];
+
+        // KHR_texture_basisu points at a ktx2 image, only use it if the image could be loaded
+        if (texture.contains("extensions") && texture["extensions"].contains("KHR_texture_basisu"))
+        {
+            uint32_t basisuSource = texture["extensions"]["KHR_texture_basisu"]["source"];
+            if (basisuSource < gltfData->images.size() && gltfData->images[basisuSource].pixels.size() > 0)
+                return basisuSource;
+        }
+
+        return texture["source"];
+    }
+    static void setTextureImage(const GLTFLoadData* gltfData, uint32_t texIndex, LvnTextureSamplerCreateInfo* createInfo)
+    {
+        uint32_t source = gltfs::getTextureSource(gltfData, texIndex);
+
+        createInfo->imageData = lvn::imageGetView(gltfData->images[source]); // the images outlive the textures created from them
+
+        const LvnVector<LvnImageData>& mipLevels = gltfData->imageMipLevels[source];
+        if (!mipLevels.empty())
+        {
+            createInfo->mipLevels = mipLevels.size() + 1;
+            createInfo->pMipImageData = mipLevels.data();
+        }
+    }
+    static LvnVector<LvnSampler*> loadSamplers(const nlm::json& JSON, LvnSampler** defaultSampler, LvnModelCookData* cook)
     {
         if (!JSON.contains("samplers"))
         {
@@ -432,7 +857,7 @@ namespace gltfs
             samplerCreateInfo.minFilter = Lvn_TextureFilter_Nearest;
             samplerCreateInfo.magFilter = Lvn_TextureFilter_Nearest;
 
-            lvn::createSampler(defaultSampler, &samplerCreateInfo);
+            gltfs::createModelSampler(cook, defaultSampler, &samplerCreateInfo);
             return LvnVector<LvnSampler*>(defaultSampler, 1);
         }
 
@@ -446,7 +871,7 @@ namespace gltfs
             samplerCreateInfo.wrapS = gltfs::getSamplerWrapModeEnum(JSON["samplers"][i]["wrapS"]);
             samplerCreateInfo.wrapT = gltfs::getSamplerWrapModeEnum(JSON["samplers"][i]["wrapT"]);
 
-            lvn::createSampler(&samplers[i], &samplerCreateInfo);
+            gltfs::createModelSampler(cook, &samplers[i], &samplerCreateInfo);
         }
 
         LvnSamplerCreateInfo samplerCreateInfo{};
@@ -455,11 +880,42 @@ namespace gltfs
         samplerCreateInfo.minFilter = Lvn_TextureFilter_Nearest;
         samplerCreateInfo.magFilter = Lvn_TextureFilter_Nearest;
 
-        lvn::createSampler(defaultSampler, &samplerCreateInfo);
+        gltfs::createModelSampler(cook, defaultSampler, &samplerCreateInfo);
         samplers.push_back(*defaultSampler);
 
         return samplers;
     }
+    static void createModelSampler(LvnModelCookData* cook, LvnSampler** sampler, const LvnSamplerCreateInfo* createInfo)
+    {
+        lvn::createSampler(sampler, createInfo);
+
+        if (cook)
+            cook->samplers.push_back({ *sampler, *createInfo });
+    }
+    static void createModelTexture(GLTFLoadData* gltfData, LvnTexture** texture, const LvnTextureSamplerCreateInfo* createInfo)
+    {
+        lvn::createTexture(texture, createInfo);
+
+        if (!gltfData->cook)
+            return;
+
+        // the create info only borrows the images of the load data, the cook data needs its own copies
+        LvnModelCookTexture cookTexture{};
+        cookTexture.texture = *texture;
+        cookTexture.sampler = createInfo->sampler;
+        cookTexture.format = createInfo->format;
+        cookTexture.image = createInfo->imageData;
+        for (uint32_t i = 1; createInfo->pMipImageData && i < createInfo->mipLevels; i++)
+            cookTexture.mipLevels.push_back(createInfo->pMipImageData[i - 1]);
+
+        gltfData->cook->textures.push_back(lvn::move(cookTexture));
+    }
+    static void bindAnimationsJob(void* arg)
+    {
+        GLTFAnimationJob* job = static_cast<GLTFAnimationJob*>(arg);
+        job->animations = gltfs::bindAnimationsToNodes(*job->gltfData);
+    }
+
     static LvnVector<LvnAnimation> bindAnimationsToNodes(const GLTFLoadData& gltfData)
     {
         LvnVector<LvnAnimation> animations(gltfData.animations.size());
@@ -479,12 +935,12 @@ namespace gltfs
 
                 GLTFAccessor accessor = gltfData.accessors[sampler.input];
                 GLTFBufferView bufferView = gltfData.bufferViews[accessor.bufferView];
-                LvnBin buffer = gltfData.buffers[bufferView.buffer];
+                const uint8_t* buffer = gltfData.buffers[bufferView.buffer].data();
 
                 uint32_t beginningOfData = accessor.byteOffset + bufferView.byteOffset;
 
-                animations[i].start = *reinterpret_cast<float*>(&buffer[beginningOfData]);
-                animations[i].end = *reinterpret_cast<float*>(&buffer[beginningOfData] + (accessor.count - 1) * sizeof(float));
+                animations[i].start = *reinterpret_cast<const float*>(&buffer[beginningOfData]);
+                animations[i].end = *reinterpret_cast<const float*>(&buffer[beginningOfData] + (accessor.count - 1) * sizeof(float));
             }
 
             // bind the channels, samplers, input, output
@@ -506,7 +962,7 @@ namespace gltfs
                 // sampler input (keyframes)
                 GLTFAccessor accessor = gltfData.accessors[sampler.input];
                 GLTFBufferView bufferView = gltfData.bufferViews[accessor.bufferView];
-                LvnBin buffer = gltfData.buffers[bufferView.buffer];
+                const uint8_t* buffer = gltfData.buffers[bufferView.buffer].data();
 
                 uint32_t beginningOfData = accessor.byteOffset + bufferView.byteOffset;
 
@@ -514,7 +970,7 @@ namespace gltfs
                 for (uint32_t k = 0; k < accessor.count; k++)
                 {
                     // adjust animation start and end times
-                    animations[i].channels[j].keyFrames[k] = *reinterpret_cast<float*>(&buffer[beginningOfData] + k * sizeof(float));
+                    animations[i].channels[j].keyFrames[k] = *reinterpret_cast<const float*>(&buffer[beginningOfData] + k * sizeof(float));
                     if (animations[i].channels[j].keyFrames[k] < animations[i].start)
                         animations[i].start = animations[i].channels[j].keyFrames[k];
                     if (animations[i].channels[j].keyFrames[k] > animations[i].end)
@@ -524,16 +980,16 @@ namespace gltfs
                 // sampler outputs (translations/rotations/scale)
                 accessor = gltfData.accessors[sampler.output];
                 bufferView = gltfData.bufferViews[accessor.bufferView];
-                buffer = gltfData.buffers[bufferView.buffer];
+                buffer = gltfData.buffers[bufferView.buffer].data();
                 beginningOfData = accessor.byteOffset + bufferView.byteOffset;
 
                 animations[i].channels[j].outputs.resize(accessor.count);
                 if (accessor.type == "VEC3")
                     for (uint32_t k = 0; k < accessor.count; k++)
-                        animations[i].channels[j].outputs[k] = LvnVec4(*reinterpret_cast<LvnVec3*>(&buffer[beginningOfData] + k * 3 * sizeof(float)), 0.0f);
+                        animations[i].channels[j].outputs[k] = LvnVec4(*reinterpret_cast<const LvnVec3*>(&buffer[beginningOfData] + k * 3 * sizeof(float)), 0.0f);
                 else if (accessor.type == "VEC4")
                     for (uint32_t k = 0; k < accessor.count; k++)
-                        animations[i].channels[j].outputs[k] = *reinterpret_cast<LvnVec4*>(&buffer[beginningOfData] + k * 4 * sizeof(float));
+                        animations[i].channels[j].outputs[k] = *reinterpret_cast<const LvnVec4*>(&buffer[beginningOfData] + k * 4 * sizeof(float));
             }
         }
 
@@ -549,6 +1005,7 @@ namespace gltfs
         {
             const GLTFSkin& skinData = gltfData.skins[i];
             skins[i].name = skinData.name.c_str();
+            skins[i].nameAtom = lvn::atomInternLength(skinData.name.c_str(), skinData.name.size());
 
             skins[i].joints.resize(skinData.joints.size());
             for (uint32_t j = 0; j < skinData.joints.size(); j++)
@@ -607,92 +1064,170 @@ namespace gltfs
             default: { LVN_CORE_ERROR("unknown component type: %d", compType); return false; }
         }
     }
-    static LvnVector<float> getAttributeData(const GLTFLoadData* gltfData, const GLTFAccessor& accessor)
+    static uint32_t getAccessorComponents(const std::string& type)
     {
-        GLTFBufferView bufferView = gltfData->bufferViews[accessor.bufferView];
-        LvnBin buffer = gltfData->buffers[bufferView.buffer];
-
-        uint32_t beginningOfData = accessor.byteOffset + bufferView.byteOffset;
-
-        size_t compSize = gltfs::getCompType(accessor.componentType);
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2") return 2;
+        if (type == "VEC3") return 3;
+        if (type == "VEC4") return 4;
+        if (type == "MAT4") return 16;
+
+        LVN_CORE_ERROR("unknown accessor type: %s", type.c_str());
+        return 0;
+    }
+    static GLTFAccessorView getAccessorView(const GLTFLoadData* gltfData, const GLTFAccessor& accessor)
+    {
+        const GLTFBufferView& bufferView = gltfData->bufferViews[accessor.bufferView];
 
-        uint32_t type = 2;
-        if (accessor.type == "VEC2")
-            type = 2;
-        else if (accessor.type == "VEC3")
-            type = 3;
-        else if (accessor.type == "VEC4")
-            type = 4;
+        GLTFAccessorView view{};
+        view.data = gltfData->buffers[bufferView.buffer].data() + bufferView.byteOffset + accessor.byteOffset;
+        view.count = accessor.count;
+        view.components = gltfs::getAccessorComponents(accessor.type);
+        view.componentType = accessor.componentType;
+        view.normalized = accessor.normalized;
 
-        LvnVector<float> att(accessor.count * type);
+        // interleaved buffer views set a byte stride, otherwise the elements are tightly packed
+        uint32_t elementSize = view.components * gltfs::getCompType(accessor.componentType);
+        view.byteStride = bufferView.byteStride != 0 ? bufferView.byteStride : elementSize;
 
-        if (accessor.componentType == 5126) // float
+        return view;
+    }
+    template <typename T>
+    static void readAccessorComponents(const GLTFAccessorView& view, uint8_t* dst, uint32_t dstStride, uint32_t components, float scale)
+    {
+        const uint8_t* src = view.data;
+        for (uint32_t i = 0; i < view.count; i++, src += view.byteStride, dst += dstStride)
         {
-            for (uint32_t i = 0; i < accessor.count; i++)
+            float* out = reinterpret_cast<float*>(dst);
+            for (uint32_t j = 0; j < components; j++)
             {
-                for (uint32_t j = 0; j < type; j++)
-                {
-                    att[i * type + j] = *reinterpret_cast<float*>(&buffer[beginningOfData] + i * type * sizeof(float) + j * sizeof(float));
-                }
+                T value;
+                memcpy(&value, src + j * sizeof(T), sizeof(T));
+
+                // signed normalized values have two encodings of -1
+                float converted = static_cast<float>(value) * scale;
+                out[j] = std::is_signed_v<T> && view.normalized && converted < -1.0f ? -1.0f : converted;
             }
         }
-        else if (accessor.componentType == 5125) // unsigned int (uint32_t)
+    }
+    template <typename T>
+    static void readAccessorComponents4(const GLTFAccessorView& view, uint8_t* dst, uint32_t dstStride, float scale)
+    {
+        const uint8_t* src = view.data;
+
+#if defined(LVN_SIMD_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 scale4 = _mm_set1_ps(scale);
+        for (uint32_t i = 0; i < view.count; i++, src += view.byteStride, dst += dstStride)
         {
-            for (uint32_t i = 0; i < accessor.count; i++)
+            __m128i values;
+            if constexpr (sizeof(T) == sizeof(uint8_t))
             {
-                for (uint32_t j = 0; j < type; j++)
-                {
-                    uint32_t at = *reinterpret_cast<uint32_t*>(&buffer[beginningOfData] + i * type * sizeof(uint32_t) + j * sizeof(uint32_t));
-                    att[i * type + j] = static_cast<float>(at);
-                }
+                int32_t packed;
+                memcpy(&packed, src, sizeof(int32_t));
+                values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
             }
+            else
+                values = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), zero);
+
+            _mm_storeu_ps(reinterpret_cast<float*>(dst), _mm_mul_ps(_mm_cvtepi32_ps(values), scale4));
         }
-        else if (accessor.componentType == 5120) // signed byte (int8_t)
+#elif defined(LVN_SIMD_NEON)
+        for (uint32_t i = 0; i < view.count; i++, src += view.byteStride, dst += dstStride)
         {
-            for (uint32_t i = 0; i < accessor.count; i++)
+            uint32x4_t values;
+            if constexpr (sizeof(T) == sizeof(uint8_t))
             {
-                for (uint32_t j = 0; j < type; j++)
-                {
-                    int8_t at = *reinterpret_cast<int8_t*>(&buffer[beginningOfData] + i * type * sizeof(int8_t) + j * sizeof(int8_t));
-                    att[i * type + j] = accessor.normalized ? static_cast<float>(at) / INT8_MAX : static_cast<float>(at);
-                }
+                uint32_t packed;
+                memcpy(&packed, src, sizeof(uint32_t));
+                values = vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(packed))));
             }
+            else
+                values = vmovl_u16(vld1_u16(reinterpret_cast<const uint16_t*>(src)));
+
+            vst1q_f32(reinterpret_cast<float*>(dst), vmulq_n_f32(vcvtq_f32_u32(values), scale));
         }
-        else if (accessor.componentType == 5121) // unsigned byte (uint8_t)
+#else
+        gltfs::readAccessorComponents<T>(view, dst, dstStride, 4, scale);
+#endif
+    }
+    // converts the accessor straight from the mapped buffer into floats dstStride bytes apart, at most dstComponents of each element are written
+    static void readAccessorFloats(const GLTFAccessorView& view, float* dst, uint32_t dstStride, uint32_t dstComponents)
+    {
+        uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+        uint32_t components = view.components < dstComponents ? view.components : dstComponents;
+
+        switch (view.componentType)
         {
-            for (uint32_t i = 0; i < accessor.count; i++)
+            case 5126: // float
             {
-                for (uint32_t j = 0; j < type; j++)
-                {
-                    uint8_t at = *reinterpret_cast<uint8_t*>(&buffer[beginningOfData] + i * type * sizeof(uint8_t) + j * sizeof(uint8_t));
-                    att[i * type + j] = accessor.normalized ? static_cast<float>(at) / UINT8_MAX : static_cast<float>(at);
-                }
+                const uint8_t* src = view.data;
+                for (uint32_t i = 0; i < view.count; i++, src += view.byteStride, out += dstStride)
+                    memcpy(out, src, components * sizeof(float));
+                break;
+            }
+            case 5121: // unsigned byte (uint8_t)
+            {
+                float scale = view.normalized ? 1.0f / UINT8_MAX : 1.0f;
+                if (components == 4)
+                    gltfs::readAccessorComponents4<uint8_t>(view, out, dstStride, scale);
+                else
+                    gltfs::readAccessorComponents<uint8_t>(view, out, dstStride, components, scale);
+                break;
             }
+            case 5123: // unsigned short (uint16_t)
+            {
+                float scale = view.normalized ? 1.0f / UINT16_MAX : 1.0f;
+                if (components == 4)
+                    gltfs::readAccessorComponents4<uint16_t>(view, out, dstStride, scale);
+                else
+                    gltfs::readAccessorComponents<uint16_t>(view, out, dstStride, components, scale);
+                break;
+            }
+            case 5120: { gltfs::readAccessorComponents<int8_t>(view, out, dstStride, components, view.normalized ? 1.0f / INT8_MAX : 1.0f); break; }
+            case 5122: { gltfs::readAccessorComponents<int16_t>(view, out, dstStride, components, view.normalized ? 1.0f / INT16_MAX : 1.0f); break; }
+            case 5125: { gltfs::readAccessorComponents<uint32_t>(view, out, dstStride, components, 1.0f); break; }
+
+            default: { LVN_CORE_ERROR("unknown component type: %d", view.componentType); break; }
         }
-        else if (accessor.componentType == 5122) // signed short (int16_t)
+    }
+    static void readAccessorIndices(const GLTFAccessorView& view, uint32_t* dst)
+    {
+        const uint8_t* src = view.data;
+
+        switch (view.componentType)
         {
-            for (uint32_t i = 0; i < accessor.count; i++)
+            case 5121: // unsigned byte
             {
-                for (uint32_t j = 0; j < type; j++)
+                for (uint32_t i = 0; i < view.count; i++, src += view.byteStride)
+                    dst[i] = *src;
+                break;
+            }
+            case 5123: // unsigned short
+            {
+                for (uint32_t i = 0; i < view.count; i++, src += view.byteStride)
                 {
-                    int16_t at = *reinterpret_cast<int16_t*>(&buffer[beginningOfData] + i * type * sizeof(int16_t) + j * sizeof(int16_t));
-                    att[i * type + j] = accessor.normalized ? static_cast<float>(at) / INT16_MAX : static_cast<float>(at);
+                    uint16_t index;
+                    memcpy(&index, src, sizeof(uint16_t));
+                    dst[i] = index;
                 }
+                break;
             }
-        }
-        else if (accessor.componentType == 5123) // unsigned short (uint16_t)
-        {
-            for (uint32_t i = 0; i < accessor.count; i++)
+            case 5125: // unsigned int
             {
-                for (uint32_t j = 0; j < type; j++)
+                if (view.byteStride == sizeof(uint32_t))
                 {
-                    uint16_t at = *reinterpret_cast<uint16_t*>(&buffer[beginningOfData] + i * type * sizeof(uint16_t) + j * sizeof(uint16_t));
-                    att[i * type + j] = accessor.normalized ? static_cast<float>(at) / UINT16_MAX : static_cast<float>(at);
+                    memcpy(dst, src, view.count * sizeof(uint32_t));
+                    break;
                 }
+
+                for (uint32_t i = 0; i < view.count; i++, src += view.byteStride)
+                    memcpy(&dst[i], src, sizeof(uint32_t));
+                break;
             }
-        }
 
-        return att;
+            default: { LVN_CORE_ERROR("invalid index component type: %d", view.componentType); memset(dst, 0, view.count * sizeof(uint32_t)); break; }
+        }
     }
     static LvnTextureFilter getSamplerFilterEnum(int filter)
     {
@@ -742,16 +1277,6 @@ namespace gltfs
         LVN_CORE_ERROR("unknown interpolation type: %s", interpolation.c_str());
         return Lvn_InterpolationMode_Step;
     }
-    static LvnVector<LvnVec3> calculateBitangents(const LvnVector<LvnVec3>& normals, const LvnVector<LvnVec4>& tangents)
-    {
-        LvnVector<LvnVec3> bitangents(normals.size());
-        for (uint32_t i = 0; i < normals.size(); i++)
-        {
-            bitangents[i] = lvn::normalize(lvn::cross(normals[i], LvnVec3(tangents[i])) * tangents[i].w);
-        }
-
-        return bitangents;
-    }
     static LvnVector<LvnVec4> calculateTangents(GLTFTangentCalcInfo* calcInfo)
     {
         SMikkTSpaceInterface iface{};
@@ -773,7 +1298,7 @@ namespace gltfs
 
             uint32_t indicesIndex = iFace * calcInfo->vertexPerFace + iVert;
             uint32_t index = calcInfo->indices[indicesIndex];
-            LvnVec3 position = calcInfo->positions[index];
+            LvnVec3 position = calcInfo->vertices[index].pos;
 
             outpos[0] = position.x;
             outpos[1] = position.y;
@@ -785,7 +1310,7 @@ namespace gltfs
 
             uint32_t indicesIndex = iFace * calcInfo->vertexPerFace + iVert;
             uint32_t index = calcInfo->indices[indicesIndex];
-            LvnVec3 normal = calcInfo->normals[index];
+            LvnVec3 normal = calcInfo->vertices[index].normal;
 
             outnormal[0] = normal.x;
             outnormal[1] = normal.y;
@@ -797,7 +1322,7 @@ namespace gltfs
 
             uint32_t indicesIndex = iFace * calcInfo->vertexPerFace + iVert;
             uint32_t index = calcInfo->indices[indicesIndex];
-            LvnVec2 texUV = calcInfo->texUVs[index];
+            LvnVec2 texUV = calcInfo->vertices[index].texUV;
 
             outuv[0] = texUV.x;
             outuv[1] = texUV.y;
@@ -819,12 +1344,50 @@ namespace gltfs
         context.m_pInterface = &iface;
         context.m_pUserData = calcInfo;
 
-        calcInfo->outTangents.resize(calcInfo->positions.size());
+        calcInfo->outTangents.resize(calcInfo->vertexCount);
 
         genTangSpaceDefault(&context);
 
         return calcInfo->outTangents;
     }
+    // EXT_mesh_gpu_instancing stores one accessor per transform component, missing components keep the identity
+    static void loadNodeInstances(const GLTFLoadData* gltfData, const nlm::json& jinstancing, LvnNode* node)
+    {
+        if (!jinstancing.contains("attributes"))
+            return;
+
+        const nlm::json& attributes = jinstancing["attributes"];
+
+        uint32_t instanceCount = 0;
+        for (const char* name : { "TRANSLATION", "ROTATION", "SCALE" })
+        {
+            if (attributes.contains(name))
+                instanceCount = lvn::max<uint32_t>(instanceCount, gltfData->accessors[attributes[name]].count);
+        }
+
+        if (instanceCount == 0)
+            return;
+
+        LvnVector<LvnVec3> translations(instanceCount, LvnVec3(0.0f, 0.0f, 0.0f));
+        LvnVector<LvnVec4> rotations(instanceCount, LvnVec4(0.0f, 0.0f, 0.0f, 1.0f)); // gltf order (x, y, z, w)
+        LvnVector<LvnVec3> scales(instanceCount, LvnVec3(1.0f, 1.0f, 1.0f));
+
+        // accessors with fewer elements than the largest one only fill the instances they have
+        if (attributes.contains("TRANSLATION"))
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[attributes["TRANSLATION"]]), &translations[0].x, sizeof(LvnVec3), 3);
+        if (attributes.contains("ROTATION"))
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[attributes["ROTATION"]]), &rotations[0].x, sizeof(LvnVec4), 4);
+        if (attributes.contains("SCALE"))
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[attributes["SCALE"]]), &scales[0].x, sizeof(LvnVec3), 3);
+
+        node->instances.resize(instanceCount);
+        for (uint32_t i = 0; i < instanceCount; i++)
+        {
+            node->instances[i].translation = translations[i];
+            node->instances[i].rotation = LvnQuat(rotations[i].w, rotations[i].x, rotations[i].y, rotations[i].z);
+            node->instances[i].scale = scales[i];
+        }
+    }
     static void traverseNode(GLTFLoadData* const gltfData, int32_t nodeIndex)
     {
         const nlm::json& JSON = gltfData->JSON;
@@ -873,6 +1436,9 @@ namespace gltfs
         node.transform.scale = scaleVec;
         node.matrix = matrix;
 
+        if (jnode.contains("extensions") && jnode["extensions"].contains("EXT_mesh_gpu_instancing"))
+            gltfs::loadNodeInstances(gltfData, jnode["extensions"]["EXT_mesh_gpu_instancing"], &node);
+
         // Check if the node has children
         if (jnode.contains("children"))
         {
@@ -898,7 +1464,6 @@ namespace gltfs
         if (gltfMaterial.pbrMetallicRoughness.baseColorTexture.index >= 0)
         {
             LvnSampler* sampler;
-            LvnImageData image{};
             uint32_t texIndex = gltfMaterial.pbrMetallicRoughness.baseColorTexture.index;
 
             if (gltfData->textures[texIndex] == nullptr)
@@ -909,15 +1474,12 @@ namespace gltfs
                 else
                     sampler = gltfData->defaultSampler;
 
-                // image
-                image = gltfData->images[JSON["textures"][texIndex]["source"]];
-
                 LvnTextureSamplerCreateInfo textureCreateInfo{};
                 textureCreateInfo.format = Lvn_TextureFormat_Srgb;
-                textureCreateInfo.imageData = image;
+                gltfs::setTextureImage(gltfData, texIndex, &textureCreateInfo);
                 textureCreateInfo.sampler = sampler;
 
-                lvn::createTexture(&gltfData->textures[texIndex], &textureCreateInfo);
+                gltfs::createModelTexture(gltfData, &gltfData->textures[texIndex], &textureCreateInfo);
             }
 
             material.albedo = gltfData->textures[texIndex];
@@ -939,7 +1501,7 @@ namespace gltfs
 
             if (gltfData->defaultBaseColorTexture == nullptr)
             {
-                lvn::createTexture(&gltfData->defaultBaseColorTexture, &baseColorCreateInfo);
+                gltfs::createModelTexture(gltfData, &gltfData->defaultBaseColorTexture, &baseColorCreateInfo);
                 gltfData->textures.push_back(gltfData->defaultBaseColorTexture);
             }
 
@@ -950,7 +1512,6 @@ namespace gltfs
         if (gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index >= 0)
         {
             LvnSampler* sampler;
-            LvnImageData image{};
             uint32_t texIndex = gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index;
 
             if (gltfData->textures[texIndex] == nullptr)
@@ -961,15 +1522,12 @@ namespace gltfs
                 else
                     sampler = gltfData->defaultSampler;
 
-                // image
-                image = gltfData->images[JSON["textures"][texIndex]["source"]];
-
                 LvnTextureSamplerCreateInfo textureCreateInfo{};
                 textureCreateInfo.format = Lvn_TextureFormat_Srgb;
-                textureCreateInfo.imageData = image;
+                gltfs::setTextureImage(gltfData, texIndex, &textureCreateInfo);
                 textureCreateInfo.sampler = sampler;
 
-                lvn::createTexture(&gltfData->textures[texIndex], &textureCreateInfo);
+                gltfs::createModelTexture(gltfData, &gltfData->textures[texIndex], &textureCreateInfo);
             }
 
             material.metallicRoughnessOcclusion = gltfData->textures[texIndex];
@@ -992,7 +1550,7 @@ namespace gltfs
 
             if (gltfData->defaultMetalicRoughnessTexture == nullptr)
             {
-                lvn::createTexture(&gltfData->defaultMetalicRoughnessTexture, &metalicRoughnessCreateInfo);
+                gltfs::createModelTexture(gltfData, &gltfData->defaultMetalicRoughnessTexture, &metalicRoughnessCreateInfo);
                 gltfData->textures.push_back(gltfData->defaultMetalicRoughnessTexture);
             }
 
@@ -1003,7 +1561,6 @@ namespace gltfs
         if (gltfMaterial.normalTexture.index >= 0)
         {
             LvnSampler* sampler;
-            LvnImageData image{};
             uint32_t texIndex = gltfMaterial.normalTexture.index;
 
             if (gltfData->textures[texIndex] == nullptr)
@@ -1014,15 +1571,12 @@ namespace gltfs
                 else
                     sampler = gltfData->defaultSampler;
 
-                // image
-                image = gltfData->images[JSON["textures"][texIndex]["source"]];
-
                 LvnTextureSamplerCreateInfo textureCreateInfo{};
                 textureCreateInfo.format = Lvn_TextureFormat_Unorm;
-                textureCreateInfo.imageData = image;
+                gltfs::setTextureImage(gltfData, texIndex, &textureCreateInfo);
                 textureCreateInfo.sampler = sampler;
 
-                lvn::createTexture(&gltfData->textures[texIndex], &textureCreateInfo);
+                gltfs::createModelTexture(gltfData, &gltfData->textures[texIndex], &textureCreateInfo);
             }
 
             material.normal = gltfData->textures[texIndex];
@@ -1045,7 +1599,7 @@ namespace gltfs
 
             if (gltfData->defaultNormalTexture == nullptr)
             {
-                lvn::createTexture(&gltfData->defaultNormalTexture, &normalCreateInfo);
+                gltfs::createModelTexture(gltfData, &gltfData->defaultNormalTexture, &normalCreateInfo);
                 gltfData->textures.push_back(gltfData->defaultNormalTexture);
             }
 
@@ -1056,7 +1610,6 @@ namespace gltfs
         if (gltfMaterial.emissiveTexture.index >= 0)
         {
             LvnSampler* sampler;
-            LvnImageData image{};
             uint32_t texIndex = gltfMaterial.emissiveTexture.index;
 
             if (gltfData->textures[texIndex] == nullptr)
@@ -1067,15 +1620,12 @@ namespace gltfs
                 else
                     sampler = gltfData->defaultSampler;
 
-                // image
-                image = gltfData->images[JSON["textures"][texIndex]["source"]];
-
                 LvnTextureSamplerCreateInfo textureCreateInfo{};
                 textureCreateInfo.format = Lvn_TextureFormat_Unorm;
-                textureCreateInfo.imageData = image;
+                gltfs::setTextureImage(gltfData, texIndex, &textureCreateInfo);
                 textureCreateInfo.sampler = sampler;
 
-                lvn::createTexture(&gltfData->textures[texIndex], &textureCreateInfo);
+                gltfs::createModelTexture(gltfData, &gltfData->textures[texIndex], &textureCreateInfo);
             }
 
             material.emissive = gltfData->textures[texIndex];
@@ -1098,7 +1648,7 @@ namespace gltfs
 
             if (gltfData->defaultEmissiveTexture == nullptr)
             {
-                lvn::createTexture(&gltfData->defaultEmissiveTexture, &emissiveCreateInfo);
+                gltfs::createModelTexture(gltfData, &gltfData->defaultEmissiveTexture, &emissiveCreateInfo);
                 gltfData->textures.push_back(gltfData->defaultEmissiveTexture);
             }
 
@@ -1132,7 +1682,7 @@ namespace gltfs
 
         if (gltfData->defaultBaseColorTexture == nullptr)
         {
-            lvn::createTexture(&gltfData->defaultBaseColorTexture, &baseColorCreateInfo);
+            gltfs::createModelTexture(gltfData, &gltfData->defaultBaseColorTexture, &baseColorCreateInfo);
             gltfData->textures.push_back(gltfData->defaultBaseColorTexture);
         }
 
@@ -1151,7 +1701,7 @@ namespace gltfs
 
         if (gltfData->defaultMetalicRoughnessTexture == nullptr)
         {
-            lvn::createTexture(&gltfData->defaultMetalicRoughnessTexture, &metalicRoughnessCreateInfo);
+            gltfs::createModelTexture(gltfData, &gltfData->defaultMetalicRoughnessTexture, &metalicRoughnessCreateInfo);
             gltfData->textures.push_back(gltfData->defaultMetalicRoughnessTexture);
         }
 
@@ -1170,7 +1720,7 @@ namespace gltfs
 
         if (gltfData->defaultNormalTexture == nullptr)
         {
-            lvn::createTexture(&gltfData->defaultNormalTexture, &normalCreateInfo);
+            gltfs::createModelTexture(gltfData, &gltfData->defaultNormalTexture, &normalCreateInfo);
             gltfData->textures.push_back(gltfData->defaultNormalTexture);
         }
 
@@ -1189,279 +1739,253 @@ namespace gltfs
 
         if (gltfData->defaultEmissiveTexture == nullptr)
         {
-            lvn::createTexture(&gltfData->defaultEmissiveTexture, &emissiveCreateInfo);
+            gltfs::createModelTexture(gltfData, &gltfData->defaultEmissiveTexture, &emissiveCreateInfo);
             gltfData->textures.push_back(gltfData->defaultEmissiveTexture);
         }
     }
-    static LvnVector<LvnMesh> loadMeshes(GLTFLoadData* gltfData)
+    // decodes the accessors of one primitive and runs the cpu side processing, only reads the load data so primitives can run in parallel
+    static void loadPrimitiveData(const GLTFLoadData* gltfData, GLTFPrimitiveJob* job)
     {
-        const nlm::json JSON = gltfData->JSON;
-
-        if (!JSON.contains("meshes"))
-            return {};
-
-        LvnVector<LvnMesh> meshes((JSON["meshes"].size()));
+        const nlm::json& primitiveNode = *job->primitiveNode;
+        LvnPrimitive* primitive = job->primitive;
+
+        int posIndex      = primitiveNode["attributes"]["POSITION"];
+        int colorIndex    = primitiveNode["attributes"].value("COLOR_0", -1);
+        int texIndex      = primitiveNode["attributes"].value("TEXCOORD_0", -1);
+        int normalIndex   = primitiveNode["attributes"].value("NORMAL", -1);
+        int tangentIndex  = primitiveNode["attributes"].value("TANGENT", -1);
+        int jointsIndex   = primitiveNode["attributes"].value("JOINTS_0", -1);
+        int weightsIndex  = primitiveNode["attributes"].value("WEIGHTS_0", -1);
+        int indicesIndex  = primitiveNode.value("indices", -1);
+        int materialIndex = primitiveNode.value("material", -1);
+
+        // every attribute is converted from its accessor view straight into the combined vertices, attributes without one are filled with defaults
+        GLTFAccessorView positionView = gltfs::getAccessorView(gltfData, gltfData->accessors[posIndex]);
+        uint32_t vertexCount = positionView.count;
+
+        LvnVector<LvnVertex> vertices;
+        vertices.resize_uninitialized(vertexCount);
+        LvnVertex* vertexData = vertices.data();
+        const uint32_t vertexStride = sizeof(LvnVertex);
+
+        // position
+        gltfs::readAccessorFloats(positionView, &vertexData[0].pos.x, vertexStride, 3);
+
+        // indices
+        LvnVector<uint32_t> indices;
+        if (indicesIndex >= 0)
+        {
+            GLTFAccessorView view = gltfs::getAccessorView(gltfData, gltfData->accessors[indicesIndex]);
+            indices.resize_uninitialized(view.count);
+            gltfs::readAccessorIndices(view, indices.data());
+        }
 
-        for (uint32_t meshIndex = 0; meshIndex < JSON["meshes"].size(); meshIndex++)
+        // color, check the material for a base color if no color attribute exists and default to white if there is no material either
+        LvnVec4 defaultColor = materialIndex >= 0 ? gltfData->materials[materialIndex].pbrMetallicRoughness.baseColorFactor : LvnVec4(1, 1, 1, 1);
+        if (colorIndex < 0 || gltfData->accessors[colorIndex].type != "VEC4") // rgb colors keep the default alpha
         {
-            LvnVector<LvnPrimitive> meshPrimitives(JSON["meshes"][meshIndex]["primitives"].size());
-            for (uint32_t i = 0; i < JSON["meshes"][meshIndex]["primitives"].size(); i++)
-            {
-                nlm::json primitiveNode = JSON["meshes"][meshIndex]["primitives"][i];
-
-                int posIndex      = primitiveNode["attributes"]["POSITION"];
-                int colorIndex    = primitiveNode["attributes"].value("COLOR_0", -1);
-                int texIndex      = primitiveNode["attributes"].value("TEXCOORD_0", -1);
-                int normalIndex   = primitiveNode["attributes"].value("NORMAL", -1);
-                int tangentIndex  = primitiveNode["attributes"].value("TANGENT", -1);
-                int jointsIndex   = primitiveNode["attributes"].value("JOINTS_0", -1);
-                int weightsIndex  = primitiveNode["attributes"].value("WEIGHTS_0", -1);
-                int indicesIndex  = primitiveNode.value("indices", -1);
-                int materialIndex = primitiveNode.value("material", -1);
-
-                // position
-                GLTFAccessor accessor = gltfData->accessors[posIndex];
-                GLTFBufferView bufferView = gltfData->bufferViews[accessor.bufferView];
-                LvnBin buffer = gltfData->buffers[bufferView.buffer];
+            for (uint32_t j = 0; j < vertexCount; j++)
+                vertexData[j].color = colorIndex < 0 ? defaultColor : LvnVec4(1, 1, 1, 1);
+        }
+        if (colorIndex >= 0)
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[colorIndex]), &vertexData[0].color.x, vertexStride, 4);
 
-                uint32_t beginningOfData = accessor.byteOffset + bufferView.byteOffset;
+        // texcoords
+        if (texIndex >= 0)
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[texIndex]), &vertexData[0].texUV.x, vertexStride, 2);
+        else
+            for (uint32_t j = 0; j < vertexCount; j++)
+                vertexData[j].texUV = LvnVec2(0.0f, 0.0f);
 
-                LvnVector<LvnVec3> positions(accessor.count);
-                for (uint32_t j = 0; j < accessor.count; j++)
-                    positions[j] = *reinterpret_cast<LvnVec3*>(&buffer[beginningOfData] + j * 3 * sizeof(float));
+        // normals
+        if (normalIndex >= 0)
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[normalIndex]), &vertexData[0].normal.x, vertexStride, 3);
+        else
+            for (uint32_t j = 0; j < vertexCount; j++)
+                vertexData[j].normal = LvnVec3(0.0f, 0.0f, 0.0f);
 
-                // indices
-                LvnVector<uint32_t> indices;
-                if (indicesIndex >= 0)
-                {
-                    accessor = gltfData->accessors[indicesIndex];
-                    bufferView = gltfData->bufferViews[accessor.bufferView];
-                    buffer = gltfData->buffers[bufferView.buffer];
+        // tangents, the handedness in w is only needed for the bitangents
+        LvnVector<LvnVec4> tangents;
+        if (tangentIndex >= 0)
+        {
+            tangents.resize_uninitialized(vertexCount);
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[tangentIndex]), &tangents[0].x, sizeof(LvnVec4), 4);
+        }
+        else if (primitiveNode.value("mode", 4) >= 4 && posIndex >= 0 && normalIndex >= 0 && texIndex >= 0) // calculate tangents
+        {
+            GLTFTangentCalcInfo calcInfo{};
+            calcInfo.vertices = vertexData;
+            calcInfo.vertexCount = vertexCount;
+            calcInfo.indices = indices.data();
+            calcInfo.vertexPerFace = 3;
+            calcInfo.numFaces = indices.size() / 3;
+
+            tangents = gltfs::calculateTangents(&calcInfo);
+        }
 
-                    beginningOfData = accessor.byteOffset + bufferView.byteOffset;
-                    size_t compType = gltfs::getCompType(accessor.componentType);
+        for (uint32_t j = 0; j < vertexCount; j++)
+            vertexData[j].tangent = tangents.empty() ? LvnVec3(0.0f, 0.0f, 0.0f) : LvnVec3(tangents[j]);
 
-                    indices.resize(accessor.count);
-                    for (uint32_t j = 0; j < accessor.count; j++)
-                    {
-                        memcpy(&indices[j], &buffer[beginningOfData] + j * compType, compType);
-                    }
-                }
+        // bitangents
+        for (uint32_t j = 0; j < vertexCount; j++)
+        {
+            if (normalIndex >= 0 && tangentIndex >= 0)
+                vertexData[j].bitangent = lvn::normalize(lvn::cross(vertexData[j].normal, vertexData[j].tangent) * tangents[j].w);
+            else
+                vertexData[j].bitangent = LvnVec3(0.0f, 0.0f, 0.0f);
+        }
 
-                // color
-                LvnVector<LvnVec4> colors;
-                if (colorIndex >= 0)
-                {
-                    accessor = gltfData->accessors[colorIndex];
-                    colors.resize(accessor.count);
-                    LvnVector<float> data = gltfs::getAttributeData(gltfData, accessor);
-                    memcpy(colors.data(), data.data(), data.size() * sizeof(float));
-                }
-                else if (materialIndex >= 0) // check material for base color if no color attribute exists
-                {
-                    colors.resize(positions.size());
-                    for (uint32_t j = 0; j < positions.size(); j++)
-                        colors[j] = gltfData->materials[materialIndex].pbrMetallicRoughness.baseColorFactor;
-                }
-                else // default vertex color if no material exists
-                {
-                    colors.resize(positions.size());
-                    for (uint32_t j = 0; j < positions.size(); j++)
-                        colors[j] = LvnVec4(1, 1, 1, 1);
-                }
+        // joints
+        if (jointsIndex >= 0)
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[jointsIndex]), &vertexData[0].joints.x, vertexStride, 4);
+        else
+            for (uint32_t j = 0; j < vertexCount; j++)
+                vertexData[j].joints = LvnVec4(0.0f);
 
-                // texcoords
-                LvnVector<LvnVec2> texcoords;
-                if (texIndex >= 0)
-                {
-                    accessor = gltfData->accessors[texIndex];
-                    texcoords.resize(accessor.count);
-                    LvnVector<float> data = gltfs::getAttributeData(gltfData, accessor);
-                    memcpy(texcoords.data(), data.data(), data.size() * sizeof(float));
-                }
-                else
-                {
-                    texcoords.resize(positions.size(), 0);
-                }
+        // weights
+        if (weightsIndex >= 0)
+            gltfs::readAccessorFloats(gltfs::getAccessorView(gltfData, gltfData->accessors[weightsIndex]), &vertexData[0].weights.x, vertexStride, 4);
+        else
+            for (uint32_t j = 0; j < vertexCount; j++)
+                vertexData[j].weights = LvnVec4(0.0f);
 
-                // normals
-                LvnVector<LvnVec3> normals;
-                if (normalIndex >= 0)
-                {
-                    accessor = gltfData->accessors[normalIndex];
-                    bufferView = gltfData->bufferViews[accessor.bufferView];
-                    buffer = gltfData->buffers[bufferView.buffer];
+        // reorder triangle lists for the vertex cache, overdraw and vertex fetch, other topologies keep their order
+        bool triangleList = primitiveNode.value("mode", 4) == 4 && !indices.empty() && !vertices.empty();
+        if (gltfData->optimize != Lvn_MeshOptimizeFlag_None && triangleList)
+        {
+            uint64_t vertexCount = lvn::optimizeLoadedMesh(gltfData->optimize, indices.data(), indices.size(), vertices.data(), vertices.size(), sizeof(LvnVertex), &vertices[0].pos.x, sizeof(LvnVertex));
+            vertices.resize(vertexCount);
+        }
 
-                    beginningOfData = accessor.byteOffset + bufferView.byteOffset;
+        uint64_t vertexSize = vertices.size() * lvn::vertexLayoutGetStride(gltfData->vertexLayout);
+        primitive->indexOffset = vertexSize;
+
+        // simplified index ranges go after the full indices in the same buffer
+        LvnVector<uint32_t> lodIndices;
+        if (!vertices.empty())
+            lvn::computeLoadedMeshBounds(&vertices[0].pos.x, vertices.size(), sizeof(LvnVertex), primitive);
+        if ((gltfData->optimize & Lvn_MeshOptimizeFlag_GenerateLods) && triangleList)
+            lvn::generateLoadedMeshLods(gltfData->optimize, indices.data(), indices.size(), &vertices[0].pos.x, vertices.size(), sizeof(LvnVertex), &lodIndices, primitive);
+
+        // pack the buffer, the vertices are converted to the vertex layout of the model
+        LvnVector<uint8_t>& bufferData = job->bufferData;
+        bufferData.resize_uninitialized(vertexSize + (indices.size() + lodIndices.size()) * sizeof(uint32_t));
+        lvn::vertexLayoutPack(gltfData->vertexLayout, vertices.data(), vertices.size(), bufferData.data());
+        memcpy(bufferData.data() + vertexSize, indices.data(), indices.size() * sizeof(uint32_t));
+        if (!lodIndices.empty())
+            memcpy(bufferData.data() + vertexSize + indices.size() * sizeof(uint32_t), lodIndices.data(), lodIndices.size() * sizeof(uint32_t));
+
+        primitive->vertexCount = vertices.size();
+        primitive->indexCount = indices.size();
+        primitive->topology = gltfs::getTopologyEnum(primitiveNode.value("mode", 4));
+    }
+    static void loadPrimitivesJob(uint32_t start, uint32_t end, void* arg)
+    {
+        GLTFMeshJobData* data = static_cast<GLTFMeshJobData*>(arg);
 
-                    normals.resize(accessor.count);
-                    for (uint32_t j = 0; j < accessor.count; j++)
-                        normals[j] = *reinterpret_cast<LvnVec3*>(&buffer[beginningOfData] + j * 3 * sizeof(float));
-                }
-                else
-                {
-                    normals.resize(positions.size(), 0);
-                }
+        for (uint32_t i = start; i < end; i++)
+        {
+            gltfs::loadPrimitiveData(data->gltfData, &data->primitiveJobs[i]);
 
-                // tangents
-                LvnVector<LvnVec4> tangents;
-                if (tangentIndex >= 0)
-                {
-                    accessor = gltfData->accessors[tangentIndex];
-                    bufferView = gltfData->bufferViews[accessor.bufferView];
-                    buffer = gltfData->buffers[bufferView.buffer];
+            // vulkan creates resources from any thread, opengl borrows one of its worker contexts for the upload
+            gltfs::createPrimitiveBuffer(&data->primitiveJobs[i]);
+        }
+    }
+    static void createPrimitiveBuffer(GLTFPrimitiveJob* job)
+    {
+        LvnBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.type = Lvn_BufferType_Vertex;
+        if (job->primitive->indexCount > 0) bufferCreateInfo.type |= Lvn_BufferType_Index;
+        bufferCreateInfo.usage = Lvn_BufferUsage_Static;
+        bufferCreateInfo.size = job->bufferData.size();
+        bufferCreateInfo.data = job->bufferData.data();
+
+        lvn::createBuffer(&job->primitive->buffer, &bufferCreateInfo);
+    }
+    static LvnVector<LvnMesh> loadMeshes(GLTFLoadData* gltfData, LvnVector<GLTFPrimitiveJob>* pPrimitiveJobs)
+    {
+        const nlm::json& JSON = gltfData->JSON;
 
-                    beginningOfData = accessor.byteOffset + bufferView.byteOffset;
+        if (!JSON.contains("meshes"))
+            return {};
 
-                    tangents.resize(accessor.count);
-                    for (uint32_t j = 0; j < accessor.count; j++)
-                        tangents[j] = *reinterpret_cast<LvnVec4*>(&buffer[beginningOfData] + j * 4 * sizeof(float));
-                }
-                else if (primitiveNode.value("mode", 4) >= 4 && posIndex >= 0 && normalIndex >= 0 && texIndex >= 0) // calculate tangents
-                {
-                    GLTFTangentCalcInfo calcInfo{};
-                    calcInfo.positions = positions;
-                    calcInfo.normals = normals;
-                    calcInfo.texUVs = texcoords;
-                    calcInfo.indices = indices;
-                    calcInfo.vertexPerFace = 3;
-                    calcInfo.numFaces = indices.size() / 3;
-
-                    tangents = gltfs::calculateTangents(&calcInfo);
-                }
-                else // mesh has no tangents
-                {
-                    tangents.resize(positions.size(), 0);
-                }
+        LvnVector<LvnMesh> meshes((JSON["meshes"].size()));
+        LvnVector<GLTFPrimitiveJob>& primitiveJobs = *pPrimitiveJobs;
 
-                // bitangents
-                LvnVector<LvnVec3> bitangents;
-                if (normalIndex >= 0 && tangentIndex >= 0)
-                {
-                    bitangents = gltfs::calculateBitangents(normals, tangents);
-                }
-                else
-                {
-                    bitangents.resize(positions.size(), 0);
-                }
+        // the primitives are allocated up front so the jobs can write to them in place
+        uint32_t primitiveCount = 0;
+        for (uint32_t meshIndex = 0; meshIndex < JSON["meshes"].size(); meshIndex++)
+        {
+            meshes[meshIndex].primitives.resize(JSON["meshes"][meshIndex]["primitives"].size());
+            primitiveCount += JSON["meshes"][meshIndex]["primitives"].size();
+        }
 
-                // joints
-                LvnVector<LvnVec4> joints;
-                if (jointsIndex >= 0)
-                {
-                    accessor = gltfData->accessors[jointsIndex];
-                    joints.resize(accessor.count);
-                    LvnVector<float> data = gltfs::getAttributeData(gltfData, accessor);
-                    memcpy(joints.data(), data.data(), data.size() * sizeof(float));
-                }
-                else
-                {
-                    joints.resize(positions.size(), 0);
-                }
+        primitiveJobs.resize(primitiveCount);
+        for (uint32_t meshIndex = 0, jobIndex = 0; meshIndex < JSON["meshes"].size(); meshIndex++)
+        {
+            for (uint32_t i = 0; i < JSON["meshes"][meshIndex]["primitives"].size(); i++, jobIndex++)
+            {
+                primitiveJobs[jobIndex].primitiveNode = &JSON["meshes"][meshIndex]["primitives"][i];
+                primitiveJobs[jobIndex].primitive = &meshes[meshIndex].primitives[i];
+            }
+        }
 
-                // weights
-                LvnVector<LvnVec4> weights;
-                if (weightsIndex >= 0)
-                {
-                    accessor = gltfData->accessors[weightsIndex];
-                    weights.resize(accessor.count);
-                    LvnVector<float> data = gltfs::getAttributeData(gltfData, accessor);
-                    memcpy(weights.data(), data.data(), data.size() * sizeof(float));
-                }
-                else
-                {
-                    weights.resize(positions.size(), 0);
-                }
+        // one range per primitive, primitives differ too much in size to batch them evenly
+        GLTFMeshJobData jobData{};
+        jobData.gltfData = gltfData;
+        jobData.primitiveJobs = primitiveJobs.data();
+        lvn::parallelFor(primitiveJobs.size(), 1, gltfs::loadPrimitivesJob, &jobData);
 
-                // combine vertex data
-                LvnVector<LvnVertex> vertices;
-                vertices.resize(positions.size());
+        return meshes;
+    }
+    // collects the buffers the workers created and creates the material textures of the loaded primitives in order, the images must have finished decoding
+    static void createMeshResources(GLTFLoadData* gltfData, LvnVector<GLTFPrimitiveJob>& primitiveJobs)
+    {
+        for (uint32_t i = 0; i < primitiveJobs.size(); i++)
+        {
+            const nlm::json& primitiveNode = *primitiveJobs[i].primitiveNode;
+            LvnPrimitive* primitive = primitiveJobs[i].primitive;
+            LvnVector<uint8_t>& bufferData = primitiveJobs[i].bufferData;
 
-                for (uint32_t j = 0; j < positions.size(); j++)
-                {
-                    vertices[j] = LvnVertex {
-                        positions[j],
-                        colors[j],
-                        texcoords[j],
-                        normals[j],
-                        LvnVec3(tangents[j]),
-                        bitangents[j],
-                        joints[j],
-                        weights[j],
-                    };
-                }
+            int materialIndex = primitiveNode.value("material", -1);
 
-                // create buffer
-                LvnVertexAttribute meshVertexAttributes[] =
-                {
-                    { 0, 0, Lvn_AttributeFormat_Vec3_f32, 0 },                   // pos
-                    { 0, 1, Lvn_AttributeFormat_Vec4_f32, 3 * sizeof(float) },   // color
-                    { 0, 2, Lvn_AttributeFormat_Vec2_f32, 7 * sizeof(float) },   // texUV
-                    { 0, 3, Lvn_AttributeFormat_Vec3_f32, 9 * sizeof(float) },   // normal
-                    { 0, 4, Lvn_AttributeFormat_Vec3_f32, 12 * sizeof(float) },  // tangent
-                    { 0, 5, Lvn_AttributeFormat_Vec3_f32, 15 * sizeof(float) },  // bitangent
-                    { 0, 6, Lvn_AttributeFormat_Vec4_f32, 18 * sizeof(float) },  // joints
-                    { 0, 7, Lvn_AttributeFormat_Vec4_f32, 22 * sizeof(float) },  // weights
-                };
-
-                LvnVertexBindingDescription meshVertexBindingDescription;
-                meshVertexBindingDescription.binding = 0;
-                meshVertexBindingDescription.stride = sizeof(LvnVertex);
-
-                LvnVector<uint8_t> bufferData(vertices.size() * sizeof(LvnVertex) + indices.size() * sizeof(uint32_t));
-                memcpy(bufferData.data(), vertices.data(), vertices.size() * sizeof(LvnVertex));
-                memcpy(bufferData.data() + vertices.size() * sizeof(LvnVertex), indices.data(), indices.size() * sizeof(uint32_t));
-
-                LvnBufferCreateInfo bufferCreateInfo{};
-                bufferCreateInfo.type = Lvn_BufferType_Vertex;
-                if (!indices.empty()) bufferCreateInfo.type |= Lvn_BufferType_Index;
-                bufferCreateInfo.usage = Lvn_BufferUsage_Static;
-                bufferCreateInfo.size = vertices.size() * sizeof(LvnVertex) + indices.size() * sizeof(uint32_t);
-                bufferCreateInfo.data = bufferData.data();
-
-                LvnBuffer* meshBuffer;
-                lvn::createBuffer(&meshBuffer, &bufferCreateInfo);
-                meshPrimitives[i].buffer = meshBuffer;
-                gltfData->meshBuffers.push_back(meshBuffer);
-
-                meshPrimitives[i].vertexCount = vertices.size();
-                meshPrimitives[i].indexCount = indices.size();
-                meshPrimitives[i].indexOffset = vertices.size() * sizeof(LvnVertex);
-
-                // material textures
-                if (materialIndex >= 0)
-                {
-                    meshPrimitives[i].material = gltfs::getMaterial(gltfData, materialIndex);
-                }
-                else
-                {
-                    meshPrimitives[i].material.albedo = gltfData->defaultBaseColorTexture;
-                    meshPrimitives[i].material.metallicRoughnessOcclusion = gltfData->defaultMetalicRoughnessTexture;
-                    meshPrimitives[i].material.normal = gltfData->defaultNormalTexture;
-                    meshPrimitives[i].material.emissive = gltfData->defaultEmissiveTexture;
-                    meshPrimitives[i].material.baseColorFactor = LvnVec4(1, 1, 1, 1);
-                    meshPrimitives[i].material.metallicFactor = 1.0f;
-                    meshPrimitives[i].material.roughnessFactor = 1.0f;
-                    meshPrimitives[i].material.emissiveFactor = LvnVec3(0, 0, 0);
-                    meshPrimitives[i].material.doubleSided = false;
-
-                    // load all default textures if no material found
-                    gltfs::loadDefaultTextures(gltfData);
-                    meshPrimitives[i].material.albedo = gltfData->defaultBaseColorTexture;
-                    meshPrimitives[i].material.metallicRoughnessOcclusion = gltfData->defaultMetalicRoughnessTexture;
-                    meshPrimitives[i].material.normal = gltfData->defaultNormalTexture;
-                    meshPrimitives[i].material.emissive = gltfData->defaultEmissiveTexture;
-                }
+            LvnBuffer* meshBuffer = primitive->buffer;
+            gltfData->meshBuffers.push_back(meshBuffer);
 
-                meshPrimitives[i].topology = gltfs::getTopologyEnum(primitiveNode.value("mode", 4));
+            if (gltfData->cook)
+            {
+                LvnBufferTypeFlagBits bufferType = Lvn_BufferType_Vertex;
+                if (primitive->indexCount > 0) bufferType |= Lvn_BufferType_Index;
+                gltfData->cook->buffers.push_back({ meshBuffer, bufferType, LvnBin(lvn::move(bufferData)) });
             }
+            else
+                bufferData = LvnVector<uint8_t>(); // release the staging data as soon as it is uploaded
 
-            LvnMesh mesh{};
-            mesh.primitives = lvn::move(meshPrimitives);
-            meshes[meshIndex] = lvn::move(mesh);
+            // material textures
+            if (materialIndex >= 0)
+            {
+                primitive->material = gltfs::getMaterial(gltfData, materialIndex);
+            }
+            else
+            {
+                primitive->material.albedo = gltfData->defaultBaseColorTexture;
+                primitive->material.metallicRoughnessOcclusion = gltfData->defaultMetalicRoughnessTexture;
+                primitive->material.normal = gltfData->defaultNormalTexture;
+                primitive->material.emissive = gltfData->defaultEmissiveTexture;
+                primitive->material.baseColorFactor = LvnVec4(1, 1, 1, 1);
+                primitive->material.metallicFactor = 1.0f;
+                primitive->material.roughnessFactor = 1.0f;
+                primitive->material.emissiveFactor = LvnVec3(0, 0, 0);
+                primitive->material.doubleSided = false;
+
+                // load all default textures if no material found
+                gltfs::loadDefaultTextures(gltfData);
+                primitive->material.albedo = gltfData->defaultBaseColorTexture;
+                primitive->material.metallicRoughnessOcclusion = gltfData->defaultMetalicRoughnessTexture;
+                primitive->material.normal = gltfData->defaultNormalTexture;
+                primitive->material.emissive = gltfData->defaultEmissiveTexture;
+            }
         }
-
-        return meshes;
     }
     static void bindMeshToNodes(GLTFLoadData* gltfData)
     {
@@ -1473,49 +1997,62 @@ namespace gltfs
                 int32_t meshIndex = JSON["nodes"][i]["mesh"];
         }
     }
-    static LvnModel loadGltfModelFileType(const char* filepath, LvnFileType filetype)
+    static LvnModel loadGltfModelFileType(const char* filepath, LvnFileType filetype, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize, LvnModelCookData* cook)
     {
         LvnContext* lvnctx = lvn::getContext();
 
         gltfs::GLTFLoadData gltfData{};
         gltfData.filepath = filepath;
         gltfData.filetype = filetype;
+        gltfData.cook = cook;
+        gltfData.vertexLayout = layout;
+        gltfData.optimize = optimize;
 
         if (filetype == Lvn_FileType_Gltf) // gltf text file
         {
-            std::string jsonText = lvn::loadFileSrc(filepath).c_str();
-            gltfData.JSON = nlm::json::parse(jsonText);
+            gltfData.fileData = lvn::loadFileMapped(filepath);
+            const char* jsonText = reinterpret_cast<const char*>(gltfData.fileData.data());
+            if (!gltfs::parseJson(&gltfData, jsonText, jsonText + gltfData.fileData.size()))
+                return LvnModel{};
+
             gltfData.buffers = std::move(gltfs::loadBuffers(gltfData.JSON, filepath)); // load buffers from external file
         }
         else if (filetype == Lvn_FileType_Glb) // glb binary file
         {
-            LvnBin binData = lvn::loadFileSrcBin(filepath);
+            gltfData.fileData = lvn::loadFileMapped(filepath);
+            const LvnBin& binData = gltfData.fileData;
 
             // chunk 0 (JSON)
             uint32_t chunkLengthJson = 0;
             memcpy(&chunkLengthJson, &binData[12], sizeof(uint32_t));
-            LvnVector<uint8_t> chunkDataJson(&binData[20], &binData[20] + chunkLengthJson);
 
-            std::string jsonText = std::string(chunkDataJson.begin(), chunkDataJson.end());
-            gltfData.JSON = nlm::json::parse(jsonText);
-            nlm::json JSON = gltfData.JSON;
+            const char* jsonText = reinterpret_cast<const char*>(&binData[20]);
+            if (!gltfs::parseJson(&gltfData, jsonText, jsonText + chunkLengthJson))
+                return LvnModel{};
+
+            nlm::json& JSON = gltfData.JSON;
 
             // load buffers; buffer are stored in binary file, chunk 1...n after chunk 0
             uint64_t chunkOffset = 0;
             gltfData.buffers.resize(JSON["buffers"].size());
             for (int i = 0; i < JSON["buffers"].size(); i++)
             {
+                // fallback buffers of meshopt compressed views have no chunk
+                if (gltfs::isMeshoptFallbackBuffer(JSON["buffers"][i]))
+                    continue;
+
                 // chunk 1... (Buffer)
                 uint32_t chunkLengthBuffer = 0;
                 memcpy(&chunkLengthBuffer, &binData[20 + chunkLengthJson + chunkOffset], sizeof(uint32_t));
-                LvnVector<uint8_t> chunkDataBuffer(&binData[28 + chunkLengthJson + chunkOffset], &binData[28 + chunkLengthJson + chunkOffset] + chunkLengthBuffer);
-
-                gltfData.buffers[i] = LvnBin(chunkDataBuffer.data(), chunkDataBuffer.size());
+                gltfData.buffers[i] = LvnBin::view(&binData[28 + chunkLengthJson + chunkOffset], chunkLengthBuffer);
                 chunkOffset += chunkLengthBuffer + 8;
             }
         }
 
-        nlm::json JSON = gltfData.JSON;
+        nlm::json& JSON = gltfData.JSON;
+
+        if (!gltfs::checkRequiredExtensions(&gltfData) || !gltfs::decodeMeshoptBufferViews(&gltfData))
+            return LvnModel{};
 
         if (JSON["scenes"].size() > 1)
             LVN_CORE_WARN("gltf model has more than one scene, loading mesh data from the first scene; Filepath: %s", filepath);
@@ -1526,13 +2063,10 @@ namespace gltfs
             gltfData.textures.resize(JSON["textures"].size());
         }
 
-        gltfData.accessors = std::move(gltfs::loadAccessors(gltfData.JSON));
-        gltfData.bufferViews = std::move(gltfs::loadBufferViews(gltfData.JSON));
-        gltfData.materials = std::move(gltfs::loadMaterials(gltfData.JSON));
         gltfData.animations = std::move(gltfs::loadAnimations(gltfData.JSON));
         gltfData.skins = std::move(gltfs::loadSkins(gltfData.JSON));
-        gltfData.images = std::move(gltfs::loadImages(gltfData));
-        gltfData.samplers = std::move(gltfs::loadSamplers(gltfData.JSON, &gltfData.defaultSampler));
+        gltfs::loadImages(&gltfData); // decodes on the workers while the nodes and meshes load below
+        gltfData.samplers = std::move(gltfs::loadSamplers(gltfData.JSON, &gltfData.defaultSampler, cook));
 
         LvnNode defaultNode{};
         defaultNode.parent = -1;
@@ -1550,18 +2084,29 @@ namespace gltfs
         }
 
         LvnVector<LvnAnimation> modelAnimations;
-        std::future<LvnVector<LvnAnimation>> animationFuture;
+        gltfs::GLTFAnimationJob animationJob{};
+        LvnJobCounter animationCounter;
 
         if (lvnctx->multithreading)
-            animationFuture = std::async(std::launch::async, gltfs::bindAnimationsToNodes, gltfData);
+        {
+            animationJob.gltfData = &gltfData;
+            lvn::jobSubmit(gltfs::bindAnimationsJob, &animationJob, &animationCounter);
+        }
         else
             modelAnimations = std::move(gltfs::bindAnimationsToNodes(gltfData));
 
-        gltfData.meshes = std::move(gltfs::loadMeshes(&gltfData));
+        // cpu side mesh work runs in parallel, then the gpu resources are created in order once the images are decoded
+        LvnVector<gltfs::GLTFPrimitiveJob> primitiveJobs;
+        gltfData.meshes = std::move(gltfs::loadMeshes(&gltfData, &primitiveJobs));
+        lvn::jobWait(&gltfData.imageCounter);
+        gltfs::createMeshResources(&gltfData, primitiveJobs);
         gltfs::bindMeshToNodes(&gltfData);
 
         if (lvnctx->multithreading)
-            modelAnimations = std::move(animationFuture.get());
+        {
+            lvn::jobWait(&animationCounter);
+            modelAnimations = std::move(animationJob.animations);
+        }
 
         LvnModel model{};
         model.skins = std::move(gltfs::bindSkinsToNodes(gltfData));
@@ -1573,19 +2118,20 @@ namespace gltfs
         model.textures = std::move(gltfData.textures);
         model.samplers = std::move(gltfData.samplers);
         model.matrix = LvnMat4(1.0f);
+        model.vertexLayout = layout;
 
         return model;
     }
 
 } /* namespace gltf */
 
-LvnModel loadGltfModel(const char* filepath)
+LvnModel loadGltfModel(const char* filepath, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize, LvnModelCookData* cook)
 {
-    return gltfs::loadGltfModelFileType(filepath, Lvn_FileType_Gltf);
+    return gltfs::loadGltfModelFileType(filepath, Lvn_FileType_Gltf, layout, optimize, cook);
 }
-LvnModel loadGlbModel(const char* filepath)
+LvnModel loadGlbModel(const char* filepath, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize, LvnModelCookData* cook)
 {
-    return gltfs::loadGltfModelFileType(filepath, Lvn_FileType_Glb);
+    return gltfs::loadGltfModelFileType(filepath, Lvn_FileType_Glb, layout, optimize, cook);
 }
 
 } /* namespace lvn */
@@ -0,0 +1,623 @@
+#include "levikno.h"
+#include "lvn_loaders.h"
+
+#include <cstdio>
+
+
+// cooked model files (.lvnmodel) hold a loaded model in the layout it is uploaded in, so loading one is mapping the file,
+// checking the tables and handing the vertex, index and pixel data straight to createBuffer and createTexture
+//
+// layout: header, tables of fixed size records, then the variable length data (children, joints, keyframes, names,
+// vertex and index blobs, pixel data), every table and blob starts at LVN_MODEL_CACHE_ALIGNMENT
+// records refer to other tables by index and to the data by byte offset from the start of the file
+// the file is written in the native byte order and struct layout, it is rebuilt from the source model and not meant to be shared between platforms
+
+#define LVN_MODEL_CACHE_MAGIC 0x444d564c // "LVMD"
+#define LVN_MODEL_CACHE_VERSION 5
+#define LVN_MODEL_CACHE_ALIGNMENT 16
+
+namespace lvn
+{
+
+struct LvnModelCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+
+    uint32_t nodeCount, rootNodeCount, meshCount, primitiveCount;
+    uint32_t skinCount, animationCount, channelCount, samplerCount;
+    uint32_t textureCount, imageCount, bufferCount, lodCount;
+
+    uint64_t nodesOffset, rootNodesOffset, meshesOffset, primitivesOffset;
+    uint64_t skinsOffset, animationsOffset, channelsOffset, samplersOffset;
+    uint64_t texturesOffset, imagesOffset, buffersOffset, lodsOffset;
+    uint64_t fileSize;
+
+    LvnMat4 matrix;
+    uint32_t vertexAttributes, vertexQuantized; // vertex layout the mesh buffers were packed in
+};
+
+struct LvnModelCacheNode
+{
+    LvnTransform transform;
+    LvnMat4 matrix;
+    int32_t parent, mesh, skin;
+    uint32_t childCount;
+    uint64_t childrenOffset;
+    uint64_t instancesOffset; // EXT_mesh_gpu_instancing transforms of the node
+    uint32_t instanceCount, reserved;
+};
+
+struct LvnModelCacheMesh
+{
+    uint32_t firstPrimitive, primitiveCount;
+};
+
+struct LvnModelCachePrimitive
+{
+    uint32_t topology;
+    uint32_t buffer;
+    uint32_t vertexCount, indexCount;
+    uint64_t indexOffset;
+
+    LvnVec3 baseColorFactor, emissiveFactor;
+    float metallicFactor, roughnessFactor;
+    int32_t albedo, metallicRoughnessOcclusion, normal, emissive; // texture indices, -1 for no texture
+    uint32_t doubleSided;
+
+    LvnVec3 boundsCenter;
+    float boundsRadius;
+    LvnVec3 boundsMin, boundsMax;
+    uint32_t firstLod, lodCount;
+};
+
+struct LvnModelCacheLod
+{
+    uint64_t indexOffset;
+    uint32_t indexCount;
+    float error;
+};
+
+struct LvnModelCacheSkin
+{
+    uint64_t nameOffset;
+    uint64_t jointsOffset;
+    uint64_t inverseBindMatricesOffset;
+    uint32_t nameLength, jointCount, inverseBindMatrixCount, reserved;
+};
+
+struct LvnModelCacheAnimation
+{
+    float start, end;
+    uint32_t firstChannel, channelCount;
+};
+
+struct LvnModelCacheChannel
+{
+    uint64_t keyFramesOffset;
+    uint64_t outputsOffset;
+    uint32_t keyFrameCount, outputCount;
+    uint32_t path, interpolation;
+    int32_t node;
+    uint32_t reserved;
+};
+
+struct LvnModelCacheSampler
+{
+    uint32_t minFilter, magFilter, wrapS, wrapT;
+};
+
+struct LvnModelCacheTexture
+{
+    uint32_t format;
+    uint32_t sampler;
+    uint32_t firstImage, imageCount; // the base image followed by its mip levels
+};
+
+struct LvnModelCacheImage
+{
+    uint64_t dataOffset, size;
+    uint32_t width, height, channels, compression;
+};
+
+struct LvnModelCacheBuffer
+{
+    uint64_t dataOffset, size;
+    uint32_t type, reserved;
+};
+
+
+// [Write]
+
+static uint64_t modelCacheAppend(LvnVector<uint8_t>& file, const void* data, uint64_t size)
+{
+    uint64_t offset = (file.size() + LVN_MODEL_CACHE_ALIGNMENT - 1) & ~static_cast<uint64_t>(LVN_MODEL_CACHE_ALIGNMENT - 1);
+    file.resize(offset + size);
+    if (size > 0)
+        memcpy(file.data() + offset, data, size);
+
+    return offset;
+}
+
+template <typename T>
+static uint64_t modelCacheAppendArray(LvnVector<uint8_t>& file, const T* data, uint64_t count)
+{
+    return lvn::modelCacheAppend(file, data, count * sizeof(T));
+}
+
+// gpu handles of the model are written as their index in the cook data, -1 for nullptr or a resource that was not recorded
+static int32_t modelCacheFindIndex(LvnHashMap<uint64_t, int32_t>& indices, const void* resource)
+{
+    uint64_t key = reinterpret_cast<uintptr_t>(resource);
+    return resource != nullptr && indices.contains(key) ? indices.at(key) : -1;
+}
+
+LvnResult writeLvnModel(const char* filepath, const LvnModel& model, const LvnModelCookData& cook)
+{
+    // resources are referred to by their index in the cook data, the model only holds the gpu handles
+    LvnHashMap<uint64_t, int32_t> samplers, textures, buffers;
+    for (uint32_t i = 0; i < cook.samplers.size(); i++) samplers.insert(reinterpret_cast<uintptr_t>(cook.samplers[i].sampler), i);
+    for (uint32_t i = 0; i < cook.textures.size(); i++) textures.insert(reinterpret_cast<uintptr_t>(cook.textures[i].texture), i);
+    for (uint32_t i = 0; i < cook.buffers.size(); i++) buffers.insert(reinterpret_cast<uintptr_t>(cook.buffers[i].buffer), i);
+
+    LvnVector<uint8_t> file(sizeof(LvnModelCacheHeader));
+
+    LvnModelCacheHeader header{};
+    header.magic = LVN_MODEL_CACHE_MAGIC;
+    header.version = LVN_MODEL_CACHE_VERSION;
+    header.matrix = model.matrix;
+    header.vertexAttributes = model.vertexLayout.attributes;
+    header.vertexQuantized = model.vertexLayout.quantized ? 1 : 0;
+
+    // nodes
+    LvnVector<LvnModelCacheNode> nodes(model.nodes.size());
+    for (uint32_t i = 0; i < model.nodes.size(); i++)
+    {
+        const LvnNode& node = model.nodes[i];
+        nodes[i].transform = node.transform;
+        nodes[i].matrix = node.matrix;
+        nodes[i].parent = node.parent;
+        nodes[i].mesh = node.mesh;
+        nodes[i].skin = node.skin;
+        nodes[i].childCount = node.children.size();
+        nodes[i].childrenOffset = lvn::modelCacheAppendArray(file, node.children.data(), node.children.size());
+        nodes[i].instanceCount = node.instances.size();
+        nodes[i].instancesOffset = lvn::modelCacheAppendArray(file, node.instances.data(), node.instances.size());
+    }
+
+    header.rootNodeCount = model.rootNodes.size();
+    header.rootNodesOffset = lvn::modelCacheAppendArray(file, model.rootNodes.data(), model.rootNodes.size());
+
+    // meshes and primitives, the vertex and index data of every mesh buffer is already packed in the vertex layout of the model
+    LvnVector<LvnModelCacheMesh> meshes(model.meshes.size());
+    LvnVector<LvnModelCachePrimitive> primitives;
+    LvnVector<LvnModelCacheLod> lods;
+    for (uint32_t i = 0; i < model.meshes.size(); i++)
+    {
+        meshes[i].firstPrimitive = primitives.size();
+        meshes[i].primitiveCount = model.meshes[i].primitives.size();
+
+        for (const LvnPrimitive& primitive : model.meshes[i].primitives)
+        {
+            int32_t bufferIndex = lvn::modelCacheFindIndex(buffers, primitive.buffer);
+            if (bufferIndex < 0)
+            {
+                LVN_CORE_ERROR("writeLvnModel(const char*, const LvnModel&, const LvnModelCookData&) | primitive buffer of mesh %u was not recorded while loading the model", i);
+                return Lvn_Result_Failure;
+            }
+
+            LvnModelCachePrimitive cachePrimitive{};
+            cachePrimitive.topology = primitive.topology;
+            cachePrimitive.buffer = bufferIndex;
+            cachePrimitive.vertexCount = primitive.vertexCount;
+            cachePrimitive.indexCount = primitive.indexCount;
+            cachePrimitive.indexOffset = primitive.indexOffset;
+            cachePrimitive.baseColorFactor = primitive.material.baseColorFactor;
+            cachePrimitive.emissiveFactor = primitive.material.emissiveFactor;
+            cachePrimitive.metallicFactor = primitive.material.metallicFactor;
+            cachePrimitive.roughnessFactor = primitive.material.roughnessFactor;
+            cachePrimitive.albedo = lvn::modelCacheFindIndex(textures, primitive.material.albedo);
+            cachePrimitive.metallicRoughnessOcclusion = lvn::modelCacheFindIndex(textures, primitive.material.metallicRoughnessOcclusion);
+            cachePrimitive.normal = lvn::modelCacheFindIndex(textures, primitive.material.normal);
+            cachePrimitive.emissive = lvn::modelCacheFindIndex(textures, primitive.material.emissive);
+            cachePrimitive.doubleSided = primitive.material.doubleSided;
+            cachePrimitive.boundsCenter = primitive.boundsCenter;
+            cachePrimitive.boundsRadius = primitive.boundsRadius;
+            cachePrimitive.boundsMin = primitive.boundsMin;
+            cachePrimitive.boundsMax = primitive.boundsMax;
+            cachePrimitive.firstLod = lods.size();
+            cachePrimitive.lodCount = primitive.lods.size();
+            primitives.push_back(cachePrimitive);
+
+            for (const LvnPrimitiveLod& lod : primitive.lods)
+                lods.push_back({ lod.indexOffset, lod.indexCount, lod.error });
+        }
+    }
+
+    // skins, the joint matrix storage buffers are recreated from the inverse bind matrices on load
+    LvnVector<LvnModelCacheSkin> skins(model.skins.size());
+    for (uint32_t i = 0; i < model.skins.size(); i++)
+    {
+        const LvnSkin& skin = model.skins[i];
+        skins[i].nameLength = skin.name.size();
+        skins[i].nameOffset = lvn::modelCacheAppend(file, skin.name.c_str(), skin.name.size());
+        skins[i].jointCount = skin.joints.size();
+        skins[i].jointsOffset = lvn::modelCacheAppendArray(file, skin.joints.data(), skin.joints.size());
+        skins[i].inverseBindMatrixCount = skin.inverseBindMatrices.size();
+        skins[i].inverseBindMatricesOffset = lvn::modelCacheAppendArray(file, skin.inverseBindMatrices.data(), skin.inverseBindMatrices.size());
+    }
+
+    // animations
+    LvnVector<LvnModelCacheAnimation> animations(model.animations.size());
+    LvnVector<LvnModelCacheChannel> channels;
+    for (uint32_t i = 0; i < model.animations.size(); i++)
+    {
+        const LvnAnimation& animation = model.animations[i];
+        animations[i].start = animation.start;
+        animations[i].end = animation.end;
+        animations[i].firstChannel = channels.size();
+        animations[i].channelCount = animation.channels.size();
+
+        for (const LvnAnimationChannel& channel : animation.channels)
+        {
+            LvnModelCacheChannel cacheChannel{};
+            cacheChannel.path = channel.path;
+            cacheChannel.interpolation = channel.interpolation;
+            cacheChannel.node = channel.node;
+            cacheChannel.keyFrameCount = channel.keyFrames.size();
+            cacheChannel.keyFramesOffset = lvn::modelCacheAppendArray(file, channel.keyFrames.data(), channel.keyFrames.size());
+            cacheChannel.outputCount = channel.outputs.size();
+            cacheChannel.outputsOffset = lvn::modelCacheAppendArray(file, channel.outputs.data(), channel.outputs.size());
+            channels.push_back(cacheChannel);
+        }
+    }
+
+    // samplers and textures, block compressed images are kept compressed with their mip levels
+    LvnVector<LvnModelCacheSampler> cacheSamplers(cook.samplers.size());
+    for (uint32_t i = 0; i < cook.samplers.size(); i++)
+    {
+        const LvnSamplerCreateInfo& createInfo = cook.samplers[i].createInfo;
+        cacheSamplers[i] = { (uint32_t)createInfo.minFilter, (uint32_t)createInfo.magFilter, (uint32_t)createInfo.wrapS, (uint32_t)createInfo.wrapT };
+    }
+
+    LvnVector<LvnModelCacheTexture> cacheTextures(cook.textures.size());
+    LvnVector<LvnModelCacheImage> images;
+    for (uint32_t i = 0; i < cook.textures.size(); i++)
+    {
+        const LvnModelCookTexture& texture = cook.textures[i];
+        cacheTextures[i].format = texture.format;
+        int32_t samplerIndex = lvn::modelCacheFindIndex(samplers, texture.sampler);
+        if (samplerIndex < 0)
+        {
+            LVN_CORE_ERROR("writeLvnModel(const char*, const LvnModel&, const LvnModelCookData&) | sampler of texture %u was not recorded while loading the model", i);
+            return Lvn_Result_Failure;
+        }
+        cacheTextures[i].sampler = samplerIndex;
+
+        cacheTextures[i].firstImage = images.size();
+        cacheTextures[i].imageCount = texture.mipLevels.size() + 1;
+
+        for (uint32_t j = 0; j < cacheTextures[i].imageCount; j++)
+        {
+            const LvnImageData& image = j == 0 ? texture.image : texture.mipLevels[j - 1];
+
+            LvnModelCacheImage cacheImage{};
+            cacheImage.width = image.width;
+            cacheImage.height = image.height;
+            cacheImage.channels = image.channels;
+            cacheImage.compression = image.compression;
+            cacheImage.size = image.pixels.size();
+            cacheImage.dataOffset = lvn::modelCacheAppend(file, image.pixels.data(), image.pixels.size());
+            images.push_back(cacheImage);
+        }
+    }
+
+    // mesh buffers
+    LvnVector<LvnModelCacheBuffer> cacheBuffers(cook.buffers.size());
+    for (uint32_t i = 0; i < cook.buffers.size(); i++)
+    {
+        cacheBuffers[i].type = cook.buffers[i].type;
+        cacheBuffers[i].size = cook.buffers[i].data.size();
+        cacheBuffers[i].dataOffset = lvn::modelCacheAppend(file, cook.buffers[i].data.data(), cook.buffers[i].data.size());
+    }
+
+    // tables
+    header.nodeCount = nodes.size();
+    header.nodesOffset = lvn::modelCacheAppendArray(file, nodes.data(), nodes.size());
+    header.meshCount = meshes.size();
+    header.meshesOffset = lvn::modelCacheAppendArray(file, meshes.data(), meshes.size());
+    header.primitiveCount = primitives.size();
+    header.primitivesOffset = lvn::modelCacheAppendArray(file, primitives.data(), primitives.size());
+    header.skinCount = skins.size();
+    header.skinsOffset = lvn::modelCacheAppendArray(file, skins.data(), skins.size());
+    header.animationCount = animations.size();
+    header.animationsOffset = lvn::modelCacheAppendArray(file, animations.data(), animations.size());
+    header.channelCount = channels.size();
+    header.channelsOffset = lvn::modelCacheAppendArray(file, channels.data(), channels.size());
+    header.samplerCount = cacheSamplers.size();
+    header.samplersOffset = lvn::modelCacheAppendArray(file, cacheSamplers.data(), cacheSamplers.size());
+    header.textureCount = cacheTextures.size();
+    header.texturesOffset = lvn::modelCacheAppendArray(file, cacheTextures.data(), cacheTextures.size());
+    header.imageCount = images.size();
+    header.imagesOffset = lvn::modelCacheAppendArray(file, images.data(), images.size());
+    header.bufferCount = cacheBuffers.size();
+    header.buffersOffset = lvn::modelCacheAppendArray(file, cacheBuffers.data(), cacheBuffers.size());
+    header.lodCount = lods.size();
+    header.lodsOffset = lvn::modelCacheAppendArray(file, lods.data(), lods.size());
+    header.fileSize = file.size();
+    memcpy(file.data(), &header, sizeof(LvnModelCacheHeader));
+
+    FILE* fileptr = fopen(filepath, "wb");
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("writeLvnModel(const char*, const LvnModel&, const LvnModelCookData&) | cannot open file for writing: %s", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    bool written = fwrite(file.data(), sizeof(uint8_t), file.size(), fileptr) == file.size();
+    fclose(fileptr);
+
+    if (!written)
+    {
+        LVN_CORE_ERROR("writeLvnModel(const char*, const LvnModel&, const LvnModelCookData&) | failed to write cooked model file: %s", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
+
+// [Load]
+
+// returns the records at offset if count of them fit in the file, nullptr otherwise
+template <typename T>
+static const T* modelCacheGet(const LvnBin& file, uint64_t offset, uint64_t count)
+{
+    if (offset % alignof(T) != 0 || offset > file.size() || count > (file.size() - offset) / sizeof(T))
+        return nullptr;
+
+    return reinterpret_cast<const T*>(file.data() + offset);
+}
+
+LvnModel loadLvnModel(const char* filepath)
+{
+    LvnBin file = lvn::loadFileMapped(filepath);
+
+    const LvnModelCacheHeader* header = lvn::modelCacheGet<LvnModelCacheHeader>(file, 0, 1);
+    if (!header || header->magic != LVN_MODEL_CACHE_MAGIC || header->version != LVN_MODEL_CACHE_VERSION || header->fileSize != file.size())
+    {
+        LVN_CORE_ERROR("loadModel(const char*) | file is not a complete cooked model of version %u, recook it with lvn::cookModel: %s", LVN_MODEL_CACHE_VERSION, filepath);
+        return {};
+    }
+
+    const LvnModelCacheNode* nodes = lvn::modelCacheGet<LvnModelCacheNode>(file, header->nodesOffset, header->nodeCount);
+    const int32_t* rootNodes = lvn::modelCacheGet<int32_t>(file, header->rootNodesOffset, header->rootNodeCount);
+    const LvnModelCacheMesh* meshes = lvn::modelCacheGet<LvnModelCacheMesh>(file, header->meshesOffset, header->meshCount);
+    const LvnModelCachePrimitive* primitives = lvn::modelCacheGet<LvnModelCachePrimitive>(file, header->primitivesOffset, header->primitiveCount);
+    const LvnModelCacheSkin* skins = lvn::modelCacheGet<LvnModelCacheSkin>(file, header->skinsOffset, header->skinCount);
+    const LvnModelCacheAnimation* animations = lvn::modelCacheGet<LvnModelCacheAnimation>(file, header->animationsOffset, header->animationCount);
+    const LvnModelCacheChannel* channels = lvn::modelCacheGet<LvnModelCacheChannel>(file, header->channelsOffset, header->channelCount);
+    const LvnModelCacheSampler* samplers = lvn::modelCacheGet<LvnModelCacheSampler>(file, header->samplersOffset, header->samplerCount);
+    const LvnModelCacheTexture* textures = lvn::modelCacheGet<LvnModelCacheTexture>(file, header->texturesOffset, header->textureCount);
+    const LvnModelCacheImage* images = lvn::modelCacheGet<LvnModelCacheImage>(file, header->imagesOffset, header->imageCount);
+    const LvnModelCacheBuffer* buffers = lvn::modelCacheGet<LvnModelCacheBuffer>(file, header->buffersOffset, header->bufferCount);
+    const LvnModelCacheLod* lods = lvn::modelCacheGet<LvnModelCacheLod>(file, header->lodsOffset, header->lodCount);
+
+    bool valid = nodes && rootNodes && meshes && primitives && skins && animations && channels && samplers && textures && images && buffers && lods;
+
+    // every index and blob is checked before any resource is created so a damaged file never leaves half a model behind
+    for (uint32_t i = 0; valid && i < header->nodeCount; i++)
+        valid = lvn::modelCacheGet<int32_t>(file, nodes[i].childrenOffset, nodes[i].childCount) != nullptr
+             && lvn::modelCacheGet<LvnTransform>(file, nodes[i].instancesOffset, nodes[i].instanceCount) != nullptr;
+    for (uint32_t i = 0; valid && i < header->meshCount; i++)
+        valid = (uint64_t)meshes[i].firstPrimitive + meshes[i].primitiveCount <= header->primitiveCount;
+    for (uint32_t i = 0; valid && i < header->primitiveCount; i++)
+    {
+        const LvnModelCachePrimitive& primitive = primitives[i];
+        valid = primitive.buffer < header->bufferCount
+            && primitive.albedo < (int32_t)header->textureCount && primitive.metallicRoughnessOcclusion < (int32_t)header->textureCount
+            && primitive.normal < (int32_t)header->textureCount && primitive.emissive < (int32_t)header->textureCount
+            && (uint64_t)primitive.firstLod + primitive.lodCount <= header->lodCount;
+
+        // lod index ranges are drawn straight from the buffer so they have to stay inside it
+        for (uint32_t j = 0; valid && j < primitive.lodCount; j++)
+        {
+            const LvnModelCacheLod& lod = lods[primitive.firstLod + j];
+            valid = lod.indexOffset <= buffers[primitive.buffer].size && lod.indexCount <= (buffers[primitive.buffer].size - lod.indexOffset) / sizeof(uint32_t);
+        }
+    }
+    for (uint32_t i = 0; valid && i < header->skinCount; i++)
+    {
+        valid = lvn::modelCacheGet<char>(file, skins[i].nameOffset, skins[i].nameLength)
+            && lvn::modelCacheGet<int32_t>(file, skins[i].jointsOffset, skins[i].jointCount)
+            && lvn::modelCacheGet<LvnMat4>(file, skins[i].inverseBindMatricesOffset, skins[i].inverseBindMatrixCount);
+    }
+    for (uint32_t i = 0; valid && i < header->animationCount; i++)
+        valid = (uint64_t)animations[i].firstChannel + animations[i].channelCount <= header->channelCount;
+    for (uint32_t i = 0; valid && i < header->channelCount; i++)
+    {
+        valid = lvn::modelCacheGet<float>(file, channels[i].keyFramesOffset, channels[i].keyFrameCount)
+            && lvn::modelCacheGet<LvnVec4>(file, channels[i].outputsOffset, channels[i].outputCount);
+    }
+    for (uint32_t i = 0; valid && i < header->textureCount; i++)
+    {
+        valid = textures[i].sampler < header->samplerCount && textures[i].imageCount > 0
+            && (uint64_t)textures[i].firstImage + textures[i].imageCount <= header->imageCount;
+    }
+    for (uint32_t i = 0; valid && i < header->imageCount; i++)
+        valid = lvn::modelCacheGet<uint8_t>(file, images[i].dataOffset, images[i].size) != nullptr;
+    for (uint32_t i = 0; valid && i < header->bufferCount; i++)
+        valid = lvn::modelCacheGet<uint8_t>(file, buffers[i].dataOffset, buffers[i].size) != nullptr;
+
+    if (!valid)
+    {
+        LVN_CORE_ERROR("loadModel(const char*) | cooked model file is damaged, a table or offset is out of range: %s", filepath);
+        return {};
+    }
+
+    LvnModel model{};
+    model.matrix = header->matrix;
+    model.vertexLayout.attributes = header->vertexAttributes;
+    model.vertexLayout.quantized = header->vertexQuantized != 0;
+
+    // gpu resources, the data is uploaded straight from the mapped file
+    model.samplers.resize(header->samplerCount);
+    for (uint32_t i = 0; i < header->samplerCount; i++)
+    {
+        LvnSamplerCreateInfo samplerCreateInfo{};
+        samplerCreateInfo.minFilter = static_cast<LvnTextureFilter>(samplers[i].minFilter);
+        samplerCreateInfo.magFilter = static_cast<LvnTextureFilter>(samplers[i].magFilter);
+        samplerCreateInfo.wrapS = static_cast<LvnTextureMode>(samplers[i].wrapS);
+        samplerCreateInfo.wrapT = static_cast<LvnTextureMode>(samplers[i].wrapT);
+        lvn::createSampler(&model.samplers[i], &samplerCreateInfo);
+    }
+
+    auto getImage = [&](const LvnModelCacheImage& cacheImage)
+    {
+        LvnImageData image{};
+        image.pixels = LvnBin::view(file.data() + cacheImage.dataOffset, cacheImage.size);
+        image.width = cacheImage.width;
+        image.height = cacheImage.height;
+        image.channels = cacheImage.channels;
+        image.size = cacheImage.size;
+        image.compression = static_cast<LvnTextureCompression>(cacheImage.compression);
+        return image;
+    };
+
+    model.textures.resize(header->textureCount);
+    for (uint32_t i = 0; i < header->textureCount; i++)
+    {
+        const LvnModelCacheTexture& texture = textures[i];
+
+        LvnVector<LvnImageData> mipLevels(texture.imageCount - 1);
+        for (uint32_t j = 1; j < texture.imageCount; j++)
+            mipLevels[j - 1] = getImage(images[texture.firstImage + j]);
+
+        LvnTextureSamplerCreateInfo textureCreateInfo{};
+        textureCreateInfo.imageData = getImage(images[texture.firstImage]);
+        textureCreateInfo.format = static_cast<LvnTextureFormat>(texture.format);
+        textureCreateInfo.sampler = model.samplers[texture.sampler];
+        if (!mipLevels.empty())
+        {
+            textureCreateInfo.mipLevels = texture.imageCount;
+            textureCreateInfo.pMipImageData = mipLevels.data();
+        }
+
+        lvn::createTexture(&model.textures[i], &textureCreateInfo);
+    }
+
+    model.buffers.resize(header->bufferCount);
+    for (uint32_t i = 0; i < header->bufferCount; i++)
+    {
+        LvnBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.type = static_cast<LvnBufferTypeFlagBits>(buffers[i].type);
+        bufferCreateInfo.usage = Lvn_BufferUsage_Static;
+        bufferCreateInfo.size = buffers[i].size;
+        bufferCreateInfo.data = file.data() + buffers[i].dataOffset;
+        lvn::createBuffer(&model.buffers[i], &bufferCreateInfo);
+    }
+
+    // meshes
+    auto getTexture = [&](int32_t index) { return index >= 0 ? model.textures[index] : nullptr; };
+
+    model.meshes.resize(header->meshCount);
+    for (uint32_t i = 0; i < header->meshCount; i++)
+    {
+        LvnVector<LvnPrimitive> meshPrimitives(meshes[i].primitiveCount);
+        for (uint32_t j = 0; j < meshes[i].primitiveCount; j++)
+        {
+            const LvnModelCachePrimitive& cachePrimitive = primitives[meshes[i].firstPrimitive + j];
+
+            LvnPrimitive& primitive = meshPrimitives[j];
+            primitive = {};
+            primitive.topology = static_cast<LvnTopologyType>(cachePrimitive.topology);
+            primitive.buffer = model.buffers[cachePrimitive.buffer];
+            primitive.vertexCount = cachePrimitive.vertexCount;
+            primitive.indexCount = cachePrimitive.indexCount;
+            primitive.indexOffset = cachePrimitive.indexOffset;
+            primitive.material.baseColorFactor = cachePrimitive.baseColorFactor;
+            primitive.material.emissiveFactor = cachePrimitive.emissiveFactor;
+            primitive.material.metallicFactor = cachePrimitive.metallicFactor;
+            primitive.material.roughnessFactor = cachePrimitive.roughnessFactor;
+            primitive.material.albedo = getTexture(cachePrimitive.albedo);
+            primitive.material.metallicRoughnessOcclusion = getTexture(cachePrimitive.metallicRoughnessOcclusion);
+            primitive.material.normal = getTexture(cachePrimitive.normal);
+            primitive.material.emissive = getTexture(cachePrimitive.emissive);
+            primitive.material.doubleSided = cachePrimitive.doubleSided != 0;
+            primitive.boundsCenter = cachePrimitive.boundsCenter;
+            primitive.boundsRadius = cachePrimitive.boundsRadius;
+            primitive.boundsMin = cachePrimitive.boundsMin;
+            primitive.boundsMax = cachePrimitive.boundsMax;
+            primitive.lods.resize(cachePrimitive.lodCount);
+            for (uint32_t k = 0; k < cachePrimitive.lodCount; k++)
+            {
+                const LvnModelCacheLod& lod = lods[cachePrimitive.firstLod + k];
+                primitive.lods[k] = { lod.indexOffset, lod.indexCount, lod.error };
+            }
+        }
+
+        model.meshes[i].primitives = lvn::move(meshPrimitives);
+    }
+
+    // nodes
+    model.rootNodes = LvnVector<int32_t>(rootNodes, header->rootNodeCount);
+    model.nodes.resize(header->nodeCount);
+    for (uint32_t i = 0; i < header->nodeCount; i++)
+    {
+        LvnNode& node = model.nodes[i];
+        node.transform = nodes[i].transform;
+        node.matrix = nodes[i].matrix;
+        node.parent = nodes[i].parent;
+        node.mesh = nodes[i].mesh;
+        node.skin = nodes[i].skin;
+        node.children = LvnVector<int32_t>(reinterpret_cast<const int32_t*>(file.data() + nodes[i].childrenOffset), nodes[i].childCount);
+        node.instances = LvnVector<LvnTransform>(reinterpret_cast<const LvnTransform*>(file.data() + nodes[i].instancesOffset), nodes[i].instanceCount);
+    }
+
+    // skins
+    model.skins.resize(header->skinCount);
+    for (uint32_t i = 0; i < header->skinCount; i++)
+    {
+        LvnSkin& skin = model.skins[i];
+        skin.name = LvnString(reinterpret_cast<const char*>(file.data() + skins[i].nameOffset), skins[i].nameLength);
+        skin.nameAtom = lvn::atomInternLength(skin.name.c_str(), skin.name.size());
+        skin.joints = LvnVector<int32_t>(reinterpret_cast<const int32_t*>(file.data() + skins[i].jointsOffset), skins[i].jointCount);
+        skin.inverseBindMatrices = LvnVector<LvnMat4>(reinterpret_cast<const LvnMat4*>(file.data() + skins[i].inverseBindMatricesOffset), skins[i].inverseBindMatrixCount);
+
+        LvnBufferCreateInfo ssboCreateInfo{};
+        ssboCreateInfo.type = Lvn_BufferType_Storage;
+        ssboCreateInfo.usage = Lvn_BufferUsage_Dynamic;
+        ssboCreateInfo.size = sizeof(LvnMat4) * skin.inverseBindMatrices.size();
+        ssboCreateInfo.data = nullptr;
+
+        lvn::createBuffer(&skin.ssbo, &ssboCreateInfo);
+        lvn::bufferUpdateData(skin.ssbo, skin.inverseBindMatrices.data(), skin.inverseBindMatrices.size() * sizeof(LvnMat4), 0);
+    }
+
+    // animations
+    model.animations.resize(header->animationCount);
+    for (uint32_t i = 0; i < header->animationCount; i++)
+    {
+        LvnAnimation& animation = model.animations[i];
+        animation.start = animations[i].start;
+        animation.end = animations[i].end;
+        animation.currentTime = 0.0f;
+        animation.channels.resize(animations[i].channelCount);
+
+        for (uint32_t j = 0; j < animations[i].channelCount; j++)
+        {
+            const LvnModelCacheChannel& cacheChannel = channels[animations[i].firstChannel + j];
+
+            LvnAnimationChannel& channel = animation.channels[j];
+            channel.path = static_cast<LvnAnimationPath>(cacheChannel.path);
+            channel.interpolation = static_cast<LvnInterpolationMode>(cacheChannel.interpolation);
+            channel.node = cacheChannel.node;
+            channel.keyFrames = LvnVector<float>(reinterpret_cast<const float*>(file.data() + cacheChannel.keyFramesOffset), cacheChannel.keyFrameCount);
+            channel.outputs = LvnVector<LvnVec4>(reinterpret_cast<const LvnVec4*>(file.data() + cacheChannel.outputsOffset), cacheChannel.outputCount);
+        }
+    }
+
+    return model;
+}
+
+} /* namespace lvn */
@@ -1,10 +1,10 @@
 #include "levikno.h"
 #include "lvn_loaders.h"
 
-#include <sstream>
+#include <algorithm>
+#include <charconv>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 
 namespace lvn
@@ -22,83 +22,375 @@ struct OBJMatrial
     std::string specularMap;
 };
 
-LvnModel loadObjModel(const char* filepath)
+// face vertices are deduplicated by their index triple, every position keeps a chain of the vertices created from it
+// the chains are walked in file order so lookups stay close in memory, unlike a hash of the triple which scatters them
+struct OBJVertexLink
 {
+    int32_t pos, uv, normal; // zero based, -1 when the face vertex has no uv or normal
+    uint32_t next;           // next vertex made from the same position, UINT32_MAX ends the chain
+};
+
+enum OBJFaceVertexFlags : uint8_t
+{
+    OBJ_FaceVertex_PosRelative    = 1 << 0,
+    OBJ_FaceVertex_UvRelative     = 1 << 1,
+    OBJ_FaceVertex_NormalRelative = 1 << 2,
+    OBJ_FaceVertex_NoUv           = 1 << 3,
+    OBJ_FaceVertex_NoNormal       = 1 << 4,
+};
+
+// indices of a face vertex as parsed from a chunk, relative indices are stored from the start of their chunk
+// and become absolute once the element counts of the chunks before it are known
+struct OBJFaceVertex
+{
+    int32_t pos, uv, normal;
+    uint8_t flags;
+};
+
+// the file is split at line boundaries into chunks that are parsed in parallel, each chunk keeps its own elements in file order
+struct OBJChunk
+{
+    const char* begin;
+    const char* end;
+
     std::vector<LvnVec3> positions;
     std::vector<LvnVec2> texCoords;
     std::vector<LvnVec3> normals;
-    std::vector<uint32_t> indices;
-    std::vector<LvnVertex> vertices;
+    std::vector<OBJFaceVertex> faceVertices;
+    std::vector<uint32_t> faceSizes;
+
+    size_t positionOffset, texCoordOffset, normalOffset;
+};
+
+struct OBJParseData
+{
+    OBJChunk* chunks;
+    std::vector<LvnVec3> positions;
+    std::vector<LvnVec2> texCoords;
+    std::vector<LvnVec3> normals;
+
+    const OBJVertexLink* vertexLinks;
+    LvnVertexLayout vertexLayout;
+    uint32_t vertexStride;
+    uint8_t* vertices;
+};
+
+static constexpr uint64_t s_ObjMinChunkSize = 1024 * 1024;
+static constexpr uint32_t s_ObjVertexFillGrainSize = 16384;
+static constexpr uint32_t s_ObjVertexPackBatchSize = 256;
+
+// the parser scans the mapped file in place between a cursor and the end pointer, the file is not null terminated
+
+static inline bool objIsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline void objSkipSpaces(const char*& p, const char* end)
+{
+    while (p < end && objIsSpace(*p))
+        p++;
+}
 
-    std::unordered_map<std::string, uint32_t> indicesMap;
+static inline void objSkipLine(const char*& p, const char* end)
+{
+    while (p < end && *p != '\n')
+        p++;
+    if (p < end)
+        p++;
+}
+
+static bool objParseFloat(const char*& p, const char* end, float* value)
+{
+    objSkipSpaces(p, end);
+    if (p < end && *p == '+') // from_chars does not accept a leading plus sign
+        p++;
 
-    std::string filesrc = lvn::loadFileSrc(filepath).c_str();
-    std::istringstream filess(filesrc);
+#if defined(__cpp_lib_to_chars)
+    std::from_chars_result result = std::from_chars(p, end, *value);
+    if (result.ec == std::errc::invalid_argument)
+        return false;
 
-    std::string line;
-    while (std::getline(filess, line))
+    p = result.ptr;
+    return true;
+#else
+    // floating point from_chars is not available on every standard library, fall back to strtof on a terminated copy of the token
+    char token[64];
+    size_t length = 0;
+    while (p + length < end && length < sizeof(token) - 1 && !objIsSpace(p[length]) && p[length] != '\n')
     {
-        std::istringstream ss(line);
-        std::string prefix;
-        ss >> prefix;
+        token[length] = p[length];
+        length++;
+    }
+    token[length] = '\0';
+
+    char* tokenEnd;
+    *value = strtof(token, &tokenEnd);
+    if (tokenEnd == token)
+        return false;
+
+    p += tokenEnd - token;
+    return true;
+#endif
+}
+
+static bool objParseInt(const char*& p, const char* end, int32_t* value)
+{
+    if (p < end && *p == '+')
+        p++;
+
+    std::from_chars_result result = std::from_chars(p, end, *value);
+    if (result.ec != std::errc())
+        return false;
+
+    p = result.ptr;
+    return true;
+}
+
+// obj indices are one based, negative indices count back from the last element read so far
+// a negative index is kept relative to the chunk start and flagged, the chunk does not know how many elements came before it
+static inline int32_t objChunkIndex(int32_t index, size_t chunkCount, uint8_t relativeFlag, uint8_t* flags)
+{
+    if (index >= 0)
+        return index - 1;
+
+    *flags |= relativeFlag;
+    return static_cast<int32_t>(chunkCount) + index;
+}
+
+static inline int32_t objAbsoluteIndex(int32_t index, uint8_t flags, uint8_t relativeFlag, size_t offset)
+{
+    return (flags & relativeFlag) ? static_cast<int32_t>(offset) + index : index;
+}
 
-        if (prefix == "v")
+static void objParseChunk(OBJChunk* chunk)
+{
+    const char* p = chunk->begin;
+    const char* end = chunk->end;
+
+    while (p < end)
+    {
+        objSkipSpaces(p, end);
+        if (p >= end)
+            break;
+
+        const char* prefix = p;
+        while (p < end && !objIsSpace(*p) && *p != '\n')
+            p++;
+        size_t prefixLength = p - prefix;
+
+        if (prefixLength == 1 && prefix[0] == 'v')
         {
-            LvnVec3 pos;
-            ss >> pos.x >> pos.y >> pos.z;
-            positions.push_back(pos);
+            LvnVec3 pos(0.0f);
+            objParseFloat(p, end, &pos.x) && objParseFloat(p, end, &pos.y) && objParseFloat(p, end, &pos.z);
+            chunk->positions.push_back(pos);
         }
-        else if (prefix == "vt")
+        else if (prefixLength == 2 && prefix[0] == 'v' && prefix[1] == 't')
         {
-            LvnVec2 uv;
-            ss >> uv.x >> uv.y;
-            texCoords.push_back(uv);
+            LvnVec2 uv(0.0f);
+            objParseFloat(p, end, &uv.x) && objParseFloat(p, end, &uv.y);
+            chunk->texCoords.push_back(uv);
         }
-        else if (prefix == "vn")
+        else if (prefixLength == 2 && prefix[0] == 'v' && prefix[1] == 'n')
         {
-            LvnVec3 norm;
-            ss >> norm.x >> norm.y >> norm.z;
-            normals.push_back(norm);
+            LvnVec3 norm(0.0f);
+            objParseFloat(p, end, &norm.x) && objParseFloat(p, end, &norm.y) && objParseFloat(p, end, &norm.z);
+            chunk->normals.push_back(norm);
         }
-        else if (prefix == "f")
+        else if (prefixLength == 1 && prefix[0] == 'f')
         {
-            std::vector<uint32_t> faceIndices;
-            std::string vertexStr;
-            while (ss >> vertexStr)
+            uint32_t faceSize = 0;
+
+            while (true)
             {
-                // if vertex with same data exists, use same indices
-                if (indicesMap.count(vertexStr))
+                objSkipSpaces(p, end);
+
+                // each face vertex is pos, pos/uv, pos//normal or pos/uv/normal
+                int32_t posIdx, uvIdx = 0, normIdx = 0;
+                if (!objParseInt(p, end, &posIdx))
+                    break;
+
+                if (p < end && *p == '/')
                 {
-                    indices.push_back(indicesMap[vertexStr]);
+                    p++;
+                    if (p < end && *p != '/')
+                        objParseInt(p, end, &uvIdx);
+                    if (p < end && *p == '/')
+                    {
+                        p++;
+                        objParseInt(p, end, &normIdx);
+                    }
                 }
-                else
+
+                OBJFaceVertex faceVertex{};
+                faceVertex.pos = objChunkIndex(posIdx, chunk->positions.size(), OBJ_FaceVertex_PosRelative, &faceVertex.flags);
+
+                if (uvIdx != 0) faceVertex.uv = objChunkIndex(uvIdx, chunk->texCoords.size(), OBJ_FaceVertex_UvRelative, &faceVertex.flags);
+                else faceVertex.flags |= OBJ_FaceVertex_NoUv;
+
+                if (normIdx != 0) faceVertex.normal = objChunkIndex(normIdx, chunk->normals.size(), OBJ_FaceVertex_NormalRelative, &faceVertex.flags);
+                else faceVertex.flags |= OBJ_FaceVertex_NoNormal;
+
+                chunk->faceVertices.push_back(faceVertex);
+                faceSize++;
+            }
+
+            if (faceSize > 0)
+                chunk->faceSizes.push_back(faceSize);
+        }
+
+        // comments, groups, materials and anything left on the line are skipped
+        objSkipLine(p, end);
+    }
+}
+
+static void objParseChunksJob(uint32_t start, uint32_t end, void* userData)
+{
+    OBJParseData* data = static_cast<OBJParseData*>(userData);
+    for (uint32_t i = start; i < end; i++)
+        lvn::objParseChunk(&data->chunks[i]);
+}
+
+static void objMergeChunksJob(uint32_t start, uint32_t end, void* userData)
+{
+    OBJParseData* data = static_cast<OBJParseData*>(userData);
+    for (uint32_t i = start; i < end; i++)
+    {
+        const OBJChunk& chunk = data->chunks[i];
+        std::copy(chunk.positions.begin(), chunk.positions.end(), data->positions.begin() + chunk.positionOffset);
+        std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), data->texCoords.begin() + chunk.texCoordOffset);
+        std::copy(chunk.normals.begin(), chunk.normals.end(), data->normals.begin() + chunk.normalOffset);
+    }
+}
+
+static void objFillVerticesJob(uint32_t start, uint32_t end, void* userData)
+{
+    OBJParseData* data = static_cast<OBJParseData*>(userData);
+
+    // vertices are built in small batches on the stack and packed into the vertex layout of the buffer
+    LvnVertex batch[s_ObjVertexPackBatchSize];
+    for (uint32_t first = start; first < end; first += s_ObjVertexPackBatchSize)
+    {
+        uint32_t count = lvn::min(end - first, s_ObjVertexPackBatchSize);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const OBJVertexLink& link = data->vertexLinks[first + i];
+
+            LvnVertex vert{};
+            vert.pos = data->positions[link.pos];
+            vert.texUV = link.uv >= 0 ? data->texCoords[link.uv] : LvnVec2(0, 0);
+            vert.normal = link.normal >= 0 ? data->normals[link.normal] : LvnVec3(0, 0, 0);
+            batch[i] = vert;
+        }
+
+        lvn::vertexLayoutPack(data->vertexLayout, batch, count, data->vertices + static_cast<uint64_t>(first) * data->vertexStride);
+    }
+}
+
+LvnModel loadObjModel(const char* filepath, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize, LvnModelCookData* cook)
+{
+    // the file is mapped and parsed in place, no copy of the source is made
+    LvnBin filesrc = lvn::loadFileMapped(filepath);
+    const char* src = reinterpret_cast<const char*>(filesrc.data());
+    const char* srcEnd = src + filesrc.size();
+
+    // [Parse]
+    // a few chunks per thread so threads that finish early pick up the rest, small files stay in one chunk
+    uint64_t threadCount = lvn::jobGetWorkerCount() + 1;
+    uint64_t chunkCount = lvn::min<uint64_t>(threadCount * 4, filesrc.size() / s_ObjMinChunkSize);
+    if (chunkCount == 0) chunkCount = 1;
+
+    std::vector<OBJChunk> chunks(chunkCount);
+    const char* chunkBegin = src;
+    for (uint64_t i = 0; i < chunkCount; i++)
+    {
+        // every chunk ends after a newline so no line is split between two chunks
+        const char* chunkEnd = i + 1 < chunkCount ? src + filesrc.size() * (i + 1) / chunkCount : srcEnd;
+        if (chunkEnd < chunkBegin) chunkEnd = chunkBegin;
+        while (chunkEnd < srcEnd && chunkEnd[-1] != '\n')
+            chunkEnd++;
+
+        chunks[i].begin = chunkBegin;
+        chunks[i].end = chunkEnd;
+        chunkBegin = chunkEnd;
+    }
+
+    OBJParseData data{};
+    data.chunks = chunks.data();
+    lvn::parallelFor(chunkCount, 1, lvn::objParseChunksJob, &data);
+
+    // [Merge]
+    // prefix sums of the element counts give each chunk its offset into the merged arrays
+    size_t positionCount = 0, texCoordCount = 0, normalCount = 0;
+    size_t faceVertexCount = 0, indexCount = 0;
+    for (OBJChunk& chunk : chunks)
+    {
+        chunk.positionOffset = positionCount;
+        chunk.texCoordOffset = texCoordCount;
+        chunk.normalOffset = normalCount;
+        positionCount += chunk.positions.size();
+        texCoordCount += chunk.texCoords.size();
+        normalCount += chunk.normals.size();
+        faceVertexCount += chunk.faceVertices.size();
+
+        for (uint32_t faceSize : chunk.faceSizes)
+            indexCount += faceSize >= 3 ? (faceSize - 2) * 3 : 0;
+    }
+
+    data.positions.resize(positionCount);
+    data.texCoords.resize(texCoordCount);
+    data.normals.resize(normalCount);
+    lvn::parallelFor(chunkCount, 1, lvn::objMergeChunksJob, &data);
+
+    // [Deduplicate]
+    // vertex indices are handed out in file order so the result does not depend on the chunk count
+    std::vector<uint32_t> positionVertices(positionCount, UINT32_MAX); // first vertex of the chain of each position
+    std::vector<OBJVertexLink> vertexLinks;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> faceIndices;
+    vertexLinks.reserve(positionCount);
+    indices.reserve(indexCount);
+    size_t invalidIndices = 0;
+
+    for (OBJChunk& chunk : chunks)
+    {
+        const OBJFaceVertex* faceVertex = chunk.faceVertices.data();
+        for (uint32_t faceSize : chunk.faceSizes)
+        {
+            faceIndices.clear();
+
+            for (uint32_t i = 0; i < faceSize; i++, faceVertex++)
+            {
+                uint8_t flags = faceVertex->flags;
+                int32_t pos = lvn::objAbsoluteIndex(faceVertex->pos, flags, OBJ_FaceVertex_PosRelative, chunk.positionOffset);
+                int32_t uv = (flags & OBJ_FaceVertex_NoUv) ? -1 : lvn::objAbsoluteIndex(faceVertex->uv, flags, OBJ_FaceVertex_UvRelative, chunk.texCoordOffset);
+                int32_t normal = (flags & OBJ_FaceVertex_NoNormal) ? -1 : lvn::objAbsoluteIndex(faceVertex->normal, flags, OBJ_FaceVertex_NormalRelative, chunk.normalOffset);
+
+                if (pos < 0 || static_cast<size_t>(pos) >= positionCount ||
+                    (uv < 0 && !(flags & OBJ_FaceVertex_NoUv)) || uv >= static_cast<int32_t>(texCoordCount) ||
+                    (normal < 0 && !(flags & OBJ_FaceVertex_NoNormal)) || normal >= static_cast<int32_t>(normalCount))
+                {
+                    invalidIndices++;
+                    continue;
+                }
+
+                // if vertex with same index triple exists, use same index
+                uint32_t index = positionVertices[pos];
+                while (index != UINT32_MAX && (vertexLinks[index].uv != uv || vertexLinks[index].normal != normal))
+                    index = vertexLinks[index].next;
+
+                if (index == UINT32_MAX)
                 {
-                    std::istringstream vs(vertexStr);
-                    std::string posIdxStr, uvIdxStr, normIdxStr;
-                    int posIdx = 0, uvIdx = 0, normIdx = 0;
-
-                    std::getline(vs, posIdxStr, '/');
-                    std::getline(vs, uvIdxStr, '/');
-                    std::getline(vs, normIdxStr, '/');
-
-                    posIdx = std::stoi(posIdxStr) - 1;
-                    if (!uvIdxStr.empty()) uvIdx = std::stoi(uvIdxStr) - 1;
-                    if (!normIdxStr.empty()) normIdx = std::stoi(normIdxStr) - 1;
-
-                    LvnVertex vert{};
-                    vert.pos = positions[posIdx];
-                    vert.texUV = uvIdxStr.empty() ? LvnVec2(0, 0) : texCoords[uvIdx];
-                    vert.normal = normIdxStr.empty() ? LvnVec3(0, 0, 0) : normals[normIdx];
-
-                    vertices.push_back(vert);
-                    uint32_t index = static_cast<uint32_t>(vertices.size()) - 1;
-                    indicesMap[vertexStr] = index;
-                    faceIndices.push_back(index);
+                    index = static_cast<uint32_t>(vertexLinks.size());
+                    vertexLinks.push_back({ pos, uv, normal, positionVertices[pos] });
+                    positionVertices[pos] = index;
                 }
+
+                faceIndices.push_back(index);
             }
 
             // triangulate the face indices if faces are quads/n-gons (triangle fan method)
-            for (uint32_t i = 1; i < faceIndices.size() - 1; i++)
+            for (size_t i = 1; i + 1 < faceIndices.size(); i++)
             {
                 indices.push_back(faceIndices[0]);
                 indices.push_back(faceIndices[i]);
@@ -107,41 +399,68 @@ LvnModel loadObjModel(const char* filepath)
         }
     }
 
-    LvnVertexAttribute meshVertexAttributes[] =
+    if (invalidIndices > 0)
+        LVN_CORE_WARN("%zu face vertices with out of range indices were skipped in obj file: %s", invalidIndices, filepath);
+
+    // the links stand in for the vertices they become, their positions feed the overdraw sort, the bounds and the lods
+    std::vector<LvnVec3> linkPositions(vertexLinks.size());
+    for (size_t i = 0; i < vertexLinks.size(); i++)
+        linkPositions[i] = data.positions[vertexLinks[i].pos];
+
+    // reorder the triangles and vertices before the vertices are built
+    if (optimize != Lvn_MeshOptimizeFlag_None && !indices.empty())
     {
-        { 0, 0, Lvn_AttributeFormat_Vec3_f32, 0 },                   // pos
-        { 0, 1, Lvn_AttributeFormat_Vec4_f32, 3 * sizeof(float) },   // color
-        { 0, 2, Lvn_AttributeFormat_Vec2_f32, 7 * sizeof(float) },   // texUV
-        { 0, 3, Lvn_AttributeFormat_Vec3_f32, 9 * sizeof(float) },   // normal
-        { 0, 4, Lvn_AttributeFormat_Vec3_f32, 12 * sizeof(float) },  // tangent
-        { 0, 5, Lvn_AttributeFormat_Vec3_f32, 15 * sizeof(float) },  // bitangent
-        { 0, 6, Lvn_AttributeFormat_Vec4_f32, 18 * sizeof(float) },  // joints
-        { 0, 7, Lvn_AttributeFormat_Vec4_f32, 22 * sizeof(float) },  // weights
-    };
-
-    LvnVertexBindingDescription meshVertexBindingDescription;
-    meshVertexBindingDescription.binding = 0;
-    meshVertexBindingDescription.stride = sizeof(LvnVertex);
-
-    std::vector<uint8_t> bufferData(vertices.size() * sizeof(LvnVertex) + indices.size() * sizeof(uint32_t));
-    memcpy(bufferData.data(), vertices.data(), vertices.size() * sizeof(LvnVertex));
-    memcpy(bufferData.data() + vertices.size() * sizeof(LvnVertex), indices.data(), indices.size() * sizeof(uint32_t));
+        uint64_t usedCount = lvn::optimizeLoadedMesh(optimize, indices.data(), indices.size(), vertexLinks.data(), vertexLinks.size(), sizeof(OBJVertexLink), &linkPositions[0].x, sizeof(LvnVec3));
+        vertexLinks.resize(usedCount);
+
+        linkPositions.resize(usedCount);
+        for (size_t i = 0; i < vertexLinks.size(); i++)
+            linkPositions[i] = data.positions[vertexLinks[i].pos];
+    }
+
+    size_t vertexCount = vertexLinks.size();
+    uint64_t vertexSize = vertexCount * lvn::vertexLayoutGetStride(layout);
+
+    LvnPrimitive primitive{};
+    primitive.vertexCount = vertexCount;
+    primitive.indexCount = indices.size();
+    primitive.indexOffset = vertexSize;
+    primitive.topology = Lvn_TopologyType_Triangle;
+
+    // simplified index ranges go after the full indices in the same buffer
+    LvnVector<uint32_t> lodIndices;
+    if (vertexCount > 0)
+        lvn::computeLoadedMeshBounds(&linkPositions[0].x, vertexCount, sizeof(LvnVec3), &primitive);
+    if ((optimize & Lvn_MeshOptimizeFlag_GenerateLods) && !indices.empty())
+        lvn::generateLoadedMeshLods(optimize, indices.data(), indices.size(), &linkPositions[0].x, vertexCount, sizeof(LvnVec3), &lodIndices, &primitive);
+
+    // the vertices are written straight into the buffer data in the vertex layout of the model, in parallel since each one is independent
+    std::vector<uint8_t> bufferData(vertexSize + (indices.size() + lodIndices.size()) * sizeof(uint32_t));
+
+    data.vertexLinks = vertexLinks.data();
+    data.vertexLayout = layout;
+    data.vertexStride = lvn::vertexLayoutGetStride(layout);
+    data.vertices = bufferData.data();
+    lvn::parallelFor(vertexCount, s_ObjVertexFillGrainSize, lvn::objFillVerticesJob, &data);
+
+    memcpy(bufferData.data() + vertexSize, indices.data(), indices.size() * sizeof(uint32_t));
+    if (!lodIndices.empty())
+        memcpy(bufferData.data() + vertexSize + indices.size() * sizeof(uint32_t), lodIndices.data(), lodIndices.size() * sizeof(uint32_t));
 
     LvnBufferCreateInfo bufferCreateInfo{};
     bufferCreateInfo.type = Lvn_BufferType_Vertex;
     if (!indices.empty()) bufferCreateInfo.type |= Lvn_BufferType_Index;
     bufferCreateInfo.usage = Lvn_BufferUsage_Static;
-    bufferCreateInfo.size = vertices.size() * sizeof(LvnVertex) + indices.size() * sizeof(uint32_t);
+    bufferCreateInfo.size = bufferData.size();
     bufferCreateInfo.data = bufferData.data();
 
     LvnBuffer* buffer;
     lvn::createBuffer(&buffer, &bufferCreateInfo);
 
-    LvnPrimitive primitive;
+    if (cook)
+        cook->buffers.push_back({ buffer, bufferCreateInfo.type, LvnBin(bufferData.data(), bufferData.size()) });
+
     primitive.buffer = buffer;
-    primitive.vertexCount = vertices.size();
-    primitive.indexCount = indices.size();
-    primitive.topology = Lvn_TopologyType_Triangle;
 
     LvnMesh mesh{};
     mesh.primitives = LvnVector(&primitive, 1);
@@ -156,6 +475,7 @@ LvnModel loadObjModel(const char* filepath)
 
     LvnModel model{};
     model.matrix = LvnMat4(1.0f);
+    model.vertexLayout = layout;
     model.buffers.push_back(buffer);
     model.nodes.push_back(node);
     model.rootNodes.push_back(0);
@@ -3,14 +3,75 @@
 
 #include "levikno_internal.h"
 
+// cpu copies of the resources a loader uploads, recorded when a model is loaded to be cooked so
+// the cooked file can be written from the model and these without reading the gpu resources back
+struct LvnModelCookSampler
+{
+    LvnSampler* sampler;
+    LvnSamplerCreateInfo createInfo;
+};
+
+struct LvnModelCookTexture
+{
+    LvnTexture* texture;
+    LvnSampler* sampler;
+    LvnTextureFormat format;
+    LvnImageData image;
+    LvnVector<LvnImageData> mipLevels; // mip levels after the first, empty if the texture has none or they are generated
+};
+
+struct LvnModelCookBuffer
+{
+    LvnBuffer* buffer;
+    LvnBufferTypeFlagBits type;
+    LvnBin data;
+};
+
+struct LvnModelCookData
+{
+    LvnVector<LvnModelCookSampler> samplers;
+    LvnVector<LvnModelCookTexture> textures;
+    LvnVector<LvnModelCookBuffer> buffers;
+};
+
+// bitstreams and filters of the EXT_meshopt_compression gltf extension
+enum LvnMeshoptMode
+{
+    Lvn_MeshoptMode_Attributes,
+    Lvn_MeshoptMode_Triangles,
+    Lvn_MeshoptMode_Indices,
+};
+
+enum LvnMeshoptFilter
+{
+    Lvn_MeshoptFilter_None,
+    Lvn_MeshoptFilter_Octahedral,
+    Lvn_MeshoptFilter_Quaternion,
+    Lvn_MeshoptFilter_Exponential,
+};
+
 namespace lvn
 {
     // gltf/glb
-    LvnModel loadGltfModel(const char* filepath);
-    LvnModel loadGlbModel(const char* filepath);
+    LvnModel loadGltfModel(const char* filepath, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize, LvnModelCookData* cook = nullptr);
+    LvnModel loadGlbModel(const char* filepath, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize, LvnModelCookData* cook = nullptr);
 
     // wavefront obj
-    LvnModel loadObjModel(const char* filepath);
+    LvnModel loadObjModel(const char* filepath, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize, LvnModelCookData* cook = nullptr);
+
+    // cooked lvnmodel
+    LvnModel loadLvnModel(const char* filepath);
+    LvnResult writeLvnModel(const char* filepath, const LvnModel& model, const LvnModelCookData& cook);
+
+    // runs the passes in optimize on an indexed triangle list, vertices are reordered in place and the number of used vertices is returned
+    uint64_t optimizeLoadedMesh(LvnMeshOptimizeFlagBits optimize, uint32_t* indices, uint64_t indexCount, void* vertices, uint64_t vertexCount, uint64_t vertexSize, const float* positions, uint64_t positionStride);
+
+    // bounding sphere of the primitive vertices and lod index ranges, the lod indices are appended to lodIndices and go right after the full indices of the primitive
+    void computeLoadedMeshBounds(const float* positions, uint64_t vertexCount, uint64_t positionStride, LvnPrimitive* primitive);
+    void generateLoadedMeshLods(LvnMeshOptimizeFlagBits optimize, const uint32_t* indices, uint64_t indexCount, const float* positions, uint64_t vertexCount, uint64_t positionStride, LvnVector<uint32_t>* lodIndices, LvnPrimitive* primitive);
+
+    // decodes count elements of stride bytes into dst, returns false if the stream is malformed or the stride does not fit the mode and filter
+    bool decodeMeshoptBuffer(void* dst, uint64_t count, uint64_t stride, const uint8_t* src, uint64_t size, LvnMeshoptMode mode, LvnMeshoptFilter filter);
 }
 
 #endif
@@ -0,0 +1,780 @@
+#include "levikno.h"
+#include "lvn_loaders.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+
+
+// mesh optimization passes for indexed triangle lists
+// - vertex cache: Tom Forsyth's linear speed vertex cache optimization, triangles are emitted greedily by the score of their vertices in a simulated lru cache
+// - overdraw: Sander et al. fast triangle reordering, the vertex cache order is split into clusters that are sorted so outward facing clusters draw first
+// - vertex fetch: vertices are renumbered in the order the indices first use them so vertex memory is read linearly
+// - simplify: Garland and Heckbert quadric error edge collapses, only half edge collapses onto existing vertices so every lod shares the vertex buffer,
+//   vertices on open borders, attribute seams and non manifold edges stay locked
+
+#define LVN_MESH_CACHE_SIZE 32
+#define LVN_MESH_OVERDRAW_CACHE_SIZE 16
+#define LVN_MESH_MAX_VALENCE_SCORE 64
+#define LVN_MESH_MAX_LODS 8
+#define LVN_MESH_LOD_MIN_TRIANGLES 64
+#define LVN_MESH_LOD_MAX_ERROR 0.1f // largest lod error relative to the bounding radius
+
+namespace lvn
+{
+
+struct LvnMeshCluster
+{
+    uint32_t start, end;
+    float sortKey;
+};
+
+struct LvnMeshQuadric
+{
+    // error(p) = p^T A p + 2 b.p + c over the summed area w of the planes
+    float a00, a11, a22, a01, a02, a12;
+    float b0, b1, b2;
+    float c, w;
+};
+
+struct LvnMeshCollapse
+{
+    uint32_t src, dst;
+    float error;
+};
+
+static float                        meshVertexScore(int32_t cachePosition, uint32_t liveTriangles);
+static uint32_t                     meshSimulateFifo(const uint32_t* triangle, uint32_t* timestamps, uint32_t* timestamp, uint32_t cacheSize);
+static int                          compareMeshClusters(const void* a, const void* b);
+static void                         meshQuadricAdd(LvnMeshQuadric& q, const LvnMeshQuadric& other);
+static float                        meshQuadricError(const LvnMeshQuadric& q, const LvnVec3& p);
+static void                         meshLockSimplifyVertices(const uint32_t* indices, uint64_t indexCount, const LvnVector<LvnVec3>& points, uint8_t* locked);
+static bool                         meshCollapseFlips(const uint32_t* indices, const uint32_t* adjacency, uint32_t adjacencyCount, const LvnVector<LvnVec3>& points, uint32_t src, uint32_t dst);
+
+
+static float meshVertexScore(int32_t cachePosition, uint32_t liveTriangles)
+{
+    // vertices without triangles left are never picked again
+    if (liveTriangles == 0)
+        return -1.0f;
+
+    // the last triangle's vertices get a fixed score so the next triangle is not biased towards reusing only one edge
+    static float s_CacheScores[LVN_MESH_CACHE_SIZE];
+    static float s_ValenceScores[LVN_MESH_MAX_VALENCE_SCORE];
+    static bool s_TablesInitialized = [] {
+        for (uint32_t i = 0; i < LVN_MESH_CACHE_SIZE; i++)
+            s_CacheScores[i] = i < 3 ? 0.75f : powf(1.0f - static_cast<float>(i - 3) / static_cast<float>(LVN_MESH_CACHE_SIZE - 3), 1.5f);
+        for (uint32_t i = 0; i < LVN_MESH_MAX_VALENCE_SCORE; i++)
+            s_ValenceScores[i] = i == 0 ? 0.0f : 2.0f / sqrtf(static_cast<float>(i));
+        return true;
+    }();
+    (void)s_TablesInitialized;
+
+    // vertices with few triangles left are boosted so they are finished instead of leaving lone triangles behind
+    float score = cachePosition >= 0 ? s_CacheScores[cachePosition] : 0.0f;
+    score += s_ValenceScores[lvn::min<uint32_t>(liveTriangles, LVN_MESH_MAX_VALENCE_SCORE - 1)];
+    return score;
+}
+
+static uint32_t meshSimulateFifo(const uint32_t* triangle, uint32_t* timestamps, uint32_t* timestamp, uint32_t cacheSize)
+{
+    // a vertex is in the fifo cache if fewer than cacheSize misses happened since it was loaded
+    uint32_t misses = 0;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        uint32_t v = triangle[i];
+        if (*timestamp - timestamps[v] > cacheSize)
+        {
+            timestamps[v] = (*timestamp)++;
+            misses++;
+        }
+    }
+    return misses;
+}
+
+static int compareMeshClusters(const void* a, const void* b)
+{
+    // higher keys first, ties keep the vertex cache order
+    const LvnMeshCluster* clusterA = static_cast<const LvnMeshCluster*>(a);
+    const LvnMeshCluster* clusterB = static_cast<const LvnMeshCluster*>(b);
+    if (clusterA->sortKey != clusterB->sortKey)
+        return clusterA->sortKey > clusterB->sortKey ? -1 : 1;
+    return clusterA->start < clusterB->start ? -1 : (clusterA->start > clusterB->start ? 1 : 0);
+}
+
+static void meshQuadricAdd(LvnMeshQuadric& q, const LvnMeshQuadric& other)
+{
+    q.a00 += other.a00; q.a11 += other.a11; q.a22 += other.a22;
+    q.a01 += other.a01; q.a02 += other.a02; q.a12 += other.a12;
+    q.b0 += other.b0; q.b1 += other.b1; q.b2 += other.b2;
+    q.c += other.c; q.w += other.w;
+}
+
+static float meshQuadricError(const LvnMeshQuadric& q, const LvnVec3& p)
+{
+    // mean squared distance to the planes, the area weights keep large triangles from being dominated by many small ones
+    float r = q.a00 * p.x * p.x + q.a11 * p.y * p.y + q.a22 * p.z * p.z
+        + 2.0f * (q.a01 * p.x * p.y + q.a02 * p.x * p.z + q.a12 * p.y * p.z)
+        + 2.0f * (q.b0 * p.x + q.b1 * p.y + q.b2 * p.z) + q.c;
+    return q.w > 0.0f ? fabsf(r) / q.w : 0.0f;
+}
+
+static void meshLockSimplifyVertices(const uint32_t* indices, uint64_t indexCount, const LvnVector<LvnVec3>& points, uint8_t* locked)
+{
+    uint32_t vertexCount = static_cast<uint32_t>(points.size());
+
+    // vertices sharing a position are attribute seams, moving one would tear the seam open so they are all locked
+    LvnVector<uint32_t> order;
+    order.resize_uninitialized(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; i++)
+        order[i] = i;
+
+    auto positionLess = [&](uint32_t a, uint32_t b)
+    {
+        const LvnVec3& pa = points[a];
+        const LvnVec3& pb = points[b];
+        if (pa.x != pb.x) return pa.x < pb.x;
+        if (pa.y != pb.y) return pa.y < pb.y;
+        if (pa.z != pb.z) return pa.z < pb.z;
+        return a < b;
+    };
+    std::sort(order.begin(), order.end(), positionLess);
+
+    LvnVector<uint32_t> positionRemap;
+    positionRemap.resize_uninitialized(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        uint32_t v = order[i];
+        bool shared = i > 0 && points[order[i - 1]].x == points[v].x && points[order[i - 1]].y == points[v].y && points[order[i - 1]].z == points[v].z;
+        positionRemap[v] = shared ? positionRemap[order[i - 1]] : v;
+        if (shared)
+        {
+            locked[v] = 1;
+            locked[order[i - 1]] = 1;
+        }
+    }
+
+    // edges are matched by position so seams do not look like borders, an edge without a reverse twin is an open border
+    // and an edge used more than once in the same direction is non manifold, both lock their vertices
+    LvnVector<uint64_t> edges;
+    edges.resize_uninitialized(indexCount);
+    for (uint64_t i = 0; i < indexCount; i += 3)
+    {
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            uint64_t a = positionRemap[indices[i + j]];
+            uint64_t b = positionRemap[indices[i + (j + 1) % 3]];
+            edges[i + j] = (a << 32) | b;
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    for (uint64_t i = 0; i < indexCount; i++)
+    {
+        uint64_t edge = edges[i];
+        uint32_t a = static_cast<uint32_t>(edge >> 32), b = static_cast<uint32_t>(edge & 0xffffffff);
+        uint64_t twin = (static_cast<uint64_t>(b) << 32) | a;
+
+        bool repeated = (i > 0 && edges[i - 1] == edge) || (i + 1 < indexCount && edges[i + 1] == edge);
+        if (repeated || a == b || !std::binary_search(edges.begin(), edges.end(), twin))
+        {
+            locked[a] = 1;
+            locked[b] = 1;
+        }
+    }
+}
+
+static bool meshCollapseFlips(const uint32_t* indices, const uint32_t* adjacency, uint32_t adjacencyCount, const LvnVector<LvnVec3>& points, uint32_t src, uint32_t dst)
+{
+    // moving src onto dst must not turn any remaining triangle around src over or fold it close to edge on
+    for (uint32_t i = 0; i < adjacencyCount; i++)
+    {
+        const uint32_t* tri = &indices[adjacency[i] * 3];
+        if (tri[0] == dst || tri[1] == dst || tri[2] == dst)
+            continue;
+
+        uint32_t k = tri[0] == src ? 0 : (tri[1] == src ? 1 : 2);
+        const LvnVec3& p1 = points[tri[(k + 1) % 3]];
+        const LvnVec3& p2 = points[tri[(k + 2) % 3]];
+
+        LvnVec3 oldNormal = lvn::cross(p1 - points[src], p2 - points[src]);
+        LvnVec3 newNormal = lvn::cross(p1 - points[dst], p2 - points[dst]);
+        if (lvn::dot(oldNormal, newNormal) < 0.25f * sqrtf(lvn::dot(oldNormal, oldNormal) * lvn::dot(newNormal, newNormal)))
+            return true;
+    }
+
+    return false;
+}
+
+void meshOptimizeVertexCache(uint32_t* indices, uint64_t indexCount, uint64_t vertexCount)
+{
+    LVN_CORE_ASSERT(indexCount % 3 == 0, "mesh index count (%llu) is not a triangle list", static_cast<unsigned long long>(indexCount));
+
+    uint64_t triangleCount = indexCount / 3;
+    if (triangleCount == 0)
+        return;
+
+    // triangles adjacent to each vertex, the first liveTriangles[v] entries of a vertex are the triangles not emitted yet
+    LvnVector<uint32_t> liveTriangles(vertexCount, 0);
+    for (uint64_t i = 0; i < indexCount; i++)
+        liveTriangles[indices[i]]++;
+
+    LvnVector<uint32_t> adjacencyOffsets(vertexCount + 1);
+    adjacencyOffsets[0] = 0;
+    for (uint64_t i = 0; i < vertexCount; i++)
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangles[i];
+
+    LvnVector<uint32_t> adjacency(indexCount);
+    LvnVector<uint32_t> adjacencyFill(adjacencyOffsets.data(), vertexCount);
+    for (uint64_t i = 0; i < triangleCount; i++)
+    {
+        for (uint32_t j = 0; j < 3; j++)
+            adjacency[adjacencyFill[indices[i * 3 + j]]++] = static_cast<uint32_t>(i);
+    }
+
+    LvnVector<float> vertexScores(vertexCount);
+    for (uint64_t i = 0; i < vertexCount; i++)
+        vertexScores[i] = lvn::meshVertexScore(-1, liveTriangles[i]);
+
+    LvnVector<float> triangleScores(triangleCount);
+    LvnVector<uint8_t> emitted(triangleCount, 0);
+    int64_t bestTriangle = 0;
+    for (uint64_t i = 0; i < triangleCount; i++)
+    {
+        const uint32_t* tri = &indices[i * 3];
+        triangleScores[i] = vertexScores[tri[0]] + vertexScores[tri[1]] + vertexScores[tri[2]];
+        if (triangleScores[i] > triangleScores[bestTriangle])
+            bestTriangle = static_cast<int64_t>(i);
+    }
+
+    LvnVector<uint32_t> result(indexCount);
+    uint32_t cache[LVN_MESH_CACHE_SIZE + 3];
+    uint32_t newCache[LVN_MESH_CACHE_SIZE + 3];
+    uint32_t cacheCount = 0;
+    uint64_t cursor = 0;
+
+    for (uint64_t out = 0; out < triangleCount; out++)
+    {
+        // nothing in the cache has triangles left, continue with the next triangle in the original order
+        if (bestTriangle < 0)
+        {
+            while (emitted[cursor])
+                cursor++;
+            bestTriangle = static_cast<int64_t>(cursor);
+        }
+
+        uint64_t triangle = static_cast<uint64_t>(bestTriangle);
+        const uint32_t* tri = &indices[triangle * 3];
+        memcpy(&result[out * 3], tri, 3 * sizeof(uint32_t));
+        emitted[triangle] = 1;
+
+        // the emitted triangle is removed from the live triangles of its vertices
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            uint32_t v = tri[j];
+            uint32_t* list = &adjacency[adjacencyOffsets[v]];
+            uint32_t count = liveTriangles[v];
+            for (uint32_t k = 0; k < count; k++)
+            {
+                if (list[k] == triangle)
+                {
+                    list[k] = list[count - 1];
+                    break;
+                }
+            }
+            liveTriangles[v]--;
+        }
+
+        // the triangle's vertices move to the front of the lru cache, the rest shift back and may fall out
+        uint32_t newCacheCount = 0;
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            // degenerate triangles repeat a vertex, it is only cached once
+            if (j == 0 || (tri[j] != tri[0] && (j == 1 || tri[j] != tri[1])))
+                newCache[newCacheCount++] = tri[j];
+        }
+        for (uint32_t j = 0; j < cacheCount; j++)
+        {
+            uint32_t v = cache[j];
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+                newCache[newCacheCount++] = v;
+        }
+
+        // rescore every vertex that was or is in the cache and the triangles they touch, the best of those is emitted next
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (uint32_t j = 0; j < newCacheCount; j++)
+        {
+            uint32_t v = newCache[j];
+            int32_t position = j < LVN_MESH_CACHE_SIZE ? static_cast<int32_t>(j) : -1;
+
+            float score = lvn::meshVertexScore(position, liveTriangles[v]);
+            float delta = score - vertexScores[v];
+            vertexScores[v] = score;
+
+            const uint32_t* list = &adjacency[adjacencyOffsets[v]];
+            for (uint32_t k = 0; k < liveTriangles[v]; k++)
+            {
+                uint32_t t = list[k];
+                triangleScores[t] += delta;
+                if (triangleScores[t] > bestScore)
+                {
+                    bestScore = triangleScores[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        cacheCount = lvn::min<uint32_t>(newCacheCount, LVN_MESH_CACHE_SIZE);
+        memcpy(cache, newCache, cacheCount * sizeof(uint32_t));
+    }
+
+    memcpy(indices, result.data(), indexCount * sizeof(uint32_t));
+}
+
+void meshOptimizeOverdraw(uint32_t* indices, uint64_t indexCount, const float* positions, uint64_t vertexCount, uint64_t positionStride, float threshold)
+{
+    LVN_CORE_ASSERT(indexCount % 3 == 0, "mesh index count (%llu) is not a triangle list", static_cast<unsigned long long>(indexCount));
+
+    uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+    if (triangleCount == 0)
+        return;
+
+    const uint8_t* positionData = reinterpret_cast<const uint8_t*>(positions);
+    auto position = [&](uint32_t v) { return reinterpret_cast<const float*>(positionData + v * positionStride); };
+
+    // hard boundaries, a new cluster starts wherever the cache order already missed on every vertex of a triangle
+    LvnVector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t timestamp = LVN_MESH_OVERDRAW_CACHE_SIZE + 1;
+
+    LvnVector<uint32_t> hardBoundaries;
+    for (uint32_t i = 0; i < triangleCount; i++)
+    {
+        if (lvn::meshSimulateFifo(&indices[i * 3], timestamps.data(), &timestamp, LVN_MESH_OVERDRAW_CACHE_SIZE) == 3 || i == 0)
+            hardBoundaries.push_back(i);
+    }
+    hardBoundaries.push_back(triangleCount);
+
+    // soft boundaries, hard clusters are split further wherever the cache misses so far stay within threshold of the cluster as a whole,
+    // the cache is flushed at every split so the split costs no more than threshold on the vertex cache
+    LvnVector<LvnMeshCluster> clusters;
+    for (uint32_t c = 0; c + 1 < hardBoundaries.size(); c++)
+    {
+        uint32_t start = hardBoundaries[c], end = hardBoundaries[c + 1];
+
+        timestamp += LVN_MESH_OVERDRAW_CACHE_SIZE + 1;
+        uint32_t clusterMisses = 0;
+        for (uint32_t i = start; i < end; i++)
+            clusterMisses += lvn::meshSimulateFifo(&indices[i * 3], timestamps.data(), &timestamp, LVN_MESH_OVERDRAW_CACHE_SIZE);
+
+        float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+        timestamp += LVN_MESH_OVERDRAW_CACHE_SIZE + 1;
+        uint32_t clusterStart = start, runningMisses = 0;
+        for (uint32_t i = start; i < end; i++)
+        {
+            runningMisses += lvn::meshSimulateFifo(&indices[i * 3], timestamps.data(), &timestamp, LVN_MESH_OVERDRAW_CACHE_SIZE);
+            if (i + 1 < end && static_cast<float>(runningMisses) / static_cast<float>(i + 1 - clusterStart) <= clusterThreshold)
+            {
+                clusters.push_back({ clusterStart, i + 1, 0.0f });
+                clusterStart = i + 1;
+                runningMisses = 0;
+                timestamp += LVN_MESH_OVERDRAW_CACHE_SIZE + 1;
+            }
+        }
+        clusters.push_back({ clusterStart, end, 0.0f });
+    }
+
+    // clusters further out along their own facing direction are more likely to occlude the rest of the mesh
+    LvnVec3 meshCentroid(0.0f);
+    for (uint64_t i = 0; i < indexCount; i++)
+    {
+        const float* p = position(indices[i]);
+        meshCentroid += LvnVec3(p[0], p[1], p[2]);
+    }
+    meshCentroid /= static_cast<float>(indexCount);
+
+    for (LvnMeshCluster& cluster : clusters)
+    {
+        LvnVec3 centroid(0.0f), normal(0.0f);
+        float area = 0.0f;
+        for (uint32_t i = cluster.start; i < cluster.end; i++)
+        {
+            const float* p0 = position(indices[i * 3 + 0]);
+            const float* p1 = position(indices[i * 3 + 1]);
+            const float* p2 = position(indices[i * 3 + 2]);
+            LvnVec3 a(p0[0], p0[1], p0[2]), b(p1[0], p1[1], p1[2]), c(p2[0], p2[1], p2[2]);
+
+            // the cross product is twice the area weighted triangle normal
+            LvnVec3 n = lvn::cross(b - a, c - a);
+            float triangleArea = sqrtf(lvn::dot(n, n));
+
+            centroid += (a + b + c) * (triangleArea / 3.0f);
+            normal += n;
+            area += triangleArea;
+        }
+
+        float normalLength = sqrtf(lvn::dot(normal, normal));
+        if (area > 0.0f && normalLength > 0.0f)
+            cluster.sortKey = lvn::dot(centroid / area - meshCentroid, normal / normalLength);
+    }
+
+    qsort(clusters.data(), clusters.size(), sizeof(LvnMeshCluster), lvn::compareMeshClusters);
+
+    LvnVector<uint32_t> result;
+    result.resize_uninitialized(indexCount);
+    uint64_t out = 0;
+    for (const LvnMeshCluster& cluster : clusters)
+    {
+        uint64_t count = static_cast<uint64_t>(cluster.end - cluster.start) * 3;
+        memcpy(&result[out], &indices[cluster.start * 3], count * sizeof(uint32_t));
+        out += count;
+    }
+
+    memcpy(indices, result.data(), indexCount * sizeof(uint32_t));
+}
+
+uint64_t meshOptimizeVertexFetchRemap(uint32_t* remap, uint32_t* indices, uint64_t indexCount, uint64_t vertexCount)
+{
+    memset(remap, 0xff, vertexCount * sizeof(uint32_t));
+
+    uint32_t nextVertex = 0;
+    for (uint64_t i = 0; i < indexCount; i++)
+    {
+        uint32_t& index = remap[indices[i]];
+        if (index == UINT32_MAX)
+            index = nextVertex++;
+        indices[i] = index;
+    }
+
+    return nextVertex;
+}
+
+void meshRemapVertices(void* dst, const void* src, uint64_t vertexCount, uint64_t vertexSize, const uint32_t* remap)
+{
+    uint8_t* dstData = static_cast<uint8_t*>(dst);
+    const uint8_t* srcData = static_cast<const uint8_t*>(src);
+
+    for (uint64_t i = 0; i < vertexCount; i++)
+    {
+        if (remap[i] != UINT32_MAX)
+            memcpy(dstData + remap[i] * vertexSize, srcData + i * vertexSize, vertexSize);
+    }
+}
+
+uint64_t meshSimplify(uint32_t* dst, const uint32_t* indices, uint64_t indexCount, const float* positions, uint64_t vertexCount, uint64_t positionStride, uint64_t targetIndexCount, float targetError, float* resultError)
+{
+    LVN_CORE_ASSERT(indexCount % 3 == 0, "mesh index count (%llu) is not a triangle list", static_cast<unsigned long long>(indexCount));
+
+    memmove(dst, indices, indexCount * sizeof(uint32_t));
+    if (resultError) *resultError = 0.0f;
+    if (indexCount <= targetIndexCount || vertexCount == 0)
+        return indexCount;
+
+    // positions are scaled into the unit cube so the quadrics stay well conditioned for any mesh size
+    const uint8_t* positionData = reinterpret_cast<const uint8_t*>(positions);
+    LvnVector<LvnVec3> points;
+    points.resize_uninitialized(vertexCount);
+    LvnVec3 minBounds(FLT_MAX), maxBounds(-FLT_MAX);
+    for (uint64_t i = 0; i < vertexCount; i++)
+    {
+        const float* p = reinterpret_cast<const float*>(positionData + i * positionStride);
+        points[i] = LvnVec3(p[0], p[1], p[2]);
+        minBounds = LvnVec3(lvn::min(minBounds.x, p[0]), lvn::min(minBounds.y, p[1]), lvn::min(minBounds.z, p[2]));
+        maxBounds = LvnVec3(lvn::max(maxBounds.x, p[0]), lvn::max(maxBounds.y, p[1]), lvn::max(maxBounds.z, p[2]));
+    }
+
+    float extent = lvn::max(maxBounds.x - minBounds.x, lvn::max(maxBounds.y - minBounds.y, maxBounds.z - minBounds.z));
+    if (extent <= 0.0f) extent = 1.0f;
+    for (uint64_t i = 0; i < vertexCount; i++)
+        points[i] = (points[i] - minBounds) / extent;
+
+    LvnVector<uint8_t> locked(vertexCount, 0);
+    lvn::meshLockSimplifyVertices(dst, indexCount, points, locked.data());
+
+    // every vertex starts with the planes of the triangles around it
+    LvnVector<LvnMeshQuadric> quadrics(vertexCount, LvnMeshQuadric{});
+    for (uint64_t i = 0; i < indexCount; i += 3)
+    {
+        const LvnVec3& p0 = points[dst[i + 0]];
+        LvnVec3 n = lvn::cross(points[dst[i + 1]] - p0, points[dst[i + 2]] - p0);
+        float length = sqrtf(lvn::dot(n, n));
+        if (length == 0.0f)
+            continue;
+
+        float w = length * 0.5f;
+        n /= length;
+        float d = -lvn::dot(n, p0);
+
+        LvnMeshQuadric q = { w * n.x * n.x, w * n.y * n.y, w * n.z * n.z, w * n.x * n.y, w * n.x * n.z, w * n.y * n.z, w * n.x * d, w * n.y * d, w * n.z * d, w * d * d, w };
+        for (uint32_t j = 0; j < 3; j++)
+            lvn::meshQuadricAdd(quadrics[dst[i + j]], q);
+    }
+
+    float errorLimit = (targetError / extent) * (targetError / extent);
+    float error = 0.0f;
+    uint64_t currentCount = indexCount;
+
+    LvnVector<uint32_t> collapseRemap;
+    collapseRemap.resize_uninitialized(vertexCount);
+    for (uint64_t i = 0; i < vertexCount; i++)
+        collapseRemap[i] = static_cast<uint32_t>(i);
+
+    LvnVector<uint32_t> adjacencyOffsets(vertexCount + 1);
+    LvnVector<uint32_t> adjacencyFill(vertexCount);
+    LvnVector<uint32_t> adjacency;
+    LvnVector<LvnMeshCollapse> collapses;
+    LvnVector<uint32_t> collapseOrder;
+    LvnVector<uint8_t> passLocked(vertexCount);
+
+    // each pass takes the cheapest independent collapses, the one ring of every collapsed vertex is locked for the rest of the pass so flip checks never see stale triangles
+    while (currentCount > targetIndexCount)
+    {
+        uint32_t triangleCount = static_cast<uint32_t>(currentCount / 3);
+
+        memset(adjacencyOffsets.data(), 0, adjacencyOffsets.size() * sizeof(uint32_t));
+        for (uint64_t i = 0; i < currentCount; i++)
+            adjacencyOffsets[dst[i] + 1]++;
+        for (uint64_t i = 0; i < vertexCount; i++)
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+        adjacency.resize_uninitialized(currentCount);
+        memcpy(adjacencyFill.data(), adjacencyOffsets.data(), vertexCount * sizeof(uint32_t));
+        for (uint32_t i = 0; i < triangleCount; i++)
+        {
+            for (uint32_t j = 0; j < 3; j++)
+                adjacency[adjacencyFill[dst[i * 3 + j]]++] = i;
+        }
+
+        // interior edges show up once in each direction, a < b keeps one of the two and both collapse directions are tried
+        collapses.clear();
+        for (uint64_t i = 0; i < currentCount; i += 3)
+        {
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                uint32_t a = dst[i + j], b = dst[i + (j + 1) % 3];
+                if (a >= b || (locked[a] && locked[b]))
+                    continue;
+
+                LvnMeshQuadric q = quadrics[a];
+                lvn::meshQuadricAdd(q, quadrics[b]);
+
+                // locked vertices can only be collapsed onto
+                float errorAB = locked[a] ? FLT_MAX : lvn::meshQuadricError(q, points[b]);
+                float errorBA = locked[b] ? FLT_MAX : lvn::meshQuadricError(q, points[a]);
+                if (!locked[a] && (locked[b] || errorAB <= errorBA))
+                    collapses.push_back({ a, b, errorAB });
+                else
+                    collapses.push_back({ b, a, errorBA });
+            }
+        }
+
+        if (collapses.empty())
+            break;
+
+        collapseOrder.resize_uninitialized(collapses.size());
+        for (uint32_t i = 0; i < collapses.size(); i++)
+            collapseOrder[i] = i;
+        std::sort(collapseOrder.begin(), collapseOrder.end(), [&](uint32_t a, uint32_t b) { return collapses[a].error < collapses[b].error; });
+
+        // every interior collapse removes two triangles, the pass stops once that reaches the target
+        uint64_t collapseGoal = (currentCount - targetIndexCount) / 6 + 1;
+        uint64_t applied = 0;
+        memset(passLocked.data(), 0, passLocked.size());
+
+        for (uint32_t i = 0; i < collapseOrder.size() && applied < collapseGoal; i++)
+        {
+            const LvnMeshCollapse& collapse = collapses[collapseOrder[i]];
+            if (collapse.error > errorLimit)
+                break;
+
+            if (passLocked[collapse.src] || passLocked[collapse.dst])
+                continue;
+
+            const uint32_t* srcAdjacency = &adjacency[adjacencyOffsets[collapse.src]];
+            uint32_t srcAdjacencyCount = adjacencyOffsets[collapse.src + 1] - adjacencyOffsets[collapse.src];
+            if (lvn::meshCollapseFlips(dst, srcAdjacency, srcAdjacencyCount, points, collapse.src, collapse.dst))
+                continue;
+
+            for (uint32_t j = 0; j < srcAdjacencyCount; j++)
+            {
+                const uint32_t* tri = &dst[srcAdjacency[j] * 3];
+                passLocked[tri[0]] = passLocked[tri[1]] = passLocked[tri[2]] = 1;
+            }
+            passLocked[collapse.dst] = 1;
+
+            collapseRemap[collapse.src] = collapse.dst;
+            lvn::meshQuadricAdd(quadrics[collapse.dst], quadrics[collapse.src]);
+            error = lvn::max(error, collapse.error);
+            applied++;
+        }
+
+        if (applied == 0)
+            break;
+
+        // move the collapsed corners and drop the triangles that became degenerate
+        uint64_t writeCount = 0;
+        for (uint64_t i = 0; i < currentCount; i += 3)
+        {
+            uint32_t a = collapseRemap[dst[i + 0]], b = collapseRemap[dst[i + 1]], c = collapseRemap[dst[i + 2]];
+            if (a == b || b == c || a == c)
+                continue;
+
+            dst[writeCount + 0] = a;
+            dst[writeCount + 1] = b;
+            dst[writeCount + 2] = c;
+            writeCount += 3;
+        }
+        currentCount = writeCount;
+    }
+
+    if (resultError) *resultError = sqrtf(error) * extent;
+    return currentCount;
+}
+
+float lodGetScreenScale(float fovy, float screenHeight)
+{
+    return screenHeight / (2.0f * tanf(fovy * 0.5f));
+}
+
+LvnPrimitiveLod primitiveSelectLod(const LvnPrimitive& primitive, const LvnMat4& matrix, const LvnVec3& cameraPosition, float screenScale, float maxPixelError)
+{
+    if (primitive.lods.empty())
+        return { primitive.indexOffset, primitive.indexCount, 0.0f };
+
+    // the bounding sphere is moved to world space with the largest axis scale of the matrix so the error is never underestimated
+    LvnVec4 center = matrix * LvnVec4(primitive.boundsCenter, 1.0f);
+    float scale = sqrtf(lvn::max(lvn::dot(LvnVec3(matrix[0]), LvnVec3(matrix[0])), lvn::max(lvn::dot(LvnVec3(matrix[1]), LvnVec3(matrix[1])), lvn::dot(LvnVec3(matrix[2]), LvnVec3(matrix[2])))));
+
+    LvnVec3 toCamera = LvnVec3(center) - cameraPosition;
+    float distance = sqrtf(lvn::dot(toCamera, toCamera)) - primitive.boundsRadius * scale;
+    if (distance <= 0.0f)
+        return primitive.lods[0];
+
+    float pixelsPerError = scale * screenScale / distance;
+
+    uint32_t lod = 0;
+    while (lod + 1 < primitive.lods.size() && primitive.lods[lod + 1].error * pixelsPerError <= maxPixelError)
+        lod++;
+
+    return primitive.lods[lod];
+}
+
+void computeLoadedMeshBounds(const float* positions, uint64_t vertexCount, uint64_t positionStride, LvnPrimitive* primitive)
+{
+    primitive->boundsCenter = LvnVec3(0.0f);
+    primitive->boundsRadius = 0.0f;
+    primitive->boundsMin = LvnVec3(0.0f);
+    primitive->boundsMax = LvnVec3(0.0f);
+    if (vertexCount == 0)
+        return;
+
+    const uint8_t* positionData = reinterpret_cast<const uint8_t*>(positions);
+    auto position = [&](uint64_t v) { const float* p = reinterpret_cast<const float*>(positionData + v * positionStride); return LvnVec3(p[0], p[1], p[2]); };
+
+    LvnVec3 minBounds(FLT_MAX), maxBounds(-FLT_MAX);
+    for (uint64_t i = 0; i < vertexCount; i++)
+    {
+        LvnVec3 p = position(i);
+        minBounds = LvnVec3(lvn::min(minBounds.x, p.x), lvn::min(minBounds.y, p.y), lvn::min(minBounds.z, p.z));
+        maxBounds = LvnVec3(lvn::max(maxBounds.x, p.x), lvn::max(maxBounds.y, p.y), lvn::max(maxBounds.z, p.z));
+    }
+
+    LvnVec3 center = (minBounds + maxBounds) * 0.5f;
+    float radius = 0.0f;
+    for (uint64_t i = 0; i < vertexCount; i++)
+    {
+        LvnVec3 d = position(i) - center;
+        radius = lvn::max(radius, lvn::dot(d, d));
+    }
+
+    primitive->boundsCenter = center;
+    primitive->boundsRadius = sqrtf(radius);
+    primitive->boundsMin = minBounds;
+    primitive->boundsMax = maxBounds;
+}
+
+void generateLoadedMeshLods(LvnMeshOptimizeFlagBits optimize, const uint32_t* indices, uint64_t indexCount, const float* positions, uint64_t vertexCount, uint64_t positionStride, LvnVector<uint32_t>* lodIndices, LvnPrimitive* primitive)
+{
+    // lod indices are stored right after the full indices of the primitive
+    primitive->lods.clear();
+    primitive->lods.push_back({ primitive->indexOffset, static_cast<uint32_t>(indexCount), 0.0f });
+
+    float errorLimit = primitive->boundsRadius * LVN_MESH_LOD_MAX_ERROR;
+    LvnVector<uint32_t> level;
+    level.resize_uninitialized(indexCount);
+
+    // each level halves the previous one, errors are relative to the level simplified from so they are summed to bound the error to the full mesh
+    const uint32_t* source = indices;
+    uint64_t sourceCount = indexCount;
+    float error = 0.0f;
+
+    while (primitive->lods.size() < LVN_MESH_MAX_LODS && sourceCount / 3 > LVN_MESH_LOD_MIN_TRIANGLES && error < errorLimit)
+    {
+        float levelError = 0.0f;
+        uint64_t targetCount = (sourceCount / 6) * 3;
+        uint64_t count = lvn::meshSimplify(level.data(), source, sourceCount, positions, vertexCount, positionStride, targetCount, errorLimit - error, &levelError);
+
+        // stop once simplification barely removes anything, the level would cost memory without saving work
+        if (count == 0 || count > sourceCount - sourceCount / 5)
+            break;
+
+        if (optimize & Lvn_MeshOptimizeFlag_VertexCache)
+            lvn::meshOptimizeVertexCache(level.data(), count, vertexCount);
+
+        error += levelError;
+        uint64_t first = lodIndices->size();
+        lodIndices->resize_uninitialized(first + count);
+        memcpy(lodIndices->data() + first, level.data(), count * sizeof(uint32_t));
+
+        primitive->lods.push_back({ primitive->indexOffset + (indexCount + first) * sizeof(uint32_t), static_cast<uint32_t>(count), error });
+
+        source = lodIndices->data() + first;
+        sourceCount = count;
+    }
+
+    // a single level is the full mesh, nothing to select from
+    if (primitive->lods.size() == 1)
+        primitive->lods.clear();
+}
+
+uint64_t optimizeLoadedMesh(LvnMeshOptimizeFlagBits optimize, uint32_t* indices, uint64_t indexCount, void* vertices, uint64_t vertexCount, uint64_t vertexSize, const float* positions, uint64_t positionStride)
+{
+    if (optimize == Lvn_MeshOptimizeFlag_None || indexCount < 3 || indexCount % 3 != 0)
+        return vertexCount;
+
+    // the passes index straight into per vertex tables, meshes with broken indices are left as they are
+    for (uint64_t i = 0; i < indexCount; i++)
+    {
+        if (indices[i] >= vertexCount)
+        {
+            LVN_CORE_WARN("mesh index (%u) is out of range of its %llu vertices, skipping mesh optimization", indices[i], static_cast<unsigned long long>(vertexCount));
+            return vertexCount;
+        }
+    }
+
+    if (optimize & Lvn_MeshOptimizeFlag_VertexCache)
+        lvn::meshOptimizeVertexCache(indices, indexCount, vertexCount);
+
+    if (optimize & Lvn_MeshOptimizeFlag_Overdraw)
+        lvn::meshOptimizeOverdraw(indices, indexCount, positions, vertexCount, positionStride);
+
+    if (optimize & Lvn_MeshOptimizeFlag_VertexFetch)
+    {
+        LvnVector<uint32_t> remap;
+        remap.resize_uninitialized(vertexCount);
+        uint64_t usedCount = lvn::meshOptimizeVertexFetchRemap(remap.data(), indices, indexCount, vertexCount);
+
+        LvnVector<uint8_t> remapped;
+        remapped.resize_uninitialized(usedCount * vertexSize);
+        lvn::meshRemapVertices(remapped.data(), vertices, vertexCount, vertexSize, remap.data());
+        memcpy(vertices, remapped.data(), remapped.size());
+
+        return usedCount;
+    }
+
+    return vertexCount;
+}
+
+} /* namespace lvn */
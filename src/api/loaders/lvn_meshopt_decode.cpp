@@ -0,0 +1,455 @@
+#include "levikno.h"
+#include "lvn_loaders.h"
+
+#include <cmath>
+#include <cstring>
+
+
+// decoders for the bitstreams of the EXT_meshopt_compression gltf extension
+// - attributes: vertices are split into blocks, every byte of the vertex is delta encoded against the previous vertex and stored in groups of 16 with 0, 2, 4 or 8 bits per value
+// - triangles: indices are encoded against a fifo of recent edges and vertices, triangles that share an edge with a recent triangle take one code byte
+// - indices: each index is a zigzag varint delta against one of two baselines
+// the filters are applied to the decoded attributes in place and turn them back into the values of the accessor
+
+#define LVN_MESHOPT_VERTEX_HEADER 0xa0
+#define LVN_MESHOPT_TRIANGLE_HEADER 0xe0
+#define LVN_MESHOPT_SEQUENCE_HEADER 0xd0
+#define LVN_MESHOPT_BYTE_GROUP_SIZE 16
+#define LVN_MESHOPT_VERTEX_BLOCK_BYTES 8192
+#define LVN_MESHOPT_VERTEX_BLOCK_MAX_SIZE 256
+#define LVN_MESHOPT_TAIL_MAX_SIZE 32
+
+namespace lvn
+{
+
+static const uint8_t*  meshoptDecodeBytesGroup(const uint8_t* data, const uint8_t* dataEnd, uint8_t* dst, uint32_t bitsLog2);
+static const uint8_t*  meshoptDecodeBytes(const uint8_t* data, const uint8_t* dataEnd, uint8_t* dst, uint64_t count);
+static bool            meshoptDecodeVertexBuffer(uint8_t* dst, uint64_t count, uint64_t stride, const uint8_t* src, uint64_t size);
+static bool            meshoptDecodeIndexBuffer(uint8_t* dst, uint64_t count, uint64_t stride, const uint8_t* src, uint64_t size);
+static bool            meshoptDecodeIndexSequence(uint8_t* dst, uint64_t count, uint64_t stride, const uint8_t* src, uint64_t size);
+static uint32_t        meshoptDecodeVByte(const uint8_t*& data);
+static void            meshoptWriteTriangle(uint8_t* dst, uint64_t offset, uint64_t stride, uint32_t a, uint32_t b, uint32_t c);
+template <typename T>
+static void            meshoptFilterOct(T* data, uint64_t count);
+static void            meshoptFilterQuat(int16_t* data, uint64_t count);
+static void            meshoptFilterExp(uint32_t* data, uint64_t count);
+
+
+// values of 2 and 4 bits equal to the largest value are escapes, the real value follows the packed values as a whole byte
+static const uint8_t* meshoptDecodeBytesGroup(const uint8_t* data, const uint8_t* dataEnd, uint8_t* dst, uint32_t bitsLog2)
+{
+    if (bitsLog2 == 0)
+    {
+        memset(dst, 0, LVN_MESHOPT_BYTE_GROUP_SIZE);
+        return data;
+    }
+
+    if (bitsLog2 == 3)
+    {
+        if (dataEnd - data < LVN_MESHOPT_BYTE_GROUP_SIZE) { return nullptr; }
+        memcpy(dst, data, LVN_MESHOPT_BYTE_GROUP_SIZE);
+        return data + LVN_MESHOPT_BYTE_GROUP_SIZE;
+    }
+
+    uint32_t bits = 1u << bitsLog2;
+    uint32_t escape = (1u << bits) - 1;
+    uint32_t packedSize = LVN_MESHOPT_BYTE_GROUP_SIZE * bits / 8;
+    if ((uint64_t)(dataEnd - data) < packedSize) { return nullptr; }
+
+    const uint8_t* extra = data + packedSize;
+    for (uint32_t i = 0; i < LVN_MESHOPT_BYTE_GROUP_SIZE; i++)
+    {
+        uint32_t bitOffset = i * bits;
+        uint32_t value = (data[bitOffset / 8] >> (8 - bits - bitOffset % 8)) & escape;
+
+        if (value == escape)
+        {
+            if (extra >= dataEnd) { return nullptr; }
+            value = *extra++;
+        }
+
+        dst[i] = (uint8_t)value;
+    }
+
+    return extra;
+}
+
+// a header of 2 bits per group gives the bit width of its values
+static const uint8_t* meshoptDecodeBytes(const uint8_t* data, const uint8_t* dataEnd, uint8_t* dst, uint64_t count)
+{
+    uint64_t groupCount = count / LVN_MESHOPT_BYTE_GROUP_SIZE;
+    uint64_t headerSize = (groupCount + 3) / 4;
+    if ((uint64_t)(dataEnd - data) < headerSize) { return nullptr; }
+
+    const uint8_t* header = data;
+    data += headerSize;
+
+    for (uint64_t i = 0; i < groupCount && data; i++)
+    {
+        uint32_t bitsLog2 = (header[i / 4] >> ((i % 4) * 2)) & 3;
+        data = lvn::meshoptDecodeBytesGroup(data, dataEnd, dst + i * LVN_MESHOPT_BYTE_GROUP_SIZE, bitsLog2);
+    }
+
+    return data;
+}
+
+static bool meshoptDecodeVertexBuffer(uint8_t* dst, uint64_t count, uint64_t stride, const uint8_t* src, uint64_t size)
+{
+    if (stride == 0 || stride > LVN_MESHOPT_VERTEX_BLOCK_MAX_SIZE || stride % 4 != 0) { return false; }
+    if (size < 1 + stride) { return false; }
+    if (src[0] != LVN_MESHOPT_VERTEX_HEADER) { return false; } // only version 0 is allowed by the extension
+
+    const uint8_t* data = src + 1;
+    const uint8_t* dataEnd = src + size;
+
+    // the stream ends with the first vertex, every byte of the vertices is a delta against the previous vertex
+    uint8_t lastVertex[LVN_MESHOPT_VERTEX_BLOCK_MAX_SIZE];
+    memcpy(lastVertex, dataEnd - stride, stride);
+
+    uint64_t blockSize = (LVN_MESHOPT_VERTEX_BLOCK_BYTES / stride) & ~(uint64_t)(LVN_MESHOPT_BYTE_GROUP_SIZE - 1);
+    if (blockSize > LVN_MESHOPT_VERTEX_BLOCK_MAX_SIZE)
+        blockSize = LVN_MESHOPT_VERTEX_BLOCK_MAX_SIZE;
+
+    uint8_t deltas[LVN_MESHOPT_VERTEX_BLOCK_MAX_SIZE];
+    for (uint64_t first = 0; first < count; first += blockSize)
+    {
+        uint64_t blockCount = lvn::min(blockSize, count - first);
+        uint64_t blockCountAligned = (blockCount + LVN_MESHOPT_BYTE_GROUP_SIZE - 1) & ~(uint64_t)(LVN_MESHOPT_BYTE_GROUP_SIZE - 1);
+        uint8_t* block = dst + first * stride;
+
+        // each byte of the vertex is stored as its own stream for the whole block
+        for (uint64_t k = 0; k < stride; k++)
+        {
+            data = lvn::meshoptDecodeBytes(data, dataEnd, deltas, blockCountAligned);
+            if (!data) { return false; }
+
+            uint8_t value = lastVertex[k];
+            for (uint64_t i = 0; i < blockCount; i++)
+            {
+                uint8_t delta = deltas[i];
+                value += (uint8_t)((delta >> 1) ^ (0u - (delta & 1u)));
+                block[i * stride + k] = value;
+            }
+            lastVertex[k] = value;
+        }
+    }
+
+    uint64_t tailSize = lvn::max(stride, (uint64_t)LVN_MESHOPT_TAIL_MAX_SIZE);
+    return (uint64_t)(dataEnd - data) == tailSize;
+}
+
+static uint32_t meshoptDecodeVByte(const uint8_t*& data)
+{
+    uint8_t lead = *data++;
+    if (lead < 128) { return lead; }
+
+    // at most five bytes, their high bit marks that another byte follows
+    uint32_t result = lead & 127;
+    uint32_t shift = 7;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        uint8_t group = *data++;
+        result |= (uint32_t)(group & 127) << shift;
+        shift += 7;
+        if (group < 128) { break; }
+    }
+
+    return result;
+}
+
+static void meshoptWriteTriangle(uint8_t* dst, uint64_t offset, uint64_t stride, uint32_t a, uint32_t b, uint32_t c)
+{
+    if (stride == 2)
+    {
+        uint16_t triangle[3] = { (uint16_t)a, (uint16_t)b, (uint16_t)c };
+        memcpy(dst + offset * 2, triangle, sizeof(triangle));
+        return;
+    }
+
+    uint32_t triangle[3] = { a, b, c };
+    memcpy(dst + offset * 4, triangle, sizeof(triangle));
+}
+
+static bool meshoptDecodeIndexBuffer(uint8_t* dst, uint64_t count, uint64_t stride, const uint8_t* src, uint64_t size)
+{
+    if (count % 3 != 0 || (stride != 2 && stride != 4)) { return false; }
+
+    // header, a code byte per triangle and the 16 byte table of the auxiliary codes at the end
+    if (size < 1 + count / 3 + 16) { return false; }
+    if ((src[0] & 0xf0) != LVN_MESHOPT_TRIANGLE_HEADER) { return false; }
+
+    uint32_t version = src[0] & 0x0f;
+    if (version > 1) { return false; }
+
+    uint32_t edgeFifo[16][2];
+    uint32_t vertexFifo[16];
+    memset(edgeFifo, 0xff, sizeof(edgeFifo));
+    memset(vertexFifo, 0xff, sizeof(vertexFifo));
+    uint32_t edgeOffset = 0, vertexOffset = 0;
+    uint32_t next = 0, last = 0;
+
+    // version 1 encodes free indices one apart from the last as codes 13 and 14 instead of vertex fifo entries
+    uint32_t fecMax = version >= 1 ? 13 : 15;
+
+    const uint8_t* code = src + 1;
+    const uint8_t* data = code + count / 3;
+    const uint8_t* dataSafeEnd = src + size - 16;
+    const uint8_t* codeAuxTable = dataSafeEnd;
+
+    auto pushEdge = [&](uint32_t a, uint32_t b) { edgeFifo[edgeOffset][0] = a; edgeFifo[edgeOffset][1] = b; edgeOffset = (edgeOffset + 1) & 15; };
+    auto pushVertex = [&](uint32_t v, bool push) { vertexFifo[vertexOffset] = v; vertexOffset = (vertexOffset + (push ? 1 : 0)) & 15; };
+
+    for (uint64_t i = 0; i < count; i += 3)
+    {
+        // a triangle reads at most 16 bytes past data, the code table at the end keeps the reads within the buffer
+        if (data > dataSafeEnd) { return false; }
+
+        uint8_t codeTri = *code++;
+        if (codeTri < 0xf0)
+        {
+            // the triangle shares an edge with a recent triangle
+            uint32_t fe = codeTri >> 4;
+            uint32_t a = edgeFifo[(edgeOffset - 1 - fe) & 15][0];
+            uint32_t b = edgeFifo[(edgeOffset - 1 - fe) & 15][1];
+            uint32_t fec = codeTri & 15;
+            uint32_t c;
+
+            if (fec < fecMax)
+            {
+                c = fec == 0 ? next++ : vertexFifo[(vertexOffset - 1 - fec) & 15];
+                lvn::meshoptWriteTriangle(dst, i, stride, a, b, c);
+                pushVertex(c, fec == 0);
+            }
+            else
+            {
+                // 13 and 14 decode to -1 and 1
+                if (fec != 15)
+                    c = last + (uint32_t)((int32_t)fec - (int32_t)(fec ^ 3));
+                else
+                {
+                    uint32_t v = lvn::meshoptDecodeVByte(data);
+                    c = last + ((v >> 1) ^ (0u - (v & 1u)));
+                }
+                last = c;
+                lvn::meshoptWriteTriangle(dst, i, stride, a, b, c);
+                pushVertex(c, true);
+            }
+
+            pushEdge(c, b);
+            pushEdge(a, c);
+            continue;
+        }
+
+        uint32_t a, b, c;
+        uint32_t feb, fec;
+        bool pushB, pushC;
+
+        if (codeTri < 0xfe)
+        {
+            // a new triangle, the codes of its second and third vertex come from the table
+            uint8_t codeAux = codeAuxTable[codeTri & 15];
+            feb = codeAux >> 4;
+            fec = codeAux & 15;
+
+            a = next++;
+            b = feb == 0 ? next++ : vertexFifo[(vertexOffset - feb) & 15];
+            c = fec == 0 ? next++ : vertexFifo[(vertexOffset - fec) & 15];
+            pushB = feb == 0;
+            pushC = fec == 0;
+        }
+        else
+        {
+            // a new triangle with its codes in a full byte, free indices are delta encoded against the last free index
+            uint8_t codeAux = *data++;
+            uint32_t fea = codeTri == 0xfe ? 0 : 15;
+            feb = codeAux >> 4;
+            fec = codeAux & 15;
+
+            // a zero code is not in the table and restarts the vertex numbering
+            if (codeAux == 0)
+                next = 0;
+
+            a = fea == 0 ? next++ : 0;
+            b = feb == 0 ? next++ : vertexFifo[(vertexOffset - feb) & 15];
+            c = fec == 0 ? next++ : vertexFifo[(vertexOffset - fec) & 15];
+
+            if (fea == 15) { uint32_t v = lvn::meshoptDecodeVByte(data); last = a = last + ((v >> 1) ^ (0u - (v & 1u))); }
+            if (feb == 15) { uint32_t v = lvn::meshoptDecodeVByte(data); last = b = last + ((v >> 1) ^ (0u - (v & 1u))); }
+            if (fec == 15) { uint32_t v = lvn::meshoptDecodeVByte(data); last = c = last + ((v >> 1) ^ (0u - (v & 1u))); }
+
+            pushB = feb == 0 || feb == 15;
+            pushC = fec == 0 || fec == 15;
+        }
+
+        lvn::meshoptWriteTriangle(dst, i, stride, a, b, c);
+        pushVertex(a, true);
+        pushVertex(b, pushB);
+        pushVertex(c, pushC);
+        pushEdge(b, a);
+        pushEdge(c, b);
+        pushEdge(a, c);
+    }
+
+    // every data byte was read and decoding stopped where the code table begins
+    return data == dataSafeEnd;
+}
+
+static bool meshoptDecodeIndexSequence(uint8_t* dst, uint64_t count, uint64_t stride, const uint8_t* src, uint64_t size)
+{
+    if (stride != 2 && stride != 4) { return false; }
+
+    // header, at least a byte per index and a 4 byte tail
+    if (size < 1 + count + 4) { return false; }
+    if ((src[0] & 0xf0) != LVN_MESHOPT_SEQUENCE_HEADER) { return false; }
+    if ((src[0] & 0x0f) > 1) { return false; }
+
+    const uint8_t* data = src + 1;
+    const uint8_t* dataSafeEnd = src + size - 4;
+    uint32_t last[2] = { 0, 0 };
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        // an index reads at most 5 bytes, the tail keeps the reads within the buffer
+        if (data >= dataSafeEnd) { return false; }
+
+        // the low bit selects the baseline, the rest is a zigzag delta against it
+        uint32_t v = lvn::meshoptDecodeVByte(data);
+        uint32_t baseline = v & 1;
+        v >>= 1;
+
+        uint32_t index = last[baseline] + ((v >> 1) ^ (0u - (v & 1u)));
+        last[baseline] = index;
+
+        if (stride == 2)
+        {
+            uint16_t index16 = (uint16_t)index;
+            memcpy(dst + i * 2, &index16, sizeof(uint16_t));
+        }
+        else
+            memcpy(dst + i * 4, &index, sizeof(uint32_t));
+    }
+
+    return data == dataSafeEnd;
+}
+
+// unit vectors stored as octahedral x and y with the scale of one in z, the fourth component is kept as is
+template <typename T>
+static void meshoptFilterOct(T* data, uint64_t count)
+{
+    const float maxValue = (float)((1 << (sizeof(T) * 8 - 1)) - 1);
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        float x = (float)data[i * 4 + 0];
+        float y = (float)data[i * 4 + 1];
+        float z = (float)data[i * 4 + 2] - fabsf(x) - fabsf(y);
+
+        // fold the lower hemisphere back out of the octahedron
+        float t = z >= 0.0f ? 0.0f : z;
+        x += x >= 0.0f ? t : -t;
+        y += y >= 0.0f ? t : -t;
+
+        float scale = maxValue / sqrtf(x * x + y * y + z * z);
+        data[i * 4 + 0] = (T)(int32_t)(x * scale + (x >= 0.0f ? 0.5f : -0.5f));
+        data[i * 4 + 1] = (T)(int32_t)(y * scale + (y >= 0.0f ? 0.5f : -0.5f));
+        data[i * 4 + 2] = (T)(int32_t)(z * scale + (z >= 0.0f ? 0.5f : -0.5f));
+    }
+}
+
+// unit quaternions stored as the three smallest components, the low bits of the last value give the index of the dropped one and the rest its scale
+static void meshoptFilterQuat(int16_t* data, uint64_t count)
+{
+    const float scale = 1.0f / sqrtf(2.0f);
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        int32_t sf = data[i * 4 + 3] | 3;
+        float ss = scale / (float)sf;
+
+        float x = (float)data[i * 4 + 0] * ss;
+        float y = (float)data[i * 4 + 1] * ss;
+        float z = (float)data[i * 4 + 2] * ss;
+
+        // clamped so rounding errors cannot take the square root of a negative value
+        float ww = 1.0f - x * x - y * y - z * z;
+        float w = sqrtf(ww >= 0.0f ? ww : 0.0f);
+
+        int32_t xf = (int32_t)(x * 32767.0f + (x >= 0.0f ? 0.5f : -0.5f));
+        int32_t yf = (int32_t)(y * 32767.0f + (y >= 0.0f ? 0.5f : -0.5f));
+        int32_t zf = (int32_t)(z * 32767.0f + (z >= 0.0f ? 0.5f : -0.5f));
+        int32_t wf = (int32_t)(w * 32767.0f + 0.5f);
+
+        uint32_t qc = data[i * 4 + 3] & 3;
+        data[i * 4 + ((qc + 1) & 3)] = (int16_t)xf;
+        data[i * 4 + ((qc + 2) & 3)] = (int16_t)yf;
+        data[i * 4 + ((qc + 3) & 3)] = (int16_t)zf;
+        data[i * 4 + ((qc + 0) & 3)] = (int16_t)wf;
+    }
+}
+
+// floats stored as a 24 bit signed mantissa and an 8 bit signed exponent
+static void meshoptFilterExp(uint32_t* data, uint64_t count)
+{
+    for (uint64_t i = 0; i < count; i++)
+    {
+        int32_t mantissa = (int32_t)(data[i] << 8) >> 8;
+        int32_t exponent = (int32_t)data[i] >> 24;
+
+        // exp2(exponent) built from the bits of the float, the product is exact for the mantissa range
+        uint32_t bits = (uint32_t)(exponent + 127) << 23;
+        float value;
+        memcpy(&value, &bits, sizeof(float));
+        value *= (float)mantissa;
+        memcpy(&data[i], &value, sizeof(float));
+    }
+}
+
+bool decodeMeshoptBuffer(void* dst, uint64_t count, uint64_t stride, const uint8_t* src, uint64_t size, LvnMeshoptMode mode, LvnMeshoptFilter filter)
+{
+    uint8_t* dstBytes = static_cast<uint8_t*>(dst);
+
+    switch (mode)
+    {
+        case Lvn_MeshoptMode_Attributes:
+        {
+            if (!lvn::meshoptDecodeVertexBuffer(dstBytes, count, stride, src, size))
+                return false;
+            break;
+        }
+        case Lvn_MeshoptMode_Triangles:
+        {
+            return filter == Lvn_MeshoptFilter_None && lvn::meshoptDecodeIndexBuffer(dstBytes, count, stride, src, size);
+        }
+        case Lvn_MeshoptMode_Indices:
+        {
+            return filter == Lvn_MeshoptFilter_None && lvn::meshoptDecodeIndexSequence(dstBytes, count, stride, src, size);
+        }
+        default: { return false; }
+    }
+
+    // the output is allocated from the lvn allocator, its alignment covers the 16 and 32 bit elements of the filters
+    switch (filter)
+    {
+        case Lvn_MeshoptFilter_None: { return true; }
+        case Lvn_MeshoptFilter_Octahedral:
+        {
+            if (stride == 4) { lvn::meshoptFilterOct(reinterpret_cast<int8_t*>(dstBytes), count); return true; }
+            if (stride == 8) { lvn::meshoptFilterOct(reinterpret_cast<int16_t*>(dstBytes), count); return true; }
+            return false;
+        }
+        case Lvn_MeshoptFilter_Quaternion:
+        {
+            if (stride != 8) { return false; }
+            lvn::meshoptFilterQuat(reinterpret_cast<int16_t*>(dstBytes), count);
+            return true;
+        }
+        case Lvn_MeshoptFilter_Exponential:
+        {
+            lvn::meshoptFilterExp(reinterpret_cast<uint32_t*>(dstBytes), count * (stride / 4));
+            return true;
+        }
+        default: { return false; }
+    }
+}
+
+} /* namespace lvn */
@@ -18,12 +18,69 @@ namespace lvn
     static void      GLFWerrorCallback(int error, const char* descripion);
     static LvnResult createGraphicsRelatedAPIData(LvnWindow* window);
     static void      destroyGraphicsRelatedAPIData(LvnWindow* window);
+    static int       getOpenGLSwapInterval(const LvnWindowData* windowData);
+    static void      submitEvent(LvnWindowData* data, LvnEvent* event);
+    static void      pushMouseSample(LvnWindowData* data, double xPos, double yPos);
 
     static void GLFWerrorCallback(int error, const char* descripion)
     {
         LVN_CORE_ERROR("[glfw]: (%d): %s", error, descripion);
     }
 
+    // buffered windows copy the event into their queue so the poll loop never runs user callbacks
+    static void submitEvent(LvnWindowData* data, LvnEvent* event)
+    {
+        data->redrawRequested.store(true, std::memory_order_release);
+
+        if (data->eventQueue == nullptr)
+        {
+            data->eventCallBackFn(event);
+            return;
+        }
+
+        if (!data->eventQueue->try_push(*event))
+            LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_WARN, "[glfw] event queue of window is full (capacity: %zu), event dropped", data->eventQueue->capacity());
+    }
+
+    // every cursor callback is kept as its own sample instead of being coalesced into the polled position
+    // samples that do not fit keep their motion in the carry so the deltas of the queued samples still add up
+    static void pushMouseSample(LvnWindowData* data, double xPos, double yPos)
+    {
+        LvnMouseMotionSample sample{};
+        sample.x = xPos;
+        sample.y = yPos;
+        sample.dx = data->mouseCarry.x + (data->mouseSampled ? xPos - data->mouseLastPos.x : 0.0);
+        sample.dy = data->mouseCarry.y + (data->mouseSampled ? yPos - data->mouseLastPos.y : 0.0);
+        sample.time = static_cast<double>(lvn::getContextTimeNs()) * 0.001 * 0.001 * 0.001;
+
+        data->mouseLastPos = { xPos, yPos };
+        data->mouseSampled = true;
+
+        if (data->mouseSamples->try_push(sample))
+            data->mouseCarry = { 0.0, 0.0 };
+        else
+            data->mouseCarry = { sample.dx, sample.dy };
+    }
+
+    // swap interval matching the present mode of the window, a negative interval swaps late frames immediately when supported
+    static int getOpenGLSwapInterval(const LvnWindowData* windowData)
+    {
+        switch (windowData->presentMode)
+        {
+            case Lvn_PresentMode_Fifo: { return 1; }
+            case Lvn_PresentMode_FifoRelaxed:
+            {
+                if (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+                    return -1;
+                return 1;
+            }
+            case Lvn_PresentMode_Mailbox:
+            case Lvn_PresentMode_Immediate: { return 0; }
+
+            default: { return windowData->vSync ? 1 : 0; }
+        }
+    }
+
     static LvnResult createGraphicsRelatedAPIData(LvnWindow* window)
     {
         switch (lvn::getGraphicsApi())
@@ -62,6 +119,15 @@ namespace lvn
             #endif
                 break;
             }
+            case Lvn_GraphicsApi_opengl:
+            {
+                // query objects are not shared between contexts, they are deleted with the window's context current
+                GLFWwindow* currentContext = glfwGetCurrentContext();
+                glfwMakeContextCurrent(static_cast<GLFWwindow*>(window->nativeWindow));
+                lvn::destroyOglWindowTimestampQueries(window);
+                glfwMakeContextCurrent(currentContext != window->nativeWindow ? currentContext : nullptr);
+                break;
+            }
 
             default:
             {
@@ -91,6 +157,8 @@ namespace lvn
         windowContext->updateWindow = glfwImplUpdateWindow;
         windowContext->windowOpen = glfwImplWindowOpen;
         windowContext->windowPollEvents = glfwImplWindowPollEvents;
+        windowContext->windowWaitEvents = glfwImplWindowWaitEvents;
+        windowContext->windowPostEmptyEvent = glfwImplWindowPostEmptyEvent;
         windowContext->getDimensions = glfwImplGetDimensions;
         windowContext->getWindowWidth = glfwImplGetWindowWidth;
         windowContext->getWindowHeight = glfwImplGetWindowHeight;
@@ -108,6 +176,8 @@ namespace lvn
         windowContext->getMouseY = glfwImplGetMouseY;
         windowContext->setMouseCursor = glfwImplSetMouseCursor;
         windowContext->SetMouseInputMode = glfwImplSetMouseInputMode;
+        windowContext->mouseRawMotionSupported = glfwImplMouseRawMotionSupported;
+        windowContext->setMouseRawMotion = glfwImplSetMouseRawMotion;
 
         windowContext->getWindowPos = glfwImplGetWindowPos;
         windowContext->getWindowPosPtr = glfwImplGetWindowPosPtr;
@@ -165,6 +235,7 @@ namespace lvn
         window->data.fullscreen = createInfo->fullscreen;
         window->data.resizable = createInfo->resizable;
         window->data.vSync = createInfo->vSync;
+        window->data.presentMode = createInfo->presentMode;
         window->data.pIcons = createInfo->pIcons;
         window->data.iconCount = createInfo->iconCount;
 
@@ -175,6 +246,19 @@ namespace lvn
 
         window->data.userData = createInfo->userData;
 
+        // headless windows only own the offscreen images they render to, there is no native window to create, poll or present to
+        if (createInfo->headless)
+        {
+            if (lvn::getGraphicsApi() != Lvn_GraphicsApi_vulkan)
+            {
+                LVN_CORE_ERROR("[glfw] failed to create headless window: \"%s\", headless windows are only supported with vulkan, create a hidden window instead", window->data.title.c_str());
+                return Lvn_Result_Failure;
+            }
+
+            window->nativeWindow = nullptr;
+            return createGraphicsRelatedAPIData(window);
+        }
+
         GLFWmonitor* fullScreen = nullptr;
         if (window->data.fullscreen)
             fullScreen = glfwGetPrimaryMonitor();
@@ -184,6 +268,8 @@ namespace lvn
         else
             glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
 
+        glfwWindowHint(GLFW_VISIBLE, createInfo->hidden ? GLFW_FALSE : GLFW_TRUE);
+
         LvnGraphicsApi graphicsapi = lvn::getGraphicsApi();
 
         // get shared context (opengl)
@@ -230,7 +316,7 @@ namespace lvn
         glfwSetWindowUserPointer(nativeWindow, window);
 
         if (graphicsapi == Lvn_GraphicsApi_opengl)
-            glfwSwapInterval(createInfo->vSync);
+            glfwSwapInterval(lvn::getOpenGLSwapInterval(&window->data));
 
         // Set GLFW Callbacks
         glfwSetWindowSizeCallback(nativeWindow, [](GLFWwindow* window, int width, int height)
@@ -247,7 +333,7 @@ namespace lvn
             event.data.y = height;
             event.userData = data->userData;
 
-            data->eventCallBackFn(&event);
+            lvn::submitEvent(data, &event);
         });
 
         glfwSetFramebufferSizeCallback(nativeWindow, [](GLFWwindow* window, int width, int height)
@@ -265,7 +351,7 @@ namespace lvn
             event.data.y = height;
             event.userData = data->userData;
 
-            data->eventCallBackFn(&event);
+            lvn::submitEvent(data, &event);
 
             switch (lvn::getGraphicsApi())
             {
@@ -300,7 +386,7 @@ namespace lvn
             event.data.y = y;
             event.userData = data->userData;
 
-            data->eventCallBackFn(&event);
+            lvn::submitEvent(data, &event);
         });
 
         glfwSetWindowFocusCallback(nativeWindow, [](GLFWwindow* window, int focused)
@@ -314,7 +400,7 @@ namespace lvn
                 event.handled = false;
                 event.userData = data->userData;
 
-                data->eventCallBackFn(&event);
+                lvn::submitEvent(data, &event);
             }
             else
             {
@@ -324,7 +410,7 @@ namespace lvn
                 event.handled = false;
                 event.userData = data->userData;
 
-                data->eventCallBackFn(&event);
+                lvn::submitEvent(data, &event);
             }
         });
 
@@ -337,7 +423,7 @@ namespace lvn
             event.handled = false;
             event.userData = data->userData;
 
-            data->eventCallBackFn(&event);
+            lvn::submitEvent(data, &event);
         });
 
         glfwSetKeyCallback(nativeWindow, [](GLFWwindow* window, int key, int scancode, int action, int mods)
@@ -355,7 +441,7 @@ namespace lvn
                     event.data.code = key;
                     event.data.repeat = false;
                     event.userData = data->userData;
-                    data->eventCallBackFn(&event);
+                    lvn::submitEvent(data, &event);
                     break;
                 }
                 case GLFW_RELEASE:
@@ -367,7 +453,7 @@ namespace lvn
                     event.data.code = key;
                     event.data.repeat = false;
                     event.userData = data->userData;
-                    data->eventCallBackFn(&event);
+                    lvn::submitEvent(data, &event);
                     break;
                 }
                 case GLFW_REPEAT:
@@ -379,7 +465,7 @@ namespace lvn
                     event.data.code = key;
                     event.data.repeat = true;
                     event.userData = data->userData;
-                    data->eventCallBackFn(&event);
+                    lvn::submitEvent(data, &event);
                     break;
                 }
             }
@@ -394,7 +480,7 @@ namespace lvn
             event.handled = false;
             event.data.ucode = keycode;
             event.userData = data->userData;
-            data->eventCallBackFn(&event);
+            lvn::submitEvent(data, &event);
         });
 
         glfwSetMouseButtonCallback(nativeWindow, [](GLFWwindow* window, int button, int action, int mods)
@@ -411,7 +497,7 @@ namespace lvn
                     event.handled = false;
                     event.data.code = button;
                     event.userData = data->userData;
-                    data->eventCallBackFn(&event);
+                    lvn::submitEvent(data, &event);
                     break;
                 }
                 case GLFW_RELEASE:
@@ -422,7 +508,7 @@ namespace lvn
                     event.handled = false;
                     event.data.code = button;
                     event.userData = data->userData;
-                    data->eventCallBackFn(&event);
+                    lvn::submitEvent(data, &event);
                     break;
                 }
             }
@@ -439,12 +525,15 @@ namespace lvn
             event.data.xd = xOffset;
             event.data.yd = yOffset;
             event.userData = data->userData;
-            data->eventCallBackFn(&event);
+            lvn::submitEvent(data, &event);
         });
 
         glfwSetCursorPosCallback(nativeWindow, [](GLFWwindow* window, double xPos, double yPos)
         {
             LvnWindowData* data = &((LvnWindow*)glfwGetWindowUserPointer(window))->data;
+            if (data->mouseSamples)
+                lvn::pushMouseSample(data, xPos, yPos);
+
             LvnEvent event{};
             event.type = Lvn_EventType_MouseMoved;
             event.category = Lvn_EventCategory_Input | Lvn_EventCategory_Mouse;
@@ -452,7 +541,7 @@ namespace lvn
             event.data.xd = xPos;
             event.data.yd = yPos;
             event.userData = data->userData;
-            data->eventCallBackFn(&event);
+            lvn::submitEvent(data, &event);
         });
 
         return Lvn_Result_Success;
@@ -466,6 +555,9 @@ namespace lvn
 
     bool glfwImplWindowOpen(LvnWindow* window)
     {
+        // headless windows have no native window and stay open until destroyed
+        if (!window->nativeWindow) { return true; }
+
         return (!glfwWindowShouldClose(static_cast<GLFWwindow*>(window->nativeWindow)));
     }
 
@@ -474,8 +566,26 @@ namespace lvn
         glfwPollEvents();
     }
 
+    void glfwImplWindowWaitEvents(double timeout)
+    {
+        // glfw needs a positive timeout, a zero timeout only polls
+        if (timeout < 0.0)
+            glfwWaitEvents();
+        else if (timeout > 0.0)
+            glfwWaitEventsTimeout(timeout);
+        else
+            glfwPollEvents();
+    }
+
+    void glfwImplWindowPostEmptyEvent()
+    {
+        glfwPostEmptyEvent();
+    }
+
     LvnPair<int> glfwImplGetDimensions(LvnWindow* window)
     {
+        if (!window->nativeWindow) { return { window->data.width, window->data.height }; }
+
         int width, height;
         glfwGetWindowSize(static_cast<GLFWwindow*>(window->nativeWindow), &width, &height);
         return { width, height };
@@ -483,6 +593,8 @@ namespace lvn
 
     unsigned int glfwImplGetWindowWidth(LvnWindow* window)
     {
+        if (!window->nativeWindow) { return window->data.width; }
+
         int width, height;
         glfwGetWindowSize(static_cast<GLFWwindow*>(window->nativeWindow), &width, &height);
         return width;
@@ -490,6 +602,8 @@ namespace lvn
 
     unsigned int glfwImplGetWindowHeight(LvnWindow* window)
     {
+        if (!window->nativeWindow) { return window->data.height; }
+
         int width, height;
         glfwGetWindowSize(static_cast<GLFWwindow*>(window->nativeWindow), &width, &height);
         return height;
@@ -503,7 +617,7 @@ namespace lvn
         {
             case Lvn_GraphicsApi_opengl:
             {
-                glfwSwapInterval(enable);
+                glfwSwapInterval(lvn::getOpenGLSwapInterval(&window->data));
                 break;
             }
             case Lvn_GraphicsApi_vulkan:
@@ -536,7 +650,8 @@ namespace lvn
     void glfwImplDestroyWindow(LvnWindow* window)
     {
         destroyGraphicsRelatedAPIData(window);
-        glfwDestroyWindow(static_cast<GLFWwindow*>(window->nativeWindow));
+        if (window->nativeWindow)
+            glfwDestroyWindow(static_cast<GLFWwindow*>(window->nativeWindow));
     }
 
     void glfwImplEventCallBackFn(LvnEvent* e) // default function for event call backs if no function is set
@@ -547,6 +662,7 @@ namespace lvn
     bool glfwImplKeyPressed(LvnWindow* window, int keycode)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return false; }
         int state = glfwGetKey(glfwWin, keycode);
         return state == GLFW_PRESS || state == GLFW_REPEAT;
     }
@@ -554,6 +670,7 @@ namespace lvn
     bool glfwImplKeyReleased(LvnWindow* window, int keycode)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return true; }
         int state = glfwGetKey(glfwWin, keycode);
         return state == GLFW_RELEASE;
     }
@@ -561,6 +678,7 @@ namespace lvn
     bool glfwImplMouseButtonPressed(LvnWindow* window, int button)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return false; }
         int state = glfwGetMouseButton(glfwWin, button);
         return state == GLFW_PRESS;
     }
@@ -568,6 +686,7 @@ namespace lvn
     bool glfwImplMouseButtonReleased(LvnWindow* window, int button)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return true; }
         int state = glfwGetMouseButton(glfwWin, button);
         return state == GLFW_RELEASE;
     }
@@ -575,6 +694,7 @@ namespace lvn
     LvnPair<float> glfwImplGetMousePos(LvnWindow* window)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return { 0.0f, 0.0f }; }
         double xpos, ypos;
         glfwGetCursorPos(glfwWin, &xpos, &ypos);
         return { (float)xpos, (float)ypos };
@@ -583,6 +703,7 @@ namespace lvn
     void glfwImplGetMousePosPtr(LvnWindow* window, float* xpos, float* ypos)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { *xpos = 0.0f; *ypos = 0.0f; return; }
         double xPos, yPos;
         glfwGetCursorPos(glfwWin, &xPos, &yPos);
         *xpos = (float)xPos;
@@ -592,6 +713,7 @@ namespace lvn
     float glfwImplGetMouseX(LvnWindow* window)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return 0.0f; }
         double xPos, yPos;
         glfwGetCursorPos(glfwWin, &xPos, &yPos);
         return (float)xPos;
@@ -600,6 +722,7 @@ namespace lvn
     float glfwImplGetMouseY(LvnWindow* window)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return 0.0f; }
         double xPos, yPos;
         glfwGetCursorPos(glfwWin, &xPos, &yPos);
         return (float)yPos;
@@ -610,12 +733,14 @@ namespace lvn
         LVN_CORE_ASSERT(static_cast<uint32_t>(cursor) < (sizeof(s_CursorIcons) / sizeof(s_CursorIcons[0])), "cursor mode index out of range");
 
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return; }
         glfwSetCursor(glfwWin, s_CursorIcons[cursor]);
     }
 
     void glfwImplSetMouseInputMode(LvnWindow* window, LvnMouseInputMode mode)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return; }
         auto modeEnum = GLFW_CURSOR_NORMAL;
 
         switch (mode)
@@ -629,9 +754,28 @@ namespace lvn
         glfwSetInputMode(glfwWin, GLFW_CURSOR, modeEnum);
     }
 
+    bool glfwImplMouseRawMotionSupported()
+    {
+        return glfwRawMouseMotionSupported() == GLFW_TRUE;
+    }
+
+    void glfwImplSetMouseRawMotion(LvnWindow* window, bool enable)
+    {
+        if (enable && !glfwRawMouseMotionSupported())
+        {
+            LVN_CORE_WARN("[glfw] raw mouse motion is not supported on this platform, window (%p) keeps the scaled and accelerated cursor motion", window);
+            return;
+        }
+
+        if (!window->nativeWindow) { return; }
+
+        glfwSetInputMode(static_cast<GLFWwindow*>(window->nativeWindow), GLFW_RAW_MOUSE_MOTION, enable ? GLFW_TRUE : GLFW_FALSE);
+    }
+
     LvnPair<int> glfwImplGetWindowPos(LvnWindow* window)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return { 0, 0 }; }
         int xpos, ypos;
         glfwGetWindowPos(glfwWin, &xpos, &ypos);
         return { xpos, ypos };
@@ -640,12 +784,14 @@ namespace lvn
     void glfwImplGetWindowPosPtr(LvnWindow* window, int* xpos, int* ypos)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { *xpos = 0; *ypos = 0; return; }
         glfwGetWindowPos(glfwWin, &(*xpos), &(*ypos));
     }
 
     LvnPair<int> glfwImplGetWindowSize(LvnWindow* window)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { return { window->data.width, window->data.height }; }
         int width, height;
         glfwGetWindowSize(glfwWin, &width, &height);
         return { width, height };
@@ -654,6 +800,7 @@ namespace lvn
     void glfwImplGetWindowSizePtr(LvnWindow* window, int* width, int* height)
     {
         GLFWwindow* glfwWin = static_cast<GLFWwindow*>(window->nativeWindow);
+        if (!glfwWin) { *width = window->data.width; *height = window->data.height; return; }
         glfwGetWindowSize(glfwWin, &(*width), &(*height));
     }
 }
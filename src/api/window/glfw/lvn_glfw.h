@@ -14,6 +14,8 @@ namespace lvn
     void glfwImplUpdateWindow(LvnWindow* window);
     bool glfwImplWindowOpen(LvnWindow* window);
     void glfwImplWindowPollEvents();
+    void glfwImplWindowWaitEvents(double timeout);
+    void glfwImplWindowPostEmptyEvent();
     LvnPair<int> glfwImplGetDimensions(LvnWindow* window);
     unsigned int glfwImplGetWindowWidth(LvnWindow* window);
     unsigned int glfwImplGetWindowHeight(LvnWindow* window);
@@ -33,6 +35,8 @@ namespace lvn
     float glfwImplGetMouseY(LvnWindow* window);
     void glfwImplSetMouseCursor(LvnWindow* window, LvnMouseCursor cursor);
     void glfwImplSetMouseInputMode(LvnWindow* window, LvnMouseInputMode mode);
+    bool glfwImplMouseRawMotionSupported();
+    void glfwImplSetMouseRawMotion(LvnWindow* window, bool enable);
 
     LvnPair<int> glfwImplGetWindowPos(LvnWindow* window);
     void glfwImplGetWindowPosPtr(LvnWindow* window, int* xpos, int* ypos);
@@ -1,7 +1,9 @@
 #include "levikno.h"
 
 #define STB_IMAGE_IMPLEMENTATION
-#define STBI_NO_SIMD
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define STBI_NEON
+#endif
 #define STBI_MALLOC(sz)         LVN_MALLOC(sz)
 #define STBI_REALLOC(p,newsz)   LVN_REALLOC(p,newsz)
 #define STBI_FREE(p)            LVN_FREE(p)
@@ -5,17 +5,83 @@
 
 #include "stb_image.h"
 #include "stb_image_write.h"
+
+#if defined(LVN_IMAGE_DECODER_TURBOJPEG)
+    #include <turbojpeg.h>
+#endif
+#if defined(LVN_IMAGE_DECODER_SPNG)
+    #include <spng.h>
+#endif
+#if defined(LVN_IMAGE_DECODER_TURBOJPEG) || defined(LVN_IMAGE_DECODER_SPNG)
+    #define LVN_IMAGE_DECODERS
+#endif
+
+// defined by stb_image_write for its png encoder but only declared in its implementation section
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
 #include "miniaudio.h"
 #include "freetype/freetype.h"
+#include "freetype/ftmodapi.h"
 #include "enet/enet.h"
+#include "enet/time.h"
 
 #ifdef LVN_PLATFORM_WINDOWS
     #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#ifdef LVN_PLATFORM_LINUX
+    #include <sys/inotify.h>
+#endif
+
+// simd paths of the image utilities, only instruction sets the compiler targets by default are used
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LVN_SIMD_SSE2
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+    #include <tmmintrin.h>
+    #define LVN_SIMD_SSSE3
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define LVN_SIMD_NEON
+#endif
+
+// avx2 batch math kernels are compiled for avx2 and fma on their own and only called when the running cpu supports both
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(_MSC_VER))
+    #include <immintrin.h>
+    #define LVN_SIMD_AVX2_DISPATCH
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+    #if defined(__GNUC__) || defined(__clang__)
+        #define LVN_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #else
+        #define LVN_TARGET_AVX2
+    #endif
 #endif
 
 #define LVN_ABORT throw std::bad_alloc{};
 #define LVN_EMPTY_STR "\0"
 #define LVN_DEFAULT_LOG_PATTERN "[%Y-%m-%d] [%T] [%#%l%^] %n: %v%$"
+#define LVN_LOG_ASYNC_QUEUE_CAPACITY 8192
+#define LVN_LOG_ASYNC_BATCH_SIZE 256
+#define LVN_LOG_ASYNC_FLUSH_INTERVAL 5 // milliseconds the log thread sleeps between batches when no error or full queue wakes it
+#define LVN_LOG_BINARY_MAGIC "LVNBLOG1"
+#define LVN_LOG_BINARY_MAGIC_SIZE 8
+#define LVN_LOG_BINARY_BUFFER_SIZE (64 * 1024) // bytes of binary log records collected before they are handed to the io thread
+#define LVN_SOUND_STREAM_INTERVAL 10 // milliseconds the sound stream thread sleeps between refills when no seek or new sound wakes it
+#define LVN_SOUND_STREAM_MIN_FRAMES 4096 // smallest stream buffer, leaves room for several refill intervals at any sample rate
+#define LVN_SOUND_VIRTUAL_HYSTERESIS 1.21f // squared distance scale past the audible radius before a sound is virtualized, 10% further than the radius
+#define LVN_SOUND_AUDIBLE_GAIN 0.001f // -60db, quieter voices are virtualized by audioUpdateVoices
+#define LVN_SOUND_DEFAULT_MAX_VOICES 64
+#define LVN_SOUND_GROUP_LOW_PASS_ORDER 2
+#define LVN_SOUND_GROUP_MAX_DECAY 0.95f // reverb feedback is kept below 1.0 so the tail always dies out
+#define LVN_SOCKET_CONNECTION_PEER UINT32_MAX // peer id of socket commands that go to the connection of a client socket
 
 #include "lvn_glfw.h"
 #include "lvn_opengl.h"
@@ -28,6 +94,55 @@
 #include "lvn_renderer.h"
 
 static LvnContext* s_LvnContext = nullptr;
+static std::atomic<uint64_t> s_ContextIdCounter{0};
+
+
+// ------------------------------------------------------------
+// [SECTION]: Memory Pool Internal structs
+// ------------------------------------------------------------
+
+// each thread keeps a few freed slots of every sType, so objects created and destroyed on the same thread never touch shared state
+// slots cached for an older context are dropped by comparing context ids, ids are never reused
+struct LvnObjectCache
+{
+    static constexpr uint32_t s_Capacity = 16;
+
+    struct Bin
+    {
+        void* slots[s_Capacity];
+        uint32_t count;
+    };
+
+    uint64_t contextId;
+    Bin bins[Lvn_Stype_Max_Value];
+
+    ~LvnObjectCache()
+    {
+        // hand the cached slots back when a loader thread exits so other threads can still reuse them
+        LvnContext* lvnctx = s_LvnContext;
+        if (lvnctx == nullptr || lvnctx->contextId != contextId)
+            return;
+
+        LvnLockGaurd lock(lvnctx->objectMutex);
+        for (uint32_t i = 0; i < lvnctx->objectCaches.size(); i++)
+        {
+            if (lvnctx->objectCaches[i] == this)
+            {
+                lvnctx->objectCaches.erase(lvnctx->objectCaches.begin() + i);
+                break;
+            }
+        }
+
+        for (uint32_t i = 0; i < Lvn_Stype_Max_Value; i++)
+        {
+            for (uint32_t j = 0; j < bins[i].count; j++)
+                lvnctx->memoryPool.freeLists[i].push(bins[i].slots[j]);
+        }
+    }
+};
+
+static thread_local LvnObjectCache s_ObjectCache = {};
+static thread_local LvnSocket* s_ServicingSocket = nullptr; // socket whose host is inside enet_host_service on this thread, read by the loss simulation
 
 
 // ------------------------------------------------------------
@@ -42,8 +157,229 @@ struct LvnSound
     bool looping;
 
     LvnVec3 pos;
+    LvnVec3 vel;
+
+    float audibleRadius;       // 0.0 when the sound is never virtualized
+    uint32_t priority;
+    bool virtualized;          // stopped while playing, by soundsUpdateSpatial out of range or by audioUpdateVoices out of the voice budget
+    bool virtualizedByBudget;  // only audioUpdateVoices resumes the sound
+    uint64_t virtualizedTime;  // engine time in pcm frames when the sound was virtualized
 
     ma_sound sound;
+    ma_decoder decoder;     // decodes sounds loaded from a pack
+    LvnBin packedData;      // encoded sound data from a pack, read by the decoder
+    bool packed;
+    LvnSoundStream* stream; // nullptr unless the sound is streamed
+    ma_fence loadFence;     // released by the resource manager once an async sound has loaded
+    bool async;             // created by createSoundAsync, its data may still be loading
+};
+
+// data source of a streamed sound, the stream thread decodes into the ring buffer and the audio thread reads from it
+struct LvnSoundStream
+{
+    ma_data_source_base base; // must be first, the stream is passed to miniaudio as the data source
+    ma_decoder decoder;       // only used by the stream thread
+    ma_pcm_rb buffer;         // single producer (stream thread), single consumer (audio thread)
+    uint32_t channels;
+    uint32_t sampleRate;
+
+    std::atomic<uint64_t> length;        // UINT64_MAX until the stream thread has measured the track
+    std::atomic<uint64_t> cursor;        // playback position in frames, grows past the length while looping
+    std::atomic<uint64_t> seekFrame;     // UINT64_MAX when no seek is pending
+    std::atomic<uint64_t> prefetchFrame; // seek already requested by soundSeekToPcmFrame, ignored when miniaudio applies it
+    std::atomic<uint64_t> writtenFrames; // frames written into the buffer since creation
+    std::atomic<uint64_t> validFrom;     // frames written before this count were decoded before the last seek
+    std::atomic<bool> decodedToEnd;
+    uint64_t readFrames;                 // frames taken from the buffer since creation, only used by the audio thread
+};
+
+struct LvnSoundBankEntry
+{
+    LvnString filepath;     // name of the decoded data in the resource manager of the engine
+    LvnBin packedData;      // encoded sound data from a pack, registered with the resource manager under filepath until the bank is destroyed
+    ma_sound prototype;     // never played, holds the reference to the decoded data that voices are copied from
+    LvnVector<ma_sound*> voices;
+};
+
+struct LvnSoundBank
+{
+    LvnVector<LvnSoundBankEntry*> entries;
+    uint32_t maxVoicesPerSound;
+    float audibleRadius;
+    ma_sound_group* group;     // group the voices are mixed into, nullptr for the master output
+    LvnMutex mutex;
+};
+
+struct LvnSoundGroup
+{
+    ma_sound_group group;
+    ma_lpf_node lowPass;
+    ma_splitter_node splitter; // sends the filtered group to the output and the reverb
+    ma_delay_node reverb;
+    ma_node* output;           // parent group or the engine endpoint
+    float lowPassCutoff;       // 0.0 when the low pass is bypassed
+    float reverbSend;          // 0.0 when the reverb is bypassed
+};
+
+
+// ------------------------------------------------------------
+// [SECTION]: Font Internal structs
+// ------------------------------------------------------------
+
+struct LvnSkylineNode
+{
+    uint32_t x, y, width;
+};
+
+struct LvnDynamicFontPage
+{
+    LvnVector<uint8_t> pixels;
+    LvnVector<LvnSkylineNode> skyline; // top edge of the packed glyphs, sorted by x and covering the page width
+    LvnTexture* texture;                          // created on the first update of the page
+
+    uint64_t lastUsed;                            // frame a glyph of the page was last requested in
+    uint32_t generation;                          // incremented when the page is cleared, glyphs packed in an older generation are rasterized again
+    uint32_t dirtyX0, dirtyY0, dirtyX1, dirtyY1;  // region rasterized since the last upload, empty if dirtyX1 is zero
+};
+
+struct LvnDynamicFontGlyph
+{
+    LvnFontGlyph glyph;
+    uint32_t page;                                // UINT32_MAX for glyphs without a bitmap (eg. spaces)
+    uint32_t generation;
+};
+
+struct LvnDynamicFont
+{
+    FT_Library library;
+    FT_Face face;
+    FT_Int32 loadFlags;
+    bool mono;
+    bool sdf;
+
+    uint32_t pageWidth, pageHeight;
+    uint32_t maxPages;
+    uint64_t frame;
+
+    LvnVector<LvnDynamicFontPage> pages;
+    LvnHashMap<uint32_t, LvnDynamicFontGlyph> glyphs;
+    LvnVector<uint8_t> uploadScratch;
+    LvnMutex mutex;
+};
+
+struct LvnFontRasterFace
+{
+    FT_Library library;
+    FT_Face face;
+    bool loaded;
+};
+
+struct LvnFontRasterGlyph
+{
+    LvnVector<uint8_t> bitmap;                    // 8 bit coverage or distance, width * rows
+    uint32_t width, rows;
+    int bearingX, bearingY;
+    int advance;
+};
+
+struct LvnFontRasterData
+{
+    const uint8_t* fontData;
+    uint64_t fontDataSize;
+    uint32_t fontSize;
+    const uint32_t* pCodepoints;
+    uint32_t loadFlags;
+    int sdfSpread;
+    bool mono;
+
+    LvnFontRasterFace* faces;                     // indexed by lvn::jobGetThreadIndex()
+    LvnFontRasterGlyph* glyphs;                   // one for each codepoint
+};
+
+#define LVN_FONT_CACHE_MAGIC 0x544e464c // "LFNT"
+#define LVN_FONT_CACHE_VERSION 1
+
+// font cache files are this header followed by the glyphs and the single channel atlas pixels
+struct LvnFontCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fontSize;
+    uint32_t flags;
+    uint32_t glyphCount;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+    uint64_t fontHash;
+    uint64_t codepointHash;
+};
+
+// ------------------------------------------------------------
+// [SECTION]: Texture Stream Internal structs
+// ------------------------------------------------------------
+
+struct LvnTextureStream
+{
+    LvnTexture* texture;
+    LvnTextureStreamLevel level;
+    LvnTextureCreateInfo textureInfo;           // format, filters and wrap modes of every level, the image data is set per upload
+
+    LvnString filepath;
+    LvnVector<uint8_t> data;                    // encoded image copied from memory, freed once decoded
+    uint32_t previewSize;
+    bool mipmaps;
+
+    // written by the decode job and only read once the counter is zero
+    LvnImageData image;
+    LvnVector<LvnImageData> mipLevels;          // mip levels 1 and up of a compressed image
+    LvnImageData preview;                       // downscaled uncompressed image, empty if there is none
+    uint32_t previewMip;                        // mip level of a compressed image used as the preview, 0 if there is none
+    bool failed;
+
+    LvnJobCounter counter;
+};
+
+
+// ------------------------------------------------------------
+// [SECTION]: Texture Atlas Internal structs
+// ------------------------------------------------------------
+
+struct LvnTextureAtlasPage
+{
+    LvnVector<uint8_t> pixels;                    // rgba texels of the page
+    LvnVector<LvnSkylineNode> skyline;            // top edge of the packed images, sorted by x and covering the page width
+    LvnTexture* texture;                          // created on the first update of the page
+    bool closed;                                  // mipmapped pages take no new images once uploaded
+    uint32_t dirtyX0, dirtyY0, dirtyX1, dirtyY1;  // region written since the last upload, empty if dirtyX1 is zero
+};
+
+struct LvnTextureAtlas
+{
+    uint32_t pageWidth, pageHeight;
+    uint32_t maxPages;
+    uint32_t padding;
+    uint32_t alignment;                           // packed rects start on and span multiples of this, 2^(mipLevels - 1)
+    uint32_t mipLevels;
+    LvnTextureFormat format;
+    LvnTextureFilter minFilter, magFilter;
+
+    LvnVector<LvnTextureAtlasPage> pages;
+    LvnVector<LvnTextureAtlasRegion> regions;
+    LvnVector<uint8_t> uploadScratch;
+    LvnMutex mutex;
+};
+
+
+// ------------------------------------------------------------
+// [SECTION]: Image Decoder Internal structs
+// ------------------------------------------------------------
+
+// decoder of one image format, getInfo reads the size and channels stb would decode to from the header
+struct LvnImageDecoder
+{
+    bool (*match)(const uint8_t* data, uint64_t length);
+    bool (*getInfo)(const uint8_t* data, uint64_t length, uint32_t* width, uint32_t* height, uint32_t* channels);
+    bool (*decode)(const uint8_t* data, uint64_t length, uint8_t* dst, uint32_t width, uint32_t height, uint32_t channels, bool flipVertically);
 };
 
 
@@ -51,6 +387,54 @@ struct LvnSound
 // [SECTION]: Network Internal structs
 // ------------------------------------------------------------
 
+struct LvnSocketPeerStats
+{
+    uint64_t bytesSent;
+    uint64_t bytesReceived;
+    uint64_t packetsSent;
+    uint64_t packetsReceived;
+};
+
+enum LvnSocketCommandType
+{
+    Lvn_SocketCommand_Send,
+    Lvn_SocketCommand_Broadcast,
+    Lvn_SocketCommand_Connect,
+    Lvn_SocketCommand_Disconnect,
+    Lvn_SocketCommand_DisconnectPeer,
+};
+
+// requests from game threads to the network thread of a socket
+struct LvnSocketCommand
+{
+    LvnSocketCommandType type;
+    ENetPacket* packet;
+    uint32_t peerId;
+    uint8_t channel;
+    uint32_t channelCount;
+    LvnAddress address;
+};
+
+// events received by the network thread, the packet is destroyed by the thread that services the socket
+struct LvnSocketQueuedEvent
+{
+    LvnSocketEventType type;
+    ENetPacket* packet;
+    uint32_t peerId;
+    uint8_t channel;
+    uint32_t data;
+};
+
+// packet held back by the network simulation of a socket until its release time
+struct LvnSocketDelayedPacket
+{
+    ENetPacket* packet;
+    uint32_t peerId;
+    uint32_t releaseTime;   // enet_time_get milliseconds
+    uint8_t channel;
+    bool broadcast;
+};
+
 struct LvnSocket
 {
     LvnSocketType type;
@@ -58,130 +442,921 @@ struct LvnSocket
     ENetHost* socket;
     ENetPeer* connection;
     ENetPacket* packet;
+    LvnVector<LvnSocketPeerStats> peerStats; // indexed by peer id, one for each peer slot of the host
+
+    LvnThread* networkThread;                   // owns the host when the socket was created with networkThread, nullptr otherwise
+    LvnMpmcQueue<LvnSocketCommand>* commands;   // pushed by any thread, popped by the network thread
+    LvnSpscQueue<LvnSocketQueuedEvent>* events; // pushed by the network thread, popped by the one thread servicing the socket
+    LvnQueue<LvnSocketQueuedEvent> overflow;    // network thread only, holds events in order while the event queue is full
+    std::atomic<bool> networkStop;
+    uint32_t networkTickMilliseconds;
+
+    LvnSocketCompression compression;
+    uint32_t compressionThreshold;
+    void* rangeCoder;                   // enet range coder context for Lvn_SocketCompression_RangeCoder
+    LvnVector<uint8_t> compressBuffer;  // datagram gathered into one block for deflate, only used by the thread servicing the host
+
+    LvnSocketSimulation simulation;
+    LvnQueue<LvnSocketDelayedPacket> delayedPackets; // in release order, only used by the thread servicing the host
+    uint64_t simulationRandom;                       // xorshift state for the simulated jitter and loss
 
     LvnAddress address;
     uint32_t channelCount;
     uint32_t connectionCount;
     uint32_t inBandWidth;
     uint32_t outBandWidth;
+    bool batchSends;
 };
 
 
-namespace lvn
+// ------------------------------------------------------------
+// [SECTION]: Hot Reload Internal structs
+// ------------------------------------------------------------
+
+// directories of the watched files, a change notification for a directory makes hotReloadUpdate compare the write times of its files
+struct LvnHotReloadDirectory
 {
+    LvnString path;
+#if defined(LVN_PLATFORM_WINDOWS)
+    HANDLE handle;                      // change notification handle, INVALID_HANDLE_VALUE if the directory is polled
+#elif defined(LVN_PLATFORM_LINUX)
+    int wd;                             // inotify watch descriptor, -1 if the directory is polled
+#endif
+    bool changed;
+};
 
-// memory allocation functions
-static void*   mallocWrapper(size_t size, void* userData)               { (void)userData; return malloc(size); }
-static void    freeWrapper(void* ptr, void* userData)                   { (void)userData; free(ptr); }
-static void*   reallocWrapper(void* ptr, size_t size, void* userData)   { (void)userData; return realloc(ptr, size); }
-static LvnMemAllocFunc    s_MemAllocFunc = mallocWrapper;
-static LvnMemFreeFunc     s_MemFreeFunc = freeWrapper;
-static LvnMemReallocFunc  s_MemReallocFunc = reallocWrapper;
-static void*              s_MemAllocUserData = nullptr;
+struct LvnHotReloadWatcher
+{
+#if defined(LVN_PLATFORM_LINUX)
+    int fd;                             // non blocking inotify instance, -1 if every directory is polled
+#endif
+    LvnVector<LvnHotReloadDirectory> directories;
+};
 
 
-static LvnResult                    initLogging(LvnContextCreateInfo* createInfo);
-static void                         terminateLogging();
-static LvnVector<LvnLogPattern>     logParseFormat(const char* fmt);
-static const char*                  getLogLevelColor(LvnLogLevel level);
-static const char*                  getLogLevelName(LvnLogLevel level);
-static const char*                  getWindowApiNameEnum(LvnWindowApi api);
-static const char*                  getGraphicsApiNameEnum(LvnGraphicsApi api);
-static LvnResult                    setWindowContext(LvnContext* lvnctx, LvnWindowApi windowapi);
-static void                         terminateWindowContext(LvnContext* lvnctx);
-static LvnResult                    setGraphicsContext(LvnContext* lvnctx, LvnGraphicsApi graphicsapi);
-static void                         terminateGraphicsContext(LvnContext* lvnctx);
-static LvnResult                    initAudioContext(LvnContext* lvnctx);
-static void                         terminateAudioContext(LvnContext* lvnctx);
-static LvnResult                    initNetworkingContext();
-static void                         terminateNetworkingContext();
-static void                         initStandardPipelineSpecification(LvnContext* lvnctx);
-static void                         setDefaultStructTypeMemAllocInfos(LvnContext* lvnctx);
-static const char*                  getStructTypeEnumStr(LvnStructureType stype);
-static uint64_t                     getStructTypeSize(LvnStructureType sType);
-static LvnData<uint32_t>            initDefaultFontCodepoints();
-static LvnResult                    createContextMemoryPool(LvnContext* lvnctx, LvnContextCreateInfo* createInfo);
-static void                         createMemoryBlock(LvnContext* lvnctx, LvnStructureType sType);
+// ------------------------------------------------------------
+// [SECTION]: Environment Map Internal structs
+// ------------------------------------------------------------
 
-template <typename T>
-static T* createObject(LvnContext* lvnctx, LvnStructureType sType);
+#define LVN_ENVIRONMENT_MAP_CACHE_MAGIC 0x4d45564c // "LVEM"
+#define LVN_ENVIRONMENT_MAP_CACHE_VERSION 1
+
+// environment map cache files are this header followed by the baked texels
+struct LvnEnvironmentMapCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t cubemapSize;
+    uint32_t irradianceSize;
+    uint32_t prefilterSize;
+    uint32_t prefilterMipLevels;
+    uint32_t brdfLutSize;
+    uint32_t reserved;
+    uint64_t hdrHash;
+    uint64_t dataSize;
+};
 
-template <typename T>
-static void destroyObject(LvnContext* lvnctx, T* obj, LvnStructureType sType);
+#define LVN_HDR_IMAGE_CACHE_MAGIC 0x4448564c // "LVHD"
+#define LVN_HDR_IMAGE_CACHE_VERSION 1
+
+// hdr image cache files are this header followed by the converted texels
+struct LvnHdrImageCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t format;
+    uint32_t flipVertically;
+    uint32_t reserved;
+    uint64_t sourceHash;
+    uint64_t dataSize;
+};
 
+struct LvnHdrImageConvertData
+{
+    const float* src;
+    uint8_t* dst;
+    uint32_t width;
+    LvnHdrImageFormat format;
+};
 
-// Windows platform specific; enables console output colors
-#ifdef LVN_PLATFORM_WINDOWS
-static void enableLogANSIcodeColors()
+struct LvnHdrImageLoadJob
 {
-    DWORD consoleMode;
-    HANDLE outputHandle = GetStdHandle(STD_OUTPUT_HANDLE);
-    if (GetConsoleMode(outputHandle, &consoleMode))
-    {
-        SetConsoleMode(outputHandle, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
-    }
-}
+    LvnString filepath;
+    LvnString cachePath;
+    LvnHdrImageFormat format;
+    bool flipVertically;
+    LvnImageHdrData* pImageData;
+};
+
+// taps source pixels per destination pixel starting at first, weights past the covered pixels are zero so every pixel runs the same loop
+struct LvnImageResampleWeights
+{
+    LvnVector<uint32_t> first;
+    LvnVector<float> weights;
+    uint32_t taps;
+};
+
+struct LvnImageResampleData
+{
+    const float* src;
+    float* dst;
+    float* tmp;                         // horizontally filtered rows, srcHeight rows of dstWidth pixels
+    uint32_t srcWidth, dstWidth;
+    uint32_t channels;
+    const LvnImageResampleWeights* horizontal;
+    const LvnImageResampleWeights* vertical;
+    void (*resampleColumns)(const float* src, size_t stride, const float* weights, uint32_t taps, float* dst, size_t count);
+};
+
+struct LvnImageLinearData
+{
+    const uint8_t* src;
+    uint8_t* dst;
+    float* linear;                      // premultiplied alpha, color in linear space for srgb images
+    uint32_t width, channels;
+    bool srgb;
+};
+
+// the bake shaders are put together from these parts, see setEnvironmentMapShaderSrcs
+// the cubemap storage image is bound as a 2d array in vulkan since storage image views cannot be cube views there,
+// face z maps uv in [-1,1] to the cubemap direction of that face
+static const char* s_EnvironmentMapCubeShaderHeaderSrc = R"(
+#version 460
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+#ifdef VULKAN
+layout(binding = 1, rgba16f) uniform writeonly image2DArray outCubemap;
+#else
+layout(binding = 1, rgba16f) uniform writeonly imageCube outCubemap;
 #endif
 
-static const char* getLogLevelColor(LvnLogLevel level)
+#define PI 3.14159265359
+
+vec3 getCubemapDirection(ivec3 id, ivec2 size)
 {
-    switch (level)
+    vec2 uv = (vec2(id.xy) + 0.5) / vec2(size) * 2.0 - 1.0;
+
+    switch (id.z)
     {
-        case Lvn_LogLevel_None:     { return LVN_LOG_COLOR_RESET; }
-        case Lvn_LogLevel_Trace:    { return LVN_LOG_COLOR_TRACE; }
-        case Lvn_LogLevel_Debug:    { return LVN_LOG_COLOR_DEBUG; }
-        case Lvn_LogLevel_Info:     { return LVN_LOG_COLOR_INFO; }
-        case Lvn_LogLevel_Warn:     { return LVN_LOG_COLOR_WARN; }
-        case Lvn_LogLevel_Error:    { return LVN_LOG_COLOR_ERROR; }
-        case Lvn_LogLevel_Fatal:    { return LVN_LOG_COLOR_FATAL; }
+        case 0:  { return normalize(vec3(1.0, -uv.y, -uv.x)); }
+        case 1:  { return normalize(vec3(-1.0, -uv.y, uv.x)); }
+        case 2:  { return normalize(vec3(uv.x, 1.0, uv.y)); }
+        case 3:  { return normalize(vec3(uv.x, -1.0, -uv.y)); }
+        case 4:  { return normalize(vec3(uv.x, -uv.y, 1.0)); }
+        default: { return normalize(vec3(-uv.x, -uv.y, -1.0)); }
     }
-
-    return nullptr;
 }
+)";
 
-static const char* getLogLevelName(LvnLogLevel level)
+static const char* s_EnvironmentMapGgxShaderSrc = R"(
+float radicalInverseVdC(uint bits)
 {
-    switch (level)
-    {
-        case Lvn_LogLevel_None:     { return "none"; }
-        case Lvn_LogLevel_Trace:    { return "trace"; }
-        case Lvn_LogLevel_Debug:    { return "debug"; }
-        case Lvn_LogLevel_Info:     { return "info"; }
-        case Lvn_LogLevel_Warn:     { return "warn"; }
-        case Lvn_LogLevel_Error:    { return "error"; }
-        case Lvn_LogLevel_Fatal:    { return "fatal"; }
-    }
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return float(bits) * 2.3283064365386963e-10;
+}
 
-    return nullptr;
+vec2 hammersley(uint i, uint count)
+{
+    return vec2(float(i) / float(count), radicalInverseVdC(i));
 }
 
-static const char* getWindowApiNameEnum(LvnWindowApi api)
+vec3 importanceSampleGGX(vec2 xi, vec3 N, float roughness)
 {
-    switch (api)
-    {
-        case Lvn_WindowApi_None:  { return "None";  }
-        case Lvn_WindowApi_glfw:  { return "glfw";  }
-        // case Lvn_WindowApi_win32: { return "win32"; }
-    }
+    float a = roughness * roughness;
 
-    return LVN_EMPTY_STR;
+    float phi = 2.0 * PI * xi.x;
+    float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (a * a - 1.0) * xi.y));
+    float sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+
+    vec3 H = vec3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta);
+
+    vec3 up = abs(N.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 tangent = normalize(cross(up, N));
+    vec3 bitangent = cross(N, tangent);
+
+    return normalize(tangent * H.x + bitangent * H.y + N * H.z);
 }
 
-static const char* getGraphicsApiNameEnum(LvnGraphicsApi api)
+float distributionGGX(float NdotH, float roughness)
 {
-    switch (api)
-    {
-        case Lvn_GraphicsApi_None:   { return "None";   }
-        case Lvn_GraphicsApi_vulkan: { return "vulkan"; }
-        case Lvn_GraphicsApi_opengl: { return "opengl"; }
-    }
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float denom = NdotH * NdotH * (a2 - 1.0) + 1.0;
+    return a2 / (PI * denom * denom);
+}
+)";
 
-    return LVN_EMPTY_STR;
+static const char* s_EnvironmentMapEquirectToCubemapSrc = R"(
+layout(binding = 0) uniform sampler2D inEquirect;
+
+void main()
+{
+    ivec3 id = ivec3(gl_GlobalInvocationID);
+    ivec2 size = imageSize(outCubemap).xy;
+    if (id.x >= size.x || id.y >= size.y)
+        return;
+
+    vec3 dir = getCubemapDirection(id, size);
+    vec2 uv = vec2(atan(dir.z, dir.x) / (2.0 * PI) + 0.5, acos(clamp(dir.y, -1.0, 1.0)) / PI);
+
+    imageStore(outCubemap, id, vec4(textureLod(inEquirect, uv, 0.0).rgb, 1.0));
 }
+)";
 
-static LvnResult setWindowContext(LvnContext* lvnctx, LvnWindowApi windowapi)
+static const char* s_EnvironmentMapIrradianceSrc = R"(
+layout(binding = 0) uniform samplerCube inCubemap;
+
+void main()
 {
-    LvnResult result = Lvn_Result_Failure;
+    ivec3 id = ivec3(gl_GlobalInvocationID);
+    ivec2 size = imageSize(outCubemap).xy;
+    if (id.x >= size.x || id.y >= size.y)
+        return;
+
+    vec3 N = getCubemapDirection(id, size);
+    vec3 up = abs(N.y) < 0.999 ? vec3(0.0, 1.0, 0.0) : vec3(0.0, 0.0, 1.0);
+    vec3 right = normalize(cross(up, N));
+    up = cross(N, right);
+
+    // sample a smaller mip so the fixed sample pattern does not alias over small bright spots
+    float lod = max(log2(float(textureSize(inCubemap, 0).x) / 64.0), 0.0);
+    const float sampleDelta = 0.025;
+
+    vec3 irradiance = vec3(0.0);
+    float sampleCount = 0.0;
+
+    for (float phi = 0.0; phi < 2.0 * PI; phi += sampleDelta)
+    {
+        for (float theta = 0.0; theta < 0.5 * PI; theta += sampleDelta)
+        {
+            vec3 tangentSample = vec3(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+            vec3 sampleDir = tangentSample.x * right + tangentSample.y * up + tangentSample.z * N;
+
+            irradiance += textureLod(inCubemap, sampleDir, lod).rgb * cos(theta) * sin(theta);
+            sampleCount++;
+        }
+    }
+
+    imageStore(outCubemap, id, vec4(PI * irradiance / sampleCount, 1.0));
+}
+)";
+
+static const char* s_EnvironmentMapPrefilterSrc = R"(
+layout(binding = 0) uniform samplerCube inCubemap;
+
+#ifdef VULKAN
+layout(push_constant) uniform PushConstants
+{
+    float roughness;
+} pc;
+#define ROUGHNESS pc.roughness
+#else
+layout(location = 0) uniform float u_Roughness;
+#define ROUGHNESS u_Roughness
+#endif
+
+void main()
+{
+    ivec3 id = ivec3(gl_GlobalInvocationID);
+    ivec2 size = imageSize(outCubemap).xy;
+    if (id.x >= size.x || id.y >= size.y)
+        return;
+
+    vec3 N = getCubemapDirection(id, size);
+    vec3 V = N;
+    float roughness = ROUGHNESS;
+
+    float resolution = float(textureSize(inCubemap, 0).x);
+    float texelSolidAngle = 4.0 * PI / (6.0 * resolution * resolution);
+    const uint sampleCount = 1024u;
+
+    vec3 color = vec3(0.0);
+    float totalWeight = 0.0;
+
+    for (uint i = 0u; i < sampleCount; i++)
+    {
+        vec3 H = importanceSampleGGX(hammersley(i, sampleCount), N, roughness);
+        vec3 L = normalize(2.0 * dot(V, H) * H - V);
+
+        float NdotL = max(dot(N, L), 0.0);
+        if (NdotL > 0.0)
+        {
+            // pick the source mip from the solid angle each sample covers so bright texels are not undersampled
+            float NdotH = max(dot(N, H), 0.0);
+            float HdotV = max(dot(H, V), 0.0);
+            float pdf = distributionGGX(NdotH, roughness) * NdotH / (4.0 * HdotV) + 0.0001;
+            float sampleSolidAngle = 1.0 / (float(sampleCount) * pdf + 0.0001);
+            float lod = roughness == 0.0 ? 0.0 : 0.5 * log2(sampleSolidAngle / texelSolidAngle);
+
+            color += textureLod(inCubemap, L, lod).rgb * NdotL;
+            totalWeight += NdotL;
+        }
+    }
+
+    imageStore(outCubemap, id, vec4(color / max(totalWeight, 0.0001), 1.0));
+}
+)";
+
+static const char* s_EnvironmentMapBrdfLutHeaderSrc = R"(
+#version 460
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+layout(binding = 1, rgba16f) uniform writeonly image2D outLut;
+
+#define PI 3.14159265359
+)";
+
+static const char* s_EnvironmentMapBrdfLutSrc = R"(
+float geometrySchlickGGX(float NdotV, float roughness)
+{
+    float k = (roughness * roughness) / 2.0;
+    return NdotV / (NdotV * (1.0 - k) + k);
+}
+
+void main()
+{
+    ivec2 id = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(outLut);
+    if (id.x >= size.x || id.y >= size.y)
+        return;
+
+    float NdotV = (float(id.x) + 0.5) / float(size.x);
+    float roughness = (float(id.y) + 0.5) / float(size.y);
+
+    vec3 V = vec3(sqrt(1.0 - NdotV * NdotV), 0.0, NdotV);
+    vec3 N = vec3(0.0, 0.0, 1.0);
+    const uint sampleCount = 1024u;
+
+    float scale = 0.0;
+    float bias = 0.0;
+
+    for (uint i = 0u; i < sampleCount; i++)
+    {
+        vec3 H = importanceSampleGGX(hammersley(i, sampleCount), N, roughness);
+        vec3 L = normalize(2.0 * dot(V, H) * H - V);
+
+        float NdotL = max(L.z, 0.0);
+        float NdotH = max(H.z, 0.0);
+        float VdotH = max(dot(V, H), 0.0);
+
+        if (NdotL > 0.0)
+        {
+            float G = geometrySchlickGGX(NdotV, roughness) * geometrySchlickGGX(NdotL, roughness);
+            float visibility = G * VdotH / (NdotH * NdotV);
+            float fresnel = pow(1.0 - VdotH, 5.0);
+
+            scale += (1.0 - fresnel) * visibility;
+            bias += fresnel * visibility;
+        }
+    }
+
+    imageStore(outLut, id, vec4(scale / float(sampleCount), bias / float(sampleCount), 0.0, 1.0));
+}
+)";
+
+// lookup of the cluster buffer written by lightClustersUpdate, matches LvnLightClustersHeader
+static const char* s_LightClustersShaderSrc = R"(
+#ifndef LVN_LIGHT_CLUSTERS_BINDING
+#define LVN_LIGHT_CLUSTERS_BINDING 8
+#endif
+
+layout(std430, binding = LVN_LIGHT_CLUSTERS_BINDING) readonly buffer LvnLightClusters
+{
+    uvec4 lvnClusterGrid;  // tiles x, tiles y, slices, index count
+    vec4 lvnClusterDepth;  // near, far, slice scale, slice bias
+    vec4 lvnClusterProj;   // ndc scale of view space xy over depth
+    uint lvnClusterData[]; // (offset, count) per cluster followed by the light indices
+};
+
+// cluster of a fragment from its view space position
+uint lvnLightClusterIndex(vec3 viewPos)
+{
+    float depth = max(-viewPos.z, lvnClusterDepth.x);
+    uint slice = uint(clamp(log(depth) * lvnClusterDepth.z + lvnClusterDepth.w, 0.0, float(lvnClusterGrid.z - 1u)));
+    vec2 ndc = viewPos.xy * lvnClusterProj.xy / depth;
+    uvec2 tile = uvec2(clamp((ndc * 0.5 + 0.5) * vec2(lvnClusterGrid.xy), vec2(0.0), vec2(lvnClusterGrid.xy) - 1.0));
+    return (slice * lvnClusterGrid.y + tile.y) * lvnClusterGrid.x + tile.x;
+}
+
+uint lvnLightClusterCount(uint cluster)
+{
+    return lvnClusterData[cluster * 2u + 1u];
+}
+
+// index into the light array of the application of the i'th light of the cluster
+uint lvnLightClusterLight(uint cluster, uint i)
+{
+    uint clusterCount = lvnClusterGrid.x * lvnClusterGrid.y * lvnClusterGrid.z;
+    return lvnClusterData[clusterCount * 2u + lvnClusterData[cluster * 2u] + i];
+}
+)";
+
+// lookup of the two layers of a shadow cache, casters write ndc depth so the comparison does not depend on the depth range of the backend
+static const char* s_ShadowCacheShaderSrc = R"(
+#ifndef LVN_SHADOW_STATIC_BINDING
+#define LVN_SHADOW_STATIC_BINDING 9
+#endif
+#ifndef LVN_SHADOW_DYNAMIC_BINDING
+#define LVN_SHADOW_DYNAMIC_BINDING 10
+#endif
+
+layout(binding = LVN_SHADOW_STATIC_BINDING) uniform sampler2D lvnShadowStatic;
+layout(binding = LVN_SHADOW_DYNAMIC_BINDING) uniform sampler2D lvnShadowDynamic;
+
+// color output of caster fragment shaders, lightClip is the light matrix times the world position passed from the vertex shader
+vec4 lvnShadowCasterDepth(vec4 lightClip)
+{
+    return vec4(lightClip.z / lightClip.w, 0.0, 0.0, 1.0);
+}
+
+// nearest caster of both layers
+float lvnShadowDepth(vec2 uv)
+{
+    return min(texture(lvnShadowStatic, uv).r, texture(lvnShadowDynamic, uv).r);
+}
+
+// 1 when lit and 0 when shadowed, fragments outside of the light frustum are lit
+float lvnShadowFactor(vec4 lightClip, float bias)
+{
+    vec3 ndc = lightClip.xyz / lightClip.w;
+    vec2 uv = ndc.xy * 0.5 + 0.5;
+    if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0))) || ndc.z > 1.0) { return 1.0; }
+    return ndc.z - bias > lvnShadowDepth(uv) ? 0.0 : 1.0;
+}
+
+// 3 x 3 percentage closer filtered lvnShadowFactor
+float lvnShadowFactorPcf(vec4 lightClip, float bias)
+{
+    vec3 ndc = lightClip.xyz / lightClip.w;
+    vec2 uv = ndc.xy * 0.5 + 0.5;
+    if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0))) || ndc.z > 1.0) { return 1.0; }
+
+    vec2 texel = 1.0 / vec2(textureSize(lvnShadowStatic, 0));
+    float lit = 0.0;
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+            lit += ndc.z - bias > lvnShadowDepth(uv + vec2(x, y) * texel) ? 0.0 : 1.0;
+    }
+    return lit / 9.0;
+}
+)";
+
+// declarations of the material table descriptor set, materialTableGetShaderSource defines LVN_MATERIAL_TABLE_MAX_TEXTURES before it
+// the material index comes from a push constant so the texture array is indexed with a dynamically uniform value on both backends
+static const char* s_MaterialTableShaderSrc = R"(
+#ifndef VULKAN
+#extension GL_ARB_bindless_texture : require
+#endif
+
+#ifndef LVN_MATERIAL_TABLE_SET
+#define LVN_MATERIAL_TABLE_SET 1
+#endif
+
+struct LvnMaterialGpu
+{
+    vec4 baseColorMetallic;  // base color factor and metallic factor
+    vec4 emissiveRoughness;  // emissive factor and roughness factor
+    uvec4 textures;          // albedo, metallic roughness occlusion, normal and emissive, 0 is the default white texture of materials without one
+};
+
+#ifdef VULKAN
+layout(std430, set = LVN_MATERIAL_TABLE_SET, binding = )" LVN_STRINGIFY(LVN_MATERIAL_TABLE_MATERIAL_BINDING) R"() readonly buffer LvnMaterials
+{
+    LvnMaterialGpu lvnMaterials[];
+};
+
+layout(set = LVN_MATERIAL_TABLE_SET, binding = )" LVN_STRINGIFY(LVN_MATERIAL_TABLE_TEXTURE_BINDING) R"() uniform sampler2D lvnMaterialTextures[LVN_MATERIAL_TABLE_MAX_TEXTURES];
+
+#ifndef LVN_MATERIAL_TABLE_NO_PUSH_CONSTANTS
+layout(push_constant) uniform LvnMaterialPushConstants
+{
+    uint lvnMaterialIndex;
+};
+#endif
+#else
+layout(std430, binding = )" LVN_STRINGIFY(LVN_MATERIAL_TABLE_MATERIAL_BINDING) R"() readonly buffer LvnMaterials
+{
+    LvnMaterialGpu lvnMaterials[];
+};
+
+// the opengl backend binds the texture handles of the array as a storage buffer
+layout(std430, binding = )" LVN_STRINGIFY(LVN_MATERIAL_TABLE_TEXTURE_BINDING) R"() readonly buffer LvnMaterialTextures
+{
+    sampler2D lvnMaterialTextures[];
+};
+
+#ifndef LVN_MATERIAL_TABLE_NO_PUSH_CONSTANTS
+layout(std140, binding = )" LVN_STRINGIFY(LVN_OPENGL_PUSH_CONSTANT_BINDING) R"() uniform LvnMaterialPushConstants
+{
+    uint lvnMaterialIndex;
+};
+#endif
+#endif
+
+// material of the primitive being drawn
+LvnMaterialGpu lvnMaterial()
+{
+    return lvnMaterials[lvnMaterialIndex];
+}
+
+vec4 lvnMaterialSample(uint textureIndex, vec2 uv)
+{
+    return texture(lvnMaterialTextures[textureIndex], uv);
+}
+)";
+
+
+namespace lvn
+{
+
+// memory allocation functions
+static void*   mallocWrapper(size_t size, void* userData)               { (void)userData; return malloc(size); }
+static void    freeWrapper(void* ptr, void* userData)                   { (void)userData; free(ptr); }
+static void*   reallocWrapper(void* ptr, size_t size, void* userData)   { (void)userData; return realloc(ptr, size); }
+static LvnMemAllocFunc    s_MemAllocFunc = mallocWrapper;
+static LvnMemFreeFunc     s_MemFreeFunc = freeWrapper;
+static LvnMemReallocFunc  s_MemReallocFunc = reallocWrapper;
+static void*              s_MemAllocUserData = nullptr;
+
+// memory tracking counters, allocations come from any thread so every counter is atomic
+struct LvnMemoryTracker
+{
+    std::atomic<uint64_t> bytes[Lvn_MemoryCategory_Max_Value];
+    std::atomic<uint64_t> peakBytes[Lvn_MemoryCategory_Max_Value];
+    std::atomic<uint64_t> allocationCount[Lvn_MemoryCategory_Max_Value];
+    std::atomic<uint64_t> totalAllocations[Lvn_MemoryCategory_Max_Value];
+    std::atomic<uint64_t> totalBytes;
+    std::atomic<uint64_t> peakTotalBytes;
+    std::atomic<uint64_t> frameAllocations, frameBytes;
+    std::atomic<uint64_t> lastFrameAllocations, lastFrameBytes;
+    std::atomic<LvnMemTrackFunc> trackFunc;
+    void* trackUserData;
+};
+
+static LvnMemoryTracker s_MemoryTracker;
+static thread_local LvnMemoryCategory s_MemoryCategory = Lvn_MemoryCategory_General;
+static thread_local uint32_t s_JobThreadIndex = 0; // 0 outside the job system, worker index + 1 on the workers
+static thread_local LvnLogTimeCache s_LogTimeCache;
+static thread_local LvnProfileThread* s_ProfileThread = nullptr;
+static thread_local uint64_t s_ProfileContextId = 0; // context the profile thread belongs to, a new context registers the thread again
+
+static constexpr uint32_t s_FontGlyphTableSize = 0x250; // direct indexed codepoints, basic latin through latin extended-b
+static constexpr int      s_FontSdfSpread = 8;          // pixels of distance encoded on each side of a glyph outline in sdf font atlases
+
+
+static LvnResult                    initLogging(LvnContextCreateInfo* createInfo);
+static void                         terminateLogging();
+static LvnVector<LvnLogPattern>     logParseFormat(const char* fmt);
+static void                         initLogThread(LvnContext* lvnctx, uint32_t capacity);
+static void                         terminateLogThread(LvnContext* lvnctx);
+static void*                        logThread(void* arg);
+static uint32_t                     logWriteRecords(LvnContext* lvnctx, LvnVector<char>& console, LvnVector<LvnLogFileBatch>& files);
+static const LvnLogTimeCache&       logGetTime(long long epochSecond);
+static const LvnLogTimeCache&       dateGetLocalTime();
+static bool                         logGetBuiltinPattern(char symbol, const LvnLogMessage* msg, const char** str);
+template <typename Buffer>
+static void                         logFormatPatterns(LvnLogger* logger, LvnLogMessage* msg, Buffer* console, Buffer* file);
+static void                         logPushRecord(LvnContext* lvnctx, const LvnLogRecord& record);
+static void                         logMessageArgs(LvnLogger* logger, LvnLogLevel level, const char* fmt, va_list args);
+static void                         logParseArgs(const char* fmt, LvnVector<LvnLogFormatSpec>* specs);
+static void                         logWriteVarint(LvnVector<uint8_t>& buffer, uint64_t value);
+static bool                         logReadVarint(const uint8_t* data, size_t size, size_t* offset, uint64_t* value);
+static bool                         logReadValue(const uint8_t* data, size_t size, size_t* offset, void* value, size_t valueSize);
+static uint32_t                     logBinaryFormatId(LvnLogBinaryFile* binfile, const char* fmt);
+static void                         logWriteBinaryName(LvnLogBinaryFile* binfile, const char* name);
+static void                         logWriteBinaryMessage(LvnLogBinaryFile* binfile, LvnLogLevel level, const char* fmt, va_list args);
+static void                         logWriteBinary(LvnLogBinaryFile* binfile, LvnLogLevel level, const char* fmt, ...);
+static void                         logFlushBinaryFile(LvnLogBinaryFile* binfile);
+static void                         logCloseBinaryFile(LvnContext* lvnctx, LvnLogger* logger);
+static bool                         logDecodeBinaryMessage(const LvnLogBinaryFormat& format, const uint8_t* data, size_t size, size_t* offset, LvnVector<char>* out);
+static void                         logAppendLiteral(LvnVector<char>* out, const char* str, size_t length);
+static void                         logOpenFile(LvnLogFile* logfile, const char* mode);
+static void                         logCloseFile(LvnLogFile* logfile);
+static void                         logWriteFile(LvnLogFile* logfile, const char* data, size_t size, LvnLogLevel level);
+static void                         logFlushFileBuffer(LvnLogFile* logfile);
+static bool                         logRotateFile(LvnLogFile* logfile);
+static void                         logTrackBufferedFile(LvnContext* lvnctx, LvnLogger* logger, bool buffered);
+static void                         logFlushFiles(LvnContext* lvnctx, bool expiredOnly);
+static const char*                  getLogLevelColor(LvnLogLevel level);
+static void                         initProfiling(LvnContext* lvnctx, LvnContextCreateInfo* createInfo);
+static void                         terminateProfiling(LvnContext* lvnctx);
+static LvnProfileThread*            profileGetThread(LvnContext* lvnctx);
+static void                         profileWriteJsonString(FILE* fileptr, const char* str);
+static const char*                  getLogLevelName(LvnLogLevel level);
+static const char*                  getWindowApiNameEnum(LvnWindowApi api);
+static const char*                  getGraphicsApiNameEnum(LvnGraphicsApi api);
+static LvnResult                    setWindowContext(LvnContext* lvnctx, LvnWindowApi windowapi);
+static void                         terminateWindowContext(LvnContext* lvnctx);
+static LvnResult                    setGraphicsContext(LvnContext* lvnctx, LvnGraphicsApi graphicsapi);
+static void                         terminateGraphicsContext(LvnContext* lvnctx);
+static LvnResult                    initAudioContext(LvnContext* lvnctx);
+static LvnResult                    initAudioDevice(LvnContext* lvnctx, ma_engine* pEngine);
+static void*                        initAudioThread(void* arg);
+static LvnResult                    requireAudioContext(LvnContext* lvnctx);
+static ma_engine*                   getAudioEngine(LvnContext* lvnctx);
+static LvnAudioDeviceInfo           getAudioDeviceInfo(const ma_device* pDevice);
+static void                         audioDeviceDataCallback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount);
+static void                         terminateAudioContext(LvnContext* lvnctx);
+static ma_result                    soundStreamRead(ma_data_source* pDataSource, void* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead);
+static ma_result                    soundStreamSeek(ma_data_source* pDataSource, ma_uint64 frameIndex);
+static ma_result                    soundStreamGetDataFormat(ma_data_source* pDataSource, ma_format* pFormat, ma_uint32* pChannels, ma_uint32* pSampleRate, ma_channel* pChannelMap, size_t channelMapCap);
+static ma_result                    soundStreamGetCursor(ma_data_source* pDataSource, ma_uint64* pCursor);
+static ma_result                    soundStreamGetLength(ma_data_source* pDataSource, ma_uint64* pLength);
+static void                         soundStreamRequestSeek(LvnSoundStream* stream, uint64_t frame);
+static void                         soundStreamService(LvnSoundStream* stream);
+static void*                        soundStreamThread(void* arg);
+static LvnResult                    createSoundObject(LvnSound** sound, const LvnSoundCreateInfo* createInfo, bool async, const char* funcName);
+static LvnSoundStream*              createSoundStream(LvnContext* lvnctx, LvnSound* sound, const LvnSoundCreateInfo* createInfo);
+static void                         destroySoundStream(LvnContext* lvnctx, LvnSoundStream* stream);
+static LvnVec3                      soundListenerOffset(const LvnSound* sound, const LvnVec3& listener);
+static bool                         soundOutOfRange(const LvnSound* sound, const LvnVec3& offset);
+static float                        soundAudibleGain(const LvnSound* sound, const LvnVec3& listener);
+static int                          compareSoundVoices(const void* a, const void* b);
+static void                         soundVirtualize(LvnSound* sound, uint64_t engineTime);
+static bool                         soundResumeVirtual(LvnSound* sound, uint64_t engineTime);
+static double                       soundGroupClampCutoff(float cutoff, uint32_t sampleRate);
+static void                         soundGroupAttachEffects(LvnSoundGroup* group);
+static LvnResult                    initNetworkingContext();
+static LvnResult                    requireNetworkingContext(LvnContext* lvnctx);
+static void                         terminateNetworkingContext(LvnContext* lvnctx);
+static ENetPacket*                  socketPreparePacket(LvnPacket* packet, LvnPacketFlagBits flags);
+static void                         socketSendPacket(LvnSocket* socket, uint32_t peerId, uint8_t channel, LvnPacket* packet, LvnPacketFlagBits flags);
+static bool                         socketSendEnetPacket(LvnSocket* socket, ENetPeer* peer, uint8_t channel, ENetPacket* packet);
+static void                         socketBroadcastEnetPacket(LvnSocket* socket, uint8_t channel, ENetPacket* packet);
+static ENetPeer*                    socketGetPeer(LvnSocket* socket, uint32_t peerId);
+static bool                         socketPushCommand(LvnSocket* socket, const LvnSocketCommand& command);
+static void                         socketRunCommand(LvnSocket* socket, const LvnSocketCommand& command);
+static LvnSocketQueuedEvent         socketTranslateEvent(LvnSocket* socket, const ENetEvent& event);
+static void                         socketDispatchEvent(const LvnSocketQueuedEvent& event, LvnSocketEventFunc func, void* userData);
+static void*                        socketNetworkThread(void* arg);
+static size_t ENET_CALLBACK         socketCompress(void* context, const ENetBuffer* inBuffers, size_t inBufferCount, size_t inLimit, enet_uint8* outData, size_t outLimit);
+static size_t ENET_CALLBACK         socketDecompress(void* context, const enet_uint8* inData, size_t inLimit, enet_uint8* outData, size_t outLimit);
+static void ENET_CALLBACK           socketDestroyCompressor(void* context);
+static uint32_t                     socketSimulationRandom(LvnSocket* socket);
+static bool                         socketSimulatesDelay(const LvnSocket* socket);
+static void                         socketDelayPacket(LvnSocket* socket, ENetPacket* packet, uint32_t peerId, uint8_t channel, bool broadcast);
+static void                         socketReleaseDelayedPackets(LvnSocket* socket);
+static int                          socketHostService(LvnSocket* socket, ENetEvent* event, uint32_t milliseconds);
+static int ENET_CALLBACK            socketIntercept(ENetHost* host, ENetEvent* event);
+static void                         initJobSystem(LvnContext* lvnctx);
+static void                         terminateJobSystem(LvnContext* lvnctx);
+static void*                        jobWorkerThread(void* arg);
+static void                         queueJob(LvnContext* lvnctx, const LvnJob& job);
+static bool                         runQueuedJob(LvnContext* lvnctx);
+static void                         runJob(LvnContext* lvnctx, const LvnJob& job);
+static void                         releaseWaitingJobs(LvnContext* lvnctx, LvnJobCounter* counter);
+static void                         parallelForJob(void* arg);
+static void                         initStandardPipelineSpecification(LvnContext* lvnctx);
+static void                         setDefaultStructTypeMemAllocInfos(LvnContext* lvnctx);
+static const char*                  getStructTypeEnumStr(LvnStructureType stype);
+static uint64_t                     getStructTypeSize(LvnStructureType sType);
+static LvnData<uint32_t>            initDefaultFontCodepoints();
+static bool                         fontRasterFaceInit(LvnFontRasterFace* rasterFace, const LvnFontRasterData* raster);
+static void                         fontRasterGlyphs(uint32_t start, uint32_t end, void* userData);
+static uint64_t                     hashFontCodepoints(const uint32_t* pCodepoints, uint32_t codepointCount);
+static bool                         readFontCache(const char* filepath, const LvnFontCacheHeader* key, LvnFont* font);
+static void                         writeFontCache(const char* filepath, const LvnFontCacheHeader* key, const LvnFont& font);
+static const LvnImageDecoder*       findImageDecoder(const uint8_t* data, uint64_t length);
+static bool                         decodeImageData(const uint8_t* data, uint64_t length, int forceChannels, bool flipVertically, LvnImageData* imageData);
+static void                         freeStbiImage(void* ptr, void* userData);
+static void                         unmapFile(void* ptr, void* userData);
+static void                         initIoService(LvnContext* lvnctx);
+static void                         terminateIoService(LvnContext* lvnctx);
+static void*                        ioThread(void* arg);
+static void                         submitIoRequest(LvnIoRequest&& request);
+static void                         runIoRequest(LvnIoRequest& request);
+static void                         writeFileStreamAsync(FILE* file, const char* data, size_t size);
+static void                         closeFileStreamAsync(FILE* file, LvnJobCounter* counter = nullptr);
+static LvnBin                       mapFile(const char* filepath);
+static LvnString                    vfsNormalizePath(const char* filepath);
+static uint64_t                     vfsHashPath(const char* path, size_t length);
+static int                          comparePackEntries(const void* a, const void* b);
+static const LvnPackEntry*          vfsFindEntry(LvnContext* lvnctx, const char* filepath, const LvnPack** pPack);
+static bool                         vfsReadFile(const char* filepath, LvnBin* data);
+static void                         vfsUnmountAll(LvnContext* lvnctx);
+static void                         swapMemory(uint8_t* a, uint8_t* b, size_t size);
+static void                         reversePixels8(uint8_t* row, uint32_t width);
+static void                         reversePixels32(uint32_t* row, uint32_t width);
+static void                         rotateBlock4x4(const uint32_t* src, size_t srcStride, uint32_t* dst, size_t dstStride, bool clockwise);
+static void                         rotatePixels32(const uint32_t* src, uint32_t* dst, uint32_t width, uint32_t height, bool clockwise);
+static void                         genNoiseHashes(uint32_t* hashes, uint32_t first, uint32_t count, uint32_t seed);
+static float                        imageFilterWeight(LvnImageFilter filter, float x);
+static void                         imageGetResampleWeights(LvnImageResampleWeights* weights, uint32_t srcSize, uint32_t dstSize, LvnImageFilter filter);
+static void                         imageToLinearRows(uint32_t start, uint32_t end, void* userData);
+static void                         imageFromLinearRows(uint32_t start, uint32_t end, void* userData);
+static void                         imageResampleHorizontalRows(uint32_t start, uint32_t end, void* userData);
+static void                         imageResampleVerticalRows(uint32_t start, uint32_t end, void* userData);
+static void                         imageResampleColumnsDefault(const float* src, size_t stride, const float* weights, uint32_t taps, float* dst, size_t count);
+static void                         imageResampleLinear(const float* src, uint32_t srcWidth, uint32_t srcHeight, float* dst, uint32_t dstWidth, uint32_t dstHeight, uint32_t channels, LvnImageFilter filter);
+static void                         imageToLinear(const LvnImageData& imageData, float* linear, bool srgb);
+static void                         imageFromLinear(LvnImageData& imageData, float* linear, bool srgb);
+#if defined(LVN_SIMD_AVX2_DISPATCH)
+static bool                         cpuSupportsAvx2();
+#endif
+static uint64_t                     alignObjectOffset(uint64_t offset);
+static void*                        mapHugePages(size_t size, size_t* mapSize);
+#ifdef LVN_MEMORY_TRACKING
+static void                         trackMemoryAlloc(void* ptr, size_t size, LvnMemoryCategory category);
+static void                         trackMemoryFree(void* ptr, size_t size, LvnMemoryCategory category);
+#endif
+static void                         unmapHugePages(void* ptr, size_t mapSize);
+static LvnResult                    createContextMemoryPool(LvnContext* lvnctx, LvnContextCreateInfo* createInfo);
+static void                         loadMemoryPoolConfig(LvnContext* lvnctx, const char* filepath);
+static void                         createMemoryBlock(LvnContext* lvnctx, LvnStructureType sType);
+static void*                        takeObjectSlot(LvnContext* lvnctx, LvnStructureType sType);
+static void                         releaseObjectSlot(LvnContext* lvnctx, LvnStructureType sType, void* slot);
+static void                         flushObjectCache(LvnContext* lvnctx, LvnObjectCache* cache);
+static void                         trimMemoryPool(LvnContext* lvnctx, LvnStructureType sType);
+static uint32_t                     getTextureCompressionChannels(LvnTextureCompression compression);
+static LvnImageData                 parseImageDataKtx2(const uint8_t* data, uint64_t length, LvnVector<LvnImageData>* pMipLevels);
+static LvnImageData                 parseImageDataDds(const uint8_t* data, uint64_t length, LvnVector<LvnImageData>* pMipLevels);
+static bool                         isCompressedImageFile(const uint8_t* data, uint64_t length);
+static LvnImageData                 imageHalfSize(const LvnImageData& imageData);
+static void                         textureStreamDecodeJob(void* userData);
+static uint64_t                     textureStreamLevelSize(const LvnTextureStream* stream, LvnTextureStreamLevel level);
+static LvnResult                    textureStreamUpload(LvnTextureStream* stream, LvnTextureStreamLevel level);
+static const void*                  getHdrImageRgbaPixels(const LvnImageHdrData& hdr, LvnVector<float>* pixels);
+static void                         setEnvironmentMapShaderSrcs(LvnEnvironmentMapBakeInfo* bakeInfo, LvnString* srcs);
+static uint16_t                     floatToHalf(float value);
+static LvnVec2                      octahedralEncode(const LvnVec3& v);
+static uint32_t                     packSnorm2101010(float x, float y, float z, float w);
+static uint64_t                     hashHdrImageData(const LvnImageHdrData& hdr);
+static bool                         readEnvironmentMapCache(const char* filepath, const LvnEnvironmentMapBakeInfo* bakeInfo, uint64_t hdrHash, LvnVector<uint8_t>* data);
+static void                         writeEnvironmentMapCache(const char* filepath, const LvnEnvironmentMapBakeInfo* bakeInfo, uint64_t hdrHash, const LvnVector<uint8_t>& data);
+static uint32_t                     floatToRgb9e5(float r, float g, float b);
+static void                         convertHdrImageRows(uint32_t start, uint32_t end, void* userData);
+static uint64_t                     hashFileContents(const uint8_t* data, uint64_t size);
+static bool                         readHdrImageCache(const char* filepath, LvnHdrImageFormat format, bool flipVertically, uint64_t sourceHash, LvnImageHdrData* imageData);
+static void                         writeHdrImageCache(const char* filepath, const LvnImageHdrData& imageData, bool flipVertically, uint64_t sourceHash);
+static void                         loadHdrImageDataJob(void* userData);
+static void                         dynamicFontResetPage(LvnDynamicFont* font, LvnDynamicFontPage& page);
+static void                         textureAtlasBlitImage(LvnTextureAtlas* atlas, LvnTextureAtlasPage& page, const LvnImageData& imageData, uint32_t x, uint32_t y);
+static bool                         renderGraphFrameBuffersCompatible(const LvnRenderGraphResourceData& a, const LvnRenderGraphResourceData& b);
+static bool                         renderGraphPassUsesResource(const LvnRenderGraphPass& pass, LvnRenderGraphResource resource);
+static void                         renderGraphReleaseFrameBuffers(LvnRenderGraph* renderGraph);
+static void                         frameBufferUpdateRenderSize(LvnFrameBuffer* frameBuffer);
+static bool                         skylinePackRect(LvnVector<LvnSkylineNode>& skyline, uint32_t pageWidth, uint32_t pageHeight, uint32_t width, uint32_t height, uint32_t* x, uint32_t* y);
+static LvnResult                    checkPipelineCreateInfo(const LvnPipelineCreateInfo* createInfo);
+static void*                        pipelineCompileThread(void* arg);
+static void                         waitPipelineCompile(LvnPipeline* pipeline);
+static void                         copyPipelineCreateInfo(LvnPipelineCompileJob* job, const LvnPipelineCreateInfo* createInfo);
+static uint64_t                     getFileModifiedTime(const char* filepath);
+static LvnString                    getFileDirectory(const char* filepath);
+static void                         hotReloadWatchDirectory(LvnContext* lvnctx, const LvnString& directory);
+static void                         hotReloadPollDirectories(LvnHotReloadWatcher* watcher);
+static void                         hotReloadAddFile(LvnContext* lvnctx, const char* filepath, LvnFileChangedFunc func, void* userData, const void* object);
+static void                         hotReloadRemoveObject(LvnContext* lvnctx, const void* object);
+static void                         hotReloadTerminate(LvnContext* lvnctx);
+static void                         hotReloadTrackShader(LvnContext* lvnctx, LvnShader* shader, const LvnShaderCreateInfo* createInfo, bool binary);
+static void                         hotReloadTrackPipeline(LvnContext* lvnctx, LvnPipeline* pipeline, const LvnPipelineCreateInfo* createInfo);
+static void                         hotReloadTrackComputePipeline(LvnContext* lvnctx, LvnPipeline* pipeline, const LvnComputePipelineCreateInfo* createInfo);
+static bool                         hotReloadIsShaderTracked(LvnContext* lvnctx, const LvnShader* shader);
+static void                         hotReloadSwapPipeline(LvnPipeline* a, LvnPipeline* b);
+static void                         hotReloadShaderFile(const char* filepath, void* userData);
+static void                         hotReloadTextureFile(const char* filepath, void* userData);
+static void                         hotReloadModelFile(const char* filepath, void* userData);
+static LvnPipeline*                 getBindablePipeline(LvnPipeline* pipeline);
+static void                         appendPipelineKey(LvnVector<uint8_t>* key, const void* data, uint64_t size);
+static void                         appendPipelineSpecificationKey(LvnVector<uint8_t>* key, const LvnPipelineSpecification* spec);
+static uint64_t                     hashPipelineKey(const LvnVector<uint8_t>& key);
+static LvnPipeline*                 findCachedPipeline(LvnContext* lvnctx, uint64_t hash, const LvnVector<uint8_t>& key);
+static void                         cachePipeline(LvnContext* lvnctx, LvnPipeline* pipeline, uint64_t hash, LvnVector<uint8_t>& key, LvnVector<const void*>& objects);
+static void                         purgePipelineCache(LvnContext* lvnctx, const void* object);
+static void                         frameStatsAdd(LvnContext* lvnctx, LvnFrameStat stat, uint64_t count);
+static void                         frameStatsCountDraw(LvnContext* lvnctx, uint64_t vertexCount, uint32_t instanceCount);
+static void                         frameStatsCountIndirect(LvnContext* lvnctx, uint32_t drawCount);
+static void                         frameStatsNextFrame(LvnContext* lvnctx);
+static void                         replayCmdDraw(void* data);
+static void                         replayCmdDrawIndexed(void* data);
+static void                         replayCmdDrawInstanced(void* data);
+static void                         replayCmdDrawIndexedInstanced(void* data);
+static void                         replayCmdDrawIndirect(void* data);
+static void                         replayCmdDrawIndexedIndirect(void* data);
+static void                         replayCmdDrawIndexedIndirectCount(void* data);
+static void                         replayCmdSetCullMode(void* data);
+static void                         replayCmdSetFrontFace(void* data);
+static void                         replayCmdSetPrimitiveTopology(void* data);
+static void                         replayCmdSetDepthTest(void* data);
+static void                         replayCmdSetBlendEnable(void* data);
+static void                         replayCmdSetScissor(void* data);
+static void                         replayCmdBeginRenderPass(void* data);
+static void                         replayCmdEndRenderPass(void* data);
+static void                         replayCmdBindPipeline(void* data);
+static void                         replayCmdBindVertexBuffer(void* data);
+static void                         replayCmdBindIndexBuffer(void* data);
+static void                         replayCmdBindDescriptorSets(void* data);
+static void                         replayCmdDispatch(void* data);
+static void                         replayCmdMemoryBarrier(void* data);
+static void                         replayCmdBeginTimestamp(void* data);
+static void                         replayCmdEndTimestamp(void* data);
+static void                         replayCmdPushConstants(void* data);
+static void                         replayCmdBeginFrameBuffer(void* data);
+static void                         replayCmdEndFrameBuffer(void* data);
+static void                         replayCmdReadbackFrameBuffer(void* data);
+static void                         writeFrameCapture(const LvnReadbackData* readback, void* userData);
+static void                         replayCmdExecuteCommandList(void* data);
+
+template <typename T>
+static T* createObject(LvnContext* lvnctx, LvnStructureType sType);
+
+template <typename T>
+static void destroyObject(LvnContext* lvnctx, T* obj, LvnStructureType sType);
+
+template <typename T>
+static T* allocateCommandListCmd(LvnWindow* window, void (*callFunc)(void*), uint64_t payloadSize);
+
+template <typename T>
+static void appendPipelineKey(LvnVector<uint8_t>* key, const T& value);
+
+template <typename T>
+static void logWriteValue(LvnVector<uint8_t>& buffer, const T& value);
+
+template <typename T>
+static void logAppendFormatted(LvnVector<char>* out, const char* spec, T value);
+
+
+// Windows platform specific; enables console output colors
+#ifdef LVN_PLATFORM_WINDOWS
+static void enableLogANSIcodeColors()
+{
+    DWORD consoleMode;
+    HANDLE outputHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (GetConsoleMode(outputHandle, &consoleMode))
+    {
+        SetConsoleMode(outputHandle, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+}
+#endif
+
+static const char* getLogLevelColor(LvnLogLevel level)
+{
+    switch (level)
+    {
+        case Lvn_LogLevel_None:     { return LVN_LOG_COLOR_RESET; }
+        case Lvn_LogLevel_Trace:    { return LVN_LOG_COLOR_TRACE; }
+        case Lvn_LogLevel_Debug:    { return LVN_LOG_COLOR_DEBUG; }
+        case Lvn_LogLevel_Info:     { return LVN_LOG_COLOR_INFO; }
+        case Lvn_LogLevel_Warn:     { return LVN_LOG_COLOR_WARN; }
+        case Lvn_LogLevel_Error:    { return LVN_LOG_COLOR_ERROR; }
+        case Lvn_LogLevel_Fatal:    { return LVN_LOG_COLOR_FATAL; }
+    }
+
+    return nullptr;
+}
+
+static const char* getLogLevelName(LvnLogLevel level)
+{
+    switch (level)
+    {
+        case Lvn_LogLevel_None:     { return "none"; }
+        case Lvn_LogLevel_Trace:    { return "trace"; }
+        case Lvn_LogLevel_Debug:    { return "debug"; }
+        case Lvn_LogLevel_Info:     { return "info"; }
+        case Lvn_LogLevel_Warn:     { return "warn"; }
+        case Lvn_LogLevel_Error:    { return "error"; }
+        case Lvn_LogLevel_Fatal:    { return "fatal"; }
+    }
+
+    return nullptr;
+}
+
+static const char* getWindowApiNameEnum(LvnWindowApi api)
+{
+    switch (api)
+    {
+        case Lvn_WindowApi_None:  { return "None";  }
+        case Lvn_WindowApi_glfw:  { return "glfw";  }
+        // case Lvn_WindowApi_win32: { return "win32"; }
+    }
+
+    return LVN_EMPTY_STR;
+}
+
+static const char* getGraphicsApiNameEnum(LvnGraphicsApi api)
+{
+    switch (api)
+    {
+        case Lvn_GraphicsApi_None:   { return "None";   }
+        case Lvn_GraphicsApi_vulkan: { return "vulkan"; }
+        case Lvn_GraphicsApi_opengl: { return "opengl"; }
+    }
+
+    return LVN_EMPTY_STR;
+}
+
+static LvnResult setWindowContext(LvnContext* lvnctx, LvnWindowApi windowapi)
+{
+    LvnResult result = Lvn_Result_Failure;
     switch (windowapi)
     {
         case Lvn_WindowApi_None:
@@ -304,26 +1479,179 @@ static LvnResult initAudioContext(LvnContext* lvnctx)
 {
     ma_engine* pEngine = (ma_engine*)LVN_MALLOC(sizeof(ma_engine));
 
-    if (ma_engine_init(nullptr, pEngine) != MA_SUCCESS)
+    // the device is created here instead of by the engine so the backend, share mode and period count can be chosen
+    if (lvn::initAudioDevice(lvnctx, pEngine) != Lvn_Result_Success)
+    {
+        lvn::memFree(pEngine);
+        return Lvn_Result_Failure;
+    }
+
+    ma_engine_config engineConfig = ma_engine_config_init();
+    engineConfig.pDevice = static_cast<ma_device*>(lvnctx->audioDevicePtr);
+
+    if (ma_engine_init(&engineConfig, pEngine) != MA_SUCCESS)
     {
+        ma_device_uninit(static_cast<ma_device*>(lvnctx->audioDevicePtr));
+        ma_context_uninit(static_cast<ma_context*>(lvnctx->audioDeviceContextPtr));
+        lvn::memFree(lvnctx->audioDevicePtr);
+        lvn::memFree(lvnctx->audioDeviceContextPtr);
+        lvnctx->audioDevicePtr = nullptr;
+        lvnctx->audioDeviceContextPtr = nullptr;
+        lvn::memFree(pEngine);
         LVN_CORE_ERROR("failed to initialize audio engine context");
         return Lvn_Result_Failure;
     }
 
     lvnctx->audioEngineContextPtr = pEngine;
 
-    LVN_CORE_TRACE("audio context initialized");
+    [[maybe_unused]] LvnAudioDeviceInfo deviceInfo = lvn::getAudioDeviceInfo(static_cast<const ma_device*>(lvnctx->audioDevicePtr));
+    LVN_CORE_TRACE("audio context initialized, backend: %s, sample rate: %u, channels: %u, period: %u frames x %u, latency: %.2fms%s",
+        deviceInfo.backendName, deviceInfo.sampleRate, deviceInfo.channels, deviceInfo.periodSizeInFrames, deviceInfo.periods, deviceInfo.latencyMilliseconds, deviceInfo.exclusive ? " (exclusive)" : "");
     return Lvn_Result_Success;
 }
 
-static void terminateAudioContext(LvnContext* lvnctx)
+static LvnResult initAudioDevice(LvnContext* lvnctx, ma_engine* pEngine)
 {
-    if (lvnctx->audioEngineContextPtr != nullptr)
+    ma_context* pContext = (ma_context*)LVN_MALLOC(sizeof(ma_context));
+    ma_device* pDevice = (ma_device*)LVN_MALLOC(sizeof(ma_device));
+
+    // a preferred backend is tried first, the remaining backends are still tried in their default order if it is unavailable
+    ma_backend backends[MA_BACKEND_COUNT];
+    uint32_t backendCount = 0;
+    if (lvnctx->audioConfig.backend != Lvn_AudioBackend_Default)
     {
-        ma_engine_uninit(static_cast<ma_engine*>(lvnctx->audioEngineContextPtr));
+        backends[backendCount++] = static_cast<ma_backend>(lvnctx->audioConfig.backend - 1);
+        for (uint32_t i = 0; i < MA_BACKEND_COUNT; i++)
+        {
+            if (static_cast<ma_backend>(i) != backends[0])
+                backends[backendCount++] = static_cast<ma_backend>(i);
+        }
+    }
+
+    if (ma_context_init(backendCount != 0 ? backends : NULL, backendCount, NULL, pContext) != MA_SUCCESS)
+    {
+        lvn::memFree(pDevice);
+        lvn::memFree(pContext);
+        LVN_CORE_ERROR("failed to initialize audio device context");
+        return Lvn_Result_Failure;
+    }
+
+    ma_device_config deviceConfig = ma_device_config_init(ma_device_type_playback);
+    deviceConfig.playback.format = ma_format_f32;
+    deviceConfig.playback.channels = lvnctx->audioConfig.channels;
+    deviceConfig.playback.shareMode = lvnctx->audioConfig.exclusiveMode ? ma_share_mode_exclusive : ma_share_mode_shared;
+    deviceConfig.sampleRate = lvnctx->audioConfig.sampleRate;
+    deviceConfig.periodSizeInFrames = lvnctx->audioConfig.periodSizeInFrames;
+    deviceConfig.periods = lvnctx->audioConfig.periods;
+    deviceConfig.performanceProfile = ma_performance_profile_low_latency;
+    deviceConfig.noFixedSizedCallback = lvnctx->audioConfig.noFixedSizedCallback;
+    deviceConfig.noPreSilencedOutputBuffer = MA_TRUE; // the engine writes every frame and clips itself
+    deviceConfig.noClip = MA_TRUE;
+    deviceConfig.dataCallback = lvn::audioDeviceDataCallback;
+    deviceConfig.pUserData = pEngine;
+
+    ma_result result = ma_device_init(pContext, &deviceConfig, pDevice);
+    if (result != MA_SUCCESS && lvnctx->audioConfig.exclusiveMode)
+    {
+        LVN_CORE_WARN("audio device could not be opened in exclusive mode, falling back to shared mode");
+        deviceConfig.playback.shareMode = ma_share_mode_shared;
+        result = ma_device_init(pContext, &deviceConfig, pDevice);
+    }
+
+    if (result != MA_SUCCESS)
+    {
+        ma_context_uninit(pContext);
+        lvn::memFree(pDevice);
+        lvn::memFree(pContext);
+        LVN_CORE_ERROR("failed to initialize audio device");
+        return Lvn_Result_Failure;
+    }
+
+    lvnctx->audioDeviceContextPtr = pContext;
+    lvnctx->audioDevicePtr = pDevice;
+    return Lvn_Result_Success;
+}
+
+static void* initAudioThread(void* arg)
+{
+    lvn::requireAudioContext(static_cast<LvnContext*>(arg));
+    return nullptr;
+}
+
+// audio created with Lvn_SubsystemInit_FirstUse is brought up by whichever thread needs it first, later calls only return the stored result
+static LvnResult requireAudioContext(LvnContext* lvnctx)
+{
+    if (lvnctx->audioInit == Lvn_SubsystemInit_Disabled)
+    {
+        LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_ERROR, "audio is disabled by the context create info (audio.init), audio functions do nothing");
+        return Lvn_Result_Failure;
+    }
+
+    std::call_once(lvnctx->audioInitFlag, [lvnctx]() { lvnctx->audioInitResult = lvn::initAudioContext(lvnctx); });
+    return lvnctx->audioInitResult;
+}
+
+static ma_engine* getAudioEngine(LvnContext* lvnctx)
+{
+    if (lvn::requireAudioContext(lvnctx) != Lvn_Result_Success)
+        return nullptr;
+
+    return static_cast<ma_engine*>(lvnctx->audioEngineContextPtr);
+}
+
+static LvnAudioDeviceInfo getAudioDeviceInfo(const ma_device* pDevice)
+{
+    LvnAudioDeviceInfo info{};
+    info.backendName = ma_get_backend_name(pDevice->pContext->backend);
+    info.sampleRate = pDevice->playback.internalSampleRate;
+    info.channels = pDevice->playback.internalChannels;
+    info.periodSizeInFrames = pDevice->playback.internalPeriodSizeInFrames;
+    info.periods = pDevice->playback.internalPeriods;
+    info.exclusive = pDevice->playback.shareMode == ma_share_mode_exclusive;
+
+    // the whole device buffer is queued ahead of the speaker, the backend may add its own latency on top
+    info.latencyMilliseconds = info.sampleRate != 0 ? static_cast<float>(info.periodSizeInFrames) * info.periods * 1000.0f / info.sampleRate : 0.0f;
+
+    return info;
+}
+
+static void audioDeviceDataCallback(ma_device* pDevice, void* pOutput, const void*, ma_uint32 frameCount)
+{
+    ma_engine_read_pcm_frames(static_cast<ma_engine*>(pDevice->pUserData), pOutput, frameCount, NULL);
+}
+
+static void terminateAudioContext(LvnContext* lvnctx)
+{
+    if (lvnctx->soundStreamThread != nullptr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(lvnctx->soundStreamMutex);
+            lvnctx->soundStreamStop = true;
+        }
+        lvnctx->soundStreamCondition.notify_all();
+
+        delete lvnctx->soundStreamThread;
+        lvnctx->soundStreamThread = nullptr;
+    }
+    lvnctx->soundStreams.clear_free();
+    lvnctx->sounds.clear_free();
+    lvnctx->soundVoices.clear_free();
+
+    // the engine stops the device, it is freed after the engine since the engine did not create it
+    if (lvnctx->audioEngineContextPtr != nullptr)
+    {
+        ma_engine_uninit(static_cast<ma_engine*>(lvnctx->audioEngineContextPtr));
         lvn::memFree(lvnctx->audioEngineContextPtr);
     }
 
+    if (lvnctx->audioDevicePtr != nullptr)
+    {
+        ma_device_uninit(static_cast<ma_device*>(lvnctx->audioDevicePtr));
+        ma_context_uninit(static_cast<ma_context*>(lvnctx->audioDeviceContextPtr));
+        lvn::memFree(lvnctx->audioDevicePtr);
+        lvn::memFree(lvnctx->audioDeviceContextPtr);
+    }
+
     LVN_CORE_TRACE("audio context terminated");
 }
 
@@ -339,12 +1667,425 @@ static LvnResult initNetworkingContext()
     return Lvn_Result_Success;
 }
 
-static void terminateNetworkingContext()
+// networking created with Lvn_SubsystemInit_FirstUse is brought up by the first socket
+static LvnResult requireNetworkingContext(LvnContext* lvnctx)
+{
+    if (lvnctx->networkingInit == Lvn_SubsystemInit_Disabled)
+    {
+        LVN_CORE_ERROR("networking is disabled by the context create info (networking.init), sockets cannot be created");
+        return Lvn_Result_Failure;
+    }
+
+    std::call_once(lvnctx->networkingInitFlag, [lvnctx]() { lvnctx->networkingInitResult = lvn::initNetworkingContext(); });
+    return lvnctx->networkingInitResult;
+}
+
+static void terminateNetworkingContext(LvnContext* lvnctx)
 {
+    if (lvnctx->networkingInitResult != Lvn_Result_Success) { return; }
+
     enet_deinitialize();
     LVN_CORE_TRACE("networking context terminated");
 }
 
+static ENetPacket* socketPreparePacket(LvnPacket* packet, LvnPacketFlagBits flags)
+{
+    // the packet flags match the enet flags, other enet flags are masked out since they describe how the packet data is owned
+    const enet_uint32 flagMask = ENET_PACKET_FLAG_RELIABLE | ENET_PACKET_FLAG_UNSEQUENCED | ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
+
+    ENetPacket* enetPacket = static_cast<ENetPacket*>(packet->handle);
+
+    // owned packets are handed to enet as they are, the payload is not copied again
+    if (enetPacket != nullptr)
+    {
+        enetPacket->flags = (enetPacket->flags & ~flagMask) | (flags & flagMask);
+        if (packet->size < enetPacket->dataLength)
+            enet_packet_resize(enetPacket, packet->size);
+        return enetPacket;
+    }
+
+    return enet_packet_create(packet->data, packet->size, flags & flagMask);
+}
+
+static void socketSendPacket(LvnSocket* socket, uint32_t peerId, uint8_t channel, LvnPacket* packet, LvnPacketFlagBits flags)
+{
+    ENetPacket* enetPacket = lvn::socketPreparePacket(packet, flags);
+
+    if (socket->networkThread != nullptr)
+    {
+        LvnSocketCommand command{};
+        command.type = Lvn_SocketCommand_Send;
+        command.packet = enetPacket;
+        command.peerId = peerId;
+        command.channel = channel;
+
+        // the network thread takes the packet even when it fails to send it later
+        lvn::socketPushCommand(socket, command);
+    }
+    else if (lvn::socketSimulatesDelay(socket))
+    {
+        lvn::socketDelayPacket(socket, enetPacket, peerId, channel, false);
+    }
+    else if (!lvn::socketSendEnetPacket(socket, lvn::socketGetPeer(socket, peerId), channel, enetPacket))
+    {
+        // an owned packet stays with the caller so it can be sent again or released
+        if (packet->handle == nullptr)
+            enet_packet_destroy(enetPacket);
+        return;
+    }
+    else if (!socket->batchSends)
+    {
+        // batched packets wait in the peer queues and are combined into datagrams by the next flush or service
+        enet_host_flush(socket->socket);
+    }
+
+    // enet now owns the packet and destroys it once it has been sent
+    if (packet->handle != nullptr)
+    {
+        packet->handle = nullptr;
+        packet->data = nullptr;
+        packet->size = 0;
+    }
+}
+
+static bool socketSendEnetPacket(LvnSocket* socket, ENetPeer* peer, uint8_t channel, ENetPacket* packet)
+{
+    const size_t packetSize = packet->dataLength;
+
+    if (peer == nullptr || enet_peer_send(peer, channel, packet) < 0)
+    {
+        LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_ERROR, "failed to send packet through socket (%p)", socket);
+        return false;
+    }
+
+    LvnSocketPeerStats& stats = socket->peerStats[peer - socket->socket->peers];
+    stats.bytesSent += packetSize;
+    stats.packetsSent++;
+    return true;
+}
+
+static void socketBroadcastEnetPacket(LvnSocket* socket, uint8_t channel, ENetPacket* packet)
+{
+    const size_t packetSize = packet->dataLength;
+
+    for (size_t i = 0; i < socket->socket->peerCount; i++)
+    {
+        if (socket->socket->peers[i].state != ENET_PEER_STATE_CONNECTED)
+            continue;
+
+        socket->peerStats[i].bytesSent += packetSize;
+        socket->peerStats[i].packetsSent++;
+    }
+
+    // every connected peer queues a reference to the same packet, enet destroys it after the last peer has sent it
+    enet_host_broadcast(socket->socket, channel, packet);
+}
+
+static ENetPeer* socketGetPeer(LvnSocket* socket, uint32_t peerId)
+{
+    if (peerId == LVN_SOCKET_CONNECTION_PEER)
+        return socket->connection;
+
+    return peerId < socket->socket->peerCount ? &socket->socket->peers[peerId] : nullptr;
+}
+
+static bool socketPushCommand(LvnSocket* socket, const LvnSocketCommand& command)
+{
+    if (socket->commands->try_push(command))
+        return true;
+
+    LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_WARN, "network command queue of socket (%p) is full, command dropped", socket);
+    if (command.packet != nullptr)
+        enet_packet_destroy(command.packet);
+    return false;
+}
+
+static void socketRunCommand(LvnSocket* socket, const LvnSocketCommand& command)
+{
+    switch (command.type)
+    {
+        case Lvn_SocketCommand_Send:
+        {
+            if (lvn::socketSimulatesDelay(socket))
+                lvn::socketDelayPacket(socket, command.packet, command.peerId, command.channel, false);
+            else if (!lvn::socketSendEnetPacket(socket, lvn::socketGetPeer(socket, command.peerId), command.channel, command.packet))
+                enet_packet_destroy(command.packet);
+            break;
+        }
+        case Lvn_SocketCommand_Broadcast:
+        {
+            if (lvn::socketSimulatesDelay(socket))
+                lvn::socketDelayPacket(socket, command.packet, 0, command.channel, true);
+            else
+                lvn::socketBroadcastEnetPacket(socket, command.channel, command.packet);
+            break;
+        }
+        case Lvn_SocketCommand_Connect:
+        {
+            ENetAddress enetAddress;
+            enetAddress.host = command.address.host;
+            enetAddress.port = command.address.port;
+
+            // the connect event is queued for socketService once the server answers
+            socket->connection = enet_host_connect(socket->socket, &enetAddress, command.channelCount, 0);
+            if (socket->connection == nullptr)
+                LVN_CORE_ERROR("no available peers for initiating a connection on socket (%p)", socket);
+            break;
+        }
+        case Lvn_SocketCommand_Disconnect:
+        {
+            if (socket->connection != nullptr)
+                enet_peer_disconnect(socket->connection, 0);
+            break;
+        }
+        case Lvn_SocketCommand_DisconnectPeer:
+        {
+            ENetPeer* peer = lvn::socketGetPeer(socket, command.peerId);
+            if (peer != nullptr)
+                enet_peer_disconnect(peer, 0);
+            break;
+        }
+    }
+}
+
+static LvnSocketQueuedEvent socketTranslateEvent(LvnSocket* socket, const ENetEvent& event)
+{
+    LvnSocketQueuedEvent queuedEvent{};
+    queuedEvent.peerId = static_cast<uint32_t>(event.peer - socket->socket->peers);
+    queuedEvent.channel = event.channelID;
+    queuedEvent.data = event.data;
+
+    switch (event.type)
+    {
+        case ENET_EVENT_TYPE_CONNECT:
+        {
+            socket->peerStats[queuedEvent.peerId] = LvnSocketPeerStats{};
+            queuedEvent.type = Lvn_SocketEvent_Connect;
+            break;
+        }
+        case ENET_EVENT_TYPE_DISCONNECT:
+        {
+            queuedEvent.type = Lvn_SocketEvent_Disconnect;
+            break;
+        }
+        case ENET_EVENT_TYPE_RECEIVE:
+        {
+            LvnSocketPeerStats& stats = socket->peerStats[queuedEvent.peerId];
+            stats.bytesReceived += event.packet->dataLength;
+            stats.packetsReceived++;
+
+            queuedEvent.type = Lvn_SocketEvent_Receive;
+            queuedEvent.packet = event.packet;
+            break;
+        }
+
+        default:
+        {
+            queuedEvent.type = Lvn_SocketEvent_None;
+            break;
+        }
+    }
+
+    return queuedEvent;
+}
+
+static void socketDispatchEvent(const LvnSocketQueuedEvent& event, LvnSocketEventFunc func, void* userData)
+{
+    LvnSocketEvent socketEvent{};
+    socketEvent.type = event.type;
+    socketEvent.peerId = event.peerId;
+    socketEvent.channel = event.channel;
+    socketEvent.data = event.data;
+
+    if (event.packet != nullptr)
+    {
+        socketEvent.packet.data = event.packet->data;
+        socketEvent.packet.size = event.packet->dataLength;
+    }
+
+    if (event.type != Lvn_SocketEvent_None)
+        func(&socketEvent, userData);
+
+    if (event.packet != nullptr)
+        enet_packet_destroy(event.packet);
+}
+
+static size_t ENET_CALLBACK socketCompress(void* context, const ENetBuffer* inBuffers, size_t inBufferCount, size_t inLimit, enet_uint8* outData, size_t outLimit)
+{
+    LvnSocket* socket = static_cast<LvnSocket*>(context);
+
+    // returning zero sends the datagram uncompressed
+    if (inLimit < socket->compressionThreshold)
+        return 0;
+
+    if (socket->compression == Lvn_SocketCompression_RangeCoder)
+        return enet_range_coder_compress(socket->rangeCoder, inBuffers, inBufferCount, inLimit, outData, outLimit);
+
+    socket->compressBuffer.clear();
+    for (size_t i = 0; i < inBufferCount; i++)
+        socket->compressBuffer.insert_index(socket->compressBuffer.size(), static_cast<const uint8_t*>(inBuffers[i].data), inBuffers[i].dataLength);
+
+    int compressedSize = 0;
+    unsigned char* compressed = stbi_zlib_compress(socket->compressBuffer.data(), static_cast<int>(socket->compressBuffer.size()), &compressedSize, 8);
+    if (compressed == nullptr)
+        return 0;
+
+    size_t size = 0;
+    if (static_cast<size_t>(compressedSize) <= outLimit)
+    {
+        memcpy(outData, compressed, compressedSize);
+        size = compressedSize;
+    }
+
+    lvn::memFree(compressed);
+    return size;
+}
+
+static size_t ENET_CALLBACK socketDecompress(void* context, const enet_uint8* inData, size_t inLimit, enet_uint8* outData, size_t outLimit)
+{
+    LvnSocket* socket = static_cast<LvnSocket*>(context);
+
+    if (socket->compression == Lvn_SocketCompression_RangeCoder)
+        return enet_range_coder_decompress(socket->rangeCoder, inData, inLimit, outData, outLimit);
+
+    // a negative size from corrupt or oversized data drops the datagram
+    int size = stbi_zlib_decode_buffer(reinterpret_cast<char*>(outData), static_cast<int>(outLimit), reinterpret_cast<const char*>(inData), static_cast<int>(inLimit));
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+static void ENET_CALLBACK socketDestroyCompressor(void* context)
+{
+    LvnSocket* socket = static_cast<LvnSocket*>(context);
+
+    if (socket->rangeCoder != nullptr)
+    {
+        enet_range_coder_destroy(socket->rangeCoder);
+        socket->rangeCoder = nullptr;
+    }
+}
+
+static uint32_t socketSimulationRandom(LvnSocket* socket)
+{
+    uint64_t x = socket->simulationRandom;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    socket->simulationRandom = x;
+    return static_cast<uint32_t>(x >> 32);
+}
+
+static bool socketSimulatesDelay(const LvnSocket* socket)
+{
+    return socket->simulation.latencyMilliseconds > 0 || socket->simulation.jitterMilliseconds > 0;
+}
+
+static void socketDelayPacket(LvnSocket* socket, ENetPacket* packet, uint32_t peerId, uint8_t channel, bool broadcast)
+{
+    uint32_t delay = socket->simulation.latencyMilliseconds;
+    if (socket->simulation.jitterMilliseconds > 0)
+        delay += lvn::socketSimulationRandom(socket) % (socket->simulation.jitterMilliseconds + 1);
+
+    // jitter never reorders packets, a packet waits for the ones sent before it
+    uint32_t releaseTime = enet_time_get() + delay;
+    if (!socket->delayedPackets.empty() && ENET_TIME_LESS(releaseTime, socket->delayedPackets.back().releaseTime))
+        releaseTime = socket->delayedPackets.back().releaseTime;
+
+    LvnSocketDelayedPacket delayedPacket{};
+    delayedPacket.packet = packet;
+    delayedPacket.peerId = peerId;
+    delayedPacket.releaseTime = releaseTime;
+    delayedPacket.channel = channel;
+    delayedPacket.broadcast = broadcast;
+    socket->delayedPackets.push(delayedPacket);
+}
+
+static void socketReleaseDelayedPackets(LvnSocket* socket)
+{
+    const uint32_t now = enet_time_get();
+
+    while (!socket->delayedPackets.empty() && ENET_TIME_LESS_EQUAL(socket->delayedPackets.front().releaseTime, now))
+    {
+        const LvnSocketDelayedPacket& delayedPacket = socket->delayedPackets.front();
+
+        if (delayedPacket.broadcast)
+            lvn::socketBroadcastEnetPacket(socket, delayedPacket.channel, delayedPacket.packet);
+        else if (!lvn::socketSendEnetPacket(socket, lvn::socketGetPeer(socket, delayedPacket.peerId), delayedPacket.channel, delayedPacket.packet))
+            enet_packet_destroy(delayedPacket.packet);
+
+        socket->delayedPackets.pop();
+    }
+}
+
+static int socketHostService(LvnSocket* socket, ENetEvent* event, uint32_t milliseconds)
+{
+    s_ServicingSocket = socket;
+
+    if (socket->delayedPackets.empty())
+        return enet_host_service(socket->socket, event, milliseconds);
+
+    // the wait is split at each release time so delayed packets leave on time while waiting for events
+    const uint32_t start = enet_time_get();
+    for (;;)
+    {
+        lvn::socketReleaseDelayedPackets(socket);
+
+        const uint32_t now = enet_time_get();
+        const uint32_t elapsed = ENET_TIME_DIFFERENCE(now, start);
+        uint32_t wait = elapsed < milliseconds ? milliseconds - elapsed : 0;
+        if (!socket->delayedPackets.empty() && ENET_TIME_LESS(now, socket->delayedPackets.front().releaseTime))
+            wait = lvn::min(wait, socket->delayedPackets.front().releaseTime - now);
+
+        int result = enet_host_service(socket->socket, event, wait);
+        if (result != 0 || ENET_TIME_DIFFERENCE(enet_time_get(), start) >= milliseconds)
+            return result;
+    }
+}
+
+static int ENET_CALLBACK socketIntercept(ENetHost* host, ENetEvent*)
+{
+    LvnSocket* socket = s_ServicingSocket;
+    if (socket == nullptr || socket->socket != host)
+        return 0;
+
+    // returning 1 tells enet the datagram was handled, so it is dropped as if it was lost on the way
+    return static_cast<float>(lvn::socketSimulationRandom(socket) >> 8) < socket->simulation.packetLoss * 16777216.0f ? 1 : 0;
+}
+
+static void* socketNetworkThread(void* arg)
+{
+    LvnSocket* socket = static_cast<LvnSocket*>(arg);
+
+    ENetEvent event;
+    LvnSocketCommand command;
+
+    while (!socket->networkStop.load(std::memory_order_acquire))
+    {
+        while (socket->commands->try_pop(command))
+            lvn::socketRunCommand(socket, command);
+
+        // events that did not fit on an earlier tick are handed over first so the event order is kept
+        while (!socket->overflow.empty() && socket->events->try_push(socket->overflow.front()))
+            socket->overflow.pop();
+
+        // waits for traffic for up to one tick, the packets queued by the commands above are sent by this service
+        int result = lvn::socketHostService(socket, &event, socket->networkTickMilliseconds);
+
+        while (result > 0)
+        {
+            LvnSocketQueuedEvent queuedEvent = lvn::socketTranslateEvent(socket, event);
+            if (!socket->overflow.empty() || !socket->events->try_push(queuedEvent))
+                socket->overflow.push(queuedEvent);
+
+            result = enet_host_check_events(socket->socket, &event);
+        }
+
+        if (result < 0)
+            LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_ERROR, "failed to service events on socket (%p)", socket);
+    }
+
+    return nullptr;
+}
+
 static void initStandardPipelineSpecification(LvnContext* lvnctx)
 {
     LvnPipelineSpecification pipelineSpecification{};
@@ -407,6 +2148,9 @@ static void initStandardPipelineSpecification(LvnContext* lvnctx)
     pipelineSpecification.depthstencil.stencil.failOp = Lvn_StencilOp_Keep;
     pipelineSpecification.depthstencil.stencil.passOp = Lvn_StencilOp_Keep;
 
+    // Dynamic States
+    pipelineSpecification.dynamicStates = Lvn_PipelineDynamicState_None;
+
     lvnctx->defaultPipelineSpecification = pipelineSpecification;
 }
 
@@ -427,7 +2171,15 @@ static void setDefaultStructTypeMemAllocInfos(LvnContext* lvnctx)
     stInfos[Lvn_Stype_Sampler]          = { Lvn_Stype_Sampler, sizeof(LvnSampler), 256 };
     stInfos[Lvn_Stype_Texture]          = { Lvn_Stype_Texture, sizeof(LvnTexture), 256 };
     stInfos[Lvn_Stype_Cubemap]          = { Lvn_Stype_Cubemap, sizeof(LvnCubemap), 256 };
+    stInfos[Lvn_Stype_EnvironmentMap]   = { Lvn_Stype_EnvironmentMap, sizeof(LvnEnvironmentMap), 8 };
+    stInfos[Lvn_Stype_LightClusters]    = { Lvn_Stype_LightClusters, sizeof(LvnLightClusters), 8 };
+    stInfos[Lvn_Stype_ShadowCache]      = { Lvn_Stype_ShadowCache, sizeof(LvnShadowCache), 8 };
+    stInfos[Lvn_Stype_MaterialTable]    = { Lvn_Stype_MaterialTable, sizeof(LvnMaterialTable), 8 };
+    stInfos[Lvn_Stype_RenderGraph]      = { Lvn_Stype_RenderGraph, sizeof(LvnRenderGraph), 8 };
+    stInfos[Lvn_Stype_CommandList]      = { Lvn_Stype_CommandList, sizeof(LvnCommandList), 8 };
     stInfos[Lvn_Stype_Sound]            = { Lvn_Stype_Sound, sizeof(LvnSound), 32 };
+    stInfos[Lvn_Stype_SoundBank]        = { Lvn_Stype_SoundBank, sizeof(LvnSoundBank), 8 };
+    stInfos[Lvn_Stype_SoundGroup]       = { Lvn_Stype_SoundGroup, sizeof(LvnSoundGroup), 8 };
     stInfos[Lvn_Stype_Socket]           = { Lvn_Stype_Socket, sizeof(LvnSocket), 32 };
 }
 
@@ -445,7 +2197,15 @@ static const char* getStructTypeEnumStr(LvnStructureType stype)
         case Lvn_Stype_Sampler:           { return "LvnSampler"; }
         case Lvn_Stype_Texture:           { return "LvnTexture"; }
         case Lvn_Stype_Cubemap:           { return "LvnCubemap"; }
+        case Lvn_Stype_EnvironmentMap:    { return "LvnEnvironmentMap"; }
+        case Lvn_Stype_LightClusters:     { return "LvnLightClusters"; }
+        case Lvn_Stype_ShadowCache:       { return "LvnShadowCache"; }
+        case Lvn_Stype_MaterialTable:     { return "LvnMaterialTable"; }
+        case Lvn_Stype_RenderGraph:       { return "LvnRenderGraph"; }
+        case Lvn_Stype_CommandList:       { return "LvnCommandList"; }
         case Lvn_Stype_Sound:             { return "LvnSound"; }
+        case Lvn_Stype_SoundBank:         { return "LvnSoundBank"; }
+        case Lvn_Stype_SoundGroup:        { return "LvnSoundGroup"; }
         case Lvn_Stype_Socket:            { return "LvnSocket"; }
 
         default:                          { return "undefined"; }
@@ -468,16 +2228,31 @@ static LvnData<uint32_t> initDefaultFontCodepoints()
     return LvnData<uint32_t>(codepoints.data(), codepoints.size());
 }
 
+static uint64_t alignObjectOffset(uint64_t offset)
+{
+    const uint64_t alignment = LVN_CACHE_LINE_SIZE;
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
 static LvnResult createContextMemoryPool(LvnContext* lvnctx, LvnContextCreateInfo* createInfo)
 {
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_MemoryPool);
     lvn::setDefaultStructTypeMemAllocInfos(lvnctx);
 
     lvnctx->memoryMode = createInfo->memoryInfo.memAllocMode;
+    lvnctx->trimHighWatermark = createInfo->memoryInfo.trimHighWatermark;
+    lvnctx->trimLowWatermark = createInfo->memoryInfo.trimLowWatermark;
+    lvnctx->poolConfigPath = createInfo->memoryInfo.poolConfigPath;
     if (lvnctx->memoryMode == Lvn_MemAllocMode_Individual) { return Lvn_Result_Success; }
 
-    // set struct memory configs
+    // set struct memory configs, further blocks keep the default counts
     lvnctx->blockMemAllocInfos = lvnctx->sTypeMemAllocInfos;
     auto& structTypes = lvnctx->sTypeMemAllocInfos;
+
+    // counts recorded by a previous run replace the defaults of the base block, bindings given by the application take precedence over both
+    if (!lvnctx->poolConfigPath.empty())
+        lvn::loadMemoryPoolConfig(lvnctx, lvnctx->poolConfigPath.c_str());
+
     for (uint64_t i = 0; i < createInfo->memoryInfo.memoryBindingCount; i++)
     {
         if (createInfo->memoryInfo.pMemoryBindings[i].count == 0)
@@ -489,10 +2264,13 @@ static LvnResult createContextMemoryPool(LvnContext* lvnctx, LvnContextCreateInf
         structTypes[createInfo->memoryInfo.pMemoryBindings[i].sType].count = createInfo->memoryInfo.pMemoryBindings[i].count;
     }
 
-    // get total memory in bytes for memory pool
+    // get total memory in bytes for memory pool, each sType starts on its own aligned offset
     uint64_t memSize = 0;
     for (uint64_t i = 0; i < structTypes.size(); i++)
-        memSize += structTypes[i].size * structTypes[i].count;
+    {
+        LVN_CORE_ASSERT(structTypes[i].count == 0 || structTypes[i].size >= sizeof(void*), "object size too small to hold a free list link");
+        memSize = lvn::alignObjectOffset(memSize) + structTypes[i].size * structTypes[i].count;
+    }
 
     // create the first memory block
     LvnMemoryPool* memPool = &lvnctx->memoryPool;
@@ -509,10 +2287,20 @@ static LvnResult createContextMemoryPool(LvnContext* lvnctx, LvnContextCreateInf
         auto& memBinding = memPool->memBindings[structTypes[i].sType];
 
         uint64_t count = structTypes[i].count;
+        if (count == 0)
+        {
+            memBinding.push_back(LvnMemoryBinding(nullptr, structTypes[i].size, 0));
+            continue;
+        }
+
+        memIndex = lvn::alignObjectOffset(memIndex);
         memBinding.push_back(LvnMemoryBinding(memPool->baseMemoryBlock[memIndex], structTypes[i].size, count));
         memIndex += count * structTypes[i].size;
     }
 
+    for (uint32_t i = 0; i < Lvn_Stype_Max_Value; i++)
+        memPool->currentBindings[i] = &memPool->memBindings[i].back();
+
     // set struct block memory configs
     for (uint64_t i = 0; i < createInfo->memoryInfo.blockMemoryBindingCount; i++)
     {
@@ -533,29 +2321,198 @@ static LvnResult createContextMemoryPool(LvnContext* lvnctx, LvnContextCreateInf
     return Lvn_Result_Success;
 }
 
-static void createMemoryBlock(LvnContext* lvnctx, LvnStructureType sType)
+// pool config files hold one "<sType name> <count>" pair per line, lines starting with # and unknown names are skipped
+static void loadMemoryPoolConfig(LvnContext* lvnctx, const char* filepath)
 {
-    uint64_t size = lvnctx->blockMemAllocInfos[sType].size;
-    uint64_t count = lvnctx->blockMemAllocInfos[sType].count;
-    uint64_t memsize = size * count;
+    FILE* fileptr = fopen(filepath, "r");
+    if (!fileptr)
+    {
+        // the first run has nothing recorded yet
+        LVN_CORE_TRACE("[context]: memory pool config file \"%s\" not found, using the default memory bindings", filepath);
+        return;
+    }
+
+    uint32_t loadedCount = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), fileptr))
+    {
+        char name[128];
+        unsigned long long count;
+        if (line[0] == '#' || sscanf(line, "%127s %llu", name, &count) != 2)
+            continue;
+
+        for (uint32_t i = Lvn_Stype_Undefined + 1; i < Lvn_Stype_Max_Value; i++)
+        {
+            if (strcmp(name, lvn::getStructTypeEnumStr((LvnStructureType)i)) != 0)
+                continue;
+
+            lvnctx->sTypeMemAllocInfos[i].count = count;
+            loadedCount++;
+            break;
+        }
+    }
+
+    fclose(fileptr);
+    LVN_CORE_TRACE("[context]: memory pool config file \"%s\" loaded, %u base memory bindings sized from recorded peak counts", filepath, loadedCount);
+}
+
+static void createMemoryBlock(LvnContext* lvnctx, LvnStructureType sType)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_MemoryPool);
+    uint64_t size = lvnctx->blockMemAllocInfos[sType].size;
+    uint64_t count = lvnctx->blockMemAllocInfos[sType].count;
+    uint64_t memsize = size * count;
 
     // create the next memory block in the list for sType
     LvnMemoryPool* memPool = &lvnctx->memoryPool;
     memPool->memBlocks[sType].push_back(LvnMemoryBlock(memsize));
 
-    // set memory binding for sType
-    auto& memBinding = memPool->memBindings[sType];
+    // bind the memory binding for sType to the newly created memory block, it becomes the binding new slots are taken from
+    memPool->memBindings[sType].push_back(LvnMemoryBinding(memPool->memBlocks[sType].back()[0], size, count));
+    memPool->currentBindings[sType] = &memPool->memBindings[sType].back();
+}
+
+static LvnObjectCache* getObjectCache(LvnContext* lvnctx)
+{
+    LvnObjectCache* cache = &s_ObjectCache;
+    if (cache->contextId != lvnctx->contextId)
+    {
+        for (uint32_t i = 0; i < Lvn_Stype_Max_Value; i++)
+            cache->bins[i].count = 0;
+        cache->contextId = lvnctx->contextId;
+
+        LvnLockGaurd lock(lvnctx->objectMutex);
+        lvnctx->objectCaches.push_back(cache);
+    }
+
+    return cache;
+}
+
+static void flushObjectCache(LvnContext* lvnctx, LvnObjectCache* cache)
+{
+    for (uint32_t i = 0; i < Lvn_Stype_Max_Value; i++)
+    {
+        for (uint32_t j = 0; j < cache->bins[i].count; j++)
+            lvnctx->memoryPool.freeLists[i].push(cache->bins[i].slots[j]);
+        cache->bins[i].count = 0;
+    }
+}
+
+static void trimMemoryPool(LvnContext* lvnctx, LvnStructureType sType)
+{
+    LvnMemoryPool* memPool = &lvnctx->memoryPool;
+    LvnList<LvnMemoryBlock>& memBlocks = memPool->memBlocks[sType];
+    if (memBlocks.empty()) { return; }
+
+    LvnList<LvnMemoryBinding>& memBindings = memPool->memBindings[sType];
+    LvnObjectFreeList& freeList = memPool->freeLists[sType];
+    uint64_t objSize = lvnctx->blockMemAllocInfos[sType].size;
+
+    // take every free slot off the free list so they can be counted per block
+    LvnVector<void*> freeSlots;
+    void* slot;
+    while ((slot = freeList.pop()) != nullptr)
+        freeSlots.push_back(slot);
+
+    // binding 0 is in the base memory block and is never freed, binding i is in memory block i - 1
+    LvnVector<LvnMemoryBinding*> bindings;
+    LvnVector<uint64_t> freeCounts;
+    uint64_t unusedBytes = freeSlots.size() * objSize;
+    for (uint32_t i = 0; i < memBindings.size(); i++)
+    {
+        LvnMemoryBinding* binding = &memBindings[i];
+        bindings.push_back(binding);
+        freeCounts.push_back(0);
+        unusedBytes += (binding->capacity() - binding->size()) * objSize;
+    }
+
+    for (void* freeSlot : freeSlots)
+    {
+        for (uint32_t i = 1; i < bindings.size(); i++)
+        {
+            if (bindings[i]->contains(freeSlot)) { freeCounts[i]++; break; }
+        }
+    }
+
+    // a block is empty when every slot taken from it is back on the free list, free the newest blocks first
+    LvnVector<bool> freeBlock;
+    freeBlock.resize(bindings.size(), false);
+    uint32_t freedBlockCount = 0;
+    if (lvnctx->trimHighWatermark == 0 || unusedBytes > lvnctx->trimHighWatermark)
+    {
+        for (uint32_t i = bindings.size() - 1; i > 0; i--)
+        {
+            uint64_t blockBytes = bindings[i]->capacity() * objSize;
+            if (freeCounts[i] != bindings[i]->size() || unusedBytes - blockBytes < lvnctx->trimLowWatermark)
+                continue;
+
+            freeBlock[i] = true;
+            unusedBytes -= blockBytes;
+            freedBlockCount++;
+        }
+    }
+
+    // put back the free slots that are in blocks that stay
+    for (void* freeSlot : freeSlots)
+    {
+        bool inFreedBlock = false;
+        for (uint32_t i = 1; i < bindings.size(); i++)
+        {
+            if (freeBlock[i] && bindings[i]->contains(freeSlot)) { inFreedBlock = true; break; }
+        }
+
+        if (!inFreedBlock)
+            freeList.push(freeSlot);
+    }
+
+    if (freedBlockCount == 0) { return; }
+
+    for (uint32_t i = bindings.size() - 1; i > 0; i--)
+    {
+        if (!freeBlock[i]) { continue; }
+
+        memBindings.erase_index(i);
+        memBlocks.erase_index(i - 1);
+    }
+
+    memPool->currentBindings[sType] = &memBindings.back();
+
+    LVN_CORE_TRACE("memory pool trimmed, freed %u empty memory blocks of sType %s", freedBlockCount, lvn::getStructTypeEnumStr(sType));
+}
+
+static void* takeObjectSlot(LvnContext* lvnctx, LvnStructureType sType)
+{
+    LvnObjectCache::Bin& bin = lvn::getObjectCache(lvnctx)->bins[sType];
+    if (bin.count > 0)
+        return bin.slots[--bin.count];
+
+    void* slot = lvnctx->memoryPool.freeLists[sType].pop();
+    if (slot != nullptr)
+        return slot;
+
+    // no freed slot left, take a new one from the newest memory binding
+    LvnLockGaurd lock(lvnctx->objectMutex);
+
+    LvnMemoryPool* memPool = &lvnctx->memoryPool;
+    if (memPool->currentBindings[sType]->full())
+        lvn::createMemoryBlock(lvnctx, sType);
 
-    LvnMemoryBinding* prevMemBinding = nullptr;
-    if (!memBinding.empty())
-        prevMemBinding = &memBinding.back();
+    return memPool->currentBindings[sType]->take_next();
+}
 
-    // bind the memory binding for sType to the newly created memory block
-    memBinding.push_back(LvnMemoryBinding(memPool->memBlocks[sType].back()[0], size, count));
+static void releaseObjectSlot(LvnContext* lvnctx, LvnStructureType sType, void* slot)
+{
+    LvnObjectCache::Bin& bin = lvn::getObjectCache(lvnctx)->bins[sType];
+    if (bin.count == LvnObjectCache::s_Capacity)
+    {
+        // cache is full, move half of it to the shared free list where other threads can take them
+        LvnObjectFreeList& freeList = lvnctx->memoryPool.freeLists[sType];
+        for (uint32_t i = LvnObjectCache::s_Capacity / 2; i < LvnObjectCache::s_Capacity; i++)
+            freeList.push(bin.slots[i]);
+        bin.count = LvnObjectCache::s_Capacity / 2;
+    }
 
-    // set the previous memory binding to the newly created memory binding
-    if (prevMemBinding != nullptr)
-        prevMemBinding->set_next_memory_binding(&memBinding.back());
+    bin.slots[bin.count++] = slot;
 }
 
 template <typename T>
@@ -568,18 +2525,19 @@ static T* createObject(LvnContext* lvnctx, LvnStructureType sType)
     }
     else if (lvnctx->memoryMode == Lvn_MemAllocMode_MemPool)
     {
-        auto& memBinding = lvnctx->memoryPool.memBindings[sType][0];
-        if (memBinding.find_empty_memory_binding() == nullptr)
-            lvn::createMemoryBlock(lvnctx, sType);
-
-        object = new (static_cast<T*>(memBinding.take_next())) T();
+        object = new (static_cast<T*>(lvn::takeObjectSlot(lvnctx, sType))) T();
     }
     else
     {
         LVN_CORE_ASSERT(false, "create object failed, no requirment was met before hand"); return nullptr;
     }
 
-    lvnctx->objectMemoryAllocations.sTypes[sType].count++;
+    // the peak only grows, a stale read just retries the exchange
+    LvnObjectMemAllocCount::LvnStructCounts& counts = lvnctx->objectMemoryAllocations.sTypes[sType];
+    size_t live = counts.count.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t peak = counts.peak.load(std::memory_order_relaxed);
+    while (live > peak && !counts.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
     return object;
 }
 
@@ -593,14 +2551,15 @@ static void destroyObject(LvnContext* lvnctx, T* obj, LvnStructureType sType)
     }
     else if (lvnctx->memoryMode == Lvn_MemAllocMode_MemPool)
     {
-        lvnctx->memoryPool.memBindings[sType][0].push_back(obj);
+        obj->~T();
+        lvn::releaseObjectSlot(lvnctx, sType, obj);
     }
     else
     {
         LVN_CORE_ASSERT(false, "destroy object failed, no requirment was met before hand");
     }
 
-    lvnctx->objectMemoryAllocations.sTypes[sType].count--;
+    lvnctx->objectMemoryAllocations.sTypes[sType].count.fetch_sub(1, std::memory_order_relaxed);
 }
 
 // ------------------------------------------------------------
@@ -613,26 +2572,52 @@ LvnResult createContext(LvnContextCreateInfo* createInfo)
     s_LvnContext = new LvnContext();
     LvnContext* lvnctx = s_LvnContext;
 
-    lvnctx->contexTime.reset();
+    lvnctx->contextStartTime = lvn::getMonotonicTimeNs();
 
     lvnctx->appName = createInfo->applicationName;
     lvnctx->windowapi = createInfo->windowapi;
     lvnctx->graphicsapi = createInfo->graphicsapi;
     lvnctx->multithreading = createInfo->enableMultithreading;
+    lvnctx->hotReloadEnabled = createInfo->rendering.enableHotReload;
+
+    lvnctx->audioInit = createInfo->audio.init;
+    lvnctx->audioConfig = createInfo->audio;
+    lvnctx->audioInitResult = Lvn_Result_Failure;
+    lvnctx->networkingInit = createInfo->networking.init;
+    lvnctx->networkingInitResult = Lvn_Result_Failure;
+
+    lvnctx->soundStreamThread = nullptr;
+    lvnctx->soundStreamStop = false;
+    lvnctx->soundMaxVoices = LVN_SOUND_DEFAULT_MAX_VOICES;
+    lvnctx->soundMixedVoiceCount = 0;
+    lvnctx->soundVirtualVoiceCount = 0;
+    lvnctx->audioEngineContextPtr = nullptr;
+    lvnctx->audioDeviceContextPtr = nullptr;
+    lvnctx->audioDevicePtr = nullptr;
 
     lvnctx->graphicsContext.graphicsapi = createInfo->graphicsapi;
     lvnctx->graphicsContext.enableGraphicsApiDebugLogs = createInfo->logging.enableGraphicsApiDebugLogs;
     lvnctx->graphicsContext.frameBufferColorFormat = createInfo->rendering.frameBufferColorFormat;
     lvnctx->graphicsContext.maxFramesInFlight = createInfo->rendering.maxFramesInFlight;
+    lvnctx->graphicsContext.frameLatency = createInfo->rendering.frameLatency;
+    lvnctx->graphicsContext.waitForPresent = createInfo->rendering.waitForPresent;
+    lvnctx->graphicsContext.physicalDevicePreference = createInfo->rendering.physicalDevicePreference;
+    lvnctx->graphicsContext.pipelineCachePath = createInfo->rendering.pipelineCachePath;
+    lvnctx->graphicsContext.shaderCacheDirectory = createInfo->rendering.shaderCacheDirectory;
 
     // logging
     lvn::initLogging(createInfo);
 
     // memory
-    lvnctx->objectMemoryAllocations.sTypes.resize(Lvn_Stype_Max_Value);
-    for (uint32_t i = 0; i < lvnctx->objectMemoryAllocations.sTypes.size(); i++)
+    lvnctx->contextId = ++s_ContextIdCounter;
+
+    // profiling
+    lvn::initProfiling(lvnctx, createInfo);
+    for (uint32_t i = 0; i < Lvn_Stype_Max_Value; i++)
     {
-        lvnctx->objectMemoryAllocations.sTypes[i] = { (LvnStructureType)i, 0 };
+        lvnctx->objectMemoryAllocations.sTypes[i].sType = (LvnStructureType)i;
+        lvnctx->objectMemoryAllocations.sTypes[i].count.store(0, std::memory_order_relaxed);
+        lvnctx->objectMemoryAllocations.sTypes[i].peak.store(0, std::memory_order_relaxed);
     }
 
     // default font codepoints
@@ -642,21 +2627,40 @@ LvnResult createContext(LvnContextCreateInfo* createInfo)
     LvnResult result = lvn::createContextMemoryPool(lvnctx, createInfo);
     if (result != Lvn_Result_Success) { return result; }
 
+    // opening the audio device can take a long time on some backends, it is done on its own thread while the window and graphics contexts are set up
+    LvnThread* audioThread = nullptr;
+    if (lvnctx->audioInit == Lvn_SubsystemInit_Startup && lvnctx->multithreading)
+        audioThread = new LvnThread(lvn::initAudioThread, lvnctx);
+
     // window context
     result = setWindowContext(lvnctx, createInfo->windowapi);
-    if (result != Lvn_Result_Success) { return result; }
 
     // graphics context
-    result = setGraphicsContext(lvnctx, createInfo->graphicsapi);
+    if (result == Lvn_Result_Success)
+        result = setGraphicsContext(lvnctx, createInfo->graphicsapi);
+
+    delete audioThread;
     if (result != Lvn_Result_Success) { return result; }
 
     // audio context
-    result = initAudioContext(lvnctx);
-    if (result != Lvn_Result_Success) { return result; }
+    if (lvnctx->audioInit == Lvn_SubsystemInit_Startup)
+    {
+        result = lvn::requireAudioContext(lvnctx);
+        if (result != Lvn_Result_Success) { return result; }
+    }
 
     // networking context
-    result = initNetworkingContext();
-    if (result != Lvn_Result_Success) { return result; }
+    if (lvnctx->networkingInit == Lvn_SubsystemInit_Startup)
+    {
+        result = lvn::requireNetworkingContext(lvnctx);
+        if (result != Lvn_Result_Success) { return result; }
+    }
+
+    // job system
+    lvn::initJobSystem(lvnctx);
+
+    // file io
+    lvn::initIoService(lvnctx);
 
     // config
     initStandardPipelineSpecification(lvnctx);
@@ -693,3249 +2697,14041 @@ void terminateContext()
 
     LvnContext* lvnctx = s_LvnContext;
 
+    // queued jobs may still use any part of the context, finish them first
+    lvn::terminateJobSystem(lvnctx);
+
     if (lvn::rendererIsInitialized())
         lvn::renderTerminate();
 
+    lvnctx->pipelineCache.clear_free();
+    lvnctx->samplerCache.clear_free();
+
+    {
+        std::lock_guard<std::mutex> lock(lvnctx->pipelineCompileMutex);
+        lvnctx->pipelineCompileStop = true;
+    }
+    lvnctx->pipelineCompileCondition.notify_all();
+    for (uint32_t i = 0; i < lvnctx->pipelineCompileThreads.size(); i++)
+        delete lvnctx->pipelineCompileThreads[i];
+    lvnctx->pipelineCompileThreads.clear_free();
+
+    lvn::hotReloadTerminate(lvnctx);
+
     lvn::terminateGraphicsContext(lvnctx);
     lvn::terminateWindowContext(lvnctx);
     lvn::terminateAudioContext(lvnctx);
-    lvn::terminateNetworkingContext();
+    lvn::terminateNetworkingContext(lvnctx);
+    lvn::vfsUnmountAll(lvnctx);
+    lvn::terminateProfiling(lvnctx);
+
+    // atoms and the strings handed out for them are invalid from here on
+    lvnctx->atomIndices.clear_free();
+    lvnctx->atoms.clear_free();
+    lvnctx->atomStrings.clear_free();
 
-    for (uint32_t i = 0; i < lvnctx->objectMemoryAllocations.sTypes.size(); i++)
+    // messages after this are written inline, the log thread and its queue are freed before the allocations are counted
+    lvn::terminateLogThread(lvnctx);
+
+    for (uint32_t i = 0; i < Lvn_Stype_Max_Value; i++)
     {
-        if (lvnctx->objectMemoryAllocations.sTypes[i].count > 0)
+        size_t count = lvnctx->objectMemoryAllocations.sTypes[i].count.load(std::memory_order_relaxed);
+        if (count > 0)
         {
             const char* stype = lvn::getStructTypeEnumStr(lvnctx->objectMemoryAllocations.sTypes[i].sType);
-            LVN_CORE_ERROR("sType = %s | not all objects of this sType (%s) have been destroyed, number of %s objects remaining: %zu", stype, stype, stype, lvnctx->objectMemoryAllocations.sTypes[i].count);
+            LVN_CORE_ERROR("sType = %s | not all objects of this sType (%s) have been destroyed, number of %s objects remaining: %zu", stype, stype, stype, count);
         }
     }
 
-    if (lvnctx->numMemoryAllocations > 0) { LVN_CORE_WARN("not all memory allocations have been freed, number of allocations remaining: %zu", lvnctx->numMemoryAllocations); }
+    if (!lvnctx->poolConfigPath.empty())
+        lvn::memPoolWriteConfig(lvnctx->poolConfigPath.c_str());
+
+    // pool blocks are allocated with lvn::memAllocAligned, free them before checking for remaining allocations
+    lvnctx->memoryPool.baseMemoryBlock = LvnMemoryBlock();
+    lvnctx->memoryPool.memBindings.clear_free();
+    lvnctx->memoryPool.memBlocks.clear_free();
 
+    if (lvnctx->numMemoryAllocations > 0) { LVN_CORE_WARN("not all memory allocations have been freed, number of allocations remaining: %zu", lvnctx->numMemoryAllocations.load()); }
+
+    // pending log writes are flushed here, logging after this point writes inline
+    lvn::terminateIoService(lvnctx);
     lvn::terminateLogging();
 
     delete s_LvnContext;
     s_LvnContext = nullptr;
 }
 
-LvnContext* getContext()
+LvnAtom atomIntern(const char* str)
 {
-    LVN_CORE_ASSERT(s_LvnContext != nullptr, "levikno context is nullptr, context was probably not created or initiated before using the library")
-    return s_LvnContext;
+    LVN_CORE_ASSERT(str != nullptr, "str is nullptr, cannot intern a string that does not exist");
+    return lvn::atomInternLength(str, strlen(str));
 }
 
-// ------------------------------------------------------------
-// [SECTION]: Date Time Functions
-// ------------------------------------------------------------
-
-int dateGetYear()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_year + 1900;
-}
-int dateGetYear02d()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return (tm.tm_year + 1900) % 100;
-}
-int dateGetMonth()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_mon + 1;
-}
-int dateGetDay()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_mday;
-}
-int dateGetHour()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_hour;
-}
-int dateGetHour12()
+LvnAtom atomInternLength(const char* str, size_t length)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return ((tm.tm_hour + 11) % 12) + 1;
-}
-int dateGetMinute()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_min;
-}
-int dateGetSecond()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_sec;
-}
+    if (length == 0) { return 0; }
 
-long long dateGetSecondsSinceEpoch()
-{
-    return time(NULL);
-}
+    LvnContext* lvnctx = lvn::getContext();
+    LvnStringView view(str, length);
 
-static const char* const s_MonthName[12] = { "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December" };
-static const char* const s_MonthNameShort[12] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
-static const char* const s_WeekDayName[7] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
-static const char* const s_WeekDayNameShort[7] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    // most calls find a string interned earlier, only the first use of a string takes the write lock
+    {
+        LvnSharedLockGaurd lock(lvnctx->atomMutex);
+        if (const LvnAtom* atom = lvnctx->atomIndices.find(view))
+            return *atom;
+    }
 
-const char* dateGetMonthName()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return s_MonthName[tm.tm_mon];
-}
-const char* dateGetMonthNameShort()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return s_MonthNameShort[tm.tm_mon];
-}
-const char* dateGetWeekDayName()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return s_WeekDayName[tm.tm_wday];
-}
-const char* dateGetWeekDayNameShort()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return s_WeekDayNameShort[tm.tm_wday];
-}
-const char* dateGetTimeMeridiem()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    if (tm.tm_hour < 12)
-        return "AM";
-    else
-        return "PM";
-}
-const char* dateGetTimeMeridiemLower()
-{
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    if (tm.tm_hour < 12)
-        return "am";
-    else
-        return "pm";
-}
+    LvnWriteLockGaurd lock(lvnctx->atomMutex);
+    if (const LvnAtom* atom = lvnctx->atomIndices.find(view))
+        return *atom;
 
-LvnString dateGetTimeHHMMSS()
-{
-    char buff[9];
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    snprintf(buff, 9, "%02d:%02d:%02d", tm.tm_hour, tm.tm_min, tm.tm_sec);
-    return LvnString(buff);
-}
-LvnString dateGetTime12HHMMSS()
-{
-    char buff[9];
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    snprintf(buff, 9, "%02d:%02d:%02d", ((tm.tm_hour + 11) % 12) + 1, tm.tm_min, tm.tm_sec);
-    return LvnString(buff);
-}
-LvnString dateGetYearStr()
-{
-    char buff[5];
-    snprintf(buff, 5, "%d", dateGetYear());
-    return LvnString(buff);
-}
-LvnString dateGetYear02dStr()
-{
-    char buff[3];
-    snprintf(buff, 3, "%d", dateGetYear02d());
-    return LvnString(buff);
+    if (lvnctx->atoms.empty())
+    {
+        LvnAtomEntry empty{};
+        empty.str = "";
+        empty.hash = LvnStringHash()(LvnStringView("", 0));
+        lvnctx->atoms.push_back(empty);
+    }
+
+    char* copy = lvnctx->atomStrings.alloc_array<char>(length + 1);
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+
+    LvnAtomEntry entry{};
+    entry.str = copy;
+    entry.length = static_cast<uint32_t>(length);
+    entry.hash = LvnStringHash()(view);
+
+    LvnAtom atom = static_cast<LvnAtom>(lvnctx->atoms.size());
+    lvnctx->atoms.push_back(entry);
+    lvnctx->atomIndices.insert(LvnStringView(copy, length), atom);
+
+    return atom;
 }
-LvnString dateGetMonthNumStr()
+
+LvnAtom atomFind(const char* str)
 {
-    char buff[3];
-    snprintf(buff, 3, "%02d", dateGetMonth());
-    return LvnString(buff);
+    if (str == nullptr || *str == '\0') { return 0; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    LvnSharedLockGaurd lock(lvnctx->atomMutex);
+    const LvnAtom* atom = lvnctx->atomIndices.find(LvnStringView(str));
+    return atom ? *atom : 0;
 }
-LvnString dateGetDayNumStr()
+
+const char* atomGetString(LvnAtom atom)
 {
-    char buff[3];
-    snprintf(buff, 3, "%02d", dateGetDay());
-    return LvnString(buff);
+    if (atom == 0) { return ""; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    LvnSharedLockGaurd lock(lvnctx->atomMutex);
+    LVN_CORE_ASSERT(atom < lvnctx->atoms.size(), "atom (%u) was not returned by lvn::atomIntern", atom);
+    return lvnctx->atoms[atom].str;
 }
-LvnString dateGetHourNumStr()
+
+uint32_t atomGetLength(LvnAtom atom)
 {
-    char buff[3];
-    snprintf(buff, 3, "%02d", dateGetHour());
-    return LvnString(buff);
+    if (atom == 0) { return 0; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    LvnSharedLockGaurd lock(lvnctx->atomMutex);
+    LVN_CORE_ASSERT(atom < lvnctx->atoms.size(), "atom (%u) was not returned by lvn::atomIntern", atom);
+    return lvnctx->atoms[atom].length;
 }
-LvnString dateGetHour12NumStr()
+
+uint64_t atomGetHash(LvnAtom atom)
 {
-    char buff[3];
-    snprintf(buff, 3, "%02d", dateGetHour12());
-    return LvnString(buff);
+    if (atom == 0) { return LvnStringHash()(LvnStringView("", 0)); }
+
+    LvnContext* lvnctx = lvn::getContext();
+    LvnSharedLockGaurd lock(lvnctx->atomMutex);
+    LVN_CORE_ASSERT(atom < lvnctx->atoms.size(), "atom (%u) was not returned by lvn::atomIntern", atom);
+    return lvnctx->atoms[atom].hash;
 }
-LvnString dateGetMinuteNumStr()
+
+LvnContext* getContext()
 {
-    char buff[3];
-    snprintf(buff, 3, "%02d", dateGetMinute());
-    return LvnString(buff);
+    LVN_CORE_ASSERT(s_LvnContext != nullptr, "levikno context is nullptr, context was probably not created or initiated before using the library")
+    return s_LvnContext;
 }
-LvnString dateGetSecondNumStr()
+
+static void initJobSystem(LvnContext* lvnctx)
 {
-    char buff[3];
-    snprintf(buff, 3, "%02d", dateGetSecond());
-    return LvnString(buff);
-}
+    lvnctx->jobStop = false;
+    lvnctx->jobQueuedCount.store(0, std::memory_order_relaxed);
+    lvnctx->jobSubmitIndex.store(0, std::memory_order_relaxed);
 
+    if (!lvnctx->multithreading)
+        return;
 
-LvnString loadFileSrc(const char* filepath)
-{
-    FILE* fileptr = fopen(filepath, "r");
+    // the thread waiting on jobs runs them too, so one core is left for it
+    uint32_t coreCount = std::thread::hardware_concurrency();
+    uint32_t workerCount = coreCount > 1 ? coreCount - 1 : 1;
 
-    if (!fileptr)
+    for (uint32_t i = 0; i < workerCount; i++)
     {
-        LVN_CORE_ERROR("cannot open source file: %s", filepath);
-        return {};
+        LvnJobQueue* queue = new LvnJobQueue();
+        queue->index = i;
+        lvnctx->jobQueues.push_back(queue);
     }
 
-    fseek(fileptr, 0, SEEK_END);
-    long int size = ftell(fileptr);
-    fseek(fileptr, 0, SEEK_SET);
-
-    LvnVector<char> src(size);
-    fread(src.data(), sizeof(char), size, fileptr);
-    fclose(fileptr);
-
-    return LvnString(src.data(), src.size());
-}
+    // every queue exists before the first worker starts stealing from them
+    for (uint32_t i = 0; i < workerCount; i++)
+        lvnctx->jobThreads.push_back(new LvnThread(lvn::jobWorkerThread, lvnctx->jobQueues[i]));
 
-float getContextTime()
-{
-    return lvn::getContext()->contexTime.elapsed();
+    LVN_CORE_TRACE("job system started with %u worker threads", workerCount);
 }
 
-LvnData<uint8_t> loadFileSrcBin(const char* filepath)
+static void terminateJobSystem(LvnContext* lvnctx)
 {
-    FILE* fileptr = fopen(filepath, "rb");
-
-    if (!fileptr)
     {
-        LVN_CORE_ERROR("cannot open binary file: %s", filepath);
-        return {};
+        std::lock_guard<std::mutex> lock(lvnctx->jobSleepMutex);
+        lvnctx->jobStop = true;
     }
+    lvnctx->jobSleepCondition.notify_all();
 
-    fseek(fileptr, 0, SEEK_END);
-    long int size = ftell(fileptr);
-    fseek(fileptr, 0, SEEK_SET);
+    for (uint32_t i = 0; i < lvnctx->jobThreads.size(); i++)
+        delete lvnctx->jobThreads[i];
+    lvnctx->jobThreads.clear_free();
 
-    LvnVector<uint8_t> bin(size);
-    fread(bin.data(), sizeof(uint8_t), size, fileptr);
-    fclose(fileptr);
+    for (uint32_t i = 0; i < lvnctx->jobQueues.size(); i++)
+        delete lvnctx->jobQueues[i];
+    lvnctx->jobQueues.clear_free();
 
-    return LvnData<uint8_t>(bin.data(), bin.size());
+    if (!lvnctx->jobsWaiting.empty())
+        LVN_CORE_WARN("not all jobs have been run, %zu jobs are still waiting on a dependency that never finished", lvnctx->jobsWaiting.size());
+    lvnctx->jobsWaiting.clear_free();
 }
 
-void writeFileSrc(const char* filename, const char* src, LvnFileMode mode)
+static void* jobWorkerThread(void* arg)
 {
-    const char* filemode = "w";
-    if (mode == Lvn_FileMode_Write) filemode = "w";
-    else if (mode == Lvn_FileMode_Append) filemode = "a";
+    LvnJobQueue* queue = static_cast<LvnJobQueue*>(arg);
+    LvnContext* lvnctx = lvn::getContext();
+    s_JobThreadIndex = queue->index + 1;
 
-    FILE* fileptr = fopen(filename, filemode);
+    char threadName[32];
+    snprintf(threadName, sizeof(threadName), "job worker %u", queue->index);
+    lvn::profileSetThreadName(threadName);
 
-    if (!fileptr)
+    while (true)
     {
-        LVN_CORE_ERROR("cannot write to source file: %s", filename);
-        return;
-    }
+        if (lvn::runQueuedJob(lvnctx))
+            continue;
 
-    fprintf(fileptr, "%s", src);
-    fclose(fileptr);
+        std::unique_lock<std::mutex> lock(lvnctx->jobSleepMutex);
+        while (!lvnctx->jobStop && lvnctx->jobQueuedCount.load(std::memory_order_acquire) == 0)
+            lvnctx->jobSleepCondition.wait(lock);
+
+        // queued jobs are finished before stopping, jobs they submit are run as well
+        if (lvnctx->jobStop && lvnctx->jobQueuedCount.load(std::memory_order_acquire) == 0)
+            return nullptr;
+    }
 }
 
-LvnFont loadFontFromFileTTF(const char* filepath, uint32_t fontSize, const uint32_t* pCodepoints, uint32_t codepointCount, LvnLoadFontFlagBits flags)
+static void queueJob(LvnContext* lvnctx, const LvnJob& job)
 {
-    LvnFont font{};
+    if (job.dependency != nullptr && job.dependency->count.load(std::memory_order_acquire) > 0)
+    {
+        // checked again under the lock, the job that brings the dependency to zero releases waiting jobs under the same lock
+        LvnLockGaurd lock(lvnctx->jobWaitingMutex);
+        if (job.dependency->count.load(std::memory_order_acquire) > 0)
+        {
+            lvnctx->jobsWaiting.push_back(job);
+            return;
+        }
+    }
 
-    if (pCodepoints == nullptr)
+    if (lvnctx->jobQueues.empty())
     {
-        LvnContext* lvnctx = lvn::getContext();
-        pCodepoints = lvnctx->defaultCodePoints.data();
-        codepointCount = lvnctx->defaultCodePoints.size();
+        lvn::runJob(lvnctx, job);
+        return;
     }
 
-    FT_Library ft;
-    FT_Face face;
+    // workers keep the jobs they submit in their own queue, other threads spread theirs over every queue
+    uint32_t index = s_JobThreadIndex != 0
+        ? s_JobThreadIndex - 1
+        : lvnctx->jobSubmitIndex.fetch_add(1, std::memory_order_relaxed) % lvnctx->jobQueues.size();
 
-    if (FT_Init_FreeType(&ft))
+    LvnJobQueue* queue = lvnctx->jobQueues[index];
     {
-        LVN_CORE_ERROR("[freetype]: failed to load freetype library");
-        LVN_CORE_ASSERT(false, "failed to load freetype");
-        return font;
+        LvnSpinLockGaurd lock(queue->lock);
+        queue->jobs.push(job);
+        lvnctx->jobQueuedCount.fetch_add(1, std::memory_order_release);
     }
 
-    if (FT_New_Face(ft, filepath, 0, &face))
+    // taking the sleep lock orders the count with workers that are about to wait
     {
-        LVN_CORE_ERROR("[freetype]: failed to load font face!");
-        LVN_CORE_ASSERT(false, "failed to load font face");
-        return font;
+        std::lock_guard<std::mutex> lock(lvnctx->jobSleepMutex);
     }
+    lvnctx->jobSleepCondition.notify_one();
+}
 
-    FT_Set_Pixel_Sizes(face, 0, (FT_UInt)fontSize);
-
-    int maxDim = (1 + (face->size->metrics.height >> 6)) * ceilf(sqrtf(codepointCount));
-    int width = 1;
-    while (width < maxDim) width <<= 1;
-    int height = width;
-
-    // render glyphs to atlas
-    LvnVector<uint8_t> pixels(width * height);
-    int penx = 0, peny = 0;
-    const int padding = 2;
-    const int lineHeight = (face->size->metrics.height >> 6) + padding;
-
-    LvnVector<LvnFontGlyph> glyphs(codepointCount);
-
-    uint32_t loadFlags = FT_LOAD_RENDER;
-    if (flags & Lvn_LoadFont_NoHinting)
-        loadFlags |= FT_LOAD_NO_HINTING;
-    if (flags & Lvn_LoadFont_AutoHinting)
-        loadFlags |= FT_LOAD_FORCE_AUTOHINT;
-    if (flags & Lvn_LoadFont_TargetLight)
-        loadFlags |= FT_LOAD_TARGET_LIGHT;
-    if (flags & Lvn_LoadFont_TargetMono)
-        loadFlags |= FT_LOAD_TARGET_MONO | FT_LOAD_MONOCHROME;
+static bool runQueuedJob(LvnContext* lvnctx)
+{
+    uint32_t queueCount = lvnctx->jobQueues.size();
+    uint32_t first = s_JobThreadIndex != 0 ? s_JobThreadIndex - 1 : 0;
 
-    for (uint32_t i = 0; i < codepointCount; i++)
+    for (uint32_t i = 0; i < queueCount; i++)
     {
-        FT_Load_Char(face, pCodepoints[i], loadFlags);
-        FT_Bitmap* bmp = &face->glyph->bitmap;
+        uint32_t index = (first + i) % queueCount;
+        LvnJobQueue* queue = lvnctx->jobQueues[index];
 
-        if (penx + bmp->width + padding > width)
+        LvnJob job;
         {
-            penx = padding;
-            peny += lineHeight;
-        }
+            LvnSpinLockGaurd lock(queue->lock);
+            if (queue->jobs.empty())
+                continue;
 
-        if (bmp->pixel_mode == FT_PIXEL_MODE_MONO && flags & Lvn_LoadFont_TargetMono)
-        {
-            for (uint32_t row = 0; row < bmp->rows; ++row)
+            // the newest job of the own queue still has its data in cache, stolen jobs are the oldest
+            if (index + 1 == s_JobThreadIndex)
             {
-                for (uint32_t col = 0; col < bmp->width; ++col)
-                {
-                    int byteIndex = col / 8;
-                    int bitIndex = 7 - (col % 8);
-                    uint8_t byte = bmp->buffer[row * bmp->pitch + byteIndex];
-                    bool bitSet = (byte >> bitIndex) & 1;
-                    int x = penx + col;
-                    int y = peny + row;
-                    if (x < width && y < height)
-                        pixels[y * width + x] = bitSet ? 255 : 0;
-                }
+                job = queue->jobs.back();
+                queue->jobs.pop_back();
             }
-        }
-        else
-        {
-            for (uint32_t row = 0; row < bmp->rows; row++)
+            else
             {
-                for (uint32_t col = 0; col < bmp->width; col++)
-                {
-                    int x = penx + col;
-                    int y = peny + row;
-                    pixels[y * width + x] = bmp->buffer[row * abs(bmp->pitch) + col];
-                }
+                job = queue->jobs.front();
+                queue->jobs.pop();
             }
+            lvnctx->jobQueuedCount.fetch_sub(1, std::memory_order_relaxed);
         }
 
-
-        LvnFontGlyph glyph{};
-        glyph.uv.x0 = (float)penx / (float)width;
-        glyph.uv.y0 = (float)peny / (float)height;
-        glyph.uv.x1 = (float)(penx + bmp->width) / (float)width;
-        glyph.uv.y1 = (float)(peny + bmp->rows) / (float)height;
-
-        glyph.size.x = bmp->width;
-        glyph.size.y = bmp->rows;
-        glyph.bearing.x = face->glyph->bitmap_left;
-        glyph.bearing.y = face->glyph->bitmap_top;
-        glyph.advance = face->glyph->advance.x >> 6;
-        glyph.unicode = pCodepoints[i];
-
-        glyphs[i] = glyph;
-
-        penx += bmp->width + padding;
+        lvn::runJob(lvnctx, job);
+        return true;
     }
 
-    FT_Done_FreeType(ft);
-
-    LvnImageData atlas{};
-    atlas.width = width;
-    atlas.height = height;
-    atlas.channels = 1;
-    atlas.size = width * height;
-    atlas.pixels = LvnData<uint8_t>(pixels.data(), pixels.size());
-
-    font.atlas = atlas;
-    font.glyphs = LvnData<LvnFontGlyph>(glyphs.data(), glyphs.size());
-    font.codepoints = LvnData<uint32_t>(pCodepoints, codepointCount);
-    font.fontSize = fontSize;
-
-    return font;
+    return false;
 }
 
-// TODO: refactor font loading and duplicate code
-LvnFont loadFontFromFileTTFMemory(const uint8_t* fontData, uint64_t fontDataSize, uint32_t fontSize, const uint32_t* pCodepoints, uint32_t codepointCount, LvnLoadFontFlagBits flags)
+static void runJob(LvnContext* lvnctx, const LvnJob& job)
 {
-    LvnFont font{};
-
-    if (pCodepoints == nullptr)
-    {
-        LvnContext* lvnctx = lvn::getContext();
-        pCodepoints = lvnctx->defaultCodePoints.data();
-        codepointCount = lvnctx->defaultCodePoints.size();
-    }
-
-    FT_Library ft;
-    FT_Face face;
-
-    if (FT_Init_FreeType(&ft))
-    {
-        LVN_CORE_ERROR("[freetype]: failed to load freetype library");
-        LVN_CORE_ASSERT(false, "failed to load freetype");
-        return font;
-    }
-
-    if (FT_New_Memory_Face(ft, fontData, fontDataSize, 0, &face))
-    {
-        LVN_CORE_ERROR("[freetype]: failed to load font face!");
-        LVN_CORE_ASSERT(false, "failed to load font face");
-        return font;
-    }
-
-    FT_Set_Pixel_Sizes(face, 0, (FT_UInt)fontSize);
-
-    int maxDim = (1 + (face->size->metrics.height >> 6)) * ceilf(sqrtf(codepointCount));
-    int width = 1;
-    while (width < maxDim) width <<= 1;
-    int height = width;
-
-    // render glyphs to atlas
-    LvnVector<uint8_t> pixels(width * height);
-    int penx = 0, peny = 0;
-    const int padding = 2;
-    const int lineHeight = (face->size->metrics.height >> 6) + padding;
-
-    LvnVector<LvnFontGlyph> glyphs(codepointCount);
+    job.func(job.userData);
 
-    uint32_t loadFlags = FT_LOAD_RENDER;
-    if (flags & Lvn_LoadFont_NoHinting)
-        loadFlags |= FT_LOAD_NO_HINTING;
-    if (flags & Lvn_LoadFont_AutoHinting)
-        loadFlags |= FT_LOAD_FORCE_AUTOHINT;
-    if (flags & Lvn_LoadFont_TargetLight)
-        loadFlags |= FT_LOAD_TARGET_LIGHT;
-    if (flags & Lvn_LoadFont_TargetMono)
-        loadFlags |= FT_LOAD_TARGET_MONO | FT_LOAD_MONOCHROME;
+    if (job.counter != nullptr && job.counter->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        lvn::releaseWaitingJobs(lvnctx, job.counter);
+}
 
-    for (uint32_t i = 0; i < codepointCount; i++)
+static void releaseWaitingJobs(LvnContext* lvnctx, LvnJobCounter* counter)
+{
+    LvnVector<LvnJob> readyJobs;
     {
-        FT_Load_Char(face, pCodepoints[i], loadFlags);
-        FT_Bitmap* bmp = &face->glyph->bitmap;
+        LvnLockGaurd lock(lvnctx->jobWaitingMutex);
 
-        if (penx + bmp->width + padding > width)
-        {
-            penx = padding;
-            peny += lineHeight;
-        }
+        // the counter can be reused before the lock is taken, its jobs then release the waiting jobs when they finish
+        if (lvnctx->jobsWaiting.empty() || counter->count.load(std::memory_order_acquire) > 0)
+            return;
 
-        if (bmp->pixel_mode == FT_PIXEL_MODE_MONO && flags & Lvn_LoadFont_TargetMono)
+        for (uint32_t i = 0; i < lvnctx->jobsWaiting.size();)
         {
-            for (uint32_t row = 0; row < bmp->rows; ++row)
+            if (lvnctx->jobsWaiting[i].dependency == counter)
             {
-                for (uint32_t col = 0; col < bmp->width; ++col)
-                {
-                    int byteIndex = col / 8;
-                    int bitIndex = 7 - (col % 8);
-                    uint8_t byte = bmp->buffer[row * bmp->pitch + byteIndex];
-                    bool bitSet = (byte >> bitIndex) & 1;
-                    int x = penx + col;
-                    int y = peny + row;
-                    if (x < width && y < height)
-                        pixels[y * width + x] = bitSet ? 255 : 0;
-                }
+                readyJobs.push_back(lvnctx->jobsWaiting[i]);
+                lvnctx->jobsWaiting.erase_index(i);
             }
-        }
-        else
-        {
-            for (uint32_t row = 0; row < bmp->rows; row++)
+            else
             {
-                for (uint32_t col = 0; col < bmp->width; col++)
-                {
-                    int x = penx + col;
-                    int y = peny + row;
-                    pixels[y * width + x] = bmp->buffer[row * abs(bmp->pitch) + col];
-                }
+                i++;
             }
         }
+    }
 
+    for (uint32_t i = 0; i < readyJobs.size(); i++)
+        lvn::queueJob(lvnctx, readyJobs[i]);
+}
 
-        LvnFontGlyph glyph{};
-        glyph.uv.x0 = (float)penx / (float)width;
-        glyph.uv.y0 = (float)peny / (float)height;
-        glyph.uv.x1 = (float)(penx + bmp->width) / (float)width;
-        glyph.uv.y1 = (float)(peny + bmp->rows) / (float)height;
-
-        glyph.size.x = bmp->width;
-        glyph.size.y = bmp->rows;
-        glyph.bearing.x = face->glyph->bitmap_left;
-        glyph.bearing.y = face->glyph->bitmap_top;
-        glyph.advance = face->glyph->advance.x >> 6;
-
-        glyphs[i] = glyph;
+static void parallelForJob(void* arg)
+{
+    LvnParallelForRange* range = static_cast<LvnParallelForRange*>(arg);
+    range->func(range->start, range->end, range->userData);
+}
 
-        penx += bmp->width + padding;
-    }
+void jobSubmit(LvnJobFunc func, void* userData, LvnJobCounter* counter)
+{
+    lvn::jobSubmitAfter(func, userData, nullptr, counter);
+}
 
-    FT_Done_FreeType(ft);
+void jobSubmitAfter(LvnJobFunc func, void* userData, LvnJobCounter* dependency, LvnJobCounter* counter)
+{
+    LVN_CORE_ASSERT(func != nullptr, "job function cannot be nullptr");
+    LVN_CORE_ASSERT(dependency == nullptr || dependency != counter, "a job cannot depend on the counter it is counted by");
 
-    LvnImageData atlas{};
-    atlas.width = width;
-    atlas.height = height;
-    atlas.channels = 1;
-    atlas.size = width * height;
-    atlas.pixels = LvnData<uint8_t>(pixels.data(), pixels.size());
+    if (counter != nullptr)
+        counter->count.fetch_add(1, std::memory_order_relaxed);
 
-    font.atlas = atlas;
-    font.glyphs = LvnData<LvnFontGlyph>(glyphs.data(), glyphs.size());
-    font.codepoints = LvnData<uint32_t>(pCodepoints, codepointCount);
-    font.fontSize = fontSize;
+    LvnJob job{};
+    job.func = func;
+    job.userData = userData;
+    job.counter = counter;
+    job.dependency = dependency;
 
-    return font;
+    lvn::queueJob(lvn::getContext(), job);
 }
 
-LvnFontGlyph fontGetGlyph(const LvnFont& font, uint32_t codepoint)
+void jobWait(LvnJobCounter* counter)
 {
-    for (uint32_t i = 0; i < font.glyphs.size(); i++)
+    LvnContext* lvnctx = lvn::getContext();
+
+    // help with the queued jobs instead of blocking, the counted jobs may be among them
+    while (counter->count.load(std::memory_order_acquire) > 0)
     {
-        if (font.glyphs[i].unicode == codepoint)
-            return font.glyphs[i];
+        if (!lvn::runQueuedJob(lvnctx))
+            std::this_thread::yield();
     }
-
-    return font.glyphs[0];
 }
 
-uint32_t decodeCodepointUTF8(const char* str, uint32_t* next)
+void parallelFor(uint32_t count, uint32_t grainSize, LvnParallelForFunc func, void* userData)
 {
-    LVN_CORE_ASSERT(next, "next is nullptr");
+    if (count == 0) { return; }
 
-    const uint8_t *ptr = reinterpret_cast<const uint8_t*>(str);
-    uint32_t codepoint = 0x3f;
-    *next = 1;
+    LvnContext* lvnctx = lvn::getContext();
+    uint32_t threadCount = lvnctx->jobQueues.size() + 1;
 
-    if ((ptr[0] & 0xf8) == 0xf0)
-    {
-        // 4-byte sequence
-        if (((ptr[1] & 0xc0) ^ 0x80) || ((ptr[2] & 0xc0) ^ 0x80) || ((ptr[3] & 0xc0) ^ 0x80))
-            return codepoint;
-        codepoint = ((ptr[0] & 0x07) << 18) | ((ptr[1] & 0x3f) << 12) | ((ptr[2] & 0x3f) << 6) | (ptr[3] & 0x3f);
-        *next = 4;
-    }
-    else if ((ptr[0] & 0xf0) == 0xe0)
-    {
-        // 3-byte sequence
-        if (((ptr[1] & 0xc0) ^ 0x80) || ((ptr[2] & 0xc0) ^ 0x80))
-            return codepoint;
-        codepoint = ((ptr[0] & 0x0f) << 12) | ((ptr[1] & 0x3f) << 6) | (ptr[2] & 0x3f);
-        *next = 3;
-    }
-    else if ((ptr[0] & 0xe0) == 0xc0)
+    // a few ranges per thread so threads that finish early can steal from the others
+    if (grainSize == 0)
+        grainSize = count / (threadCount * 4) > 0 ? count / (threadCount * 4) : 1;
+
+    uint32_t rangeCount = count / grainSize + (count % grainSize != 0);
+    if (threadCount == 1 || rangeCount == 1)
     {
-        // 2-byte sequence
-        if (((ptr[1] & 0xc0) ^ 0x80))
-            return codepoint;
-        codepoint = ((ptr[0] & 0x1f) << 6) | (ptr[1] & 0x3f);
-        *next = 2;
+        func(0, count, userData);
+        return;
     }
-    else if (ptr[0] < 0x80)
+
+    LvnVector<LvnParallelForRange> ranges(rangeCount);
+    LvnJobCounter counter;
+
+    // the first range is run by the calling thread
+    for (uint32_t i = 1; i < rangeCount; i++)
     {
-        // 1-byte ASCII
-        codepoint = ptr[0];
-        *next = 1;
+        uint64_t end = (uint64_t)(i + 1) * grainSize;
+        ranges[i].func = func;
+        ranges[i].userData = userData;
+        ranges[i].start = i * grainSize;
+        ranges[i].end = end < count ? (uint32_t)end : count;
+        lvn::jobSubmit(lvn::parallelForJob, &ranges[i], &counter);
     }
 
-    return codepoint;
+    func(0, grainSize, userData);
+    lvn::jobWait(&counter);
 }
 
-LvnData<uint32_t> getDefaultSupportedCodepoints()
+uint32_t jobGetWorkerCount()
 {
-    return lvn::getContext()->defaultCodePoints;
+    return lvn::getContext()->jobThreads.size();
 }
 
-void* memAlloc(size_t size)
+uint32_t jobGetThreadIndex()
 {
-    if (size == 0) { return nullptr; }
-    void* allocmem = (*s_MemAllocFunc)(size, s_MemAllocUserData);
-    if (!allocmem) { LVN_CORE_ERROR("malloc failure, could not allocate memory!"); LVN_ABORT; }
-    memset(allocmem, 0, size);
-    if (s_LvnContext) { s_LvnContext->numMemoryAllocations++; }
-    return allocmem;
+    return s_JobThreadIndex;
 }
 
-void memFree(void* ptr)
+// ------------------------------------------------------------
+// [SECTION]: Date Time Functions
+// ------------------------------------------------------------
+
+// date functions share the thread's log time cache, localtime only runs when the second changed since the last call
+int dateGetYear()
 {
-    if (ptr == nullptr) { return; }
-    (*s_MemFreeFunc)(ptr, s_MemAllocUserData);
-    if (s_LvnContext) s_LvnContext->numMemoryAllocations--;
+    return lvn::dateGetLocalTime().tm.tm_year + 1900;
 }
-
-void* memRealloc(void* ptr, size_t size)
+int dateGetYear02d()
 {
-    if (!ptr) { return lvn::memAlloc(size); }
-    return (*s_MemReallocFunc)(ptr, size, s_MemAllocUserData);
+    return (lvn::dateGetLocalTime().tm.tm_year + 1900) % 100;
 }
-
-void setMemFuncs(LvnMemAllocFunc allocFunc, LvnMemFreeFunc freeFunc, LvnMemReallocFunc reallocFunc, void* userData)
+int dateGetMonth()
 {
-    s_MemAllocFunc = allocFunc;
-    s_MemFreeFunc = freeFunc;
-    s_MemReallocFunc = reallocFunc;
-    s_MemAllocUserData = userData;
+    return lvn::dateGetLocalTime().tm.tm_mon + 1;
 }
-
-LvnMemAllocFunc getMemAllocFunc()
+int dateGetDay()
 {
-    return s_MemAllocFunc;
+    return lvn::dateGetLocalTime().tm.tm_mday;
 }
-
-LvnMemFreeFunc getMemFreeFunc()
+int dateGetHour()
 {
-    return s_MemFreeFunc;
+    return lvn::dateGetLocalTime().tm.tm_hour;
 }
-
-LvnMemReallocFunc getMemReallocFunc()
+int dateGetHour12()
 {
-    return s_MemReallocFunc;
+    return ((lvn::dateGetLocalTime().tm.tm_hour + 11) % 12) + 1;
 }
-
-void* getMemUserData()
+int dateGetMinute()
 {
-    return s_MemAllocUserData;
+    return lvn::dateGetLocalTime().tm.tm_min;
+}
+int dateGetSecond()
+{
+    return lvn::dateGetLocalTime().tm.tm_sec;
 }
 
-/* [Logging] */
-const static LvnLogPattern s_LogPatterns[] =
+long long dateGetSecondsSinceEpoch()
 {
-    { '$', [](LvnLogMessage* msg) -> LvnString { return "\n"; } },
-    { 'n', [](LvnLogMessage* msg) -> LvnString { return msg->loggerName; } },
-    { 'l', [](LvnLogMessage* msg) -> LvnString { return getLogLevelName(msg->level); }},
-    { '#', [](LvnLogMessage* msg) -> LvnString { return getLogLevelColor(msg->level); }},
-    { '^', [](LvnLogMessage* msg) -> LvnString { return LVN_LOG_COLOR_RESET; }},
-    { 'v', [](LvnLogMessage* msg) -> LvnString { return msg->msg; }},
-    { '%', [](LvnLogMessage* msg) -> LvnString { return "%"; } },
-    { 'T', [](LvnLogMessage* msg) -> LvnString { return dateGetTimeHHMMSS(); } },
-    { 't', [](LvnLogMessage* msg) -> LvnString { return dateGetTime12HHMMSS(); } },
-    { 'Y', [](LvnLogMessage* msg) -> LvnString { return dateGetYearStr(); }},
-    { 'y', [](LvnLogMessage* msg) -> LvnString { return dateGetYear02dStr(); } },
-    { 'm', [](LvnLogMessage* msg) -> LvnString { return dateGetMonthNumStr(); } },
-    { 'B', [](LvnLogMessage* msg) -> LvnString { return dateGetMonthName(); } },
-    { 'b', [](LvnLogMessage* msg) -> LvnString { return dateGetMonthNameShort(); } },
-    { 'd', [](LvnLogMessage* msg) -> LvnString { return dateGetDayNumStr(); } },
-    { 'A', [](LvnLogMessage* msg) -> LvnString { return dateGetWeekDayName(); } },
-    { 'a', [](LvnLogMessage* msg) -> LvnString { return dateGetWeekDayNameShort(); } },
-    { 'H', [](LvnLogMessage* msg) -> LvnString { return dateGetHourNumStr(); } },
-    { 'h', [](LvnLogMessage* msg) -> LvnString { return dateGetHour12NumStr(); } },
-    { 'M', [](LvnLogMessage* msg) -> LvnString { return dateGetMinuteNumStr(); } },
-    { 'S', [](LvnLogMessage* msg) -> LvnString { return dateGetSecondNumStr(); } },
-    { 'P', [](LvnLogMessage* msg) -> LvnString { return dateGetTimeMeridiem(); } },
-    { 'p', [](LvnLogMessage* msg) -> LvnString { return dateGetTimeMeridiemLower(); }},
-};
+    return time(NULL);
+}
 
-static LvnResult initLogging(LvnContextCreateInfo* createInfo)
+static const char* const s_MonthName[12] = { "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December" };
+static const char* const s_MonthNameShort[12] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+static const char* const s_WeekDayName[7] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+static const char* const s_WeekDayNameShort[7] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+
+const char* dateGetMonthName()
 {
-    LvnContext* lvnctx = lvn::getContext();
-    lvnctx->enableCoreLogging = !createInfo->logging.disableCoreLogging;
+    return s_MonthName[lvn::dateGetLocalTime().tm.tm_mon];
+}
+const char* dateGetMonthNameShort()
+{
+    return s_MonthNameShort[lvn::dateGetLocalTime().tm.tm_mon];
+}
+const char* dateGetWeekDayName()
+{
+    return s_WeekDayName[lvn::dateGetLocalTime().tm.tm_wday];
+}
+const char* dateGetWeekDayNameShort()
+{
+    return s_WeekDayNameShort[lvn::dateGetLocalTime().tm.tm_wday];
+}
+const char* dateGetTimeMeridiem()
+{
+    if (lvn::dateGetLocalTime().tm.tm_hour < 12)
+        return "AM";
+    else
+        return "PM";
+}
+const char* dateGetTimeMeridiemLower()
+{
+    if (lvn::dateGetLocalTime().tm.tm_hour < 12)
+        return "am";
+    else
+        return "pm";
+}
 
-    if (createInfo->logging.enableLogging)
+LvnString dateGetTimeHHMMSS()
+{
+    return LvnString(lvn::dateGetLocalTime().time);
+}
+LvnString dateGetTime12HHMMSS()
+{
+    return LvnString(lvn::dateGetLocalTime().time12);
+}
+LvnString dateGetYearStr()
+{
+    return LvnString(lvn::dateGetLocalTime().year);
+}
+LvnString dateGetYear02dStr()
+{
+    return LvnString(lvn::dateGetLocalTime().year02d);
+}
+LvnString dateGetMonthNumStr()
+{
+    return LvnString(lvn::dateGetLocalTime().month);
+}
+LvnString dateGetDayNumStr()
+{
+    return LvnString(lvn::dateGetLocalTime().day);
+}
+LvnString dateGetHourNumStr()
+{
+    return LvnString(lvn::dateGetLocalTime().hour);
+}
+LvnString dateGetHour12NumStr()
+{
+    return LvnString(lvn::dateGetLocalTime().hour12);
+}
+LvnString dateGetMinuteNumStr()
+{
+    return LvnString(lvn::dateGetLocalTime().minute);
+}
+LvnString dateGetSecondNumStr()
+{
+    return LvnString(lvn::dateGetLocalTime().second);
+}
+
+LvnString loadFileSrc(const char* filepath)
+{
+    LvnBin packed;
+    if (lvn::vfsReadFile(filepath, &packed))
+        return LvnString(reinterpret_cast<const char*>(packed.data()), packed.size());
+
+    FILE* fileptr = fopen(filepath, "r");
+
+    if (!fileptr)
     {
-        lvnctx->logging = true;
+        LVN_CORE_ERROR("cannot open source file: %s", filepath);
+        return {};
+    }
 
-        lvnctx->coreLogger.loggerName = "CORE";
+    fseek(fileptr, 0, SEEK_END);
+    long int size = ftell(fileptr);
+    fseek(fileptr, 0, SEEK_SET);
 
-        if (!lvnctx->appName.empty())
-            lvnctx->clientLogger.loggerName = lvnctx->appName;
-        else
-            lvnctx->clientLogger.loggerName = "CLIENT";
+    LvnVector<char> src(size);
+    fread(src.data(), sizeof(char), size, fileptr);
+    fclose(fileptr);
 
-        lvnctx->coreLogger.logLevel = lvnctx->clientLogger.logLevel = Lvn_LogLevel_None;
-        lvnctx->coreLogger.logPatternFormat = lvnctx->clientLogger.logPatternFormat = LVN_DEFAULT_LOG_PATTERN;
-        lvnctx->coreLogger.logPatterns = lvnctx->clientLogger.logPatterns = lvn::logParseFormat(LVN_DEFAULT_LOG_PATTERN);
+    return LvnString(src.data(), src.size());
+}
 
-        #ifdef LVN_PLATFORM_WINDOWS
-        enableLogANSIcodeColors();
-        #endif
+float getContextTime()
+{
+    return static_cast<float>(static_cast<double>(lvn::getContextTimeNs()) * 0.001 * 0.001 * 0.001);
+}
 
-        return Lvn_Result_Success;
+uint64_t getContextTimeNs()
+{
+    return lvn::getMonotonicTimeNs() - lvn::getContext()->contextStartTime;
+}
+
+uint64_t getMonotonicTimeNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+LvnData<uint8_t> loadFileSrcBin(const char* filepath)
+{
+    // packed files may be views into the mapped pack, the returned data always owns its copy
+    LvnBin packed;
+    if (lvn::vfsReadFile(filepath, &packed))
+        return packed.owns_data() ? lvn::move(packed) : LvnBin(packed.data(), packed.size());
+
+    FILE* fileptr = fopen(filepath, "rb");
+
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("cannot open binary file: %s", filepath);
+        return {};
     }
 
-    return Lvn_Result_AlreadyCalled;
+    fseek(fileptr, 0, SEEK_END);
+    long int size = ftell(fileptr);
+    fseek(fileptr, 0, SEEK_SET);
+
+    LvnVector<uint8_t> bin(size);
+    fread(bin.data(), sizeof(uint8_t), size, fileptr);
+    fclose(fileptr);
+
+    return LvnData<uint8_t>(lvn::move(bin));
 }
 
-static void terminateLogging()
+static void unmapFile(void* ptr, void* userData)
 {
-    LvnContext* lvnctx = lvn::getContext();
+#ifdef LVN_PLATFORM_WINDOWS
+    UnmapViewOfFile(ptr);
+#else
+    munmap(ptr, reinterpret_cast<size_t>(userData)); // userData holds the length of the mapping
+#endif
+}
 
-    if (lvnctx->coreLogger.logfile.logToFile)
+LvnBin loadFileMapped(const char* filepath)
+{
+    LvnBin packed;
+    if (lvn::vfsReadFile(filepath, &packed))
+        return packed;
+
+    return lvn::mapFile(filepath);
+}
+
+static LvnBin mapFile(const char* filepath)
+{
+#ifdef LVN_PLATFORM_WINDOWS
+    HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
     {
-        fclose(lvnctx->coreLogger.logfile.fileptr);
-        lvnctx->coreLogger.logfile.fileptr = nullptr;
+        LVN_CORE_ERROR("cannot open binary file: %s", filepath);
+        return {};
     }
-    if (lvnctx->clientLogger.logfile.logToFile)
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return {};
+    }
+
+    // the view keeps the mapping alive, both handles can be closed once it is mapped
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+    if (mapping) { CloseHandle(mapping); }
+    CloseHandle(file);
+
+    if (!data)
+    {
+        LVN_CORE_ERROR("failed to map binary file: %s", filepath);
+        return {};
+    }
+
+    size_t size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int file = open(filepath, O_RDONLY);
+    if (file < 0)
+    {
+        LVN_CORE_ERROR("cannot open binary file: %s", filepath);
+        return {};
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(file);
+        return {};
+    }
+
+    // private mapping so writes through the returned data stay in memory, the descriptor is not needed once mapped
+    size_t size = static_cast<size_t>(fileStat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (data == MAP_FAILED)
     {
-        fclose(lvnctx->clientLogger.logfile.fileptr);
-        lvnctx->clientLogger.logfile.fileptr = nullptr;
+        LVN_CORE_ERROR("failed to map binary file: %s", filepath);
+        return {};
     }
+#endif
+
+    return LvnBin(static_cast<uint8_t*>(data), size, lvn::unmapFile, reinterpret_cast<void*>(size));
 }
 
-static LvnVector<LvnLogPattern> logParseFormat(const char* fmt)
+LvnResult loadFileChunksAsync(const char* filepath, uint64_t chunkSize, LvnFileChunkFunc func, void* userData, LvnJobCounter* counter)
 {
-    if (!fmt || !*fmt) { return {}; }
+    LVN_CORE_ASSERT(func != nullptr, "file chunk function cannot be nullptr");
+    LVN_CORE_ASSERT(chunkSize > 0, "file chunk size cannot be zero");
 
-    LvnVector<LvnLogPattern> patterns;
+    // the file is opened here so a missing file is reported to the caller instead of on the io thread
+    FILE* fileptr = fopen(filepath, "rb");
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("cannot open binary file: %s", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    LvnIoRequest request{};
+    request.type = Lvn_IoRequest_ReadChunks;
+    request.file = fileptr;
+    request.chunkSize = chunkSize;
+    request.chunkFunc = func;
+    request.userData = userData;
+    request.counter = counter;
+
+    lvn::submitIoRequest(lvn::move(request));
+    return Lvn_Result_Success;
+}
+
+void loadFileAsync(const char* filepath, LvnFileReadFunc func, void* userData, LvnJobCounter* counter)
+{
+    LVN_CORE_ASSERT(func != nullptr, "file read function cannot be nullptr");
+
+    LvnIoRequest request{};
+    request.type = Lvn_IoRequest_Read;
+    request.filepath = filepath;
+    request.readFunc = func;
+    request.userData = userData;
+    request.counter = counter;
+
+    lvn::submitIoRequest(lvn::move(request));
+}
+
+void writeFileAsync(const char* filepath, const void* data, uint64_t size, LvnFileMode mode, LvnFileWriteFunc func, void* userData, LvnJobCounter* counter)
+{
+    LvnIoRequest request{};
+    request.type = Lvn_IoRequest_Write;
+    request.filepath = filepath;
+    request.data = LvnBin(static_cast<const uint8_t*>(data), size);
+    request.mode = mode;
+    request.writeFunc = func;
+    request.userData = userData;
+    request.counter = counter;
+
+    lvn::submitIoRequest(lvn::move(request));
+}
+
+void fileWaitIdle()
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    std::unique_lock<std::mutex> lock(lvnctx->ioMutex);
+    while (lvnctx->ioThread != nullptr && (!lvnctx->ioRequests.empty() || lvnctx->ioBusy))
+        lvnctx->ioCondition.wait(lock);
+}
+
+static void initIoService(LvnContext* lvnctx)
+{
+    lvnctx->ioThread = nullptr;
+    lvnctx->ioBusy = false;
+    lvnctx->ioStop = false;
+
+    if (!lvnctx->multithreading)
+        return;
+
+    lvnctx->ioThread = new LvnThread(lvn::ioThread, lvnctx);
+}
+
+static void terminateIoService(LvnContext* lvnctx)
+{
+    LvnThread* thread = lvnctx->ioThread;
+    if (thread == nullptr) { return; }
 
-    for (uint32_t i = 0; i < strlen(fmt) - 1; i++)
     {
-        if (fmt[i] != '%') // Other characters in format
+        std::lock_guard<std::mutex> lock(lvnctx->ioMutex);
+        lvnctx->ioStop = true;
+    }
+    lvnctx->ioCondition.notify_all();
+
+    delete thread;
+    lvnctx->ioRequests.clear_free();
+}
+
+static void* ioThread(void* arg)
+{
+    LvnContext* lvnctx = static_cast<LvnContext*>(arg);
+
+    std::unique_lock<std::mutex> lock(lvnctx->ioMutex);
+    while (true)
+    {
+        while (!lvnctx->ioStop && lvnctx->ioRequests.empty())
+            lvnctx->ioCondition.wait(lock);
+
+        // queued requests are finished before stopping so log files are complete, requests submitted after this run inline
+        if (lvnctx->ioRequests.empty())
         {
-            LvnLogPattern pattern = { /* .symbol = */ fmt[i], /* .func = */ nullptr };
-            patterns.push_back(pattern);
-            continue;
+            lvnctx->ioThread = nullptr;
+            lvnctx->ioCondition.notify_all();
+            return nullptr;
         }
 
-        // find pattern with matching symbol
-        for (uint32_t j = 0; j < sizeof(s_LogPatterns) / sizeof(LvnLogPattern); j++)
-        {
-            if (fmt[i + 1] != s_LogPatterns[j].symbol)
-                continue;
+        LvnIoRequest request = lvn::move(lvnctx->ioRequests.front());
+        lvnctx->ioRequests.pop();
+        lvnctx->ioBusy = true;
 
-            patterns.push_back(s_LogPatterns[j]);
+        lock.unlock();
+        lvn::runIoRequest(request);
+        lock.lock();
+
+        lvnctx->ioBusy = false;
+        lvnctx->ioCondition.notify_all();
+    }
+}
+
+static void submitIoRequest(LvnIoRequest&& request)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (request.counter != nullptr)
+        request.counter->count.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(lvnctx->ioMutex);
+        if (lvnctx->ioThread != nullptr)
+        {
+            lvnctx->ioRequests.push(lvn::move(request));
+            lvnctx->ioCondition.notify_all();
+            return;
         }
+    }
 
-        // find and add user defined patterns
-        for (uint32_t j = 0; j < s_LvnContext->userLogPatterns.size(); j++)
+    lvn::runIoRequest(request);
+}
+
+static void runIoRequest(LvnIoRequest& request)
+{
+    switch (request.type)
+    {
+        case Lvn_IoRequest_Read:
         {
-            if (fmt[i + 1] != s_LvnContext->userLogPatterns[j].symbol)
-                continue;
+            LvnBin data;
+            bool read = false;
 
-            patterns.push_back(s_LvnContext->userLogPatterns[j]);
-        }
+            FILE* fileptr = fopen(request.filepath.c_str(), "rb");
+            if (fileptr && fseek(fileptr, 0, SEEK_END) == 0)
+            {
+                long int size = ftell(fileptr);
+                fseek(fileptr, 0, SEEK_SET);
+
+                if (size >= 0)
+                {
+                    data = LvnBin(static_cast<size_t>(size));
+                    read = fread(data.data(), 1, data.size(), fileptr) == data.size();
+                }
+            }
+            if (fileptr) { fclose(fileptr); }
+
+            if (!read)
+            {
+                LVN_CORE_ERROR("cannot read file: %s", request.filepath.c_str());
+                data = LvnBin();
+            }
+
+            request.readFunc(&data, read ? Lvn_Result_Success : Lvn_Result_Failure, request.userData);
+            break;
+        }
+        case Lvn_IoRequest_ReadChunks:
+        {
+            uint8_t* chunk = static_cast<uint8_t*>(lvn::memAlloc(request.chunkSize));
+            uint64_t offset = 0;
+
+            size_t readSize;
+            while ((readSize = fread(chunk, 1, request.chunkSize, request.file)) > 0)
+            {
+                request.chunkFunc(chunk, offset, readSize, request.userData);
+                offset += readSize;
+            }
+
+            if (ferror(request.file))
+                LVN_CORE_ERROR("failed to read file chunk at offset %llu", (unsigned long long)offset);
+
+            fclose(request.file);
+            lvn::memFree(chunk);
+            break;
+        }
+        case Lvn_IoRequest_Write:
+        {
+            FILE* fileptr = fopen(request.filepath.c_str(), request.mode == Lvn_FileMode_Append ? "ab" : "wb");
+            bool written = fileptr && fwrite(request.data.data(), 1, request.data.size(), fileptr) == request.data.size();
+            if (fileptr) { fclose(fileptr); }
+
+            if (!written)
+                LVN_CORE_ERROR("cannot write to file: %s", request.filepath.c_str());
+
+            if (request.writeFunc)
+                request.writeFunc(written ? Lvn_Result_Success : Lvn_Result_Failure, request.userData);
+            break;
+        }
+        case Lvn_IoRequest_WriteStream:
+        {
+            fwrite(request.data.data(), 1, request.data.size(), request.file);
+            break;
+        }
+        case Lvn_IoRequest_CloseStream:
+        {
+            fclose(request.file);
+            break;
+        }
+    }
+
+    if (request.counter != nullptr)
+        request.counter->count.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// log files are written to and closed through the io queue so their writes stay in order
+static void writeFileStreamAsync(FILE* file, const char* data, size_t size)
+{
+    LvnIoRequest request{};
+    request.type = Lvn_IoRequest_WriteStream;
+    request.file = file;
+    request.data = LvnBin(reinterpret_cast<const uint8_t*>(data), size);
+
+    lvn::submitIoRequest(lvn::move(request));
+}
+
+static void closeFileStreamAsync(FILE* file, LvnJobCounter* counter)
+{
+    if (file == nullptr) { return; }
+
+    LvnIoRequest request{};
+    request.type = Lvn_IoRequest_CloseStream;
+    request.file = file;
+    request.counter = counter;
+
+    lvn::submitIoRequest(lvn::move(request));
+}
+
+static LvnString vfsNormalizePath(const char* filepath)
+{
+    if (filepath[0] == '.' && (filepath[1] == '/' || filepath[1] == '\\'))
+        filepath += 2;
+
+    LvnString path(filepath);
+    for (uint32_t i = 0; i < path.size(); i++)
+    {
+        if (path[i] == '\\')
+            path[i] = '/';
+    }
+
+    return path;
+}
+
+static uint64_t vfsHashPath(const char* path, size_t length)
+{
+    return LvnStringHash()(LvnStringView(path, length));
+}
+
+static int comparePackEntries(const void* a, const void* b)
+{
+    uint64_t hashA = static_cast<const LvnPackEntry*>(a)->pathHash;
+    uint64_t hashB = static_cast<const LvnPackEntry*>(b)->pathHash;
+    return hashA < hashB ? -1 : (hashA > hashB ? 1 : 0);
+}
+
+LvnResult packBuild(const char* packPath, const char* const* filepaths, uint32_t fileCount, LvnPackCompression compression)
+{
+    FILE* fileptr = fopen(packPath, "wb");
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("packBuild(const char*, const char* const*, uint32_t, LvnPackCompression) | cannot open pack file for writing: %s", packPath);
+        return Lvn_Result_Failure;
+    }
+
+    static const uint8_t s_Padding[LVN_PACK_ALIGNMENT] = {};
+
+    LvnPackHeader header{};
+    header.magic = LVN_PACK_MAGIC;
+    header.version = LVN_PACK_VERSION;
+    header.entryCount = fileCount;
+    header.alignment = LVN_PACK_ALIGNMENT;
+
+    LvnVector<LvnPackEntry> entries(fileCount);
+    LvnVector<char> strings;
+    uint64_t offset = sizeof(LvnPackHeader);
+    bool failed = fwrite(&header, sizeof(LvnPackHeader), 1, fileptr) != 1;
+
+    for (uint32_t i = 0; i < fileCount && !failed; i++)
+    {
+        LvnString path = lvn::vfsNormalizePath(filepaths[i]);
+        LvnBin data = lvn::mapFile(filepaths[i]);
+        if (data.size() == 0)
+        {
+            LVN_CORE_ERROR("packBuild(const char*, const char* const*, uint32_t, LvnPackCompression) | cannot read file or file is empty: %s", filepaths[i]);
+            failed = true;
+            break;
+        }
+
+        LvnPackEntry& entry = entries[i];
+        entry.pathHash = lvn::vfsHashPath(path.c_str(), path.size());
+        entry.pathOffset = static_cast<uint32_t>(strings.size());
+        entry.pathLength = static_cast<uint32_t>(path.size());
+        entry.size = data.size();
+        strings.push_range(path.c_str(), path.size());
+
+        // keep the compressed data only when it saves space
+        const uint8_t* storedData = data.data();
+        entry.storedSize = data.size();
+        entry.compression = Lvn_PackCompression_None;
+
+        unsigned char* compressed = nullptr;
+        if (compression == Lvn_PackCompression_Deflate && data.size() <= INT32_MAX)
+        {
+            int compressedSize = 0;
+            compressed = stbi_zlib_compress(data.data(), static_cast<int>(data.size()), &compressedSize, 8);
+            if (compressed && static_cast<uint64_t>(compressedSize) < data.size())
+            {
+                storedData = compressed;
+                entry.storedSize = compressedSize;
+                entry.compression = Lvn_PackCompression_Deflate;
+            }
+        }
+
+        // file data starts at the alignment so uncompressed files can be read in place from the mapped pack
+        uint64_t padding = (LVN_PACK_ALIGNMENT - offset % LVN_PACK_ALIGNMENT) % LVN_PACK_ALIGNMENT;
+        entry.dataOffset = offset + padding;
+
+        failed = fwrite(s_Padding, 1, padding, fileptr) != padding || fwrite(storedData, 1, entry.storedSize, fileptr) != entry.storedSize;
+        offset = entry.dataOffset + entry.storedSize;
+
+        if (compressed) { lvn::memFree(compressed); }
+    }
+
+    if (!failed)
+    {
+        qsort(entries.data(), entries.size(), sizeof(LvnPackEntry), lvn::comparePackEntries);
+
+        // the entry table is read in place from the mapped pack, keep it aligned as well
+        uint64_t padding = (LVN_PACK_ALIGNMENT - offset % LVN_PACK_ALIGNMENT) % LVN_PACK_ALIGNMENT;
+        failed = fwrite(s_Padding, 1, padding, fileptr) != padding;
+        offset += padding;
+
+        header.entriesOffset = offset;
+        header.stringsOffset = offset + entries.size() * sizeof(LvnPackEntry);
+        header.stringsSize = strings.size();
+
+        failed = failed
+            || fwrite(entries.data(), sizeof(LvnPackEntry), entries.size(), fileptr) != entries.size()
+            || fwrite(strings.data(), 1, strings.size(), fileptr) != strings.size()
+            || fseek(fileptr, 0, SEEK_SET) != 0
+            || fwrite(&header, sizeof(LvnPackHeader), 1, fileptr) != 1;
+    }
+
+    fclose(fileptr);
+
+    if (failed)
+    {
+        LVN_CORE_ERROR("packBuild(const char*, const char* const*, uint32_t, LvnPackCompression) | failed to write pack file: %s", packPath);
+        remove(packPath);
+        return Lvn_Result_Failure;
+    }
+
+    LVN_CORE_TRACE("built pack file: %s, files: %u, total size: %llu bytes", packPath, fileCount, (unsigned long long)(header.stringsOffset + header.stringsSize));
+    return Lvn_Result_Success;
+}
+
+LvnResult vfsMountPack(const char* packPath)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    LvnBin file = lvn::mapFile(packPath);
+    if (file.size() < sizeof(LvnPackHeader))
+    {
+        LVN_CORE_ERROR("vfsMountPack(const char*) | cannot read pack file: %s", packPath);
+        return Lvn_Result_Failure;
+    }
+
+    LvnPackHeader header;
+    memcpy(&header, file.data(), sizeof(LvnPackHeader));
+
+    bool valid = header.magic == LVN_PACK_MAGIC && header.version == LVN_PACK_VERSION && header.entriesOffset % alignof(LvnPackEntry) == 0
+        && header.entriesOffset + (uint64_t)header.entryCount * sizeof(LvnPackEntry) <= header.stringsOffset
+        && header.stringsOffset + header.stringsSize <= file.size();
+
+    const LvnPackEntry* entries = reinterpret_cast<const LvnPackEntry*>(file.data() + header.entriesOffset);
+    for (uint32_t i = 0; i < header.entryCount && valid; i++)
+    {
+        valid = entries[i].dataOffset + entries[i].storedSize <= header.entriesOffset
+            && (uint64_t)entries[i].pathOffset + entries[i].pathLength <= header.stringsSize
+            && (entries[i].compression == Lvn_PackCompression_None ? entries[i].storedSize == entries[i].size : entries[i].compression == Lvn_PackCompression_Deflate);
+    }
+
+    if (!valid)
+    {
+        LVN_CORE_ERROR("vfsMountPack(const char*) | pack file is corrupt or was built by a different version: %s", packPath);
+        return Lvn_Result_Failure;
+    }
+
+    LvnPack* pack = new LvnPack();
+    pack->filepath = packPath;
+    pack->entries = entries;
+    pack->strings = reinterpret_cast<const char*>(file.data() + header.stringsOffset);
+    pack->entryCount = header.entryCount;
+    pack->file = lvn::move(file);
+
+    LvnWriteLockGaurd lock(lvnctx->packMutex);
+    lvnctx->packs.push_back(pack);
+
+    LVN_CORE_TRACE("mounted pack file: %s, files: %u", packPath, header.entryCount);
+    return Lvn_Result_Success;
+}
+
+void vfsUnmountPack(const char* packPath)
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnWriteLockGaurd lock(lvnctx->packMutex);
+
+    for (uint32_t i = lvnctx->packs.size(); i-- > 0;)
+    {
+        if (lvnctx->packs[i]->filepath == packPath)
+        {
+            delete lvnctx->packs[i];
+            lvnctx->packs.erase(lvnctx->packs.begin() + i);
+            return;
+        }
+    }
+
+    LVN_CORE_WARN("vfsUnmountPack(const char*) | pack file was not mounted: %s", packPath);
+}
+
+static void vfsUnmountAll(LvnContext* lvnctx)
+{
+    for (uint32_t i = 0; i < lvnctx->packs.size(); i++)
+        delete lvnctx->packs[i];
+    lvnctx->packs.clear_free();
+}
+
+// packs are searched from the last mounted, the pack mutex must be held while the entry is used
+static const LvnPackEntry* vfsFindEntry(LvnContext* lvnctx, const char* filepath, const LvnPack** pPack)
+{
+    if (lvnctx->packs.empty()) { return nullptr; }
+
+    LvnString path = lvn::vfsNormalizePath(filepath);
+    uint64_t hash = lvn::vfsHashPath(path.c_str(), path.size());
+
+    for (uint32_t i = lvnctx->packs.size(); i-- > 0;)
+    {
+        const LvnPack* pack = lvnctx->packs[i];
+
+        // lower bound of the hash in the sorted entries, equal hashes are compared by path
+        uint32_t low = 0, high = pack->entryCount;
+        while (low < high)
+        {
+            uint32_t mid = low + (high - low) / 2;
+            if (pack->entries[mid].pathHash < hash) { low = mid + 1; }
+            else { high = mid; }
+        }
+
+        for (uint32_t j = low; j < pack->entryCount && pack->entries[j].pathHash == hash; j++)
+        {
+            const LvnPackEntry& entry = pack->entries[j];
+            if (entry.pathLength == path.size() && memcmp(pack->strings + entry.pathOffset, path.c_str(), path.size()) == 0)
+            {
+                *pPack = pack;
+                return &entry;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+// returns false if no mounted pack has the file, uncompressed files are returned as views into the pack
+static bool vfsReadFile(const char* filepath, LvnBin* data)
+{
+    // file functions are also used without a context, there are no packs to search then
+    LvnContext* lvnctx = s_LvnContext;
+    if (lvnctx == nullptr) { return false; }
+
+    LvnSharedLockGaurd lock(lvnctx->packMutex);
+
+    const LvnPack* pack = nullptr;
+    const LvnPackEntry* entry = lvn::vfsFindEntry(lvnctx, filepath, &pack);
+    if (!entry) { return false; }
+
+    const uint8_t* stored = pack->file.data() + entry->dataOffset;
+    if (entry->compression == Lvn_PackCompression_None)
+    {
+        *data = LvnBin::view(stored, entry->size);
+        return true;
+    }
+
+    LvnBin decompressed(entry->size);
+    int size = stbi_zlib_decode_buffer(reinterpret_cast<char*>(decompressed.data()), static_cast<int>(entry->size), reinterpret_cast<const char*>(stored), static_cast<int>(entry->storedSize));
+    if (size < 0 || static_cast<uint64_t>(size) != entry->size)
+    {
+        LVN_CORE_ERROR("failed to decompress file: %s, from pack: %s", filepath, pack->filepath.c_str());
+        *data = LvnBin();
+        return true;
+    }
+
+    *data = lvn::move(decompressed);
+    return true;
+}
+
+bool vfsFileExists(const char* filepath)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    {
+        LvnSharedLockGaurd lock(lvnctx->packMutex);
+        const LvnPack* pack = nullptr;
+        if (lvn::vfsFindEntry(lvnctx, filepath, &pack))
+            return true;
+    }
+
+    FILE* fileptr = fopen(filepath, "rb");
+    if (!fileptr) { return false; }
+    fclose(fileptr);
+    return true;
+}
+
+void writeFileSrc(const char* filename, const char* src, LvnFileMode mode)
+{
+    const char* filemode = "w";
+    if (mode == Lvn_FileMode_Write) filemode = "w";
+    else if (mode == Lvn_FileMode_Append) filemode = "a";
+
+    FILE* fileptr = fopen(filename, filemode);
+
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("cannot write to source file: %s", filename);
+        return;
+    }
+
+    fprintf(fileptr, "%s", src);
+    fclose(fileptr);
+}
+
+static bool fontRasterFaceInit(LvnFontRasterFace* rasterFace, const LvnFontRasterData* raster)
+{
+    if (FT_Init_FreeType(&rasterFace->library))
+        return false;
+
+    if (FT_New_Memory_Face(rasterFace->library, raster->fontData, raster->fontDataSize, 0, &rasterFace->face))
+    {
+        FT_Done_FreeType(rasterFace->library);
+        return false;
+    }
+
+    FT_Set_Pixel_Sizes(rasterFace->face, 0, (FT_UInt)raster->fontSize);
+
+    // sdf glyph bitmaps have a border of spread pixels around the outline
+    if (raster->sdfSpread)
+        FT_Property_Set(rasterFace->library, "sdf", "spread", &raster->sdfSpread);
+
+    rasterFace->loaded = true;
+    return true;
+}
+
+static void fontRasterGlyphs(uint32_t start, uint32_t end, void* userData)
+{
+    const LvnFontRasterData* raster = static_cast<const LvnFontRasterData*>(userData);
+
+    // freetype faces cannot be shared between threads, each thread index has its own face created on first use
+    LvnFontRasterFace* rasterFace = &raster->faces[lvn::jobGetThreadIndex()];
+    if (!rasterFace->loaded && !lvn::fontRasterFaceInit(rasterFace, raster))
+    {
+        LVN_CORE_ERROR("[freetype]: failed to load font face for glyph rasterization");
+        return;
+    }
+
+    FT_Face face = rasterFace->face;
+
+    for (uint32_t i = start; i < end; i++)
+    {
+        LvnFontRasterGlyph& glyph = raster->glyphs[i];
+
+        FT_Load_Char(face, raster->pCodepoints[i], raster->loadFlags);
+        if (raster->sdfSpread)
+            FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF);
+
+        FT_Bitmap* bmp = &face->glyph->bitmap;
+
+        glyph.width = bmp->width;
+        glyph.rows = bmp->rows;
+        glyph.bearingX = face->glyph->bitmap_left;
+        glyph.bearingY = face->glyph->bitmap_top;
+        glyph.advance = face->glyph->advance.x >> 6;
+        glyph.bitmap.resize((size_t)bmp->width * bmp->rows);
+
+        // mono bitmaps hold one bit per pixel and are expanded to 8 bit coverage
+        if (bmp->pixel_mode == FT_PIXEL_MODE_MONO && raster->mono)
+        {
+            for (uint32_t row = 0; row < bmp->rows; row++)
+            {
+                for (uint32_t col = 0; col < bmp->width; col++)
+                {
+                    uint8_t byte = bmp->buffer[row * bmp->pitch + col / 8];
+                    glyph.bitmap[row * bmp->width + col] = ((byte >> (7 - (col % 8))) & 1) ? 255 : 0;
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t row = 0; row < bmp->rows; row++)
+                memcpy(&glyph.bitmap[row * bmp->width], &bmp->buffer[row * abs(bmp->pitch)], bmp->width);
+        }
+    }
+}
+
+static uint64_t hashFontCodepoints(const uint32_t* pCodepoints, uint32_t codepointCount)
+{
+    // FNV-1a over the codepoints in order, glyphs are stored in the order of the codepoints
+    uint64_t hash = 0xcbf29ce484222325;
+    for (uint32_t i = 0; i < codepointCount; i++)
+        hash = (hash ^ pCodepoints[i]) * 0x100000001b3;
+
+    return hash;
+}
+
+static bool readFontCache(const char* filepath, const LvnFontCacheHeader* key, LvnFont* font)
+{
+    FILE* fileptr = fopen(filepath, "rb");
+    if (!fileptr)
+        return false;
+
+    LvnFontCacheHeader header{};
+
+    bool valid = fread(&header, sizeof(LvnFontCacheHeader), 1, fileptr) == 1
+        && header.magic == LVN_FONT_CACHE_MAGIC
+        && header.version == LVN_FONT_CACHE_VERSION
+        && header.fontSize == key->fontSize
+        && header.flags == key->flags
+        && header.glyphCount == key->glyphCount
+        && header.fontHash == key->fontHash
+        && header.codepointHash == key->codepointHash;
+
+    LvnVector<LvnFontGlyph> glyphs;
+    LvnVector<uint8_t> pixels;
+    if (valid)
+    {
+        glyphs.resize(header.glyphCount);
+        pixels.resize((uint64_t)header.width * header.height);
+        valid = fread(glyphs.data(), sizeof(LvnFontGlyph), glyphs.size(), fileptr) == glyphs.size()
+            && fread(pixels.data(), sizeof(uint8_t), pixels.size(), fileptr) == pixels.size();
+    }
+
+    fclose(fileptr);
+
+    if (!valid)
+    {
+        LVN_CORE_WARN("font cache file does not match the font and will be rewritten: %s", filepath);
+        return false;
+    }
+
+    font->atlas.width = header.width;
+    font->atlas.height = header.height;
+    font->atlas.channels = 1;
+    font->atlas.size = pixels.size();
+    font->atlas.pixels = LvnData<uint8_t>(lvn::move(pixels));
+    font->glyphs = LvnData<LvnFontGlyph>(lvn::move(glyphs));
+
+    return true;
+}
+
+static void writeFontCache(const char* filepath, const LvnFontCacheHeader* key, const LvnFont& font)
+{
+    LvnFontCacheHeader header = *key;
+    header.magic = LVN_FONT_CACHE_MAGIC;
+    header.version = LVN_FONT_CACHE_VERSION;
+    header.width = font.atlas.width;
+    header.height = font.atlas.height;
+
+    FILE* fileptr = fopen(filepath, "wb");
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("cannot write font cache file: %s", filepath);
+        return;
+    }
+
+    if (fwrite(&header, sizeof(LvnFontCacheHeader), 1, fileptr) != 1
+        || fwrite(font.glyphs.data(), sizeof(LvnFontGlyph), font.glyphs.size(), fileptr) != font.glyphs.size()
+        || fwrite(font.atlas.pixels.data(), sizeof(uint8_t), font.atlas.pixels.size(), fileptr) != font.atlas.pixels.size())
+        LVN_CORE_ERROR("failed to write font cache file: %s", filepath);
+
+    fclose(fileptr);
+}
+
+LvnFont loadFontFromFileTTF(const char* filepath, uint32_t fontSize, const uint32_t* pCodepoints, uint32_t codepointCount, LvnLoadFontFlagBits flags, const char* cachePath)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Fonts);
+
+    // the face is read from memory by every rasterizing thread, so the file is read or mapped once up front
+    LvnBin file;
+    if (!lvn::vfsReadFile(filepath, &file))
+        file = lvn::loadFileMapped(filepath);
+
+    if (file.size() == 0)
+    {
+        LVN_CORE_ERROR("[freetype]: failed to load font file: %s", filepath);
+        LVN_CORE_ASSERT(false, "failed to load font face");
+        return {};
+    }
+
+    return lvn::loadFontFromFileTTFMemory(file.data(), file.size(), fontSize, pCodepoints, codepointCount, flags, cachePath);
+}
+
+LvnFont loadFontFromFileTTFMemory(const uint8_t* fontData, uint64_t fontDataSize, uint32_t fontSize, const uint32_t* pCodepoints, uint32_t codepointCount, LvnLoadFontFlagBits flags, const char* cachePath)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Fonts);
+    LvnFont font{};
+
+    if (pCodepoints == nullptr)
+    {
+        LvnContext* lvnctx = lvn::getContext();
+        pCodepoints = lvnctx->defaultCodePoints.data();
+        codepointCount = lvnctx->defaultCodePoints.size();
+    }
+
+    const int sdfSpread = (flags & Lvn_LoadFont_SDF) ? s_FontSdfSpread : 0;
+
+    LvnFontCacheHeader cacheKey{};
+    cacheKey.fontSize = fontSize;
+    cacheKey.flags = flags;
+    cacheKey.glyphCount = codepointCount;
+
+    // a cache hit skips freetype entirely, the atlas and glyphs are read as they were packed
+    if (cachePath != nullptr)
+    {
+        cacheKey.fontHash = lvn::hashFileContents(fontData, fontDataSize);
+        cacheKey.codepointHash = lvn::hashFontCodepoints(pCodepoints, codepointCount);
+
+        if (lvn::readFontCache(cachePath, &cacheKey, &font))
+        {
+            font.codepoints = LvnData<uint32_t>(pCodepoints, codepointCount);
+            font.fontSize = fontSize;
+            font.sdfSpread = sdfSpread;
+            lvn::fontBuildGlyphLookup(font);
+
+            LVN_CORE_TRACE("loaded font atlas (w:%u,h:%u), glyphs: %u, from cache file: %s", font.atlas.width, font.atlas.height, codepointCount, cachePath);
+            return font;
+        }
+    }
+
+    uint32_t loadFlags = sdfSpread ? FT_LOAD_DEFAULT : FT_LOAD_RENDER;
+    if (flags & Lvn_LoadFont_NoHinting)
+        loadFlags |= FT_LOAD_NO_HINTING;
+    if (flags & Lvn_LoadFont_AutoHinting)
+        loadFlags |= FT_LOAD_FORCE_AUTOHINT;
+    if (flags & Lvn_LoadFont_TargetLight)
+        loadFlags |= FT_LOAD_TARGET_LIGHT;
+    if (flags & Lvn_LoadFont_TargetMono)
+        loadFlags |= FT_LOAD_TARGET_MONO | FT_LOAD_MONOCHROME;
+
+    // one face slot per job thread index, the workers and the calling thread each rasterize with their own face
+    uint32_t threadCount = s_LvnContext != nullptr ? lvn::jobGetWorkerCount() + 1 : 1;
+    LvnVector<LvnFontRasterFace> faces(threadCount);
+    LvnVector<LvnFontRasterGlyph> rasterGlyphs(codepointCount);
+
+    LvnFontRasterData raster{};
+    raster.fontData = fontData;
+    raster.fontDataSize = fontDataSize;
+    raster.fontSize = fontSize;
+    raster.pCodepoints = pCodepoints;
+    raster.loadFlags = loadFlags;
+    raster.sdfSpread = sdfSpread;
+    raster.mono = flags & Lvn_LoadFont_TargetMono;
+    raster.faces = faces.data();
+    raster.glyphs = rasterGlyphs.data();
+
+    // the face of the calling thread is created first, it checks the font and gives the metrics for the atlas size
+    LvnFontRasterFace* callerFace = &faces[lvn::jobGetThreadIndex()];
+    if (!lvn::fontRasterFaceInit(callerFace, &raster))
+    {
+        LVN_CORE_ERROR("[freetype]: failed to load font face!");
+        LVN_CORE_ASSERT(false, "failed to load font face");
+        return font;
+    }
+
+    int faceHeight = callerFace->face->size->metrics.height >> 6;
+
+    if (s_LvnContext != nullptr)
+        lvn::parallelFor(codepointCount, 0, lvn::fontRasterGlyphs, &raster);
+    else
+        lvn::fontRasterGlyphs(0, codepointCount, &raster);
+
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        if (!faces[i].loaded)
+            continue;
+
+        FT_Done_Face(faces[i].face);
+        FT_Done_FreeType(faces[i].library);
+    }
+
+    int maxDim = (1 + faceHeight + 2 * sdfSpread) * ceilf(sqrtf(codepointCount));
+    int width = 1;
+    while (width < maxDim) width <<= 1;
+    int height = width;
+
+    // pack the rasterized glyphs into rows of the atlas in codepoint order
+    LvnVector<uint8_t> pixels(width * height);
+    int penx = 0, peny = 0;
+    const int padding = 2;
+    const int lineHeight = faceHeight + 2 * sdfSpread + padding;
+
+    LvnVector<LvnFontGlyph> glyphs(codepointCount);
+
+    for (uint32_t i = 0; i < codepointCount; i++)
+    {
+        const LvnFontRasterGlyph& rasterGlyph = rasterGlyphs[i];
+
+        if (penx + (int)rasterGlyph.width + padding > width)
+        {
+            penx = padding;
+            peny += lineHeight;
+        }
+
+        // glyphs past the bottom of the atlas are clipped
+        uint32_t copyWidth = lvn::min(rasterGlyph.width, (uint32_t)lvn::max(width - penx, 0));
+        for (uint32_t row = 0; row < rasterGlyph.rows && peny + (int)row < height; row++)
+            memcpy(&pixels[(peny + row) * width + penx], &rasterGlyph.bitmap[row * rasterGlyph.width], copyWidth);
+
+        LvnFontGlyph glyph{};
+        glyph.uv.x0 = (float)penx / (float)width;
+        glyph.uv.y0 = (float)peny / (float)height;
+        glyph.uv.x1 = (float)(penx + rasterGlyph.width) / (float)width;
+        glyph.uv.y1 = (float)(peny + rasterGlyph.rows) / (float)height;
+
+        glyph.size.x = rasterGlyph.width;
+        glyph.size.y = rasterGlyph.rows;
+        glyph.bearing.x = rasterGlyph.bearingX;
+        glyph.bearing.y = rasterGlyph.bearingY;
+        glyph.advance = rasterGlyph.advance;
+        glyph.unicode = pCodepoints[i];
+
+        glyphs[i] = glyph;
+
+        penx += rasterGlyph.width + padding;
+    }
+
+    LvnImageData atlas{};
+    atlas.width = width;
+    atlas.height = height;
+    atlas.channels = 1;
+    atlas.size = width * height;
+    atlas.pixels = LvnData<uint8_t>(lvn::move(pixels));
+
+    font.atlas = lvn::move(atlas);
+    font.glyphs = LvnData<LvnFontGlyph>(lvn::move(glyphs));
+    font.codepoints = LvnData<uint32_t>(pCodepoints, codepointCount);
+    font.fontSize = fontSize;
+    font.sdfSpread = sdfSpread;
+    lvn::fontBuildGlyphLookup(font);
+
+    if (cachePath != nullptr)
+        lvn::writeFontCache(cachePath, &cacheKey, font);
+
+    return font;
+}
+
+LvnFontGlyph fontGetGlyph(const LvnFont& font, uint32_t codepoint)
+{
+    if (font.glyphTable.size() == s_FontGlyphTableSize)
+    {
+        if (codepoint < s_FontGlyphTableSize)
+        {
+            uint32_t index = font.glyphTable[codepoint];
+            return index ? font.glyphs[index - 1] : font.glyphs[0];
+        }
+
+        // the hash table always has an empty slot, every probe ends
+        size_t mask = font.glyphHashTable.size() - 1;
+        for (size_t slot = LvnHash{}(codepoint) & mask;; slot = (slot + 1) & mask)
+        {
+            uint64_t entry = font.glyphHashTable[slot];
+            if (entry == UINT64_MAX)
+                break;
+            if ((entry >> 32) == codepoint)
+                return font.glyphs[entry & 0xffffffff];
+        }
+
+        return font.glyphs[0];
+    }
+
+    for (uint32_t i = 0; i < font.glyphs.size(); i++)
+    {
+        if (font.glyphs[i].unicode == codepoint)
+            return font.glyphs[i];
+    }
+
+    return font.glyphs[0];
+}
+
+void fontBuildGlyphLookup(LvnFont& font)
+{
+    LvnVector<uint32_t> glyphTable(s_FontGlyphTableSize, 0);
+
+    uint32_t sparseCount = 0;
+    for (uint32_t i = 0; i < font.glyphs.size(); i++)
+    {
+        if (font.glyphs[i].unicode >= s_FontGlyphTableSize)
+            sparseCount++;
+    }
+
+    // power of two capacity at most half full so probe chains stay short, always at least one empty slot to end the probe
+    size_t capacity = 8;
+    while (capacity < sparseCount * 2)
+        capacity *= 2;
+
+    LvnVector<uint64_t> glyphHashTable(capacity, UINT64_MAX);
+
+    // the first glyph with a codepoint wins, same as searching the glyphs in order
+    for (uint32_t i = 0; i < font.glyphs.size(); i++)
+    {
+        uint32_t codepoint = font.glyphs[i].unicode;
+        if (codepoint < s_FontGlyphTableSize)
+        {
+            if (!glyphTable[codepoint])
+                glyphTable[codepoint] = i + 1;
+            continue;
+        }
+
+        size_t slot = LvnHash{}(codepoint) & (capacity - 1);
+        while (glyphHashTable[slot] != UINT64_MAX && (glyphHashTable[slot] >> 32) != codepoint)
+            slot = (slot + 1) & (capacity - 1);
+
+        if (glyphHashTable[slot] == UINT64_MAX)
+            glyphHashTable[slot] = ((uint64_t)codepoint << 32) | i;
+    }
+
+    font.glyphTable = LvnData<uint32_t>(lvn::move(glyphTable));
+    font.glyphHashTable = LvnData<uint64_t>(lvn::move(glyphHashTable));
+}
+
+static void dynamicFontResetPage(LvnDynamicFont* font, LvnDynamicFontPage& page)
+{
+    memset(page.pixels.data(), 0, page.pixels.size());
+
+    page.skyline.clear();
+    page.skyline.push_back({ 0, 0, font->pageWidth });
+    page.generation++;
+
+    // the whole page is uploaded again so the evicted glyphs are cleared from the texture
+    page.dirtyX0 = 0;
+    page.dirtyY0 = 0;
+    page.dirtyX1 = font->pageWidth;
+    page.dirtyY1 = font->pageHeight;
+}
+
+// shared by the dynamic font and texture atlas pages
+static bool skylinePackRect(LvnVector<LvnSkylineNode>& skyline, uint32_t pageWidth, uint32_t pageHeight, uint32_t width, uint32_t height, uint32_t* x, uint32_t* y)
+{
+    // bottom left skyline packing, place the rect where its bottom edge is lowest, ties go to the narrowest node
+    size_t bestIndex = SIZE_MAX;
+    uint32_t bestX = 0, bestY = 0, bestBottom = UINT32_MAX, bestWidth = UINT32_MAX;
+
+    for (size_t i = 0; i < skyline.size(); i++)
+    {
+        uint32_t nodeX = skyline[i].x;
+        if (nodeX + width > pageWidth)
+            break;
+
+        // the rect rests on the highest node it spans
+        uint32_t top = 0;
+        uint32_t remaining = width;
+        for (size_t j = i; j < skyline.size(); j++)
+        {
+            top = lvn::max(top, skyline[j].y);
+            if (skyline[j].width >= remaining)
+                break;
+            remaining -= skyline[j].width;
+        }
+
+        if (top + height > pageHeight)
+            continue;
+
+        if (top + height < bestBottom || (top + height == bestBottom && skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestX = nodeX;
+            bestY = top;
+            bestBottom = top + height;
+            bestWidth = skyline[i].width;
+        }
+    }
+
+    if (bestIndex == SIZE_MAX)
+        return false;
+
+    // insert the top edge of the rect and shrink or remove the nodes it covers
+    skyline.push_back({});
+    for (size_t i = skyline.size() - 1; i > bestIndex; i--)
+        skyline[i] = skyline[i - 1];
+    skyline[bestIndex] = { bestX, bestBottom, width };
+
+    uint32_t right = bestX + width;
+    for (size_t i = bestIndex + 1; i < skyline.size();)
+    {
+        LvnSkylineNode& node = skyline[i];
+        if (node.x >= right)
+            break;
+
+        if (node.x + node.width <= right)
+        {
+            skyline.erase_index(i);
+            continue;
+        }
+
+        node.width -= right - node.x;
+        node.x = right;
+        break;
+    }
+
+    // merge neighbouring nodes at the same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase_index(i + 1);
+            continue;
+        }
+        i++;
+    }
+
+    *x = bestX;
+    *y = bestY;
+    return true;
+}
+
+LvnResult createDynamicFont(LvnDynamicFont** font, const LvnDynamicFontCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Fonts);
+    if (createInfo->filepath.empty())
+    {
+        LVN_CORE_ERROR("createDynamicFont(LvnDynamicFont**, LvnDynamicFontCreateInfo*) | createInfo->filepath is empty, cannot load font without a valid path to the font file");
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->fontSize == 0 || createInfo->pageWidth == 0 || createInfo->pageHeight == 0 || createInfo->maxPages == 0)
+    {
+        LVN_CORE_ERROR("createDynamicFont(LvnDynamicFont**, LvnDynamicFontCreateInfo*) | createInfo->fontSize, pageWidth, pageHeight and maxPages must be greater than zero");
+        return Lvn_Result_Failure;
+    }
+
+    FT_Library ft;
+    FT_Face face;
+
+    if (FT_Init_FreeType(&ft))
+    {
+        LVN_CORE_ERROR("[freetype]: failed to load freetype library");
+        return Lvn_Result_Failure;
+    }
+
+    if (FT_New_Face(ft, createInfo->filepath.c_str(), 0, &face))
+    {
+        LVN_CORE_ERROR("[freetype]: failed to load font face from file: %s", createInfo->filepath.c_str());
+        FT_Done_FreeType(ft);
+        return Lvn_Result_Failure;
+    }
+
+    FT_Set_Pixel_Sizes(face, 0, (FT_UInt)createInfo->fontSize);
+
+    bool sdf = createInfo->flags & Lvn_LoadFont_SDF;
+    if (sdf)
+        FT_Property_Set(ft, "sdf", "spread", &s_FontSdfSpread);
+
+    FT_Int32 loadFlags = sdf ? FT_LOAD_DEFAULT : FT_LOAD_RENDER;
+    if (createInfo->flags & Lvn_LoadFont_NoHinting)
+        loadFlags |= FT_LOAD_NO_HINTING;
+    if (createInfo->flags & Lvn_LoadFont_AutoHinting)
+        loadFlags |= FT_LOAD_FORCE_AUTOHINT;
+    if (createInfo->flags & Lvn_LoadFont_TargetLight)
+        loadFlags |= FT_LOAD_TARGET_LIGHT;
+    if (createInfo->flags & Lvn_LoadFont_TargetMono)
+        loadFlags |= FT_LOAD_TARGET_MONO | FT_LOAD_MONOCHROME;
+
+    *font = lvn::memNew<LvnDynamicFont>();
+
+    LvnDynamicFont* fontPtr = *font;
+    fontPtr->library = ft;
+    fontPtr->face = face;
+    fontPtr->loadFlags = loadFlags;
+    fontPtr->mono = createInfo->flags & Lvn_LoadFont_TargetMono;
+    fontPtr->sdf = sdf;
+    fontPtr->pageWidth = createInfo->pageWidth;
+    fontPtr->pageHeight = createInfo->pageHeight;
+    fontPtr->maxPages = createInfo->maxPages;
+    fontPtr->frame = 1;
+
+    // reserved up front so pages are never moved while glyphs are packed into them
+    fontPtr->pages.reserve(createInfo->maxPages);
+
+    LVN_CORE_TRACE("created dynamic font: (%p), font size: %u, page size: (w:%u,h:%u), max pages: %u", *font, createInfo->fontSize, createInfo->pageWidth, createInfo->pageHeight, createInfo->maxPages);
+    return Lvn_Result_Success;
+}
+
+void destroyDynamicFont(LvnDynamicFont* font)
+{
+    if (font == nullptr) { return; }
+
+    for (uint32_t i = 0; i < font->pages.size(); i++)
+        lvn::destroyTexture(font->pages[i].texture);
+
+    FT_Done_Face(font->face);
+    FT_Done_FreeType(font->library);
+
+    lvn::memDelete(font);
+}
+
+LvnDynamicFontCreateInfo configDynamicFontInit(const char* filepath, uint32_t fontSize)
+{
+    LvnDynamicFontCreateInfo fontInit{};
+    fontInit.filepath = filepath;
+    fontInit.fontSize = fontSize;
+    fontInit.pageWidth = 1024;
+    fontInit.pageHeight = 1024;
+    fontInit.maxPages = 4;
+    fontInit.flags = Lvn_LoadFont_Default;
+
+    return fontInit;
+}
+
+LvnFontGlyph dynamicFontGetGlyph(LvnDynamicFont* font, uint32_t codepoint, uint32_t* pageIndex)
+{
+    LvnLockGaurd lock(font->mutex);
+    *pageIndex = 0;
+
+    if (font->glyphs.contains(codepoint))
+    {
+        const LvnDynamicFontGlyph& entry = font->glyphs[codepoint];
+        if (entry.page == UINT32_MAX)
+            return entry.glyph;
+
+        LvnDynamicFontPage& page = font->pages[entry.page];
+        if (entry.generation == page.generation)
+        {
+            page.lastUsed = font->frame;
+            *pageIndex = entry.page;
+            return entry.glyph;
+        }
+    }
+
+    // rasterize the glyph on first use or after its page was evicted
+    FT_Face face = font->face;
+    if (FT_Load_Char(face, codepoint, font->loadFlags) || (font->sdf && FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF)))
+    {
+        LVN_CORE_WARN("[freetype]: failed to load glyph for codepoint (%u)", codepoint);
+        return LvnFontGlyph{};
+    }
+
+    FT_Bitmap* bmp = &face->glyph->bitmap;
+
+    LvnDynamicFontGlyph entry{};
+    entry.glyph.size.x = bmp->width;
+    entry.glyph.size.y = bmp->rows;
+    entry.glyph.bearing.x = face->glyph->bitmap_left;
+    entry.glyph.bearing.y = face->glyph->bitmap_top;
+    entry.glyph.advance = face->glyph->advance.x >> 6;
+    entry.glyph.unicode = codepoint;
+    entry.page = UINT32_MAX;
+
+    if (bmp->width == 0 || bmp->rows == 0)
+    {
+        font->glyphs.insert(codepoint, LvnDynamicFontGlyph(entry));
+        return entry.glyph;
+    }
+
+    // padding keeps linear filtering from sampling neighbouring glyphs
+    const uint32_t padding = 2;
+    uint32_t rectWidth = bmp->width + padding, rectHeight = bmp->rows + padding;
+    if (rectWidth > font->pageWidth || rectHeight > font->pageHeight)
+    {
+        LVN_CORE_WARN("glyph for codepoint (%u) with size (w:%u,h:%u) does not fit in the dynamic font page size (w:%u,h:%u)", codepoint, bmp->width, bmp->rows, font->pageWidth, font->pageHeight);
+        entry.glyph.size = { 0.0f, 0.0f };
+        font->glyphs.insert(codepoint, LvnDynamicFontGlyph(entry));
+        return entry.glyph;
+    }
+
+    uint32_t penx = 0, peny = 0;
+    uint32_t pageIndexFound = UINT32_MAX;
+    for (uint32_t i = 0; i < font->pages.size(); i++)
+    {
+        if (skylinePackRect(font->pages[i].skyline, font->pageWidth, font->pageHeight, rectWidth, rectHeight, &penx, &peny))
+        {
+            pageIndexFound = i;
+            break;
+        }
+    }
+
+    if (pageIndexFound == UINT32_MAX && font->pages.size() < font->maxPages)
+    {
+        font->pages.push_back({});
+        LvnDynamicFontPage& page = font->pages.back();
+        page.pixels.resize(font->pageWidth * font->pageHeight);
+        page.texture = nullptr;
+        dynamicFontResetPage(font, page);
+        page.generation = 0;
+
+        if (skylinePackRect(page.skyline, font->pageWidth, font->pageHeight, rectWidth, rectHeight, &penx, &peny))
+            pageIndexFound = font->pages.size() - 1;
+    }
+
+    // every page is full, clear the least recently used page that no glyph was requested from this frame
+    if (pageIndexFound == UINT32_MAX)
+    {
+        uint32_t evictIndex = UINT32_MAX;
+        for (uint32_t i = 0; i < font->pages.size(); i++)
+        {
+            if (font->pages[i].lastUsed < font->frame && (evictIndex == UINT32_MAX || font->pages[i].lastUsed < font->pages[evictIndex].lastUsed))
+                evictIndex = i;
+        }
+
+        if (evictIndex == UINT32_MAX)
+        {
+            LVN_CORE_WARN("dynamic font (%p) has no atlas page to evict, every page is in use this frame, glyph for codepoint (%u) is not rasterized", font, codepoint);
+            entry.glyph.size = { 0.0f, 0.0f };
+            return entry.glyph;
+        }
+
+        dynamicFontResetPage(font, font->pages[evictIndex]);
+        if (skylinePackRect(font->pages[evictIndex].skyline, font->pageWidth, font->pageHeight, rectWidth, rectHeight, &penx, &peny))
+            pageIndexFound = evictIndex;
+    }
+
+    LVN_CORE_ASSERT(pageIndexFound != UINT32_MAX, "glyph must fit into an empty dynamic font page");
+
+    LvnDynamicFontPage& page = font->pages[pageIndexFound];
+    uint32_t width = font->pageWidth;
+
+    if (bmp->pixel_mode == FT_PIXEL_MODE_MONO && font->mono)
+    {
+        for (uint32_t row = 0; row < bmp->rows; row++)
+        {
+            for (uint32_t col = 0; col < bmp->width; col++)
+            {
+                uint8_t byte = bmp->buffer[row * bmp->pitch + col / 8];
+                bool bitSet = (byte >> (7 - (col % 8))) & 1;
+                page.pixels[(peny + row) * width + penx + col] = bitSet ? 255 : 0;
+            }
+        }
+    }
+    else
+    {
+        for (uint32_t row = 0; row < bmp->rows; row++)
+            memcpy(&page.pixels[(peny + row) * width + penx], &bmp->buffer[row * abs(bmp->pitch)], bmp->width);
+    }
+
+    page.dirtyX0 = lvn::min(page.dirtyX0, penx);
+    page.dirtyY0 = lvn::min(page.dirtyY0, peny);
+    page.dirtyX1 = lvn::max(page.dirtyX1, penx + bmp->width);
+    page.dirtyY1 = lvn::max(page.dirtyY1, peny + bmp->rows);
+    page.lastUsed = font->frame;
+
+    entry.glyph.uv.x0 = (float)penx / (float)font->pageWidth;
+    entry.glyph.uv.y0 = (float)peny / (float)font->pageHeight;
+    entry.glyph.uv.x1 = (float)(penx + bmp->width) / (float)font->pageWidth;
+    entry.glyph.uv.y1 = (float)(peny + bmp->rows) / (float)font->pageHeight;
+    entry.page = pageIndexFound;
+    entry.generation = page.generation;
+
+    font->glyphs.insert(codepoint, LvnDynamicFontGlyph(entry));
+
+    *pageIndex = pageIndexFound;
+    return entry.glyph;
+}
+
+void dynamicFontUpdate(LvnDynamicFont* font)
+{
+    LvnLockGaurd lock(font->mutex);
+
+    for (uint32_t i = 0; i < font->pages.size(); i++)
+    {
+        LvnDynamicFontPage& page = font->pages[i];
+        if (page.dirtyX1 == 0)
+            continue;
+
+        if (page.texture == nullptr)
+        {
+            LvnTextureCreateInfo textureCreateInfo{};
+            textureCreateInfo.imageData.width = font->pageWidth;
+            textureCreateInfo.imageData.height = font->pageHeight;
+            textureCreateInfo.imageData.channels = 1;
+            textureCreateInfo.imageData.size = page.pixels.size();
+            textureCreateInfo.imageData.pixels = LvnData<uint8_t>::view(page.pixels.data(), page.pixels.size());
+            textureCreateInfo.format = Lvn_TextureFormat_Unorm;
+            textureCreateInfo.minFilter = Lvn_TextureFilter_Linear;
+            textureCreateInfo.magFilter = Lvn_TextureFilter_Linear;
+            textureCreateInfo.wrapS = Lvn_TextureMode_ClampToEdge;
+            textureCreateInfo.wrapT = Lvn_TextureMode_ClampToEdge;
+
+            if (lvn::createTexture(&page.texture, &textureCreateInfo) != Lvn_Result_Success)
+            {
+                LVN_CORE_ERROR("failed to create texture for page (%u) of dynamic font (%p)", i, font);
+                page.texture = nullptr;
+                continue;
+            }
+        }
+        else
+        {
+            // only the rows and columns rasterized since the last update are uploaded
+            uint32_t regionWidth = page.dirtyX1 - page.dirtyX0;
+            uint32_t regionHeight = page.dirtyY1 - page.dirtyY0;
+
+            font->uploadScratch.resize(regionWidth * regionHeight);
+            for (uint32_t row = 0; row < regionHeight; row++)
+                memcpy(&font->uploadScratch[row * regionWidth], &page.pixels[(page.dirtyY0 + row) * font->pageWidth + page.dirtyX0], regionWidth);
+
+            if (lvn::textureUpdateData(page.texture, font->uploadScratch.data(), page.dirtyX0, page.dirtyY0, regionWidth, regionHeight) != Lvn_Result_Success)
+            {
+                LVN_CORE_ERROR("failed to update texture for page (%u) of dynamic font (%p)", i, font);
+                continue;
+            }
+        }
+
+        page.dirtyX0 = font->pageWidth;
+        page.dirtyY0 = font->pageHeight;
+        page.dirtyX1 = 0;
+        page.dirtyY1 = 0;
+    }
+
+    font->frame++;
+}
+
+LvnTexture* dynamicFontGetPageTexture(LvnDynamicFont* font, uint32_t pageIndex)
+{
+    LvnLockGaurd lock(font->mutex);
+    return pageIndex < font->pages.size() ? font->pages[pageIndex].texture : nullptr;
+}
+
+uint32_t dynamicFontGetPageCount(LvnDynamicFont* font)
+{
+    LvnLockGaurd lock(font->mutex);
+    return font->pages.size();
+}
+
+uint32_t decodeCodepointUTF8(const char* str, uint32_t* next)
+{
+    LVN_CORE_ASSERT(next, "next is nullptr");
+
+    const uint8_t *ptr = reinterpret_cast<const uint8_t*>(str);
+    uint32_t codepoint = 0x3f;
+    *next = 1;
+
+    if ((ptr[0] & 0xf8) == 0xf0)
+    {
+        // 4-byte sequence
+        if (((ptr[1] & 0xc0) ^ 0x80) || ((ptr[2] & 0xc0) ^ 0x80) || ((ptr[3] & 0xc0) ^ 0x80))
+            return codepoint;
+        codepoint = ((ptr[0] & 0x07) << 18) | ((ptr[1] & 0x3f) << 12) | ((ptr[2] & 0x3f) << 6) | (ptr[3] & 0x3f);
+        *next = 4;
+    }
+    else if ((ptr[0] & 0xf0) == 0xe0)
+    {
+        // 3-byte sequence
+        if (((ptr[1] & 0xc0) ^ 0x80) || ((ptr[2] & 0xc0) ^ 0x80))
+            return codepoint;
+        codepoint = ((ptr[0] & 0x0f) << 12) | ((ptr[1] & 0x3f) << 6) | (ptr[2] & 0x3f);
+        *next = 3;
+    }
+    else if ((ptr[0] & 0xe0) == 0xc0)
+    {
+        // 2-byte sequence
+        if (((ptr[1] & 0xc0) ^ 0x80))
+            return codepoint;
+        codepoint = ((ptr[0] & 0x1f) << 6) | (ptr[1] & 0x3f);
+        *next = 2;
+    }
+    else if (ptr[0] < 0x80)
+    {
+        // 1-byte ASCII
+        codepoint = ptr[0];
+        *next = 1;
+    }
+
+    return codepoint;
+}
+
+size_t decodeUTF8(const char* str, size_t len, uint32_t* out)
+{
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(str);
+    size_t count = 0;
+    size_t i = 0;
+
+    while (i < len)
+    {
+        // runs of ascii are widened 16 bytes at a time, text is mostly ascii even when it is not entirely
+#if defined(LVN_SIMD_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        while (i + 16 <= len)
+        {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(ptr + i));
+            if (_mm_movemask_epi8(bytes) != 0) { break; }
+
+            __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+            __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+            _mm_storeu_si128((__m128i*)(out + count), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 12), _mm_unpackhi_epi16(hi, zero));
+            i += 16;
+            count += 16;
+        }
+#elif defined(LVN_SIMD_NEON)
+        while (i + 16 <= len)
+        {
+            uint8x16_t bytes = vld1q_u8(ptr + i);
+            uint64x2_t high = vreinterpretq_u64_u8(vandq_u8(bytes, vdupq_n_u8(0x80)));
+            if ((vgetq_lane_u64(high, 0) | vgetq_lane_u64(high, 1)) != 0) { break; }
+
+            uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+            uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+            vst1q_u32(out + count, vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32(out + count + 4, vmovl_u16(vget_high_u16(lo)));
+            vst1q_u32(out + count + 8, vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32(out + count + 12, vmovl_u16(vget_high_u16(hi)));
+            i += 16;
+            count += 16;
+        }
+#endif
+
+        // scalar until the next byte that could start an ascii run, checks stay within len
+        size_t end = lvn::min(len, i + 16);
+        while (i < end)
+        {
+            uint8_t lead = ptr[i];
+            if (lead < 0x80)
+            {
+                out[count++] = lead;
+                i++;
+                continue;
+            }
+
+            uint32_t size = (lead & 0xe0) == 0xc0 ? 2 : (lead & 0xf0) == 0xe0 ? 3 : (lead & 0xf8) == 0xf0 ? 4 : 0;
+            uint32_t codepoint = 0x3f;
+            bool valid = size != 0 && i + size <= len;
+
+            for (uint32_t j = 1; valid && j < size; j++)
+                valid = (ptr[i + j] & 0xc0) == 0x80;
+
+            if (valid)
+            {
+                if (size == 2)
+                    codepoint = ((lead & 0x1f) << 6) | (ptr[i + 1] & 0x3f);
+                else if (size == 3)
+                    codepoint = ((lead & 0x0f) << 12) | ((ptr[i + 1] & 0x3f) << 6) | (ptr[i + 2] & 0x3f);
+                else
+                    codepoint = ((lead & 0x07) << 18) | ((ptr[i + 1] & 0x3f) << 12) | ((ptr[i + 2] & 0x3f) << 6) | (ptr[i + 3] & 0x3f);
+
+                // overlong encodings, utf-16 surrogates and values past the unicode range are rejected
+                static const uint32_t minCodepoint[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+                valid = codepoint >= minCodepoint[size] && codepoint <= 0x10ffff && (codepoint < 0xd800 || codepoint > 0xdfff);
+            }
+
+            out[count++] = valid ? codepoint : 0x3f;
+            i += valid ? size : 1;
+        }
+    }
+
+    return count;
+}
+
+LvnData<uint32_t> getDefaultSupportedCodepoints()
+{
+    return lvn::getContext()->defaultCodePoints;
+}
+
+void* memAlloc(size_t size)
+{
+    if (size == 0) { return nullptr; }
+#ifdef LVN_MEMORY_TRACKING
+    void* allocmem = lvn::memTrackAlloc(size);
+#else
+    void* allocmem = (*s_MemAllocFunc)(size, s_MemAllocUserData);
+#endif
+    if (!allocmem) { LVN_CORE_ERROR("malloc failure, could not allocate memory!"); LVN_ABORT; }
+    memset(allocmem, 0, size);
+    if (s_LvnContext) { s_LvnContext->numMemoryAllocations++; }
+    return allocmem;
+}
+
+void memFree(void* ptr)
+{
+    if (ptr == nullptr) { return; }
+#ifdef LVN_MEMORY_TRACKING
+    lvn::memTrackFree(ptr);
+#else
+    (*s_MemFreeFunc)(ptr, s_MemAllocUserData);
+#endif
+    if (s_LvnContext) s_LvnContext->numMemoryAllocations--;
+}
+
+void* memRealloc(void* ptr, size_t size)
+{
+    if (!ptr) { return lvn::memAlloc(size); }
+#ifdef LVN_MEMORY_TRACKING
+    return lvn::memTrackRealloc(ptr, size);
+#else
+    return (*s_MemReallocFunc)(ptr, size, s_MemAllocUserData);
+#endif
+}
+
+#ifdef LVN_MEMORY_TRACKING
+static void updatePeakBytes(std::atomic<uint64_t>& peak, uint64_t bytes)
+{
+    uint64_t current = peak.load(std::memory_order_relaxed);
+    while (bytes > current && !peak.compare_exchange_weak(current, bytes, std::memory_order_relaxed)) {}
+}
+
+static void trackMemoryAlloc(void* ptr, size_t size, LvnMemoryCategory category)
+{
+    LvnMemoryTracker& tracker = s_MemoryTracker;
+    lvn::updatePeakBytes(tracker.peakBytes[category], tracker.bytes[category].fetch_add(size, std::memory_order_relaxed) + size);
+    lvn::updatePeakBytes(tracker.peakTotalBytes, tracker.totalBytes.fetch_add(size, std::memory_order_relaxed) + size);
+    tracker.allocationCount[category].fetch_add(1, std::memory_order_relaxed);
+    tracker.totalAllocations[category].fetch_add(1, std::memory_order_relaxed);
+    tracker.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+    tracker.frameBytes.fetch_add(size, std::memory_order_relaxed);
+
+    LvnMemTrackFunc trackFunc = tracker.trackFunc.load(std::memory_order_acquire);
+    if (trackFunc) { trackFunc(ptr, size, category, false, tracker.trackUserData); }
+}
+
+static void trackMemoryFree(void* ptr, size_t size, LvnMemoryCategory category)
+{
+    LvnMemoryTracker& tracker = s_MemoryTracker;
+    tracker.bytes[category].fetch_sub(size, std::memory_order_relaxed);
+    tracker.totalBytes.fetch_sub(size, std::memory_order_relaxed);
+    tracker.allocationCount[category].fetch_sub(1, std::memory_order_relaxed);
+
+    LvnMemTrackFunc trackFunc = tracker.trackFunc.load(std::memory_order_acquire);
+    if (trackFunc) { trackFunc(ptr, size, category, true, tracker.trackUserData); }
+}
+
+// stored right before the pointer returned by memTrackAlloc, the size keeps the returned pointer aligned like the memory functions
+struct alignas(std::max_align_t) LvnMemTrackHeader
+{
+    size_t size;
+    LvnMemoryCategory category;
+};
+
+void* memTrackAlloc(size_t size)
+{
+    if (size == 0) { return nullptr; }
+    LvnMemTrackHeader* header = static_cast<LvnMemTrackHeader*>((*s_MemAllocFunc)(size + sizeof(LvnMemTrackHeader), s_MemAllocUserData));
+    if (!header) { return nullptr; }
+
+    header->size = size;
+    header->category = s_MemoryCategory;
+    lvn::trackMemoryAlloc(header + 1, size, header->category);
+    return header + 1;
+}
+
+void memTrackFree(void* ptr)
+{
+    if (ptr == nullptr) { return; }
+    LvnMemTrackHeader* header = static_cast<LvnMemTrackHeader*>(ptr) - 1;
+    lvn::trackMemoryFree(ptr, header->size, header->category);
+    (*s_MemFreeFunc)(header, s_MemAllocUserData);
+}
+
+void* memTrackRealloc(void* ptr, size_t size)
+{
+    if (ptr == nullptr) { return lvn::memTrackAlloc(size); }
+
+    LvnMemTrackHeader* header = static_cast<LvnMemTrackHeader*>(ptr) - 1;
+    size_t oldSize = header->size;
+    LvnMemoryCategory category = header->category;
+
+    LvnMemTrackHeader* newHeader = static_cast<LvnMemTrackHeader*>((*s_MemReallocFunc)(header, size + sizeof(LvnMemTrackHeader), s_MemAllocUserData));
+    if (!newHeader) { return nullptr; }
+
+    // reported as a free and a new allocation so profilers see the block move, the allocation keeps its category
+    lvn::trackMemoryFree(ptr, oldSize, category);
+    newHeader->size = size;
+    lvn::trackMemoryAlloc(newHeader + 1, size, category);
+    return newHeader + 1;
+}
+#endif
+
+// stored right before the pointer returned by memAllocAligned
+struct LvnAlignedAllocHeader
+{
+    void* base;        // start of the underlying allocation
+    size_t mapSize;    // size of the os mapping, 0 when allocated with the memory functions
+    size_t size;       // size asked for, used by memory tracking
+    LvnMemoryCategory category;
+};
+
+static void* alignedAllocatorAlloc(size_t size, size_t align, void*)
+{
+    return lvn::memAllocAligned(size, align > LVN_CACHE_LINE_SIZE ? align : LVN_CACHE_LINE_SIZE);
+}
+
+static void alignedAllocatorFree(void* ptr, void*)
+{
+    lvn::memFreeAligned(ptr);
+}
+
+static const LvnAllocator s_AlignedAllocator = { alignedAllocatorAlloc, alignedAllocatorFree, nullptr, nullptr };
+
+static void* mapHugePages(size_t size, size_t* mapSize)
+{
+#ifdef LVN_PLATFORM_WINDOWS
+    // large pages need the lock pages in memory privilege, fall back to normal pages when it is not held
+    size_t largePageSize = GetLargePageMinimum();
+    if (largePageSize != 0)
+    {
+        size_t largeSize = (size + largePageSize - 1) & ~(largePageSize - 1);
+        void* mem = VirtualAlloc(nullptr, largeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (mem) { *mapSize = largeSize; return mem; }
+    }
+
+    void* mem = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    *mapSize = size;
+    return mem;
+#else
+    // map one huge page extra so the start can be moved up to a huge page boundary, the unused head and tail are unmapped again
+    size_t mapLength = size + LVN_HUGE_PAGE_SIZE;
+    void* mem = mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) { return nullptr; }
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(mem);
+    uintptr_t alignedStart = (start + LVN_HUGE_PAGE_SIZE - 1) & ~(static_cast<uintptr_t>(LVN_HUGE_PAGE_SIZE) - 1);
+    size_t head = alignedStart - start;
+    size_t tail = mapLength - head - size;
+    if (head) { munmap(mem, head); }
+    if (tail) { munmap(reinterpret_cast<void*>(alignedStart + size), tail); }
+
+    #ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void*>(alignedStart), size, MADV_HUGEPAGE);
+    #endif
+
+    *mapSize = size;
+    return reinterpret_cast<void*>(alignedStart);
+#endif
+}
+
+static void unmapHugePages(void* ptr, size_t mapSize)
+{
+#ifdef LVN_PLATFORM_WINDOWS
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, mapSize);
+#endif
+}
+
+void* memAllocAligned(size_t size, size_t alignment)
+{
+    if (size == 0) { return nullptr; }
+    LVN_CORE_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+    if (alignment < alignof(LvnAlignedAllocHeader)) { alignment = alignof(LvnAlignedAllocHeader); }
+
+    // leave room for the header in front of the aligned pointer
+    size_t headerSpace = (sizeof(LvnAlignedAllocHeader) + alignment - 1) & ~(alignment - 1);
+    size_t totalSize = size + headerSpace + alignment;
+
+    void* base = nullptr;
+    size_t mapSize = 0;
+    if (totalSize >= LVN_HUGE_PAGE_SIZE)
+    {
+        size_t pageSize = (totalSize + 4095) & ~static_cast<size_t>(4095);
+        base = lvn::mapHugePages(pageSize, &mapSize);
+        if (!base) { mapSize = 0; }
+    }
+
+    if (!base)
+    {
+        base = (*s_MemAllocFunc)(totalSize, s_MemAllocUserData);
+        if (!base) { LVN_CORE_ERROR("malloc failure, could not allocate aligned memory!"); LVN_ABORT; }
+        memset(base, 0, totalSize);
+    }
+
+    uintptr_t alignedAddr = (reinterpret_cast<uintptr_t>(base) + headerSpace + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    LvnAlignedAllocHeader* header = reinterpret_cast<LvnAlignedAllocHeader*>(alignedAddr) - 1;
+    header->base = base;
+    header->mapSize = mapSize;
+    header->size = size;
+    header->category = s_MemoryCategory;
+
+#ifdef LVN_MEMORY_TRACKING
+    lvn::trackMemoryAlloc(header + 1, size, header->category);
+#endif
+
+    if (s_LvnContext) { s_LvnContext->numMemoryAllocations++; }
+    return reinterpret_cast<void*>(alignedAddr);
+}
+
+void memFreeAligned(void* ptr)
+{
+    if (ptr == nullptr) { return; }
+
+    LvnAlignedAllocHeader* header = static_cast<LvnAlignedAllocHeader*>(ptr) - 1;
+#ifdef LVN_MEMORY_TRACKING
+    lvn::trackMemoryFree(ptr, header->size, header->category);
+#endif
+    if (header->mapSize != 0)
+        lvn::unmapHugePages(header->base, header->mapSize);
+    else
+        (*s_MemFreeFunc)(header->base, s_MemAllocUserData);
+
+    if (s_LvnContext) { s_LvnContext->numMemoryAllocations--; }
+}
+
+const LvnAllocator* getAlignedAllocator()
+{
+    return &s_AlignedAllocator;
+}
+
+void setMemFuncs(LvnMemAllocFunc allocFunc, LvnMemFreeFunc freeFunc, LvnMemReallocFunc reallocFunc, void* userData)
+{
+    s_MemAllocFunc = allocFunc;
+    s_MemFreeFunc = freeFunc;
+    s_MemReallocFunc = reallocFunc;
+    s_MemAllocUserData = userData;
+}
+
+LvnMemAllocFunc getMemAllocFunc()
+{
+    return s_MemAllocFunc;
+}
+
+LvnMemFreeFunc getMemFreeFunc()
+{
+    return s_MemFreeFunc;
+}
+
+LvnMemReallocFunc getMemReallocFunc()
+{
+    return s_MemReallocFunc;
+}
+
+void* getMemUserData()
+{
+    return s_MemAllocUserData;
+}
+
+LvnMemoryCategory memSetCategory(LvnMemoryCategory category)
+{
+    LvnMemoryCategory previous = s_MemoryCategory;
+    s_MemoryCategory = category;
+    return previous;
+}
+
+LvnMemoryStats getMemoryStats()
+{
+    LvnMemoryTracker& tracker = s_MemoryTracker;
+
+    LvnMemoryStats stats{};
+    for (uint32_t i = 0; i < Lvn_MemoryCategory_Max_Value; i++)
+    {
+        stats.categories[i].bytes = tracker.bytes[i].load(std::memory_order_relaxed);
+        stats.categories[i].peakBytes = tracker.peakBytes[i].load(std::memory_order_relaxed);
+        stats.categories[i].allocationCount = tracker.allocationCount[i].load(std::memory_order_relaxed);
+        stats.categories[i].totalAllocations = tracker.totalAllocations[i].load(std::memory_order_relaxed);
+        stats.allocationCount += stats.categories[i].allocationCount;
+    }
+
+    stats.bytes = tracker.totalBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = tracker.peakTotalBytes.load(std::memory_order_relaxed);
+    stats.frameAllocations = tracker.lastFrameAllocations.load(std::memory_order_relaxed);
+    stats.frameBytes = tracker.lastFrameBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void memNextFrame()
+{
+    LvnMemoryTracker& tracker = s_MemoryTracker;
+    tracker.lastFrameAllocations.store(tracker.frameAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    tracker.lastFrameBytes.store(tracker.frameBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void setMemTrackFunc(LvnMemTrackFunc func, void* userData)
+{
+    s_MemoryTracker.trackUserData = userData;
+    s_MemoryTracker.trackFunc.store(func, std::memory_order_release);
+}
+
+const char* getMemoryCategoryName(LvnMemoryCategory category)
+{
+    switch (category)
+    {
+        case Lvn_MemoryCategory_General:     { return "General"; }
+        case Lvn_MemoryCategory_MemoryPool:  { return "MemoryPool"; }
+        case Lvn_MemoryCategory_Graphics:    { return "Graphics"; }
+        case Lvn_MemoryCategory_Renderer:    { return "Renderer"; }
+        case Lvn_MemoryCategory_Loaders:     { return "Loaders"; }
+        case Lvn_MemoryCategory_Fonts:       { return "Fonts"; }
+        case Lvn_MemoryCategory_Audio:       { return "Audio"; }
+        case Lvn_MemoryCategory_Networking:  { return "Networking"; }
+        case Lvn_MemoryCategory_Ecs:         { return "Ecs"; }
+
+        default:                             { return "undefined"; }
+    }
+}
+
+void memPoolTrim()
+{
+    LvnContext* lvnctx = lvn::getContext();
+    if (lvnctx->memoryMode != Lvn_MemAllocMode_MemPool) { return; }
+
+    LvnLockGaurd lock(lvnctx->objectMutex);
+
+    // slots cached by each thread are counted as free too, the caller makes sure no thread is using its cache
+    for (LvnObjectCache* cache : lvnctx->objectCaches)
+        lvn::flushObjectCache(lvnctx, cache);
+
+    for (uint32_t i = 0; i < Lvn_Stype_Max_Value; i++)
+        lvn::trimMemoryPool(lvnctx, (LvnStructureType)i);
+}
+
+size_t memPoolGetPeakCount(LvnStructureType sType)
+{
+    LVN_CORE_ASSERT(sType < Lvn_Stype_Max_Value, "sType out of range");
+    return lvn::getContext()->objectMemoryAllocations.sTypes[sType].peak.load(std::memory_order_relaxed);
+}
+
+LvnResult memPoolWriteConfig(const char* filepath)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    FILE* fileptr = fopen(filepath, "w");
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("memPoolWriteConfig(const char*) | cannot open memory pool config file for writing: %s", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    // sTypes that were never created are written too so the next run does not reserve their default counts
+    fprintf(fileptr, "# peak object counts per sType, loaded by createContext to size the base memory block\n");
+    for (uint32_t i = Lvn_Stype_Undefined + 1; i < Lvn_Stype_Max_Value; i++)
+        fprintf(fileptr, "%s %zu\n", lvn::getStructTypeEnumStr((LvnStructureType)i), lvnctx->objectMemoryAllocations.sTypes[i].peak.load(std::memory_order_relaxed));
+
+    fclose(fileptr);
+    return Lvn_Result_Success;
+}
+
+/* [Logging] */
+const static LvnLogPattern s_LogPatterns[] =
+{
+    { '$', [](LvnLogMessage* msg) -> LvnString { return "\n"; } },
+    { 'n', [](LvnLogMessage* msg) -> LvnString { return msg->loggerName; } },
+    { 'l', [](LvnLogMessage* msg) -> LvnString { return getLogLevelName(msg->level); }},
+    { '#', [](LvnLogMessage* msg) -> LvnString { return getLogLevelColor(msg->level); }},
+    { '^', [](LvnLogMessage* msg) -> LvnString { return LVN_LOG_COLOR_RESET; }},
+    { 'v', [](LvnLogMessage* msg) -> LvnString { return msg->msg; }},
+    { '%', [](LvnLogMessage* msg) -> LvnString { return "%"; } },
+    { 'T', [](LvnLogMessage* msg) -> LvnString { return dateGetTimeHHMMSS(); } },
+    { 't', [](LvnLogMessage* msg) -> LvnString { return dateGetTime12HHMMSS(); } },
+    { 'Y', [](LvnLogMessage* msg) -> LvnString { return dateGetYearStr(); }},
+    { 'y', [](LvnLogMessage* msg) -> LvnString { return dateGetYear02dStr(); } },
+    { 'm', [](LvnLogMessage* msg) -> LvnString { return dateGetMonthNumStr(); } },
+    { 'B', [](LvnLogMessage* msg) -> LvnString { return dateGetMonthName(); } },
+    { 'b', [](LvnLogMessage* msg) -> LvnString { return dateGetMonthNameShort(); } },
+    { 'd', [](LvnLogMessage* msg) -> LvnString { return dateGetDayNumStr(); } },
+    { 'A', [](LvnLogMessage* msg) -> LvnString { return dateGetWeekDayName(); } },
+    { 'a', [](LvnLogMessage* msg) -> LvnString { return dateGetWeekDayNameShort(); } },
+    { 'H', [](LvnLogMessage* msg) -> LvnString { return dateGetHourNumStr(); } },
+    { 'h', [](LvnLogMessage* msg) -> LvnString { return dateGetHour12NumStr(); } },
+    { 'M', [](LvnLogMessage* msg) -> LvnString { return dateGetMinuteNumStr(); } },
+    { 'S', [](LvnLogMessage* msg) -> LvnString { return dateGetSecondNumStr(); } },
+    { 'P', [](LvnLogMessage* msg) -> LvnString { return dateGetTimeMeridiem(); } },
+    { 'p', [](LvnLogMessage* msg) -> LvnString { return dateGetTimeMeridiemLower(); }},
+};
+
+static LvnResult initLogging(LvnContextCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+    lvnctx->enableCoreLogging = !createInfo->logging.disableCoreLogging;
+
+    if (createInfo->logging.enableLogging)
+    {
+        lvnctx->logging = true;
+
+        lvnctx->coreLogger.loggerName = "CORE";
+
+        if (!lvnctx->appName.empty())
+            lvnctx->clientLogger.loggerName = lvnctx->appName;
+        else
+            lvnctx->clientLogger.loggerName = "CLIENT";
+
+        lvnctx->coreLogger.logLevel = lvnctx->clientLogger.logLevel = Lvn_LogLevel_None;
+        lvnctx->coreLogger.logPatternFormat = lvnctx->clientLogger.logPatternFormat = LVN_DEFAULT_LOG_PATTERN;
+        lvnctx->coreLogger.logPatterns = lvnctx->clientLogger.logPatterns = lvn::logParseFormat(LVN_DEFAULT_LOG_PATTERN);
+
+        #ifdef LVN_PLATFORM_WINDOWS
+        enableLogANSIcodeColors();
+        #endif
+
+        if (createInfo->logging.enableAsyncLogging)
+            lvn::initLogThread(lvnctx, createInfo->logging.asyncQueueCapacity);
+
+        return Lvn_Result_Success;
+    }
+
+    return Lvn_Result_AlreadyCalled;
+}
+
+static void terminateLogging()
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    // custom loggers that were never destroyed still get their binary log written
+    while (!lvnctx->binaryLoggers.empty())
+        lvn::logCloseBinaryFile(lvnctx, lvnctx->binaryLoggers.back());
+
+    // buffered lines of custom loggers are written even if the logger is never destroyed
+    {
+        std::lock_guard<std::mutex> lock(lvnctx->logMutex);
+        lvn::logFlushFiles(lvnctx, false);
+        lvnctx->bufferedLoggers.clear();
+    }
+
+    if (lvnctx->coreLogger.logfile.logToFile)
+        lvn::logCloseFile(&lvnctx->coreLogger.logfile);
+    if (lvnctx->clientLogger.logfile.logToFile)
+        lvn::logCloseFile(&lvnctx->clientLogger.logfile);
+}
+
+static void initLogThread(LvnContext* lvnctx, uint32_t capacity)
+{
+    lvnctx->logPushed.store(0, std::memory_order_relaxed);
+    lvnctx->logWritten = 0;
+    lvnctx->logStop = false;
+
+    lvnctx->logQueue = new LvnMpmcQueue<LvnLogRecord>(capacity > 0 ? capacity : LVN_LOG_ASYNC_QUEUE_CAPACITY);
+    lvnctx->logThread = new LvnThread(lvn::logThread, lvnctx);
+}
+
+static void terminateLogThread(LvnContext* lvnctx)
+{
+    if (lvnctx->logThread == nullptr) { return; }
+
+    {
+        std::lock_guard<std::mutex> lock(lvnctx->logMutex);
+        lvnctx->logStop = true;
+    }
+    lvnctx->logCondition.notify_all();
+
+    // the thread writes the queued records before it returns
+    delete lvnctx->logThread;
+    lvnctx->logThread = nullptr;
+
+    delete lvnctx->logQueue;
+    lvnctx->logQueue = nullptr;
+}
+
+static void* logThread(void* arg)
+{
+    LvnContext* lvnctx = static_cast<LvnContext*>(arg);
+
+    // the buffers keep their memory between batches
+    LvnVector<char> console;
+    LvnVector<LvnLogFileBatch> files;
+
+    while (true)
+    {
+        uint32_t written = lvn::logWriteRecords(lvnctx, console, files);
+
+        std::unique_lock<std::mutex> lock(lvnctx->logMutex);
+        if (written > 0)
+        {
+            lvnctx->logWritten += written;
+            lvnctx->logCondition.notify_all();
+            continue;
+        }
+
+        if (lvnctx->logStop)
+            return nullptr;
+
+        // idle batches write the file buffers whose flush interval has passed
+        lvn::logFlushFiles(lvnctx, true);
+
+        lvnctx->logCondition.wait_for(lock, std::chrono::milliseconds(LVN_LOG_ASYNC_FLUSH_INTERVAL));
+    }
+}
+
+// pops up to a batch of records, the console gets one write per batch and each log file one io request
+static uint32_t logWriteRecords(LvnContext* lvnctx, LvnVector<char>& console, LvnVector<LvnLogFileBatch>& files)
+{
+    console.clear();
+
+    uint32_t count = 0;
+    LvnLogRecord record;
+    while (count < LVN_LOG_ASYNC_BATCH_SIZE && lvnctx->logQueue->try_pop(record))
+    {
+        LvnLogger* logger = record.logger;
+
+        LvnLogMessage logMsg{};
+        logMsg.msg = record.heapMsg ? record.heapMsg : record.msg;
+        logMsg.loggerName = logger->loggerName.c_str();
+        logMsg.level = record.level;
+        logMsg.timeEpoch = record.timeEpoch;
+
+        LvnLogFileBatch* batch = nullptr;
+        LvnLogFile* file = logger->logfile.logToFile && logger->logfile.fileptr ? &logger->logfile : nullptr;
+        if (file)
+        {
+            for (uint32_t i = 0; i < files.size() && !batch; i++)
+            {
+                if (files[i].file == file)
+                    batch = &files[i];
+            }
+
+            if (!batch)
+            {
+                files.push_back(LvnLogFileBatch{ file, Lvn_LogLevel_None, {} });
+                batch = &files.back();
+            }
+
+            if (record.level > batch->level)
+                batch->level = record.level;
+        }
+
+        lvn::logFormatPatterns(logger, &logMsg, &console, batch ? &batch->data : nullptr);
+
+        if (record.heapMsg)
+            lvn::memFree(record.heapMsg);
+
+        count++;
+    }
+
+    if (!console.empty())
+    {
+        fwrite(console.data(), 1, console.size(), stdout);
+        fflush(stdout);
+    }
+
+    // files that got nothing this batch were likely closed, their entry is dropped
+    for (uint32_t i = files.size(); i > 0; i--)
+    {
+        LvnLogFileBatch& batch = files[i - 1];
+        if (batch.data.empty())
+        {
+            files.erase_index(i - 1);
+            continue;
+        }
+
+        lvn::logWriteFile(batch.file, batch.data.data(), batch.data.size(), batch.level);
+        batch.data.clear();
+        batch.level = Lvn_LogLevel_None;
+    }
+
+    return count;
+}
+
+// fills the cache again only when the second changed, formatting a line costs no localtime call or allocation
+static const LvnLogTimeCache& logGetTime(long long epochSecond)
+{
+    LvnLogTimeCache& cache = s_LogTimeCache;
+    if (cache.epochSecond == epochSecond)
+        return cache;
+
+    time_t t = static_cast<time_t>(epochSecond);
+#ifdef LVN_PLATFORM_WINDOWS
+    localtime_s(&cache.tm, &t);
+#else
+    localtime_r(&t, &cache.tm);
+#endif
+
+    const struct tm& tm = cache.tm;
+    // the fields are clamped to the digits the strings hold so the formatted widths are bounded
+    unsigned hour = (unsigned)tm.tm_hour % 100u, minute = (unsigned)tm.tm_min % 100u, second = (unsigned)tm.tm_sec % 100u;
+    unsigned hour12 = ((hour + 11u) % 12u) + 1u;
+    unsigned year = (unsigned)(tm.tm_year + 1900) % 10000u;
+    snprintf(cache.time, sizeof(cache.time), "%02u:%02u:%02u", hour, minute, second);
+    snprintf(cache.time12, sizeof(cache.time12), "%02u:%02u:%02u", hour12, minute, second);
+    snprintf(cache.year, sizeof(cache.year), "%u", year);
+    snprintf(cache.year02d, sizeof(cache.year02d), "%u", year % 100u);
+    snprintf(cache.month, sizeof(cache.month), "%02u", (unsigned)(tm.tm_mon + 1) % 100u);
+    snprintf(cache.day, sizeof(cache.day), "%02u", (unsigned)tm.tm_mday % 100u);
+    snprintf(cache.hour, sizeof(cache.hour), "%02u", hour);
+    snprintf(cache.hour12, sizeof(cache.hour12), "%02u", hour12);
+    snprintf(cache.minute, sizeof(cache.minute), "%02u", minute);
+    snprintf(cache.second, sizeof(cache.second), "%02u", second);
+
+    cache.epochSecond = epochSecond;
+    return cache;
+}
+
+static const LvnLogTimeCache& dateGetLocalTime()
+{
+    return lvn::logGetTime(static_cast<long long>(time(NULL)));
+}
+
+// the default patterns are written without calling their func, false for user patterns
+static bool logGetBuiltinPattern(char symbol, const LvnLogMessage* msg, const char** str)
+{
+    switch (symbol)
+    {
+        case '$': { *str = "\n"; return true; }
+        case 'n': { *str = msg->loggerName; return true; }
+        case 'l': { *str = lvn::getLogLevelName(msg->level); return true; }
+        case '#': { *str = lvn::getLogLevelColor(msg->level); return true; }
+        case '^': { *str = LVN_LOG_COLOR_RESET; return true; }
+        case 'v': { *str = msg->msg; return true; }
+        case '%': { *str = "%"; return true; }
+    }
+
+    // messages built by the user may not carry a time
+    const LvnLogTimeCache& time = lvn::logGetTime(msg->timeEpoch != 0 ? msg->timeEpoch : lvn::dateGetSecondsSinceEpoch());
+    switch (symbol)
+    {
+        case 'T': { *str = time.time; return true; }
+        case 't': { *str = time.time12; return true; }
+        case 'Y': { *str = time.year; return true; }
+        case 'y': { *str = time.year02d; return true; }
+        case 'm': { *str = time.month; return true; }
+        case 'B': { *str = s_MonthName[time.tm.tm_mon]; return true; }
+        case 'b': { *str = s_MonthNameShort[time.tm.tm_mon]; return true; }
+        case 'd': { *str = time.day; return true; }
+        case 'A': { *str = s_WeekDayName[time.tm.tm_wday]; return true; }
+        case 'a': { *str = s_WeekDayNameShort[time.tm.tm_wday]; return true; }
+        case 'H': { *str = time.hour; return true; }
+        case 'h': { *str = time.hour12; return true; }
+        case 'M': { *str = time.minute; return true; }
+        case 'S': { *str = time.second; return true; }
+        case 'P': { *str = time.tm.tm_hour < 12 ? "AM" : "PM"; return true; }
+        case 'p': { *str = time.tm.tm_hour < 12 ? "am" : "pm"; return true; }
+    }
+
+    return false;
+}
+
+// walks the patterns once for both outputs, file skips the ansi color patterns, either can be nullptr
+template <typename Buffer>
+static void logFormatPatterns(LvnLogger* logger, LvnLogMessage* msg, Buffer* console, Buffer* file)
+{
+    for (uint32_t i = 0; i < logger->logPatterns.size(); i++)
+    {
+        const LvnLogPattern& pattern = logger->logPatterns[i];
+        if (pattern.func == nullptr) // no special format character '%' found
+        {
+            if (console) { console->push_back(pattern.symbol); }
+            if (file) { file->push_back(pattern.symbol); }
+            continue;
+        }
+
+        // user patterns can not reuse a default symbol so the symbol tells them apart
+        const char* str = nullptr;
+        LvnString userStr;
+        if (!lvn::logGetBuiltinPattern(pattern.symbol, msg, &str))
+        {
+            userStr = pattern.func(msg);
+            str = userStr.c_str();
+        }
+
+        size_t length = strlen(str);
+        if (console) { console->push_range(str, length); }
+        if (file && pattern.symbol != '#' && pattern.symbol != '^') { file->push_range(str, length); }
+    }
+}
+
+// a full queue wakes the log thread and waits for room so messages are never dropped
+static void logPushRecord(LvnContext* lvnctx, const LvnLogRecord& record)
+{
+    while (!lvnctx->logQueue->try_push(record))
+    {
+        lvnctx->logCondition.notify_all();
+        std::this_thread::yield();
+    }
+    lvnctx->logPushed.fetch_add(1, std::memory_order_release);
+
+    // errors are written right away and fatal messages before returning in case the program is about to stop
+    if (record.level == Lvn_LogLevel_Fatal)
+        lvn::logFlush();
+    else if (record.level == Lvn_LogLevel_Error)
+        lvnctx->logCondition.notify_all();
+}
+
+// formats straight into the queued record with async logging, only messages too long for it allocate
+static void logMessageArgs(LvnLogger* logger, LvnLogLevel level, const char* fmt, va_list args)
+{
+    if (!lvn::logShouldOutput(logger, level)) { return; }
+
+    if (logger->binfile)
+    {
+        lvn::logWriteBinaryMessage(logger->binfile, level, fmt, args);
+        return;
+    }
+
+    va_list argcopy;
+    va_copy(argcopy, args);
+
+    if (s_LvnContext->logQueue)
+    {
+        LvnLogRecord record;
+        record.logger = logger;
+        record.timeEpoch = lvn::dateGetSecondsSinceEpoch();
+        record.level = level;
+        record.heapMsg = nullptr;
+
+        int len = vsnprintf(record.msg, LVN_LOG_RECORD_INLINE_SIZE, fmt, args);
+        if (len < 0)
+        {
+            record.msg[0] = '\0';
+        }
+        else if (len >= LVN_LOG_RECORD_INLINE_SIZE)
+        {
+            record.heapMsg = static_cast<char*>(lvn::memAlloc(len + 1));
+            vsnprintf(record.heapMsg, len + 1, fmt, argcopy);
+        }
+
+        lvn::logPushRecord(s_LvnContext, record);
+    }
+    else
+    {
+        LvnSmallVector<char, 256> buff;
+
+        int len = vsnprintf(nullptr, 0, fmt, args);
+        buff.resize(len + 1);
+        vsnprintf(&buff[0], len + 1, fmt, argcopy);
+        lvn::logMessage(logger, level, buff.data());
+    }
+
+    va_end(argcopy);
+}
+
+static void logOpenFile(LvnLogFile* logfile, const char* mode)
+{
+    logfile->fileptr = fopen(logfile->filename.c_str(), mode);
+    logfile->fileSize = 0;
+    logfile->openTime = lvn::dateGetSecondsSinceEpoch();
+    logfile->flushTime = lvn::getContextTime();
+
+    // appended files count what they already hold toward maxFileSize
+    if (logfile->fileptr && mode[0] == 'a' && fseek(logfile->fileptr, 0, SEEK_END) == 0)
+    {
+        long int size = ftell(logfile->fileptr);
+        logfile->fileSize = size > 0 ? static_cast<uint64_t>(size) : 0;
+    }
+}
+
+static void logCloseFile(LvnLogFile* logfile)
+{
+    LvnLockGaurd lock(logfile->mutex);
+    lvn::logFlushFileBuffer(logfile);
+    lvn::closeFileStreamAsync(logfile->fileptr);
+    logfile->fileptr = nullptr;
+}
+
+// appends formatted lines to the file buffer, the file is rotated first when the lines would pass its limits
+static void logWriteFile(LvnLogFile* logfile, const char* data, size_t size, LvnLogLevel level)
+{
+    logfile->mutex.lock();
+
+    const LvnLogFileOptions& options = logfile->options;
+
+    // an empty file is never rotated so lines longer than maxFileSize are still written
+    bool reopened = true;
+    if (logfile->fileptr && logfile->fileSize > 0 &&
+        ((options.maxFileSize > 0 && logfile->fileSize + size > options.maxFileSize) ||
+         (options.rotateInterval > 0 && lvn::dateGetSecondsSinceEpoch() - logfile->openTime >= options.rotateInterval)))
+    {
+        reopened = lvn::logRotateFile(logfile);
+    }
+
+    if (logfile->fileptr)
+    {
+        logfile->buffer.insert(logfile->buffer.end(), data, size);
+        logfile->fileSize += size;
+
+        if (logfile->buffer.size() >= options.bufferSize || level >= Lvn_LogLevel_Error ||
+            (options.flushLevel != Lvn_LogLevel_None && level >= options.flushLevel) ||
+            (options.flushInterval > 0 && lvn::getContextTime() - logfile->flushTime >= options.flushInterval * 0.001f))
+        {
+            lvn::logFlushFileBuffer(logfile);
+        }
+    }
+
+    logfile->mutex.unlock();
+
+    // reported after unlocking since the core logger may be the one writing to this file
+    if (!reopened)
+        LVN_CORE_ERROR("failed to open log file after rotating it: %s", logfile->filename.c_str());
+}
+
+// the caller holds the mutex of the file
+static void logFlushFileBuffer(LvnLogFile* logfile)
+{
+    if (logfile->options.flushInterval > 0)
+        logfile->flushTime = lvn::getContextTime();
+
+    if (logfile->buffer.empty()) { return; }
+
+    lvn::writeFileStreamAsync(logfile->fileptr, logfile->buffer.data(), logfile->buffer.size());
+    logfile->buffer.clear();
+}
+
+// the io thread finishes the queued writes and closes the file before it is renamed, rotating is rare enough to wait for it
+static bool logRotateFile(LvnLogFile* logfile)
+{
+    lvn::logFlushFileBuffer(logfile);
+
+    LvnJobCounter counter;
+    lvn::closeFileStreamAsync(logfile->fileptr, &counter);
+    while (counter.count.load(std::memory_order_acquire) > 0)
+        std::this_thread::yield();
+
+    auto rotatedName = [logfile](uint32_t index)
+    {
+        char suffix[16];
+        snprintf(suffix, sizeof(suffix), ".%u", index);
+        return logfile->filename + suffix;
+    };
+
+    // "<filename>.1" is the newest rotated file, the one past maxFiles is deleted and the current file is truncated when none are kept
+    uint32_t maxFiles = logfile->options.maxFiles;
+    if (maxFiles > 0)
+    {
+        remove(rotatedName(maxFiles).c_str());
+        for (uint32_t i = maxFiles - 1; i > 0; i--)
+            rename(rotatedName(i).c_str(), rotatedName(i + 1).c_str());
+        rename(logfile->filename.c_str(), rotatedName(1).c_str());
+    }
+
+    lvn::logOpenFile(logfile, "w");
+    return logfile->fileptr != nullptr;
+}
+
+static void logTrackBufferedFile(LvnContext* lvnctx, LvnLogger* logger, bool buffered)
+{
+    std::lock_guard<std::mutex> lock(lvnctx->logMutex);
+
+    for (uint32_t i = 0; i < lvnctx->bufferedLoggers.size(); i++)
+    {
+        if (lvnctx->bufferedLoggers[i] != logger) { continue; }
+
+        if (!buffered)
+            lvnctx->bufferedLoggers.erase_index(i);
+        return;
+    }
+
+    if (buffered)
+        lvnctx->bufferedLoggers.push_back(logger);
+}
+
+// the caller holds logMutex
+static void logFlushFiles(LvnContext* lvnctx, bool expiredOnly)
+{
+    float time = expiredOnly ? lvn::getContextTime() : 0.0f;
+
+    for (uint32_t i = 0; i < lvnctx->bufferedLoggers.size(); i++)
+    {
+        LvnLogFile* logfile = &lvnctx->bufferedLoggers[i]->logfile;
+        LvnLockGaurd lock(logfile->mutex);
+
+        if (expiredOnly && (logfile->options.flushInterval == 0 || time - logfile->flushTime < logfile->options.flushInterval * 0.001f))
+            continue;
+
+        lvn::logFlushFileBuffer(logfile);
+    }
+}
+
+// finds the conversions of a printf format string and the type of the argument each one reads
+static void logParseArgs(const char* fmt, LvnVector<LvnLogFormatSpec>* specs)
+{
+    for (uint32_t i = 0; fmt[i] != '\0'; i++)
+    {
+        if (fmt[i] != '%') { continue; }
+        if (fmt[i + 1] == '%') { i++; continue; }
+
+        LvnLogFormatSpec spec{};
+        spec.begin = i++;
+        spec.precision = -1;
+
+        // flags and width
+        while (fmt[i] != '\0' && strchr("-+ #0'123456789*", fmt[i]))
+        {
+            if (fmt[i] == '*') { spec.stars++; }
+            i++;
+        }
+
+        if (fmt[i] == '.')
+        {
+            i++;
+            if (fmt[i] == '*')
+            {
+                spec.stars++;
+                spec.precisionStar = true;
+                i++;
+            }
+            else
+            {
+                spec.precision = 0;
+                while (fmt[i] >= '0' && fmt[i] <= '9')
+                    spec.precision = spec.precision * 10 + (fmt[i++] - '0');
+            }
+        }
+
+        uint32_t longs = 0;
+        char modifier = '\0';
+        while (fmt[i] != '\0' && strchr("hlLjzt", fmt[i]))
+        {
+            if (fmt[i] == 'l') { longs++; }
+            else { modifier = fmt[i]; }
+            i++;
+        }
+
+        // a format that ends inside a conversion reads no argument for it
+        if (fmt[i] == '\0') { return; }
+
+        spec.conversion = fmt[i];
+        spec.end = i + 1;
+
+        switch (spec.conversion)
+        {
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            {
+                if (modifier == 'j') spec.type = Lvn_LogArgType_IntMax;
+                else if (modifier == 'z') spec.type = Lvn_LogArgType_Size;
+                else if (modifier == 't') spec.type = Lvn_LogArgType_PtrDiff;
+                else if (longs >= 2) spec.type = Lvn_LogArgType_LongLong;
+                else if (longs == 1) spec.type = Lvn_LogArgType_Long;
+                else spec.type = Lvn_LogArgType_Int;
+                break;
+            }
+            case 'c': { spec.type = Lvn_LogArgType_Int; break; }
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            {
+                spec.type = modifier == 'L' ? Lvn_LogArgType_LongDouble : Lvn_LogArgType_Double;
+                break;
+            }
+            case 's': { spec.type = longs > 0 ? Lvn_LogArgType_Pointer : Lvn_LogArgType_String; break; }
+            case 'p': case 'n': { spec.type = Lvn_LogArgType_Pointer; break; }
+            default: { continue; } // unknown conversion, printf does not define which argument it reads
+        }
+
+        specs->push_back(spec);
+    }
+}
+
+static void logWriteVarint(LvnVector<uint8_t>& buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+static bool logReadVarint(const uint8_t* data, size_t size, size_t* offset, uint64_t* value)
+{
+    *value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        if (*offset >= size) { return false; }
+
+        uint8_t byte = data[(*offset)++];
+        *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) { return true; }
+    }
+    return false;
+}
+
+static bool logReadValue(const uint8_t* data, size_t size, size_t* offset, void* value, size_t valueSize)
+{
+    if (size - *offset < valueSize) { return false; }
+
+    memcpy(value, data + *offset, valueSize);
+    *offset += valueSize;
+    return true;
+}
+
+template <typename T>
+static void logWriteValue(LvnVector<uint8_t>& buffer, const T& value)
+{
+    buffer.insert(buffer.end(), reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+}
+
+// format strings are almost always literals, the address finds them and the text catches buffers reused for another format
+static uint32_t logBinaryFormatId(LvnLogBinaryFile* binfile, const char* fmt)
+{
+    uint64_t key = reinterpret_cast<uintptr_t>(fmt);
+    if (const uint32_t* id = binfile->formatIds.find(key))
+    {
+        if (strcmp(binfile->formats[*id].text.c_str(), fmt) == 0)
+            return *id;
+    }
+
+    uint32_t id = static_cast<uint32_t>(binfile->formats.size());
+
+    LvnLogBinaryFormat format;
+    format.text = fmt;
+    lvn::logParseArgs(fmt, &format.specs);
+    binfile->formats.push_back(lvn::move(format));
+    binfile->formatIds.insert(key, id);
+
+    size_t length = strlen(fmt);
+    binfile->buffer.push_back(Lvn_LogBinaryRecord_Format);
+    lvn::logWriteVarint(binfile->buffer, length);
+    binfile->buffer.insert(binfile->buffer.end(), reinterpret_cast<const uint8_t*>(fmt), length);
+
+    return id;
+}
+
+static void logWriteBinaryName(LvnLogBinaryFile* binfile, const char* name)
+{
+    size_t length = strlen(name);
+    binfile->buffer.push_back(Lvn_LogBinaryRecord_Logger);
+    lvn::logWriteVarint(binfile->buffer, length);
+    binfile->buffer.insert(binfile->buffer.end(), reinterpret_cast<const uint8_t*>(name), length);
+}
+
+// copies the arguments the format reads without formatting them, the decoder runs them through printf later
+static void logWriteBinaryMessage(LvnLogBinaryFile* binfile, LvnLogLevel level, const char* fmt, va_list args)
+{
+    std::lock_guard<std::mutex> lock(binfile->mutex);
+
+    uint32_t id = lvn::logBinaryFormatId(binfile, fmt);
+    const LvnLogBinaryFormat& format = binfile->formats[id];
+    LvnVector<uint8_t>& buffer = binfile->buffer;
+
+    buffer.push_back(Lvn_LogBinaryRecord_Message);
+    lvn::logWriteVarint(buffer, id);
+    lvn::logWriteValue(buffer, lvn::dateGetSecondsSinceEpoch());
+    buffer.push_back(static_cast<uint8_t>(level));
+
+    for (uint32_t i = 0; i < format.specs.size(); i++)
+    {
+        const LvnLogFormatSpec& spec = format.specs[i];
+
+        int64_t star = 0;
+        for (uint32_t j = 0; j < spec.stars; j++)
+        {
+            star = va_arg(args, int);
+            lvn::logWriteValue(buffer, star);
+        }
+
+        switch (spec.type)
+        {
+            case Lvn_LogArgType_Int: { lvn::logWriteValue(buffer, static_cast<int64_t>(va_arg(args, int))); break; }
+            case Lvn_LogArgType_Long: { lvn::logWriteValue(buffer, static_cast<int64_t>(va_arg(args, long))); break; }
+            case Lvn_LogArgType_LongLong: { lvn::logWriteValue(buffer, static_cast<int64_t>(va_arg(args, long long))); break; }
+            case Lvn_LogArgType_IntMax: { lvn::logWriteValue(buffer, static_cast<int64_t>(va_arg(args, intmax_t))); break; }
+            case Lvn_LogArgType_Size: { lvn::logWriteValue(buffer, static_cast<uint64_t>(va_arg(args, size_t))); break; }
+            case Lvn_LogArgType_PtrDiff: { lvn::logWriteValue(buffer, static_cast<int64_t>(va_arg(args, ptrdiff_t))); break; }
+            case Lvn_LogArgType_Double: { lvn::logWriteValue(buffer, va_arg(args, double)); break; }
+            case Lvn_LogArgType_LongDouble: { lvn::logWriteValue(buffer, static_cast<double>(va_arg(args, long double))); break; }
+            case Lvn_LogArgType_Pointer: { lvn::logWriteValue(buffer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(va_arg(args, void*)))); break; }
+            case Lvn_LogArgType_String:
+            {
+                const char* str = va_arg(args, const char*);
+                if (str == nullptr) { str = "(null)"; }
+
+                // strings with a precision do not have to be null terminated
+                size_t maxLength = SIZE_MAX;
+                if (spec.precisionStar) { maxLength = star >= 0 ? static_cast<size_t>(star) : SIZE_MAX; }
+                else if (spec.precision >= 0) { maxLength = static_cast<size_t>(spec.precision); }
+
+                size_t length = 0;
+                while (length < maxLength && str[length] != '\0') { length++; }
+
+                lvn::logWriteVarint(buffer, length);
+                buffer.insert(buffer.end(), reinterpret_cast<const uint8_t*>(str), length);
+                break;
+            }
+        }
+    }
+
+    // fatal messages reach the file before returning in case the program is about to stop
+    if (buffer.size() >= LVN_LOG_BINARY_BUFFER_SIZE || level == Lvn_LogLevel_Fatal)
+        lvn::logFlushBinaryFile(binfile);
+}
+
+static void logWriteBinary(LvnLogBinaryFile* binfile, LvnLogLevel level, const char* fmt, ...)
+{
+    va_list argptr;
+    va_start(argptr, fmt);
+    lvn::logWriteBinaryMessage(binfile, level, fmt, argptr);
+    va_end(argptr);
+}
+
+// the caller holds the mutex of the file
+static void logFlushBinaryFile(LvnLogBinaryFile* binfile)
+{
+    if (binfile->buffer.empty()) { return; }
+
+    lvn::writeFileStreamAsync(binfile->fileptr, reinterpret_cast<const char*>(binfile->buffer.data()), binfile->buffer.size());
+    binfile->buffer.clear();
+}
+
+static void logCloseBinaryFile(LvnContext* lvnctx, LvnLogger* logger)
+{
+    LvnLogBinaryFile* binfile = logger->binfile;
+
+    {
+        std::lock_guard<std::mutex> lock(binfile->mutex);
+        lvn::logFlushBinaryFile(binfile);
+    }
+    lvn::closeFileStreamAsync(binfile->fileptr);
+
+    for (uint32_t i = 0; i < lvnctx->binaryLoggers.size(); i++)
+    {
+        if (lvnctx->binaryLoggers[i] != logger) { continue; }
+
+        lvnctx->binaryLoggers.erase_index(i);
+        break;
+    }
+
+    delete binfile;
+    logger->binfile = nullptr;
+}
+
+template <typename T>
+static void logAppendFormatted(LvnVector<char>* out, const char* spec, T value)
+{
+    int length = snprintf(nullptr, 0, spec, value);
+    if (length <= 0) { return; }
+
+    size_t size = out->size();
+    out->resize(size + length + 1);
+    snprintf(out->data() + size, length + 1, spec, value);
+    out->resize(size + length);
+}
+
+// text between conversions, "%%" is printed as '%'
+static void logAppendLiteral(LvnVector<char>* out, const char* str, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        out->push_back(str[i]);
+        if (str[i] == '%' && i + 1 < length && str[i + 1] == '%')
+            i++;
+    }
+}
+
+// runs the stored arguments of a message record through printf one conversion at a time
+static bool logDecodeBinaryMessage(const LvnLogBinaryFormat& format, const uint8_t* data, size_t size, size_t* offset, LvnVector<char>* out)
+{
+    const char* fmt = format.text.c_str();
+    uint32_t pos = 0;
+
+    for (uint32_t i = 0; i < format.specs.size(); i++)
+    {
+        const LvnLogFormatSpec& spec = format.specs[i];
+
+        lvn::logAppendLiteral(out, fmt + pos, spec.begin - pos);
+        pos = spec.end;
+
+        // the stored '*' values are written into the conversion since they can not be passed next to a single argument
+        char specstr[64];
+        uint32_t length = 0;
+        for (uint32_t j = spec.begin; j < spec.end; j++)
+        {
+            if (length + 24 >= sizeof(specstr)) { return false; }
+
+            if (fmt[j] != '*')
+            {
+                specstr[length++] = fmt[j];
+                continue;
+            }
+
+            int64_t star;
+            if (!lvn::logReadValue(data, size, offset, &star, sizeof(star))) { return false; }
+
+            // a negative precision is taken as if it was omitted
+            if (fmt[j - 1] == '.' && star < 0) { length--; continue; }
+            length += snprintf(specstr + length, sizeof(specstr) - length, "%d", static_cast<int>(star));
+        }
+        specstr[length] = '\0';
+
+        if (spec.type == Lvn_LogArgType_String)
+        {
+            uint64_t strLength;
+            if (!lvn::logReadVarint(data, size, offset, &strLength) || strLength > size - *offset) { return false; }
+
+            LvnString str(reinterpret_cast<const char*>(data + *offset), strLength);
+            *offset += strLength;
+            lvn::logAppendFormatted(out, specstr, str.c_str());
+            continue;
+        }
+
+        uint64_t value;
+        if (!lvn::logReadValue(data, size, offset, &value, sizeof(value))) { return false; }
+
+        int64_t ivalue;
+        double dvalue;
+        memcpy(&ivalue, &value, sizeof(value));
+        memcpy(&dvalue, &value, sizeof(value));
+
+        switch (spec.type)
+        {
+            case Lvn_LogArgType_Int: { lvn::logAppendFormatted(out, specstr, static_cast<int>(ivalue)); break; }
+            case Lvn_LogArgType_Long: { lvn::logAppendFormatted(out, specstr, static_cast<long>(ivalue)); break; }
+            case Lvn_LogArgType_LongLong: { lvn::logAppendFormatted(out, specstr, static_cast<long long>(ivalue)); break; }
+            case Lvn_LogArgType_IntMax: { lvn::logAppendFormatted(out, specstr, static_cast<intmax_t>(ivalue)); break; }
+            case Lvn_LogArgType_Size: { lvn::logAppendFormatted(out, specstr, static_cast<size_t>(value)); break; }
+            case Lvn_LogArgType_PtrDiff: { lvn::logAppendFormatted(out, specstr, static_cast<ptrdiff_t>(ivalue)); break; }
+            case Lvn_LogArgType_Double: { lvn::logAppendFormatted(out, specstr, dvalue); break; }
+            case Lvn_LogArgType_LongDouble: { lvn::logAppendFormatted(out, specstr, static_cast<long double>(dvalue)); break; }
+            case Lvn_LogArgType_Pointer:
+            {
+                // %n wrote to memory of the logging process and wide strings were not copied, only their address is left
+                if (spec.conversion == 'n') { break; }
+                lvn::logAppendFormatted(out, spec.conversion == 'p' ? specstr : "%p", reinterpret_cast<void*>(static_cast<uintptr_t>(value)));
+                break;
+            }
+            default: { break; }
+        }
+    }
+
+    lvn::logAppendLiteral(out, fmt + pos, format.text.size() - pos);
+    return true;
+}
+
+static LvnVector<LvnLogPattern> logParseFormat(const char* fmt)
+{
+    if (!fmt || !*fmt) { return {}; }
+
+    LvnVector<LvnLogPattern> patterns;
+
+    for (uint32_t i = 0; i < strlen(fmt) - 1; i++)
+    {
+        if (fmt[i] != '%') // Other characters in format
+        {
+            LvnLogPattern pattern = { /* .symbol = */ fmt[i], /* .func = */ nullptr };
+            patterns.push_back(pattern);
+            continue;
+        }
+
+        // find pattern with matching symbol
+        for (uint32_t j = 0; j < sizeof(s_LogPatterns) / sizeof(LvnLogPattern); j++)
+        {
+            if (fmt[i + 1] != s_LogPatterns[j].symbol)
+                continue;
+
+            patterns.push_back(s_LogPatterns[j]);
+        }
+
+        // find and add user defined patterns
+        for (uint32_t j = 0; j < s_LvnContext->userLogPatterns.size(); j++)
+        {
+            if (fmt[i + 1] != s_LvnContext->userLogPatterns[j].symbol)
+                continue;
+
+            patterns.push_back(s_LvnContext->userLogPatterns[j]);
+        }
+
+        i++; // incramant past symbol on next character in format
+    }
+
+    return patterns;
+}
+
+void logEnable(bool enable)
+{
+    lvn::getContext()->logging = enable;
+}
+
+void logEnableCoreLogging(bool enable)
+{
+    lvn::getContext()->enableCoreLogging = enable;
+}
+
+void logSetLevel(LvnLogger* logger, LvnLogLevel level)
+{
+    logger->logLevel = level;
+}
+
+void logSetFileConfig(LvnLogger* logger, bool enable, const char* filename, LvnFileMode filemode)
+{
+    // queued messages are written to the file they were logged to
+    lvn::logFlush();
+
+    // if log to file was enabled before, fileptr needs to be closed
+    if (logger->logfile.logToFile)
+        lvn::logCloseFile(&logger->logfile);
+
+    logger->logfile.logToFile = enable;
+    logger->logfile.filename = filename;
+    logger->logfile.filemode = filemode;
+
+    if (enable)
+    {
+        if (logger->logfile.filename.empty())
+        {
+            logger->logfile.filename = logger->loggerName + "_logs.txt";
+            LVN_CORE_WARN("logSetFileConfig(LvnLogger*, bool enable, const char* filename, LvnFileMode filemode) | filename not set, setting file name to name of the logger: %s_logs.txt", logger->loggerName.c_str());
+        }
+
+        const char* filemode = "w";
+        if (logger->logfile.filemode == Lvn_FileMode_Write) filemode = "w";
+        else if (logger->logfile.filemode == Lvn_FileMode_Append) filemode = "a";
+
+        lvn::logOpenFile(&logger->logfile, filemode);
+    }
+}
+
+void logSetFileOptions(LvnLogger* logger, const LvnLogFileOptions* options)
+{
+    lvn::logFlush();
+
+    LvnLogFile* logfile = &logger->logfile;
+    {
+        LvnLockGaurd lock(logfile->mutex);
+        lvn::logFlushFileBuffer(logfile);
+        logfile->options = *options;
+        logfile->buffer.reserve(options->bufferSize);
+    }
+
+    lvn::logTrackBufferedFile(lvn::getContext(), logger, options->bufferSize > 0);
+}
+
+void logFlushFile(LvnLogger* logger)
+{
+    LvnLockGaurd lock(logger->logfile.mutex);
+    lvn::logFlushFileBuffer(&logger->logfile);
+}
+
+LvnResult logSetBinaryFileConfig(LvnLogger* logger, bool enable, const char* filename)
+{
+    // queued text messages are written before the logger switches files
+    lvn::logFlush();
+
+    LvnContext* lvnctx = lvn::getContext();
+    if (logger->binfile)
+        lvn::logCloseBinaryFile(lvnctx, logger);
+
+    if (!enable) { return Lvn_Result_Success; }
+
+    LvnString path = filename;
+    if (path.empty())
+    {
+        path = logger->loggerName + "_logs.lvnlog";
+        LVN_CORE_WARN("logSetBinaryFileConfig(LvnLogger*, bool enable, const char* filename) | filename not set, setting file name to name of the logger: %s_logs.lvnlog", logger->loggerName.c_str());
+    }
+
+    FILE* fileptr = fopen(path.c_str(), "wb");
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("logSetBinaryFileConfig(LvnLogger*, bool enable, const char* filename) | failed to open binary log file: %s", path.c_str());
+        return Lvn_Result_Failure;
+    }
+
+    LvnLogBinaryFile* binfile = new LvnLogBinaryFile();
+    binfile->filename = path;
+    binfile->fileptr = fileptr;
+    binfile->buffer.reserve(LVN_LOG_BINARY_BUFFER_SIZE);
+    binfile->buffer.insert(binfile->buffer.end(), reinterpret_cast<const uint8_t*>(LVN_LOG_BINARY_MAGIC), LVN_LOG_BINARY_MAGIC_SIZE);
+    lvn::logWriteBinaryName(binfile, logger->loggerName.c_str());
+
+    logger->binfile = binfile;
+    lvnctx->binaryLoggers.push_back(logger);
+
+    return Lvn_Result_Success;
+}
+
+LvnResult logDecodeBinaryFile(LvnLogger* logger, const char* filepath, const char* outpath)
+{
+    LvnBin bin = lvn::loadFileSrcBin(filepath);
+    const uint8_t* data = bin.data();
+    size_t size = bin.size();
+
+    if (size < LVN_LOG_BINARY_MAGIC_SIZE || memcmp(data, LVN_LOG_BINARY_MAGIC, LVN_LOG_BINARY_MAGIC_SIZE) != 0)
+    {
+        LVN_CORE_ERROR("logDecodeBinaryFile(LvnLogger*, const char*, const char*) | file is not a binary log file: %s", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    FILE* outfile = stdout;
+    if (outpath && *outpath)
+    {
+        outfile = fopen(outpath, "w");
+        if (!outfile)
+        {
+            LVN_CORE_ERROR("logDecodeBinaryFile(LvnLogger*, const char*, const char*) | failed to open output file: %s", outpath);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    // console output keeps the color patterns, text files get the lines without ANSI codes like text log files do
+    bool toConsole = outfile == stdout;
+
+    LvnVector<LvnLogBinaryFormat> formats;
+    LvnString loggerName;
+    LvnVector<char> msgstr, output;
+
+    size_t offset = LVN_LOG_BINARY_MAGIC_SIZE;
+    bool valid = true;
+    while (offset < size)
+    {
+        uint8_t type = data[offset++];
+
+        if (type == Lvn_LogBinaryRecord_Logger || type == Lvn_LogBinaryRecord_Format)
+        {
+            uint64_t length;
+            if (!lvn::logReadVarint(data, size, &offset, &length) || length > size - offset) { valid = false; break; }
+
+            LvnString text(reinterpret_cast<const char*>(data + offset), length);
+            offset += length;
+
+            if (type == Lvn_LogBinaryRecord_Logger)
+            {
+                loggerName = lvn::move(text);
+                continue;
+            }
+
+            LvnLogBinaryFormat format;
+            format.text = lvn::move(text);
+            lvn::logParseArgs(format.text.c_str(), &format.specs);
+            formats.push_back(lvn::move(format));
+            continue;
+        }
+
+        uint64_t id;
+        long long timeEpoch;
+        uint8_t level;
+        if (type != Lvn_LogBinaryRecord_Message ||
+            !lvn::logReadVarint(data, size, &offset, &id) || id >= formats.size() ||
+            !lvn::logReadValue(data, size, &offset, &timeEpoch, sizeof(timeEpoch)) ||
+            !lvn::logReadValue(data, size, &offset, &level, sizeof(level)))
+        {
+            valid = false;
+            break;
+        }
+
+        msgstr.clear();
+        if (!lvn::logDecodeBinaryMessage(formats[id], data, size, &offset, &msgstr)) { valid = false; break; }
+        msgstr.push_back('\0');
+
+        LvnLogMessage logMsg{};
+        logMsg.msg = msgstr.data();
+        logMsg.loggerName = loggerName.c_str();
+        logMsg.level = static_cast<LvnLogLevel>(level);
+        logMsg.timeEpoch = timeEpoch;
+
+        lvn::logFormatPatterns(logger, &logMsg, toConsole ? &output : nullptr, toConsole ? nullptr : &output);
+
+        if (output.size() >= LVN_LOG_BINARY_BUFFER_SIZE)
+        {
+            fwrite(output.data(), 1, output.size(), outfile);
+            output.clear();
+        }
+    }
+
+    fwrite(output.data(), 1, output.size(), outfile);
+    if (outfile != stdout)
+        fclose(outfile);
+
+    // the records decoded before a damaged one are still written, a file cut off by a crash ends in a partial record
+    if (!valid)
+    {
+        LVN_CORE_ERROR("logDecodeBinaryFile(LvnLogger*, const char*, const char*) | binary log file is truncated or damaged after byte %zu: %s", offset, filepath);
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
+bool logCheckLevel(LvnLogger* logger, LvnLogLevel level)
+{
+    return (level >= logger->logLevel);
+}
+
+bool logShouldOutput(LvnLogger* logger, LvnLogLevel level)
+{
+    if (!s_LvnContext || !s_LvnContext->logging) { return false; }
+    if (!s_LvnContext->enableCoreLogging && logger == &s_LvnContext->coreLogger) { return false; }
+    return level >= logger->logLevel;
+}
+
+void logRenameLogger(LvnLogger* logger, const char* name)
+{
+    lvn::logFlush();
+    logger->loggerName = name;
+
+    if (logger->binfile)
+    {
+        std::lock_guard<std::mutex> lock(logger->binfile->mutex);
+        lvn::logWriteBinaryName(logger->binfile, name);
+    }
+}
+
+void logOutputMessage(LvnLogger* logger, LvnLogMessage* msg)
+{
+    if (!lvn::getContext()->logging) { return; }
+
+    // the message is built inline so logging a typical line does not allocate
+    LvnSmallVector<char, 512> msgstr;
+    lvn::logFormatPatterns<LvnSmallVector<char, 512>>(logger, msg, &msgstr, nullptr);
+
+    fwrite(msgstr.data(), 1, msgstr.size(), stdout);
+}
+
+LvnString logFormatMessage(LvnLogger* logger, LvnLogLevel level, const char* msg, bool removeANSI)
+{
+    LvnLogMessage logMsg{};
+    logMsg.msg = msg;
+    logMsg.loggerName = logger->loggerName.c_str();
+    logMsg.level = level;
+    logMsg.timeEpoch = lvn::dateGetSecondsSinceEpoch();
+
+    LvnSmallVector<char, 512> msgstr;
+    if (removeANSI)
+        lvn::logFormatPatterns<LvnSmallVector<char, 512>>(logger, &logMsg, nullptr, &msgstr);
+    else
+        lvn::logFormatPatterns<LvnSmallVector<char, 512>>(logger, &logMsg, &msgstr, nullptr);
+
+    return LvnString(msgstr.data(), msgstr.size());
+}
+
+void logMessage(LvnLogger* logger, LvnLogLevel level, const char* msg)
+{
+    if (!lvn::getContext()->logging) { return; }
+
+    if (logger->binfile)
+    {
+        lvn::logWriteBinary(logger->binfile, level, "%s", msg);
+        return;
+    }
+
+    if (s_LvnContext->logQueue)
+    {
+        LvnLogRecord record;
+        record.logger = logger;
+        record.timeEpoch = lvn::dateGetSecondsSinceEpoch();
+        record.level = level;
+        record.heapMsg = nullptr;
+
+        size_t len = strlen(msg);
+        char* dst = record.msg;
+        if (len >= LVN_LOG_RECORD_INLINE_SIZE)
+            dst = record.heapMsg = static_cast<char*>(lvn::memAlloc(len + 1));
+        memcpy(dst, msg, len + 1);
+
+        lvn::logPushRecord(s_LvnContext, record);
+        return;
+    }
+
+    LvnLogMessage logMsg{};
+    logMsg.msg = msg;
+    logMsg.loggerName = logger->loggerName.c_str();
+    logMsg.level = level;
+    logMsg.timeEpoch = lvn::dateGetSecondsSinceEpoch();
+
+    // the console and file lines are formatted in the same pass
+    LvnSmallVector<char, 512> msgstr, filestr;
+    bool toFile = logger->logfile.logToFile && logger->logfile.fileptr;
+    lvn::logFormatPatterns(logger, &logMsg, &msgstr, toFile ? &filestr : nullptr);
+
+    fwrite(msgstr.data(), 1, msgstr.size(), stdout);
+
+    if (toFile)
+        lvn::logWriteFile(&logger->logfile, filestr.data(), filestr.size(), level);
+}
+
+bool logRateLimit(LvnLogRateLimit* limit, uint32_t* suppressed)
+{
+    if (!s_LvnContext) { return false; }
+
+    float time = lvn::getContextTime();
+    LvnSpinLockGaurd lock(limit->lock);
+
+    if (!limit->started)
+    {
+        limit->started = true;
+        limit->tokens = limit->burst;
+    }
+    else
+    {
+        limit->tokens += (time - limit->lastTime) * limit->ratePerSecond;
+        if (limit->tokens > limit->burst)
+            limit->tokens = limit->burst;
+    }
+    limit->lastTime = time;
+
+    if (limit->tokens < 1.0f)
+    {
+        limit->suppressed++;
+        return false;
+    }
+
+    limit->tokens -= 1.0f;
+    *suppressed = limit->suppressed;
+    limit->suppressed = 0;
+    return true;
+}
+
+void logFlush()
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    for (uint32_t i = 0; i < lvnctx->binaryLoggers.size(); i++)
+    {
+        LvnLogBinaryFile* binfile = lvnctx->binaryLoggers[i]->binfile;
+        std::lock_guard<std::mutex> lock(binfile->mutex);
+        lvn::logFlushBinaryFile(binfile);
+    }
+
+    std::unique_lock<std::mutex> lock(lvnctx->logMutex);
+
+    if (lvnctx->logQueue)
+    {
+        // records pushed by other threads after this point are not waited for
+        uint64_t target = lvnctx->logPushed.load(std::memory_order_acquire);
+
+        lvnctx->logCondition.notify_all();
+        while (lvnctx->logWritten < target && !lvnctx->logStop)
+            lvnctx->logCondition.wait(lock);
+    }
+
+    // file buffers last so they include the lines of the records written above
+    lvn::logFlushFiles(lvnctx, false);
+}
+
+void logMessageTrace(LvnLogger* logger, const char* fmt, ...)
+{
+    va_list argptr;
+    va_start(argptr, fmt);
+    lvn::logMessageArgs(logger, Lvn_LogLevel_Trace, fmt, argptr);
+    va_end(argptr);
+}
+
+void logMessageDebug(LvnLogger* logger, const char* fmt, ...)
+{
+    va_list argptr;
+    va_start(argptr, fmt);
+    lvn::logMessageArgs(logger, Lvn_LogLevel_Debug, fmt, argptr);
+    va_end(argptr);
+}
+
+void logMessageInfo(LvnLogger* logger, const char* fmt, ...)
+{
+    va_list argptr;
+    va_start(argptr, fmt);
+    lvn::logMessageArgs(logger, Lvn_LogLevel_Info, fmt, argptr);
+    va_end(argptr);
+}
+
+void logMessageWarn(LvnLogger* logger, const char* fmt, ...)
+{
+    va_list argptr;
+    va_start(argptr, fmt);
+    lvn::logMessageArgs(logger, Lvn_LogLevel_Warn, fmt, argptr);
+    va_end(argptr);
+}
+
+void logMessageError(LvnLogger* logger, const char* fmt, ...)
+{
+    va_list argptr;
+    va_start(argptr, fmt);
+    lvn::logMessageArgs(logger, Lvn_LogLevel_Error, fmt, argptr);
+    va_end(argptr);
+}
+
+void logMessageFatal(LvnLogger* logger, const char* fmt, ...)
+{
+    va_list argptr;
+    va_start(argptr, fmt);
+    lvn::logMessageArgs(logger, Lvn_LogLevel_Fatal, fmt, argptr);
+    va_end(argptr);
+}
+
+LvnLogger* logGetCoreLogger()
+{
+    return &lvn::getContext()->coreLogger;
+}
+
+LvnLogger* logGetClientLogger()
+{
+    return &lvn::getContext()->clientLogger;
+}
+
+const char* logGetANSIcodeColor(LvnLogLevel level)
+{
+    switch (level)
+    {
+        case Lvn_LogLevel_None:     { return LVN_LOG_COLOR_RESET; }
+        case Lvn_LogLevel_Trace:    { return LVN_LOG_COLOR_TRACE; }
+        case Lvn_LogLevel_Debug:    { return LVN_LOG_COLOR_DEBUG; }
+        case Lvn_LogLevel_Info:     { return LVN_LOG_COLOR_INFO; }
+        case Lvn_LogLevel_Warn:     { return LVN_LOG_COLOR_WARN; }
+        case Lvn_LogLevel_Error:    { return LVN_LOG_COLOR_ERROR; }
+        case Lvn_LogLevel_Fatal:    { return LVN_LOG_COLOR_FATAL; }
+    }
+
+    return nullptr;
+}
+
+LvnResult logSetPatternFormat(LvnLogger* logger, const char* patternfmt)
+{
+    if (!logger) { return Lvn_Result_Failure; }
+    if (!patternfmt || patternfmt[0] == '\0') { return Lvn_Result_Failure; }
+
+    lvn::logFlush();
+
+    logger->logPatternFormat = patternfmt;
+
+    logger->logPatterns = lvn::logParseFormat(patternfmt);
+
+    return Lvn_Result_Success;
+}
+
+LvnResult logAddPatterns(LvnLogPattern* pLogPatterns, uint32_t count)
+{
+    if (!pLogPatterns) { return Lvn_Result_Failure; }
+    if (pLogPatterns->symbol == '\0') { return Lvn_Result_Failure; }
+
+    for (uint32_t i = 0; i < sizeof(s_LogPatterns) / sizeof(LvnLogPattern); i++)
+    {
+        for (uint32_t j = 0; j < count; j++)
+        {
+            if (pLogPatterns[j].symbol == s_LogPatterns[i].symbol) { return Lvn_Result_Failure; }
+        }
+    }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvnctx->userLogPatterns.insert(lvnctx->userLogPatterns.end(), pLogPatterns, pLogPatterns + count);
+
+    return Lvn_Result_Success;
+}
+
+LvnResult createLogger(LvnLogger** logger, const LvnLoggerCreateInfo* loggerCreateInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    *logger = lvn::createObject<LvnLogger>(lvnctx, Lvn_Stype_Logger);
+    LvnLogger* loggerPtr = *logger;
+
+    loggerPtr->loggerName = loggerCreateInfo->loggerName;
+    loggerPtr->logPatternFormat = loggerCreateInfo->format;
+    loggerPtr->logLevel = loggerCreateInfo->level;
+
+    loggerPtr->logfile.logToFile = loggerCreateInfo->fileConfig.enableLogToFile;
+    loggerPtr->logfile.filename = loggerCreateInfo->fileConfig.filename;
+    loggerPtr->logfile.filemode = loggerCreateInfo->fileConfig.filemode;
+
+    if (loggerPtr->logfile.logToFile)
+    {
+        if (loggerPtr->logfile.filename.empty())
+        {
+            LVN_CORE_ERROR("createLogger(LvnLogger**, LvnLoggerCreateInfo*) | loggerCreateInfo->fileConfig.filename is empty, cannot log to a file without a valid file path/name");
+            return Lvn_Result_Failure;
+        }
+
+        const char* filemode = "w";
+        if (loggerPtr->logfile.filemode == Lvn_FileMode_Write) filemode = "w";
+        else if (loggerPtr->logfile.filemode == Lvn_FileMode_Append) filemode = "a";
+
+        lvn::logOpenFile(&loggerPtr->logfile, filemode);
+    }
+
+    loggerPtr->logfile.options = loggerCreateInfo->fileConfig.options;
+    if (loggerPtr->logfile.options.bufferSize > 0)
+        lvn::logTrackBufferedFile(lvnctx, loggerPtr, true);
+
+    loggerPtr->logPatterns = lvn::logParseFormat(loggerCreateInfo->format.c_str());
+
+    LVN_CORE_TRACE("created logger: (%p), name: \"%s\"", *logger, loggerCreateInfo->loggerName.c_str());
+    return Lvn_Result_Success;
+}
+
+void destroyLogger(LvnLogger* logger)
+{
+    if (logger == nullptr) { return; }
+
+    lvn::logFlush();
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::logTrackBufferedFile(lvnctx, logger, false);
+
+    if (logger->logfile.logToFile)
+        lvn::logCloseFile(&logger->logfile);
+
+    if (logger->binfile)
+        lvn::logCloseBinaryFile(lvnctx, logger);
+
+    lvn::destroyObject(lvnctx, logger, Lvn_Stype_Logger);
+}
+
+
+// ------------------------------------------------------------
+// [SECTION]: Profiling Functions
+// ------------------------------------------------------------
+
+static void initProfiling(LvnContext* lvnctx, LvnContextCreateInfo* createInfo)
+{
+    uint32_t capacity = createInfo->profiling.zonesPerThread > 0 ? createInfo->profiling.zonesPerThread : 16384;
+    lvnctx->profileCapacity = 1;
+    while (lvnctx->profileCapacity < capacity && lvnctx->profileCapacity < (1u << 31))
+        lvnctx->profileCapacity <<= 1;
+
+    lvnctx->profileStart = lvn::profileGetTicks();
+    lvn::i_ProfileEnabled.store(createInfo->profiling.enableProfiling, std::memory_order_relaxed);
+
+    lvn::profileSetThreadName("main");
+}
+
+static void terminateProfiling(LvnContext* lvnctx)
+{
+    lvn::i_ProfileEnabled.store(false, std::memory_order_relaxed);
+
+    LvnLockGaurd lock(lvnctx->profileMutex);
+
+    for (LvnProfileThread* thread : lvnctx->profileThreads)
+        delete thread;
+    lvnctx->profileThreads.clear_free();
+
+}
+
+static LvnProfileThread* profileGetThread(LvnContext* lvnctx)
+{
+    if (s_ProfileThread != nullptr && s_ProfileContextId == lvnctx->contextId)
+        return s_ProfileThread;
+
+    LvnProfileThread* thread = new LvnProfileThread();
+    thread->count.store(0, std::memory_order_relaxed);
+
+    {
+        LvnLockGaurd lock(lvnctx->profileMutex);
+        thread->index = static_cast<uint32_t>(lvnctx->profileThreads.size());
+        lvnctx->profileThreads.push_back(thread);
+    }
+
+    s_ProfileThread = thread;
+    s_ProfileContextId = lvnctx->contextId;
+    return thread;
+}
+
+static void profileWriteJsonString(FILE* fileptr, const char* str)
+{
+    fputc('"', fileptr);
+    for (const char* c = str ? str : ""; *c; c++)
+    {
+        unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch == '"' || ch == '\\')
+            fprintf(fileptr, "\\%c", ch);
+        else if (ch < 0x20)
+            fprintf(fileptr, "\\u%04x", ch);
+        else
+            fputc(ch, fileptr);
+    }
+    fputc('"', fileptr);
+}
+
+void profileEnable(bool enable)
+{
+    lvn::i_ProfileEnabled.store(enable, std::memory_order_relaxed);
+}
+
+bool profileIsEnabled()
+{
+    return lvn::i_ProfileEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t profileGetTicks()
+{
+    // never 0, LvnProfileScope uses 0 for zones that began while recording was disabled
+    return lvn::getMonotonicTimeNs() | 1;
+}
+
+void profileRecordZone(const char* name, uint64_t start, uint64_t end)
+{
+    LvnContext* lvnctx = s_LvnContext;
+    if (lvnctx == nullptr || !lvn::i_ProfileEnabled.load(std::memory_order_relaxed)) { return; }
+
+    LvnProfileThread* thread = lvn::profileGetThread(lvnctx);
+    if (thread->zones.empty())
+        thread->zones.resize(lvnctx->profileCapacity);
+
+    uint64_t count = thread->count.load(std::memory_order_relaxed);
+    LvnProfileZone& zone = thread->zones[count & (lvnctx->profileCapacity - 1)];
+    zone.name = name;
+    zone.start = start;
+    zone.end = end;
+    thread->count.store(count + 1, std::memory_order_release);
+}
+
+void profileSetThreadName(const char* name)
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnProfileThread* thread = lvn::profileGetThread(lvnctx);
+
+    LvnLockGaurd lock(lvnctx->profileMutex);
+    thread->name = name;
+}
+
+const char* profileInternString(const char* str)
+{
+    LVN_CORE_ASSERT(str != nullptr, "str is nullptr, cannot intern a string that does not exist");
+
+    // zone names share the atom table, the string of an atom lives as long as the context
+    return lvn::atomGetString(lvn::atomIntern(str));
+}
+
+LvnResult profileExportChromeTrace(const char* filepath)
+{
+    LVN_CORE_ASSERT(filepath != nullptr, "filepath is nullptr, cannot export profile trace without a file path");
+
+    LvnContext* lvnctx = lvn::getContext();
+
+    FILE* fileptr = fopen(filepath, "wb");
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("[profile]: failed to open file for profile trace: \"%s\"", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    LvnLockGaurd lock(lvnctx->profileMutex);
+
+    fprintf(fileptr, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    bool first = true;
+
+    for (const LvnProfileThread* thread : lvnctx->profileThreads)
+    {
+        uint32_t tid = thread->index + 1;
+
+        fprintf(fileptr, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",", tid);
+        if (!thread->name.empty())
+            profileWriteJsonString(fileptr, thread->name.c_str());
+        else
+            fprintf(fileptr, "\"thread %u\"", tid);
+        fprintf(fileptr, "}}");
+        first = false;
+
+        // once the ring has wrapped only the newest capacity zones are still there
+        uint64_t count = thread->count.load(std::memory_order_acquire);
+        uint64_t begin = count > lvnctx->profileCapacity ? count - lvnctx->profileCapacity : 0;
+
+        for (uint64_t i = begin; i < count; i++)
+        {
+            const LvnProfileZone& zone = thread->zones[i & (lvnctx->profileCapacity - 1)];
+            uint64_t start = zone.start > lvnctx->profileStart ? zone.start - lvnctx->profileStart : 0;
+            uint64_t duration = zone.end > zone.start ? zone.end - zone.start : 0;
+
+            fprintf(fileptr, ",\n{\"name\":");
+            profileWriteJsonString(fileptr, zone.name);
+            fprintf(fileptr, ",\"cat\":\"lvn\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", tid, start / 1000.0, duration / 1000.0);
+        }
+    }
+
+    fprintf(fileptr, "\n]}\n");
+
+    bool failed = ferror(fileptr) != 0;
+    fclose(fileptr);
+
+    if (failed)
+    {
+        LVN_CORE_ERROR("[profile]: failed to write profile trace: \"%s\"", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
+void profileClear()
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnLockGaurd lock(lvnctx->profileMutex);
+
+    for (LvnProfileThread* thread : lvnctx->profileThreads)
+        thread->count.store(0, std::memory_order_release);
+}
+
+// ------------------------------------------------------------
+// [SECTION]: Event Functions
+// ------------------------------------------------------------
+
+bool dispatchKeyHoldEvent(LvnEvent* event, bool(*func)(LvnKeyHoldEvent*, void*))
+{
+    if (event->type == Lvn_EventType_KeyHold)
+    {
+        LvnKeyHoldEvent eventType{};
+        eventType.type = Lvn_EventType_KeyHold;
+        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Keyboard;
+        eventType.name = "LvnKeyHoldEvent";
+        eventType.handled = false;
+        eventType.keyCode = event->data.code;
+        eventType.repeat = event->data.repeat;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchKeyPressedEvent(LvnEvent* event, bool(*func)(LvnKeyPressedEvent*, void*))
+{
+    if (event->type == Lvn_EventType_KeyPressed)
+    {
+        LvnKeyPressedEvent eventType{};
+        eventType.type = Lvn_EventType_KeyPressed;
+        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Keyboard;
+        eventType.name = "LvnKeyPressedEvent";
+        eventType.handled = false;
+        eventType.keyCode = event->data.code;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchKeyReleasedEvent(LvnEvent* event, bool(*func)(LvnKeyReleasedEvent*, void*))
+{
+    if (event->type == Lvn_EventType_KeyReleased)
+    {
+        LvnKeyReleasedEvent eventType{};
+        eventType.type = Lvn_EventType_KeyReleased;
+        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Keyboard;
+        eventType.name = "LvnKeyReleasedEvent";
+        eventType.handled = false;
+        eventType.keyCode = event->data.code;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchKeyTypedEvent(LvnEvent* event, bool(*func)(LvnKeyTypedEvent*, void*))
+{
+    if (event->type == Lvn_EventType_KeyTyped)
+    {
+        LvnKeyTypedEvent eventType{};
+        eventType.type = Lvn_EventType_KeyTyped;
+        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Keyboard;
+        eventType.name = "LvnKeyTypedEvent";
+        eventType.handled = false;
+        eventType.key = event->data.ucode;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchMouseButtonPressedEvent(LvnEvent* event, bool(*func)(LvnMouseButtonPressedEvent*, void*))
+{
+    if (event->type == Lvn_EventType_MouseButtonPressed)
+    {
+        LvnMouseButtonPressedEvent eventType{};
+        eventType.type = Lvn_EventType_MouseButtonPressed;
+        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_MouseButton | Lvn_EventCategory_Mouse;
+        eventType.name = "LvnMouseButtonPressedEvent";
+        eventType.handled = false;
+        eventType.buttonCode = event->data.code;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchMouseButtonReleasedEvent(LvnEvent* event, bool(*func)(LvnMouseButtonReleasedEvent*, void*))
+{
+    if (event->type == Lvn_EventType_MouseButtonReleased)
+    {
+        LvnMouseButtonReleasedEvent eventType{};
+        eventType.type = Lvn_EventType_MouseButtonReleased;
+        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_MouseButton | Lvn_EventCategory_Mouse;
+        eventType.name = "LvnMouseButtonReleasedEvent";
+        eventType.handled = false;
+        eventType.buttonCode = event->data.code;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchMouseMovedEvent(LvnEvent* event, bool(*func)(LvnMouseMovedEvent*, void*))
+{
+    if (event->type == Lvn_EventType_MouseMoved)
+    {
+        LvnMouseMovedEvent eventType{};
+        eventType.type = Lvn_EventType_MouseMoved;
+        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Mouse;
+        eventType.name = "LvnMouseMovedEvent";
+        eventType.handled = false;
+        eventType.x = event->data.xd;
+        eventType.y = event->data.yd;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchMouseScrolledEvent(LvnEvent* event, bool(*func)(LvnMouseScrolledEvent*, void*))
+{
+    if (event->type == Lvn_EventType_MouseScrolled)
+    {
+        LvnMouseScrolledEvent eventType{};
+        eventType.type = Lvn_EventType_MouseScrolled;
+        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_MouseButton | Lvn_EventCategory_Mouse;
+        eventType.name = "LvnMouseScrolledEvent";
+        eventType.handled = false;
+        eventType.x = static_cast<float>(event->data.xd);
+        eventType.y = static_cast<float>(event->data.yd);
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchWindowCloseEvent(LvnEvent* event, bool(*func)(LvnWindowCloseEvent*, void*))
+{
+    if (event->type == Lvn_EventType_WindowClose)
+    {
+        LvnWindowCloseEvent eventType{};
+        eventType.type = Lvn_EventType_WindowClose;
+        eventType.category = Lvn_EventCategory_Window;
+        eventType.name = "LvnWindowCloseEvent";
+        eventType.handled = false;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchWindowFocusEvent(LvnEvent* event, bool(*func)(LvnWindowFocusEvent*, void*))
+{
+    if (event->type == Lvn_EventType_WindowFocus)
+    {
+        LvnWindowFocusEvent eventType{};
+        eventType.type = Lvn_EventType_WindowFocus;
+        eventType.category = Lvn_EventCategory_Window;
+        eventType.name = "LvnWindowFocusEvent";
+        eventType.handled = false;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchWindowFramebufferResizeEvent(LvnEvent* event, bool(*func)(LvnWindowFramebufferResizeEvent*, void*))
+{
+    if (event->type == Lvn_EventType_WindowFramebufferResize)
+    {
+        LvnWindowFramebufferResizeEvent eventType{};
+        eventType.type = Lvn_EventType_WindowFramebufferResize;
+        eventType.category = Lvn_EventCategory_Window;
+        eventType.name = "LvnWindowFramebufferResizeEvent";
+        eventType.handled = false;
+        eventType.width = event->data.x;
+        eventType.height = event->data.y;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchWindowLostFocusEvent(LvnEvent* event, bool(*func)(LvnWindowLostFocusEvent*, void*))
+{
+    if (event->type == Lvn_EventType_WindowLostFocus)
+    {
+        LvnWindowLostFocusEvent eventType{};
+        eventType.type = Lvn_EventType_WindowLostFocus;
+        eventType.category = Lvn_EventCategory_Window;
+        eventType.name = "LvnWindowLostFocusEvent";
+        eventType.handled = false;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchWindowMovedEvent(LvnEvent* event, bool(*func)(LvnWindowMovedEvent*, void*))
+{
+    if (event->type == Lvn_EventType_WindowMoved)
+    {
+        LvnWindowMovedEvent eventType{};
+        eventType.type = Lvn_EventType_WindowMoved;
+        eventType.category = Lvn_EventCategory_Window;
+        eventType.name = "LvnWindowMovedEvent";
+        eventType.handled = false;
+        eventType.x = event->data.x;
+        eventType.y = event->data.y;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+bool dispatchWindowResizeEvent(LvnEvent* event, bool(*func)(LvnWindowResizeEvent*, void*))
+{
+
+    if (event->type == Lvn_EventType_WindowResize)
+    {
+        LvnWindowResizeEvent eventType{};
+        eventType.type = Lvn_EventType_WindowResize;
+        eventType.category = Lvn_EventCategory_Window;
+        eventType.name = "LvnWindowResizeEvent";
+        eventType.handled = false;
+        eventType.width = event->data.x;
+        eventType.height = event->data.y;
+
+        return func(&eventType, event->userData);
+    }
+
+    return false;
+}
+
+
+// ------------------------------------------------------------
+// [SECTION]: Window Functions
+// ------------------------------------------------------------
+
+LvnWindowApi getWindowApi()
+{
+    return lvn::getContext()->windowapi;
+}
+
+const char* getWindowApiName()
+{
+    switch (lvn::getContext()->windowapi)
+    {
+        case Lvn_WindowApi_None:  { return "None";  }
+        case Lvn_WindowApi_glfw:  { return "glfw";  }
+        // case Lvn_WindowApi_win32: { return "win32"; }
+    }
+
+    LVN_CORE_ERROR("Unknown Windows API selected!");
+    return LVN_EMPTY_STR;
+}
+
+LvnResult createWindow(LvnWindow** window, const LvnWindowCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (createInfo->width < 0 || createInfo->height < 0)
+    {
+        LVN_CORE_ERROR("createWindow(LvnWindow**, LvnWindowCreateInfo*) | cannot create window with negative dimensions (w:%d,h:%d)", createInfo->width, createInfo->height);
+        return Lvn_Result_Failure;
+    }
+
+    *window = lvn::createObject<LvnWindow>(lvnctx, Lvn_Stype_Window);
+    (*window)->data.redrawRequested.store(true, std::memory_order_relaxed);
+
+    if (createInfo->eventQueueCapacity > 0)
+        (*window)->data.eventQueue = new LvnMpmcQueue<LvnEvent>(createInfo->eventQueueCapacity);
+    if (createInfo->mouseSampleCapacity > 0)
+        (*window)->data.mouseSamples = new LvnSpscQueue<LvnMouseMotionSample>(createInfo->mouseSampleCapacity);
+
+    LVN_CORE_TRACE("created window: (%p), \"%s\" (w:%d,h:%d)", *window, createInfo->title.c_str(), createInfo->width, createInfo->height);
+    return lvnctx->windowContext.createWindow(*window, createInfo);
+}
+
+void destroyWindow(LvnWindow* window)
+{
+    if (window == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::purgePipelineCache(lvnctx, lvn::windowGetRenderPass(window));
+    if (lvnctx->frameStatsWindow == window)
+        lvnctx->frameStatsWindow = nullptr;
+    lvnctx->windowContext.destroyWindow(window);
+    delete window->data.eventQueue;
+    delete window->data.mouseSamples;
+    lvn::destroyObject(lvnctx, window, Lvn_Stype_Window);
+}
+
+LvnWindowCreateInfo configWindowInit(const char* title, int width, int height)
+{
+    LvnWindowCreateInfo windowCreateInfo{};
+    windowCreateInfo.width = width;
+    windowCreateInfo.height = height;
+    windowCreateInfo.title = title;
+    windowCreateInfo.minWidth = 0;
+    windowCreateInfo.minHeight = 0;
+    windowCreateInfo.maxWidth = -1;
+    windowCreateInfo.maxHeight = -1;
+    windowCreateInfo.fullscreen = false;
+    windowCreateInfo.resizable = true;
+    windowCreateInfo.vSync = false;
+    windowCreateInfo.pIcons = nullptr;
+    windowCreateInfo.iconCount = 0;
+    windowCreateInfo.eventCallBack = nullptr;
+    windowCreateInfo.userData = nullptr;
+    windowCreateInfo.mouseSampleCapacity = 0;
+    windowCreateInfo.eventQueueCapacity = 0;
+    windowCreateInfo.headless = false;
+
+    return windowCreateInfo;
+}
+
+void windowUpdate(LvnWindow* window)
+{
+    lvn::getContext()->windowContext.updateWindow(window);
+}
+
+bool windowOpen(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.windowOpen(window);
+}
+
+void windowPollEvents()
+{
+    lvn::getContext()->windowContext.windowPollEvents();
+}
+
+void windowWaitEvents(double timeout)
+{
+    lvn::getContext()->windowContext.windowWaitEvents(timeout);
+}
+
+void windowPostEmptyEvent()
+{
+    lvn::getContext()->windowContext.windowPostEmptyEvent();
+}
+
+void windowInvalidate(LvnWindow* window)
+{
+    window->data.redrawRequested.store(true, std::memory_order_release);
+    lvn::getContext()->windowContext.windowPostEmptyEvent();
+}
+
+bool windowConsumeRedraw(LvnWindow* window)
+{
+    return window->data.redrawRequested.exchange(false, std::memory_order_acq_rel);
+}
+
+LvnPair<int> windowGetDimensions(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getWindowSize(window);
+}
+
+int windowGetWidth(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getWindowWidth(window);
+}
+
+int windowGetHeight(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getWindowHeight(window);
+}
+
+void windowSetEventCallback(LvnWindow* window, void (*callback)(LvnEvent*), void* userData)
+{
+    window->data.eventCallBackFn = callback;
+    window->data.userData = userData;
+}
+
+uint32_t windowConsumeEvents(LvnWindow* window, void (*callback)(LvnEvent*), uint32_t maxCount)
+{
+    if (window->data.eventQueue == nullptr)
+    {
+        LVN_CORE_ERROR("windowConsumeEvents(LvnWindow*, void (*)(LvnEvent*), uint32_t) | window (%p) was not created with an event queue, set eventQueueCapacity in LvnWindowCreateInfo", window);
+        return 0;
+    }
+
+    uint32_t count = 0;
+    LvnEvent event;
+    while (count < maxCount && window->data.eventQueue->try_pop(event))
+    {
+        callback(&event);
+        count++;
+    }
+
+    return count;
+}
+
+void windowSetVSync(LvnWindow* window, bool enable)
+{
+    lvn::getContext()->windowContext.setWindowVSync(window, enable);
+}
+
+bool windowGetVSync(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getWindowVSync(window);
+}
+
+void* windowGetNativeWindow(LvnWindow* window)
+{
+    return window->nativeWindow;
+}
+
+LvnRenderPass* windowGetRenderPass(LvnWindow* window)
+{
+    return &window->renderPass;
+}
+
+void windowSetContextCurrent(LvnWindow* window)
+{
+    lvn::getContext()->windowContext.setWindowContextCurrent(window);
+}
+
+LvnResult windowReadPixels(LvnWindow* window, void* data, uint64_t size)
+{
+    if (data == nullptr)
+    {
+        LVN_CORE_ERROR("windowReadPixels(LvnWindow*, void*, uint64_t) | cannot read pixels of window (%p), data is null", window);
+        return Lvn_Result_Failure;
+    }
+
+    return lvn::getContext()->graphicsContext.windowReadPixels(window, data, size);
+}
+
+// ------------------------------------------------------------
+// [SECTION]: Input Functions
+// ------------------------------------------------------------
+
+bool keyPressed(LvnWindow* window, int keycode)
+{
+    return lvn::getContext()->windowContext.keyPressed(window, keycode);
+}
+
+bool keyReleased(LvnWindow* window, int keycode)
+{
+    return lvn::getContext()->windowContext.keyReleased(window, keycode);
+}
+
+bool mouseButtonPressed(LvnWindow* window, int button)
+{
+    return lvn::getContext()->windowContext.mouseButtonPressed(window, button);
+}
+
+bool mouseButtonReleased(LvnWindow* window, int button)
+{
+    return lvn::getContext()->windowContext.mouseButtonReleased(window, button);
+}
+
+LvnPair<float> mouseGetPos(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getMousePos(window);
+}
+
+void mouseGetPos(LvnWindow* window, float* xpos, float* ypos)
+{
+    lvn::getContext()->windowContext.getMousePosPtr(window, xpos, ypos);
+}
+
+float mouseGetX(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getMouseX(window);
+}
+
+float mouseGetY(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getMouseY(window);
+}
+
+void mouseSetCursor(LvnWindow* window, LvnMouseCursor cursor)
+{
+    lvn::getContext()->windowContext.setMouseCursor(window, cursor);
+}
+
+void mouseSetInputMode(LvnWindow* window, LvnMouseInputMode mode)
+{
+    lvn::getContext()->windowContext.SetMouseInputMode(window, mode);
+}
+
+bool mouseRawMotionSupported()
+{
+    return lvn::getContext()->windowContext.mouseRawMotionSupported();
+}
+
+void mouseSetRawMotion(LvnWindow* window, bool enable)
+{
+    lvn::getContext()->windowContext.setMouseRawMotion(window, enable);
+}
+
+uint32_t mouseGetMotionSamples(LvnWindow* window, LvnMouseMotionSample* samples, uint32_t maxCount)
+{
+    if (window->data.mouseSamples == nullptr)
+    {
+        LVN_CORE_ERROR("mouseGetMotionSamples(LvnWindow*, LvnMouseMotionSample*, uint32_t) | window (%p) was not created with mouse sampling, set mouseSampleCapacity in LvnWindowCreateInfo", window);
+        return 0;
+    }
+
+    uint32_t count = 0;
+    while (count < maxCount && window->data.mouseSamples->try_pop(samples[count]))
+        count++;
+
+    return count;
+}
+
+LvnPair<int> windowGetPos(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getWindowPos(window);
+}
+
+void windowGetPos(LvnWindow* window, int* xpos, int* ypos)
+{
+    lvn::getContext()->windowContext.getWindowPosPtr(window, xpos, ypos);
+}
+
+LvnPair<int> windowGetSize(LvnWindow* window)
+{
+    return lvn::getContext()->windowContext.getWindowSize(window);
+}
+
+void windowGetSize(LvnWindow* window, int* width, int* height)
+{
+    lvn::getContext()->windowContext.getWindowSizePtr(window, width, height);
+}
+
+// ------------------------------------------------------------
+// [SECTION]: Graphics Functions
+// ------------------------------------------------------------
+
+LvnGraphicsApi getGraphicsApi()
+{
+    return lvn::getContext()->graphicsapi;
+}
+
+const char* getGraphicsApiName()
+{
+    switch (lvn::getContext()->graphicsapi)
+    {
+        case Lvn_GraphicsApi_None:   { return "None";   }
+        case Lvn_GraphicsApi_vulkan: { return "vulkan"; }
+        case Lvn_GraphicsApi_opengl: { return "opengl"; }
+    }
+
+    LVN_CORE_ERROR("Unknown Graphics API selected!");
+    return LVN_EMPTY_STR;
+}
+
+void getPhysicalDevices(LvnPhysicalDevice** pPhysicalDevices, uint32_t* deviceCount)
+{
+    uint32_t getDeviceCount;
+    lvn::getContext()->graphicsContext.getPhysicalDevices(nullptr, &getDeviceCount);
+
+    if (deviceCount != nullptr)
+        *deviceCount = getDeviceCount;
+
+    if (pPhysicalDevices == nullptr)
+        return;
+
+    lvn::getContext()->graphicsContext.getPhysicalDevices(pPhysicalDevices, &getDeviceCount);
+
+    return;
+}
+
+LvnPhysicalDeviceProperties getPhysicalDeviceProperties(LvnPhysicalDevice* physicalDevice)
+{
+    return physicalDevice->properties;
+}
+
+LvnPhysicalDeviceFeatures getPhysicalDeviceFeatures(LvnPhysicalDevice* physicalDevice)
+{
+    return physicalDevice->features;
+}
+
+LvnResult checkPhysicalDeviceSupport(LvnPhysicalDevice* physicalDevice)
+{
+    if (physicalDevice == nullptr)
+    {
+        LVN_CORE_ERROR("cannot check physical device support, physicalDevice is nullptr");
+        return Lvn_Result_Failure;
+    }
+
+    return lvn::getContext()->graphicsContext.checkPhysicalDeviceSupport(physicalDevice);
+}
+
+LvnResult setPhysicalDevice(LvnPhysicalDevice* physicalDevice)
+{
+    if (physicalDevice == nullptr)
+    {
+        LVN_CORE_ERROR("cannot set physical device, physicalDevice is nullptr");
+        return Lvn_Result_Failure;
+    }
+
+    return lvn::getContext()->graphicsContext.setPhysicalDevice(physicalDevice);
+}
+
+LvnClipRegion getRenderClipRegionEnum()
+{
+    return lvn::getContext()->matrixClipRegion;
+}
+
+void renderCmdDraw(LvnWindow* window, uint32_t vertexCount)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdDraw* cmd = lvn::allocateCommandListCmd<LvnCmdDraw>(window, lvn::replayCmdDraw, 0);
+        cmd->vertexCount = vertexCount;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountDraw(lvnctx, vertexCount, 1);
+    lvnctx->graphicsContext.renderCmdDraw(window, vertexCount);
+}
+
+void renderCmdDrawIndexed(LvnWindow* window, uint32_t indexCount)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdDrawIndexed* cmd = lvn::allocateCommandListCmd<LvnCmdDrawIndexed>(window, lvn::replayCmdDrawIndexed, 0);
+        cmd->indexCount = indexCount;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountDraw(lvnctx, indexCount, 1);
+    lvnctx->graphicsContext.renderCmdDrawIndexed(window, indexCount);
+}
+
+void renderCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdDrawInstanced* cmd = lvn::allocateCommandListCmd<LvnCmdDrawInstanced>(window, lvn::replayCmdDrawInstanced, 0);
+        cmd->vertexCount = vertexCount;
+        cmd->instanceCount = instanceCount;
+        cmd->firstInstance = firstInstance;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountDraw(lvnctx, vertexCount, instanceCount);
+    lvnctx->graphicsContext.renderCmdDrawInstanced(window, vertexCount, instanceCount, firstInstance);
+}
+
+void renderCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdDrawIndexedInstanced* cmd = lvn::allocateCommandListCmd<LvnCmdDrawIndexedInstanced>(window, lvn::replayCmdDrawIndexedInstanced, 0);
+        cmd->indexCount = indexCount;
+        cmd->instanceCount = instanceCount;
+        cmd->firstInstance = firstInstance;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountDraw(lvnctx, indexCount, instanceCount);
+    lvnctx->graphicsContext.renderCmdDrawIndexedInstanced(window, indexCount, instanceCount, firstInstance);
+}
+
+void renderCmdDrawIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    LVN_CORE_ASSERT(buffer->type & Lvn_BufferType_Indirect, "buffer was not created with Lvn_BufferType_Indirect");
+    if (stride == 0) { stride = sizeof(LvnDrawIndirectCommand); }
+
+    if (window->commandList != nullptr)
+    {
+        LvnCmdDrawIndirect* cmd = lvn::allocateCommandListCmd<LvnCmdDrawIndirect>(window, lvn::replayCmdDrawIndirect, 0);
+        cmd->buffer = buffer;
+        cmd->offset = offset;
+        cmd->drawCount = drawCount;
+        cmd->stride = stride;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountIndirect(lvnctx, drawCount);
+    lvnctx->graphicsContext.renderCmdDrawIndirect(window, buffer, offset, drawCount, stride);
+}
+
+void renderCmdDrawIndexedIndirect(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    LVN_CORE_ASSERT(buffer->type & Lvn_BufferType_Indirect, "buffer was not created with Lvn_BufferType_Indirect");
+    if (stride == 0) { stride = sizeof(LvnDrawIndexedIndirectCommand); }
+
+    if (window->commandList != nullptr)
+    {
+        LvnCmdDrawIndirect* cmd = lvn::allocateCommandListCmd<LvnCmdDrawIndirect>(window, lvn::replayCmdDrawIndexedIndirect, 0);
+        cmd->buffer = buffer;
+        cmd->offset = offset;
+        cmd->drawCount = drawCount;
+        cmd->stride = stride;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountIndirect(lvnctx, drawCount);
+    lvnctx->graphicsContext.renderCmdDrawIndexedIndirect(window, buffer, offset, drawCount, stride);
+}
+
+void renderCmdDrawIndexedIndirectCount(LvnWindow* window, LvnBuffer* buffer, uint64_t offset, LvnBuffer* countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    LVN_CORE_ASSERT(buffer->type & Lvn_BufferType_Indirect, "buffer was not created with Lvn_BufferType_Indirect");
+    LVN_CORE_ASSERT(countBuffer->type & Lvn_BufferType_Indirect, "count buffer was not created with Lvn_BufferType_Indirect");
+    if (stride == 0) { stride = sizeof(LvnDrawIndexedIndirectCommand); }
+
+    if (window->commandList != nullptr)
+    {
+        LvnCmdDrawIndirect* cmd = lvn::allocateCommandListCmd<LvnCmdDrawIndirect>(window, lvn::replayCmdDrawIndexedIndirectCount, 0);
+        cmd->buffer = buffer;
+        cmd->offset = offset;
+        cmd->countBuffer = countBuffer;
+        cmd->countBufferOffset = countBufferOffset;
+        cmd->drawCount = maxDrawCount;
+        cmd->stride = stride;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountIndirect(lvnctx, maxDrawCount);
+    lvnctx->graphicsContext.renderCmdDrawIndexedIndirectCount(window, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+void renderCmdSetStencilReference(uint32_t reference)
+{
+
+}
+
+void renderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask)
+{
+
+}
+
+void renderCmdSetCullMode(LvnWindow* window, LvnCullFaceMode cullMode)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdSetCullMode* cmd = lvn::allocateCommandListCmd<LvnCmdSetCullMode>(window, lvn::replayCmdSetCullMode, 0);
+        cmd->cullMode = cullMode;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdSetCullMode(window, cullMode);
+}
+
+void renderCmdSetFrontFace(LvnWindow* window, LvnCullFrontFace frontFace)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdSetFrontFace* cmd = lvn::allocateCommandListCmd<LvnCmdSetFrontFace>(window, lvn::replayCmdSetFrontFace, 0);
+        cmd->frontFace = frontFace;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdSetFrontFace(window, frontFace);
+}
+
+void renderCmdSetPrimitiveTopology(LvnWindow* window, LvnTopologyType topology)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdSetPrimitiveTopology* cmd = lvn::allocateCommandListCmd<LvnCmdSetPrimitiveTopology>(window, lvn::replayCmdSetPrimitiveTopology, 0);
+        cmd->topology = topology;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdSetPrimitiveTopology(window, topology);
+}
+
+void renderCmdSetDepthTest(LvnWindow* window, bool enableDepth, bool depthWrite, LvnCompareOperation depthOpCompare)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdSetDepthTest* cmd = lvn::allocateCommandListCmd<LvnCmdSetDepthTest>(window, lvn::replayCmdSetDepthTest, 0);
+        cmd->enableDepth = enableDepth;
+        cmd->depthWrite = depthWrite;
+        cmd->depthOpCompare = depthOpCompare;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdSetDepthTest(window, enableDepth, depthWrite, depthOpCompare);
+}
+
+void renderCmdSetBlendEnable(LvnWindow* window, uint32_t attachment, bool enable)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdSetBlendEnable* cmd = lvn::allocateCommandListCmd<LvnCmdSetBlendEnable>(window, lvn::replayCmdSetBlendEnable, 0);
+        cmd->attachment = attachment;
+        cmd->enable = enable;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdSetBlendEnable(window, attachment, enable);
+}
+
+void renderCmdSetScissor(LvnWindow* window, int32_t x, int32_t y, uint32_t width, uint32_t height)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdSetScissor* cmd = lvn::allocateCommandListCmd<LvnCmdSetScissor>(window, lvn::replayCmdSetScissor, 0);
+        cmd->x = x;
+        cmd->y = y;
+        cmd->width = width;
+        cmd->height = height;
+        return;
+    }
+
+    int windowWidth, windowHeight;
+    lvn::windowGetSize(window, &windowWidth, &windowHeight);
+    if (windowWidth * windowHeight <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdSetScissor(window, x, y, width, height);
+}
+
+void renderBeginNextFrame(LvnWindow* window)
+{
+    LVN_PROFILE_FUNCTION();
+
+    // reset before the minimized check so a minimized window does not keep growing its arena
+    window->frameArena.reset();
+
+    LvnContext* lvnctx = lvn::getContext();
+    if (lvnctx->frameStatsWindow == nullptr)
+        lvnctx->frameStatsWindow = window;
+    if (lvnctx->frameStatsWindow == window)
+    {
+        lvn::frameStatsNextFrame(lvnctx);
+
+        // edited assets are swapped in between frames, before any command of the next frame is recorded
+        if (lvnctx->hotReloadEnabled)
+            lvn::hotReloadUpdate();
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvnctx->graphicsContext.renderBeginNextFrame(window);
+}
+
+LvnArena* renderGetFrameArena(LvnWindow* window)
+{
+    return &window->frameArena;
+}
+
+void renderDrawSubmit(LvnWindow* window)
+{
+    LVN_PROFILE_FUNCTION();
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderDrawSubmit(window);
+}
+
+void renderBeginSubmitBatch()
+{
+    lvn::getContext()->graphicsContext.renderBeginSubmitBatch();
+}
+
+void renderEndSubmitBatch()
+{
+    LVN_PROFILE_FUNCTION();
+    lvn::getContext()->graphicsContext.renderEndSubmitBatch();
+}
+
+void renderBeginCommandRecording(LvnWindow* window)
+{
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderBeginCommandRecording(window);
+}
+
+void renderEndCommandRecording(LvnWindow* window)
+{
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderEndCommandRecording(window);
+}
+
+LvnResult renderBeginSecondaryCommandRecording(LvnWindow* window, LvnFrameBuffer* frameBuffer)
+{
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return Lvn_Result_Failure; }
+
+    return lvn::getContext()->graphicsContext.renderBeginSecondaryCommandRecording(window, frameBuffer);
+}
+
+void renderEndSecondaryCommandRecording(LvnWindow* window)
+{
+    lvn::getContext()->graphicsContext.renderEndSecondaryCommandRecording(window);
+}
+
+LvnResult renderBeginCommandList(LvnWindow* window, LvnCommandList* commandList)
+{
+    if (window->commandList != nullptr)
+    {
+        LVN_CORE_ERROR("renderBeginCommandList(LvnWindow*, LvnCommandList*) | window is already recording command list (%p), end it before beginning another", window->commandList);
+        return Lvn_Result_Failure;
+    }
+
+    // the arena keeps its capacity, rerecording a list of the same size does not allocate
+    commandList->window = window;
+    commandList->size = 0;
+    commandList->commandCount = 0;
+    window->commandList = commandList;
+
+    return Lvn_Result_Success;
+}
+
+void renderEndCommandList(LvnWindow* window)
+{
+    window->commandList = nullptr;
+}
+
+void renderCmdExecuteCommandList(LvnWindow* window, LvnCommandList* commandList)
+{
+    LVN_CORE_ASSERT(commandList->size == 0 || commandList->window == window, "command list was recorded for a different window");
+
+    if (window->commandList != nullptr)
+    {
+        if (window->commandList == commandList)
+        {
+            LVN_CORE_ERROR("renderCmdExecuteCommandList(LvnWindow*, LvnCommandList*) | command list (%p) cannot be executed while it is being recorded", commandList);
+            return;
+        }
+
+        LvnCmdExecuteCommandList* cmd = lvn::allocateCommandListCmd<LvnCmdExecuteCommandList>(window, lvn::replayCmdExecuteCommandList, 0);
+        cmd->commandList = commandList;
+        return;
+    }
+
+    // commands were validated when recorded, the window is only checked once for the whole list
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::frameStatsAdd(lvn::getContext(), Lvn_FrameStat_CommandListsExecuted, 1);
+
+    uint64_t offset = 0;
+    uint8_t* data = commandList->commands.data();
+
+    while (offset < commandList->size)
+    {
+        LvnDrawCmdHeader* header = reinterpret_cast<LvnDrawCmdHeader*>(&data[offset]);
+        header->callFunc(&data[offset]);
+        offset += header->size;
+    }
+}
+
+void renderCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdBeginRenderPass* cmd = lvn::allocateCommandListCmd<LvnCmdBeginRenderPass>(window, lvn::replayCmdBeginRenderPass, 0);
+        cmd->r = r;
+        cmd->g = g;
+        cmd->b = b;
+        cmd->a = a;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_RenderPasses, 1);
+    lvnctx->graphicsContext.renderCmdBeginRenderPass(window, r, g, b, a);
+}
+
+void renderCmdEndRenderPass(LvnWindow* window)
+{
+    if (window->commandList != nullptr)
+    {
+        lvn::allocateCommandListCmd<LvnCmdEndRenderPass>(window, lvn::replayCmdEndRenderPass, 0);
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdEndRenderPass(window);
+}
+
+void renderCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdBindPipeline* cmd = lvn::allocateCommandListCmd<LvnCmdBindPipeline>(window, lvn::replayCmdBindPipeline, 0);
+        cmd->pipeline = pipeline;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_PipelineBinds, 1);
+    lvnctx->graphicsContext.renderCmdBindPipeline(window, lvn::getBindablePipeline(pipeline));
+}
+
+void renderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets)
+{
+    if (window->commandList != nullptr)
+    {
+        // the buffer and offset arrays are copied after the command, offsets default to zero like below
+        LvnCmdBindVertexBuffer* cmd = lvn::allocateCommandListCmd<LvnCmdBindVertexBuffer>(window, lvn::replayCmdBindVertexBuffer, bindingCount * (sizeof(LvnBuffer*) + sizeof(uint64_t)));
+        cmd->firstBinding = firstBinding;
+        cmd->bindingCount = bindingCount;
+        LvnBuffer** buffers = reinterpret_cast<LvnBuffer**>(cmd + 1);
+        memcpy(buffers, pBuffers, bindingCount * sizeof(LvnBuffer*));
+        if (pOffsets != nullptr)
+            memcpy(buffers + bindingCount, pOffsets, bindingCount * sizeof(uint64_t));
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    uint64_t offsets[] = {0};
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_VertexBufferBinds, bindingCount);
+    lvnctx->graphicsContext.renderCmdBindVertexBuffer(window, firstBinding, bindingCount, pBuffers, pOffsets ? pOffsets : offsets);
+}
+
+void renderCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdBindIndexBuffer* cmd = lvn::allocateCommandListCmd<LvnCmdBindIndexBuffer>(window, lvn::replayCmdBindIndexBuffer, 0);
+        cmd->buffer = buffer;
+        cmd->offset = offset;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_IndexBufferBinds, 1);
+    lvnctx->graphicsContext.renderCmdBindIndexBuffer(window, buffer, offset);
+}
+
+void renderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets)
+{
+    if (window->commandList != nullptr)
+    {
+        // the descriptor set array and dynamic offsets are copied after the command
+        LvnCmdBindDescriptorSets* cmd = lvn::allocateCommandListCmd<LvnCmdBindDescriptorSets>(window, lvn::replayCmdBindDescriptorSets, descriptorSetCount * sizeof(LvnDescriptorSet*) + 0);
+        cmd->pipeline = pipeline;
+        cmd->firstSetIndex = firstSetIndex;
+        cmd->descriptorSetCount = descriptorSetCount;
+        cmd->dynamicOffsetCount = 0;
+        LvnDescriptorSet** descriptorSets = reinterpret_cast<LvnDescriptorSet**>(cmd + 1);
+        memcpy(descriptorSets, pDescriptorSets, descriptorSetCount * sizeof(LvnDescriptorSet*));
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_DescriptorSetBinds, descriptorSetCount);
+    lvnctx->graphicsContext.renderCmdBindDescriptorSets(window, lvn::getBindablePipeline(pipeline), firstSetIndex, descriptorSetCount, pDescriptorSets, 0, nullptr);
+}
+
+void renderCmdBindDescriptorSetsDynamic(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets)
+{
+    if (window->commandList != nullptr)
+    {
+        // the descriptor set array and dynamic offsets are copied after the command
+        LvnCmdBindDescriptorSets* cmd = lvn::allocateCommandListCmd<LvnCmdBindDescriptorSets>(window, lvn::replayCmdBindDescriptorSets, descriptorSetCount * sizeof(LvnDescriptorSet*) + dynamicOffsetCount * sizeof(uint32_t));
+        cmd->pipeline = pipeline;
+        cmd->firstSetIndex = firstSetIndex;
+        cmd->descriptorSetCount = descriptorSetCount;
+        cmd->dynamicOffsetCount = dynamicOffsetCount;
+        LvnDescriptorSet** descriptorSets = reinterpret_cast<LvnDescriptorSet**>(cmd + 1);
+        memcpy(descriptorSets, pDescriptorSets, descriptorSetCount * sizeof(LvnDescriptorSet*));
+        if (dynamicOffsetCount > 0)
+            memcpy(descriptorSets + descriptorSetCount, pDynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_DescriptorSetBinds, descriptorSetCount);
+    lvnctx->graphicsContext.renderCmdBindDescriptorSets(window, lvn::getBindablePipeline(pipeline), firstSetIndex, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+}
+
+void renderCmdDispatch(LvnWindow* window, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdDispatch* cmd = lvn::allocateCommandListCmd<LvnCmdDispatch>(window, lvn::replayCmdDispatch, 0);
+        cmd->groupCountX = groupCountX;
+        cmd->groupCountY = groupCountY;
+        cmd->groupCountZ = groupCountZ;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_Dispatches, 1);
+    lvnctx->graphicsContext.renderCmdDispatch(window, groupCountX, groupCountY, groupCountZ);
+}
+
+void renderCmdMemoryBarrier(LvnWindow* window, LvnMemoryBarrierFlagBits barriers)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdMemoryBarrier* cmd = lvn::allocateCommandListCmd<LvnCmdMemoryBarrier>(window, lvn::replayCmdMemoryBarrier, 0);
+        cmd->barriers = barriers;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdMemoryBarrier(window, barriers);
+}
+
+void renderCmdBeginTimestamp(LvnWindow* window, const char* name)
+{
+    if (window->commandList != nullptr)
+    {
+        // the scope name is copied so the caller's string does not have to outlive the list
+        uint32_t nameLength = strlen(name);
+        LvnCmdBeginTimestamp* cmd = lvn::allocateCommandListCmd<LvnCmdBeginTimestamp>(window, lvn::replayCmdBeginTimestamp, nameLength + 1);
+        cmd->nameLength = nameLength;
+        memcpy(cmd + 1, name, nameLength);
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdBeginTimestamp(window, name);
+}
+
+void renderCmdEndTimestamp(LvnWindow* window)
+{
+    if (window->commandList != nullptr)
+    {
+        lvn::allocateCommandListCmd<LvnCmdEndTimestamp>(window, lvn::replayCmdEndTimestamp, 0);
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdEndTimestamp(window);
+}
+
+// budget warnings name the counter, indexed by LvnFrameStat
+static const struct { uint64_t LvnFrameStats::* member; const char* name; } s_FrameStatMembers[] =
+{
+    { &LvnFrameStats::drawCalls,               "draw calls" },
+    { &LvnFrameStats::vertices,                "vertices" },
+    { &LvnFrameStats::instances,               "instances" },
+    { &LvnFrameStats::indirectDraws,           "indirect draws" },
+    { &LvnFrameStats::dispatches,              "dispatches" },
+    { &LvnFrameStats::renderPasses,            "render passes" },
+    { &LvnFrameStats::pipelineBinds,           "pipeline binds" },
+    { &LvnFrameStats::descriptorSetBinds,      "descriptor set binds" },
+    { &LvnFrameStats::vertexBufferBinds,       "vertex buffer binds" },
+    { &LvnFrameStats::indexBufferBinds,        "index buffer binds" },
+    { &LvnFrameStats::pushConstantBytes,       "push constant bytes" },
+    { &LvnFrameStats::commandListsExecuted,    "command lists executed" },
+    { &LvnFrameStats::bufferUploads,           "buffer uploads" },
+    { &LvnFrameStats::bufferUploadBytes,       "buffer upload bytes" },
+};
+static_assert(sizeof(s_FrameStatMembers) / sizeof(s_FrameStatMembers[0]) == Lvn_FrameStat_Max_Value, "every frame stat counter needs a member in s_FrameStatMembers");
+
+static void frameStatsAdd(LvnContext* lvnctx, LvnFrameStat stat, uint64_t count)
+{
+    lvnctx->frameStatCounters[stat].fetch_add(count, std::memory_order_relaxed);
+}
+
+static void frameStatsCountDraw(LvnContext* lvnctx, uint64_t vertexCount, uint32_t instanceCount)
+{
+    lvnctx->frameStatCounters[Lvn_FrameStat_DrawCalls].fetch_add(1, std::memory_order_relaxed);
+    lvnctx->frameStatCounters[Lvn_FrameStat_Vertices].fetch_add(vertexCount * instanceCount, std::memory_order_relaxed);
+    lvnctx->frameStatCounters[Lvn_FrameStat_Instances].fetch_add(instanceCount, std::memory_order_relaxed);
+}
+
+static void frameStatsCountIndirect(LvnContext* lvnctx, uint32_t drawCount)
+{
+    lvnctx->frameStatCounters[Lvn_FrameStat_DrawCalls].fetch_add(1, std::memory_order_relaxed);
+    lvnctx->frameStatCounters[Lvn_FrameStat_IndirectDraws].fetch_add(drawCount, std::memory_order_relaxed);
+}
+
+static void frameStatsNextFrame(LvnContext* lvnctx)
+{
+    uint64_t ticks = lvn::profileGetTicks();
+
+    LvnFrameStats stats{};
+    for (uint32_t i = 0; i < Lvn_FrameStat_Max_Value; i++)
+        stats.*s_FrameStatMembers[i].member = lvnctx->frameStatCounters[i].exchange(0, std::memory_order_relaxed);
+
+    // work before the first frame (eg. loading) is not a frame
+    if (lvnctx->frameStatsBeginTicks == 0)
+    {
+        lvnctx->frameStatsBeginTicks = ticks;
+        return;
+    }
+
+    stats.cpuMilliseconds = (ticks - lvnctx->frameStatsBeginTicks) / 1000000.0;
+    lvnctx->frameStatsBeginTicks = ticks;
+
+    uint32_t overBudget = Lvn_FrameStat_Max_Value;
+    uint64_t budget = 0;
+    {
+        LvnSpinLockGaurd lock(lvnctx->frameStatsLock);
+        stats.frameIndex = lvnctx->frameStatsCount;
+        lvnctx->frameStatsHistory[lvnctx->frameStatsCount % LVN_FRAME_STATS_HISTORY] = stats;
+        lvnctx->frameStatsCount++;
+
+        if (lvnctx->frameStatsHasBudget)
+        {
+            for (uint32_t i = 0; i < Lvn_FrameStat_Max_Value; i++)
+            {
+                budget = lvnctx->frameStatsBudget.*s_FrameStatMembers[i].member;
+                if (budget > 0 && stats.*s_FrameStatMembers[i].member > budget)
+                {
+                    overBudget = i;
+                    break;
+                }
+            }
+
+            if (overBudget != Lvn_FrameStat_Max_Value)
+                lvnctx->frameStatsOverBudget++;
+        }
+    }
+
+    if (overBudget != Lvn_FrameStat_Max_Value)
+    {
+        uint64_t count = stats.*s_FrameStatMembers[overBudget].member;
+        LVN_LOG_RATE_LIMIT(1.0, 3, LVN_CORE_WARN, "frame %llu is over its budget, %s: %llu (budget: %llu)", (unsigned long long)stats.frameIndex, s_FrameStatMembers[overBudget].name, (unsigned long long)count, (unsigned long long)budget);
+    }
+}
+
+LvnFrameStats getFrameStats()
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnSpinLockGaurd lock(lvnctx->frameStatsLock);
+
+    if (lvnctx->frameStatsCount == 0)
+        return LvnFrameStats{};
+
+    return lvnctx->frameStatsHistory[(lvnctx->frameStatsCount - 1) % LVN_FRAME_STATS_HISTORY];
+}
+
+uint32_t getFrameStatsHistory(LvnFrameStats* pStats, uint32_t statsCount)
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnSpinLockGaurd lock(lvnctx->frameStatsLock);
+
+    uint32_t available = static_cast<uint32_t>(lvn::min<uint64_t>(lvnctx->frameStatsCount, LVN_FRAME_STATS_HISTORY));
+    if (pStats == nullptr)
+        return available;
+
+    // the newest frames are kept when fewer are asked for
+    uint32_t count = lvn::min(statsCount, available);
+    uint64_t first = lvnctx->frameStatsCount - count;
+    for (uint32_t i = 0; i < count; i++)
+        pStats[i] = lvnctx->frameStatsHistory[(first + i) % LVN_FRAME_STATS_HISTORY];
+
+    return count;
+}
+
+void setFrameStatsBudget(const LvnFrameStats* budget)
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnSpinLockGaurd lock(lvnctx->frameStatsLock);
+
+    lvnctx->frameStatsBudget = budget ? *budget : LvnFrameStats{};
+    lvnctx->frameStatsHasBudget = budget != nullptr;
+    lvnctx->frameStatsOverBudget = 0;
+}
+
+uint64_t getFrameStatsOverBudgetCount()
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnSpinLockGaurd lock(lvnctx->frameStatsLock);
+    return lvnctx->frameStatsOverBudget;
+}
+
+uint32_t renderGetTimestamps(LvnWindow* window, LvnGpuTimestamp* pTimestamps, uint32_t timestampCount)
+{
+    if (pTimestamps == nullptr)
+        return window->timestamps.size();
+
+    uint32_t count = lvn::min(timestampCount, static_cast<uint32_t>(window->timestamps.size()));
+    for (uint32_t i = 0; i < count; i++)
+    {
+        pTimestamps[i].name = window->timestamps[i].name.c_str();
+        pTimestamps[i].milliseconds = window->timestamps[i].milliseconds;
+        pTimestamps[i].depth = window->timestamps[i].depth;
+    }
+
+    return count;
+}
+
+void renderCmdPushConstants(LvnWindow* window, LvnPipeline* pipeline, LvnShaderStage shaderStage, uint32_t offset, uint32_t size, const void* data)
+{
+    if (window->commandList != nullptr)
+    {
+        // the push constant data is copied after the command
+        LvnCmdPushConstants* cmd = lvn::allocateCommandListCmd<LvnCmdPushConstants>(window, lvn::replayCmdPushConstants, size);
+        cmd->pipeline = pipeline;
+        cmd->shaderStage = shaderStage;
+        cmd->offset = offset;
+        cmd->size = size;
+        memcpy(cmd + 1, data, size);
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_PushConstantBytes, size);
+    lvnctx->graphicsContext.renderCmdPushConstants(window, lvn::getBindablePipeline(pipeline), shaderStage, offset, size, data);
+}
+
+void renderCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdBeginFrameBuffer* cmd = lvn::allocateCommandListCmd<LvnCmdBeginFrameBuffer>(window, lvn::replayCmdBeginFrameBuffer, 0);
+        cmd->frameBuffer = frameBuffer;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_RenderPasses, 1);
+    lvnctx->graphicsContext.renderCmdBeginFrameBuffer(window, frameBuffer);
+}
+
+void renderCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
+{
+    if (window->commandList != nullptr)
+    {
+        LvnCmdEndFrameBuffer* cmd = lvn::allocateCommandListCmd<LvnCmdEndFrameBuffer>(window, lvn::replayCmdEndFrameBuffer, 0);
+        cmd->frameBuffer = frameBuffer;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdEndFrameBuffer(window, frameBuffer);
+}
+
+void renderCmdReadbackFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, LvnReadbackFunc func, void* userData)
+{
+    LVN_CORE_ASSERT(frameBuffer != nullptr, "frameBuffer cannot be nullptr");
+    LVN_CORE_ASSERT(func != nullptr, "readback func cannot be nullptr");
+
+    if (window->commandList != nullptr)
+    {
+        LvnCmdReadbackFrameBuffer* cmd = lvn::allocateCommandListCmd<LvnCmdReadbackFrameBuffer>(window, lvn::replayCmdReadbackFrameBuffer, 0);
+        cmd->frameBuffer = frameBuffer;
+        cmd->attachmentIndex = attachmentIndex;
+        cmd->func = func;
+        cmd->userData = userData;
+        return;
+    }
+
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return; }
+
+    lvn::getContext()->graphicsContext.renderCmdReadbackFrameBuffer(window, frameBuffer, attachmentIndex, func, userData);
+}
+
+void renderCmdCaptureFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, const char* filename, int jpgQuality)
+{
+    if (filename == nullptr)
+    {
+        LVN_CORE_ERROR("renderCmdCaptureFrameBuffer(LvnWindow*, LvnFrameBuffer*, uint32_t, const char*, int) | cannot capture framebuffer (%p), filename is null", frameBuffer);
+        return;
+    }
+
+    // freed by the readback callback once the file is written
+    LvnFrameCapture* capture = lvn::memNew<LvnFrameCapture>();
+    capture->filename = filename;
+    capture->jpgQuality = lvn::clamp(jpgQuality, 0, 100);
+
+    lvn::renderCmdReadbackFrameBuffer(window, frameBuffer, attachmentIndex, lvn::writeFrameCapture, capture);
+}
+
+static void writeFrameCapture(const LvnReadbackData* readback, void* userData)
+{
+    LvnFrameCapture* capture = static_cast<LvnFrameCapture*>(userData);
+
+    bool eightBit = readback->format == Lvn_ColorImageFormat_RGB || readback->format == Lvn_ColorImageFormat_RGBA || readback->format == Lvn_ColorImageFormat_RGBA8
+        || readback->format == Lvn_ColorImageFormat_SRGB || readback->format == Lvn_ColorImageFormat_SRGBA || readback->format == Lvn_ColorImageFormat_SRGBA8;
+
+    if (!eightBit)
+    {
+        LVN_CORE_ERROR("renderCmdCaptureFrameBuffer(LvnWindow*, LvnFrameBuffer*, uint32_t, const char*, int) | cannot write capture \"%s\", only attachments with 8 bit channels can be encoded", capture->filename.c_str());
+        lvn::memDelete(capture);
+        return;
+    }
+
+    LvnImageData imageData{};
+    imageData.pixels = LvnData<uint8_t>(static_cast<const uint8_t*>(readback->pixels), readback->size);
+    imageData.width = readback->width;
+    imageData.height = readback->height;
+    imageData.channels = readback->pixelSize;
+    imageData.size = readback->size;
+
+    LvnResult result = capture->jpgQuality > 0
+        ? lvn::writeImageJpg(imageData, capture->filename.c_str(), capture->jpgQuality)
+        : lvn::writeImagePng(imageData, capture->filename.c_str());
+
+    if (result != Lvn_Result_Success)
+        LVN_CORE_ERROR("renderCmdCaptureFrameBuffer(LvnWindow*, LvnFrameBuffer*, uint32_t, const char*, int) | failed to write capture \"%s\"", capture->filename.c_str());
+
+    lvn::memDelete(capture);
+}
+
+LvnResult createShaderFromSrc(LvnShader** shader, const LvnShaderCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (!createInfo->computeSrc.empty())
+    {
+        *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+
+        LVN_CORE_TRACE("created compute shader: (%p)", *shader);
+        return lvnctx->graphicsContext.createShaderFromSrc(*shader, createInfo);
+    }
+
+    if (createInfo->vertexSrc.empty())
+    {
+        LVN_CORE_ERROR("createShaderFromSrc(LvnShader**, LvnShaderCreateInfo*) | createInfo->vertexSrc is nullptr, cannot create shader without the vertex shader source");
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->fragmentSrc.empty())
+    {
+        LVN_CORE_ERROR("createShaderFromSrc(LvnShader**, LvnShaderCreateInfo*) | createInfo->fragmentSrc is nullptr, cannot create shader without the fragment shader source");
+        return Lvn_Result_Failure;
+    }
+
+    *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+
+    LVN_CORE_TRACE("created shader (from source): (%p)", *shader);
+    return lvnctx->graphicsContext.createShaderFromSrc(*shader, createInfo);
+}
+
+LvnResult createShaderFromFileSrc(LvnShader** shader, const LvnShaderCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (!createInfo->computeSrc.empty())
+    {
+        *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+
+        LVN_CORE_TRACE("created compute shader: (%p)", *shader);
+        LvnResult result = lvnctx->graphicsContext.createShaderFromFileSrc(*shader, createInfo);
+        if (result == Lvn_Result_Success && lvnctx->hotReloadEnabled)
+            lvn::hotReloadTrackShader(lvnctx, *shader, createInfo, false);
+
+        return result;
+    }
+
+    if (createInfo->vertexSrc.empty())
+    {
+        LVN_CORE_ERROR("createShaderFromFileSrc(LvnShader**, LvnShaderCreateInfo*) | createInfo->vertexSrc is nullptr, cannot create shader without the vertex shader source");
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->fragmentSrc.empty())
+    {
+        LVN_CORE_ERROR("createShaderFromFileSrc(LvnShader**, LvnShaderCreateInfo*) | createInfo->fragmentSrc is nullptr, cannot create shader without the fragment shader source");
+        return Lvn_Result_Failure;
+    }
+
+    *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+
+    LVN_CORE_TRACE("created shader (from source file): (%p), vertex file: %s, fragment file: %s", *shader, createInfo->vertexSrc.c_str(), createInfo->fragmentSrc.c_str());
+    LvnResult result = lvnctx->graphicsContext.createShaderFromFileSrc(*shader, createInfo);
+    if (result == Lvn_Result_Success && lvnctx->hotReloadEnabled)
+        lvn::hotReloadTrackShader(lvnctx, *shader, createInfo, false);
+
+    return result;
+}
+
+LvnResult createShaderFromFileBin(LvnShader** shader, const LvnShaderCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (!createInfo->computeSrc.empty())
+    {
+        *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+
+        LVN_CORE_TRACE("created compute shader: (%p)", *shader);
+        LvnResult result = lvnctx->graphicsContext.createShaderFromFileBin(*shader, createInfo);
+        if (result == Lvn_Result_Success && lvnctx->hotReloadEnabled)
+            lvn::hotReloadTrackShader(lvnctx, *shader, createInfo, true);
+
+        return result;
+    }
+
+    if (createInfo->vertexSrc.empty())
+    {
+        LVN_CORE_ERROR("createShaderFileBin(LvnShader**, LvnShaderCreateInfo*) | createInfo->vertexSrc is nullptr, cannot create shader without the vertex shader source");
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->fragmentSrc.empty())
+    {
+        LVN_CORE_ERROR("createShaderFileBin(LvnShader**, LvnShaderCreateInfo*) | createInfo->fragmentSrc is nullptr, cannot create shader without the fragment shader source");
+        return Lvn_Result_Failure;
+    }
+
+    *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+
+    LVN_CORE_TRACE("created shader (from binary file): (%p), vertex file: %s, fragment file: %s", *shader, createInfo->vertexSrc.c_str(), createInfo->fragmentSrc.c_str());
+    LvnResult result = lvnctx->graphicsContext.createShaderFromFileBin(*shader, createInfo);
+    if (result == Lvn_Result_Success && lvnctx->hotReloadEnabled)
+        lvn::hotReloadTrackShader(lvnctx, *shader, createInfo, true);
+
+    return result;
+}
+
+LvnResult createDescriptorLayout(LvnDescriptorLayout** descriptorLayout, const LvnDescriptorLayoutCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (!createInfo->descriptorBindingCount)
+    {
+        LVN_CORE_ERROR("createDescriptorLayout(LvnDescriptorLayout**, LvnDescriptorLayoutCreateInfo*) | createInfo->descriptorBindingCount is 0, cannot create descriptor layout without the descriptor bindings count");
+        return Lvn_Result_Failure;
+    }
+
+    if (!createInfo->pDescriptorBindings)
+    {
+        LVN_CORE_ERROR("createDescriptorLayout(LvnDescriptorLayout**, LvnDescriptorLayoutCreateInfo*) | createInfo->pDescriptorBindings is nullptr, cannot create descriptor layout without the pointer to the array of descriptor bindings");
+        return Lvn_Result_Failure;
+    }
+
+    for (uint32_t i = 0; i < createInfo->descriptorBindingCount; i++)
+    {
+        if (createInfo->pDescriptorBindings[i].maxAllocations == 0)
+            LVN_CORE_WARN("createDescriptorLayout(LvnDescriptorLayout**, LvnDescriptorLayoutCreateInfo*) | createInfo->pDescriptorBindings[%u].maxAllocations is 0, no descriptors will be allocated for this binding which may not be intentional", i);
+
+        if (createInfo->pDescriptorBindings[i].descriptorCount == 0)
+            LVN_CORE_WARN("createDescriptorLayout(LvnDescriptorLayout**, LvnDescriptorLayoutCreateInfo*) | createInfo->pDescriptorBindings[%u].descriptorCount is 0, no descriptors will be created for this binding which may not be intentional", i);
+    }
+
+    *descriptorLayout = lvn::createObject<LvnDescriptorLayout>(lvnctx, Lvn_Stype_DescriptorLayout);
+
+    LvnDescriptorLayout* descriptorLayoutPtr = *descriptorLayout;
+    descriptorLayoutPtr->descriptorBindings = LvnVector<LvnDescriptorBinding>(createInfo->pDescriptorBindings, createInfo->descriptorBindingCount);
+    descriptorLayoutPtr->descriptorSets.clear();
+    descriptorLayoutPtr->maxSets = createInfo->maxSets;
+    descriptorLayoutPtr->stats = {};
+
+    LVN_CORE_TRACE("created descriptorLayout: (%p), descriptor binding count: %u", *descriptorLayout, createInfo->descriptorBindingCount);
+    return lvnctx->graphicsContext.createDescriptorLayout(*descriptorLayout, createInfo);
+}
+
+LvnResult allocateDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    // sets are allocated individually so their addresses stay valid as the layout grows
+    LvnDescriptorSet* descriptorSetPtr = lvn::memNew<LvnDescriptorSet>();
+    descriptorSetPtr->transient = false;
+
+    if (lvnctx->graphicsContext.allocateDescriptorSet(descriptorSetPtr, descriptorLayout) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("allocateDescriptorSet(LvnDescriptorSet**, LvnDescriptorLayout*) | failed to allocate descriptor set from descriptorLayout: (%p)", descriptorLayout);
+        lvn::memDelete(descriptorSetPtr);
+        return Lvn_Result_Failure;
+    }
+
+    descriptorLayout->descriptorSets.push_back(descriptorSetPtr);
+    descriptorLayout->stats.allocatedSets++;
+    *descriptorSet = descriptorSetPtr;
+
+    LVN_CORE_TRACE("allocated descriptorSet: (%p) from descriptorLayout: (%p)", *descriptorSet, descriptorLayout);
+    return Lvn_Result_Success;
+}
+
+LvnResult allocateTransientDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout)
+{
+    LvnContext* lvnctx = lvn::getContext();
+    return lvnctx->graphicsContext.allocateTransientDescriptorSet(descriptorSet, descriptorLayout);
+}
+
+LvnDescriptorLayoutStats descriptorLayoutGetStats(LvnDescriptorLayout* descriptorLayout)
+{
+    return descriptorLayout->stats;
+}
+
+LvnGraphicsMemoryStats getGraphicsMemoryStats()
+{
+    LvnGraphicsMemoryStats stats{};
+    lvn::getContext()->graphicsContext.getMemoryStats(&stats);
+    return stats;
+}
+
+template <typename T>
+static void appendPipelineKey(LvnVector<uint8_t>* key, const T& value)
+{
+    lvn::appendPipelineKey(key, &value, sizeof(T));
+}
+
+static void appendPipelineKey(LvnVector<uint8_t>* key, const void* data, uint64_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    key->insert(key->end(), bytes, bytes + size);
+}
+
+static void appendPipelineSpecificationKey(LvnVector<uint8_t>* key, const LvnPipelineSpecification* spec)
+{
+    // members are appended one at a time so struct padding never takes part in the comparison
+    lvn::appendPipelineKey(key, spec->inputAssembly.topology);
+    lvn::appendPipelineKey(key, spec->inputAssembly.primitiveRestartEnable);
+
+    lvn::appendPipelineKey(key, spec->viewport.x);
+    lvn::appendPipelineKey(key, spec->viewport.y);
+    lvn::appendPipelineKey(key, spec->viewport.width);
+    lvn::appendPipelineKey(key, spec->viewport.height);
+    lvn::appendPipelineKey(key, spec->viewport.minDepth);
+    lvn::appendPipelineKey(key, spec->viewport.maxDepth);
+    lvn::appendPipelineKey(key, spec->scissor.offset.x);
+    lvn::appendPipelineKey(key, spec->scissor.offset.y);
+    lvn::appendPipelineKey(key, spec->scissor.extent.width);
+    lvn::appendPipelineKey(key, spec->scissor.extent.height);
+
+    lvn::appendPipelineKey(key, spec->rasterizer.cullMode);
+    lvn::appendPipelineKey(key, spec->rasterizer.frontFace);
+    lvn::appendPipelineKey(key, spec->rasterizer.lineWidth);
+    lvn::appendPipelineKey(key, spec->rasterizer.depthBiasConstantFactor);
+    lvn::appendPipelineKey(key, spec->rasterizer.depthBiasClamp);
+    lvn::appendPipelineKey(key, spec->rasterizer.depthBiasSlopeFactor);
+    lvn::appendPipelineKey(key, spec->rasterizer.depthClampEnable);
+    lvn::appendPipelineKey(key, spec->rasterizer.rasterizerDiscardEnable);
+    lvn::appendPipelineKey(key, spec->rasterizer.depthBiasEnable);
+
+    lvn::appendPipelineKey(key, spec->multisampling.rasterizationSamples);
+    lvn::appendPipelineKey(key, spec->multisampling.minSampleShading);
+    lvn::appendPipelineKey(key, spec->multisampling.sampleShadingEnable);
+    lvn::appendPipelineKey(key, spec->multisampling.alphaToCoverageEnable);
+    lvn::appendPipelineKey(key, spec->multisampling.alphaToOneEnable);
+    uint32_t sampleMask = spec->multisampling.sampleMask ? *spec->multisampling.sampleMask : UINT32_MAX;
+    lvn::appendPipelineKey(key, sampleMask);
+
+    lvn::appendPipelineKey(key, spec->colorBlend.colorBlendAttachmentCount);
+    for (uint32_t i = 0; i < spec->colorBlend.colorBlendAttachmentCount && spec->colorBlend.pColorBlendAttachments; i++)
+    {
+        const LvnPipelineColorBlendAttachment& attachment = spec->colorBlend.pColorBlendAttachments[i];
+        lvn::appendPipelineKey(key, attachment.colorWriteMask.colorComponentR);
+        lvn::appendPipelineKey(key, attachment.colorWriteMask.colorComponentG);
+        lvn::appendPipelineKey(key, attachment.colorWriteMask.colorComponentB);
+        lvn::appendPipelineKey(key, attachment.colorWriteMask.colorComponentA);
+        lvn::appendPipelineKey(key, attachment.srcColorBlendFactor);
+        lvn::appendPipelineKey(key, attachment.dstColorBlendFactor);
+        lvn::appendPipelineKey(key, attachment.colorBlendOp);
+        lvn::appendPipelineKey(key, attachment.srcAlphaBlendFactor);
+        lvn::appendPipelineKey(key, attachment.dstAlphaBlendFactor);
+        lvn::appendPipelineKey(key, attachment.alphaBlendOp);
+        lvn::appendPipelineKey(key, attachment.blendEnable);
+    }
+    lvn::appendPipelineKey(key, spec->colorBlend.blendConstants, sizeof(spec->colorBlend.blendConstants));
+    lvn::appendPipelineKey(key, spec->colorBlend.logicOpEnable);
+
+    lvn::appendPipelineKey(key, spec->depthstencil.depthOpCompare);
+    lvn::appendPipelineKey(key, spec->depthstencil.stencil.failOp);
+    lvn::appendPipelineKey(key, spec->depthstencil.stencil.passOp);
+    lvn::appendPipelineKey(key, spec->depthstencil.stencil.depthFailOp);
+    lvn::appendPipelineKey(key, spec->depthstencil.stencil.compareOp);
+    lvn::appendPipelineKey(key, spec->depthstencil.stencil.compareMask);
+    lvn::appendPipelineKey(key, spec->depthstencil.stencil.writeMask);
+    lvn::appendPipelineKey(key, spec->depthstencil.stencil.reference);
+    lvn::appendPipelineKey(key, spec->depthstencil.enableDepth);
+    lvn::appendPipelineKey(key, spec->depthstencil.enableStencil);
+    lvn::appendPipelineKey(key, spec->dynamicStates);
+}
+
+static uint64_t hashPipelineKey(const LvnVector<uint8_t>& key)
+{
+    // fnv-1a, the same hash used for environment map caches
+    uint64_t hash = 0xcbf29ce484222325;
+    for (uint32_t i = 0; i < key.size(); i++)
+        hash = (hash ^ key[i]) * 0x100000001b3;
+
+    return hash;
+}
+
+static LvnPipeline* findCachedPipeline(LvnContext* lvnctx, uint64_t hash, const LvnVector<uint8_t>& key)
+{
+    for (uint32_t i = 0; i < lvnctx->pipelineCache.size(); i++)
+    {
+        LvnPipelineCacheEntry& entry = lvnctx->pipelineCache[i];
+        if (entry.hash == hash && entry.key.size() == key.size() && memcmp(entry.key.data(), key.data(), key.size()) == 0)
+        {
+            entry.pipeline->refCount++;
+            return entry.pipeline;
+        }
+    }
+
+    return nullptr;
+}
+
+static void cachePipeline(LvnContext* lvnctx, LvnPipeline* pipeline, uint64_t hash, LvnVector<uint8_t>& key, LvnVector<const void*>& objects)
+{
+    LvnPipelineCacheEntry entry{};
+    entry.hash = hash;
+    entry.pipeline = pipeline;
+    lvnctx->pipelineCache.push_back(entry);
+    lvnctx->pipelineCache.back().key = lvn::move(key);
+    lvnctx->pipelineCache.back().objects = lvn::move(objects);
+}
+
+static void purgePipelineCache(LvnContext* lvnctx, const void* object)
+{
+    if (object == nullptr) { return; }
+
+    // pipelines stay valid for their owners, new create infos can no longer match them once an object in their key is gone
+    LvnLockGaurd lock(lvnctx->pipelineCacheMutex);
+    for (uint32_t i = 0; i < lvnctx->pipelineCache.size();)
+    {
+        LvnVector<const void*>& objects = lvnctx->pipelineCache[i].objects;
+        if (objects.find(object) != objects.end())
+            lvnctx->pipelineCache.erase_index(i);
+        else
+            i++;
+    }
+}
+
+static LvnResult checkPipelineCreateInfo(const LvnPipelineCreateInfo* createInfo)
+{
+    // vertex binding descriptions
+    if (!createInfo->pVertexBindingDescriptions)
+    {
+        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->pVertexBindingDescriptions is nullptr; cannot create vertex buffer without the vertex binding descriptions");
+        return Lvn_Result_Failure;
+    }
+    else if (!createInfo->vertexBindingDescriptionCount)
+    {
+        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->vertexBindingDescriptionCount is 0; cannot create vertex buffer without the vertex binding descriptions");
+        return Lvn_Result_Failure;
+    }
+
+    // vertex attributes
+    if (!createInfo->pVertexAttributes)
+    {
+        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->pVertexAttributes is nullptr; cannot create vertex buffer without the vertex attributes");
+        return Lvn_Result_Failure;
+    }
+    else if (!createInfo->vertexAttributeCount)
+    {
+        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->vertexAttributeCount is 0; cannot create vertex buffer without the vertex attributes");
+        return Lvn_Result_Failure;
+    }
+
+    for (uint32_t i = 0; i < createInfo->vertexAttributeCount; i++)
+    {
+        if (createInfo->pVertexAttributes[i].format == Lvn_AttributeFormat_Undefined)
+        {
+            LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->pVertexAttributes[%d].type is Lvn_AttributeFormat_Undefined, cannot create vertex buffer without a vertex data type", i);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    // push constants
+    if (createInfo->pushConstantRangeCount && !createInfo->pPushConstantRanges)
+    {
+        LVN_CORE_ERROR("createPipeline(LvnPipeline**, LvnPipelineCreateInfo*) | createInfo->pPushConstantRanges is nullptr while createInfo->pushConstantRangeCount is %u", createInfo->pushConstantRangeCount);
+        return Lvn_Result_Failure;
+    }
+
+    for (uint32_t i = 0; i < createInfo->pushConstantRangeCount; i++)
+    {
+        const LvnPushConstantRange& range = createInfo->pPushConstantRanges[i];
+        if (range.size == 0 || range.size % 4 != 0 || range.offset % 4 != 0)
+        {
+            LVN_CORE_ERROR("createPipeline(LvnPipeline**, LvnPipelineCreateInfo*) | createInfo->pPushConstantRanges[%u] has offset %u and size %u, push constant ranges need a non zero size and an offset and size that are multiples of 4", i, range.offset, range.size);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    return Lvn_Result_Success;
+}
+
+LvnResult createPipeline(LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo)
+{
+    LVN_PROFILE_FUNCTION();
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (lvn::checkPipelineCreateInfo(createInfo) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    // equal create infos share one pipeline, skipping the duplicate driver compile
+    LvnVector<uint8_t> key;
+    LvnVector<const void*> objects;
+    uint32_t graphicsTag = 0;
+    lvn::appendPipelineKey(&key, graphicsTag);
+    // a null specification uses the backend's default, which never changes once created
+    bool hasSpecification = createInfo->pipelineSpecification != nullptr;
+    lvn::appendPipelineKey(&key, hasSpecification);
+    if (hasSpecification)
+        lvn::appendPipelineSpecificationKey(&key, createInfo->pipelineSpecification);
+    for (uint32_t i = 0; i < createInfo->vertexBindingDescriptionCount; i++)
+    {
+        lvn::appendPipelineKey(&key, createInfo->pVertexBindingDescriptions[i].binding);
+        lvn::appendPipelineKey(&key, createInfo->pVertexBindingDescriptions[i].stride);
+        lvn::appendPipelineKey(&key, createInfo->pVertexBindingDescriptions[i].inputRate);
+    }
+    for (uint32_t i = 0; i < createInfo->vertexAttributeCount; i++)
+    {
+        lvn::appendPipelineKey(&key, createInfo->pVertexAttributes[i].binding);
+        lvn::appendPipelineKey(&key, createInfo->pVertexAttributes[i].layout);
+        lvn::appendPipelineKey(&key, createInfo->pVertexAttributes[i].format);
+        lvn::appendPipelineKey(&key, createInfo->pVertexAttributes[i].offset);
+    }
+    for (uint32_t i = 0; i < createInfo->pushConstantRangeCount; i++)
+    {
+        lvn::appendPipelineKey(&key, createInfo->pPushConstantRanges[i].shaderStage);
+        lvn::appendPipelineKey(&key, createInfo->pPushConstantRanges[i].offset);
+        lvn::appendPipelineKey(&key, createInfo->pPushConstantRanges[i].size);
+    }
+    lvn::appendPipelineKey(&key, createInfo->vertexBindingDescriptionCount);
+    lvn::appendPipelineKey(&key, createInfo->vertexAttributeCount);
+    lvn::appendPipelineKey(&key, createInfo->pushConstantRangeCount);
+    lvn::appendPipelineKey(&key, createInfo->descriptorLayoutCount);
+    for (uint32_t i = 0; i < createInfo->descriptorLayoutCount; i++)
+        objects.push_back(createInfo->pDescriptorLayouts[i]);
+    objects.push_back(createInfo->shader);
+    objects.push_back(createInfo->renderPass);
+    lvn::appendPipelineKey(&key, objects.data(), objects.memsize());
+
+    uint64_t hash = lvn::hashPipelineKey(key);
+    LvnLockGaurd lock(lvnctx->pipelineCacheMutex);
+
+    if ((*pipeline = lvn::findCachedPipeline(lvnctx, hash, key)) != nullptr)
+    {
+        LVN_CORE_TRACE("reused pipeline: (%p), references: %u", *pipeline, (*pipeline)->refCount);
+        return Lvn_Result_Success;
+    }
+
+    *pipeline = lvn::createObject<LvnPipeline>(lvnctx, Lvn_Stype_Pipeline);
+    (*pipeline)->compute = false;
+    (*pipeline)->refCount = 1;
+
+    LVN_CORE_TRACE("created pipeline: (%p)", *pipeline);
+    LvnResult result = lvnctx->graphicsContext.createPipeline(*pipeline, createInfo);
+    if (result == Lvn_Result_Success)
+    {
+        lvn::cachePipeline(lvnctx, *pipeline, hash, key, objects);
+        lvn::hotReloadTrackPipeline(lvnctx, *pipeline, createInfo);
+    }
+
+    return result;
+}
+
+LvnResult createComputePipeline(LvnPipeline** pipeline, const LvnComputePipelineCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (!createInfo->shader)
+    {
+        LVN_CORE_ERROR("createComputePipeline(LvnPipeline**, LvnComputePipelineCreateInfo*) | createInfo->shader is nullptr, cannot create compute pipeline without a compute shader");
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->descriptorLayoutCount && !createInfo->pDescriptorLayouts)
+    {
+        LVN_CORE_ERROR("createComputePipeline(LvnPipeline**, LvnComputePipelineCreateInfo*) | createInfo->pDescriptorLayouts is nullptr while createInfo->descriptorLayoutCount is %u", createInfo->descriptorLayoutCount);
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->pushConstantRangeCount && !createInfo->pPushConstantRanges)
+    {
+        LVN_CORE_ERROR("createComputePipeline(LvnPipeline**, LvnComputePipelineCreateInfo*) | createInfo->pPushConstantRanges is nullptr while createInfo->pushConstantRangeCount is %u", createInfo->pushConstantRangeCount);
+        return Lvn_Result_Failure;
+    }
+
+    for (uint32_t i = 0; i < createInfo->pushConstantRangeCount; i++)
+    {
+        const LvnPushConstantRange& range = createInfo->pPushConstantRanges[i];
+        if (range.size == 0 || range.size % 4 != 0 || range.offset % 4 != 0)
+        {
+            LVN_CORE_ERROR("createComputePipeline(LvnPipeline**, LvnComputePipelineCreateInfo*) | createInfo->pPushConstantRanges[%u] has offset %u and size %u, push constant ranges need a non zero size and an offset and size that are multiples of 4", i, range.offset, range.size);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    LvnVector<uint8_t> key;
+    LvnVector<const void*> objects;
+    uint32_t computeTag = 1;
+    lvn::appendPipelineKey(&key, computeTag);
+    for (uint32_t i = 0; i < createInfo->pushConstantRangeCount; i++)
+    {
+        lvn::appendPipelineKey(&key, createInfo->pPushConstantRanges[i].shaderStage);
+        lvn::appendPipelineKey(&key, createInfo->pPushConstantRanges[i].offset);
+        lvn::appendPipelineKey(&key, createInfo->pPushConstantRanges[i].size);
+    }
+    lvn::appendPipelineKey(&key, createInfo->pushConstantRangeCount);
+    lvn::appendPipelineKey(&key, createInfo->descriptorLayoutCount);
+    for (uint32_t i = 0; i < createInfo->descriptorLayoutCount; i++)
+        objects.push_back(createInfo->pDescriptorLayouts[i]);
+    objects.push_back(createInfo->shader);
+    lvn::appendPipelineKey(&key, objects.data(), objects.memsize());
+
+    uint64_t hash = lvn::hashPipelineKey(key);
+    LvnLockGaurd lock(lvnctx->pipelineCacheMutex);
+
+    if ((*pipeline = lvn::findCachedPipeline(lvnctx, hash, key)) != nullptr)
+    {
+        LVN_CORE_TRACE("reused compute pipeline: (%p), references: %u", *pipeline, (*pipeline)->refCount);
+        return Lvn_Result_Success;
+    }
+
+    *pipeline = lvn::createObject<LvnPipeline>(lvnctx, Lvn_Stype_Pipeline);
+    (*pipeline)->compute = true;
+    (*pipeline)->refCount = 1;
+
+    LVN_CORE_TRACE("created compute pipeline: (%p)", *pipeline);
+    LvnResult result = lvnctx->graphicsContext.createComputePipeline(*pipeline, createInfo);
+    if (result == Lvn_Result_Success)
+    {
+        lvn::cachePipeline(lvnctx, *pipeline, hash, key, objects);
+        lvn::hotReloadTrackComputePipeline(lvnctx, *pipeline, createInfo);
+    }
+
+    return result;
+}
+
+static void* pipelineCompileThread(void* arg)
+{
+    LvnContext* lvnctx = static_cast<LvnContext*>(arg);
+
+    while (true)
+    {
+        LvnPipelineCompileJob* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(lvnctx->pipelineCompileMutex);
+            while (!lvnctx->pipelineCompileStop && lvnctx->pipelineCompileJobs.empty())
+                lvnctx->pipelineCompileCondition.wait(lock);
+
+            // pending jobs are finished before stopping so no pipeline is left compiling
+            if (lvnctx->pipelineCompileJobs.empty())
+                return nullptr;
+
+            job = lvnctx->pipelineCompileJobs.front();
+            lvnctx->pipelineCompileJobs.erase_index(0);
+        }
+
+        if (lvnctx->graphicsContext.createPipeline(job->pipeline, &job->createInfo) != Lvn_Result_Success)
+        {
+            LVN_CORE_ERROR("createPipelineAsync(LvnPipeline**, LvnPipelineCreateInfo*, LvnPipeline*) | background compile of pipeline (%p) failed, binds keep using its fallback pipeline (%p)", job->pipeline, job->pipeline->fallback);
+            job->pipeline->compileFailed = true;
+        }
+
+        job->pipeline->compiling.store(false, std::memory_order_release);
+        delete job;
+    }
+}
+
+static void waitPipelineCompile(LvnPipeline* pipeline)
+{
+    while (pipeline->compiling.load(std::memory_order_acquire))
+        std::this_thread::yield();
+}
+
+static LvnPipeline* getBindablePipeline(LvnPipeline* pipeline)
+{
+    if (!pipeline->compiling.load(std::memory_order_acquire) && !pipeline->compileFailed)
+        return pipeline;
+
+    // draw with the fallback until the pipeline is ready, only wait when there is nothing to fall back to
+    if (pipeline->fallback != nullptr)
+        return lvn::getBindablePipeline(pipeline->fallback);
+
+    lvn::waitPipelineCompile(pipeline);
+    return pipeline;
+}
+
+static void copyPipelineCreateInfo(LvnPipelineCompileJob* job, const LvnPipelineCreateInfo* createInfo)
+{
+    job->vertexBindingDescriptions.insert(job->vertexBindingDescriptions.end(), createInfo->pVertexBindingDescriptions, createInfo->pVertexBindingDescriptions + createInfo->vertexBindingDescriptionCount);
+    job->vertexAttributes.insert(job->vertexAttributes.end(), createInfo->pVertexAttributes, createInfo->pVertexAttributes + createInfo->vertexAttributeCount);
+    job->descriptorLayouts.insert(job->descriptorLayouts.end(), createInfo->pDescriptorLayouts, createInfo->pDescriptorLayouts + createInfo->descriptorLayoutCount);
+    job->pushConstantRanges.insert(job->pushConstantRanges.end(), createInfo->pPushConstantRanges, createInfo->pPushConstantRanges + createInfo->pushConstantRangeCount);
+
+    job->createInfo = *createInfo;
+    job->createInfo.pVertexBindingDescriptions = job->vertexBindingDescriptions.data();
+    job->createInfo.pVertexAttributes = job->vertexAttributes.data();
+    job->createInfo.pDescriptorLayouts = job->descriptorLayouts.data();
+    job->createInfo.pPushConstantRanges = job->pushConstantRanges.data();
+
+    if (createInfo->pipelineSpecification != nullptr)
+    {
+        job->pipelineSpecification = *createInfo->pipelineSpecification;
+        const LvnPipelineColorBlend& colorBlend = createInfo->pipelineSpecification->colorBlend;
+        if (colorBlend.pColorBlendAttachments != nullptr)
+            job->colorBlendAttachments.insert(job->colorBlendAttachments.end(), colorBlend.pColorBlendAttachments, colorBlend.pColorBlendAttachments + colorBlend.colorBlendAttachmentCount);
+        if (createInfo->pipelineSpecification->multisampling.sampleMask != nullptr)
+            job->sampleMask = *createInfo->pipelineSpecification->multisampling.sampleMask;
+
+        job->pipelineSpecification.colorBlend.pColorBlendAttachments = colorBlend.pColorBlendAttachments ? job->colorBlendAttachments.data() : nullptr;
+        job->pipelineSpecification.multisampling.sampleMask = createInfo->pipelineSpecification->multisampling.sampleMask ? &job->sampleMask : nullptr;
+        job->createInfo.pipelineSpecification = &job->pipelineSpecification;
+    }
+}
+
+LvnResult createPipelineAsync(LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo, LvnPipeline* fallback)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    // opengl programs and vertex arrays belong to the render thread's contexts, they are compiled in place
+    if (lvnctx->graphicsapi != Lvn_GraphicsApi_vulkan)
+        return lvn::createPipeline(pipeline, createInfo);
+
+    if (lvn::checkPipelineCreateInfo(createInfo) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    *pipeline = lvn::createObject<LvnPipeline>(lvnctx, Lvn_Stype_Pipeline);
+    (*pipeline)->compute = false;
+    (*pipeline)->refCount = 1;
+    (*pipeline)->fallback = fallback;
+    (*pipeline)->compiling.store(true, std::memory_order_relaxed);
+
+    // the create info and the arrays it points to are copied, the caller's memory can go out of scope once this returns
+    LvnPipelineCompileJob* job = new LvnPipelineCompileJob();
+    job->pipeline = *pipeline;
+    lvn::copyPipelineCreateInfo(job, createInfo);
+    lvn::hotReloadTrackPipeline(lvnctx, *pipeline, createInfo);
+
+    {
+        std::lock_guard<std::mutex> lock(lvnctx->pipelineCompileMutex);
+
+        // workers are started with the first background compile
+        if (lvnctx->pipelineCompileThreads.empty())
+        {
+            lvnctx->pipelineCompileStop = false;
+            for (uint32_t i = 0; i < LVN_PIPELINE_COMPILE_THREADS; i++)
+                lvnctx->pipelineCompileThreads.push_back(new LvnThread(lvn::pipelineCompileThread, lvnctx));
+        }
+
+        lvnctx->pipelineCompileJobs.push_back(job);
+    }
+    lvnctx->pipelineCompileCondition.notify_one();
+
+    LVN_CORE_TRACE("created pipeline (compiling in background): (%p), fallback pipeline: (%p)", *pipeline, fallback);
+    return Lvn_Result_Success;
+}
+
+bool pipelineIsReady(LvnPipeline* pipeline)
+{
+    return !pipeline->compiling.load(std::memory_order_acquire) && !pipeline->compileFailed;
+}
+
+static uint64_t getFileModifiedTime(const char* filepath)
+{
+#if defined(LVN_PLATFORM_WINDOWS)
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(filepath, GetFileExInfoStandard, &attributes))
+        return 0;
+
+    return ((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+#else
+    struct stat fileStat;
+    if (stat(filepath, &fileStat) != 0)
+        return 0;
+
+#if defined(LVN_PLATFORM_LINUX)
+    return (uint64_t)fileStat.st_mtim.tv_sec * 1000000000ull + (uint64_t)fileStat.st_mtim.tv_nsec;
+#else
+    return (uint64_t)fileStat.st_mtime;
+#endif
+#endif
+}
+
+static LvnString getFileDirectory(const char* filepath)
+{
+    const char* end = nullptr;
+    for (const char* c = filepath; *c != '\0'; c++)
+    {
+        if (*c == '/' || *c == '\\')
+            end = c;
+    }
+
+    if (end == nullptr)
+        return LvnString(".");
+    if (end == filepath)
+        return LvnString("/");
+
+    return LvnString(filepath, end - filepath);
+}
+
+static void hotReloadWatchDirectory(LvnContext* lvnctx, const LvnString& directory)
+{
+    LvnHotReloadWatcher* watcher = static_cast<LvnHotReloadWatcher*>(lvnctx->hotReloadWatcher);
+    if (watcher == nullptr)
+    {
+        watcher = lvn::memNew<LvnHotReloadWatcher>();
+#if defined(LVN_PLATFORM_LINUX)
+        watcher->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (watcher->fd < 0)
+            LVN_CORE_WARN("hot reload | failed to create inotify instance, watched files are polled instead");
+#endif
+        lvnctx->hotReloadWatcher = watcher;
+    }
+
+    for (const LvnHotReloadDirectory& watched : watcher->directories)
+    {
+        if (strcmp(watched.path.c_str(), directory.c_str()) == 0)
+            return;
+    }
+
+    LvnHotReloadDirectory watchDirectory{};
+    watchDirectory.path = directory;
+    watchDirectory.changed = false;
+
+    // directories without a change notification fall back to comparing the write times of their files every update
+#if defined(LVN_PLATFORM_WINDOWS)
+    watchDirectory.handle = FindFirstChangeNotificationA(directory.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+#elif defined(LVN_PLATFORM_LINUX)
+    watchDirectory.wd = watcher->fd >= 0 ? inotify_add_watch(watcher->fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ATTRIB) : -1;
+#endif
+
+    watcher->directories.push_back(watchDirectory);
+}
+
+static void hotReloadPollDirectories(LvnHotReloadWatcher* watcher)
+{
+#if defined(LVN_PLATFORM_LINUX)
+    // editors often save by writing a new file and renaming it over the old one, so every event in a directory is treated as a change
+    if (watcher->fd >= 0)
+    {
+        alignas(struct inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(watcher->fd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(struct inotify_event) + reinterpret_cast<struct inotify_event*>(ptr)->len)
+            {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+                for (LvnHotReloadDirectory& directory : watcher->directories)
+                {
+                    if (directory.wd == event->wd)
+                        directory.changed = true;
+                }
+            }
+        }
+    }
+#endif
+
+    for (LvnHotReloadDirectory& directory : watcher->directories)
+    {
+#if defined(LVN_PLATFORM_WINDOWS)
+        if (directory.handle != INVALID_HANDLE_VALUE)
+        {
+            if (WaitForSingleObject(directory.handle, 0) == WAIT_OBJECT_0)
+            {
+                directory.changed = true;
+                FindNextChangeNotification(directory.handle);
+            }
+            continue;
+        }
+#elif defined(LVN_PLATFORM_LINUX)
+        if (directory.wd >= 0)
+            continue;
+#endif
+        directory.changed = true;
+    }
+}
+
+uint32_t hotReloadUpdate()
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    struct LvnHotReloadCall
+    {
+        LvnFileChangedFunc func;
+        void* userData;
+        LvnString filepath;
+    };
+
+    LvnVector<LvnHotReloadCall> calls;
+
+    {
+        LvnLockGaurd lock(lvnctx->hotReloadMutex);
+
+        LvnHotReloadWatcher* watcher = static_cast<LvnHotReloadWatcher*>(lvnctx->hotReloadWatcher);
+        if (watcher == nullptr)
+            return 0;
+
+        lvn::hotReloadPollDirectories(watcher);
+
+        for (LvnHotReloadDirectory& directory : watcher->directories)
+        {
+            if (!directory.changed)
+                continue;
+            directory.changed = false;
+
+            for (LvnHotReloadFile& file : lvnctx->hotReloadFiles)
+            {
+                LvnString fileDirectory = lvn::getFileDirectory(file.filepath.c_str());
+                if (strcmp(fileDirectory.c_str(), directory.path.c_str()) != 0)
+                    continue;
+
+                // files that are being written or were removed are picked up again once they can be read
+                uint64_t modifiedTime = lvn::getFileModifiedTime(file.filepath.c_str());
+                if (modifiedTime == 0 || modifiedTime == file.modifiedTime)
+                    continue;
+                file.modifiedTime = modifiedTime;
+
+                // an object is reloaded once per update even if several of its files changed
+                bool queued = false;
+                for (const LvnHotReloadCall& call : calls)
+                {
+                    if (call.func == file.func && call.userData == file.userData)
+                    {
+                        queued = true;
+                        break;
+                    }
+                }
+
+                if (!queued)
+                    calls.push_back({ file.func, file.userData, file.filepath });
+            }
+        }
+    }
+
+    // reloads are called without the lock held, they create and destroy objects which can watch or unwatch files
+    for (const LvnHotReloadCall& call : calls)
+    {
+        LVN_CORE_TRACE("hot reload | file changed: %s", call.filepath.c_str());
+        call.func(call.filepath.c_str(), call.userData);
+    }
+
+    return static_cast<uint32_t>(calls.size());
+}
+
+static void hotReloadAddFile(LvnContext* lvnctx, const char* filepath, LvnFileChangedFunc func, void* userData, const void* object)
+{
+    LvnHotReloadFile file{};
+    file.filepath = filepath;
+    file.modifiedTime = lvn::getFileModifiedTime(filepath);
+    file.func = func;
+    file.userData = userData;
+    file.object = object;
+
+    LvnLockGaurd lock(lvnctx->hotReloadMutex);
+    lvn::hotReloadWatchDirectory(lvnctx, lvn::getFileDirectory(filepath));
+    lvnctx->hotReloadFiles.push_back(file);
+}
+
+static void hotReloadRemoveObject(LvnContext* lvnctx, const void* object)
+{
+    LvnLockGaurd lock(lvnctx->hotReloadMutex);
+
+    for (uint32_t i = 0; i < lvnctx->hotReloadFiles.size();)
+    {
+        if (lvnctx->hotReloadFiles[i].object == object)
+            lvnctx->hotReloadFiles.erase_index(i);
+        else
+            i++;
+    }
+
+    for (uint32_t i = 0; i < lvnctx->hotReloadShaders.size(); i++)
+    {
+        if (lvnctx->hotReloadShaders[i].shader == object)
+        {
+            lvnctx->hotReloadShaders.erase_index(i);
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < lvnctx->hotReloadPipelines.size(); i++)
+    {
+        if (lvnctx->hotReloadPipelines[i].pipeline == object)
+        {
+            delete lvnctx->hotReloadPipelines[i].job;
+            lvnctx->hotReloadPipelines.erase_index(i);
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < lvnctx->hotReloadModels.size(); i++)
+    {
+        if (lvnctx->hotReloadModels[i].model == object)
+        {
+            lvnctx->hotReloadModels.erase_index(i);
+            break;
+        }
+    }
+}
+
+static void hotReloadTerminate(LvnContext* lvnctx)
+{
+    for (LvnHotReloadPipeline& record : lvnctx->hotReloadPipelines)
+        delete record.job;
+
+    lvnctx->hotReloadFiles.clear_free();
+    lvnctx->hotReloadShaders.clear_free();
+    lvnctx->hotReloadPipelines.clear_free();
+    lvnctx->hotReloadModels.clear_free();
+
+    LvnHotReloadWatcher* watcher = static_cast<LvnHotReloadWatcher*>(lvnctx->hotReloadWatcher);
+    if (watcher == nullptr)
+        return;
+
+#if defined(LVN_PLATFORM_WINDOWS)
+    for (const LvnHotReloadDirectory& directory : watcher->directories)
+    {
+        if (directory.handle != INVALID_HANDLE_VALUE)
+            FindCloseChangeNotification(directory.handle);
+    }
+#elif defined(LVN_PLATFORM_LINUX)
+    if (watcher->fd >= 0)
+        close(watcher->fd);
+#endif
+
+    lvn::memDelete(watcher);
+    lvnctx->hotReloadWatcher = nullptr;
+}
+
+static void hotReloadTrackShader(LvnContext* lvnctx, LvnShader* shader, const LvnShaderCreateInfo* createInfo, bool binary)
+{
+    LvnHotReloadShader record{};
+    record.shader = shader;
+    record.createInfo = *createInfo;
+    record.binary = binary;
+
+    {
+        LvnLockGaurd lock(lvnctx->hotReloadMutex);
+        lvnctx->hotReloadShaders.push_back(record);
+    }
+
+    if (!createInfo->computeSrc.empty())
+    {
+        lvn::hotReloadAddFile(lvnctx, createInfo->computeSrc.c_str(), lvn::hotReloadShaderFile, shader, shader);
+        return;
+    }
+
+    lvn::hotReloadAddFile(lvnctx, createInfo->vertexSrc.c_str(), lvn::hotReloadShaderFile, shader, shader);
+    lvn::hotReloadAddFile(lvnctx, createInfo->fragmentSrc.c_str(), lvn::hotReloadShaderFile, shader, shader);
+}
+
+static bool hotReloadIsShaderTracked(LvnContext* lvnctx, const LvnShader* shader)
+{
+    for (const LvnHotReloadShader& record : lvnctx->hotReloadShaders)
+    {
+        if (record.shader == shader)
+            return true;
+    }
+
+    return false;
+}
+
+static void hotReloadTrackPipeline(LvnContext* lvnctx, LvnPipeline* pipeline, const LvnPipelineCreateInfo* createInfo)
+{
+    if (!lvnctx->hotReloadEnabled)
+        return;
+
+    LvnLockGaurd lock(lvnctx->hotReloadMutex);
+    if (!lvn::hotReloadIsShaderTracked(lvnctx, createInfo->shader))
+        return;
+
+    LvnHotReloadPipeline record{};
+    record.pipeline = pipeline;
+    record.shader = createInfo->shader;
+    record.job = new LvnPipelineCompileJob();
+    record.job->pipeline = pipeline;
+    lvn::copyPipelineCreateInfo(record.job, createInfo);
+
+    lvnctx->hotReloadPipelines.push_back(std::move(record));
+}
+
+static void hotReloadTrackComputePipeline(LvnContext* lvnctx, LvnPipeline* pipeline, const LvnComputePipelineCreateInfo* createInfo)
+{
+    if (!lvnctx->hotReloadEnabled)
+        return;
+
+    LvnLockGaurd lock(lvnctx->hotReloadMutex);
+    if (!lvn::hotReloadIsShaderTracked(lvnctx, createInfo->shader))
+        return;
+
+    LvnHotReloadPipeline record{};
+    record.pipeline = pipeline;
+    record.shader = createInfo->shader;
+    record.job = nullptr;
+    record.computeCreateInfo = *createInfo;
+    record.computeDescriptorLayouts.insert(record.computeDescriptorLayouts.end(), createInfo->pDescriptorLayouts, createInfo->pDescriptorLayouts + createInfo->descriptorLayoutCount);
+    record.computePushConstantRanges.insert(record.computePushConstantRanges.end(), createInfo->pPushConstantRanges, createInfo->pPushConstantRanges + createInfo->pushConstantRangeCount);
+
+    lvnctx->hotReloadPipelines.push_back(std::move(record));
+}
+
+static void hotReloadSwapPipeline(LvnPipeline* a, LvnPipeline* b)
+{
+    std::swap(a->nativePipeline, b->nativePipeline);
+    std::swap(a->nativePipelineLayout, b->nativePipelineLayout);
+    std::swap(a->nativeDynamicState, b->nativeDynamicState);
+    std::swap(a->id, b->id);
+    std::swap(a->vaoId, b->vaoId);
+    std::swap(a->bindingDescriptions, b->bindingDescriptions);
+}
+
+static void hotReloadShaderFile(const char* filepath, void* userData)
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnShader* shader = static_cast<LvnShader*>(userData);
+
+    LvnShaderCreateInfo createInfo;
+    bool binary = false;
+    {
+        LvnLockGaurd lock(lvnctx->hotReloadMutex);
+        bool found = false;
+        for (const LvnHotReloadShader& record : lvnctx->hotReloadShaders)
+        {
+            if (record.shader == shader)
+            {
+                createInfo = record.createInfo;
+                binary = record.binary;
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+            return;
+    }
+
+    // the edited shader is built into a temporary first, a shader that fails to compile keeps its previous build
+    LvnShader newShader{};
+    LvnResult result = binary
+        ? lvnctx->graphicsContext.createShaderFromFileBin(&newShader, &createInfo)
+        : lvnctx->graphicsContext.createShaderFromFileSrc(&newShader, &createInfo);
+
+    if (result != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("hot reload | failed to rebuild shader (%p) from file: %s, the shader keeps its previous build", shader, filepath);
+        return;
+    }
+
+    // pipelines still compiling in the background read the shader modules, they finish with the old build first
+    LvnLockGaurd lock(lvnctx->hotReloadMutex);
+    for (const LvnHotReloadPipeline& record : lvnctx->hotReloadPipelines)
+    {
+        if (record.shader == shader)
+            lvn::waitPipelineCompile(record.pipeline);
+    }
+
+    std::swap(shader->nativeVertexShaderModule, newShader.nativeVertexShaderModule);
+    std::swap(shader->nativeFragmentShaderModule, newShader.nativeFragmentShaderModule);
+    std::swap(shader->nativeComputeShaderModule, newShader.nativeComputeShaderModule);
+    std::swap(shader->vertexShaderId, newShader.vertexShaderId);
+    std::swap(shader->fragmentShaderId, newShader.fragmentShaderId);
+    std::swap(shader->computeShaderId, newShader.computeShaderId);
+
+    // rebuild the pipelines of the shader with their stored create info, the pipeline objects stay at the same address so handles held by the application remain valid
+    uint32_t rebuilt = 0, failed = 0;
+    for (LvnHotReloadPipeline& record : lvnctx->hotReloadPipelines)
+    {
+        if (record.shader != shader)
+            continue;
+
+        LvnPipeline newPipeline{};
+        newPipeline.compute = record.pipeline->compute;
+        if (record.job != nullptr)
+        {
+            result = lvnctx->graphicsContext.createPipeline(&newPipeline, &record.job->createInfo);
+        }
+        else
+        {
+            record.computeCreateInfo.pDescriptorLayouts = record.computeDescriptorLayouts.data();
+            record.computeCreateInfo.pPushConstantRanges = record.computePushConstantRanges.data();
+            result = lvnctx->graphicsContext.createComputePipeline(&newPipeline, &record.computeCreateInfo);
+        }
+
+        if (result != Lvn_Result_Success)
+        {
+            LVN_CORE_ERROR("hot reload | failed to rebuild pipeline (%p) with shader (%p), the pipeline keeps its previous build", record.pipeline, shader);
+            failed++;
+            continue;
+        }
+
+        // a background compile that failed is replaced by the rebuild, binds stop using the fallback
+        lvn::hotReloadSwapPipeline(record.pipeline, &newPipeline);
+        record.pipeline->compileFailed = false;
+        lvnctx->graphicsContext.destroyPipeline(&newPipeline);
+        rebuilt++;
+    }
+
+    // the shader modules are only read while pipelines are created, the old ones can be destroyed once every pipeline is rebuilt
+    lvnctx->graphicsContext.destroyShader(&newShader);
+
+    LVN_CORE_TRACE("hot reload | rebuilt shader (%p) and %u pipelines, %u pipelines failed", shader, rebuilt, failed);
+}
+
+static void hotReloadTextureFile(const char* filepath, void* userData)
+{
+    LvnTexture* texture = static_cast<LvnTexture*>(userData);
+
+    if (texture->compression != Lvn_TextureCompression_None)
+    {
+        LVN_CORE_WARN("hot reload | texture (%p) is block compressed and cannot be updated in place, file: %s", texture, filepath);
+        return;
+    }
+
+    LvnImageData imageData = lvn::loadImageData(filepath, texture->channels);
+    if (imageData.pixels.data() == nullptr)
+    {
+        LVN_CORE_ERROR("hot reload | failed to load image for texture (%p), file: %s", texture, filepath);
+        return;
+    }
+
+    if (imageData.width != texture->width || imageData.height != texture->height)
+    {
+        LVN_CORE_WARN("hot reload | image size (%u x %u) does not match texture (%p) size (%u x %u), the texture is not updated, file: %s", imageData.width, imageData.height, texture, texture->width, texture->height, filepath);
+        return;
+    }
+
+    lvn::textureUpdateData(texture, imageData.pixels.data(), 0, 0, texture->width, texture->height);
+}
+
+static void hotReloadModelFile(const char* filepath, void* userData)
+{
+    LvnContext* lvnctx = lvn::getContext();
+    LvnModel* model = static_cast<LvnModel*>(userData);
+
+    LvnHotReloadModel record{};
+    {
+        LvnLockGaurd lock(lvnctx->hotReloadMutex);
+        bool found = false;
+        for (const LvnHotReloadModel& watched : lvnctx->hotReloadModels)
+        {
+            if (watched.model == model)
+            {
+                record = watched;
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+            return;
+    }
+
+    LvnModel newModel = record.hasLayout ? lvn::loadModel(filepath, record.layout, record.optimize) : lvn::loadModel(filepath);
+    if (newModel.meshes.empty() && newModel.nodes.empty())
+    {
+        LVN_CORE_ERROR("hot reload | failed to reload model (%p), the model keeps its previous data, file: %s", model, filepath);
+        return;
+    }
+
+    // the old model is destroyed after the swap, the buffers it held are released with the deferred destroys of the backend
+    LvnModel oldModel = std::move(*model);
+    *model = std::move(newModel);
+    lvn::unloadModel(&oldModel);
+}
+
+LvnResult hotReloadWatchFile(const char* filepath, LvnFileChangedFunc func, void* userData)
+{
+    if (filepath == nullptr || func == nullptr)
+    {
+        LVN_CORE_ERROR("hotReloadWatchFile(const char*, LvnFileChangedFunc, void*) | filepath or func is nullptr, cannot watch file");
+        return Lvn_Result_Failure;
+    }
+
+    lvn::hotReloadAddFile(lvn::getContext(), filepath, func, userData, nullptr);
+    return Lvn_Result_Success;
+}
+
+void hotReloadUnwatchFile(const char* filepath, LvnFileChangedFunc func, void* userData)
+{
+    if (filepath == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    LvnLockGaurd lock(lvnctx->hotReloadMutex);
+    for (uint32_t i = 0; i < lvnctx->hotReloadFiles.size(); i++)
+    {
+        const LvnHotReloadFile& file = lvnctx->hotReloadFiles[i];
+        if (file.object == nullptr && file.func == func && file.userData == userData && strcmp(file.filepath.c_str(), filepath) == 0)
+        {
+            lvnctx->hotReloadFiles.erase_index(i);
+            return;
+        }
+    }
+}
+
+LvnResult hotReloadWatchTexture(LvnTexture* texture, const char* filepath)
+{
+    if (texture == nullptr || filepath == nullptr)
+    {
+        LVN_CORE_ERROR("hotReloadWatchTexture(LvnTexture*, const char*) | texture or filepath is nullptr, cannot watch texture");
+        return Lvn_Result_Failure;
+    }
+
+    lvn::hotReloadAddFile(lvn::getContext(), filepath, lvn::hotReloadTextureFile, texture, texture);
+    return Lvn_Result_Success;
+}
+
+LvnResult hotReloadWatchModel(LvnModel* model, const char* filepath, const LvnVertexLayout* layout, LvnMeshOptimizeFlagBits optimize)
+{
+    if (model == nullptr || filepath == nullptr)
+    {
+        LVN_CORE_ERROR("hotReloadWatchModel(LvnModel*, const char*, LvnVertexLayout*, LvnMeshOptimizeFlagBits) | model or filepath is nullptr, cannot watch model");
+        return Lvn_Result_Failure;
+    }
+
+    LvnContext* lvnctx = lvn::getContext();
+
+    LvnHotReloadModel record{};
+    record.model = model;
+    record.hasLayout = layout != nullptr;
+    record.layout = layout != nullptr ? *layout : LvnVertexLayout{};
+    record.optimize = optimize;
+
+    {
+        LvnLockGaurd lock(lvnctx->hotReloadMutex);
+        lvnctx->hotReloadModels.push_back(record);
+    }
+
+    lvn::hotReloadAddFile(lvnctx, filepath, lvn::hotReloadModelFile, model, model);
+    return Lvn_Result_Success;
+}
+
+void hotReloadUnwatch(const void* object)
+{
+    if (object == nullptr) { return; }
+    lvn::hotReloadRemoveObject(lvn::getContext(), object);
+}
+
+LvnResult createFrameBuffer(LvnFrameBuffer** frameBuffer, const LvnFrameBufferCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (createInfo->pColorAttachments == nullptr)
+    {
+        LVN_CORE_ERROR("createFrameBuffer(LvnFrameBuffer**, LvnFrameBufferCreateInfo*) | createInfo->pColorAttachments is nullptr, cannot create framebuffer without one or more color attachments");
+        return Lvn_Result_Failure;
+    }
+
+    uint32_t totalAttachments = createInfo->colorAttachmentCount + (createInfo->depthAttachment != nullptr ? 1 : 0);
+
+    for (uint32_t i = 0; i < createInfo->colorAttachmentCount; i++)
+    {
+        if (createInfo->pColorAttachments[i].index >= totalAttachments)
+        {
+            LVN_CORE_ERROR("createFrameBuffer(LvnFrameBuffer**, LvnFrameBufferCreateInfo*) | createInfo->pColorAttachments[%u].index is greater than or equal to total attachments, color attachment index must be less than the total number of attachments", i);
+            return Lvn_Result_Failure;
+        }
+        if (createInfo->depthAttachment != nullptr && createInfo->pColorAttachments[i].index == createInfo->depthAttachment->index)
+        {
+            LVN_CORE_ERROR("createFrameBuffer(LvnFrameBuffer**, LvnFrameBufferCreateInfo*) | createInfo->pColorAttachments[%u].index has the same value as createInfo->depthAttachment->index, color attachment index must not be the same as the depth attachment index", i);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    if (createInfo->depthAttachment != nullptr)
+    {
+        if (createInfo->depthAttachment->index >= totalAttachments)
+        {
+            LVN_CORE_ERROR("createFrameBuffer(LvnFrameBuffer**, LvnFrameBufferCreateInfo*) | createInfo->pColorAttachments[%u].index is greater than or equal to total attachments, depth attachment index must be less than the total number of attachments");
+            return Lvn_Result_Failure;
+        }
+    }
+
+    *frameBuffer = lvn::createObject<LvnFrameBuffer>(lvnctx, Lvn_Stype_FrameBuffer);
+    (*frameBuffer)->width = createInfo->width;
+    (*frameBuffer)->height = createInfo->height;
+    (*frameBuffer)->renderScale = 1.0f;
+    lvn::frameBufferUpdateRenderSize(*frameBuffer);
+
+    LVN_CORE_TRACE("created framebuffer: (%p)", *frameBuffer);
+    return lvnctx->graphicsContext.createFrameBuffer(*frameBuffer, createInfo);
+}
+
+LvnResult createBuffer(LvnBuffer** buffer, const LvnBufferCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+    LvnContext* lvnctx = lvn::getContext();
+
+    // check valid buffer type
+    if (createInfo->type == Lvn_BufferType_Unknown)
+    {
+        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->type is \'Lvn_BufferType_Unknown\'; cannot create vertex buffer without knowing the type of buffer usage");
+        return Lvn_Result_Failure;
+    }
+
+    *buffer = lvn::createObject<LvnBuffer>(lvnctx, Lvn_Stype_Buffer);
+
+    LVN_CORE_TRACE("created buffer: (%p)", *buffer);
+    return lvnctx->graphicsContext.createBuffer(*buffer, createInfo);
+}
+
+LvnResult createSampler(LvnSampler** sampler, const LvnSamplerCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    // each field is a small enum, packing them gives a key that equal create infos and only equal create infos share
+    uint64_t key = static_cast<uint64_t>(createInfo->minFilter)
+        | static_cast<uint64_t>(createInfo->magFilter) << 16
+        | static_cast<uint64_t>(createInfo->wrapS) << 32
+        | static_cast<uint64_t>(createInfo->wrapT) << 48;
+
+    LvnLockGaurd lock(lvnctx->samplerCacheMutex);
+    for (uint32_t i = 0; i < lvnctx->samplerCache.size(); i++)
+    {
+        if (lvnctx->samplerCache[i]->key == key)
+        {
+            *sampler = lvnctx->samplerCache[i];
+            (*sampler)->refCount++;
+            LVN_CORE_TRACE("reused sampler: (%p), references: %u", *sampler, (*sampler)->refCount);
+            return Lvn_Result_Success;
+        }
+    }
+
+    *sampler = lvn::createObject<LvnSampler>(lvnctx, Lvn_Stype_Sampler);
+    (*sampler)->key = key;
+    (*sampler)->refCount = 1;
+
+    LVN_CORE_TRACE("created sampler: (%p)", *sampler);
+    LvnResult result = lvnctx->graphicsContext.createSampler(*sampler, createInfo);
+    if (result == Lvn_Result_Success)
+        lvnctx->samplerCache.push_back(*sampler);
+
+    return result;
+}
+
+LvnResult createTexture(LvnTexture** texture, const LvnTextureCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+    LvnContext* lvnctx = lvn::getContext();
+
+    *texture = lvn::createObject<LvnTexture>(lvnctx, Lvn_Stype_Texture);
+
+    LVN_CORE_TRACE("created texture: (%p) using image data: (%p), (w:%u,h:%u,ch:%u), total size: %u bytes",
+        *texture,
+        createInfo->imageData.pixels.data(),
+        createInfo->imageData.width,
+        createInfo->imageData.height,
+        createInfo->imageData.channels,
+        createInfo->imageData.pixels.memsize());
+
+    return lvnctx->graphicsContext.createTexture(*texture, createInfo);
+}
+
+LvnResult createTexture(LvnTexture** texture, const LvnTextureSamplerCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+    LvnContext* lvnctx = lvn::getContext();
+
+    *texture = lvn::createObject<LvnTexture>(lvnctx, Lvn_Stype_Texture);
+
+    LVN_CORE_TRACE("created texture (seperate sampler): (%p) using image data: (%p), (w:%u,h:%u,ch:%u), total size: %u bytes, sampler object used: (%p)",
+        *texture,
+        createInfo->imageData.pixels.data(),
+        createInfo->imageData.width,
+        createInfo->imageData.height,
+        createInfo->imageData.channels,
+        createInfo->imageData.pixels.memsize(),
+        createInfo->sampler);
+
+    return lvnctx->graphicsContext.createTextureSampler(*texture, createInfo);
+}
+
+LvnResult createCubemap(LvnCubemap** cubemap, const LvnCubemapCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (createInfo->posx.pixels.data() == nullptr)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->posx.pixels does not point to a valid pointer array");
+        return Lvn_Result_Failure;
+    }
+    if (createInfo->negx.pixels.data() == nullptr)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->negx.pixels does not point to a valid pointer array");
+        return Lvn_Result_Failure;
+    }
+    if (createInfo->posy.pixels.data() == nullptr)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->posy.pixels does not point to a valid pointer array");
+        return Lvn_Result_Failure;
+    }
+    if (createInfo->negy.pixels.data() == nullptr)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->negy.pixels does not point to a valid pointer array");
+        return Lvn_Result_Failure;
+    }
+    if (createInfo->posz.pixels.data() == nullptr)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->posz.pixels does not point to a valid pointer array");
+        return Lvn_Result_Failure;
+    }
+    if (createInfo->negz.pixels.data() == nullptr)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->negz.pixels does not point to a valid pointer array");
+        return Lvn_Result_Failure;
+    }
+
+    // if(!(createInfo->posx.width * createInfo->posx.height ==
+    //  createInfo->negx.width * createInfo->negx.height ==
+    //  createInfo->posy.width * createInfo->posy.height ==
+    //  createInfo->negy.width * createInfo->negy.height ==
+    //  createInfo->posz.width * createInfo->posz.height ==
+    //  createInfo->negz.width * createInfo->negz.height))
+    // {
+    //  LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | not all images have the same dimensions, all cubemap images must have the same width and height");
+    //  return Lvn_Result_Failure;
+    // }
+
+    *cubemap = lvn::createObject<LvnCubemap>(lvnctx, Lvn_Stype_Cubemap);
+
+    LVN_CORE_TRACE("created cubemap: (%p)", *cubemap);
+    return lvnctx->graphicsContext.createCubemap(*cubemap, createInfo);
+}
+
+static const void* getHdrImageRgbaPixels(const LvnImageHdrData& hdr, LvnVector<float>* pixels)
+{
+    // packed images are uploaded as they are, half images are always rgba
+    if (hdr.format != Lvn_HdrImageFormat_Float)
+        return hdr.packedPixels.data();
+
+    if (hdr.channels == 4)
+        return hdr.pixels.data();
+
+    // the bake always samples an rgba image, missing channels are filled in the same way texture sampling would
+    uint64_t texelCount = (uint64_t)hdr.width * hdr.height;
+    pixels->resize(texelCount * 4);
+
+    for (uint64_t i = 0; i < texelCount; i++)
+    {
+        const float* src = hdr.pixels.data() + i * hdr.channels;
+        float* dst = pixels->data() + i * 4;
+
+        dst[0] = src[0];
+        dst[1] = hdr.channels >= 2 ? src[1] : (hdr.channels == 1 ? src[0] : 0.0f);
+        dst[2] = hdr.channels >= 3 ? src[2] : (hdr.channels == 1 ? src[0] : 0.0f);
+        dst[3] = 1.0f;
+    }
+
+    return pixels->data();
+}
+
+static void setEnvironmentMapShaderSrcs(LvnEnvironmentMapBakeInfo* bakeInfo, LvnString* srcs)
+{
+    // srcs must hold four strings and outlive the bake info
+    srcs[0] = s_EnvironmentMapCubeShaderHeaderSrc;
+    srcs[0] += s_EnvironmentMapEquirectToCubemapSrc;
+
+    srcs[1] = s_EnvironmentMapCubeShaderHeaderSrc;
+    srcs[1] += s_EnvironmentMapIrradianceSrc;
+
+    srcs[2] = s_EnvironmentMapCubeShaderHeaderSrc;
+    srcs[2] += s_EnvironmentMapGgxShaderSrc;
+    srcs[2] += s_EnvironmentMapPrefilterSrc;
+
+    srcs[3] = s_EnvironmentMapBrdfLutHeaderSrc;
+    srcs[3] += s_EnvironmentMapGgxShaderSrc;
+    srcs[3] += s_EnvironmentMapBrdfLutSrc;
+
+    bakeInfo->equirectToCubemapSrc = srcs[0].c_str();
+    bakeInfo->irradianceSrc = srcs[1].c_str();
+    bakeInfo->prefilterSrc = srcs[2].c_str();
+    bakeInfo->brdfLutSrc = srcs[3].c_str();
+}
+
+static uint64_t hashHdrImageData(const LvnImageHdrData& hdr)
+{
+    // FNV-1a over the image size and the pixel words, only used to tell if a cache file was baked from the same image
+    uint64_t hash = 0xcbf29ce484222325;
+    const uint32_t header[4] = { hdr.width, hdr.height, hdr.channels, (uint32_t)hdr.format };
+
+    for (uint32_t i = 0; i < 4; i++)
+        hash = (hash ^ header[i]) * 0x100000001b3;
+
+    // every texel format is a whole number of 32 bit words
+    bool packed = hdr.format != Lvn_HdrImageFormat_Float;
+    const uint32_t* words = packed ? reinterpret_cast<const uint32_t*>(hdr.packedPixels.data()) : reinterpret_cast<const uint32_t*>(hdr.pixels.data());
+    uint64_t wordCount = (uint64_t)hdr.width * hdr.height * lvn::hdrImageGetTexelSize(hdr.format, hdr.channels) / sizeof(uint32_t);
+
+    for (uint64_t i = 0; i < wordCount; i++)
+        hash = (hash ^ words[i]) * 0x100000001b3;
+
+    return hash;
+}
+
+static bool readEnvironmentMapCache(const char* filepath, const LvnEnvironmentMapBakeInfo* bakeInfo, uint64_t hdrHash, LvnVector<uint8_t>* data)
+{
+    FILE* fileptr = fopen(filepath, "rb");
+    if (!fileptr)
+        return false;
+
+    LvnEnvironmentMapCacheHeader header{};
+    uint64_t bakedSize = lvn::environmentMapGetBakedSize(bakeInfo);
+
+    bool valid = fread(&header, sizeof(LvnEnvironmentMapCacheHeader), 1, fileptr) == 1
+        && header.magic == LVN_ENVIRONMENT_MAP_CACHE_MAGIC
+        && header.version == LVN_ENVIRONMENT_MAP_CACHE_VERSION
+        && header.cubemapSize == bakeInfo->cubemapSize
+        && header.irradianceSize == bakeInfo->irradianceSize
+        && header.prefilterSize == bakeInfo->prefilterSize
+        && header.prefilterMipLevels == bakeInfo->prefilterMipLevels
+        && header.brdfLutSize == bakeInfo->brdfLutSize
+        && header.dataSize == bakedSize
+        && (hdrHash == 0 || header.hdrHash == hdrHash); // without an hdr image any cache with matching sizes is used
+
+    if (valid)
+    {
+        data->resize(bakedSize);
+        valid = fread(data->data(), sizeof(uint8_t), bakedSize, fileptr) == bakedSize;
+    }
+
+    fclose(fileptr);
+
+    if (!valid)
+        LVN_CORE_WARN("environment map cache file does not match the create info and will be rebaked: %s", filepath);
+
+    return valid;
+}
+
+static void writeEnvironmentMapCache(const char* filepath, const LvnEnvironmentMapBakeInfo* bakeInfo, uint64_t hdrHash, const LvnVector<uint8_t>& data)
+{
+    LvnEnvironmentMapCacheHeader header{};
+    header.magic = LVN_ENVIRONMENT_MAP_CACHE_MAGIC;
+    header.version = LVN_ENVIRONMENT_MAP_CACHE_VERSION;
+    header.cubemapSize = bakeInfo->cubemapSize;
+    header.irradianceSize = bakeInfo->irradianceSize;
+    header.prefilterSize = bakeInfo->prefilterSize;
+    header.prefilterMipLevels = bakeInfo->prefilterMipLevels;
+    header.brdfLutSize = bakeInfo->brdfLutSize;
+    header.hdrHash = hdrHash;
+    header.dataSize = data.size();
+
+    FILE* fileptr = fopen(filepath, "wb");
+    if (!fileptr)
+    {
+        LVN_CORE_ERROR("cannot write environment map cache file: %s", filepath);
+        return;
+    }
+
+    if (fwrite(&header, sizeof(LvnEnvironmentMapCacheHeader), 1, fileptr) != 1 || fwrite(data.data(), sizeof(uint8_t), data.size(), fileptr) != data.size())
+        LVN_CORE_ERROR("failed to write environment map cache file: %s", filepath);
+
+    fclose(fileptr);
+}
+
+LvnResult createCubemap(LvnCubemap** cubemap, const LvnCubemapHdrCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    const void* hdrPixels = createInfo->hdr.format == Lvn_HdrImageFormat_Float ? (const void*)createInfo->hdr.pixels.data() : (const void*)createInfo->hdr.packedPixels.data();
+    if (hdrPixels == nullptr)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapHdrCreateInfo*) | createInfo->hdr.pixels does not point to a valid pointer array");
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->hdr.channels == 0 || createInfo->hdr.channels > 4)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapHdrCreateInfo*) | createInfo->hdr.channels (%u) must be between 1 and 4", createInfo->hdr.channels);
+        return Lvn_Result_Failure;
+    }
+
+    LvnVector<float> pixels;
+
+    LvnEnvironmentMapBakeInfo bakeInfo{};
+    bakeInfo.pixels = lvn::getHdrImageRgbaPixels(createInfo->hdr, &pixels);
+    bakeInfo.width = createInfo->hdr.width;
+    bakeInfo.height = createInfo->hdr.height;
+    bakeInfo.format = createInfo->hdr.format;
+    bakeInfo.cubemapSize = createInfo->size ? createInfo->size : lvn::max(createInfo->hdr.width / 4, 1u);
+    bakeInfo.cubemapOnly = true;
+
+    LvnString shaderSrcs[4];
+    lvn::setEnvironmentMapShaderSrcs(&bakeInfo, shaderSrcs);
+
+    LvnEnvironmentMap environmentMap{};
+    if (lvnctx->graphicsContext.createEnvironmentMap(&environmentMap, &bakeInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapHdrCreateInfo*) | failed to convert hdr image (%p) to a cubemap", hdrPixels);
+        return Lvn_Result_Failure;
+    }
+
+    *cubemap = lvn::createObject<LvnCubemap>(lvnctx, Lvn_Stype_Cubemap);
+    (*cubemap)->textureData = environmentMap.cubemap;
+
+    LVN_CORE_TRACE("created cubemap (%p) from hdr image (%p)", *cubemap, hdrPixels);
+    return Lvn_Result_Success;
+}
+
+LvnResult createEnvironmentMap(LvnEnvironmentMap** environmentMap, const LvnEnvironmentMapCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    bool hasHdr = (createInfo->hdr.format == Lvn_HdrImageFormat_Float ? (const void*)createInfo->hdr.pixels.data() : (const void*)createInfo->hdr.packedPixels.data()) != nullptr;
+
+    if (!hasHdr && createInfo->cachePath.empty())
+    {
+        LVN_CORE_ERROR("createEnvironmentMap(LvnEnvironmentMap**, LvnEnvironmentMapCreateInfo*) | createInfo->hdr.pixels does not point to a valid pointer array and no cache path was given");
+        return Lvn_Result_Failure;
+    }
+
+    if (hasHdr && (createInfo->hdr.channels == 0 || createInfo->hdr.channels > 4))
+    {
+        LVN_CORE_ERROR("createEnvironmentMap(LvnEnvironmentMap**, LvnEnvironmentMapCreateInfo*) | createInfo->hdr.channels (%u) must be between 1 and 4", createInfo->hdr.channels);
+        return Lvn_Result_Failure;
+    }
+
+    LvnEnvironmentMapBakeInfo bakeInfo{};
+    bakeInfo.cubemapSize = createInfo->cubemapSize ? createInfo->cubemapSize : 512;
+    bakeInfo.irradianceSize = createInfo->irradianceSize ? createInfo->irradianceSize : 32;
+    bakeInfo.prefilterSize = createInfo->prefilterSize ? createInfo->prefilterSize : 128;
+    bakeInfo.prefilterMipLevels = lvn::clamp(createInfo->prefilterMipLevels ? createInfo->prefilterMipLevels : 5, 1u, lvn::imageGetMipLevelCount(bakeInfo.prefilterSize, bakeInfo.prefilterSize));
+    bakeInfo.brdfLutSize = createInfo->brdfLutSize ? createInfo->brdfLutSize : 512;
+
+    LvnString shaderSrcs[4];
+    lvn::setEnvironmentMapShaderSrcs(&bakeInfo, shaderSrcs);
+
+    uint64_t hdrHash = hasHdr ? lvn::hashHdrImageData(createInfo->hdr) : 0;
+
+    // a matching cache file skips the bake entirely, its texels are uploaded as is
+    LvnVector<uint8_t> bakedData;
+    if (!createInfo->cachePath.empty() && lvn::readEnvironmentMapCache(createInfo->cachePath.c_str(), &bakeInfo, hdrHash, &bakedData))
+    {
+        bakeInfo.pBakedData = bakedData.data();
+    }
+    else if (!hasHdr)
+    {
+        LVN_CORE_ERROR("createEnvironmentMap(LvnEnvironmentMap**, LvnEnvironmentMapCreateInfo*) | createInfo->hdr is empty and no valid cache file was found at: %s", createInfo->cachePath.c_str());
+        return Lvn_Result_Failure;
+    }
+
+    LvnVector<float> pixels;
+    if (!bakeInfo.pBakedData)
+    {
+        bakeInfo.pixels = lvn::getHdrImageRgbaPixels(createInfo->hdr, &pixels);
+        bakeInfo.width = createInfo->hdr.width;
+        bakeInfo.height = createInfo->hdr.height;
+        bakeInfo.format = createInfo->hdr.format;
+
+        if (!createInfo->cachePath.empty())
+            bakeInfo.pBakedDataOut = &bakedData;
+    }
+
+    *environmentMap = lvn::createObject<LvnEnvironmentMap>(lvnctx, Lvn_Stype_EnvironmentMap);
+
+    if (lvnctx->graphicsContext.createEnvironmentMap(*environmentMap, &bakeInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createEnvironmentMap(LvnEnvironmentMap**, LvnEnvironmentMapCreateInfo*) | failed to create environment map textures");
+        lvn::destroyObject(lvnctx, *environmentMap, Lvn_Stype_EnvironmentMap);
+        *environmentMap = nullptr;
+        return Lvn_Result_Failure;
+    }
+
+    if (bakeInfo.pBakedDataOut)
+        lvn::writeEnvironmentMapCache(createInfo->cachePath.c_str(), &bakeInfo, hdrHash, bakedData);
+
+    LVN_CORE_TRACE("created environment map (%p), %s", *environmentMap, bakeInfo.pBakedData ? "loaded from cache" : "baked from hdr image");
+    return Lvn_Result_Success;
+}
+
+void destroyShader(LvnShader* shader)
+{
+    if (shader == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvn::purgePipelineCache(lvnctx, shader);
+    lvn::hotReloadRemoveObject(lvnctx, shader);
+    lvnctx->graphicsContext.destroyShader(shader);
+    lvn::destroyObject(lvnctx, shader, Lvn_Stype_Shader);
+}
+
+void destroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout)
+{
+    if (descriptorLayout == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvn::purgePipelineCache(lvnctx, descriptorLayout);
+    lvnctx->graphicsContext.destroyDescriptorLayout(descriptorLayout);
+
+    for (LvnDescriptorSet* descriptorSet : descriptorLayout->descriptorSets)
+        lvn::memDelete(descriptorSet);
+    descriptorLayout->descriptorSets.clear_free();
+    descriptorLayout->descriptorBindings.clear_free();
+
+    lvn::destroyObject(lvnctx, descriptorLayout, Lvn_Stype_DescriptorLayout);
+}
+
+void destroyPipeline(LvnPipeline* pipeline)
+{
+    if (pipeline == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    // a pipeline compiling in the background is destroyed once its compile finishes
+    lvn::waitPipelineCompile(pipeline);
+
+    {
+        LvnLockGaurd lock(lvnctx->pipelineCacheMutex);
+        if (--pipeline->refCount > 0) { return; }
+
+        for (uint32_t i = 0; i < lvnctx->pipelineCache.size(); i++)
+        {
+            if (lvnctx->pipelineCache[i].pipeline == pipeline)
+            {
+                lvnctx->pipelineCache.erase_index(i);
+                break;
+            }
+        }
+    }
+
+    lvn::hotReloadRemoveObject(lvnctx, pipeline);
+    lvnctx->graphicsContext.destroyPipeline(pipeline);
+    lvn::destroyObject(lvnctx, pipeline, Lvn_Stype_Pipeline);
+}
+
+void destroyFrameBuffer(LvnFrameBuffer* frameBuffer)
+{
+    if (frameBuffer == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvn::purgePipelineCache(lvnctx, lvnctx->graphicsContext.frameBufferGetRenderPass(frameBuffer));
+    lvnctx->graphicsContext.destroyFrameBuffer(frameBuffer);
+    lvn::destroyObject(lvnctx, frameBuffer, Lvn_Stype_FrameBuffer);
+}
+
+void destroyBuffer(LvnBuffer* buffer)
+{
+    if (buffer == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvnctx->graphicsContext.destroyBuffer(buffer);
+    lvn::destroyObject(lvnctx, buffer, Lvn_Stype_Buffer);
+}
+
+void destroySampler(LvnSampler* sampler)
+{
+    if (sampler == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    {
+        LvnLockGaurd lock(lvnctx->samplerCacheMutex);
+        if (--sampler->refCount > 0) { return; }
+
+        auto it = lvnctx->samplerCache.find(sampler);
+        if (it != lvnctx->samplerCache.end())
+            lvnctx->samplerCache.erase(it);
+    }
+
+    lvnctx->graphicsContext.destroySampler(sampler);
+    lvn::destroyObject(lvnctx, sampler, Lvn_Stype_Sampler);
+}
+
+void destroyTexture(LvnTexture* texture)
+{
+    if (texture == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvn::hotReloadRemoveObject(lvnctx, texture);
+    lvnctx->graphicsContext.destroyTexture(texture);
+    lvn::destroyObject(lvnctx, texture, Lvn_Stype_Texture);
+}
+
+void destroyCubemap(LvnCubemap* cubemap)
+{
+    if (cubemap == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvnctx->graphicsContext.destroyCubemap(cubemap);
+    lvn::destroyObject(lvnctx, cubemap, Lvn_Stype_Cubemap);
+}
+
+void destroyEnvironmentMap(LvnEnvironmentMap* environmentMap)
+{
+    if (environmentMap == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvnctx->graphicsContext.destroyEnvironmentMap(environmentMap);
+    lvn::destroyObject(lvnctx, environmentMap, Lvn_Stype_EnvironmentMap);
+}
+
+LvnResult createTextureStream(LvnTextureStream** textureStream, const LvnTextureStreamCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+
+    if (createInfo->data != nullptr ? createInfo->size == 0 : createInfo->filepath.empty())
+    {
+        LVN_CORE_ERROR("createTextureStream(LvnTextureStream**, LvnTextureStreamCreateInfo*) | createInfo has no image source, either data and size or filepath must be set");
+        return Lvn_Result_Failure;
+    }
+
+    LvnTextureStream* stream = lvn::memNew<LvnTextureStream>();
+    stream->textureInfo.format = createInfo->format;
+    stream->textureInfo.minFilter = createInfo->minFilter;
+    stream->textureInfo.magFilter = createInfo->magFilter;
+    stream->textureInfo.wrapS = createInfo->wrapS;
+    stream->textureInfo.wrapT = createInfo->wrapT;
+    stream->previewSize = createInfo->previewSize;
+    stream->mipmaps = createInfo->mipmaps;
+    stream->level = Lvn_TextureStreamLevel_Placeholder;
+
+    LvnTextureCreateInfo placeholderInfo = stream->textureInfo;
+    placeholderInfo.imageData.pixels = LvnData<uint8_t>(createInfo->placeholder, 4);
+    placeholderInfo.imageData.width = 1;
+    placeholderInfo.imageData.height = 1;
+    placeholderInfo.imageData.channels = 4;
+    placeholderInfo.imageData.size = 4;
+    placeholderInfo.mipLevels = 1;
+
+    if (lvn::createTexture(&stream->texture, &placeholderInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createTextureStream(LvnTextureStream**, LvnTextureStreamCreateInfo*) | failed to create placeholder texture");
+        lvn::memDelete(stream);
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->data != nullptr)
+        stream->data = LvnVector<uint8_t>(createInfo->data, createInfo->size);
+    else
+        stream->filepath = createInfo->filepath;
+
+    *textureStream = stream;
+    lvn::jobSubmit(lvn::textureStreamDecodeJob, stream, &stream->counter);
+
+    LVN_CORE_TRACE("created texture stream: (%p), source: %s, preview size: %u", *textureStream, createInfo->data != nullptr ? "memory" : createInfo->filepath.c_str(), createInfo->previewSize);
+    return Lvn_Result_Success;
+}
+
+void destroyTextureStream(LvnTextureStream* textureStream)
+{
+    if (textureStream == nullptr) { return; }
+
+    // the decode job still writes to the stream until the counter is zero
+    lvn::jobWait(&textureStream->counter);
+    lvn::destroyTexture(textureStream->texture);
+    lvn::memDelete(textureStream);
+}
+
+LvnResult createTextureAtlas(LvnTextureAtlas** textureAtlas, const LvnTextureAtlasCreateInfo* createInfo)
+{
+    if (createInfo->pageWidth == 0 || createInfo->pageHeight == 0)
+    {
+        LVN_CORE_ERROR("createTextureAtlas(LvnTextureAtlas**, LvnTextureAtlasCreateInfo*) | createInfo->pageWidth and pageHeight must be greater than zero");
+        return Lvn_Result_Failure;
+    }
+
+    uint32_t mipLevels = lvn::max(createInfo->mipLevels, 1u);
+    if (mipLevels > lvn::imageGetMipLevelCount(createInfo->pageWidth, createInfo->pageHeight))
+    {
+        LVN_CORE_ERROR("createTextureAtlas(LvnTextureAtlas**, LvnTextureAtlasCreateInfo*) | createInfo->mipLevels (%u) is more than the mip chain of a (w:%u,h:%u) page", mipLevels, createInfo->pageWidth, createInfo->pageHeight);
+        return Lvn_Result_Failure;
+    }
+
+    *textureAtlas = lvn::memNew<LvnTextureAtlas>();
+
+    LvnTextureAtlas* atlasPtr = *textureAtlas;
+    atlasPtr->pageWidth = createInfo->pageWidth;
+    atlasPtr->pageHeight = createInfo->pageHeight;
+    atlasPtr->maxPages = createInfo->maxPages;
+    atlasPtr->padding = createInfo->padding;
+    atlasPtr->alignment = 1u << (mipLevels - 1);
+    atlasPtr->mipLevels = mipLevels;
+    atlasPtr->format = createInfo->format;
+    atlasPtr->minFilter = createInfo->minFilter;
+    atlasPtr->magFilter = createInfo->magFilter;
+
+    LVN_CORE_TRACE("created texture atlas: (%p), page size: (w:%u,h:%u), padding: %u, mip levels: %u", *textureAtlas, createInfo->pageWidth, createInfo->pageHeight, createInfo->padding, mipLevels);
+    return Lvn_Result_Success;
+}
+
+void destroyTextureAtlas(LvnTextureAtlas* textureAtlas)
+{
+    if (textureAtlas == nullptr) { return; }
+
+    for (uint32_t i = 0; i < textureAtlas->pages.size(); i++)
+        lvn::destroyTexture(textureAtlas->pages[i].texture);
+
+    lvn::memDelete(textureAtlas);
+}
+
+LvnResult createLightClusters(LvnLightClusters** lightClusters, const LvnLightClustersCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    uint32_t tilesX = createInfo->tilesX ? createInfo->tilesX : 16;
+    uint32_t tilesY = createInfo->tilesY ? createInfo->tilesY : 9;
+    uint32_t slices = createInfo->slices ? createInfo->slices : 24;
+    uint64_t clusterCount = (uint64_t)tilesX * tilesY * slices;
+    uint64_t maxLightIndices = createInfo->maxLightIndices ? createInfo->maxLightIndices : clusterCount * 32;
+
+    if (clusterCount * 2 + maxLightIndices > UINT32_MAX)
+    {
+        LVN_CORE_ERROR("createLightClusters(LvnLightClusters**, LvnLightClustersCreateInfo*) | grid of %u x %u x %u clusters with %llu light indices is too large", tilesX, tilesY, slices, maxLightIndices);
+        return Lvn_Result_Failure;
+    }
+
+    LvnBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.type = Lvn_BufferType_Storage;
+    bufferCreateInfo.usage = Lvn_BufferUsage_DynamicRing;
+    bufferCreateInfo.size = sizeof(LvnLightClustersHeader) + (clusterCount * 2 + maxLightIndices) * sizeof(uint32_t);
+
+    LvnBuffer* buffer;
+    if (lvn::createBuffer(&buffer, &bufferCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createLightClusters(LvnLightClusters**, LvnLightClustersCreateInfo*) | failed to create cluster storage buffer");
+        return Lvn_Result_Failure;
+    }
+
+    *lightClusters = lvn::createObject<LvnLightClusters>(lvnctx, Lvn_Stype_LightClusters);
+    LvnLightClusters* clustersPtr = *lightClusters;
+
+    clustersPtr->buffer = buffer;
+    clustersPtr->tilesX = tilesX;
+    clustersPtr->tilesY = tilesY;
+    clustersPtr->slices = slices;
+    clustersPtr->maxLightIndices = static_cast<uint32_t>(maxLightIndices);
+    clustersPtr->counts.resize(clusterCount);
+
+    LVN_CORE_TRACE("created light clusters (%p), grid: %u x %u x %u, max light indices: %u", *lightClusters, tilesX, tilesY, slices, clustersPtr->maxLightIndices);
+    return Lvn_Result_Success;
+}
+
+void destroyLightClusters(LvnLightClusters* lightClusters)
+{
+    if (lightClusters == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvn::destroyBuffer(lightClusters->buffer);
+    lvn::destroyObject(lvnctx, lightClusters, Lvn_Stype_LightClusters);
+}
+
+static LvnResult createShadowCacheFrameBuffer(LvnFrameBuffer** frameBuffer, uint32_t width, uint32_t height, LvnColorImageFormat depthFormat, LvnTextureFilter textureFilter)
+{
+    LvnFrameBufferColorAttachment colorAttachment = { 0, depthFormat };
+    LvnFrameBufferDepthAttachment depthAttachment = { 1, Lvn_DepthImageFormat_Depth32, false };
+
+    LvnFrameBufferCreateInfo frameBufferCreateInfo{};
+    frameBufferCreateInfo.width = width;
+    frameBufferCreateInfo.height = height;
+    frameBufferCreateInfo.sampleCount = Lvn_SampleCount_1_Bit;
+    frameBufferCreateInfo.pColorAttachments = &colorAttachment;
+    frameBufferCreateInfo.colorAttachmentCount = 1;
+    frameBufferCreateInfo.depthAttachment = &depthAttachment;
+    frameBufferCreateInfo.textureFilter = textureFilter;
+    frameBufferCreateInfo.textureMode = Lvn_TextureMode_ClampToEdge;
+
+    if (lvn::createFrameBuffer(frameBuffer, &frameBufferCreateInfo) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    // cleared to the far plane so texels without casters never shadow
+    lvn::frameBufferSetClearColor(*frameBuffer, 0, 1.0f, 1.0f, 1.0f, 1.0f);
+    return Lvn_Result_Success;
+}
+
+LvnResult createShadowCache(LvnShadowCache** shadowCache, const LvnShadowCacheCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    uint32_t width = createInfo->width ? createInfo->width : 2048;
+    uint32_t height = createInfo->height ? createInfo->height : 2048;
+    LvnColorImageFormat depthFormat = createInfo->depthFormat != Lvn_ColorImageFormat_None ? createInfo->depthFormat : Lvn_ColorImageFormat_RGBA32F;
+
+    LvnFrameBuffer* staticFrameBuffer;
+    if (lvn::createShadowCacheFrameBuffer(&staticFrameBuffer, width, height, depthFormat, createInfo->textureFilter) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createShadowCache(LvnShadowCache**, LvnShadowCacheCreateInfo*) | failed to create static layer framebuffer");
+        return Lvn_Result_Failure;
+    }
+
+    LvnFrameBuffer* dynamicFrameBuffer;
+    if (lvn::createShadowCacheFrameBuffer(&dynamicFrameBuffer, width, height, depthFormat, createInfo->textureFilter) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createShadowCache(LvnShadowCache**, LvnShadowCacheCreateInfo*) | failed to create dynamic layer framebuffer");
+        lvn::destroyFrameBuffer(staticFrameBuffer);
+        return Lvn_Result_Failure;
+    }
+
+    *shadowCache = lvn::createObject<LvnShadowCache>(lvnctx, Lvn_Stype_ShadowCache);
+    LvnShadowCache* shadowCachePtr = *shadowCache;
+
+    shadowCachePtr->staticFrameBuffer = staticFrameBuffer;
+    shadowCachePtr->dynamicFrameBuffer = dynamicFrameBuffer;
+    shadowCachePtr->lightMatrix = LvnMat4(1.0f);
+    shadowCachePtr->valid = false;
+
+    LVN_CORE_TRACE("created shadow cache (%p), size: %u x %u", *shadowCache, width, height);
+    return Lvn_Result_Success;
+}
+
+void destroyShadowCache(LvnShadowCache* shadowCache)
+{
+    if (shadowCache == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvn::destroyFrameBuffer(shadowCache->staticFrameBuffer);
+    lvn::destroyFrameBuffer(shadowCache->dynamicFrameBuffer);
+    lvn::destroyObject(lvnctx, shadowCache, Lvn_Stype_ShadowCache);
+}
+
+LvnResult createMaterialTable(LvnMaterialTable** materialTable, const LvnMaterialTableCreateInfo* createInfo)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    uint32_t maxMaterials = createInfo->maxMaterials ? createInfo->maxMaterials : 1024;
+    uint32_t maxTextures = createInfo->maxTextures ? createInfo->maxTextures : 256;
+
+    LvnBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.type = Lvn_BufferType_Storage;
+    bufferCreateInfo.usage = Lvn_BufferUsage_DynamicDeviceLocal;
+    bufferCreateInfo.size = (uint64_t)maxMaterials * sizeof(LvnMaterialTableEntry);
+
+    LvnBuffer* buffer;
+    if (lvn::createBuffer(&buffer, &bufferCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createMaterialTable(LvnMaterialTable**, LvnMaterialTableCreateInfo*) | failed to create material storage buffer");
+        return Lvn_Result_Failure;
+    }
+
+    // every slot of the array is written with the default texture so the array is always fully bound
+    uint8_t white[4] = { 255, 255, 255, 255 };
+
+    LvnTextureCreateInfo textureCreateInfo{};
+    textureCreateInfo.imageData.width = 1;
+    textureCreateInfo.imageData.height = 1;
+    textureCreateInfo.imageData.channels = 4;
+    textureCreateInfo.imageData.size = sizeof(white);
+    textureCreateInfo.imageData.pixels = LvnData<uint8_t>::view(white, sizeof(white));
+    textureCreateInfo.format = Lvn_TextureFormat_Unorm;
+    textureCreateInfo.minFilter = Lvn_TextureFilter_Nearest;
+    textureCreateInfo.magFilter = Lvn_TextureFilter_Nearest;
+    textureCreateInfo.wrapS = Lvn_TextureMode_Repeat;
+    textureCreateInfo.wrapT = Lvn_TextureMode_Repeat;
+
+    LvnTexture* defaultTexture;
+    if (lvn::createTexture(&defaultTexture, &textureCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createMaterialTable(LvnMaterialTable**, LvnMaterialTableCreateInfo*) | failed to create default texture");
+        lvn::destroyBuffer(buffer);
+        return Lvn_Result_Failure;
+    }
+
+    LvnDescriptorBinding descriptorBindings[2]{};
+    descriptorBindings[0].binding = LVN_MATERIAL_TABLE_MATERIAL_BINDING;
+    descriptorBindings[0].descriptorType = Lvn_DescriptorType_StorageBuffer;
+    descriptorBindings[0].descriptorCount = 1;
+    descriptorBindings[0].maxAllocations = 1;
+    descriptorBindings[0].shaderStage = Lvn_ShaderStage_All;
+
+    descriptorBindings[1].binding = LVN_MATERIAL_TABLE_TEXTURE_BINDING;
+    descriptorBindings[1].descriptorType = Lvn_DescriptorType_ImageSamplerBindless;
+    descriptorBindings[1].descriptorCount = maxTextures;
+    descriptorBindings[1].maxAllocations = 1;
+    descriptorBindings[1].shaderStage = Lvn_ShaderStage_All;
+
+    LvnDescriptorLayoutCreateInfo descriptorLayoutCreateInfo{};
+    descriptorLayoutCreateInfo.pDescriptorBindings = descriptorBindings;
+    descriptorLayoutCreateInfo.descriptorBindingCount = 2;
+    descriptorLayoutCreateInfo.maxSets = 1;
+
+    LvnDescriptorLayout* descriptorLayout;
+    LvnDescriptorSet* descriptorSet;
+    if (lvn::createDescriptorLayout(&descriptorLayout, &descriptorLayoutCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createMaterialTable(LvnMaterialTable**, LvnMaterialTableCreateInfo*) | failed to create descriptor layout");
+        lvn::destroyTexture(defaultTexture);
+        lvn::destroyBuffer(buffer);
+        return Lvn_Result_Failure;
+    }
+
+    if (lvn::allocateDescriptorSet(&descriptorSet, descriptorLayout) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createMaterialTable(LvnMaterialTable**, LvnMaterialTableCreateInfo*) | failed to allocate descriptor set");
+        lvn::destroyDescriptorLayout(descriptorLayout);
+        lvn::destroyTexture(defaultTexture);
+        lvn::destroyBuffer(buffer);
+        return Lvn_Result_Failure;
+    }
+
+    *materialTable = lvn::createObject<LvnMaterialTable>(lvnctx, Lvn_Stype_MaterialTable);
+    LvnMaterialTable* tablePtr = *materialTable;
+
+    tablePtr->descriptorLayout = descriptorLayout;
+    tablePtr->descriptorSet = descriptorSet;
+    tablePtr->buffer = buffer;
+    tablePtr->defaultTexture = defaultTexture;
+    tablePtr->maxMaterials = maxMaterials;
+    tablePtr->maxTextures = maxTextures;
+    tablePtr->textures.push_back(defaultTexture);
+    tablePtr->textureIndices.insert(reinterpret_cast<uint64_t>(defaultTexture), 0);
+    tablePtr->materialsDirty = false;
+    tablePtr->texturesDirty = true;
+
+    char maxTexturesDefine[64];
+    snprintf(maxTexturesDefine, sizeof(maxTexturesDefine), "#define LVN_MATERIAL_TABLE_MAX_TEXTURES %u\n", maxTextures);
+    tablePtr->shaderSrc = LvnString(maxTexturesDefine);
+    tablePtr->shaderSrc += s_MaterialTableShaderSrc;
+
+    lvn::materialTableUpdate(tablePtr);
+
+    LVN_CORE_TRACE("created material table (%p), max materials: %u, max textures: %u", *materialTable, maxMaterials, maxTextures);
+    return Lvn_Result_Success;
+}
+
+void destroyMaterialTable(LvnMaterialTable* materialTable)
+{
+    if (materialTable == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvn::destroyDescriptorLayout(materialTable->descriptorLayout);
+    lvn::destroyTexture(materialTable->defaultTexture);
+    lvn::destroyBuffer(materialTable->buffer);
+    lvn::destroyObject(lvnctx, materialTable, Lvn_Stype_MaterialTable);
+}
+
+static bool renderGraphFrameBuffersCompatible(const LvnRenderGraphResourceData& a, const LvnRenderGraphResourceData& b)
+{
+    const LvnFrameBufferCreateInfo& infoA = a.frameBufferCreateInfo;
+    const LvnFrameBufferCreateInfo& infoB = b.frameBufferCreateInfo;
+
+    if (infoA.width != infoB.width || infoA.height != infoB.height || infoA.sampleCount != infoB.sampleCount ||
+        infoA.textureFilter != infoB.textureFilter || infoA.textureMode != infoB.textureMode)
+        return false;
+
+    if (a.colorAttachments.size() != b.colorAttachments.size())
+        return false;
+
+    for (uint32_t i = 0; i < a.colorAttachments.size(); i++)
+    {
+        if (a.colorAttachments[i].index != b.colorAttachments[i].index || a.colorAttachments[i].format != b.colorAttachments[i].format)
+            return false;
+    }
+
+    bool hasDepthA = infoA.depthAttachment != nullptr, hasDepthB = infoB.depthAttachment != nullptr;
+    if (hasDepthA != hasDepthB)
+        return false;
+
+    if (hasDepthA && (a.depthAttachment.index != b.depthAttachment.index || a.depthAttachment.format != b.depthAttachment.format || a.depthAttachment.sampled != b.depthAttachment.sampled))
+        return false;
+
+    return true;
+}
+
+static bool renderGraphPassUsesResource(const LvnRenderGraphPass& pass, LvnRenderGraphResource resource)
+{
+    if (pass.target == resource)
+        return true;
+
+    for (uint32_t i = 0; i < pass.reads.size(); i++)
+    {
+        if (pass.reads[i].resource == resource)
+            return true;
+    }
+
+    for (uint32_t i = 0; i < pass.writes.size(); i++)
+    {
+        if (pass.writes[i] == resource)
+            return true;
+    }
+
+    return false;
+}
+
+static void renderGraphReleaseFrameBuffers(LvnRenderGraph* renderGraph)
+{
+    for (uint32_t i = 0; i < renderGraph->transientFrameBuffers.size(); i++)
+        lvn::destroyFrameBuffer(renderGraph->transientFrameBuffers[i]);
+
+    renderGraph->transientFrameBuffers.clear();
+
+    for (uint32_t i = 0; i < renderGraph->resources.size(); i++)
+    {
+        if (renderGraph->resources[i].type == Lvn_RenderGraphResourceType_TransientFrameBuffer)
+            renderGraph->resources[i].frameBuffer = nullptr;
+    }
+}
+
+template <typename T>
+static T* allocateCommandListCmd(LvnWindow* window, void (*callFunc)(void*), uint64_t payloadSize)
+{
+    LvnCommandList* commandList = window->commandList;
+
+    // payloads are padded so the next command stays aligned
+    uint64_t size = (sizeof(T) + payloadSize + 7) & ~static_cast<uint64_t>(7);
+    uint64_t offset = commandList->size;
+    if (offset + size > commandList->commands.size())
+        commandList->commands.resize_uninitialized(offset + size);
+
+    uint8_t* data = &commandList->commands[offset];
+    memset(data, 0, size);
+    commandList->size += size;
+    commandList->commandCount++;
+
+    T* cmd = reinterpret_cast<T*>(data);
+    cmd->header.size = size;
+    cmd->header.callFunc = callFunc;
+    cmd->window = window;
+    return cmd;
+}
+
+static void replayCmdDraw(void* data)
+{
+    LvnCmdDraw* cmd = static_cast<LvnCmdDraw*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountDraw(lvnctx, cmd->vertexCount, 1);
+    lvnctx->graphicsContext.renderCmdDraw(cmd->window, cmd->vertexCount);
+}
+
+static void replayCmdDrawIndexed(void* data)
+{
+    LvnCmdDrawIndexed* cmd = static_cast<LvnCmdDrawIndexed*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountDraw(lvnctx, cmd->indexCount, 1);
+    lvnctx->graphicsContext.renderCmdDrawIndexed(cmd->window, cmd->indexCount);
+}
+
+static void replayCmdDrawInstanced(void* data)
+{
+    LvnCmdDrawInstanced* cmd = static_cast<LvnCmdDrawInstanced*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountDraw(lvnctx, cmd->vertexCount, cmd->instanceCount);
+    lvnctx->graphicsContext.renderCmdDrawInstanced(cmd->window, cmd->vertexCount, cmd->instanceCount, cmd->firstInstance);
+}
+
+static void replayCmdDrawIndexedInstanced(void* data)
+{
+    LvnCmdDrawIndexedInstanced* cmd = static_cast<LvnCmdDrawIndexedInstanced*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountDraw(lvnctx, cmd->indexCount, cmd->instanceCount);
+    lvnctx->graphicsContext.renderCmdDrawIndexedInstanced(cmd->window, cmd->indexCount, cmd->instanceCount, cmd->firstInstance);
+}
+
+static void replayCmdDrawIndirect(void* data)
+{
+    LvnCmdDrawIndirect* cmd = static_cast<LvnCmdDrawIndirect*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountIndirect(lvnctx, cmd->drawCount);
+    lvnctx->graphicsContext.renderCmdDrawIndirect(cmd->window, cmd->buffer, cmd->offset, cmd->drawCount, cmd->stride);
+}
+
+static void replayCmdDrawIndexedIndirect(void* data)
+{
+    LvnCmdDrawIndirect* cmd = static_cast<LvnCmdDrawIndirect*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountIndirect(lvnctx, cmd->drawCount);
+    lvnctx->graphicsContext.renderCmdDrawIndexedIndirect(cmd->window, cmd->buffer, cmd->offset, cmd->drawCount, cmd->stride);
+}
+
+static void replayCmdDrawIndexedIndirectCount(void* data)
+{
+    LvnCmdDrawIndirect* cmd = static_cast<LvnCmdDrawIndirect*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsCountIndirect(lvnctx, cmd->drawCount);
+    lvnctx->graphicsContext.renderCmdDrawIndexedIndirectCount(cmd->window, cmd->buffer, cmd->offset, cmd->countBuffer, cmd->countBufferOffset, cmd->drawCount, cmd->stride);
+}
+
+static void replayCmdSetCullMode(void* data)
+{
+    LvnCmdSetCullMode* cmd = static_cast<LvnCmdSetCullMode*>(data);
+    lvn::getContext()->graphicsContext.renderCmdSetCullMode(cmd->window, cmd->cullMode);
+}
+
+static void replayCmdSetFrontFace(void* data)
+{
+    LvnCmdSetFrontFace* cmd = static_cast<LvnCmdSetFrontFace*>(data);
+    lvn::getContext()->graphicsContext.renderCmdSetFrontFace(cmd->window, cmd->frontFace);
+}
+
+static void replayCmdSetPrimitiveTopology(void* data)
+{
+    LvnCmdSetPrimitiveTopology* cmd = static_cast<LvnCmdSetPrimitiveTopology*>(data);
+    lvn::getContext()->graphicsContext.renderCmdSetPrimitiveTopology(cmd->window, cmd->topology);
+}
+
+static void replayCmdSetDepthTest(void* data)
+{
+    LvnCmdSetDepthTest* cmd = static_cast<LvnCmdSetDepthTest*>(data);
+    lvn::getContext()->graphicsContext.renderCmdSetDepthTest(cmd->window, cmd->enableDepth, cmd->depthWrite, cmd->depthOpCompare);
+}
+
+static void replayCmdSetBlendEnable(void* data)
+{
+    LvnCmdSetBlendEnable* cmd = static_cast<LvnCmdSetBlendEnable*>(data);
+    lvn::getContext()->graphicsContext.renderCmdSetBlendEnable(cmd->window, cmd->attachment, cmd->enable);
+}
+
+static void replayCmdSetScissor(void* data)
+{
+    LvnCmdSetScissor* cmd = static_cast<LvnCmdSetScissor*>(data);
+    lvn::getContext()->graphicsContext.renderCmdSetScissor(cmd->window, cmd->x, cmd->y, cmd->width, cmd->height);
+}
+
+static void replayCmdBeginRenderPass(void* data)
+{
+    LvnCmdBeginRenderPass* cmd = static_cast<LvnCmdBeginRenderPass*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_RenderPasses, 1);
+    lvnctx->graphicsContext.renderCmdBeginRenderPass(cmd->window, cmd->r, cmd->g, cmd->b, cmd->a);
+}
+
+static void replayCmdEndRenderPass(void* data)
+{
+    LvnCmdEndRenderPass* cmd = static_cast<LvnCmdEndRenderPass*>(data);
+    lvn::getContext()->graphicsContext.renderCmdEndRenderPass(cmd->window);
+}
+
+static void replayCmdBindPipeline(void* data)
+{
+    LvnCmdBindPipeline* cmd = static_cast<LvnCmdBindPipeline*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_PipelineBinds, 1);
+    lvnctx->graphicsContext.renderCmdBindPipeline(cmd->window, lvn::getBindablePipeline(cmd->pipeline));
+}
+
+static void replayCmdBindVertexBuffer(void* data)
+{
+    LvnCmdBindVertexBuffer* cmd = static_cast<LvnCmdBindVertexBuffer*>(data);
+    LvnBuffer** buffers = reinterpret_cast<LvnBuffer**>(cmd + 1);
+    uint64_t* offsets = reinterpret_cast<uint64_t*>(buffers + cmd->bindingCount);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_VertexBufferBinds, cmd->bindingCount);
+    lvnctx->graphicsContext.renderCmdBindVertexBuffer(cmd->window, cmd->firstBinding, cmd->bindingCount, buffers, offsets);
+}
+
+static void replayCmdBindIndexBuffer(void* data)
+{
+    LvnCmdBindIndexBuffer* cmd = static_cast<LvnCmdBindIndexBuffer*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_IndexBufferBinds, 1);
+    lvnctx->graphicsContext.renderCmdBindIndexBuffer(cmd->window, cmd->buffer, cmd->offset);
+}
+
+static void replayCmdBindDescriptorSets(void* data)
+{
+    LvnCmdBindDescriptorSets* cmd = static_cast<LvnCmdBindDescriptorSets*>(data);
+    LvnDescriptorSet** descriptorSets = reinterpret_cast<LvnDescriptorSet**>(cmd + 1);
+    const uint32_t* dynamicOffsets = cmd->dynamicOffsetCount > 0 ? reinterpret_cast<const uint32_t*>(descriptorSets + cmd->descriptorSetCount) : nullptr;
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_DescriptorSetBinds, cmd->descriptorSetCount);
+    lvnctx->graphicsContext.renderCmdBindDescriptorSets(cmd->window, lvn::getBindablePipeline(cmd->pipeline), cmd->firstSetIndex, cmd->descriptorSetCount, descriptorSets, cmd->dynamicOffsetCount, dynamicOffsets);
+}
+
+static void replayCmdDispatch(void* data)
+{
+    LvnCmdDispatch* cmd = static_cast<LvnCmdDispatch*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_Dispatches, 1);
+    lvnctx->graphicsContext.renderCmdDispatch(cmd->window, cmd->groupCountX, cmd->groupCountY, cmd->groupCountZ);
+}
+
+static void replayCmdMemoryBarrier(void* data)
+{
+    LvnCmdMemoryBarrier* cmd = static_cast<LvnCmdMemoryBarrier*>(data);
+    lvn::getContext()->graphicsContext.renderCmdMemoryBarrier(cmd->window, cmd->barriers);
+}
+
+static void replayCmdBeginTimestamp(void* data)
+{
+    LvnCmdBeginTimestamp* cmd = static_cast<LvnCmdBeginTimestamp*>(data);
+    lvn::getContext()->graphicsContext.renderCmdBeginTimestamp(cmd->window, reinterpret_cast<const char*>(cmd + 1));
+}
+
+static void replayCmdEndTimestamp(void* data)
+{
+    LvnCmdEndTimestamp* cmd = static_cast<LvnCmdEndTimestamp*>(data);
+    lvn::getContext()->graphicsContext.renderCmdEndTimestamp(cmd->window);
+}
+
+static void replayCmdPushConstants(void* data)
+{
+    LvnCmdPushConstants* cmd = static_cast<LvnCmdPushConstants*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_PushConstantBytes, cmd->size);
+    lvnctx->graphicsContext.renderCmdPushConstants(cmd->window, lvn::getBindablePipeline(cmd->pipeline), cmd->shaderStage, cmd->offset, cmd->size, cmd + 1);
+}
+
+static void replayCmdBeginFrameBuffer(void* data)
+{
+    LvnCmdBeginFrameBuffer* cmd = static_cast<LvnCmdBeginFrameBuffer*>(data);
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_RenderPasses, 1);
+    lvnctx->graphicsContext.renderCmdBeginFrameBuffer(cmd->window, cmd->frameBuffer);
+}
+
+static void replayCmdEndFrameBuffer(void* data)
+{
+    LvnCmdEndFrameBuffer* cmd = static_cast<LvnCmdEndFrameBuffer*>(data);
+    lvn::getContext()->graphicsContext.renderCmdEndFrameBuffer(cmd->window, cmd->frameBuffer);
+}
+
+static void replayCmdReadbackFrameBuffer(void* data)
+{
+    LvnCmdReadbackFrameBuffer* cmd = static_cast<LvnCmdReadbackFrameBuffer*>(data);
+    lvn::getContext()->graphicsContext.renderCmdReadbackFrameBuffer(cmd->window, cmd->frameBuffer, cmd->attachmentIndex, cmd->func, cmd->userData);
+}
+
+static void replayCmdExecuteCommandList(void* data)
+{
+    LvnCmdExecuteCommandList* cmd = static_cast<LvnCmdExecuteCommandList*>(data);
+    lvn::renderCmdExecuteCommandList(cmd->window, cmd->commandList);
+}
+
+LvnResult createCommandList(LvnCommandList** commandList)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    *commandList = lvn::createObject<LvnCommandList>(lvnctx, Lvn_Stype_CommandList);
+
+    LVN_CORE_TRACE("created command list: (%p)", *commandList);
+    return Lvn_Result_Success;
+}
+
+void destroyCommandList(LvnCommandList* commandList)
+{
+    if (commandList == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (commandList->window != nullptr && commandList->window->commandList == commandList)
+        commandList->window->commandList = nullptr;
+
+    commandList->commands.clear_free();
+    lvn::destroyObject(lvnctx, commandList, Lvn_Stype_CommandList);
+}
+
+LvnResult createRenderGraph(LvnRenderGraph** renderGraph)
+{
+    LvnContext* lvnctx = lvn::getContext();
+
+    *renderGraph = lvn::createObject<LvnRenderGraph>(lvnctx, Lvn_Stype_RenderGraph);
+    (*renderGraph)->compiled = false;
+
+    LVN_CORE_TRACE("created render graph: (%p)", *renderGraph);
+    return Lvn_Result_Success;
+}
+
+void destroyRenderGraph(LvnRenderGraph* renderGraph)
+{
+    if (renderGraph == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    lvn::renderGraphReleaseFrameBuffers(renderGraph);
+    lvn::destroyObject(lvnctx, renderGraph, Lvn_Stype_RenderGraph);
+}
+
+LvnRenderGraphResource renderGraphImportFrameBuffer(LvnRenderGraph* renderGraph, LvnFrameBuffer* frameBuffer)
+{
+    LvnRenderGraphResourceData resource{};
+    resource.type = Lvn_RenderGraphResourceType_FrameBuffer;
+    resource.frameBuffer = frameBuffer;
+
+    renderGraph->resources.push_back(resource);
+    renderGraph->compiled = false;
+    return renderGraph->resources.size() - 1;
+}
+
+LvnRenderGraphResource renderGraphImportBuffer(LvnRenderGraph* renderGraph, LvnBuffer* buffer)
+{
+    LvnRenderGraphResourceData resource{};
+    resource.type = Lvn_RenderGraphResourceType_Buffer;
+    resource.buffer = buffer;
+
+    renderGraph->resources.push_back(resource);
+    renderGraph->compiled = false;
+    return renderGraph->resources.size() - 1;
+}
+
+LvnRenderGraphResource renderGraphImportWindow(LvnRenderGraph* renderGraph)
+{
+    LvnRenderGraphResourceData resource{};
+    resource.type = Lvn_RenderGraphResourceType_Window;
+
+    renderGraph->resources.push_back(resource);
+    renderGraph->compiled = false;
+    return renderGraph->resources.size() - 1;
+}
+
+LvnRenderGraphResource renderGraphCreateFrameBuffer(LvnRenderGraph* renderGraph, const LvnFrameBufferCreateInfo* createInfo)
+{
+    LvnRenderGraphResourceData resource{};
+    resource.type = Lvn_RenderGraphResourceType_TransientFrameBuffer;
+    resource.frameBufferCreateInfo = *createInfo;
+    resource.colorAttachments = LvnVector<LvnFrameBufferColorAttachment>(createInfo->pColorAttachments, createInfo->pColorAttachments + createInfo->colorAttachmentCount);
+    if (createInfo->depthAttachment != nullptr)
+        resource.depthAttachment = *createInfo->depthAttachment;
+
+    // attachment pointers are set to the copies when the framebuffer is created
+    resource.frameBufferCreateInfo.pColorAttachments = nullptr;
+
+    renderGraph->resources.push_back(resource);
+    renderGraph->compiled = false;
+    return renderGraph->resources.size() - 1;
+}
+
+LvnResult renderGraphAddPass(LvnRenderGraph* renderGraph, const LvnRenderGraphPassCreateInfo* createInfo)
+{
+    const char* name = createInfo->name ? createInfo->name : "";
+    uint32_t resourceCount = renderGraph->resources.size();
+
+    if (createInfo->execute == nullptr)
+    {
+        LVN_CORE_ERROR("renderGraphAddPass(LvnRenderGraph*, LvnRenderGraphPassCreateInfo*) | pass \"%s\" has no execute function", name);
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->target != LVN_RENDER_GRAPH_NO_RESOURCE)
+    {
+        if (createInfo->target >= resourceCount || renderGraph->resources[createInfo->target].type == Lvn_RenderGraphResourceType_Buffer)
+        {
+            LVN_CORE_ERROR("renderGraphAddPass(LvnRenderGraph*, LvnRenderGraphPassCreateInfo*) | pass \"%s\" target (%u) is not a framebuffer or window resource of the render graph", name, createInfo->target);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    for (uint32_t i = 0; i < createInfo->readCount; i++)
+    {
+        LvnRenderGraphResource resource = createInfo->pReads[i].resource;
+
+        if (resource >= resourceCount || renderGraph->resources[resource].type == Lvn_RenderGraphResourceType_Window)
+        {
+            LVN_CORE_ERROR("renderGraphAddPass(LvnRenderGraph*, LvnRenderGraphPassCreateInfo*) | pass \"%s\" read (%u) is not a framebuffer or buffer resource of the render graph", name, resource);
+            return Lvn_Result_Failure;
+        }
+        if (resource == createInfo->target)
+        {
+            LVN_CORE_ERROR("renderGraphAddPass(LvnRenderGraph*, LvnRenderGraphPassCreateInfo*) | pass \"%s\" reads from its own target (%u), a framebuffer cannot be sampled while it is rendered to", name, resource);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    for (uint32_t i = 0; i < createInfo->writeCount; i++)
+    {
+        LvnRenderGraphResource resource = createInfo->pWrites[i];
+
+        if (resource >= resourceCount || renderGraph->resources[resource].type != Lvn_RenderGraphResourceType_Buffer)
+        {
+            LVN_CORE_ERROR("renderGraphAddPass(LvnRenderGraph*, LvnRenderGraphPassCreateInfo*) | pass \"%s\" write (%u) is not a buffer resource of the render graph, framebuffers are written as the pass target", name, resource);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    LvnRenderGraphPass pass{};
+    pass.name = name;
+    pass.target = createInfo->target;
+    pass.reads = LvnVector<LvnRenderGraphAccess>(createInfo->pReads, createInfo->pReads + createInfo->readCount);
+    pass.writes = LvnVector<LvnRenderGraphResource>(createInfo->pWrites, createInfo->pWrites + createInfo->writeCount);
+    pass.clearColor = createInfo->clearColor;
+    pass.keepAlive = createInfo->keepAlive;
+    pass.execute = createInfo->execute;
+    pass.userData = createInfo->userData;
+    pass.barriers = Lvn_MemoryBarrier_None;
+
+    renderGraph->passes.push_back(pass);
+    renderGraph->compiled = false;
+    return Lvn_Result_Success;
+}
+
+LvnResult renderGraphCompile(LvnRenderGraph* renderGraph, LvnRenderGraphResource output)
+{
+    LvnVector<LvnRenderGraphResourceData>& resources = renderGraph->resources;
+    LvnVector<LvnRenderGraphPass>& passes = renderGraph->passes;
+
+    if (output >= resources.size())
+    {
+        LVN_CORE_ERROR("renderGraphCompile(LvnRenderGraph*, LvnRenderGraphResource) | output (%u) is not a resource of the render graph", output);
+        return Lvn_Result_Failure;
+    }
+
+    lvn::renderGraphReleaseFrameBuffers(renderGraph);
+    renderGraph->executionOrder.clear();
+    renderGraph->compiled = false;
+
+    // cull passes, walking backwards from the output a pass is kept if it writes a resource that is needed later
+    LvnVector<bool> neededResources(resources.size(), false);
+    LvnVector<bool> keptPasses(passes.size(), false);
+    neededResources[output] = true;
+
+    for (int64_t i = (int64_t)passes.size() - 1; i >= 0; i--)
+    {
+        const LvnRenderGraphPass& pass = passes[i];
+
+        bool needed = pass.keepAlive || (pass.target != LVN_RENDER_GRAPH_NO_RESOURCE && neededResources[pass.target]);
+        for (uint32_t j = 0; j < pass.writes.size() && !needed; j++)
+            needed = neededResources[pass.writes[j]];
+
+        if (!needed)
+            continue;
+
+        keptPasses[i] = true;
+        for (uint32_t j = 0; j < pass.reads.size(); j++)
+            neededResources[pass.reads[j].resource] = true;
+    }
+
+    for (uint32_t i = 0; i < passes.size(); i++)
+    {
+        if (keptPasses[i])
+            renderGraph->executionOrder.push_back(i);
+    }
+
+    LvnVector<uint32_t>& executionOrder = renderGraph->executionOrder;
+
+    // lifetime of each resource as the first and last position in the execution order that uses it
+    LvnVector<int64_t> firstUse(resources.size(), -1);
+    LvnVector<int64_t> lastUse(resources.size(), -1);
+    LvnVector<bool> written(resources.size(), false);
+
+    for (uint32_t i = 0; i < executionOrder.size(); i++)
+    {
+        const LvnRenderGraphPass& pass = passes[executionOrder[i]];
+
+        // transient framebuffers have no contents until a pass renders to them
+        for (uint32_t j = 0; j < pass.reads.size(); j++)
+        {
+            LvnRenderGraphResource resource = pass.reads[j].resource;
+            if (resources[resource].type == Lvn_RenderGraphResourceType_TransientFrameBuffer && !written[resource])
+            {
+                LVN_CORE_ERROR("renderGraphCompile(LvnRenderGraph*, LvnRenderGraphResource) | pass \"%s\" reads transient framebuffer (%u) before any pass renders to it", pass.name.c_str(), resource);
+                renderGraph->executionOrder.clear();
+                return Lvn_Result_Failure;
+            }
+        }
+
+        if (pass.target != LVN_RENDER_GRAPH_NO_RESOURCE)
+            written[pass.target] = true;
+
+        for (uint32_t j = 0; j < resources.size(); j++)
+        {
+            if (!lvn::renderGraphPassUsesResource(pass, j))
+                continue;
+
+            if (firstUse[j] < 0)
+                firstUse[j] = i;
+            lastUse[j] = i;
+        }
+    }
+
+    // transient framebuffers are assigned in order of first use, reusing a framebuffer whose last use has already passed
+    LvnVector<int64_t> frameBufferLastUse;
+    LvnVector<LvnRenderGraphResource> frameBufferResources;
+    uint32_t transientCount = 0;
+
+    for (uint32_t i = 0; i < executionOrder.size(); i++)
+    {
+        for (uint32_t j = 0; j < resources.size(); j++)
+        {
+            LvnRenderGraphResourceData& resource = resources[j];
+            if (resource.type != Lvn_RenderGraphResourceType_TransientFrameBuffer || firstUse[j] != i)
+                continue;
+
+            transientCount++;
+
+            for (uint32_t k = 0; k < renderGraph->transientFrameBuffers.size(); k++)
+            {
+                if (frameBufferLastUse[k] < firstUse[j] && lvn::renderGraphFrameBuffersCompatible(resources[frameBufferResources[k]], resource))
+                {
+                    resource.frameBuffer = renderGraph->transientFrameBuffers[k];
+                    frameBufferLastUse[k] = lastUse[j];
+                    break;
+                }
+            }
+
+            if (resource.frameBuffer != nullptr)
+                continue;
+
+            LvnFrameBufferCreateInfo frameBufferCreateInfo = resource.frameBufferCreateInfo;
+            frameBufferCreateInfo.pColorAttachments = resource.colorAttachments.data();
+            frameBufferCreateInfo.colorAttachmentCount = resource.colorAttachments.size();
+            frameBufferCreateInfo.depthAttachment = resource.frameBufferCreateInfo.depthAttachment != nullptr ? &resource.depthAttachment : nullptr;
+
+            LvnFrameBuffer* frameBuffer;
+            if (lvn::createFrameBuffer(&frameBuffer, &frameBufferCreateInfo) != Lvn_Result_Success)
+            {
+                LVN_CORE_ERROR("renderGraphCompile(LvnRenderGraph*, LvnRenderGraphResource) | failed to create framebuffer for transient resource (%u)", j);
+                lvn::renderGraphReleaseFrameBuffers(renderGraph);
+                renderGraph->executionOrder.clear();
+                return Lvn_Result_Failure;
+            }
+
+            resource.frameBuffer = frameBuffer;
+            renderGraph->transientFrameBuffers.push_back(frameBuffer);
+            frameBufferLastUse.push_back(lastUse[j]);
+            frameBufferResources.push_back(j);
+        }
+    }
+
+    // plan barriers, a buffer written by an earlier pass needs a barrier for each way it is used until one has been recorded since the write;
+    // barriers are global so one recorded before a pass covers every buffer written before it
+    LvnVector<int64_t> lastWrite(resources.size(), -1);
+    int64_t lastBarrier[5] = { -1, -1, -1, -1, -1 };
+    uint32_t barrierCount = 0;
+
+    for (uint32_t i = 0; i < executionOrder.size(); i++)
+    {
+        LvnRenderGraphPass& pass = passes[executionOrder[i]];
+        pass.barriers = Lvn_MemoryBarrier_None;
+
+        for (uint32_t j = 0; j < pass.reads.size(); j++)
+        {
+            LvnRenderGraphResource resource = pass.reads[j].resource;
+            if (resources[resource].type != Lvn_RenderGraphResourceType_Buffer || lastWrite[resource] < 0)
+                continue;
+
+            for (uint32_t bit = 0; bit < 5; bit++)
+            {
+                if ((pass.reads[j].usage & (1U << bit)) && lastBarrier[bit] <= lastWrite[resource])
+                    pass.barriers |= (1U << bit);
+            }
+        }
+
+        // writes after earlier shader writes to the same buffer are ordered with a storage barrier
+        for (uint32_t j = 0; j < pass.writes.size(); j++)
+        {
+            if (lastWrite[pass.writes[j]] >= 0 && lastBarrier[0] <= lastWrite[pass.writes[j]])
+                pass.barriers |= Lvn_MemoryBarrier_StorageBuffer;
+        }
+
+        for (uint32_t bit = 0; bit < 5; bit++)
+        {
+            if (pass.barriers & (1U << bit))
+                lastBarrier[bit] = i;
+        }
+
+        if (pass.barriers != Lvn_MemoryBarrier_None)
+            barrierCount++;
+
+        for (uint32_t j = 0; j < pass.writes.size(); j++)
+            lastWrite[pass.writes[j]] = i;
+    }
+
+    renderGraph->compiled = true;
+
+    LVN_CORE_TRACE("compiled render graph (%p), passes: %u (%u culled), transient framebuffers: %u for %u resources, barriers: %u", renderGraph, executionOrder.size(), passes.size() - executionOrder.size(), renderGraph->transientFrameBuffers.size(), transientCount, barrierCount);
+    return Lvn_Result_Success;
+}
+
+void renderGraphExecute(LvnRenderGraph* renderGraph, LvnWindow* window)
+{
+    LVN_CORE_ASSERT(renderGraph->compiled, "render graph (%p) must be compiled before it is executed", renderGraph);
+
+    for (uint32_t i = 0; i < renderGraph->executionOrder.size(); i++)
+    {
+        LvnRenderGraphPass& pass = renderGraph->passes[renderGraph->executionOrder[i]];
+
+        if (pass.barriers != Lvn_MemoryBarrier_None)
+            lvn::renderCmdMemoryBarrier(window, pass.barriers);
+
+        // every pass is timed so the passes worth optimizing show up in renderGetTimestamps
+        lvn::renderCmdBeginTimestamp(window, pass.name.c_str());
+
+        if (pass.target == LVN_RENDER_GRAPH_NO_RESOURCE)
+        {
+            pass.execute(renderGraph, window, pass.userData);
+            lvn::renderCmdEndTimestamp(window);
+            continue;
+        }
+
+        const LvnRenderGraphResourceData& target = renderGraph->resources[pass.target];
+        if (target.type == Lvn_RenderGraphResourceType_Window)
+        {
+            lvn::renderCmdBeginRenderPass(window, pass.clearColor.r, pass.clearColor.g, pass.clearColor.b, pass.clearColor.a);
+            pass.execute(renderGraph, window, pass.userData);
+            lvn::renderCmdEndRenderPass(window);
+        }
+        else
+        {
+            lvn::renderCmdBeginFrameBuffer(window, target.frameBuffer);
+            pass.execute(renderGraph, window, pass.userData);
+            lvn::renderCmdEndFrameBuffer(window, target.frameBuffer);
+        }
+
+        lvn::renderCmdEndTimestamp(window);
+    }
+}
+
+LvnFrameBuffer* renderGraphGetFrameBuffer(LvnRenderGraph* renderGraph, LvnRenderGraphResource resource)
+{
+    LVN_CORE_ASSERT(resource < renderGraph->resources.size(), "render graph resource (%u) out of range", resource);
+    return renderGraph->resources[resource].frameBuffer;
+}
+
+uint32_t getAttributeFormatSize(LvnAttributeFormat format)
+{
+    switch (format)
+    {
+        case Lvn_AttributeFormat_Undefined:        { return 0; }
+        case Lvn_AttributeFormat_Scalar_f32:       { return sizeof(float); }
+        case Lvn_AttributeFormat_Scalar_f64:       { return sizeof(double); }
+        case Lvn_AttributeFormat_Scalar_i32:       { return sizeof(int32_t); }
+        case Lvn_AttributeFormat_Scalar_ui32:      { return sizeof(uint32_t); }
+        case Lvn_AttributeFormat_Scalar_i8:        { return sizeof(int8_t); }
+        case Lvn_AttributeFormat_Scalar_ui8:       { return sizeof(uint8_t); }
+        case Lvn_AttributeFormat_Vec2_f32:         { return 2 * sizeof(float); }
+        case Lvn_AttributeFormat_Vec3_f32:         { return 3 * sizeof(float); }
+        case Lvn_AttributeFormat_Vec4_f32:         { return 4 * sizeof(float); }
+        case Lvn_AttributeFormat_Vec2_f64:         { return 2 * sizeof(double); }
+        case Lvn_AttributeFormat_Vec3_f64:         { return 3 * sizeof(double); }
+        case Lvn_AttributeFormat_Vec4_f64:         { return 4 * sizeof(double); }
+        case Lvn_AttributeFormat_Vec2_i32:         { return 2 * sizeof(int32_t); }
+        case Lvn_AttributeFormat_Vec3_i32:         { return 3 * sizeof(int32_t); }
+        case Lvn_AttributeFormat_Vec4_i32:         { return 4 * sizeof(int32_t); }
+        case Lvn_AttributeFormat_Vec2_ui32:        { return 2 * sizeof(uint32_t); }
+        case Lvn_AttributeFormat_Vec3_ui32:        { return 3 * sizeof(uint32_t); }
+        case Lvn_AttributeFormat_Vec4_ui32:        { return 4 * sizeof(uint32_t); }
+        case Lvn_AttributeFormat_Vec2_i8:          { return 2 * sizeof(int8_t); }
+        case Lvn_AttributeFormat_Vec3_i8:          { return 3 * sizeof(int8_t); }
+        case Lvn_AttributeFormat_Vec4_i8:          { return 4 * sizeof(int8_t); }
+        case Lvn_AttributeFormat_Vec2_ui8:         { return 2 * sizeof(uint8_t); }
+        case Lvn_AttributeFormat_Vec3_ui8:         { return 3 * sizeof(uint8_t); }
+        case Lvn_AttributeFormat_Vec4_ui8:         { return 4 * sizeof(uint8_t); }
+        case Lvn_AttributeFormat_Vec2_n8:          { return 2 * sizeof(int8_t); }
+        case Lvn_AttributeFormat_Vec3_n8:          { return 3 * sizeof(int8_t); }
+        case Lvn_AttributeFormat_Vec4_n8:          { return 4 * sizeof(int8_t); }
+        case Lvn_AttributeFormat_Vec2_un8:         { return 2 * sizeof(uint8_t); }
+        case Lvn_AttributeFormat_Vec3_un8:         { return 3 * sizeof(uint8_t); }
+        case Lvn_AttributeFormat_Vec4_un8:         { return 4 * sizeof(uint8_t); }
+        case Lvn_AttributeFormat_2_10_10_10_ile:   { return sizeof(int32_t); }
+        case Lvn_AttributeFormat_2_10_10_10_uile:  { return sizeof(uint32_t); }
+        case Lvn_AttributeFormat_2_10_10_10_nle:   { return sizeof(int32_t); }
+        case Lvn_AttributeFormat_2_10_10_10_unle:  { return sizeof(uint32_t); }
+        case Lvn_AttributeFormat_Vec2_f16:         { return 2 * sizeof(uint16_t); }
+        case Lvn_AttributeFormat_Vec4_f16:         { return 4 * sizeof(uint16_t); }
+        case Lvn_AttributeFormat_Vec2_n16:         { return 2 * sizeof(int16_t); }
+        case Lvn_AttributeFormat_Vec4_n16:         { return 4 * sizeof(int16_t); }
+        case Lvn_AttributeFormat_Vec2_un16:        { return 2 * sizeof(uint16_t); }
+        case Lvn_AttributeFormat_Vec4_un16:        { return 4 * sizeof(uint16_t); }
+
+        default:
+        {
+            LVN_CORE_WARN("unknown vertex data type enum: (%u)", format);
+            return 0;
+        }
+    }
+}
+
+uint32_t getAttributeFormatComponentSize(LvnAttributeFormat format)
+{
+    switch (format)
+    {
+        case Lvn_AttributeFormat_Undefined:        { return 0; }
+        case Lvn_AttributeFormat_Scalar_f32:       { return 1; }
+        case Lvn_AttributeFormat_Scalar_f64:       { return 1; }
+        case Lvn_AttributeFormat_Scalar_i32:       { return 1; }
+        case Lvn_AttributeFormat_Scalar_ui32:      { return 1; }
+        case Lvn_AttributeFormat_Scalar_i8:        { return 1; }
+        case Lvn_AttributeFormat_Scalar_ui8:       { return 1; }
+        case Lvn_AttributeFormat_Vec2_f32:         { return 2; }
+        case Lvn_AttributeFormat_Vec3_f32:         { return 3; }
+        case Lvn_AttributeFormat_Vec4_f32:         { return 4; }
+        case Lvn_AttributeFormat_Vec2_f64:         { return 2; }
+        case Lvn_AttributeFormat_Vec3_f64:         { return 3; }
+        case Lvn_AttributeFormat_Vec4_f64:         { return 4; }
+        case Lvn_AttributeFormat_Vec2_i32:         { return 2; }
+        case Lvn_AttributeFormat_Vec3_i32:         { return 3; }
+        case Lvn_AttributeFormat_Vec4_i32:         { return 4; }
+        case Lvn_AttributeFormat_Vec2_ui32:        { return 2; }
+        case Lvn_AttributeFormat_Vec3_ui32:        { return 3; }
+        case Lvn_AttributeFormat_Vec4_ui32:        { return 4; }
+        case Lvn_AttributeFormat_Vec2_i8:          { return 2; }
+        case Lvn_AttributeFormat_Vec3_i8:          { return 3; }
+        case Lvn_AttributeFormat_Vec4_i8:          { return 4; }
+        case Lvn_AttributeFormat_Vec2_ui8:         { return 2; }
+        case Lvn_AttributeFormat_Vec3_ui8:         { return 3; }
+        case Lvn_AttributeFormat_Vec4_ui8:         { return 4; }
+        case Lvn_AttributeFormat_Vec2_n8:          { return 2; }
+        case Lvn_AttributeFormat_Vec3_n8:          { return 3; }
+        case Lvn_AttributeFormat_Vec4_n8:          { return 4; }
+        case Lvn_AttributeFormat_Vec2_un8:         { return 2; }
+        case Lvn_AttributeFormat_Vec3_un8:         { return 3; }
+        case Lvn_AttributeFormat_Vec4_un8:         { return 4; }
+        case Lvn_AttributeFormat_2_10_10_10_ile:   { return 4; }
+        case Lvn_AttributeFormat_2_10_10_10_uile:  { return 4; }
+        case Lvn_AttributeFormat_2_10_10_10_nle:   { return 4; }
+        case Lvn_AttributeFormat_2_10_10_10_unle:  { return 4; }
+        case Lvn_AttributeFormat_Vec2_f16:         { return 2; }
+        case Lvn_AttributeFormat_Vec4_f16:         { return 4; }
+        case Lvn_AttributeFormat_Vec2_n16:         { return 2; }
+        case Lvn_AttributeFormat_Vec4_n16:         { return 4; }
+        case Lvn_AttributeFormat_Vec2_un16:        { return 2; }
+        case Lvn_AttributeFormat_Vec4_un16:        { return 4; }
+
+        default:
+        {
+            LVN_CORE_WARN("unknown vertex data type enum: (%u)", format);
+            return 0;
+        }
+    }
+}
+
+bool isAttributeFormatNormalizedType(LvnAttributeFormat format)
+{
+    switch (format)
+    {
+        case Lvn_AttributeFormat_Vec2_n8:          { return true; }
+        case Lvn_AttributeFormat_Vec3_n8:          { return true; }
+        case Lvn_AttributeFormat_Vec4_n8:          { return true; }
+        case Lvn_AttributeFormat_Vec2_un8:         { return true; }
+        case Lvn_AttributeFormat_Vec3_un8:         { return true; }
+        case Lvn_AttributeFormat_Vec4_un8:         { return true; }
+        case Lvn_AttributeFormat_2_10_10_10_nle:   { return true; }
+        case Lvn_AttributeFormat_2_10_10_10_unle:  { return true; }
+        case Lvn_AttributeFormat_Vec2_n16:         { return true; }
+        case Lvn_AttributeFormat_Vec4_n16:         { return true; }
+        case Lvn_AttributeFormat_Vec2_un16:        { return true; }
+        case Lvn_AttributeFormat_Vec4_un16:        { return true; }
+
+        default: { return false; }
+    }
+}
+
+static uint16_t floatToHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(uint32_t));
+
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t exponent = (bits >> 23) & 0xff;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    // inf and nan, nans keep a mantissa bit set
+    if (exponent == 0xff)
+        return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+    int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+    if (halfExponent >= 0x1f)
+        return static_cast<uint16_t>(sign | 0x7c00);
+
+    // subnormal halfs, the implicit bit is shifted into the mantissa
+    if (halfExponent <= 0)
+    {
+        if (halfExponent < -10)
+            return static_cast<uint16_t>(sign);
+
+        mantissa |= 0x800000;
+        uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1U << shift) - 1);
+        uint32_t halfway = 1U << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1)))
+            half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // round to nearest even, a carry out of the mantissa correctly bumps the exponent
+    uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1fff;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+        half++;
+    return static_cast<uint16_t>(sign | half);
+}
+
+static LvnVec2 octahedralEncode(const LvnVec3& v)
+{
+    float length = fabsf(v.x) + fabsf(v.y) + fabsf(v.z);
+    if (length == 0.0f)
+        return LvnVec2(0.0f, 0.0f);
+
+    LvnVec2 e(v.x / length, v.y / length);
+    if (v.z < 0.0f)
+    {
+        LvnVec2 folded((1.0f - fabsf(e.y)) * (e.x >= 0.0f ? 1.0f : -1.0f), (1.0f - fabsf(e.x)) * (e.y >= 0.0f ? 1.0f : -1.0f));
+        e = folded;
+    }
+    return e;
+}
+
+static uint32_t packSnorm2101010(float x, float y, float z, float w)
+{
+    int32_t ix = static_cast<int32_t>(roundf(lvn::clamp(x, -1.0f, 1.0f) * 511.0f));
+    int32_t iy = static_cast<int32_t>(roundf(lvn::clamp(y, -1.0f, 1.0f) * 511.0f));
+    int32_t iz = static_cast<int32_t>(roundf(lvn::clamp(z, -1.0f, 1.0f) * 511.0f));
+    int32_t iw = static_cast<int32_t>(roundf(lvn::clamp(w, -1.0f, 1.0f)));
+    return (static_cast<uint32_t>(ix) & 0x3ff) | ((static_cast<uint32_t>(iy) & 0x3ff) << 10) | ((static_cast<uint32_t>(iz) & 0x3ff) << 20) | ((static_cast<uint32_t>(iw) & 0x3) << 30);
+}
+
+uint32_t vertexLayoutGetStride(const LvnVertexLayout& layout)
+{
+    LvnVertexAttribute attributes[8];
+    uint32_t attributeCount = lvn::vertexLayoutGetAttributes(layout, attributes);
+    if (attributeCount == 0)
+        return 0;
+
+    const LvnVertexAttribute& last = attributes[attributeCount - 1];
+    return static_cast<uint32_t>(last.offset) + lvn::getAttributeFormatSize(last.format);
+}
+
+uint32_t vertexLayoutGetAttributes(const LvnVertexLayout& layout, LvnVertexAttribute* pAttributes, uint32_t binding)
+{
+    // attributes are laid out in the order of LvnVertex and keep its locations so shaders only drop inputs they do not use
+    struct LayoutAttribute { uint32_t location; LvnVertexAttributeFlagBits flag; LvnAttributeFormat format; LvnAttributeFormat quantizedFormat; };
+    static const LayoutAttribute s_LayoutAttributes[] =
+    {
+        { 0, Lvn_VertexAttributeFlag_None,    Lvn_AttributeFormat_Vec3_f32, Lvn_AttributeFormat_Vec3_f32 },        // pos
+        { 1, Lvn_VertexAttributeFlag_Color,   Lvn_AttributeFormat_Vec4_f32, Lvn_AttributeFormat_Vec4_un8 },        // color
+        { 2, Lvn_VertexAttributeFlag_TexUV,   Lvn_AttributeFormat_Vec2_f32, Lvn_AttributeFormat_Vec2_f16 },        // texUV
+        { 3, Lvn_VertexAttributeFlag_Normal,  Lvn_AttributeFormat_Vec3_f32, Lvn_AttributeFormat_Vec2_n16 },        // normal
+        { 4, Lvn_VertexAttributeFlag_Tangent, Lvn_AttributeFormat_Vec3_f32, Lvn_AttributeFormat_2_10_10_10_nle },  // tangent
+        { 5, Lvn_VertexAttributeFlag_Tangent, Lvn_AttributeFormat_Vec3_f32, Lvn_AttributeFormat_Undefined },       // bitangent
+        { 6, Lvn_VertexAttributeFlag_Joints,  Lvn_AttributeFormat_Vec4_f32, Lvn_AttributeFormat_Vec4_ui8 },        // joints
+        { 7, Lvn_VertexAttributeFlag_Weights, Lvn_AttributeFormat_Vec4_f32, Lvn_AttributeFormat_Vec4_un16 },       // weights
+    };
+
+    uint32_t count = 0;
+    uint64_t offset = 0;
+    for (const LayoutAttribute& attribute : s_LayoutAttributes)
+    {
+        if (attribute.flag != Lvn_VertexAttributeFlag_None && !(layout.attributes & attribute.flag))
+            continue;
+
+        LvnAttributeFormat format = layout.quantized ? attribute.quantizedFormat : attribute.format;
+        if (format == Lvn_AttributeFormat_Undefined)
+            continue;
+
+        if (pAttributes)
+            pAttributes[count] = { binding, attribute.location, format, offset };
+
+        offset += lvn::getAttributeFormatSize(format);
+        count++;
+    }
+
+    return count;
+}
+
+void vertexLayoutPack(const LvnVertexLayout& layout, const LvnVertex* pVertices, uint64_t count, void* dst)
+{
+    LvnVertexAttribute attributes[8];
+    uint32_t attributeCount = lvn::vertexLayoutGetAttributes(layout, attributes);
+    uint32_t stride = lvn::vertexLayoutGetStride(layout);
+    uint64_t jointsOutOfRange = 0;
+
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    for (uint64_t i = 0; i < count; i++, out += stride)
+    {
+        const LvnVertex& vertex = pVertices[i];
+        for (uint32_t j = 0; j < attributeCount; j++)
+        {
+            uint8_t* ptr = out + attributes[j].offset;
+            switch (attributes[j].format)
+            {
+                case Lvn_AttributeFormat_Vec2_f32:
+                case Lvn_AttributeFormat_Vec3_f32:
+                case Lvn_AttributeFormat_Vec4_f32:
+                {
+                    // unquantized attributes are copied as is from the matching member of LvnVertex
+                    const float* src = nullptr;
+                    switch (attributes[j].layout)
+                    {
+                        case 0: { src = &vertex.pos.x; break; }
+                        case 1: { src = &vertex.color.x; break; }
+                        case 2: { src = &vertex.texUV.x; break; }
+                        case 3: { src = &vertex.normal.x; break; }
+                        case 4: { src = &vertex.tangent.x; break; }
+                        case 5: { src = &vertex.bitangent.x; break; }
+                        case 6: { src = &vertex.joints.x; break; }
+                        case 7: { src = &vertex.weights.x; break; }
+                    }
+                    memcpy(ptr, src, lvn::getAttributeFormatSize(attributes[j].format));
+                    break;
+                }
+                case Lvn_AttributeFormat_Vec4_un8:
+                {
+                    for (uint32_t k = 0; k < 4; k++)
+                        ptr[k] = static_cast<uint8_t>(roundf(lvn::clamp(vertex.color[k], 0.0f, 1.0f) * 255.0f));
+                    break;
+                }
+                case Lvn_AttributeFormat_Vec2_f16:
+                {
+                    uint16_t uv[2] = { lvn::floatToHalf(vertex.texUV.x), lvn::floatToHalf(vertex.texUV.y) };
+                    memcpy(ptr, uv, sizeof(uv));
+                    break;
+                }
+                case Lvn_AttributeFormat_Vec2_n16:
+                {
+                    LvnVec2 e = lvn::octahedralEncode(vertex.normal);
+                    int16_t normal[2] = { static_cast<int16_t>(roundf(lvn::clamp(e.x, -1.0f, 1.0f) * 32767.0f)), static_cast<int16_t>(roundf(lvn::clamp(e.y, -1.0f, 1.0f) * 32767.0f)) };
+                    memcpy(ptr, normal, sizeof(normal));
+                    break;
+                }
+                case Lvn_AttributeFormat_2_10_10_10_nle:
+                {
+                    // the bitangent is rebuilt in the shader as cross(normal, tangent) * w, only its handedness is kept
+                    LvnVec2 e = lvn::octahedralEncode(vertex.tangent);
+                    float handedness = lvn::dot(lvn::cross(vertex.normal, vertex.tangent), vertex.bitangent) < 0.0f ? -1.0f : 1.0f;
+                    uint32_t tangent = lvn::packSnorm2101010(e.x, e.y, 0.0f, handedness);
+                    memcpy(ptr, &tangent, sizeof(uint32_t));
+                    break;
+                }
+                case Lvn_AttributeFormat_Vec4_ui8:
+                {
+                    for (uint32_t k = 0; k < 4; k++)
+                    {
+                        float joint = vertex.joints[k];
+                        if (joint > 255.0f) jointsOutOfRange++;
+                        ptr[k] = static_cast<uint8_t>(lvn::clamp(joint, 0.0f, 255.0f));
+                    }
+                    break;
+                }
+                case Lvn_AttributeFormat_Vec4_un16:
+                {
+                    uint16_t weights[4];
+                    for (uint32_t k = 0; k < 4; k++)
+                        weights[k] = static_cast<uint16_t>(roundf(lvn::clamp(vertex.weights[k], 0.0f, 1.0f) * 65535.0f));
+                    memcpy(ptr, weights, sizeof(weights));
+                    break;
+                }
+
+                default: { break; }
+            }
+        }
+    }
+
+    if (jointsOutOfRange > 0)
+        LVN_CORE_ERROR("vertexLayoutPack(const LvnVertexLayout&, const LvnVertex*, uint64_t, void*) | %llu joint indices are above 255 and were clamped, quantized layouts store joints as 8 bit indices", static_cast<unsigned long long>(jointsOutOfRange));
+}
+
+void pipelineSpecificationSetConfig(LvnPipelineSpecification* pipelineSpecification)
+{
+    LVN_CORE_ASSERT(pipelineSpecification != nullptr, "pipeline specification points to nullptr when setting pipeline specification config");
+    LvnContext* lvnctx = lvn::getContext();
+    lvnctx->defaultPipelineSpecification = *pipelineSpecification;
+}
+
+LvnPipelineSpecification configPipelineSpecificationInit()
+{
+    LvnContext* lvnctx = lvn::getContext();
+    return lvnctx->defaultPipelineSpecification;
+}
+
+void bufferUpdateData(LvnBuffer* buffer, void* data, uint64_t size, uint64_t offset)
+{
+    if (buffer->usage == Lvn_BufferUsage_Static)
+    {
+        LVN_CORE_ERROR("[opengl] cannot change data of buffer that has static buffer usage set Lvn_BufferUsage_Static, buffer: (%p)", buffer);
+        return;
+    }
+
+    LvnContext* lvnctx = lvn::getContext();
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_BufferUploads, 1);
+    lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_BufferUploadBytes, size);
+    lvnctx->graphicsContext.bufferUpdateData(buffer, data, size, offset);
+}
+
+void bufferResize(LvnBuffer* buffer, uint64_t size)
+{
+    if (buffer->usage != Lvn_BufferUsage_Resize)
+    {
+        LVN_CORE_ERROR("[opengl] cannot change data of buffer that does not have resize buffer usage set Lvn_BufferUsage_Resize, buffer: (%p)", buffer);
+        return;
+    }
+
+    lvn::getContext()->graphicsContext.bufferResize(buffer, size);
+}
+
+void* bufferGetMappedData(LvnBuffer* buffer)
+{
+    if (buffer->usage != Lvn_BufferUsage_DynamicRing)
+        return nullptr;
+
+    return lvn::getContext()->graphicsContext.bufferGetMappedData(buffer);
+}
+
+void* bufferMap(LvnBuffer* buffer)
+{
+    if (buffer->usage == Lvn_BufferUsage_Static)
+    {
+        LVN_CORE_ERROR("bufferMap(LvnBuffer*) | cannot map buffer (%p) that has static buffer usage set Lvn_BufferUsage_Static", buffer);
+        return nullptr;
+    }
+
+    if (buffer->mappedData)
+        return buffer->mappedData;
+
+    buffer->mappedData = lvn::getContext()->graphicsContext.bufferMap(buffer);
+    buffer->dirtyBegin = buffer->dirtyEnd = 0;
+    return buffer->mappedData;
+}
+
+void bufferMarkRange(LvnBuffer* buffer, uint64_t offset, uint64_t size)
+{
+    if (!buffer->mappedData)
+    {
+        LVN_CORE_ERROR("bufferMarkRange(LvnBuffer*, uint64_t, uint64_t) | buffer (%p) is not mapped, call bufferMap before marking written ranges", buffer);
+        return;
+    }
+
+    if (offset + size > buffer->size)
+    {
+        LVN_CORE_ERROR("bufferMarkRange(LvnBuffer*, uint64_t, uint64_t) | range (offset:%llu,size:%llu) is out of bounds of buffer (%p), size: %llu", offset, size, buffer, buffer->size);
+        return;
+    }
+
+    if (size == 0)
+        return;
+
+    if (buffer->dirtyBegin == buffer->dirtyEnd)
+    {
+        buffer->dirtyBegin = offset;
+        buffer->dirtyEnd = offset + size;
+        return;
+    }
+
+    // the staging region of a device local buffer still holds data of an older frame, so the gap between disjoint ranges cannot be copied and the previous range is flushed on its own
+    if (buffer->usage == Lvn_BufferUsage_DynamicDeviceLocal && (offset > buffer->dirtyEnd || offset + size < buffer->dirtyBegin))
+    {
+        LvnContext* lvnctx = lvn::getContext();
+        lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_BufferUploads, 1);
+        lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_BufferUploadBytes, buffer->dirtyEnd - buffer->dirtyBegin);
+        lvnctx->graphicsContext.bufferFlushRange(buffer, buffer->dirtyBegin, buffer->dirtyEnd - buffer->dirtyBegin);
+
+        buffer->dirtyBegin = offset;
+        buffer->dirtyEnd = offset + size;
+        return;
+    }
+
+    buffer->dirtyBegin = lvn::min(buffer->dirtyBegin, offset);
+    buffer->dirtyEnd = lvn::max(buffer->dirtyEnd, offset + size);
+}
+
+void bufferUnmapRange(LvnBuffer* buffer, uint64_t offset, uint64_t size)
+{
+    if (!buffer->mappedData)
+    {
+        LVN_CORE_ERROR("bufferUnmapRange(LvnBuffer*, uint64_t, uint64_t) | buffer (%p) is not mapped, call bufferMap before unmapping", buffer);
+        return;
+    }
+
+    lvn::bufferMarkRange(buffer, offset, size);
+
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (buffer->dirtyBegin != buffer->dirtyEnd)
+    {
+        lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_BufferUploads, 1);
+        lvn::frameStatsAdd(lvnctx, Lvn_FrameStat_BufferUploadBytes, buffer->dirtyEnd - buffer->dirtyBegin);
+        lvnctx->graphicsContext.bufferFlushRange(buffer, buffer->dirtyBegin, buffer->dirtyEnd - buffer->dirtyBegin);
+    }
+
+    lvnctx->graphicsContext.bufferUnmap(buffer);
+    buffer->mappedData = nullptr;
+    buffer->dirtyBegin = buffer->dirtyEnd = 0;
+}
+
+LvnResult textureUpdateData(LvnTexture* texture, const void* pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    if (texture->compression != Lvn_TextureCompression_None || texture->channels == 0)
+    {
+        LVN_CORE_ERROR("cannot update data of texture (%p), only uncompressed textures created from image data can be updated", texture);
+        return Lvn_Result_Failure;
+    }
+
+    if (x + width > texture->width || y + height > texture->height)
+    {
+        LVN_CORE_ERROR("texture update region (x:%u,y:%u,w:%u,h:%u) is out of bounds of texture (%p), (w:%u,h:%u)", x, y, width, height, texture, texture->width, texture->height);
+        return Lvn_Result_Failure;
+    }
+
+    if (width == 0 || height == 0)
+        return Lvn_Result_Success;
+
+    return lvn::getContext()->graphicsContext.textureUpdateData(texture, pixels, x, y, width, height);
+}
+
+static bool isCompressedImageFile(const uint8_t* data, uint64_t length)
+{
+    static const uint8_t ktx2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+    return (length >= sizeof(ktx2Identifier) && memcmp(data, ktx2Identifier, sizeof(ktx2Identifier)) == 0)
+        || (length >= 4 && memcmp(data, "DDS ", 4) == 0);
+}
+
+// halves an uncompressed image with a 2x2 box filter, the last row or column is repeated for odd sizes
+static LvnImageData imageHalfSize(const LvnImageData& imageData)
+{
+    uint32_t width = lvn::max(imageData.width / 2, 1u);
+    uint32_t height = lvn::max(imageData.height / 2, 1u);
+    uint32_t channels = imageData.channels;
+
+    LvnData<uint8_t> pixels((size_t)width * height * channels);
+    const uint8_t* src = imageData.pixels.data();
+    uint8_t* dst = pixels.data();
+    size_t srcStride = (size_t)imageData.width * channels;
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const uint8_t* row0 = src + lvn::min(y * 2, imageData.height - 1) * srcStride;
+        const uint8_t* row1 = src + lvn::min(y * 2 + 1, imageData.height - 1) * srcStride;
+
+        for (uint32_t x = 0; x < width; x++)
+        {
+            size_t x0 = (size_t)lvn::min(x * 2, imageData.width - 1) * channels;
+            size_t x1 = (size_t)lvn::min(x * 2 + 1, imageData.width - 1) * channels;
+
+            for (uint32_t c = 0; c < channels; c++)
+                *dst++ = (uint8_t)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+        }
+    }
+
+    LvnImageData halfImage{};
+    halfImage.width = width;
+    halfImage.height = height;
+    halfImage.channels = channels;
+    halfImage.size = pixels.size();
+    halfImage.pixels = lvn::move(pixels);
+
+    return halfImage;
+}
+
+static void textureStreamDecodeJob(void* userData)
+{
+    LvnTextureStream* stream = static_cast<LvnTextureStream*>(userData);
+
+    LvnBin file;
+    const uint8_t* data = stream->data.data();
+    uint64_t size = stream->data.size();
+    if (stream->data.empty())
+    {
+        if (!lvn::vfsReadFile(stream->filepath.c_str(), &file))
+            file = lvn::loadFileMapped(stream->filepath.c_str());
+        data = file.data();
+        size = file.size();
+    }
+
+    if (size > 0 && lvn::isCompressedImageFile(data, size))
+    {
+        stream->image = lvn::loadImageDataCompressedMemory(data, size, &stream->mipLevels);
+
+        // the largest mip level stored in the file that fits the preview size
+        for (uint32_t i = 0; stream->previewSize > 0 && i < stream->mipLevels.size(); i++)
+        {
+            if (lvn::max(stream->mipLevels[i].width, stream->mipLevels[i].height) <= stream->previewSize)
+            {
+                stream->previewMip = i + 1;
+                break;
+            }
+        }
+    }
+    else if (size > 0)
+    {
+        stream->image = lvn::loadImageDataMemoryThread(data, static_cast<int>(size), 4, false);
+
+        if (stream->image.pixels.size() > 0 && stream->previewSize > 0 && lvn::max(stream->image.width, stream->image.height) > stream->previewSize)
+        {
+            LvnImageData preview = lvn::imageHalfSize(stream->image);
+            while (lvn::max(preview.width, preview.height) > stream->previewSize)
+                preview = lvn::imageHalfSize(preview);
+
+            stream->preview = lvn::move(preview);
+        }
+    }
+
+    stream->data = LvnVector<uint8_t>();
+    stream->failed = stream->image.pixels.size() == 0;
+
+    if (stream->failed)
+        LVN_CORE_ERROR("texture stream (%p) failed to decode the image data, the stream keeps its placeholder texture", stream);
+}
+
+// bytes uploaded for a level including its mip levels, generated mip chains add about a third
+static uint64_t textureStreamLevelSize(const LvnTextureStream* stream, LvnTextureStreamLevel level)
+{
+    if (stream->image.compression != Lvn_TextureCompression_None)
+    {
+        uint32_t first = level == Lvn_TextureStreamLevel_Preview ? stream->previewMip : 0;
+        uint64_t size = first == 0 ? stream->image.pixels.size() : stream->mipLevels[first - 1].pixels.size();
+        for (uint32_t i = first; stream->mipmaps && i < stream->mipLevels.size(); i++)
+            size += stream->mipLevels[i].pixels.size();
+        return size;
+    }
+
+    uint64_t size = level == Lvn_TextureStreamLevel_Preview ? stream->preview.pixels.size() : stream->image.pixels.size();
+    return stream->mipmaps ? size + size / 3 : size;
+}
+
+static LvnResult textureStreamUpload(LvnTextureStream* stream, LvnTextureStreamLevel level)
+{
+    LvnTextureCreateInfo createInfo = stream->textureInfo;
+    createInfo.mipLevels = 1;
+    createInfo.pMipImageData = nullptr;
+
+    if (stream->image.compression != Lvn_TextureCompression_None)
+    {
+        // compressed levels are uploaded with the mip levels that follow them in the file
+        uint32_t first = level == Lvn_TextureStreamLevel_Preview ? stream->previewMip : 0;
+        createInfo.imageData = lvn::imageGetView(first == 0 ? stream->image : stream->mipLevels[first - 1]);
+        if (stream->mipmaps)
+        {
+            createInfo.mipLevels = stream->mipLevels.size() + 1 - first;
+            createInfo.pMipImageData = stream->mipLevels.data() + first;
+        }
+    }
+    else
+    {
+        createInfo.imageData = lvn::imageGetView(level == Lvn_TextureStreamLevel_Preview ? stream->preview : stream->image);
+        if (stream->mipmaps)
+            createInfo.mipLevels = lvn::imageGetMipLevelCount(createInfo.imageData.width, createInfo.imageData.height);
+    }
+
+    LvnTexture* texture;
+    if (lvn::createTexture(&texture, &createInfo) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    // the previous level is destroyed once the frames using it retire
+    lvn::destroyTexture(stream->texture);
+    stream->texture = texture;
+    stream->level = level;
+
+    if (level == Lvn_TextureStreamLevel_Full)
+    {
+        stream->image = LvnImageData{};
+        stream->preview = LvnImageData{};
+        stream->mipLevels = LvnVector<LvnImageData>();
+    }
+
+    return Lvn_Result_Success;
+}
+
+LvnTextureStreamCreateInfo configTextureStreamInit(const char* filepath)
+{
+    LvnTextureStreamCreateInfo createInfo{};
+    createInfo.filepath = filepath;
+    createInfo.format = Lvn_TextureFormat_Unorm;
+    createInfo.minFilter = Lvn_TextureFilter_Linear;
+    createInfo.magFilter = Lvn_TextureFilter_Linear;
+    createInfo.wrapS = Lvn_TextureMode_Repeat;
+    createInfo.wrapT = Lvn_TextureMode_Repeat;
+    createInfo.mipmaps = true;
+    createInfo.previewSize = 64;
+    createInfo.placeholder[0] = 128;
+    createInfo.placeholder[1] = 128;
+    createInfo.placeholder[2] = 128;
+    createInfo.placeholder[3] = 255;
+
+    return createInfo;
+}
+
+uint64_t textureStreamUpdate(LvnTextureStream** pTextureStreams, uint32_t textureStreamCount, uint64_t budget)
+{
+    uint64_t uploaded = 0;
+
+    // every decoded stream gets its preview before any full image takes the budget
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        LvnTextureStreamLevel level = pass == 0 ? Lvn_TextureStreamLevel_Preview : Lvn_TextureStreamLevel_Full;
+
+        for (uint32_t i = 0; i < textureStreamCount; i++)
+        {
+            LvnTextureStream* stream = pTextureStreams[i];
+            if (stream->level >= level || stream->counter.count.load(std::memory_order_acquire) > 0 || stream->failed)
+                continue;
+
+            if (level == Lvn_TextureStreamLevel_Preview && stream->preview.pixels.size() == 0 && stream->previewMip == 0)
+                continue;
+
+            // a level larger than the budget is still uploaded when nothing else was, so it cannot be starved
+            uint64_t size = lvn::textureStreamLevelSize(stream, level);
+            if (uploaded > 0 && uploaded + size > budget)
+                continue;
+
+            if (lvn::textureStreamUpload(stream, level) != Lvn_Result_Success)
+            {
+                LVN_CORE_ERROR("texture stream (%p) failed to create the texture of level %u, the stream keeps its current texture", stream, level);
+                stream->failed = true;
+                continue;
+            }
+
+            uploaded += size;
+        }
+    }
+
+    return uploaded;
+}
+
+LvnTexture* textureStreamGetTexture(LvnTextureStream* textureStream)
+{
+    return textureStream->texture;
+}
+
+LvnTextureStreamLevel textureStreamGetLevel(LvnTextureStream* textureStream)
+{
+    return textureStream->level;
+}
+
+bool textureStreamIsDone(LvnTextureStream* textureStream)
+{
+    return textureStream->level == Lvn_TextureStreamLevel_Full || (textureStream->counter.count.load(std::memory_order_acquire) == 0 && textureStream->failed);
+}
+
+LvnTextureAtlasCreateInfo configTextureAtlasInit()
+{
+    LvnTextureAtlasCreateInfo createInfo{};
+    createInfo.pageWidth = 2048;
+    createInfo.pageHeight = 2048;
+    createInfo.maxPages = 0;
+    createInfo.padding = 2;
+    createInfo.mipLevels = 1;
+    createInfo.format = Lvn_TextureFormat_Unorm;
+    createInfo.minFilter = Lvn_TextureFilter_Linear;
+    createInfo.magFilter = Lvn_TextureFilter_Linear;
+
+    return createInfo;
+}
+
+// copies the image into the page as rgba with its edge texels repeated over the padding
+static void textureAtlasBlitImage(LvnTextureAtlas* atlas, LvnTextureAtlasPage& page, const LvnImageData& imageData, uint32_t x, uint32_t y)
+{
+    uint32_t padding = atlas->padding;
+    uint32_t channels = imageData.channels;
+    const uint8_t* src = imageData.pixels.data();
+
+    for (uint32_t row = 0; row < imageData.height + padding * 2; row++)
+    {
+        uint32_t srcRow = lvn::min(row > padding ? row - padding : 0, imageData.height - 1);
+        const uint8_t* srcLine = src + (size_t)srcRow * imageData.width * channels;
+        uint8_t* dst = &page.pixels[((size_t)(y + row) * atlas->pageWidth + x) * 4];
+
+        for (uint32_t col = 0; col < imageData.width + padding * 2; col++, dst += 4)
+        {
+            const uint8_t* texel = srcLine + (size_t)lvn::min(col > padding ? col - padding : 0, imageData.width - 1) * channels;
+            switch (channels)
+            {
+                case 1: { dst[0] = dst[1] = dst[2] = texel[0]; dst[3] = 255; break; }
+                case 2: { dst[0] = dst[1] = dst[2] = texel[0]; dst[3] = texel[1]; break; }
+                case 3: { dst[0] = texel[0]; dst[1] = texel[1]; dst[2] = texel[2]; dst[3] = 255; break; }
+                default: { memcpy(dst, texel, 4); break; }
+            }
+        }
+    }
+}
+
+LvnResult textureAtlasAdd(LvnTextureAtlas* textureAtlas, const LvnImageData& imageData, uint32_t* pRegion)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+
+    if (imageData.compression != Lvn_TextureCompression_None || imageData.channels == 0 || imageData.channels > 4 || imageData.width == 0 || imageData.height == 0)
+    {
+        LVN_CORE_ERROR("textureAtlasAdd(LvnTextureAtlas*, const LvnImageData&, uint32_t*) | only uncompressed images with 1 to 4 channels can be added to an atlas");
+        return Lvn_Result_Failure;
+    }
+
+    // rounding the rect up keeps every rect on the alignment since the skyline only ever adds rect sizes
+    uint32_t alignMask = textureAtlas->alignment - 1;
+    uint32_t rectWidth = (imageData.width + textureAtlas->padding * 2 + alignMask) & ~alignMask;
+    uint32_t rectHeight = (imageData.height + textureAtlas->padding * 2 + alignMask) & ~alignMask;
+
+    if (rectWidth > textureAtlas->pageWidth || rectHeight > textureAtlas->pageHeight)
+    {
+        LVN_CORE_ERROR("textureAtlasAdd(LvnTextureAtlas*, const LvnImageData&, uint32_t*) | image with size (w:%u,h:%u) and padding does not fit in the atlas page size (w:%u,h:%u)", imageData.width, imageData.height, textureAtlas->pageWidth, textureAtlas->pageHeight);
+        return Lvn_Result_Failure;
+    }
+
+    LvnLockGaurd lock(textureAtlas->mutex);
+
+    uint32_t x = 0, y = 0;
+    uint32_t pageIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < textureAtlas->pages.size(); i++)
+    {
+        LvnTextureAtlasPage& page = textureAtlas->pages[i];
+        if (!page.closed && lvn::skylinePackRect(page.skyline, textureAtlas->pageWidth, textureAtlas->pageHeight, rectWidth, rectHeight, &x, &y))
+        {
+            pageIndex = i;
+            break;
+        }
+    }
+
+    if (pageIndex == UINT32_MAX)
+    {
+        if (textureAtlas->maxPages != 0 && textureAtlas->pages.size() >= textureAtlas->maxPages)
+        {
+            LVN_CORE_ERROR("textureAtlasAdd(LvnTextureAtlas*, const LvnImageData&, uint32_t*) | every page of texture atlas (%p) is full, max pages: %u", textureAtlas, textureAtlas->maxPages);
+            return Lvn_Result_Failure;
+        }
+
+        textureAtlas->pages.push_back({});
+        LvnTextureAtlasPage& page = textureAtlas->pages.back();
+        page.pixels.resize((size_t)textureAtlas->pageWidth * textureAtlas->pageHeight * 4, 0);
+        page.skyline.push_back({ 0, 0, textureAtlas->pageWidth });
+        page.texture = nullptr;
+        page.closed = false;
+        page.dirtyX0 = textureAtlas->pageWidth;
+        page.dirtyY0 = textureAtlas->pageHeight;
+        page.dirtyX1 = 0;
+        page.dirtyY1 = 0;
+
+        pageIndex = textureAtlas->pages.size() - 1;
+        bool packed = lvn::skylinePackRect(page.skyline, textureAtlas->pageWidth, textureAtlas->pageHeight, rectWidth, rectHeight, &x, &y);
+        LVN_CORE_ASSERT(packed, "image must fit into an empty texture atlas page");
+        (void)packed;
+    }
+
+    LvnTextureAtlasPage& page = textureAtlas->pages[pageIndex];
+    lvn::textureAtlasBlitImage(textureAtlas, page, imageData, x, y);
+
+    page.dirtyX0 = lvn::min(page.dirtyX0, x);
+    page.dirtyY0 = lvn::min(page.dirtyY0, y);
+    page.dirtyX1 = lvn::max(page.dirtyX1, x + imageData.width + textureAtlas->padding * 2);
+    page.dirtyY1 = lvn::max(page.dirtyY1, y + imageData.height + textureAtlas->padding * 2);
+
+    LvnTextureAtlasRegion region{};
+    region.page = pageIndex;
+    region.x = x + textureAtlas->padding;
+    region.y = y + textureAtlas->padding;
+    region.width = imageData.width;
+    region.height = imageData.height;
+    region.u0 = (float)region.x / textureAtlas->pageWidth;
+    region.v0 = (float)region.y / textureAtlas->pageHeight;
+    region.u1 = (float)(region.x + region.width) / textureAtlas->pageWidth;
+    region.v1 = (float)(region.y + region.height) / textureAtlas->pageHeight;
+
+    *pRegion = textureAtlas->regions.size();
+    textureAtlas->regions.push_back(region);
+    return Lvn_Result_Success;
+}
+
+void textureAtlasUpdate(LvnTextureAtlas* textureAtlas)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Graphics);
+    LvnLockGaurd lock(textureAtlas->mutex);
+
+    for (uint32_t i = 0; i < textureAtlas->pages.size(); i++)
+    {
+        LvnTextureAtlasPage& page = textureAtlas->pages[i];
+        if (page.dirtyX1 == 0)
+            continue;
+
+        if (page.texture == nullptr)
+        {
+            LvnTextureCreateInfo textureCreateInfo{};
+            textureCreateInfo.imageData.width = textureAtlas->pageWidth;
+            textureCreateInfo.imageData.height = textureAtlas->pageHeight;
+            textureCreateInfo.imageData.channels = 4;
+            textureCreateInfo.imageData.size = page.pixels.size();
+            textureCreateInfo.imageData.pixels = LvnData<uint8_t>::view(page.pixels.data(), page.pixels.size());
+            textureCreateInfo.format = textureAtlas->format;
+            textureCreateInfo.minFilter = textureAtlas->minFilter;
+            textureCreateInfo.magFilter = textureAtlas->magFilter;
+            textureCreateInfo.wrapS = Lvn_TextureMode_ClampToEdge;
+            textureCreateInfo.wrapT = Lvn_TextureMode_ClampToEdge;
+            textureCreateInfo.mipLevels = textureAtlas->mipLevels;
+
+            if (lvn::createTexture(&page.texture, &textureCreateInfo) != Lvn_Result_Success)
+            {
+                LVN_CORE_ERROR("failed to create texture for page (%u) of texture atlas (%p)", i, textureAtlas);
+                page.texture = nullptr;
+                continue;
+            }
+
+            // the mip levels were generated from the page as it is now and cannot be updated later
+            page.closed = textureAtlas->mipLevels > 1;
+        }
+        else
+        {
+            // only the rows and columns written since the last update are uploaded
+            uint32_t regionWidth = page.dirtyX1 - page.dirtyX0;
+            uint32_t regionHeight = page.dirtyY1 - page.dirtyY0;
+            size_t rowSize = (size_t)regionWidth * 4;
+
+            textureAtlas->uploadScratch.resize(rowSize * regionHeight);
+            for (uint32_t row = 0; row < regionHeight; row++)
+                memcpy(&textureAtlas->uploadScratch[row * rowSize], &page.pixels[((size_t)(page.dirtyY0 + row) * textureAtlas->pageWidth + page.dirtyX0) * 4], rowSize);
+
+            if (lvn::textureUpdateData(page.texture, textureAtlas->uploadScratch.data(), page.dirtyX0, page.dirtyY0, regionWidth, regionHeight) != Lvn_Result_Success)
+            {
+                LVN_CORE_ERROR("failed to update texture for page (%u) of texture atlas (%p)", i, textureAtlas);
+                continue;
+            }
+        }
+
+        page.dirtyX0 = textureAtlas->pageWidth;
+        page.dirtyY0 = textureAtlas->pageHeight;
+        page.dirtyX1 = 0;
+        page.dirtyY1 = 0;
+    }
+}
+
+LvnTextureAtlasRegion textureAtlasGetRegion(LvnTextureAtlas* textureAtlas, uint32_t region)
+{
+    LvnLockGaurd lock(textureAtlas->mutex);
+    LVN_CORE_ASSERT(region < textureAtlas->regions.size(), "region index (%u) out of range of texture atlas (%p)", region, textureAtlas);
+    return textureAtlas->regions[region];
+}
+
+LvnTexture* textureAtlasGetPageTexture(LvnTextureAtlas* textureAtlas, uint32_t pageIndex)
+{
+    LvnLockGaurd lock(textureAtlas->mutex);
+    return pageIndex < textureAtlas->pages.size() ? textureAtlas->pages[pageIndex].texture : nullptr;
+}
+
+uint32_t textureAtlasGetPageCount(LvnTextureAtlas* textureAtlas)
+{
+    LvnLockGaurd lock(textureAtlas->mutex);
+    return textureAtlas->pages.size();
+}
+
+LvnTexture* cubemapGetTextureData(LvnCubemap* cubemap)
+{
+    return &cubemap->textureData;
+}
+
+LvnTexture* environmentMapGetCubemap(LvnEnvironmentMap* environmentMap)
+{
+    return &environmentMap->cubemap;
+}
+
+LvnTexture* environmentMapGetIrradiance(LvnEnvironmentMap* environmentMap)
+{
+    return &environmentMap->irradiance;
+}
+
+LvnTexture* environmentMapGetPrefilter(LvnEnvironmentMap* environmentMap)
+{
+    return &environmentMap->prefilter;
+}
+
+LvnTexture* environmentMapGetBrdfLut(LvnEnvironmentMap* environmentMap)
+{
+    return &environmentMap->brdfLut;
+}
+
+uint32_t lightClustersUpdate(LvnLightClusters* lightClusters, const LvnMat4& view, const LvnCamera& camera, const LvnVec4* pLights, uint32_t lightCount)
+{
+    uint8_t* mapped = static_cast<uint8_t*>(lvn::bufferMap(lightClusters->buffer));
+    if (!mapped)
+        return 0;
+
+    uint32_t tilesX = lightClusters->tilesX, tilesY = lightClusters->tilesY, slices = lightClusters->slices;
+    uint32_t clusterCount = tilesX * tilesY * slices;
+
+    LvnLightClustersHeader header{};
+    header.tilesX = tilesX;
+    header.tilesY = tilesY;
+    header.slices = slices;
+    header.zNear = camera.zNear;
+    header.zFar = camera.zFar;
+    header.sliceScale = (float)slices / logf(camera.zFar / camera.zNear);
+    header.sliceBias = -(float)slices * logf(camera.zNear) / logf(camera.zFar / camera.zNear);
+    header.projY = 1.0f / tanf(camera.fov * 0.5f);
+    header.projX = header.projY / camera.aspectRatio;
+
+    LvnVector<LvnLightClusterRange>& ranges = lightClusters->ranges;
+    LvnVector<uint32_t>& counts = lightClusters->counts;
+    ranges.resize(lightCount);
+    memset(counts.data(), 0, counts.size() * sizeof(uint32_t));
+
+    // the tiles of a light are the screen rect of its view space box, projected at the depth that makes each edge widest
+    for (uint32_t i = 0; i < lightCount; i++)
+    {
+        LvnVec4 center = view * LvnVec4(pLights[i].x, pLights[i].y, pLights[i].z, 1.0f);
+        float radius = pLights[i].w;
+        float depthMin = -center.z - radius, depthMax = -center.z + radius;
+
+        LvnLightClusterRange& range = ranges[i];
+        if (depthMax < camera.zNear || depthMin > camera.zFar)
+        {
+            range.z0 = 1; range.z1 = 0; // empty, the light is in front of or behind the clusters
+            continue;
+        }
+
+        depthMin = lvn::max(depthMin, camera.zNear);
+        depthMax = lvn::min(depthMax, camera.zFar);
+
+        float ndc[2][2];
+        float scales[2] = { header.projX, header.projY };
+        for (uint32_t axis = 0; axis < 2; axis++)
+        {
+            float lo = center[axis] - radius, hi = center[axis] + radius;
+            ndc[axis][0] = (lo < 0.0f ? lo / depthMin : lo / depthMax) * scales[axis];
+            ndc[axis][1] = (hi > 0.0f ? hi / depthMin : hi / depthMax) * scales[axis];
+        }
+
+        if (ndc[0][0] > 1.0f || ndc[0][1] < -1.0f || ndc[1][0] > 1.0f || ndc[1][1] < -1.0f)
+        {
+            range.z0 = 1; range.z1 = 0; // outside the sides of the frustum
+            continue;
+        }
+
+        range.x0 = (uint32_t)lvn::clamp((ndc[0][0] * 0.5f + 0.5f) * tilesX, 0.0f, (float)(tilesX - 1));
+        range.x1 = (uint32_t)lvn::clamp((ndc[0][1] * 0.5f + 0.5f) * tilesX, 0.0f, (float)(tilesX - 1));
+        range.y0 = (uint32_t)lvn::clamp((ndc[1][0] * 0.5f + 0.5f) * tilesY, 0.0f, (float)(tilesY - 1));
+        range.y1 = (uint32_t)lvn::clamp((ndc[1][1] * 0.5f + 0.5f) * tilesY, 0.0f, (float)(tilesY - 1));
+        range.z0 = (uint32_t)lvn::clamp(logf(depthMin) * header.sliceScale + header.sliceBias, 0.0f, (float)(slices - 1));
+        range.z1 = (uint32_t)lvn::clamp(logf(depthMax) * header.sliceScale + header.sliceBias, 0.0f, (float)(slices - 1));
+
+        for (uint32_t z = range.z0; z <= range.z1; z++)
+            for (uint32_t y = range.y0; y <= range.y1; y++)
+                for (uint32_t x = range.x0; x <= range.x1; x++)
+                    counts[(z * tilesY + y) * tilesX + x]++;
+    }
+
+    // offsets are a prefix sum of the counts, clusters past the capacity keep only the lights that fit
+    uint32_t* clusterData = reinterpret_cast<uint32_t*>(mapped + sizeof(LvnLightClustersHeader));
+    uint32_t* indices = clusterData + clusterCount * 2;
+    uint32_t indexCount = 0;
+    uint64_t requestedCount = 0;
+    for (uint32_t i = 0; i < clusterCount; i++)
+    {
+        uint32_t count = lvn::min(counts[i], lightClusters->maxLightIndices - indexCount);
+        clusterData[i * 2] = indexCount;
+        clusterData[i * 2 + 1] = count;
+        indexCount += count;
+        requestedCount += counts[i];
+        counts[i] = 0;
+    }
+
+    if (requestedCount > indexCount)
+        LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_WARN, "lightClustersUpdate(LvnLightClusters*, const LvnMat4&, const LvnCamera&, const LvnVec4*, uint32_t) | light index list of clusters (%p) is full, increase maxLightIndices", lightClusters);
+
+    for (uint32_t i = 0; i < lightCount; i++)
+    {
+        const LvnLightClusterRange& range = ranges[i];
+        for (uint32_t z = range.z0; z <= range.z1; z++)
+            for (uint32_t y = range.y0; y <= range.y1; y++)
+                for (uint32_t x = range.x0; x <= range.x1; x++)
+                {
+                    uint32_t cluster = (z * tilesY + y) * tilesX + x;
+                    if (counts[cluster] < clusterData[cluster * 2 + 1])
+                        indices[clusterData[cluster * 2] + counts[cluster]++] = i;
+                }
+    }
+
+    header.indexCount = indexCount;
+    memcpy(mapped, &header, sizeof(LvnLightClustersHeader));
+
+    lvn::bufferUnmapRange(lightClusters->buffer, 0, sizeof(LvnLightClustersHeader) + ((uint64_t)clusterCount * 2 + indexCount) * sizeof(uint32_t));
+    return indexCount;
+}
+
+LvnBuffer* lightClustersGetBuffer(LvnLightClusters* lightClusters)
+{
+    return lightClusters->buffer;
+}
+
+const char* lightClustersGetShaderSource()
+{
+    return s_LightClustersShaderSrc;
+}
+
+void shadowCacheInvalidate(LvnShadowCache* shadowCache)
+{
+    shadowCache->valid = false;
+}
+
+bool shadowCacheBeginStatic(LvnWindow* window, LvnShadowCache* shadowCache, const LvnMat4& lightMatrix)
+{
+    if (shadowCache->valid && memcmp(&shadowCache->lightMatrix, &lightMatrix, sizeof(LvnMat4)) == 0)
+        return false;
+
+    // a minimized window skips its render passes, keep the layer stale until it can be drawn
+    int width, height;
+    lvn::windowGetSize(window, &width, &height);
+    if (width * height <= 0) { return false; }
+
+    shadowCache->lightMatrix = lightMatrix;
+    shadowCache->valid = true;
+    lvn::renderCmdBeginFrameBuffer(window, shadowCache->staticFrameBuffer);
+    return true;
+}
+
+void shadowCacheEndStatic(LvnWindow* window, LvnShadowCache* shadowCache)
+{
+    lvn::renderCmdEndFrameBuffer(window, shadowCache->staticFrameBuffer);
+}
+
+void shadowCacheBeginDynamic(LvnWindow* window, LvnShadowCache* shadowCache)
+{
+    lvn::renderCmdBeginFrameBuffer(window, shadowCache->dynamicFrameBuffer);
+}
+
+void shadowCacheEndDynamic(LvnWindow* window, LvnShadowCache* shadowCache)
+{
+    lvn::renderCmdEndFrameBuffer(window, shadowCache->dynamicFrameBuffer);
+}
+
+LvnTexture* shadowCacheGetStaticImage(LvnShadowCache* shadowCache)
+{
+    return lvn::frameBufferGetImage(shadowCache->staticFrameBuffer, 0);
+}
+
+LvnTexture* shadowCacheGetDynamicImage(LvnShadowCache* shadowCache)
+{
+    return lvn::frameBufferGetImage(shadowCache->dynamicFrameBuffer, 0);
+}
+
+const LvnMat4& shadowCacheGetLightMatrix(LvnShadowCache* shadowCache)
+{
+    return shadowCache->lightMatrix;
+}
+
+const char* shadowCacheGetShaderSource()
+{
+    return s_ShadowCacheShaderSrc;
+}
+
+// index of the texture in the array of the table, textures are added on first use and null textures use the default texture
+static uint32_t materialTableGetTextureIndex(LvnMaterialTable* materialTable, LvnTexture* texture)
+{
+    if (texture == nullptr)
+        return 0;
+
+    uint64_t key = reinterpret_cast<uint64_t>(texture);
+    if (const uint32_t* index = materialTable->textureIndices.find(key))
+        return *index;
+
+    if (materialTable->textures.size() >= materialTable->maxTextures)
+        return UINT32_MAX;
+
+    uint32_t index = materialTable->textures.size();
+    materialTable->textures.push_back(texture);
+    materialTable->textureIndices.insert(key, index);
+    materialTable->texturesDirty = true;
+    return index;
+}
+
+uint32_t materialTableAdd(LvnMaterialTable* materialTable, const LvnMaterial& material)
+{
+    LvnMaterialTableEntry entry{};
+    entry.baseColorMetallic = LvnVec4(material.baseColorFactor, material.metallicFactor);
+    entry.emissiveRoughness = LvnVec4(material.emissiveFactor, material.roughnessFactor);
+
+    LvnTexture* textures[4] = { material.albedo, material.metallicRoughnessOcclusion, material.normal, material.emissive };
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        entry.textures[i] = lvn::materialTableGetTextureIndex(materialTable, textures[i]);
+        if (entry.textures[i] == UINT32_MAX)
+        {
+            LVN_CORE_ERROR("materialTableAdd(LvnMaterialTable*, const LvnMaterial&) | texture array of material table (%p) is full, max textures: %u", materialTable, materialTable->maxTextures);
+            return UINT32_MAX;
+        }
+    }
+
+    // primitives of loaded models each hold a copy of their material, copies of the same material share one entry
+    for (uint32_t i = 0; i < materialTable->materials.size(); i++)
+    {
+        if (memcmp(&materialTable->materials[i], &entry, sizeof(LvnMaterialTableEntry)) == 0)
+            return i;
+    }
+
+    if (materialTable->materials.size() >= materialTable->maxMaterials)
+    {
+        LVN_CORE_ERROR("materialTableAdd(LvnMaterialTable*, const LvnMaterial&) | material table (%p) is full, max materials: %u", materialTable, materialTable->maxMaterials);
+        return UINT32_MAX;
+    }
+
+    materialTable->materials.push_back(entry);
+    materialTable->materialsDirty = true;
+    return materialTable->materials.size() - 1;
+}
+
+LvnResult materialTableAddModel(LvnMaterialTable* materialTable, LvnModel* model)
+{
+    for (LvnMesh& mesh : model->meshes)
+    {
+        for (LvnPrimitive& primitive : mesh.primitives)
+        {
+            uint32_t materialIndex = lvn::materialTableAdd(materialTable, primitive.material);
+            if (materialIndex == UINT32_MAX)
+                return Lvn_Result_Failure;
+
+            primitive.materialIndex = materialIndex;
+        }
+    }
+
+    return Lvn_Result_Success;
+}
+
+void materialTableUpdate(LvnMaterialTable* materialTable)
+{
+    if (materialTable->materialsDirty)
+    {
+        lvn::bufferUpdateData(materialTable->buffer, materialTable->materials.data(), materialTable->materials.size() * sizeof(LvnMaterialTableEntry), 0);
+        materialTable->materialsDirty = false;
+    }
+
+    if (!materialTable->texturesDirty)
+        return;
+
+    // the whole array is written, slots past the added textures keep the default texture
+    LvnVector<const LvnTexture*> textures(materialTable->maxTextures, materialTable->defaultTexture);
+    for (uint32_t i = 0; i < materialTable->textures.size(); i++)
+        textures[i] = materialTable->textures[i];
+
+    LvnUniformBufferInfo bufferInfo{};
+    bufferInfo.buffer = materialTable->buffer;
+    bufferInfo.range = (uint64_t)materialTable->maxMaterials * sizeof(LvnMaterialTableEntry);
+    bufferInfo.offset = 0;
+
+    LvnDescriptorUpdateInfo descriptorUpdateInfos[2]{};
+    descriptorUpdateInfos[0].binding = LVN_MATERIAL_TABLE_MATERIAL_BINDING;
+    descriptorUpdateInfos[0].descriptorType = Lvn_DescriptorType_StorageBuffer;
+    descriptorUpdateInfos[0].descriptorCount = 1;
+    descriptorUpdateInfos[0].bufferInfo = &bufferInfo;
+
+    descriptorUpdateInfos[1].binding = LVN_MATERIAL_TABLE_TEXTURE_BINDING;
+    descriptorUpdateInfos[1].descriptorType = Lvn_DescriptorType_ImageSamplerBindless;
+    descriptorUpdateInfos[1].descriptorCount = materialTable->maxTextures;
+    descriptorUpdateInfos[1].pTextureInfos = textures.data();
+
+    lvn::updateDescriptorSetData(materialTable->descriptorSet, descriptorUpdateInfos, 2);
+    materialTable->texturesDirty = false;
+}
+
+LvnDescriptorLayout* materialTableGetDescriptorLayout(LvnMaterialTable* materialTable)
+{
+    return materialTable->descriptorLayout;
+}
+
+LvnDescriptorSet* materialTableGetDescriptorSet(LvnMaterialTable* materialTable)
+{
+    return materialTable->descriptorSet;
+}
+
+const char* materialTableGetShaderSource(LvnMaterialTable* materialTable)
+{
+    return materialTable->shaderSrc.c_str();
+}
+
+void updateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count)
+{
+    // TODO: add update error logs
+    lvn::getContext()->graphicsContext.updateDescriptorSetData(descriptorSet, pUpdateInfo, count);
+}
+
+void updateDescriptorSetsData(const LvnDescriptorSetUpdate* pUpdates, uint32_t count)
+{
+    if (count == 0) { return; }
+    lvn::getContext()->graphicsContext.updateDescriptorSetsData(pUpdates, count);
+}
+
+LvnTexture* frameBufferGetImage(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex)
+{
+    return lvn::getContext()->graphicsContext.frameBufferGetImage(frameBuffer, attachmentIndex);
+}
+
+LvnRenderPass* frameBufferGetRenderPass(LvnFrameBuffer* frameBuffer)
+{
+    return lvn::getContext()->graphicsContext.frameBufferGetRenderPass(frameBuffer);
+}
+
+void frameBufferResize(LvnFrameBuffer* frameBuffer, uint32_t width, uint32_t height)
+{
+    if (width * height == 0)
+        return;
+
+    lvn::getContext()->graphicsContext.framebufferResize(frameBuffer, width, height);
+
+    frameBuffer->width = width;
+    frameBuffer->height = height;
+    lvn::frameBufferUpdateRenderSize(frameBuffer);
+}
+
+static void frameBufferUpdateRenderSize(LvnFrameBuffer* frameBuffer)
+{
+    frameBuffer->renderWidth = lvn::clamp<uint32_t>(static_cast<uint32_t>(frameBuffer->width * frameBuffer->renderScale + 0.5f), 1, frameBuffer->width);
+    frameBuffer->renderHeight = lvn::clamp<uint32_t>(static_cast<uint32_t>(frameBuffer->height * frameBuffer->renderScale + 0.5f), 1, frameBuffer->height);
+}
+
+void frameBufferSetRenderScale(LvnFrameBuffer* frameBuffer, float scale)
+{
+    // only the viewport, scissor and render area change, the attachments stay at their full size
+    frameBuffer->renderScale = lvn::clamp(scale, 0.01f, 1.0f);
+    lvn::frameBufferUpdateRenderSize(frameBuffer);
+}
+
+float frameBufferGetRenderScale(LvnFrameBuffer* frameBuffer)
+{
+    return frameBuffer->renderScale;
+}
+
+void frameBufferGetRenderSize(LvnFrameBuffer* frameBuffer, uint32_t* width, uint32_t* height)
+{
+    if (width) { *width = frameBuffer->renderWidth; }
+    if (height) { *height = frameBuffer->renderHeight; }
+}
+
+LvnVec2 frameBufferGetRenderUvScale(LvnFrameBuffer* frameBuffer)
+{
+    return LvnVec2((float)frameBuffer->renderWidth / (float)frameBuffer->width, (float)frameBuffer->renderHeight / (float)frameBuffer->height);
+}
+
+LvnRenderScaleController configRenderScaleControllerInit(float targetGpuTime)
+{
+    LvnRenderScaleController controller{};
+    controller.targetGpuTime = targetGpuTime;
+    controller.minScale = 0.5f;
+    controller.maxScale = 1.0f;
+    controller.headroom = 0.15f;
+    controller.maxIncrease = 0.02f;
+    controller.smoothing = 0.1f;
+    controller.scale = 1.0f;
+    controller.averageGpuTime = 0.0f;
+    return controller;
+}
+
+float renderScaleControllerUpdate(LvnRenderScaleController* controller, float gpuTime)
+{
+    if (gpuTime <= 0.0f)
+        return controller->scale;
+
+    controller->averageGpuTime = controller->averageGpuTime > 0.0f ? controller->averageGpuTime + (gpuTime - controller->averageGpuTime) * controller->smoothing : gpuTime;
+
+    // the scale that would hit the target if the cost follows the pixel count
+    float ideal = controller->scale * sqrtf(controller->targetGpuTime / controller->averageGpuTime);
+
+    if (controller->averageGpuTime > controller->targetGpuTime)
+        controller->scale = ideal;
+    else if (controller->averageGpuTime < controller->targetGpuTime * (1.0f - controller->headroom))
+        controller->scale = lvn::min(ideal, controller->scale + controller->maxIncrease);
+
+    controller->scale = lvn::clamp(controller->scale, controller->minScale, controller->maxScale);
+    return controller->scale;
+}
+
+void frameBufferSetClearColor(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, float r, float g, float b, float a)
+{
+    lvn::getContext()->graphicsContext.frameBufferSetClearColor(frameBuffer, attachmentIndex, r, g, b, a);
+}
+
+LvnResult frameBufferReadPixels(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, void* data, uint64_t size)
+{
+    if (data == nullptr)
+    {
+        LVN_CORE_ERROR("frameBufferReadPixels(LvnFrameBuffer*, uint32_t, void*, uint64_t) | cannot read pixels of framebuffer (%p), data is null", frameBuffer);
+        return Lvn_Result_Failure;
+    }
+
+    return lvn::getContext()->graphicsContext.frameBufferReadPixels(frameBuffer, attachmentIndex, data, size);
+}
+
+LvnDepthImageFormat findSupportedDepthImageFormat(LvnDepthImageFormat* pDepthImageFormats, uint32_t count)
+{
+    if (pDepthImageFormats == nullptr)
+    {
+        LVN_CORE_ERROR("cannot find supported depth image format, no depth image candidates given");
+        return (LvnDepthImageFormat)(0);
+    }
+
+    return lvn::getContext()->graphicsContext.findSupportedDepthImageFormat(pDepthImageFormats, count);
+}
+
+// pixels loaded by stb_image are adopted by the image data instead of copied, they are freed with stbi_image_free
+// image decoders faster than stb for their format, compiled in when CMakeLists.txt finds the library,
+// a decoder returning false hands the image to stb, eg. for channel counts or variants it does not support
+
+#if defined(LVN_IMAGE_DECODER_TURBOJPEG)
+
+static bool isJpegImage(const uint8_t* data, uint64_t length)
+{
+    return length >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+}
+
+static bool turbojpegGetInfo(const uint8_t* data, uint64_t length, uint32_t* width, uint32_t* height, uint32_t* channels)
+{
+    tjhandle handle = tjInitDecompress();
+    if (handle == nullptr) { return false; }
+
+    int imageWidth, imageHeight, subsamp, colorspace;
+    bool read = tjDecompressHeader3(handle, data, static_cast<unsigned long>(length), &imageWidth, &imageHeight, &subsamp, &colorspace) == 0;
+    tjDestroy(handle);
+
+    // cmyk images are left to stb
+    if (!read || colorspace == TJCS_CMYK || colorspace == TJCS_YCCK)
+        return false;
+
+    *width = imageWidth;
+    *height = imageHeight;
+    *channels = colorspace == TJCS_GRAY ? 1 : 3;
+    return true;
+}
+
+static bool turbojpegDecode(const uint8_t* data, uint64_t length, uint8_t* dst, uint32_t width, uint32_t height, uint32_t channels, bool flipVertically)
+{
+    int pixelFormat;
+    switch (channels)
+    {
+        case 1: { pixelFormat = TJPF_GRAY; break; }
+        case 3: { pixelFormat = TJPF_RGB; break; }
+        case 4: { pixelFormat = TJPF_RGBA; break; } // alpha is written as 255
+        default: { return false; }
+    }
+
+    tjhandle handle = tjInitDecompress();
+    if (handle == nullptr) { return false; }
+
+    bool decoded = tjDecompress2(handle, data, static_cast<unsigned long>(length), dst, width, 0, height, pixelFormat, flipVertically ? TJFLAG_BOTTOMUP : 0) == 0;
+    tjDestroy(handle);
+
+    return decoded;
+}
+
+#endif
+
+#if defined(LVN_IMAGE_DECODER_SPNG)
+
+static void flipImageRows(uint8_t* pixels, uint32_t height, size_t rowSize)
+{
+    for (uint32_t y = 0; y < height / 2; y++)
+        lvn::swapMemory(pixels + y * rowSize, pixels + (height - y - 1) * rowSize, rowSize);
+}
+
+static bool isPngImage(const uint8_t* data, uint64_t length)
+{
+    static const uint8_t pngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    return length >= sizeof(pngSignature) && memcmp(data, pngSignature, sizeof(pngSignature)) == 0;
+}
+
+static bool spngGetInfo(const uint8_t* data, uint64_t length, uint32_t* width, uint32_t* height, uint32_t* channels)
+{
+    spng_ctx* ctx = spng_ctx_new(0);
+    if (ctx == nullptr) { return false; }
+
+    struct spng_ihdr ihdr;
+    struct spng_trns trns;
+    bool read = spng_set_png_buffer(ctx, data, length) == 0 && spng_get_ihdr(ctx, &ihdr) == 0;
+    bool hasTrns = read && spng_get_trns(ctx, &trns) == 0;
+    spng_ctx_free(ctx);
+
+    if (!read) { return false; }
+
+    // same channel counts as stb, a transparency chunk adds an alpha channel
+    switch (ihdr.color_type)
+    {
+        case SPNG_COLOR_TYPE_GRAYSCALE: { *channels = hasTrns ? 2 : 1; break; }
+        case SPNG_COLOR_TYPE_GRAYSCALE_ALPHA: { *channels = 2; break; }
+        case SPNG_COLOR_TYPE_TRUECOLOR: { *channels = hasTrns ? 4 : 3; break; }
+        case SPNG_COLOR_TYPE_INDEXED: { *channels = hasTrns ? 4 : 3; break; }
+        case SPNG_COLOR_TYPE_TRUECOLOR_ALPHA: { *channels = 4; break; }
+        default: { return false; }
+    }
+
+    *width = ihdr.width;
+    *height = ihdr.height;
+    return true;
+}
+
+static bool spngDecode(const uint8_t* data, uint64_t length, uint8_t* dst, uint32_t width, uint32_t height, uint32_t channels, bool flipVertically)
+{
+    // gray outputs are only converted by spng for gray images, those are left to stb
+    int format;
+    switch (channels)
+    {
+        case 3: { format = SPNG_FMT_RGB8; break; }
+        case 4: { format = SPNG_FMT_RGBA8; break; }
+        default: { return false; }
+    }
+
+    spng_ctx* ctx = spng_ctx_new(0);
+    if (ctx == nullptr) { return false; }
+
+    size_t size = 0;
+    bool decoded = spng_set_png_buffer(ctx, data, length) == 0
+        && spng_decoded_image_size(ctx, format, &size) == 0
+        && size == (size_t)width * height * channels
+        && spng_decode_image(ctx, dst, size, format, channels == 4 ? SPNG_DECODE_TRNS : 0) == 0;
+    spng_ctx_free(ctx);
+
+    if (decoded && flipVertically)
+        lvn::flipImageRows(dst, height, (size_t)width * channels);
+
+    return decoded;
+}
+
+#endif
+
+#if defined(LVN_IMAGE_DECODERS)
+static const LvnImageDecoder s_ImageDecoders[] =
+{
+#if defined(LVN_IMAGE_DECODER_TURBOJPEG)
+    { lvn::isJpegImage, lvn::turbojpegGetInfo, lvn::turbojpegDecode },
+#endif
+#if defined(LVN_IMAGE_DECODER_SPNG)
+    { lvn::isPngImage, lvn::spngGetInfo, lvn::spngDecode },
+#endif
+};
+
+#endif
+
+static const LvnImageDecoder* findImageDecoder(const uint8_t* data, uint64_t length)
+{
+#if defined(LVN_IMAGE_DECODERS)
+    for (uint32_t i = 0; i < sizeof(s_ImageDecoders) / sizeof(s_ImageDecoders[0]); i++)
+    {
+        if (s_ImageDecoders[i].match(data, length))
+            return &s_ImageDecoders[i];
+    }
+#else
+    (void)data;
+    (void)length;
+#endif
+    return nullptr;
+}
+
+static bool decodeImageData(const uint8_t* data, uint64_t length, int forceChannels, bool flipVertically, LvnImageData* imageData)
+{
+#if defined(LVN_IMAGE_DECODERS)
+    const LvnImageDecoder* decoder = lvn::findImageDecoder(data, length);
+    uint32_t width, height, channels;
+    if (decoder == nullptr || !decoder->getInfo(data, length, &width, &height, &channels))
+        return false;
+
+    if (forceChannels)
+        channels = forceChannels;
+
+    LvnData<uint8_t> pixels((size_t)width * height * channels);
+    if (!decoder->decode(data, length, pixels.data(), width, height, channels, flipVertically))
+        return false;
+
+    imageData->width = width;
+    imageData->height = height;
+    imageData->channels = channels;
+    imageData->size = pixels.size();
+    imageData->pixels = lvn::move(pixels);
+
+    LVN_CORE_TRACE("decoded image data from memory (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes", data, imageData->width, imageData->height, imageData->channels, imageData->size);
+    return true;
+#else
+    (void)data;
+    (void)length;
+    (void)forceChannels;
+    (void)flipVertically;
+    (void)imageData;
+    return false;
+#endif
+}
+
+static void freeStbiImage(void* ptr, void*)
+{
+    stbi_image_free(ptr);
+}
+
+LvnImageData loadImageData(const char* filepath, int forceChannels, bool flipVertically)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Loaders);
+    if (filepath == nullptr)
+    {
+        LVN_CORE_ERROR("loadImageData(const char*, int, bool) | invalid filepath, filepath must not be nullptr");
+        return {};
+    }
+
+    if (forceChannels < 0)
+    {
+        LVN_CORE_ERROR("loadImageData(const char*, int, bool) | forceChannels < 0, channels cannot be negative");
+        return {};
+    }
+    else if (forceChannels > 4)
+    {
+        LVN_CORE_ERROR("loadImageData(const char*, int, bool) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
+        return {};
+    }
+
+    LvnBin packed;
+    if (lvn::vfsReadFile(filepath, &packed))
+        return lvn::loadImageDataMemory(packed.data(), static_cast<int>(packed.size()), forceChannels, flipVertically);
+
+#if defined(LVN_IMAGE_DECODERS)
+    // the decoders read from memory, so the file is mapped and decoded from the mapping
+    LvnBin file = lvn::loadFileMapped(filepath);
+    if (file.size() > 0)
+        return lvn::loadImageDataMemory(file.data(), static_cast<int>(file.size()), forceChannels, flipVertically);
+#endif
+
+    stbi_set_flip_vertically_on_load(flipVertically);
+    int imageWidth, imageHeight, imageChannels;
+    stbi_uc* pixels = stbi_load(filepath, &imageWidth, &imageHeight, &imageChannels, forceChannels);
 
-        i++; // incramant past symbol on next character in format
+    if (!pixels)
+    {
+        LVN_CORE_ERROR("loadImageData(const char*, int, bool) | failed to load image pixel data from file: %s", filepath);
+        return {};
     }
 
-    return patterns;
-}
-
-void logEnable(bool enable)
-{
-    lvn::getContext()->logging = enable;
-}
+    LvnImageData imageData{};
+    imageData.width = imageWidth;
+    imageData.height = imageHeight;
+    imageData.channels = forceChannels ? forceChannels : imageChannels;
+    imageData.size = imageData.width * imageData.height * imageData.channels;
+    imageData.pixels = LvnData<uint8_t>(pixels, imageData.size, lvn::freeStbiImage);
 
-void logEnableCoreLogging(bool enable)
-{
-    lvn::getContext()->enableCoreLogging = enable;
-}
+    LVN_CORE_TRACE("loaded image data <unsigned char*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes, filepath: %s", pixels, imageData.width, imageData.height, imageData.channels, imageData.size, filepath);
 
-void logSetLevel(LvnLogger* logger, LvnLogLevel level)
-{
-    logger->logLevel = level;
+    return imageData;
 }
 
-void logSetFileConfig(LvnLogger* logger, bool enable, const char* filename, LvnFileMode filemode)
+LvnImageData loadImageDataMemory(const uint8_t* data, int length, int forceChannels, bool flipVertically)
 {
-    // if log to file was enabled before, fileptr needs to be closed
-    if (logger->logfile.logToFile)
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Loaders);
+    if (!data)
     {
-        fclose(logger->logfile.fileptr);
-        logger->logfile.fileptr = nullptr;
+        LVN_CORE_ERROR("loadImageDataMemory(const unsigned char*, int, int, bool) | invalid data, image memory data must not be nullptr");
+        return {};
     }
 
-    logger->logfile.logToFile = enable;
-    logger->logfile.filename = filename;
-    logger->logfile.filemode = filemode;
-
-    if (enable)
+    if (forceChannels < 0)
     {
-        if (logger->logfile.filename.empty())
-        {
-            logger->logfile.filename = logger->loggerName + "_logs.txt";
-            LVN_CORE_WARN("logSetFileConfig(LvnLogger*, bool enable, const char* filename, LvnFileMode filemode) | filename not set, setting file name to name of the logger: %s_logs.txt", logger->loggerName.c_str());
-        }
+        LVN_CORE_ERROR("loadImageDataMemory(conts unsigned char*, int, int, bool) | forceChannels < 0, channels cannot be negative");
+        return {};
+    }
+    else if (forceChannels > 4)
+    {
+        LVN_CORE_ERROR("loadImageDataMemory(const unsigned char*, int, int, bool) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
+        return {};
+    }
 
-        const char* filemode = "w";
-        if (logger->logfile.filemode == Lvn_FileMode_Write) filemode = "w";
-        else if (logger->logfile.filemode == Lvn_FileMode_Append) filemode = "a";
+    LvnImageData decoded{};
+    if (lvn::decodeImageData(data, length, forceChannels, flipVertically, &decoded))
+        return decoded;
+
+    stbi_set_flip_vertically_on_load(flipVertically);
+    int imageWidth, imageHeight, imageChannels;
+    stbi_uc* pixels = stbi_load_from_memory(data, length, &imageWidth, &imageHeight, &imageChannels, forceChannels);
 
-        logger->logfile.fileptr = fopen(logger->logfile.filename.c_str(), filemode);
+    if (!pixels)
+    {
+        LVN_CORE_ERROR("loadImageDataMemory(const unsigned char*) | failed to load image pixel data from memory: %p", data);
+        return {};
     }
-}
 
-bool logCheckLevel(LvnLogger* logger, LvnLogLevel level)
-{
-    return (level >= logger->logLevel);
-}
+    LvnImageData imageData{};
+    imageData.width = imageWidth;
+    imageData.height = imageHeight;
+    imageData.channels = forceChannels ? forceChannels : imageChannels;
+    imageData.size = imageData.width * imageData.height * imageData.channels;
+    imageData.pixels = LvnData<uint8_t>(pixels, imageData.size, lvn::freeStbiImage);
 
-void logRenameLogger(LvnLogger* logger, const char* name)
-{
-    logger->loggerName = name;
+    LVN_CORE_TRACE("loaded image data from memory <unsigned char*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes", pixels, imageData.width, imageData.height, imageData.channels, imageData.size);
+
+    return imageData;
 }
 
-void logOutputMessage(LvnLogger* logger, LvnLogMessage* msg)
+LvnImageData loadImageDataThread(const LvnString filepath, int forceChannels, bool flipVertically)
 {
-    if (!lvn::getContext()->logging) { return; }
-
-    LvnString msgstr; msgstr.reserve(strlen(msg->msg) + 1);
+    if (filepath.empty())
+    {
+        LVN_CORE_ERROR("loadImageDataThread(const char*, int, bool) | invalid filepath, filepath is empty string");
+        return {};
+    }
 
-    for (uint32_t i = 0; i < logger->logPatterns.size(); i++)
+    if (forceChannels < 0)
     {
-        if (logger->logPatterns[i].func == nullptr) // no special format character '%' found
-        {
-            msgstr += logger->logPatterns[i].symbol;
-        }
-        else // call func of special format
-        {
-            msgstr += logger->logPatterns[i].func(msg);
-        }
+        LVN_CORE_ERROR("loadImageDataThread(const char*, int, bool) | forceChannels < 0, channels cannot be negative");
+        return {};
+    }
+    else if (forceChannels > 4)
+    {
+        LVN_CORE_ERROR("loadImageDataThread(const char*, int, bool) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
+        return {};
     }
 
-    printf("%s", msgstr.c_str());
-}
+    LvnBin packed;
+    if (lvn::vfsReadFile(filepath.c_str(), &packed))
+        return lvn::loadImageDataMemoryThread(packed.data(), static_cast<int>(packed.size()), forceChannels, flipVertically);
 
-LvnString logFormatMessage(LvnLogger* logger, LvnLogLevel level, const char* msg, bool removeANSI)
-{
-    LvnLogMessage logMsg{};
-    logMsg.msg = msg;
-    logMsg.loggerName = logger->loggerName.c_str();
-    logMsg.level = level;
-    logMsg.timeEpoch = lvn::dateGetSecondsSinceEpoch();
+#if defined(LVN_IMAGE_DECODERS)
+    // the decoders read from memory, so the file is mapped and decoded from the mapping
+    LvnBin file = lvn::loadFileMapped(filepath.c_str());
+    if (file.size() > 0)
+        return lvn::loadImageDataMemoryThread(file.data(), static_cast<int>(file.size()), forceChannels, flipVertically);
+#endif
 
-    LvnString msgstr; msgstr.reserve(strlen(msg) + 1);
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
+    int imageWidth, imageHeight, imageChannels;
+    stbi_uc* pixels = stbi_load(filepath.c_str(), &imageWidth, &imageHeight, &imageChannels, forceChannels);
 
-    for (uint32_t i = 0; i < logger->logPatterns.size(); i++)
+    if (!pixels)
     {
-        if (removeANSI && (logger->logPatterns[i].symbol == '#' || logger->logPatterns[i].symbol == '^'))
-            continue;
-
-        if (logger->logPatterns[i].func == nullptr) // no special format character '%' found
-        {
-            msgstr += logger->logPatterns[i].symbol;
-        }
-        else // call func of special format
-        {
-            msgstr += logger->logPatterns[i].func(&logMsg);
-        }
+        LVN_CORE_ERROR("loadImageDataThread(const char*, int, bool) | failed to load image pixel data from file: %s", filepath.c_str());
+        return {};
     }
 
-    return msgstr;
-}
+    LvnImageData imageData{};
+    imageData.width = imageWidth;
+    imageData.height = imageHeight;
+    imageData.channels = forceChannels ? forceChannels : imageChannels;
+    imageData.size = imageData.width * imageData.height * imageData.channels;
+    imageData.pixels = LvnData<uint8_t>(pixels, imageData.size, lvn::freeStbiImage);
 
-void logMessage(LvnLogger* logger, LvnLogLevel level, const char* msg)
-{
-    if (!lvn::getContext()->logging) { return; }
+    LVN_CORE_TRACE("loaded image data <unsigned char*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes, filepath: %s", pixels, imageData.width, imageData.height, imageData.channels, imageData.size, filepath.c_str());
 
-    LvnLogMessage logMsg{};
-    logMsg.msg = msg;
-    logMsg.loggerName = logger->loggerName.c_str();
-    logMsg.level = level;
-    logMsg.timeEpoch = lvn::dateGetSecondsSinceEpoch();
+    return imageData;
+}
 
-    lvn::logOutputMessage(logger, &logMsg);
+LvnImageData loadImageDataMemoryThread(const uint8_t* data, int length, int forceChannels, bool flipVertically)
+{
+    if (!data)
+    {
+        LVN_CORE_ERROR("loadImageDataMemoryThread(const unsigned char*, int, int, bool) | invalid data, image memory data must not be nullptr");
+        return {};
+    }
 
-    if (logger->logfile.logToFile)
+    if (forceChannels < 0)
+    {
+        LVN_CORE_ERROR("loadImageDataMemoryThread(conts unsigned char*, int, int, bool) | forceChannels < 0, channels cannot be negative");
+        return {};
+    }
+    else if (forceChannels > 4)
     {
-        LvnString msgstr; msgstr.reserve(strlen(msg) + 1);
+        LVN_CORE_ERROR("loadImageDataMemoryThread(const unsigned char*, int, int, bool) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
+        return {};
+    }
 
-        for (uint32_t i = 0; i < logger->logPatterns.size(); i++)
-        {
-            if (logger->logPatterns[i].symbol == '#' || logger->logPatterns[i].symbol == '^')
-                continue;
+    LvnImageData decoded{};
+    if (lvn::decodeImageData(data, length, forceChannels, flipVertically, &decoded))
+        return decoded;
 
-            if (logger->logPatterns[i].func == nullptr) // no special format character '%' found
-            {
-                msgstr += logger->logPatterns[i].symbol;
-            }
-            else // call func of special format
-            {
-                msgstr += logger->logPatterns[i].func(&logMsg);
-            }
-        }
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
+    int imageWidth, imageHeight, imageChannels;
+    stbi_uc* pixels = stbi_load_from_memory(data, length, &imageWidth, &imageHeight, &imageChannels, forceChannels);
 
-        fprintf(logger->logfile.fileptr, "%s", msgstr.c_str());
+    if (!pixels)
+    {
+        LVN_CORE_ERROR("loadImageDataMemoryThread(const unsigned char*) | failed to load image pixel data from memory: %p", data);
+        return {};
     }
-}
-
-void logMessageTrace(LvnLogger* logger, const char* fmt, ...)
-{
-    if (!s_LvnContext || !s_LvnContext->logging) { return; }
-    if (!s_LvnContext->enableCoreLogging && logger == &s_LvnContext->coreLogger) { return; }
-    if (!lvn::logCheckLevel(logger, Lvn_LogLevel_Trace)) { return; }
-
-    LvnVector<char> buff;
 
-    va_list argptr, argcopy;
-    va_start(argptr, fmt);
-    va_copy(argcopy, argptr);
+    LvnImageData imageData{};
+    imageData.width = imageWidth;
+    imageData.height = imageHeight;
+    imageData.channels = forceChannels ? forceChannels : imageChannels;
+    imageData.size = imageData.width * imageData.height * imageData.channels;
+    imageData.pixels = LvnData<uint8_t>(pixels, imageData.size, lvn::freeStbiImage);
 
-    int len = vsnprintf(nullptr, 0, fmt, argptr);
-    buff.resize(len + 1);
-    vsnprintf(&buff[0], len + 1, fmt, argcopy);
-    lvn::logMessage(logger, Lvn_LogLevel_Trace, buff.data());
+    LVN_CORE_TRACE("loaded image data from memory <unsigned char*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes", pixels, imageData.width, imageData.height, imageData.channels, imageData.size);
 
-    va_end(argcopy);
-    va_end(argptr);
+    return imageData;
 }
 
-void logMessageDebug(LvnLogger* logger, const char* fmt, ...)
+LvnResult imageGetInfo(const uint8_t* data, uint64_t length, uint32_t* width, uint32_t* height, uint32_t* channels)
 {
-    if (!s_LvnContext || !s_LvnContext->logging) { return; }
-    if (!s_LvnContext->enableCoreLogging && logger == &s_LvnContext->coreLogger) { return; }
-    if (!lvn::logCheckLevel(logger, Lvn_LogLevel_Debug)) { return; }
-
-    LvnVector<char> buff;
-
-    va_list argptr, argcopy;
-    va_start(argptr, fmt);
-    va_copy(argcopy, argptr);
+    const LvnImageDecoder* decoder = lvn::findImageDecoder(data, length);
+    if (decoder != nullptr && decoder->getInfo(data, length, width, height, channels))
+        return Lvn_Result_Success;
 
-    int len = vsnprintf(nullptr, 0, fmt, argptr);
-    buff.resize(len + 1);
-    vsnprintf(&buff[0], len + 1, fmt, argcopy);
-    lvn::logMessage(logger, Lvn_LogLevel_Debug, buff.data());
+    int imageWidth, imageHeight, imageChannels;
+    if (!stbi_info_from_memory(data, static_cast<int>(length), &imageWidth, &imageHeight, &imageChannels))
+        return Lvn_Result_Failure;
 
-    va_end(argcopy);
-    va_end(argptr);
+    *width = imageWidth;
+    *height = imageHeight;
+    *channels = imageChannels;
+    return Lvn_Result_Success;
 }
 
-void logMessageInfo(LvnLogger* logger, const char* fmt, ...)
+LvnResult loadImageDataMemoryInto(const uint8_t* data, uint64_t length, uint8_t* dst, uint64_t dstSize, int forceChannels, bool flipVertically)
 {
-    if (!s_LvnContext || !s_LvnContext->logging) { return; }
-    if (!s_LvnContext->enableCoreLogging && logger == &s_LvnContext->coreLogger) { return; }
-    if (!lvn::logCheckLevel(logger, Lvn_LogLevel_Info)) { return; }
-
-    LvnVector<char> buff;
+    if (!data || !dst)
+    {
+        LVN_CORE_ERROR("loadImageDataMemoryInto(const uint8_t*, uint64_t, uint8_t*, uint64_t, int, bool) | invalid data, image memory data and dst must not be nullptr");
+        return Lvn_Result_Failure;
+    }
 
-    va_list argptr, argcopy;
-    va_start(argptr, fmt);
-    va_copy(argcopy, argptr);
+    if (forceChannels < 0 || forceChannels > 4)
+    {
+        LVN_CORE_ERROR("loadImageDataMemoryInto(const uint8_t*, uint64_t, uint8_t*, uint64_t, int, bool) | forceChannels (%d) must be within 0 to 4 components (rgba)", forceChannels);
+        return Lvn_Result_Failure;
+    }
 
-    int len = vsnprintf(nullptr, 0, fmt, argptr);
-    buff.resize(len + 1);
-    vsnprintf(&buff[0], len + 1, fmt, argcopy);
-    lvn::logMessage(logger, Lvn_LogLevel_Info, buff.data());
+    uint32_t width, height, channels;
+    if (lvn::imageGetInfo(data, length, &width, &height, &channels) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("loadImageDataMemoryInto(const uint8_t*, uint64_t, uint8_t*, uint64_t, int, bool) | failed to read the image header from memory: %p", data);
+        return Lvn_Result_Failure;
+    }
 
-    va_end(argcopy);
-    va_end(argptr);
-}
+    if (forceChannels)
+        channels = forceChannels;
 
-void logMessageWarn(LvnLogger* logger, const char* fmt, ...)
-{
-    if (!s_LvnContext || !s_LvnContext->logging) { return; }
-    if (!s_LvnContext->enableCoreLogging && logger == &s_LvnContext->coreLogger) { return; }
-    if (!lvn::logCheckLevel(logger, Lvn_LogLevel_Warn)) { return; }
+    uint64_t size = (uint64_t)width * height * channels;
+    if (size > dstSize)
+    {
+        LVN_CORE_ERROR("loadImageDataMemoryInto(const uint8_t*, uint64_t, uint8_t*, uint64_t, int, bool) | dst size (%llu) is smaller than the decoded image (w:%u,h:%u,ch:%u), %llu bytes", (unsigned long long)dstSize, width, height, channels, (unsigned long long)size);
+        return Lvn_Result_Failure;
+    }
 
-    LvnVector<char> buff;
+    const LvnImageDecoder* decoder = lvn::findImageDecoder(data, length);
+    if (decoder != nullptr && decoder->decode(data, length, dst, width, height, channels, flipVertically))
+        return Lvn_Result_Success;
 
-    va_list argptr, argcopy;
-    va_start(argptr, fmt);
-    va_copy(argcopy, argptr);
+    // stb always decodes into its own allocation
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
+    int imageWidth, imageHeight, imageChannels;
+    stbi_uc* pixels = stbi_load_from_memory(data, static_cast<int>(length), &imageWidth, &imageHeight, &imageChannels, channels);
 
-    int len = vsnprintf(nullptr, 0, fmt, argptr);
-    buff.resize(len + 1);
-    vsnprintf(&buff[0], len + 1, fmt, argcopy);
-    lvn::logMessage(logger, Lvn_LogLevel_Warn, buff.data());
+    if (!pixels)
+    {
+        LVN_CORE_ERROR("loadImageDataMemoryInto(const uint8_t*, uint64_t, uint8_t*, uint64_t, int, bool) | failed to load image pixel data from memory: %p", data);
+        return Lvn_Result_Failure;
+    }
 
-    va_end(argcopy);
-    va_end(argptr);
+    memcpy(dst, pixels, size);
+    stbi_image_free(pixels);
+    return Lvn_Result_Success;
 }
 
-void logMessageError(LvnLogger* logger, const char* fmt, ...)
+LvnImageHdrData loadHdrImageData(const char* filepath, int forceChannels, bool flipVertically)
 {
-    if (!s_LvnContext || !s_LvnContext->logging) { return; }
-    if (!s_LvnContext->enableCoreLogging && logger == &s_LvnContext->coreLogger) { return; }
-    if (!lvn::logCheckLevel(logger, Lvn_LogLevel_Error)) { return; }
-
-    LvnVector<char> buff;
-
-    va_list argptr, argcopy;
-    va_start(argptr, fmt);
-    va_copy(argcopy, argptr);
+    if (filepath == nullptr)
+    {
+        LVN_CORE_ERROR("loadHdrImageData(const char*) | invalid filepath, filepath must not be nullptr");
+        return {};
+    }
 
-    int len = vsnprintf(nullptr, 0, fmt, argptr);
-    buff.resize(len + 1);
-    vsnprintf(&buff[0], len + 1, fmt, argcopy);
-    lvn::logMessage(logger, Lvn_LogLevel_Error, buff.data());
+    if (forceChannels < 0)
+    {
+        LVN_CORE_ERROR("loadHdrImageData(const char*) | forceChannels < 0, channels cannot be negative");
+        return {};
+    }
+    else if (forceChannels > 4)
+    {
+        LVN_CORE_ERROR("loadHdrImageData(const char*) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
+        return {};
+    }
 
-    va_end(argcopy);
-    va_end(argptr);
-}
+    stbi_set_flip_vertically_on_load(flipVertically);
+    int imageWidth, imageHeight, imageChannels;
+    float* pixels = nullptr;
 
-void logMessageFatal(LvnLogger* logger, const char* fmt, ...)
-{
-    if (!s_LvnContext || !s_LvnContext->logging) { return; }
-    if (!s_LvnContext->enableCoreLogging && logger == &s_LvnContext->coreLogger) { return; }
-    if (!lvn::logCheckLevel(logger, Lvn_LogLevel_Fatal)) { return; }
+    LvnBin packed;
+    if (lvn::vfsReadFile(filepath, &packed))
+        pixels = stbi_loadf_from_memory(packed.data(), static_cast<int>(packed.size()), &imageWidth, &imageHeight, &imageChannels, forceChannels);
+    else
+        pixels = stbi_loadf(filepath, &imageWidth, &imageHeight, &imageChannels, forceChannels);
 
-    LvnVector<char> buff;
+    if (!pixels)
+    {
+        LVN_CORE_ERROR("loadHdrImageData(const char*) | failed to load image pixel data from file: %s", filepath);
+        return {};
+    }
 
-    va_list argptr, argcopy;
-    va_start(argptr, fmt);
-    va_copy(argcopy, argptr);
+    LvnImageHdrData imageData{};
+    imageData.width = imageWidth;
+    imageData.height = imageHeight;
+    imageData.channels = forceChannels ? forceChannels : imageChannels;
+    imageData.size = imageData.width * imageData.height * imageData.channels;
+    imageData.pixels = LvnData<float>(pixels, imageData.size, lvn::freeStbiImage);
 
-    int len = vsnprintf(nullptr, 0, fmt, argptr);
-    buff.resize(len + 1);
-    vsnprintf(&buff[0], len + 1, fmt, argcopy);
-    lvn::logMessage(logger, Lvn_LogLevel_Fatal, buff.data());
+    LVN_CORE_TRACE("loaded hdr image data <float*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes, filepath: %s", pixels, imageData.width, imageData.height, imageData.channels, imageData.size, filepath);
 
-    va_end(argcopy);
-    va_end(argptr);
+    return imageData;
 }
 
-LvnLogger* logGetCoreLogger()
+static uint32_t floatToRgb9e5(float r, float g, float b)
 {
-    return &lvn::getContext()->coreLogger;
-}
+    // shared exponent encoding of EXT_texture_shared_exponent, 9 bit mantissas and a 5 bit exponent with a bias of 15
+    const float maxValue = 65408.0f;
 
-LvnLogger* logGetClientLogger()
-{
-    return &lvn::getContext()->clientLogger;
-}
+    // negatives and nans are flushed to zero
+    r = r > 0.0f ? (r < maxValue ? r : maxValue) : 0.0f;
+    g = g > 0.0f ? (g < maxValue ? g : maxValue) : 0.0f;
+    b = b > 0.0f ? (b < maxValue ? b : maxValue) : 0.0f;
+    float maxComponent = lvn::max(r, lvn::max(g, b));
 
-const char* logGetANSIcodeColor(LvnLogLevel level)
-{
-    switch (level)
+    // floor(log2(max)) from the float exponent bits, values below 2^-16 all use the smallest exponent
+    uint32_t bits;
+    memcpy(&bits, &maxComponent, sizeof(uint32_t));
+    int32_t exponent = lvn::max(static_cast<int32_t>((bits >> 23) & 0xff) - 127, -16) + 16;
+
+    // 2^(24 - exponent) scales the components to 9 bit mantissas, rounding the largest one up to 512 needs the next exponent
+    uint32_t scaleBits = static_cast<uint32_t>(127 + 24 - exponent) << 23;
+    float scale;
+    memcpy(&scale, &scaleBits, sizeof(float));
+
+    if (static_cast<uint32_t>(maxComponent * scale + 0.5f) == 512)
     {
-        case Lvn_LogLevel_None:     { return LVN_LOG_COLOR_RESET; }
-        case Lvn_LogLevel_Trace:    { return LVN_LOG_COLOR_TRACE; }
-        case Lvn_LogLevel_Debug:    { return LVN_LOG_COLOR_DEBUG; }
-        case Lvn_LogLevel_Info:     { return LVN_LOG_COLOR_INFO; }
-        case Lvn_LogLevel_Warn:     { return LVN_LOG_COLOR_WARN; }
-        case Lvn_LogLevel_Error:    { return LVN_LOG_COLOR_ERROR; }
-        case Lvn_LogLevel_Fatal:    { return LVN_LOG_COLOR_FATAL; }
+        exponent++;
+        scale *= 0.5f;
     }
 
-    return nullptr;
+    uint32_t rm = static_cast<uint32_t>(r * scale + 0.5f);
+    uint32_t gm = static_cast<uint32_t>(g * scale + 0.5f);
+    uint32_t bm = static_cast<uint32_t>(b * scale + 0.5f);
+
+    return rm | (gm << 9) | (bm << 18) | (static_cast<uint32_t>(exponent) << 27);
 }
 
-LvnResult logSetPatternFormat(LvnLogger* logger, const char* patternfmt)
+static void convertHdrImageRows(uint32_t start, uint32_t end, void* userData)
 {
-    if (!logger) { return Lvn_Result_Failure; }
-    if (!patternfmt || patternfmt[0] == '\0') { return Lvn_Result_Failure; }
-
-    logger->logPatternFormat = patternfmt;
-
-    logger->logPatterns = lvn::logParseFormat(patternfmt);
+    const LvnHdrImageConvertData* convert = static_cast<const LvnHdrImageConvertData*>(userData);
+    uint64_t first = (uint64_t)start * convert->width;
+    uint64_t last = (uint64_t)end * convert->width;
 
-    return Lvn_Result_Success;
+    // half images are converted from rgba floats, rgb9e5 images from rgb floats
+    if (convert->format == Lvn_HdrImageFormat_Half)
+    {
+        uint16_t* dst = reinterpret_cast<uint16_t*>(convert->dst);
+        for (uint64_t i = first * 4; i < last * 4; i++)
+            dst[i] = lvn::floatToHalf(convert->src[i]);
+    }
+    else
+    {
+        uint32_t* dst = reinterpret_cast<uint32_t*>(convert->dst);
+        for (uint64_t i = first; i < last; i++)
+        {
+            const float* texel = convert->src + i * 3;
+            dst[i] = lvn::floatToRgb9e5(texel[0], texel[1], texel[2]);
+        }
+    }
 }
 
-LvnResult logAddPatterns(LvnLogPattern* pLogPatterns, uint32_t count)
+static uint64_t hashFileContents(const uint8_t* data, uint64_t size)
 {
-    if (!pLogPatterns) { return Lvn_Result_Failure; }
-    if (pLogPatterns->symbol == '\0') { return Lvn_Result_Failure; }
+    // FNV-1a over the 64 bit words of a file, only used to tell if a cache file was made from the same source file
+    uint64_t hash = 0xcbf29ce484222325 ^ size;
+    uint64_t i = 0;
 
-    for (uint32_t i = 0; i < sizeof(s_LogPatterns) / sizeof(LvnLogPattern); i++)
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
     {
-        for (uint32_t j = 0; j < count; j++)
-        {
-            if (pLogPatterns[j].symbol == s_LogPatterns[i].symbol) { return Lvn_Result_Failure; }
-        }
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(uint64_t));
+        hash = (hash ^ word) * 0x100000001b3;
     }
 
-    LvnContext* lvnctx = lvn::getContext();
-    lvnctx->userLogPatterns.insert(lvnctx->userLogPatterns.end(), pLogPatterns, pLogPatterns + count);
+    for (; i < size; i++)
+        hash = (hash ^ data[i]) * 0x100000001b3;
 
-    return Lvn_Result_Success;
+    return hash;
 }
 
-LvnResult createLogger(LvnLogger** logger, const LvnLoggerCreateInfo* loggerCreateInfo)
+static bool readHdrImageCache(const char* filepath, LvnHdrImageFormat format, bool flipVertically, uint64_t sourceHash, LvnImageHdrData* imageData)
 {
-    LvnContext* lvnctx = lvn::getContext();
-
-    *logger = lvn::createObject<LvnLogger>(lvnctx, Lvn_Stype_Logger);
-    LvnLogger* loggerPtr = *logger;
+    FILE* fileptr = fopen(filepath, "rb");
+    if (!fileptr)
+        return false;
 
-    loggerPtr->loggerName = loggerCreateInfo->loggerName;
-    loggerPtr->logPatternFormat = loggerCreateInfo->format;
-    loggerPtr->logLevel = loggerCreateInfo->level;
+    LvnHdrImageCacheHeader header{};
 
-    loggerPtr->logfile.logToFile = loggerCreateInfo->fileConfig.enableLogToFile;
-    loggerPtr->logfile.filename = loggerCreateInfo->fileConfig.filename;
-    loggerPtr->logfile.filemode = loggerCreateInfo->fileConfig.filemode;
+    bool valid = fread(&header, sizeof(LvnHdrImageCacheHeader), 1, fileptr) == 1
+        && header.magic == LVN_HDR_IMAGE_CACHE_MAGIC
+        && header.version == LVN_HDR_IMAGE_CACHE_VERSION
+        && header.format == static_cast<uint32_t>(format)
+        && header.flipVertically == static_cast<uint32_t>(flipVertically)
+        && header.sourceHash == sourceHash
+        && header.channels >= 1 && header.channels <= 4
+        && header.dataSize == (uint64_t)header.width * header.height * lvn::hdrImageGetTexelSize(format, header.channels);
 
-    if (loggerPtr->logfile.logToFile)
+    if (valid)
     {
-        if (loggerPtr->logfile.filename.empty())
+        uint8_t* dst = nullptr;
+        if (format == Lvn_HdrImageFormat_Float)
         {
-            LVN_CORE_ERROR("createLogger(LvnLogger**, LvnLoggerCreateInfo*) | loggerCreateInfo->fileConfig.filename is empty, cannot log to a file without a valid file path/name");
-            return Lvn_Result_Failure;
+            imageData->pixels = LvnData<float>(header.dataSize / sizeof(float));
+            dst = reinterpret_cast<uint8_t*>(imageData->pixels.data());
+        }
+        else
+        {
+            imageData->packedPixels = LvnData<uint8_t>(header.dataSize);
+            dst = imageData->packedPixels.data();
         }
 
-        const char* filemode = "w";
-        if (loggerPtr->logfile.filemode == Lvn_FileMode_Write) filemode = "w";
-        else if (loggerPtr->logfile.filemode == Lvn_FileMode_Append) filemode = "a";
+        valid = fread(dst, sizeof(uint8_t), header.dataSize, fileptr) == header.dataSize;
+    }
+
+    fclose(fileptr);
 
-        loggerPtr->logfile.fileptr = fopen(loggerPtr->logfile.filename.c_str(), filemode);
+    if (!valid)
+    {
+        LVN_CORE_WARN("hdr image cache file does not match the source image and will be rewritten: %s", filepath);
+        *imageData = {};
+        return false;
     }
 
-    loggerPtr->logPatterns = lvn::logParseFormat(loggerCreateInfo->format.c_str());
+    imageData->width = header.width;
+    imageData->height = header.height;
+    imageData->channels = header.channels;
+    imageData->format = format;
+    imageData->size = format == Lvn_HdrImageFormat_Float ? header.dataSize / sizeof(float) : header.dataSize;
 
-    LVN_CORE_TRACE("created logger: (%p), name: \"%s\"", *logger, loggerCreateInfo->loggerName.c_str());
-    return Lvn_Result_Success;
+    return true;
 }
 
-void destroyLogger(LvnLogger* logger)
+static void writeHdrImageCache(const char* filepath, const LvnImageHdrData& imageData, bool flipVertically, uint64_t sourceHash)
 {
-    if (logger == nullptr) { return; }
+    bool packed = imageData.format != Lvn_HdrImageFormat_Float;
 
-    if (logger->logfile.logToFile)
+    LvnHdrImageCacheHeader header{};
+    header.magic = LVN_HDR_IMAGE_CACHE_MAGIC;
+    header.version = LVN_HDR_IMAGE_CACHE_VERSION;
+    header.width = imageData.width;
+    header.height = imageData.height;
+    header.channels = imageData.channels;
+    header.format = static_cast<uint32_t>(imageData.format);
+    header.flipVertically = static_cast<uint32_t>(flipVertically);
+    header.sourceHash = sourceHash;
+    header.dataSize = packed ? imageData.packedPixels.memsize() : imageData.pixels.memsize();
+
+    const void* data = packed ? (const void*)imageData.packedPixels.data() : (const void*)imageData.pixels.data();
+
+    FILE* fileptr = fopen(filepath, "wb");
+    if (!fileptr)
     {
-        fclose(logger->logfile.fileptr);
-        logger->logfile.fileptr = nullptr;
+        LVN_CORE_ERROR("cannot write hdr image cache file: %s", filepath);
+        return;
     }
 
-    LvnContext* lvnctx = lvn::getContext();
-    lvn::destroyObject(lvnctx, logger, Lvn_Stype_Logger);
-}
+    if (fwrite(&header, sizeof(LvnHdrImageCacheHeader), 1, fileptr) != 1 || fwrite(data, sizeof(uint8_t), header.dataSize, fileptr) != header.dataSize)
+        LVN_CORE_ERROR("failed to write hdr image cache file: %s", filepath);
 
-// ------------------------------------------------------------
-// [SECTION]: Event Functions
-// ------------------------------------------------------------
+    fclose(fileptr);
+}
 
-bool dispatchKeyHoldEvent(LvnEvent* event, bool(*func)(LvnKeyHoldEvent*, void*))
+LvnImageHdrData loadHdrImageData(const char* filepath, LvnHdrImageFormat format, bool flipVertically, const char* cachePath)
 {
-    if (event->type == Lvn_EventType_KeyHold)
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Loaders);
+    if (filepath == nullptr)
     {
-        LvnKeyHoldEvent eventType{};
-        eventType.type = Lvn_EventType_KeyHold;
-        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Keyboard;
-        eventType.name = "LvnKeyHoldEvent";
-        eventType.handled = false;
-        eventType.keyCode = event->data.code;
-        eventType.repeat = event->data.repeat;
+        LVN_CORE_ERROR("loadHdrImageData(const char*, LvnHdrImageFormat, bool, const char*) | invalid filepath, filepath must not be nullptr");
+        return {};
+    }
 
-        return func(&eventType, event->userData);
+    LvnBin file;
+    if (!lvn::vfsReadFile(filepath, &file))
+        file = lvn::loadFileMapped(filepath);
+
+    if (file.size() == 0)
+    {
+        LVN_CORE_ERROR("loadHdrImageData(const char*, LvnHdrImageFormat, bool, const char*) | failed to read file: %s", filepath);
+        return {};
     }
 
-    return false;
-}
-bool dispatchKeyPressedEvent(LvnEvent* event, bool(*func)(LvnKeyPressedEvent*, void*))
-{
-    if (event->type == Lvn_EventType_KeyPressed)
+    // the cache is checked against the encoded file, hashing it is much cheaper than decoding it
+    LvnImageHdrData imageData{};
+    uint64_t sourceHash = 0;
+    if (cachePath != nullptr)
     {
-        LvnKeyPressedEvent eventType{};
-        eventType.type = Lvn_EventType_KeyPressed;
-        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Keyboard;
-        eventType.name = "LvnKeyPressedEvent";
-        eventType.handled = false;
-        eventType.keyCode = event->data.code;
+        sourceHash = lvn::hashFileContents(file.data(), file.size());
+        if (lvn::readHdrImageCache(cachePath, format, flipVertically, sourceHash, &imageData))
+        {
+            LVN_CORE_TRACE("loaded hdr image data (w:%u,h:%u,ch:%u) from cache file: %s, filepath: %s", imageData.width, imageData.height, imageData.channels, cachePath, filepath);
+            return imageData;
+        }
+    }
 
-        return func(&eventType, event->userData);
+    // half images are decoded to rgba so they upload as is, rgb9e5 has no alpha and float images keep the channels of the file
+    int forceChannels = format == Lvn_HdrImageFormat_Half ? 4 : (format == Lvn_HdrImageFormat_Rgb9e5 ? 3 : 0);
+
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
+    int imageWidth, imageHeight, imageChannels;
+    float* pixels = stbi_loadf_from_memory(file.data(), static_cast<int>(file.size()), &imageWidth, &imageHeight, &imageChannels, forceChannels);
+
+    if (!pixels)
+    {
+        LVN_CORE_ERROR("loadHdrImageData(const char*, LvnHdrImageFormat, bool, const char*) | failed to load image pixel data from file: %s", filepath);
+        return {};
     }
 
-    return false;
-}
-bool dispatchKeyReleasedEvent(LvnEvent* event, bool(*func)(LvnKeyReleasedEvent*, void*))
-{
-    if (event->type == Lvn_EventType_KeyReleased)
+    imageData.width = imageWidth;
+    imageData.height = imageHeight;
+    imageData.channels = forceChannels ? forceChannels : imageChannels;
+    imageData.format = format;
+
+    if (format == Lvn_HdrImageFormat_Float)
     {
-        LvnKeyReleasedEvent eventType{};
-        eventType.type = Lvn_EventType_KeyReleased;
-        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Keyboard;
-        eventType.name = "LvnKeyReleasedEvent";
-        eventType.handled = false;
-        eventType.keyCode = event->data.code;
+        imageData.size = (uint64_t)imageData.width * imageData.height * imageData.channels;
+        imageData.pixels = LvnData<float>(pixels, imageData.size, lvn::freeStbiImage);
+    }
+    else
+    {
+        imageData.size = (uint64_t)imageData.width * imageData.height * lvn::hdrImageGetTexelSize(format, imageData.channels);
+        imageData.packedPixels = LvnData<uint8_t>(imageData.size);
+
+        // rows are packed in parallel when there is a context to run jobs on, the float texels are freed right after
+        LvnHdrImageConvertData convert{};
+        convert.src = pixels;
+        convert.dst = imageData.packedPixels.data();
+        convert.width = imageData.width;
+        convert.format = format;
+
+        if (s_LvnContext != nullptr)
+            lvn::parallelFor(imageData.height, 0, lvn::convertHdrImageRows, &convert);
+        else
+            lvn::convertHdrImageRows(0, imageData.height, &convert);
 
-        return func(&eventType, event->userData);
+        stbi_image_free(pixels);
     }
 
-    return false;
+    if (cachePath != nullptr)
+        lvn::writeHdrImageCache(cachePath, imageData, flipVertically, sourceHash);
+
+    LVN_CORE_TRACE("loaded hdr image data (w:%u,h:%u,ch:%u), format: %u, total memory size: %llu bytes, filepath: %s", imageData.width, imageData.height, imageData.channels, (uint32_t)format, (unsigned long long)(imageData.size * (format == Lvn_HdrImageFormat_Float ? sizeof(float) : 1)), filepath);
+
+    return imageData;
 }
-bool dispatchKeyTypedEvent(LvnEvent* event, bool(*func)(LvnKeyTypedEvent*, void*))
-{
-    if (event->type == Lvn_EventType_KeyTyped)
-    {
-        LvnKeyTypedEvent eventType{};
-        eventType.type = Lvn_EventType_KeyTyped;
-        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Keyboard;
-        eventType.name = "LvnKeyTypedEvent";
-        eventType.handled = false;
-        eventType.key = event->data.ucode;
 
-        return func(&eventType, event->userData);
-    }
+static void loadHdrImageDataJob(void* userData)
+{
+    LvnHdrImageLoadJob* job = static_cast<LvnHdrImageLoadJob*>(userData);
 
-    return false;
+    *job->pImageData = lvn::loadHdrImageData(job->filepath.c_str(), job->format, job->flipVertically, job->cachePath.empty() ? nullptr : job->cachePath.c_str());
+    lvn::memDelete(job);
 }
-bool dispatchMouseButtonPressedEvent(LvnEvent* event, bool(*func)(LvnMouseButtonPressedEvent*, void*))
+
+void loadHdrImageDataAsync(const char* filepath, LvnHdrImageFormat format, LvnImageHdrData* pImageData, LvnJobCounter* counter, bool flipVertically, const char* cachePath)
 {
-    if (event->type == Lvn_EventType_MouseButtonPressed)
-    {
-        LvnMouseButtonPressedEvent eventType{};
-        eventType.type = Lvn_EventType_MouseButtonPressed;
-        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_MouseButton | Lvn_EventCategory_Mouse;
-        eventType.name = "LvnMouseButtonPressedEvent";
-        eventType.handled = false;
-        eventType.buttonCode = event->data.code;
+    LVN_CORE_ASSERT(pImageData != nullptr, "pImageData cannot be nullptr");
 
-        return func(&eventType, event->userData);
+    if (filepath == nullptr)
+    {
+        LVN_CORE_ERROR("loadHdrImageDataAsync(const char*, LvnHdrImageFormat, LvnImageHdrData*, LvnJobCounter*, bool, const char*) | invalid filepath, filepath must not be nullptr");
+        return;
     }
 
-    return false;
+    // the paths are copied, the job owns its data and frees it once the image is written
+    LvnHdrImageLoadJob* job = lvn::memNew<LvnHdrImageLoadJob>();
+    job->filepath = filepath;
+    job->cachePath = cachePath ? cachePath : "";
+    job->format = format;
+    job->flipVertically = flipVertically;
+    job->pImageData = pImageData;
+
+    lvn::jobSubmit(lvn::loadHdrImageDataJob, job, counter);
 }
-bool dispatchMouseButtonReleasedEvent(LvnEvent* event, bool(*func)(LvnMouseButtonReleasedEvent*, void*))
+
+static uint32_t getTextureCompressionChannels(LvnTextureCompression compression)
 {
-    if (event->type == Lvn_EventType_MouseButtonReleased)
+    switch (compression)
     {
-        LvnMouseButtonReleasedEvent eventType{};
-        eventType.type = Lvn_EventType_MouseButtonReleased;
-        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_MouseButton | Lvn_EventCategory_Mouse;
-        eventType.name = "LvnMouseButtonReleasedEvent";
-        eventType.handled = false;
-        eventType.buttonCode = event->data.code;
-
-        return func(&eventType, event->userData);
+        case Lvn_TextureCompression_Bc4: { return 1; }
+        case Lvn_TextureCompression_Bc5: { return 2; }
+        case Lvn_TextureCompression_Etc2Rgb: { return 3; }
+        default: { return 4; }
     }
-
-    return false;
 }
-bool dispatchMouseMovedEvent(LvnEvent* event, bool(*func)(LvnMouseMovedEvent*, void*))
+
+uint64_t imageGetCompressedSize(LvnTextureCompression compression, uint32_t width, uint32_t height)
 {
-    if (event->type == Lvn_EventType_MouseMoved)
+    uint64_t blockSize = 16;
+    switch (compression)
     {
-        LvnMouseMovedEvent eventType{};
-        eventType.type = Lvn_EventType_MouseMoved;
-        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_Mouse;
-        eventType.name = "LvnMouseMovedEvent";
-        eventType.handled = false;
-        eventType.x = event->data.xd;
-        eventType.y = event->data.yd;
-
-        return func(&eventType, event->userData);
+        case Lvn_TextureCompression_None: { return (uint64_t)width * height * 4; }
+        case Lvn_TextureCompression_Bc1:
+        case Lvn_TextureCompression_Bc4:
+        case Lvn_TextureCompression_Etc2Rgb: { blockSize = 8; break; }
+        default: { break; }
     }
 
-    return false;
+    // every supported format uses 4x4 blocks
+    return (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
 }
-bool dispatchMouseScrolledEvent(LvnEvent* event, bool(*func)(LvnMouseScrolledEvent*, void*))
+
+static LvnImageData parseImageDataKtx2(const uint8_t* data, uint64_t length, LvnVector<LvnImageData>* pMipLevels)
 {
-    if (event->type == Lvn_EventType_MouseScrolled)
+    // header layout from the KTX 2.0 specification
+    struct Ktx2Header
     {
-        LvnMouseScrolledEvent eventType{};
-        eventType.type = Lvn_EventType_MouseScrolled;
-        eventType.category = Lvn_EventCategory_Input | Lvn_EventCategory_MouseButton | Lvn_EventCategory_Mouse;
-        eventType.name = "LvnMouseScrolledEvent";
-        eventType.handled = false;
-        eventType.x = static_cast<float>(event->data.xd);
-        eventType.y = static_cast<float>(event->data.yd);
+        uint8_t identifier[12];
+        uint32_t vkFormat, typeSize;
+        uint32_t pixelWidth, pixelHeight, pixelDepth;
+        uint32_t layerCount, faceCount, levelCount;
+        uint32_t supercompressionScheme;
+        uint32_t dfdByteOffset, dfdByteLength;
+        uint32_t kvdByteOffset, kvdByteLength;
+        uint64_t sgdByteOffset, sgdByteLength;
+    };
+
+    struct Ktx2LevelIndex
+    {
+        uint64_t byteOffset, byteLength, uncompressedByteLength;
+    };
 
-        return func(&eventType, event->userData);
+    Ktx2Header header;
+    if (length < sizeof(Ktx2Header))
+    {
+        LVN_CORE_ERROR("loadImageDataCompressed() | ktx2 data too small to contain a header, size: %llu bytes", (unsigned long long)length);
+        return {};
     }
+    memcpy(&header, data, sizeof(Ktx2Header));
 
-    return false;
-}
-bool dispatchWindowCloseEvent(LvnEvent* event, bool(*func)(LvnWindowCloseEvent*, void*))
-{
-    if (event->type == Lvn_EventType_WindowClose)
+    if (header.supercompressionScheme != 0 || header.vkFormat == 0)
     {
-        LvnWindowCloseEvent eventType{};
-        eventType.type = Lvn_EventType_WindowClose;
-        eventType.category = Lvn_EventCategory_Window;
-        eventType.name = "LvnWindowCloseEvent";
-        eventType.handled = false;
-
-        return func(&eventType, event->userData);
+        LVN_CORE_ERROR("loadImageDataCompressed() | ktx2 data uses supercompression (%u) or basis universal encoding, only ktx2 files storing block compressed formats directly are supported", header.supercompressionScheme);
+        return {};
+    }
+    if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1)
+    {
+        LVN_CORE_ERROR("loadImageDataCompressed() | ktx2 data is not a single 2d image (depth:%u, layers:%u, faces:%u), only 2d textures are supported", header.pixelDepth, header.layerCount, header.faceCount);
+        return {};
     }
 
-    return false;
-}
-bool dispatchWindowFocusEvent(LvnEvent* event, bool(*func)(LvnWindowFocusEvent*, void*))
-{
-    if (event->type == Lvn_EventType_WindowFocus)
+    // vkFormat values from the vulkan specification
+    LvnTextureCompression compression;
+    switch (header.vkFormat)
     {
-        LvnWindowFocusEvent eventType{};
-        eventType.type = Lvn_EventType_WindowFocus;
-        eventType.category = Lvn_EventCategory_Window;
-        eventType.name = "LvnWindowFocusEvent";
-        eventType.handled = false;
+        case 133: case 134: { compression = Lvn_TextureCompression_Bc1; break; }        // VK_FORMAT_BC1_RGBA_UNORM/SRGB_BLOCK
+        case 137: case 138: { compression = Lvn_TextureCompression_Bc3; break; }        // VK_FORMAT_BC3_UNORM/SRGB_BLOCK
+        case 139: { compression = Lvn_TextureCompression_Bc4; break; }                  // VK_FORMAT_BC4_UNORM_BLOCK
+        case 141: { compression = Lvn_TextureCompression_Bc5; break; }                  // VK_FORMAT_BC5_UNORM_BLOCK
+        case 145: case 146: { compression = Lvn_TextureCompression_Bc7; break; }        // VK_FORMAT_BC7_UNORM/SRGB_BLOCK
+        case 147: case 148: { compression = Lvn_TextureCompression_Etc2Rgb; break; }    // VK_FORMAT_ETC2_R8G8B8_UNORM/SRGB_BLOCK
+        case 151: case 152: { compression = Lvn_TextureCompression_Etc2Rgba; break; }   // VK_FORMAT_ETC2_R8G8B8A8_UNORM/SRGB_BLOCK
+        case 157: case 158: { compression = Lvn_TextureCompression_Astc4x4; break; }    // VK_FORMAT_ASTC_4x4_UNORM/SRGB_BLOCK
 
-        return func(&eventType, event->userData);
+        default:
+        {
+            LVN_CORE_ERROR("loadImageDataCompressed() | ktx2 data has unsupported vkFormat (%u)", header.vkFormat);
+            return {};
+        }
     }
 
-    return false;
-}
-bool dispatchWindowFramebufferResizeEvent(LvnEvent* event, bool(*func)(LvnWindowFramebufferResizeEvent*, void*))
-{
-    if (event->type == Lvn_EventType_WindowFramebufferResize)
+    uint32_t levelCount = lvn::max(header.levelCount, 1u);
+    if (length < sizeof(Ktx2Header) + sizeof(Ktx2LevelIndex) * levelCount)
     {
-        LvnWindowFramebufferResizeEvent eventType{};
-        eventType.type = Lvn_EventType_WindowFramebufferResize;
-        eventType.category = Lvn_EventCategory_Window;
-        eventType.name = "LvnWindowFramebufferResizeEvent";
-        eventType.handled = false;
-        eventType.width = event->data.x;
-        eventType.height = event->data.y;
-
-        return func(&eventType, event->userData);
+        LVN_CORE_ERROR("loadImageDataCompressed() | ktx2 data too small to contain the level index for (%u) levels", levelCount);
+        return {};
     }
 
-    return false;
-}
-bool dispatchWindowLostFocusEvent(LvnEvent* event, bool(*func)(LvnWindowLostFocusEvent*, void*))
-{
-    if (event->type == Lvn_EventType_WindowLostFocus)
+    LvnImageData imageData{};
+    if (pMipLevels)
+        pMipLevels->clear();
+
+    for (uint32_t i = 0; i < levelCount; i++)
     {
-        LvnWindowLostFocusEvent eventType{};
-        eventType.type = Lvn_EventType_WindowLostFocus;
-        eventType.category = Lvn_EventCategory_Window;
-        eventType.name = "LvnWindowLostFocusEvent";
-        eventType.handled = false;
+        Ktx2LevelIndex level;
+        memcpy(&level, data + sizeof(Ktx2Header) + sizeof(Ktx2LevelIndex) * i, sizeof(Ktx2LevelIndex));
 
-        return func(&eventType, event->userData);
+        LvnImageData levelData{};
+        levelData.width = lvn::max(header.pixelWidth >> i, 1u);
+        levelData.height = lvn::max(header.pixelHeight >> i, 1u);
+        levelData.channels = lvn::getTextureCompressionChannels(compression);
+        levelData.compression = compression;
+        levelData.size = lvn::imageGetCompressedSize(compression, levelData.width, levelData.height);
+
+        if (level.byteLength < levelData.size || level.byteOffset + levelData.size > length)
+        {
+            LVN_CORE_ERROR("loadImageDataCompressed() | ktx2 mip level (%u) is out of range of the file data", i);
+            return {};
+        }
+
+        levelData.pixels = LvnData<uint8_t>(data + level.byteOffset, levelData.size);
+
+        if (i == 0)
+            imageData = lvn::move(levelData);
+        else if (pMipLevels)
+            pMipLevels->push_back(lvn::move(levelData));
+        else
+            break;
     }
 
-    return false;
+    return imageData;
 }
-bool dispatchWindowMovedEvent(LvnEvent* event, bool(*func)(LvnWindowMovedEvent*, void*))
+
+static LvnImageData parseImageDataDds(const uint8_t* data, uint64_t length, LvnVector<LvnImageData>* pMipLevels)
 {
-    if (event->type == Lvn_EventType_WindowMoved)
+    // header layout from the DirectDraw Surface documentation, the magic number is not part of the header
+    struct DdsHeader
     {
-        LvnWindowMovedEvent eventType{};
-        eventType.type = Lvn_EventType_WindowMoved;
-        eventType.category = Lvn_EventCategory_Window;
-        eventType.name = "LvnWindowMovedEvent";
-        eventType.handled = false;
-        eventType.x = event->data.x;
-        eventType.y = event->data.y;
+        uint32_t size, flags, height, width, pitchOrLinearSize, depth, mipMapCount;
+        uint32_t reserved1[11];
+        uint32_t pfSize, pfFlags, pfFourCC, pfRGBBitCount, pfRBitMask, pfGBitMask, pfBBitMask, pfABitMask;
+        uint32_t caps, caps2, caps3, caps4, reserved2;
+    };
 
-        return func(&eventType, event->userData);
+    struct DdsHeaderDxt10
+    {
+        uint32_t dxgiFormat, resourceDimension, miscFlag, arraySize, miscFlags2;
+    };
+
+    uint64_t offset = 4;
+    DdsHeader header;
+    if (length < offset + sizeof(DdsHeader))
+    {
+        LVN_CORE_ERROR("loadImageDataCompressed() | dds data too small to contain a header, size: %llu bytes", (unsigned long long)length);
+        return {};
     }
+    memcpy(&header, data + offset, sizeof(DdsHeader));
+    offset += sizeof(DdsHeader);
 
-    return false;
-}
-bool dispatchWindowResizeEvent(LvnEvent* event, bool(*func)(LvnWindowResizeEvent*, void*))
-{
+    auto fourCC = [](const char* code) { return (uint32_t)code[0] | ((uint32_t)code[1] << 8) | ((uint32_t)code[2] << 16) | ((uint32_t)code[3] << 24); };
 
-    if (event->type == Lvn_EventType_WindowResize)
+    LvnTextureCompression compression = Lvn_TextureCompression_None;
+    if (header.pfFourCC == fourCC("DXT1")) compression = Lvn_TextureCompression_Bc1;
+    else if (header.pfFourCC == fourCC("DXT5")) compression = Lvn_TextureCompression_Bc3;
+    else if (header.pfFourCC == fourCC("ATI1") || header.pfFourCC == fourCC("BC4U")) compression = Lvn_TextureCompression_Bc4;
+    else if (header.pfFourCC == fourCC("ATI2") || header.pfFourCC == fourCC("BC5U")) compression = Lvn_TextureCompression_Bc5;
+    else if (header.pfFourCC == fourCC("DX10"))
     {
-        LvnWindowResizeEvent eventType{};
-        eventType.type = Lvn_EventType_WindowResize;
-        eventType.category = Lvn_EventCategory_Window;
-        eventType.name = "LvnWindowResizeEvent";
-        eventType.handled = false;
-        eventType.width = event->data.x;
-        eventType.height = event->data.y;
+        DdsHeaderDxt10 dxt10;
+        if (length < offset + sizeof(DdsHeaderDxt10))
+        {
+            LVN_CORE_ERROR("loadImageDataCompressed() | dds data too small to contain the dx10 header");
+            return {};
+        }
+        memcpy(&dxt10, data + offset, sizeof(DdsHeaderDxt10));
+        offset += sizeof(DdsHeaderDxt10);
 
-        return func(&eventType, event->userData);
+        if (dxt10.arraySize > 1)
+        {
+            LVN_CORE_ERROR("loadImageDataCompressed() | dds texture arrays are not supported, array size: %u", dxt10.arraySize);
+            return {};
+        }
+
+        // DXGI_FORMAT values
+        switch (dxt10.dxgiFormat)
+        {
+            case 71: case 72: { compression = Lvn_TextureCompression_Bc1; break; } // DXGI_FORMAT_BC1_UNORM(_SRGB)
+            case 77: case 78: { compression = Lvn_TextureCompression_Bc3; break; } // DXGI_FORMAT_BC3_UNORM(_SRGB)
+            case 80: { compression = Lvn_TextureCompression_Bc4; break; }          // DXGI_FORMAT_BC4_UNORM
+            case 83: { compression = Lvn_TextureCompression_Bc5; break; }          // DXGI_FORMAT_BC5_UNORM
+            case 98: case 99: { compression = Lvn_TextureCompression_Bc7; break; } // DXGI_FORMAT_BC7_UNORM(_SRGB)
+            default: { break; }
+        }
     }
 
-    return false;
-}
+    if (compression == Lvn_TextureCompression_None)
+    {
+        LVN_CORE_ERROR("loadImageDataCompressed() | dds data has an unsupported pixel format, fourCC: (%.4s)", (const char*)&header.pfFourCC);
+        return {};
+    }
+    if (header.caps2 & 0x200) // DDSCAPS2_CUBEMAP
+    {
+        LVN_CORE_ERROR("loadImageDataCompressed() | dds cubemaps are not supported");
+        return {};
+    }
 
+    LvnImageData imageData{};
+    if (pMipLevels)
+        pMipLevels->clear();
 
-// ------------------------------------------------------------
-// [SECTION]: Window Functions
-// ------------------------------------------------------------
+    uint32_t levelCount = lvn::max(header.mipMapCount, 1u);
+    for (uint32_t i = 0; i < levelCount; i++)
+    {
+        LvnImageData levelData{};
+        levelData.width = lvn::max(header.width >> i, 1u);
+        levelData.height = lvn::max(header.height >> i, 1u);
+        levelData.channels = lvn::getTextureCompressionChannels(compression);
+        levelData.compression = compression;
+        levelData.size = lvn::imageGetCompressedSize(compression, levelData.width, levelData.height);
+
+        if (offset + levelData.size > length)
+        {
+            LVN_CORE_ERROR("loadImageDataCompressed() | dds mip level (%u) is out of range of the file data", i);
+            return {};
+        }
 
-LvnWindowApi getWindowApi()
-{
-    return lvn::getContext()->windowapi;
-}
+        // levels are stored tightly packed one after another
+        levelData.pixels = LvnData<uint8_t>(data + offset, levelData.size);
+        offset += levelData.size;
 
-const char* getWindowApiName()
-{
-    switch (lvn::getContext()->windowapi)
-    {
-        case Lvn_WindowApi_None:  { return "None";  }
-        case Lvn_WindowApi_glfw:  { return "glfw";  }
-        // case Lvn_WindowApi_win32: { return "win32"; }
+        if (i == 0)
+            imageData = lvn::move(levelData);
+        else if (pMipLevels)
+            pMipLevels->push_back(lvn::move(levelData));
+        else
+            break;
     }
 
-    LVN_CORE_ERROR("Unknown Windows API selected!");
-    return LVN_EMPTY_STR;
+    return imageData;
 }
 
-LvnResult createWindow(LvnWindow** window, const LvnWindowCreateInfo* createInfo)
+LvnImageData loadImageDataCompressed(const char* filepath, LvnVector<LvnImageData>* pMipLevels)
 {
-    LvnContext* lvnctx = lvn::getContext();
-
-    if (createInfo->width < 0 || createInfo->height < 0)
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Loaders);
+    if (filepath == nullptr)
     {
-        LVN_CORE_ERROR("createWindow(LvnWindow**, LvnWindowCreateInfo*) | cannot create window with negative dimensions (w:%d,h:%d)", createInfo->width, createInfo->height);
-        return Lvn_Result_Failure;
+        LVN_CORE_ERROR("loadImageDataCompressed(const char*, LvnVector<LvnImageData>*) | invalid filepath, filepath must not be nullptr");
+        return {};
     }
 
-    *window = lvn::createObject<LvnWindow>(lvnctx, Lvn_Stype_Window);
+    LvnBin bin = lvn::loadFileMapped(filepath);
+    if (bin.size() == 0)
+        return {};
 
-    LVN_CORE_TRACE("created window: (%p), \"%s\" (w:%d,h:%d)", *window, createInfo->title.c_str(), createInfo->width, createInfo->height);
-    return lvnctx->windowContext.createWindow(*window, createInfo);
-}
+    LvnImageData imageData = lvn::loadImageDataCompressedMemory(bin.data(), bin.size(), pMipLevels);
 
-void destroyWindow(LvnWindow* window)
-{
-    if (window == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
-    lvnctx->windowContext.destroyWindow(window);
-    lvn::destroyObject(lvnctx, window, Lvn_Stype_Window);
+    if (imageData.pixels.size())
+        LVN_CORE_TRACE("loaded compressed image data (w:%u,h:%u,compression:%u), total memory size: %u bytes, mip levels: %u, filepath: %s", imageData.width, imageData.height, imageData.compression, imageData.size, pMipLevels ? (uint32_t)pMipLevels->size() + 1 : 1, filepath);
+
+    return imageData;
 }
 
-LvnWindowCreateInfo configWindowInit(const char* title, int width, int height)
+LvnImageData loadImageDataCompressedMemory(const uint8_t* data, uint64_t length, LvnVector<LvnImageData>* pMipLevels)
 {
-    LvnWindowCreateInfo windowCreateInfo{};
-    windowCreateInfo.width = width;
-    windowCreateInfo.height = height;
-    windowCreateInfo.title = title;
-    windowCreateInfo.minWidth = 0;
-    windowCreateInfo.minHeight = 0;
-    windowCreateInfo.maxWidth = -1;
-    windowCreateInfo.maxHeight = -1;
-    windowCreateInfo.fullscreen = false;
-    windowCreateInfo.resizable = true;
-    windowCreateInfo.vSync = false;
-    windowCreateInfo.pIcons = nullptr;
-    windowCreateInfo.iconCount = 0;
-    windowCreateInfo.eventCallBack = nullptr;
-    windowCreateInfo.userData = nullptr;
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Loaders);
+    if (!data)
+    {
+        LVN_CORE_ERROR("loadImageDataCompressedMemory(const uint8_t*, uint64_t, LvnVector<LvnImageData>*) | invalid data, image memory data must not be nullptr");
+        return {};
+    }
 
-    return windowCreateInfo;
-}
+    if (lvn::isCompressedImageFile(data, length))
+        return memcmp(data, "DDS ", 4) == 0 ? lvn::parseImageDataDds(data, length, pMipLevels) : lvn::parseImageDataKtx2(data, length, pMipLevels);
 
-void windowUpdate(LvnWindow* window)
-{
-    lvn::getContext()->windowContext.updateWindow(window);
+    LVN_CORE_ERROR("loadImageDataCompressedMemory(const uint8_t*, uint64_t, LvnVector<LvnImageData>*) | image data is not a ktx2 or dds file");
+    return {};
 }
 
-bool windowOpen(LvnWindow* window)
+LvnResult writeImagePng(const LvnImageData& imageData, const char* filename)
 {
-    return lvn::getContext()->windowContext.windowOpen(window);
+    int stride = imageData.width * imageData.channels;
+    int result = stbi_write_png(filename, (int)imageData.width, (int)imageData.height, (int)imageData.channels, imageData.pixels.data(), stride);
+    return result ? Lvn_Result_Success : Lvn_Result_Failure;
 }
 
-void windowPollEvents()
+LvnResult writeImageJpg(const LvnImageData& imageData, const char* filename, int quality)
 {
-    lvn::getContext()->windowContext.windowPollEvents();
+    int result = stbi_write_jpg(filename, imageData.width, imageData.height, imageData.channels, imageData.pixels.data(), quality);
+    return result ? Lvn_Result_Success : Lvn_Result_Failure;
 }
 
-LvnPair<int> windowGetDimensions(LvnWindow* window)
+LvnResult writeImageBmp(const LvnImageData& imageData, const char* filename)
 {
-    return lvn::getContext()->windowContext.getWindowSize(window);
+    int result = stbi_write_bmp(filename, imageData.width, imageData.height, imageData.channels, imageData.pixels.data());
+    return result ? Lvn_Result_Success : Lvn_Result_Failure;
 }
 
-int windowGetWidth(LvnWindow* window)
+static void swapMemory(uint8_t* a, uint8_t* b, size_t size)
 {
-    return lvn::getContext()->windowContext.getWindowWidth(window);
+    // swapped in chunks through a stack buffer, memcpy is already vectorized by the c runtime
+    uint8_t temp[512];
+    while (size > 0)
+    {
+        size_t chunk = size < sizeof(temp) ? size : sizeof(temp);
+        memcpy(temp, a, chunk);
+        memcpy(a, b, chunk);
+        memcpy(b, temp, chunk);
+        a += chunk;
+        b += chunk;
+        size -= chunk;
+    }
 }
 
-int windowGetHeight(LvnWindow* window)
+// 1, 2 and 3 channel pixels keep the scalar loop, the compiler vectorizes what it can
+template <typename T>
+static void reversePixels(T* row, uint32_t width)
 {
-    return lvn::getContext()->windowContext.getWindowHeight(window);
-}
+    if (width < 2) { return; }
 
-void windowSetEventCallback(LvnWindow* window, void (*callback)(LvnEvent*), void* userData)
-{
-    window->data.eventCallBackFn = callback;
-    window->data.userData = userData;
+    T* left = row;
+    T* right = row + width - 1;
+    while (left < right)
+    {
+        T temp = *left;
+        *left++ = *right;
+        *right-- = temp;
+    }
 }
 
-void windowSetVSync(LvnWindow* window, bool enable)
-{
-    lvn::getContext()->windowContext.setWindowVSync(window, enable);
-}
+struct LvnRgbPixel { uint8_t c[3]; };
 
-bool windowGetVSync(LvnWindow* window)
+static void reversePixels8(uint8_t* row, uint32_t width)
 {
-    return lvn::getContext()->windowContext.getWindowVSync(window);
-}
+    if (width < 2) { return; }
 
-void* windowGetNativeWindow(LvnWindow* window)
-{
-    return window->nativeWindow;
+    uint8_t* left = row;
+    uint8_t* right = row + width - 1;
+
+#if defined(LVN_SIMD_SSSE3)
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    while (right - left >= 31)
+    {
+        __m128i l = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)left), reverse);
+        __m128i r = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(right - 15)), reverse);
+        _mm_storeu_si128((__m128i*)left, r);
+        _mm_storeu_si128((__m128i*)(right - 15), l);
+        left += 16;
+        right -= 16;
+    }
+#elif defined(LVN_SIMD_NEON)
+    while (right - left >= 31)
+    {
+        uint8x16_t l = vld1q_u8(left);
+        uint8x16_t r = vld1q_u8(right - 15);
+        l = vrev64q_u8(l); l = vextq_u8(l, l, 8);
+        r = vrev64q_u8(r); r = vextq_u8(r, r, 8);
+        vst1q_u8(left, r);
+        vst1q_u8(right - 15, l);
+        left += 16;
+        right -= 16;
+    }
+#endif
+
+    while (left < right)
+    {
+        uint8_t temp = *left;
+        *left++ = *right;
+        *right-- = temp;
+    }
 }
 
-LvnRenderPass* windowGetRenderPass(LvnWindow* window)
+static void reversePixels32(uint32_t* row, uint32_t width)
 {
-    return &window->renderPass;
+    if (width < 2) { return; }
+
+    uint32_t* left = row;
+    uint32_t* right = row + width - 1;
+
+    // four pixels from each end are reversed in a register and swapped while the two ends do not overlap
+#if defined(LVN_SIMD_SSE2)
+    while (right - left >= 7)
+    {
+        __m128i l = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)left), _MM_SHUFFLE(0, 1, 2, 3));
+        __m128i r = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(right - 3)), _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_storeu_si128((__m128i*)left, r);
+        _mm_storeu_si128((__m128i*)(right - 3), l);
+        left += 4;
+        right -= 4;
+    }
+#elif defined(LVN_SIMD_NEON)
+    while (right - left >= 7)
+    {
+        uint32x4_t l = vld1q_u32(left);
+        uint32x4_t r = vld1q_u32(right - 3);
+        l = vrev64q_u32(l); l = vextq_u32(l, l, 2);
+        r = vrev64q_u32(r); r = vextq_u32(r, r, 2);
+        vst1q_u32(left, r);
+        vst1q_u32(right - 3, l);
+        left += 4;
+        right -= 4;
+    }
+#endif
+
+    while (left < right)
+    {
+        uint32_t temp = *left;
+        *left++ = *right;
+        *right-- = temp;
+    }
 }
 
-void windowSetContextCurrent(LvnWindow* window)
+// rotates the pixel in tiles so the strided side of the transpose stays within a few cache lines
+template <typename T>
+static void rotatePixels(const T* src, T* dst, uint32_t width, uint32_t height, bool clockwise)
 {
-    lvn::getContext()->windowContext.setWindowContextCurrent(window);
-}
+    const uint32_t tileSize = 32;
 
-// ------------------------------------------------------------
-// [SECTION]: Input Functions
-// ------------------------------------------------------------
+    for (uint32_t ty = 0; ty < height; ty += tileSize)
+    {
+        uint32_t yEnd = lvn::min(ty + tileSize, height);
+        for (uint32_t tx = 0; tx < width; tx += tileSize)
+        {
+            uint32_t xEnd = lvn::min(tx + tileSize, width);
+            for (uint32_t x = tx; x < xEnd; x++)
+            {
+                // the rotated image is height pixels wide, clockwise: (x, y) -> (height - 1 - y, x), counter clockwise: (x, y) -> (y, width - 1 - x)
+                T* dstRow = clockwise ? dst + (size_t)x * height : dst + (size_t)(width - 1 - x) * height;
+                for (uint32_t y = ty; y < yEnd; y++)
+                    dstRow[clockwise ? height - 1 - y : y] = src[(size_t)y * width + x];
+            }
+        }
+    }
+}
 
-bool keyPressed(LvnWindow* window, int keycode)
-{
-    return lvn::getContext()->windowContext.keyPressed(window, keycode);
+// transposes a 4x4 block of rgba pixels in registers, rows are read bottom up for clockwise rotations so each column comes out reversed
+static void rotateBlock4x4(const uint32_t* src, size_t srcStride, uint32_t* dst, size_t dstStride, bool clockwise)
+{
+    const uint32_t* rows[4];
+    for (uint32_t i = 0; i < 4; i++)
+        rows[i] = src + (clockwise ? 3 - i : i) * srcStride;
+
+    // dst points at the rotated position of the top left pixel of the block, the rows of the rotated block step away from it
+    uint32_t* dstRows[4];
+    for (uint32_t i = 0; i < 4; i++)
+        dstRows[i] = clockwise ? dst + i * dstStride : dst - i * dstStride;
+
+#if defined(LVN_SIMD_SSE2)
+    __m128i r0 = _mm_loadu_si128((const __m128i*)rows[0]);
+    __m128i r1 = _mm_loadu_si128((const __m128i*)rows[1]);
+    __m128i r2 = _mm_loadu_si128((const __m128i*)rows[2]);
+    __m128i r3 = _mm_loadu_si128((const __m128i*)rows[3]);
+
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+    _mm_storeu_si128((__m128i*)dstRows[0], _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)dstRows[1], _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)dstRows[2], _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i*)dstRows[3], _mm_unpackhi_epi64(t2, t3));
+#elif defined(LVN_SIMD_NEON)
+    uint32x4x2_t a = vtrnq_u32(vld1q_u32(rows[0]), vld1q_u32(rows[1]));
+    uint32x4x2_t b = vtrnq_u32(vld1q_u32(rows[2]), vld1q_u32(rows[3]));
+
+    vst1q_u32(dstRows[0], vcombine_u32(vget_low_u32(a.val[0]), vget_low_u32(b.val[0])));
+    vst1q_u32(dstRows[1], vcombine_u32(vget_low_u32(a.val[1]), vget_low_u32(b.val[1])));
+    vst1q_u32(dstRows[2], vcombine_u32(vget_high_u32(a.val[0]), vget_high_u32(b.val[0])));
+    vst1q_u32(dstRows[3], vcombine_u32(vget_high_u32(a.val[1]), vget_high_u32(b.val[1])));
+#else
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        for (uint32_t j = 0; j < 4; j++)
+            dstRows[i][j] = rows[j][i];
+    }
+#endif
 }
 
-bool keyReleased(LvnWindow* window, int keycode)
+static void rotatePixels32(const uint32_t* src, uint32_t* dst, uint32_t width, uint32_t height, bool clockwise)
 {
-    return lvn::getContext()->windowContext.keyReleased(window, keycode);
+    const uint32_t tileSize = 32;
+
+    for (uint32_t ty = 0; ty < height; ty += tileSize)
+    {
+        uint32_t yEnd = lvn::min(ty + tileSize, height);
+        for (uint32_t tx = 0; tx < width; tx += tileSize)
+        {
+            uint32_t xEnd = lvn::min(tx + tileSize, width);
+            for (uint32_t by = ty; by < yEnd; by += 4)
+            {
+                for (uint32_t bx = tx; bx < xEnd; bx += 4)
+                {
+                    if (by + 4 <= yEnd && bx + 4 <= xEnd)
+                    {
+                        // clockwise the block starts at (height - 4 - by, bx), counter clockwise at (by, width - 1 - bx) and its rows go up
+                        uint32_t* blockDst = clockwise
+                            ? dst + (size_t)bx * height + (height - 4 - by)
+                            : dst + (size_t)(width - 1 - bx) * height + by;
+                        lvn::rotateBlock4x4(src + (size_t)by * width + bx, width, blockDst, height, clockwise);
+                        continue;
+                    }
+
+                    // partial blocks at the right and bottom edges
+                    for (uint32_t y = by; y < lvn::min(by + 4, yEnd); y++)
+                    {
+                        for (uint32_t x = bx; x < lvn::min(bx + 4, xEnd); x++)
+                        {
+                            size_t dstIndex = clockwise ? (size_t)x * height + (height - 1 - y) : (size_t)(width - 1 - x) * height + y;
+                            dst[dstIndex] = src[(size_t)y * width + x];
+                        }
+                    }
+                }
+            }
+        }
+    }
 }
 
-bool mouseButtonPressed(LvnWindow* window, int button)
+void imageFlipVertically(LvnImageData& imageData)
 {
-    return lvn::getContext()->windowContext.mouseButtonPressed(window, button);
-}
+    uint8_t* data = imageData.pixels.data();
+    size_t rowSize = (size_t)imageData.width * imageData.channels;
 
-bool mouseButtonReleased(LvnWindow* window, int button)
-{
-    return lvn::getContext()->windowContext.mouseButtonReleased(window, button);
+    for (uint32_t y = 0; y < imageData.height / 2; y++)
+        lvn::swapMemory(data + y * rowSize, data + (imageData.height - y - 1) * rowSize, rowSize);
 }
 
-LvnPair<float> mouseGetPos(LvnWindow* window)
+void imageFlipHorizontally(LvnImageData& imageData)
 {
-    return lvn::getContext()->windowContext.getMousePos(window);
-}
+    uint8_t* data = imageData.pixels.data();
+    size_t rowSize = (size_t)imageData.width * imageData.channels;
 
-void mouseGetPos(LvnWindow* window, float* xpos, float* ypos)
-{
-    lvn::getContext()->windowContext.getMousePosPtr(window, xpos, ypos);
-}
+    for (uint32_t y = 0; y < imageData.height; y++)
+    {
+        uint8_t* row = data + y * rowSize;
 
-float mouseGetX(LvnWindow* window)
-{
-    return lvn::getContext()->windowContext.getMouseX(window);
+        switch (imageData.channels)
+        {
+            case 1: { lvn::reversePixels8(row, imageData.width); break; }
+            case 2: { lvn::reversePixels(reinterpret_cast<uint16_t*>(row), imageData.width); break; }
+            case 3: { lvn::reversePixels(reinterpret_cast<LvnRgbPixel*>(row), imageData.width); break; }
+            case 4: { lvn::reversePixels32(reinterpret_cast<uint32_t*>(row), imageData.width); break; }
+            default: { break; }
+        }
+    }
 }
 
-float mouseGetY(LvnWindow* window)
+static void rotateImage(LvnImageData& imageData, bool clockwise)
 {
-    return lvn::getContext()->windowContext.getMouseY(window);
-}
+    const uint8_t* data = imageData.pixels.data();
+    uint32_t width = imageData.width, height = imageData.height;
 
-void mouseSetCursor(LvnWindow* window, LvnMouseCursor cursor)
-{
-    lvn::getContext()->windowContext.setMouseCursor(window, cursor);
+    LvnVector<uint8_t> rotated((size_t)width * height * imageData.channels);
+
+    switch (imageData.channels)
+    {
+        case 1: { lvn::rotatePixels(data, rotated.data(), width, height, clockwise); break; }
+        case 2: { lvn::rotatePixels(reinterpret_cast<const uint16_t*>(data), reinterpret_cast<uint16_t*>(rotated.data()), width, height, clockwise); break; }
+        case 3: { lvn::rotatePixels(reinterpret_cast<const LvnRgbPixel*>(data), reinterpret_cast<LvnRgbPixel*>(rotated.data()), width, height, clockwise); break; }
+        case 4: { lvn::rotatePixels32(reinterpret_cast<const uint32_t*>(data), reinterpret_cast<uint32_t*>(rotated.data()), width, height, clockwise); break; }
+        default: { return; }
+    }
+
+    imageData.pixels = LvnData<uint8_t>(lvn::move(rotated));
+    lvn::swap(imageData.width, imageData.height);
 }
 
-void mouseSetInputMode(LvnWindow* window, LvnMouseInputMode mode)
+void imageRotateCW(LvnImageData& imageData)
 {
-    lvn::getContext()->windowContext.SetMouseInputMode(window, mode);
+    lvn::rotateImage(imageData, true);
 }
 
-LvnPair<int> windowGetPos(LvnWindow* window)
+void imageRotateCCW(LvnImageData& imageData)
 {
-    return lvn::getContext()->windowContext.getWindowPos(window);
+    lvn::rotateImage(imageData, false);
 }
 
-void windowGetPos(LvnWindow* window, int* xpos, int* ypos)
+void imageConvertChannels(uint8_t* dst, uint32_t dstChannels, const uint8_t* src, uint32_t srcChannels, uint64_t pixelCount)
 {
-    lvn::getContext()->windowContext.getWindowPosPtr(window, xpos, ypos);
+    LVN_CORE_ASSERT(dstChannels >= 1 && dstChannels <= 4 && srcChannels >= 1 && srcChannels <= 4, "channels must be within 1 to 4");
+
+    uint64_t i = 0;
+
+    // rgb to rgba is the common case (eg. uploading three channel images to rgba textures)
+    if (srcChannels == 3 && dstChannels == 4)
+    {
+#if defined(LVN_SIMD_SSSE3)
+        const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alpha = _mm_set1_epi32((int)0xff000000);
+        for (; i + 6 <= pixelCount; i += 4) // 16 byte loads read 4 bytes past the 4 pixels, stop while they still land on a following pixel
+        {
+            __m128i px = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i * 3)), shuffle);
+            _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(px, alpha));
+        }
+#elif defined(LVN_SIMD_NEON)
+        for (; i + 16 <= pixelCount; i += 16)
+        {
+            uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(0xff);
+            vst4q_u8(dst + i * 4, rgba);
+        }
+#endif
+        for (; i < pixelCount; i++)
+        {
+            dst[i * 4 + 0] = src[i * 3 + 0];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + 2];
+            dst[i * 4 + 3] = 0xff;
+        }
+        return;
+    }
+
+    // same rules as stb_image, gray is copied to every color channel and a missing alpha is opaque
+    for (; i < pixelCount; i++)
+    {
+        const uint8_t* s = src + i * srcChannels;
+        uint8_t* d = dst + i * dstChannels;
+
+        bool gray = srcChannels <= 2;
+        uint8_t alpha = srcChannels == 2 ? s[1] : (srcChannels == 4 ? s[3] : 0xff);
+
+        if (dstChannels <= 2)
+        {
+            // color to gray uses the same integer luma weights as stb_image
+            d[0] = gray ? s[0] : (uint8_t)((s[0] * 77 + s[1] * 150 + s[2] * 29) >> 8);
+            if (dstChannels == 2) { d[1] = alpha; }
+        }
+        else
+        {
+            d[0] = s[0];
+            d[1] = gray ? s[0] : s[1];
+            d[2] = gray ? s[0] : s[2];
+            if (dstChannels == 4) { d[3] = alpha; }
+        }
+    }
 }
 
-LvnPair<int> windowGetSize(LvnWindow* window)
+#if defined(LVN_SIMD_SSE2)
+// sse2 has no 32 bit mullo, the even and odd lanes are multiplied separately and interleaved back
+static __m128i mullo32Sse2(__m128i a, __m128i b)
 {
-    return lvn::getContext()->windowContext.getWindowSize(window);
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
 }
+#endif
 
-void windowGetSize(LvnWindow* window, int* width, int* height)
+// counter based hash (lowbias32 finalizer) of i * golden ratio + seed
+static void genNoiseHashes(uint32_t* hashes, uint32_t first, uint32_t count, uint32_t seed)
 {
-    lvn::getContext()->windowContext.getWindowSizePtr(window, width, height);
-}
+    uint32_t i = 0;
 
-// ------------------------------------------------------------
-// [SECTION]: Graphics Functions
-// ------------------------------------------------------------
+#if defined(LVN_SIMD_SSE2)
+    const __m128i golden = _mm_set1_epi32((int)0x9E3779B9);
+    const __m128i m1 = _mm_set1_epi32(0x7feb352d);
+    const __m128i m2 = _mm_set1_epi32((int)0x846ca68b);
+    const __m128i vseed = _mm_set1_epi32((int)seed);
+    const __m128i step = _mm_set1_epi32(4);
+    __m128i index = _mm_add_epi32(_mm_set1_epi32((int)first), _mm_setr_epi32(0, 1, 2, 3));
 
-LvnGraphicsApi getGraphicsApi()
-{
-    return lvn::getContext()->graphicsapi;
-}
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i x = _mm_add_epi32(lvn::mullo32Sse2(index, golden), vseed);
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+        x = lvn::mullo32Sse2(x, m1);
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+        x = lvn::mullo32Sse2(x, m2);
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+        _mm_storeu_si128((__m128i*)(hashes + i), x);
+        index = _mm_add_epi32(index, step);
+    }
+#elif defined(LVN_SIMD_NEON)
+    const uint32_t lanes[4] = { 0, 1, 2, 3 };
+    const uint32x4_t vseed = vdupq_n_u32(seed);
+    uint32x4_t index = vaddq_u32(vdupq_n_u32(first), vld1q_u32(lanes));
 
-const char* getGraphicsApiName()
-{
-    switch (lvn::getContext()->graphicsapi)
+    for (; i + 4 <= count; i += 4)
     {
-        case Lvn_GraphicsApi_None:   { return "None";   }
-        case Lvn_GraphicsApi_vulkan: { return "vulkan"; }
-        case Lvn_GraphicsApi_opengl: { return "opengl"; }
+        uint32x4_t x = vaddq_u32(vmulq_n_u32(index, 0x9E3779B9), vseed);
+        x = veorq_u32(x, vshrq_n_u32(x, 16));
+        x = vmulq_n_u32(x, 0x7feb352d);
+        x = veorq_u32(x, vshrq_n_u32(x, 15));
+        x = vmulq_n_u32(x, 0x846ca68b);
+        x = veorq_u32(x, vshrq_n_u32(x, 16));
+        vst1q_u32(hashes + i, x);
+        index = vaddq_u32(index, vdupq_n_u32(4));
     }
+#endif
 
-    LVN_CORE_ERROR("Unknown Graphics API selected!");
-    return LVN_EMPTY_STR;
+    for (; i < count; i++)
+    {
+        uint32_t x = (first + i) * 0x9E3779B9u + seed;
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        hashes[i] = x;
+    }
 }
 
-void getPhysicalDevices(LvnPhysicalDevice** pPhysicalDevices, uint32_t* deviceCount)
+LvnImageData imageSetChannels(const LvnImageData& imageData, uint32_t channels)
 {
-    uint32_t getDeviceCount;
-    lvn::getContext()->graphicsContext.getPhysicalDevices(nullptr, &getDeviceCount);
-
-    if (deviceCount != nullptr)
-        *deviceCount = getDeviceCount;
+    LVN_CORE_ASSERT(imageData.compression == Lvn_TextureCompression_None, "cannot change the channels of block compressed image data");
 
-    if (pPhysicalDevices == nullptr)
-        return;
+    uint64_t pixelCount = (uint64_t)imageData.width * imageData.height;
 
-    lvn::getContext()->graphicsContext.getPhysicalDevices(pPhysicalDevices, &getDeviceCount);
+    LvnImageData result{};
+    result.width = imageData.width;
+    result.height = imageData.height;
+    result.channels = channels;
+    result.size = pixelCount * channels;
+    result.pixels = LvnData<uint8_t>(result.size);
 
-    return;
+    lvn::imageConvertChannels(result.pixels.data(), channels, imageData.pixels.data(), imageData.channels, pixelCount);
+    return result;
 }
 
-LvnPhysicalDeviceProperties getPhysicalDeviceProperties(LvnPhysicalDevice* physicalDevice)
+LvnImageData imageGetView(const LvnImageData& imageData)
 {
-    return physicalDevice->properties;
+    LvnImageData view{};
+    view.pixels = LvnData<uint8_t>::view(imageData.pixels.data(), imageData.pixels.size());
+    view.width = imageData.width;
+    view.height = imageData.height;
+    view.channels = imageData.channels;
+    view.size = imageData.size;
+    view.compression = imageData.compression;
+    return view;
 }
 
-LvnPhysicalDeviceFeatures getPhysicalDeviceFeatures(LvnPhysicalDevice* physicalDevice)
+uint32_t imageGetMipLevelCount(uint32_t width, uint32_t height)
 {
-    return physicalDevice->features;
-}
+    uint32_t size = lvn::max(width, height);
+    uint32_t levels = 1;
 
-LvnResult checkPhysicalDeviceSupport(LvnPhysicalDevice* physicalDevice)
-{
-    if (physicalDevice == nullptr)
+    while (size > 1)
     {
-        LVN_CORE_ERROR("cannot check physical device support, physicalDevice is nullptr");
-        return Lvn_Result_Failure;
+        size >>= 1;
+        levels++;
     }
 
-    return lvn::getContext()->graphicsContext.checkPhysicalDeviceSupport(physicalDevice);
+    return levels;
 }
 
-LvnResult setPhysicalDevice(LvnPhysicalDevice* physicalDevice)
+static float imageFilterWeight(LvnImageFilter filter, float x)
 {
-    if (physicalDevice == nullptr)
+    x = fabsf(x);
+    switch (filter)
     {
-        LVN_CORE_ERROR("cannot set physical device, physicalDevice is nullptr");
-        return Lvn_Result_Failure;
+        case Lvn_ImageFilter_Box: { return x <= 0.5f ? 1.0f : 0.0f; }
+        case Lvn_ImageFilter_Bilinear: { return x < 1.0f ? 1.0f - x : 0.0f; }
+        case Lvn_ImageFilter_Lanczos:
+        {
+            if (x < 1e-5f) { return 1.0f; }
+            if (x >= 3.0f) { return 0.0f; }
+            float px = (float)M_PI * x;
+            return 3.0f * sinf(px) * sinf(px / 3.0f) / (px * px);
+        }
     }
 
-    return lvn::getContext()->graphicsContext.setPhysicalDevice(physicalDevice);
+    return 0.0f;
 }
 
-LvnClipRegion getRenderClipRegionEnum()
+static void imageGetResampleWeights(LvnImageResampleWeights* weights, uint32_t srcSize, uint32_t dstSize, LvnImageFilter filter)
 {
-    return lvn::getContext()->matrixClipRegion;
-}
+    // downscaling widens the filter by the scale so every source pixel is covered
+    float scale = (float)srcSize / dstSize;
+    float filterScale = lvn::max(scale, 1.0f);
+    float radius = filter == Lvn_ImageFilter_Lanczos ? 3.0f : (filter == Lvn_ImageFilter_Bilinear ? 1.0f : 0.5f);
+    float support = radius * filterScale;
 
-void renderCmdDraw(LvnWindow* window, uint32_t vertexCount)
-{
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    uint32_t taps = lvn::min((uint32_t)ceilf(support * 2.0f) + 2, srcSize);
+    weights->taps = taps;
+    weights->first.resize(dstSize);
+    weights->weights.resize((size_t)dstSize * taps);
+    memset(weights->weights.data(), 0, weights->weights.size() * sizeof(float));
 
-    lvn::getContext()->graphicsContext.renderCmdDraw(window, vertexCount);
-}
+    for (uint32_t i = 0; i < dstSize; i++)
+    {
+        float center = (i + 0.5f) * scale;
+        int32_t start = lvn::max((int32_t)floorf(center - support), 0);
+        int32_t end = lvn::min((int32_t)ceilf(center + support), (int32_t)srcSize);
 
-void renderCmdDrawIndexed(LvnWindow* window, uint32_t indexCount)
-{
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+        // the taps stay inside the image at the edges, the pixels the filter misses there get zero weight
+        uint32_t first = lvn::min((uint32_t)start, srcSize - taps);
+        float* w = &weights->weights[(size_t)i * taps];
+        weights->first[i] = first;
 
-    lvn::getContext()->graphicsContext.renderCmdDrawIndexed(window, indexCount);
-}
+        float sum = 0.0f;
+        for (int32_t j = start; j < end && (uint32_t)j < first + taps; j++)
+        {
+            float weight = lvn::imageFilterWeight(filter, (j + 0.5f - center) / filterScale);
+            w[j - first] = weight;
+            sum += weight;
+        }
 
-void renderCmdDrawInstanced(LvnWindow* window, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstInstance)
-{
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+        // a box that falls between pixels takes the nearest one
+        if (sum == 0.0f)
+        {
+            uint32_t nearest = lvn::min(lvn::max((uint32_t)center, first), first + taps - 1);
+            w[nearest - first] = 1.0f;
+            sum = 1.0f;
+        }
 
-    lvn::getContext()->graphicsContext.renderCmdDrawInstanced(window, vertexCount, instanceCount, firstInstance);
+        for (uint32_t t = 0; t < taps; t++)
+            w[t] /= sum;
+    }
 }
 
-void renderCmdDrawIndexedInstanced(LvnWindow* window, uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance)
+// srgb to linear of every 8 bit value, and the linear values halfway between neighbouring 8 bit values to round back correctly
+struct LvnSrgbTables
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
-
-    lvn::getContext()->graphicsContext.renderCmdDrawIndexedInstanced(window, indexCount, instanceCount, firstInstance);
-}
+    float toLinear[256];
+    float thresholds[256];              // [i] is where values start rounding to i, [0] is never read
+};
 
-void renderCmdSetStencilReference(uint32_t reference)
+static const LvnSrgbTables& getSrgbTables()
 {
+    static const LvnSrgbTables tables = []()
+    {
+        LvnSrgbTables result;
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            float c = i / 255.0f;
+            result.toLinear[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
 
+            float h = (i - 0.5f) / 255.0f;
+            result.thresholds[i] = h <= 0.04045f ? h / 12.92f : powf((h + 0.055f) / 1.055f, 2.4f);
+        }
+        return result;
+    }();
+
+    return tables;
 }
 
-void renderCmdSetStencilMask(uint32_t compareMask, uint32_t writeMask)
+static void imageToLinearRows(uint32_t start, uint32_t end, void* userData)
 {
+    const LvnImageLinearData* data = static_cast<const LvnImageLinearData*>(userData);
+    const LvnSrgbTables& tables = lvn::getSrgbTables();
+    uint32_t channels = data->channels;
+    uint32_t alpha = (channels == 2 || channels == 4) ? channels - 1 : channels;
+    size_t rowSize = (size_t)data->width * channels;
 
-}
+    for (uint32_t y = start; y < end; y++)
+    {
+        const uint8_t* src = data->src + y * rowSize;
+        float* dst = data->linear + y * rowSize;
 
-void renderBeginNextFrame(LvnWindow* window)
-{
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+        for (uint32_t x = 0; x < data->width; x++)
+        {
+            const uint8_t* s = src + x * channels;
+            float* d = dst + x * channels;
+            float a = alpha < channels ? s[alpha] / 255.0f : 1.0f;
 
-    lvn::getContext()->graphicsContext.renderBeginNextFrame(window);
+            for (uint32_t c = 0; c < channels; c++)
+            {
+                if (c == alpha) { d[c] = a; continue; }
+                d[c] = (data->srgb ? tables.toLinear[s[c]] : s[c] / 255.0f) * a;
+            }
+        }
+    }
 }
 
-void renderDrawSubmit(LvnWindow* window)
+static void imageFromLinearRows(uint32_t start, uint32_t end, void* userData)
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    const LvnImageLinearData* data = static_cast<const LvnImageLinearData*>(userData);
+    const LvnSrgbTables& tables = lvn::getSrgbTables();
+    uint32_t channels = data->channels;
+    uint32_t alpha = (channels == 2 || channels == 4) ? channels - 1 : channels;
+    size_t rowSize = (size_t)data->width * channels;
 
-    lvn::getContext()->graphicsContext.renderDrawSubmit(window);
-}
+    for (uint32_t y = start; y < end; y++)
+    {
+        const float* src = data->linear + y * rowSize;
+        uint8_t* dst = data->dst + y * rowSize;
 
-void renderBeginCommandRecording(LvnWindow* window)
-{
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+        for (uint32_t x = 0; x < data->width; x++)
+        {
+            const float* s = src + x * channels;
+            uint8_t* d = dst + x * channels;
 
-    lvn::getContext()->graphicsContext.renderBeginCommandRecording(window);
-}
+            // lanczos can overshoot, values are clamped after the alpha is divided out
+            float a = alpha < channels ? lvn::clamp(s[alpha], 0.0f, 1.0f) : 1.0f;
+            float invAlpha = a > 0.0f ? 1.0f / a : 0.0f;
 
-void renderEndCommandRecording(LvnWindow* window)
-{
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+            for (uint32_t c = 0; c < channels; c++)
+            {
+                if (c == alpha) { d[c] = (uint8_t)(a * 255.0f + 0.5f); continue; }
 
-    lvn::getContext()->graphicsContext.renderEndCommandRecording(window);
+                float v = lvn::clamp(s[c] * invAlpha, 0.0f, 1.0f);
+                if (!data->srgb)
+                {
+                    d[c] = (uint8_t)(v * 255.0f + 0.5f);
+                    continue;
+                }
+
+                // largest value whose threshold is not above v
+                uint32_t index = 0;
+                for (uint32_t step = 128; step > 0; step >>= 1)
+                {
+                    if (index + step < 256 && v >= tables.thresholds[index + step])
+                        index += step;
+                }
+                d[c] = (uint8_t)index;
+            }
+        }
+    }
 }
 
-void renderCmdBeginRenderPass(LvnWindow* window, float r, float g, float b, float a)
+static void imageToLinear(const LvnImageData& imageData, float* linear, bool srgb)
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    LvnImageLinearData data{};
+    data.src = imageData.pixels.data();
+    data.linear = linear;
+    data.width = imageData.width;
+    data.channels = imageData.channels;
+    data.srgb = srgb;
 
-    lvn::getContext()->graphicsContext.renderCmdBeginRenderPass(window, r, g, b, a);
+    lvn::parallelFor(imageData.height, 0, lvn::imageToLinearRows, &data);
 }
 
-void renderCmdEndRenderPass(LvnWindow* window)
+static void imageFromLinear(LvnImageData& imageData, float* linear, bool srgb)
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    LvnImageLinearData data{};
+    data.dst = imageData.pixels.data();
+    data.linear = linear;
+    data.width = imageData.width;
+    data.channels = imageData.channels;
+    data.srgb = srgb;
 
-    lvn::getContext()->graphicsContext.renderCmdEndRenderPass(window);
+    lvn::parallelFor(imageData.height, 0, lvn::imageFromLinearRows, &data);
 }
 
-void renderCmdBindPipeline(LvnWindow* window, LvnPipeline* pipeline)
+static void imageResampleHorizontalRows(uint32_t start, uint32_t end, void* userData)
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    const LvnImageResampleData* data = static_cast<const LvnImageResampleData*>(userData);
+    const LvnImageResampleWeights& weights = *data->horizontal;
+    uint32_t channels = data->channels;
+    uint32_t taps = weights.taps;
 
-    lvn::getContext()->graphicsContext.renderCmdBindPipeline(window, pipeline);
-}
+    for (uint32_t y = start; y < end; y++)
+    {
+        const float* src = data->src + (size_t)y * data->srcWidth * channels;
+        float* dst = data->tmp + (size_t)y * data->dstWidth * channels;
 
-void renderCmdBindVertexBuffer(LvnWindow* window, uint32_t firstBinding, uint32_t bindingCount, LvnBuffer** pBuffers, uint64_t* pOffsets)
-{
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+        for (uint32_t x = 0; x < data->dstWidth; x++)
+        {
+            const float* w = &weights.weights[(size_t)x * taps];
+            const float* s = src + (size_t)weights.first[x] * channels;
+            float* d = dst + (size_t)x * channels;
 
-    uint64_t offsets[] = {0};
-    lvn::getContext()->graphicsContext.renderCmdBindVertexBuffer(window, firstBinding, bindingCount, pBuffers, pOffsets ? pOffsets : offsets);
+#if defined(LVN_SIMD_MATH)
+            // rgba pixels are one vector, each tap is a single multiply add
+            if (channels == 4)
+            {
+                LvnSimdFloat4 sum = lvn::simdSplat(0.0f);
+                for (uint32_t t = 0; t < taps; t++)
+                    sum = lvn::simdMulAdd(lvn::simdLoad(s + t * 4), lvn::simdSplat(w[t]), sum);
+                lvn::simdStore(d, sum);
+                continue;
+            }
+#endif
+            for (uint32_t c = 0; c < channels; c++)
+            {
+                float sum = 0.0f;
+                for (uint32_t t = 0; t < taps; t++)
+                    sum += s[t * channels + c] * w[t];
+                d[c] = sum;
+            }
+        }
+    }
 }
 
-void renderCmdBindIndexBuffer(LvnWindow* window, LvnBuffer* buffer, uint64_t offset)
+// weighted sum of taps rows of count floats each stride floats apart
+static void imageResampleColumnsDefault(const float* src, size_t stride, const float* weights, uint32_t taps, float* dst, size_t count)
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    size_t i = 0;
+
+#if defined(LVN_SIMD_MATH)
+    for (; i + 4 <= count; i += 4)
+    {
+        LvnSimdFloat4 sum = lvn::simdSplat(0.0f);
+        for (uint32_t t = 0; t < taps; t++)
+            sum = lvn::simdMulAdd(lvn::simdLoad(src + t * stride + i), lvn::simdSplat(weights[t]), sum);
+        lvn::simdStore(dst + i, sum);
+    }
+#endif
 
-    lvn::getContext()->graphicsContext.renderCmdBindIndexBuffer(window, buffer, offset);
+    for (; i < count; i++)
+    {
+        float sum = 0.0f;
+        for (uint32_t t = 0; t < taps; t++)
+            sum += src[t * stride + i] * weights[t];
+        dst[i] = sum;
+    }
 }
 
-void renderCmdBindDescriptorSets(LvnWindow* window, LvnPipeline* pipeline, uint32_t firstSetIndex, uint32_t descriptorSetCount, LvnDescriptorSet** pDescriptorSets)
+#if defined(LVN_SIMD_AVX2_DISPATCH)
+LVN_TARGET_AVX2 static void imageResampleColumnsAvx2(const float* src, size_t stride, const float* weights, uint32_t taps, float* dst, size_t count)
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 sum = _mm256_setzero_ps();
+        for (uint32_t t = 0; t < taps; t++)
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(src + t * stride + i), _mm256_set1_ps(weights[t]), sum);
+        _mm256_storeu_ps(dst + i, sum);
+    }
 
-    lvn::getContext()->graphicsContext.renderCmdBindDescriptorSets(window, pipeline, firstSetIndex, descriptorSetCount, pDescriptorSets);
+    if (i < count)
+        lvn::imageResampleColumnsDefault(src + i, stride, weights, taps, dst + i, count - i);
 }
+#endif
 
-void renderCmdBeginFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
+static void imageResampleVerticalRows(uint32_t start, uint32_t end, void* userData)
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    const LvnImageResampleData* data = static_cast<const LvnImageResampleData*>(userData);
+    const LvnImageResampleWeights& weights = *data->vertical;
+    size_t rowSize = (size_t)data->dstWidth * data->channels;
 
-    lvn::getContext()->graphicsContext.renderCmdBeginFrameBuffer(window, frameBuffer);
+    for (uint32_t y = start; y < end; y++)
+        data->resampleColumns(data->tmp + weights.first[y] * rowSize, rowSize, &weights.weights[(size_t)y * weights.taps], weights.taps, data->dst + y * rowSize, rowSize);
 }
 
-void renderCmdEndFrameBuffer(LvnWindow* window, LvnFrameBuffer* frameBuffer)
+// separable, rows are filtered horizontally into a temporary image which is then filtered vertically, both passes split the rows across the job workers
+static void imageResampleLinear(const float* src, uint32_t srcWidth, uint32_t srcHeight, float* dst, uint32_t dstWidth, uint32_t dstHeight, uint32_t channels, LvnImageFilter filter)
 {
-    int width, height;
-    lvn::windowGetSize(window, &width, &height);
-    if (width * height <= 0) { return; }
+    static void (*const s_ResampleColumns)(const float*, size_t, const float*, uint32_t, float*, size_t) = []()
+    {
+#if defined(LVN_SIMD_AVX2_DISPATCH)
+        if (lvn::cpuSupportsAvx2())
+            return lvn::imageResampleColumnsAvx2;
+#endif
+        return lvn::imageResampleColumnsDefault;
+    }();
 
-    lvn::getContext()->graphicsContext.renderCmdEndFrameBuffer(window, frameBuffer);
+    LvnImageResampleWeights horizontal, vertical;
+    lvn::imageGetResampleWeights(&horizontal, srcWidth, dstWidth, filter);
+    lvn::imageGetResampleWeights(&vertical, srcHeight, dstHeight, filter);
+
+    LvnVector<float> tmp((size_t)srcHeight * dstWidth * channels);
+
+    LvnImageResampleData data{};
+    data.src = src;
+    data.dst = dst;
+    data.tmp = tmp.data();
+    data.srcWidth = srcWidth;
+    data.dstWidth = dstWidth;
+    data.channels = channels;
+    data.horizontal = &horizontal;
+    data.vertical = &vertical;
+    data.resampleColumns = s_ResampleColumns;
+
+    lvn::parallelFor(srcHeight, 0, lvn::imageResampleHorizontalRows, &data);
+    lvn::parallelFor(dstHeight, 0, lvn::imageResampleVerticalRows, &data);
 }
 
-LvnResult createShaderFromSrc(LvnShader** shader, const LvnShaderCreateInfo* createInfo)
+LvnImageData imageResize(const LvnImageData& imageData, uint32_t width, uint32_t height, LvnImageFilter filter, bool srgb)
 {
-    LvnContext* lvnctx = lvn::getContext();
+    LVN_CORE_ASSERT(imageData.compression == Lvn_TextureCompression_None, "cannot resize block compressed image data");
+    LVN_CORE_ASSERT(imageData.channels >= 1 && imageData.channels <= 4, "channels must be within 1 to 4");
 
-    if (createInfo->vertexSrc.empty())
+    LvnImageData result{};
+    if (width == 0 || height == 0 || imageData.width == 0 || imageData.height == 0)
     {
-        LVN_CORE_ERROR("createShaderFromSrc(LvnShader**, LvnShaderCreateInfo*) | createInfo->vertexSrc is nullptr, cannot create shader without the vertex shader source");
-        return Lvn_Result_Failure;
+        LVN_CORE_ERROR("imageResize(const LvnImageData&, uint32_t, uint32_t, LvnImageFilter, bool) | cannot resize image of %u x %u to %u x %u", imageData.width, imageData.height, width, height);
+        return result;
     }
 
-    if (createInfo->fragmentSrc.empty())
-    {
-        LVN_CORE_ERROR("createShaderFromSrc(LvnShader**, LvnShaderCreateInfo*) | createInfo->fragmentSrc is nullptr, cannot create shader without the fragment shader source");
-        return Lvn_Result_Failure;
-    }
+    result.width = width;
+    result.height = height;
+    result.channels = imageData.channels;
+    result.size = (uint64_t)width * height * imageData.channels;
+    result.pixels = LvnData<uint8_t>(result.size);
 
-    *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+    LvnVector<float> src((size_t)imageData.width * imageData.height * imageData.channels);
+    LvnVector<float> dst(result.size);
 
-    LVN_CORE_TRACE("created shader (from source): (%p)", *shader);
-    return lvnctx->graphicsContext.createShaderFromSrc(*shader, createInfo);
+    lvn::imageToLinear(imageData, src.data(), srgb);
+    lvn::imageResampleLinear(src.data(), imageData.width, imageData.height, dst.data(), width, height, imageData.channels, filter);
+    lvn::imageFromLinear(result, dst.data(), srgb);
+    return result;
 }
 
-LvnResult createShaderFromFileSrc(LvnShader** shader, const LvnShaderCreateInfo* createInfo)
+LvnVector<LvnImageData> imageGenerateMips(const LvnImageData& imageData, LvnImageFilter filter, bool srgb)
 {
-    LvnContext* lvnctx = lvn::getContext();
+    LVN_CORE_ASSERT(imageData.compression == Lvn_TextureCompression_None, "cannot generate mips of block compressed image data");
+    LVN_CORE_ASSERT(imageData.channels >= 1 && imageData.channels <= 4, "channels must be within 1 to 4");
 
-    if (createInfo->vertexSrc.empty())
-    {
-        LVN_CORE_ERROR("createShaderFromFileSrc(LvnShader**, LvnShaderCreateInfo*) | createInfo->vertexSrc is nullptr, cannot create shader without the vertex shader source");
-        return Lvn_Result_Failure;
-    }
+    LvnVector<LvnImageData> mips;
+    if (imageData.width == 0 || imageData.height == 0) { return mips; }
 
-    if (createInfo->fragmentSrc.empty())
+    uint32_t channels = imageData.channels;
+    uint32_t width = imageData.width, height = imageData.height;
+    uint32_t levels = lvn::imageGetMipLevelCount(width, height);
+
+    // each level is filtered from the linear floats of the level above so rounding errors do not add up down the chain
+    LvnVector<float> src((size_t)width * height * channels);
+    LvnVector<float> dst;
+    lvn::imageToLinear(imageData, src.data(), srgb);
+
+    for (uint32_t i = 1; i < levels; i++)
     {
-        LVN_CORE_ERROR("createShaderFromFileSrc(LvnShader**, LvnShaderCreateInfo*) | createInfo->fragmentSrc is nullptr, cannot create shader without the fragment shader source");
-        return Lvn_Result_Failure;
+        uint32_t mipWidth = lvn::max(width >> 1, 1u);
+        uint32_t mipHeight = lvn::max(height >> 1, 1u);
+
+        dst.resize((size_t)mipWidth * mipHeight * channels);
+        lvn::imageResampleLinear(src.data(), width, height, dst.data(), mipWidth, mipHeight, channels, filter);
+
+        LvnImageData mip{};
+        mip.width = mipWidth;
+        mip.height = mipHeight;
+        mip.channels = channels;
+        mip.size = (uint64_t)mipWidth * mipHeight * channels;
+        mip.pixels = LvnData<uint8_t>(mip.size);
+        lvn::imageFromLinear(mip, dst.data(), srgb);
+        mips.push_back(lvn::move(mip));
+
+        lvn::swap(src, dst);
+        width = mipWidth;
+        height = mipHeight;
     }
 
-    *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+    return mips;
+}
 
-    LVN_CORE_TRACE("created shader (from source file): (%p), vertex file: %s, fragment file: %s", *shader, createInfo->vertexSrc.c_str(), createInfo->fragmentSrc.c_str());
-    return lvnctx->graphicsContext.createShaderFromFileSrc(*shader, createInfo);
+LvnImageData imageGenWhiteNoise(uint32_t width, uint32_t height, uint32_t channels)
+{
+    return lvn::imageGenWhiteNoise(width, height, channels, time(0));
 }
 
-LvnResult createShaderFromFileBin(LvnShader** shader, const LvnShaderCreateInfo* createInfo)
+LvnImageData imageGenWhiteNoise(uint32_t width, uint32_t height, uint32_t channels, uint32_t seed)
 {
-    LvnContext* lvnctx = lvn::getContext();
+    LVN_CORE_ASSERT(channels > 0 && channels <= 4, "channels must be within 0 to 4");
 
-    if (createInfo->vertexSrc.empty())
-    {
-        LVN_CORE_ERROR("createShaderFileBin(LvnShader**, LvnShaderCreateInfo*) | createInfo->vertexSrc is nullptr, cannot create shader without the vertex shader source");
-        return Lvn_Result_Failure;
-    }
+    uint32_t imgSize = width * height * channels;
+    LvnData<uint8_t> pixels(imgSize);
+    uint8_t* imgBuff = pixels.data();
 
-    if (createInfo->fragmentSrc.empty())
+    // each pixel is a hash of its index so the noise only depends on the seed and chunks can be generated in simd lanes
+    uint32_t hashes[256];
+    uint32_t pixelCount = width * height;
+    for (uint32_t first = 0; first < pixelCount; first += 256)
     {
-        LVN_CORE_ERROR("createShaderFileBin(LvnShader**, LvnShaderCreateInfo*) | createInfo->fragmentSrc is nullptr, cannot create shader without the fragment shader source");
-        return Lvn_Result_Failure;
+        uint32_t count = lvn::min(pixelCount - first, 256u);
+        lvn::genNoiseHashes(hashes, first, count, seed);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint8_t value = (hashes[i] >> 31) ? 255 : 0;
+            uint8_t* px = imgBuff + (size_t)(first + i) * channels;
+            for (uint32_t c = 0; c < channels; c++)
+                px[c] = c == 3 ? 255 : value;
+        }
     }
 
-    *shader = lvn::createObject<LvnShader>(lvnctx, Lvn_Stype_Shader);
+    LvnImageData imageData{};
+    imageData.width = width;
+    imageData.height = height;
+    imageData.channels = channels;
+    imageData.size = width * height * channels;
+    imageData.pixels = lvn::move(pixels);
 
-    LVN_CORE_TRACE("created shader (from binary file): (%p), vertex file: %s, fragment file: %s", *shader, createInfo->vertexSrc.c_str(), createInfo->fragmentSrc.c_str());
-    return lvnctx->graphicsContext.createShaderFromFileBin(*shader, createInfo);
+    return imageData;
 }
 
-LvnResult createDescriptorLayout(LvnDescriptorLayout** descriptorLayout, const LvnDescriptorLayoutCreateInfo* createInfo)
+LvnImageData imageGenGrayScaleNoise(uint32_t width, uint32_t height, uint32_t channels)
 {
-    LvnContext* lvnctx = lvn::getContext();
+    return lvn::imageGenGrayScaleNoise(width, height, channels, time(0));
+}
 
-    if (!createInfo->descriptorBindingCount)
-    {
-        LVN_CORE_ERROR("createDescriptorLayout(LvnDescriptorLayout**, LvnDescriptorLayoutCreateInfo*) | createInfo->descriptorBindingCount is 0, cannot create descriptor layout without the descriptor bindings count");
-        return Lvn_Result_Failure;
-    }
+LvnImageData imageGenGrayScaleNoise(uint32_t width, uint32_t height, uint32_t channels, uint32_t seed)
+{
+    LVN_CORE_ASSERT(channels > 0 && channels <= 4, "channels must be within 0 to 4");
 
-    if (!createInfo->pDescriptorBindings)
-    {
-        LVN_CORE_ERROR("createDescriptorLayout(LvnDescriptorLayout**, LvnDescriptorLayoutCreateInfo*) | createInfo->pDescriptorBindings is nullptr, cannot create descriptor layout without the pointer to the array of descriptor bindings");
-        return Lvn_Result_Failure;
-    }
+    uint32_t imgSize = width * height * channels;
+    LvnData<uint8_t> pixels(imgSize);
+    uint8_t* imgBuff = pixels.data();
 
-    for (uint32_t i = 0; i < createInfo->descriptorBindingCount; i++)
+    // each pixel is a hash of its index so the noise only depends on the seed and chunks can be generated in simd lanes
+    uint32_t hashes[256];
+    uint32_t pixelCount = width * height;
+    for (uint32_t first = 0; first < pixelCount; first += 256)
     {
-        if (createInfo->pDescriptorBindings[i].maxAllocations == 0)
-            LVN_CORE_WARN("createDescriptorLayout(LvnDescriptorLayout**, LvnDescriptorLayoutCreateInfo*) | createInfo->pDescriptorBindings[%u].maxAllocations is 0, no descriptors will be allocated for this binding which may not be intentional", i);
+        uint32_t count = lvn::min(pixelCount - first, 256u);
+        lvn::genNoiseHashes(hashes, first, count, seed);
 
-        if (createInfo->pDescriptorBindings[i].descriptorCount == 0)
-            LVN_CORE_WARN("createDescriptorLayout(LvnDescriptorLayout**, LvnDescriptorLayoutCreateInfo*) | createInfo->pDescriptorBindings[%u].descriptorCount is 0, no descriptors will be created for this binding which may not be intentional", i);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint8_t value = (uint8_t)(hashes[i] >> 24);
+            uint8_t* px = imgBuff + (size_t)(first + i) * channels;
+            for (uint32_t c = 0; c < channels; c++)
+                px[c] = c == 3 ? 255 : value;
+        }
     }
 
-    *descriptorLayout = lvn::createObject<LvnDescriptorLayout>(lvnctx, Lvn_Stype_DescriptorLayout);
-
-    LvnDescriptorLayout* descriptorLayoutPtr = *descriptorLayout;
-    descriptorLayoutPtr->descriptorSets.resize(createInfo->maxSets);
-    descriptorLayoutPtr->descriptorSetIndex = 0;
+    LvnImageData imageData{};
+    imageData.width = width;
+    imageData.height = height;
+    imageData.channels = channels;
+    imageData.size = width * height * channels;
+    imageData.pixels = lvn::move(pixels);
 
-    LVN_CORE_TRACE("created descriptorLayout: (%p), descriptor binding count: %u", *descriptorLayout, createInfo->descriptorBindingCount);
-    return lvnctx->graphicsContext.createDescriptorLayout(*descriptorLayout, createInfo);
+    return imageData;
 }
 
-LvnResult allocateDescriptorSet(LvnDescriptorSet** descriptorSet, LvnDescriptorLayout* descriptorLayout)
+LvnModel loadModel(const char* filepath)
 {
-    LvnContext* lvnctx = lvn::getContext();
-
-    *descriptorSet = &descriptorLayout->descriptorSets[descriptorLayout->descriptorSetIndex++];
+    LvnVertexLayout layout{};
+    layout.attributes = Lvn_VertexAttributeFlag_All;
+    layout.quantized = false;
 
-    LVN_CORE_TRACE("allocated descriptorSet: (%p) from descriptorLayout: (%p)", *descriptorSet, descriptorLayout);
-    return lvnctx->graphicsContext.allocateDescriptorSet(*descriptorSet, descriptorLayout);
+    return lvn::loadModel(filepath, layout);
 }
 
-LvnResult createPipeline(LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo)
+LvnModel loadModel(const char* filepath, const LvnVertexLayout& layout, LvnMeshOptimizeFlagBits optimize)
 {
-    LvnContext* lvnctx = lvn::getContext();
+    LVN_PROFILE_FUNCTION();
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Loaders);
+    LvnString filepathstr(filepath);
+    LvnString extensionType = filepathstr.substr(filepathstr.find_last_of(".") + 1);
 
-    // vertex binding descriptions
-    if (!createInfo->pVertexBindingDescriptions)
+    if (extensionType == "gltf")
     {
-        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->pVertexBindingDescriptions is nullptr; cannot create vertex buffer without the vertex binding descriptions");
-        return Lvn_Result_Failure;
+        return lvn::loadGltfModel(filepath, layout, optimize);
     }
-    else if (!createInfo->vertexBindingDescriptionCount)
+    else if (extensionType == "glb")
     {
-        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->vertexBindingDescriptionCount is 0; cannot create vertex buffer without the vertex binding descriptions");
-        return Lvn_Result_Failure;
+        return lvn::loadGlbModel(filepath, layout, optimize);
     }
-
-    // vertex attributes
-    if (!createInfo->pVertexAttributes)
+    else if (extensionType == "obj")
     {
-        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->pVertexAttributes is nullptr; cannot create vertex buffer without the vertex attributes");
-        return Lvn_Result_Failure;
+        return lvn::loadObjModel(filepath, layout, optimize);
     }
-    else if (!createInfo->vertexAttributeCount)
+    else if (extensionType == "lvnmodel")
     {
-        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->vertexAttributeCount is 0; cannot create vertex buffer without the vertex attributes");
+        return lvn::loadLvnModel(filepath);
+    }
+
+    LVN_CORE_WARN("loadModel(const char*, const LvnVertexLayout&, LvnMeshOptimizeFlagBits) | could not load model, file extension type not recognized (%s), Filepath: %s", extensionType.c_str(), filepath);
+    return {};
+}
+
+LvnResult cookModel(const char* filepath, const char* outpath, const LvnVertexLayout* layout, LvnMeshOptimizeFlagBits optimize)
+{
+    LVN_PROFILE_FUNCTION();
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Loaders);
+    LvnString filepathstr(filepath);
+    LvnString extensionType = filepathstr.substr(filepathstr.find_last_of(".") + 1);
+
+    // the loaders record cpu copies of what they upload, the cooked file is written from those and the loaded model
+    LvnModelCookData cook{};
+    LvnModel model{};
+
+    LvnVertexLayout vertexLayout{};
+    vertexLayout.attributes = Lvn_VertexAttributeFlag_All;
+    vertexLayout.quantized = false;
+    if (layout) vertexLayout = *layout;
+
+    if (extensionType == "gltf")
+        model = lvn::loadGltfModel(filepath, vertexLayout, optimize, &cook);
+    else if (extensionType == "glb")
+        model = lvn::loadGlbModel(filepath, vertexLayout, optimize, &cook);
+    else if (extensionType == "obj")
+        model = lvn::loadObjModel(filepath, vertexLayout, optimize, &cook);
+    else
+    {
+        LVN_CORE_ERROR("cookModel(const char*, const char*, const LvnVertexLayout*, LvnMeshOptimizeFlagBits) | cannot cook model, file extension type not recognized (%s), Filepath: %s", extensionType.c_str(), filepath);
         return Lvn_Result_Failure;
     }
 
-    for (uint32_t i = 0; i < createInfo->vertexAttributeCount; i++)
+    if (model.meshes.empty())
     {
-        if (createInfo->pVertexAttributes[i].format == Lvn_AttributeFormat_Undefined)
-        {
-            LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->pVertexAttributes[%d].type is Lvn_AttributeFormat_Undefined, cannot create vertex buffer without a vertex data type", i);
-            return Lvn_Result_Failure;
-        }
+        LVN_CORE_ERROR("cookModel(const char*, const char*, const LvnVertexLayout*, LvnMeshOptimizeFlagBits) | failed to load model, Filepath: %s", filepath);
+        lvn::unloadModel(&model);
+        return Lvn_Result_Failure;
     }
 
-    *pipeline = lvn::createObject<LvnPipeline>(lvnctx, Lvn_Stype_Pipeline);
+    LvnResult result = lvn::writeLvnModel(outpath, model, cook);
+    lvn::unloadModel(&model);
 
-    LVN_CORE_TRACE("created pipeline: (%p)", *pipeline);
-    return lvnctx->graphicsContext.createPipeline(*pipeline, createInfo);
+    return result;
 }
 
-LvnResult createFrameBuffer(LvnFrameBuffer** frameBuffer, const LvnFrameBufferCreateInfo* createInfo)
+void unloadModel(LvnModel* model)
 {
-    LvnContext* lvnctx = lvn::getContext();
+    lvn::hotReloadRemoveObject(lvn::getContext(), model);
 
-    if (createInfo->pColorAttachments == nullptr)
+    for (uint32_t i = 0; i < model->samplers.size(); i++)
     {
-        LVN_CORE_ERROR("createFrameBuffer(LvnFrameBuffer**, LvnFrameBufferCreateInfo*) | createInfo->pColorAttachments is nullptr, cannot create framebuffer without one or more color attachments");
-        return Lvn_Result_Failure;
+        lvn::destroySampler(model->samplers[i]);
     }
-
-    uint32_t totalAttachments = createInfo->colorAttachmentCount + (createInfo->depthAttachment != nullptr ? 1 : 0);
-
-    for (uint32_t i = 0; i < createInfo->colorAttachmentCount; i++)
+    for (uint32_t i = 0; i < model->textures.size(); i++)
     {
-        if (createInfo->pColorAttachments[i].index >= totalAttachments)
-        {
-            LVN_CORE_ERROR("createFrameBuffer(LvnFrameBuffer**, LvnFrameBufferCreateInfo*) | createInfo->pColorAttachments[%u].index is greater than or equal to total attachments, color attachment index must be less than the total number of attachments", i);
-            return Lvn_Result_Failure;
-        }
-        if (createInfo->depthAttachment != nullptr && createInfo->pColorAttachments[i].index == createInfo->depthAttachment->index)
-        {
-            LVN_CORE_ERROR("createFrameBuffer(LvnFrameBuffer**, LvnFrameBufferCreateInfo*) | createInfo->pColorAttachments[%u].index has the same value as createInfo->depthAttachment->index, color attachment index must not be the same as the depth attachment index", i);
-            return Lvn_Result_Failure;
-        }
+        lvn::destroyTexture(model->textures[i]);
     }
-
-    if (createInfo->depthAttachment != nullptr)
+    for (uint32_t i = 0; i < model->buffers.size(); i++)
     {
-        if (createInfo->depthAttachment->index >= totalAttachments)
-        {
-            LVN_CORE_ERROR("createFrameBuffer(LvnFrameBuffer**, LvnFrameBufferCreateInfo*) | createInfo->pColorAttachments[%u].index is greater than or equal to total attachments, depth attachment index must be less than the total number of attachments");
-            return Lvn_Result_Failure;
-        }
+        lvn::destroyBuffer(model->buffers[i]);
+    }
+    for (uint32_t i = 0; i < model->skins.size(); i++)
+    {
+        lvn::destroyBuffer(model->skins[i].ssbo);
     }
-
-    *frameBuffer = lvn::createObject<LvnFrameBuffer>(lvnctx, Lvn_Stype_FrameBuffer);
-
-    LVN_CORE_TRACE("created framebuffer: (%p)", *frameBuffer);
-    return lvnctx->graphicsContext.createFrameBuffer(*frameBuffer, createInfo);
 }
 
-LvnResult createBuffer(LvnBuffer** buffer, const LvnBufferCreateInfo* createInfo)
+struct LvnAnimationUpdateData
 {
-    LvnContext* lvnctx = lvn::getContext();
+    LvnModel** models;
+    const uint64_t* jointOffsets; // first joint matrix of the skins of each model
+    LvnMat4* jointMatrices;
+    uint32_t animation;
+    float dt;
+};
 
-    // check valid buffer type
-    if (createInfo->type == Lvn_BufferType_Unknown)
+// returns the keyframe that starts the segment containing time, the cursor of the last sample is tried
+// first since playback mostly stays in or moves to the next segment, else the keyframes are binary searched
+static uint32_t animationFindKeyFrame(LvnAnimationChannel* channel, float time)
+{
+    const float* keyFrames = channel->keyFrames.data();
+    uint32_t last = channel->keyFrames.size() - 1;
+    uint32_t cursor = channel->cursor;
+
+    if (cursor < last && keyFrames[cursor] <= time)
     {
-        LVN_CORE_ERROR("createBuffer(LvnBuffer*, LvnBufferCreateInfo*) | createInfo->type is \'Lvn_BufferType_Unknown\'; cannot create vertex buffer without knowing the type of buffer usage");
-        return Lvn_Result_Failure;
+        if (time < keyFrames[cursor + 1])
+            return cursor;
+        if (cursor + 1 < last && time < keyFrames[cursor + 2])
+            return channel->cursor = cursor + 1;
     }
 
-    *buffer = lvn::createObject<LvnBuffer>(lvnctx, Lvn_Stype_Buffer);
+    uint32_t low = 0, high = last;
+    while (high - low > 1)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        if (keyFrames[mid] <= time)
+            low = mid;
+        else
+            high = mid;
+    }
 
-    LVN_CORE_TRACE("created buffer: (%p)", *buffer);
-    return lvnctx->graphicsContext.createBuffer(*buffer, createInfo);
-}
+    return channel->cursor = low;
+}
+
+// spherical interpolation of two rotations of 4 floats, the component order does not matter as long as both use the same one
+// takes the shortest path and falls back to a normalized lerp when the rotations are nearly equal
+static void quatSlerp(const float* q1, const float* q2, float t, float* q)
+{
+#if defined(LVN_SIMD_SSE2)
+    __m128 a = _mm_loadu_ps(q1);
+    __m128 b = _mm_loadu_ps(q2);
+    __m128 d = _mm_mul_ps(a, b);
+    d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+    d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+    float cosTheta = _mm_cvtss_f32(d);
+#elif defined(LVN_SIMD_NEON)
+    float32x4_t a = vld1q_f32(q1);
+    float32x4_t b = vld1q_f32(q2);
+    float32x4_t d = vmulq_f32(a, b);
+    float32x2_t s = vadd_f32(vget_low_f32(d), vget_high_f32(d));
+    float cosTheta = vget_lane_f32(vpadd_f32(s, s), 0);
+#else
+    float cosTheta = q1[0] * q2[0] + q1[1] * q2[1] + q1[2] * q2[2] + q1[3] * q2[3];
+#endif
 
-LvnResult createSampler(LvnSampler** sampler, const LvnSamplerCreateInfo* createInfo)
-{
-    LvnContext* lvnctx = lvn::getContext();
+    float sign = cosTheta < 0.0f ? -1.0f : 1.0f;
+    cosTheta *= sign;
 
-    *sampler = lvn::createObject<LvnSampler>(lvnctx, Lvn_Stype_Sampler);
+    float w1 = 1.0f - t, w2 = t;
+    if (cosTheta < 0.9995f)
+    {
+        float sinTheta = sqrtf(1.0f - cosTheta * cosTheta);
+        float angle = lvn::fastAtan2(sinTheta, cosTheta);
+        float invSin = 1.0f / sinTheta;
+        w1 = lvn::fastSin(w1 * angle) * invSin;
+        w2 = lvn::fastSin(w2 * angle) * invSin;
+    }
+    w2 *= sign;
+
+#if defined(LVN_SIMD_SSE2)
+    __m128 r = _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(w1)), _mm_mul_ps(b, _mm_set1_ps(w2)));
+    __m128 l = _mm_mul_ps(r, r);
+    l = _mm_add_ps(l, _mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 3, 0, 1)));
+    l = _mm_add_ps(l, _mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 0, 3, 2)));
+    r = _mm_div_ps(r, _mm_sqrt_ps(l));
+
+    _mm_storeu_ps(q, r);
+#elif defined(LVN_SIMD_NEON)
+    float32x4_t r = vmlaq_n_f32(vmulq_n_f32(a, w1), b, w2);
+    float32x4_t l = vmulq_f32(r, r);
+    float32x2_t ls = vadd_f32(vget_low_f32(l), vget_high_f32(l));
+    r = vmulq_n_f32(r, 1.0f / sqrtf(vget_lane_f32(vpadd_f32(ls, ls), 0)));
+
+    vst1q_f32(q, r);
+#else
+    for (uint32_t i = 0; i < 4; i++)
+        q[i] = q1[i] * w1 + q2[i] * w2;
+    float invLength = 1.0f / sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (uint32_t i = 0; i < 4; i++)
+        q[i] *= invLength;
+#endif
+}
 
-    LVN_CORE_TRACE("created sampler: (%p)");
-    return lvnctx->graphicsContext.createSampler(*sampler, createInfo);
+// rotation keyframes are stored as x, y, z, w
+static LvnQuat animationSlerp(const LvnVec4& q1, const LvnVec4& q2, float t)
+{
+    float q[4];
+    lvn::quatSlerp(&q1.x, &q2.x, t, q);
+    return LvnQuat(q[3], q[0], q[1], q[2]);
 }
 
-LvnResult createTexture(LvnTexture** texture, const LvnTextureCreateInfo* createInfo)
+static void modelUpdateAnimationsJob(uint32_t start, uint32_t end, void* userData)
 {
-    LvnContext* lvnctx = lvn::getContext();
+    LvnAnimationUpdateData* data = static_cast<LvnAnimationUpdateData*>(userData);
+    LvnVector<LvnMat4> nodeMatrices;
 
-    *texture = lvn::createObject<LvnTexture>(lvnctx, Lvn_Stype_Texture);
+    for (uint32_t i = start; i < end; i++)
+    {
+        LvnModel* model = data->models[i];
+        if (data->animation >= model->animations.size()) { continue; }
 
-    LVN_CORE_TRACE("created texture: (%p) using image data: (%p), (w:%u,h:%u,ch:%u), total size: %u bytes",
-        *texture,
-        createInfo->imageData.pixels.data(),
-        createInfo->imageData.width,
-        createInfo->imageData.height,
-        createInfo->imageData.channels,
-        createInfo->imageData.pixels.memsize());
+        LvnAnimation& animation = model->animations[data->animation];
+        animation.currentTime += data->dt;
 
-    return lvnctx->graphicsContext.createTexture(*texture, createInfo);
-}
+        float duration = animation.end - animation.start;
+        if (duration > 0.0f && (animation.currentTime < animation.start || animation.currentTime > animation.end))
+        {
+            animation.currentTime = fmodf(animation.currentTime - animation.start, duration);
+            animation.currentTime += animation.currentTime < 0.0f ? animation.end : animation.start;
+        }
 
-LvnResult createTexture(LvnTexture** texture, const LvnTextureSamplerCreateInfo* createInfo)
-{
-    LvnContext* lvnctx = lvn::getContext();
+        lvn::animationSample(&animation, animation.currentTime, model->nodes.data());
 
-    *texture = lvn::createObject<LvnTexture>(lvnctx, Lvn_Stype_Texture);
+        if (model->skins.empty()) { continue; }
 
-    LVN_CORE_TRACE("created texture (seperate sampler): (%p) using image data: (%p), (w:%u,h:%u,ch:%u), total size: %u bytes, sampler object used: (%p)",
-        *texture,
-        createInfo->imageData.pixels.data(),
-        createInfo->imageData.width,
-        createInfo->imageData.height,
-        createInfo->imageData.channels,
-        createInfo->imageData.pixels.memsize(),
-        createInfo->sampler);
+        // only the subtrees of animated nodes are recomputed, the rest keep their world matrix from the last update
+        if (model->hierarchy.nodes.size() != model->nodes.size())
+            lvn::modelBuildHierarchy(*model, &model->hierarchy);
+        else
+            lvn::hierarchySyncNodes(&model->hierarchy, model->nodes.data());
 
-    return lvnctx->graphicsContext.createTextureSampler(*texture, createInfo);
+        lvn::hierarchyUpdate(&model->hierarchy);
+
+        nodeMatrices.resize(model->nodes.size());
+        lvn::hierarchyGetNodeMatrices(model->hierarchy, nodeMatrices.data());
+
+        LvnMat4* jointMatrices = data->jointMatrices + data->jointOffsets[i];
+        for (const LvnSkin& skin : model->skins)
+        {
+            lvn::skinGetJointMatrices(skin, nodeMatrices.data(), jointMatrices);
+            jointMatrices += skin.joints.size();
+        }
+    }
 }
 
-LvnResult createCubemap(LvnCubemap** cubemap, const LvnCubemapCreateInfo* createInfo)
+void animationSample(LvnAnimation* animation, float time, LvnNode* pNodes)
 {
-    LvnContext* lvnctx = lvn::getContext();
-
-    if (createInfo->posx.pixels.data() == nullptr)
+    for (LvnAnimationChannel& channel : animation->channels)
     {
-        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->posx.pixels does not point to a valid pointer array");
-        return Lvn_Result_Failure;
+        if (channel.node < 0 || channel.keyFrames.empty() || channel.outputs.size() < channel.keyFrames.size()) { continue; }
+
+        LvnTransform& transform = pNodes[channel.node].transform;
+        uint32_t last = channel.keyFrames.size() - 1;
+
+        // times outside of the keyframes hold the first or last value
+        uint32_t key = 0;
+        float t = 0.0f;
+        if (time >= channel.keyFrames[last])
+        {
+            key = last;
+        }
+        else if (time > channel.keyFrames[0])
+        {
+            key = lvn::animationFindKeyFrame(&channel, time);
+            if (channel.interpolation == Lvn_InterpolationMode_Linear)
+                t = (time - channel.keyFrames[key]) / (channel.keyFrames[key + 1] - channel.keyFrames[key]);
+        }
+
+        const LvnVec4& v1 = channel.outputs[key];
+        const LvnVec4& v2 = channel.outputs[key < last ? key + 1 : key];
+
+        switch (channel.path)
+        {
+            case Lvn_AnimationPath_Translation:
+            {
+                transform.translation = t > 0.0f ? lvn::lerp(v1, v2, t) : v1;
+                break;
+            }
+            case Lvn_AnimationPath_Rotation:
+            {
+                transform.rotation = t > 0.0f ? lvn::animationSlerp(v1, v2, t) : LvnQuat(v1.w, v1.x, v1.y, v1.z);
+                break;
+            }
+            case Lvn_AnimationPath_Scale:
+            {
+                transform.scale = t > 0.0f ? lvn::lerp(v1, v2, t) : v1;
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
     }
-    if (createInfo->negx.pixels.data() == nullptr)
+}
+
+void modelGetNodeMatrices(const LvnModel& model, LvnMat4* pMatrices)
+{
+    // the local matrices of all nodes are composed in one batch, translation * rotation * scale * node matrix
+    uint32_t nodeCount = static_cast<uint32_t>(model.nodes.size());
+    LvnVector<LvnVec3> translations(nodeCount), scales(nodeCount);
+    LvnVector<LvnQuat> rotations(nodeCount);
+    LvnVector<LvnMat4> nodeMatrices(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; i++)
     {
-        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->negx.pixels does not point to a valid pointer array");
-        return Lvn_Result_Failure;
+        const LvnNode& node = model.nodes[i];
+        translations[i] = node.transform.translation;
+        rotations[i] = node.transform.rotation;
+        scales[i] = node.transform.scale;
+        nodeMatrices[i] = node.matrix;
     }
-    if (createInfo->posy.pixels.data() == nullptr)
+
+    lvn::composeTRS(translations.data(), rotations.data(), scales.data(), pMatrices, nodeCount);
+    lvn::multiplyMatrices(pMatrices, nodeMatrices.data(), pMatrices, nodeCount);
+
+    // parents are visited before their children so each node only multiplies its local matrix onto the one of its parent
+    LvnVector<int32_t> stack;
+    for (uint32_t i = 0; i < nodeCount; i++)
     {
-        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->posy.pixels does not point to a valid pointer array");
-        return Lvn_Result_Failure;
+        if (model.nodes[i].parent < 0)
+            stack.push_back(i);
     }
-    if (createInfo->negy.pixels.data() == nullptr)
+
+    while (!stack.empty())
     {
-        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->negy.pixels does not point to a valid pointer array");
-        return Lvn_Result_Failure;
+        int32_t index = stack.back();
+        stack.pop_back();
+
+        const LvnNode& node = model.nodes[index];
+        if (node.parent >= 0)
+            pMatrices[index] = pMatrices[node.parent] * pMatrices[index];
+
+        for (uint32_t i = 0; i < node.children.size(); i++)
+            stack.push_back(node.children[i]);
     }
-    if (createInfo->posz.pixels.data() == nullptr)
+}
+
+void modelCullPrimitives(const LvnModel& model, const LvnMat4* pNodeMatrices, const LvnFrustum& frustum, LvnVector<LvnVisiblePrimitive>* pVisible)
+{
+    pVisible->clear();
+
+    // bounding spheres of every primitive are moved to world space and tested in one batch, the radius is scaled by the largest axis scale of the node
+    LvnVector<LvnVec4> spheres;
+    LvnVector<LvnVisiblePrimitive> candidates;
+    for (uint32_t i = 0; i < model.nodes.size(); i++)
     {
-        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->posz.pixels does not point to a valid pointer array");
-        return Lvn_Result_Failure;
+        const LvnNode& node = model.nodes[i];
+        if (node.mesh < 0)
+            continue;
+
+        const LvnMat4& matrix = pNodeMatrices[i];
+        float scale = sqrtf(lvn::max(lvn::dot(LvnVec3(matrix[0]), LvnVec3(matrix[0])), lvn::max(lvn::dot(LvnVec3(matrix[1]), LvnVec3(matrix[1])), lvn::dot(LvnVec3(matrix[2]), LvnVec3(matrix[2])))));
+
+        const LvnMesh& mesh = model.meshes[node.mesh];
+        for (uint32_t j = 0; j < mesh.primitives.size(); j++)
+        {
+            const LvnPrimitive& primitive = mesh.primitives[j];
+            LvnVec4 center = matrix * LvnVec4(primitive.boundsCenter, 1.0f);
+            spheres.push_back(LvnVec4(center.x, center.y, center.z, primitive.boundsRadius * scale));
+            candidates.push_back({ i, j });
+        }
     }
-    if (createInfo->negz.pixels.data() == nullptr)
+
+    LvnVector<uint8_t> visible(spheres.size());
+    lvn::frustumCullSpheres(frustum, spheres.data(), visible.data(), static_cast<uint32_t>(spheres.size()));
+
+    // spheres of long or flat primitives are loose, the world space box around the mesh box rejects most of what they let through
+    for (uint32_t i = 0; i < candidates.size(); i++)
     {
-        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | createInfo->negz.pixels does not point to a valid pointer array");
-        return Lvn_Result_Failure;
-    }
+        if (!visible[i])
+            continue;
 
-    // if(!(createInfo->posx.width * createInfo->posx.height ==
-    //  createInfo->negx.width * createInfo->negx.height ==
-    //  createInfo->posy.width * createInfo->posy.height ==
-    //  createInfo->negy.width * createInfo->negy.height ==
-    //  createInfo->posz.width * createInfo->posz.height ==
-    //  createInfo->negz.width * createInfo->negz.height))
-    // {
-    //  LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapCreateInfo*) | not all images have the same dimensions, all cubemap images must have the same width and height");
-    //  return Lvn_Result_Failure;
-    // }
+        const LvnPrimitive& primitive = model.meshes[model.nodes[candidates[i].node].mesh].primitives[candidates[i].primitive];
+        const LvnMat4& matrix = pNodeMatrices[candidates[i].node];
 
-    *cubemap = lvn::createObject<LvnCubemap>(lvnctx, Lvn_Stype_Cubemap);
+        LvnVec3 center = LvnVec3(matrix * LvnVec4((primitive.boundsMin + primitive.boundsMax) * 0.5f, 1.0f));
+        LvnVec3 extent = (primitive.boundsMax - primitive.boundsMin) * 0.5f;
+        LvnVec3 worldExtent;
+        for (uint32_t axis = 0; axis < 3; axis++)
+            worldExtent[axis] = fabsf(matrix[0][axis]) * extent.x + fabsf(matrix[1][axis]) * extent.y + fabsf(matrix[2][axis]) * extent.z;
 
-    LVN_CORE_TRACE("created cubemap: (%p)", *cubemap);
-    return lvnctx->graphicsContext.createCubemap(*cubemap, createInfo);
+        if (lvn::frustumTestAabb(frustum, center - worldExtent, center + worldExtent))
+            pVisible->push_back(candidates[i]);
+    }
 }
 
-LvnResult createCubemap(LvnCubemap** cubemap, const LvnCubemapHdrCreateInfo* createInfo)
+uint32_t modelGetInstanceCount(const LvnModel& model, uint32_t instanceCount)
 {
-    LvnContext* lvnctx = lvn::getContext();
-
-    if (createInfo->hdr.pixels.data() == nullptr)
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < model.nodes.size(); i++)
     {
-        LVN_CORE_ERROR("createCubemap(LvnCubemap**, LvnCubemapHdrCreateInfo*) | createInfo->hdr.pixels does not point to a valid pointer array");
-        return Lvn_Result_Failure;
+        const LvnNode& node = model.nodes[i];
+        if (node.mesh >= 0)
+            count += instanceCount * lvn::max<uint32_t>(node.instances.size(), 1);
     }
 
-    *cubemap = lvn::createObject<LvnCubemap>(lvnctx, Lvn_Stype_Cubemap);
-
-    LVN_CORE_TRACE("created cubemap (%p) from hdr image (%p)", *cubemap, createInfo->hdr.pixels.data());
-    return lvnctx->graphicsContext.createCubemapHdr(*cubemap, createInfo);
+    return count;
 }
 
-void destroyShader(LvnShader* shader)
+void modelWriteInstances(const LvnModel& model, const LvnMat4* pNodeMatrices, const LvnModelInstance* pInstances, uint32_t instanceCount, LvnModelInstance* pDst)
 {
-    if (shader == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
+    // every mesh node gets one contiguous range so each of its primitives is drawn with a single instanced draw
+    LvnVector<LvnVec3> translations, scales;
+    LvnVector<LvnQuat> rotations;
+    LvnVector<LvnMat4> nodeInstances;
+    for (uint32_t i = 0; i < model.nodes.size(); i++)
+    {
+        const LvnNode& node = model.nodes[i];
+        if (node.mesh < 0)
+            continue;
 
-    lvnctx->graphicsContext.destroyShader(shader);
-    lvn::destroyObject(lvnctx, shader, Lvn_Stype_Shader);
-}
+        if (node.instances.empty())
+        {
+            for (uint32_t j = 0; j < instanceCount; j++, pDst++)
+            {
+                pDst->matrix = pInstances[j].matrix * pNodeMatrices[i];
+                pDst->materialIndex = pInstances[j].materialIndex;
+            }
+            continue;
+        }
 
-void destroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout)
-{
-    if (descriptorLayout == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
+        uint32_t gpuInstanceCount = static_cast<uint32_t>(node.instances.size());
+        translations.resize(gpuInstanceCount);
+        rotations.resize(gpuInstanceCount);
+        scales.resize(gpuInstanceCount);
+        nodeInstances.resize(gpuInstanceCount);
+        for (uint32_t j = 0; j < gpuInstanceCount; j++)
+        {
+            translations[j] = node.instances[j].translation;
+            rotations[j] = node.instances[j].rotation;
+            scales[j] = node.instances[j].scale;
+        }
 
-    lvnctx->graphicsContext.destroyDescriptorLayout(descriptorLayout);
-    lvn::destroyObject(lvnctx, descriptorLayout, Lvn_Stype_DescriptorLayout);
+        lvn::composeTRS(translations.data(), rotations.data(), scales.data(), nodeInstances.data(), gpuInstanceCount);
+
+        for (uint32_t j = 0; j < instanceCount; j++)
+        {
+            LvnMat4 matrix = pInstances[j].matrix * pNodeMatrices[i];
+            for (uint32_t k = 0; k < gpuInstanceCount; k++, pDst++)
+            {
+                pDst->matrix = matrix * nodeInstances[k];
+                pDst->materialIndex = pInstances[j].materialIndex;
+            }
+        }
+    }
 }
 
-void destroyPipeline(LvnPipeline* pipeline)
+// shared by renderCmdDrawModelInstanced and renderCmdDrawModelMaterials, materialIndices pushes the material index of each primitive instead of binding its descriptor set
+static void drawModelInstances(LvnWindow* window, const LvnModel& model, LvnPipeline* pipeline, LvnBuffer* instanceBuffer, uint64_t instanceOffset, uint32_t instanceCount, bool materialIndices)
 {
-    if (pipeline == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
+    if (instanceCount == 0)
+        return;
 
-    lvnctx->graphicsContext.destroyPipeline(pipeline);
-    lvn::destroyObject(lvnctx, pipeline, Lvn_Stype_Pipeline);
-}
+    // walks the nodes in the same order as modelWriteInstances so firstInstance points at the range of each node
+    uint32_t firstInstance = 0;
+    const LvnDescriptorSet* boundSet = nullptr;
+    uint32_t pushedMaterial = UINT32_MAX;
+    for (uint32_t i = 0; i < model.nodes.size(); i++)
+    {
+        const LvnNode& node = model.nodes[i];
+        if (node.mesh < 0)
+            continue;
 
-void destroyFrameBuffer(LvnFrameBuffer* frameBuffer)
-{
-    if (frameBuffer == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
+        uint32_t nodeInstanceCount = instanceCount * lvn::max<uint32_t>(node.instances.size(), 1);
+        const LvnMesh& mesh = model.meshes[node.mesh];
+        for (uint32_t j = 0; j < mesh.primitives.size(); j++)
+        {
+            const LvnPrimitive& primitive = mesh.primitives[j];
 
-    lvnctx->graphicsContext.destroyFrameBuffer(frameBuffer);
-    lvn::destroyObject(lvnctx, frameBuffer, Lvn_Stype_FrameBuffer);
-}
+            if (materialIndices)
+            {
+                if (primitive.materialIndex != pushedMaterial)
+                {
+                    lvn::renderCmdPushConstants(window, pipeline, Lvn_ShaderStage_All, 0, sizeof(uint32_t), &primitive.materialIndex);
+                    pushedMaterial = primitive.materialIndex;
+                }
+            }
+            else if (primitive.descriptorSet != nullptr && primitive.descriptorSet != boundSet)
+            {
+                LvnDescriptorSet* descriptorSet = primitive.descriptorSet;
+                lvn::renderCmdBindDescriptorSets(window, pipeline, 0, 1, &descriptorSet);
+                boundSet = descriptorSet;
+            }
 
-void destroyBuffer(LvnBuffer* buffer)
-{
-    if (buffer == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
+            LvnBuffer* vertexBuffers[] = { primitive.buffer, instanceBuffer };
+            uint64_t vertexOffsets[] = { 0, instanceOffset };
+            lvn::renderCmdBindVertexBuffer(window, 0, 2, vertexBuffers, vertexOffsets);
+            lvn::renderCmdBindIndexBuffer(window, primitive.buffer, primitive.indexOffset);
+            lvn::renderCmdDrawIndexedInstanced(window, primitive.indexCount, nodeInstanceCount, firstInstance);
+        }
 
-    lvnctx->graphicsContext.destroyBuffer(buffer);
-    lvn::destroyObject(lvnctx, buffer, Lvn_Stype_Buffer);
+        firstInstance += nodeInstanceCount;
+    }
 }
 
-void destroySampler(LvnSampler* sampler)
+void renderCmdDrawModelInstanced(LvnWindow* window, const LvnModel& model, LvnPipeline* pipeline, LvnBuffer* instanceBuffer, uint64_t instanceOffset, uint32_t instanceCount)
 {
-    if (sampler == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
-
-    lvnctx->graphicsContext.destroySampler(sampler);
-    lvn::destroyObject(lvnctx, sampler, Lvn_Stype_Sampler);
+    lvn::drawModelInstances(window, model, pipeline, instanceBuffer, instanceOffset, instanceCount, false);
 }
 
-void destroyTexture(LvnTexture* texture)
+void renderCmdDrawModelMaterials(LvnWindow* window, const LvnModel& model, LvnPipeline* pipeline, LvnMaterialTable* materialTable, uint32_t setIndex, LvnBuffer* instanceBuffer, uint64_t instanceOffset, uint32_t instanceCount)
 {
-    if (texture == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
+    if (instanceCount == 0)
+        return;
 
-    lvnctx->graphicsContext.destroyTexture(texture);
-    lvn::destroyObject(lvnctx, texture, Lvn_Stype_Texture);
+    // one bind covers the materials and textures of every primitive
+    lvn::renderCmdBindDescriptorSets(window, pipeline, setIndex, 1, &materialTable->descriptorSet);
+    lvn::drawModelInstances(window, model, pipeline, instanceBuffer, instanceOffset, instanceCount, true);
 }
 
-void destroyCubemap(LvnCubemap* cubemap)
+void skinGetJointMatrices(const LvnSkin& skin, const LvnMat4* pNodeMatrices, LvnMat4* pJointMatrices)
 {
-    if (cubemap == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
+    for (uint32_t i = 0; i < skin.joints.size(); i++)
+        pJointMatrices[i] = pNodeMatrices[skin.joints[i]] * skin.inverseBindMatrices[i];
+}
 
-    lvnctx->graphicsContext.destroyCubemap(cubemap);
-    lvn::destroyObject(lvnctx, cubemap, Lvn_Stype_Cubemap);
+void modelUpdateAnimation(LvnModel* model, uint32_t animation, float dt)
+{
+    lvn::modelUpdateAnimations(&model, 1, animation, dt);
 }
 
-uint32_t getAttributeFormatSize(LvnAttributeFormat format)
+void modelUpdateAnimations(LvnModel** pModels, uint32_t modelCount, uint32_t animation, float dt)
 {
-    switch (format)
+    // every model writes its joint matrices into its own range of one array
+    LvnVector<uint64_t> jointOffsets(modelCount);
+    uint64_t jointCount = 0;
+    for (uint32_t i = 0; i < modelCount; i++)
     {
-        case Lvn_AttributeFormat_Undefined:        { return 0; }
-        case Lvn_AttributeFormat_Scalar_f32:       { return sizeof(float); }
-        case Lvn_AttributeFormat_Scalar_f64:       { return sizeof(double); }
-        case Lvn_AttributeFormat_Scalar_i32:       { return sizeof(int32_t); }
-        case Lvn_AttributeFormat_Scalar_ui32:      { return sizeof(uint32_t); }
-        case Lvn_AttributeFormat_Scalar_i8:        { return sizeof(int8_t); }
-        case Lvn_AttributeFormat_Scalar_ui8:       { return sizeof(uint8_t); }
-        case Lvn_AttributeFormat_Vec2_f32:         { return 2 * sizeof(float); }
-        case Lvn_AttributeFormat_Vec3_f32:         { return 3 * sizeof(float); }
-        case Lvn_AttributeFormat_Vec4_f32:         { return 4 * sizeof(float); }
-        case Lvn_AttributeFormat_Vec2_f64:         { return 2 * sizeof(double); }
-        case Lvn_AttributeFormat_Vec3_f64:         { return 3 * sizeof(double); }
-        case Lvn_AttributeFormat_Vec4_f64:         { return 4 * sizeof(double); }
-        case Lvn_AttributeFormat_Vec2_i32:         { return 2 * sizeof(int32_t); }
-        case Lvn_AttributeFormat_Vec3_i32:         { return 3 * sizeof(int32_t); }
-        case Lvn_AttributeFormat_Vec4_i32:         { return 4 * sizeof(int32_t); }
-        case Lvn_AttributeFormat_Vec2_ui32:        { return 2 * sizeof(uint32_t); }
-        case Lvn_AttributeFormat_Vec3_ui32:        { return 3 * sizeof(uint32_t); }
-        case Lvn_AttributeFormat_Vec4_ui32:        { return 4 * sizeof(uint32_t); }
-        case Lvn_AttributeFormat_Vec2_i8:          { return 2 * sizeof(int8_t); }
-        case Lvn_AttributeFormat_Vec3_i8:          { return 3 * sizeof(int8_t); }
-        case Lvn_AttributeFormat_Vec4_i8:          { return 4 * sizeof(int8_t); }
-        case Lvn_AttributeFormat_Vec2_ui8:         { return 2 * sizeof(uint8_t); }
-        case Lvn_AttributeFormat_Vec3_ui8:         { return 3 * sizeof(uint8_t); }
-        case Lvn_AttributeFormat_Vec4_ui8:         { return 4 * sizeof(uint8_t); }
-        case Lvn_AttributeFormat_Vec2_n8:          { return 2 * sizeof(int8_t); }
-        case Lvn_AttributeFormat_Vec3_n8:          { return 3 * sizeof(int8_t); }
-        case Lvn_AttributeFormat_Vec4_n8:          { return 4 * sizeof(int8_t); }
-        case Lvn_AttributeFormat_Vec2_un8:         { return 2 * sizeof(uint8_t); }
-        case Lvn_AttributeFormat_Vec3_un8:         { return 3 * sizeof(uint8_t); }
-        case Lvn_AttributeFormat_Vec4_un8:         { return 4 * sizeof(uint8_t); }
-        case Lvn_AttributeFormat_2_10_10_10_ile:   { return sizeof(int32_t); }
-        case Lvn_AttributeFormat_2_10_10_10_uile:  { return sizeof(uint32_t); }
-        case Lvn_AttributeFormat_2_10_10_10_nle:   { return sizeof(int32_t); }
-        case Lvn_AttributeFormat_2_10_10_10_unle:  { return sizeof(uint32_t); }
+        jointOffsets[i] = jointCount;
+        for (const LvnSkin& skin : pModels[i]->skins)
+            jointCount += skin.joints.size();
+    }
 
-        default:
+    LvnVector<LvnMat4> jointMatrices;
+    jointMatrices.resize_uninitialized(jointCount);
+
+    LvnAnimationUpdateData data{};
+    data.models = pModels;
+    data.jointOffsets = jointOffsets.data();
+    data.jointMatrices = jointMatrices.data();
+    data.animation = animation;
+    data.dt = dt;
+
+    // sampling and the pose are evaluated across the job system, the buffers are only updated from the calling thread
+    lvn::parallelFor(modelCount, 1, lvn::modelUpdateAnimationsJob, &data);
+
+    for (uint32_t i = 0; i < modelCount; i++)
+    {
+        if (animation >= pModels[i]->animations.size()) { continue; }
+
+        const LvnMat4* skinMatrices = jointMatrices.data() + jointOffsets[i];
+        for (const LvnSkin& skin : pModels[i]->skins)
         {
-            LVN_CORE_WARN("unknown vertex data type enum: (%u)", format);
-            return 0;
+            if (skin.ssbo != nullptr && !skin.joints.empty())
+                lvn::bufferUpdateData(skin.ssbo, const_cast<LvnMat4*>(skinMatrices), skin.joints.size() * sizeof(LvnMat4), 0);
+            skinMatrices += skin.joints.size();
         }
     }
 }
 
-uint32_t getAttributeFormatComponentSize(LvnAttributeFormat format)
+void modelBuildHierarchy(const LvnModel& model, LvnNodeHierarchy* pHierarchy)
 {
-    switch (format)
-    {
-        case Lvn_AttributeFormat_Undefined:        { return 0; }
-        case Lvn_AttributeFormat_Scalar_f32:       { return 1; }
-        case Lvn_AttributeFormat_Scalar_f64:       { return 1; }
-        case Lvn_AttributeFormat_Scalar_i32:       { return 1; }
-        case Lvn_AttributeFormat_Scalar_ui32:      { return 1; }
-        case Lvn_AttributeFormat_Scalar_i8:        { return 1; }
-        case Lvn_AttributeFormat_Scalar_ui8:       { return 1; }
-        case Lvn_AttributeFormat_Vec2_f32:         { return 2; }
-        case Lvn_AttributeFormat_Vec3_f32:         { return 3; }
-        case Lvn_AttributeFormat_Vec4_f32:         { return 4; }
-        case Lvn_AttributeFormat_Vec2_f64:         { return 2; }
-        case Lvn_AttributeFormat_Vec3_f64:         { return 3; }
-        case Lvn_AttributeFormat_Vec4_f64:         { return 4; }
-        case Lvn_AttributeFormat_Vec2_i32:         { return 2; }
-        case Lvn_AttributeFormat_Vec3_i32:         { return 3; }
-        case Lvn_AttributeFormat_Vec4_i32:         { return 4; }
-        case Lvn_AttributeFormat_Vec2_ui32:        { return 2; }
-        case Lvn_AttributeFormat_Vec3_ui32:        { return 3; }
-        case Lvn_AttributeFormat_Vec4_ui32:        { return 4; }
-        case Lvn_AttributeFormat_Vec2_i8:          { return 2; }
-        case Lvn_AttributeFormat_Vec3_i8:          { return 3; }
-        case Lvn_AttributeFormat_Vec4_i8:          { return 4; }
-        case Lvn_AttributeFormat_Vec2_ui8:         { return 2; }
-        case Lvn_AttributeFormat_Vec3_ui8:         { return 3; }
-        case Lvn_AttributeFormat_Vec4_ui8:         { return 4; }
-        case Lvn_AttributeFormat_Vec2_n8:          { return 2; }
-        case Lvn_AttributeFormat_Vec3_n8:          { return 3; }
-        case Lvn_AttributeFormat_Vec4_n8:          { return 4; }
-        case Lvn_AttributeFormat_Vec2_un8:         { return 2; }
-        case Lvn_AttributeFormat_Vec3_un8:         { return 3; }
-        case Lvn_AttributeFormat_Vec4_un8:         { return 4; }
-        case Lvn_AttributeFormat_2_10_10_10_ile:   { return 4; }
-        case Lvn_AttributeFormat_2_10_10_10_uile:  { return 4; }
-        case Lvn_AttributeFormat_2_10_10_10_nle:   { return 4; }
-        case Lvn_AttributeFormat_2_10_10_10_unle:  { return 4; }
+    uint32_t nodeCount = static_cast<uint32_t>(model.nodes.size());
 
-        default:
+    pHierarchy->nodes.clear();
+    pHierarchy->nodes.reserve(nodeCount);
+    pHierarchy->entries.resize(nodeCount);
+    pHierarchy->parents.resize(nodeCount);
+    pHierarchy->subtreeEnds.resize(nodeCount);
+
+    // depth first preorder keeps every subtree contiguous, nodes that cannot be reached from a root are appended as roots
+    LvnVector<uint8_t> visited(nodeCount, 0);
+    LvnVector<uint32_t> stack;
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        for (uint32_t i = nodeCount; i-- > 0;)
         {
-            LVN_CORE_WARN("unknown vertex data type enum: (%u)", format);
-            return 0;
+            if (visited[i] || (pass == 0 && model.nodes[i].parent >= 0))
+                continue;
+
+            stack.push_back(i);
+            while (!stack.empty())
+            {
+                uint32_t index = stack.back();
+                stack.pop_back();
+                if (visited[index])
+                    continue;
+
+                visited[index] = 1;
+                uint32_t entry = static_cast<uint32_t>(pHierarchy->nodes.size());
+                int32_t parent = model.nodes[index].parent;
+
+                pHierarchy->entries[index] = entry;
+                pHierarchy->parents[entry] = parent >= 0 && visited[parent] ? static_cast<int32_t>(pHierarchy->entries[parent]) : -1;
+                pHierarchy->nodes.push_back(index);
+
+                const LvnVector<int32_t>& children = model.nodes[index].children;
+                for (uint32_t j = static_cast<uint32_t>(children.size()); j-- > 0;)
+                    stack.push_back(children[j]);
+            }
         }
     }
-}
 
-bool isAttributeFormatNormalizedType(LvnAttributeFormat format)
-{
-    switch (format)
+    // children come after their parent so walking backwards passes the end of each subtree up to its parent
+    for (uint32_t i = 0; i < nodeCount; i++)
+        pHierarchy->subtreeEnds[i] = i + 1;
+    for (uint32_t i = nodeCount; i-- > 0;)
     {
-        case Lvn_AttributeFormat_Vec2_n8:          { return true; }
-        case Lvn_AttributeFormat_Vec3_n8:          { return true; }
-        case Lvn_AttributeFormat_Vec4_n8:          { return true; }
-        case Lvn_AttributeFormat_Vec2_un8:         { return true; }
-        case Lvn_AttributeFormat_Vec3_un8:         { return true; }
-        case Lvn_AttributeFormat_Vec4_un8:         { return true; }
-        case Lvn_AttributeFormat_2_10_10_10_nle:   { return true; }
-        case Lvn_AttributeFormat_2_10_10_10_unle:  { return true; }
+        int32_t parent = pHierarchy->parents[i];
+        if (parent >= 0)
+            pHierarchy->subtreeEnds[parent] = lvn::max(pHierarchy->subtreeEnds[parent], pHierarchy->subtreeEnds[i]);
+    }
 
-        default: { return false; }
+    pHierarchy->translations.resize(nodeCount);
+    pHierarchy->rotations.resize(nodeCount);
+    pHierarchy->scales.resize(nodeCount);
+    pHierarchy->matrices.resize(nodeCount);
+    pHierarchy->localMatrices.resize(nodeCount);
+    pHierarchy->worldMatrices.resize(nodeCount);
+    pHierarchy->dirty.resize(nodeCount);
+
+    for (uint32_t i = 0; i < nodeCount; i++)
+    {
+        const LvnNode& node = model.nodes[pHierarchy->nodes[i]];
+        pHierarchy->translations[i] = node.transform.translation;
+        pHierarchy->rotations[i] = node.transform.rotation;
+        pHierarchy->scales[i] = node.transform.scale;
+        pHierarchy->matrices[i] = node.matrix;
+        pHierarchy->dirty[i] = 1;
     }
-}
 
-void pipelineSpecificationSetConfig(LvnPipelineSpecification* pipelineSpecification)
-{
-    LVN_CORE_ASSERT(pipelineSpecification != nullptr, "pipeline specification points to nullptr when setting pipeline specification config");
-    LvnContext* lvnctx = lvn::getContext();
-    lvnctx->defaultPipelineSpecification = *pipelineSpecification;
+    pHierarchy->anyDirty = nodeCount > 0;
 }
 
-LvnPipelineSpecification configPipelineSpecificationInit()
+void hierarchySetTransform(LvnNodeHierarchy* pHierarchy, uint32_t node, const LvnTransform& transform)
 {
-    LvnContext* lvnctx = lvn::getContext();
-    return lvnctx->defaultPipelineSpecification;
+    uint32_t entry = pHierarchy->entries[node];
+    pHierarchy->translations[entry] = transform.translation;
+    pHierarchy->rotations[entry] = transform.rotation;
+    pHierarchy->scales[entry] = transform.scale;
+    pHierarchy->dirty[entry] = 1;
+    pHierarchy->anyDirty = true;
 }
 
-void bufferUpdateData(LvnBuffer* buffer, void* data, uint64_t size, uint64_t offset)
+void hierarchySyncNodes(LvnNodeHierarchy* pHierarchy, const LvnNode* pNodes)
 {
-    if (buffer->usage == Lvn_BufferUsage_Static)
+    for (uint32_t i = 0; i < pHierarchy->nodes.size(); i++)
     {
-        LVN_CORE_ERROR("[opengl] cannot change data of buffer that has static buffer usage set Lvn_BufferUsage_Static, buffer: (%p)", buffer);
-        return;
-    }
+        const LvnTransform& transform = pNodes[pHierarchy->nodes[i]].transform;
+        // compared bitwise, animation sampling writes the same bits when a channel holds its value
+        if (memcmp(&transform.translation, &pHierarchy->translations[i], sizeof(LvnVec3)) == 0 && memcmp(&transform.rotation, &pHierarchy->rotations[i], sizeof(LvnQuat)) == 0 && memcmp(&transform.scale, &pHierarchy->scales[i], sizeof(LvnVec3)) == 0)
+            continue;
 
-    lvn::getContext()->graphicsContext.bufferUpdateData(buffer, data, size, offset);
+        pHierarchy->translations[i] = transform.translation;
+        pHierarchy->rotations[i] = transform.rotation;
+        pHierarchy->scales[i] = transform.scale;
+        pHierarchy->dirty[i] = 1;
+        pHierarchy->anyDirty = true;
+    }
 }
 
-void bufferResize(LvnBuffer* buffer, uint64_t size)
+uint32_t hierarchyUpdate(LvnNodeHierarchy* pHierarchy)
 {
-    if (buffer->usage != Lvn_BufferUsage_Resize)
+    if (!pHierarchy->anyDirty)
+        return 0;
+
+    uint32_t count = static_cast<uint32_t>(pHierarchy->nodes.size());
+
+    // local matrices of consecutive dirty entries are composed together
+    for (uint32_t i = 0; i < count;)
     {
-        LVN_CORE_ERROR("[opengl] cannot change data of buffer that does not have resize buffer usage set Lvn_BufferUsage_Resize, buffer: (%p)", buffer);
-        return;
+        if (!pHierarchy->dirty[i]) { i++; continue; }
+
+        uint32_t end = i + 1;
+        while (end < count && pHierarchy->dirty[end])
+            end++;
+
+        lvn::composeTRS(&pHierarchy->translations[i], &pHierarchy->rotations[i], &pHierarchy->scales[i], &pHierarchy->localMatrices[i], end - i);
+        lvn::multiplyMatrices(&pHierarchy->localMatrices[i], &pHierarchy->matrices[i], &pHierarchy->localMatrices[i], end - i);
+        i = end;
     }
 
-    lvn::getContext()->graphicsContext.bufferResize(buffer, size);
+    // parents are always before their children, so the world matrices of every dirty subtree are recomputed in one pass
+    uint32_t updated = 0, dirtyEnd = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (pHierarchy->dirty[i])
+        {
+            dirtyEnd = lvn::max(dirtyEnd, pHierarchy->subtreeEnds[i]);
+            pHierarchy->dirty[i] = 0;
+        }
+
+        if (i >= dirtyEnd)
+            continue;
+
+        int32_t parent = pHierarchy->parents[i];
+        pHierarchy->worldMatrices[i] = parent >= 0 ? pHierarchy->worldMatrices[parent] * pHierarchy->localMatrices[i] : pHierarchy->localMatrices[i];
+        updated++;
+    }
+
+    pHierarchy->anyDirty = false;
+    return updated;
 }
 
-LvnTexture* cubemapGetTextureData(LvnCubemap* cubemap)
+void hierarchyGetNodeMatrices(const LvnNodeHierarchy& hierarchy, LvnMat4* pMatrices)
 {
-    return &cubemap->textureData;
+    for (uint32_t i = 0; i < hierarchy.nodes.size(); i++)
+        pMatrices[hierarchy.nodes[i]] = hierarchy.worldMatrices[i];
 }
 
-void updateDescriptorSetData(LvnDescriptorSet* descriptorSet, LvnDescriptorUpdateInfo* pUpdateInfo, uint32_t count)
+const LvnMat4& hierarchyGetWorldMatrix(const LvnNodeHierarchy& hierarchy, uint32_t node)
 {
-    // TODO: add update error logs
-    lvn::getContext()->graphicsContext.updateDescriptorSetData(descriptorSet, pUpdateInfo, count);
+    return hierarchy.worldMatrices[hierarchy.entries[node]];
 }
 
-LvnTexture* frameBufferGetImage(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex)
+
+// ------------------------------------------------------------
+// [SECTION]: Audio Functions
+// ------------------------------------------------------------
+
+float volumeDbToLinear(float db)
 {
-    return lvn::getContext()->graphicsContext.frameBufferGetImage(frameBuffer, attachmentIndex);
+    return ma_volume_db_to_linear(db);
 }
 
-LvnRenderPass* frameBufferGetRenderPass(LvnFrameBuffer* frameBuffer)
+float volumeLineatToDb(float volume)
 {
-    return lvn::getContext()->graphicsContext.frameBufferGetRenderPass(frameBuffer);
+    return ma_volume_linear_to_db(volume);
 }
 
-void frameBufferResize(LvnFrameBuffer* frameBuffer, uint32_t width, uint32_t height)
+void audioSetGlobalTimeMilliSeconds(uint64_t ms)
 {
-    if (width * height == 0)
-        return;
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    lvn::getContext()->graphicsContext.framebufferResize(frameBuffer, width, height);
+    ma_engine_set_time_in_milliseconds(pEngine, ms);
 }
 
-void frameBufferSetClearColor(LvnFrameBuffer* frameBuffer, uint32_t attachmentIndex, float r, float g, float b, float a)
+void audioSetGlobalTimePcmFrames(uint64_t pcm)
 {
-    lvn::getContext()->graphicsContext.frameBufferSetClearColor(frameBuffer, attachmentIndex, r, g, b, a);
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
+
+    ma_engine_set_time_in_pcm_frames(pEngine, pcm);
 }
 
-LvnDepthImageFormat findSupportedDepthImageFormat(LvnDepthImageFormat* pDepthImageFormats, uint32_t count)
+void audioSetMasterVolume(float volume)
 {
-    if (pDepthImageFormats == nullptr)
-    {
-        LVN_CORE_ERROR("cannot find supported depth image format, no depth image candidates given");
-        return (LvnDepthImageFormat)(0);
-    }
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    return lvn::getContext()->graphicsContext.findSupportedDepthImageFormat(pDepthImageFormats, count);
+    ma_engine_set_volume(pEngine, volume);
 }
 
-LvnImageData loadImageData(const char* filepath, int forceChannels, bool flipVertically)
+uint32_t audioGetSampleRate()
 {
-    if (filepath == nullptr)
-    {
-        LVN_CORE_ERROR("loadImageData(const char*, int, bool) | invalid filepath, filepath must not be nullptr");
-        return {};
-    }
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return 0; }
 
-    if (forceChannels < 0)
-    {
-        LVN_CORE_ERROR("loadImageData(const char*, int, bool) | forceChannels < 0, channels cannot be negative");
-        return {};
-    }
-    else if (forceChannels > 4)
-    {
-        LVN_CORE_ERROR("loadImageData(const char*, int, bool) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
-        return {};
-    }
+    return ma_engine_get_sample_rate(pEngine);
+}
 
-    stbi_set_flip_vertically_on_load(flipVertically);
-    int imageWidth, imageHeight, imageChannels;
-    stbi_uc* pixels = stbi_load(filepath, &imageWidth, &imageHeight, &imageChannels, forceChannels);
+LvnAudioDeviceInfo audioGetDeviceInfo()
+{
+    LvnContext* lvnctx = lvn::getContext();
+    if (lvn::requireAudioContext(lvnctx) != Lvn_Result_Success)
+        return LvnAudioDeviceInfo{};
 
-    if (!pixels)
-    {
-        LVN_CORE_ERROR("loadImageData(const char*, int, bool) | failed to load image pixel data from file: %s", filepath);
-        return {};
-    }
+    return lvn::getAudioDeviceInfo(static_cast<const ma_device*>(lvnctx->audioDevicePtr));
+}
 
-    LvnImageData imageData{};
-    imageData.width = imageWidth;
-    imageData.height = imageHeight;
-    imageData.channels = forceChannels ? forceChannels : imageChannels;
-    imageData.size = imageData.width * imageData.height * imageData.channels;
-    imageData.pixels = LvnData<uint8_t>(pixels, imageData.size);
+uint64_t audioGetGlobalTimeMilliseconds()
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return 0; }
 
-    LVN_CORE_TRACE("loaded image data <unsigned char*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes, filepath: %s", pixels, imageData.width, imageData.height, imageData.channels, imageData.size, filepath);
+    return ma_engine_get_time_in_milliseconds(pEngine);
+}
 
-    stbi_image_free(pixels);
+uint64_t audioGetGlobalTimePcmFrames()
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return 0; }
 
-    return imageData;
+    return ma_engine_get_time_in_pcm_frames(pEngine);
 }
 
-LvnImageData loadImageDataMemory(const uint8_t* data, int length, int forceChannels, bool flipVertically)
+
+void listenerSetPosition(float x, float y, float z)
 {
-    if (!data)
-    {
-        LVN_CORE_ERROR("loadImageDataMemory(const unsigned char*, int, int, bool) | invalid data, image memory data must not be nullptr");
-        return {};
-    }
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    if (forceChannels < 0)
-    {
-        LVN_CORE_ERROR("loadImageDataMemory(conts unsigned char*, int, int, bool) | forceChannels < 0, channels cannot be negative");
-        return {};
-    }
-    else if (forceChannels > 4)
-    {
-        LVN_CORE_ERROR("loadImageDataMemory(const unsigned char*, int, int, bool) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
-        return {};
-    }
+    ma_engine_listener_set_position(pEngine, 0, x, y, z);
+}
 
-    stbi_set_flip_vertically_on_load(flipVertically);
-    int imageWidth, imageHeight, imageChannels;
-    stbi_uc* pixels = stbi_load_from_memory(data, length, &imageWidth, &imageHeight, &imageChannels, forceChannels);
+void listenerSetPosition(const LvnVec3& pos)
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    if (!pixels)
-    {
-        LVN_CORE_ERROR("loadImageDataMemory(const unsigned char*) | failed to load image pixel data from memory: %p", data);
-        return {};
-    }
+    ma_engine_listener_set_position(pEngine, 0, pos.x, pos.y, pos.z);
+}
 
-    LvnImageData imageData{};
-    imageData.width = imageWidth;
-    imageData.height = imageHeight;
-    imageData.channels = forceChannels ? forceChannels : imageChannels;
-    imageData.size = imageData.width * imageData.height * imageData.channels;
-    imageData.pixels = LvnData<uint8_t>(pixels, imageData.size);
+void listenerSetDirection(float x, float y, float z)
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    LVN_CORE_TRACE("loaded image data from memory <unsigned char*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes", pixels, imageData.width, imageData.height, imageData.channels, imageData.size);
+    ma_engine_listener_set_direction(pEngine, 0, x, y, z);
+}
 
-    stbi_image_free(pixels);
+void listenerSetDirection(const LvnVec3 dir)
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    return imageData;
+    ma_engine_listener_set_direction(pEngine, 0, dir.x, dir.y, dir.z);
 }
 
-LvnImageData loadImageDataThread(const LvnString filepath, int forceChannels, bool flipVertically)
+void listenerSetVelocity(float x, float y, float z)
 {
-    if (filepath.empty())
-    {
-        LVN_CORE_ERROR("loadImageDataThread(const char*, int, bool) | invalid filepath, filepath is empty string");
-        return {};
-    }
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    if (forceChannels < 0)
-    {
-        LVN_CORE_ERROR("loadImageDataThread(const char*, int, bool) | forceChannels < 0, channels cannot be negative");
-        return {};
-    }
-    else if (forceChannels > 4)
-    {
-        LVN_CORE_ERROR("loadImageDataThread(const char*, int, bool) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
-        return {};
-    }
+    ma_engine_listener_set_velocity(pEngine, 0, x, y, z);
+}
 
-    stbi_set_flip_vertically_on_load_thread(flipVertically);
-    int imageWidth, imageHeight, imageChannels;
-    stbi_uc* pixels = stbi_load(filepath.c_str(), &imageWidth, &imageHeight, &imageChannels, forceChannels);
+void listenerSetVelocity(const LvnVec3 vel)
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    if (!pixels)
-    {
-        LVN_CORE_ERROR("loadImageDataThread(const char*, int, bool) | failed to load image pixel data from file: %s", filepath.c_str());
-        return {};
-    }
+    ma_engine_listener_set_velocity(pEngine, 0, vel.x, vel.y, vel.z);
+}
 
-    LvnImageData imageData{};
-    imageData.width = imageWidth;
-    imageData.height = imageHeight;
-    imageData.channels = forceChannels ? forceChannels : imageChannels;
-    imageData.size = imageData.width * imageData.height * imageData.channels;
-    imageData.pixels = LvnData<uint8_t>(pixels, imageData.size);
+void listenerSetWorldUp(float x, float y, float z)
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    LVN_CORE_TRACE("loaded image data <unsigned char*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes, filepath: %s", pixels, imageData.width, imageData.height, imageData.channels, imageData.size, filepath.c_str());
+    ma_engine_listener_set_world_up(pEngine, 0, x, y, z);
+}
 
-    stbi_image_free(pixels);
+void listenerSetWorldUp(const LvnVec3 up)
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    return imageData;
+    ma_engine_listener_set_world_up(pEngine, 0, up.x, up.y, up.z);
 }
 
-LvnImageData loadImageDataMemoryThread(const uint8_t* data, int length, int forceChannels, bool flipVertically)
+void listenerSetCone(float innerAngleRad, float outerAngleRad, float outerGain)
 {
-    if (!data)
-    {
-        LVN_CORE_ERROR("loadImageDataMemoryThread(const unsigned char*, int, int, bool) | invalid data, image memory data must not be nullptr");
-        return {};
-    }
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
 
-    if (forceChannels < 0)
-    {
-        LVN_CORE_ERROR("loadImageDataMemoryThread(conts unsigned char*, int, int, bool) | forceChannels < 0, channels cannot be negative");
-        return {};
-    }
-    else if (forceChannels > 4)
-    {
-        LVN_CORE_ERROR("loadImageDataMemoryThread(const unsigned char*, int, int, bool) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
-        return {};
-    }
+    ma_engine_listener_set_cone(pEngine, 0, innerAngleRad, outerAngleRad, outerGain);
+}
 
-    stbi_set_flip_vertically_on_load_thread(flipVertically);
-    int imageWidth, imageHeight, imageChannels;
-    stbi_uc* pixels = stbi_load_from_memory(data, length, &imageWidth, &imageHeight, &imageChannels, forceChannels);
+LvnVec3 listenerGetPosition()
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return LvnVec3{}; }
 
-    if (!pixels)
-    {
-        LVN_CORE_ERROR("loadImageDataMemoryThread(const unsigned char*) | failed to load image pixel data from memory: %p", data);
-        return {};
-    }
+    ma_vec3f pos = ma_engine_listener_get_position(pEngine, 0);
+    return LvnVec3{ pos.x, pos.y, pos.z };
+}
 
-    LvnImageData imageData{};
-    imageData.width = imageWidth;
-    imageData.height = imageHeight;
-    imageData.channels = forceChannels ? forceChannels : imageChannels;
-    imageData.size = imageData.width * imageData.height * imageData.channels;
-    imageData.pixels = LvnData<uint8_t>(pixels, imageData.size);
+LvnVec3 listenerGetDirection()
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return LvnVec3{}; }
+
+    ma_vec3f dir = ma_engine_listener_get_position(pEngine, 0);
+    return LvnVec3{ dir.x, dir.y, dir.z };
+}
 
-    LVN_CORE_TRACE("loaded image data from memory <unsigned char*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes", pixels, imageData.width, imageData.height, imageData.channels, imageData.size);
+LvnVec3 listenerGetWorldUp()
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return LvnVec3{}; }
 
-    stbi_image_free(pixels);
+    ma_vec3f up = ma_engine_listener_get_position(pEngine, 0);
+    return LvnVec3{ up.x, up.y, up.z };
+}
 
-    return imageData;
+void listenerGetCone(float* innerAngleRad, float* outerAngleRad, float* outerGain)
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
+
+    ma_engine_listener_get_cone(pEngine, 0, innerAngleRad, outerAngleRad, outerGain);
 }
 
-LvnImageHdrData loadHdrImageData(const char* filepath, int forceChannels, bool flipVertically)
+
+static ma_data_source_vtable s_SoundStreamVtable =
 {
-    if (filepath == nullptr)
+    lvn::soundStreamRead,
+    lvn::soundStreamSeek,
+    lvn::soundStreamGetDataFormat,
+    lvn::soundStreamGetCursor,
+    lvn::soundStreamGetLength,
+    NULL,
+    MA_DATA_SOURCE_SELF_MANAGED_RANGE_AND_LOOP_POINT, // looping is done by the stream thread so the loop point costs no seek
+};
+
+static ma_result soundStreamRead(ma_data_source* pDataSource, void* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead)
+{
+    LvnSoundStream* stream = static_cast<LvnSoundStream*>(pDataSource);
+    uint32_t frameSize = ma_get_bytes_per_frame(ma_format_f32, stream->channels);
+    ma_uint64 framesRead = 0;
+
+    // everything buffered was decoded before a pending seek, drop it so the stream thread can refill from the new position
+    if (stream->seekFrame.load(std::memory_order_acquire) != UINT64_MAX)
     {
-        LVN_CORE_ERROR("loadHdrImageData(const char*) | invalid filepath, filepath must not be nullptr");
-        return {};
+        ma_uint32 stale = ma_pcm_rb_available_read(&stream->buffer);
+        ma_pcm_rb_seek_read(&stream->buffer, stale);
+        stream->readFrames += stale;
+        *pFramesRead = 0;
+        return MA_BUSY;
     }
 
-    if (forceChannels < 0)
+    uint64_t validFrom = stream->validFrom.load(std::memory_order_acquire);
+    if (stream->readFrames < validFrom)
     {
-        LVN_CORE_ERROR("loadHdrImageData(const char*) | forceChannels < 0, channels cannot be negative");
-        return {};
+        ma_uint32 stale = static_cast<ma_uint32>(lvn::min<uint64_t>(validFrom - stream->readFrames, ma_pcm_rb_available_read(&stream->buffer)));
+        ma_pcm_rb_seek_read(&stream->buffer, stale);
+        stream->readFrames += stale;
     }
-    else if (forceChannels > 4)
+
+    while (stream->readFrames >= validFrom && framesRead < frameCount)
     {
-        LVN_CORE_ERROR("loadHdrImageData(const char*) | forceChannels > 4, channels cannot be higher than 4 components (rgba)");
-        return {};
-    }
+        ma_uint32 frames = static_cast<ma_uint32>(lvn::min<ma_uint64>(frameCount - framesRead, UINT32_MAX));
+        void* pBuffer;
+        if (ma_pcm_rb_acquire_read(&stream->buffer, &frames, &pBuffer) != MA_SUCCESS || frames == 0)
+            break;
 
-    stbi_set_flip_vertically_on_load(flipVertically);
-    int imageWidth, imageHeight, imageChannels;
-    float* pixels = stbi_loadf(filepath, &imageWidth, &imageHeight, &imageChannels, forceChannels);
+        // a null output is a forward seek within the buffered frames
+        if (pFramesOut != NULL)
+            memcpy(static_cast<uint8_t*>(pFramesOut) + framesRead * frameSize, pBuffer, static_cast<size_t>(frames) * frameSize);
 
-    if (!pixels)
-    {
-        LVN_CORE_ERROR("loadHdrImageData(const char*) | failed to load image pixel data from file: %s", filepath);
-        return {};
+        ma_pcm_rb_commit_read(&stream->buffer, frames);
+        framesRead += frames;
+        stream->readFrames += frames;
     }
 
-    LvnImageHdrData imageData{};
-    imageData.width = imageWidth;
-    imageData.height = imageHeight;
-    imageData.channels = forceChannels ? forceChannels : imageChannels;
-    imageData.size = imageData.width * imageData.height * imageData.channels;
-    imageData.pixels = LvnData<float>(pixels, imageData.size);
+    stream->cursor.fetch_add(framesRead, std::memory_order_relaxed);
+    *pFramesRead = framesRead;
 
-    LVN_CORE_TRACE("loaded hdr image data <float*> (%p), (w:%u,h:%u,ch:%u), total memory size: %u bytes, filepath: %s", pixels, imageData.width, imageData.height, imageData.channels, imageData.size, filepath);
+    if (framesRead == frameCount)
+        return MA_SUCCESS;
 
-    stbi_image_free(pixels);
+    // the end is only reached once the decoder has finished and every written frame was played, otherwise the buffer ran dry
+    if (stream->decodedToEnd.load(std::memory_order_acquire) && stream->readFrames == stream->writtenFrames.load(std::memory_order_acquire))
+        return framesRead == 0 ? MA_AT_END : MA_SUCCESS;
 
-    return imageData;
+    return MA_BUSY;
 }
 
-LvnResult writeImagePng(const LvnImageData& imageData, const char* filename)
+static ma_result soundStreamSeek(ma_data_source* pDataSource, ma_uint64 frameIndex)
 {
-    int stride = imageData.width * imageData.channels;
-    int result = stbi_write_png(filename, (int)imageData.width, (int)imageData.height, (int)imageData.channels, imageData.pixels.data(), stride);
-    return result ? Lvn_Result_Success : Lvn_Result_Failure;
+    LvnSoundStream* stream = static_cast<LvnSoundStream*>(pDataSource);
+
+    // soundSeekToPcmFrame has already started decoding from here
+    if (stream->prefetchFrame.exchange(UINT64_MAX, std::memory_order_acq_rel) == frameIndex)
+        return MA_SUCCESS;
+
+    lvn::soundStreamRequestSeek(stream, frameIndex);
+    return MA_SUCCESS;
 }
 
-LvnResult writeImageJpg(const LvnImageData& imageData, const char* filename, int quality)
+static ma_result soundStreamGetDataFormat(ma_data_source* pDataSource, ma_format* pFormat, ma_uint32* pChannels, ma_uint32* pSampleRate, ma_channel* pChannelMap, size_t channelMapCap)
 {
-    int result = stbi_write_jpg(filename, imageData.width, imageData.height, imageData.channels, imageData.pixels.data(), quality);
-    return result ? Lvn_Result_Success : Lvn_Result_Failure;
+    LvnSoundStream* stream = static_cast<LvnSoundStream*>(pDataSource);
+
+    *pFormat = ma_format_f32;
+    *pChannels = stream->channels;
+    *pSampleRate = stream->sampleRate;
+    if (pChannelMap != NULL)
+        ma_channel_map_init_standard(ma_standard_channel_map_default, pChannelMap, channelMapCap, stream->channels);
+
+    return MA_SUCCESS;
 }
 
-LvnResult writeImageBmp(const LvnImageData& imageData, const char* filename)
+static ma_result soundStreamGetCursor(ma_data_source* pDataSource, ma_uint64* pCursor)
 {
-    int result = stbi_write_bmp(filename, imageData.width, imageData.height, imageData.channels, imageData.pixels.data());
-    return result ? Lvn_Result_Success : Lvn_Result_Failure;
+    LvnSoundStream* stream = static_cast<LvnSoundStream*>(pDataSource);
+    uint64_t length = stream->length.load(std::memory_order_relaxed);
+    uint64_t cursor = stream->cursor.load(std::memory_order_relaxed);
+
+    // the cursor keeps counting through loops, wrap it back into the track
+    *pCursor = (length != UINT64_MAX && length != 0 && cursor > length) ? cursor % length : cursor;
+    return MA_SUCCESS;
 }
 
-void imageFlipVertically(LvnImageData& imageData)
+static ma_result soundStreamGetLength(ma_data_source* pDataSource, ma_uint64* pLength)
 {
-    uint8_t* data = imageData.pixels.data();
-    uint32_t rowSize = imageData.width * imageData.channels;
-    LvnVector<uint8_t> tempRow(rowSize);
+    LvnSoundStream* stream = static_cast<LvnSoundStream*>(pDataSource);
+    uint64_t length = stream->length.load(std::memory_order_relaxed);
 
-    for (uint32_t y = 0; y < imageData.height / 2; y++)
+    // not measured yet or the decoder cannot tell
+    if (length == UINT64_MAX || length == 0)
     {
-        uint8_t* rowTop = data + y * rowSize;
-        uint8_t* rowBottom = data + (imageData.height - y - 1) * rowSize;
-
-        memcpy(tempRow.data(), rowTop, rowSize);
-        memcpy(rowTop, rowBottom, rowSize);
-        memcpy(rowBottom, tempRow.data(), rowSize);
+        *pLength = 0;
+        return MA_NOT_IMPLEMENTED;
     }
+
+    *pLength = length;
+    return MA_SUCCESS;
 }
 
-void imageFlipHorizontally(LvnImageData& imageData)
+static void soundStreamRequestSeek(LvnSoundStream* stream, uint64_t frame)
 {
-    uint8_t* data = imageData.pixels.data();
+    stream->cursor.store(frame, std::memory_order_relaxed);
+    stream->seekFrame.store(frame, std::memory_order_release);
+    lvn::getContext()->soundStreamCondition.notify_one();
+}
 
-    for (uint32_t y = 0; y < imageData.height; y++)
+// runs on the stream thread with soundStreamMutex held
+static void soundStreamService(LvnSoundStream* stream)
+{
+    uint64_t seekFrame = stream->seekFrame.load(std::memory_order_acquire);
+    if (seekFrame != UINT64_MAX)
     {
-        uint8_t* row = data + y * imageData.width * imageData.channels;
+        ma_decoder_seek_to_pcm_frame(&stream->decoder, seekFrame);
+        stream->decodedToEnd.store(false, std::memory_order_relaxed);
+        stream->validFrom.store(stream->writtenFrames.load(std::memory_order_relaxed), std::memory_order_release);
 
-        for (uint32_t x = 0; x < imageData.width / 2; x++)
-        {
-            uint8_t* leftpx = row + x * imageData.channels;
-            uint8_t* rightpx = row + (imageData.width - x - 1) * imageData.channels;
+        // a newer seek keeps the request pending for the next pass
+        stream->seekFrame.compare_exchange_strong(seekFrame, UINT64_MAX, std::memory_order_acq_rel);
+    }
+
+    bool looping = ma_data_source_is_looping(&stream->base);
+    if (stream->decodedToEnd.load(std::memory_order_relaxed))
+    {
+        if (!looping) { return; }
+
+        // looping was turned on after the decoder finished
+        ma_decoder_seek_to_pcm_frame(&stream->decoder, 0);
+        stream->decodedToEnd.store(false, std::memory_order_relaxed);
+    }
+
+    uint32_t emptyReads = 0;
+    while (true)
+    {
+        ma_uint32 frames = ma_pcm_rb_available_write(&stream->buffer);
+        if (frames == 0) { break; }
+
+        void* pBuffer;
+        if (ma_pcm_rb_acquire_write(&stream->buffer, &frames, &pBuffer) != MA_SUCCESS || frames == 0)
+            break;
+
+        ma_uint64 framesDecoded = 0;
+        ma_result result = ma_decoder_read_pcm_frames(&stream->decoder, pBuffer, frames, &framesDecoded);
+        ma_pcm_rb_commit_write(&stream->buffer, static_cast<ma_uint32>(framesDecoded));
+        stream->writtenFrames.fetch_add(framesDecoded, std::memory_order_release);
+
+        if (framesDecoded == frames && result == MA_SUCCESS)
+            continue;
 
-            for (uint32_t c = 0; c < imageData.channels; c++)
-                lvn::swap(leftpx[c], rightpx[c]);
+        // the track has ended, looping sounds continue from the start without a gap
+        if (!looping || (framesDecoded == 0 && ++emptyReads > 1))
+        {
+            stream->decodedToEnd.store(true, std::memory_order_release);
+            break;
         }
+        if (framesDecoded != 0)
+            emptyReads = 0;
+
+        ma_decoder_seek_to_pcm_frame(&stream->decoder, 0);
+    }
+
+    // measured once the buffer is full, mp3 lengths are counted by decoding the whole track
+    if (stream->length.load(std::memory_order_relaxed) == UINT64_MAX)
+    {
+        ma_uint64 length = 0;
+        if (ma_decoder_get_length_in_pcm_frames(&stream->decoder, &length) != MA_SUCCESS)
+            length = 0;
+        stream->length.store(length, std::memory_order_relaxed);
     }
 }
 
-void imageRotateCW(LvnImageData& imageData)
+static void* soundStreamThread(void* arg)
 {
-    uint8_t* data = imageData.pixels.data();
-    uint32_t newWidth = imageData.height;
-    uint32_t newHeight = imageData.width;
-
-    LvnVector<uint8_t> rotated(newWidth * newHeight * imageData.channels);
+    LvnContext* lvnctx = static_cast<LvnContext*>(arg);
 
-    for (uint32_t y = 0; y < imageData.height; y++)
+    std::unique_lock<std::mutex> lock(lvnctx->soundStreamMutex);
+    while (!lvnctx->soundStreamStop)
     {
-        for (uint32_t x = 0; x < imageData.width; x++)
-        {
-            for (uint32_t c = 0; c < imageData.channels; c++)
-            {
-                uint32_t srcIndex = (y * imageData.width + x) * imageData.channels + c;
-                uint32_t dstx = imageData.height - 1 - y;
-                uint32_t dsty = x;
-                uint32_t dstIndex = (dsty * newWidth + dstx) * imageData.channels + c;
-                rotated[dstIndex] = data[srcIndex];
-            }
-        }
+        for (LvnSoundStream* stream : lvnctx->soundStreams)
+            lvn::soundStreamService(stream);
+
+        // the shortest stream buffer is refilled well before it can run dry, seeks and new sounds wake the thread early
+        lvnctx->soundStreamCondition.wait_for(lock, std::chrono::milliseconds(LVN_SOUND_STREAM_INTERVAL));
     }
 
-    imageData.pixels = lvn::move(LvnData<uint8_t>(rotated.data(), rotated.size()));
-    lvn::swap(imageData.width, imageData.height);
+    return nullptr;
 }
 
-void imageRotateCCW(LvnImageData& imageData)
+static LvnSoundStream* createSoundStream(LvnContext* lvnctx, LvnSound* sound, const LvnSoundCreateInfo* createInfo)
 {
-    uint8_t* data = imageData.pixels.data();
-    uint32_t newWidth = imageData.height;
-    uint32_t newHeight = imageData.width;
+    LvnSoundStream* stream = lvn::memNew<LvnSoundStream>();
 
-    LvnVector<uint8_t> rotated(newWidth * newHeight * imageData.channels);
+    // the decoder converts to f32 so the audio thread only copies frames out of the buffer
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, 0, 0);
+    ma_result result = sound->packedData.data() != nullptr
+        ? ma_decoder_init_memory(sound->packedData.data(), sound->packedData.size(), &decoderConfig, &stream->decoder)
+        : ma_decoder_init_file(createInfo->filepath.c_str(), &decoderConfig, &stream->decoder);
 
-    for (uint32_t y = 0; y < imageData.height; y++)
+    if (result != MA_SUCCESS)
+    {
+        lvn::memDelete(stream);
+        LVN_CORE_ERROR("createSound(LvnSound**, LvnSoundCreateInfo*) | failed to open sound for streaming, filepath: %s", createInfo->filepath.c_str());
+        return nullptr;
+    }
+
+    ma_format format;
+    ma_decoder_get_data_format(&stream->decoder, &format, &stream->channels, &stream->sampleRate, NULL, 0);
+
+    uint32_t bufferFrames = lvn::max(static_cast<uint32_t>(static_cast<uint64_t>(stream->sampleRate) * createInfo->streamBufferMilliseconds / 1000), static_cast<uint32_t>(LVN_SOUND_STREAM_MIN_FRAMES));
+    if (ma_pcm_rb_init(ma_format_f32, stream->channels, bufferFrames, NULL, NULL, &stream->buffer) != MA_SUCCESS)
+    {
+        ma_decoder_uninit(&stream->decoder);
+        lvn::memDelete(stream);
+        LVN_CORE_ERROR("createSound(LvnSound**, LvnSoundCreateInfo*) | failed to allocate stream buffer of %u frames", bufferFrames);
+        return nullptr;
+    }
+
+    ma_data_source_config dataSourceConfig = ma_data_source_config_init();
+    dataSourceConfig.vtable = &s_SoundStreamVtable;
+    ma_data_source_init(&dataSourceConfig, &stream->base);
+
+    stream->length = UINT64_MAX;
+    stream->cursor = 0;
+    stream->seekFrame = UINT64_MAX;
+    stream->prefetchFrame = UINT64_MAX;
+    stream->writtenFrames = 0;
+    stream->validFrom = 0;
+    stream->decodedToEnd = false;
+    stream->readFrames = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(lvnctx->soundStreamMutex);
+        lvnctx->soundStreams.push_back(stream);
+        if (lvnctx->soundStreamThread == nullptr)
+            lvnctx->soundStreamThread = new LvnThread(lvn::soundStreamThread, lvnctx);
+    }
+    lvnctx->soundStreamCondition.notify_one();
+
+    return stream;
+}
+
+static void destroySoundStream(LvnContext* lvnctx, LvnSoundStream* stream)
+{
     {
-        for (uint32_t x = 0; x < imageData.width; x++)
+        std::lock_guard<std::mutex> lock(lvnctx->soundStreamMutex);
+        for (size_t i = 0; i < lvnctx->soundStreams.size(); i++)
         {
-            for (uint32_t c = 0; c < imageData.channels; c++)
+            if (lvnctx->soundStreams[i] == stream)
             {
-                uint32_t srcIndex = (y * imageData.width + x) * imageData.channels + c;
-                uint32_t dstx = y;
-                uint32_t dsty = imageData.width - 1 - x;
-                uint32_t dstIndex = (dsty * newWidth + dstx) * imageData.channels + c;
-                rotated[dstIndex] = data[srcIndex];
+                lvnctx->soundStreams.erase_index(i);
+                break;
             }
         }
     }
 
-    imageData.pixels = lvn::move(LvnData<uint8_t>(rotated.data(), rotated.size()));
-    lvn::swap(imageData.width, imageData.height);
+    ma_data_source_uninit(&stream->base);
+    ma_pcm_rb_uninit(&stream->buffer);
+    ma_decoder_uninit(&stream->decoder);
+    lvn::memDelete(stream);
 }
 
-LvnImageData imageGenWhiteNoise(uint32_t width, uint32_t height, uint32_t channels)
+static LvnResult createSoundObject(LvnSound** sound, const LvnSoundCreateInfo* createInfo, bool async, const char* funcName)
 {
-    return lvn::imageGenWhiteNoise(width, height, channels, time(0));
-}
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Audio);
+    LvnContext* lvnctx = lvn::getContext();
+    ma_engine* pEngine = lvn::getAudioEngine(lvnctx);
+    if (pEngine == nullptr)
+    {
+        LVN_CORE_ERROR("%s | audio context is not available, failed to initialize or disabled by the context create info", funcName);
+        return Lvn_Result_Failure;
+    }
 
-LvnImageData imageGenWhiteNoise(uint32_t width, uint32_t height, uint32_t channels, uint32_t seed)
-{
-    LVN_CORE_ASSERT(channels > 0 && channels <= 4, "channels must be within 0 to 4");
-    srand(seed);
+    if (createInfo->filepath.empty())
+    {
+        LVN_CORE_ERROR("%s | createInfo->filepath is nullptr, cannot load sound data without a valid path to the sound file", funcName);
+        return Lvn_Result_Failure;
+    }
 
-    uint32_t imgSize = width * height * channels;
-    uint8_t* imgBuff = (uint8_t*)LVN_MALLOC(imgSize);
+    *sound = lvn::createObject<LvnSound>(lvnctx, Lvn_Stype_Sound);
 
-    for (uint32_t y = 0; y < height; y++)
+    LvnSound* soundPtr = *sound;
+    soundPtr->volume = createInfo->volume;
+    soundPtr->pan = createInfo->pan;
+    soundPtr->pitch = createInfo->pitch;
+    soundPtr->pos = createInfo->pos;
+    soundPtr->looping = createInfo->looping;
+    soundPtr->audibleRadius = createInfo->audibleRadius;
+    soundPtr->priority = createInfo->priority;
+
+    ma_sound_config soundConfig{};
+    ma_sound_group* pGroup = createInfo->group != nullptr ? &createInfo->group->group : NULL;
+    bool packed = lvn::vfsReadFile(createInfo->filepath.c_str(), &soundPtr->packedData);
+
+    // streamed sounds are decoded ahead by the stream thread, without multithreading files fall back to miniaudio streaming
+    if (createInfo->stream && lvnctx->multithreading)
     {
-        for (uint32_t x = 0; x < width; x++)
+        soundPtr->stream = lvn::createSoundStream(lvnctx, soundPtr, createInfo);
+        if (soundPtr->stream == nullptr)
+            return Lvn_Result_Failure;
+
+        if (ma_sound_init_from_data_source(pEngine, &soundPtr->stream->base, createInfo->flags, pGroup, &soundPtr->sound) != MA_SUCCESS)
         {
-            int rn = rand() % 2;
-            for (uint32_t c = 0; c < channels; c++)
-                imgBuff[y * width * channels + x * channels + c] = (c == 3 ? 255 : (rn ? 255 : 0));
+            lvn::destroySoundStream(lvnctx, soundPtr->stream);
+            LVN_CORE_ERROR("%s | failed to create sound object", funcName);
+            return Lvn_Result_Failure;
         }
     }
+    // miniaudio opens files by itself, sounds in packs are decoded from memory instead
+    else if (packed)
+    {
+        if (ma_decoder_init_memory(soundPtr->packedData.data(), soundPtr->packedData.size(), NULL, &soundPtr->decoder) != MA_SUCCESS)
+        {
+            LVN_CORE_ERROR("%s | failed to decode sound data from pack, filepath: %s", funcName, createInfo->filepath.c_str());
+            return Lvn_Result_Failure;
+        }
+        soundPtr->packed = true;
 
-    LvnImageData imageData{};
-    imageData.width = width;
-    imageData.height = height;
-    imageData.channels = channels;
-    imageData.size = width * height * channels;
-    imageData.pixels = LvnData<uint8_t>(imgBuff, imgSize);
+        if (ma_sound_init_from_data_source(pEngine, &soundPtr->decoder, createInfo->flags, pGroup, &soundPtr->sound) != MA_SUCCESS)
+        {
+            ma_decoder_uninit(&soundPtr->decoder);
+            LVN_CORE_ERROR("%s | failed to create sound object", funcName);
+            return Lvn_Result_Failure;
+        }
+    }
+    // async sounds are opened and decoded by the job thread of the miniaudio resource manager, the fence is released once the data is loaded or failed to load
+    else if (async)
+    {
+        ma_fence_init(&soundPtr->loadFence);
+        soundPtr->async = true;
 
-    LVN_FREE(imgBuff);
-    return imageData;
+        soundConfig = ma_sound_config_init_2(pEngine);
+        soundConfig.pFilePath = createInfo->filepath.c_str();
+        soundConfig.pInitialAttachment = pGroup;
+        soundConfig.flags = createInfo->flags | MA_SOUND_FLAG_ASYNC | (createInfo->stream ? MA_SOUND_FLAG_STREAM : 0);
+        soundConfig.initNotifications.done.pFence = &soundPtr->loadFence;
+
+        if (ma_sound_init_ex(pEngine, &soundConfig, &soundPtr->sound) != MA_SUCCESS)
+        {
+            ma_fence_uninit(&soundPtr->loadFence);
+            LVN_CORE_ERROR("%s | failed to create sound object", funcName);
+            return Lvn_Result_Failure;
+        }
+    }
+    else if (ma_sound_init_from_file(pEngine, createInfo->filepath.c_str(), createInfo->flags | (createInfo->stream ? MA_SOUND_FLAG_STREAM : 0), pGroup, NULL, &soundPtr->sound) != MA_SUCCESS)
+    {
+        LVN_CORE_ERROR("%s | failed to create sound object", funcName);
+        return Lvn_Result_Failure;
+    }
+
+    ma_sound_set_volume(&soundPtr->sound, createInfo->volume);
+    ma_sound_set_pan(&soundPtr->sound, createInfo->pan);
+    ma_sound_set_pitch(&soundPtr->sound, createInfo->pitch);
+    ma_sound_set_position(&soundPtr->sound, createInfo->pos.x, createInfo->pos.y, createInfo->pos.z);
+    ma_sound_set_looping(&soundPtr->sound, createInfo->looping);
+
+    {
+        LvnLockGaurd lock(lvnctx->soundsMutex);
+        lvnctx->sounds.push_back(soundPtr);
+    }
+
+    LVN_CORE_TRACE("created sound: (%p), volume: %.2f, pan: %.2f, pitch: %.2f%s", *sound, createInfo->volume, createInfo->pan, createInfo->pitch, soundPtr->async ? ", loading in the background" : "");
+    return Lvn_Result_Success;
 }
 
-LvnImageData imageGenGrayScaleNoise(uint32_t width, uint32_t height, uint32_t channels)
+LvnResult createSound(LvnSound** sound, const LvnSoundCreateInfo* createInfo)
 {
-    return lvn::imageGenGrayScaleNoise(width, height, channels, time(0));
+    return lvn::createSoundObject(sound, createInfo, false, "createSound(LvnSound**, LvnSoundCreateInfo*)");
 }
 
-LvnImageData imageGenGrayScaleNoise(uint32_t width, uint32_t height, uint32_t channels, uint32_t seed)
+LvnResult createSoundAsync(LvnSound** sound, const LvnSoundCreateInfo* createInfo)
 {
-    LVN_CORE_ASSERT(channels > 0 && channels <= 4, "channels must be within 0 to 4");
-    srand(seed);
+    return lvn::createSoundObject(sound, createInfo, true, "createSoundAsync(LvnSound**, LvnSoundCreateInfo*)");
+}
 
-    uint32_t imgSize = width * height * channels;
-    uint8_t* imgBuff = (uint8_t*)LVN_MALLOC(imgSize);
+void destroySound(LvnSound* sound)
+{
+    if (sound == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
 
-    for (uint32_t y = 0; y < height; y++)
     {
-        for (uint32_t x = 0; x < width; x++)
+        LvnLockGaurd lock(lvnctx->soundsMutex);
+        for (size_t i = 0; i < lvnctx->sounds.size(); i++)
         {
-            int rn = rand() % 256;
-            for (uint32_t c = 0; c < channels; c++)
-                imgBuff[y * width * channels + x * channels + c] = (c == 3 ? 255 : rn);
+            if (lvnctx->sounds[i] == sound)
+            {
+                lvnctx->sounds[i] = lvnctx->sounds.back();
+                lvnctx->sounds.pop_back();
+                break;
+            }
         }
     }
 
-    LvnImageData imageData{};
-    imageData.width = width;
-    imageData.height = height;
-    imageData.channels = channels;
-    imageData.size = width * height * channels;
-    imageData.pixels = LvnData<uint8_t>(imgBuff, imgSize);
+    // the resource manager releases the fence when loading ends, it must not outlive the sound
+    if (sound->async)
+    {
+        ma_fence_wait(&sound->loadFence);
+        ma_fence_uninit(&sound->loadFence);
+    }
 
-    LVN_FREE(imgBuff);
-    return imageData;
+    ma_sound_uninit(&sound->sound);
+    if (sound->packed)
+        ma_decoder_uninit(&sound->decoder);
+    if (sound->stream != nullptr)
+        lvn::destroySoundStream(lvnctx, sound->stream);
+
+    lvn::destroyObject(lvnctx, sound, Lvn_Stype_Sound);
 }
 
-LvnModel loadModel(const char* filepath)
+LvnSoundCreateInfo configSoundInit(const char* filepath)
 {
-    LvnString filepathstr(filepath);
-    LvnString extensionType = filepathstr.substr(filepathstr.find_last_of(".") + 1);
+    LvnSoundCreateInfo soundInit{};
+    soundInit.pos = { 0.0f, 0.0f, 0.0f };
+    soundInit.volume = 1.0f;
+    soundInit.pan = 0.0f;
+    soundInit.pitch = 1.0f;
+    soundInit.looping = false;
+    soundInit.filepath = filepath;
+    soundInit.audibleRadius = 0.0f;
+    soundInit.priority = 0;
+    soundInit.group = nullptr;
+    soundInit.stream = false;
+    soundInit.streamBufferMilliseconds = 500;
 
-    if (extensionType == "gltf")
-    {
-        return lvn::loadGltfModel(filepath);
-    }
-    else if (extensionType == "glb")
-    {
-        return lvn::loadGlbModel(filepath);
-    }
-    else if (extensionType == "obj")
-    {
-        return lvn::loadObjModel(filepath);
-    }
+    return soundInit;
+}
 
-    LVN_CORE_WARN("loadModel(const char*) | could not load model, file extension type not recognized (%s), Filepath: %s", extensionType.c_str(), filepath);
-    return {};
+void soundSetVolume(LvnSound* sound, float volume)
+{
+    ma_sound_set_volume(&sound->sound, volume);
 }
 
-void unloadModel(LvnModel* model)
+void soundSetPan(LvnSound* sound, float pan)
 {
-    for (uint32_t i = 0; i < model->samplers.size(); i++)
-    {
-        lvn::destroySampler(model->samplers[i]);
-    }
-    for (uint32_t i = 0; i < model->textures.size(); i++)
-    {
-        lvn::destroyTexture(model->textures[i]);
-    }
-    for (uint32_t i = 0; i < model->buffers.size(); i++)
-    {
-        lvn::destroyBuffer(model->buffers[i]);
-    }
-    for (uint32_t i = 0; i < model->skins.size(); i++)
-    {
-        lvn::destroyBuffer(model->skins[i].ssbo);
-    }
+    ma_sound_set_pan(&sound->sound, pan);
 }
 
+void soundSetPitch(LvnSound* sound, float pitch)
+{
+    ma_sound_set_pitch(&sound->sound, pitch);
+}
 
-// ------------------------------------------------------------
-// [SECTION]: Audio Functions
-// ------------------------------------------------------------
+void soundSetPositioning(LvnSound* sound, LvnSoundPositioningFlags positioning)
+{
+    ma_sound_set_positioning(&sound->sound, static_cast<ma_positioning>(positioning));
+}
 
-float volumeDbToLinear(float db)
+void soundSetPosition(LvnSound* sound, float x, float y, float z)
 {
-    return ma_volume_db_to_linear(db);
+    sound->pos = LvnVec3{ x, y, z };
+    ma_sound_set_position(&sound->sound, x, y, z);
 }
 
-float volumeLineatToDb(float volume)
+void soundSetPosition(LvnSound* sound, const LvnVec3& pos)
 {
-    return ma_volume_linear_to_db(volume);
+    sound->pos = pos;
+    ma_sound_set_position(&sound->sound, pos.x, pos.y, pos.z);
 }
 
-void audioSetGlobalTimeMilliSeconds(uint64_t ms)
+void soundSetDirection(LvnSound* sound, float x, float y, float z)
 {
-    ma_engine_set_time_in_milliseconds(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), ms);
+    ma_sound_set_direction(&sound->sound, x, y, z);
 }
 
-void audioSetGlobalTimePcmFrames(uint64_t pcm)
+void soundSetDirection(LvnSound* sound, const LvnVec3& dir)
 {
-    ma_engine_set_time_in_pcm_frames(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), pcm);
+    ma_sound_set_direction(&sound->sound, dir.x, dir.y, dir.z);
 }
 
-void audioSetMasterVolume(float volume)
+void soundSetVelocity(LvnSound* sound, float x, float y, float z)
 {
-    ma_engine_set_volume(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), volume);
+    sound->vel = LvnVec3{ x, y, z };
+    ma_sound_set_velocity(&sound->sound, x, y, z);
 }
 
-uint32_t audioGetSampleRate()
+void soundSetVelocity(LvnSound* sound, const LvnVec3& vel)
 {
-    return ma_engine_get_sample_rate(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr));
+    sound->vel = vel;
+    ma_sound_set_velocity(&sound->sound, vel.x, vel.y, vel.z);
 }
 
-uint64_t audioGetGlobalTimeMilliseconds()
+void soundSetCone(LvnSound* sound, float innerAngleRad, float outerAngleRad, float outerGain)
 {
-    return ma_engine_get_time_in_milliseconds(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr));
+    ma_sound_group_set_cone(&sound->sound, innerAngleRad, outerAngleRad, outerGain);
 }
 
-uint64_t audioGetGlobalTimePcmFrames()
+void soundSetAttenuation(LvnSound* sound, LvnSoundAttenuationFlags attenuation)
 {
-    return ma_engine_get_time_in_pcm_frames(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr));
+    ma_sound_set_attenuation_model(&sound->sound, static_cast<ma_attenuation_model>(attenuation));
 }
 
+void soundSetRolloff(LvnSound* sound, float rolloff)
+{
+    ma_sound_set_rolloff(&sound->sound, rolloff);
+}
 
-void listenerSetPosition(float x, float y, float z)
+void soundSetMinGain(LvnSound* sound, float minGain)
 {
-    ma_engine_listener_set_position(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, x, y, z);
+    ma_sound_set_min_gain(&sound->sound, minGain);
 }
 
-void listenerSetPosition(const LvnVec3& pos)
+void soundSetMaxGain(LvnSound* sound, float maxGain)
 {
-    ma_engine_listener_set_position(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, pos.x, pos.y, pos.z);
+    ma_sound_set_max_gain(&sound->sound, maxGain);
 }
 
-void listenerSetDirection(float x, float y, float z)
+void soundSetMinDistance(LvnSound* sound, float minDist)
 {
-    ma_engine_listener_set_direction(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, x, y, z);
+    ma_sound_set_min_distance(&sound->sound, minDist);
 }
 
-void listenerSetDirection(const LvnVec3 dir)
+void soundSetMaxDistance(LvnSound* sound, float maxDist)
 {
-    ma_engine_listener_set_direction(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, dir.x, dir.y, dir.z);
+    ma_sound_set_max_distance(&sound->sound, maxDist);
 }
 
-void listenerSetVelocity(float x, float y, float z)
+void soundSetDopplerFactor(LvnSound* sound, float dopplerFactor)
 {
-    ma_engine_listener_set_velocity(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, x, y, z);
+    ma_sound_set_doppler_factor(&sound->sound, dopplerFactor);
 }
 
-void listenerSetVelocity(const LvnVec3 vel)
+void soundSetAudibleRadius(LvnSound* sound, float radius)
 {
-    ma_engine_listener_set_velocity(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, vel.x, vel.y, vel.z);
+    sound->audibleRadius = radius;
 }
 
-void listenerSetWorldUp(float x, float y, float z)
+void soundSetPriority(LvnSound* sound, uint32_t priority)
 {
-    ma_engine_listener_set_world_up(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, x, y, z);
+    sound->priority = priority;
 }
 
-void listenerSetWorldUp(const LvnVec3 up)
+void soundSetLooping(LvnSound* sound, bool looping)
 {
-    ma_engine_listener_set_world_up(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, up.x, up.y, up.z);
+    ma_sound_set_looping(&sound->sound, looping);
 }
 
-void listenerSetCone(float innerAngleRad, float outerAngleRad, float outerGain)
+void soundPlayStart(LvnSound* sound)
+{
+    sound->virtualized = false;
+    ma_sound_start(&sound->sound);
+}
+
+void soundPlayStop(LvnSound* sound)
 {
-    ma_engine_listener_set_cone(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, innerAngleRad, outerAngleRad, outerGain);
+    sound->virtualized = false;
+    ma_sound_stop(&sound->sound);
 }
 
-LvnVec3 listenerGetPosition()
+void soundTogglePause(LvnSound* sound)
 {
-    ma_vec3f pos = ma_engine_listener_get_position(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0);
-    return LvnVec3{ pos.x, pos.y, pos.z };
+    // pausing a virtual sound keeps it where it was virtualized
+    if (sound->virtualized)
+        sound->virtualized = false;
+    else if (ma_sound_is_playing(&sound->sound))
+        ma_sound_stop(&sound->sound);
+    else
+        ma_sound_start(&sound->sound);
 }
 
-LvnVec3 listenerGetDirection()
+LVN_API void soundScheduleStartTimePcmFrames(LvnSound* sound, uint64_t pcm)
 {
-    ma_vec3f dir = ma_engine_listener_get_position(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0);
-    return LvnVec3{ dir.x, dir.y, dir.z };
+    ma_sound_set_start_time_in_pcm_frames(&sound->sound, pcm);
 }
 
-LvnVec3 listenerGetWorldUp()
+void soundScheduleStartTimeMilliseconds(LvnSound* sound, uint64_t ms)
 {
-    ma_vec3f up = ma_engine_listener_get_position(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0);
-    return LvnVec3{ up.x, up.y, up.z };
+    ma_sound_set_start_time_in_milliseconds(&sound->sound, ms);
 }
 
-void listenerGetCone(float* innerAngleRad, float* outerAngleRad, float* outerGain)
+LVN_API void soundScheduleStopTimePcmFrames(LvnSound* sound, uint64_t pcm)
 {
-    ma_engine_listener_get_cone(static_cast<ma_engine*>(lvn::getContext()->audioEngineContextPtr), 0, innerAngleRad, outerAngleRad, outerGain);
+    ma_sound_set_stop_time_in_pcm_frames(&sound->sound, pcm);
 }
 
+void soundScheduleStopTimeMilliseconds(LvnSound* sound, uint64_t ms)
+{
+    ma_sound_set_stop_time_in_milliseconds(&sound->sound, ms);
+}
 
-LvnResult createSound(LvnSound** sound, const LvnSoundCreateInfo* createInfo)
+void soundSetFadeMilliseconds(LvnSound* sound, float volBegin, float volEnd, uint64_t ms)
 {
-    LvnContext* lvnctx = lvn::getContext();
-    ma_engine* pEngine = static_cast<ma_engine*>(lvnctx->audioEngineContextPtr);
+    ma_sound_set_fade_in_milliseconds(&sound->sound, volBegin, volEnd, ms);
+}
 
-    if (createInfo->filepath.empty())
+void soundSetFadePcmFrames(LvnSound* sound, float volBegin, float volEnd, uint64_t pcm)
+{
+    ma_sound_set_fade_in_pcm_frames(&sound->sound, volBegin, volEnd, pcm);
+}
+
+void soundSeekToPcmFrame(LvnSound* sound, uint64_t pcm)
+{
+    // start decoding from the target now instead of when the audio thread applies the seek
+    if (sound->stream != nullptr)
     {
-        LVN_CORE_ERROR("createSound(LvnSound**, LvnSoundCreateInfo*) | createInfo->filepath is nullptr, cannot load sound data without a valid path to the sound file");
-        return Lvn_Result_Failure;
+        sound->stream->prefetchFrame.store(pcm, std::memory_order_release);
+        lvn::soundStreamRequestSeek(sound->stream, pcm);
     }
 
-    *sound = lvn::createObject<LvnSound>(lvnctx, Lvn_Stype_Sound);
-
-    LvnSound* soundPtr = *sound;
-    soundPtr->volume = createInfo->volume;
-    soundPtr->pan = createInfo->pan;
-    soundPtr->pitch = createInfo->pitch;
-    soundPtr->pos = createInfo->pos;
-    soundPtr->looping = createInfo->looping;
+    ma_sound_seek_to_pcm_frame(&sound->sound, pcm);
+}
 
-    ma_sound_config soundConfig{};
+float soundGetVolume(const LvnSound* sound)
+{
+    return ma_sound_get_volume(&sound->sound);
+}
 
-    if (ma_sound_init_from_file(pEngine, createInfo->filepath.c_str(), createInfo->flags, NULL, NULL, &soundPtr->sound) != MA_SUCCESS)
-    {
-        LVN_CORE_ERROR("createSound(LvnSound**, LvnSoundCreateInfo*) | failed to create sound object");
-        return Lvn_Result_Failure;
-    }
+float soundGetPan(const LvnSound* sound)
+{
+    return ma_sound_get_pan(&sound->sound);
+}
 
-    ma_sound_set_volume(&soundPtr->sound, createInfo->volume);
-    ma_sound_set_pan(&soundPtr->sound, createInfo->pan);
-    ma_sound_set_pitch(&soundPtr->sound, createInfo->pitch);
-    ma_sound_set_position(&soundPtr->sound, createInfo->pos.x, createInfo->pos.y, createInfo->pos.z);
-    ma_sound_set_looping(&soundPtr->sound, createInfo->looping);
+float soundGetPitch(const LvnSound* sound)
+{
+    return ma_sound_get_pitch(&sound->sound);
+}
 
-    LVN_CORE_TRACE("created sound: (%p), volume: %.2f, pan: %.2f, pitch: %.2f", *sound, createInfo->volume, createInfo->pan, createInfo->pitch);
-    return Lvn_Result_Success;
+LvnSoundPositioningFlags soundGetPositioning(const LvnSound* sound)
+{
+    return static_cast<LvnSoundPositioningFlags>(ma_sound_get_positioning(&sound->sound));
 }
 
-void destroySound(LvnSound* sound)
+LvnVec3 soundGetPosition(const LvnSound* sound)
 {
-    if (sound == nullptr) { return; }
-    LvnContext* lvnctx = lvn::getContext();
+    if (sound->virtualized)
+        return sound->pos;
 
-    ma_sound_uninit(&sound->sound);
+    ma_vec3f pos = ma_sound_get_position(&sound->sound);
+    return LvnVec3{ pos.x, pos.y, pos.z };
+}
 
-    lvn::destroyObject(lvnctx, sound, Lvn_Stype_Sound);
+LvnVec3 soundGetDirection(const LvnSound* sound)
+{
+    ma_vec3f dir = ma_sound_get_direction(&sound->sound);
+    return LvnVec3{ dir.x, dir.y, dir.z };
 }
 
-LvnSoundCreateInfo configSoundInit(const char* filepath)
+void soundGetCone(const LvnSound* sound, float* innerAngleRad, float* outerAngleRad, float* outerGain)
 {
-    LvnSoundCreateInfo soundInit{};
-    soundInit.pos = { 0.0f, 0.0f, 0.0f };
-    soundInit.volume = 1.0f;
-    soundInit.pan = 0.0f;
-    soundInit.pitch = 1.0f;
-    soundInit.looping = false;
-    soundInit.filepath = filepath;
+    ma_sound_get_cone(&sound->sound, innerAngleRad, outerAngleRad, outerGain);
+}
 
-    return soundInit;
+LvnVec3 soundGetVelocity(const LvnSound* sound)
+{
+    ma_vec3f vel = ma_sound_get_velocity(&sound->sound);
+    return LvnVec3{ vel.x, vel.y, vel.z };
 }
 
-void soundSetVolume(LvnSound* sound, float volume)
+LvnSoundAttenuationFlags soundGetAttenuation(const LvnSound* sound)
 {
-    ma_sound_set_volume(&sound->sound, volume);
+    return static_cast<LvnSoundAttenuationFlags>(ma_sound_get_attenuation_model(&sound->sound));
 }
 
-void soundSetPan(LvnSound* sound, float pan)
+float soundGetRolloff(const LvnSound* sound)
 {
-    ma_sound_set_pan(&sound->sound, pan);
+    return ma_sound_get_rolloff(&sound->sound);
 }
 
-void soundSetPitch(LvnSound* sound, float pitch)
+float soundGetMinGain(const LvnSound* sound)
 {
-    ma_sound_set_pitch(&sound->sound, pitch);
+    return ma_sound_get_min_gain(&sound->sound);
 }
 
-void soundSetPositioning(LvnSound* sound, LvnSoundPositioningFlags positioning)
+float soundGetMaxGain(const LvnSound* sound)
 {
-    ma_sound_set_positioning(&sound->sound, static_cast<ma_positioning>(positioning));
+    return ma_sound_get_max_gain(&sound->sound);
 }
 
-void soundSetPosition(LvnSound* sound, float x, float y, float z)
+float soundGetMinDistance(const LvnSound* sound)
 {
-    ma_sound_set_position(&sound->sound, x, y, z);
+    return ma_sound_get_min_distance(&sound->sound);
 }
 
-void soundSetPosition(LvnSound* sound, const LvnVec3& pos)
+float soundGetMaxDistance(const LvnSound* sound)
 {
-    ma_sound_set_position(&sound->sound, pos.x, pos.y, pos.z);
+    return ma_sound_get_max_distance(&sound->sound);
 }
 
-void soundSetDirection(LvnSound* sound, float x, float y, float z)
+float soundGetDopplerFactor(const LvnSound* sound)
 {
-    ma_sound_set_direction(&sound->sound, x, y, z);
+    return ma_sound_get_doppler_factor(&sound->sound);
 }
 
-void soundSetDirection(LvnSound* sound, const LvnVec3& dir)
+bool soundIsLooping(const LvnSound* sound)
 {
-    ma_sound_set_direction(&sound->sound, dir.x, dir.y, dir.z);
+    return ma_sound_is_looping(&sound->sound);
 }
 
-void soundSetVelocity(LvnSound* sound, float x, float y, float z)
+bool soundIsPlaying(const LvnSound* sound)
 {
-    ma_sound_set_velocity(&sound->sound, x, y, z);
+    return sound->virtualized || ma_sound_is_playing(&sound->sound);
 }
 
-void soundSetVelocity(LvnSound* sound, const LvnVec3& vel)
+bool soundAtEnd(const LvnSound* sound)
 {
-    ma_sound_set_velocity(&sound->sound, vel.x, vel.y, vel.z);
+    return ma_sound_at_end(&sound->sound);
 }
 
-void soundSetCone(LvnSound* sound, float innerAngleRad, float outerAngleRad, float outerGain)
+uint64_t soundGetTimeMilliseconds(const LvnSound* sound)
 {
-    ma_sound_group_set_cone(&sound->sound, innerAngleRad, outerAngleRad, outerGain);
+    return ma_sound_get_time_in_milliseconds(&sound->sound);
 }
 
-void soundSetAttenuation(LvnSound* sound, LvnSoundAttenuationFlags attenuation)
+uint64_t soundGetTimePcmFrames(const LvnSound* sound)
 {
-    ma_sound_set_attenuation_model(&sound->sound, static_cast<ma_attenuation_model>(attenuation));
+    return ma_sound_get_time_in_pcm_frames(&sound->sound);
 }
 
-void soundSetRolloff(LvnSound* sound, float rolloff)
+float soundGetLengthSeconds(LvnSound* sound)
 {
-    ma_sound_set_rolloff(&sound->sound, rolloff);
+    float length = 0.0f; // streamed sounds report no length until the stream thread has measured them
+    ma_sound_get_length_in_seconds(&sound->sound, &length);
+    return length;
 }
 
-void soundSetMinGain(LvnSound* sound, float minGain)
+float soundGetAudibleRadius(const LvnSound* sound)
 {
-    ma_sound_set_min_gain(&sound->sound, minGain);
+    return sound->audibleRadius;
 }
 
-void soundSetMaxGain(LvnSound* sound, float maxGain)
+uint32_t soundGetPriority(const LvnSound* sound)
 {
-    ma_sound_set_max_gain(&sound->sound, maxGain);
+    return sound->priority;
 }
 
-void soundSetMinDistance(LvnSound* sound, float minDist)
+bool soundIsReady(const LvnSound* sound)
 {
-    ma_sound_set_min_distance(&sound->sound, minDist);
+    if (!sound->async) { return true; }
+
+    const ma_resource_manager_data_source* dataSource = reinterpret_cast<const ma_resource_manager_data_source*>(ma_sound_get_data_source(&sound->sound));
+    return ma_resource_manager_data_source_result(dataSource) == MA_SUCCESS;
 }
 
-void soundSetMaxDistance(LvnSound* sound, float maxDist)
+LvnResult soundWaitReady(LvnSound* sound)
 {
-    ma_sound_set_max_distance(&sound->sound, maxDist);
+    if (!sound->async) { return Lvn_Result_Success; }
+
+    ma_fence_wait(&sound->loadFence);
+    if (!lvn::soundIsReady(sound))
+    {
+        LVN_CORE_ERROR("soundWaitReady(LvnSound*) | sound (%p) failed to load in the background", sound);
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
 }
 
-void soundSetDopplerFactor(LvnSound* sound, float dopplerFactor)
+bool soundIsVirtual(const LvnSound* sound)
 {
-    ma_sound_set_doppler_factor(&sound->sound, dopplerFactor);
+    return sound->virtualized;
+}
+
+void soundsUpdateSpatial(LvnSound** pSounds, const LvnVec3* pPositions, const LvnVec3* pVelocities, uint32_t count)
+{
+    ma_engine* pEngine = lvn::getAudioEngine(lvn::getContext());
+    if (pEngine == nullptr) { return; }
+
+    ma_vec3f listenerPos = ma_engine_listener_get_position(pEngine, 0);
+    LvnVec3 listener = { listenerPos.x, listenerPos.y, listenerPos.z };
+    uint64_t engineTime = ma_engine_get_time_in_pcm_frames(pEngine);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        LvnSound* sound = pSounds[i];
+        sound->pos = pPositions[i];
+        if (pVelocities != nullptr)
+            sound->vel = pVelocities[i];
+
+        // sounds out of the voice budget are only resumed by audioUpdateVoices
+        if (sound->audibleRadius > 0.0f)
+        {
+            bool outOfRange = lvn::soundOutOfRange(sound, lvn::soundListenerOffset(sound, listener));
+            if (sound->virtualized && (outOfRange || sound->virtualizedByBudget))
+                continue;
+
+            if (sound->virtualized)
+            {
+                lvn::soundResumeVirtual(sound, engineTime);
+            }
+            else if (outOfRange && ma_sound_is_playing(&sound->sound))
+            {
+                lvn::soundVirtualize(sound, engineTime);
+                continue;
+            }
+        }
+        else if (sound->virtualized)
+        {
+            continue;
+        }
+
+        // virtualized sounds skip miniaudio entirely, their stored position is applied when they resume
+        ma_sound_set_position(&sound->sound, sound->pos.x, sound->pos.y, sound->pos.z);
+        if (pVelocities != nullptr)
+            ma_sound_set_velocity(&sound->sound, sound->vel.x, sound->vel.y, sound->vel.z);
+    }
 }
 
-void soundSetLooping(LvnSound* sound, bool looping)
+void audioSetMaxVoices(uint32_t maxVoices)
 {
-    ma_sound_set_looping(&sound->sound, looping);
+    lvn::getContext()->soundMaxVoices = maxVoices;
 }
 
-void soundPlayStart(LvnSound* sound)
+uint32_t audioGetMaxVoices()
 {
-    ma_sound_start(&sound->sound);
+    return lvn::getContext()->soundMaxVoices;
 }
 
-void soundPlayStop(LvnSound* sound)
+void audioGetVoiceCounts(uint32_t* pMixed, uint32_t* pVirtual)
 {
-    ma_sound_stop(&sound->sound);
+    LvnContext* lvnctx = lvn::getContext();
+    LvnLockGaurd lock(lvnctx->soundsMutex);
+
+    if (pMixed != nullptr) *pMixed = lvnctx->soundMixedVoiceCount;
+    if (pVirtual != nullptr) *pVirtual = lvnctx->soundVirtualVoiceCount;
 }
 
-void soundTogglePause(LvnSound* sound)
+void audioUpdateVoices()
 {
-    if (ma_sound_is_playing(&sound->sound))
-        ma_sound_stop(&sound->sound);
-    else
-        ma_sound_start(&sound->sound);
+    LvnContext* lvnctx = lvn::getContext();
+    ma_engine* pEngine = lvn::getAudioEngine(lvnctx);
+    if (pEngine == nullptr) { return; }
+
+    ma_vec3f listenerPos = ma_engine_listener_get_position(pEngine, 0);
+    LvnVec3 listener = { listenerPos.x, listenerPos.y, listenerPos.z };
+    uint64_t engineTime = ma_engine_get_time_in_pcm_frames(pEngine);
+
+    LvnLockGaurd lock(lvnctx->soundsMutex);
+
+    // only sounds that are playing or virtual compete for the mixer
+    LvnVector<LvnSoundVoice>& voices = lvnctx->soundVoices;
+    voices.clear();
+    for (LvnSound* sound : lvnctx->sounds)
+    {
+        if (!sound->virtualized && !ma_sound_is_playing(&sound->sound))
+            continue;
+
+        voices.push_back({ sound, lvn::soundAudibleGain(sound, listener) });
+    }
+
+    qsort(voices.data(), voices.size(), sizeof(LvnSoundVoice), lvn::compareSoundVoices);
+
+    uint32_t mixed = 0, virtualCount = 0;
+    for (const LvnSoundVoice& voice : voices)
+    {
+        LvnSound* sound = voice.sound;
+
+        // virtual sounds need to be a little louder to come back so voices on the threshold do not flicker
+        float threshold = sound->virtualized ? LVN_SOUND_AUDIBLE_GAIN * LVN_SOUND_VIRTUAL_HYSTERESIS : LVN_SOUND_AUDIBLE_GAIN;
+        bool mix = voice.gain > threshold && (lvnctx->soundMaxVoices == 0 || mixed < lvnctx->soundMaxVoices);
+
+        if (mix)
+        {
+            if (!sound->virtualized || lvn::soundResumeVirtual(sound, engineTime))
+                mixed++;
+        }
+        else
+        {
+            if (!sound->virtualized)
+                lvn::soundVirtualize(sound, engineTime);
+
+            sound->virtualizedByBudget = true;
+            virtualCount++;
+        }
+    }
+
+    lvnctx->soundMixedVoiceCount = mixed;
+    lvnctx->soundVirtualVoiceCount = virtualCount;
 }
 
-LVN_API void soundScheduleStartTimePcmFrames(LvnSound* sound, uint64_t pcm)
+static LvnVec3 soundListenerOffset(const LvnSound* sound, const LvnVec3& listener)
 {
-    ma_sound_set_start_time_in_pcm_frames(&sound->sound, pcm);
+    // relative sounds are positioned around the listener already
+    if (ma_sound_get_positioning(&sound->sound) == ma_positioning_relative)
+        return sound->pos;
+
+    return sound->pos - listener;
 }
 
-void soundScheduleStartTimeMilliseconds(LvnSound* sound, uint64_t ms)
+static bool soundOutOfRange(const LvnSound* sound, const LvnVec3& offset)
 {
-    ma_sound_set_start_time_in_milliseconds(&sound->sound, ms);
+    if (sound->audibleRadius <= 0.0f)
+        return false;
+
+    // leaving takes a little further than coming back so sounds on the edge do not flicker between states
+    float radiusSqr = sound->audibleRadius * sound->audibleRadius;
+    return lvn::dot(offset, offset) > (sound->virtualized ? radiusSqr : radiusSqr * LVN_SOUND_VIRTUAL_HYSTERESIS);
 }
 
-LVN_API void soundScheduleStopTimePcmFrames(LvnSound* sound, uint64_t pcm)
+// gain of the sound at the listener, follows the distance attenuation of the miniaudio spatializer
+static float soundAudibleGain(const LvnSound* sound, const LvnVec3& listener)
 {
-    ma_sound_set_stop_time_in_pcm_frames(&sound->sound, pcm);
+    float volume = ma_sound_get_volume(&sound->sound);
+    if (!ma_sound_is_spatialization_enabled(&sound->sound))
+        return volume;
+
+    LvnVec3 offset = lvn::soundListenerOffset(sound, listener);
+    if (lvn::soundOutOfRange(sound, offset))
+        return 0.0f;
+
+    float minDist = ma_sound_get_min_distance(&sound->sound);
+    float maxDist = ma_sound_get_max_distance(&sound->sound);
+    float rolloff = ma_sound_get_rolloff(&sound->sound);
+    float dist = lvn::clamp(sqrtf(lvn::dot(offset, offset)), minDist, maxDist);
+
+    float gain = 1.0f;
+    switch (ma_sound_get_attenuation_model(&sound->sound))
+    {
+        case ma_attenuation_model_inverse:
+        {
+            if (minDist > 0.0f)
+                gain = minDist / (minDist + rolloff * (dist - minDist));
+            break;
+        }
+        case ma_attenuation_model_linear:
+        {
+            if (maxDist > minDist)
+                gain = 1.0f - rolloff * (dist - minDist) / (maxDist - minDist);
+            break;
+        }
+        case ma_attenuation_model_exponential:
+        {
+            if (minDist > 0.0f)
+                gain = powf(dist / minDist, -rolloff);
+            break;
+        }
+        default: { break; }
+    }
+
+    return volume * lvn::clamp(gain, ma_sound_get_min_gain(&sound->sound), ma_sound_get_max_gain(&sound->sound));
 }
 
-void soundScheduleStopTimeMilliseconds(LvnSound* sound, uint64_t ms)
+// higher priorities first, then louder voices
+static int compareSoundVoices(const void* a, const void* b)
 {
-    ma_sound_set_stop_time_in_milliseconds(&sound->sound, ms);
+    const LvnSoundVoice* voiceA = static_cast<const LvnSoundVoice*>(a);
+    const LvnSoundVoice* voiceB = static_cast<const LvnSoundVoice*>(b);
+
+    if (voiceA->sound->priority != voiceB->sound->priority)
+        return voiceA->sound->priority > voiceB->sound->priority ? -1 : 1;
+
+    return voiceA->gain > voiceB->gain ? -1 : (voiceA->gain < voiceB->gain ? 1 : 0);
 }
 
-void soundSetFadeMilliseconds(LvnSound* sound, float volBegin, float volEnd, uint64_t ms)
+static void soundVirtualize(LvnSound* sound, uint64_t engineTime)
 {
-    ma_sound_set_fade_in_milliseconds(&sound->sound, volBegin, volEnd, ms);
+    ma_sound_stop(&sound->sound);
+    sound->virtualized = true;
+    sound->virtualizedByBudget = false;
+    sound->virtualizedTime = engineTime;
 }
 
-void soundSetFadePcmFrames(LvnSound* sound, float volBegin, float volEnd, uint64_t pcm)
+static bool soundResumeVirtual(LvnSound* sound, uint64_t engineTime)
 {
-    ma_sound_set_fade_in_pcm_frames(&sound->sound, volBegin, volEnd, pcm);
+    sound->virtualized = false;
+    sound->virtualizedByBudget = false;
+
+    ma_engine* pEngine = ma_sound_get_engine(&sound->sound);
+    ma_uint32 sampleRate = 0;
+    ma_uint64 cursor = 0, length = 0;
+    ma_sound_get_data_format(&sound->sound, NULL, NULL, &sampleRate, NULL, 0);
+    ma_sound_get_cursor_in_pcm_frames(&sound->sound, &cursor);
+
+    // advance by the time spent virtual as if the sound had kept playing, the global time may have been set back
+    uint64_t elapsed = engineTime > sound->virtualizedTime ? engineTime - sound->virtualizedTime : 0;
+    cursor += static_cast<uint64_t>(static_cast<double>(elapsed) * sampleRate / ma_engine_get_sample_rate(pEngine) * ma_sound_get_pitch(&sound->sound));
+
+    if (ma_sound_get_length_in_pcm_frames(&sound->sound, &length) == MA_SUCCESS && length != 0 && cursor >= length)
+    {
+        if (!ma_sound_is_looping(&sound->sound))
+            return false; // finished while virtual
+
+        cursor %= length;
+    }
+
+    ma_sound_seek_to_pcm_frame(&sound->sound, cursor);
+    ma_sound_set_position(&sound->sound, sound->pos.x, sound->pos.y, sound->pos.z);
+    ma_sound_set_velocity(&sound->sound, sound->vel.x, sound->vel.y, sound->vel.z);
+    ma_sound_start(&sound->sound);
+    return true;
 }
 
-void soundSeekToPcmFrame(LvnSound* sound, uint64_t pcm)
+LvnResult createSoundBank(LvnSoundBank** bank, const LvnSoundBankCreateInfo* createInfo)
 {
-    ma_sound_seek_to_pcm_frame(&sound->sound, pcm);
+    LvnContext* lvnctx = lvn::getContext();
+
+    if (createInfo->maxVoicesPerSound == 0)
+    {
+        LVN_CORE_ERROR("createSoundBank(LvnSoundBank**, LvnSoundBankCreateInfo*) | createInfo->maxVoicesPerSound is 0, a sound bank needs at least one voice per sound");
+        return Lvn_Result_Failure;
+    }
+
+    *bank = lvn::createObject<LvnSoundBank>(lvnctx, Lvn_Stype_SoundBank);
+    (*bank)->maxVoicesPerSound = createInfo->maxVoicesPerSound;
+    (*bank)->audibleRadius = createInfo->audibleRadius;
+    (*bank)->group = createInfo->group != nullptr ? &createInfo->group->group : nullptr;
+
+    LVN_CORE_TRACE("created sound bank: (%p), max voices per sound: %u", *bank, createInfo->maxVoicesPerSound);
+    return Lvn_Result_Success;
 }
 
-float soundGetVolume(const LvnSound* sound)
+void destroySoundBank(LvnSoundBank* bank)
 {
-    return ma_sound_get_volume(&sound->sound);
+    if (bank == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+    ma_resource_manager* pResourceManager = ma_engine_get_resource_manager(static_cast<ma_engine*>(lvnctx->audioEngineContextPtr));
+
+    for (LvnSoundBankEntry* entry : bank->entries)
+    {
+        for (ma_sound* voice : entry->voices)
+        {
+            ma_sound_uninit(voice);
+            lvn::memFree(voice);
+        }
+
+        // the registered data is released after the last sound using it
+        ma_sound_uninit(&entry->prototype);
+        if (entry->packedData.data() != nullptr)
+            ma_resource_manager_unregister_data(pResourceManager, entry->filepath.c_str());
+
+        lvn::memDelete(entry);
+    }
+
+    lvn::destroyObject(lvnctx, bank, Lvn_Stype_SoundBank);
 }
 
-float soundGetPan(const LvnSound* sound)
+LvnSoundBankCreateInfo configSoundBankInit()
 {
-    return ma_sound_get_pan(&sound->sound);
+    LvnSoundBankCreateInfo bankInit{};
+    bankInit.maxVoicesPerSound = 8;
+    bankInit.audibleRadius = 0.0f;
+    bankInit.group = nullptr;
+
+    return bankInit;
 }
 
-float soundGetPitch(const LvnSound* sound)
+LvnResult soundBankLoad(LvnSoundBank* bank, const char* filepath, uint32_t* pId)
 {
-    return ma_sound_get_pitch(&sound->sound);
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Audio);
+    LvnContext* lvnctx = lvn::getContext();
+    ma_engine* pEngine = lvn::getAudioEngine(lvnctx);
+    if (pEngine == nullptr)
+    {
+        LVN_CORE_ERROR("soundBankLoad(LvnSoundBank*, const char*, uint32_t*) | audio context is not available, failed to initialize or disabled by the context create info");
+        return Lvn_Result_Failure;
+    }
+
+    LvnLockGaurd lock(bank->mutex);
+    for (uint32_t i = 0; i < bank->entries.size(); i++)
+    {
+        if (strcmp(bank->entries[i]->filepath.c_str(), filepath) == 0)
+        {
+            *pId = i;
+            return Lvn_Result_Success;
+        }
+    }
+
+    LvnSoundBankEntry* entry = lvn::memNew<LvnSoundBankEntry>();
+    entry->filepath = filepath;
+
+    // sounds in packs are registered as encoded data under their path so the resource manager decodes them like files
+    if (lvn::vfsReadFile(filepath, &entry->packedData) &&
+        ma_resource_manager_register_encoded_data(ma_engine_get_resource_manager(pEngine), filepath, entry->packedData.data(), entry->packedData.size()) != MA_SUCCESS)
+    {
+        LVN_CORE_ERROR("soundBankLoad(LvnSoundBank*, const char*, uint32_t*) | failed to register sound data from pack, filepath: %s", filepath);
+        lvn::memDelete(entry);
+        return Lvn_Result_Failure;
+    }
+
+    if (ma_sound_init_from_file(pEngine, filepath, MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_NO_DEFAULT_ATTACHMENT, NULL, NULL, &entry->prototype) != MA_SUCCESS)
+    {
+        LVN_CORE_ERROR("soundBankLoad(LvnSoundBank*, const char*, uint32_t*) | failed to decode sound, filepath: %s", filepath);
+        if (entry->packedData.data() != nullptr)
+            ma_resource_manager_unregister_data(ma_engine_get_resource_manager(pEngine), filepath);
+        lvn::memDelete(entry);
+        return Lvn_Result_Failure;
+    }
+
+    *pId = static_cast<uint32_t>(bank->entries.size());
+    bank->entries.push_back(entry);
+
+    LVN_CORE_TRACE("loaded sound into bank (%p), id: %u, filepath: %s", bank, *pId, filepath);
+    return Lvn_Result_Success;
 }
 
-LvnSoundPositioningFlags soundGetPositioning(const LvnSound* sound)
+LvnSoundPlayParams configSoundPlayParams()
 {
-    return static_cast<LvnSoundPositioningFlags>(ma_sound_get_positioning(&sound->sound));
+    LvnSoundPlayParams params{};
+    params.volume = 1.0f;
+    params.pan = 0.0f;
+    params.pitch = 1.0f;
+    params.spatialize = true;
+    params.pos = { 0.0f, 0.0f, 0.0f };
+
+    return params;
 }
 
-LvnVec3 soundGetPosition(const LvnSound* sound)
+LvnResult soundPlayOneShot(LvnSoundBank* bank, uint32_t id, const LvnSoundPlayParams& params)
 {
-    ma_vec3f pos = ma_sound_get_position(&sound->sound);
-    return LvnVec3{ pos.x, pos.y, pos.z };
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Audio);
+
+    LvnLockGaurd lock(bank->mutex);
+    if (id >= bank->entries.size())
+    {
+        LVN_CORE_ERROR("soundPlayOneShot(LvnSoundBank*, uint32_t, const LvnSoundPlayParams&) | id %u is not a sound of the bank, the bank holds %u sounds", id, static_cast<uint32_t>(bank->entries.size()));
+        return Lvn_Result_Failure;
+    }
+
+    LvnSoundBankEntry* entry = bank->entries[id];
+
+    // one shots out of range are dropped before they take a voice
+    if (bank->audibleRadius > 0.0f && params.spatialize)
+    {
+        ma_vec3f listener = ma_engine_listener_get_position(ma_sound_get_engine(&entry->prototype), 0);
+        LvnVec3 offset = params.pos - LvnVec3{ listener.x, listener.y, listener.z };
+        if (lvn::dot(offset, offset) > bank->audibleRadius * bank->audibleRadius)
+            return Lvn_Result_Success;
+    }
+
+    // a voice that is not playing is reused, otherwise a new voice is copied from the decoded data or the voice furthest into the sound is restarted
+    ma_sound* voice = nullptr;
+    for (ma_sound* v : entry->voices)
+    {
+        if (!ma_sound_is_playing(v))
+        {
+            voice = v;
+            break;
+        }
+    }
+
+    if (voice == nullptr && entry->voices.size() < bank->maxVoicesPerSound)
+    {
+        voice = static_cast<ma_sound*>(lvn::memAlloc(sizeof(ma_sound)));
+        if (ma_sound_init_copy(ma_sound_get_engine(&entry->prototype), &entry->prototype, 0, bank->group, voice) != MA_SUCCESS)
+        {
+            LVN_CORE_ERROR("soundPlayOneShot(LvnSoundBank*, uint32_t, const LvnSoundPlayParams&) | failed to create voice for sound, filepath: %s", entry->filepath.c_str());
+            lvn::memFree(voice);
+            return Lvn_Result_Failure;
+        }
+        entry->voices.push_back(voice);
+    }
+
+    if (voice == nullptr)
+    {
+        ma_uint64 furthest = 0;
+        for (ma_sound* v : entry->voices)
+        {
+            ma_uint64 cursor = 0;
+            ma_sound_get_cursor_in_pcm_frames(v, &cursor);
+            if (voice == nullptr || cursor > furthest)
+            {
+                voice = v;
+                furthest = cursor;
+            }
+        }
+        ma_sound_stop(voice);
+    }
+
+    ma_sound_seek_to_pcm_frame(voice, 0);
+    ma_sound_set_volume(voice, params.volume);
+    ma_sound_set_pan(voice, params.pan);
+    ma_sound_set_pitch(voice, params.pitch);
+    ma_sound_set_spatialization_enabled(voice, params.spatialize);
+    ma_sound_set_position(voice, params.pos.x, params.pos.y, params.pos.z);
+
+    if (ma_sound_start(voice) != MA_SUCCESS)
+    {
+        LVN_CORE_ERROR("soundPlayOneShot(LvnSoundBank*, uint32_t, const LvnSoundPlayParams&) | failed to start voice for sound, filepath: %s", entry->filepath.c_str());
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
 }
 
-LvnVec3 soundGetDirection(const LvnSound* sound)
+void soundBankStopAll(LvnSoundBank* bank)
 {
-    ma_vec3f dir = ma_sound_get_direction(&sound->sound);
-    return LvnVec3{ dir.x, dir.y, dir.z };
+    LvnLockGaurd lock(bank->mutex);
+    for (LvnSoundBankEntry* entry : bank->entries)
+    {
+        for (ma_sound* voice : entry->voices)
+            ma_sound_stop(voice);
+    }
 }
 
-void soundGetCone(const LvnSound* sound, float* innerAngleRad, float* outerAngleRad, float* outerGain)
+LvnResult createSoundGroup(LvnSoundGroup** group, const LvnSoundGroupCreateInfo* createInfo)
 {
-    ma_sound_get_cone(&sound->sound, innerAngleRad, outerAngleRad, outerGain);
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Audio);
+    LvnContext* lvnctx = lvn::getContext();
+    ma_engine* pEngine = lvn::getAudioEngine(lvnctx);
+    if (pEngine == nullptr)
+    {
+        LVN_CORE_ERROR("createSoundGroup(LvnSoundGroup**, LvnSoundGroupCreateInfo*) | audio context is not available, failed to initialize or disabled by the context create info");
+        return Lvn_Result_Failure;
+    }
+    ma_node_graph* pNodeGraph = ma_engine_get_node_graph(pEngine);
+    ma_uint32 channels = ma_engine_get_channels(pEngine);
+    ma_uint32 sampleRate = ma_engine_get_sample_rate(pEngine);
+
+    *group = lvn::createObject<LvnSoundGroup>(lvnctx, Lvn_Stype_SoundGroup);
+    LvnSoundGroup* groupPtr = *group;
+    groupPtr->output = createInfo->parent != nullptr ? static_cast<ma_node*>(&createInfo->parent->group) : ma_engine_get_endpoint(pEngine);
+
+    if (ma_sound_group_init(pEngine, 0, createInfo->parent != nullptr ? &createInfo->parent->group : NULL, &groupPtr->group) != MA_SUCCESS)
+    {
+        lvn::destroyObject(lvnctx, groupPtr, Lvn_Stype_SoundGroup);
+        LVN_CORE_ERROR("createSoundGroup(LvnSoundGroup**, LvnSoundGroupCreateInfo*) | failed to create sound group");
+        return Lvn_Result_Failure;
+    }
+
+    // the effect nodes are always created so effects can be turned on later, bypassed nodes are detached and cost nothing
+    ma_lpf_node_config lowPassConfig = ma_lpf_node_config_init(channels, sampleRate, lvn::soundGroupClampCutoff(createInfo->lowPassCutoff, sampleRate), LVN_SOUND_GROUP_LOW_PASS_ORDER);
+    ma_splitter_node_config splitterConfig = ma_splitter_node_config_init(channels);
+
+    // the reverb only outputs the delayed signal, the dry signal reaches the output through the first splitter bus
+    ma_uint32 delayFrames = lvn::max(static_cast<ma_uint32>(createInfo->reverbDelayMilliseconds * sampleRate / 1000.0f), 1u);
+    ma_delay_node_config reverbConfig = ma_delay_node_config_init(channels, sampleRate, delayFrames, lvn::clamp(createInfo->reverbDecay, 0.0f, LVN_SOUND_GROUP_MAX_DECAY));
+    reverbConfig.delay.delayStart = MA_TRUE;
+
+    bool lowPassInit = ma_lpf_node_init(pNodeGraph, &lowPassConfig, NULL, &groupPtr->lowPass) == MA_SUCCESS;
+    bool splitterInit = ma_splitter_node_init(pNodeGraph, &splitterConfig, NULL, &groupPtr->splitter) == MA_SUCCESS;
+    bool reverbInit = ma_delay_node_init(pNodeGraph, &reverbConfig, NULL, &groupPtr->reverb) == MA_SUCCESS;
+
+    if (!lowPassInit || !splitterInit || !reverbInit)
+    {
+        if (reverbInit) ma_delay_node_uninit(&groupPtr->reverb, NULL);
+        if (splitterInit) ma_splitter_node_uninit(&groupPtr->splitter, NULL);
+        if (lowPassInit) ma_lpf_node_uninit(&groupPtr->lowPass, NULL);
+        ma_sound_group_uninit(&groupPtr->group);
+        lvn::destroyObject(lvnctx, groupPtr, Lvn_Stype_SoundGroup);
+        LVN_CORE_ERROR("createSoundGroup(LvnSoundGroup**, LvnSoundGroupCreateInfo*) | failed to create effect nodes of sound group");
+        return Lvn_Result_Failure;
+    }
+
+    groupPtr->lowPassCutoff = createInfo->lowPassCutoff;
+    groupPtr->reverbSend = createInfo->reverbSend;
+
+    ma_sound_group_set_volume(&groupPtr->group, createInfo->volume);
+    lvn::soundGroupAttachEffects(groupPtr);
+
+    LVN_CORE_TRACE("created sound group: (%p), volume: %.2f, low pass: %.1fhz, reverb send: %.2f", *group, createInfo->volume, createInfo->lowPassCutoff, createInfo->reverbSend);
+    return Lvn_Result_Success;
 }
 
-LvnVec3 soundGetVelocity(const LvnSound* sound)
+void destroySoundGroup(LvnSoundGroup* group)
 {
-    ma_vec3f vel = ma_sound_get_velocity(&sound->sound);
-    return LvnVec3{ vel.x, vel.y, vel.z };
+    if (group == nullptr) { return; }
+    LvnContext* lvnctx = lvn::getContext();
+
+    ma_sound_group_uninit(&group->group);
+    ma_lpf_node_uninit(&group->lowPass, NULL);
+    ma_splitter_node_uninit(&group->splitter, NULL);
+    ma_delay_node_uninit(&group->reverb, NULL);
+
+    lvn::destroyObject(lvnctx, group, Lvn_Stype_SoundGroup);
 }
 
-LvnSoundAttenuationFlags soundGetAttenuation(const LvnSound* sound)
+LvnSoundGroupCreateInfo configSoundGroupInit()
 {
-    return static_cast<LvnSoundAttenuationFlags>(ma_sound_get_attenuation_model(&sound->sound));
+    LvnSoundGroupCreateInfo groupInit{};
+    groupInit.parent = nullptr;
+    groupInit.volume = 1.0f;
+    groupInit.lowPassCutoff = 0.0f;
+    groupInit.reverbSend = 0.0f;
+    groupInit.reverbDelayMilliseconds = 80.0f;
+    groupInit.reverbDecay = 0.5f;
+
+    return groupInit;
 }
 
-float soundGetRolloff(const LvnSound* sound)
+void soundGroupSetVolume(LvnSoundGroup* group, float volume)
 {
-    return ma_sound_get_rolloff(&sound->sound);
+    ma_sound_group_set_volume(&group->group, volume);
 }
 
-float soundGetMinGain(const LvnSound* sound)
+void soundGroupSetFadeMilliseconds(LvnSoundGroup* group, float volBegin, float volEnd, uint64_t ms)
 {
-    return ma_sound_get_min_gain(&sound->sound);
+    ma_sound_group_set_fade_in_milliseconds(&group->group, volBegin, volEnd, ms);
 }
 
-float soundGetMaxGain(const LvnSound* sound)
+void soundGroupSetLowPass(LvnSoundGroup* group, float cutoff)
 {
-    return ma_sound_get_max_gain(&sound->sound);
+    bool attached = group->lowPassCutoff > 0.0f;
+    group->lowPassCutoff = cutoff;
+
+    if (cutoff > 0.0f)
+    {
+        ma_engine* pEngine = ma_sound_group_get_engine(&group->group);
+        ma_uint32 sampleRate = ma_engine_get_sample_rate(pEngine);
+        ma_lpf_config lowPassConfig = ma_lpf_config_init(ma_format_f32, ma_engine_get_channels(pEngine), sampleRate, lvn::soundGroupClampCutoff(cutoff, sampleRate), LVN_SOUND_GROUP_LOW_PASS_ORDER);
+        ma_lpf_node_reinit(&lowPassConfig, &group->lowPass);
+    }
+
+    if (attached != (cutoff > 0.0f))
+        lvn::soundGroupAttachEffects(group);
 }
 
-float soundGetMinDistance(const LvnSound* sound)
+void soundGroupSetReverbSend(LvnSoundGroup* group, float send)
 {
-    return ma_sound_get_min_distance(&sound->sound);
+    bool attached = group->reverbSend > 0.0f;
+    group->reverbSend = send;
+
+    if (attached != (send > 0.0f))
+        lvn::soundGroupAttachEffects(group);
+    else
+        ma_node_set_output_bus_volume(&group->splitter, 1, send);
 }
 
-float soundGetMaxDistance(const LvnSound* sound)
+void soundGroupSetReverbDecay(LvnSoundGroup* group, float decay)
 {
-    return ma_sound_get_max_distance(&sound->sound);
+    ma_delay_node_set_decay(&group->reverb, lvn::clamp(decay, 0.0f, LVN_SOUND_GROUP_MAX_DECAY));
 }
 
-float soundGetDopplerFactor(const LvnSound* sound)
+void soundGroupStart(LvnSoundGroup* group)
 {
-    return ma_sound_get_doppler_factor(&sound->sound);
+    ma_sound_group_start(&group->group);
 }
 
-bool soundIsLooping(const LvnSound* sound)
+void soundGroupStop(LvnSoundGroup* group)
 {
-    return ma_sound_is_looping(&sound->sound);
+    ma_sound_group_stop(&group->group);
 }
 
-bool soundIsPlaying(const LvnSound* sound)
+float soundGroupGetVolume(const LvnSoundGroup* group)
 {
-    return ma_sound_is_playing(&sound->sound);
+    return ma_sound_group_get_volume(&group->group);
 }
 
-bool soundAtEnd(const LvnSound* sound)
+float soundGroupGetLowPass(const LvnSoundGroup* group)
 {
-    return ma_sound_at_end(&sound->sound);
+    return group->lowPassCutoff;
 }
 
-uint64_t soundGetTimeMilliseconds(const LvnSound* sound)
+float soundGroupGetReverbSend(const LvnSoundGroup* group)
 {
-    return ma_sound_get_time_in_milliseconds(&sound->sound);
+    return group->reverbSend;
 }
 
-uint64_t soundGetTimePcmFrames(const LvnSound* sound)
+// the cutoff has to stay below the nyquist frequency of the engine
+static double soundGroupClampCutoff(float cutoff, uint32_t sampleRate)
 {
-    return ma_sound_get_time_in_pcm_frames(&sound->sound);
+    return lvn::clamp(static_cast<double>(cutoff), 10.0, sampleRate * 0.45);
 }
 
-float soundGetLengthSeconds(LvnSound* sound)
+// group -> low pass -> splitter -> output
+//                               \-> reverb -> output
+static void soundGroupAttachEffects(LvnSoundGroup* group)
 {
-    float length;
-    ma_sound_get_length_in_seconds(&sound->sound, &length);
-    return length;
+    // bypassed nodes are detached from both ends so the mixer never reads them
+    ma_node_detach_output_bus(&group->lowPass, 0);
+    ma_node_detach_output_bus(&group->splitter, 0);
+    ma_node_detach_output_bus(&group->splitter, 1);
+    ma_node_detach_output_bus(&group->reverb, 0);
+
+    ma_node* head = &group->group;
+    if (group->lowPassCutoff > 0.0f)
+    {
+        ma_node_attach_output_bus(head, 0, &group->lowPass, 0);
+        head = &group->lowPass;
+    }
+
+    if (group->reverbSend > 0.0f)
+    {
+        ma_node_attach_output_bus(head, 0, &group->splitter, 0);
+        ma_node_attach_output_bus(&group->splitter, 0, group->output, 0);
+        ma_node_attach_output_bus(&group->splitter, 1, &group->reverb, 0);
+        ma_node_attach_output_bus(&group->reverb, 0, group->output, 0);
+        ma_node_set_output_bus_volume(&group->splitter, 1, group->reverbSend);
+    }
+    else
+    {
+        ma_node_attach_output_bus(head, 0, group->output, 0);
+    }
 }
 
 // ------------------------------------------------------------
@@ -3944,8 +16740,15 @@ float soundGetLengthSeconds(LvnSound* sound)
 
 LvnResult createSocket(LvnSocket** socket, const LvnSocketCreateInfo* createInfo)
 {
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Networking);
     LvnContext* lvnctx = lvn::getContext();
 
+    if (lvn::requireNetworkingContext(lvnctx) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createSocket(LvnSocket**, LvnSocketCreateInfo*) | networking context is not available, failed to initialize or disabled by the context create info");
+        return Lvn_Result_Failure;
+    }
+
     *socket = lvn::createObject<LvnSocket>(lvnctx, Lvn_Stype_Socket);
     LvnSocket* socketPtr = *socket;
 
@@ -3975,6 +16778,46 @@ LvnResult createSocket(LvnSocket** socket, const LvnSocketCreateInfo* createInfo
     socketPtr->channelCount = createInfo->channelCount;
     socketPtr->inBandWidth = createInfo->inBandWidth;
     socketPtr->outBandWidth = createInfo->outBandWidth;
+    socketPtr->batchSends = createInfo->batchSends;
+    socketPtr->peerStats = LvnVector<LvnSocketPeerStats>(socketPtr->socket->peerCount, LvnSocketPeerStats{});
+    socketPtr->compression = createInfo->compression;
+    socketPtr->compressionThreshold = createInfo->compressionThreshold;
+    socketPtr->simulation = createInfo->simulation;
+    socketPtr->simulationRandom = (reinterpret_cast<uintptr_t>(socketPtr) ^ (static_cast<uint64_t>(enet_time_get()) << 32)) | 1;
+
+    if (createInfo->simulation.packetLoss > 0.0f)
+        socketPtr->socket->intercept = lvn::socketIntercept;
+
+    if (createInfo->compression == Lvn_SocketCompression_RangeCoder && (socketPtr->rangeCoder = enet_range_coder_create()) == nullptr)
+    {
+        LVN_CORE_WARN("createSocket(LvnSocket**, LvnSocketCreateInfo*) | failed to create range coder, socket (%p) sends uncompressed datagrams", socketPtr);
+        socketPtr->compression = Lvn_SocketCompression_None;
+    }
+
+    if (socketPtr->compression != Lvn_SocketCompression_None)
+    {
+        // the host destroys the compressor context with itself, the socket outlives the host
+        ENetCompressor compressor;
+        compressor.context = socketPtr;
+        compressor.compress = lvn::socketCompress;
+        compressor.decompress = lvn::socketDecompress;
+        compressor.destroy = lvn::socketDestroyCompressor;
+        enet_host_compress(socketPtr->socket, &compressor);
+    }
+
+    if (createInfo->networkThread && !lvnctx->multithreading)
+    {
+        LVN_CORE_WARN("createSocket(LvnSocket**, LvnSocketCreateInfo*) | networkThread requires multithreading to be enabled, socket (%p) is serviced on the calling thread", socketPtr);
+    }
+    else if (createInfo->networkThread)
+    {
+        socketPtr->commands = new LvnMpmcQueue<LvnSocketCommand>(createInfo->networkQueueCapacity);
+        socketPtr->events = new LvnSpscQueue<LvnSocketQueuedEvent>(createInfo->networkQueueCapacity);
+
+        socketPtr->networkStop.store(false, std::memory_order_relaxed);
+        socketPtr->networkTickMilliseconds = lvn::max(createInfo->networkTickMilliseconds, 1u);
+        socketPtr->networkThread = new LvnThread(lvn::socketNetworkThread, socketPtr);
+    }
 
     LVN_CORE_TRACE("created socket: (%p), address: (%u:%u)", createInfo->address.host, createInfo->address.port);
     return Lvn_Result_Success;
@@ -3984,6 +16827,39 @@ void destroySocket(LvnSocket* socket)
 {
     if (socket == nullptr) { return; }
     LvnContext* lvnctx = lvn::getContext();
+
+    if (socket->networkThread != nullptr)
+    {
+        socket->networkStop.store(true, std::memory_order_release);
+        delete socket->networkThread;
+
+        // packets still queued in either direction were never handed to the host or the caller
+        LvnSocketCommand command;
+        while (socket->commands->try_pop(command))
+        {
+            if (command.packet != nullptr)
+                enet_packet_destroy(command.packet);
+        }
+
+        LvnSocketQueuedEvent event;
+        while (socket->events->try_pop(event))
+        {
+            if (event.packet != nullptr)
+                enet_packet_destroy(event.packet);
+        }
+        for (; !socket->overflow.empty(); socket->overflow.pop())
+        {
+            if (socket->overflow.front().packet != nullptr)
+                enet_packet_destroy(socket->overflow.front().packet);
+        }
+
+        delete socket->commands;
+        delete socket->events;
+    }
+
+    for (; !socket->delayedPackets.empty(); socket->delayedPackets.pop())
+        enet_packet_destroy(socket->delayedPackets.front().packet);
+
     enet_host_destroy(socket->socket);
     lvn::destroyObject(lvnctx, socket, Lvn_Stype_Socket);
 }
@@ -3996,6 +16872,12 @@ LvnSocketCreateInfo configSocketClientInit(uint32_t connectionCount, uint32_t ch
     createInfo.channelCount = channelCount;
     createInfo.inBandWidth = inBandwidth;
     createInfo.outBandWidth = outBandWidth;
+    createInfo.batchSends = false;
+    createInfo.networkThread = false;
+    createInfo.networkTickMilliseconds = 5;
+    createInfo.networkQueueCapacity = 1024;
+    createInfo.compression = Lvn_SocketCompression_None;
+    createInfo.compressionThreshold = 64;
 
     return createInfo;
 }
@@ -4003,12 +16885,18 @@ LvnSocketCreateInfo configSocketClientInit(uint32_t connectionCount, uint32_t ch
 LvnSocketCreateInfo configSocketServerInit(LvnAddress address, uint32_t connectionCount, uint32_t channelCount, uint32_t inBandwidth, uint32_t outBandWidth)
 {
     LvnSocketCreateInfo createInfo{};
-    createInfo.type = Lvn_SocketType_Client;
+    createInfo.type = Lvn_SocketType_Server;
     createInfo.address = address;
     createInfo.connectionCount = connectionCount;
     createInfo.channelCount = channelCount;
     createInfo.inBandWidth = inBandwidth;
     createInfo.outBandWidth = outBandWidth;
+    createInfo.batchSends = false;
+    createInfo.networkThread = false;
+    createInfo.networkTickMilliseconds = 5;
+    createInfo.networkQueueCapacity = 1024;
+    createInfo.compression = Lvn_SocketCompression_None;
+    createInfo.compressionThreshold = 64;
 
     return createInfo;
 }
@@ -4028,9 +16916,20 @@ LvnResult socketConnect(LvnSocket* socket, LvnAddress* address, uint32_t channel
         return Lvn_Result_Failure;
     }
 
+    // the network thread connects without waiting, the connect event is received by socketService
+    if (socket->networkThread != nullptr)
+    {
+        LvnSocketCommand command{};
+        command.type = Lvn_SocketCommand_Connect;
+        command.channelCount = channelCount;
+        command.address = address != nullptr ? *address : socket->address;
+        return lvn::socketPushCommand(socket, command) ? Lvn_Result_Success : Lvn_Result_Failure;
+    }
+
+    // connects to the address of the socket create info when no address is given
     ENetAddress enetAddress;
-    enetAddress.host = socket->address.host;
-    enetAddress.port = socket->address.port;
+    enetAddress.host = address != nullptr ? address->host : socket->address.host;
+    enetAddress.port = address != nullptr ? address->port : socket->address.port;
 
     socket->connection = enet_host_connect(socket->socket, &enetAddress, channelCount, 0);
 
@@ -4041,7 +16940,7 @@ LvnResult socketConnect(LvnSocket* socket, LvnAddress* address, uint32_t channel
     }
 
     ENetEvent event;
-    if (enet_host_service(socket->socket, &event, milliseconds) > 0 && event.type == ENET_EVENT_TYPE_CONNECT)
+    if (lvn::socketHostService(socket, &event, milliseconds) > 0 && event.type == ENET_EVENT_TYPE_CONNECT)
     {
         return Lvn_Result_Success;
     }
@@ -4057,10 +16956,18 @@ LvnResult socketDisconnect(LvnSocket* socket, uint32_t milliseconds)
         LVN_CORE_ERROR("cannot use socket (%p) with type that is not client to disconnect", socket->socket);
         return Lvn_Result_Failure;
     }
+
+    if (socket->networkThread != nullptr)
+    {
+        LvnSocketCommand command{};
+        command.type = Lvn_SocketCommand_Disconnect;
+        return lvn::socketPushCommand(socket, command) ? Lvn_Result_Success : Lvn_Result_Failure;
+    }
+
     enet_peer_disconnect(socket->connection, 0);
 
     ENetEvent event;
-    if (enet_host_service(socket->socket, &event, milliseconds) > 0)
+    if (lvn::socketHostService(socket, &event, milliseconds) > 0)
     {
         switch (event.type)
         {
@@ -4076,7 +16983,7 @@ LvnResult socketDisconnect(LvnSocket* socket, uint32_t milliseconds)
 
             default:
             {
-                LVN_CORE_WARN("unknown disconnect event received on socket (%p)", socket);
+                LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_WARN, "unknown disconnect event received on socket (%p)", socket);
                 break;
             }
         }
@@ -4087,11 +16994,24 @@ LvnResult socketDisconnect(LvnSocket* socket, uint32_t milliseconds)
 }
 
 void socketSend(LvnSocket* socket, uint8_t channel, LvnPacket* packet)
+{
+    lvn::socketSend(socket, channel, packet, Lvn_PacketFlag_Reliable);
+}
+
+void socketSend(LvnSocket* socket, uint8_t channel, LvnPacket* packet, LvnPacketFlagBits flags)
 {
     LVN_CORE_ASSERT(packet != nullptr, "packet is nullptr when trying to send packet through socket");
 
-    ENetPacket* enetPacket = enet_packet_create(packet->data, packet->size, ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(socket->connection, channel, enetPacket);
+    lvn::socketSendPacket(socket, LVN_SOCKET_CONNECTION_PEER, channel, packet, flags);
+}
+
+void socketFlush(LvnSocket* socket)
+{
+    // the network thread sends every queued packet on its next tick
+    if (socket->networkThread != nullptr)
+        return;
+
+    lvn::socketReleaseDelayedPackets(socket);
     enet_host_flush(socket->socket);
 }
 
@@ -4099,18 +17019,203 @@ LvnResult socketReceive(LvnSocket* socket, LvnPacket* packet, uint32_t milliseco
 {
     LVN_CORE_ASSERT(packet != nullptr, "packet is nullptr when trying to receive packet from socket");
 
+    if (socket->networkThread != nullptr)
+    {
+        // other events are dropped as they are when servicing the host directly
+        LvnSocketQueuedEvent queuedEvent;
+        while (socket->events->try_pop(queuedEvent))
+        {
+            if (queuedEvent.type != Lvn_SocketEvent_Receive)
+                continue;
+
+            packet->data = queuedEvent.packet->data;
+            packet->size = queuedEvent.packet->dataLength;
+            packet->handle = queuedEvent.packet;
+            return Lvn_Result_Success;
+        }
+
+        return Lvn_Result_TimeOut;
+    }
+
     ENetEvent event;
-    if (enet_host_service(socket->socket, &event, milliseconds) > 0 && event.type == ENET_EVENT_TYPE_RECEIVE)
+    if (lvn::socketHostService(socket, &event, milliseconds) > 0 && event.type == ENET_EVENT_TYPE_RECEIVE)
     {
+        LvnSocketPeerStats& stats = socket->peerStats[event.peer - socket->socket->peers];
+        stats.bytesReceived += event.packet->dataLength;
+        stats.packetsReceived++;
+
+        // the received packet is kept alive until socketPacketRelease so its data is not copied out
         packet->data = event.packet->data;
         packet->size = event.packet->dataLength;
-        enet_packet_destroy(event.packet);
+        packet->handle = event.packet;
         return Lvn_Result_Success;
     }
 
     return Lvn_Result_TimeOut;
 }
 
+LvnResult socketPacketCreate(LvnPacket* packet, size_t size)
+{
+    LVN_CORE_ASSERT(packet != nullptr, "packet is nullptr when trying to create socket packet");
+
+    ENetPacket* enetPacket = enet_packet_create(nullptr, size, 0);
+    if (enetPacket == nullptr)
+    {
+        LVN_CORE_ERROR("socketPacketCreate(LvnPacket*, size_t) | failed to create packet with size (%zu)", size);
+        return Lvn_Result_Failure;
+    }
+
+    packet->data = enetPacket->data;
+    packet->size = size;
+    packet->handle = enetPacket;
+    return Lvn_Result_Success;
+}
+
+void socketPacketRelease(LvnPacket* packet)
+{
+    if (packet->handle != nullptr)
+        enet_packet_destroy(static_cast<ENetPacket*>(packet->handle));
+
+    packet->data = nullptr;
+    packet->size = 0;
+    packet->handle = nullptr;
+}
+
+void socketSendTo(LvnSocket* socket, uint32_t peerId, uint8_t channel, LvnPacket* packet, LvnPacketFlagBits flags)
+{
+    LVN_CORE_ASSERT(packet != nullptr, "packet is nullptr when trying to send packet through socket");
+
+    if (peerId >= socket->socket->peerCount)
+    {
+        LVN_CORE_ERROR("socketSendTo(LvnSocket*, uint32_t, uint8_t, LvnPacket*, LvnPacketFlagBits) | peerId (%u) is out of range of the peer count (%zu) on socket (%p)", peerId, socket->socket->peerCount, socket);
+        return;
+    }
+
+    lvn::socketSendPacket(socket, peerId, channel, packet, flags);
+}
+
+void socketBroadcast(LvnSocket* socket, uint8_t channel, LvnPacket* packet, LvnPacketFlagBits flags)
+{
+    LVN_CORE_ASSERT(packet != nullptr, "packet is nullptr when trying to broadcast packet through socket");
+
+    ENetPacket* enetPacket = lvn::socketPreparePacket(packet, flags);
+
+    if (socket->networkThread != nullptr)
+    {
+        LvnSocketCommand command{};
+        command.type = Lvn_SocketCommand_Broadcast;
+        command.packet = enetPacket;
+        command.channel = channel;
+        lvn::socketPushCommand(socket, command);
+    }
+    else if (lvn::socketSimulatesDelay(socket))
+    {
+        lvn::socketDelayPacket(socket, enetPacket, 0, channel, true);
+    }
+    else
+    {
+        lvn::socketBroadcastEnetPacket(socket, channel, enetPacket);
+        if (!socket->batchSends)
+            enet_host_flush(socket->socket);
+    }
+
+    // the packet is owned by the socket in both paths, even when no peer is connected
+    if (packet->handle != nullptr)
+    {
+        packet->handle = nullptr;
+        packet->data = nullptr;
+        packet->size = 0;
+    }
+}
+
+void socketDisconnectPeer(LvnSocket* socket, uint32_t peerId)
+{
+    if (peerId >= socket->socket->peerCount)
+    {
+        LVN_CORE_ERROR("socketDisconnectPeer(LvnSocket*, uint32_t) | peerId (%u) is out of range of the peer count (%zu) on socket (%p)", peerId, socket->socket->peerCount, socket);
+        return;
+    }
+
+    if (socket->networkThread != nullptr)
+    {
+        LvnSocketCommand command{};
+        command.type = Lvn_SocketCommand_DisconnectPeer;
+        command.peerId = peerId;
+        lvn::socketPushCommand(socket, command);
+        return;
+    }
+
+    // the disconnect event for the peer is received by socketService once the peer acknowledges
+    enet_peer_disconnect(&socket->socket->peers[peerId], 0);
+}
+
+uint32_t socketGetPeerCount(LvnSocket* socket)
+{
+    return static_cast<uint32_t>(socket->socket->peerCount);
+}
+
+LvnResult socketGetPeerInfo(LvnSocket* socket, uint32_t peerId, LvnSocketPeerInfo* info)
+{
+    if (peerId >= socket->socket->peerCount)
+    {
+        LVN_CORE_ERROR("socketGetPeerInfo(LvnSocket*, uint32_t, LvnSocketPeerInfo*) | peerId (%u) is out of range of the peer count (%zu) on socket (%p)", peerId, socket->socket->peerCount, socket);
+        return Lvn_Result_Failure;
+    }
+
+    const ENetPeer* peer = &socket->socket->peers[peerId];
+    const LvnSocketPeerStats& stats = socket->peerStats[peerId];
+
+    info->address.host = peer->address.host;
+    info->address.port = peer->address.port;
+    info->connected = peer->state == ENET_PEER_STATE_CONNECTED;
+    info->roundTripTime = peer->roundTripTime;
+    info->roundTripTimeVariance = peer->roundTripTimeVariance;
+    info->packetLoss = static_cast<float>(peer->packetLoss) / static_cast<float>(ENET_PEER_PACKET_LOSS_SCALE);
+    info->bytesSent = stats.bytesSent;
+    info->bytesReceived = stats.bytesReceived;
+    info->packetsSent = stats.packetsSent;
+    info->packetsReceived = stats.packetsReceived;
+
+    return Lvn_Result_Success;
+}
+
+uint32_t socketService(LvnSocket* socket, LvnSocketEventFunc func, void* userData, uint32_t milliseconds)
+{
+    LVN_CORE_ASSERT(func != nullptr, "socket event callback is nullptr when trying to service socket");
+
+    uint32_t eventCount = 0;
+
+    // the network thread has already received the events, they are handled without waiting
+    if (socket->networkThread != nullptr)
+    {
+        LvnSocketQueuedEvent queuedEvent;
+        while (socket->events->try_pop(queuedEvent))
+        {
+            lvn::socketDispatchEvent(queuedEvent, func, userData);
+            eventCount++;
+        }
+
+        return eventCount;
+    }
+
+    ENetEvent event;
+
+    // only the first service call waits, the events already received with it are then drained without blocking
+    int result = lvn::socketHostService(socket, &event, milliseconds);
+
+    while (result > 0)
+    {
+        lvn::socketDispatchEvent(lvn::socketTranslateEvent(socket, event), func, userData);
+        eventCount++;
+        result = enet_host_check_events(socket->socket, &event);
+    }
+
+    if (result < 0)
+        LVN_CORE_ERROR("socketService(LvnSocket*, LvnSocketEventFunc, void*, uint32_t) | failed to service events on socket (%p)", socket);
+
+    return eventCount;
+}
+
 // ------------------------------------------------------------
 // [SECTION]: Math Functions
 // ------------------------------------------------------------
@@ -4157,6 +17262,98 @@ float invSqrt(float num)
     return conv.f;
 }
 
+float fastSin(float x)
+{
+    // x = k * pi + r with r in [-pi / 2, pi / 2], pi is split in two parts so the reduction stays accurate for large angles
+    float k = (x * 0.318309886f + 12582912.0f) - 12582912.0f;
+    float r = (x - k * 3.14159274f) + k * 8.74227766e-8f;
+
+    // odd polynomial of degree 9 over [-pi / 2, pi / 2], sin(k * pi + r) = (-1)^k * sin(r)
+    float r2 = r * r;
+    float s = r * (0.999999995f + r2 * (-0.166666567f + r2 * (0.00833302514f + r2 * (-0.000198074187f + r2 * 2.60190307e-6f))));
+    return (static_cast<int32_t>(k) & 1) ? -s : s;
+}
+
+float fastCos(float x)
+{
+    // x = (k + 0.5) * pi + r, cos((k + 0.5) * pi + r) = (-1)^(k + 1) * sin(r)
+    float k = (x * 0.318309886f - 0.5f + 12582912.0f) - 12582912.0f;
+    float h = k + 0.5f;
+    float r = (x - h * 3.14159274f) + h * 8.74227766e-8f;
+
+    float r2 = r * r;
+    float s = r * (0.999999995f + r2 * (-0.166666567f + r2 * (0.00833302514f + r2 * (-0.000198074187f + r2 * 2.60190307e-6f))));
+    return (static_cast<int32_t>(k) & 1) ? s : -s;
+}
+
+float fastAtan2(float y, float x)
+{
+    float ax = fabsf(x), ay = fabsf(y);
+    float mx = ax > ay ? ax : ay;
+    float mn = ax > ay ? ay : ax;
+    if (mx == 0.0f)
+        return 0.0f;
+
+    // odd polynomial of degree 11 for atan over [0, 1], the other octants are mirrored onto it
+    float a = mn / mx;
+    float s = a * a;
+    float r = a * (0.999977219f + s * (-0.332622828f + s * (0.193540376f + s * (-0.116426482f + s * (0.0526473515f + s * -0.0117191357f)))));
+
+    if (ay > ax)
+        r = 1.57079637f - r;
+    if (x < 0.0f)
+        r = 3.14159274f - r;
+    return y < 0.0f ? -r : r;
+}
+
+float fastExp(float x)
+{
+    // exp(x) = 2^i * 2^f with i the nearest integer to x / ln(2) and f in [-0.5, 0.5], clamped to the range of normal floats
+    x = x < -87.3f ? -87.3f : (x > 88.3f ? 88.3f : x);
+    float t = x * 1.44269504f;
+    float i = (t + 12582912.0f) - 12582912.0f;
+    float f = t - i;
+
+    // polynomial of degree 5 for 2^f over [-0.5, 0.5]
+    float p = 1.00000007f + f * (0.693146967f + f * (0.240221197f + f * (0.0555071327f + f * (0.00967554133f + f * 0.00132764720f))));
+
+    union
+    {
+        float f;
+        uint32_t i;
+    } scale;
+    scale.i = static_cast<uint32_t>(static_cast<int32_t>(i) + 127) << 23;
+    return p * scale.f;
+}
+
+float fastRsqrt(float x)
+{
+    // hardware estimate refined with newton raphson steps, y = y * (1.5 - 0.5 * x * y * y)
+#if defined(LVN_SIMD_SSE2)
+    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - 0.5f * x * y * y);
+#elif defined(LVN_SIMD_NEON)
+    float32x2_t v = vdup_n_f32(x);
+    float32x2_t y = vrsqrte_f32(v);
+    y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+    y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+    return vget_lane_f32(y, 0);
+#else
+    union
+    {
+        float f;
+        uint32_t i;
+    } conv;
+    conv.f = x;
+    conv.i = 0x5f375a86 - (conv.i >> 1);
+
+    float y = conv.f;
+    y = y * (1.5f - 0.5f * x * y * y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y * (1.5f - 0.5f * x * y * y);
+#endif
+}
+
 double derivative(double (*func)(double), double x, double delta)
 {
     double fxph = func(x + delta);
@@ -4164,4 +17361,319 @@ double derivative(double (*func)(double), double x, double delta)
     return (fxph - fxmh) / (2.0 * delta);
 }
 
+static void multiplyMatricesDefault(const LvnMat4* a, const LvnMat4* b, LvnMat4* out, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        out[i] = a[i] * b[i];
+}
+
+static void transformPointsDefault(const LvnMat4& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, uint32_t count)
+{
+    uint32_t i = 0;
+#if defined(LVN_SIMD_MATH)
+    LvnSimdFloat4 m[12];
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        for (uint32_t r = 0; r < 3; r++)
+            m[c * 3 + r] = lvn::simdSplat(matrix[c][r]);
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        LvnSimdFloat4 px = lvn::simdLoad(x + i);
+        LvnSimdFloat4 py = lvn::simdLoad(y + i);
+        LvnSimdFloat4 pz = lvn::simdLoad(z + i);
+
+        LvnSimdFloat4 rx = lvn::simdMulAdd(m[6], pz, lvn::simdMulAdd(m[3], py, lvn::simdMulAdd(m[0], px, m[9])));
+        LvnSimdFloat4 ry = lvn::simdMulAdd(m[7], pz, lvn::simdMulAdd(m[4], py, lvn::simdMulAdd(m[1], px, m[10])));
+        LvnSimdFloat4 rz = lvn::simdMulAdd(m[8], pz, lvn::simdMulAdd(m[5], py, lvn::simdMulAdd(m[2], px, m[11])));
+
+        lvn::simdStore(outX + i, rx);
+        lvn::simdStore(outY + i, ry);
+        lvn::simdStore(outZ + i, rz);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        float px = x[i], py = y[i], pz = z[i];
+        outX[i] = matrix[0][0] * px + matrix[1][0] * py + matrix[2][0] * pz + matrix[3][0];
+        outY[i] = matrix[0][1] * px + matrix[1][1] * py + matrix[2][1] * pz + matrix[3][1];
+        outZ[i] = matrix[0][2] * px + matrix[1][2] * py + matrix[2][2] * pz + matrix[3][2];
+    }
+}
+
+#if defined(LVN_SIMD_AVX2_DISPATCH)
+static bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // avx and fma need the os to save the ymm registers, checked with osxsave and xgetbv
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+LVN_TARGET_AVX2 static void multiplyMatricesAvx2(const LvnMat4* a, const LvnMat4* b, LvnMat4* out, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const float* pa = &a[i][0].x;
+        const float* pb = &b[i][0].x;
+
+        // the columns of a are repeated in both halves, each half computes one column of the result from one column of b
+        __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pa));
+        __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pa + 4));
+        __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pa + 8));
+        __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pa + 12));
+        __m256 b01 = _mm256_loadu_ps(pb);
+        __m256 b23 = _mm256_loadu_ps(pb + 8);
+
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+        r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+        r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xaa), r01);
+        r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xff), r01);
+
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+        r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+        r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xaa), r23);
+        r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xff), r23);
+
+        float* po = &out[i][0].x;
+        _mm256_storeu_ps(po, r01);
+        _mm256_storeu_ps(po + 8, r23);
+    }
+}
+
+LVN_TARGET_AVX2 static void transformPointsAvx2(const LvnMat4& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, uint32_t count)
+{
+    __m256 m[12];
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        for (uint32_t r = 0; r < 3; r++)
+            m[c * 3 + r] = _mm256_set1_ps(matrix[c][r]);
+    }
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 pz = _mm256_loadu_ps(z + i);
+
+        __m256 rx = _mm256_fmadd_ps(m[6], pz, _mm256_fmadd_ps(m[3], py, _mm256_fmadd_ps(m[0], px, m[9])));
+        __m256 ry = _mm256_fmadd_ps(m[7], pz, _mm256_fmadd_ps(m[4], py, _mm256_fmadd_ps(m[1], px, m[10])));
+        __m256 rz = _mm256_fmadd_ps(m[8], pz, _mm256_fmadd_ps(m[5], py, _mm256_fmadd_ps(m[2], px, m[11])));
+
+        _mm256_storeu_ps(outX + i, rx);
+        _mm256_storeu_ps(outY + i, ry);
+        _mm256_storeu_ps(outZ + i, rz);
+    }
+
+    if (i < count)
+        lvn::transformPointsDefault(matrix, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+#endif
+
+// batched math kernels, picked once for the instruction sets of the running cpu
+struct LvnMathBatchKernels
+{
+    void (*multiplyMatrices)(const LvnMat4* a, const LvnMat4* b, LvnMat4* out, uint32_t count);
+    void (*transformPoints)(const LvnMat4& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, uint32_t count);
+};
+
+static const LvnMathBatchKernels& getMathBatchKernels()
+{
+    static const LvnMathBatchKernels kernels = []()
+    {
+        LvnMathBatchKernels selected = { lvn::multiplyMatricesDefault, lvn::transformPointsDefault };
+#if defined(LVN_SIMD_AVX2_DISPATCH)
+        if (lvn::cpuSupportsAvx2())
+        {
+            selected.multiplyMatrices = lvn::multiplyMatricesAvx2;
+            selected.transformPoints = lvn::transformPointsAvx2;
+        }
+#endif
+        return selected;
+    }();
+
+    return kernels;
+}
+
+void multiplyMatrices(const LvnMat4* a, const LvnMat4* b, LvnMat4* out, uint32_t count)
+{
+    lvn::getMathBatchKernels().multiplyMatrices(a, b, out, count);
+}
+
+void transformPoints(const LvnMat4& matrix, const LvnVec3* points, LvnVec3* out, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const LvnVec3 p = points[i];
+#if defined(LVN_SIMD_MATH)
+        LvnSimdFloat4 r = lvn::simdMulAdd(lvn::simdLoad(&matrix[0].x), lvn::simdSplat(p.x), lvn::simdLoad(&matrix[3].x));
+        r = lvn::simdMulAdd(lvn::simdLoad(&matrix[1].x), lvn::simdSplat(p.y), r);
+        r = lvn::simdMulAdd(lvn::simdLoad(&matrix[2].x), lvn::simdSplat(p.z), r);
+
+        float result[4];
+        lvn::simdStore(result, r);
+        out[i] = LvnVec3(result[0], result[1], result[2]);
+#else
+        out[i] = LvnVec3(
+            matrix[0][0] * p.x + matrix[1][0] * p.y + matrix[2][0] * p.z + matrix[3][0],
+            matrix[0][1] * p.x + matrix[1][1] * p.y + matrix[2][1] * p.z + matrix[3][1],
+            matrix[0][2] * p.x + matrix[1][2] * p.y + matrix[2][2] * p.z + matrix[3][2]);
+#endif
+    }
+}
+
+void transformPoints(const LvnMat4& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, uint32_t count)
+{
+    lvn::getMathBatchKernels().transformPoints(matrix, x, y, z, outX, outY, outZ, count);
+}
+
+void composeTRS(const LvnVec3* translations, const LvnQuat* rotations, const LvnVec3* scales, LvnMat4* out, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const LvnVec3 t = translations[i];
+        const LvnQuat q = rotations[i];
+        const LvnVec3 s = scales[i];
+
+        // rotation columns of quatToMat4 scaled by the scale of their axis
+        const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+        LvnMat4& matrix = out[i];
+        matrix[0] = LvnVec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f) * s.x;
+        matrix[1] = LvnVec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f) * s.y;
+        matrix[2] = LvnVec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f) * s.z;
+        matrix[3] = LvnVec4(t.x, t.y, t.z, 1.0f);
+    }
+}
+
+void slerpBatch(const LvnQuat* q1, const LvnQuat* q2, const float* t, LvnQuat* out, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        lvn::quatSlerp(&q1[i].w, &q2[i].w, t[i], &out[i].w);
+}
+
+LvnFrustum frustumFromMatrix(const LvnMat4& viewProj)
+{
+    // clip space x, y and z are bounded by w, so every plane is a sum or difference of two rows of the matrix
+    LvnVec4 rows[4];
+    for (uint32_t i = 0; i < 4; i++)
+        rows[i] = LvnVec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+
+    LvnClipRegion clipRegion = lvn::getRenderClipRegionEnum();
+    bool zeroToOne = clipRegion == Lvn_ClipRegion_RHZO || clipRegion == Lvn_ClipRegion_LHZO;
+
+    LvnFrustum frustum;
+    frustum.planes[0] = rows[3] + rows[0];
+    frustum.planes[1] = rows[3] - rows[0];
+    frustum.planes[2] = rows[3] + rows[1];
+    frustum.planes[3] = rows[3] - rows[1];
+    frustum.planes[4] = zeroToOne ? rows[2] : rows[3] + rows[2];
+    frustum.planes[5] = rows[3] - rows[2];
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        LvnVec4& plane = frustum.planes[i];
+        float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f)
+            plane = plane / length;
+    }
+
+    return frustum;
+}
+
+bool frustumTestSphere(const LvnFrustum& frustum, const LvnVec3& center, float radius)
+{
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        const LvnVec4& plane = frustum.planes[i];
+        if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+            return false;
+    }
+
+    return true;
+}
+
+bool frustumTestAabb(const LvnFrustum& frustum, const LvnVec3& boundsMin, const LvnVec3& boundsMax)
+{
+    // the corner furthest along the plane normal is outside only if the whole box is
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        const LvnVec4& plane = frustum.planes[i];
+        float x = plane.x >= 0.0f ? boundsMax.x : boundsMin.x;
+        float y = plane.y >= 0.0f ? boundsMax.y : boundsMin.y;
+        float z = plane.z >= 0.0f ? boundsMax.z : boundsMin.z;
+        if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+            return false;
+    }
+
+    return true;
+}
+
+uint32_t frustumCullSpheres(const LvnFrustum& frustum, const LvnVec4* spheres, uint8_t* pVisible, uint32_t count)
+{
+    uint32_t visibleCount = 0;
+    uint32_t i = 0;
+#if defined(LVN_SIMD_MATH)
+    LvnSimdFloat4 planes[6][4];
+    for (uint32_t p = 0; p < 6; p++)
+    {
+        planes[p][0] = lvn::simdSplat(frustum.planes[p].x);
+        planes[p][1] = lvn::simdSplat(frustum.planes[p].y);
+        planes[p][2] = lvn::simdSplat(frustum.planes[p].z);
+        planes[p][3] = lvn::simdSplat(frustum.planes[p].w);
+    }
+
+    // the spheres are transposed so each register holds one component of four spheres, a sphere is culled if its
+    // smallest signed distance to the planes is below minus its radius
+    LvnSimdFloat4 zero = lvn::simdSplat(0.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        LvnSimdFloat4 s[4];
+        lvn::simdMat4Transpose(s, &spheres[i].x);
+
+        LvnSimdFloat4 distance = lvn::simdMulAdd(planes[0][2], s[2], lvn::simdMulAdd(planes[0][1], s[1], lvn::simdMulAdd(planes[0][0], s[0], planes[0][3])));
+        for (uint32_t p = 1; p < 6; p++)
+            distance = lvn::simdMin(distance, lvn::simdMulAdd(planes[p][2], s[2], lvn::simdMulAdd(planes[p][1], s[1], lvn::simdMulAdd(planes[p][0], s[0], planes[p][3]))));
+
+        int outside = lvn::simdLessMask(lvn::simdAdd(distance, s[3]), zero);
+        for (uint32_t j = 0; j < 4; j++)
+        {
+            uint8_t visible = (outside >> j) & 1 ? 0 : 1;
+            pVisible[i + j] = visible;
+            visibleCount += visible;
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        uint8_t visible = lvn::frustumTestSphere(frustum, LvnVec3(spheres[i]), spheres[i].w) ? 1 : 0;
+        pVisible[i] = visible;
+        visibleCount += visible;
+    }
+
+    return visibleCount;
+}
+
 } /* namespace lvn */
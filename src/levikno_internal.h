@@ -3,6 +3,11 @@
 
 #include "levikno.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 
 // ------------------------------------------------------------
 // Layout: levikno_internal.h
@@ -21,7 +26,9 @@
 // -- [SUBSECT]: General Graphics Structures
 // [SECTION]: Context Internal Structs
 // -- [SUBSECT]: Memory Alloc Structures
+// -- [SUBSECT]: Job System Structures
 // -- [SUBSECT]: Renderer Structures
+// -- [SUBSECT]: IO Structures
 // -- [SUBSECT]: Context Structure
 // [SECTION]: Internal Functions
 
@@ -201,6 +208,26 @@ public:
         m_Tail->prev = node;
         m_Size++;
     }
+    void push_back(T&& data)
+    {
+        if (!m_Size)
+        {
+            m_Head = lvn::memNew<LvnLNode<T>>();
+            m_Head->value = std::move(data);
+            m_Head->next = nullptr;
+            m_Head->prev = nullptr;
+            m_Tail = m_Head;
+            m_Size++;
+            return;
+        }
+
+        LvnLNode<T>* node = m_Tail;
+        node->next = lvn::memNew<LvnLNode<T>>();
+        m_Tail = node->next;
+        m_Tail->value = std::move(data);
+        m_Tail->prev = node;
+        m_Size++;
+    }
     void push_front(const T& data)
     {
         if (!m_Size)
@@ -253,6 +280,7 @@ public:
     const T&    back() const { LVN_CORE_ASSERT(m_Size, "cannot call back on empty list"); return m_Tail->value; }
 };
 
+// memory blocks are cache line aligned, big blocks are backed by huge pages when the os allows it
 class LvnMemoryBlock
 {
 private:
@@ -265,32 +293,52 @@ public:
     LvnMemoryBlock(uint64_t memsize)
         : m_Size(memsize)
     {
-        m_Memory = calloc(1, memsize);
+        m_Memory = lvn::memAllocAligned(memsize, LVN_CACHE_LINE_SIZE);
         LVN_CORE_ASSERT(m_Memory, "malloc failure when allocating memory block");
     }
 
     LvnMemoryBlock(const LvnMemoryBlock& other)
     {
         m_Size = other.m_Size;
-        m_Memory = malloc(m_Size);
-        LVN_CORE_ASSERT(m_Memory, "malloc failure when allocating memory block");
-        memcpy(m_Memory, other.m_Memory, other.m_Size);
+        m_Memory = lvn::memAllocAligned(m_Size, LVN_CACHE_LINE_SIZE);
+        LVN_CORE_ASSERT(m_Memory || !m_Size, "malloc failure when allocating memory block");
+        if (m_Memory) { memcpy(m_Memory, other.m_Memory, other.m_Size); }
     }
 
     LvnMemoryBlock& operator =(const LvnMemoryBlock& other)
     {
+        if (this == &other) return *this;
+        lvn::memFreeAligned(m_Memory);
         m_Size = other.m_Size;
-        void* memptr = realloc(m_Memory, m_Size);
-        LVN_CORE_ASSERT(memptr, "malloc failure when allocating memory block");
-        memcpy(memptr, other.m_Memory, other.m_Size);
-        m_Memory = memptr;
+        m_Memory = lvn::memAllocAligned(m_Size, LVN_CACHE_LINE_SIZE);
+        LVN_CORE_ASSERT(m_Memory || !m_Size, "malloc failure when allocating memory block");
+        if (m_Memory) { memcpy(m_Memory, other.m_Memory, other.m_Size); }
+
+        return *this;
+    }
+
+    LvnMemoryBlock(LvnMemoryBlock&& other)
+        : m_Memory(other.m_Memory), m_Size(other.m_Size)
+    {
+        other.m_Memory = nullptr;
+        other.m_Size = 0;
+    }
+
+    LvnMemoryBlock& operator =(LvnMemoryBlock&& other)
+    {
+        if (this == &other) return *this;
+        lvn::memFreeAligned(m_Memory);
+        m_Memory = other.m_Memory;
+        m_Size = other.m_Size;
+        other.m_Memory = nullptr;
+        other.m_Size = 0;
 
         return *this;
     }
 
     ~LvnMemoryBlock()
     {
-        free(m_Memory);
+        lvn::memFreeAligned(m_Memory);
     }
 
     void* operator [](uint64_t bytes)
@@ -303,59 +351,89 @@ public:
     uint64_t size() { return m_Size; }
 };
 
+// bump allocates object slots out of one memory block, slots are never handed back to the binding
+// freed slots go to the free list of their sType instead, so once a binding is full it stays full
 class LvnMemoryBinding
 {
 private:
     void* m_Data;
     uint64_t m_ObjSize, m_Size, m_Capacity;
-    LvnQueue<void*> m_Available;
-
-    LvnMemoryBinding* m_Next;
 
 public:
-    LvnMemoryBinding() : m_Data(nullptr), m_ObjSize(0), m_Size(0), m_Capacity(0), m_Next(nullptr) {}
-    LvnMemoryBinding(void* data, uint64_t objSize, uint64_t count) : m_Data(data), m_ObjSize(objSize), m_Size(0), m_Capacity(count), m_Next(nullptr) {}
+    LvnMemoryBinding() : m_Data(nullptr), m_ObjSize(0), m_Size(0), m_Capacity(0) {}
+    LvnMemoryBinding(void* data, uint64_t objSize, uint64_t count) : m_Data(data), m_ObjSize(objSize), m_Size(0), m_Capacity(count) {}
 
-    void                 set_next_memory_binding(LvnMemoryBinding* next) { m_Next = next; }
-    LvnMemoryBinding*    get_next_memory_binding() { return m_Next; }
-    bool                 full() { return m_Size == m_Capacity && m_Available.empty(); }
+    bool                 full() { return m_Size == m_Capacity; }
+    uint64_t             size() { return m_Size; }
+    uint64_t             capacity() { return m_Capacity; }
+    bool                 contains(void* ptr) { return ptr >= m_Data && ptr < static_cast<uint8_t*>(m_Data) + m_Capacity * m_ObjSize; }
 
-    LvnMemoryBinding* find_empty_memory_binding()
+    void* take_next()
     {
-        if (!LvnMemoryBinding::full()) { return this; }
+        LVN_CORE_ASSERT(!full(), "cannot take next memory index, memory binding is full");
 
-        if (m_Next != nullptr)
-            return m_Next->find_empty_memory_binding();
-
-        return nullptr;
+        uint64_t index = m_Size;
+        m_Size++;
+        return &static_cast<uint8_t*>(m_Data)[index * m_ObjSize];
     }
+};
 
-    void* take_next()
+// lock-free stack (treiber stack) of freed object slots, each free slot holds the link to the next one in its own memory
+// the head packs a tag next to the slot pointer that changes on every push and pop, so a head that was popped
+// and pushed back by another thread in between (aba) fails the compare exchange
+// slots live in memory blocks that are only freed when the context is terminated or by memPoolTrim, which rebuilds the
+// list without the slots of the empty blocks it frees while no other thread creates or destroys objects, so reading the
+// link of a slot that another thread just took is always a valid read, the value is thrown away when the exchange fails
+class LvnObjectFreeList
+{
+private:
+    struct Node
     {
-        if (!m_Available.empty())
-        {
-            void* value = m_Available.front();
-            m_Available.pop();
-            return value;
-        }
+        std::atomic<Node*> next;
+    };
 
-        if (m_Size == m_Capacity) // current memory block is full, get next memory block
-        {
-            LVN_CORE_ASSERT(m_Next != nullptr, "cannot take next memory index, next memory binding not set");
-            return m_Next->take_next();
-        }
+    static constexpr uint32_t s_PtrBits = sizeof(void*) == 8 ? 48 : 32;
+    static constexpr uint64_t s_PtrMask = (1ull << s_PtrBits) - 1;
 
-        uint64_t index = m_Size;
-        m_Size++;
-        return &static_cast<uint8_t*>(m_Data)[index * m_ObjSize];
+    std::atomic<uint64_t> m_Head;
+
+    static Node* get_ptr(uint64_t head) { return reinterpret_cast<Node*>(static_cast<uintptr_t>(head & s_PtrMask)); }
+    static uint64_t make_head(Node* node, uint64_t prevHead) { return (((prevHead >> s_PtrBits) + 1) << s_PtrBits) | static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)); }
+
+public:
+    LvnObjectFreeList() : m_Head(0) {}
+
+    LvnObjectFreeList(const LvnObjectFreeList&) = delete;
+    LvnObjectFreeList& operator=(const LvnObjectFreeList&) = delete;
+
+    void push(void* slot)
+    {
+        LVN_CORE_ASSERT(slot != nullptr, "cannot push nullptr slot onto object free list");
+        LVN_CORE_ASSERT((static_cast<uint64_t>(reinterpret_cast<uintptr_t>(slot)) & ~s_PtrMask) == 0, "object slot address does not fit into the free list head");
+
+        Node* node = new (slot) Node();
+        uint64_t head = m_Head.load(std::memory_order_relaxed);
+        do
+        {
+            node->next.store(get_ptr(head), std::memory_order_relaxed);
+        } while (!m_Head.compare_exchange_weak(head, make_head(node, head), std::memory_order_release, std::memory_order_relaxed));
     }
 
-    void push_back(void* value)
+    void* pop()
     {
-        LVN_CORE_ASSERT(value != nullptr, "value is nullptr when pushing back into memory binding queue");
+        uint64_t head = m_Head.load(std::memory_order_acquire);
+        Node* node;
+        do
+        {
+            node = get_ptr(head);
+            if (node == nullptr)
+                return nullptr;
+        } while (!m_Head.compare_exchange_weak(head, make_head(node->next.load(std::memory_order_relaxed), head), std::memory_order_acquire, std::memory_order_acquire));
 
-        m_Available.push(value);
+        return node;
     }
+
+    void clear() { m_Head.store(0, std::memory_order_relaxed); }
 };
 
 struct LvnMemoryPool
@@ -363,12 +441,16 @@ struct LvnMemoryPool
     LvnMemoryBlock baseMemoryBlock;
     LvnVector<LvnList<LvnMemoryBlock>> memBlocks;
     LvnVector<LvnList<LvnMemoryBinding>> memBindings;
+    LvnMemoryBinding* currentBindings[Lvn_Stype_Max_Value]; // newest binding of each sType, the only one that can still have room
+    LvnObjectFreeList freeLists[Lvn_Stype_Max_Value];
 };
 
 
 // -- [SUBSECT]: Logging Data Structures
 // ------------------------------------------------------------
 
+struct LvnLogBinaryFile;
+
 struct LvnLogger
 {
     LvnString loggerName;
@@ -377,6 +459,121 @@ struct LvnLogger
     LvnVector<LvnLogPattern> logPatterns;
 
     LvnLogFile logfile;
+    LvnLogBinaryFile* binfile;                  // nullptr unless lvn::logSetBinaryFileConfig enabled a binary log file
+};
+
+#define LVN_LOG_RECORD_INLINE_SIZE 200
+
+// message queued for the async log thread, formatted by the caller but not yet run through the log patterns
+struct LvnLogRecord
+{
+    LvnLogger* logger;
+    long long timeEpoch;
+    LvnLogLevel level;
+    char* heapMsg;                              // messages that do not fit inline, freed by the log thread
+    char msg[LVN_LOG_RECORD_INLINE_SIZE];
+};
+
+// date fields of the second the last log line on a thread was formatted at, lines within the same second reuse them
+struct LvnLogTimeCache
+{
+    long long epochSecond = -1;                 // second the strings were formatted for, -1 until the first log
+    struct tm tm = {};
+    char time[9];                               // HH:MM:SS
+    char time12[9];
+    char year[8];
+    char year02d[3];
+    char month[3];
+    char day[3];
+    char hour[3];
+    char hour12[3];
+    char minute[3];
+    char second[3];
+};
+
+// log lines of one file collected by the log thread during a batch
+struct LvnLogFileBatch
+{
+    LvnLogFile* file;
+    LvnLogLevel level;                          // highest level in the batch, decides whether the file buffer is written right away
+    LvnVector<char> data;
+};
+
+// records of a binary log file, the file starts with LVN_LOG_BINARY_MAGIC followed by the records
+enum LvnLogBinaryRecordType : uint8_t
+{
+    Lvn_LogBinaryRecord_Logger = 0,             // varint length and the logger name of the messages after it
+    Lvn_LogBinaryRecord_Format = 1,             // varint length and a format string, format ids count up from 0 in the order they are written
+    Lvn_LogBinaryRecord_Message = 2,            // varint format id, time since epoch, level and the arguments the format reads
+};
+
+// type of the argument a printf conversion reads, integers, pointers and floats are stored in 8 bytes in host byte order
+enum LvnLogArgType : uint8_t
+{
+    Lvn_LogArgType_Int,                         // also char and short, they are promoted to int
+    Lvn_LogArgType_Long,
+    Lvn_LogArgType_LongLong,
+    Lvn_LogArgType_IntMax,
+    Lvn_LogArgType_Size,
+    Lvn_LogArgType_PtrDiff,
+    Lvn_LogArgType_Double,
+    Lvn_LogArgType_LongDouble,                  // stored as a double
+    Lvn_LogArgType_String,                      // varint length and the characters
+    Lvn_LogArgType_Pointer,                     // also %n and wide strings, they are stored by address
+};
+
+// one conversion of a format string
+struct LvnLogFormatSpec
+{
+    uint32_t begin, end;                        // range of the conversion in the format string, from the '%' to past the conversion character
+    int32_t precision;                          // -1 without a precision, caps the characters stored for strings
+    uint8_t stars;                              // '*' width and precision values read before the argument, stored as Lvn_LogArgType_Int
+    bool precisionStar;                         // the last star is the precision
+    char conversion;
+    LvnLogArgType type;
+};
+
+struct LvnLogBinaryFormat
+{
+    LvnString text;
+    LvnVector<LvnLogFormatSpec> specs;
+};
+
+// binary log file of a logger, messages are stored as the id of their format string and the raw arguments
+struct LvnLogBinaryFile
+{
+    LvnString filename;
+    FILE* fileptr;
+    std::mutex mutex;                           // loggers are shared between threads
+    LvnVector<uint8_t> buffer;                  // records not yet handed to the io thread
+    LvnFlatHashMap<uint64_t, uint32_t> formatIds; // address of a format string to its index in formats
+    LvnVector<LvnLogBinaryFormat> formats;
+};
+
+
+// -- [SUBSECT]: Profiling Data Structures
+// ------------------------------------------------------------
+
+struct LvnProfileZone
+{
+    const char* name;
+    uint64_t start, end;                        // lvn::profileGetTicks
+};
+
+// zones of one thread, only the owning thread writes to it
+struct LvnAtomEntry
+{
+    const char* str;
+    uint32_t length;
+    uint64_t hash;
+};
+
+struct LvnProfileThread
+{
+    LvnVector<LvnProfileZone> zones;            // ring buffer, allocated with the first zone
+    std::atomic<uint64_t> count;                // zones written since the last clear, the ring index is count & (capacity - 1)
+    LvnString name;                             // guarded by profileMutex
+    uint32_t index;                             // order of registration, used as the thread id in traces
 };
 
 
@@ -425,15 +622,25 @@ struct LvnWindowData
     int minWidth, minHeight;             // minimum width and height of window
     int maxWidth, maxHeight;             // maximum width and height of window
     bool fullscreen, resizable, vSync;   // sets window to fullscreen; enables window resizing; vSync controls window framerate
+    LvnPresentMode presentMode;          // present mode of the window swapchain
     LvnWindowIconData* pIcons;           // icon images used for window/app icon
     uint32_t iconCount;                  // iconCount is the number of icons in pIcons
     void (*eventCallBackFn)(LvnEvent*);  // function ptr used as a callback to get events from this window
     void* userData;
+    LvnMpmcQueue<LvnEvent>* eventQueue;  // events are buffered here instead of sent to eventCallBackFn when set, null for callback windows
+
+    LvnSpscQueue<LvnMouseMotionSample>* mouseSamples; // cursor motion pushed by the window api during polls, null when sampling is disabled
+    LvnPair<double> mouseLastPos;        // position of the last sample
+    LvnPair<double> mouseCarry;          // motion of samples that did not fit in mouseSamples, added to the next sample pushed
+    bool mouseSampled;                   // set once the first sample was taken, it has no delta
+
+    std::atomic<bool> redrawRequested;   // set by every event of the window and by lvn::windowInvalidate, cleared by lvn::windowConsumeRedraw
 };
 
 struct LvnRenderPass
 {
     void* nativeRenderPass;
+    void* nativeRenderingFormats; // attachment formats pipelines are built against when there is no native render pass (vulkan dynamic rendering)
 };
 
 /*
@@ -444,6 +651,51 @@ struct LvnRenderPass
         allocated and destroyed with its corresponding functions.
         Use lvn::createWindow() and lvn::destroyWindow()
 */
+struct LvnGpuTimestampScope
+{
+    LvnString name;
+    uint32_t beginQuery;    // query written when the scope begins, the end query follows it, UINT32_MAX when the frame ran out of queries
+    uint32_t depth;
+    bool ended;
+};
+
+// timestamp scopes recorded in one frame, reused once the gpu has finished the frame and the queries are read back
+struct LvnGpuTimestampFrame
+{
+    LvnVector<LvnGpuTimestampScope> scopes;
+    LvnVector<uint32_t> openScopes;  // indices of scopes that have begun but not ended, innermost last
+    LvnVector<uint32_t> queries;     // query objects of the frame (opengl)
+    uint32_t queryCount;             // queries used by the scopes of the frame
+};
+
+struct LvnGpuTimestampResult
+{
+    LvnString name;
+    double milliseconds;
+    uint32_t depth;
+};
+
+// counters of LvnFrameStats, see the member table in levikno.cpp
+enum LvnFrameStat
+{
+    Lvn_FrameStat_DrawCalls,
+    Lvn_FrameStat_Vertices,
+    Lvn_FrameStat_Instances,
+    Lvn_FrameStat_IndirectDraws,
+    Lvn_FrameStat_Dispatches,
+    Lvn_FrameStat_RenderPasses,
+    Lvn_FrameStat_PipelineBinds,
+    Lvn_FrameStat_DescriptorSetBinds,
+    Lvn_FrameStat_VertexBufferBinds,
+    Lvn_FrameStat_IndexBufferBinds,
+    Lvn_FrameStat_PushConstantBytes,
+    Lvn_FrameStat_CommandListsExecuted,
+    Lvn_FrameStat_BufferUploads,
+    Lvn_FrameStat_BufferUploadBytes,
+
+    Lvn_FrameStat_Max_Value,
+};
+
 struct LvnWindow
 {
     LvnWindowData data;              // holds data of window (eg. width, height)
@@ -453,8 +705,14 @@ struct LvnWindow
     uint32_t topologyTypeEnum;       // topologyType used to render primitives (opengl)
     uint32_t vao;                    // vertex array object per pipeline object (opengl)
     uint32_t indexOffset;            // index offset when binding index buffer (opengl)
-    LvnHashMap<uint32_t, uint32_t>* bindingDescriptions;
+    LvnFlatHashMap<uint32_t, uint32_t>* bindingDescriptions;
     LvnVector<uint8_t> cmdBuffer;    // command buffer to store draw commands in byte data
+    LvnVector<LvnGpuTimestampFrame> timestampFrames; // timestamp scopes of the frames in flight (opengl)
+    uint32_t timestampFrame;         // frame the timestamp scopes are recorded to (opengl)
+    LvnVector<LvnGpuTimestampResult> timestamps; // scope times of the latest frame read back from the gpu
+    uint64_t cmdBufferSize;          // bytes of cmdBuffer used by the commands of the frame, the buffer itself only grows (opengl)
+    LvnCommandList* commandList;     // command list the render commands are recorded to, null when recording to the frame
+    LvnArena frameArena;             // transient allocations of the frame, reset at the start of renderBeginNextFrame
 };
 
 
@@ -470,6 +728,8 @@ struct LvnWindowContext
     void                (*updateWindow)(LvnWindow*);
     bool                (*windowOpen)(LvnWindow*);
     void                (*windowPollEvents)();
+    void                (*windowWaitEvents)(double);
+    void                (*windowPostEmptyEvent)();
     LvnPair<int>        (*getDimensions)(LvnWindow*);
     unsigned int        (*getWindowWidth)(LvnWindow*);
     unsigned int        (*getWindowHeight)(LvnWindow*);
@@ -488,6 +748,8 @@ struct LvnWindowContext
     float               (*getMouseY)(LvnWindow*);
     void                (*setMouseCursor)(LvnWindow*, LvnMouseCursor);
     void                (*SetMouseInputMode)(LvnWindow*, LvnMouseInputMode);
+    bool                (*mouseRawMotionSupported)();
+    void                (*setMouseRawMotion)(LvnWindow*, bool);
 
     LvnPair<int>        (*getWindowPos)(LvnWindow*);
     void                (*getWindowPosPtr)(LvnWindow*, int*, int*);
@@ -503,30 +765,40 @@ struct LvnWindowContext
 // -- [SUBSECT]: Graphics Context
 // ------------------------------------------------------------
 
+struct LvnEnvironmentMapBakeInfo;
+
 struct LvnGraphicsContext
 {
     LvnGraphicsApi              graphicsapi;
     bool                        enableGraphicsApiDebugLogs;
     LvnTextureFormat            frameBufferColorFormat;
     uint32_t                    maxFramesInFlight;
+    uint32_t                    frameLatency;
+    bool                        waitForPresent;
+    LvnPhysicalDevicePreference physicalDevicePreference;
+    LvnString                   pipelineCachePath;
+    LvnString                   shaderCacheDirectory;
 
     void                        (*getPhysicalDevices)(LvnPhysicalDevice**, uint32_t*);
     LvnResult                   (*checkPhysicalDeviceSupport)(LvnPhysicalDevice*);
     LvnResult                   (*setPhysicalDevice)(LvnPhysicalDevice*);
+    void                        (*getMemoryStats)(LvnGraphicsMemoryStats*);
 
     LvnResult                   (*createShaderFromSrc)(LvnShader*, const LvnShaderCreateInfo*);
     LvnResult                   (*createShaderFromFileSrc)(LvnShader*, const LvnShaderCreateInfo*);
     LvnResult                   (*createShaderFromFileBin)(LvnShader*, const LvnShaderCreateInfo*);
     LvnResult                   (*createDescriptorLayout)(LvnDescriptorLayout*, const LvnDescriptorLayoutCreateInfo*);
     LvnResult                   (*allocateDescriptorSet)(LvnDescriptorSet*, LvnDescriptorLayout*);
+    LvnResult                   (*allocateTransientDescriptorSet)(LvnDescriptorSet**, LvnDescriptorLayout*);
     LvnResult                   (*createPipeline)(LvnPipeline*, const LvnPipelineCreateInfo*);
+    LvnResult                   (*createComputePipeline)(LvnPipeline*, const LvnComputePipelineCreateInfo*);
     LvnResult                   (*createFrameBuffer)(LvnFrameBuffer*, const LvnFrameBufferCreateInfo*);
     LvnResult                   (*createBuffer)(LvnBuffer*, const LvnBufferCreateInfo*);
     LvnResult                   (*createSampler)(LvnSampler*, const LvnSamplerCreateInfo*);
     LvnResult                   (*createTexture)(LvnTexture*, const LvnTextureCreateInfo*);
     LvnResult                   (*createTextureSampler)(LvnTexture*, const LvnTextureSamplerCreateInfo*);
     LvnResult                   (*createCubemap)(LvnCubemap*, const LvnCubemapCreateInfo*);
-    LvnResult                   (*createCubemapHdr)(LvnCubemap*, const LvnCubemapHdrCreateInfo*);
+    LvnResult                   (*createEnvironmentMap)(LvnEnvironmentMap*, const LvnEnvironmentMapBakeInfo*);
 
     void                        (*destroyShader)(LvnShader*);
     void                        (*destroyDescriptorLayout)(LvnDescriptorLayout*);
@@ -536,33 +808,61 @@ struct LvnGraphicsContext
     void                        (*destroySampler)(LvnSampler*);
     void                        (*destroyTexture)(LvnTexture*);
     void                        (*destroyCubemap)(LvnCubemap*);
+    void                        (*destroyEnvironmentMap)(LvnEnvironmentMap*);
 
     void                        (*renderBeginNextFrame)(LvnWindow*);
     void                        (*renderDrawSubmit)(LvnWindow*);
+    void                        (*renderBeginSubmitBatch)();
+    void                        (*renderEndSubmitBatch)();
     void                        (*renderBeginCommandRecording)(LvnWindow*);
     void                        (*renderEndCommandRecording)(LvnWindow*);
+    LvnResult                   (*renderBeginSecondaryCommandRecording)(LvnWindow*, LvnFrameBuffer*);
+    void                        (*renderEndSecondaryCommandRecording)(LvnWindow*);
     void                        (*renderCmdDraw)(LvnWindow*, uint32_t);
     void                        (*renderCmdDrawIndexed)(LvnWindow*, uint32_t);
     void                        (*renderCmdDrawInstanced)(LvnWindow*, uint32_t, uint32_t, uint32_t);
     void                        (*renderCmdDrawIndexedInstanced)(LvnWindow*, uint32_t, uint32_t, uint32_t);
+    void                        (*renderCmdDrawIndirect)(LvnWindow*, LvnBuffer*, uint64_t, uint32_t, uint32_t);
+    void                        (*renderCmdDrawIndexedIndirect)(LvnWindow*, LvnBuffer*, uint64_t, uint32_t, uint32_t);
+    void                        (*renderCmdDrawIndexedIndirectCount)(LvnWindow*, LvnBuffer*, uint64_t, LvnBuffer*, uint64_t, uint32_t, uint32_t);
     void                        (*renderCmdSetStencilReference)(uint32_t);
     void                        (*renderCmdSetStencilMask)(uint32_t, uint32_t);
+    void                        (*renderCmdSetCullMode)(LvnWindow*, LvnCullFaceMode);
+    void                        (*renderCmdSetFrontFace)(LvnWindow*, LvnCullFrontFace);
+    void                        (*renderCmdSetPrimitiveTopology)(LvnWindow*, LvnTopologyType);
+    void                        (*renderCmdSetDepthTest)(LvnWindow*, bool, bool, LvnCompareOperation);
+    void                        (*renderCmdSetBlendEnable)(LvnWindow*, uint32_t, bool);
+    void                        (*renderCmdSetScissor)(LvnWindow*, int32_t, int32_t, uint32_t, uint32_t);
     void                        (*renderCmdBeginRenderPass)(LvnWindow*, float r, float g, float b, float a);
     void                        (*renderCmdEndRenderPass)(LvnWindow*);
     void                        (*renderCmdBindPipeline)(LvnWindow*, LvnPipeline*);
     void                        (*renderCmdBindVertexBuffer)(LvnWindow*, uint32_t, uint32_t, LvnBuffer**, uint64_t*);
     void                        (*renderCmdBindIndexBuffer)(LvnWindow*, LvnBuffer*, uint64_t);
-    void                        (*renderCmdBindDescriptorSets)(LvnWindow*, LvnPipeline*, uint32_t, uint32_t, LvnDescriptorSet**);
+    void                        (*renderCmdBindDescriptorSets)(LvnWindow*, LvnPipeline*, uint32_t, uint32_t, LvnDescriptorSet**, uint32_t, const uint32_t*);
+    void                        (*renderCmdPushConstants)(LvnWindow*, LvnPipeline*, LvnShaderStage, uint32_t, uint32_t, const void*);
+    void                        (*renderCmdDispatch)(LvnWindow*, uint32_t, uint32_t, uint32_t);
+    void                        (*renderCmdMemoryBarrier)(LvnWindow*, LvnMemoryBarrierFlagBits);
+    void                        (*renderCmdBeginTimestamp)(LvnWindow*, const char*);
+    void                        (*renderCmdEndTimestamp)(LvnWindow*);
     void                        (*renderCmdBeginFrameBuffer)(LvnWindow*, LvnFrameBuffer*);
     void                        (*renderCmdEndFrameBuffer)(LvnWindow*, LvnFrameBuffer*);
+    void                        (*renderCmdReadbackFrameBuffer)(LvnWindow*, LvnFrameBuffer*, uint32_t, LvnReadbackFunc, void*);
 
     void                        (*bufferUpdateData)(LvnBuffer*, void*, uint64_t, uint64_t);
     void                        (*bufferResize)(LvnBuffer*, uint64_t);
+    void*                       (*bufferGetMappedData)(LvnBuffer*);
+    void*                       (*bufferMap)(LvnBuffer*);
+    void                        (*bufferFlushRange)(LvnBuffer*, uint64_t, uint64_t);
+    void                        (*bufferUnmap)(LvnBuffer*);
+    LvnResult                   (*textureUpdateData)(LvnTexture*, const void*, uint32_t, uint32_t, uint32_t, uint32_t);
     void                        (*updateDescriptorSetData)(LvnDescriptorSet*, LvnDescriptorUpdateInfo*, uint32_t);
+    void                        (*updateDescriptorSetsData)(const LvnDescriptorSetUpdate*, uint32_t);
     LvnTexture*                 (*frameBufferGetImage)(LvnFrameBuffer*, uint32_t);
     LvnRenderPass*              (*frameBufferGetRenderPass)(LvnFrameBuffer*);
     void                        (*framebufferResize)(LvnFrameBuffer*, uint32_t, uint32_t);
     void                        (*frameBufferSetClearColor)(LvnFrameBuffer*, uint32_t, float, float, float, float);
+    LvnResult                   (*frameBufferReadPixels)(LvnFrameBuffer*, uint32_t, void*, uint64_t);
+    LvnResult                   (*windowReadPixels)(LvnWindow*, void*, uint64_t);
 
     LvnDepthImageFormat         (*findSupportedDepthImageFormat)(LvnDepthImageFormat*, uint32_t);
 };
@@ -578,6 +878,9 @@ struct LvnPhysicalDevice
 // -- [SUBSECT]: Draw Command Buffer Structures
 // ------------------------------------------------------------
 
+// worker threads compiling pipelines created with createPipelineAsync
+#define LVN_PIPELINE_COMPILE_THREADS (2)
+
 struct LvnDrawCmdHeader
 {
     uint64_t size;
@@ -616,6 +919,18 @@ struct LvnCmdDrawIndexedInstanced
     uint32_t firstInstance;
 };
 
+struct LvnCmdDrawIndirect
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    LvnBuffer* buffer;
+    uint64_t offset;
+    LvnBuffer* countBuffer; // only used by indirect count draws
+    uint64_t countBufferOffset;
+    uint32_t drawCount;
+    uint32_t stride;
+};
+
 struct LvnCmdSetStencilReference
 {
     LvnDrawCmdHeader header;
@@ -629,6 +944,52 @@ struct LvnCmdSetStencilMask
     uint32_t writeMask;
 };
 
+struct LvnCmdSetCullMode
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    LvnCullFaceMode cullMode;
+};
+
+struct LvnCmdSetFrontFace
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    LvnCullFrontFace frontFace;
+};
+
+struct LvnCmdSetPrimitiveTopology
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    LvnTopologyType topology;
+};
+
+struct LvnCmdSetDepthTest
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    bool enableDepth;
+    bool depthWrite;
+    LvnCompareOperation depthOpCompare;
+};
+
+struct LvnCmdSetBlendEnable
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    uint32_t attachment;
+    bool enable;
+};
+
+struct LvnCmdSetScissor
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    int32_t x, y;
+    uint32_t width, height;
+};
+
 struct LvnCmdBeginRenderPass
 {
     LvnDrawCmdHeader header;
@@ -675,6 +1036,70 @@ struct LvnCmdBindDescriptorSets
     uint32_t firstSetIndex;
     uint32_t descriptorSetCount;
     LvnDescriptorSet** pDescriptorSets;
+    uint32_t dynamicOffsetCount; // dynamic offsets are copied right after the command
+};
+
+struct LvnCmdPushConstants
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    LvnPipeline* pipeline;
+    LvnShaderStage shaderStage;
+    uint32_t offset;
+    uint32_t size; // push constant data is copied right after the command
+};
+
+struct LvnCmdDispatch
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    uint32_t groupCountX;
+    uint32_t groupCountY;
+    uint32_t groupCountZ;
+};
+
+struct LvnCmdMemoryBarrier
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    LvnMemoryBarrierFlagBits barriers;
+};
+
+struct LvnCmdWriteTimestamp
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    uint32_t query;
+};
+
+struct LvnCmdBeginTimestamp
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    uint32_t nameLength; // null terminated name is copied right after the command
+};
+
+struct LvnCmdEndTimestamp
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+};
+
+struct LvnCmdReadbackFrameBuffer
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    LvnFrameBuffer* frameBuffer;
+    uint32_t attachmentIndex;
+    LvnReadbackFunc func;
+    void* userData;
+};
+
+struct LvnCmdExecuteCommandList
+{
+    LvnDrawCmdHeader header;
+    LvnWindow* window;
+    LvnCommandList* commandList;
 };
 
 struct LvnCmdBeginFrameBuffer
@@ -691,6 +1116,15 @@ struct LvnCmdEndFrameBuffer
     LvnFrameBuffer* frameBuffer;
 };
 
+// render commands recorded once and replayed by renderCmdExecuteCommandList, stored as the LvnCmd structs above with their payloads
+struct LvnCommandList
+{
+    LvnWindow* window;               // window the commands were recorded for
+    LvnVector<uint8_t> commands;     // bump allocated command arena, kept between recordings so rerecording does not allocate
+    uint64_t size;                   // bytes used by the recorded commands
+    uint32_t commandCount;
+};
+
 
 // -- [SUBSECT]: General Graphics Structures
 // ------------------------------------------------------------
@@ -699,35 +1133,107 @@ struct LvnShader
 {
     void* nativeVertexShaderModule;
     void* nativeFragmentShaderModule;
+    void* nativeComputeShaderModule;
 
     uint32_t vertexShaderId;
     uint32_t fragmentShaderId;
+    uint32_t computeShaderId;
 };
 
 struct LvnDescriptorLayout
 {
     void* descriptorLayout;
-    void* descriptorPool;
+    void* descriptorPool;                          // backend allocator the descriptor sets come from
 
-    LvnVector<LvnDescriptorSet> descriptorSets;
-    uint64_t descriptorSetIndex;
+    LvnVector<LvnDescriptorBinding> descriptorBindings;
+    LvnVector<LvnDescriptorSet*> descriptorSets;   // persistent sets allocated from the layout, freed with it
+    uint32_t maxSets;
+    LvnDescriptorLayoutStats stats;
 };
 
 struct LvnDescriptorSet
 {
     LvnVector<void*> descriptorSets;
-    void* singleSet;
+    void* singleSet;                               // opengl set object
+    void* descriptorPool;                          // vulkan pool the sets were allocated from, pending descriptor updates are dropped with it
+    void* updateTemplate;                          // backend template writing every binding of the layout at once, null when there is none
+    bool transient;                                // transient sets are owned by the backend and reused once their frame retires
 };
 
 struct LvnPipeline
 {
     void* nativePipeline;
     void* nativePipelineLayout;
+    void* nativeDynamicState; // values of the dynamic states set again on each bind, null when the pipeline has none
 
     uint32_t id;
     uint32_t vaoId;
+    bool compute;
+    uint32_t refCount; // pipelines are shared between equal create infos, destroyed once every reference is destroyed
+
+    // background compiled pipelines, binds use the fallback while compiling
+    std::atomic<bool> compiling;
+    bool compileFailed;
+    LvnPipeline* fallback;
 
-    LvnHashMap<uint32_t, uint32_t> bindingDescriptions;
+    LvnFlatHashMap<uint32_t, uint32_t> bindingDescriptions;
+};
+
+// create info of a pipeline compiled in the background, with copies of the arrays it points to, also kept by hot reload to rebuild pipelines
+struct LvnPipelineCompileJob
+{
+    LvnPipeline* pipeline;
+    LvnPipelineCreateInfo createInfo;
+    LvnPipelineSpecification pipelineSpecification;
+    LvnVector<LvnPipelineColorBlendAttachment> colorBlendAttachments;
+    uint32_t sampleMask;
+    LvnVector<LvnVertexBindingDescription> vertexBindingDescriptions;
+    LvnVector<LvnVertexAttribute> vertexAttributes;
+    LvnVector<LvnDescriptorLayout*> descriptorLayouts;
+    LvnVector<LvnPushConstantRange> pushConstantRanges;
+};
+
+struct LvnHotReloadFile
+{
+    LvnString filepath;
+    uint64_t modifiedTime;              // last write time seen, zero if the file could not be read
+    LvnFileChangedFunc func;
+    void* userData;
+    const void* object;                 // shader, texture or model reloaded by func, nullptr for files watched with hotReloadWatchFile
+};
+
+struct LvnHotReloadShader
+{
+    LvnShader* shader;
+    LvnShaderCreateInfo createInfo;     // file paths the shader was created from
+    bool binary;
+};
+
+// pipelines of a watched shader keep a copy of their create info and are rebuilt with it when the shader is reloaded
+struct LvnHotReloadPipeline
+{
+    LvnPipeline* pipeline;
+    const LvnShader* shader;
+    LvnPipelineCompileJob* job;                         // graphics pipelines, nullptr for compute pipelines
+    LvnComputePipelineCreateInfo computeCreateInfo;     // compute pipelines, the arrays are pointed at computeDescriptorLayouts and computePushConstantRanges before each rebuild
+    LvnVector<LvnDescriptorLayout*> computeDescriptorLayouts;
+    LvnVector<LvnPushConstantRange> computePushConstantRanges;
+};
+
+struct LvnHotReloadModel
+{
+    LvnModel* model;
+    LvnVertexLayout layout;
+    bool hasLayout;
+    LvnMeshOptimizeFlagBits optimize;
+};
+
+struct LvnPipelineCacheEntry
+{
+    uint64_t hash;
+    LvnVector<uint8_t> key;             // create info serialized member by member, compared once the hashes match
+    LvnVector<const void*> objects;     // shader, descriptor layouts and render pass in the key, the entry is dropped when one is destroyed
+    LvnPipeline* pipeline;
 };
 
 struct LvnBuffer
@@ -736,15 +1242,28 @@ struct LvnBuffer
     LvnBufferUsage usage;
     uint32_t id;
     uint64_t size;
+    uint64_t regionSize; // size of each frame in flight region for ring buffers, zero otherwise
+    uint64_t baseOffset; // offset of the buffer within the pool block it was sub-allocated from, zero for buffers with their own allocation
 
     void* buffer;
     void* bufferMemory;
     void* bufferMap;
+    void* stagingBuffer;
+    void* stagingMemory;
+    void* poolBlock; // block of a sub-allocated buffer, null for buffers with their own allocation
+    void* poolAllocation; // range of the pool block used by the buffer
+
+    void* mappedData; // region returned by bufferMap, null while the buffer is not mapped
+    uint64_t dirtyBegin; // coalesced range written since bufferMap that has not been flushed yet, empty when dirtyBegin equals dirtyEnd
+    uint64_t dirtyEnd;
 };
 
 struct LvnSampler
 {
     void* sampler;
+
+    uint64_t key;      // filters and wrap modes packed together, equal create infos share one sampler
+    uint32_t refCount; // destroyed once every reference is destroyed
 };
 
 struct LvnTexture
@@ -755,14 +1274,28 @@ struct LvnTexture
     void* sampler;
 
     uint32_t width, height;
+    uint32_t channels;
+    uint32_t mipLevels;
     uint32_t id;
 
+    LvnTextureCompression compression;
     bool seperateSampler;
 };
 
 struct LvnFrameBuffer
 {
     void* frameBufferData;
+
+    uint32_t width, height;             // full size of the attachments
+    uint32_t renderWidth, renderHeight; // sub rectangle at the origin passes render into, width and height scaled by renderScale
+    float renderScale;
+};
+
+// file a framebuffer capture is written to once its readback arrives
+struct LvnFrameCapture
+{
+    LvnString filename;
+    int jpgQuality; // png when 0
 };
 
 struct LvnCubemap
@@ -770,6 +1303,137 @@ struct LvnCubemap
     LvnTexture textureData;
 };
 
+struct LvnEnvironmentMap
+{
+    LvnTexture cubemap;
+    LvnTexture irradiance;
+    LvnTexture prefilter;
+    LvnTexture brdfLut;
+};
+
+// cluster buffers start with this header, followed by an (offset, count) pair per cluster and the light index list
+struct LvnLightClustersHeader
+{
+    uint32_t tilesX, tilesY, slices, indexCount;
+    float zNear, zFar, sliceScale, sliceBias; // slice = log(depth) * sliceScale + sliceBias
+    float projX, projY, reserved[2];          // view space xy over depth is scaled by these into ndc
+};
+
+struct LvnLightClusterRange
+{
+    uint32_t x0, x1, y0, y1, z0, z1; // inclusive cluster ranges covered by a light
+};
+
+struct LvnLightClusters
+{
+    LvnBuffer* buffer;
+    uint32_t tilesX, tilesY, slices;
+    uint32_t maxLightIndices;
+
+    LvnVector<LvnLightClusterRange> ranges; // scratch of lightClustersUpdate
+    LvnVector<uint32_t> counts;
+};
+
+struct LvnShadowCache
+{
+    LvnFrameBuffer* staticFrameBuffer;  // casters that do not move, only redrawn when invalidated or the light matrix changes
+    LvnFrameBuffer* dynamicFrameBuffer; // casters that move, redrawn every frame
+    LvnMat4 lightMatrix;
+    bool valid;
+};
+
+// entry of the material storage buffer, matches LvnMaterialGpu in the shader source of materialTableGetShaderSource
+struct LvnMaterialTableEntry
+{
+    LvnVec4 baseColorMetallic;  // base color factor and metallic factor
+    LvnVec4 emissiveRoughness;  // emissive factor and roughness factor
+    uint32_t textures[4];       // albedo, metallic roughness occlusion, normal and emissive indices into the texture array
+};
+
+struct LvnMaterialTable
+{
+    LvnDescriptorLayout* descriptorLayout;
+    LvnDescriptorSet* descriptorSet;
+    LvnBuffer* buffer;
+    LvnTexture* defaultTexture;                        // white texture at index 0 used by materials without a texture and the unused slots of the array
+    uint32_t maxMaterials, maxTextures;
+
+    LvnVector<LvnMaterialTableEntry> materials;
+    LvnVector<LvnTexture*> textures;
+    LvnFlatHashMap<uint64_t, uint32_t> textureIndices; // address of a texture to its index in textures
+    LvnString shaderSrc;
+    bool materialsDirty, texturesDirty;
+};
+
+// -- [SUBSECT]: Render Graph
+// ------------------------------------------------------------
+
+enum LvnRenderGraphResourceType
+{
+    Lvn_RenderGraphResourceType_FrameBuffer,
+    Lvn_RenderGraphResourceType_TransientFrameBuffer,
+    Lvn_RenderGraphResourceType_Buffer,
+    Lvn_RenderGraphResourceType_Window,
+};
+
+struct LvnRenderGraphResourceData
+{
+    LvnRenderGraphResourceType type;
+    LvnFrameBuffer* frameBuffer;                                      // imported framebuffer, or the framebuffer a transient resource is aliased to once compiled
+    LvnBuffer* buffer;
+
+    // create info of transient framebuffers, attachments are copied so the caller's arrays do not need to outlive the graph
+    LvnFrameBufferCreateInfo frameBufferCreateInfo;
+    LvnVector<LvnFrameBufferColorAttachment> colorAttachments;
+    LvnFrameBufferDepthAttachment depthAttachment;
+};
+
+struct LvnRenderGraphPass
+{
+    LvnString name;
+    LvnRenderGraphResource target;
+    LvnVector<LvnRenderGraphAccess> reads;
+    LvnVector<LvnRenderGraphResource> writes;
+    LvnVec4 clearColor;
+    bool keepAlive;
+    void (*execute)(LvnRenderGraph*, LvnWindow*, void*);
+    void* userData;
+
+    LvnMemoryBarrierFlagBits barriers;                                // barriers recorded before the pass begins, planned when compiling
+};
+
+struct LvnRenderGraph
+{
+    LvnVector<LvnRenderGraphResourceData> resources;
+    LvnVector<LvnRenderGraphPass> passes;
+    LvnVector<uint32_t> executionOrder;                               // indices of the passes left after culling
+    LvnVector<LvnFrameBuffer*> transientFrameBuffers;                 // framebuffers created for transient resources, shared by resources that alias each other
+    bool compiled;
+};
+
+// baked environment map texels are rgba16f, stored in this order: cubemap base level, irradiance, each prefilter level (six faces each), then the brdf lut
+struct LvnEnvironmentMapBakeInfo
+{
+    const void* pixels;                     // equirectangular hdr image, rgba for float and half images, nullptr when uploading pBakedData
+    uint32_t width, height;
+    LvnHdrImageFormat format;               // texel format of pixels
+
+    uint32_t cubemapSize;
+    uint32_t irradianceSize;
+    uint32_t prefilterSize;
+    uint32_t prefilterMipLevels;
+    uint32_t brdfLutSize;
+    bool cubemapOnly;                       // only create the environment cubemap, used by createCubemap
+
+    const uint8_t* pBakedData;              // texels of a previous bake to upload instead of baking
+    LvnVector<uint8_t>* pBakedDataOut;      // receives the baked texels when not nullptr
+
+    const char* equirectToCubemapSrc;       // compute shader sources, shared by every backend
+    const char* irradianceSrc;
+    const char* prefilterSrc;
+    const char* brdfLutSrc;
+};
+
 
 // ------------------------------------------------------------
 // [SECTION]: Context Internal Structs
@@ -790,16 +1454,118 @@ struct LvnObjectMemAllocCount
     struct LvnStructCounts
     {
         LvnStructureType sType;
-        size_t count;
+        std::atomic<size_t> count;
+        std::atomic<size_t> peak; // most objects alive at once, written to the pool config file
     };
 
-    LvnVector<LvnStructCounts> sTypes;
+    LvnStructCounts sTypes[Lvn_Stype_Max_Value];
+};
+
+
+// -- [SUBSECT]: Job System Structures
+// ------------------------------------------------------------
+
+struct LvnJob
+{
+    LvnJobFunc func;
+    void* userData;
+    LvnJobCounter* counter;     // decremented once the job has run, can be nullptr
+    LvnJobCounter* dependency;  // the job waits in the context until this reaches zero, can be nullptr
+};
+
+// work-stealing queue of one worker, the worker pushes and pops its newest jobs at the back while other threads steal the oldest from the front
+struct LvnJobQueue
+{
+    LvnSpinLock lock;
+    LvnQueue<LvnJob> jobs;
+    uint32_t index;
+};
+
+struct LvnParallelForRange
+{
+    LvnParallelForFunc func;
+    void* userData;
+    uint32_t start, end;
+};
+
+
+// -- [SUBSECT]: IO Structures
+// ------------------------------------------------------------
+
+enum LvnIoRequestType
+{
+    Lvn_IoRequest_Read,
+    Lvn_IoRequest_ReadChunks,
+    Lvn_IoRequest_Write,
+    Lvn_IoRequest_WriteStream,  // write to an open stream (eg. a log file)
+    Lvn_IoRequest_CloseStream,
+};
+
+// pack file layout: header, file data at alignment boundaries, entry table sorted by path hash, path strings
+#define LVN_PACK_MAGIC 0x4b50564c // "LVPK"
+#define LVN_PACK_VERSION 1
+#define LVN_PACK_ALIGNMENT 64
+
+struct LvnPackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t alignment;
+    uint64_t entriesOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+struct LvnPackEntry
+{
+    uint64_t pathHash;
+    uint64_t dataOffset;
+    uint64_t size;              // size of the file once decompressed
+    uint64_t storedSize;        // size of the data in the pack
+    uint32_t pathOffset;        // into the string table
+    uint32_t pathLength;
+    uint32_t compression;       // LvnPackCompression
+    uint32_t reserved;
+};
+
+struct LvnPack
+{
+    LvnString filepath;
+    LvnBin file;                // mapped pack file
+    const LvnPackEntry* entries;
+    const char* strings;
+    uint32_t entryCount;
+};
+
+struct LvnIoRequest
+{
+    LvnIoRequestType type;
+    LvnString filepath;
+    FILE* file;                 // open stream of chunked reads and stream requests
+    LvnBin data;                // bytes to write
+    LvnFileMode mode;
+    uint64_t chunkSize;
+    LvnFileReadFunc readFunc;
+    LvnFileChunkFunc chunkFunc;
+    LvnFileWriteFunc writeFunc;
+    void* userData;
+    LvnJobCounter* counter;     // decremented once the request has completed, can be nullptr
+};
+
+struct LvnSoundVoice
+{
+    LvnSound* sound;
+    float gain;                 // estimated gain at the listener, ranks voices of the same priority
 };
 
 
 // -- [SUBSECT]: Context Structure
 // ------------------------------------------------------------
 
+struct LvnObjectCache;
+struct LvnSoundStream;
+
 struct LvnContext
 {
     // api specification
@@ -808,6 +1574,26 @@ struct LvnContext
     LvnGraphicsApi                       graphicsapi;
     LvnGraphicsContext                   graphicsContext;
     void*                                audioEngineContextPtr;
+    void*                                audioDeviceContextPtr; // ma_context of the audio device
+    void*                                audioDevicePtr;    // ma_device the engine mixes into
+    LvnVector<LvnSoundStream*>           soundStreams;      // streamed sounds decoded ahead by the stream thread, guarded by soundStreamMutex
+    LvnThread*                           soundStreamThread; // started by the first streamed sound
+    std::mutex                           soundStreamMutex;
+    std::condition_variable              soundStreamCondition; // wakes the stream thread early after a sound is created or seeked
+    bool                                 soundStreamStop;   // guarded by soundStreamMutex
+    LvnVector<LvnSound*>                 sounds;            // every created sound, ranked for the mixer by audioUpdateVoices, guarded by soundsMutex
+    LvnVector<LvnSoundVoice>             soundVoices;       // ranking scratch of audioUpdateVoices, guarded by soundsMutex
+    LvnMutex                             soundsMutex;
+    uint32_t                             soundMaxVoices;    // sounds mixed at once, 0 mixes every audible sound
+    uint32_t                             soundMixedVoiceCount; // counts of the last audioUpdateVoices, guarded by soundsMutex
+    uint32_t                             soundVirtualVoiceCount;
+    LvnSubsystemInit                     audioInit;
+    decltype(LvnContextCreateInfo::audio) audioConfig;      // device settings of the create info, kept for audio brought up on first use
+    std::once_flag                       audioInitFlag;
+    LvnResult                            audioInitResult;   // result of the audio initialization, set once audioInitFlag has run
+    LvnSubsystemInit                     networkingInit;
+    std::once_flag                       networkingInitFlag;
+    LvnResult                            networkingInitResult;
     LvnClipRegion                        matrixClipRegion;
     LvnString                            appName;
     LvnPipelineSpecification             defaultPipelineSpecification;
@@ -819,20 +1605,105 @@ struct LvnContext
     LvnLogger                            coreLogger;
     LvnLogger                            clientLogger;
     LvnVector<LvnLogPattern>             userLogPatterns;
+    LvnMpmcQueue<LvnLogRecord>*          logQueue;          // nullptr unless async logging is enabled, messages are written inline then
+    LvnThread*                           logThread;
+    std::atomic<uint64_t>                logPushed;         // records pushed to the queue
+    uint64_t                             logWritten;        // records written by the log thread, guarded by logMutex
+    std::mutex                           logMutex;
+    std::condition_variable              logCondition;      // wakes the log thread and signals written records to lvn::logFlush
+    bool                                 logStop;           // guarded by logMutex
+    LvnVector<LvnLogger*>                binaryLoggers;     // loggers with a binary log file, flushed by lvn::logFlush and closed with the context
+    LvnVector<LvnLogger*>                bufferedLoggers;   // loggers with a buffered log file, flushed by lvn::logFlush and the log thread, guarded by logMutex
+
+    // profiling
+    LvnVector<LvnProfileThread*>         profileThreads;    // every thread that recorded a zone or was named, guarded by profileMutex
+    LvnMutex                             profileMutex;
+    uint32_t                             profileCapacity;   // zones per thread, power of two
+    uint64_t                             profileStart;      // ticks at context creation, traces start here
+
+    // string atoms, the views point into atomStrings so they stay valid while the table grows
+    LvnFlatHashMap<LvnStringView, LvnAtom, LvnStringHash, LvnStringEqual> atomIndices;
+    LvnVector<LvnAtomEntry>              atoms;             // indexed by atom, entry 0 is the empty string
+    LvnArena                             atomStrings;
+    LvnSharedMutex                       atomMutex;
 
     // memory pools and bindings
     LvnMemAllocMode                      memoryMode;
     LvnMemoryPool                        memoryPool;
     LvnVector<LvnStructureTypeInfo>      sTypeMemAllocInfos;
     LvnVector<LvnStructureTypeInfo>      blockMemAllocInfos;
+    size_t                               trimHighWatermark;
+    size_t                               trimLowWatermark;
+    LvnString                            poolConfigPath; // peak object counts are written here at terminateContext, empty when not used
 
     // memory object allocations
-    size_t                               numMemoryAllocations;
+    std::atomic<size_t>                  numMemoryAllocations; // audio may be brought up on its own thread while createContext runs
     size_t                               numClassObjectAllocations;
     LvnObjectMemAllocCount               objectMemoryAllocations;
+    LvnMutex                             objectMutex; // guards new memory blocks and bindings, freed objects are reused through the lock-free free lists
+    uint64_t                             contextId;   // never reused, lets per thread object caches notice a new context
+    LvnVector<LvnObjectCache*>           objectCaches; // caches of every thread that used the pool, guarded by objectMutex so memPoolTrim can flush them
+
+    // pipelines shared between equal create infos
+    LvnVector<LvnPipelineCacheEntry>     pipelineCache;
+    LvnMutex                             pipelineCacheMutex;
+
+    // samplers shared between equal create infos
+    LvnVector<LvnSampler*>               samplerCache;
+    LvnMutex                             samplerCacheMutex;
+
+    // hot reload, watched files are checked by hotReloadUpdate, guarded by hotReloadMutex
+    bool                                 hotReloadEnabled;  // shaders created from files are watched, rendering.enableHotReload
+    LvnVector<LvnHotReloadFile>          hotReloadFiles;
+    LvnVector<LvnHotReloadShader>        hotReloadShaders;
+    LvnVector<LvnHotReloadPipeline>      hotReloadPipelines;
+    LvnVector<LvnHotReloadModel>         hotReloadModels;
+    void*                                hotReloadWatcher;  // platform directory watcher, created with the first watched file
+    LvnMutex                             hotReloadMutex;
+
+    // background pipeline compilation, workers are started by the first createPipelineAsync call
+    LvnVector<LvnPipelineCompileJob*>    pipelineCompileJobs;
+    LvnVector<LvnThread*>                pipelineCompileThreads;
+    std::mutex                           pipelineCompileMutex;
+    std::condition_variable              pipelineCompileCondition;
+    bool                                 pipelineCompileStop;
+
+    // job system, workers are started by createContext when multithreading is enabled
+    LvnVector<LvnJobQueue*>              jobQueues;         // one per worker, jobs submitted from other threads are spread over them
+    LvnVector<LvnThread*>                jobThreads;
+    LvnVector<LvnJob>                    jobsWaiting;       // jobs whose dependency has not reached zero yet
+    LvnMutex                             jobWaitingMutex;
+    std::mutex                           jobSleepMutex;
+    std::condition_variable              jobSleepCondition;
+    std::atomic<uint32_t>                jobQueuedCount;    // jobs sitting in the queues, idle workers sleep while there are none
+    std::atomic<uint32_t>                jobSubmitIndex;
+    bool                                 jobStop;           // guarded by jobSleepMutex
+
+    // file io, one thread runs requests in submit order so blocking reads and writes stay off the calling thread
+    LvnThread*                           ioThread;          // nullptr when multithreading is disabled, requests run inline then
+    LvnQueue<LvnIoRequest>               ioRequests;
+    std::mutex                           ioMutex;
+    std::condition_variable              ioCondition;       // signals new requests to the io thread and completed requests to fileWaitIdle
+    bool                                 ioBusy;            // io thread is running a request, guarded by ioMutex
+    bool                                 ioStop;            // guarded by ioMutex
+
+    // frame stats, counted by the render command dispatchers and rolled over by renderBeginNextFrame
+    std::atomic<uint64_t>                frameStatCounters[Lvn_FrameStat_Max_Value]; // counts of the current frame, buffers may be updated from any thread
+    LvnFrameStats                        frameStatsHistory[LVN_FRAME_STATS_HISTORY]; // ring of completed frames, guarded by frameStatsLock
+    uint64_t                             frameStatsCount;   // frames completed, guarded by frameStatsLock
+    LvnSpinLock                          frameStatsLock;
+    LvnWindow*                           frameStatsWindow;  // window whose renderBeginNextFrame ends the frame, the first window that began a frame
+    uint64_t                             frameStatsBeginTicks; // lvn::profileGetTicks at the start of the current frame, 0 before the first frame
+    LvnFrameStats                        frameStatsBudget;
+    bool                                 frameStatsHasBudget;
+    uint64_t                             frameStatsOverBudget; // frames over the budget since it was set, guarded by frameStatsLock
+
+    // mounted packs of the virtual file system, searched from the last mounted
+    LvnVector<LvnPack*>                  packs;
+    LvnSharedMutex                       packMutex;
 
     // misc
-    LvnTimer                             contexTime;       // timer
+    uint64_t                             contextStartTime; // lvn::getMonotonicTimeNs at context creation
     LvnData<uint32_t>                    defaultCodePoints;
 
 };
@@ -868,6 +1739,32 @@ namespace lvn
         for (size_t i = 0; i < N; i++)
             lvn::swap(arg1[i], arg2[i]);
     }
+
+    inline uint64_t hdrImageGetTexelSize(LvnHdrImageFormat format, uint32_t channels)
+    {
+        switch (format)
+        {
+            case Lvn_HdrImageFormat_Half: { return 4 * sizeof(uint16_t); }
+            case Lvn_HdrImageFormat_Rgb9e5: { return sizeof(uint32_t); }
+            default: { return channels * sizeof(float); }
+        }
+    }
+
+    inline uint64_t environmentMapGetBakedSize(const LvnEnvironmentMapBakeInfo* bakeInfo)
+    {
+        const uint64_t texelSize = 4 * sizeof(uint16_t);
+
+        uint64_t size = 6 * (uint64_t)bakeInfo->cubemapSize * bakeInfo->cubemapSize;
+        size += 6 * (uint64_t)bakeInfo->irradianceSize * bakeInfo->irradianceSize;
+        for (uint32_t i = 0; i < bakeInfo->prefilterMipLevels; i++)
+        {
+            uint64_t mipSize = bakeInfo->prefilterSize >> i ? bakeInfo->prefilterSize >> i : 1;
+            size += 6 * mipSize * mipSize;
+        }
+        size += (uint64_t)bakeInfo->brdfLutSize * bakeInfo->brdfLutSize;
+
+        return size * texelSize;
+    }
 }
 
 #endif
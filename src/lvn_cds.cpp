@@ -8,13 +8,37 @@
 // [SECTION]: Multithreading Structures
 // -- [SUBSECT]: LvnThread
 // -- [SUBSECT]: LvnMutex
+// -- [SUBSECT]: LvnSpinLock
+// -- [SUBSECT]: LvnSharedMutex
+// -- [SUBSECT]: LvnCondVar
 // [SECTION]: Internal Data Structures
+// -- [SUBSECT]: LvnArena
 // -- [SUBSECT]: LvnString
 // -- [SUBSECT]: LvnDrawList
+// -- [SUBSECT]: LvnBitWriter, LvnBitReader
+// [SECTION]: Spatial Structures
+// -- [SUBSECT]: LvnBvh
+// -- [SUBSECT]: LvnLooseGrid2D
 
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cfloat>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+    #define LVN_CPU_PAUSE() _mm_pause()
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define LVN_SIMD_SSE2
+    #endif
+#elif defined(__aarch64__) || defined(__arm__)
+    #define LVN_CPU_PAUSE() __asm__ __volatile__("yield")
+#else
+    #define LVN_CPU_PAUSE() ((void)0)
+#endif
 
 // ------------------------------------------------------------
 // [SECTION]: Timing Structures (chrono)
@@ -133,61 +157,495 @@ void LvnMutex::unlock()
     mutex->unlock();
 }
 
+// -- [SUBSECT]: LvnSpinLock
+// ------------------------------------------------------------
+
+void LvnSpinLock::wait_unlocked()
+{
+    // spin on a load so waiting threads do not keep pulling the cache line away from the owner, yield once the wait gets long
+    for (uint32_t spins = 0; m_Locked.load(std::memory_order_relaxed); spins++)
+    {
+        if (spins < 64)
+            LVN_CPU_PAUSE();
+        else
+            std::this_thread::yield();
+    }
+}
+
+// -- [SUBSECT]: LvnSharedMutex
+// ------------------------------------------------------------
+
+LvnSharedMutex::LvnSharedMutex()
+{
+    static_assert(sizeof(std::shared_mutex) <= m_SharedMutexBuffSize, "shared mutex storage too small");
+    static_assert(alignof(std::shared_mutex) <= alignof(max_align_t), "shared mutex alignment too strict");
+    new (m_SharedMutexBuff) std::shared_mutex();
+}
+LvnSharedMutex::~LvnSharedMutex()
+{
+    std::shared_mutex* mutex = reinterpret_cast<std::shared_mutex*>(m_SharedMutexBuff);
+    mutex->~shared_mutex();
+}
+void LvnSharedMutex::lock()
+{
+    std::shared_mutex* mutex = reinterpret_cast<std::shared_mutex*>(m_SharedMutexBuff);
+    mutex->lock();
+}
+bool LvnSharedMutex::try_lock()
+{
+    std::shared_mutex* mutex = reinterpret_cast<std::shared_mutex*>(m_SharedMutexBuff);
+    return mutex->try_lock();
+}
+void LvnSharedMutex::unlock()
+{
+    std::shared_mutex* mutex = reinterpret_cast<std::shared_mutex*>(m_SharedMutexBuff);
+    mutex->unlock();
+}
+void LvnSharedMutex::lock_shared()
+{
+    std::shared_mutex* mutex = reinterpret_cast<std::shared_mutex*>(m_SharedMutexBuff);
+    mutex->lock_shared();
+}
+bool LvnSharedMutex::try_lock_shared()
+{
+    std::shared_mutex* mutex = reinterpret_cast<std::shared_mutex*>(m_SharedMutexBuff);
+    return mutex->try_lock_shared();
+}
+void LvnSharedMutex::unlock_shared()
+{
+    std::shared_mutex* mutex = reinterpret_cast<std::shared_mutex*>(m_SharedMutexBuff);
+    mutex->unlock_shared();
+}
+
+// -- [SUBSECT]: LvnCondVar
+// ------------------------------------------------------------
+
+LvnCondVar::LvnCondVar()
+{
+    static_assert(sizeof(std::condition_variable_any) <= m_CondVarBuffSize, "condition variable storage too small");
+    static_assert(alignof(std::condition_variable_any) <= alignof(max_align_t), "condition variable alignment too strict");
+    new (m_CondVarBuff) std::condition_variable_any();
+}
+LvnCondVar::~LvnCondVar()
+{
+    std::condition_variable_any* condVar = reinterpret_cast<std::condition_variable_any*>(m_CondVarBuff);
+    condVar->~condition_variable_any();
+}
+void LvnCondVar::wait(LvnMutex& mutex)
+{
+    std::condition_variable_any* condVar = reinterpret_cast<std::condition_variable_any*>(m_CondVarBuff);
+    condVar->wait(mutex);
+}
+bool LvnCondVar::wait_for(LvnMutex& mutex, uint64_t milliseconds)
+{
+    std::condition_variable_any* condVar = reinterpret_cast<std::condition_variable_any*>(m_CondVarBuff);
+    return condVar->wait_for(mutex, std::chrono::milliseconds(milliseconds)) == std::cv_status::no_timeout;
+}
+void LvnCondVar::notify_one()
+{
+    std::condition_variable_any* condVar = reinterpret_cast<std::condition_variable_any*>(m_CondVarBuff);
+    condVar->notify_one();
+}
+void LvnCondVar::notify_all()
+{
+    std::condition_variable_any* condVar = reinterpret_cast<std::condition_variable_any*>(m_CondVarBuff);
+    condVar->notify_all();
+}
+
 
 // ------------------------------------------------------------
 // [SECTION]: Internal Data Structures
 // ------------------------------------------------------------
 
 
+// -- [SUBSECT]: LvnArena
+// ------------------------------------------------------------
+
+LvnArena::LvnArena()
+    : m_First(nullptr), m_Current(nullptr), m_Last(nullptr), m_BlockSize(DefaultBlockSize)
+{
+    m_Allocator = { LvnArena::allocator_alloc, nullptr, LvnArena::allocator_realloc, this };
+}
+LvnArena::LvnArena(size_t blockSize)
+    : m_First(nullptr), m_Current(nullptr), m_Last(nullptr), m_BlockSize(blockSize ? blockSize : DefaultBlockSize)
+{
+    m_Allocator = { LvnArena::allocator_alloc, nullptr, LvnArena::allocator_realloc, this };
+}
+LvnArena::~LvnArena()
+{
+    clear_free();
+}
+
+void* LvnArena::allocator_alloc(size_t size, size_t align, void* userData)
+{
+    return static_cast<LvnArena*>(userData)->alloc(size, align);
+}
+void* LvnArena::allocator_realloc(void* ptr, size_t oldSize, size_t newSize, size_t align, void* userData)
+{
+    return static_cast<LvnArena*>(userData)->realloc(ptr, oldSize, newSize, align);
+}
+
+void* LvnArena::alloc_slow(size_t size, size_t align)
+{
+    // blocks after the current one are empty and reused first, a new block is only allocated when none of them fit
+    Block* tail = m_Current;
+    for (Block* block = m_Current ? m_Current->next : m_First; block; block = block->next)
+    {
+        size_t offset = align_offset(block, align);
+        if (offset + size <= block->size)
+        {
+            block->used = offset + size;
+            m_Current = block;
+            m_Last = reinterpret_cast<uint8_t*>(block + 1) + offset;
+            return m_Last;
+        }
+        tail = block;
+    }
+
+    // allocations larger than the block size get a block of their own
+    size_t dataSize = lvn::max(m_BlockSize, size + align);
+    Block* block = static_cast<Block*>(lvn::memAlloc(sizeof(Block) + dataSize));
+    block->next = nullptr;
+    block->size = dataSize;
+    block->used = 0;
+
+    if (tail)
+        tail->next = block;
+    else
+        m_First = block;
+
+    size_t offset = align_offset(block, align);
+    block->used = offset + size;
+    m_Current = block;
+    m_Last = reinterpret_cast<uint8_t*>(block + 1) + offset;
+    return m_Last;
+}
+
+void* LvnArena::realloc(void* ptr, size_t oldSize, size_t newSize, size_t align)
+{
+    if (!ptr) { return alloc(newSize, align); }
+    if (newSize <= oldSize) { return ptr; }
+
+    // the last allocation can grow in place while there is room left in its block
+    if (ptr == m_Last)
+    {
+        size_t offset = static_cast<uint8_t*>(ptr) - reinterpret_cast<uint8_t*>(m_Current + 1);
+        if (offset + newSize <= m_Current->size)
+        {
+            m_Current->used = offset + newSize;
+            return ptr;
+        }
+    }
+
+    void* data = alloc(newSize, align);
+    memcpy(data, ptr, oldSize);
+    return data;
+}
+
+LvnArenaMarker LvnArena::marker() const
+{
+    LvnArenaMarker marker{};
+    marker.block = m_Current;
+    marker.used = m_Current ? m_Current->used : 0;
+    return marker;
+}
+
+void LvnArena::rewind(const LvnArenaMarker& marker)
+{
+    if (!marker.block) { reset(); return; }
+
+    Block* current = static_cast<Block*>(marker.block);
+    current->used = marker.used;
+    for (Block* block = current->next; block; block = block->next)
+        block->used = 0;
+
+    m_Current = current;
+    m_Last = nullptr;
+}
+
+void LvnArena::reset()
+{
+    for (Block* block = m_First; block; block = block->next)
+        block->used = 0;
+
+    m_Current = m_First;
+    m_Last = nullptr;
+}
+
+void LvnArena::clear_free()
+{
+    Block* block = m_First;
+    while (block)
+    {
+        Block* next = block->next;
+        lvn::memFree(block);
+        block = next;
+    }
+
+    m_First = m_Current = nullptr;
+    m_Last = nullptr;
+}
+
+size_t LvnArena::used() const
+{
+    size_t bytes = 0;
+    for (const Block* block = m_First; block; block = block->next)
+    {
+        bytes += block->used;
+        if (block == m_Current) break;
+    }
+    return bytes;
+}
+
+size_t LvnArena::capacity() const
+{
+    size_t bytes = 0;
+    for (const Block* block = m_First; block; block = block->next)
+        bytes += block->size;
+    return bytes;
+}
+
+
 // -- [SUBSECT]: LvnString
 // ------------------------------------------------------------
 
+// 256 bit membership table of the bytes of a character set, built once per call so matching a byte is a single lookup
+struct LvnStringCharSet
+{
+    uint64_t bits[4];
+
+    LvnStringCharSet(const char* str, size_t length)
+        : bits{ 0, 0, 0, 0 }
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            uint8_t ch = static_cast<uint8_t>(str[i]);
+            bits[ch >> 6] |= 1ull << (ch & 63);
+        }
+    }
+
+    bool contains(char ch) const
+    {
+        uint8_t byte = static_cast<uint8_t>(ch);
+        return (bits[byte >> 6] >> (byte & 63)) & 1;
+    }
+};
+
+static size_t stringFindLastByte(const char* data, size_t size, char ch)
+{
+#if defined(LVN_SIMD_SSE2)
+    const __m128i needle = _mm_set1_epi8(ch);
+    while (size >= 16)
+    {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + size - 16)), needle));
+        if (mask != 0)
+        {
+            for (int bit = 15; bit >= 0; bit--)
+                if (mask & (1 << bit)) { return size - 16 + bit; }
+        }
+        size -= 16;
+    }
+#endif
+
+    while (size > 0)
+    {
+        if (data[--size] == ch)
+            return size;
+    }
+
+    return LvnString::npos;
+}
+
+// two way string matching (crochemore and perrin), linear in the haystack with constant extra memory, the last byte of each window is
+// checked against the needle's bytes first so most windows are skipped without comparing
+static size_t stringFindTwoWay(const uint8_t* haystack, size_t haystackSize, const uint8_t* needle, size_t needleSize)
+{
+    uint64_t byteset[4] = { 0, 0, 0, 0 };
+    size_t shift[256];
+    for (size_t i = 0; i < needleSize; i++)
+    {
+        byteset[needle[i] >> 6] |= 1ull << (needle[i] & 63);
+        shift[needle[i]] = i + 1;
+    }
+
+    // critical factorization from the maximal suffixes under both byte orderings
+    size_t suffix = 0, period = 0;
+    for (int order = 0; order < 2; order++)
+    {
+        size_t ip = static_cast<size_t>(-1), jp = 0, k = 1, p = 1;
+        while (jp + k < needleSize)
+        {
+            uint8_t a = needle[ip + k], b = needle[jp + k];
+            if (a == b)
+            {
+                if (k == p) { jp += p; k = 1; }
+                else { k++; }
+            }
+            else if (order == 0 ? a > b : a < b)
+            {
+                jp += k;
+                k = 1;
+                p = jp - ip;
+            }
+            else
+            {
+                ip = jp++;
+                k = p = 1;
+            }
+        }
+
+        if (order == 0 || ip + 1 > suffix + 1)
+        {
+            suffix = ip;
+            period = p;
+        }
+    }
+
+    // a needle that is not periodic shifts by the longer half, a periodic one remembers how much of the window already matched
+    size_t memoryReset;
+    if (memcmp(needle, needle + period, suffix + 1) != 0)
+    {
+        memoryReset = 0;
+        period = lvn::max(suffix, needleSize - suffix - 1) + 1;
+    }
+    else
+    {
+        memoryReset = needleSize - period;
+    }
+
+    size_t memory = 0;
+    size_t pos = 0;
+    while (haystackSize - pos >= needleSize)
+    {
+        const uint8_t* window = haystack + pos;
+        uint8_t last = window[needleSize - 1];
+
+        if (!((byteset[last >> 6] >> (last & 63)) & 1))
+        {
+            pos += needleSize;
+            memory = 0;
+            continue;
+        }
+
+        size_t k = needleSize - shift[last];
+        if (k != 0)
+        {
+            pos += lvn::max(k, memory);
+            memory = 0;
+            continue;
+        }
+
+        // right half first, then the left half down to what a previous window already matched
+        for (k = lvn::max(suffix + 1, memory); k < needleSize && needle[k] == window[k]; k++);
+        if (k < needleSize)
+        {
+            pos += k - suffix;
+            memory = 0;
+            continue;
+        }
+
+        for (k = suffix + 1; k > memory && needle[k - 1] == window[k - 1]; k--);
+        if (k <= memory)
+            return pos;
+
+        pos += period;
+        memory = memoryReset;
+    }
+
+    return LvnString::npos;
+}
+
 LvnString::LvnString()
+    : m_Data(m_Local), m_Size(0), m_Capacity(LocalCapacity), m_Allocator(nullptr)
 {
-    m_Data = lvn::memNew<char>();
-    m_Data[0] = '\0';
-    m_Size = 0;
-    m_Capacity = 1;
+    m_Local[0] = '\0';
 }
 LvnString::~LvnString()
 {
-    lvn::memDelete<char>(m_Data);
+    deallocate();
     m_Size = m_Capacity = 0;
     m_Data = nullptr;
 }
 LvnString::LvnString(const char* str)
+    : m_Data(m_Local), m_Size(0), m_Capacity(LocalCapacity), m_Allocator(nullptr)
 {
-    m_Size = strlen(str);
-    m_Capacity = m_Size + 1;
-    m_Data = lvn::memNew<char>(m_Capacity);
-    memcpy(m_Data, str, m_Capacity);
+    assign(str, strlen(str));
 }
 LvnString::LvnString(const char* data, size_t size)
+    : m_Data(m_Local), m_Size(0), m_Capacity(LocalCapacity), m_Allocator(nullptr)
 {
-    m_Size = size;
-    m_Capacity = m_Size + 1;
-    m_Data = lvn::memNew<char>(m_Capacity);
-    memcpy(m_Data, data, m_Capacity);
-    m_Data[m_Size] = '\0';
+    assign(data, size);
 }
 LvnString::LvnString(const LvnString& other)
+    : m_Data(m_Local), m_Size(0), m_Capacity(LocalCapacity), m_Allocator(nullptr)
+{
+    assign(other.m_Data, other.m_Size);
+}
+LvnString::LvnString(LvnString&& other)
+    : m_Allocator(other.m_Allocator)
 {
-    m_Size = other.m_Size;
-    m_Capacity = other.m_Capacity;
-    m_Data = lvn::memNew<char>(other.m_Capacity);
-    memcpy(m_Data, other.m_Data, other.m_Capacity);
+    move_from(other);
 }
 LvnString& LvnString::operator=(const LvnString& other)
 {
     if (this == &other) return *this;
-    lvn::memDelete<char>(m_Data);
-    m_Size = other.m_Size;
-    m_Capacity = other.m_Capacity;
-    m_Data = lvn::memNew<char>(other.m_Capacity);
-    memcpy(m_Data, other.m_Data, other.m_Capacity);
+    assign(other.m_Data, other.m_Size);
+    return *this;
+}
+LvnString& LvnString::operator=(LvnString&& other)
+{
+    if (this == &other) return *this;
+    deallocate();
+    move_from(other);
     return *this;
 }
 
+char* LvnString::allocate(size_t size)
+{
+    return lvn::allocatorNew<char>(m_Allocator, size);
+}
+void LvnString::deallocate()
+{
+    if (!is_local())
+        lvn::allocatorDelete<char>(m_Allocator, m_Data);
+}
+void LvnString::assign(const char* data, size_t size)
+{
+    // reuses the current buffer when it is large enough, only grows when the new string does not fit
+    if (size + 1 > m_Capacity)
+    {
+        deallocate();
+        m_Capacity = size + 1;
+        m_Data = allocate(m_Capacity);
+    }
+    if (size != 0)
+        memmove(m_Data, data, size);
+    m_Size = size;
+    m_Data[m_Size] = '\0';
+}
+void LvnString::move_from(LvnString& other)
+{
+    // inline strings are copied, heap strings hand over their buffer
+    if (other.is_local())
+    {
+        m_Data = m_Local;
+        m_Capacity = LocalCapacity;
+        m_Size = other.m_Size;
+        memcpy(m_Local, other.m_Local, other.m_Size + 1);
+    }
+    else
+    {
+        m_Data = other.m_Data;
+        m_Size = other.m_Size;
+        m_Capacity = other.m_Capacity;
+        m_Allocator = other.m_Allocator; // the buffer stays owned by the allocator it came from
+        other.m_Data = other.m_Local;
+        other.m_Capacity = LocalCapacity;
+    }
+    other.m_Size = 0;
+    other.m_Data[0] = '\0';
+}
+
 char& LvnString::operator [](size_t index)
 {
     LVN_CORE_ASSERT(index < length(), "string index out of range");
@@ -251,6 +709,13 @@ void LvnString::operator+=(const char& ch)
 void LvnString::append(const char* str)
 {
     size_t strsize = strlen(str);
+    if (str >= m_Data && str <= m_Data + m_Size) // appending part of itself, the buffer may move when resizing
+    {
+        size_t offset = str - m_Data;
+        resize(m_Size + strsize);
+        memcpy(&m_Data[m_Size - strsize], &m_Data[offset], strsize * sizeof(char));
+        return;
+    }
     resize(m_Size + strsize);
     memcpy(&m_Data[m_Size - strsize], str, strsize * sizeof(char));
 }
@@ -339,15 +804,19 @@ void LvnString::insert_index(size_t index, const char* data, size_t size)
 void LvnString::reserve(size_t size)
 {
     if (size <= m_Capacity) { return; }
-    char* temp = lvn::memNew<char>(size);
-    memcpy(temp, m_Data, m_Size * sizeof(char));
-    lvn::memDelete<char>(m_Data);
+    char* temp = allocate(size);
+    memcpy(temp, m_Data, (m_Size + 1) * sizeof(char));
+    deallocate();
     m_Data = temp;
     m_Capacity = size;
 }
 void LvnString::resize(size_t size)
 {
-    reserve(size + 1);
+    // appending grows the buffer geometrically so building a string char by char is not quadratic
+    if (size + 1 > m_Capacity)
+        reserve(lvn::max(size + 1, m_Capacity * 2));
+    if (size > m_Size)
+        memset(&m_Data[m_Size], 0, size - m_Size);
     m_Size = size;
     m_Data[m_Size] = '\0';
 }
@@ -358,9 +827,27 @@ void LvnString::clear()
 }
 void LvnString::clear_free()
 {
-    lvn::memDelete<char>(m_Data);
-    m_Data = nullptr;
-    m_Size = m_Capacity = 0;
+    deallocate();
+    m_Data = m_Local;
+    m_Data[0] = '\0';
+    m_Size = 0;
+    m_Capacity = LocalCapacity;
+}
+void LvnString::set_allocator(const LvnAllocator* allocator)
+{
+    // a string already on the heap moves its characters so the buffer and its allocator always match
+    if (allocator == m_Allocator) { return; }
+    if (is_local())
+    {
+        m_Allocator = allocator;
+        return;
+    }
+    char* data = m_Data;
+    const LvnAllocator* oldAllocator = m_Allocator;
+    m_Allocator = allocator;
+    m_Data = allocate(m_Capacity);
+    memcpy(m_Data, data, m_Size + 1);
+    lvn::allocatorDelete<char>(oldAllocator, data);
 }
 void LvnString::erase(const char* it)
 {
@@ -373,8 +860,9 @@ void LvnString::erase_index(size_t index)
     LVN_CORE_ASSERT(index < m_Size, "index out of vector size range");
     size_t aftIndex = m_Size - index - 1;
     if (aftIndex != 0)
-        memcpy(&m_Data[index], &m_Data[index + 1], aftIndex * sizeof(char));
+        memmove(&m_Data[index], &m_Data[index + 1], aftIndex * sizeof(char));
     --m_Size;
+    m_Data[m_Size] = '\0';
 }
 void LvnString::push_back(const char& ch)
 {
@@ -402,49 +890,21 @@ size_t LvnString::rfind(const LvnString& other) const
 size_t LvnString::find(const char& ch) const
 {
     if (m_Size == 0) { return LvnString::npos; }
-    for (size_t i = 0; i < m_Size; i++)
-    {
-        if (m_Data[i] == ch)
-            return i;
-    }
-
-    return LvnString::npos;
+    const char* found = static_cast<const char*>(memchr(m_Data, ch, m_Size));
+    return found ? found - m_Data : LvnString::npos;
 }
 size_t LvnString::rfind(const char& ch) const
 {
-    if (m_Size == 0) { return LvnString::npos; }
-    for (size_t i = m_Size - 1; i >= 0; i--)
-    {
-        if (m_Data[i] == ch)
-            return i;
-
-        if (i == 0) break;
-    }
-
-    return LvnString::npos;
+    return stringFindLastByte(m_Data, m_Size, ch);
 }
 size_t LvnString::find(const char* str) const
 {
-    if (!str || str == "\0" || m_Size == 0) { return LvnString::npos; }
+    if (!str || !*str || m_Size == 0) { return LvnString::npos; }
     size_t strsize = strlen(str);
     if (strsize > m_Size) { return LvnString::npos; }
+    if (strsize == 1) { return find(str[0]); }
 
-    for (size_t i = 0; i <= m_Size - strsize; i++)
-    {
-        bool match = true;
-        for (size_t j = 0; j < strsize; j++)
-        {
-            if (m_Data[i + j] != str[j])
-            {
-                match = false;
-                break;
-            }
-        }
-
-        if (match) { return i; }
-    }
-
-    return LvnString::npos;
+    return stringFindTwoWay(reinterpret_cast<const uint8_t*>(m_Data), m_Size, reinterpret_cast<const uint8_t*>(str), strsize);
 }
 size_t LvnString::rfind(const char* str) const
 {
@@ -452,20 +912,14 @@ size_t LvnString::rfind(const char* str) const
     size_t strsize = strlen(str);
     if (strsize > m_Size) { return LvnString::npos; }
 
-    for (size_t i = m_Size - strsize; i >= 0; i--)
+    // candidates are positions of the first byte found backwards from the last place the needle fits
+    size_t end = m_Size - strsize + 1;
+    while (end > 0)
     {
-        bool match = true;
-        for (size_t j = 0; j < strsize; j++)
-        {
-            if (m_Data[i + j] != str[j])
-            {
-                match = false;
-                break;
-            }
-        }
-
-        if (match) { return i; }
-        if (i == 0) break;
+        size_t i = stringFindLastByte(m_Data, end, str[0]);
+        if (i == LvnString::npos) { break; }
+        if (memcmp(m_Data + i + 1, str + 1, strsize - 1) == 0) { return i; }
+        end = i;
     }
 
     return LvnString::npos;
@@ -481,9 +935,8 @@ size_t LvnString::find_first_of(const LvnString& other, size_t index, size_t len
 size_t LvnString::find_first_of(const char& ch, size_t index) const
 {
     LVN_CORE_ASSERT(index < m_Size, "index not within string bounds");
-    for (size_t i = index; i < m_Size; i++)
-        if (m_Data[i] == ch) { return i; }
-    return LvnString::npos;
+    const char* found = static_cast<const char*>(memchr(m_Data + index, ch, m_Size - index));
+    return found ? found - m_Data : LvnString::npos;
 }
 size_t LvnString::find_first_of(const char* str, size_t index) const
 {
@@ -499,14 +952,9 @@ size_t LvnString::find_first_of(const char* str, size_t index, size_t length) co
     size_t strsize = strlen(str) + 1;
     LVN_CORE_ASSERT(length <= strsize, "length not within str size");
 
+    LvnStringCharSet set(str, length);
     for (size_t i = index; i < m_Size; i++)
-    {
-        for (size_t j = 0; j < length; j++)
-        {
-            if (m_Data[i] == str[j])
-                return i;
-        }
-    }
+        if (set.contains(m_Data[i])) { return i; }
 
     return LvnString::npos;
 }
@@ -539,20 +987,9 @@ size_t LvnString::find_first_not_of(const char* str, size_t index, size_t length
     size_t strsize = strlen(str) + 1;
     LVN_CORE_ASSERT(length <= strsize, "length not within str size");
 
+    LvnStringCharSet set(str, length);
     for (size_t i = index; i < m_Size; i++)
-    {
-        bool found = false;
-        for (size_t j = 0; j < length; j++)
-        {
-            if (m_Data[i] == str[j])
-            {
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) { return i; }
-    }
+        if (!set.contains(m_Data[i])) { return i; }
 
     return LvnString::npos;
 }
@@ -567,9 +1004,7 @@ size_t LvnString::find_last_of(const LvnString& other, size_t index, size_t leng
 size_t LvnString::find_last_of(const char& ch, size_t index) const
 {
     LVN_CORE_ASSERT(index < m_Size || index == LvnString::npos, "index not within string bounds");
-    for (size_t i = m_Size - 1; i != LvnString::npos; i--)
-        if (m_Data[i] == ch) { return i; }
-    return LvnString::npos;
+    return stringFindLastByte(m_Data, m_Size, ch);
 }
 size_t LvnString::find_last_of(const char* str, size_t index) const
 {
@@ -585,14 +1020,9 @@ size_t LvnString::find_last_of(const char* str, size_t index, size_t length) con
     size_t strsize = strlen(str) + 1;
     LVN_CORE_ASSERT(length <= strsize, "length not within str size");
 
+    LvnStringCharSet set(str, length);
     for (size_t i = m_Size - 1; i != LvnString::npos; i--)
-    {
-        for (size_t j = 0; j < length; j++)
-        {
-            if (m_Data[i] == str[j])
-                return i;
-        }
-    }
+        if (set.contains(m_Data[i])) { return i; }
 
     return LvnString::npos;
 }
@@ -625,20 +1055,9 @@ size_t LvnString::find_last_not_of(const char* str, size_t index, size_t length)
     size_t strsize = strlen(str) + 1;
     LVN_CORE_ASSERT(length <= strsize, "length not within str size");
 
+    LvnStringCharSet set(str, length);
     for (size_t i = m_Size - 1; i != LvnString::npos; i--)
-    {
-        bool found = false;
-        for (size_t j = 0; j < length; j++)
-        {
-            if (m_Data[i] == str[j])
-            {
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) { return i; }
-    }
+        if (!set.contains(m_Data[i])) { return i; }
 
     return LvnString::npos;
 }
@@ -676,12 +1095,1077 @@ LvnString operator+(const char* str, const LvnString& other)
 // -- [SUBSECT]: LvnDrawList
 // ------------------------------------------------------------
 
-void LvnDrawList::push_back(const LvnDrawCommand& drawCmd)
+struct LvnDrawListShard
+{
+    std::thread::id threadId;
+    LvnVector<uint8_t> verticesRaw;
+    LvnVector<uint32_t> indices;
+    LvnVector<LvnDrawListCommand> commands;
+    size_t vertexCount;
+};
+
+// each thread remembers its shard for the last few draw lists it pushed to, ids are never reused so stale entries never match
+struct LvnDrawListShardCacheEntry
+{
+    uint64_t drawListId;
+    LvnDrawListShard* shard;
+};
+
+static constexpr uint32_t s_DrawListShardCacheSize = 8;
+static thread_local LvnDrawListShardCacheEntry s_DrawListShardCache[s_DrawListShardCacheSize] = {};
+static std::atomic<uint64_t> s_DrawListIdCounter{0};
+
+LvnDrawList::LvnDrawList()
+    : m_VertexCount(0), m_Id(++s_DrawListIdCounter)
+{
+}
+
+LvnDrawList::~LvnDrawList()
+{
+    for (LvnDrawListShard* shard : m_Shards)
+        lvn::memDelete<LvnDrawListShard>(shard);
+}
+
+LvnDrawList::LvnDrawList(const LvnDrawList& other)
+    : m_VerticesRaw(other.m_VerticesRaw), m_Indices(other.m_Indices), m_Commands(other.m_Commands), m_VertexCount(other.m_VertexCount), m_Id(++s_DrawListIdCounter)
+{
+    // shards belong to the threads of the other list, only merged data is copied over
+    for (const LvnDrawListShard* shard : other.m_Shards)
+    {
+        for (LvnDrawListCommand command : shard->commands)
+        {
+            command.firstVertex += m_VertexCount;
+            command.firstIndex += m_Indices.size();
+            m_Commands.push_back(command);
+        }
+
+        m_Indices.insert(m_Indices.end(), shard->indices.begin(), shard->indices.end());
+        for (size_t i = m_Indices.size() - shard->indices.size(); i < m_Indices.size(); i++)
+            m_Indices[i] += m_VertexCount;
+
+        m_VerticesRaw.insert(m_VerticesRaw.end(), shard->verticesRaw.begin(), shard->verticesRaw.end());
+        m_VertexCount += shard->vertexCount;
+    }
+}
+
+LvnDrawList& LvnDrawList::operator=(const LvnDrawList& other)
+{
+    if (this == &other)
+        return *this;
+
+    LvnDrawList copy(other);
+
+    for (LvnDrawListShard* shard : m_Shards)
+        lvn::memDelete<LvnDrawListShard>(shard);
+    m_Shards.clear();
+
+    m_VerticesRaw = copy.m_VerticesRaw;
+    m_Indices = copy.m_Indices;
+    m_Commands = copy.m_Commands;
+    m_VertexCount = copy.m_VertexCount;
+    m_Id = ++s_DrawListIdCounter;
+
+    return *this;
+}
+
+LvnDrawListShard* LvnDrawList::get_shard()
+{
+    LvnDrawListShardCacheEntry& cacheEntry = s_DrawListShardCache[m_Id % s_DrawListShardCacheSize];
+    if (cacheEntry.drawListId == m_Id)
+        return cacheEntry.shard;
+
+    // cache miss, find or register the shard for this thread
+    std::thread::id threadId = std::this_thread::get_id();
+    LvnDrawListShard* shard = nullptr;
+
+    LvnLockGaurd lock(m_ShardMutex);
+    for (LvnDrawListShard* threadShard : m_Shards)
+    {
+        if (threadShard->threadId == threadId)
+        {
+            shard = threadShard;
+            break;
+        }
+    }
+
+    if (!shard)
+    {
+        shard = lvn::memNew<LvnDrawListShard>();
+        shard->threadId = threadId;
+        shard->vertexCount = 0;
+        m_Shards.push_back(shard);
+    }
+
+    cacheEntry.drawListId = m_Id;
+    cacheEntry.shard = shard;
+    return shard;
+}
+
+void LvnDrawList::push_back(const LvnDrawCommand& drawCmd)
+{
+    LvnDrawListShard* shard = get_shard();
+
+    LvnDrawListCommand command{};
+    command.sortKey = drawCmd.sortKey;
+    command.firstVertex = shard->vertexCount;
+    command.vertexCount = drawCmd.vertexCount;
+    command.firstIndex = shard->indices.size();
+    command.indexCount = drawCmd.indexCount;
+    shard->commands.push_back(command);
+
+    // indices stay relative to the shard, they are rebased against the merged vertex count in merge()
+    uint32_t* indices = shard->indices.push_back_uninitialized(drawCmd.indexCount);
+    for (uint64_t i = 0; i < drawCmd.indexCount; i++)
+        indices[i] = drawCmd.pIndices[i] + static_cast<uint32_t>(shard->vertexCount);
+
+    shard->verticesRaw.push_range(static_cast<uint8_t*>(drawCmd.pVertices), drawCmd.vertexCount * drawCmd.vertexStride);
+    shard->vertexCount += drawCmd.vertexCount;
+}
+
+void LvnDrawList::merge()
+{
+    LvnLockGaurd lock(m_ShardMutex);
+
+    size_t vertexSize = m_VerticesRaw.size(), indexCount = m_Indices.size(), commandCount = m_Commands.size();
+    for (const LvnDrawListShard* shard : m_Shards)
+    {
+        vertexSize += shard->verticesRaw.size();
+        indexCount += shard->indices.size();
+        commandCount += shard->commands.size();
+    }
+
+    m_VerticesRaw.reserve(vertexSize);
+    m_Indices.reserve(indexCount);
+    m_Commands.reserve(commandCount);
+
+    // shards are appended in the order threads first pushed to the list, the shard memory is kept for the next frame
+    for (LvnDrawListShard* shard : m_Shards)
+    {
+        if (shard->indices.empty() && shard->verticesRaw.empty())
+            continue;
+
+        for (LvnDrawListCommand command : shard->commands)
+        {
+            command.firstVertex += m_VertexCount;
+            command.firstIndex += m_Indices.size();
+            m_Commands.push_back(command);
+        }
+
+        m_Indices.insert(m_Indices.end(), shard->indices.begin(), shard->indices.end());
+        for (size_t i = m_Indices.size() - shard->indices.size(); i < m_Indices.size(); i++)
+            m_Indices[i] += m_VertexCount;
+
+        m_VerticesRaw.insert(m_VerticesRaw.end(), shard->verticesRaw.begin(), shard->verticesRaw.end());
+        m_VertexCount += shard->vertexCount;
+
+        shard->verticesRaw.clear();
+        shard->indices.clear();
+        shard->commands.clear();
+        shard->vertexCount = 0;
+    }
+}
+
+void LvnDrawList::swap(LvnDrawList& other)
+{
+    if (this == &other)
+        return;
+
+    // the ids move with the shards so the per thread shard caches stay valid for both lists
+    std::swap(m_VerticesRaw, other.m_VerticesRaw);
+    std::swap(m_Indices, other.m_Indices);
+    std::swap(m_Commands, other.m_Commands);
+    std::swap(m_Shards, other.m_Shards);
+    std::swap(m_VertexCount, other.m_VertexCount);
+    std::swap(m_Id, other.m_Id);
+}
+
+void LvnDrawList::clear()
+{
+    m_VerticesRaw.clear();
+    m_Indices.clear();
+    m_Commands.clear();
+    m_VertexCount = 0;
+
+    LvnLockGaurd lock(m_ShardMutex);
+    for (LvnDrawListShard* shard : m_Shards)
+    {
+        shard->verticesRaw.clear();
+        shard->indices.clear();
+        shard->commands.clear();
+        shard->vertexCount = 0;
+    }
+}
+
+
+// -- [SUBSECT]: LvnBitWriter, LvnBitReader
+// ------------------------------------------------------------
+
+static uint32_t bitsRequired(uint32_t range)
+{
+    uint32_t bits = 0;
+    while (range > 0)
+    {
+        bits++;
+        range >>= 1;
+    }
+    return bits;
+}
+
+static uint32_t quantizeFloat(float value, float min, float max, float resolution)
+{
+    value = value < min ? min : (value > max ? max : value);
+    return static_cast<uint32_t>((value - min) / resolution + 0.5f);
+}
+
+static uint32_t quantizeSteps(float min, float max, float resolution)
+{
+    LVN_CORE_ASSERT(max > min && resolution > 0.0f, "quantized float range must have max > min and a positive resolution");
+    return static_cast<uint32_t>((max - min) / resolution + 0.5f);
+}
+
+LvnBitWriter::LvnBitWriter()
+    : m_Scratch(0), m_ScratchBits(0)
+{
+}
+
+void LvnBitWriter::write_bits(uint32_t value, uint32_t bits)
+{
+    LVN_CORE_ASSERT(bits <= 32, "cannot write more than 32 bits at once");
+
+    m_Scratch |= (static_cast<uint64_t>(value) & ((1ull << bits) - 1)) << m_ScratchBits;
+    m_ScratchBits += bits;
+
+    while (m_ScratchBits >= 8)
+    {
+        m_Data.push_back(static_cast<uint8_t>(m_Scratch));
+        m_Scratch >>= 8;
+        m_ScratchBits -= 8;
+    }
+}
+
+void LvnBitWriter::write_bool(bool value)
+{
+    LvnBitWriter::write_bits(value ? 1 : 0, 1);
+}
+
+void LvnBitWriter::write_uint(uint32_t value, uint32_t min, uint32_t max)
+{
+    LVN_CORE_ASSERT(min <= max && value >= min && value <= max, "value is outside of the bounded range");
+    LvnBitWriter::write_bits(value - min, bitsRequired(max - min));
+}
+
+void LvnBitWriter::write_int(int32_t value, int32_t min, int32_t max)
+{
+    LVN_CORE_ASSERT(min <= max && value >= min && value <= max, "value is outside of the bounded range");
+    LvnBitWriter::write_bits(static_cast<uint32_t>(static_cast<int64_t>(value) - min), bitsRequired(static_cast<uint32_t>(static_cast<int64_t>(max) - min)));
+}
+
+void LvnBitWriter::write_varint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        LvnBitWriter::write_bits(static_cast<uint32_t>(value & 0x7f) | 0x80, 8);
+        value >>= 7;
+    }
+    LvnBitWriter::write_bits(static_cast<uint32_t>(value), 8);
+}
+
+void LvnBitWriter::write_svarint(int64_t value)
+{
+    LvnBitWriter::write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void LvnBitWriter::write_float(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(uint32_t));
+    LvnBitWriter::write_bits(bits, 32);
+}
+
+void LvnBitWriter::write_float(float value, float min, float max, float resolution)
+{
+    LvnBitWriter::write_bits(quantizeFloat(value, min, max, resolution), bitsRequired(quantizeSteps(min, max, resolution)));
+}
+
+void LvnBitWriter::write_bytes(const void* data, size_t size)
+{
+    LvnBitWriter::align();
+    m_Data.insert_index(m_Data.size(), static_cast<const uint8_t*>(data), size);
+}
+
+void LvnBitWriter::write_delta_uint(uint32_t value, uint32_t base, uint32_t min, uint32_t max)
+{
+    LvnBitWriter::write_bool(value != base);
+    if (value != base)
+        LvnBitWriter::write_uint(value, min, max);
+}
+
+void LvnBitWriter::write_delta_int(int32_t value, int32_t base, int32_t min, int32_t max)
+{
+    LvnBitWriter::write_bool(value != base);
+    if (value != base)
+        LvnBitWriter::write_int(value, min, max);
+}
+
+void LvnBitWriter::write_delta_float(float value, float base, float min, float max, float resolution)
+{
+    // compared after quantizing so changes smaller than the resolution are not sent
+    const uint32_t quantized = quantizeFloat(value, min, max, resolution);
+    const bool changed = quantized != quantizeFloat(base, min, max, resolution);
+
+    LvnBitWriter::write_bool(changed);
+    if (changed)
+        LvnBitWriter::write_bits(quantized, bitsRequired(quantizeSteps(min, max, resolution)));
+}
+
+void LvnBitWriter::align()
+{
+    if (m_ScratchBits > 0)
+        LvnBitWriter::write_bits(0, 8 - m_ScratchBits);
+}
+
+void LvnBitWriter::clear()
+{
+    m_Data.clear();
+    m_Scratch = 0;
+    m_ScratchBits = 0;
+}
+
+LvnBitReader::LvnBitReader(const uint8_t* data, size_t size)
+    : m_Data(data), m_Size(size), m_BitOffset(0), m_Overflowed(false)
+{
+}
+
+uint32_t LvnBitReader::read_bits(uint32_t bits)
+{
+    LVN_CORE_ASSERT(bits <= 32, "cannot read more than 32 bits at once");
+
+    if (bits > m_Size * 8 - m_BitOffset)
+    {
+        m_Overflowed = true;
+        m_BitOffset = m_Size * 8;
+        return 0;
+    }
+
+    uint64_t value = 0;
+    uint32_t count = 0;
+    while (count < bits)
+    {
+        const uint32_t shift = static_cast<uint32_t>(m_BitOffset & 7);
+        const uint32_t take = (8 - shift) < (bits - count) ? (8 - shift) : (bits - count);
+
+        value |= static_cast<uint64_t>((m_Data[m_BitOffset >> 3] >> shift) & ((1u << take) - 1)) << count;
+        count += take;
+        m_BitOffset += take;
+    }
+
+    return static_cast<uint32_t>(value);
+}
+
+bool LvnBitReader::read_bool()
+{
+    return LvnBitReader::read_bits(1) != 0;
+}
+
+uint32_t LvnBitReader::read_uint(uint32_t min, uint32_t max)
+{
+    uint32_t value = min + LvnBitReader::read_bits(bitsRequired(max - min));
+
+    // corrupt data can hold values past max when the range is not a power of two
+    if (value > max)
+    {
+        m_Overflowed = true;
+        return max;
+    }
+    return value;
+}
+
+int32_t LvnBitReader::read_int(int32_t min, int32_t max)
+{
+    int64_t value = static_cast<int64_t>(min) + LvnBitReader::read_bits(bitsRequired(static_cast<uint32_t>(static_cast<int64_t>(max) - min)));
+
+    if (value > max)
+    {
+        m_Overflowed = true;
+        return max;
+    }
+    return static_cast<int32_t>(value);
+}
+
+uint64_t LvnBitReader::read_varint()
+{
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        uint32_t byte = LvnBitReader::read_bits(8);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+
+    m_Overflowed = true;
+    return value;
+}
+
+int64_t LvnBitReader::read_svarint()
+{
+    uint64_t value = LvnBitReader::read_varint();
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+float LvnBitReader::read_float()
+{
+    uint32_t bits = LvnBitReader::read_bits(32);
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+float LvnBitReader::read_float(float min, float max, float resolution)
+{
+    float value = min + static_cast<float>(LvnBitReader::read_bits(bitsRequired(quantizeSteps(min, max, resolution)))) * resolution;
+    return value > max ? max : value;
+}
+
+void LvnBitReader::read_bytes(void* data, size_t size)
+{
+    LvnBitReader::align();
+
+    if (size > m_Size - (m_BitOffset >> 3))
+    {
+        m_Overflowed = true;
+        m_BitOffset = m_Size * 8;
+        memset(data, 0, size);
+        return;
+    }
+
+    memcpy(data, m_Data + (m_BitOffset >> 3), size);
+    m_BitOffset += size * 8;
+}
+
+uint32_t LvnBitReader::read_delta_uint(uint32_t base, uint32_t min, uint32_t max)
+{
+    return LvnBitReader::read_bool() ? LvnBitReader::read_uint(min, max) : base;
+}
+
+int32_t LvnBitReader::read_delta_int(int32_t base, int32_t min, int32_t max)
+{
+    return LvnBitReader::read_bool() ? LvnBitReader::read_int(min, max) : base;
+}
+
+float LvnBitReader::read_delta_float(float base, float min, float max, float resolution)
+{
+    return LvnBitReader::read_bool() ? LvnBitReader::read_float(min, max, resolution) : base;
+}
+
+void LvnBitReader::align()
+{
+    m_BitOffset = (m_BitOffset + 7) & ~static_cast<size_t>(7);
+    if (m_BitOffset > m_Size * 8)
+        m_BitOffset = m_Size * 8;
+}
+
+
+// ------------------------------------------------------------
+// [SECTION]: Spatial Structures
+// ------------------------------------------------------------
+
+
+// -- [SUBSECT]: LvnBvh
+// ------------------------------------------------------------
+
+static constexpr uint32_t s_BvhBinCount = 12;
+
+struct LvnBvhBin
+{
+    LvnVec3 min, max;
+    uint32_t count;
+};
+
+struct LvnBvhTraversal
+{
+    uint32_t node;
+    float distance;
+};
+
+static LvnVec3 bvhMin(const LvnVec3& a, const LvnVec3& b) { return LvnVec3(lvn::min(a.x, b.x), lvn::min(a.y, b.y), lvn::min(a.z, b.z)); }
+static LvnVec3 bvhMax(const LvnVec3& a, const LvnVec3& b) { return LvnVec3(lvn::max(a.x, b.x), lvn::max(a.y, b.y), lvn::max(a.z, b.z)); }
+
+// half of the surface area, only ratios of areas are compared
+static float bvhArea(const LvnVec3& min, const LvnVec3& max)
+{
+    LvnVec3 d = max - min;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+static uint32_t bvhBinIndex(float centroid, float minCentroid, float scale)
+{
+    uint32_t bin = static_cast<uint32_t>((centroid - minCentroid) * scale);
+    return bin < s_BvhBinCount ? bin : s_BvhBinCount - 1;
+}
+
+static void bvhFitNode(LvnBvhNode* node, const LvnAabb* pBounds)
+{
+    node->min = LvnVec3(FLT_MAX);
+    node->max = LvnVec3(-FLT_MAX);
+    for (uint32_t i = node->first; i < node->first + node->count; i++)
+    {
+        node->min = bvhMin(node->min, pBounds[i].min);
+        node->max = bvhMax(node->max, pBounds[i].max);
+    }
+}
+
+static bool bvhOverlaps(const LvnVec3& aMin, const LvnVec3& aMax, const LvnVec3& bMin, const LvnVec3& bMax)
+{
+    return aMin.x <= bMax.x && aMax.x >= bMin.x && aMin.y <= bMax.y && aMax.y >= bMin.y && aMin.z <= bMax.z && aMax.z >= bMin.z;
+}
+
+// slab test, writes the distance the ray enters the box at, 0 if the origin is inside
+static bool bvhRayBox(const LvnVec3& origin, const LvnVec3& invDir, const LvnVec3& min, const LvnVec3& max, float maxDistance, float* pDistance)
+{
+    float tx0 = (min.x - origin.x) * invDir.x, tx1 = (max.x - origin.x) * invDir.x;
+    float ty0 = (min.y - origin.y) * invDir.y, ty1 = (max.y - origin.y) * invDir.y;
+    float tz0 = (min.z - origin.z) * invDir.z, tz1 = (max.z - origin.z) * invDir.z;
+
+    float tEnter = fmaxf(fmaxf(fminf(tx0, tx1), fminf(ty0, ty1)), fmaxf(fminf(tz0, tz1), 0.0f));
+    float tExit = fminf(fminf(fmaxf(tx0, tx1), fmaxf(ty0, ty1)), fminf(fmaxf(tz0, tz1), maxDistance));
+
+    *pDistance = tEnter;
+    return tEnter <= tExit;
+}
+
+void LvnBvh::build(const LvnAabb* pBounds, uint32_t count, uint32_t maxLeafSize)
 {
-    m_Indices.insert(m_Indices.end(), drawCmd.pIndices, drawCmd.pIndices + drawCmd.indexCount);
-    for (uint32_t i = m_Indices.size() - drawCmd.indexCount; i < m_Indices.size(); i++)
-        m_Indices[i] += m_VertexCount;
+    m_Nodes.clear();
+    m_Objects.resize(count);
+    m_Bounds.resize(count);
+    if (count == 0)
+        return;
+
+    maxLeafSize = lvn::max(maxLeafSize, 1u);
+
+    LvnVector<LvnVec3> centroids(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        m_Objects[i] = i;
+        centroids[i] = (pBounds[i].min + pBounds[i].max) * 0.5f;
+    }
+
+    // a binary tree with count leaves has at most 2 * count - 1 nodes, reserving them keeps node references valid while splitting
+    m_Nodes.reserve(2 * static_cast<size_t>(count) - 1);
+    m_Nodes.push_back({ LvnVec3(0.0f), 0, LvnVec3(0.0f), count });
+
+    LvnVector<uint32_t> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        LvnBvhNode& node = m_Nodes[stack.back()];
+        stack.pop_back();
+
+        node.min = LvnVec3(FLT_MAX);
+        node.max = LvnVec3(-FLT_MAX);
+        LvnVec3 centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+        for (uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            const LvnAabb& bounds = pBounds[m_Objects[i]];
+            node.min = bvhMin(node.min, bounds.min);
+            node.max = bvhMax(node.max, bounds.max);
+            centroidMin = bvhMin(centroidMin, centroids[m_Objects[i]]);
+            centroidMax = bvhMax(centroidMax, centroids[m_Objects[i]]);
+        }
+
+        if (node.count <= maxLeafSize)
+            continue;
+
+        // objects are binned by centroid along each axis, every plane between two bins is a split candidate with the cost area * count of both sides
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        uint32_t bestSplit = 0;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float extent = centroidMax[axis] - centroidMin[axis];
+            if (extent <= 0.0f)
+                continue;
+
+            float scale = s_BvhBinCount / extent;
+            LvnBvhBin bins[s_BvhBinCount];
+            for (uint32_t b = 0; b < s_BvhBinCount; b++)
+                bins[b] = { LvnVec3(FLT_MAX), LvnVec3(-FLT_MAX), 0 };
+
+            for (uint32_t i = node.first; i < node.first + node.count; i++)
+            {
+                LvnBvhBin& bin = bins[bvhBinIndex(centroids[m_Objects[i]][axis], centroidMin[axis], scale)];
+                bin.min = bvhMin(bin.min, pBounds[m_Objects[i]].min);
+                bin.max = bvhMax(bin.max, pBounds[m_Objects[i]].max);
+                bin.count++;
+            }
+
+            // sweeping from both ends gives the area and count on each side of every plane
+            float leftArea[s_BvhBinCount - 1], rightArea[s_BvhBinCount - 1];
+            uint32_t leftCount[s_BvhBinCount - 1], rightCount[s_BvhBinCount - 1];
+            LvnVec3 leftMin(FLT_MAX), leftMax(-FLT_MAX), rightMin(FLT_MAX), rightMax(-FLT_MAX);
+            uint32_t leftSum = 0, rightSum = 0;
+            for (uint32_t b = 0; b < s_BvhBinCount - 1; b++)
+            {
+                leftSum += bins[b].count;
+                leftCount[b] = leftSum;
+                if (bins[b].count > 0) { leftMin = bvhMin(leftMin, bins[b].min); leftMax = bvhMax(leftMax, bins[b].max); }
+                leftArea[b] = leftSum > 0 ? bvhArea(leftMin, leftMax) : 0.0f;
+
+                uint32_t r = s_BvhBinCount - 1 - b;
+                rightSum += bins[r].count;
+                rightCount[r - 1] = rightSum;
+                if (bins[r].count > 0) { rightMin = bvhMin(rightMin, bins[r].min); rightMax = bvhMax(rightMax, bins[r].max); }
+                rightArea[r - 1] = rightSum > 0 ? bvhArea(rightMin, rightMax) : 0.0f;
+            }
+
+            for (uint32_t b = 0; b < s_BvhBinCount - 1; b++)
+            {
+                if (leftCount[b] == 0 || rightCount[b] == 0)
+                    continue;
+
+                float cost = leftCount[b] * leftArea[b] + rightCount[b] * rightArea[b];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b + 1;
+                }
+            }
+        }
+
+        // splitting pays off only if the children are cheaper to test than every object of the node
+        if (bestAxis < 0 || bestCost >= node.count * bvhArea(node.min, node.max))
+            continue;
+
+        float scale = s_BvhBinCount / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+        uint32_t* objects = m_Objects.data() + node.first;
+        uint32_t left = 0, right = node.count;
+        while (left < right)
+        {
+            if (bvhBinIndex(centroids[objects[left]][bestAxis], centroidMin[bestAxis], scale) < bestSplit)
+            {
+                left++;
+                continue;
+            }
+
+            right--;
+            uint32_t temp = objects[left];
+            objects[left] = objects[right];
+            objects[right] = temp;
+        }
+
+        uint32_t child = static_cast<uint32_t>(m_Nodes.size());
+        m_Nodes.push_back({ LvnVec3(0.0f), node.first, LvnVec3(0.0f), left });
+        m_Nodes.push_back({ LvnVec3(0.0f), node.first + left, LvnVec3(0.0f), node.count - left });
+        node.first = child;
+        node.count = 0;
+
+        stack.push_back(child);
+        stack.push_back(child + 1);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+        m_Bounds[i] = pBounds[m_Objects[i]];
+}
+
+void LvnBvh::refit(const LvnAabb* pBounds)
+{
+    for (uint32_t i = 0; i < m_Objects.size(); i++)
+        m_Bounds[i] = pBounds[m_Objects[i]];
+
+    // children are always stored after their parent, walking backwards fits every child before its parent
+    for (size_t i = m_Nodes.size(); i-- > 0;)
+    {
+        LvnBvhNode& node = m_Nodes[i];
+        if (node.count > 0)
+        {
+            bvhFitNode(&node, m_Bounds.data());
+            continue;
+        }
+
+        const LvnBvhNode& left = m_Nodes[node.first];
+        const LvnBvhNode& right = m_Nodes[node.first + 1];
+        node.min = bvhMin(left.min, right.min);
+        node.max = bvhMax(left.max, right.max);
+    }
+}
+
+void LvnBvh::clear()
+{
+    m_Nodes.clear();
+    m_Objects.clear();
+    m_Bounds.clear();
+}
+
+void LvnBvh::query_aabb(const LvnAabb& bounds, LvnVector<uint32_t>* pResults) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    LvnSmallVector<uint32_t, 64> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const LvnBvhNode& node = m_Nodes[stack.back()];
+        stack.pop_back();
+
+        if (!bvhOverlaps(node.min, node.max, bounds.min, bounds.max))
+            continue;
+
+        if (node.count == 0)
+        {
+            stack.push_back(node.first);
+            stack.push_back(node.first + 1);
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            if (bvhOverlaps(m_Bounds[i].min, m_Bounds[i].max, bounds.min, bounds.max))
+                pResults->push_back(m_Objects[i]);
+        }
+    }
+}
+
+void LvnBvh::query_frustum(const LvnFrustum& frustum, LvnVector<uint32_t>* pResults) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    LvnSmallVector<uint32_t, 64> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const LvnBvhNode& node = m_Nodes[stack.back()];
+        stack.pop_back();
+
+        if (!lvn::frustumTestAabb(frustum, node.min, node.max))
+            continue;
+
+        if (node.count == 0)
+        {
+            stack.push_back(node.first);
+            stack.push_back(node.first + 1);
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            if (lvn::frustumTestAabb(frustum, m_Bounds[i].min, m_Bounds[i].max))
+                pResults->push_back(m_Objects[i]);
+        }
+    }
+}
+
+void LvnBvh::query_ray(const LvnRay& ray, float maxDistance, LvnVector<uint32_t>* pResults) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    LvnVec3 invDir = LvnVec3(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+    LvnSmallVector<uint32_t, 64> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const LvnBvhNode& node = m_Nodes[stack.back()];
+        stack.pop_back();
+
+        float distance;
+        if (!bvhRayBox(ray.origin, invDir, node.min, node.max, maxDistance, &distance))
+            continue;
+
+        if (node.count == 0)
+        {
+            stack.push_back(node.first);
+            stack.push_back(node.first + 1);
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; i++)
+        {
+            if (bvhRayBox(ray.origin, invDir, m_Bounds[i].min, m_Bounds[i].max, maxDistance, &distance))
+                pResults->push_back(m_Objects[i]);
+        }
+    }
+}
+
+bool LvnBvh::raycast(const LvnRay& ray, float maxDistance, uint32_t* pObject, float* pDistance, LvnBvhIntersectFunc intersect, void* userData) const
+{
+    if (m_Nodes.empty())
+        return false;
 
-    m_VerticesRaw.insert(m_VerticesRaw.end(), static_cast<uint8_t*>(drawCmd.pVertices), static_cast<uint8_t*>(drawCmd.pVertices) + drawCmd.vertexCount * drawCmd.vertexStride);
-    m_VertexCount += drawCmd.vertexCount;
+    LvnVec3 invDir = LvnVec3(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+    float nearest = maxDistance;
+    uint32_t hitObject = UINT32_MAX;
+
+    float rootDistance;
+    if (!bvhRayBox(ray.origin, invDir, m_Nodes[0].min, m_Nodes[0].max, nearest, &rootDistance))
+        return false;
+
+    // the nearer child is visited first and nodes entered beyond the nearest hit so far are skipped
+    LvnSmallVector<LvnBvhTraversal, 64> stack;
+    stack.push_back({ 0, rootDistance });
+    while (!stack.empty())
+    {
+        LvnBvhTraversal entry = stack.back();
+        stack.pop_back();
+        if (entry.distance > nearest)
+            continue;
+
+        const LvnBvhNode& node = m_Nodes[entry.node];
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.first; i < node.first + node.count; i++)
+            {
+                float distance;
+                if (!bvhRayBox(ray.origin, invDir, m_Bounds[i].min, m_Bounds[i].max, nearest, &distance))
+                    continue;
+
+                if (intersect)
+                {
+                    distance = intersect(m_Objects[i], ray, nearest, userData);
+                    if (distance < 0.0f || distance > nearest)
+                        continue;
+                }
+
+                nearest = distance;
+                hitObject = m_Objects[i];
+            }
+            continue;
+        }
+
+        float leftDistance, rightDistance;
+        bool hitLeft = bvhRayBox(ray.origin, invDir, m_Nodes[node.first].min, m_Nodes[node.first].max, nearest, &leftDistance);
+        bool hitRight = bvhRayBox(ray.origin, invDir, m_Nodes[node.first + 1].min, m_Nodes[node.first + 1].max, nearest, &rightDistance);
+
+        if (hitLeft && hitRight)
+        {
+            bool leftFirst = leftDistance <= rightDistance;
+            stack.push_back(leftFirst ? LvnBvhTraversal{ node.first + 1, rightDistance } : LvnBvhTraversal{ node.first, leftDistance });
+            stack.push_back(leftFirst ? LvnBvhTraversal{ node.first, leftDistance } : LvnBvhTraversal{ node.first + 1, rightDistance });
+        }
+        else if (hitLeft)
+            stack.push_back({ node.first, leftDistance });
+        else if (hitRight)
+            stack.push_back({ node.first + 1, rightDistance });
+    }
+
+    if (hitObject == UINT32_MAX)
+        return false;
+
+    if (pObject) *pObject = hitObject;
+    if (pDistance) *pDistance = nearest;
+    return true;
+}
+
+
+// -- [SUBSECT]: LvnLooseGrid2D
+// ------------------------------------------------------------
+
+static bool looseGridOverlaps(const LvnVec2& aMin, const LvnVec2& aMax, const LvnVec2& bMin, const LvnVec2& bMax)
+{
+    return aMin.x <= bMax.x && aMax.x >= bMin.x && aMin.y <= bMax.y && aMax.y >= bMin.y;
+}
+
+static bool looseGridRayBox(const LvnVec2& origin, const LvnVec2& invDir, const LvnVec2& min, const LvnVec2& max, float maxDistance)
+{
+    float tx0 = (min.x - origin.x) * invDir.x, tx1 = (max.x - origin.x) * invDir.x;
+    float ty0 = (min.y - origin.y) * invDir.y, ty1 = (max.y - origin.y) * invDir.y;
+
+    float tEnter = fmaxf(fmaxf(fminf(tx0, tx1), fminf(ty0, ty1)), 0.0f);
+    float tExit = fminf(fminf(fmaxf(tx0, tx1), fmaxf(ty0, ty1)), maxDistance);
+    return tEnter <= tExit;
+}
+
+LvnLooseGrid2D::LvnLooseGrid2D()
+    : m_Origin(0.0f), m_MaxHalfExtent(0.0f), m_CellSize(1.0f), m_InvCellSize(1.0f), m_Width(0), m_Height(0)
+{
+}
+
+LvnLooseGrid2D::LvnLooseGrid2D(const LvnVec2& origin, float cellSize, uint32_t width, uint32_t height)
+    : LvnLooseGrid2D()
+{
+    init(origin, cellSize, width, height);
+}
+
+void LvnLooseGrid2D::init(const LvnVec2& origin, float cellSize, uint32_t width, uint32_t height)
+{
+    LVN_CORE_ASSERT(cellSize > 0.0f && width > 0 && height > 0, "loose grid needs a positive cell size and at least one cell");
+
+    m_Origin = origin;
+    m_CellSize = cellSize;
+    m_InvCellSize = 1.0f / cellSize;
+    m_Width = width;
+    m_Height = height;
+    m_Cells.resize(static_cast<size_t>(width) * height);
+    clear();
+}
+
+void LvnLooseGrid2D::clear()
+{
+    for (uint32_t i = 0; i < m_Cells.size(); i++)
+        m_Cells[i] = { LvnVec2(FLT_MAX), LvnVec2(-FLT_MAX), UINT32_MAX, 0 };
+
+    m_Objects.clear();
+    m_MaxHalfExtent = LvnVec2(0.0f);
+}
+
+uint32_t LvnLooseGrid2D::cell_of(const LvnVec2& point) const
+{
+    uint32_t x0, y0, x1, y1;
+    cell_range(point, point, &x0, &y0, &x1, &y1);
+    return y0 * m_Width + x0;
+}
+
+void LvnLooseGrid2D::cell_range(const LvnVec2& boundsMin, const LvnVec2& boundsMax, uint32_t* x0, uint32_t* y0, uint32_t* x1, uint32_t* y1) const
+{
+    // clamped as floats first so points far outside the grid do not overflow the conversion
+    auto cell = [](float v, uint32_t size) { return static_cast<uint32_t>(lvn::clamp(floorf(v), 0.0f, static_cast<float>(size - 1))); };
+    *x0 = cell((boundsMin.x - m_Origin.x) * m_InvCellSize, m_Width);
+    *y0 = cell((boundsMin.y - m_Origin.y) * m_InvCellSize, m_Height);
+    *x1 = cell((boundsMax.x - m_Origin.x) * m_InvCellSize, m_Width);
+    *y1 = cell((boundsMax.y - m_Origin.y) * m_InvCellSize, m_Height);
+}
+
+void LvnLooseGrid2D::link(uint32_t id, uint32_t cell)
+{
+    LvnLooseGridObject& object = m_Objects[id];
+    LvnLooseGridCell& gridCell = m_Cells[cell];
+
+    object.cell = cell;
+    object.prev = UINT32_MAX;
+    object.next = gridCell.head;
+    if (gridCell.head != UINT32_MAX)
+        m_Objects[gridCell.head].prev = id;
+
+    gridCell.head = id;
+    gridCell.count++;
+    gridCell.looseMin = LvnVec2(lvn::min(gridCell.looseMin.x, object.min.x), lvn::min(gridCell.looseMin.y, object.min.y));
+    gridCell.looseMax = LvnVec2(lvn::max(gridCell.looseMax.x, object.max.x), lvn::max(gridCell.looseMax.y, object.max.y));
+}
+
+void LvnLooseGrid2D::unlink(uint32_t id)
+{
+    LvnLooseGridObject& object = m_Objects[id];
+    LvnLooseGridCell& gridCell = m_Cells[object.cell];
+
+    if (object.prev != UINT32_MAX)
+        m_Objects[object.prev].next = object.next;
+    else
+        gridCell.head = object.next;
+
+    if (object.next != UINT32_MAX)
+        m_Objects[object.next].prev = object.prev;
+
+    if (--gridCell.count == 0)
+    {
+        gridCell.looseMin = LvnVec2(FLT_MAX);
+        gridCell.looseMax = LvnVec2(-FLT_MAX);
+    }
+
+    object.cell = UINT32_MAX;
+}
+
+void LvnLooseGrid2D::insert(uint32_t id, const LvnVec2& boundsMin, const LvnVec2& boundsMax)
+{
+    update(id, boundsMin, boundsMax);
+}
+
+void LvnLooseGrid2D::update(uint32_t id, const LvnVec2& boundsMin, const LvnVec2& boundsMax)
+{
+    LVN_CORE_ASSERT(!m_Cells.empty(), "loose grid was not initialized with init()");
+
+    if (id >= m_Objects.size())
+        m_Objects.resize(static_cast<size_t>(id) + 1, { LvnVec2(0.0f), LvnVec2(0.0f), UINT32_MAX, UINT32_MAX, UINT32_MAX });
+
+    LvnVec2 halfExtent = (boundsMax - boundsMin) * 0.5f;
+    m_MaxHalfExtent = LvnVec2(lvn::max(m_MaxHalfExtent.x, halfExtent.x), lvn::max(m_MaxHalfExtent.y, halfExtent.y));
+
+    uint32_t cell = cell_of((boundsMin + boundsMax) * 0.5f);
+    LvnLooseGridObject& object = m_Objects[id];
+    object.min = boundsMin;
+    object.max = boundsMax;
+
+    // objects that stay in their cell only grow its loose bounds
+    if (object.cell == cell)
+    {
+        LvnLooseGridCell& gridCell = m_Cells[cell];
+        gridCell.looseMin = LvnVec2(lvn::min(gridCell.looseMin.x, boundsMin.x), lvn::min(gridCell.looseMin.y, boundsMin.y));
+        gridCell.looseMax = LvnVec2(lvn::max(gridCell.looseMax.x, boundsMax.x), lvn::max(gridCell.looseMax.y, boundsMax.y));
+        return;
+    }
+
+    if (object.cell != UINT32_MAX)
+        unlink(id);
+
+    link(id, cell);
+}
+
+void LvnLooseGrid2D::remove(uint32_t id)
+{
+    if (contains(id))
+        unlink(id);
+}
+
+void LvnLooseGrid2D::query_aabb(const LvnVec2& boundsMin, const LvnVec2& boundsMax, LvnVector<uint32_t>* pResults) const
+{
+    if (m_Cells.empty())
+        return;
+
+    // an object can only overlap the box if its center is within the largest half extent of it
+    uint32_t x0, y0, x1, y1;
+    cell_range(boundsMin - m_MaxHalfExtent, boundsMax + m_MaxHalfExtent, &x0, &y0, &x1, &y1);
+
+    for (uint32_t y = y0; y <= y1; y++)
+    {
+        for (uint32_t x = x0; x <= x1; x++)
+        {
+            const LvnLooseGridCell& cell = m_Cells[y * m_Width + x];
+            if (cell.count == 0 || !looseGridOverlaps(cell.looseMin, cell.looseMax, boundsMin, boundsMax))
+                continue;
+
+            for (uint32_t id = cell.head; id != UINT32_MAX; id = m_Objects[id].next)
+            {
+                if (looseGridOverlaps(m_Objects[id].min, m_Objects[id].max, boundsMin, boundsMax))
+                    pResults->push_back(id);
+            }
+        }
+    }
+}
+
+void LvnLooseGrid2D::query_point(const LvnVec2& point, LvnVector<uint32_t>* pResults) const
+{
+    query_aabb(point, point, pResults);
+}
+
+void LvnLooseGrid2D::query_ray(const LvnVec2& origin, const LvnVec2& direction, float maxDistance, LvnVector<uint32_t>* pResults) const
+{
+    if (m_Cells.empty())
+        return;
+
+    // the cells around the segment are tested with their loose bounds first, long rays crossing the grid diagonally visit many empty cells
+    LvnVec2 end = origin + direction * maxDistance;
+    LvnVec2 segmentMin = LvnVec2(lvn::min(origin.x, end.x), lvn::min(origin.y, end.y));
+    LvnVec2 segmentMax = LvnVec2(lvn::max(origin.x, end.x), lvn::max(origin.y, end.y));
+    LvnVec2 invDir = LvnVec2(1.0f / direction.x, 1.0f / direction.y);
+
+    uint32_t x0, y0, x1, y1;
+    cell_range(segmentMin - m_MaxHalfExtent, segmentMax + m_MaxHalfExtent, &x0, &y0, &x1, &y1);
+
+    for (uint32_t y = y0; y <= y1; y++)
+    {
+        for (uint32_t x = x0; x <= x1; x++)
+        {
+            const LvnLooseGridCell& cell = m_Cells[y * m_Width + x];
+            if (cell.count == 0 || !looseGridRayBox(origin, invDir, cell.looseMin, cell.looseMax, maxDistance))
+                continue;
+
+            for (uint32_t id = cell.head; id != UINT32_MAX; id = m_Objects[id].next)
+            {
+                if (looseGridRayBox(origin, invDir, m_Objects[id].min, m_Objects[id].max, maxDistance))
+                    pResults->push_back(id);
+            }
+        }
+    }
 }
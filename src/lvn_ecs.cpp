@@ -1,60 +1,1809 @@
 #include "lvn_ecs.h"
 
+#include <algorithm>
+
 // [FILE]: lvn_ecs.cpp (Entity Component System)
 // ------------------------------------------------------------
 
-static size_t                  s_EntityIndexID = 0;
-static size_t                  s_MaxEntityIDs = SIZE_MAX;
-static LvnQueue<LvnEntity>     s_AvailableEntityIDs;
-static LvnComponentManager     s_ComponentManager;
+// chunks are sized to stay within the l1/l2 caches while iterating, archetypes with rows larger than this get one row per chunk
+#define LVN_ECS_CHUNK_SIZE (16 * 1024)
+#define LVN_ECS_CHUNK_ALIGNMENT 64
+#define LVN_ECS_COMMAND_BLOCK_SIZE (16 * 1024)    // component values recorded in command buffers are stored in blocks of this size
+
+// snapshots and deltas start with a magic number so foreign data is rejected, the version changes with the layout
+#define LVN_ECS_SNAPSHOT_MAGIC 0x534e564c         // "LVNS"
+#define LVN_ECS_SNAPSHOT_VERSION 1
+#define LVN_ECS_DELTA_MAGIC 0x444e564c            // "LVND"
+#define LVN_ECS_DELTA_MERGE_GAP 4                 // equal runs shorter than this are sent as changed bytes instead of starting a new op
+
+static LvnEcsWorld             s_EcsWorld;                 // used by the functions that do not take a world
+static LvnAtomic<uint64_t>     s_NextWorldGeneration(1);
+
+
+// in playback order
+enum LvnEcsCommandType
+{
+    Lvn_EcsCommandType_AddComponent,
+    Lvn_EcsCommandType_RemoveComponent,
+    Lvn_EcsCommandType_DestroyEntity,
+};
+
+struct LvnEcsCommand
+{
+    LvnEntity entity;
+    LvnEcsCommandType type;
+    LvnTypeId id;                               // component type of add and remove commands
+    const LvnComponentInfo* info;               // component of add commands
+    void* value;                                // storage of add commands in the value blocks
+};
+
+struct LvnEcsCommandBlock
+{
+    uint8_t* memory;
+    size_t size;
+    size_t used;
+};
+
+struct LvnEcsCommandBuffer
+{
+    LvnEcsWorld* world;
+    const void* thread;                         // address of a thread local of the thread the buffer belongs to
+    LvnVector<LvnEcsCommand> commands;
+    LvnVector<LvnEcsCommandBlock> blocks;       // values are constructed in place so blocks never move, they are reused after every playback
+    uint32_t currentBlock;
+    uint32_t pendingCount;                      // entities created since the last playback
+    LvnVector<LvnEntity> created;               // entities the pending handles became in the last playback
+};
+
+struct LvnEcsPlaybackItem
+{
+    LvnEcsCommand* command;
+    uint32_t archetype;                         // index + 1 of the archetype of the entity when its group is played back, 0 for none
+    size_t sequence;                            // recorded order across every buffer, keeps commands with equal keys in order
+};
+
+struct LvnEcsThreadCommandBuffer
+{
+    uint64_t generation;
+    LvnEcsCommandBuffer* buffer;
+};
+
+static thread_local char                         s_ThreadKey;                // its address tells the threads apart
+static thread_local LvnEcsThreadCommandBuffer    s_ThreadCommandBuffer{};    // buffer of the world the thread last recorded for
+static thread_local LvnEcsWorld*                 s_SystemWorld = nullptr;    // world of the schedule running the system on this thread
+
+
+struct LvnEcsSystem;
+
+struct LvnEcsSystemTask
+{
+    LvnEcsSystem* system;
+    const LvnArchetype* archetype;
+    const LvnArchetypeChunk* chunk;
+    const uint32_t* columns;
+    const size_t* offsets;
+};
+
+struct LvnEcsSystem
+{
+    LvnEcsSchedule* schedule;
+    LvnString name;
+    const char* profileName;                    // interned copy of the name, profiling zones outlive the schedule
+    LvnVector<LvnTypeId> typeIds;               // in the order of the function parameters
+    LvnVector<bool> writes;
+    void (*func)();
+    LvnEcsSystemChunkFunc runChunk;
+
+    LvnVector<const LvnArchetype*> matches;     // archetypes with every component of the system, matched as they are created
+    LvnVector<uint32_t> matchColumns;           // typeIds.size() columns per match
+    LvnVector<size_t> matchOffsets;             // typeIds.size() column offsets per match
+    size_t archetypeCount;
+    uint64_t generation;
+
+    LvnVector<uint32_t> dependents;             // later systems that conflict with this one
+    uint32_t dependencyCount;
+
+    // state of the current run
+    LvnVector<LvnEcsSystemTask> tasks;
+    LvnAtomic<uint32_t> pendingDependencies;
+    LvnAtomic<uint32_t> remainingTasks;
+};
+
+struct LvnEcsSchedule
+{
+    LvnVector<LvnEcsSystem*> systems;
+    LvnJobCounter counter;
+    uint32_t changeTick;                        // tick of the world being run, stamped on the components systems write
+    LvnEcsWorld* world;                         // world being run
+};
+
+// snapshot layout, every value is in the byte order of the machine that wrote it:
+// header, type table, generation of every entity index from 1, free entity indices,
+// then per archetype: component count, type table index of each component, entity count, the entities,
+// and per component the values, added ticks and changed ticks of every entity
+struct LvnEcsSnapshotHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t entityIndexId;
+    uint32_t changeTick;
+    uint32_t typeCount;
+    uint32_t archetypeCount;
+    uint32_t freeCount;
+};
+
+struct LvnEcsSnapshotType
+{
+    uint64_t hash;
+    uint64_t size;
+};
+
+// followed by ops of a varint count of equal bytes to skip, a varint count of changed bytes and the changed bytes
+struct LvnEcsDeltaHeader
+{
+    uint32_t magic;
+    uint32_t reserved;
+    uint64_t baseHash;
+    uint64_t baseSize;
+    uint64_t size;
+};
+
+struct LvnEcsReader
+{
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+};
 
 namespace lvn
 {
 
-LvnEntity createEntity()
+static LvnEntityRecord&        getRecord(LvnEcsWorld* world, LvnEntity entity);
+static LvnEntityRecord*        findRecord(LvnEcsWorld* world, LvnEntity entity);
+static LvnArchetype*           createArchetype(LvnEcsWorld* world, const LvnVector<const LvnComponentInfo*>& components);
+static void                    destroyArchetype(LvnArchetype* archetype);
+static LvnArchetype*           findArchetype(LvnEcsWorld* world, const LvnVector<const LvnComponentInfo*>& components);
+static LvnArchetype*           getAddArchetype(LvnEcsWorld* world, LvnArchetype* archetype, const LvnComponentInfo* info);
+static LvnArchetype*           getRemoveArchetype(LvnEcsWorld* world, LvnArchetype* archetype, LvnTypeId id);
+static void                    archetypePushRow(LvnArchetype* archetype, LvnEntity entity, uint32_t* chunk, uint32_t* row);
+static uint32_t                archetypePushRows(LvnArchetype* archetype, size_t count, uint32_t* chunk, uint32_t* row);
+static void                    archetypeRemoveRow(LvnEcsWorld* world, LvnArchetype* archetype, uint32_t chunk, uint32_t row);
+static void                    moveEntity(LvnEcsWorld* world, LvnEntity entity, LvnArchetype* dst);
+static void                    setComponentTicks(LvnArchetype* archetype, LvnArchetypeChunk& chunk, uint32_t column, uint32_t row, uint32_t added, uint32_t changed);
+static void                    recordRemoved(LvnEcsWorld* world, LvnTypeId id, LvnEntity entity);
+static bool                    systemsConflict(const LvnEcsSystem* a, const LvnEcsSystem* b);
+static void                    updateSystemMatches(LvnEcsSystem* system, LvnEcsWorld* world);
+static void                    launchSystem(LvnEcsSystem* system);
+static void                    finishSystem(LvnEcsSystem* system);
+static void                    systemTaskJob(void* arg);
+static void*                   commandAllocValue(LvnEcsCommandBuffer* commands, size_t size, size_t alignment);
+static void                    destroyCommandBuffer(LvnEcsCommandBuffer* commands);
+static void                    playbackCommandGroup(LvnEcsWorld* world, const LvnEcsPlaybackItem* items, size_t count);
+static uint64_t                hashBytes(const uint8_t* data, size_t size);
+static void                    writeBytes(LvnVector<uint8_t>& out, const void* data, size_t size);
+static void                    writeVarint(LvnVector<uint8_t>& out, uint64_t value);
+static const uint8_t*          readBytes(LvnEcsReader* reader, size_t size);
+static bool                    readVarint(LvnEcsReader* reader, uint64_t* value);
+static bool                    readSnapshot(LvnEcsWorld* world, const uint8_t* data, size_t size, bool apply);
+
+
+// records are paged so large or scattered entity ids only allocate the pages they touch
+static LvnEntityRecord& getRecord(LvnEcsWorld* world, LvnEntity entity)
+{
+    uint32_t index = lvn::entityIndex(entity);
+    size_t page = index / LVN_ECS_RECORD_PAGE_SIZE;
+    if (page >= world->recordPages.size())
+        world->recordPages.resize(page + 1, nullptr);
+
+    if (!world->recordPages[page])
+    {
+        LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+        // zeroed memory is a record without an archetype
+        world->recordPages[page] = static_cast<LvnEntityRecord*>(lvn::memAlloc(LVN_ECS_RECORD_PAGE_SIZE * sizeof(LvnEntityRecord)));
+    }
+
+    return world->recordPages[page][index % LVN_ECS_RECORD_PAGE_SIZE];
+}
+
+// nullptr if the page of the entity was never allocated or the handle is stale
+static LvnEntityRecord* findRecord(LvnEcsWorld* world, LvnEntity entity)
+{
+    uint32_t index = lvn::entityIndex(entity);
+    size_t page = index / LVN_ECS_RECORD_PAGE_SIZE;
+    if (index == 0 || index > world->entityIndexId || page >= world->recordPages.size() || !world->recordPages[page])
+        return nullptr;
+
+    LvnEntityRecord* record = &world->recordPages[page][index % LVN_ECS_RECORD_PAGE_SIZE];
+    return record->generation == lvn::entityGeneration(entity) ? record : nullptr;
+}
+
+static LvnArchetype* createArchetype(LvnEcsWorld* world, const LvnVector<const LvnComponentInfo*>& components)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+    LvnArchetype* archetype = new LvnArchetype();
+    archetype->components = components;
+    archetype->chunkCapacity = 0;
+    archetype->entityCount = 0;
+    archetype->index = world->archetypes.size();
+
+    size_t rowSize = sizeof(LvnEntity);
+    for (uint32_t i = 0; i < components.size(); i++)
+    {
+        archetype->typeIds.push_back(components[i]->id);
+        rowSize += components[i]->size + 2 * sizeof(uint32_t);
+        lvn::ecsRegisterComponentInfo(world, components[i]);
+    }
+
+    // type ids are dense so the table stays small, the ids are sorted so the last one is the largest
+    if (!components.empty())
+    {
+        archetype->columnTable.resize(components.back()->id + 1, -1);
+        for (uint32_t i = 0; i < components.size(); i++)
+            archetype->columnTable[components[i]->id] = static_cast<int32_t>(i);
+    }
+
+    // fit as many rows as the chunk size allows once every column is aligned, at least one
+    uint32_t capacity = rowSize < LVN_ECS_CHUNK_SIZE ? static_cast<uint32_t>(LVN_ECS_CHUNK_SIZE / rowSize) : 1;
+    while (true)
+    {
+        archetype->columnOffsets.clear();
+        archetype->tickOffsets.clear();
+
+        size_t offset = sizeof(LvnEntity) * capacity;
+        // each column starts on a cache line so chunk loops can use aligned simd loads and two columns never share a line
+        for (uint32_t i = 0; i < components.size(); i++)
+        {
+            size_t alignment = components[i]->alignment > LVN_ECS_CHUNK_ALIGNMENT ? components[i]->alignment : LVN_ECS_CHUNK_ALIGNMENT;
+            offset = (offset + alignment - 1) & ~(alignment - 1);
+            archetype->columnOffsets.push_back(offset);
+            offset += components[i]->size * capacity;
+        }
+
+        // added and changed ticks of each column, then the newest of both per column for the whole chunk
+        offset = (offset + alignof(uint32_t) - 1) & ~(alignof(uint32_t) - 1);
+        for (uint32_t i = 0; i < components.size(); i++)
+        {
+            archetype->tickOffsets.push_back(offset);
+            offset += 2 * sizeof(uint32_t) * capacity;
+        }
+
+        archetype->chunkTickOffset = offset;
+        offset += 2 * sizeof(uint32_t) * components.size();
+
+        if (offset <= LVN_ECS_CHUNK_SIZE || capacity == 1)
+        {
+            archetype->chunkSize = offset;
+            archetype->chunkCapacity = capacity;
+            break;
+        }
+
+        capacity--;
+    }
+
+    world->archetypes.push_back(archetype);
+    return archetype;
+}
+
+static void destroyArchetype(LvnArchetype* archetype)
+{
+    for (uint32_t i = 0; i < archetype->chunks.size(); i++)
+    {
+        LvnArchetypeChunk& chunk = archetype->chunks[i];
+        for (uint32_t j = 0; j < archetype->components.size(); j++)
+        {
+            if (archetype->components[j]->destruct == nullptr)
+                continue;
+
+            for (uint32_t k = 0; k < chunk.count; k++)
+                archetype->components[j]->destruct(archetype->component(chunk, j, k));
+        }
+
+        lvn::memFreeAligned(chunk.memory);
+    }
+
+    delete archetype;
+}
+
+// components are sorted by type id
+static LvnArchetype* findArchetype(LvnEcsWorld* world, const LvnVector<const LvnComponentInfo*>& components)
+{
+    for (uint32_t i = 0; i < world->archetypes.size(); i++)
+    {
+        LvnArchetype* archetype = world->archetypes[i];
+        if (archetype->typeIds.size() != components.size())
+            continue;
+
+        bool match = true;
+        for (uint32_t j = 0; j < components.size() && match; j++)
+            match = archetype->typeIds[j] == components[j]->id;
+
+        if (match)
+            return archetype;
+    }
+
+    return nullptr;
+}
+
+static LvnArchetype* getAddArchetype(LvnEcsWorld* world, LvnArchetype* archetype, const LvnComponentInfo* info)
+{
+    // entities without components follow the edges of the world
+    LvnFlatHashMap<LvnTypeId, LvnArchetype*>& edges = archetype ? archetype->addEdges : world->rootEdges;
+    LvnArchetype** edge = edges.find(info->id);
+    if (edge) { return *edge; }
+
+    // the archetype is searched for once per transition, later moves follow the edge
+    LvnVector<const LvnComponentInfo*> components;
+    if (archetype)
+        components = archetype->components;
+
+    uint32_t index = 0;
+    while (index < components.size() && components[index]->id < info->id)
+        index++;
+    components.insert_index(index, info);
+
+    LvnArchetype* dst = lvn::findArchetype(world, components);
+    if (!dst)
+        dst = lvn::createArchetype(world, components);
+
+    edges[info->id] = dst;
+    if (archetype)
+        dst->removeEdges[info->id] = archetype;
+
+    return dst;
+}
+
+static LvnArchetype* getRemoveArchetype(LvnEcsWorld* world, LvnArchetype* archetype, LvnTypeId id)
+{
+    LvnArchetype** edge = archetype->removeEdges.find(id);
+    if (edge) { return *edge; }
+
+    if (archetype->components.size() == 1)
+        return nullptr;
+
+    LvnVector<const LvnComponentInfo*> components;
+    for (uint32_t i = 0; i < archetype->components.size(); i++)
+    {
+        if (archetype->components[i]->id != id)
+            components.push_back(archetype->components[i]);
+    }
+
+    LvnArchetype* dst = lvn::findArchetype(world, components);
+    if (!dst)
+        dst = lvn::createArchetype(world, components);
+
+    archetype->removeEdges[id] = dst;
+    dst->addEdges[id] = archetype;
+    return dst;
+}
+
+// appends an uninitialized row, the caller constructs its components
+static void archetypePushRow(LvnArchetype* archetype, LvnEntity entity, uint32_t* chunk, uint32_t* row)
+{
+    lvn::archetypePushRows(archetype, 1, chunk, row);
+    archetype->chunks[*chunk].entities()[*row] = entity;
+}
+
+// appends up to count uninitialized rows to the last chunk or a new one, returns how many fit
+static uint32_t archetypePushRows(LvnArchetype* archetype, size_t count, uint32_t* chunk, uint32_t* row)
+{
+    if (archetype->chunks.empty() || archetype->chunks.back().count == archetype->chunkCapacity)
+    {
+        LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+        LvnArchetypeChunk newChunk{};
+        newChunk.memory = static_cast<uint8_t*>(lvn::memAllocAligned(archetype->chunkSize, LVN_ECS_CHUNK_ALIGNMENT));
+        newChunk.count = 0;
+        archetype->chunks.push_back(newChunk);
+    }
+
+    LvnArchetypeChunk& last = archetype->chunks.back();
+    uint32_t space = archetype->chunkCapacity - last.count;
+    uint32_t pushed = count < space ? static_cast<uint32_t>(count) : space;
+    *chunk = static_cast<uint32_t>(archetype->chunks.size() - 1);
+    *row = last.count;
+
+    last.count += pushed;
+    archetype->entityCount += pushed;
+    return pushed;
+}
+
+// destroys the components of the row and fills the hole with the last row so the chunks stay dense
+static void archetypeRemoveRow(LvnEcsWorld* world, LvnArchetype* archetype, uint32_t chunk, uint32_t row)
+{
+    LvnArchetypeChunk& hole = archetype->chunks[chunk];
+    LvnArchetypeChunk& last = archetype->chunks.back();
+    uint32_t lastRow = last.count - 1;
+
+    for (uint32_t i = 0; i < archetype->components.size(); i++)
+    {
+        if (archetype->components[i]->destruct)
+            archetype->components[i]->destruct(archetype->component(hole, i, row));
+    }
+
+    if (&hole != &last || row != lastRow)
+    {
+        for (uint32_t i = 0; i < archetype->components.size(); i++)
+        {
+            void* src = archetype->component(last, i, lastRow);
+            archetype->components[i]->moveConstruct(archetype->component(hole, i, row), src);
+            if (archetype->components[i]->destruct)
+                archetype->components[i]->destruct(src);
+
+            lvn::setComponentTicks(archetype, hole, i, row, archetype->added_ticks(last, i)[lastRow], archetype->changed_ticks(last, i)[lastRow]);
+        }
+
+        LvnEntity moved = last.entities()[lastRow];
+        hole.entities()[row] = moved;
+
+        LvnEntityRecord& record = lvn::getRecord(world, moved);
+        record.chunk = chunk;
+        record.row = row;
+    }
+
+    last.count--;
+    archetype->entityCount--;
+
+    if (last.count == 0)
+    {
+        lvn::memFreeAligned(last.memory);
+        archetype->chunks.pop_back();
+    }
+}
+
+// moves the components the entity keeps into dst, components without a column in dst are destroyed
+static void moveEntity(LvnEcsWorld* world, LvnEntity entity, LvnArchetype* dst)
+{
+    LvnEntityRecord& record = lvn::getRecord(world, entity);
+    LvnArchetype* src = record.archetype;
+
+    uint32_t dstChunk = 0, dstRow = 0;
+    if (dst)
+    {
+        lvn::archetypePushRow(dst, entity, &dstChunk, &dstRow);
+
+        // components the entity keeps bring their ticks along, new ones are added and changed now
+        LvnArchetypeChunk& dstChunkRef = dst->chunks[dstChunk];
+        for (uint32_t i = 0; i < dst->components.size(); i++)
+        {
+            int32_t column = src ? src->column_index(dst->typeIds[i]) : -1;
+            if (column < 0)
+            {
+                lvn::setComponentTicks(dst, dstChunkRef, i, dstRow, world->changeTick, world->changeTick);
+                continue;
+            }
+
+            LvnArchetypeChunk& srcChunk = src->chunks[record.chunk];
+            src->components[column]->moveConstruct(dst->component(dstChunkRef, i, dstRow), src->component(srcChunk, column, record.row));
+            lvn::setComponentTicks(dst, dstChunkRef, i, dstRow, src->added_ticks(srcChunk, column)[record.row], src->changed_ticks(srcChunk, column)[record.row]);
+        }
+    }
+
+    if (src)
+    {
+        for (uint32_t i = 0; i < src->components.size(); i++)
+        {
+            if (!dst || dst->column_index(src->typeIds[i]) < 0)
+                lvn::recordRemoved(world, src->typeIds[i], entity);
+        }
+
+        // moved from components are destroyed with the rest of the row
+        lvn::archetypeRemoveRow(world, src, record.chunk, record.row);
+    }
+
+    record.archetype = dst;
+    record.chunk = dstChunk;
+    record.row = dstRow;
+}
+
+static void setComponentTicks(LvnArchetype* archetype, LvnArchetypeChunk& chunk, uint32_t column, uint32_t row, uint32_t added, uint32_t changed)
+{
+    archetype->added_ticks(chunk, column)[row] = added;
+    archetype->changed_ticks(chunk, column)[row] = changed;
+
+    // the chunk ticks only move forward, rows leaving the chunk can leave them newer than every row which only costs a scan
+    uint32_t* chunkTicks = archetype->chunk_ticks(chunk);
+    if (lvn::internal::ecsTickNewer(added, chunkTicks[column * 2]))
+        chunkTicks[column * 2] = added;
+    if (lvn::internal::ecsTickNewer(changed, chunkTicks[column * 2 + 1]))
+        chunkTicks[column * 2 + 1] = changed;
+}
+
+static void recordRemoved(LvnEcsWorld* world, LvnTypeId id, LvnEntity entity)
+{
+    if (id >= world->removedComponents.size())
+        world->removedComponents.resize(id + 1);
+
+    world->removedComponents[id].push_back(LvnEcsRemovedComponent{ entity, world->changeTick });
+}
+
+// systems conflict when one writes a component the other reads or writes
+static bool systemsConflict(const LvnEcsSystem* a, const LvnEcsSystem* b)
+{
+    for (uint32_t i = 0; i < a->typeIds.size(); i++)
+    {
+        for (uint32_t j = 0; j < b->typeIds.size(); j++)
+        {
+            if (a->typeIds[i] == b->typeIds[j] && (a->writes[i] || b->writes[j]))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+static void updateSystemMatches(LvnEcsSystem* system, LvnEcsWorld* world)
+{
+    if (system->generation != world->generation)
+    {
+        system->matches.clear();
+        system->matchColumns.clear();
+        system->matchOffsets.clear();
+        system->archetypeCount = 0;
+        system->generation = world->generation;
+    }
+
+    uint32_t typeCount = system->typeIds.size();
+    for (; system->archetypeCount < world->archetypes.size(); system->archetypeCount++)
+    {
+        const LvnArchetype* archetype = world->archetypes[system->archetypeCount];
+
+        size_t index = system->matchOffsets.size();
+        system->matchColumns.resize(index + typeCount);
+        system->matchOffsets.resize(index + typeCount);
+        if (lvn::internal::ecsGetColumns(archetype, system->typeIds.data(), typeCount, &system->matchColumns[index], &system->matchOffsets[index]))
+        {
+            system->matches.push_back(archetype);
+        }
+        else
+        {
+            system->matchColumns.resize(index);
+            system->matchOffsets.resize(index);
+        }
+    }
+}
+
+static void launchSystem(LvnEcsSystem* system)
+{
+    if (system->tasks.empty())
+    {
+        lvn::finishSystem(system);
+        return;
+    }
+
+    for (uint32_t i = 0; i < system->tasks.size(); i++)
+        lvn::jobSubmit(lvn::systemTaskJob, &system->tasks[i], &system->schedule->counter);
+}
+
+static void finishSystem(LvnEcsSystem* system)
+{
+    LvnEcsSchedule* schedule = system->schedule;
+    for (uint32_t i = 0; i < system->dependents.size(); i++)
+    {
+        LvnEcsSystem* dependent = schedule->systems[system->dependents[i]];
+        if (dependent->pendingDependencies.decrement(std::memory_order_acq_rel) == 0)
+            lvn::launchSystem(dependent);
+    }
+}
+
+static void systemTaskJob(void* arg)
+{
+    LvnEcsSystemTask* task = static_cast<LvnEcsSystemTask*>(arg);
+    LvnEcsSystem* system = task->system;
+    LVN_PROFILE_SCOPE(system->profileName);
+
+    // systems record their structural changes for the world they run over
+    LvnEcsWorld* prevWorld = s_SystemWorld;
+    s_SystemWorld = system->schedule->world;
+    system->runChunk(system->func, task->chunk->memory, task->chunk->count, task->offsets);
+    s_SystemWorld = prevWorld;
+
+    // chunks are only touched by one task of a system and conflicting systems never run together
+    for (uint32_t i = 0; i < system->typeIds.size(); i++)
+    {
+        if (system->writes[i])
+            lvn::internal::ecsMarkChanged(task->archetype, *task->chunk, task->columns[i], 0, task->chunk->count, system->schedule->changeTick);
+    }
+
+    // the last chunk of the system releases the systems waiting on it
+    if (system->remainingTasks.decrement(std::memory_order_acq_rel) == 0)
+        lvn::finishSystem(system);
+}
+
+static void* commandAllocValue(LvnEcsCommandBuffer* commands, size_t size, size_t alignment)
+{
+    LVN_CORE_ASSERT(alignment <= LVN_ECS_CHUNK_ALIGNMENT, "component alignment (%zu) is larger than the chunk alignment", alignment);
+
+    // the blocks of earlier playbacks are filled again from the front
+    for (; commands->currentBlock < commands->blocks.size(); commands->currentBlock++)
+    {
+        LvnEcsCommandBlock& block = commands->blocks[commands->currentBlock];
+        size_t offset = (block.used + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= block.size)
+        {
+            block.used = offset + size;
+            return block.memory + offset;
+        }
+    }
+
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+    LvnEcsCommandBlock block{};
+    block.size = size > LVN_ECS_COMMAND_BLOCK_SIZE ? size : LVN_ECS_COMMAND_BLOCK_SIZE;
+    block.memory = static_cast<uint8_t*>(lvn::memAllocAligned(block.size, LVN_ECS_CHUNK_ALIGNMENT));
+    block.used = size;
+    commands->blocks.push_back(block);
+    commands->currentBlock = commands->blocks.size() - 1;
+    return block.memory;
+}
+
+// values of commands that were never played back are destroyed with the buffer
+static void destroyCommandBuffer(LvnEcsCommandBuffer* commands)
 {
-    if (!s_AvailableEntityIDs.empty())
+    for (uint32_t i = 0; i < commands->commands.size(); i++)
     {
-        LvnEntity entity = s_AvailableEntityIDs.front();
-        s_AvailableEntityIDs.pop();
-        return entity;
+        const LvnEcsCommand& command = commands->commands[i];
+        if (command.type == Lvn_EcsCommandType_AddComponent && command.info->destruct)
+            command.info->destruct(command.value);
     }
 
-    LVN_CORE_ASSERT(s_EntityIndexID < s_MaxEntityIDs, "cannot create entity, maximum entity count (%zu) reached", s_MaxEntityIDs);
-    return ++s_EntityIndexID;
+    for (uint32_t i = 0; i < commands->blocks.size(); i++)
+        lvn::memFreeAligned(commands->blocks[i].memory);
+
+    delete commands;
 }
 
-void destroyEntity(LvnEntity entity)
+// every command of the group has the same type and component, entities of the same archetype are next to each other
+static void playbackCommandGroup(LvnEcsWorld* world, const LvnEcsPlaybackItem* items, size_t count)
 {
-    for (auto& comp : s_ComponentManager)
+    LvnArchetype* src = nullptr;
+    LvnArchetype* dst = nullptr;
+    bool cached = false;
+
+    for (size_t i = 0; i < count; i++)
     {
-        comp.second->entityDestroyed(entity);
+        const LvnEcsCommand& command = *items[i].command;
+        LvnEntityRecord* record = lvn::findRecord(world, command.entity);
+
+        switch (command.type)
+        {
+            case Lvn_EcsCommandType_AddComponent:
+            {
+                const LvnComponentInfo* info = command.info;
+                if (record)
+                {
+                    int32_t column = record->archetype ? record->archetype->column_index(command.id) : -1;
+                    if (column >= 0)
+                    {
+                        // the entity already has the component, the recorded value replaces it
+                        LvnArchetypeChunk& chunk = record->archetype->chunks[record->chunk];
+                        void* comp = record->archetype->component(chunk, column, record->row);
+                        if (info->destruct)
+                            info->destruct(comp);
+                        info->moveConstruct(comp, command.value);
+                        lvn::internal::ecsMarkChanged(record->archetype, chunk, column, record->row, 1, world->changeTick);
+                    }
+                    else
+                    {
+                        if (!cached || record->archetype != src)
+                        {
+                            src = record->archetype;
+                            dst = lvn::getAddArchetype(world, src, info);
+                            cached = true;
+                        }
+
+                        lvn::moveEntity(world, command.entity, dst);
+                        info->moveConstruct(dst->component(dst->chunks[record->chunk], dst->column_index(command.id), record->row), command.value);
+                    }
+                }
+
+                if (info->destruct)
+                    info->destruct(command.value);
+                break;
+            }
+            case Lvn_EcsCommandType_RemoveComponent:
+            {
+                if (!record || !record->archetype || record->archetype->column_index(command.id) < 0)
+                    break;
+
+                if (!cached || record->archetype != src)
+                {
+                    src = record->archetype;
+                    dst = lvn::getRemoveArchetype(world, src, command.id);
+                    cached = true;
+                }
+
+                lvn::moveEntity(world, command.entity, dst);
+                break;
+            }
+            case Lvn_EcsCommandType_DestroyEntity:
+            {
+                if (record)
+                    lvn::destroyEntity(world, command.entity);
+                break;
+            }
+        }
     }
+}
 
-    s_AvailableEntityIDs.push(entity);
+
+LvnEcsWorld* ecsCreateWorld()
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+    LvnEcsWorld* world = new LvnEcsWorld();
+    world->generation = s_NextWorldGeneration.fetch_add(1, std::memory_order_relaxed);
+    return world;
 }
 
-void setMaxEntityIdCount(size_t max)
+void ecsDestroyWorld(LvnEcsWorld* world)
 {
-    s_MaxEntityIDs = max;
+    lvn::ecsWorldClear(world);
+    delete world;
 }
 
-size_t getMaxEntityIdCount()
+void ecsWorldClear(LvnEcsWorld* world)
 {
-    return s_MaxEntityIDs;
+    // recorded commands refer to the entities being destroyed, the threads create new buffers for the next generation
+    for (uint32_t i = 0; i < world->commandBuffers.size(); i++)
+        lvn::destroyCommandBuffer(world->commandBuffers[i]);
+    world->commandBuffers.clear_free();
+
+    for (uint32_t i = 0; i < world->archetypes.size(); i++)
+        lvn::destroyArchetype(world->archetypes[i]);
+
+    for (uint32_t i = 0; i < world->recordPages.size(); i++)
+    {
+        if (world->recordPages[i])
+            lvn::memFree(world->recordPages[i]);
+    }
+
+    world->archetypes.clear_free();
+    world->recordPages.clear_free();
+    world->rootEdges.clear_free();
+    world->removedComponents.clear_free();
+    world->availableEntityIds = LvnQueue<uint32_t>();
+    world->entityIndexId = 0;
+    world->maxEntityIds = LVN_ENTITY_INDEX_MASK;
+
+    // generations are unique across worlds so views and schedules never mistake one world for another
+    world->generation = s_NextWorldGeneration.fetch_add(1, std::memory_order_relaxed);
 }
 
-LvnComponentManager* getComponentManager()
+LvnEcsWorld* getEcsWorld()
 {
-    return &s_ComponentManager;
+    return &s_EcsWorld;
 }
 
 void ecsRestart()
 {
-    s_EntityIndexID = 0;
-    s_MaxEntityIDs = SIZE_MAX;
-    s_AvailableEntityIDs = LvnQueue<LvnEntity>();
-    s_ComponentManager = LvnComponentManager();
+    lvn::ecsWorldClear(&s_EcsWorld);
+}
+
+LvnEntity createEntity(LvnEcsWorld* world)
+{
+    // reused indices keep the generation their last entity was destroyed with
+    if (!world->availableEntityIds.empty())
+    {
+        uint32_t index = world->availableEntityIds.front();
+        world->availableEntityIds.pop();
+        return (static_cast<LvnEntity>(lvn::getRecord(world, index).generation) << LVN_ENTITY_INDEX_BITS) | index;
+    }
+
+    LVN_CORE_ASSERT(world->entityIndexId < world->maxEntityIds, "cannot create entity, maximum entity count (%zu) reached", world->maxEntityIds);
+
+    // the record page is allocated here so live entities always have a record
+    LvnEntity entity = ++world->entityIndexId;
+    lvn::getRecord(world, entity);
+    return entity;
+}
+
+void createEntities(LvnEcsWorld* world, LvnEntity* pEntities, uint32_t count)
+{
+    uint32_t created = 0;
+    while (created < count && !world->availableEntityIds.empty())
+    {
+        uint32_t index = world->availableEntityIds.front();
+        world->availableEntityIds.pop();
+        pEntities[created++] = (static_cast<LvnEntity>(lvn::getRecord(world, index).generation) << LVN_ENTITY_INDEX_BITS) | index;
+    }
+
+    uint32_t remaining = count - created;
+    LVN_CORE_ASSERT(world->entityIndexId + remaining <= world->maxEntityIds, "cannot create %u entities, maximum entity count (%zu) reached", remaining, world->maxEntityIds);
+    if (remaining == 0) { return; }
+
+    // new indices are consecutive, their record pages are allocated once per page instead of once per entity
+    size_t first = world->entityIndexId + 1;
+    size_t last = world->entityIndexId + remaining;
+    for (size_t page = first / LVN_ECS_RECORD_PAGE_SIZE; page <= last / LVN_ECS_RECORD_PAGE_SIZE; page++)
+        lvn::getRecord(world, page * LVN_ECS_RECORD_PAGE_SIZE);
+
+    for (uint32_t i = 0; i < remaining; i++)
+        pEntities[created + i] = first + i;
+
+    world->entityIndexId = last;
+}
+
+void destroyEntity(LvnEcsWorld* world, LvnEntity entity)
+{
+    LvnEntityRecord* record = lvn::findRecord(world, entity);
+    LVN_CORE_ASSERT(record != nullptr, "entity (%llu) is not alive", static_cast<unsigned long long>(entity));
+    if (!record) { return; }
+
+    // only the archetype that holds the entity is touched
+    if (record->archetype)
+        lvn::moveEntity(world, entity, nullptr);
+
+    // the pending generation is kept for the handles of command buffers
+    if (++record->generation == LVN_ENTITY_PENDING_GENERATION)
+        record->generation = 0;
+    world->availableEntityIds.push(lvn::entityIndex(entity));
+}
+
+bool entityIsAlive(LvnEcsWorld* world, LvnEntity entity)
+{
+    return lvn::findRecord(world, entity) != nullptr;
+}
+
+void setMaxEntityIdCount(LvnEcsWorld* world, size_t max)
+{
+    LVN_CORE_ASSERT(max <= LVN_ENTITY_INDEX_MASK, "max entity count (%zu) does not fit in the entity index bits", max);
+    world->maxEntityIds = max;
+}
+
+size_t getMaxEntityIdCount(LvnEcsWorld* world)
+{
+    return world->maxEntityIds;
+}
+
+void* entityAddComponentStorage(LvnEcsWorld* world, LvnEntity entity, const LvnComponentInfo* info)
+{
+    LVN_CORE_ASSERT(lvn::entityIsAlive(world, entity), "entity (%llu) is not alive", static_cast<unsigned long long>(entity));
+
+    LvnEntityRecord& record = lvn::getRecord(world, entity);
+    LVN_CORE_ASSERT(!record.archetype || record.archetype->column_index(info->id) < 0, "entity already has component");
+
+    LvnArchetype* dst = lvn::getAddArchetype(world, record.archetype, info);
+    lvn::moveEntity(world, entity, dst);
+
+    LvnEntityRecord& moved = lvn::getRecord(world, entity);
+    return dst->component(dst->chunks[moved.chunk], dst->column_index(info->id), moved.row);
+}
+
+void entityAddComponentsId(LvnEcsWorld* world, const LvnEntity* pEntities, uint32_t count, const LvnComponentInfo* info, const void* pValues, LvnComponentCopyFunc copy)
+{
+    const uint8_t* values = static_cast<const uint8_t*>(pValues);
+
+    // rows of a destination archetype are only appended during the batch, so consecutive rows of one chunk are copied together
+    LvnArchetype* src = nullptr;
+    LvnArchetype* dst = nullptr;
+    uint8_t* runStorage = nullptr;
+    uint32_t runStart = 0, runChunk = 0, runRow = 0, runCount = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        LVN_CORE_ASSERT(lvn::entityIsAlive(world, pEntities[i]), "entity (%llu) is not alive", static_cast<unsigned long long>(pEntities[i]));
+
+        LvnEntityRecord& record = lvn::getRecord(world, pEntities[i]);
+        LVN_CORE_ASSERT(!record.archetype || record.archetype->column_index(info->id) < 0, "entity already has component");
+
+        // the destination is only looked up again when the source archetype changes
+        LvnArchetype* entitySrc = record.archetype;
+        LvnArchetype* entityDst = (i > 0 && entitySrc == src) ? dst : lvn::getAddArchetype(world, entitySrc, info);
+        lvn::moveEntity(world, pEntities[i], entityDst);
+
+        if (runCount > 0 && entityDst == dst && record.chunk == runChunk && record.row == runRow + runCount)
+        {
+            runCount++;
+            continue;
+        }
+
+        if (runCount > 0)
+            copy(runStorage, values + runStart * info->size, runCount);
+
+        src = entitySrc;
+        dst = entityDst;
+        runStorage = static_cast<uint8_t*>(dst->component(dst->chunks[record.chunk], dst->column_index(info->id), record.row));
+        runStart = i;
+        runChunk = record.chunk;
+        runRow = record.row;
+        runCount = 1;
+    }
+
+    if (runCount > 0)
+        copy(runStorage, values + runStart * info->size, runCount);
+}
+
+void entityRemoveComponentId(LvnEcsWorld* world, LvnEntity entity, LvnTypeId id)
+{
+    LVN_CORE_ASSERT(lvn::entityIsAlive(world, entity), "entity (%llu) is not alive", static_cast<unsigned long long>(entity));
+
+    LvnEntityRecord& record = lvn::getRecord(world, entity);
+    LVN_CORE_ASSERT(record.archetype && record.archetype->column_index(id) >= 0, "entity does not have component");
+
+    lvn::moveEntity(world, entity, lvn::getRemoveArchetype(world, record.archetype, id));
+}
+
+void* entityGetComponentId(LvnEcsWorld* world, LvnEntity entity, LvnTypeId id, bool markChanged)
+{
+    const LvnEntityRecord* record = lvn::findRecord(world, entity);
+    if (!record || !record->archetype) { return nullptr; }
+
+    int32_t column = record->archetype->column_index(id);
+    if (column < 0) { return nullptr; }
+
+    LvnArchetypeChunk& chunk = record->archetype->chunks[record->chunk];
+    if (markChanged)
+        lvn::internal::ecsMarkChanged(record->archetype, chunk, column, record->row, 1, world->changeTick);
+
+    return record->archetype->component(chunk, column, record->row);
+}
+
+const LvnEntityRecord& entityGetRecord(LvnEcsWorld* world, LvnEntity entity)
+{
+    LVN_CORE_ASSERT(lvn::entityIsAlive(world, entity), "entity (%llu) is not alive", static_cast<unsigned long long>(entity));
+    return lvn::getRecord(world, entity);
+}
+
+uint32_t ecsWorldGetTick(LvnEcsWorld* world)
+{
+    return world->changeTick;
+}
+
+uint32_t ecsWorldAdvanceTick(LvnEcsWorld* world)
+{
+    // 0 is kept for components that were never stamped
+    uint32_t tick = world->changeTick++;
+    if (world->changeTick == 0)
+        world->changeTick = 1;
+
+    return tick;
+}
+
+const LvnEcsRemovedComponent* ecsGetRemovedId(LvnEcsWorld* world, LvnTypeId id, uint32_t* count)
+{
+    if (id >= world->removedComponents.size())
+    {
+        *count = 0;
+        return nullptr;
+    }
+
+    *count = world->removedComponents[id].size();
+    return world->removedComponents[id].data();
+}
+
+void ecsWorldClearRemoved(LvnEcsWorld* world, uint32_t tick)
+{
+    for (uint32_t i = 0; i < world->removedComponents.size(); i++)
+    {
+        LvnVector<LvnEcsRemovedComponent>& removed = world->removedComponents[i];
+
+        // removals are appended in tick order so the old ones are at the front
+        uint32_t drop = 0;
+        while (drop < removed.size() && !lvn::internal::ecsTickNewer(removed[drop].tick, tick))
+            drop++;
+
+        if (drop == 0) { continue; }
+        for (uint32_t j = drop; j < removed.size(); j++)
+            removed[j - drop] = removed[j];
+        removed.resize(removed.size() - drop);
+    }
+}
+
+LvnEntity createEntity() { return lvn::createEntity(&s_EcsWorld); }
+void createEntities(LvnEntity* pEntities, uint32_t count) { lvn::createEntities(&s_EcsWorld, pEntities, count); }
+void destroyEntity(LvnEntity entity) { lvn::destroyEntity(&s_EcsWorld, entity); }
+bool entityIsAlive(LvnEntity entity) { return lvn::entityIsAlive(&s_EcsWorld, entity); }
+void setMaxEntityIdCount(size_t max) { lvn::setMaxEntityIdCount(&s_EcsWorld, max); }
+size_t getMaxEntityIdCount() { return lvn::getMaxEntityIdCount(&s_EcsWorld); }
+
+LvnEcsSchedule* ecsCreateSchedule()
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+    return new LvnEcsSchedule();
+}
+
+void ecsDestroySchedule(LvnEcsSchedule* schedule)
+{
+    for (uint32_t i = 0; i < schedule->systems.size(); i++)
+        delete schedule->systems[i];
+
+    delete schedule;
+}
+
+uint32_t ecsScheduleAddSystemId(LvnEcsSchedule* schedule, const char* name, const LvnTypeId* ids, const bool* writes, uint32_t count, void (*func)(), LvnEcsSystemChunkFunc runChunk)
+{
+    LVN_CORE_ASSERT(schedule != nullptr && func != nullptr && runChunk != nullptr, "invalid system");
+
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+    LvnEcsSystem* system = new LvnEcsSystem();
+    system->schedule = schedule;
+    system->name = name ? name : "";
+    system->profileName = lvn::profileInternString(system->name.c_str());
+    system->typeIds.insert(system->typeIds.end(), ids, count);
+    system->writes.insert(system->writes.end(), writes, count);
+    system->func = func;
+    system->runChunk = runChunk;
+    system->archetypeCount = 0;
+    system->generation = 0;
+    system->dependencyCount = 0;
+
+    // systems added earlier that conflict run first
+    uint32_t index = schedule->systems.size();
+    for (uint32_t i = 0; i < index; i++)
+    {
+        if (lvn::systemsConflict(schedule->systems[i], system))
+        {
+            schedule->systems[i]->dependents.push_back(index);
+            system->dependencyCount++;
+        }
+    }
+
+    schedule->systems.push_back(system);
+    return index;
+}
+
+void ecsScheduleRun(LvnEcsSchedule* schedule)
+{
+    lvn::ecsScheduleRun(schedule, &s_EcsWorld);
+}
+
+void ecsScheduleRun(LvnEcsSchedule* schedule, LvnEcsWorld* world)
+{
+    LVN_PROFILE_FUNCTION();
+
+    schedule->changeTick = world->changeTick;
+    schedule->world = world;
+
+    // chunks are gathered up front, the archetypes cannot change while the systems run
+    for (uint32_t i = 0; i < schedule->systems.size(); i++)
+    {
+        LvnEcsSystem* system = schedule->systems[i];
+        lvn::updateSystemMatches(system, world);
+
+        system->tasks.clear();
+        uint32_t typeCount = system->typeIds.size();
+        for (uint32_t j = 0; j < system->matches.size(); j++)
+        {
+            const LvnArchetype* archetype = system->matches[j];
+            for (uint32_t k = 0; k < archetype->chunks.size(); k++)
+            {
+                LvnEcsSystemTask task{};
+                task.system = system;
+                task.archetype = archetype;
+                task.chunk = &archetype->chunks[k];
+                task.columns = &system->matchColumns[j * typeCount];
+                task.offsets = &system->matchOffsets[j * typeCount];
+                system->tasks.push_back(task);
+            }
+        }
+
+        system->pendingDependencies.store(system->dependencyCount, std::memory_order_relaxed);
+        system->remainingTasks.store(system->tasks.size(), std::memory_order_relaxed);
+    }
+
+    for (uint32_t i = 0; i < schedule->systems.size(); i++)
+    {
+        if (schedule->systems[i]->dependencyCount == 0)
+            lvn::launchSystem(schedule->systems[i]);
+    }
+
+    lvn::jobWait(&schedule->counter);
+
+    // every system has finished, the changes they recorded can be applied
+    lvn::ecsWorldPlaybackCommands(world);
+}
+
+LvnEcsCommandBuffer* ecsGetCommandBuffer(LvnEcsWorld* world)
+{
+    // generations are unique across worlds and cleared worlds destroy their buffers, so a matching generation is a live buffer
+    if (s_ThreadCommandBuffer.buffer && s_ThreadCommandBuffer.generation == world->generation)
+        return s_ThreadCommandBuffer.buffer;
+
+    LvnSpinLockGaurd lock(world->commandBufferLock);
+
+    LvnEcsCommandBuffer* commands = nullptr;
+    for (uint32_t i = 0; i < world->commandBuffers.size(); i++)
+    {
+        if (world->commandBuffers[i]->thread == &s_ThreadKey)
+        {
+            commands = world->commandBuffers[i];
+            break;
+        }
+    }
+
+    if (!commands)
+    {
+        LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+        commands = new LvnEcsCommandBuffer();
+        commands->world = world;
+        commands->thread = &s_ThreadKey;
+        commands->currentBlock = 0;
+        commands->pendingCount = 0;
+        world->commandBuffers.push_back(commands);
+    }
+
+    s_ThreadCommandBuffer.generation = world->generation;
+    s_ThreadCommandBuffer.buffer = commands;
+    return commands;
+}
+
+LvnEcsCommandBuffer* ecsGetCommandBuffer()
+{
+    return lvn::ecsGetCommandBuffer(s_SystemWorld ? s_SystemWorld : &s_EcsWorld);
+}
+
+void ecsWorldPlaybackCommands(LvnEcsWorld* world)
+{
+    LVN_PROFILE_FUNCTION();
+
+    LvnVector<LvnEcsPlaybackItem> items;
+    size_t sequence = 0;
+
+    // pending entities are created first so every other command refers to a real entity
+    for (uint32_t i = 0; i < world->commandBuffers.size(); i++)
+    {
+        LvnEcsCommandBuffer* commands = world->commandBuffers[i];
+        commands->created.resize(commands->pendingCount);
+        if (commands->pendingCount > 0)
+            lvn::createEntities(world, commands->created.data(), commands->pendingCount);
+
+        for (uint32_t j = 0; j < commands->commands.size(); j++)
+        {
+            LvnEcsCommand& command = commands->commands[j];
+            if (lvn::entityIsPending(command.entity))
+            {
+                uint32_t index = lvn::entityIndex(command.entity);
+                LVN_CORE_ASSERT(index > 0 && index <= commands->pendingCount, "pending entity (%llu) was not created by this command buffer", static_cast<unsigned long long>(command.entity));
+                command.entity = (index > 0 && index <= commands->pendingCount) ? commands->created[index - 1] : 0;
+            }
+
+            items.push_back(LvnEcsPlaybackItem{ &command, 0, sequence++ });
+        }
+    }
+
+    // grouped by type and component so each group moves entities along the same few archetype edges
+    std::sort(items.begin(), items.end(), [](const LvnEcsPlaybackItem& a, const LvnEcsPlaybackItem& b)
+    {
+        if (a.command->type != b.command->type) { return a.command->type < b.command->type; }
+        if (a.command->id != b.command->id) { return a.command->id < b.command->id; }
+        return a.sequence < b.sequence;
+    });
+
+    for (size_t begin = 0; begin < items.size();)
+    {
+        const LvnEcsCommand* first = items[begin].command;
+        size_t end = begin + 1;
+        while (end < items.size() && items[end].command->type == first->type && items[end].command->id == first->id)
+            end++;
+
+        // the archetypes are read when the group starts since earlier groups move the entities
+        for (size_t i = begin; i < end; i++)
+        {
+            const LvnEntityRecord* record = lvn::findRecord(world, items[i].command->entity);
+            items[i].archetype = (record && record->archetype) ? record->archetype->index + 1 : 0;
+        }
+
+        std::sort(items.begin() + begin, items.begin() + end, [](const LvnEcsPlaybackItem& a, const LvnEcsPlaybackItem& b)
+        {
+            if (a.archetype != b.archetype) { return a.archetype < b.archetype; }
+            return a.sequence < b.sequence;
+        });
+
+        lvn::playbackCommandGroup(world, &items[begin], end - begin);
+        begin = end;
+    }
+
+    for (uint32_t i = 0; i < world->commandBuffers.size(); i++)
+    {
+        LvnEcsCommandBuffer* commands = world->commandBuffers[i];
+        for (uint32_t j = 0; j < commands->blocks.size(); j++)
+            commands->blocks[j].used = 0;
+
+        commands->commands.clear();
+        commands->currentBlock = 0;
+        commands->pendingCount = 0;
+    }
+}
+
+LvnEntity ecsCommandCreateEntity(LvnEcsCommandBuffer* commands)
+{
+    LVN_CORE_ASSERT(commands->pendingCount < LVN_ENTITY_INDEX_MASK, "cannot record more pending entities in one command buffer");
+    return (static_cast<LvnEntity>(LVN_ENTITY_PENDING_GENERATION) << LVN_ENTITY_INDEX_BITS) | ++commands->pendingCount;
+}
+
+void ecsCommandDestroyEntity(LvnEcsCommandBuffer* commands, LvnEntity entity)
+{
+    commands->commands.push_back(LvnEcsCommand{ entity, Lvn_EcsCommandType_DestroyEntity, 0, nullptr, nullptr });
+}
+
+void* ecsCommandAddComponentStorage(LvnEcsCommandBuffer* commands, LvnEntity entity, const LvnComponentInfo* info)
+{
+    void* value = lvn::commandAllocValue(commands, info->size, info->alignment);
+    commands->commands.push_back(LvnEcsCommand{ entity, Lvn_EcsCommandType_AddComponent, info->id, info, value });
+    return value;
+}
+
+void ecsCommandRemoveComponentId(LvnEcsCommandBuffer* commands, LvnEntity entity, LvnTypeId id)
+{
+    commands->commands.push_back(LvnEcsCommand{ entity, Lvn_EcsCommandType_RemoveComponent, id, nullptr, nullptr });
+}
+
+LvnEntity ecsCommandGetEntity(LvnEcsCommandBuffer* commands, LvnEntity pending)
+{
+    if (!lvn::entityIsPending(pending)) { return pending; }
+
+    uint32_t index = lvn::entityIndex(pending);
+    return (index > 0 && index <= commands->created.size()) ? commands->created[index - 1] : 0;
+}
+
+
+// fnv-1a, only used to tell whether a delta is applied to the snapshot it was made against
+static uint64_t hashBytes(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+static void writeBytes(LvnVector<uint8_t>& out, const void* data, size_t size)
+{
+    size_t offset = out.size();
+    out.resize_uninitialized(offset + size);
+    memcpy(out.data() + offset, data, size);
+}
+
+// seven bits per byte, the high bit is set on every byte but the last
+static void writeVarint(LvnVector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// nullptr if fewer than size bytes are left
+static const uint8_t* readBytes(LvnEcsReader* reader, size_t size)
+{
+    if (size > reader->size - reader->offset)
+        return nullptr;
+
+    const uint8_t* bytes = reader->data + reader->offset;
+    reader->offset += size;
+    return bytes;
+}
+
+static bool readVarint(LvnEcsReader* reader, uint64_t* value)
+{
+    *value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        const uint8_t* byte = lvn::readBytes(reader, 1);
+        if (!byte) { return false; }
+
+        *value |= static_cast<uint64_t>(*byte & 0x7f) << shift;
+        if (!(*byte & 0x80))
+            return true;
+    }
+
+    return false;
+}
+
+// reads the snapshot twice, once without apply to validate all of it so a bad snapshot never leaves the world half written
+static bool readSnapshot(LvnEcsWorld* world, const uint8_t* data, size_t size, bool apply)
+{
+    LvnEcsReader reader{ data, size, 0 };
+
+    LvnEcsSnapshotHeader header;
+    const uint8_t* bytes = lvn::readBytes(&reader, sizeof(LvnEcsSnapshotHeader));
+    if (!bytes) { return false; }
+    memcpy(&header, bytes, sizeof(LvnEcsSnapshotHeader));
+
+    if (header.magic != LVN_ECS_SNAPSHOT_MAGIC || header.version != LVN_ECS_SNAPSHOT_VERSION)
+    {
+        if (!apply) { LVN_CORE_ERROR("[ecs]: data is not an ecs snapshot or was written by a different version"); }
+        return false;
+    }
+    if (header.entityIndexId > world->maxEntityIds)
+    {
+        if (!apply) { LVN_CORE_ERROR("[ecs]: snapshot has more entity ids (%zu) than the world allows (%zu)", static_cast<size_t>(header.entityIndexId), world->maxEntityIds); }
+        return false;
+    }
+
+    // component types are matched by hash, the size guards against a type that changed without changing its name
+    LvnVector<const LvnComponentInfo*> types;
+    for (uint32_t i = 0; i < header.typeCount; i++)
+    {
+        LvnEcsSnapshotType type;
+        if (!(bytes = lvn::readBytes(&reader, sizeof(LvnEcsSnapshotType)))) { return false; }
+        memcpy(&type, bytes, sizeof(LvnEcsSnapshotType));
+
+        const LvnComponentInfo* info = nullptr;
+        for (uint32_t j = 0; j < world->componentInfos.size() && !info; j++)
+        {
+            const LvnComponentInfo* candidate = world->componentInfos[j];
+            if (candidate && candidate->hash == type.hash && candidate->size == type.size && candidate->triviallyCopyable)
+                info = candidate;
+        }
+
+        if (!info)
+        {
+            if (!apply) { LVN_CORE_ERROR("[ecs]: snapshot has a component type (hash: %llx) that is not registered with the world", static_cast<unsigned long long>(type.hash)); }
+            return false;
+        }
+
+        types.push_back(info);
+    }
+
+    const uint8_t* generations = lvn::readBytes(&reader, header.entityIndexId * sizeof(uint32_t));
+    const uint8_t* freeIds = lvn::readBytes(&reader, header.freeCount * sizeof(uint32_t));
+    if (!generations || !freeIds) { return false; }
+
+    for (uint32_t i = 0; i < header.freeCount; i++)
+    {
+        uint32_t index;
+        memcpy(&index, freeIds + i * sizeof(uint32_t), sizeof(uint32_t));
+        if (index == 0 || index > header.entityIndexId) { return false; }
+    }
+
+    if (apply)
+    {
+        for (uint32_t i = 1; i <= header.entityIndexId; i++)
+            memcpy(&lvn::getRecord(world, i).generation, generations + (i - 1) * sizeof(uint32_t), sizeof(uint32_t));
+
+        for (uint32_t i = 0; i < header.freeCount; i++)
+        {
+            uint32_t index;
+            memcpy(&index, freeIds + i * sizeof(uint32_t), sizeof(uint32_t));
+            world->availableEntityIds.push(index);
+        }
+
+        world->entityIndexId = header.entityIndexId;
+        world->changeTick = header.changeTick;
+    }
+
+    LvnVector<const uint8_t*> columns;
+    LvnVector<const LvnComponentInfo*> components;
+    for (uint32_t i = 0; i < header.archetypeCount; i++)
+    {
+        uint32_t componentCount;
+        if (!(bytes = lvn::readBytes(&reader, sizeof(uint32_t)))) { return false; }
+        memcpy(&componentCount, bytes, sizeof(uint32_t));
+
+        const uint8_t* typeIndices = lvn::readBytes(&reader, componentCount * sizeof(uint32_t));
+        if (componentCount == 0 || !typeIndices) { return false; }
+
+        // the archetype keeps its components sorted by the type ids of this run which can differ from the ones it was written with
+        components.clear();
+        for (uint32_t j = 0; j < componentCount; j++)
+        {
+            uint32_t typeIndex;
+            memcpy(&typeIndex, typeIndices + j * sizeof(uint32_t), sizeof(uint32_t));
+            if (typeIndex >= types.size()) { return false; }
+
+            const LvnComponentInfo* info = types[typeIndex];
+            uint32_t index = 0;
+            while (index < components.size() && components[index]->id < info->id)
+                index++;
+            if (index < components.size() && components[index]->id == info->id) { return false; }
+            components.insert_index(index, info);
+        }
+
+        uint64_t entityCount;
+        if (!(bytes = lvn::readBytes(&reader, sizeof(uint64_t)))) { return false; }
+        memcpy(&entityCount, bytes, sizeof(uint64_t));
+        if (entityCount > header.entityIndexId) { return false; }
+
+        const uint8_t* entities = lvn::readBytes(&reader, entityCount * sizeof(LvnEntity));
+        if (!entities) { return false; }
+
+        // values, added ticks and changed ticks of each component in the order they were written
+        columns.clear();
+        for (uint32_t j = 0; j < componentCount; j++)
+        {
+            uint32_t typeIndex;
+            memcpy(&typeIndex, typeIndices + j * sizeof(uint32_t), sizeof(uint32_t));
+
+            const uint8_t* values = lvn::readBytes(&reader, entityCount * types[typeIndex]->size);
+            const uint8_t* ticks = lvn::readBytes(&reader, entityCount * 2 * sizeof(uint32_t));
+            if (!values || !ticks) { return false; }
+
+            columns.push_back(values);
+            columns.push_back(ticks);
+        }
+
+        if (!apply)
+        {
+            for (uint64_t j = 0; j < entityCount; j++)
+            {
+                LvnEntity entity;
+                memcpy(&entity, entities + j * sizeof(LvnEntity), sizeof(LvnEntity));
+
+                uint32_t index = lvn::entityIndex(entity), generation;
+                if (index == 0 || index > header.entityIndexId) { return false; }
+                memcpy(&generation, generations + (index - 1) * sizeof(uint32_t), sizeof(uint32_t));
+                if (generation != lvn::entityGeneration(entity)) { return false; }
+            }
+
+            continue;
+        }
+
+        LvnArchetype* archetype = lvn::findArchetype(world, components);
+        if (!archetype)
+            archetype = lvn::createArchetype(world, components);
+
+        // rows are copied a chunk at a time, the chunks of this world can hold a different number of rows than the ones written
+        size_t done = 0;
+        while (done < entityCount)
+        {
+            uint32_t chunkIndex, first;
+            uint32_t count = lvn::archetypePushRows(archetype, entityCount - done, &chunkIndex, &first);
+            LvnArchetypeChunk& chunk = archetype->chunks[chunkIndex];
+
+            memcpy(chunk.entities() + first, entities + done * sizeof(LvnEntity), count * sizeof(LvnEntity));
+            for (uint32_t j = 0; j < componentCount; j++)
+            {
+                uint32_t typeIndex;
+                memcpy(&typeIndex, typeIndices + j * sizeof(uint32_t), sizeof(uint32_t));
+
+                const LvnComponentInfo* info = types[typeIndex];
+                uint32_t column = static_cast<uint32_t>(archetype->column_index(info->id));
+                const uint8_t* ticks = columns[j * 2 + 1];
+
+                memcpy(archetype->component(chunk, column, first), columns[j * 2] + done * info->size, count * info->size);
+                for (uint32_t k = 0; k < count; k++)
+                {
+                    uint32_t added, changed;
+                    memcpy(&added, ticks + (done + k) * sizeof(uint32_t), sizeof(uint32_t));
+                    memcpy(&changed, ticks + (entityCount + done + k) * sizeof(uint32_t), sizeof(uint32_t));
+                    lvn::setComponentTicks(archetype, chunk, column, first + k, added, changed);
+                }
+            }
+
+            for (uint32_t j = 0; j < count; j++)
+            {
+                LvnEntityRecord& record = lvn::getRecord(world, chunk.entities()[first + j]);
+                record.archetype = archetype;
+                record.chunk = chunkIndex;
+                record.row = first + j;
+            }
+
+            done += count;
+        }
+    }
+
+    return reader.offset == reader.size;
+}
+
+LvnResult ecsWorldCopy(LvnEcsWorld* dst, const LvnEcsWorld* src)
+{
+    LVN_CORE_ASSERT(dst != src, "cannot copy a world into itself");
+
+    for (uint32_t i = 0; i < src->archetypes.size(); i++)
+    {
+        const LvnArchetype* archetype = src->archetypes[i];
+        for (uint32_t j = 0; j < archetype->components.size(); j++)
+        {
+            if (!archetype->components[j]->copyConstruct)
+            {
+                LVN_CORE_ERROR("[ecs]: cannot copy world, component type (hash: %llx) is not copy constructible", static_cast<unsigned long long>(archetype->components[j]->hash));
+                return Lvn_Result_Failure;
+            }
+        }
+    }
+
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+    size_t maxEntityIds = src->maxEntityIds;
+    lvn::ecsWorldClear(dst);
+
+    for (uint32_t i = 0; i < src->componentInfos.size(); i++)
+    {
+        if (src->componentInfos[i])
+            lvn::ecsRegisterComponentInfo(dst, src->componentInfos[i]);
+    }
+
+    // the same components in the same order give the same chunk layout so chunks are copied as they are
+    for (uint32_t i = 0; i < src->archetypes.size(); i++)
+    {
+        const LvnArchetype* archetype = src->archetypes[i];
+        LvnArchetype* copy = lvn::createArchetype(dst, archetype->components);
+
+        bool trivial = true;
+        for (uint32_t j = 0; j < archetype->components.size(); j++)
+            trivial = trivial && archetype->components[j]->triviallyCopyable;
+
+        for (uint32_t j = 0; j < archetype->chunks.size(); j++)
+        {
+            const LvnArchetypeChunk& chunk = archetype->chunks[j];
+
+            LvnArchetypeChunk newChunk{};
+            newChunk.memory = static_cast<uint8_t*>(lvn::memAllocAligned(archetype->chunkSize, LVN_ECS_CHUNK_ALIGNMENT));
+            newChunk.count = chunk.count;
+
+            if (trivial)
+            {
+                memcpy(newChunk.memory, chunk.memory, archetype->chunkSize);
+            }
+            else
+            {
+                // the entities and the ticks after the columns are plain data
+                memcpy(newChunk.memory, chunk.memory, chunk.count * sizeof(LvnEntity));
+                memcpy(newChunk.memory + archetype->tickOffsets[0], chunk.memory + archetype->tickOffsets[0], archetype->chunkSize - archetype->tickOffsets[0]);
+
+                for (uint32_t k = 0; k < archetype->components.size(); k++)
+                    archetype->components[k]->copyConstruct(copy->component(newChunk, k, 0), archetype->component(chunk, k, 0), chunk.count);
+            }
+
+            copy->chunks.push_back(newChunk);
+        }
+
+        copy->entityCount = archetype->entityCount;
+    }
+
+    // records point into the archetypes of the source, the copies are at the same index
+    dst->recordPages.resize(src->recordPages.size(), nullptr);
+    for (uint32_t i = 0; i < src->recordPages.size(); i++)
+    {
+        if (!src->recordPages[i]) { continue; }
+
+        LvnEntityRecord* page = static_cast<LvnEntityRecord*>(lvn::memAlloc(LVN_ECS_RECORD_PAGE_SIZE * sizeof(LvnEntityRecord)));
+        memcpy(page, src->recordPages[i], LVN_ECS_RECORD_PAGE_SIZE * sizeof(LvnEntityRecord));
+        for (uint32_t j = 0; j < LVN_ECS_RECORD_PAGE_SIZE; j++)
+        {
+            if (page[j].archetype)
+                page[j].archetype = dst->archetypes[page[j].archetype->index];
+        }
+
+        dst->recordPages[i] = page;
+    }
+
+    dst->availableEntityIds = src->availableEntityIds;
+    dst->entityIndexId = src->entityIndexId;
+    dst->maxEntityIds = maxEntityIds;
+    dst->changeTick = src->changeTick;
+    dst->removedComponents = src->removedComponents;
+
+    return Lvn_Result_Success;
+}
+
+LvnEcsWorld* ecsCloneWorld(const LvnEcsWorld* src)
+{
+    LvnEcsWorld* world = lvn::ecsCreateWorld();
+    if (lvn::ecsWorldCopy(world, src) != Lvn_Result_Success)
+    {
+        lvn::ecsDestroyWorld(world);
+        return nullptr;
+    }
+
+    return world;
+}
+
+void ecsRegisterComponentInfo(LvnEcsWorld* world, const LvnComponentInfo* info)
+{
+    if (info->id >= world->componentInfos.size())
+        world->componentInfos.resize(info->id + 1, nullptr);
+
+    world->componentInfos[info->id] = info;
+}
+
+LvnBin ecsWorldSerialize(const LvnEcsWorld* world)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+    // component types are written once, archetypes refer to them by their index in the type table
+    LvnVector<const LvnComponentInfo*> types;
+    LvnVector<uint32_t> typeIndices;
+    typeIndices.resize(world->componentInfos.size(), UINT32_MAX);
+
+    uint32_t archetypeCount = 0;
+    for (uint32_t i = 0; i < world->archetypes.size(); i++)
+    {
+        const LvnArchetype* archetype = world->archetypes[i];
+        if (archetype->entityCount == 0) { continue; }
+
+        archetypeCount++;
+        for (uint32_t j = 0; j < archetype->components.size(); j++)
+        {
+            const LvnComponentInfo* info = archetype->components[j];
+            if (typeIndices[info->id] != UINT32_MAX) { continue; }
+
+            if (!info->triviallyCopyable)
+            {
+                LVN_CORE_ERROR("[ecs]: cannot serialize world, component type (hash: %llx) is not trivially copyable", static_cast<unsigned long long>(info->hash));
+                return LvnBin();
+            }
+
+            typeIndices[info->id] = types.size();
+            types.push_back(info);
+        }
+    }
+
+    LvnQueue<uint32_t> freeIds = world->availableEntityIds;
+
+    LvnEcsSnapshotHeader header{};
+    header.magic = LVN_ECS_SNAPSHOT_MAGIC;
+    header.version = LVN_ECS_SNAPSHOT_VERSION;
+    header.entityIndexId = world->entityIndexId;
+    header.changeTick = world->changeTick;
+    header.typeCount = types.size();
+    header.archetypeCount = archetypeCount;
+    header.freeCount = freeIds.size();
+
+    LvnVector<uint8_t> out;
+    lvn::writeBytes(out, &header, sizeof(LvnEcsSnapshotHeader));
+
+    for (uint32_t i = 0; i < types.size(); i++)
+    {
+        LvnEcsSnapshotType type{ types[i]->hash, types[i]->size };
+        lvn::writeBytes(out, &type, sizeof(LvnEcsSnapshotType));
+    }
+
+    for (size_t i = 1; i <= world->entityIndexId; i++)
+    {
+        const LvnEntityRecord* page = world->recordPages[i / LVN_ECS_RECORD_PAGE_SIZE];
+        uint32_t generation = page ? page[i % LVN_ECS_RECORD_PAGE_SIZE].generation : 0;
+        lvn::writeBytes(out, &generation, sizeof(uint32_t));
+    }
+
+    while (!freeIds.empty())
+    {
+        lvn::writeBytes(out, &freeIds.front(), sizeof(uint32_t));
+        freeIds.pop();
+    }
+
+    // columns are written whole across chunks so a snapshot does not depend on how many rows a chunk holds
+    for (uint32_t i = 0; i < world->archetypes.size(); i++)
+    {
+        const LvnArchetype* archetype = world->archetypes[i];
+        if (archetype->entityCount == 0) { continue; }
+
+        uint32_t componentCount = archetype->components.size();
+        lvn::writeBytes(out, &componentCount, sizeof(uint32_t));
+        for (uint32_t j = 0; j < componentCount; j++)
+            lvn::writeBytes(out, &typeIndices[archetype->components[j]->id], sizeof(uint32_t));
+
+        uint64_t entityCount = archetype->entityCount;
+        lvn::writeBytes(out, &entityCount, sizeof(uint64_t));
+        for (uint32_t j = 0; j < archetype->chunks.size(); j++)
+            lvn::writeBytes(out, archetype->chunks[j].entities(), archetype->chunks[j].count * sizeof(LvnEntity));
+
+        for (uint32_t j = 0; j < componentCount; j++)
+        {
+            for (uint32_t k = 0; k < archetype->chunks.size(); k++)
+                lvn::writeBytes(out, archetype->component(archetype->chunks[k], j, 0), archetype->chunks[k].count * archetype->components[j]->size);
+            for (uint32_t k = 0; k < archetype->chunks.size(); k++)
+                lvn::writeBytes(out, archetype->added_ticks(archetype->chunks[k], j), archetype->chunks[k].count * sizeof(uint32_t));
+            for (uint32_t k = 0; k < archetype->chunks.size(); k++)
+                lvn::writeBytes(out, archetype->changed_ticks(archetype->chunks[k], j), archetype->chunks[k].count * sizeof(uint32_t));
+        }
+    }
+
+    return LvnBin(static_cast<LvnVector<uint8_t>&&>(out));
+}
+
+LvnResult ecsWorldDeserialize(LvnEcsWorld* world, const uint8_t* data, size_t size)
+{
+    if (!lvn::readSnapshot(world, data, size, false))
+    {
+        LVN_CORE_ERROR("[ecs]: failed to deserialize world, snapshot is truncated or corrupt");
+        return Lvn_Result_Failure;
+    }
+
+    size_t maxEntityIds = world->maxEntityIds;
+    lvn::ecsWorldClear(world);
+    world->maxEntityIds = maxEntityIds;
+
+    lvn::readSnapshot(world, data, size, true);
+    return Lvn_Result_Success;
+}
+
+LvnBin ecsSnapshotDelta(const LvnBin& base, const LvnBin& snapshot)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+    const uint8_t* baseData = base.data();
+    const uint8_t* data = snapshot.data();
+    size_t size = snapshot.size();
+    size_t shared = base.size() < size ? base.size() : size;
+
+    LvnEcsDeltaHeader header{};
+    header.magic = LVN_ECS_DELTA_MAGIC;
+    header.baseHash = lvn::hashBytes(baseData, base.size());
+    header.baseSize = base.size();
+    header.size = size;
+
+    LvnVector<uint8_t> out;
+    lvn::writeBytes(out, &header, sizeof(LvnEcsDeltaHeader));
+
+    // bytes past the end of base always differ
+    size_t offset = 0;
+    while (true)
+    {
+        size_t start = offset;
+        while (start + sizeof(uint64_t) <= shared && memcmp(data + start, baseData + start, sizeof(uint64_t)) == 0)
+            start += sizeof(uint64_t);
+        while (start < shared && data[start] == baseData[start])
+            start++;
+
+        if (start == size) { break; }
+
+        // the run of changed bytes takes in short equal gaps, each op costs at least two bytes
+        size_t end = start + 1;
+        for (size_t next = end; next < size && next - end < LVN_ECS_DELTA_MERGE_GAP; next++)
+        {
+            if (next >= shared || data[next] != baseData[next])
+                end = next + 1;
+        }
+
+        lvn::writeVarint(out, start - offset);
+        lvn::writeVarint(out, end - start);
+        lvn::writeBytes(out, data + start, end - start);
+        offset = end;
+    }
+
+    return LvnBin(static_cast<LvnVector<uint8_t>&&>(out));
+}
+
+LvnResult ecsSnapshotApplyDelta(const LvnBin& base, const uint8_t* delta, size_t size, LvnBin* snapshot)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Ecs);
+
+    LvnEcsReader reader{ delta, size, 0 };
+
+    LvnEcsDeltaHeader header;
+    const uint8_t* bytes = lvn::readBytes(&reader, sizeof(LvnEcsDeltaHeader));
+    if (!bytes)
+    {
+        LVN_CORE_ERROR("[ecs]: failed to apply snapshot delta, delta is truncated");
+        return Lvn_Result_Failure;
+    }
+    memcpy(&header, bytes, sizeof(LvnEcsDeltaHeader));
+
+    if (header.magic != LVN_ECS_DELTA_MAGIC)
+    {
+        LVN_CORE_ERROR("[ecs]: failed to apply snapshot delta, data is not a snapshot delta");
+        return Lvn_Result_Failure;
+    }
+    if (header.baseSize != base.size() || header.baseHash != lvn::hashBytes(base.data(), base.size()))
+    {
+        LVN_CORE_ERROR("[ecs]: failed to apply snapshot delta, base is not the snapshot the delta was made against");
+        return Lvn_Result_Failure;
+    }
+
+    LvnVector<uint8_t> out;
+    out.resize_uninitialized(header.size);
+    memcpy(out.data(), base.data(), header.size < base.size() ? header.size : base.size());
+
+    size_t offset = 0;
+    while (reader.offset < reader.size)
+    {
+        uint64_t skip, length;
+        if (!lvn::readVarint(&reader, &skip) || !lvn::readVarint(&reader, &length) ||
+            skip > header.size - offset || length > header.size - offset - skip || !(bytes = lvn::readBytes(&reader, length)))
+        {
+            LVN_CORE_ERROR("[ecs]: failed to apply snapshot delta, delta is truncated or corrupt");
+            return Lvn_Result_Failure;
+        }
+
+        offset += skip;
+        memcpy(out.data() + offset, bytes, length);
+        offset += length;
+    }
+
+    *snapshot = LvnBin(static_cast<LvnVector<uint8_t>&&>(out));
+    return Lvn_Result_Success;
 }
 
 } /* namespace lvn */
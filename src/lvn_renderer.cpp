@@ -3,11 +3,22 @@
 #include "levikno.h"
 #include "levikno_internal.h"
 
+#include <atomic>
+
 
 #define LVN_ARRAY_LEN(x) (sizeof(x) / sizeof(x[0]))
 
 #define LVN_CONFIG_GLYPH(ux0,uy0,ux1,uy1,bx,by,u,a) {{ux0/128.0f,uy0/128.0f,ux1/128.0f,uy1/128.0f},{ux1-ux0,uy1-uy0},{bx,by},u,a}
 
+#define LVN_RENDER_MODE_INIT_VERTEX_COUNT 5000
+#define LVN_RENDER_MODE_INIT_INDEX_COUNT 5000
+#define LVN_UNIFORM_OFFSET_ALIGNMENT 256 // largest minUniformBufferOffsetAlignment allowed by the vulkan spec
+#define LVN_RENDER_MODE_TEXTURE_SLOTS 16 // textures per sprite batch, the minimum sampler count per shader stage in vulkan and opengl, must match the sprite shaders
+#define LVN_RENDER_MODE_TEXTURE_BATCHES 4 // sprite batches per frame, each batch draws with its own descriptor set
+#define LVN_TEXT_LAYOUT_CACHE_MAX 512 // cached text layouts before the cache is cleared in drawBegin
+#define LVN_RENDER_DEFAULT_SORT_KEY (0x80000000ull << 32) // layer zero and the first texture batch
+#define LVN_PARTICLE_GROUP_SIZE 256 // must match local_size_x of the particle compute shader
+
 static const char* s_VertexShaderSrc = R"(
 #version 460
 
@@ -26,15 +37,135 @@ layout (binding = 0) uniform ObjectBuffer
     mat4 u_ViewMat;
 };
 
+layout(push_constant) uniform PushConstants
+{
+    mat4 u_Model; // transform of a static batch, identity for the geometry of the frame
+};
+
 void main()
 {
-    gl_Position = u_ProjMat * u_ViewMat * vec4(inPos, 0.0, 1.0);
+    gl_Position = u_ProjMat * u_ViewMat * u_Model * vec4(inPos, 0.0, 1.0);
     fragColor = inColor;
     fragTexCoord = inTexCoord;
     fragTexId = inTexId;
 }
 )";
 
+// unit quad corners are expanded per instance, the outputs match s_VertexShaderSrc so the same fragment shaders are used
+static const char* s_VertexShaderQuadSrc = R"(
+#version 460
+
+layout(location = 0) in vec2 inCorner;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in vec4 inTexRect;
+layout(location = 3) in float inTexId;
+layout(location = 4) in vec4 inRect;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out float fragTexId;
+
+layout (binding = 0) uniform ObjectBuffer
+{
+    mat4 u_ProjMat;
+    mat4 u_ViewMat;
+};
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 u_Model; // transform of a static batch, identity for the geometry of the frame
+};
+
+void main()
+{
+    gl_Position = u_ProjMat * u_ViewMat * u_Model * vec4(inRect.xy + inCorner * inRect.zw, 0.0, 1.0);
+    fragColor = inColor;
+    fragTexCoord = mix(inTexRect.xy, inTexRect.zw, inCorner);
+    fragTexId = inTexId;
+}
+)";
+
+// sprites index into an array of textures, instances that belong to another batch are moved outside the clip volume
+static const char* s_VertexShaderSpriteSrc = R"(
+#version 460
+
+layout(location = 0) in vec2 inCorner;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in vec4 inTexRect;
+layout(location = 3) in float inTexId;
+layout(location = 4) in vec4 inRect;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out int fragTexIndex;
+
+layout (binding = 0) uniform ObjectBuffer
+{
+    mat4 u_ProjMat;
+    mat4 u_ViewMat;
+    int u_TextureBase;
+};
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 u_Model; // transform of a static batch, identity for the geometry of the frame
+};
+
+void main()
+{
+    int texIndex = int(inTexId) - u_TextureBase;
+    if (texIndex < 0 || texIndex >= 16)
+    {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    gl_Position = u_ProjMat * u_ViewMat * u_Model * vec4(inRect.xy + inCorner * inRect.zw, 0.0, 1.0);
+    fragColor = inColor;
+    fragTexCoord = mix(inTexRect.xy, inTexRect.zw, inCorner);
+    fragTexIndex = texIndex;
+}
+)";
+
+// each case uses a constant index so the lookup does not need non uniform descriptor indexing
+static const char* s_FragmentShaderSpriteSrc = R"(
+#version 460
+
+layout(location = 0) out vec4 outColor;
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in int fragTexIndex;
+
+layout(binding = 1) uniform sampler2D inTextures[16];
+
+void main()
+{
+    vec4 texColor;
+    switch (fragTexIndex)
+    {
+        case 0: texColor = texture(inTextures[0], fragTexCoord); break;
+        case 1: texColor = texture(inTextures[1], fragTexCoord); break;
+        case 2: texColor = texture(inTextures[2], fragTexCoord); break;
+        case 3: texColor = texture(inTextures[3], fragTexCoord); break;
+        case 4: texColor = texture(inTextures[4], fragTexCoord); break;
+        case 5: texColor = texture(inTextures[5], fragTexCoord); break;
+        case 6: texColor = texture(inTextures[6], fragTexCoord); break;
+        case 7: texColor = texture(inTextures[7], fragTexCoord); break;
+        case 8: texColor = texture(inTextures[8], fragTexCoord); break;
+        case 9: texColor = texture(inTextures[9], fragTexCoord); break;
+        case 10: texColor = texture(inTextures[10], fragTexCoord); break;
+        case 11: texColor = texture(inTextures[11], fragTexCoord); break;
+        case 12: texColor = texture(inTextures[12], fragTexCoord); break;
+        case 13: texColor = texture(inTextures[13], fragTexCoord); break;
+        case 14: texColor = texture(inTextures[14], fragTexCoord); break;
+        default: texColor = texture(inTextures[15], fragTexCoord); break;
+    }
+
+    outColor = fragColor * texColor;
+}
+)";
+
 static const char* s_FragmentShaderSrc = R"(
 #version 460
 
@@ -52,6 +183,26 @@ void main()
 }
 )";
 
+// circles are drawn as instanced quads, texture coordinates span the quad and fragments outside the inscribed circle are discarded
+static const char* s_FragmentShaderCircleSrc = R"(
+#version 460
+
+layout(location = 0) out vec4 outColor;
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) in float fragTexId;
+
+void main()
+{
+    vec2 p = fragTexCoord * 2.0 - 1.0;
+    if (dot(p, p) > 1.0)
+        discard;
+
+    outColor = fragColor;
+}
+)";
+
 static const char* s_FragmentShaderFontSrc = R"(
 #version 460
 
@@ -70,34 +221,380 @@ void main()
 }
 )";
 
+static const char* s_FragmentShaderFontSdfSrc = R"(
+#version 460
+
+layout(location = 0) out vec4 outColor;
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) in float fragTexId;
+
+layout(binding = 1) uniform sampler2D inTexture;
+
+void main()
+{
+    // the glyph edge is at 0.5, smooth over one screen pixel at any scale
+    float dist = texture(inTexture, fragTexCoord).r;
+    float width = fwidth(dist);
+    float text = smoothstep(0.5 - width, 0.5 + width, dist);
+    outColor = vec4(vec3(text) * fragColor.rgb, text);
+}
+)";
+
+// every particle is visited each step, the slots after the spawn base are respawned and the rest are integrated
+static const char* s_ComputeShaderParticleSrc = R"(
+#version 460
+
+// matches LvnParticleUniformData, the emitter array has LVN_PARTICLE_MAX_EMITTERS entries
+struct LvnParticleEmitter
+{
+    vec4 posVel;     // position, velocity
+    vec4 variance;   // position variance, velocity variance
+    vec4 accelLife;  // acceleration, lifetime, lifetime variance
+    vec4 size;       // start size, end size
+    vec4 startColor;
+    vec4 endColor;
+    uvec4 spawn;     // first spawn slot relative to the spawn base, spawn count
+};
+
+layout (binding = 0) uniform ParticleBuffer
+{
+    mat4 u_ProjMat;
+    float u_Dt;
+    uint u_Seed;
+    uvec4 u_Spawn;   // max particles, spawn base, spawn count, emitter count
+    LvnParticleEmitter u_Emitters[16];
+};
+
+layout(local_size_x = 256) in;
+
+struct LvnParticle
+{
+    vec2 pos;
+    vec2 vel;
+    vec4 state;      // age, lifetime, emitter, unused
+};
+
+layout(std430, binding = 1) buffer ParticleData
+{
+    LvnParticle particles[];
+};
+
+uint hash(uint x)
+{
+    x ^= x >> 16; x *= 0x7feb352du;
+    x ^= x >> 15; x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// uniform random value in [-1, 1]
+float random(inout uint state)
+{
+    state = hash(state);
+    return float(state) * (2.0 / 4294967295.0) - 1.0;
+}
+
+void main()
+{
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= u_Spawn.x)
+        return;
+
+    uint slot = (i + u_Spawn.x - u_Spawn.y) % u_Spawn.x;
+    if (slot < u_Spawn.z)
+    {
+        // the spawn ranges of the emitters follow each other
+        uint e = 0;
+        while (e + 1 < u_Spawn.w && slot >= u_Emitters[e].spawn.x + u_Emitters[e].spawn.y)
+            e++;
+
+        LvnParticleEmitter emitter = u_Emitters[e];
+        uint state = hash(i ^ u_Seed);
+
+        LvnParticle particle;
+        particle.pos = emitter.posVel.xy + vec2(random(state), random(state)) * emitter.variance.xy;
+        particle.vel = emitter.posVel.zw + vec2(random(state), random(state)) * emitter.variance.zw;
+        particle.state = vec4(0.0, max(emitter.accelLife.z + random(state) * emitter.accelLife.w, 0.0), float(e), 0.0);
+        particles[i] = particle;
+        return;
+    }
+
+    LvnParticle particle = particles[i];
+    if (particle.state.x >= particle.state.y)
+        return;
+
+    particle.vel += u_Emitters[uint(particle.state.z)].accelLife.xy * u_Dt;
+    particle.pos += particle.vel * u_Dt;
+    particle.state.x += u_Dt;
+    particles[i] = particle;
+}
+)";
+
+// the particle buffer is read per instance, dead particles are moved outside the clip volume, the outputs match s_FragmentShaderCircleSrc
+static const char* s_VertexShaderParticleSrc = R"(
+#version 460
+
+// matches LvnParticleUniformData, the emitter array has LVN_PARTICLE_MAX_EMITTERS entries
+struct LvnParticleEmitter
+{
+    vec4 posVel;     // position, velocity
+    vec4 variance;   // position variance, velocity variance
+    vec4 accelLife;  // acceleration, lifetime, lifetime variance
+    vec4 size;       // start size, end size
+    vec4 startColor;
+    vec4 endColor;
+    uvec4 spawn;     // first spawn slot relative to the spawn base, spawn count
+};
+
+layout (binding = 0) uniform ParticleBuffer
+{
+    mat4 u_ProjMat;
+    float u_Dt;
+    uint u_Seed;
+    uvec4 u_Spawn;   // max particles, spawn base, spawn count, emitter count
+    LvnParticleEmitter u_Emitters[16];
+};
+
+layout(location = 0) in vec2 inCorner;
+layout(location = 1) in vec4 inMotion; // position, velocity
+layout(location = 2) in vec4 inState;  // age, lifetime, emitter, unused
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out float fragTexId;
+
+void main()
+{
+    fragTexCoord = inCorner;
+    fragTexId = 0.0;
+
+    if (inState.x >= inState.y)
+    {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        fragColor = vec4(0.0);
+        return;
+    }
+
+    LvnParticleEmitter emitter = u_Emitters[uint(inState.z)];
+    float t = inState.x / inState.y;
+    float size = mix(emitter.size.x, emitter.size.y, t);
+
+    gl_Position = u_ProjMat * vec4(inMotion.xy + (inCorner - 0.5) * size, 0.0, 1.0);
+    fragColor = mix(emitter.startColor, emitter.endColor, t);
+}
+)";
+
+// reservation counters for geometry written directly into the mapped buffer, copyable so render modes can be stored in a vector
+struct LvnRenderModeCursor
+{
+    std::atomic<uint64_t> vertexCount{0};
+    std::atomic<uint64_t> indexCount{0};
+    std::atomic<bool> overflow{false};
+
+    LvnRenderModeCursor() = default;
+    LvnRenderModeCursor(const LvnRenderModeCursor& other) : vertexCount(other.vertexCount.load()), indexCount(other.indexCount.load()), overflow(other.overflow.load()) {}
+    LvnRenderModeCursor& operator=(const LvnRenderModeCursor& other) { vertexCount = other.vertexCount.load(); indexCount = other.indexCount.load(); overflow = other.overflow.load(); return *this; }
+
+    void reset() { vertexCount = 0; indexCount = 0; overflow = false; }
+};
+
 struct LvnRenderMode
 {
     using LvnRenderModeFunc = void (*)(LvnRenderer*, LvnRenderMode&);
+    using LvnRenderModeDrawFunc = void (*)(LvnRenderer*, LvnRenderMode&, uint64_t, uint64_t);
 
     LvnRenderModeEnum modes;
-    LvnDrawList drawList;
+    LvnDrawList recordDrawList; // draws of the frame being recorded, swapped into drawList when drawEnd hands the frame over
+    LvnDrawList drawList;       // draws of the frame being submitted
+    LvnDrawList batchDrawList;  // draws of the frame set aside while a static batch is recorded into recordDrawList
+    uint8_t* batchMappedData;   // mappedData set aside while a static batch is recorded
+    bool staticDrawn;           // static batches draw geometry of this render mode in the frame being submitted
+
+    uint8_t* mappedData; // current frame region of the buffer when writing directly, null when draws go through the draw list
+    LvnRenderModeCursor cursor;
+    uint64_t vertexCount; // geometry to draw this frame, set when the render mode is prepared
+    uint64_t indexCount;
+
+    // draw list data reordered by sort key, only used when the submission order does not match the sorted order
+    LvnVector<uint8_t> sortedVertices;
+    LvnVector<uint32_t> sortedIndices;
+    bool sorted;
 
     LvnPipeline* pipeline;
     LvnDescriptorLayout* descriptorLayout;
     LvnDescriptorSet* descriptorSet;
     LvnBuffer* buffer;
+    LvnBuffer* quadBuffer; // static unit quad for instanced render modes, null otherwise
+    const LvnTexture* texture;
+    uint64_t vertexStride; // size of a vertex, or of an instance for instanced render modes
+    uint64_t uniformSize;
+    uint64_t uniformStride; // uniform size aligned to LVN_UNIFORM_OFFSET_ALIGNMENT, one uniform per texture batch
+
+    LvnVector<LvnDescriptorSet*> batchDescriptorSets; // texture batched render modes only, one set per batch
+    LvnVector<const LvnTexture*> recordBatchTextures; // textures referenced by the frame being recorded, the texture slot is the index
+    LvnVector<const LvnTexture*> batchTextures;       // textures referenced by the frame being submitted
+    LvnVector<const LvnTexture*> boundTextures;       // textures last written to the batch descriptor sets
 
     uint64_t maxVertexCount;
     uint64_t maxIndexCount;
     uint64_t indexOffset;
     uint64_t uniformOffset;
 
-    LvnRenderModeFunc drawFunc;
+    LvnRenderModeFunc updateFunc; // writes uniforms and descriptor sets before the first draw of the frame
+    LvnRenderModeDrawFunc drawFunc; // draws a range of indices, or of instances for instanced render modes
+};
+
+// a draw within a render mode, packets of all render modes are sorted together at drawEnd
+// key layout from high to low bits: layer (32), render mode (16), texture batch (16)
+struct LvnRenderPacket
+{
+    uint64_t sortKey;
+    uint32_t renderMode;
+    uint32_t command;    // index into the draw list commands, UINT32_MAX for geometry written directly to the buffer
+    uint32_t staticDraw; // index into the static batch draws of the frame, UINT32_MAX for geometry of the frame
+    uint32_t particleDraw; // index into the particle system draws of the frame, UINT32_MAX otherwise
+    uint32_t clip;       // clip rect of the draw starting at one, zero draws to the whole render area
+    uint64_t first;      // first index, or first instance for instanced render modes
+    uint64_t count;
+};
+
+// geometry of one render mode within a static batch
+struct LvnStaticBatchPart
+{
+    uint64_t vertexOffset; // offset of the vertices, or instances for instanced render modes, in the batch buffer
+    uint64_t indexOffset;
+    uint64_t count;        // indices, or instances for instanced render modes
+};
+
+// draws recorded once into a static buffer, drawn every frame without generating vertices again
+struct LvnStaticBatch
+{
+    LvnRenderer* renderer; // the pipelines of this renderer draw the batch
+    LvnBuffer* buffer;     // null when nothing was recorded
+    LvnStaticBatchPart parts[Lvn_RenderMode_Max_Value];
+};
+
+struct LvnStaticBatchDraw
+{
+    const LvnStaticBatch* batch;
+    LvnMat4 transform;
+    uint64_t sortKey; // layer of the draw, the batch is drawn after the geometry of the frame on the same layer and render mode
+};
+
+// particles are read by the compute shader as a storage buffer and by the vertex shader as instances, matches LvnParticle of the shaders
+struct LvnParticleData
+{
+    LvnVec2 pos;
+    LvnVec2 vel;
+    LvnVec4 state; // age, lifetime, emitter, unused
+};
+
+struct LvnParticleEmitterData
+{
+    LvnVec4 posVel;
+    LvnVec4 variance;
+    LvnVec4 accelLife;
+    LvnVec4 size;
+    LvnVec4 startColor;
+    LvnVec4 endColor;
+    uint32_t spawnFirst, spawnCount, reserved[2];
+};
+
+// std140 layout of the ParticleBuffer uniform block
+struct LvnParticleUniformData
+{
+    LvnMat4 projMat;
+    float dt;
+    uint32_t seed;
+    uint32_t reserved[2];
+    uint32_t maxParticles, spawnBase, spawnCount, emitterCount;
+    LvnParticleEmitterData emitters[LVN_PARTICLE_MAX_EMITTERS];
+};
+
+struct LvnParticleSystem
+{
+    LvnRenderer* renderer;        // the system is drawn in the render pass of this renderer
+    LvnBuffer* particleBuffer;
+    LvnBuffer* uniformBuffer;
+    LvnDescriptorLayout* descriptorLayout;
+    LvnDescriptorSet* descriptorSet;  // bound to both pipelines
+    LvnPipeline* computePipeline;
+    LvnPipeline* pipeline;
+    uint32_t maxParticles;
+    uint32_t spawnCursor;         // slot the next spawned particle is written to, the particle buffer is used as a ring
+    uint32_t emitterCount;        // highest configured emitter plus one
+    uint32_t step;
+    uint64_t drawFrameIndex;      // frame of the last draw, a system is simulated once per frame
+    LvnParticleEmitter emitters[LVN_PARTICLE_MAX_EMITTERS];
+    float spawnRemainder[LVN_PARTICLE_MAX_EMITTERS]; // fraction of a particle carried over to the next step
+    uint32_t bursts[LVN_PARTICLE_MAX_EMITTERS];
+};
+
+// the uniform is filled when the system is drawn so the submission never reads emitters the next frame is changing
+struct LvnParticleDraw
+{
+    LvnParticleSystem* system;
+    LvnParticleUniformData uniform;
+    uint64_t sortKey;
+};
+
+// bounds of a clip rect in world units, the world origin is the center of the render area
+struct LvnDrawClipRect
+{
+    float minX, minY, maxX, maxY;
+};
+
+struct LvnTextLayoutCacheEntry
+{
+    LvnString text;
+    float scale, lineHeight, textBoxWidth;
+    LvnTextLayout layout;
 };
 
 struct LvnRenderer
 {
-    LvnWindow* window;
+    LvnWindow* window;           // window the commands are recorded into
+    LvnFrameBuffer* frameBuffer; // offscreen target drawn within the frame of the window, null when drawing to the window
+    LvnRenderPass* renderPass;
+    bool ownsWindow;             // the window of renderInit is destroyed with its renderer
     LvnVec4 clearColor;
     LvnFont defaultFont;
+    LvnHashMap<uint64_t, LvnTextLayoutCacheEntry> textLayoutCache;
+    LvnMutex textLayoutMutex;
     LvnTexture* defaultWhiteTexture;
     LvnTexture* defaultFontTexture;
+    bool ownsFontTexture;        // set once renderSetFont replaces the shared font texture
     LvnVector<LvnRenderMode> renderModes;
+    LvnVector<LvnRenderPacket> packets;
+    LvnVector<LvnRenderPacket> packetScratch;
+    LvnMutex batchTextureMutex;
+    LvnVector<LvnStaticBatchDraw> recordStaticDraws; // static batches drawn in the frame being recorded, guarded by staticDrawMutex
+    LvnVector<LvnStaticBatchDraw> staticDraws;       // static batches drawn in the frame being submitted
+    LvnMutex staticDrawMutex;
+    LvnVector<LvnParticleDraw> recordParticleDraws;  // particle systems drawn in the frame being recorded, guarded by particleDrawMutex
+    LvnVector<LvnParticleDraw> particleDraws;        // particle systems drawn in the frame being submitted
+    LvnMutex particleDrawMutex;
+    LvnStaticBatch* recordingBatch;                  // batch between staticBatchBegin and staticBatchEnd, null otherwise
+    LvnVector<LvnDrawClipRect> recordClipRects;      // clip rects pushed in the frame being recorded, guarded by clipRectMutex
+    LvnVector<LvnDrawClipRect> clipRects;            // clip rects of the frame being submitted
+    LvnMutex clipRectMutex;
+    LvnDrawClipRect viewBounds;                      // render area of the frame being recorded in world units, draws outside of it are culled
+    bool directWrite;
+    bool onDemand;               // frames are only drawn after input to the window or lvn::windowInvalidate, see renderWaitEvents
+
+    // frame packet handed from drawEnd to the submission, copied on the window thread so the render thread never reads the recording state
+    LvnVec4 frameClearColor;
+    int frameWidth, frameHeight;
+
+    // render thread mode, drawEnd hands the frame over and the render thread records and submits it while the next frame is recorded
+    bool renderThreadEnabled;                      // set by renderSetRenderThread, takes effect on the next drawBegin
+    LvnThread* renderThread;                       // null when drawEnd submits the frame itself
+    std::mutex renderThreadMutex;
+    std::condition_variable renderThreadCondition; // signals a handed over frame to the render thread and its submission back to the window thread
+    bool renderFramePending;                       // guarded by renderThreadMutex
+    bool renderThreadStop;                         // guarded by renderThreadMutex
 };
 
 struct LvnUniformData
@@ -106,6 +603,43 @@ struct LvnUniformData
     LvnMat4 viewMat;
 };
 
+struct LvnSpriteUniformData
+{
+    LvnMat4 projMat;
+    LvnMat4 viewMat;
+    int32_t textureBase; // first texture slot of the batch being drawn
+};
+
+// per thread cache of the last texture slot looked up, the frame index keeps entries from carrying over into the next frame
+struct LvnBatchTextureCache
+{
+    const LvnRenderer* renderer;
+    uint64_t frameIndex;
+    const LvnTexture* texture;
+    uint32_t slot;
+};
+
+struct LvnDrawClip
+{
+    uint32_t index; // index into the clip rects of the frame starting at one, zero when the clip is not recorded
+    LvnDrawClipRect bounds;
+};
+
+// per thread stack of pushed clip rects, the renderer and frame index drop clips left over from another frame
+struct LvnDrawClipStack
+{
+    const LvnRenderer* renderer;
+    uint64_t frameIndex;
+    LvnVector<LvnDrawClip> clips;
+};
+
+static uint64_t s_DrawFrameIndex = 0;
+static thread_local int32_t s_DrawLayer = 0;
+static thread_local LvnBatchTextureCache s_BatchTextureCache = {};
+static thread_local LvnDrawClipStack s_DrawClipStack = {};
+static thread_local LvnHashMap<uint32_t, LvnVector<LvnVec2>> s_UnitCircleTables; // unit circle points per side count, per thread so lookups need no lock
+static thread_local LvnVector<uint32_t> s_TextCodepoints; // scratch of the decoded text while building a layout
+
 struct LvnVertexData2d
 {
     LvnVec2 pos;
@@ -114,16 +648,73 @@ struct LvnVertexData2d
     float texId;
 };
 
+struct LvnQuadInstanceData2d
+{
+    LvnColor color;
+    LvnVec4 texRect; // uvs at the (0,0) and (1,1) corners of the quad
+    float texId;
+    LvnVec4 rect;    // position of the (0,0) corner, size
+};
+
+static thread_local LvnVector<LvnVertexData2d> s_PolygonVertices; // reused by drawPolyNgonSector so drawing polygons does not allocate
+static thread_local LvnVector<uint32_t> s_PolygonIndices;
+
+
+// resources shared by every renderer, created with the first renderer and destroyed with the last
+struct LvnRendererSharedResources
+{
+    LvnTexture* whiteTexture;
+    LvnTexture* fontTexture;
+    LvnFont font;
+    uint32_t rendererCount;
+};
 
-static LvnUniquePtr<LvnRenderer> s_Renderer;
+static LvnRendererSharedResources s_RendererResources{};
+static LvnRenderer* s_Renderer = nullptr;     // renderer the draw functions go to
+static LvnRenderer* s_InitRenderer = nullptr; // renderer created by renderInit
 
 namespace lvn
 {
 
 static LvnFont         getDefaultFont();
 static LvnResult       createRendererResources(const LvnWindowCreateInfo* windowCreateInfo);
-static LvnRenderMode   createRenderMode2d(const LvnRenderer* renderer, const LvnTexture* texture, const char* fragmentShaderSrc);
-static void            renderModeDraw2d(LvnRenderer* renderer, LvnRenderMode& renderMode);
+static LvnResult       acquireRendererSharedResources();
+static void            releaseRendererSharedResources();
+static void            renderGetTargetSize(LvnRenderer* renderer, int* width, int* height);
+static LvnRenderMode   createRenderMode2d(const LvnRenderer* renderer, const LvnTexture* texture, const char* fragmentShaderSrc, bool instanced, uint32_t textureBatches);
+static void            destroyRenderMode(LvnRenderMode& renderMode);
+static LvnResult       renderModeResizeBuffer2d(LvnRenderMode& renderMode, uint64_t vertexCount, uint64_t indexCount);
+static bool            renderModePrepareDraw2d(LvnRenderer* renderer, LvnRenderMode& renderMode);
+static void            renderModeWrite2d(LvnRenderMode& renderMode, const void* data, uint64_t size, uint64_t offset);
+static void            renderModeUpload2d(LvnRenderMode& renderMode);
+static void            renderModeUpdate2d(LvnRenderer* renderer, LvnRenderMode& renderMode);
+static void            renderModeUpdateSprite2d(LvnRenderer* renderer, LvnRenderMode& renderMode);
+static void            renderModeBind2d(LvnRenderer* renderer, LvnRenderMode& renderMode);
+static void            renderModeDraw2d(LvnRenderer* renderer, LvnRenderMode& renderMode, uint64_t first, uint64_t count);
+static void            renderModeDrawQuad2d(LvnRenderer* renderer, LvnRenderMode& renderMode, uint64_t first, uint64_t count);
+static void            renderModeDrawStatic2d(LvnRenderer* renderer, LvnRenderMode& renderMode, const LvnStaticBatchDraw& draw, uint64_t count);
+static void            renderSwapFrame(LvnRenderer* renderer);
+static void            renderSubmitFrame(LvnRenderer* renderer);
+static void*           renderThreadFunc(void* arg);
+static void            renderUpdateThread(LvnRenderer* renderer);
+static void            renderWaitFrame(LvnRenderer* renderer);
+static void            renderStopThread(LvnRenderer* renderer);
+static void            renderBuildPackets(LvnRenderer* renderer);
+static void            renderSortPackets(LvnRenderer* renderer);
+static void            renderReorderPackets(LvnRenderer* renderer);
+static uint64_t        renderGetSortKey(uint32_t textureBatch);
+static LvnDrawClipStack& renderGetClipStack(const LvnRenderer* renderer);
+static bool            renderIsVisible(const LvnRenderer* renderer, float minX, float minY, float maxX, float maxY);
+static void            renderSetClipScissor(LvnRenderer* renderer, uint32_t clip);
+static uint32_t        renderModeGetTextureSlot(LvnRenderer* renderer, const LvnTexture* texture);
+static void            renderPushSprite(const LvnTexture* texture, const LvnUVBox& uv, const LvnVec2& pos, const LvnVec2& size, const LvnColor& color);
+static const LvnVec2*  renderGetUnitCircle(uint32_t nSides);
+static void            renderBuildTextLayout(LvnRenderer* renderer, const char* text, float scale, float lineHeight, float textBoxWidth, LvnTextLayout* layout);
+static void            renderModePushQuad(LvnRenderMode& renderMode, const LvnQuadInstanceData2d& instance, uint64_t sortKey);
+static bool            renderModeReserve(std::atomic<uint64_t>& counter, uint64_t count, uint64_t maxCount, uint64_t* first);
+static void            renderModePushDrawCmd(LvnRenderMode& renderMode, const LvnDrawCommand& drawCmd);
+static void            particleSystemSimulate(LvnRenderer* renderer, LvnParticleDraw& draw);
+static void            particleSystemDraw(LvnRenderer* renderer, const LvnParticleDraw& draw);
 
 
 static LvnFont getDefaultFont()
@@ -362,7 +953,8 @@ static LvnFont getDefaultFont()
         LVN_CONFIG_GLYPH(106,91,111,103,0,1,255,7),
     };
 
-    uint8_t* imgbuff = (uint8_t*)LVN_MALLOC(128 * 128);
+    LvnData<uint8_t> pixels(128 * 128);
+    uint8_t* imgbuff = pixels.data();
 
     for (uint32_t i = 0; i < LVN_ARRAY_LEN(c_DefaultFontData); i++)
     {
@@ -374,7 +966,7 @@ static LvnFont getDefaultFont()
     }
 
     LvnImageData imageData{};
-    imageData.pixels = LvnData<uint8_t>(imgbuff, 128 * 128);
+    imageData.pixels = lvn::move(pixels);
     imageData.width = 128;
     imageData.height = 128;
     imageData.channels = 1;
@@ -382,40 +974,55 @@ static LvnFont getDefaultFont()
 
     LvnFont font{};
     font.fontSize = 11; // default font max pixel height
-    font.atlas = imageData;
+    font.atlas = lvn::move(imageData);
     font.glyphs = LvnData<LvnFontGlyph>(glyphs, LVN_ARRAY_LEN(glyphs));
     font.codepoints = lvn::getDefaultSupportedCodepoints();
-
-    LVN_FREE(imgbuff);
+    lvn::fontBuildGlyphLookup(font);
 
     return font;
 }
 
 static LvnResult createRendererResources(const LvnWindowCreateInfo* windowCreateInfo)
 {
-    if (s_Renderer)
+    if (s_InitRenderer)
         return Lvn_Result_AlreadyCalled;
 
-    s_Renderer = lvn::makeUniquePtr<LvnRenderer>();
-    LvnRenderer* renderer = s_Renderer.get();
+    LvnWindow* window;
+    if (lvn::createWindow(&window, windowCreateInfo) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    LvnRendererCreateInfo createInfo{};
+    createInfo.window = window;
 
-    if (lvn::createWindow(&renderer->window, windowCreateInfo) != Lvn_Result_Success)
+    if (lvn::createRenderer(&s_InitRenderer, &createInfo) != Lvn_Result_Success)
+    {
+        lvn::destroyWindow(window);
         return Lvn_Result_Failure;
+    }
 
-    // set background clear color
-    renderer->clearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+    s_InitRenderer->ownsWindow = true;
+    s_Renderer = s_InitRenderer;
+
+    return Lvn_Result_Success;
+}
+
+static LvnResult acquireRendererSharedResources()
+{
+    LvnRendererSharedResources& resources = s_RendererResources;
+    if (resources.rendererCount++ > 0)
+        return Lvn_Result_Success;
 
     // texture
     uint8_t whiteTextureData[] = { 0xff, 0xff, 0xff, 0xff };
     LvnImageData imageData;
-    imageData.pixels = LvnData<uint8_t>(whiteTextureData, sizeof(whiteTextureData) / sizeof(uint8_t));
+    imageData.pixels = LvnData<uint8_t>::view(whiteTextureData, sizeof(whiteTextureData) / sizeof(uint8_t));
     imageData.width = 1;
     imageData.height = 1;
     imageData.channels = 4;
     imageData.size = 4;
 
     LvnTextureCreateInfo textureCreateInfo{};
-    textureCreateInfo.imageData = imageData;
+    textureCreateInfo.imageData = lvn::move(imageData);
     textureCreateInfo.format = Lvn_TextureFormat_Unorm;
     textureCreateInfo.wrapS = Lvn_TextureMode_Repeat;
     textureCreateInfo.wrapT = Lvn_TextureMode_Repeat;
@@ -423,73 +1030,101 @@ static LvnResult createRendererResources(const LvnWindowCreateInfo* windowCreate
     textureCreateInfo.magFilter = Lvn_TextureFilter_Nearest;
 
     // create texture
-    lvn::createTexture(&renderer->defaultWhiteTexture, &textureCreateInfo);
+    if (lvn::createTexture(&resources.whiteTexture, &textureCreateInfo) != Lvn_Result_Success)
+    {
+        resources.rendererCount--;
+        return Lvn_Result_Failure;
+    }
 
     // load default font
-    renderer->defaultFont = lvn::getDefaultFont();
-    textureCreateInfo.imageData = renderer->defaultFont.atlas;
-    lvn::createTexture(&renderer->defaultFontTexture, &textureCreateInfo);
-
-    // render modes
-    renderer->renderModes.resize(Lvn_RenderMode_Max_Value);
-    renderer->renderModes[Lvn_RenderMode_2d] = lvn::move(lvn::createRenderMode2d(renderer, renderer->defaultWhiteTexture, s_FragmentShaderSrc));
-    renderer->renderModes[Lvn_RenderMode_2dText] = lvn::move(lvn::createRenderMode2d(renderer, renderer->defaultFontTexture, s_FragmentShaderFontSrc));
-
+    resources.font = lvn::getDefaultFont();
+    textureCreateInfo.imageData = lvn::imageGetView(resources.font.atlas);
+    if (lvn::createTexture(&resources.fontTexture, &textureCreateInfo) != Lvn_Result_Success)
+    {
+        lvn::destroyTexture(resources.whiteTexture);
+        resources.rendererCount--;
+        return Lvn_Result_Failure;
+    }
 
     return Lvn_Result_Success;
 }
 
-static LvnRenderMode createRenderMode2d(const LvnRenderer* renderer, const LvnTexture* texture, const char* fragmentShaderSrc)
+static void releaseRendererSharedResources()
 {
-    LvnRenderMode renderMode{};
-    renderMode.maxVertexCount = 5000;
-    renderMode.maxIndexCount = 5000;
+    LvnRendererSharedResources& resources = s_RendererResources;
+    if (resources.rendererCount == 0 || --resources.rendererCount > 0)
+        return;
 
-    uint32_t stride = sizeof(LvnVertexData2d);
+    lvn::destroyTexture(resources.whiteTexture);
+    lvn::destroyTexture(resources.fontTexture);
+    resources = LvnRendererSharedResources{};
+}
 
-    // create buffer
-    LvnBufferCreateInfo bufferCreateInfo{};
-    bufferCreateInfo.type = Lvn_BufferType_Vertex | Lvn_BufferType_Index | Lvn_BufferType_Uniform;
-    bufferCreateInfo.usage = Lvn_BufferUsage_Dynamic;
-    bufferCreateInfo.data = nullptr;
-    bufferCreateInfo.size = renderMode.maxVertexCount * stride + renderMode.maxIndexCount * sizeof(uint32_t) + sizeof(LvnUniformData);
+static void renderGetTargetSize(LvnRenderer* renderer, int* width, int* height)
+{
+    if (renderer->frameBuffer)
+    {
+        LvnTexture* image = lvn::frameBufferGetImage(renderer->frameBuffer, 0);
+        *width = (int)image->width;
+        *height = (int)image->height;
+        return;
+    }
+
+    lvn::windowGetSize(renderer->window, width, height);
+}
 
-    lvn::createBuffer(&renderMode.buffer, &bufferCreateInfo);
-    renderMode.indexOffset = renderMode.maxVertexCount * stride;
-    renderMode.uniformOffset = renderMode.maxVertexCount * stride + renderMode.maxIndexCount * sizeof(uint32_t);
+static LvnRenderMode createRenderMode2d(const LvnRenderer* renderer, const LvnTexture* texture, const char* fragmentShaderSrc, bool instanced, uint32_t textureBatches)
+{
+    LvnRenderMode renderMode{};
+    renderMode.texture = texture;
+    renderMode.vertexStride = instanced ? sizeof(LvnQuadInstanceData2d) : sizeof(LvnVertexData2d);
+    renderMode.uniformSize = textureBatches ? sizeof(LvnSpriteUniformData) : sizeof(LvnUniformData);
+    renderMode.uniformStride = (renderMode.uniformSize + LVN_UNIFORM_OFFSET_ALIGNMENT - 1) & ~((uint64_t)LVN_UNIFORM_OFFSET_ALIGNMENT - 1);
 
     // attributes and bindings
-    LvnVertexBindingDescription bindingDescriptions[] = {LvnVertexBindingDescription{ 0, stride }};
-    LvnVertexAttribute attributes[] =
+    LvnVertexBindingDescription bindingDescriptions[] = { lvn::vertexBinding<LvnVertexData2d>(0) };
+    static_assert(Lvn_AttributeLocation_Position == 0 && Lvn_AttributeLocation_Color == 1 && Lvn_AttributeLocation_TexCoords == 2 && Lvn_AttributeLocation_TexId == 3, "LvnVertexData2d members are laid out in attribute location order");
+    const auto attributes = lvn::vertexLayout<&LvnVertexData2d::pos, &LvnVertexData2d::color, &LvnVertexData2d::texCoords, &LvnVertexData2d::texId>(0);
+
+    // instanced modes read the unit quad corner per vertex from binding 0 and everything else per instance from binding 1
+    LvnVertexBindingDescription quadBindingDescriptions[] =
+    {
+        LvnVertexBindingDescription{ 0, sizeof(LvnVec2), Lvn_VertexInputRate_Vertex },
+        LvnVertexBindingDescription{ 1, sizeof(LvnQuadInstanceData2d), Lvn_VertexInputRate_Instance },
+    };
+    LvnVertexAttribute quadAttributes[] =
     {
         { 0, Lvn_AttributeLocation_Position, Lvn_AttributeFormat_Vec2_f32, 0 },
-        { 0, Lvn_AttributeLocation_Color, Lvn_AttributeFormat_Vec4_un8, (2 * sizeof(float)) },
-        { 0, Lvn_AttributeLocation_TexCoords, Lvn_AttributeFormat_Vec2_f32, (2 * sizeof(float) + 4 * sizeof(uint8_t)) },
-        { 0, Lvn_AttributeLocation_TexId, Lvn_AttributeFormat_Scalar_f32, (4 * sizeof(float) + 4 * sizeof(uint8_t)) },
+        { 1, Lvn_AttributeLocation_Color, Lvn_AttributeFormat_Vec4_un8, offsetof(LvnQuadInstanceData2d, color) },
+        { 1, Lvn_AttributeLocation_TexCoords, Lvn_AttributeFormat_Vec4_f32, offsetof(LvnQuadInstanceData2d, texRect) },
+        { 1, Lvn_AttributeLocation_TexId, Lvn_AttributeFormat_Scalar_f32, offsetof(LvnQuadInstanceData2d, texId) },
+        { 1, Lvn_AttributeLocation_InstanceRect, Lvn_AttributeFormat_Vec4_f32, offsetof(LvnQuadInstanceData2d, rect) },
     };
 
     // create pipeline
     LvnShaderCreateInfo shaderCreateInfo{};
-    shaderCreateInfo.vertexSrc = s_VertexShaderSrc;
+    shaderCreateInfo.vertexSrc = textureBatches ? s_VertexShaderSpriteSrc : (instanced ? s_VertexShaderQuadSrc : s_VertexShaderSrc);
     shaderCreateInfo.fragmentSrc = fragmentShaderSrc;
 
     LvnShader* shader;
     lvn::createShaderFromSrc(&shader, &shaderCreateInfo);
 
-    // descriptor binding
+    // descriptor binding, texture batched modes allocate one set per batch
+    uint32_t setCount = textureBatches ? textureBatches : 1;
+
     LvnDescriptorBinding descriptorUniformBinding{};
     descriptorUniformBinding.binding = 0;
     descriptorUniformBinding.descriptorType = Lvn_DescriptorType_UniformBuffer;
     descriptorUniformBinding.shaderStage = Lvn_ShaderStage_Vertex;
     descriptorUniformBinding.descriptorCount = 1;
-    descriptorUniformBinding.maxAllocations = 1;
+    descriptorUniformBinding.maxAllocations = setCount;
 
     LvnDescriptorBinding descriptorTextureBinding{};
     descriptorTextureBinding.binding = 1;
     descriptorTextureBinding.descriptorType = Lvn_DescriptorType_ImageSampler;
     descriptorTextureBinding.shaderStage = Lvn_ShaderStage_Fragment;
-    descriptorTextureBinding.descriptorCount = 1;
-    descriptorTextureBinding.maxAllocations = 1;
+    descriptorTextureBinding.descriptorCount = textureBatches ? LVN_RENDER_MODE_TEXTURE_SLOTS : 1;
+    descriptorTextureBinding.maxAllocations = setCount;
 
     LvnDescriptorBinding descriptorBindings[] =
     {
@@ -500,35 +1135,154 @@ static LvnRenderMode createRenderMode2d(const LvnRenderer* renderer, const LvnTe
     LvnDescriptorLayoutCreateInfo descriptorLayoutCreateInfo{};
     descriptorLayoutCreateInfo.pDescriptorBindings = descriptorBindings;
     descriptorLayoutCreateInfo.descriptorBindingCount = LVN_ARRAY_LEN(descriptorBindings);
-    descriptorLayoutCreateInfo.maxSets = 1;
+    descriptorLayoutCreateInfo.maxSets = setCount;
 
     lvn::createDescriptorLayout(&renderMode.descriptorLayout, &descriptorLayoutCreateInfo);
     lvn::allocateDescriptorSet(&renderMode.descriptorSet, renderMode.descriptorLayout);
 
-    LvnRenderPass* renderPass = lvn::windowGetRenderPass(renderer->window);
+    if (textureBatches)
+    {
+        renderMode.batchDescriptorSets.resize(textureBatches);
+        renderMode.batchDescriptorSets[0] = renderMode.descriptorSet;
+        for (uint32_t i = 1; i < textureBatches; i++)
+            lvn::allocateDescriptorSet(&renderMode.batchDescriptorSets[i], renderMode.descriptorLayout);
+    }
+
+    LvnRenderPass* renderPass = renderer->renderPass;
     LvnPipelineSpecification pipelineSpec = lvn::configPipelineSpecificationInit();
 
     // pipeline create info struct
     LvnPipelineCreateInfo pipelineCreateInfo{};
     pipelineCreateInfo.pipelineSpecification = &pipelineSpec;
-    pipelineCreateInfo.pVertexAttributes = attributes;
-    pipelineCreateInfo.vertexAttributeCount = LVN_ARRAY_LEN(attributes);
-    pipelineCreateInfo.pVertexBindingDescriptions = bindingDescriptions;
-    pipelineCreateInfo.vertexBindingDescriptionCount = LVN_ARRAY_LEN(bindingDescriptions);
+    pipelineCreateInfo.pVertexAttributes = instanced ? quadAttributes : attributes.data();
+    pipelineCreateInfo.vertexAttributeCount = instanced ? LVN_ARRAY_LEN(quadAttributes) : attributes.size();
+    pipelineCreateInfo.pVertexBindingDescriptions = instanced ? quadBindingDescriptions : bindingDescriptions;
+    pipelineCreateInfo.vertexBindingDescriptionCount = instanced ? LVN_ARRAY_LEN(quadBindingDescriptions) : LVN_ARRAY_LEN(bindingDescriptions);
     pipelineCreateInfo.pDescriptorLayouts = &renderMode.descriptorLayout;
     pipelineCreateInfo.descriptorLayoutCount = 1;
     pipelineCreateInfo.shader = shader;
     pipelineCreateInfo.renderPass = renderPass;
 
+    // model transform of static batches
+    LvnPushConstantRange pushConstantRange{ Lvn_ShaderStage_Vertex, 0, sizeof(LvnMat4) };
+    pipelineCreateInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineCreateInfo.pushConstantRangeCount = 1;
+
     // create pipeline
     lvn::createPipeline(&renderMode.pipeline, &pipelineCreateInfo);
     lvn::destroyShader(shader);
 
 
+    if (instanced)
+    {
+        // unit quad shared by every instance, vertices followed by indices
+        LvnVec2 quadVertices[] = { {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f} };
+        uint32_t quadIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+        uint8_t quadData[sizeof(quadVertices) + sizeof(quadIndices)];
+        memcpy(quadData, quadVertices, sizeof(quadVertices));
+        memcpy(quadData + sizeof(quadVertices), quadIndices, sizeof(quadIndices));
+
+        LvnBufferCreateInfo quadBufferCreateInfo{};
+        quadBufferCreateInfo.type = Lvn_BufferType_Vertex | Lvn_BufferType_Index;
+        quadBufferCreateInfo.usage = Lvn_BufferUsage_Static;
+        quadBufferCreateInfo.data = quadData;
+        quadBufferCreateInfo.size = sizeof(quadData);
+
+        lvn::createBuffer(&renderMode.quadBuffer, &quadBufferCreateInfo);
+    }
+
+    // create buffer and update descriptor set, instanced modes have no per instance indices
+    lvn::renderModeResizeBuffer2d(renderMode, LVN_RENDER_MODE_INIT_VERTEX_COUNT, instanced ? 0 : LVN_RENDER_MODE_INIT_INDEX_COUNT);
+
+    renderMode.updateFunc = textureBatches ? lvn::renderModeUpdateSprite2d : lvn::renderModeUpdate2d;
+    renderMode.drawFunc = instanced ? lvn::renderModeDrawQuad2d : lvn::renderModeDraw2d;
+
+    return renderMode;
+}
+
+static void destroyRenderMode(LvnRenderMode& renderMode)
+{
+    lvn::destroyPipeline(renderMode.pipeline);
+    lvn::destroyDescriptorLayout(renderMode.descriptorLayout);
+    lvn::destroyBuffer(renderMode.buffer);
+    if (renderMode.quadBuffer)
+        lvn::destroyBuffer(renderMode.quadBuffer);
+}
+
+static LvnResult renderModeResizeBuffer2d(LvnRenderMode& renderMode, uint64_t vertexCount, uint64_t indexCount)
+{
+    // grow geometrically so the buffer settles at the frame high-water mark and stops reallocating
+    uint64_t maxVertexCount = renderMode.maxVertexCount ? renderMode.maxVertexCount : vertexCount;
+    uint64_t maxIndexCount = renderMode.maxIndexCount ? renderMode.maxIndexCount : indexCount;
+    while (maxVertexCount < vertexCount) maxVertexCount *= 2;
+    while (maxIndexCount < indexCount) maxIndexCount *= 2;
+
+    uint64_t indexOffset = maxVertexCount * renderMode.vertexStride;
+    uint64_t uniformOffset = indexOffset + maxIndexCount * sizeof(uint32_t);
+    uniformOffset = (uniformOffset + LVN_UNIFORM_OFFSET_ALIGNMENT - 1) & ~((uint64_t)LVN_UNIFORM_OFFSET_ALIGNMENT - 1);
+
+    LvnBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.type = Lvn_BufferType_Vertex | Lvn_BufferType_Index | Lvn_BufferType_Uniform;
+    bufferCreateInfo.usage = Lvn_BufferUsage_DynamicRing;
+    bufferCreateInfo.data = nullptr;
+    bufferCreateInfo.size = uniformOffset + renderMode.uniformStride * (renderMode.batchDescriptorSets.empty() ? 1 : renderMode.batchDescriptorSets.size());
+
+    LvnBuffer* buffer;
+    if (lvn::createBuffer(&buffer, &bufferCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("[renderer]: failed to create render mode buffer, (vertices:%llu, indices:%llu)", (unsigned long long)maxVertexCount, (unsigned long long)maxIndexCount);
+        return Lvn_Result_Failure;
+    }
+
+    // destruction of the old buffer is deferred until the frames in flight that may still read it retire, the current frame has not recorded it yet
+    if (renderMode.buffer)
+        lvn::destroyBuffer(renderMode.buffer);
+
+    renderMode.buffer = buffer;
+    renderMode.maxVertexCount = maxVertexCount;
+    renderMode.maxIndexCount = maxIndexCount;
+    renderMode.indexOffset = indexOffset;
+    renderMode.uniformOffset = uniformOffset;
+
+    // texture batched modes point each set at its own uniform, the textures are written when the batch is drawn
+    if (!renderMode.batchDescriptorSets.empty())
+    {
+        // every batch set is written with one update call
+        uint32_t batchCount = renderMode.batchDescriptorSets.size();
+        LvnVector<LvnUniformBufferInfo> bufferInfos(batchCount);
+        LvnVector<LvnDescriptorUpdateInfo> descriptorUniformUpdateInfos(batchCount);
+        LvnVector<LvnDescriptorSetUpdate> descriptorSetUpdates(batchCount);
+        for (uint32_t i = 0; i < batchCount; i++)
+        {
+            LvnUniformBufferInfo& bufferInfo = bufferInfos[i];
+            bufferInfo = {};
+            bufferInfo.buffer = renderMode.buffer;
+            bufferInfo.range = renderMode.uniformSize;
+            bufferInfo.offset = renderMode.uniformOffset + renderMode.uniformStride * i;
+
+            LvnDescriptorUpdateInfo& descriptorUniformUpdateInfo = descriptorUniformUpdateInfos[i];
+            descriptorUniformUpdateInfo = {};
+            descriptorUniformUpdateInfo.descriptorType = Lvn_DescriptorType_UniformBuffer;
+            descriptorUniformUpdateInfo.binding = 0;
+            descriptorUniformUpdateInfo.descriptorCount = 1;
+            descriptorUniformUpdateInfo.bufferInfo = &bufferInfo;
+
+            descriptorSetUpdates[i].descriptorSet = renderMode.batchDescriptorSets[i];
+            descriptorSetUpdates[i].pUpdateInfos = &descriptorUniformUpdateInfo;
+            descriptorSetUpdates[i].updateInfoCount = 1;
+        }
+
+        lvn::updateDescriptorSetsData(descriptorSetUpdates.data(), batchCount);
+
+        renderMode.boundTextures.clear();
+        return Lvn_Result_Success;
+    }
+
     // update descriptor set
     LvnUniformBufferInfo bufferInfo{};
     bufferInfo.buffer = renderMode.buffer;
-    bufferInfo.range = sizeof(LvnUniformData);
+    bufferInfo.range = renderMode.uniformSize;
     bufferInfo.offset = renderMode.uniformOffset;
 
     LvnDescriptorUpdateInfo descriptorUniformUpdateInfo{};
@@ -541,353 +1295,1969 @@ static LvnRenderMode createRenderMode2d(const LvnRenderer* renderer, const LvnTe
     descriptorTextureUpdateInfo.descriptorType = Lvn_DescriptorType_ImageSampler;
     descriptorTextureUpdateInfo.binding = 1;
     descriptorTextureUpdateInfo.descriptorCount = 1;
-    descriptorTextureUpdateInfo.pTextureInfos = &texture;
+    descriptorTextureUpdateInfo.pTextureInfos = &renderMode.texture;
 
     LvnDescriptorUpdateInfo descriptorUpdateInfos[] = { descriptorUniformUpdateInfo, descriptorTextureUpdateInfo, };
     lvn::updateDescriptorSetData(renderMode.descriptorSet, descriptorUpdateInfos, LVN_ARRAY_LEN(descriptorUpdateInfos));
 
+    return Lvn_Result_Success;
+}
 
-    renderMode.drawFunc = lvn::renderModeDraw2d;
+static bool renderModeReserve(std::atomic<uint64_t>& counter, uint64_t count, uint64_t maxCount, uint64_t* first)
+{
+    // only advance the counter if the reservation fits, every reserved range below the counter is written by its owner
+    uint64_t current = counter.load(std::memory_order_relaxed);
+    do
+    {
+        if (current + count > maxCount)
+            return false;
+    } while (!counter.compare_exchange_weak(current, current + count, std::memory_order_relaxed));
 
-    return renderMode;
+    *first = current;
+    return true;
 }
 
-static void renderModeDraw2d(LvnRenderer* renderer, LvnRenderMode& renderMode)
+static void renderModePushDrawCmd(LvnRenderMode& renderMode, const LvnDrawCommand& drawCmd)
 {
-    if (renderMode.drawList.empty())
-        return;
-
-    int width, height;
-    lvn::windowGetSize(renderer->window, &width, &height);
+    uint64_t firstVertex, firstIndex;
 
-    LvnUniformData uniformData{};
-    uniformData.projMat = lvn::ortho((float)width * -0.5f, (float)width * 0.5f, (float)height * -0.5f, (float)height * 0.5f, -1.0f, 1.0f);
-    uniformData.viewMat = LvnMat4(1.0f);
+    // vertices reserved without a matching index range are left unreferenced in the buffer
+    // only draws with the default sort key are written directly, the rest need to be reordered in drawEnd
+    if (renderMode.mappedData && drawCmd.sortKey == LVN_RENDER_DEFAULT_SORT_KEY && !renderMode.cursor.overflow.load(std::memory_order_relaxed)
+        && lvn::renderModeReserve(renderMode.cursor.vertexCount, drawCmd.vertexCount, renderMode.maxVertexCount, &firstVertex)
+        && lvn::renderModeReserve(renderMode.cursor.indexCount, drawCmd.indexCount, renderMode.maxIndexCount, &firstIndex))
+    {
+        memcpy(renderMode.mappedData + firstVertex * drawCmd.vertexStride, drawCmd.pVertices, drawCmd.vertexCount * drawCmd.vertexStride);
 
-    lvn::bufferUpdateData(renderMode.buffer, renderMode.drawList.vertices(), renderMode.drawList.vertex_size(), 0);
-    lvn::bufferUpdateData(renderMode.buffer, renderMode.drawList.indices(), renderMode.drawList.index_size(), renderMode.indexOffset);
-    lvn::bufferUpdateData(renderMode.buffer, &uniformData, sizeof(LvnUniformData), renderMode.uniformOffset);
+        uint32_t* indices = reinterpret_cast<uint32_t*>(renderMode.mappedData + renderMode.indexOffset) + firstIndex;
+        for (uint64_t i = 0; i < drawCmd.indexCount; i++)
+            indices[i] = drawCmd.pIndices[i] + firstVertex;
 
-    lvn::renderCmdBindPipeline(renderer->window, renderMode.pipeline);
-    lvn::renderCmdBindDescriptorSets(renderer->window, renderMode.pipeline, 0, 1, &renderMode.descriptorSet);
+        return;
+    }
 
-    lvn::renderCmdBindVertexBuffer(renderer->window, 0, 1, &renderMode.buffer, 0);
-    lvn::renderCmdBindIndexBuffer(renderer->window, renderMode.buffer, renderMode.indexOffset);
+    // buffer is full or cannot be mapped, the draw list is uploaded in drawEnd
+    // later draws also go to the draw list so they stay ordered after the overflow
+    if (renderMode.mappedData)
+        renderMode.cursor.overflow = true;
 
-    lvn::renderCmdDrawIndexed(renderer->window, renderMode.drawList.index_count());
+    renderMode.recordDrawList.push_back(drawCmd);
 }
 
-
-LvnResult renderInit(const char* title, int width, int height)
+static void renderModePushQuad(LvnRenderMode& renderMode, const LvnQuadInstanceData2d& instance, uint64_t sortKey)
 {
-    LvnWindowCreateInfo windowCreateInfo = lvn::configWindowInit(title, width, height);
-    return createRendererResources(&windowCreateInfo);
+    // an instance is pushed as a single vertex without indices
+    LvnDrawCommand drawCmd{};
+    drawCmd.pVertices = const_cast<LvnQuadInstanceData2d*>(&instance);
+    drawCmd.vertexCount = 1;
+    drawCmd.pIndices = nullptr;
+    drawCmd.indexCount = 0;
+    drawCmd.vertexStride = sizeof(LvnQuadInstanceData2d);
+    drawCmd.sortKey = sortKey;
+
+    lvn::renderModePushDrawCmd(renderMode, drawCmd);
 }
 
-LvnResult renderInit(const LvnWindowCreateInfo* createInfo)
+static bool renderModePrepareDraw2d(LvnRenderer* renderer, LvnRenderMode& renderMode)
 {
-    return createRendererResources(createInfo);
-}
+    // combine the per thread shards, all draw calls for this frame must be finished by drawEnd
+    renderMode.drawList.merge();
+    renderMode.sorted = false;
 
-void renderTerminate()
-{
-    if (!s_Renderer)
-        return;
+    uint64_t directVertexCount = renderMode.cursor.vertexCount.load();
+    uint64_t directIndexCount = renderMode.cursor.indexCount.load();
+    renderMode.cursor.reset();
 
-    LvnRenderer* renderer = s_Renderer.get();
+    renderMode.vertexCount = directVertexCount;
+    renderMode.indexCount = directIndexCount;
 
-    for (auto& renderMode : renderer->renderModes)
+    if (renderMode.drawList.empty() && directVertexCount == 0)
+        return false;
+
+    // geometry was also pushed to the draw list this frame, move the directly written geometry in front of it as a single command so both are uploaded together
+    if (!renderMode.drawList.empty() && directVertexCount > 0)
     {
-        lvn::destroyPipeline(renderMode.pipeline);
-        lvn::destroyDescriptorLayout(renderMode.descriptorLayout);
-        lvn::destroyBuffer(renderMode.buffer);
+        LvnDrawList combined;
+
+        LvnDrawCommand directCmd{};
+        directCmd.pVertices = renderMode.mappedData;
+        directCmd.vertexCount = directVertexCount;
+        directCmd.pIndices = reinterpret_cast<uint32_t*>(renderMode.mappedData + renderMode.indexOffset);
+        directCmd.indexCount = directIndexCount;
+        directCmd.vertexStride = renderMode.vertexStride;
+        directCmd.sortKey = LVN_RENDER_DEFAULT_SORT_KEY;
+        combined.push_back(directCmd);
+
+        // commands are pushed again to keep their sort keys, indices are made relative to the command
+        LvnVector<uint32_t> indices;
+        indices.set_allocator(lvn::renderGetFrameArena(renderer->window)->allocator());
+        const LvnDrawListCommand* commands = renderMode.drawList.commands();
+        for (uint64_t i = 0; i < renderMode.drawList.command_count(); i++)
+        {
+            indices.resize(commands[i].indexCount);
+            for (uint64_t j = 0; j < commands[i].indexCount; j++)
+                indices[j] = renderMode.drawList.indices()[commands[i].firstIndex + j] - commands[i].firstVertex;
+
+            LvnDrawCommand drawCmd{};
+            drawCmd.pVertices = static_cast<uint8_t*>(renderMode.drawList.vertices()) + commands[i].firstVertex * renderMode.vertexStride;
+            drawCmd.vertexCount = commands[i].vertexCount;
+            drawCmd.pIndices = indices.data();
+            drawCmd.indexCount = commands[i].indexCount;
+            drawCmd.vertexStride = renderMode.vertexStride;
+            drawCmd.sortKey = commands[i].sortKey;
+            combined.push_back(drawCmd);
+        }
+
+        combined.merge();
+        renderMode.drawList = combined;
     }
 
-    lvn::destroyTexture(renderer->defaultWhiteTexture);
-    lvn::destroyTexture(renderer->defaultFontTexture);
-    lvn::destroyWindow(renderer->window);
+    // geometry written directly is already in the buffer, only the draw list needs to be uploaded
+    if (!renderMode.drawList.empty())
+    {
+        renderMode.vertexCount = renderMode.drawList.vertex_count();
+        renderMode.indexCount = renderMode.drawList.index_count();
 
-    s_Renderer.reset(nullptr);
-}
+        if (renderMode.vertexCount > renderMode.maxVertexCount || renderMode.indexCount > renderMode.maxIndexCount)
+        {
+            // the new buffer is not mapped until the next frame begins
+            renderMode.mappedData = nullptr;
 
-bool rendererIsInitialized()
-{
-    return s_Renderer;
-}
+            if (lvn::renderModeResizeBuffer2d(renderMode, renderMode.vertexCount, renderMode.indexCount) != Lvn_Result_Success)
+            {
+                // drop the frame's geometry for this render mode so no packets reference it
+                renderMode.drawList.clear();
+                renderMode.vertexCount = 0;
+                renderMode.indexCount = 0;
+                return false;
+            }
+        }
+    }
 
-LvnWindow* getRendererWindow()
-{
-    LvnRenderer* renderer = s_Renderer.get();
-    return renderer->window;
+    return true;
 }
 
-bool renderWindowOpen()
+// writes into the mapped region of the current frame, the marked ranges are flushed together once the render mode is unmapped
+static void renderModeWrite2d(LvnRenderMode& renderMode, const void* data, uint64_t size, uint64_t offset)
 {
-    LvnRenderer* renderer = s_Renderer.get();
-    return lvn::windowOpen(renderer->window);
+    uint8_t* mapped = static_cast<uint8_t*>(lvn::bufferMap(renderMode.buffer));
+    if (!mapped)
+        return;
+
+    memcpy(mapped + offset, data, size);
+    lvn::bufferMarkRange(renderMode.buffer, offset, size);
 }
 
-LvnSprite createSprite(const LvnTextureCreateInfo& texCreateInfo, const LvnUVBox& uv)
+static void renderModeUpload2d(LvnRenderMode& renderMode)
 {
-    LvnSprite sprite;
-    sprite.uv = uv;
-    lvn::createTexture(&sprite.texture, &texCreateInfo);
-    return sprite;
+    if (renderMode.drawList.empty())
+        return;
+
+    // instanced render modes reorder the instances, indexed render modes only reorder the indices
+    const void* vertices = renderMode.sorted && !renderMode.sortedVertices.empty() ? renderMode.sortedVertices.data() : renderMode.drawList.vertices();
+    const uint32_t* indices = renderMode.sorted && !renderMode.sortedIndices.empty() ? renderMode.sortedIndices.data() : renderMode.drawList.indices();
+
+    lvn::renderModeWrite2d(renderMode, vertices, renderMode.drawList.vertex_size(), 0);
+    if (renderMode.indexCount > 0)
+        lvn::renderModeWrite2d(renderMode, indices, renderMode.drawList.index_size(), renderMode.indexOffset);
 }
 
-void destroySprite(LvnSprite& sprite)
+static void renderModeUpdate2d(LvnRenderer* renderer, LvnRenderMode& renderMode)
 {
-    lvn::destroyTexture(sprite.texture);
+    int width = renderer->frameWidth, height = renderer->frameHeight;
+
+    LvnUniformData uniformData{};
+    uniformData.projMat = lvn::ortho((float)width * -0.5f, (float)width * 0.5f, (float)height * -0.5f, (float)height * 0.5f, -1.0f, 1.0f);
+    uniformData.viewMat = LvnMat4(1.0f);
+
+    lvn::renderModeWrite2d(renderMode, &uniformData, sizeof(LvnUniformData), renderMode.uniformOffset);
 }
 
-void drawBegin()
+static void renderModeUpdateSprite2d(LvnRenderer* renderer, LvnRenderMode& renderMode)
 {
-    LvnRenderer* renderer = s_Renderer.get();
-    lvn::windowUpdate(renderer->window);
+    int width = renderer->frameWidth, height = renderer->frameHeight;
 
-    for (auto& renderMode : renderer->renderModes)
-        renderMode.drawList.clear();
+    LvnSpriteUniformData uniformData{};
+    uniformData.projMat = lvn::ortho((float)width * -0.5f, (float)width * 0.5f, (float)height * -0.5f, (float)height * 0.5f, -1.0f, 1.0f);
+    uniformData.viewMat = LvnMat4(1.0f);
+
+    uint32_t batchCount = lvn::max(((uint32_t)renderMode.batchTextures.size() + LVN_RENDER_MODE_TEXTURE_SLOTS - 1) / LVN_RENDER_MODE_TEXTURE_SLOTS, 1u);
+    renderMode.boundTextures.resize(renderMode.batchDescriptorSets.size() * LVN_RENDER_MODE_TEXTURE_SLOTS, nullptr);
+
+    for (uint32_t i = 0; i < batchCount; i++)
+    {
+        // unused slots point at the white texture so every descriptor in the array is valid
+        const LvnTexture* textures[LVN_RENDER_MODE_TEXTURE_SLOTS];
+        bool changed = false;
+        for (uint32_t j = 0; j < LVN_RENDER_MODE_TEXTURE_SLOTS; j++)
+        {
+            uint32_t slot = i * LVN_RENDER_MODE_TEXTURE_SLOTS + j;
+            textures[j] = slot < renderMode.batchTextures.size() ? renderMode.batchTextures[slot] : renderMode.texture;
+            changed |= renderMode.boundTextures[slot] != textures[j];
+            renderMode.boundTextures[slot] = textures[j];
+        }
+
+        if (changed)
+        {
+            LvnDescriptorUpdateInfo descriptorTextureUpdateInfo{};
+            descriptorTextureUpdateInfo.descriptorType = Lvn_DescriptorType_ImageSampler;
+            descriptorTextureUpdateInfo.binding = 1;
+            descriptorTextureUpdateInfo.descriptorCount = LVN_RENDER_MODE_TEXTURE_SLOTS;
+            descriptorTextureUpdateInfo.pTextureInfos = textures;
+
+            lvn::updateDescriptorSetData(renderMode.batchDescriptorSets[i], &descriptorTextureUpdateInfo, 1);
+        }
 
-    lvn::renderBeginNextFrame(renderer->window);
-    lvn::renderBeginCommandRecording(renderer->window);
-    lvn::renderCmdBeginRenderPass(renderer->window, renderer->clearColor.r, renderer->clearColor.g, renderer->clearColor.b, renderer->clearColor.a);
+        // each batch reads its own uniform, the vertex shader drops instances outside the batch
+        uniformData.textureBase = i * LVN_RENDER_MODE_TEXTURE_SLOTS;
+        lvn::renderModeWrite2d(renderMode, &uniformData, sizeof(LvnSpriteUniformData), renderMode.uniformOffset + renderMode.uniformStride * i);
+    }
 }
 
-void drawEnd()
+static void renderModeBind2d(LvnRenderer* renderer, LvnRenderMode& renderMode)
 {
-    LvnRenderer* renderer = s_Renderer.get();
+    lvn::renderCmdBindPipeline(renderer->window, renderMode.pipeline);
+    lvn::renderCmdBindDescriptorSets(renderer->window, renderMode.pipeline, 0, 1, &renderMode.descriptorSet);
 
-    for (auto& renderMode : renderer->renderModes)
+    LvnMat4 model = LvnMat4(1.0f);
+    lvn::renderCmdPushConstants(renderer->window, renderMode.pipeline, Lvn_ShaderStage_Vertex, 0, sizeof(LvnMat4), &model);
+
+    if (renderMode.quadBuffer)
     {
-        renderMode.drawFunc(renderer, renderMode);
+        // binding 0 is the unit quad, binding 1 is the instance stream
+        LvnBuffer* vertexBuffers[] = { renderMode.quadBuffer, renderMode.buffer };
+        uint64_t vertexOffsets[] = { 0, 0 };
+        lvn::renderCmdBindVertexBuffer(renderer->window, 0, 2, vertexBuffers, vertexOffsets);
+        lvn::renderCmdBindIndexBuffer(renderer->window, renderMode.quadBuffer, 4 * sizeof(LvnVec2));
+        return;
     }
 
-    lvn::renderCmdEndRenderPass(renderer->window);
-    lvn::renderEndCommandRecording(renderer->window);
-    lvn::renderDrawSubmit(renderer->window);
+    uint64_t vertexOffset = 0;
+    lvn::renderCmdBindVertexBuffer(renderer->window, 0, 1, &renderMode.buffer, &vertexOffset);
 }
 
-void drawClearColor(float r, float g, float b, float a)
+static void renderModeDraw2d(LvnRenderer* renderer, LvnRenderMode& renderMode, uint64_t first, uint64_t count)
 {
-    LvnRenderer* renderer = s_Renderer.get();
-    renderer->clearColor = { r, g, b, a };
+    lvn::renderCmdBindIndexBuffer(renderer->window, renderMode.buffer, renderMode.indexOffset + first * sizeof(uint32_t));
+    lvn::renderCmdDrawIndexed(renderer->window, count);
 }
 
-void drawClearColor(const LvnColor& color)
+static void renderModeDrawQuad2d(LvnRenderer* renderer, LvnRenderMode&, uint64_t first, uint64_t count)
 {
-    LvnRenderer* renderer = s_Renderer.get();
-    renderer->clearColor = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
+    lvn::renderCmdDrawIndexedInstanced(renderer->window, 6, count, first);
 }
 
-void drawTriangle(const LvnVec2& v1, const LvnVec2& v2, const LvnVec2& v3, const LvnColor& color)
+// the pipeline and descriptor set of the render mode are bound, the batch buffer replaces the buffer of the frame
+static void renderModeDrawStatic2d(LvnRenderer* renderer, LvnRenderMode& renderMode, const LvnStaticBatchDraw& draw, uint64_t count)
 {
-    LvnVertexData2d vertices[] =
-    {
-        { v1, color, {0.0f, 0.0f} },
-        { v2, color, {0.5f, 1.0f} },
-        { v3, color, {1.0f, 0.0f} },
-    };
+    const LvnStaticBatchPart& part = draw.batch->parts[&renderMode - renderer->renderModes.data()];
+    LvnBuffer* buffer = draw.batch->buffer;
+    uint64_t vertexOffset = part.vertexOffset;
 
-    uint32_t indices[] = { 0, 1, 2 };
+    lvn::renderCmdPushConstants(renderer->window, renderMode.pipeline, Lvn_ShaderStage_Vertex, 0, sizeof(LvnMat4), &draw.transform);
 
-    LvnDrawCommand drawCmd{};
-    drawCmd.pVertices = vertices;
-    drawCmd.vertexCount = 3;
-    drawCmd.pIndices = indices;
-    drawCmd.indexCount = 3;
-    drawCmd.vertexStride = sizeof(LvnVertexData2d);
+    if (renderMode.quadBuffer)
+    {
+        LvnBuffer* vertexBuffers[] = { renderMode.quadBuffer, buffer };
+        uint64_t vertexOffsets[] = { 0, vertexOffset };
+        lvn::renderCmdBindVertexBuffer(renderer->window, 0, 2, vertexBuffers, vertexOffsets);
+        lvn::renderCmdDrawIndexedInstanced(renderer->window, 6, count, 0);
+        return;
+    }
 
-    LvnRenderer* renderer = s_Renderer.get();
-    renderer->renderModes[Lvn_RenderMode_2d].drawList.push_back(drawCmd);
+    lvn::renderCmdBindVertexBuffer(renderer->window, 0, 1, &buffer, &vertexOffset);
+    lvn::renderCmdBindIndexBuffer(renderer->window, buffer, part.indexOffset);
+    lvn::renderCmdDrawIndexed(renderer->window, count);
 }
 
-void drawRect(const LvnVec2& pos, const LvnVec2& size, const LvnColor& color)
+// the projection is written here since the size of the target is only known once the frame is handed over
+static void particleSystemSimulate(LvnRenderer* renderer, LvnParticleDraw& draw)
 {
-    LvnVertexData2d vertices[] =
-    {
-        {{ pos.x, pos.y + size.y },          color, {0.0f, 1.0f} },
-        {{ pos.x, pos.y },                   color, {0.0f, 0.0f} },
-        {{ pos.x + size.x, pos.y },          color, {1.0f, 0.0f} },
-        {{ pos.x + size.x, pos.y + size.y }, color, {1.0f, 1.0f} },
-    };
+    LvnParticleSystem* particleSystem = draw.system;
+    int width = renderer->frameWidth, height = renderer->frameHeight;
+    draw.uniform.projMat = lvn::ortho((float)width * -0.5f, (float)width * 0.5f, (float)height * -0.5f, (float)height * 0.5f, -1.0f, 1.0f);
 
-    uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+    uint8_t* mapped = static_cast<uint8_t*>(lvn::bufferMap(particleSystem->uniformBuffer));
+    if (!mapped)
+        return;
 
-    LvnDrawCommand drawCmd{};
-    drawCmd.pVertices = vertices;
-    drawCmd.vertexCount = 4;
-    drawCmd.pIndices = indices;
-    drawCmd.indexCount = 6;
-    drawCmd.vertexStride = sizeof(LvnVertexData2d);
+    memcpy(mapped, &draw.uniform, sizeof(LvnParticleUniformData));
+    lvn::bufferUnmapRange(particleSystem->uniformBuffer, 0, sizeof(LvnParticleUniformData));
 
-    LvnRenderer* renderer = s_Renderer.get();
-    renderer->renderModes[Lvn_RenderMode_2d].drawList.push_back(drawCmd);
+    lvn::renderCmdBindPipeline(renderer->window, particleSystem->computePipeline);
+    lvn::renderCmdBindDescriptorSets(renderer->window, particleSystem->computePipeline, 0, 1, &particleSystem->descriptorSet);
+    lvn::renderCmdDispatch(renderer->window, (particleSystem->maxParticles + LVN_PARTICLE_GROUP_SIZE - 1) / LVN_PARTICLE_GROUP_SIZE, 1, 1);
 }
 
-void drawRectEx(const LvnRect& rect)
+// binding 0 is the unit quad of the circle render mode, binding 1 is the particle buffer read per instance
+static void particleSystemDraw(LvnRenderer* renderer, const LvnParticleDraw& draw)
 {
+    LvnParticleSystem* particleSystem = draw.system;
+    LvnBuffer* quadBuffer = renderer->renderModes[Lvn_RenderMode_2dCircle].quadBuffer;
 
+    lvn::renderCmdBindPipeline(renderer->window, particleSystem->pipeline);
+    lvn::renderCmdBindDescriptorSets(renderer->window, particleSystem->pipeline, 0, 1, &particleSystem->descriptorSet);
+
+    LvnBuffer* vertexBuffers[] = { quadBuffer, particleSystem->particleBuffer };
+    uint64_t vertexOffsets[] = { 0, 0 };
+    lvn::renderCmdBindVertexBuffer(renderer->window, 0, 2, vertexBuffers, vertexOffsets);
+    lvn::renderCmdBindIndexBuffer(renderer->window, quadBuffer, 4 * sizeof(LvnVec2));
+    lvn::renderCmdDrawIndexedInstanced(renderer->window, 6, particleSystem->maxParticles, 0);
 }
 
-void drawCircle(const LvnVec2& pos, float radius, const LvnColor& color)
+static uint64_t renderGetSortKey(uint32_t textureBatch)
 {
-    lvn::drawPolyNgonSector(pos, radius, 0, 360, 36, color);
+    // the clip rect sits where the render mode goes in the packet key, renderBuildPackets moves it into the packet
+    const LvnDrawClipStack& clipStack = lvn::renderGetClipStack(s_Renderer);
+    uint64_t clip = clipStack.clips.empty() ? 0 : clipStack.clips.back().index;
+
+    // the layer is biased so negative layers sort before positive layers
+    return ((uint64_t)((uint32_t)s_DrawLayer ^ 0x80000000u) << 32) | (clip << 16) | textureBatch;
 }
 
-void drawCircleSector(const LvnVec2& pos, float radius, float startAngle, float endAngle, const LvnColor& color)
+static LvnDrawClipStack& renderGetClipStack(const LvnRenderer* renderer)
 {
-    lvn::drawPolyNgonSector(pos, radius, startAngle, endAngle, 36, color);
+    LvnDrawClipStack& clipStack = s_DrawClipStack;
+    if (clipStack.renderer != renderer || clipStack.frameIndex != s_DrawFrameIndex)
+    {
+        clipStack.renderer = renderer;
+        clipStack.frameIndex = s_DrawFrameIndex;
+        clipStack.clips.clear();
+    }
+
+    return clipStack;
 }
 
-void drawPolyNgon(const LvnVec2& pos, float radius, uint32_t nSides, const LvnColor& color)
+// tests bounds in world units against the innermost clip rect, or the render area without one
+static bool renderIsVisible(const LvnRenderer* renderer, float minX, float minY, float maxX, float maxY)
 {
-    lvn::drawPolyNgonSector(pos, radius, 0, 360, nSides, color);
+    // a static batch is drawn with transforms that are not known while it is recorded
+    if (renderer->recordingBatch)
+        return true;
+
+    const LvnDrawClipStack& clipStack = lvn::renderGetClipStack(renderer);
+    const LvnDrawClipRect& bounds = clipStack.clips.empty() ? renderer->viewBounds : clipStack.clips.back().bounds;
+    return maxX > bounds.minX && minX < bounds.maxX && maxY > bounds.minY && minY < bounds.maxY;
 }
 
-void drawPolyNgonSector(const LvnVec2& pos, float radius, float startAngle, float endAngle, uint32_t nSides, const LvnColor& color)
+// converts the clip rect from world units into pixels of the render area, the scissor rounds outwards so edges on half pixels are kept
+static void renderSetClipScissor(LvnRenderer* renderer, uint32_t clip)
 {
-    if (startAngle == endAngle)
-        return;
-    if (radius <= 0.0f)
-        return;
-    if (nSides == 0)
+    if (clip == 0)
+    {
+        lvn::renderCmdSetScissor(renderer->window, 0, 0, (uint32_t)renderer->frameWidth, (uint32_t)renderer->frameHeight);
         return;
+    }
 
-    uint32_t minSides = (uint32_t)ceilf(abs(endAngle - startAngle)) / 90;
-    if (nSides < minSides)
-        nSides = minSides;
+    const LvnDrawClipRect& rect = renderer->clipRects[clip - 1];
+    float halfWidth = (float)renderer->frameWidth * 0.5f, halfHeight = (float)renderer->frameHeight * 0.5f;
+    int32_t x0 = (int32_t)floorf(rect.minX + halfWidth), y0 = (int32_t)floorf(rect.minY + halfHeight);
+    int32_t x1 = (int32_t)ceilf(rect.maxX + halfWidth), y1 = (int32_t)ceilf(rect.maxY + halfHeight);
+    x0 = lvn::max(x0, 0);
+    y0 = lvn::max(y0, 0);
+
+    lvn::renderCmdSetScissor(renderer->window, x0, y0, (uint32_t)lvn::max(x1 - x0, 0), (uint32_t)lvn::max(y1 - y0, 0));
+}
 
-    LvnVector<LvnVertexData2d> vertices(nSides + 2);
-    LvnVector<uint32_t> indices((nSides + 2) * 3);
+// records and submits the frame moved into the draw lists by renderSwapFrame, runs on the render thread in render thread mode
+static void renderSubmitFrame(LvnRenderer* renderer)
+{
+    LVN_PROFILE_FUNCTION();
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Renderer);
 
-    float angle = lvn::radians(abs(endAngle - startAngle)) / (float)nSides;
+    // sort the draws of every render mode by layer, then render mode, then texture batch
+    for (auto& renderMode : renderer->renderModes)
+        lvn::renderModePrepareDraw2d(renderer, renderMode);
 
-    vertices[0] = { pos, color, {0.5f,0.5f} };
+    lvn::renderBuildPackets(renderer);
+    lvn::renderSortPackets(renderer);
+    lvn::renderReorderPackets(renderer);
 
-    for (uint32_t i = 0; i < nSides; i++)
+    for (auto& renderMode : renderer->renderModes)
     {
-        float circlex = cos(i * angle);
-        float circley = sin(i * angle);
-        float posx = pos.x + (radius * circlex);
-        float posy = pos.y + (radius * circley);
-        vertices[i + 1] = { {posx,posy}, color, {(circlex + 1) * 0.5f , (circley + 1) * 0.5f} };
-
-        circlex = cos((i + 1) * angle);
-        circley = sin((i + 1) * angle);
-        posx = pos.x + (radius * circlex);
-        posy = pos.y + (radius * circley);
-        vertices[i + 2] = { {posx,posy}, color, {(circlex + 1) * 0.5f , (circley + 1) * 0.5f} };
+        if (renderMode.vertexCount == 0 && !renderMode.staticDrawn)
+            continue;
 
-        indices[i * 3 + 0] = (0);
-        indices[i * 3 + 1] = (i + 1);
-        indices[i * 3 + 2] = (i + 2);
+        // vertices, indices and uniforms share one buffer, their writes are flushed with a single upload
+        lvn::renderModeUpload2d(renderMode);
+        renderMode.updateFunc(renderer, renderMode);
+        lvn::bufferUnmapRange(renderMode.buffer, 0, 0);
     }
 
-    // if full circle, connect last vertiex with first vertex of circle side to avoid precision errors
-    if ((uint32_t)abs(endAngle - startAngle) == 360)
-        indices.back() = indices[1];
-
-    LvnDrawCommand drawCmd{};
-    drawCmd.pVertices = vertices.data();
-    drawCmd.vertexCount = vertices.size();
-    drawCmd.pIndices = indices.data();
-    drawCmd.indexCount = indices.size();
-    drawCmd.vertexStride = sizeof(LvnVertexData2d);
-
-    LvnRenderer* renderer = s_Renderer.get();
-    renderer->renderModes[Lvn_RenderMode_2d].drawList.push_back(drawCmd);
-}
-
-void drawText(const char* text, const LvnVec2& pos, const LvnColor& color, float scale)
-{
-    drawTextEx(text, pos, color, scale, 2.0f, 0.0f);
-}
-
-void drawTextEx(const char* text, const LvnVec2& pos, const LvnColor& color, float scale, float lineHeight, float textBoxWidth)
-{
-    LvnRenderer* renderer = s_Renderer.get();
-    LvnVec2 pen = pos;
-    float sentenceLength = 0.0f;
-
-    if (lineHeight < 0)
-        lineHeight = 0;
+    // dispatches cannot be recorded within a render pass, every particle system drawn this frame is stepped before the pass begins
+    for (auto& draw : renderer->particleDraws)
+        lvn::particleSystemSimulate(renderer, draw);
+    if (!renderer->particleDraws.empty())
+        lvn::renderCmdMemoryBarrier(renderer->window, Lvn_MemoryBarrier_VertexBuffer);
 
-    for (uint32_t i = 0; i < strlen(text);)
+    // the pass begins after the uploads so offscreen renderers can record their passes before the pass of the window
+    if (renderer->frameBuffer)
     {
-        uint32_t codePointBytes = 0;
-        uint32_t codepoint = lvn::decodeCodepointUTF8(&text[i], &codePointBytes);
-        LvnFontGlyph glyph = lvn::fontGetGlyph(renderer->defaultFont, codepoint);
-        i += codePointBytes;
+        lvn::frameBufferSetClearColor(renderer->frameBuffer, 0, renderer->frameClearColor.r, renderer->frameClearColor.g, renderer->frameClearColor.b, renderer->frameClearColor.a);
+        lvn::renderCmdBeginFrameBuffer(renderer->window, renderer->frameBuffer);
+    }
+    else
+        lvn::renderCmdBeginRenderPass(renderer->window, renderer->frameClearColor.r, renderer->frameClearColor.g, renderer->frameClearColor.b, renderer->frameClearColor.a);
+
+    // consecutive packets of the same render mode and texture batch with contiguous ranges are drawn together
+    // the pipeline is only bound when the render mode changes
+    // beginning the pass reset the scissor to the whole render area
+    uint32_t boundMode = UINT32_MAX;
+    uint64_t boundBatch = 0;
+    uint32_t boundClip = 0;
+    bool staticBound = false; // a static batch replaced the buffers and transform of the bound render mode
+    for (uint64_t i = 0; i < renderer->packets.size();)
+    {
+        const LvnRenderPacket& packet = renderer->packets[i];
+        LvnRenderMode& renderMode = renderer->renderModes[packet.renderMode];
+        uint64_t batch = packet.sortKey & 0xffff;
 
-        if (codepoint == '\n')
+        if (packet.clip != boundClip)
         {
-            pen.y -= (renderer->defaultFont.fontSize + lineHeight) * scale;
-            pen.x = pos.x;
+            lvn::renderSetClipScissor(renderer, packet.clip);
+            boundClip = packet.clip;
+        }
+
+        if (packet.particleDraw != UINT32_MAX)
+        {
+            lvn::particleSystemDraw(renderer, renderer->particleDraws[packet.particleDraw]);
+            boundMode = UINT32_MAX;
+            i++;
             continue;
         }
 
-        if (textBoxWidth > 0)
+        if (packet.staticDraw != UINT32_MAX)
         {
-            // get the length of the next word
-            float wordLength = 0.0f;
-            codePointBytes = 0;
-            for (uint32_t j = i; j < strlen(text);)
+            if (packet.renderMode != boundMode)
             {
-                if (text[j] == ' ')
-                    break;
-
-                uint32_t wordcp = lvn::decodeCodepointUTF8(&text[j], &codePointBytes);
-                LvnFontGlyph wordGlyph = lvn::fontGetGlyph(renderer->defaultFont, wordcp);
-                j += codePointBytes;
-                wordLength += wordGlyph.advance * scale;
+                lvn::renderModeBind2d(renderer, renderMode);
+                boundMode = packet.renderMode;
+                boundBatch = 0;
             }
 
-            if (sentenceLength + wordLength > textBoxWidth)
-            {
-                pen.y -= (renderer->defaultFont.fontSize + lineHeight) * scale;
-                pen.x = pos.x;
-                sentenceLength = 0;
+            lvn::renderModeDrawStatic2d(renderer, renderMode, renderer->staticDraws[packet.staticDraw], packet.count);
+            staticBound = true;
+            i++;
+            continue;
+        }
 
-                // if space char, skip drawing space on next line
-                if (codepoint == 32)
-                    continue;
+        uint64_t count = packet.count;
+        uint64_t j = i + 1;
+        for (; j < renderer->packets.size(); j++)
+        {
+            const LvnRenderPacket& next = renderer->packets[j];
+            if (next.sortKey != packet.sortKey || next.clip != packet.clip || next.staticDraw != UINT32_MAX || next.particleDraw != UINT32_MAX || next.first != packet.first + count)
+                break;
+            count += next.count;
+        }
+
+        if (packet.renderMode != boundMode || staticBound)
+        {
+            lvn::renderModeBind2d(renderer, renderMode);
+            boundMode = packet.renderMode;
+            boundBatch = 0;
+            staticBound = false;
+        }
+
+        if (batch != boundBatch)
+        {
+            lvn::renderCmdBindDescriptorSets(renderer->window, renderMode.pipeline, 0, 1, &renderMode.batchDescriptorSets[batch]);
+            boundBatch = batch;
+        }
+
+        renderMode.drawFunc(renderer, renderMode, packet.first, count);
+        i = j;
+    }
+
+    if (renderer->frameBuffer)
+    {
+        lvn::renderCmdEndFrameBuffer(renderer->window, renderer->frameBuffer);
+        return;
+    }
+
+    lvn::renderCmdEndRenderPass(renderer->window);
+    lvn::renderEndCommandRecording(renderer->window);
+    lvn::renderDrawSubmit(renderer->window);
+}
+
+// moves the recorded draws into the submitted draw lists and copies the state the submission reads, called on the window thread
+static void renderSwapFrame(LvnRenderer* renderer)
+{
+    for (auto& renderMode : renderer->renderModes)
+    {
+        renderMode.drawList.swap(renderMode.recordDrawList);
+        std::swap(renderMode.batchTextures, renderMode.recordBatchTextures);
+    }
+    std::swap(renderer->staticDraws, renderer->recordStaticDraws);
+    std::swap(renderer->particleDraws, renderer->recordParticleDraws);
+    std::swap(renderer->clipRects, renderer->recordClipRects);
+
+    renderer->frameClearColor = renderer->clearColor;
+    lvn::renderGetTargetSize(renderer, &renderer->frameWidth, &renderer->frameHeight);
+}
+
+static void* renderThreadFunc(void* arg)
+{
+    LvnRenderer* renderer = static_cast<LvnRenderer*>(arg);
+
+    std::unique_lock<std::mutex> lock(renderer->renderThreadMutex);
+    while (true)
+    {
+        renderer->renderThreadCondition.wait(lock, [renderer]() { return renderer->renderFramePending || renderer->renderThreadStop; });
+
+        // a frame handed over before the stop is still submitted
+        if (!renderer->renderFramePending)
+            break;
+
+        lock.unlock();
+        lvn::renderBeginNextFrame(renderer->window);
+        lvn::renderBeginCommandRecording(renderer->window);
+        lvn::renderSubmitFrame(renderer);
+        lock.lock();
+
+        renderer->renderFramePending = false;
+        renderer->renderThreadCondition.notify_all();
+    }
+
+    return nullptr;
+}
+
+// starts or stops the render thread to match renderSetRenderThread, called by drawBegin before the frame begins
+static void renderUpdateThread(LvnRenderer* renderer)
+{
+    if (renderer->renderThreadEnabled == (renderer->renderThread != nullptr))
+        return;
+
+    if (!renderer->renderThreadEnabled)
+    {
+        lvn::renderStopThread(renderer);
+        return;
+    }
+
+    // geometry written directly would land in the buffer region the render thread is submitting
+    for (auto& renderMode : renderer->renderModes)
+    {
+        renderMode.mappedData = nullptr;
+        renderMode.cursor.reset();
+    }
+
+    renderer->renderFramePending = false;
+    renderer->renderThreadStop = false;
+    renderer->renderThread = new LvnThread(lvn::renderThreadFunc, renderer);
+}
+
+static void renderWaitFrame(LvnRenderer* renderer)
+{
+    if (!renderer->renderThread)
+        return;
+
+    std::unique_lock<std::mutex> lock(renderer->renderThreadMutex);
+    renderer->renderThreadCondition.wait(lock, [renderer]() { return !renderer->renderFramePending; });
+}
+
+static void renderStopThread(LvnRenderer* renderer)
+{
+    if (!renderer->renderThread)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(renderer->renderThreadMutex);
+        renderer->renderThreadStop = true;
+    }
+    renderer->renderThreadCondition.notify_all();
+
+    // joins once the pending frame is submitted
+    delete renderer->renderThread;
+    renderer->renderThread = nullptr;
+}
+
+static void renderBuildPackets(LvnRenderer* renderer)
+{
+    renderer->packets.clear();
+
+    for (uint32_t i = 0; i < renderer->renderModes.size(); i++)
+    {
+        LvnRenderMode& renderMode = renderer->renderModes[i];
+        bool instanced = renderMode.quadBuffer != nullptr;
+
+        // geometry written directly without a draw list has no commands and is drawn as one range
+        if (renderMode.drawList.empty())
+        {
+            if (renderMode.vertexCount > 0)
+            {
+                LvnRenderPacket packet{};
+                packet.sortKey = (LVN_RENDER_DEFAULT_SORT_KEY & 0xffffffff00000000ull) | ((uint64_t)i << 16);
+                packet.renderMode = i;
+                packet.command = UINT32_MAX;
+                packet.staticDraw = UINT32_MAX;
+                packet.particleDraw = UINT32_MAX;
+                packet.clip = 0;
+                packet.first = 0;
+                packet.count = instanced ? renderMode.vertexCount : renderMode.indexCount;
+                renderer->packets.push_back(packet);
+            }
+        }
+        else
+        {
+            const LvnDrawListCommand* commands = renderMode.drawList.commands();
+            for (uint32_t j = 0; j < renderMode.drawList.command_count(); j++)
+            {
+                LvnRenderPacket packet{};
+                packet.sortKey = (commands[j].sortKey & 0xffffffff00000000ull) | ((uint64_t)i << 16) | (commands[j].sortKey & 0xffff);
+                packet.renderMode = i;
+                packet.command = j;
+                packet.staticDraw = UINT32_MAX;
+                packet.particleDraw = UINT32_MAX;
+                packet.clip = (uint32_t)((commands[j].sortKey >> 16) & 0xffff);
+                packet.first = instanced ? commands[j].firstVertex : commands[j].firstIndex;
+                packet.count = instanced ? commands[j].vertexCount : commands[j].indexCount;
+                if (packet.count > 0)
+                    renderer->packets.push_back(packet);
             }
+        }
 
-            sentenceLength += glyph.advance * scale;
+        // static batches follow the geometry of the frame so packets built in order stay sorted when layers are not used
+        renderMode.staticDrawn = false;
+        for (uint32_t j = 0; j < renderer->staticDraws.size(); j++)
+        {
+            const LvnStaticBatchDraw& draw = renderer->staticDraws[j];
+            if (draw.batch->parts[i].count == 0)
+                continue;
+
+            LvnRenderPacket packet{};
+            packet.sortKey = (draw.sortKey & 0xffffffff00000000ull) | ((uint64_t)i << 16);
+            packet.renderMode = i;
+            packet.command = UINT32_MAX;
+            packet.staticDraw = j;
+            packet.particleDraw = UINT32_MAX;
+            packet.clip = (uint32_t)((draw.sortKey >> 16) & 0xffff);
+            packet.first = 0;
+            packet.count = draw.batch->parts[i].count;
+            renderer->packets.push_back(packet);
+            renderMode.staticDrawn = true;
         }
+    }
+
+    // particle systems sort after every render mode on their layer, the render mode index only has to be valid
+    for (uint32_t i = 0; i < renderer->particleDraws.size(); i++)
+    {
+        const LvnParticleDraw& draw = renderer->particleDraws[i];
+
+        LvnRenderPacket packet{};
+        packet.sortKey = (draw.sortKey & 0xffffffff00000000ull) | ((uint64_t)Lvn_RenderMode_Max_Value << 16);
+        packet.renderMode = Lvn_RenderMode_2dCircle;
+        packet.command = UINT32_MAX;
+        packet.staticDraw = UINT32_MAX;
+        packet.particleDraw = i;
+        packet.clip = (uint32_t)((draw.sortKey >> 16) & 0xffff);
+        packet.first = 0;
+        packet.count = draw.system->maxParticles;
+        renderer->packets.push_back(packet);
+    }
+}
 
-        float xpos = pen.x + glyph.bearing.x * scale;
-        float ypos = pen.y - (glyph.size.y - glyph.bearing.y) * scale;
+static void renderSortPackets(LvnRenderer* renderer)
+{
+    LvnVector<LvnRenderPacket>& packets = renderer->packets;
+    LvnVector<LvnRenderPacket>& scratch = renderer->packetScratch;
 
-        float w = glyph.size.x * scale;
-        float h = glyph.size.y * scale;
+    // nothing to do when the submission order is already sorted, which is the case when layers are not used
+    bool sorted = true;
+    for (uint64_t i = 1; i < packets.size() && sorted; i++)
+        sorted = packets[i - 1].sortKey <= packets[i].sortKey;
 
-        pen.x += glyph.advance * scale;
+    if (sorted)
+        return;
+
+    // count every digit in one pass, digits shared by all packets are skipped
+    uint64_t counts[8][256] = {};
+    for (uint64_t i = 0; i < packets.size(); i++)
+        for (uint32_t d = 0; d < 8; d++)
+            counts[d][(packets[i].sortKey >> (d * 8)) & 0xff]++;
+
+    scratch.resize(packets.size());
+    LvnRenderPacket* src = packets.data();
+    LvnRenderPacket* dst = scratch.data();
+
+    // least significant digit first, each pass is stable so packets with the same key keep their submission order
+    for (uint32_t d = 0; d < 8; d++)
+    {
+        if (counts[d][(src[0].sortKey >> (d * 8)) & 0xff] == packets.size())
+            continue;
+
+        uint64_t offsets[256];
+        uint64_t offset = 0;
+        for (uint32_t b = 0; b < 256; b++)
+        {
+            offsets[b] = offset;
+            offset += counts[d][b];
+        }
+
+        for (uint64_t i = 0; i < packets.size(); i++)
+            dst[offsets[(src[i].sortKey >> (d * 8)) & 0xff]++] = src[i];
+
+        std::swap(src, dst);
+    }
+
+    if (src != packets.data())
+        memcpy(packets.data(), src, packets.size() * sizeof(LvnRenderPacket));
+}
+
+static void renderReorderPackets(LvnRenderer* renderer)
+{
+    // a render mode only needs its geometry reordered if its packets are out of submission order after sorting
+    for (auto& renderMode : renderer->renderModes)
+        renderMode.sorted = false;
+
+    LvnSmallVector<uint64_t, 16> lastFirst(renderer->renderModes.size());
+    for (const LvnRenderPacket& packet : renderer->packets)
+    {
+        if (packet.staticDraw != UINT32_MAX || packet.particleDraw != UINT32_MAX)
+            continue;
+
+        if (packet.first < lastFirst[packet.renderMode])
+            renderer->renderModes[packet.renderMode].sorted = true;
+        lastFirst[packet.renderMode] = packet.first + packet.count;
+    }
+
+    for (auto& renderMode : renderer->renderModes)
+    {
+        if (!renderMode.sorted)
+            continue;
+
+        if (renderMode.quadBuffer)
+        {
+            renderMode.sortedVertices.resize(renderMode.drawList.vertex_size());
+            renderMode.sortedIndices.clear();
+        }
+        else
+        {
+            renderMode.sortedIndices.resize(renderMode.drawList.index_count());
+            renderMode.sortedVertices.clear();
+        }
+
+        lastFirst[&renderMode - renderer->renderModes.data()] = 0;
+    }
+
+    // copy each packet to the end of its render mode's sorted stream, packets that follow each other now have contiguous ranges
+    for (LvnRenderPacket& packet : renderer->packets)
+    {
+        LvnRenderMode& renderMode = renderer->renderModes[packet.renderMode];
+        if (!renderMode.sorted || packet.staticDraw != UINT32_MAX || packet.particleDraw != UINT32_MAX)
+            continue;
+
+        uint64_t first = lastFirst[packet.renderMode];
+        if (renderMode.quadBuffer)
+            memcpy(renderMode.sortedVertices.data() + first * renderMode.vertexStride, static_cast<uint8_t*>(renderMode.drawList.vertices()) + packet.first * renderMode.vertexStride, packet.count * renderMode.vertexStride);
+        else
+            memcpy(renderMode.sortedIndices.data() + first, renderMode.drawList.indices() + packet.first, packet.count * sizeof(uint32_t));
+
+        packet.first = first;
+        lastFirst[packet.renderMode] = first + packet.count;
+    }
+}
+
+static uint32_t renderModeGetTextureSlot(LvnRenderer* renderer, const LvnTexture* texture)
+{
+    if (s_BatchTextureCache.renderer == renderer && s_BatchTextureCache.frameIndex == s_DrawFrameIndex && s_BatchTextureCache.texture == texture)
+        return s_BatchTextureCache.slot;
+
+    LvnLockGaurd lock(renderer->batchTextureMutex);
+    LvnVector<const LvnTexture*>& batchTextures = renderer->renderModes[Lvn_RenderMode_2dSprite].recordBatchTextures;
+
+    uint32_t slot = UINT32_MAX;
+    for (uint32_t i = 0; i < batchTextures.size(); i++)
+    {
+        if (batchTextures[i] == texture)
+        {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot == UINT32_MAX)
+    {
+        if (batchTextures.size() >= LVN_RENDER_MODE_TEXTURE_SLOTS * LVN_RENDER_MODE_TEXTURE_BATCHES)
+        {
+            LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_WARN, "[renderer]: sprite texture (%p) not drawn, a frame can use at most %u different sprite textures", texture, LVN_RENDER_MODE_TEXTURE_SLOTS * LVN_RENDER_MODE_TEXTURE_BATCHES);
+            return UINT32_MAX;
+        }
+
+        slot = batchTextures.size();
+        batchTextures.push_back(texture);
+    }
+
+    s_BatchTextureCache = { renderer, s_DrawFrameIndex, texture, slot };
+    return slot;
+}
+
+static void renderPushSprite(const LvnTexture* texture, const LvnUVBox& uv, const LvnVec2& pos, const LvnVec2& size, const LvnColor& color)
+{
+    LvnRenderer* renderer = s_Renderer;
+    if (!lvn::renderIsVisible(renderer, lvn::min(pos.x, pos.x + size.x), lvn::min(pos.y, pos.y + size.y), lvn::max(pos.x, pos.x + size.x), lvn::max(pos.y, pos.y + size.y)))
+        return;
+
+    // texture slots are assigned per frame, a batch drawn in later frames could not keep them
+    if (renderer->recordingBatch)
+    {
+        LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_WARN, "[renderer]: sprite texture (%p) not recorded, textured sprites cannot be drawn into a static batch", texture);
+        return;
+    }
+
+    uint32_t slot = lvn::renderModeGetTextureSlot(renderer, texture);
+    if (slot == UINT32_MAX)
+        return;
+
+    // uv boxes follow the image rows top to bottom, the bottom left corner of the quad samples uv.y1
+    LvnQuadInstanceData2d instance{};
+    instance.rect = { pos.x, pos.y, size.x, size.y };
+    instance.texRect = { uv.x0, uv.y1, uv.x1, uv.y0 };
+    instance.texId = (float)slot;
+    instance.color = color;
+
+    lvn::renderModePushQuad(renderer->renderModes[Lvn_RenderMode_2dSprite], instance, lvn::renderGetSortKey(slot / LVN_RENDER_MODE_TEXTURE_SLOTS));
+}
+
+
+static const LvnVec2* renderGetUnitCircle(uint32_t nSides)
+{
+    if (s_UnitCircleTables.contains(nSides))
+        return s_UnitCircleTables[nSides].data();
+
+    LvnVector<LvnVec2> unitCircle(nSides + 1);
+    float angle = lvn::radians(360.0f) / (float)nSides;
+    for (uint32_t i = 0; i < nSides; i++)
+        unitCircle[i] = { cosf(i * angle), sinf(i * angle) };
+    unitCircle[nSides] = unitCircle[0];
+
+    s_UnitCircleTables.insert(nSides, lvn::move(unitCircle));
+    return s_UnitCircleTables[nSides].data();
+}
+
+static void renderBuildTextLayout(LvnRenderer* renderer, const char* text, float scale, float lineHeight, float textBoxWidth, LvnTextLayout* layout)
+{
+    LvnVec2 pen = { 0.0f, 0.0f };
+    float sentenceLength = 0.0f;
+    size_t textLength = strlen(text);
+
+    if (lineHeight < 0)
+        lineHeight = 0;
+
+    // the text is decoded once up front, wrapping looks ahead over each word without decoding it again
+    LvnVector<uint32_t>& codepoints = s_TextCodepoints;
+    codepoints.resize_uninitialized(textLength);
+    uint32_t length = lvn::decodeUTF8(text, textLength, codepoints.data());
+
+    layout->glyphs.clear();
+    layout->glyphs.reserve(length);
+
+    // length of the rest of the current word, measured once per word and shortened as each glyph is placed
+    float wordLength = 0.0f;
+    bool wordMeasured = false;
 
-        LvnVertexData2d vertices[] =
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint32_t codepoint = codepoints[i];
+        LvnFontGlyph glyph = lvn::fontGetGlyph(renderer->defaultFont, codepoint);
+
+        if (codepoint == '\n')
         {
-            /*         pos         | color |         texUVs            */
-            { {xpos, ypos + h},      color, {glyph.uv.x0, glyph.uv.y0} },
-            { {xpos, ypos},          color, {glyph.uv.x0, glyph.uv.y1} },
-            { {xpos + w, ypos + h},  color, {glyph.uv.x1, glyph.uv.y0} },
-            { {xpos + w, ypos},      color, {glyph.uv.x1, glyph.uv.y1} },
-        };
-
-        uint32_t indices[] =
+            pen.y -= (renderer->defaultFont.fontSize + lineHeight) * scale;
+            pen.x = 0.0f;
+            wordMeasured = false;
+            continue;
+        }
+
+        if (textBoxWidth > 0)
         {
-            0, 1, 2,
-            2, 1, 3,
-        };
+            // get the length of the next word
+            if (!wordMeasured || codepoint == ' ')
+            {
+                wordLength = 0.0f;
+                for (uint32_t j = i + 1; j < length && codepoints[j] != ' '; j++)
+                    wordLength += lvn::fontGetGlyph(renderer->defaultFont, codepoints[j]).advance * scale;
+                wordMeasured = true;
+            }
+            else
+            {
+                wordLength -= glyph.advance * scale;
+            }
+
+            if (sentenceLength + wordLength > textBoxWidth)
+            {
+                pen.y -= (renderer->defaultFont.fontSize + lineHeight) * scale;
+                pen.x = 0.0f;
+                sentenceLength = 0;
+
+                // if space char, skip drawing space on next line
+                if (codepoint == 32)
+                    continue;
+            }
 
-        LvnDrawCommand drawCmd{};
-        drawCmd.pVertices = vertices;
-        drawCmd.vertexCount = 4;
-        drawCmd.pIndices = indices;
-        drawCmd.indexCount = 6;
-        drawCmd.vertexStride = sizeof(LvnVertexData2d);
+            sentenceLength += glyph.advance * scale;
+        }
+
+        LvnTextLayoutGlyph layoutGlyph{};
+        layoutGlyph.pos = { pen.x + glyph.bearing.x * scale, pen.y - (glyph.size.y - glyph.bearing.y) * scale };
+        layoutGlyph.size = { glyph.size.x * scale, glyph.size.y * scale };
+        layoutGlyph.uv = { glyph.uv.x0, glyph.uv.y0, glyph.uv.x1, glyph.uv.y1 };
+        layout->glyphs.push_back(layoutGlyph);
+
+        pen.x += glyph.advance * scale;
+    }
+}
+
+LvnResult renderInit(const char* title, int width, int height)
+{
+    LvnWindowCreateInfo windowCreateInfo = lvn::configWindowInit(title, width, height);
+    return createRendererResources(&windowCreateInfo);
+}
+
+LvnResult renderInit(const LvnWindowCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Renderer);
+    return createRendererResources(createInfo);
+}
+
+void renderTerminate()
+{
+    if (!s_InitRenderer)
+        return;
+
+    lvn::destroyRenderer(s_InitRenderer);
+    s_InitRenderer = nullptr;
+}
 
-        renderer->renderModes[Lvn_RenderMode_2dText].drawList.push_back(drawCmd);
+LvnResult createRenderer(LvnRenderer** renderer, const LvnRendererCreateInfo* createInfo)
+{
+    if (!createInfo->window)
+    {
+        LVN_CORE_ERROR("createRenderer(LvnRenderer**, const LvnRendererCreateInfo*) | createInfo->window is nullptr, a renderer needs a window to record its commands into");
+        return Lvn_Result_Failure;
+    }
+
+    if (lvn::acquireRendererSharedResources() != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createRenderer(LvnRenderer**, const LvnRendererCreateInfo*) | failed to create the shared renderer resources");
+        return Lvn_Result_Failure;
     }
+
+    *renderer = lvn::memNew<LvnRenderer>();
+    LvnRenderer* rendererPtr = *renderer;
+
+    rendererPtr->window = createInfo->window;
+    rendererPtr->frameBuffer = createInfo->frameBuffer;
+    rendererPtr->renderPass = createInfo->frameBuffer ? lvn::frameBufferGetRenderPass(createInfo->frameBuffer) : lvn::windowGetRenderPass(createInfo->window);
+    rendererPtr->ownsWindow = false;
+
+    // set background clear color
+    rendererPtr->clearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+    rendererPtr->directWrite = false;
+    rendererPtr->onDemand = false;
+    rendererPtr->frameClearColor = rendererPtr->clearColor;
+    rendererPtr->frameWidth = 0, rendererPtr->frameHeight = 0;
+    rendererPtr->renderThreadEnabled = false;
+    rendererPtr->renderThread = nullptr;
+    rendererPtr->renderFramePending = false;
+    rendererPtr->renderThreadStop = false;
+    rendererPtr->recordingBatch = nullptr;
+
+    rendererPtr->defaultWhiteTexture = s_RendererResources.whiteTexture;
+    rendererPtr->defaultFontTexture = s_RendererResources.fontTexture;
+    rendererPtr->defaultFont = s_RendererResources.font;
+    rendererPtr->ownsFontTexture = false;
+
+    // render modes
+    rendererPtr->renderModes.resize(Lvn_RenderMode_Max_Value);
+    rendererPtr->renderModes[Lvn_RenderMode_2d] = lvn::move(lvn::createRenderMode2d(rendererPtr, rendererPtr->defaultWhiteTexture, s_FragmentShaderSrc, false, 0));
+    rendererPtr->renderModes[Lvn_RenderMode_2dQuad] = lvn::move(lvn::createRenderMode2d(rendererPtr, rendererPtr->defaultWhiteTexture, s_FragmentShaderSrc, true, 0));
+    rendererPtr->renderModes[Lvn_RenderMode_2dCircle] = lvn::move(lvn::createRenderMode2d(rendererPtr, rendererPtr->defaultWhiteTexture, s_FragmentShaderCircleSrc, true, 0));
+    rendererPtr->renderModes[Lvn_RenderMode_2dSprite] = lvn::move(lvn::createRenderMode2d(rendererPtr, rendererPtr->defaultWhiteTexture, s_FragmentShaderSpriteSrc, true, LVN_RENDER_MODE_TEXTURE_BATCHES));
+    rendererPtr->renderModes[Lvn_RenderMode_2dText] = lvn::move(lvn::createRenderMode2d(rendererPtr, rendererPtr->defaultFontTexture, rendererPtr->defaultFont.sdfSpread > 0.0f ? s_FragmentShaderFontSdfSrc : s_FragmentShaderFontSrc, true, 0));
+
+    LVN_CORE_TRACE("created renderer: (%p), window: (%p), framebuffer: (%p)", *renderer, createInfo->window, createInfo->frameBuffer);
+    return Lvn_Result_Success;
+}
+
+void destroyRenderer(LvnRenderer* renderer)
+{
+    if (renderer == nullptr) { return; }
+
+    lvn::renderStopThread(renderer);
+
+    for (auto& renderMode : renderer->renderModes)
+        lvn::destroyRenderMode(renderMode);
+
+    if (renderer->ownsFontTexture)
+        lvn::destroyTexture(renderer->defaultFontTexture);
+    if (renderer->ownsWindow)
+        lvn::destroyWindow(renderer->window);
+
+    if (s_Renderer == renderer)
+        s_Renderer = nullptr;
+
+    lvn::memDelete(renderer);
+    lvn::releaseRendererSharedResources();
+}
+
+void renderSetCurrent(LvnRenderer* renderer)
+{
+    s_Renderer = renderer;
+}
+
+LvnRenderer* renderGetCurrent()
+{
+    return s_Renderer;
+}
+
+bool rendererIsInitialized()
+{
+    return s_Renderer != nullptr;
+}
+
+LvnWindow* getRendererWindow()
+{
+    LvnRenderer* renderer = s_Renderer;
+    return renderer->window;
+}
+
+void renderSetDirectWrite(bool enable)
+{
+    LvnRenderer* renderer = s_Renderer;
+    renderer->directWrite = enable;
+}
+
+void renderSetOnDemand(bool enable)
+{
+    LvnRenderer* renderer = s_Renderer;
+    renderer->onDemand = enable;
+
+    // the first frame after switching is always drawn
+    if (enable)
+        lvn::windowInvalidate(renderer->window);
+}
+
+bool renderWaitEvents(double timeout)
+{
+    LvnRenderer* renderer = s_Renderer;
+
+    if (!renderer->onDemand)
+    {
+        lvn::windowPollEvents();
+        return true;
+    }
+
+    // a pending request draws right away, otherwise the thread sleeps until an event of any window wakes it
+    if (renderer->window->data.redrawRequested.load(std::memory_order_acquire))
+        lvn::windowPollEvents();
+    else
+        lvn::windowWaitEvents(timeout);
+
+    return lvn::windowConsumeRedraw(renderer->window);
+}
+
+void renderSetRenderThread(bool enable)
+{
+    LvnRenderer* renderer = s_Renderer;
+
+    if (enable && renderer->frameBuffer)
+    {
+        LVN_CORE_WARN("renderSetRenderThread(bool) | renderer (%p) draws to a framebuffer within the frame of its window, only renderers of a window can use a render thread", renderer);
+        return;
+    }
+    if (enable && !lvn::getContext()->multithreading)
+    {
+        LVN_CORE_WARN("renderSetRenderThread(bool) | multithreading is not enabled, frames of renderer (%p) are still submitted by drawEnd", renderer);
+        return;
+    }
+    if (enable && lvn::getGraphicsApi() != Lvn_GraphicsApi_vulkan)
+    {
+        LVN_CORE_WARN("renderSetRenderThread(bool) | the render thread needs the vulkan graphics api, the opengl context stays current on the window thread so frames of renderer (%p) are still submitted by drawEnd", renderer);
+        return;
+    }
+
+    renderer->renderThreadEnabled = enable;
+}
+
+void renderWaitIdle()
+{
+    lvn::renderWaitFrame(s_Renderer);
+}
+
+void renderSetFont(const LvnFont& font)
+{
+    LvnRenderer* renderer = s_Renderer;
+
+    // the text render mode is recreated below, the render thread may still be drawing with it
+    lvn::renderWaitFrame(renderer);
+
+    // distance fields are interpolated between texels, coverage atlases are sampled as rasterized
+    LvnTextureFilter filter = font.sdfSpread > 0.0f ? Lvn_TextureFilter_Linear : Lvn_TextureFilter_Nearest;
+
+    LvnTextureCreateInfo textureCreateInfo{};
+    textureCreateInfo.imageData = lvn::imageGetView(font.atlas);
+    textureCreateInfo.format = Lvn_TextureFormat_Unorm;
+    textureCreateInfo.wrapS = Lvn_TextureMode_ClampToEdge;
+    textureCreateInfo.wrapT = Lvn_TextureMode_ClampToEdge;
+    textureCreateInfo.minFilter = filter;
+    textureCreateInfo.magFilter = filter;
+
+    LvnTexture* fontTexture;
+    if (lvn::createTexture(&fontTexture, &textureCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("renderSetFont(const LvnFont&) | failed to create font atlas texture, the previous font is kept");
+        return;
+    }
+
+    lvn::destroyRenderMode(renderer->renderModes[Lvn_RenderMode_2dText]);
+    if (renderer->ownsFontTexture)
+        lvn::destroyTexture(renderer->defaultFontTexture);
+
+    renderer->defaultFont = font;
+    renderer->defaultFontTexture = fontTexture;
+    renderer->ownsFontTexture = true;
+    renderer->renderModes[Lvn_RenderMode_2dText] = lvn::move(lvn::createRenderMode2d(renderer, fontTexture, font.sdfSpread > 0.0f ? s_FragmentShaderFontSdfSrc : s_FragmentShaderFontSrc, true, 0));
+
+    // cached layouts were measured with the previous font
+    LvnLockGaurd lock(renderer->textLayoutMutex);
+    renderer->textLayoutCache.clear();
+}
+
+bool renderWindowOpen()
+{
+    LvnRenderer* renderer = s_Renderer;
+    return lvn::windowOpen(renderer->window);
+}
+
+LvnSprite createSprite(const LvnTextureCreateInfo& texCreateInfo, const LvnUVBox& uv)
+{
+    LvnSprite sprite;
+    sprite.uv = uv;
+    lvn::createTexture(&sprite.texture, &texCreateInfo);
+    return sprite;
+}
+
+LvnSprite createSprite(LvnTextureAtlas* atlas, uint32_t region)
+{
+    LvnTextureAtlasRegion atlasRegion = lvn::textureAtlasGetRegion(atlas, region);
+
+    LvnSprite sprite;
+    sprite.texture = lvn::textureAtlasGetPageTexture(atlas, atlasRegion.page);
+    sprite.uv = { atlasRegion.u0, atlasRegion.v0, atlasRegion.u1, atlasRegion.v1 };
+    LVN_CORE_ASSERT(sprite.texture, "atlas page (%u) has no texture, call lvn::textureAtlasUpdate() before creating sprites from it", atlasRegion.page);
+    return sprite;
+}
+
+void destroySprite(LvnSprite& sprite)
+{
+    lvn::destroyTexture(sprite.texture);
+}
+
+void drawBegin()
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Renderer);
+    LvnRenderer* renderer = s_Renderer;
+
+    // offscreen renderers draw within the frame the renderer of their window has already begun
+    if (!renderer->frameBuffer)
+    {
+        lvn::memNextFrame();
+        lvn::windowUpdate(renderer->window);
+        lvn::renderUpdateThread(renderer);
+
+        // the render thread begins the frame when drawEnd hands it over
+        if (!renderer->renderThread)
+            lvn::renderBeginNextFrame(renderer->window);
+    }
+
+    for (auto& renderMode : renderer->renderModes)
+    {
+        renderMode.recordDrawList.clear();
+        renderMode.recordBatchTextures.clear();
+        if (!renderer->renderThread)
+            renderMode.cursor.reset();
+    }
+    renderer->recordStaticDraws.clear();
+    renderer->recordParticleDraws.clear();
+    renderer->recordClipRects.clear();
+    s_DrawFrameIndex++;
+
+    int width, height;
+    lvn::renderGetTargetSize(renderer, &width, &height);
+    renderer->viewBounds = { (float)width * -0.5f, (float)height * -0.5f, (float)width * 0.5f, (float)height * 0.5f };
+
+    // strings that change every frame would grow the cache without bound, start over once it gets large
+    if (renderer->textLayoutCache.size() > LVN_TEXT_LAYOUT_CACHE_MAX)
+        renderer->textLayoutCache.clear();
+
+    // the region of the next frame is free once its fence has been waited on
+    // the buffers belong to the render thread in render thread mode, draws then always go through the draw lists
+    if (renderer->renderThread)
+        return;
+
+    for (auto& renderMode : renderer->renderModes)
+        renderMode.mappedData = renderer->directWrite ? static_cast<uint8_t*>(lvn::bufferGetMappedData(renderMode.buffer)) : nullptr;
+
+    if (!renderer->frameBuffer)
+        lvn::renderBeginCommandRecording(renderer->window);
+}
+
+void drawEnd()
+{
+    LvnRenderer* renderer = s_Renderer;
+
+    if (!renderer->renderThread)
+    {
+        lvn::renderSwapFrame(renderer);
+        lvn::renderSubmitFrame(renderer);
+        return;
+    }
+
+    // a minimized window has no swap chain to present to, the frame is dropped so the render thread never waits for the window to be restored
+    LvnPair<int> size = lvn::windowGetDimensions(renderer->window);
+    if (size.width == 0 || size.height == 0)
+        return;
+
+    // the draw lists of the previous frame are reused once it has been submitted
+    lvn::renderWaitFrame(renderer);
+    lvn::renderSwapFrame(renderer);
+
+    {
+        std::lock_guard<std::mutex> lock(renderer->renderThreadMutex);
+        renderer->renderFramePending = true;
+    }
+    renderer->renderThreadCondition.notify_all();
+}
+
+void drawClearColor(float r, float g, float b, float a)
+{
+    LvnRenderer* renderer = s_Renderer;
+    renderer->clearColor = { r, g, b, a };
+}
+
+void drawClearColor(const LvnColor& color)
+{
+    LvnRenderer* renderer = s_Renderer;
+    renderer->clearColor = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
+}
+
+void drawSetLayer(int32_t layer)
+{
+    s_DrawLayer = layer;
+}
+
+int32_t drawGetLayer()
+{
+    return s_DrawLayer;
+}
+
+void drawPushClipRect(const LvnVec2& pos, const LvnVec2& size)
+{
+    LvnRenderer* renderer = s_Renderer;
+    LvnDrawClipStack& clipStack = lvn::renderGetClipStack(renderer);
+    const LvnDrawClipRect& parent = clipStack.clips.empty() ? renderer->viewBounds : clipStack.clips.back().bounds;
+
+    // nested clips are intersected with their parent, an empty intersection culls every draw until the clip is popped
+    LvnDrawClip clip{};
+    clip.bounds.minX = lvn::max(lvn::min(pos.x, pos.x + size.x), parent.minX);
+    clip.bounds.minY = lvn::max(lvn::min(pos.y, pos.y + size.y), parent.minY);
+    clip.bounds.maxX = lvn::min(lvn::max(pos.x, pos.x + size.x), parent.maxX);
+    clip.bounds.maxY = lvn::min(lvn::max(pos.y, pos.y + size.y), parent.maxY);
+
+    if (renderer->recordingBatch)
+    {
+        LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_WARN, "[renderer]: clip rect not recorded, clip rects do not apply to draws recorded into a static batch");
+        clipStack.clips.push_back(clip);
+        return;
+    }
+
+    {
+        LvnLockGaurd lock(renderer->clipRectMutex);
+        if (renderer->recordClipRects.size() < 0xffff)
+        {
+            renderer->recordClipRects.push_back(clip.bounds);
+            clip.index = (uint32_t)renderer->recordClipRects.size();
+        }
+    }
+
+    // the sort key holds 16 bits of clip index, further clips fall back to the clip of their parent
+    if (clip.index == 0)
+    {
+        LVN_LOG_RATE_LIMIT(1, 5, LVN_CORE_WARN, "[renderer]: clip rect not recorded, a frame can use at most %u clip rects", 0xffff);
+        clip.index = clipStack.clips.empty() ? 0 : clipStack.clips.back().index;
+    }
+
+    clipStack.clips.push_back(clip);
+}
+
+void drawPopClipRect()
+{
+    LvnDrawClipStack& clipStack = lvn::renderGetClipStack(s_Renderer);
+    if (clipStack.clips.empty())
+    {
+        LVN_CORE_WARN("drawPopClipRect() | no clip rect was pushed on this thread in the current frame");
+        return;
+    }
+
+    clipStack.clips.pop_back();
+}
+
+void drawTriangle(const LvnVec2& v1, const LvnVec2& v2, const LvnVec2& v3, const LvnColor& color)
+{
+    LvnRenderer* renderer = s_Renderer;
+    if (!lvn::renderIsVisible(renderer, lvn::min(v1.x, lvn::min(v2.x, v3.x)), lvn::min(v1.y, lvn::min(v2.y, v3.y)), lvn::max(v1.x, lvn::max(v2.x, v3.x)), lvn::max(v1.y, lvn::max(v2.y, v3.y))))
+        return;
+
+    LvnVertexData2d vertices[] =
+    {
+        { v1, color, {0.0f, 0.0f} },
+        { v2, color, {0.5f, 1.0f} },
+        { v3, color, {1.0f, 0.0f} },
+    };
+
+    uint32_t indices[] = { 0, 1, 2 };
+
+    LvnDrawCommand drawCmd{};
+    drawCmd.pVertices = vertices;
+    drawCmd.vertexCount = 3;
+    drawCmd.pIndices = indices;
+    drawCmd.indexCount = 3;
+    drawCmd.vertexStride = sizeof(LvnVertexData2d);
+    drawCmd.sortKey = lvn::renderGetSortKey(0);
+
+    lvn::renderModePushDrawCmd(renderer->renderModes[Lvn_RenderMode_2d], drawCmd);
+}
+
+void drawRect(const LvnVec2& pos, const LvnVec2& size, const LvnColor& color)
+{
+    LvnRenderer* renderer = s_Renderer;
+    if (!lvn::renderIsVisible(renderer, lvn::min(pos.x, pos.x + size.x), lvn::min(pos.y, pos.y + size.y), lvn::max(pos.x, pos.x + size.x), lvn::max(pos.y, pos.y + size.y)))
+        return;
+
+    LvnQuadInstanceData2d instance{};
+    instance.rect = { pos.x, pos.y, size.x, size.y };
+    instance.texRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+    instance.color = color;
+
+    lvn::renderModePushQuad(renderer->renderModes[Lvn_RenderMode_2dQuad], instance, lvn::renderGetSortKey(0));
+}
+
+void drawRectEx(const LvnRect& rect)
+{
+    if (!rect.texture)
+    {
+        lvn::drawRect(rect.pos, rect.size, rect.color);
+        return;
+    }
+
+    lvn::renderPushSprite(rect.texture, LvnUVBox{ 0.0f, 0.0f, 1.0f, 1.0f }, rect.pos, rect.size, rect.color);
+}
+
+void drawSprite(const LvnSprite& sprite, const LvnVec2& pos, const LvnVec2& size, const LvnColor& color)
+{
+    lvn::renderPushSprite(sprite.texture, sprite.uv, pos, size, color);
+}
+
+void drawCircle(const LvnVec2& pos, float radius, const LvnColor& color)
+{
+    if (radius <= 0.0f)
+        return;
+
+    LvnRenderer* renderer = s_Renderer;
+    if (!lvn::renderIsVisible(renderer, pos.x - radius, pos.y - radius, pos.x + radius, pos.y + radius))
+        return;
+
+    LvnQuadInstanceData2d instance{};
+    instance.rect = { pos.x - radius, pos.y - radius, radius * 2.0f, radius * 2.0f };
+    instance.texRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+    instance.color = color;
+
+    lvn::renderModePushQuad(renderer->renderModes[Lvn_RenderMode_2dCircle], instance, lvn::renderGetSortKey(0));
+}
+
+void drawCircleSector(const LvnVec2& pos, float radius, float startAngle, float endAngle, const LvnColor& color)
+{
+    lvn::drawPolyNgonSector(pos, radius, startAngle, endAngle, 36, color);
+}
+
+void drawPolyNgon(const LvnVec2& pos, float radius, uint32_t nSides, const LvnColor& color)
+{
+    lvn::drawPolyNgonSector(pos, radius, 0, 360, nSides, color);
+}
+
+void drawPolyNgonSector(const LvnVec2& pos, float radius, float startAngle, float endAngle, uint32_t nSides, const LvnColor& color)
+{
+    if (startAngle == endAngle)
+        return;
+    if (radius <= 0.0f)
+        return;
+    if (nSides == 0)
+        return;
+
+    // the bounds of the whole circle are tested, sectors are rarely far enough off screen for tighter bounds to matter
+    LvnRenderer* renderer = s_Renderer;
+    if (!lvn::renderIsVisible(renderer, pos.x - radius, pos.y - radius, pos.x + radius, pos.y + radius))
+        return;
+
+    float sweep = endAngle - startAngle;
+    uint32_t minSides = (uint32_t)ceilf(fabsf(sweep)) / 90;
+    if (nSides < minSides)
+        nSides = minSides;
+
+    LvnVector<LvnVertexData2d>& vertices = s_PolygonVertices;
+    LvnVector<uint32_t>& indices = s_PolygonIndices;
+    vertices.resize(nSides + 2);
+    indices.resize(nSides * 3);
+
+    vertices[0] = { pos, color, {0.5f,0.5f}, 0.0f };
+
+    if (fabsf(sweep) >= 360.0f)
+    {
+        // full polygons read the cached unit circle, its last point is the first so the outline closes exactly
+        const LvnVec2* unitCircle = lvn::renderGetUnitCircle(nSides);
+        for (uint32_t i = 0; i <= nSides; i++)
+            vertices[i + 1] = { {pos.x + radius * unitCircle[i].x, pos.y + radius * unitCircle[i].y}, color, {(unitCircle[i].x + 1.0f) * 0.5f, (unitCircle[i].y + 1.0f) * 0.5f}, 0.0f };
+    }
+    else
+    {
+        // sectors rotate the start point by a fixed step, two sin/cos pairs per call instead of two per side
+        float step = lvn::radians(sweep) / (float)nSides;
+        float stepCos = lvn::fastCos(step), stepSin = lvn::fastSin(step);
+        float circlex = lvn::fastCos(lvn::radians(startAngle)), circley = lvn::fastSin(lvn::radians(startAngle));
+
+        for (uint32_t i = 0; i <= nSides; i++)
+        {
+            vertices[i + 1] = { {pos.x + radius * circlex, pos.y + radius * circley}, color, {(circlex + 1.0f) * 0.5f, (circley + 1.0f) * 0.5f}, 0.0f };
+
+            float nextx = circlex * stepCos - circley * stepSin;
+            circley = circlex * stepSin + circley * stepCos;
+            circlex = nextx;
+        }
+    }
+
+    for (uint32_t i = 0; i < nSides; i++)
+    {
+        indices[i * 3 + 0] = (0);
+        indices[i * 3 + 1] = (i + 1);
+        indices[i * 3 + 2] = (i + 2);
+    }
+
+    LvnDrawCommand drawCmd{};
+    drawCmd.pVertices = vertices.data();
+    drawCmd.vertexCount = vertices.size();
+    drawCmd.pIndices = indices.data();
+    drawCmd.indexCount = indices.size();
+    drawCmd.vertexStride = sizeof(LvnVertexData2d);
+    drawCmd.sortKey = lvn::renderGetSortKey(0);
+
+    lvn::renderModePushDrawCmd(renderer->renderModes[Lvn_RenderMode_2d], drawCmd);
+}
+
+void drawText(const char* text, const LvnVec2& pos, const LvnColor& color, float scale)
+{
+    drawTextEx(text, pos, color, scale, 2.0f, 0.0f);
+}
+
+void drawTextEx(const char* text, const LvnVec2& pos, const LvnColor& color, float scale, float lineHeight, float textBoxWidth)
+{
+    LvnRenderer* renderer = s_Renderer;
+    size_t length = strlen(text);
+
+    // fnv-1a over the string and the layout parameters, entries keep the string to rule out collisions
+    uint64_t key = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < length; i++)
+        key = (key ^ (uint8_t)text[i]) * 0x100000001b3ull;
+
+    float params[] = { scale, lineHeight, textBoxWidth };
+    const uint8_t* paramBytes = reinterpret_cast<const uint8_t*>(params);
+    for (size_t i = 0; i < sizeof(params); i++)
+        key = (key ^ paramBytes[i]) * 0x100000001b3ull;
+
+    LvnLockGaurd lock(renderer->textLayoutMutex);
+
+    if (renderer->textLayoutCache.contains(key))
+    {
+        const LvnTextLayoutCacheEntry& entry = renderer->textLayoutCache[key];
+        if (entry.scale == scale && entry.lineHeight == lineHeight && entry.textBoxWidth == textBoxWidth
+            && entry.text.length() == length && memcmp(entry.text.c_str(), text, length) == 0)
+        {
+            lvn::drawTextLayout(entry.layout, pos, color);
+            return;
+        }
+    }
+
+    LvnTextLayoutCacheEntry entry{};
+    entry.text = LvnString(text, length);
+    entry.scale = scale;
+    entry.lineHeight = lineHeight;
+    entry.textBoxWidth = textBoxWidth;
+    lvn::renderBuildTextLayout(renderer, text, scale, lineHeight, textBoxWidth, &entry.layout);
+
+    lvn::drawTextLayout(entry.layout, pos, color);
+    renderer->textLayoutCache.insert(key, lvn::move(entry));
+}
+
+LvnTextLayout createTextLayout(const char* text, float scale, float lineHeight, float textBoxWidth)
+{
+    LvnTextLayout layout{};
+    lvn::renderBuildTextLayout(s_Renderer, text, scale, lineHeight, textBoxWidth, &layout);
+    return layout;
+}
+
+void drawTextLayout(const LvnTextLayout& layout, const LvnVec2& pos, const LvnColor& color)
+{
+    if (layout.glyphs.empty())
+        return;
+
+    LvnRenderer* renderer = s_Renderer;
+
+    // the atlas v axis points down, the bottom left corner of the glyph samples uv.y1
+    // glyphs outside of the clip rect or render area are left out, long text scrolled mostly off screen only uploads what is visible
+    static thread_local LvnVector<LvnQuadInstanceData2d> instances;
+    instances.resize(layout.glyphs.size());
+    uint32_t instanceCount = 0;
+    for (uint32_t i = 0; i < layout.glyphs.size(); i++)
+    {
+        const LvnTextLayoutGlyph& glyph = layout.glyphs[i];
+        float x = pos.x + glyph.pos.x, y = pos.y + glyph.pos.y;
+        if (!lvn::renderIsVisible(renderer, x, y, x + glyph.size.x, y + glyph.size.y))
+            continue;
+
+        LvnQuadInstanceData2d& instance = instances[instanceCount++];
+        instance.rect = { x, y, glyph.size.x, glyph.size.y };
+        instance.texRect = { glyph.uv.x0, glyph.uv.y1, glyph.uv.x1, glyph.uv.y0 };
+        instance.texId = 0.0f;
+        instance.color = color;
+    }
+
+    if (instanceCount == 0)
+        return;
+
+    // the whole string is appended as one command
+    LvnDrawCommand drawCmd{};
+    drawCmd.pVertices = instances.data();
+    drawCmd.vertexCount = instanceCount;
+    drawCmd.pIndices = nullptr;
+    drawCmd.indexCount = 0;
+    drawCmd.vertexStride = sizeof(LvnQuadInstanceData2d);
+    drawCmd.sortKey = lvn::renderGetSortKey(0);
+
+    lvn::renderModePushDrawCmd(renderer->renderModes[Lvn_RenderMode_2dText], drawCmd);
+}
+
+LvnResult createStaticBatch(LvnStaticBatch** batch)
+{
+    LvnRenderer* renderer = s_Renderer;
+    if (!renderer)
+    {
+        LVN_CORE_ERROR("createStaticBatch(LvnStaticBatch**) | no current renderer, a static batch is drawn with the pipelines of the renderer it was created with");
+        return Lvn_Result_Failure;
+    }
+
+    *batch = lvn::memNew<LvnStaticBatch>();
+    LvnStaticBatch* batchPtr = *batch;
+    batchPtr->renderer = renderer;
+    batchPtr->buffer = nullptr;
+    for (auto& part : batchPtr->parts)
+        part = {};
+
+    return Lvn_Result_Success;
+}
+
+void destroyStaticBatch(LvnStaticBatch* batch)
+{
+    if (batch == nullptr) { return; }
+
+    if (batch->buffer)
+        lvn::destroyBuffer(batch->buffer);
+
+    lvn::memDelete(batch);
+}
+
+void staticBatchBegin(LvnStaticBatch* batch)
+{
+    LvnRenderer* renderer = s_Renderer;
+    if (renderer->recordingBatch)
+    {
+        LVN_CORE_ERROR("staticBatchBegin(LvnStaticBatch*) | batch (%p) is still being recorded, call staticBatchEnd first", renderer->recordingBatch);
+        return;
+    }
+    if (batch->renderer != renderer)
+    {
+        LVN_CORE_ERROR("staticBatchBegin(LvnStaticBatch*) | batch (%p) was created with another renderer than the current renderer", batch);
+        return;
+    }
+
+    // the draws of the frame are set aside, the following draws collect in the record draw lists
+    for (auto& renderMode : renderer->renderModes)
+    {
+        renderMode.batchDrawList.clear();
+        renderMode.batchDrawList.swap(renderMode.recordDrawList);
+        renderMode.batchMappedData = renderMode.mappedData;
+        renderMode.mappedData = nullptr;
+    }
+
+    renderer->recordingBatch = batch;
+}
+
+void staticBatchEnd()
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Renderer);
+
+    LvnRenderer* renderer = s_Renderer;
+    LvnStaticBatch* batch = renderer->recordingBatch;
+    if (!batch)
+    {
+        LVN_CORE_ERROR("staticBatchEnd() | no static batch is being recorded, call staticBatchBegin first");
+        return;
+    }
+
+    // the recorded draws and the draws of the frame trade places again
+    for (auto& renderMode : renderer->renderModes)
+    {
+        renderMode.batchDrawList.swap(renderMode.recordDrawList);
+        renderMode.mappedData = renderMode.batchMappedData;
+        renderMode.batchMappedData = nullptr;
+        renderMode.batchDrawList.merge();
+    }
+    renderer->recordingBatch = nullptr;
+
+    // every render mode gets a vertex range and an index range in one buffer, drawn in the order the draws were recorded
+    uint64_t size = 0;
+    for (uint32_t i = 0; i < renderer->renderModes.size(); i++)
+    {
+        LvnRenderMode& renderMode = renderer->renderModes[i];
+        LvnStaticBatchPart& part = batch->parts[i];
+        bool instanced = renderMode.quadBuffer != nullptr;
+
+        part.vertexOffset = size;
+        size = (size + renderMode.batchDrawList.vertex_size() + 15) & ~15ull;
+        part.indexOffset = size;
+        if (!instanced)
+            size = (size + renderMode.batchDrawList.index_size() + 15) & ~15ull;
+        part.count = instanced ? renderMode.batchDrawList.vertex_count() : renderMode.batchDrawList.index_count();
+    }
+
+    LvnVector<uint8_t> data(size);
+    for (uint32_t i = 0; i < renderer->renderModes.size(); i++)
+    {
+        LvnDrawList& drawList = renderer->renderModes[i].batchDrawList;
+        if (drawList.empty())
+            continue;
+
+        memcpy(data.data() + batch->parts[i].vertexOffset, drawList.vertices(), drawList.vertex_size());
+        if (drawList.index_size() > 0)
+            memcpy(data.data() + batch->parts[i].indexOffset, drawList.indices(), drawList.index_size());
+        drawList.clear();
+    }
+
+    // recording a batch again replaces its geometry
+    if (batch->buffer)
+    {
+        lvn::destroyBuffer(batch->buffer);
+        batch->buffer = nullptr;
+    }
+
+    if (size == 0)
+        return;
+
+    LvnBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.type = Lvn_BufferType_Vertex | Lvn_BufferType_Index;
+    bufferCreateInfo.usage = Lvn_BufferUsage_Static;
+    bufferCreateInfo.data = data.data();
+    bufferCreateInfo.size = size;
+
+    if (lvn::createBuffer(&batch->buffer, &bufferCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("[renderer]: failed to create static batch buffer, (size:%llu)", (unsigned long long)size);
+        batch->buffer = nullptr;
+        for (auto& part : batch->parts)
+            part = {};
+    }
+}
+
+void drawStaticBatch(const LvnStaticBatch* batch, const LvnMat4& transform)
+{
+    LvnRenderer* renderer = s_Renderer;
+    if (!batch->buffer || batch->renderer != renderer)
+        return;
+
+    LvnStaticBatchDraw draw{};
+    draw.batch = batch;
+    draw.transform = transform;
+    draw.sortKey = lvn::renderGetSortKey(0);
+
+    LvnLockGaurd lock(renderer->staticDrawMutex);
+    renderer->recordStaticDraws.push_back(draw);
+}
+
+LvnResult createParticleSystem(LvnParticleSystem** particleSystem, const LvnParticleSystemCreateInfo* createInfo)
+{
+    LvnMemoryScope memoryScope(Lvn_MemoryCategory_Renderer);
+    LvnRenderer* renderer = s_Renderer;
+    if (!renderer)
+    {
+        LVN_CORE_ERROR("createParticleSystem(LvnParticleSystem**, LvnParticleSystemCreateInfo*) | no current renderer, a particle system is drawn in the render pass of the renderer it was created with");
+        return Lvn_Result_Failure;
+    }
+
+    if (createInfo->maxParticles == 0)
+    {
+        LVN_CORE_ERROR("createParticleSystem(LvnParticleSystem**, LvnParticleSystemCreateInfo*) | createInfo->maxParticles is 0, cannot create particle system without particles");
+        return Lvn_Result_Failure;
+    }
+
+    uint32_t maxParticles = createInfo->maxParticles;
+
+    // zeroed particles have a lifetime of zero and start out dead
+    LvnVector<LvnParticleData> particles(maxParticles, LvnParticleData{});
+
+    LvnBufferCreateInfo particleBufferCreateInfo{};
+    particleBufferCreateInfo.type = Lvn_BufferType_Storage | Lvn_BufferType_Vertex;
+    particleBufferCreateInfo.usage = Lvn_BufferUsage_Static;
+    particleBufferCreateInfo.data = particles.data();
+    particleBufferCreateInfo.size = (uint64_t)maxParticles * sizeof(LvnParticleData);
+
+    LvnBuffer* particleBuffer;
+    if (lvn::createBuffer(&particleBuffer, &particleBufferCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createParticleSystem(LvnParticleSystem**, LvnParticleSystemCreateInfo*) | failed to create particle buffer of %u particles", maxParticles);
+        return Lvn_Result_Failure;
+    }
+
+    LvnBufferCreateInfo uniformBufferCreateInfo{};
+    uniformBufferCreateInfo.type = Lvn_BufferType_Uniform;
+    uniformBufferCreateInfo.usage = Lvn_BufferUsage_DynamicRing;
+    uniformBufferCreateInfo.data = nullptr;
+    uniformBufferCreateInfo.size = sizeof(LvnParticleUniformData);
+
+    LvnBuffer* uniformBuffer;
+    if (lvn::createBuffer(&uniformBuffer, &uniformBufferCreateInfo) != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createParticleSystem(LvnParticleSystem**, LvnParticleSystemCreateInfo*) | failed to create particle uniform buffer");
+        lvn::destroyBuffer(particleBuffer);
+        return Lvn_Result_Failure;
+    }
+
+    // one layout and set shared by the compute and graphics pipelines
+    LvnDescriptorBinding descriptorUniformBinding{};
+    descriptorUniformBinding.binding = 0;
+    descriptorUniformBinding.descriptorType = Lvn_DescriptorType_UniformBuffer;
+    descriptorUniformBinding.shaderStage = Lvn_ShaderStage_All;
+    descriptorUniformBinding.descriptorCount = 1;
+    descriptorUniformBinding.maxAllocations = 1;
+
+    LvnDescriptorBinding descriptorStorageBinding{};
+    descriptorStorageBinding.binding = 1;
+    descriptorStorageBinding.descriptorType = Lvn_DescriptorType_StorageBuffer;
+    descriptorStorageBinding.shaderStage = Lvn_ShaderStage_Compute;
+    descriptorStorageBinding.descriptorCount = 1;
+    descriptorStorageBinding.maxAllocations = 1;
+
+    LvnDescriptorBinding descriptorBindings[] =
+    {
+        descriptorUniformBinding, descriptorStorageBinding,
+    };
+
+    LvnDescriptorLayoutCreateInfo descriptorLayoutCreateInfo{};
+    descriptorLayoutCreateInfo.pDescriptorBindings = descriptorBindings;
+    descriptorLayoutCreateInfo.descriptorBindingCount = LVN_ARRAY_LEN(descriptorBindings);
+    descriptorLayoutCreateInfo.maxSets = 1;
+
+    LvnDescriptorLayout* descriptorLayout;
+    LvnDescriptorSet* descriptorSet;
+    lvn::createDescriptorLayout(&descriptorLayout, &descriptorLayoutCreateInfo);
+    lvn::allocateDescriptorSet(&descriptorSet, descriptorLayout);
+
+    LvnUniformBufferInfo uniformBufferInfo{ uniformBuffer, sizeof(LvnParticleUniformData), 0 };
+    LvnUniformBufferInfo storageBufferInfo{ particleBuffer, particleBufferCreateInfo.size, 0 };
+
+    LvnDescriptorUpdateInfo descriptorUniformUpdateInfo{};
+    descriptorUniformUpdateInfo.descriptorType = Lvn_DescriptorType_UniformBuffer;
+    descriptorUniformUpdateInfo.binding = 0;
+    descriptorUniformUpdateInfo.descriptorCount = 1;
+    descriptorUniformUpdateInfo.bufferInfo = &uniformBufferInfo;
+
+    LvnDescriptorUpdateInfo descriptorStorageUpdateInfo{};
+    descriptorStorageUpdateInfo.descriptorType = Lvn_DescriptorType_StorageBuffer;
+    descriptorStorageUpdateInfo.binding = 1;
+    descriptorStorageUpdateInfo.descriptorCount = 1;
+    descriptorStorageUpdateInfo.bufferInfo = &storageBufferInfo;
+
+    LvnDescriptorUpdateInfo descriptorUpdateInfos[] = { descriptorUniformUpdateInfo, descriptorStorageUpdateInfo, };
+    lvn::updateDescriptorSetData(descriptorSet, descriptorUpdateInfos, LVN_ARRAY_LEN(descriptorUpdateInfos));
+
+    // compute pipeline
+    LvnShaderCreateInfo computeShaderCreateInfo{};
+    computeShaderCreateInfo.computeSrc = s_ComputeShaderParticleSrc;
+
+    LvnShader* computeShader;
+    lvn::createShaderFromSrc(&computeShader, &computeShaderCreateInfo);
+
+    LvnComputePipelineCreateInfo computePipelineCreateInfo{};
+    computePipelineCreateInfo.pDescriptorLayouts = &descriptorLayout;
+    computePipelineCreateInfo.descriptorLayoutCount = 1;
+    computePipelineCreateInfo.shader = computeShader;
+
+    LvnPipeline* computePipeline;
+    LvnResult computeResult = lvn::createComputePipeline(&computePipeline, &computePipelineCreateInfo);
+    lvn::destroyShader(computeShader);
+
+    // graphics pipeline, the unit quad corner is read per vertex from binding 0 and the particle per instance from binding 1
+    LvnVertexBindingDescription bindingDescriptions[] =
+    {
+        LvnVertexBindingDescription{ 0, sizeof(LvnVec2), Lvn_VertexInputRate_Vertex },
+        LvnVertexBindingDescription{ 1, sizeof(LvnParticleData), Lvn_VertexInputRate_Instance },
+    };
+    LvnVertexAttribute attributes[] =
+    {
+        { 0, 0, Lvn_AttributeFormat_Vec2_f32, 0 },
+        { 1, 1, Lvn_AttributeFormat_Vec4_f32, offsetof(LvnParticleData, pos) },
+        { 1, 2, Lvn_AttributeFormat_Vec4_f32, offsetof(LvnParticleData, state) },
+    };
+
+    LvnShaderCreateInfo shaderCreateInfo{};
+    shaderCreateInfo.vertexSrc = s_VertexShaderParticleSrc;
+    shaderCreateInfo.fragmentSrc = s_FragmentShaderCircleSrc;
+
+    LvnShader* shader;
+    lvn::createShaderFromSrc(&shader, &shaderCreateInfo);
+
+    LvnPipelineSpecification pipelineSpec = lvn::configPipelineSpecificationInit();
+
+    LvnPipelineCreateInfo pipelineCreateInfo{};
+    pipelineCreateInfo.pipelineSpecification = &pipelineSpec;
+    pipelineCreateInfo.pVertexAttributes = attributes;
+    pipelineCreateInfo.vertexAttributeCount = LVN_ARRAY_LEN(attributes);
+    pipelineCreateInfo.pVertexBindingDescriptions = bindingDescriptions;
+    pipelineCreateInfo.vertexBindingDescriptionCount = LVN_ARRAY_LEN(bindingDescriptions);
+    pipelineCreateInfo.pDescriptorLayouts = &descriptorLayout;
+    pipelineCreateInfo.descriptorLayoutCount = 1;
+    pipelineCreateInfo.shader = shader;
+    pipelineCreateInfo.renderPass = renderer->renderPass;
+
+    LvnPipeline* pipeline;
+    LvnResult pipelineResult = lvn::createPipeline(&pipeline, &pipelineCreateInfo);
+    lvn::destroyShader(shader);
+
+    if (computeResult != Lvn_Result_Success || pipelineResult != Lvn_Result_Success)
+    {
+        LVN_CORE_ERROR("createParticleSystem(LvnParticleSystem**, LvnParticleSystemCreateInfo*) | failed to create particle pipelines, compute pipelines may not be supported by the graphics api");
+        if (computeResult == Lvn_Result_Success) lvn::destroyPipeline(computePipeline);
+        if (pipelineResult == Lvn_Result_Success) lvn::destroyPipeline(pipeline);
+        lvn::destroyDescriptorLayout(descriptorLayout);
+        lvn::destroyBuffer(uniformBuffer);
+        lvn::destroyBuffer(particleBuffer);
+        return Lvn_Result_Failure;
+    }
+
+    *particleSystem = lvn::memNew<LvnParticleSystem>();
+    LvnParticleSystem* particleSystemPtr = *particleSystem;
+    particleSystemPtr->renderer = renderer;
+    particleSystemPtr->particleBuffer = particleBuffer;
+    particleSystemPtr->uniformBuffer = uniformBuffer;
+    particleSystemPtr->descriptorLayout = descriptorLayout;
+    particleSystemPtr->descriptorSet = descriptorSet;
+    particleSystemPtr->computePipeline = computePipeline;
+    particleSystemPtr->pipeline = pipeline;
+    particleSystemPtr->maxParticles = maxParticles;
+    particleSystemPtr->spawnCursor = 0;
+    particleSystemPtr->emitterCount = 0;
+    particleSystemPtr->step = 0;
+    particleSystemPtr->drawFrameIndex = UINT64_MAX;
+    for (uint32_t i = 0; i < LVN_PARTICLE_MAX_EMITTERS; i++)
+    {
+        particleSystemPtr->emitters[i] = {};
+        particleSystemPtr->spawnRemainder[i] = 0.0f;
+        particleSystemPtr->bursts[i] = 0;
+    }
+
+    LVN_CORE_TRACE("created particle system: (%p), max particles: %u", *particleSystem, maxParticles);
+    return Lvn_Result_Success;
+}
+
+void destroyParticleSystem(LvnParticleSystem* particleSystem)
+{
+    if (particleSystem == nullptr) { return; }
+
+    lvn::destroyPipeline(particleSystem->computePipeline);
+    lvn::destroyPipeline(particleSystem->pipeline);
+    lvn::destroyDescriptorLayout(particleSystem->descriptorLayout);
+    lvn::destroyBuffer(particleSystem->uniformBuffer);
+    lvn::destroyBuffer(particleSystem->particleBuffer);
+    lvn::memDelete(particleSystem);
+}
+
+void particleSystemSetEmitter(LvnParticleSystem* particleSystem, uint32_t index, const LvnParticleEmitter& emitter)
+{
+    if (index >= LVN_PARTICLE_MAX_EMITTERS)
+    {
+        LVN_CORE_ERROR("particleSystemSetEmitter(LvnParticleSystem*, uint32_t, const LvnParticleEmitter&) | emitter index (%u) out of range, particle systems have %u emitters", index, LVN_PARTICLE_MAX_EMITTERS);
+        return;
+    }
+
+    particleSystem->emitters[index] = emitter;
+    particleSystem->emitterCount = lvn::max(particleSystem->emitterCount, index + 1);
+}
+
+void particleSystemEmit(LvnParticleSystem* particleSystem, uint32_t index, uint32_t count)
+{
+    if (index >= particleSystem->emitterCount)
+    {
+        LVN_CORE_ERROR("particleSystemEmit(LvnParticleSystem*, uint32_t, uint32_t) | emitter (%u) of particle system (%p) was never set", index, particleSystem);
+        return;
+    }
+
+    particleSystem->bursts[index] += count;
+}
+
+void drawParticleSystem(LvnParticleSystem* particleSystem, float dt)
+{
+    LvnRenderer* renderer = s_Renderer;
+    if (particleSystem->renderer != renderer || particleSystem->drawFrameIndex == s_DrawFrameIndex)
+        return;
+
+    particleSystem->drawFrameIndex = s_DrawFrameIndex;
+
+    LvnParticleDraw draw{};
+    draw.system = particleSystem;
+    draw.sortKey = lvn::renderGetSortKey(0);
+
+    // the cpu only decides how many particles each emitter spawns, the spawned slots are contiguous in the ring
+    LvnParticleUniformData& uniform = draw.uniform;
+    uint32_t spawnCount = 0;
+    for (uint32_t i = 0; i < particleSystem->emitterCount; i++)
+    {
+        const LvnParticleEmitter& emitter = particleSystem->emitters[i];
+
+        float spawn = particleSystem->spawnRemainder[i] + lvn::max(emitter.rate, 0.0f) * dt;
+        uint32_t count = (uint32_t)spawn;
+        particleSystem->spawnRemainder[i] = spawn - (float)count;
+        count = lvn::min(count + particleSystem->bursts[i], particleSystem->maxParticles - spawnCount);
+        particleSystem->bursts[i] = 0;
+
+        LvnParticleEmitterData& data = uniform.emitters[i];
+        data.posVel = { emitter.pos.x, emitter.pos.y, emitter.velocity.x, emitter.velocity.y };
+        data.variance = { emitter.posVariance.x, emitter.posVariance.y, emitter.velocityVariance.x, emitter.velocityVariance.y };
+        data.accelLife = { emitter.acceleration.x, emitter.acceleration.y, emitter.lifetime, emitter.lifetimeVariance };
+        data.size = { emitter.startSize, emitter.endSize, 0.0f, 0.0f };
+        data.startColor = { emitter.startColor.r / 255.0f, emitter.startColor.g / 255.0f, emitter.startColor.b / 255.0f, emitter.startColor.a / 255.0f };
+        data.endColor = { emitter.endColor.r / 255.0f, emitter.endColor.g / 255.0f, emitter.endColor.b / 255.0f, emitter.endColor.a / 255.0f };
+        data.spawnFirst = spawnCount;
+        data.spawnCount = count;
+        spawnCount += count;
+    }
+
+    uniform.dt = dt;
+    uniform.seed = (particleSystem->step++ + 1) * 0x9e3779b9u;
+    uniform.maxParticles = particleSystem->maxParticles;
+    uniform.spawnBase = particleSystem->spawnCursor;
+    uniform.spawnCount = spawnCount;
+    uniform.emitterCount = particleSystem->emitterCount;
+    particleSystem->spawnCursor = (particleSystem->spawnCursor + spawnCount) % particleSystem->maxParticles;
+
+    LvnLockGaurd lock(renderer->particleDrawMutex);
+    renderer->recordParticleDraws.push_back(draw);
 }
 
 } /* namespace lvn */